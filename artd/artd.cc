@@ -22,6 +22,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <climits>
 #include <csignal>
 #include <cstddef>
@@ -48,6 +49,7 @@
 #include "aidl/com/android/server/art/BnArtd.h"
 #include "aidl/com/android/server/art/DexoptTrigger.h"
 #include "aidl/com/android/server/art/IArtdCancellationSignal.h"
+#include "android-base/chrono_utils.h"
 #include "android-base/errors.h"
 #include "android-base/file.h"
 #include "android-base/logging.h"
@@ -90,6 +92,9 @@ namespace artd {
 
 namespace {
 
+using ::aidl::com::android::server::art::ArtdDexoptBatchResult;
+using ::aidl::com::android::server::art::ArtdDexoptJob;
+using ::aidl::com::android::server::art::ArtdDexoptJobResult;
 using ::aidl::com::android::server::art::ArtdDexoptResult;
 using ::aidl::com::android::server::art::ArtifactsLocation;
 using ::aidl::com::android::server::art::ArtifactsPath;
@@ -116,6 +121,7 @@ using ::android::base::Join;
 using ::android::base::make_scope_guard;
 using ::android::base::ParseInt;
 using ::android::base::ReadFileToString;
+using ::android::base::Timer;
 using ::android::base::Result;
 using ::android::base::Split;
 using ::android::base::Tokenize;
@@ -313,9 +319,6 @@ Result<void> CopyFile(const std::string& src_path, const NewFile& dst_file) {
   if (!WriteStringToFd(content, dst_file.Fd())) {
     return Errorf("Failed to write file '{}': {}", dst_file.TempPath(), strerror(errno));
   }
-  if (fsync(dst_file.Fd()) != 0) {
-    return Errorf("Failed to flush file '{}': {}", dst_file.TempPath(), strerror(errno));
-  }
   if (lseek(dst_file.Fd(), /*offset=*/0, SEEK_SET) != 0) {
     return Errorf(
         "Failed to reset the offset for file '{}': {}", dst_file.TempPath(), strerror(errno));
@@ -863,6 +866,17 @@ ndk::ScopedAStatus Artd::mergeProfiles(const std::vector<ProfilePath>& in_profil
     return ScopedAStatus::ok();
   }
 
+  if (!in_options.dumpOnly && !in_options.dumpClassesAndMethods &&
+      std::all_of(profile_files.begin(),
+                  profile_files.end(),
+                  [](const std::unique_ptr<File>& file) { return file->GetLength() == 0; })) {
+    // Empty profiles cannot add anything to the reference profile, so profman would skip the
+    // compilation anyway. Don't copy the reference profile and spawn profman just to find out.
+    LOG(INFO) << "Merge skipped because all existing profiles are empty";
+    *_aidl_return = false;
+    return ScopedAStatus::ok();
+  }
+
   std::unique_ptr<NewFile> output_profile_file =
       OR_RETURN_NON_FATAL(NewFile::Create(output_profile_path, in_outputProfile->fsPermission));
 
@@ -903,6 +917,10 @@ ndk::ScopedAStatus Artd::mergeProfiles(const std::vector<ProfilePath>& in_profil
                        props_->GetOrEmpty("dalvik.vm.bgdexopt.new-classes-percent"))
         .AddIfNonEmpty("--min-new-methods-percent-change=%s",
                        props_->GetOrEmpty("dalvik.vm.bgdexopt.new-methods-percent"))
+        .AddIfNonEmpty("--min-new-classes-change=%s",
+                       props_->GetOrEmpty("dalvik.vm.bgdexopt.new-classes-count"))
+        .AddIfNonEmpty("--min-new-methods-change=%s",
+                       props_->GetOrEmpty("dalvik.vm.bgdexopt.new-methods-count"))
         .AddIf(in_options.forceMerge, "--force-merge-and-analyze")
         .AddIf(in_options.forBootImage, "--boot-image-merge");
   }
@@ -932,6 +950,12 @@ ndk::ScopedAStatus Artd::mergeProfiles(const std::vector<ProfilePath>& in_profil
     return NonFatal(ART_FORMAT("profman returned an unexpected code: {}", result.value()));
   }
 
+  // Only flush the output once profman is done with it. The copy of the reference profile that
+  // profman starts from doesn't need to be durable because the file is abandoned on failure.
+  if (fsync(output_profile_file->Fd()) != 0) {
+    return NonFatal(ART_FORMAT(
+        "Failed to flush file '{}': {}", output_profile_file->TempPath(), strerror(errno)));
+  }
   OR_RETURN_NON_FATAL(output_profile_file->Keep());
   *_aidl_return = true;
   in_outputProfile->profilePath.id = output_profile_file->TempId();
@@ -1264,6 +1288,64 @@ ScopedAStatus Artd::createCancellationSignal(
   return ScopedAStatus::ok();
 }
 
+ScopedAStatus Artd::dexoptBatch(const std::vector<ArtdDexoptJob>& in_jobs,
+                                ArtdDexoptBatchResult* _aidl_return) {
+  Timer timer;
+  *_aidl_return = {};
+  _aidl_return->jobResults.reserve(in_jobs.size());
+  for (const ArtdDexoptJob& job : in_jobs) {
+    ArtdCancellationSignal* cancellation_signal =
+        OR_RETURN_FATAL(ToArtdCancellationSignal(job.cancellationSignal.get()));
+    ArtdDexoptJobResult& job_result = _aidl_return->jobResults.emplace_back();
+    if (cancellation_signal->IsCancelled()) {
+      // Don't spawn dex2oat only to kill it right away.
+      job_result.result = ArtdDexoptResult{.cancelled = true};
+      _aidl_return->numCancelled++;
+      continue;
+    }
+    ArtdDexoptResult result;
+    ScopedAStatus status = dexopt(job.outputArtifacts,
+                                  job.dexFile,
+                                  job.instructionSet,
+                                  job.classLoaderContext,
+                                  job.compilerFilter,
+                                  job.profile,
+                                  job.inputVdex,
+                                  job.dmFile,
+                                  job.priorityClass,
+                                  job.dexoptOptions,
+                                  job.cancellationSignal,
+                                  &result);
+    if (!status.isOk()) {
+      if (status.getExceptionCode() != EX_SERVICE_SPECIFIC) {
+        return status;
+      }
+      job_result.errorMessage = status.getMessage();
+      _aidl_return->numFailed++;
+      continue;
+    }
+    _aidl_return->dex2oatWallTimeMs += result.wallTimeMs;
+    _aidl_return->dex2oatCpuTimeMs += result.cpuTimeMs;
+    if (result.cancelled) {
+      _aidl_return->numCancelled++;
+    } else {
+      _aidl_return->numSucceeded++;
+    }
+    job_result.result = std::move(result);
+  }
+  _aidl_return->wallTimeMs = timer.duration().count();
+  LOG(INFO) << ART_FORMAT("dexoptBatch: {} jobs ({} succeeded, {} failed, {} cancelled) in {}ms, "
+                          "dex2oat wall time {}ms, dex2oat CPU time {}ms",
+                          in_jobs.size(),
+                          _aidl_return->numSucceeded,
+                          _aidl_return->numFailed,
+                          _aidl_return->numCancelled,
+                          _aidl_return->wallTimeMs,
+                          _aidl_return->dex2oatWallTimeMs,
+                          _aidl_return->dex2oatCpuTimeMs);
+  return ScopedAStatus::ok();
+}
+
 ScopedAStatus Artd::cleanup(const std::vector<ProfilePath>& in_profilesToKeep,
                             const std::vector<ArtifactsPath>& in_artifactsToKeep,
                             const std::vector<VdexPath>& in_vdexFilesToKeep,
@@ -1728,6 +1810,10 @@ void Artd::AddPerfConfigFlags(PriorityClass priority_class,
   dex2oat_args.AddIf(props_->GetBool("ro.config.low_ram", /*default_value=*/false),
                      "--compile-individually");
 
+  // Background dexopt is not time-critical, so let dex2oat trade speed for memory when the
+  // system is under memory pressure.
+  dex2oat_args.AddIf(priority_class <= PriorityClass::BACKGROUND, "--adapt-to-memory-pressure");
+
   for (const std::string& flag :
        Tokenize(props_->GetOrEmpty("dalvik.vm.dex2oat-flags"), /*delimiters=*/" ")) {
     dex2oat_args.AddIfNonEmpty("%s", flag);
@@ -197,6 +197,10 @@ class Artd : public aidl::com::android::server::art::BnArtd {
       std::shared_ptr<aidl::com::android::server::art::IArtdCancellationSignal>* _aidl_return)
       override;
 
+  ndk::ScopedAStatus dexoptBatch(
+      const std::vector<aidl::com::android::server::art::ArtdDexoptJob>& in_jobs,
+      aidl::com::android::server::art::ArtdDexoptBatchResult* _aidl_return) override;
+
   ndk::ScopedAStatus cleanup(
       const std::vector<aidl::com::android::server::art::ProfilePath>& in_profilesToKeep,
       const std::vector<aidl::com::android::server::art::ArtifactsPath>& in_artifactsToKeep,
@@ -74,6 +74,9 @@ namespace artd {
 namespace {
 
 using ::aidl::com::android::server::art::ArtConstants;
+using ::aidl::com::android::server::art::ArtdDexoptBatchResult;
+using ::aidl::com::android::server::art::ArtdDexoptJob;
+using ::aidl::com::android::server::art::ArtdDexoptJobResult;
 using ::aidl::com::android::server::art::ArtdDexoptResult;
 using ::aidl::com::android::server::art::ArtifactsPath;
 using ::aidl::com::android::server::art::CopyAndRewriteProfileResult;
@@ -116,6 +119,7 @@ using ::testing::Matcher;
 using ::testing::MockFunction;
 using ::testing::NiceMock;
 using ::testing::Not;
+using ::testing::Optional;
 using ::testing::Property;
 using ::testing::ResultOf;
 using ::testing::Return;
@@ -449,6 +453,21 @@ class ArtdTest : public CommonArtTest {
     }
   }
 
+  // Returns a job for `dexoptBatch` with the same arguments as `RunDexopt`.
+  ArtdDexoptJob CreateDexoptJob(std::shared_ptr<IArtdCancellationSignal> cancellation_signal) {
+    return ArtdDexoptJob{.outputArtifacts = output_artifacts_,
+                         .dexFile = dex_file_,
+                         .instructionSet = isa_,
+                         .classLoaderContext = class_loader_context_,
+                         .compilerFilter = compiler_filter_,
+                         .profile = profile_path_,
+                         .inputVdex = vdex_path_,
+                         .dmFile = dm_path_,
+                         .priorityClass = priority_class_,
+                         .dexoptOptions = dexopt_options_,
+                         .cancellationSignal = std::move(cancellation_signal)};
+  }
+
   template <bool kExpectOk>
   using RunCopyAndRewriteProfileResult = Result<
       std::pair<std::conditional_t<kExpectOk, CopyAndRewriteProfileResult, ndk::ScopedAStatus>,
@@ -806,7 +825,8 @@ TEST_F(ArtdTest, dexoptPriorityClassInteractive) {
                   WhenSplitBy("--",
                               AllOf(Contains(Flag("--set-task-profile=", "Dex2OatBootComplete")),
                                     Contains(Flag("--set-priority=", "background"))),
-                              Contains(Flag("--compact-dex-level=", "none"))),
+                              AllOf(Contains(Flag("--compact-dex-level=", "none")),
+                                    Not(Contains("--adapt-to-memory-pressure")))),
                   _,
                   _))
       .WillOnce(Return(0));
@@ -834,7 +854,8 @@ TEST_F(ArtdTest, dexoptPriorityClassBackground) {
                   WhenSplitBy("--",
                               AllOf(Contains(Flag("--set-task-profile=", "Dex2OatBackground")),
                                     Contains(Flag("--set-priority=", "background"))),
-                              Not(Contains(Flag("--compact-dex-level=", _)))),
+                              AllOf(Not(Contains(Flag("--compact-dex-level=", _))),
+                                    Contains("--adapt-to-memory-pressure"))),
                   _,
                   _))
       .WillOnce(Return(0));
@@ -1260,6 +1281,90 @@ TEST_F(ArtdTest, dexoptCancelledAfterDex2oat) {
   EXPECT_FALSE(std::filesystem::exists(scratch_path_ + "/a/oat/arm64/b.art"));
 }
 
+TEST_F(ArtdTest, dexoptBatch) {
+  InitFilesBeforeDexopt();
+  std::shared_ptr<IArtdCancellationSignal> cancellation_signal_1, cancellation_signal_2;
+  ASSERT_TRUE(artd_->createCancellationSignal(&cancellation_signal_1).isOk());
+  ASSERT_TRUE(artd_->createCancellationSignal(&cancellation_signal_2).isOk());
+
+  constexpr int kExitCode = 135;
+  EXPECT_CALL(*mock_exec_utils_, DoExecAndReturnCode(_, _, _))
+      .WillOnce(DoAll(WithArg<0>(WriteToFdFlag("--oat-fd=", "oat")),
+                      WithArg<0>(WriteToFdFlag("--output-vdex-fd=", "vdex")),
+                      SetArgPointee<2>(ProcessStat{.wall_time_ms = 100, .cpu_time_ms = 400}),
+                      Return(0)))
+      .WillOnce(Return(kExitCode));
+
+  ArtdDexoptBatchResult aidl_return;
+  ASSERT_TRUE(artd_
+                  ->dexoptBatch({CreateDexoptJob(cancellation_signal_1),
+                                 CreateDexoptJob(cancellation_signal_2)},
+                                &aidl_return)
+                  .isOk());
+
+  EXPECT_THAT(
+      aidl_return.jobResults,
+      ElementsAre(
+          AllOf(Field(&ArtdDexoptJobResult::result,
+                      Optional(AllOf(Field(&ArtdDexoptResult::cancelled, false),
+                                     Field(&ArtdDexoptResult::wallTimeMs, 100),
+                                     Field(&ArtdDexoptResult::cpuTimeMs, 400)))),
+                Field(&ArtdDexoptJobResult::errorMessage, IsEmpty())),
+          AllOf(Field(&ArtdDexoptJobResult::result, std::nullopt),
+                Field(&ArtdDexoptJobResult::errorMessage,
+                      HasSubstr(ART_FORMAT("[status={},exit_code={},signal=0]",
+                                           static_cast<int>(ExecResult::kExited),
+                                           kExitCode))))));
+  EXPECT_EQ(aidl_return.numSucceeded, 1);
+  EXPECT_EQ(aidl_return.numFailed, 1);
+  EXPECT_EQ(aidl_return.numCancelled, 0);
+  EXPECT_EQ(aidl_return.dex2oatWallTimeMs, 100);
+  EXPECT_EQ(aidl_return.dex2oatCpuTimeMs, 400);
+
+  CheckContent(scratch_path_ + "/a/oat/arm64/b.odex", "oat");
+  CheckContent(scratch_path_ + "/a/oat/arm64/b.vdex", "vdex");
+}
+
+TEST_F(ArtdTest, dexoptBatchSkipsCancelledJobs) {
+  InitFilesBeforeDexopt();
+  std::shared_ptr<IArtdCancellationSignal> cancellation_signal_1, cancellation_signal_2;
+  ASSERT_TRUE(artd_->createCancellationSignal(&cancellation_signal_1).isOk());
+  ASSERT_TRUE(artd_->createCancellationSignal(&cancellation_signal_2).isOk());
+
+  EXPECT_CALL(*mock_exec_utils_, DoExecAndReturnCode(_, _, _))
+      .WillOnce(DoAll(WithArg<0>(WriteToFdFlag("--oat-fd=", "oat")),
+                      WithArg<0>(WriteToFdFlag("--output-vdex-fd=", "vdex")),
+                      Return(0)));
+  EXPECT_CALL(mock_kill_, Call).Times(0);
+
+  cancellation_signal_1->cancel();
+
+  ArtdDexoptBatchResult aidl_return;
+  ASSERT_TRUE(artd_
+                  ->dexoptBatch({CreateDexoptJob(cancellation_signal_1),
+                                 CreateDexoptJob(cancellation_signal_2)},
+                                &aidl_return)
+                  .isOk());
+
+  EXPECT_THAT(aidl_return.jobResults,
+              ElementsAre(Field(&ArtdDexoptJobResult::result,
+                                Optional(Field(&ArtdDexoptResult::cancelled, true))),
+                          Field(&ArtdDexoptJobResult::result,
+                                Optional(Field(&ArtdDexoptResult::cancelled, false)))));
+  EXPECT_EQ(aidl_return.numSucceeded, 1);
+  EXPECT_EQ(aidl_return.numCancelled, 1);
+}
+
+TEST_F(ArtdTest, dexoptBatchInvalidCancellationSignal) {
+  EXPECT_CALL(*mock_exec_utils_, DoExecAndReturnCode(_, _, _)).Times(0);
+
+  ArtdDexoptBatchResult aidl_return;
+  ndk::ScopedAStatus status = artd_->dexoptBatch({CreateDexoptJob(nullptr)}, &aidl_return);
+
+  EXPECT_EQ(status.getExceptionCode(), EX_ILLEGAL_STATE);
+  EXPECT_THAT(status.getMessage(), HasSubstr("Cancellation signal must not be nullptr"));
+}
+
 TEST_F(ArtdTest, dexoptDexFileNotOtherReadable) {
   dex_file_other_readable_ = false;
   EXPECT_CALL(*mock_exec_utils_, DoExecAndReturnCode(_, _, _)).Times(0);
@@ -2011,6 +2116,38 @@ TEST_F(ArtdTest, mergeProfilesProfilesDontExist) {
   EXPECT_THAT(output_profile.profilePath.tmpPath, IsEmpty());
 }
 
+TEST_F(ArtdTest, mergeProfilesProfilesEmpty) {
+  std::string reference_profile_file = OR_FATAL(BuildProfileOrDmPath(profile_path_.value()));
+  CreateFile(reference_profile_file, "abc");
+
+  PrimaryCurProfilePath profile_0_path{
+      .userId = 0, .packageName = "com.android.foo", .profileName = "primary"};
+  std::string profile_0_file = OR_FATAL(BuildPrimaryCurProfilePath(profile_0_path));
+  CreateFile(profile_0_file, "");
+
+  OutputProfile output_profile{.profilePath = tmp_profile_path_,
+                               .fsPermission = FsPermission{.uid = -1, .gid = -1}};
+  output_profile.profilePath.id = "";
+  output_profile.profilePath.tmpPath = "";
+
+  CreateFile(dex_file_);
+
+  EXPECT_CALL(*mock_exec_utils_, DoExecAndReturnCode).Times(0);
+
+  bool result;
+  EXPECT_TRUE(artd_
+                  ->mergeProfiles({profile_0_path},
+                                  profile_path_,
+                                  &output_profile,
+                                  {dex_file_},
+                                  /*in_options=*/{},
+                                  &result)
+                  .isOk());
+  EXPECT_FALSE(result);
+  EXPECT_THAT(output_profile.profilePath.id, IsEmpty());
+  EXPECT_THAT(output_profile.profilePath.tmpPath, IsEmpty());
+}
+
 TEST_F(ArtdTest, mergeProfilesWithOptionsForceMerge) {
   PrimaryCurProfilePath profile_0_path{
       .userId = 0, .packageName = "com.android.foo", .profileName = "primary"};
@@ -2047,6 +2184,50 @@ TEST_F(ArtdTest, mergeProfilesWithOptionsForceMerge) {
   EXPECT_THAT(output_profile.profilePath.tmpPath, Not(IsEmpty()));
 }
 
+TEST_F(ArtdTest, mergeProfilesWithDeltaThresholds) {
+  PrimaryCurProfilePath profile_0_path{
+      .userId = 0, .packageName = "com.android.foo", .profileName = "primary"};
+  std::string profile_0_file = OR_FATAL(BuildPrimaryCurProfilePath(profile_0_path));
+  CreateFile(profile_0_file, "def");
+
+  OutputProfile output_profile{.profilePath = tmp_profile_path_,
+                               .fsPermission = FsPermission{.uid = -1, .gid = -1}};
+  output_profile.profilePath.id = "";
+  output_profile.profilePath.tmpPath = "";
+
+  CreateFile(dex_file_);
+
+  EXPECT_CALL(*mock_props_, GetProperty("dalvik.vm.bgdexopt.new-classes-percent"))
+      .WillOnce(Return("5"));
+  EXPECT_CALL(*mock_props_, GetProperty("dalvik.vm.bgdexopt.new-methods-percent"))
+      .WillOnce(Return("10"));
+  EXPECT_CALL(*mock_props_, GetProperty("dalvik.vm.bgdexopt.new-classes-count"))
+      .WillOnce(Return("20"));
+  EXPECT_CALL(*mock_props_, GetProperty("dalvik.vm.bgdexopt.new-methods-count"))
+      .WillOnce(Return("200"));
+  EXPECT_CALL(*mock_exec_utils_,
+              DoExecAndReturnCode(WhenSplitBy("--",
+                                              _,
+                                              AllOf(Contains("--min-new-classes-percent-change=5"),
+                                                    Contains("--min-new-methods-percent-change=10"),
+                                                    Contains("--min-new-classes-change=20"),
+                                                    Contains("--min-new-methods-change=200"))),
+                                  _,
+                                  _))
+      .WillOnce(Return(ProfmanResult::kSkipCompilationSmallDelta));
+
+  bool result;
+  EXPECT_TRUE(artd_
+                  ->mergeProfiles({profile_0_path},
+                                  std::nullopt,
+                                  &output_profile,
+                                  {dex_file_},
+                                  /*in_options=*/{},
+                                  &result)
+                  .isOk());
+  EXPECT_FALSE(result);
+}
+
 TEST_F(ArtdTest, mergeProfilesWithOptionsDumpOnly) {
   PrimaryCurProfilePath profile_0_path{
       .userId = 0, .packageName = "com.android.foo", .profileName = "primary"};
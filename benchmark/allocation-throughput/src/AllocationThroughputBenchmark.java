@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+public class AllocationThroughputBenchmark {
+    static class Empty {
+    }
+
+    static class Small {
+        int a;
+        int b;
+    }
+
+    static class Large {
+        long a;
+        long b;
+        long c;
+        long d;
+        long e;
+        long f;
+        long g;
+        long h;
+    }
+
+    static class Finalizable {
+        int a;
+
+        @Override
+        protected void finalize() {
+        }
+    }
+
+    private static Object sink;
+
+    public void timeNewEmpty(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new Empty();
+        }
+    }
+
+    public void timeNewSmall(int count) {
+        for (int i = 0; i < count; ++i) {
+            Small small = new Small();
+            small.a = i;
+            sink = small;
+        }
+    }
+
+    public void timeNewLarge(int count) {
+        for (int i = 0; i < count; ++i) {
+            Large large = new Large();
+            large.a = i;
+            sink = large;
+        }
+    }
+
+    public void timeNewLinkedPairs(int count) {
+        for (int i = 0; i < count; ++i) {
+            Object[] pair = new Object[] { new Small(), new Small() };
+            sink = pair;
+        }
+    }
+
+    public void timeNewFinalizable(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new Finalizable();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.nio.ByteBuffer;
+import java.util.zip.CRC32;
+
+public class CRC32Benchmark {
+    private static final byte[] bytes64 = makeBytes(64);
+    private static final byte[] bytes4K = makeBytes(4 * 1024);
+    private static final ByteBuffer directBuffer4K = makeDirectBuffer(4 * 1024);
+
+    private static byte[] makeBytes(int length) {
+        byte[] bytes = new byte[length];
+        for (int i = 0; i < length; ++i) {
+            bytes[i] = (byte) (i * 31);
+        }
+        return bytes;
+    }
+
+    private static ByteBuffer makeDirectBuffer(int length) {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(length);
+        buffer.put(makeBytes(length));
+        return buffer;
+    }
+
+    public void timeUpdateInt(int count) {
+        CRC32 crc32 = new CRC32();
+        for (int i = 0; i < count; ++i) {
+            crc32.update(i);
+        }
+    }
+
+    public void timeUpdateBytes64(int count) {
+        CRC32 crc32 = new CRC32();
+        for (int i = 0; i < count; ++i) {
+            crc32.update(bytes64, 0, bytes64.length);
+        }
+    }
+
+    public void timeUpdateBytes4K(int count) {
+        CRC32 crc32 = new CRC32();
+        for (int i = 0; i < count; ++i) {
+            crc32.update(bytes4K, 0, bytes4K.length);
+        }
+    }
+
+    public void timeUpdateDirectByteBuffer4K(int count) {
+        CRC32 crc32 = new CRC32();
+        for (int i = 0; i < count; ++i) {
+            directBuffer4K.rewind();
+            crc32.update(directBuffer4K);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class ExceptionThroughputBenchmark {
+    private static final int SHALLOW_DEPTH = 4;
+    private static final int DEEP_DEPTH = 256;
+
+    private static final IllegalStateException PREALLOCATED = new IllegalStateException();
+
+    private static int sink;
+
+    private static int recurseAndThrow(int depth) {
+        if (depth == 0) {
+            throw new IllegalStateException();
+        }
+        return recurseAndThrow(depth - 1) + 1;
+    }
+
+    private static int recurseAndThrowPreallocated(int depth) {
+        if (depth == 0) {
+            throw PREALLOCATED;
+        }
+        return recurseAndThrowPreallocated(depth - 1) + 1;
+    }
+
+    // Catches the exception thrown by the callee, as code using exceptions for control flow does.
+    private static int parseOrDefault(String value) {
+        try {
+            return Integer.parseInt(value);
+        } catch (NumberFormatException e) {
+            return -1;
+        }
+    }
+
+    private static int throwAndCatch(int depth, int count) {
+        int result = 0;
+        for (int i = 0; i < count; ++i) {
+            try {
+                result += recurseAndThrow(depth);
+            } catch (IllegalStateException expected) {
+                result += 1;
+            }
+        }
+        return result;
+    }
+
+    public void timeThrowAndCatchShallow(int count) {
+        sink += throwAndCatch(SHALLOW_DEPTH, count);
+    }
+
+    // Stack trace capture dominates: each exception records DEEP_DEPTH frames unless limited.
+    public void timeThrowAndCatchDeep(int count) {
+        sink += throwAndCatch(DEEP_DEPTH, count);
+    }
+
+    // No stack trace capture, only the search for the catch handler.
+    public void timeThrowPreallocatedAndCatchDeep(int count) {
+        for (int i = 0; i < count; ++i) {
+            try {
+                sink += recurseAndThrowPreallocated(DEEP_DEPTH);
+            } catch (IllegalStateException expected) {
+                sink += 1;
+            }
+        }
+    }
+
+    public void timeParseInvalidNumber(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink += parseOrDefault("not a number");
+        }
+    }
+
+    public void timeThrowAndGetStackTraceDeep(int count) {
+        for (int i = 0; i < count; ++i) {
+            try {
+                sink += recurseAndThrow(DEEP_DEPTH);
+            } catch (IllegalStateException e) {
+                sink += e.getStackTrace().length;
+            }
+        }
+    }
+}
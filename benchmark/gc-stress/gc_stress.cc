@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "android-base/logging.h"
+#include "base/macros.h"
+#include "base/time_utils.h"
+#include "gc/gc_pause_listener.h"
+#include "gc/heap.h"
+#include "jni.h"
+#include "nativehelper/scoped_local_ref.h"
+#include "runtime.h"
+
+// A GC stress driver: builds a live heap of a given shape, then mutates it from several threads
+// for a fixed duration while recording the GC pauses, the mutator throughput and the RSS. Run it
+// once per collector (e.g. -Xgc:CC, -Xgc:CMC) with the same options to compare them.
+
+namespace art {
+
+namespace {
+
+// The live heap is an array of `units`, each unit built by a shape. The mutators replace random
+// units with new ones, so that the live size stays constant while old units become garbage.
+enum class HeapShape {
+  // Units are singly linked lists of small nodes, which makes marking chase long pointer chains.
+  kLinkedList,
+  // Units are shallow trees with a large fanout, i.e. many objects but a short marking depth.
+  kWideTree,
+  // Units are primitive arrays above the large object threshold.
+  kLargeArrays,
+  // Units hold WeakReferences, half of them to objects kept alive by the same unit.
+  kWeakRefs,
+  // Units are small arrays that are not replaced; instead the mutators keep storing new objects
+  // into random old units, which stresses card marking and the reference update paths.
+  kReferenceChurn,
+};
+
+struct ShapeInfo {
+  HeapShape shape;
+  const char* name;
+};
+
+constexpr ShapeInfo kShapes[] = {
+    {HeapShape::kLinkedList, "linked-list"},
+    {HeapShape::kWideTree, "wide-tree"},
+    {HeapShape::kLargeArrays, "large-arrays"},
+    {HeapShape::kWeakRefs, "weak-refs"},
+    {HeapShape::kReferenceChurn, "reference-churn"},
+};
+
+constexpr jint kLinkedListLength = 1024;
+constexpr jint kTreeFanout = 64;
+constexpr jint kLargeArrayLength = 256 * KB;
+constexpr jint kWeakRefsPerUnit = 256;
+constexpr jint kChurnUnitLength = 16;
+
+class PauseRecorder final : public gc::GcPauseListener {
+ public:
+  // Called by the GC thread while the mutators are suspended.
+  void StartPause() override {
+    pause_start_ns_ = NanoTime();
+  }
+
+  void EndPause() override {
+    std::lock_guard<std::mutex> lock(lock_);
+    pauses_ns_.push_back(NanoTime() - pause_start_ns_);
+  }
+
+  std::vector<uint64_t> GetPauses() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return pauses_ns_;
+  }
+
+ private:
+  uint64_t pause_start_ns_ = 0;
+  std::mutex lock_;
+  std::vector<uint64_t> pauses_ns_;
+};
+
+struct MemorySample {
+  uint64_t time_ms;
+  size_t rss_bytes;
+  size_t heap_bytes;
+};
+
+size_t GetRss() {
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0;
+  }
+  size_t size_pages = 0;
+  size_t resident_pages = 0;
+  if (fscanf(statm, "%zu %zu", &size_pages, &resident_pages) != 2) {
+    resident_pages = 0;
+  }
+  fclose(statm);
+  return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+class GcStress {
+ public:
+  GcStress(JavaVM* vm, HeapShape shape, size_t live_bytes, size_t num_threads)
+      : vm_(vm), shape_(shape), live_bytes_(live_bytes), num_threads_(num_threads) {}
+
+  void SetUp(JNIEnv* env) {
+    ScopedLocalRef<jclass> object_class(env, env->FindClass("java/lang/Object"));
+    object_class_ = reinterpret_cast<jclass>(env->NewGlobalRef(object_class.get()));
+    ScopedLocalRef<jclass> object_array_class(env, env->FindClass("[Ljava/lang/Object;"));
+    object_array_class_ = reinterpret_cast<jclass>(env->NewGlobalRef(object_array_class.get()));
+    ScopedLocalRef<jclass> weak_class(env, env->FindClass("java/lang/ref/WeakReference"));
+    weak_reference_class_ = reinterpret_cast<jclass>(env->NewGlobalRef(weak_class.get()));
+    weak_reference_init_ =
+        env->GetMethodID(weak_reference_class_, "<init>", "(Ljava/lang/Object;)V");
+    CHECK(weak_reference_init_ != nullptr);
+
+    // Estimate the size of a unit from the heap growth when building units, then build enough
+    // units for the requested live size. Thread-local allocation buffers are accounted for when
+    // they are allocated, so build units until the growth is well above their size.
+    static constexpr size_t kMinEstimateBytes = 4 * MB;
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    heap->CollectGarbage(/*clear_soft_references=*/ false);
+    ScopedLocalRef<jclass> array_list_class(env, env->FindClass("java/util/ArrayList"));
+    jmethodID array_list_init = env->GetMethodID(array_list_class.get(), "<init>", "()V");
+    jmethodID array_list_add =
+        env->GetMethodID(array_list_class.get(), "add", "(Ljava/lang/Object;)Z");
+    jmethodID array_list_get =
+        env->GetMethodID(array_list_class.get(), "get", "(I)Ljava/lang/Object;");
+    ScopedLocalRef<jobject> estimate_units(
+        env, env->NewObject(array_list_class.get(), array_list_init));
+    size_t before = heap->GetBytesAllocated();
+    size_t num_estimate_units = 0;
+    while (heap->GetBytesAllocated() < before + kMinEstimateBytes) {
+      ScopedLocalRef<jobject> unit(env, NewUnit(env));
+      env->CallBooleanMethod(estimate_units.get(), array_list_add, unit.get());
+      ++num_estimate_units;
+    }
+    unit_bytes_ = std::max<size_t>((heap->GetBytesAllocated() - before) / num_estimate_units, 1u);
+    num_units_ = std::max<size_t>(live_bytes_ / unit_bytes_, 1u);
+
+    ScopedLocalRef<jobjectArray> units(
+        env, env->NewObjectArray(static_cast<jint>(num_units_), object_class_, nullptr));
+    CHECK(units.get() != nullptr);
+    for (size_t i = 0; i < num_units_; ++i) {
+      ScopedLocalRef<jobject> unit(
+          env,
+          i < num_estimate_units
+              ? env->CallObjectMethod(estimate_units.get(), array_list_get, static_cast<jint>(i))
+              : NewUnit(env));
+      env->SetObjectArrayElement(units.get(), static_cast<jint>(i), unit.get());
+    }
+    units_ = reinterpret_cast<jobjectArray>(env->NewGlobalRef(units.get()));
+  }
+
+  void Run(uint64_t duration_ms, uint64_t sample_interval_ms) {
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    heap->SetGcPauseListener(&pauses_);
+    start_ns_ = NanoTime();
+    uint64_t end_ns = start_ns_ + MsToNs(duration_ms);
+
+    std::vector<std::thread> mutators;
+    for (size_t t = 0; t < num_threads_; ++t) {
+      mutators.emplace_back([this, t, end_ns]() { Mutate(t, end_ns); });
+    }
+
+    // The sampler only reads counters and does not need to be attached to the runtime.
+    std::thread sampler([&]() {
+      std::unique_lock<std::mutex> lock(done_lock_);
+      do {
+        samples_.push_back({NsToMs(NanoTime() - start_ns_), GetRss(), heap->GetBytesAllocated()});
+      } while (!done_cond_.wait_for(
+          lock, std::chrono::milliseconds(sample_interval_ms), [this]() { return done_; }));
+    });
+
+    for (std::thread& mutator : mutators) {
+      mutator.join();
+    }
+    elapsed_ns_ = NanoTime() - start_ns_;
+    {
+      std::lock_guard<std::mutex> lock(done_lock_);
+      done_ = true;
+    }
+    done_cond_.notify_all();
+    sampler.join();
+    heap->RemoveGcPauseListener();
+  }
+
+  void TearDown(JNIEnv* env) {
+    env->DeleteGlobalRef(units_);
+    env->DeleteGlobalRef(weak_reference_class_);
+    env->DeleteGlobalRef(object_array_class_);
+    env->DeleteGlobalRef(object_class_);
+  }
+
+  void WriteJson(std::ostream& os, const char* shape_name) {
+    std::vector<uint64_t> pauses = pauses_.GetPauses();
+    std::sort(pauses.begin(), pauses.end());
+    auto percentile = [&](double p) -> uint64_t {
+      if (pauses.empty()) {
+        return 0u;
+      }
+      size_t index = static_cast<size_t>(p * (pauses.size() - 1) + 0.5);
+      return pauses[index];
+    };
+    uint64_t total_pause_ns = 0;
+    for (uint64_t pause : pauses) {
+      total_pause_ns += pause;
+    }
+    double seconds = static_cast<double>(elapsed_ns_) / 1e9;
+    uint64_t operations = operations_.load();
+
+    os << "{\"context\":{"
+       << "\"collector\":\"" << Runtime::Current()->GetHeap()->GetForegroundCollectorName()
+       << "\",\"shape\":\"" << shape_name << "\""
+       << ",\"live_bytes\":" << num_units_ * unit_bytes_
+       << ",\"unit_bytes\":" << unit_bytes_
+       << ",\"units\":" << num_units_
+       << ",\"threads\":" << num_threads_ << "},\n"
+       << "\"pauses\":{"
+       << "\"count\":" << pauses.size()
+       << ",\"total_ns\":" << total_pause_ns
+       << ",\"p50_ns\":" << percentile(0.5)
+       << ",\"p90_ns\":" << percentile(0.9)
+       << ",\"p99_ns\":" << percentile(0.99)
+       << ",\"max_ns\":" << (pauses.empty() ? 0u : pauses.back()) << "},\n"
+       << "\"throughput\":{"
+       << "\"elapsed_ns\":" << elapsed_ns_
+       << ",\"operations\":" << operations
+       << ",\"operations_per_second\":" << operations / seconds
+       << ",\"allocated_bytes_per_second\":" << operations * GetBytesPerOperation() / seconds
+       << "},\n\"memory\":[";
+    for (size_t i = 0; i < samples_.size(); ++i) {
+      os << (i == 0 ? "\n" : ",\n")
+         << "{\"time_ms\":" << samples_[i].time_ms
+         << ",\"rss_bytes\":" << samples_[i].rss_bytes
+         << ",\"heap_bytes\":" << samples_[i].heap_bytes << "}";
+    }
+    os << "\n]}\n";
+  }
+
+ private:
+  size_t GetBytesPerOperation() const {
+    // Churn operations allocate a single small array, the other shapes a whole unit.
+    return shape_ == HeapShape::kReferenceChurn ? 0u : unit_bytes_;
+  }
+
+  void Mutate(size_t thread_index, uint64_t end_ns) {
+    JNIEnv* env;
+    CHECK_EQ(vm_->AttachCurrentThread(&env, nullptr), JNI_OK);
+    std::minstd_rand random(static_cast<uint32_t>(thread_index + 1));
+    std::uniform_int_distribution<jint> pick_unit(0, static_cast<jint>(num_units_ - 1));
+    uint64_t operations = 0;
+    // Only check the time every few operations, operations on small units are short.
+    static constexpr uint64_t kOperationsPerTimeCheck = 16;
+    do {
+      for (uint64_t i = 0; i < kOperationsPerTimeCheck; ++i) {
+        jint index = pick_unit(random);
+        if (shape_ == HeapShape::kReferenceChurn) {
+          ScopedLocalRef<jobject> target(env, env->GetObjectArrayElement(units_, index));
+          ScopedLocalRef<jobjectArray> value(
+              env, env->NewObjectArray(kChurnUnitLength / 4, object_class_, nullptr));
+          env->SetObjectArrayElement(reinterpret_cast<jobjectArray>(target.get()),
+                                     static_cast<jint>(random() % kChurnUnitLength),
+                                     value.get());
+        } else {
+          ScopedLocalRef<jobject> unit(env, NewUnit(env));
+          env->SetObjectArrayElement(units_, index, unit.get());
+        }
+      }
+      operations += kOperationsPerTimeCheck;
+    } while (NanoTime() < end_ns);
+    operations_.fetch_add(operations);
+    CHECK(!env->ExceptionCheck());
+    CHECK_EQ(vm_->DetachCurrentThread(), JNI_OK);
+  }
+
+  jobject NewUnit(JNIEnv* env) {
+    switch (shape_) {
+      case HeapShape::kLinkedList: {
+        // Each node is an Object[2] of {next, payload}.
+        ScopedLocalRef<jobjectArray> head(env, nullptr);
+        for (jint i = 0; i < kLinkedListLength; ++i) {
+          ScopedLocalRef<jobjectArray> node(env,
+                                            env->NewObjectArray(2, object_class_, head.get()));
+          ScopedLocalRef<jobject> payload(env, env->AllocObject(object_class_));
+          env->SetObjectArrayElement(node.get(), 1, payload.get());
+          head.reset(node.release());
+        }
+        return head.release();
+      }
+      case HeapShape::kWideTree: {
+        jobjectArray root = env->NewObjectArray(kTreeFanout, object_array_class_, nullptr);
+        for (jint i = 0; i < kTreeFanout; ++i) {
+          ScopedLocalRef<jobjectArray> inner(
+              env, env->NewObjectArray(kTreeFanout, object_class_, nullptr));
+          for (jint j = 0; j < kTreeFanout; ++j) {
+            ScopedLocalRef<jobject> leaf(env, env->AllocObject(object_class_));
+            env->SetObjectArrayElement(inner.get(), j, leaf.get());
+          }
+          env->SetObjectArrayElement(root, i, inner.get());
+        }
+        return root;
+      }
+      case HeapShape::kLargeArrays:
+        return env->NewByteArray(kLargeArrayLength);
+      case HeapShape::kWeakRefs: {
+        // Slots [0, kWeakRefsPerUnit) hold the references, the next half the strong referents.
+        jobjectArray unit =
+            env->NewObjectArray(kWeakRefsPerUnit + kWeakRefsPerUnit / 2, object_class_, nullptr);
+        for (jint i = 0; i < kWeakRefsPerUnit; ++i) {
+          ScopedLocalRef<jobject> referent(env, env->AllocObject(object_class_));
+          if (i % 2 == 0) {
+            env->SetObjectArrayElement(unit, kWeakRefsPerUnit + i / 2, referent.get());
+          }
+          ScopedLocalRef<jobject> reference(
+              env, env->NewObject(weak_reference_class_, weak_reference_init_, referent.get()));
+          env->SetObjectArrayElement(unit, i, reference.get());
+        }
+        return unit;
+      }
+      case HeapShape::kReferenceChurn:
+        return env->NewObjectArray(kChurnUnitLength, object_class_, nullptr);
+    }
+    LOG(FATAL) << "Unreachable";
+    UNREACHABLE();
+  }
+
+  JavaVM* const vm_;
+  const HeapShape shape_;
+  const size_t live_bytes_;
+  const size_t num_threads_;
+
+  jclass object_class_ = nullptr;
+  jclass object_array_class_ = nullptr;
+  jclass weak_reference_class_ = nullptr;
+  jmethodID weak_reference_init_ = nullptr;
+  jobjectArray units_ = nullptr;
+  size_t unit_bytes_ = 0;
+  size_t num_units_ = 0;
+
+  PauseRecorder pauses_;
+  std::atomic<uint64_t> operations_ = 0;
+  uint64_t start_ns_ = 0;
+  uint64_t elapsed_ns_ = 0;
+
+  std::mutex done_lock_;
+  std::condition_variable done_cond_;
+  bool done_ = false;
+  std::vector<MemorySample> samples_;
+};
+
+void Usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options] [-- runtime options]\n"
+          "  --shape=<shape>: the shape of the live heap, one of:\n"
+          "      linked-list, wide-tree, large-arrays, weak-refs, reference-churn\n"
+          "      Default: linked-list\n"
+          "  --live-mb=<mb>: approximate size of the live heap. Default: 64\n"
+          "  --threads=<n>: number of mutator threads. Default: 4\n"
+          "  --duration-ms=<ms>: duration of the mutation phase. Default: 10000\n"
+          "  --sample-interval-ms=<ms>: interval between memory samples. Default: 100\n"
+          "  --json=<file>: write the results to <file> instead of stdout.\n"
+          "Options after -- are passed to JNI_CreateJavaVM, for example\n"
+          "  -Xbootclasspath:<jars> -Ximage:<image> -Xgc:CMC -Xmx512m\n",
+          program);
+}
+
+int GcStressMain(int argc, char** argv) {
+  const ShapeInfo* shape = &kShapes[0];
+  size_t live_mb = 64;
+  size_t num_threads = 4;
+  uint64_t duration_ms = 10000;
+  uint64_t sample_interval_ms = 100;
+  std::string json_file;
+  std::vector<JavaVMOption> vm_options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg(argv[i]);
+    auto value = [&](const char* prefix) { return argv[i] + strlen(prefix); };
+    if (arg == "--") {
+      for (++i; i < argc; ++i) {
+        vm_options.push_back({argv[i], nullptr});
+      }
+    } else if (arg.starts_with("--shape=")) {
+      auto it = std::find_if(std::begin(kShapes), std::end(kShapes), [&](const ShapeInfo& s) {
+        return arg.substr(strlen("--shape=")) == s.name;
+      });
+      if (it == std::end(kShapes)) {
+        Usage(argv[0]);
+        return EXIT_FAILURE;
+      }
+      shape = it;
+    } else if (arg.starts_with("--live-mb=")) {
+      live_mb = strtoull(value("--live-mb="), nullptr, 10);
+    } else if (arg.starts_with("--threads=")) {
+      num_threads = std::max<size_t>(strtoull(value("--threads="), nullptr, 10), 1u);
+    } else if (arg.starts_with("--duration-ms=")) {
+      duration_ms = strtoull(value("--duration-ms="), nullptr, 10);
+    } else if (arg.starts_with("--sample-interval-ms=")) {
+      sample_interval_ms =
+          std::max<uint64_t>(strtoull(value("--sample-interval-ms="), nullptr, 10), 1u);
+    } else if (arg.starts_with("--json=")) {
+      json_file = arg.substr(strlen("--json="));
+    } else {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  JavaVMInitArgs init_args;
+  init_args.version = JNI_VERSION_1_6;
+  init_args.options = vm_options.data();
+  init_args.nOptions = static_cast<jint>(vm_options.size());
+  init_args.ignoreUnrecognized = JNI_FALSE;
+  JavaVM* vm = nullptr;
+  JNIEnv* env = nullptr;
+  if (JNI_CreateJavaVM(&vm, &env, &init_args) != JNI_OK) {
+    fprintf(stderr, "Failed to create the runtime\n");
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream json_stream;
+  std::ostream* os = &std::cout;
+  if (!json_file.empty()) {
+    json_stream.open(json_file);
+    if (!json_stream.is_open()) {
+      fprintf(stderr, "Failed to open %s\n", json_file.c_str());
+      return EXIT_FAILURE;
+    }
+    os = &json_stream;
+  }
+
+  GcStress stress(vm, shape->shape, live_mb * MB, num_threads);
+  stress.SetUp(env);
+  stress.Run(duration_ms, sample_interval_ms);
+  stress.TearDown(env);
+  stress.WriteJson(*os, shape->name);
+  os->flush();
+
+  vm->DestroyJavaVM();
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+}  // namespace art
+
+int main(int argc, char** argv) {
+  // Output all logging to stderr, stdout may be used for the results.
+  android::base::SetLogger(android::base::StderrLogger);
+
+  return art::GcStressMain(argc, argv);
+}
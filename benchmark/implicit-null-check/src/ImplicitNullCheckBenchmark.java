@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class ImplicitNullCheckBenchmark {
+    static class Holder {
+        int field = 1;
+
+        int get() {
+            return field;
+        }
+    }
+
+    // Not final, so that the compiler cannot see which accesses fault.
+    private static Holder nullHolder = null;
+    private static Holder holder = new Holder();
+
+    private static int sink;
+
+    // The field read faults in compiled code and the fault handler raises the exception.
+    private static int readField(Holder h) {
+        return h.field;
+    }
+
+    private static int callVirtual(Holder h) {
+        return h.get();
+    }
+
+    private static int readFieldExplicitCheck(Holder h) {
+        if (h == null) {
+            throw new NullPointerException();
+        }
+        return h.field;
+    }
+
+    public void timeFieldReadFaultCaught(int count) {
+        int result = 0;
+        Holder h = nullHolder;
+        for (int i = 0; i < count; ++i) {
+            try {
+                result += readField(h);
+            } catch (NullPointerException expected) {
+                result += 1;
+            }
+        }
+        sink = result;
+    }
+
+    public void timeVirtualCallFaultCaught(int count) {
+        int result = 0;
+        Holder h = nullHolder;
+        for (int i = 0; i < count; ++i) {
+            try {
+                result += callVirtual(h);
+            } catch (NullPointerException expected) {
+                result += 1;
+            }
+        }
+        sink = result;
+    }
+
+    public void timeExplicitNullCheckCaught(int count) {
+        int result = 0;
+        Holder h = nullHolder;
+        for (int i = 0; i < count; ++i) {
+            try {
+                result += readFieldExplicitCheck(h);
+            } catch (NullPointerException expected) {
+                result += 1;
+            }
+        }
+        sink = result;
+    }
+
+    public void timeFieldReadNoFault(int count) {
+        int result = 0;
+        Holder h = holder;
+        for (int i = 0; i < count; ++i) {
+            try {
+                result += readField(h);
+            } catch (NullPointerException expected) {
+                result += 1;
+            }
+        }
+        sink = result;
+    }
+}
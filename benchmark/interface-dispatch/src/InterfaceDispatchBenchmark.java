@@ -0,0 +1,595 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class InterfaceDispatchBenchmark {
+    public void timeNarrowInterfaceCall(int count) {
+        Narrow narrow = narrowImpl;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += narrow.get();
+        }
+        result = sum;
+    }
+
+    // With 256 methods in `Wide`, each IMT slot holds several conflicting methods.
+    // Calls cycle through the methods so that they do not always hit the first entry
+    // of a conflict table.
+    public void timeWideInterfaceCall(int count) {
+        Wide wide = wideImpl;
+        int sum = 0;
+        for (int i = 0; i < count; i += 8) {
+            sum += wide.m0();
+            sum += wide.m37();
+            sum += wide.m74();
+            sum += wide.m111();
+            sum += wide.m148();
+            sum += wide.m185();
+            sum += wide.m222();
+            sum += wide.m255();
+        }
+        result = sum;
+    }
+
+    // The same calls through a class that does not override the methods of `WideImpl`.
+    public void timeWideInterfaceCallSubclass(int count) {
+        Wide wide = wideSubclass;
+        int sum = 0;
+        for (int i = 0; i < count; i += 8) {
+            sum += wide.m0();
+            sum += wide.m37();
+            sum += wide.m74();
+            sum += wide.m111();
+            sum += wide.m148();
+            sum += wide.m185();
+            sum += wide.m222();
+            sum += wide.m255();
+        }
+        result = sum;
+    }
+
+    interface Narrow {
+        int get();
+    }
+
+    static class NarrowImpl implements Narrow {
+        public int get() { return 1; }
+    }
+
+    interface Wide {
+        int m0();
+        int m1();
+        int m2();
+        int m3();
+        int m4();
+        int m5();
+        int m6();
+        int m7();
+        int m8();
+        int m9();
+        int m10();
+        int m11();
+        int m12();
+        int m13();
+        int m14();
+        int m15();
+        int m16();
+        int m17();
+        int m18();
+        int m19();
+        int m20();
+        int m21();
+        int m22();
+        int m23();
+        int m24();
+        int m25();
+        int m26();
+        int m27();
+        int m28();
+        int m29();
+        int m30();
+        int m31();
+        int m32();
+        int m33();
+        int m34();
+        int m35();
+        int m36();
+        int m37();
+        int m38();
+        int m39();
+        int m40();
+        int m41();
+        int m42();
+        int m43();
+        int m44();
+        int m45();
+        int m46();
+        int m47();
+        int m48();
+        int m49();
+        int m50();
+        int m51();
+        int m52();
+        int m53();
+        int m54();
+        int m55();
+        int m56();
+        int m57();
+        int m58();
+        int m59();
+        int m60();
+        int m61();
+        int m62();
+        int m63();
+        int m64();
+        int m65();
+        int m66();
+        int m67();
+        int m68();
+        int m69();
+        int m70();
+        int m71();
+        int m72();
+        int m73();
+        int m74();
+        int m75();
+        int m76();
+        int m77();
+        int m78();
+        int m79();
+        int m80();
+        int m81();
+        int m82();
+        int m83();
+        int m84();
+        int m85();
+        int m86();
+        int m87();
+        int m88();
+        int m89();
+        int m90();
+        int m91();
+        int m92();
+        int m93();
+        int m94();
+        int m95();
+        int m96();
+        int m97();
+        int m98();
+        int m99();
+        int m100();
+        int m101();
+        int m102();
+        int m103();
+        int m104();
+        int m105();
+        int m106();
+        int m107();
+        int m108();
+        int m109();
+        int m110();
+        int m111();
+        int m112();
+        int m113();
+        int m114();
+        int m115();
+        int m116();
+        int m117();
+        int m118();
+        int m119();
+        int m120();
+        int m121();
+        int m122();
+        int m123();
+        int m124();
+        int m125();
+        int m126();
+        int m127();
+        int m128();
+        int m129();
+        int m130();
+        int m131();
+        int m132();
+        int m133();
+        int m134();
+        int m135();
+        int m136();
+        int m137();
+        int m138();
+        int m139();
+        int m140();
+        int m141();
+        int m142();
+        int m143();
+        int m144();
+        int m145();
+        int m146();
+        int m147();
+        int m148();
+        int m149();
+        int m150();
+        int m151();
+        int m152();
+        int m153();
+        int m154();
+        int m155();
+        int m156();
+        int m157();
+        int m158();
+        int m159();
+        int m160();
+        int m161();
+        int m162();
+        int m163();
+        int m164();
+        int m165();
+        int m166();
+        int m167();
+        int m168();
+        int m169();
+        int m170();
+        int m171();
+        int m172();
+        int m173();
+        int m174();
+        int m175();
+        int m176();
+        int m177();
+        int m178();
+        int m179();
+        int m180();
+        int m181();
+        int m182();
+        int m183();
+        int m184();
+        int m185();
+        int m186();
+        int m187();
+        int m188();
+        int m189();
+        int m190();
+        int m191();
+        int m192();
+        int m193();
+        int m194();
+        int m195();
+        int m196();
+        int m197();
+        int m198();
+        int m199();
+        int m200();
+        int m201();
+        int m202();
+        int m203();
+        int m204();
+        int m205();
+        int m206();
+        int m207();
+        int m208();
+        int m209();
+        int m210();
+        int m211();
+        int m212();
+        int m213();
+        int m214();
+        int m215();
+        int m216();
+        int m217();
+        int m218();
+        int m219();
+        int m220();
+        int m221();
+        int m222();
+        int m223();
+        int m224();
+        int m225();
+        int m226();
+        int m227();
+        int m228();
+        int m229();
+        int m230();
+        int m231();
+        int m232();
+        int m233();
+        int m234();
+        int m235();
+        int m236();
+        int m237();
+        int m238();
+        int m239();
+        int m240();
+        int m241();
+        int m242();
+        int m243();
+        int m244();
+        int m245();
+        int m246();
+        int m247();
+        int m248();
+        int m249();
+        int m250();
+        int m251();
+        int m252();
+        int m253();
+        int m254();
+        int m255();
+    }
+
+    static class WideImpl implements Wide {
+        public int m0() { return 0; }
+        public int m1() { return 1; }
+        public int m2() { return 2; }
+        public int m3() { return 3; }
+        public int m4() { return 4; }
+        public int m5() { return 5; }
+        public int m6() { return 6; }
+        public int m7() { return 7; }
+        public int m8() { return 8; }
+        public int m9() { return 9; }
+        public int m10() { return 10; }
+        public int m11() { return 11; }
+        public int m12() { return 12; }
+        public int m13() { return 13; }
+        public int m14() { return 14; }
+        public int m15() { return 15; }
+        public int m16() { return 16; }
+        public int m17() { return 17; }
+        public int m18() { return 18; }
+        public int m19() { return 19; }
+        public int m20() { return 20; }
+        public int m21() { return 21; }
+        public int m22() { return 22; }
+        public int m23() { return 23; }
+        public int m24() { return 24; }
+        public int m25() { return 25; }
+        public int m26() { return 26; }
+        public int m27() { return 27; }
+        public int m28() { return 28; }
+        public int m29() { return 29; }
+        public int m30() { return 30; }
+        public int m31() { return 31; }
+        public int m32() { return 32; }
+        public int m33() { return 33; }
+        public int m34() { return 34; }
+        public int m35() { return 35; }
+        public int m36() { return 36; }
+        public int m37() { return 37; }
+        public int m38() { return 38; }
+        public int m39() { return 39; }
+        public int m40() { return 40; }
+        public int m41() { return 41; }
+        public int m42() { return 42; }
+        public int m43() { return 43; }
+        public int m44() { return 44; }
+        public int m45() { return 45; }
+        public int m46() { return 46; }
+        public int m47() { return 47; }
+        public int m48() { return 48; }
+        public int m49() { return 49; }
+        public int m50() { return 50; }
+        public int m51() { return 51; }
+        public int m52() { return 52; }
+        public int m53() { return 53; }
+        public int m54() { return 54; }
+        public int m55() { return 55; }
+        public int m56() { return 56; }
+        public int m57() { return 57; }
+        public int m58() { return 58; }
+        public int m59() { return 59; }
+        public int m60() { return 60; }
+        public int m61() { return 61; }
+        public int m62() { return 62; }
+        public int m63() { return 63; }
+        public int m64() { return 64; }
+        public int m65() { return 65; }
+        public int m66() { return 66; }
+        public int m67() { return 67; }
+        public int m68() { return 68; }
+        public int m69() { return 69; }
+        public int m70() { return 70; }
+        public int m71() { return 71; }
+        public int m72() { return 72; }
+        public int m73() { return 73; }
+        public int m74() { return 74; }
+        public int m75() { return 75; }
+        public int m76() { return 76; }
+        public int m77() { return 77; }
+        public int m78() { return 78; }
+        public int m79() { return 79; }
+        public int m80() { return 80; }
+        public int m81() { return 81; }
+        public int m82() { return 82; }
+        public int m83() { return 83; }
+        public int m84() { return 84; }
+        public int m85() { return 85; }
+        public int m86() { return 86; }
+        public int m87() { return 87; }
+        public int m88() { return 88; }
+        public int m89() { return 89; }
+        public int m90() { return 90; }
+        public int m91() { return 91; }
+        public int m92() { return 92; }
+        public int m93() { return 93; }
+        public int m94() { return 94; }
+        public int m95() { return 95; }
+        public int m96() { return 96; }
+        public int m97() { return 97; }
+        public int m98() { return 98; }
+        public int m99() { return 99; }
+        public int m100() { return 100; }
+        public int m101() { return 101; }
+        public int m102() { return 102; }
+        public int m103() { return 103; }
+        public int m104() { return 104; }
+        public int m105() { return 105; }
+        public int m106() { return 106; }
+        public int m107() { return 107; }
+        public int m108() { return 108; }
+        public int m109() { return 109; }
+        public int m110() { return 110; }
+        public int m111() { return 111; }
+        public int m112() { return 112; }
+        public int m113() { return 113; }
+        public int m114() { return 114; }
+        public int m115() { return 115; }
+        public int m116() { return 116; }
+        public int m117() { return 117; }
+        public int m118() { return 118; }
+        public int m119() { return 119; }
+        public int m120() { return 120; }
+        public int m121() { return 121; }
+        public int m122() { return 122; }
+        public int m123() { return 123; }
+        public int m124() { return 124; }
+        public int m125() { return 125; }
+        public int m126() { return 126; }
+        public int m127() { return 127; }
+        public int m128() { return 128; }
+        public int m129() { return 129; }
+        public int m130() { return 130; }
+        public int m131() { return 131; }
+        public int m132() { return 132; }
+        public int m133() { return 133; }
+        public int m134() { return 134; }
+        public int m135() { return 135; }
+        public int m136() { return 136; }
+        public int m137() { return 137; }
+        public int m138() { return 138; }
+        public int m139() { return 139; }
+        public int m140() { return 140; }
+        public int m141() { return 141; }
+        public int m142() { return 142; }
+        public int m143() { return 143; }
+        public int m144() { return 144; }
+        public int m145() { return 145; }
+        public int m146() { return 146; }
+        public int m147() { return 147; }
+        public int m148() { return 148; }
+        public int m149() { return 149; }
+        public int m150() { return 150; }
+        public int m151() { return 151; }
+        public int m152() { return 152; }
+        public int m153() { return 153; }
+        public int m154() { return 154; }
+        public int m155() { return 155; }
+        public int m156() { return 156; }
+        public int m157() { return 157; }
+        public int m158() { return 158; }
+        public int m159() { return 159; }
+        public int m160() { return 160; }
+        public int m161() { return 161; }
+        public int m162() { return 162; }
+        public int m163() { return 163; }
+        public int m164() { return 164; }
+        public int m165() { return 165; }
+        public int m166() { return 166; }
+        public int m167() { return 167; }
+        public int m168() { return 168; }
+        public int m169() { return 169; }
+        public int m170() { return 170; }
+        public int m171() { return 171; }
+        public int m172() { return 172; }
+        public int m173() { return 173; }
+        public int m174() { return 174; }
+        public int m175() { return 175; }
+        public int m176() { return 176; }
+        public int m177() { return 177; }
+        public int m178() { return 178; }
+        public int m179() { return 179; }
+        public int m180() { return 180; }
+        public int m181() { return 181; }
+        public int m182() { return 182; }
+        public int m183() { return 183; }
+        public int m184() { return 184; }
+        public int m185() { return 185; }
+        public int m186() { return 186; }
+        public int m187() { return 187; }
+        public int m188() { return 188; }
+        public int m189() { return 189; }
+        public int m190() { return 190; }
+        public int m191() { return 191; }
+        public int m192() { return 192; }
+        public int m193() { return 193; }
+        public int m194() { return 194; }
+        public int m195() { return 195; }
+        public int m196() { return 196; }
+        public int m197() { return 197; }
+        public int m198() { return 198; }
+        public int m199() { return 199; }
+        public int m200() { return 200; }
+        public int m201() { return 201; }
+        public int m202() { return 202; }
+        public int m203() { return 203; }
+        public int m204() { return 204; }
+        public int m205() { return 205; }
+        public int m206() { return 206; }
+        public int m207() { return 207; }
+        public int m208() { return 208; }
+        public int m209() { return 209; }
+        public int m210() { return 210; }
+        public int m211() { return 211; }
+        public int m212() { return 212; }
+        public int m213() { return 213; }
+        public int m214() { return 214; }
+        public int m215() { return 215; }
+        public int m216() { return 216; }
+        public int m217() { return 217; }
+        public int m218() { return 218; }
+        public int m219() { return 219; }
+        public int m220() { return 220; }
+        public int m221() { return 221; }
+        public int m222() { return 222; }
+        public int m223() { return 223; }
+        public int m224() { return 224; }
+        public int m225() { return 225; }
+        public int m226() { return 226; }
+        public int m227() { return 227; }
+        public int m228() { return 228; }
+        public int m229() { return 229; }
+        public int m230() { return 230; }
+        public int m231() { return 231; }
+        public int m232() { return 232; }
+        public int m233() { return 233; }
+        public int m234() { return 234; }
+        public int m235() { return 235; }
+        public int m236() { return 236; }
+        public int m237() { return 237; }
+        public int m238() { return 238; }
+        public int m239() { return 239; }
+        public int m240() { return 240; }
+        public int m241() { return 241; }
+        public int m242() { return 242; }
+        public int m243() { return 243; }
+        public int m244() { return 244; }
+        public int m245() { return 245; }
+        public int m246() { return 246; }
+        public int m247() { return 247; }
+        public int m248() { return 248; }
+        public int m249() { return 249; }
+        public int m250() { return 250; }
+        public int m251() { return 251; }
+        public int m252() { return 252; }
+        public int m253() { return 253; }
+        public int m254() { return 254; }
+        public int m255() { return 255; }
+    }
+
+    static class WideSubclass extends WideImpl {}
+
+    Narrow narrowImpl = new NarrowImpl();
+    Wide wideImpl = new WideImpl();
+    Wide wideSubclass = new WideSubclass();
+    int result;
+}
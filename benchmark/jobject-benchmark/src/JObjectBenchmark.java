@@ -15,6 +15,8 @@
  */
 
 public class JObjectBenchmark {
+  private static final int CONTENDING_THREADS = 4;
+
   public JObjectBenchmark() {
     // Make sure to link methods before benchmark starts.
     System.loadLibrary("artbenchmark");
@@ -34,4 +36,16 @@ public class JObjectBenchmark {
   public native void timeAddRemoveWeakGlobal(int reps);
   public native void timeDecodeWeakGlobal(int reps);
   public native void timeDecodeHandleScopeRef(int reps);
+
+  // Add and remove global references on several threads at the same time.
+  public void timeAddRemoveGlobalContended(int reps) throws InterruptedException {
+    Thread[] threads = new Thread[CONTENDING_THREADS];
+    for (int i = 0; i < threads.length; ++i) {
+      threads[i] = new Thread(() -> timeAddRemoveGlobal(reps));
+      threads[i].start();
+    }
+    for (Thread thread : threads) {
+      thread.join();
+    }
+  }
 }
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+public class MultiArrayBenchmark {
+    private static Object sink;
+
+    public void timeNewDoubleMatrix4x4(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new double[4][4];
+        }
+    }
+
+    public void timeNewDoubleMatrix64x64(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new double[64][64];
+        }
+    }
+
+    public void timeNewDoubleCube16(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink = new double[16][16][16];
+        }
+    }
+
+    public void timeNewDoubleRows64x64(int count) {
+        for (int i = 0; i < count; ++i) {
+            double[][] matrix = new double[64][];
+            for (int j = 0; j < matrix.length; ++j) {
+                matrix[j] = new double[64];
+            }
+            sink = matrix;
+        }
+    }
+}
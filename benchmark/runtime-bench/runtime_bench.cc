@@ -0,0 +1,659 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "android-base/logging.h"
+#include "android-base/stringprintf.h"
+#include "arch/instruction_set.h"
+#include "base/time_utils.h"
+#include "class_linker-inl.h"
+#include "class_root-inl.h"
+#include "gc/gc_pause_listener.h"
+#include "gc/heap.h"
+#include "gc/space/space.h"
+#include "intern_table.h"
+#include "jni.h"
+#include "jni/jni_internal.h"
+#include "mirror/array-alloc-inl.h"
+#include "mirror/array-inl.h"
+#include "mirror/class-inl.h"
+#include "mirror/string-inl.h"
+#include "nativehelper/scoped_local_ref.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-current-inl.h"
+
+// A microbenchmark suite for runtime operations that are hard to measure from Java benchmarks
+// alone: allocation in each space, GC pauses, class lookup, monitors, JNI transitions, interface
+// dispatch, string interning and reflection. The runtime is created with JNI_CreateJavaVM and the
+// results are written as JSON so that they can be collected for every build and compared.
+
+namespace art {
+
+namespace {
+
+class RuntimeBenchmark {
+ public:
+  explicit RuntimeBenchmark(const char* name) : name_(name) {}
+  virtual ~RuntimeBenchmark() {}
+
+  const char* GetName() const { return name_; }
+
+  virtual void SetUp([[maybe_unused]] JNIEnv* env) {}
+  // Runs `iterations` operations. Called several times to find how many iterations fit the
+  // minimum time, only the last call is reported.
+  virtual void Run(JNIEnv* env, size_t iterations) = 0;
+  virtual void TearDown([[maybe_unused]] JNIEnv* env) {}
+
+  // Bytes allocated or processed by one iteration, used to report a throughput. 0 if unused.
+  virtual size_t GetBytesPerIteration() const { return 0; }
+
+  // Appends benchmark specific fields, as `,"key":value`, to the JSON result.
+  virtual void WriteExtraFields([[maybe_unused]] std::ostream& os) const {}
+
+ private:
+  const char* const name_;
+};
+
+// Allocates byte arrays of a given length, which determines the space they are allocated in. The
+// space actually used is reported, so that a change of space is not mistaken for a regression.
+class AllocationBenchmark final : public RuntimeBenchmark {
+ public:
+  AllocationBenchmark(const char* name, int32_t length, bool non_moving)
+      : RuntimeBenchmark(name), length_(length), non_moving_(non_moving) {}
+
+  void SetUp(JNIEnv* env) override {
+    ScopedObjectAccess soa(env);
+    ObjPtr<mirror::Array> array = Allocate(soa.Self());
+    CHECK(array != nullptr);
+    space_name_ =
+        Runtime::Current()->GetHeap()->FindSpaceFromObject(array, /*fail_ok=*/ false)->GetName();
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    ScopedObjectAccess soa(env);
+    for (size_t i = 0; i < iterations; ++i) {
+      CHECK(Allocate(soa.Self()) != nullptr);
+    }
+  }
+
+  size_t GetBytesPerIteration() const override { return static_cast<size_t>(length_); }
+
+  void WriteExtraFields(std::ostream& os) const override {
+    os << ",\"space\":\"" << space_name_ << "\"";
+  }
+
+ private:
+  ObjPtr<mirror::Array> Allocate(Thread* self) REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (non_moving_) {
+      return mirror::Array::Alloc(self,
+                                  GetClassRoot<mirror::ByteArray>(),
+                                  length_,
+                                  /*component_size_shift=*/ 0u,
+                                  gc::kAllocatorTypeNonMoving);
+    }
+    return mirror::ByteArray::Alloc(self, length_);
+  }
+
+  const int32_t length_;
+  const bool non_moving_;
+  std::string space_name_;
+};
+
+// Runs explicit GCs with a live set of small objects and records the pauses of the collector the
+// runtime was started with, see -Xgc.
+class GcPauseBenchmark final : public RuntimeBenchmark, public gc::GcPauseListener {
+ public:
+  GcPauseBenchmark() : RuntimeBenchmark("gc/explicit") {}
+
+  void SetUp(JNIEnv* env) override {
+    static constexpr jint kLiveObjects = 64 * 1024;
+    ScopedLocalRef<jclass> object_class(env, env->FindClass("java/lang/Object"));
+    ScopedLocalRef<jobjectArray> live(
+        env, env->NewObjectArray(kLiveObjects, object_class.get(), nullptr));
+    for (jint i = 0; i < kLiveObjects; ++i) {
+      ScopedLocalRef<jobject> obj(env, env->AllocObject(object_class.get()));
+      env->SetObjectArrayElement(live.get(), i, obj.get());
+    }
+    live_set_ = env->NewGlobalRef(live.get());
+    Runtime::Current()->GetHeap()->SetGcPauseListener(this);
+  }
+
+  void Run([[maybe_unused]] JNIEnv* env, size_t iterations) override {
+    {
+      std::lock_guard<std::mutex> lock(pauses_lock_);
+      pauses_ns_.clear();
+    }
+    for (size_t i = 0; i < iterations; ++i) {
+      Runtime::Current()->GetHeap()->CollectGarbage(/*clear_soft_references=*/ false);
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    Runtime::Current()->GetHeap()->RemoveGcPauseListener();
+    env->DeleteGlobalRef(live_set_);
+  }
+
+  void WriteExtraFields(std::ostream& os) const override {
+    std::lock_guard<std::mutex> lock(pauses_lock_);
+    uint64_t total = 0;
+    uint64_t max = 0;
+    for (uint64_t pause : pauses_ns_) {
+      total += pause;
+      max = std::max(max, pause);
+    }
+    double mean = pauses_ns_.empty() ? 0.0 : static_cast<double>(total) / pauses_ns_.size();
+    os << ",\"pause_count\":" << pauses_ns_.size()
+       << ",\"pause_ns_mean\":" << mean
+       << ",\"pause_ns_max\":" << max;
+  }
+
+  // Called by the GC thread while the mutators are suspended.
+  void StartPause() override {
+    pause_start_ns_ = NanoTime();
+  }
+
+  void EndPause() override {
+    std::lock_guard<std::mutex> lock(pauses_lock_);
+    pauses_ns_.push_back(NanoTime() - pause_start_ns_);
+  }
+
+ private:
+  jobject live_set_ = nullptr;
+  uint64_t pause_start_ns_ = 0;
+  mutable std::mutex pauses_lock_;
+  std::vector<uint64_t> pauses_ns_;
+};
+
+// Looks up boot classes that are already loaded, which is the common case for FindClass calls.
+class FindClassBenchmark final : public RuntimeBenchmark {
+ public:
+  FindClassBenchmark() : RuntimeBenchmark("class_linker/find_class") {}
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    static constexpr const char* kDescriptors[] = {
+        "Ljava/lang/String;",
+        "Ljava/util/HashMap;",
+        "Ljava/util/concurrent/ConcurrentHashMap;",
+        "[Ljava/lang/Object;",
+    };
+    ScopedObjectAccess soa(env);
+    ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+    for (size_t i = 0; i < iterations; ++i) {
+      const char* descriptor = kDescriptors[i % arraysize(kDescriptors)];
+      CHECK(class_linker->FindSystemClass(soa.Self(), descriptor) != nullptr);
+    }
+  }
+};
+
+// Same as above, through JNI FindClass which also goes through the caller's class loader.
+class JniFindClassBenchmark final : public RuntimeBenchmark {
+ public:
+  JniFindClassBenchmark() : RuntimeBenchmark("jni/find_class") {}
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    for (size_t i = 0; i < iterations; ++i) {
+      ScopedLocalRef<jclass> klass(env, env->FindClass("java/util/HashMap"));
+      CHECK(klass.get() != nullptr);
+    }
+  }
+};
+
+// Enters and exits the monitor of a shared object on `num_threads` threads at the same time. One
+// iteration is one enter/exit pair on each thread.
+class MonitorBenchmark final : public RuntimeBenchmark {
+ public:
+  MonitorBenchmark(const char* name, size_t num_threads)
+      : RuntimeBenchmark(name), num_threads_(num_threads) {}
+
+  void SetUp(JNIEnv* env) override {
+    ScopedLocalRef<jclass> object_class(env, env->FindClass("java/lang/Object"));
+    ScopedLocalRef<jobject> lock(env, env->AllocObject(object_class.get()));
+    lock_ = env->NewGlobalRef(lock.get());
+    CHECK(env->GetJavaVM(&vm_) == JNI_OK);
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    std::atomic<size_t> ready(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads_; ++t) {
+      threads.emplace_back([&]() {
+        JNIEnv* thread_env;
+        CHECK(vm_->AttachCurrentThread(&thread_env, nullptr) == JNI_OK);
+        ready.fetch_add(1);
+        EnterAndExit(thread_env, iterations);
+        CHECK(vm_->DetachCurrentThread() == JNI_OK);
+      });
+    }
+    // Start contending once the other threads are attached, so that attaching is not measured.
+    while (ready.load() != num_threads_ - 1) {
+      std::this_thread::yield();
+    }
+    EnterAndExit(env, iterations);
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    env->DeleteGlobalRef(lock_);
+  }
+
+  void WriteExtraFields(std::ostream& os) const override {
+    os << ",\"threads\":" << num_threads_;
+  }
+
+ private:
+  void EnterAndExit(JNIEnv* env, size_t iterations) {
+    for (size_t i = 0; i < iterations; ++i) {
+      CHECK_EQ(env->MonitorEnter(lock_), JNI_OK);
+      CHECK_EQ(env->MonitorExit(lock_), JNI_OK);
+    }
+  }
+
+  const size_t num_threads_;
+  JavaVM* vm_ = nullptr;
+  jobject lock_ = nullptr;
+};
+
+// Calls a static Java method, Math.abs(int), through JNI.
+class JniCallJavaBenchmark final : public RuntimeBenchmark {
+ public:
+  JniCallJavaBenchmark() : RuntimeBenchmark("jni/call_static_java") {}
+
+  void SetUp(JNIEnv* env) override {
+    math_class_ = reinterpret_cast<jclass>(env->NewGlobalRef(env->FindClass("java/lang/Math")));
+    abs_ = env->GetStaticMethodID(math_class_, "abs", "(I)I");
+    CHECK(abs_ != nullptr);
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    for (size_t i = 0; i < iterations; ++i) {
+      CHECK_GE(env->CallStaticIntMethod(math_class_, abs_, static_cast<jint>(-i)), 0);
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    env->DeleteGlobalRef(math_class_);
+  }
+
+ private:
+  jclass math_class_ = nullptr;
+  jmethodID abs_ = nullptr;
+};
+
+// Calls a native method, System.nanoTime(), through JNI, i.e. a native to managed to native round
+// trip.
+class JniCallNativeBenchmark final : public RuntimeBenchmark {
+ public:
+  JniCallNativeBenchmark() : RuntimeBenchmark("jni/call_static_native") {}
+
+  void SetUp(JNIEnv* env) override {
+    system_class_ =
+        reinterpret_cast<jclass>(env->NewGlobalRef(env->FindClass("java/lang/System")));
+    nano_time_ = env->GetStaticMethodID(system_class_, "nanoTime", "()J");
+    CHECK(nano_time_ != nullptr);
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    for (size_t i = 0; i < iterations; ++i) {
+      env->CallStaticLongMethod(system_class_, nano_time_);
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    env->DeleteGlobalRef(system_class_);
+  }
+
+ private:
+  jclass system_class_ = nullptr;
+  jmethodID nano_time_ = nullptr;
+};
+
+// Resolves an interface method for a receiver class, as done by the runtime when dispatching
+// through an IMT conflict, and calls an interface method through JNI.
+class InterfaceDispatchBenchmark final : public RuntimeBenchmark {
+ public:
+  explicit InterfaceDispatchBenchmark(bool through_jni)
+      : RuntimeBenchmark(through_jni ? "dispatch/interface_jni" : "dispatch/interface_resolve"),
+        through_jni_(through_jni) {}
+
+  void SetUp(JNIEnv* env) override {
+    ScopedLocalRef<jclass> list_class(env, env->FindClass("java/util/List"));
+    size_ = env->GetMethodID(list_class.get(), "size", "()I");
+    CHECK(size_ != nullptr);
+    ScopedLocalRef<jclass> array_list_class(env, env->FindClass("java/util/ArrayList"));
+    jmethodID init = env->GetMethodID(array_list_class.get(), "<init>", "()V");
+    ScopedLocalRef<jobject> list(env, env->NewObject(array_list_class.get(), init));
+    receiver_ = env->NewGlobalRef(list.get());
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    if (through_jni_) {
+      for (size_t i = 0; i < iterations; ++i) {
+        CHECK_EQ(env->CallIntMethod(receiver_, size_), 0);
+      }
+      return;
+    }
+    ScopedObjectAccess soa(env);
+    ArtMethod* interface_method = jni::DecodeArtMethod(size_);
+    ObjPtr<mirror::Class> klass = soa.Decode<mirror::Object>(receiver_)->GetClass();
+    for (size_t i = 0; i < iterations; ++i) {
+      CHECK(klass->FindVirtualMethodForInterface(interface_method, kRuntimePointerSize) !=
+            nullptr);
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    env->DeleteGlobalRef(receiver_);
+  }
+
+ private:
+  const bool through_jni_;
+  jmethodID size_ = nullptr;
+  jobject receiver_ = nullptr;
+};
+
+// Interns strings whose value is already in the intern table, but which are not the interned
+// instance themselves.
+class StringInternBenchmark final : public RuntimeBenchmark {
+ public:
+  StringInternBenchmark() : RuntimeBenchmark("string/intern") {}
+
+  void SetUp(JNIEnv* env) override {
+    static constexpr size_t kStrings = 1024;
+    ScopedObjectAccess soa(env);
+    InternTable* intern_table = Runtime::Current()->GetInternTable();
+    for (size_t i = 0; i < kStrings; ++i) {
+      std::string value = android::base::StringPrintf("runtime-bench-string-%zu", i);
+      CHECK(intern_table->InternStrong(value.c_str()) != nullptr);
+      ObjPtr<mirror::String> copy =
+          mirror::String::AllocFromModifiedUtf8(soa.Self(), value.c_str());
+      CHECK(copy != nullptr);
+      strings_.push_back(soa.Vm()->AddGlobalRef(soa.Self(), copy));
+    }
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    ScopedObjectAccess soa(env);
+    InternTable* intern_table = Runtime::Current()->GetInternTable();
+    for (size_t i = 0; i < iterations; ++i) {
+      ObjPtr<mirror::String> s = soa.Decode<mirror::String>(strings_[i % strings_.size()]);
+      CHECK(intern_table->InternStrong(s) != s);
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    for (jobject s : strings_) {
+      env->DeleteGlobalRef(s);
+    }
+    strings_.clear();
+  }
+
+ private:
+  std::vector<jobject> strings_;
+};
+
+// Looks up a method by name and invokes it through java.lang.reflect.Method.
+class ReflectionBenchmark final : public RuntimeBenchmark {
+ public:
+  explicit ReflectionBenchmark(bool invoke)
+      : RuntimeBenchmark(invoke ? "reflection/method_invoke" : "reflection/get_declared_method"),
+        invoke_(invoke) {}
+
+  void SetUp(JNIEnv* env) override {
+    ScopedLocalRef<jclass> class_class(env, env->FindClass("java/lang/Class"));
+    get_declared_method_ = env->GetMethodID(
+        class_class.get(), "getDeclaredMethod", "(Ljava/lang/String;[Ljava/lang/Class;)"
+        "Ljava/lang/reflect/Method;");
+    ScopedLocalRef<jclass> method_class(env, env->FindClass("java/lang/reflect/Method"));
+    invoke_method_ = env->GetMethodID(
+        method_class.get(), "invoke", "(Ljava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;");
+    CHECK(get_declared_method_ != nullptr);
+    CHECK(invoke_method_ != nullptr);
+
+    ScopedLocalRef<jclass> integer_class(env, env->FindClass("java/lang/Integer"));
+    integer_class_ = reinterpret_cast<jclass>(env->NewGlobalRef(integer_class.get()));
+    jfieldID type_field = env->GetStaticFieldID(integer_class.get(), "TYPE", "Ljava/lang/Class;");
+    ScopedLocalRef<jobject> int_class(env,
+                                      env->GetStaticObjectField(integer_class.get(), type_field));
+    ScopedLocalRef<jobjectArray> parameter_types(
+        env, env->NewObjectArray(1, class_class.get(), int_class.get()));
+    parameter_types_ = env->NewGlobalRef(parameter_types.get());
+    ScopedLocalRef<jstring> name(env, env->NewStringUTF("signum"));
+    name_ = env->NewGlobalRef(name.get());
+
+    jmethodID value_of =
+        env->GetStaticMethodID(integer_class.get(), "valueOf", "(I)Ljava/lang/Integer;");
+    ScopedLocalRef<jobject> boxed(env,
+                                  env->CallStaticObjectMethod(integer_class.get(), value_of, 42));
+    ScopedLocalRef<jclass> object_class(env, env->FindClass("java/lang/Object"));
+    ScopedLocalRef<jobjectArray> arguments(
+        env, env->NewObjectArray(1, object_class.get(), boxed.get()));
+    arguments_ = env->NewGlobalRef(arguments.get());
+    ScopedLocalRef<jobject> method(env, GetDeclaredMethod(env));
+    method_ = env->NewGlobalRef(method.get());
+  }
+
+  void Run(JNIEnv* env, size_t iterations) override {
+    for (size_t i = 0; i < iterations; ++i) {
+      ScopedLocalRef<jobject> result(
+          env,
+          invoke_ ? env->CallObjectMethod(method_, invoke_method_, nullptr, arguments_)
+                  : GetDeclaredMethod(env));
+      CHECK(result.get() != nullptr);
+    }
+  }
+
+  void TearDown(JNIEnv* env) override {
+    env->DeleteGlobalRef(method_);
+    env->DeleteGlobalRef(arguments_);
+    env->DeleteGlobalRef(name_);
+    env->DeleteGlobalRef(parameter_types_);
+    env->DeleteGlobalRef(integer_class_);
+  }
+
+ private:
+  jobject GetDeclaredMethod(JNIEnv* env) {
+    return env->CallObjectMethod(integer_class_, get_declared_method_, name_, parameter_types_);
+  }
+
+  const bool invoke_;
+  jmethodID get_declared_method_ = nullptr;
+  jmethodID invoke_method_ = nullptr;
+  jclass integer_class_ = nullptr;
+  jobject parameter_types_ = nullptr;
+  jobject name_ = nullptr;
+  jobject arguments_ = nullptr;
+  jobject method_ = nullptr;
+};
+
+std::vector<std::unique_ptr<RuntimeBenchmark>> CreateBenchmarks() {
+  std::vector<std::unique_ptr<RuntimeBenchmark>> benchmarks;
+  benchmarks.emplace_back(new AllocationBenchmark("alloc/small", 16, /*non_moving=*/ false));
+  benchmarks.emplace_back(new AllocationBenchmark("alloc/medium", 4 * KB, /*non_moving=*/ false));
+  // Well above the default large object threshold.
+  benchmarks.emplace_back(new AllocationBenchmark("alloc/large", 64 * KB, /*non_moving=*/ false));
+  benchmarks.emplace_back(new AllocationBenchmark("alloc/non_moving", 16, /*non_moving=*/ true));
+  benchmarks.emplace_back(new GcPauseBenchmark());
+  benchmarks.emplace_back(new FindClassBenchmark());
+  benchmarks.emplace_back(new JniFindClassBenchmark());
+  benchmarks.emplace_back(new MonitorBenchmark("monitor/uncontended", /*num_threads=*/ 1));
+  benchmarks.emplace_back(new MonitorBenchmark("monitor/contended", /*num_threads=*/ 4));
+  benchmarks.emplace_back(new JniCallJavaBenchmark());
+  benchmarks.emplace_back(new JniCallNativeBenchmark());
+  benchmarks.emplace_back(new InterfaceDispatchBenchmark(/*through_jni=*/ false));
+  benchmarks.emplace_back(new InterfaceDispatchBenchmark(/*through_jni=*/ true));
+  benchmarks.emplace_back(new StringInternBenchmark());
+  benchmarks.emplace_back(new ReflectionBenchmark(/*invoke=*/ false));
+  benchmarks.emplace_back(new ReflectionBenchmark(/*invoke=*/ true));
+  return benchmarks;
+}
+
+struct BenchmarkResult {
+  size_t iterations;
+  uint64_t elapsed_ns;
+};
+
+// Like Google Benchmark, grows the number of iterations until a run takes at least `min_time_ns`.
+BenchmarkResult RunBenchmark(RuntimeBenchmark* benchmark, JNIEnv* env, uint64_t min_time_ns) {
+  static constexpr size_t kMaxIterations = 1000 * 1000 * 1000;
+  size_t iterations = 1;
+  while (true) {
+    uint64_t start_ns = NanoTime();
+    benchmark->Run(env, iterations);
+    uint64_t elapsed_ns = NanoTime() - start_ns;
+    if (elapsed_ns >= min_time_ns || iterations >= kMaxIterations) {
+      return {iterations, elapsed_ns};
+    }
+    // Aim slightly above the minimum time, but grow by at most 10x based on a short run.
+    double multiplier = (elapsed_ns == 0)
+        ? 10.0
+        : std::min(10.0, 1.4 * static_cast<double>(min_time_ns) / elapsed_ns);
+    iterations = std::min(kMaxIterations,
+                          std::max(iterations + 1, static_cast<size_t>(iterations * multiplier)));
+  }
+}
+
+void Usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options] [-- runtime options]\n"
+          "  --filter=<substring>: only run the benchmarks whose name contains <substring>.\n"
+          "  --min-time-ms=<ms>: minimum duration of the measured run of each benchmark.\n"
+          "      Default: 500\n"
+          "  --json=<file>: write the results to <file> instead of stdout.\n"
+          "  --list: list the benchmarks and exit.\n"
+          "Options after -- are passed to JNI_CreateJavaVM, for example\n"
+          "  -Xbootclasspath:<jars> -Ximage:<image> -Xgc:CMC\n",
+          program);
+}
+
+int RuntimeBenchMain(int argc, char** argv) {
+  std::string filter;
+  uint64_t min_time_ms = 500;
+  std::string json_file;
+  bool list = false;
+  std::vector<JavaVMOption> vm_options;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg(argv[i]);
+    if (arg == "--") {
+      for (++i; i < argc; ++i) {
+        vm_options.push_back({argv[i], nullptr});
+      }
+    } else if (arg.starts_with("--filter=")) {
+      filter = arg.substr(strlen("--filter="));
+    } else if (arg.starts_with("--min-time-ms=")) {
+      min_time_ms = strtoull(argv[i] + strlen("--min-time-ms="), nullptr, 10);
+    } else if (arg.starts_with("--json=")) {
+      json_file = arg.substr(strlen("--json="));
+    } else if (arg == "--list") {
+      list = true;
+    } else {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<std::unique_ptr<RuntimeBenchmark>> benchmarks = CreateBenchmarks();
+  if (list) {
+    for (const std::unique_ptr<RuntimeBenchmark>& benchmark : benchmarks) {
+      printf("%s\n", benchmark->GetName());
+    }
+    return EXIT_SUCCESS;
+  }
+
+  JavaVMInitArgs init_args;
+  init_args.version = JNI_VERSION_1_6;
+  init_args.options = vm_options.data();
+  init_args.nOptions = static_cast<jint>(vm_options.size());
+  init_args.ignoreUnrecognized = JNI_FALSE;
+  JavaVM* vm = nullptr;
+  JNIEnv* env = nullptr;
+  if (JNI_CreateJavaVM(&vm, &env, &init_args) != JNI_OK) {
+    fprintf(stderr, "Failed to create the runtime\n");
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream json_stream;
+  std::ostream* os = &std::cout;
+  if (!json_file.empty()) {
+    json_stream.open(json_file);
+    if (!json_stream.is_open()) {
+      fprintf(stderr, "Failed to open %s\n", json_file.c_str());
+      return EXIT_FAILURE;
+    }
+    os = &json_stream;
+  }
+
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  *os << "{\"context\":{"
+      << "\"isa\":\"" << GetInstructionSetString(kRuntimeISA) << "\","
+      << "\"collector\":\"" << heap->GetForegroundCollectorName() << "\","
+      << "\"min_time_ms\":" << min_time_ms << "},\n\"benchmarks\":[";
+  bool first = true;
+  for (const std::unique_ptr<RuntimeBenchmark>& benchmark : benchmarks) {
+    if (std::string_view(benchmark->GetName()).find(filter) == std::string_view::npos) {
+      continue;
+    }
+    benchmark->SetUp(env);
+    BenchmarkResult result = RunBenchmark(benchmark.get(), env, MsToNs(min_time_ms));
+    double ns_per_op = static_cast<double>(result.elapsed_ns) / result.iterations;
+    *os << (first ? "\n" : ",\n")
+        << "{\"name\":\"" << benchmark->GetName() << "\","
+        << "\"iterations\":" << result.iterations << ","
+        << "\"real_time_ns\":" << result.elapsed_ns << ","
+        << "\"ns_per_op\":" << ns_per_op;
+    if (benchmark->GetBytesPerIteration() != 0) {
+      *os << ",\"bytes_per_second\":"
+          << benchmark->GetBytesPerIteration() * (1e9 / ns_per_op);
+    }
+    benchmark->WriteExtraFields(*os);
+    *os << "}";
+    benchmark->TearDown(env);
+    first = false;
+    CHECK(!env->ExceptionCheck()) << benchmark->GetName() << " left an exception pending";
+  }
+  *os << "\n]}\n";
+  os->flush();
+
+  vm->DestroyJavaVM();
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+}  // namespace art
+
+int main(int argc, char** argv) {
+  // Output all logging to stderr, stdout may be used for the results.
+  android::base::SetLogger(android::base::StderrLogger);
+
+  return art::RuntimeBenchMain(argc, argv);
+}
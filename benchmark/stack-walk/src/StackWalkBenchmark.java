@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class StackWalkBenchmark {
+    private static final int DEPTH = 32;
+
+    private static int sink;
+
+    private static Throwable recurseAndCreateThrowable(int depth) {
+        if (depth == 0) {
+            return new Throwable();
+        }
+        return recurseAndCreateThrowable(depth - 1);
+    }
+
+    private static StackTraceElement[] recurseAndGetStackTrace(int depth) {
+        if (depth == 0) {
+            return Thread.currentThread().getStackTrace();
+        }
+        return recurseAndGetStackTrace(depth - 1);
+    }
+
+    private static int recurseAndThrow(int depth) {
+        if (depth == 0) {
+            throw new IllegalStateException();
+        }
+        return recurseAndThrow(depth - 1) + 1;
+    }
+
+    public void timeCreateThrowable(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink += recurseAndCreateThrowable(DEPTH).hashCode();
+        }
+    }
+
+    public void timeCreateThrowableAndGetStackTrace(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink += recurseAndCreateThrowable(DEPTH).getStackTrace().length;
+        }
+    }
+
+    public void timeThreadGetStackTrace(int count) {
+        for (int i = 0; i < count; ++i) {
+            sink += recurseAndGetStackTrace(DEPTH).length;
+        }
+    }
+
+    public void timeThrowAndCatch(int count) {
+        for (int i = 0; i < count; ++i) {
+            try {
+                sink += recurseAndThrow(DEPTH);
+            } catch (IllegalStateException expected) {
+                sink += 1;
+            }
+        }
+    }
+}
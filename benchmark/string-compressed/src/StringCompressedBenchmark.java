@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class StringCompressedBenchmark {
+    // Compressed (Latin-1) and uncompressed (UTF-16) strings with the same 64-char prefix.
+    public static final String compressed = makeString(64, "");
+    public static final String compressed2 = makeString(64, "");
+    public static final String uncompressed = makeString(64, "é€");
+
+    public void timeCompareToCompressed(int count) {
+        String lhs = compressed;
+        String rhs = compressed2;
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(lhs, rhs);
+        }
+    }
+
+    public void timeCompareToMixed(int count) {
+        String lhs = compressed;
+        String rhs = uncompressed;
+        for (int i = 0; i < count; ++i) {
+            $noinline$compareTo(lhs, rhs);
+        }
+    }
+
+    public void timeToCharArrayCompressed(int count) {
+        String s = compressed;
+        for (int i = 0; i < count; ++i) {
+            $noinline$toCharArray(s);
+        }
+    }
+
+    public void timeGetCharsCompressed(int count) {
+        String s = compressed;
+        char[] buffer = new char[s.length()];
+        for (int i = 0; i < count; ++i) {
+            $noinline$getChars(s, buffer);
+        }
+    }
+
+    public void timeIndexOfCompressedMissing(int count) {
+        String s = compressed;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, '#');
+        }
+    }
+
+    public void timeIndexOfCompressedNonLatin1(int count) {
+        String s = compressed;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, '€');
+        }
+    }
+
+    public void timeIndexOfUncompressed(int count) {
+        String s = uncompressed;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, '€');
+        }
+    }
+
+    public void timeInternNewString(int count) {
+        // Interning a fresh copy computes its hash code and looks it up in the intern table.
+        String s = compressed;
+        for (int i = 0; i < count; ++i) {
+            $noinline$intern(new String(s));
+        }
+    }
+
+    static String makeString(int length, String suffix) {
+        StringBuilder sb = new StringBuilder(length + suffix.length());
+        for (int i = 0; i < length; ++i) {
+            sb.append((char) ('a' + (i % 26)));
+        }
+        return sb.append(suffix).toString();
+    }
+
+    static int $noinline$compareTo(String lhs, String rhs) {
+        if (doThrow) { throw new Error(); }
+        return lhs.compareTo(rhs);
+    }
+
+    static char[] $noinline$toCharArray(String s) {
+        if (doThrow) { throw new Error(); }
+        return s.toCharArray();
+    }
+
+    static void $noinline$getChars(String s, char[] buffer) {
+        if (doThrow) { throw new Error(); }
+        s.getChars(0, s.length(), buffer, 0);
+    }
+
+    static int $noinline$indexOf(String s, char c) {
+        if (doThrow) { throw new Error(); }
+        return s.indexOf(c);
+    }
+
+    static String $noinline$intern(String s) {
+        if (doThrow) { throw new Error(); }
+        return s.intern();
+    }
+
+    public static boolean doThrow = false;
+}
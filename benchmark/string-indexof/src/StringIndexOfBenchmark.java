@@ -113,6 +113,42 @@ public class StringIndexOfBenchmark {
         }
     }
 
+    public static final String string1024 = buildString(1024, 'a');  // compressed
+    public static final String string1024Utf16 = buildString(1024, '\u0100');  // uncompressed
+
+    public void timeIndexOfLongCompressed(int count) {
+        final char c = 'Z';
+        String s = string1024;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfLongUncompressed(int count) {
+        final char c = 'Z';
+        String s = string1024Utf16;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    public void timeIndexOfLongNoMatch(int count) {
+        final char c = '_';
+        String s = string1024Utf16;
+        for (int i = 0; i < count; ++i) {
+            $noinline$indexOf(s, c);
+        }
+    }
+
+    // Builds a string of `length - 1` copies of `filler` followed by a 'Z'.
+    private static String buildString(int length, char filler) {
+        StringBuilder sb = new StringBuilder(length);
+        for (int i = 0; i < length - 1; ++i) {
+            sb.append(filler);
+        }
+        return sb.append('Z').toString();
+    }
+
     static int $noinline$indexOf(String s, char c) {
         if (doThrow) { throw new Error(); }
         return s.indexOf(c);
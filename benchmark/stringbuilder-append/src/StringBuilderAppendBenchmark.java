@@ -24,6 +24,9 @@ public class StringBuilderAppendBenchmark {
     public static double double2 = 1.0E308;
     public static float float1 = 42.0f;
     public static float float2 = 1.0E38f;
+    public static double double3 = 3.14159;
+    public static long long1 = 1234567890123L;
+    public static char char1 = ':';
 
     public void timeAppendStrings(int count) {
         String s1 = string1;
@@ -133,4 +136,63 @@ public class StringBuilderAppendBenchmark {
             throw new AssertionError();
         }
     }
+
+    public void timeAppendStringAndFractionalDouble(int count) {
+        String s1 = string1;
+        double d3 = double3;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            String result = s1 + d3;
+            sum += result.length();  // Make sure the append is not optimized away.
+        }
+        if (sum != count * (s1.length() + Double.toString(d3).length())) {
+            throw new AssertionError();
+        }
+    }
+
+    public void timeAppendStringCharAndInt(int count) {
+        String s1 = string1;
+        char c1 = char1;
+        int i1 = int1;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            String result = s1 + c1 + i1;
+            sum += result.length();  // Make sure the append is not optimized away.
+        }
+        if (sum != count * (s1.length() + 1 + Integer.toString(i1).length())) {
+            throw new AssertionError();
+        }
+    }
+
+    public void timeAppendToStringConstructor(int count) {
+        int i1 = int1;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            String result = new StringBuilder("s1").append(i1).toString();
+            sum += result.length();  // Make sure the append is not optimized away.
+        }
+        if (sum != count * (2 + Integer.toString(i1).length())) {
+            throw new AssertionError();
+        }
+    }
+
+    // A logging-style chain with more arguments than a single fused append supports.
+    public void timeAppendManyArgs(int count) {
+        String s1 = string1;
+        String s2 = string2;
+        char c1 = char1;
+        int i1 = int1;
+        long l1 = long1;
+        double d1 = double1;
+        float f1 = float1;
+        int sum = 0;
+        for (int i = 0; i < count; ++i) {
+            String result = s1 + c1 + i1 + c1 + l1 + c1 + s2 + c1 + d1 + c1 + f1 + c1 + i;
+            sum += result.length();  // Make sure the append is not optimized away.
+        }
+        String expected = s1 + c1 + i1 + c1 + l1 + c1 + s2 + c1 + d1 + c1 + f1 + c1;
+        if (sum < count * expected.length()) {
+            throw new AssertionError();
+        }
+    }
 }
@@ -341,12 +341,13 @@ TEST_F(CmdlineParserTest, TestXGcOption) {
     option_all_true.verify_pre_gc_rosalloc_ = true;
     option_all_true.verify_pre_sweeping_rosalloc_ = true;
     option_all_true.verify_post_gc_rosalloc_ = true;
+    option_all_true.generational_cmc = true;
 
     const char * xgc_args_all_true = "-Xgc:concurrent,"
         "preverify,presweepingverify,postverify,"
         "preverify_rosalloc,presweepingverify_rosalloc,"
         "postverify_rosalloc,precise,"
-        "verifycardtable";
+        "verifycardtable,generational_cmc";
 
     EXPECT_SINGLE_PARSE_VALUE(option_all_true, xgc_args_all_true, M::GcOption);
 
@@ -358,10 +359,12 @@ TEST_F(CmdlineParserTest, TestXGcOption) {
     option_all_false.verify_pre_gc_rosalloc_ = false;
     option_all_false.verify_pre_sweeping_rosalloc_ = false;
     option_all_false.verify_post_gc_rosalloc_ = false;
+    option_all_false.generational_cmc = false;
 
     const char* xgc_args_all_false = "-Xgc:nonconcurrent,"
         "nopreverify,nopresweepingverify,nopostverify,nopreverify_rosalloc,"
-        "nopresweepingverify_rosalloc,nopostverify_rosalloc,noprecise,noverifycardtable";
+        "nopresweepingverify_rosalloc,nopostverify_rosalloc,noprecise,noverifycardtable,"
+        "nogenerational_cmc";
 
     EXPECT_SINGLE_PARSE_VALUE(option_all_false, xgc_args_all_false, M::GcOption);
 
@@ -553,6 +553,7 @@ struct XGcOption {
   bool verify_pre_gc_heap_ = false;
   bool verify_pre_sweeping_heap_ = kIsDebugBuild;
   bool generational_cc = kEnableGenerationalCCByDefault;
+  bool generational_cmc = kEnableGenerationalCMCByDefault;
   bool verify_post_gc_heap_ = kIsDebugBuild;
   bool verify_pre_gc_rosalloc_ = kIsDebugBuild;
   bool verify_pre_sweeping_rosalloc_ = false;
@@ -595,6 +596,10 @@ struct CmdlineType<XGcOption> : CmdlineTypeParser<XGcOption> {
         // for compatibility reasons (this should not prevent the runtime from
         // starting up).
         xgc.generational_cc = false;
+      } else if (gc_option == "generational_cmc") {
+        xgc.generational_cmc = true;
+      } else if (gc_option == "nogenerational_cmc") {
+        xgc.generational_cmc = false;
       } else if (gc_option == "postverify") {
         xgc.verify_post_gc_heap_ = true;
       } else if (gc_option == "nopostverify") {
@@ -810,6 +815,11 @@ struct CmdlineType<ProfileSaverOptions> : CmdlineTypeParser<ProfileSaverOptions>
       return Result::SuccessNoValue();
     }
 
+    if (option == "delta-journal") {
+      existing.use_delta_journal_ = true;
+      return Result::SuccessNoValue();
+    }
+
     // The rest of these options are always the wildcard from '-Xps-*'
     std::string suffix = RemovePrefix(option);
 
@@ -862,10 +872,20 @@ struct CmdlineType<ProfileSaverOptions> : CmdlineTypeParser<ProfileSaverOptions>
       return ParseInto(
           existing, &ProfileSaverOptions::inline_cache_threshold_, type_parser.Parse(suffix));
     }
+    if (option.starts_with("sampling-interval-ms:")) {
+      CmdlineType<unsigned int> type_parser;
+      return ParseInto(existing,
+             &ProfileSaverOptions::sampling_interval_ms_,
+             type_parser.Parse(suffix));
+    }
     if (option.starts_with("profile-path:")) {
       existing.profile_path_ = suffix;
       return Result::SuccessNoValue();
     }
+    if (option.starts_with("startup-trace-path:")) {
+      existing.startup_trace_path_ = suffix;
+      return Result::SuccessNoValue();
+    }
 
     return Result::Failure(std::string("Invalid suboption '") + option + "'");
   }
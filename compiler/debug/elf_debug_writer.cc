@@ -118,7 +118,8 @@ static std::vector<uint8_t> MakeMiniDebugInfoInternal(
     size_t text_section_size,
     typename ElfTypes::Addr dex_section_address,
     size_t dex_section_size,
-    const DebugInfo& debug_info) {
+    const DebugInfo& debug_info,
+    bool compress) {
   std::vector<uint8_t> buffer;
   buffer.reserve(KB);
   VectorOutputStream out("Mini-debug-info ELF file", &buffer);
@@ -139,6 +140,9 @@ static std::vector<uint8_t> MakeMiniDebugInfoInternal(
   }
   builder->End();
   CHECK(builder->Good());
+  if (!compress) {
+    return buffer;
+  }
   std::vector<uint8_t> compressed_buffer;
   compressed_buffer.reserve(buffer.size() / 4);
   XzCompress(ArrayRef<const uint8_t>(buffer), &compressed_buffer);
@@ -152,7 +156,8 @@ std::vector<uint8_t> MakeMiniDebugInfo(
     size_t text_section_size,
     uint64_t dex_section_address,
     size_t dex_section_size,
-    const DebugInfo& debug_info) {
+    const DebugInfo& debug_info,
+    bool compress) {
   if (Is64BitInstructionSet(isa)) {
     return MakeMiniDebugInfoInternal<ElfTypes64>(isa,
                                                  features,
@@ -160,7 +165,8 @@ std::vector<uint8_t> MakeMiniDebugInfo(
                                                  text_section_size,
                                                  dex_section_address,
                                                  dex_section_size,
-                                                 debug_info);
+                                                 debug_info,
+                                                 compress);
   } else {
     return MakeMiniDebugInfoInternal<ElfTypes32>(isa,
                                                  features,
@@ -168,7 +174,8 @@ std::vector<uint8_t> MakeMiniDebugInfo(
                                                  text_section_size,
                                                  dex_section_address,
                                                  dex_section_size,
-                                                 debug_info);
+                                                 debug_info,
+                                                 compress);
   }
 }
 
@@ -41,6 +41,8 @@ EXPORT void WriteDebugInfo(
     ElfBuilder<ElfTypes>* builder,
     const DebugInfo& debug_info);
 
+// Without `compress`, the caller is responsible for compressing the returned ELF file,
+// for example with `XzCompressChunk()`.
 EXPORT std::vector<uint8_t> MakeMiniDebugInfo(
     InstructionSet isa,
     const InstructionSetFeatures* features,
@@ -48,7 +50,8 @@ EXPORT std::vector<uint8_t> MakeMiniDebugInfo(
     size_t text_section_size,
     uint64_t dex_section_address,
     size_t dex_section_size,
-    const DebugInfo& debug_info);
+    const DebugInfo& debug_info,
+    bool compress = true);
 
 std::vector<uint8_t> MakeElfFileForJIT(
     InstructionSet isa,
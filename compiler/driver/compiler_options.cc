@@ -61,10 +61,12 @@ CompilerOptions::CompilerOptions()
       compile_pic_(false),
       dump_timings_(false),
       dump_pass_timings_(false),
+      dump_pass_summary_(false),
       dump_stats_(false),
       profile_branches_(false),
       profile_compilation_info_(nullptr),
       verbose_methods_(),
+      relaxed_fp_reduction_methods_(),
       abort_on_hard_verifier_failure_(false),
       abort_on_soft_verifier_failure_(false),
       init_failure_output_(nullptr),
@@ -77,6 +79,7 @@ CompilerOptions::CompilerOptions()
       count_hotness_in_compiled_code_(false),
       resolve_startup_const_strings_(false),
       initialize_app_image_classes_(false),
+      initialize_app_image_startup_classes_(false),
       check_profiled_methods_(ProfileMethodsCheck::kNone),
       max_image_block_size_(std::numeric_limits<uint32_t>::max()),
       passes_to_run_(nullptr) {
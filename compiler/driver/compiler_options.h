@@ -256,6 +256,19 @@ class CompilerOptions final {
     return false;
   }
 
+  bool HasRelaxedFpReductionMethods() const {
+    return !relaxed_fp_reduction_methods_.empty();
+  }
+
+  bool IsRelaxedFpReductionMethod(const std::string& pretty_method) const {
+    for (const std::string& cur_method : relaxed_fp_reduction_methods_) {
+      if (pretty_method.find(cur_method) != std::string::npos) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   std::ostream* GetInitFailureOutput() const {
     return init_failure_output_.get();
   }
@@ -338,6 +351,10 @@ class CompilerOptions final {
     return dump_pass_timings_;
   }
 
+  bool GetDumpPassSummary() const {
+    return dump_pass_summary_;
+  }
+
   bool GetDumpStats() const {
     return dump_stats_;
   }
@@ -366,6 +383,10 @@ class CompilerOptions final {
     return initialize_app_image_classes_;
   }
 
+  bool InitializeAppImageStartupClasses() const {
+    return initialize_app_image_startup_classes_;
+  }
+
   // Returns true if `dex_file` is within an oat file we're producing right now.
   bool WithinOatFile(const DexFile* dex_file) const {
     return ContainsElement(GetDexFilesForOatFile(), dex_file);
@@ -419,6 +440,7 @@ class CompilerOptions final {
   bool compile_pic_;
   bool dump_timings_;
   bool dump_pass_timings_;
+  bool dump_pass_summary_;
   bool dump_stats_;
   bool profile_branches_;
 
@@ -428,6 +450,9 @@ class CompilerOptions final {
   // Vector of methods to have verbose output enabled for.
   std::vector<std::string> verbose_methods_;
 
+  // Vector of methods whose floating point reductions may be reassociated for vectorization.
+  std::vector<std::string> relaxed_fp_reduction_methods_;
+
   // Abort compilation with an error if we find a class that fails verification with a hard
   // failure.
   bool abort_on_hard_verifier_failure_;
@@ -465,6 +490,10 @@ class CompilerOptions final {
   // Whether we attempt to run class initializers for app image classes.
   bool initialize_app_image_classes_;
 
+  // Whether we attempt to run class initializers for app image classes used during startup,
+  // even if they depend on other class initializers.
+  bool initialize_app_image_startup_classes_;
+
   // When running profile-guided compilation, check that methods intended to be compiled end
   // up compiled and are not punted.
   ProfileMethodsCheck check_profiled_methods_;
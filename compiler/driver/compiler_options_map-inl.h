@@ -82,12 +82,16 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
     options->dump_cfg_append_ = true;
   }
   map.AssignIfExists(Base::VerboseMethods, &options->verbose_methods_);
+  map.AssignIfExists(Base::RelaxedFpReductionMethods,
+                     &options->relaxed_fp_reduction_methods_);
   options->deduplicate_code_ = map.GetOrDefault(Base::DeduplicateCode);
   if (map.Exists(Base::CountHotnessInCompiledCode)) {
     options->count_hotness_in_compiled_code_ = true;
   }
   map.AssignIfExists(Base::ResolveStartupConstStrings, &options->resolve_startup_const_strings_);
   map.AssignIfExists(Base::InitializeAppImageClasses, &options->initialize_app_image_classes_);
+  map.AssignIfExists(Base::InitializeAppImageStartupClasses,
+                     &options->initialize_app_image_startup_classes_);
   if (map.Exists(Base::CheckProfiledMethods)) {
     options->check_profiled_methods_ = *map.Get(Base::CheckProfiledMethods);
   }
@@ -101,6 +105,10 @@ inline bool ReadCompilerOptions(Base& map, CompilerOptions* options, std::string
     options->dump_pass_timings_ = true;
   }
 
+  if (map.Exists(Base::DumpPassSummary)) {
+    options->dump_pass_summary_ = true;
+  }
+
   if (map.Exists(Base::DumpStats)) {
     options->dump_stats_ = true;
   }
@@ -179,6 +187,11 @@ NO_INLINE void AddCompilerOptionsArgumentParserOptions(Builder& b) {
                     " method.")
           .IntoKey(Map::DumpPassTimings)
 
+      .Define({"--dump-pass-summary"})
+          .WithHelp("Display the time spent in each optimization pass and the arena memory used"
+                    " per method, aggregated over all compiled methods.")
+          .IntoKey(Map::DumpPassSummary)
+
       .Define({"--dump-stats"})
           .WithHelp("Display overall compilation statistics.")
           .IntoKey(Map::DumpStats)
@@ -228,12 +241,29 @@ NO_INLINE void AddCompilerOptionsArgumentParserOptions(Builder& b) {
           .WithValueMap({{"false", false}, {"true", true}})
           .IntoKey(Map::InitializeAppImageClasses)
 
+      .Define("--initialize-app-image-startup-classes=_")
+          .template WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .WithHelp("If true, try to initialize app image classes with a static method or\n"
+                    "constructor executed during startup according to the profile, even if\n"
+                    "they or their superclasses have class initializers. Classes are kept\n"
+                    "uninitialized if the initialization fails or stores references to\n"
+                    "objects outside the boot image in static fields.")
+          .IntoKey(Map::InitializeAppImageStartupClasses)
+
       .Define("--verbose-methods=_")
           .template WithType<ParseStringList<','>>()
           .WithHelp("Restrict the dumped CFG data to methods whose name is listed.\n"
                     "Eg: --verbose-methods=toString,hashCode")
           .IntoKey(Map::VerboseMethods)
 
+      .Define("--relaxed-fp-reduction-methods=_")
+          .template WithType<ParseStringList<','>>()
+          .WithHelp("Allow vectorizing floating point reductions in the listed methods, even\n"
+                    "though reassociating the additions may change the rounding of the result.\n"
+                    "Eg: --relaxed-fp-reduction-methods=Filter.apply,dot")
+          .IntoKey(Map::RelaxedFpReductionMethods)
+
       .Define("--max-image-block-size=_")
           .template WithType<unsigned int>()
           .WithHelp("Maximum solid block size for compressed images.")
@@ -16,6 +16,8 @@
 
 #include "block_builder.h"
 
+#include <algorithm>
+
 #include "base/logging.h"  // FOR VLOG.
 #include "dex/bytecode_utils.h"
 #include "dex/code_item_accessors-inl.h"
@@ -38,9 +40,14 @@ HBasicBlockBuilder::HBasicBlockBuilder(HGraph* graph,
                       nullptr,
                       local_allocator->Adapter(kArenaAllocGraphBuilder)),
       throwing_blocks_(kDefaultNumberOfThrowingBlocks,
-                       local_allocator->Adapter(kArenaAllocGraphBuilder)) {}
+                       local_allocator->Adapter(kArenaAllocGraphBuilder)),
+      block_start_dex_pcs_(local_allocator->Adapter(kArenaAllocGraphBuilder)),
+      control_flow_dex_pcs_(local_allocator->Adapter(kArenaAllocGraphBuilder)) {}
 
 HBasicBlock* HBasicBlockBuilder::MaybeCreateBlockAt(uint32_t dex_pc) {
+  if (branch_targets_[dex_pc] == nullptr) {
+    block_start_dex_pcs_.push_back(dex_pc);
+  }
   return MaybeCreateBlockAt(dex_pc, dex_pc);
 }
 
@@ -94,11 +101,22 @@ bool HBasicBlockBuilder::CreateBranchTargets() {
   }
 
   // Iterate over all instructions and find branching instructions. Create blocks for
-  // the locations these instructions branch to.
+  // the locations these instructions branch to. Also record the instructions which
+  // ConnectBasicBlocks() needs to look at, so that it does not decode all of them again.
+  // Throwing instructions only matter for methods with try items, see throwing_blocks_.
+  const bool has_try_items = code_item_accessor_.TriesSize() != 0;
   for (const DexInstructionPcPair& pair : code_item_accessor_) {
     const uint32_t dex_pc = pair.DexPc();
     const Instruction& instruction = pair.Inst();
 
+    if (instruction.IsBranch() ||
+        instruction.IsSwitch() ||
+        instruction.IsReturn() ||
+        instruction.Opcode() == Instruction::THROW ||
+        (has_try_items && IsThrowingDexInstruction(instruction))) {
+      control_flow_dex_pcs_.push_back(dex_pc);
+    }
+
     if (instruction.IsBranch()) {
       MaybeCreateBlockAt(dex_pc + instruction.GetTargetOffset());
     } else if (instruction.IsSwitch()) {
@@ -141,16 +159,19 @@ void HBasicBlockBuilder::ConnectBasicBlocks() {
   HBasicBlock* block = graph_->GetEntryBlock();
   graph_->AddBlock(block);
 
+  // Visit the block starts and the instructions recorded by CreateBranchTargets() in dex_pc
+  // order. Other instructions neither end a block nor matter for throwing_blocks_.
+  std::sort(block_start_dex_pcs_.begin(), block_start_dex_pcs_.end());
+  auto block_start_it = block_start_dex_pcs_.begin();
+  auto instruction_it = control_flow_dex_pcs_.begin();
   bool is_throwing_block = false;
-  // Calculate the qucikening index here instead of CreateBranchTargets since it's easier to
-  // calculate in dex_pc order.
-  for (const DexInstructionPcPair& pair : code_item_accessor_) {
-    const uint32_t dex_pc = pair.DexPc();
-    const Instruction& instruction = pair.Inst();
-
-    // Check if this dex_pc address starts a new basic block.
-    HBasicBlock* next_block = GetBlockAt(dex_pc);
-    if (next_block != nullptr) {
+  while (block_start_it != block_start_dex_pcs_.end() ||
+         instruction_it != control_flow_dex_pcs_.end()) {
+    // Check if the next dex_pc address starts a new basic block.
+    if (block_start_it != block_start_dex_pcs_.end() &&
+        (instruction_it == control_flow_dex_pcs_.end() || *block_start_it <= *instruction_it)) {
+      HBasicBlock* next_block = GetBlockAt(*block_start_it);
+      ++block_start_it;
       if (block != nullptr) {
         // Last instruction did not end its basic block but a new one starts here.
         // It must have been a block falling through into the next one.
@@ -159,12 +180,16 @@ void HBasicBlockBuilder::ConnectBasicBlocks() {
       block = next_block;
       is_throwing_block = false;
       graph_->AddBlock(block);
+      continue;
     }
 
+    const uint32_t dex_pc = *instruction_it;
+    ++instruction_it;
     if (block == nullptr) {
       // Ignore dead code.
       continue;
     }
+    const Instruction& instruction = code_item_accessor_.InstructionAt(dex_pc);
 
     if (!is_throwing_block && IsThrowingDexInstruction(instruction)) {
       DCHECK(!ContainsElement(throwing_blocks_, block));
@@ -198,7 +223,7 @@ void HBasicBlockBuilder::ConnectBasicBlocks() {
 
     // Go to the next instruction in case we read dex PC below.
     if (instruction.CanFlowThrough()) {
-      block->AddSuccessor(GetBlockAt(std::next(DexInstructionIterator(pair)).DexPc()));
+      block->AddSuccessor(GetBlockAt(dex_pc + instruction.SizeInCodeUnits()));
     }
 
     // The basic block ends here. Do not add any more instructions.
@@ -388,9 +413,8 @@ void HBasicBlockBuilder::InsertTryBoundaryBlocks() {
 void HBasicBlockBuilder::InsertSynthesizedLoopsForOsr() {
   ArenaSet<uint32_t> targets(allocator_->Adapter(kArenaAllocGraphBuilder));
   // Collect basic blocks that are targets of a negative branch.
-  for (const DexInstructionPcPair& pair : code_item_accessor_) {
-    const uint32_t dex_pc = pair.DexPc();
-    const Instruction& instruction = pair.Inst();
+  for (uint32_t dex_pc : control_flow_dex_pcs_) {
+    const Instruction& instruction = code_item_accessor_.InstructionAt(dex_pc);
     if (instruction.IsBranch()) {
       uint32_t target_dex_pc = dex_pc + instruction.GetTargetOffset();
       if (target_dex_pc < dex_pc) {
@@ -434,7 +458,6 @@ bool HBasicBlockBuilder::Build() {
   graph_->SetEntryBlock(new (allocator_) HBasicBlock(graph_, kNoDexPc));
   graph_->SetExitBlock(new (allocator_) HBasicBlock(graph_, kNoDexPc));
 
-  // TODO(dbrazdil): Do CreateBranchTargets and ConnectBasicBlocks in one pass.
   if (!CreateBranchTargets()) {
     return false;
   }
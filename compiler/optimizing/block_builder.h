@@ -77,8 +77,17 @@ class HBasicBlockBuilder : public ValueObject {
 
   ScopedArenaAllocator* const local_allocator_;
   ScopedArenaVector<HBasicBlock*> branch_targets_;
+  // Blocks containing a throwing instruction. Only complete for methods with try items, which
+  // are the only ones using it.
   ScopedArenaVector<HBasicBlock*> throwing_blocks_;
 
+  // Dex pcs of the blocks created by MaybeCreateBlockAt(dex_pc), in creation order.
+  ScopedArenaVector<uint32_t> block_start_dex_pcs_;
+
+  // Dex pcs, in ascending order, of the instructions that can end a basic block and, for methods
+  // with try items, of the throwing instructions.
+  ScopedArenaVector<uint32_t> control_flow_dex_pcs_;
+
   static constexpr size_t kDefaultNumberOfThrowingBlocks = 2u;
 
   DISALLOW_COPY_AND_ASSIGN(HBasicBlockBuilder);
@@ -1037,6 +1037,10 @@ CodeGenerator::CodeGenerator(HGraph* graph,
     // We need the current method in case we reach the hotness threshold. As a
     // side effect this makes the frame non-empty.
     SetRequiresCurrentMethod();
+  } else if (GetGraph()->IsCountingInvocations()) {
+    // Make the frame non-empty, so that the link register is saved and can be used
+    // as a temporary to increment the invocation counter.
+    SetRequiresCurrentMethod();
   }
 }
 
@@ -1717,9 +1721,10 @@ void CodeGenerator::ValidateInvokeRuntimeWithoutRecordingPcInfo(HInstruction* in
       << "instruction->DebugName()=" << instruction->DebugName()
       << " slow_path->GetDescription()=" << slow_path->GetDescription();
   // Only the Baker read barrier marking slow path used by certains
-  // instructions is expected to invoke the runtime without recording
-  // PC-related information.
-  DCHECK(kUseBakerReadBarrier);
+  // instructions and the inline cache update of type checks in baseline
+  // code are expected to invoke the runtime without recording PC-related
+  // information.
+  DCHECK(kUseBakerReadBarrier || instruction->IsInstanceOf() || instruction->IsCheckCast());
   DCHECK(instruction->IsInstanceFieldGet() ||
          instruction->IsStaticFieldGet() ||
          instruction->IsArrayGet() ||
@@ -381,6 +381,7 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
   void RecordCatchBlockInfo();
 
   const CompilerOptions& GetCompilerOptions() const { return compiler_options_; }
+  OptimizingCompilerStats* GetCompilerStats() const { return stats_; }
   bool EmitReadBarrier() const;
   bool EmitBakerReadBarrier() const;
   bool EmitNonBakerReadBarrier() const;
@@ -510,6 +511,14 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
         : LocationSummary::kCallOnSlowPath;
   }
 
+  // Whether `new_instance` can bump the thread-local allocation buffer inline and only call its
+  // allocation entrypoint on a slow path. The slow path is taken when the TLAB is full, when the
+  // class is not visibly initialized or is finalizable (its fast path object size is then too
+  // large to fit) and while allocations are instrumented.
+  static bool CanInlineTlabAllocation(HNewInstance* new_instance) {
+    return !new_instance->NeedsChecks();
+  }
+
   static bool StoreNeedsWriteBarrier(DataType::Type type, HInstruction* value) {
     // Check that null value is not represented as an integer constant.
     DCHECK_IMPLIES(type == DataType::Type::kReference, !value->IsIntConstant());
@@ -429,6 +429,38 @@ class SuspendCheckSlowPathARM64 : public SlowPathCodeARM64 {
   DISALLOW_COPY_AND_ASSIGN(SuspendCheckSlowPathARM64);
 };
 
+class NewInstanceSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  explicit NewInstanceSlowPathARM64(HNewInstance* instruction)
+      : SlowPathCodeARM64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    CodeGeneratorARM64* arm64_codegen = down_cast<CodeGeneratorARM64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    DataType::Type type = DataType::Type::kReference;
+    arm64_codegen->MoveLocation(
+        LocationFrom(calling_convention.GetRegisterAt(0)), locations->InAt(0), type);
+    arm64_codegen->InvokeRuntime(instruction_->AsNewInstance()->GetEntrypoint(),
+                                 instruction_,
+                                 instruction_->GetDexPc(),
+                                 this);
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+    arm64_codegen->MoveLocation(locations->Out(), calling_convention.GetReturnLocation(type), type);
+    RestoreLiveRegisters(codegen, locations);
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "NewInstanceSlowPathARM64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NewInstanceSlowPathARM64);
+};
+
 class TypeCheckSlowPathARM64 : public SlowPathCodeARM64 {
  public:
   TypeCheckSlowPathARM64(HInstruction* instruction, bool is_fatal)
@@ -484,6 +516,42 @@ class TypeCheckSlowPathARM64 : public SlowPathCodeARM64 {
   DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathARM64);
 };
 
+// Slow path updating the inline cache of a type check in baseline code.
+class TypeCheckInlineCacheSlowPathARM64 : public SlowPathCodeARM64 {
+ public:
+  TypeCheckInlineCacheSlowPathARM64(HTypeCheckInstruction* instruction, InlineCache* cache)
+      : SlowPathCodeARM64(instruction), cache_(cache) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    CodeGeneratorARM64* arm64_codegen = down_cast<CodeGeneratorARM64*>(codegen);
+    Register obj = InputRegisterAt(instruction_, 0);
+
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    // The `art_quick_update_inline_cache` stub expects the class in w0 and the cache in x8.
+    // /* HeapReference<Class> */ w0 = obj->klass_
+    __ Ldr(w0, HeapOperand(obj, mirror::Object::ClassOffset()));
+    arm64_codegen->GetAssembler()->MaybeUnpoisonHeapReference(w0);
+    __ Mov(x8, reinterpret_cast64<uint64_t>(cache_));
+    arm64_codegen->InvokeRuntimeWithoutRecordingPcInfo(
+        GetThreadOffset<kArm64PointerSize>(kQuickUpdateInlineCache).Int32Value(),
+        instruction_,
+        this);
+
+    RestoreLiveRegisters(codegen, locations);
+    __ B(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "TypeCheckInlineCacheSlowPathARM64"; }
+
+ private:
+  InlineCache* const cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckInlineCacheSlowPathARM64);
+};
+
 class DeoptimizationSlowPathARM64 : public SlowPathCodeARM64 {
  public:
   explicit DeoptimizationSlowPathARM64(HDeoptimize* instruction)
@@ -1368,6 +1436,19 @@ void CodeGeneratorARM64::MaybeIncrementHotness(HSuspendCheck* suspend_check, boo
     __ Strh(counter, MemOperand(lr, ProfilingInfo::BaselineHotnessCountOffset().Int32Value()));
     __ Bind(slow_path->GetExitLabel());
   }
+
+  if (is_frame_entry && GetGraph()->IsCountingInvocations()) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    DCHECK(!HasEmptyFrame());
+    uint64_t address = reinterpret_cast64<uint64_t>(info);
+    UseScratchRegisterScope temps(masm);
+    Register counter = temps.AcquireW();
+    __ Ldr(lr, jit_patches_.DeduplicateUint64Literal(address));
+    __ Ldr(counter, MemOperand(lr, ProfilingInfo::InvocationCountOffset().Int32Value()));
+    __ Add(counter, counter, 1);
+    __ Str(counter, MemOperand(lr, ProfilingInfo::InvocationCountOffset().Int32Value()));
+  }
 }
 
 void CodeGeneratorARM64::GenerateFrameEntry() {
@@ -4220,6 +4301,12 @@ void LocationsBuilderARM64::VisitInstanceOf(HInstanceOf* instruction) {
       break;
   }
 
+  if (ProfilingInfoBuilder::IsInlineCacheUseful(instruction, codegen_)) {
+    // The inline cache update needs to save the live caller-save registers.
+    call_kind = LocationSummary::kCallOnSlowPath;
+    baker_read_barrier_slow_path = false;
+  }
+
   LocationSummary* locations =
       new (GetGraph()->GetAllocator()) LocationSummary(instruction, call_kind);
   if (baker_read_barrier_slow_path) {
@@ -4272,6 +4359,8 @@ void InstructionCodeGeneratorARM64::VisitInstanceOf(HInstanceOf* instruction) {
     __ Cbz(obj, &zero);
   }
 
+  codegen_->MaybeGenerateTypeCheckInlineCacheCheck(instruction, obj);
+
   switch (type_check_kind) {
     case TypeCheckKind::kExactCheck: {
       ReadBarrierOption read_barrier_option =
@@ -4514,6 +4603,10 @@ void InstructionCodeGeneratorARM64::VisitInstanceOf(HInstanceOf* instruction) {
 void LocationsBuilderARM64::VisitCheckCast(HCheckCast* instruction) {
   TypeCheckKind type_check_kind = instruction->GetTypeCheckKind();
   LocationSummary::CallKind call_kind = codegen_->GetCheckCastCallKind(instruction);
+  if (ProfilingInfoBuilder::IsInlineCacheUseful(instruction, codegen_)) {
+    // The inline cache update needs to save the live caller-save registers.
+    call_kind = LocationSummary::kCallOnSlowPath;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetAllocator()) LocationSummary(instruction, call_kind);
   locations->SetInAt(0, Location::RequiresRegister());
@@ -4563,6 +4656,8 @@ void InstructionCodeGeneratorARM64::VisitCheckCast(HCheckCast* instruction) {
     __ Cbz(obj, &done);
   }
 
+  codegen_->MaybeGenerateTypeCheckInlineCacheCheck(instruction, obj);
+
   switch (type_check_kind) {
     case TypeCheckKind::kExactCheck:
     case TypeCheckKind::kArrayCheck: {
@@ -4804,6 +4899,37 @@ void CodeGeneratorARM64::MaybeGenerateInlineCacheCheck(HInstruction* instruction
   }
 }
 
+void CodeGeneratorARM64::MaybeGenerateTypeCheckInlineCacheCheck(HTypeCheckInstruction* instruction,
+                                                                Register obj) {
+  if (ProfilingInfoBuilder::IsInlineCacheUseful(instruction, this)) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    InlineCache* cache = ProfilingInfoBuilder::GetInlineCache(info, instruction);
+    if (cache != nullptr) {
+      SlowPathCodeARM64* slow_path = new (GetScopedAllocator())
+          TypeCheckInlineCacheSlowPathARM64(instruction, cache);
+      AddSlowPath(slow_path);
+      UseScratchRegisterScope temps(GetVIXLAssembler());
+      Register temp = temps.AcquireW();
+      Register temp2 = temps.AcquireX();
+      // /* HeapReference<Class> */ temp = obj->klass_
+      __ Ldr(temp, HeapOperand(obj, mirror::Object::ClassOffset()));
+      GetAssembler()->MaybeUnpoisonHeapReference(temp);
+      __ Mov(temp2, reinterpret_cast64<uint64_t>(cache));
+      __ Ldr(temp2.W(), MemOperand(temp2, InlineCache::ClassesOffset().Int32Value()));
+      // Fast path for a monomorphic cache.
+      __ Cmp(temp, temp2.W());
+      __ B(ne, slow_path->GetEntryLabel());
+      __ Bind(slow_path->GetExitLabel());
+    } else {
+      // This is unexpected, but we don't guarantee stable compilation across
+      // JIT runs so just warn about it.
+      ScopedObjectAccess soa(Thread::Current());
+      LOG(WARNING) << "Missing inline cache for " << GetGraph()->GetArtMethod()->PrettyMethod();
+    }
+  }
+}
+
 void InstructionCodeGeneratorARM64::VisitInvokeInterface(HInvokeInterface* invoke) {
   // TODO: b/18116999, our IMTs can miss an IncompatibleClassChangeError.
   LocationSummary* locations = invoke->GetLocations();
@@ -6057,6 +6183,14 @@ void InstructionCodeGeneratorARM64::VisitNewArray(HNewArray* instruction) {
 }
 
 void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    // The output is written before the class is stored into the new object.
+    locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+    return;
+  }
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
       instruction, LocationSummary::kCallOnMainOnly);
   InvokeRuntimeCallingConvention calling_convention;
@@ -6065,8 +6199,44 @@ void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorARM64::VisitNewInstance(HNewInstance* instruction) {
-  codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
-  CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+  if (!CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+    codegen_->MaybeGenerateMarkingRegisterCheck(/* code= */ __LINE__);
+    return;
+  }
+  // Same as the fast path of art_quick_alloc_object_resolved_tlab.
+  Register cls = InputRegisterAt(instruction, 0);
+  Register out = OutputRegister(instruction);
+  SlowPathCodeARM64* slow_path =
+      new (codegen_->GetScopedAllocator()) NewInstanceSlowPathARM64(instruction);
+  codegen_->AddSlowPath(slow_path);
+  {
+    UseScratchRegisterScope temps(GetVIXLAssembler());
+    Register end = temps.AcquireX();
+    Register new_pos = temps.AcquireX();
+    __ Ldr(end.W(), MemOperand(tr, Thread::ThreadFlagsOffset<kArm64PointerSize>().Int32Value()));
+    __ Tbnz(end.W(),
+            WhichPowerOf2(enum_cast<uint32_t>(ThreadFlag::kInstrumentedAllocation)),
+            slow_path->GetEntryLabel());
+    __ Ldr(out.X(),
+           MemOperand(tr, Thread::ThreadLocalPosOffset<kArm64PointerSize>().Int32Value()));
+    __ Ldr(end, MemOperand(tr, Thread::ThreadLocalEndOffset<kArm64PointerSize>().Int32Value()));
+    __ Ldr(new_pos.W(), HeapOperand(cls, mirror::Class::ObjectSizeAllocFastPathOffset()));
+    __ Add(new_pos, out.X(), new_pos);
+    __ Cmp(new_pos, end);
+    __ B(hi, slow_path->GetEntryLabel());
+    __ Str(new_pos, MemOperand(tr, Thread::ThreadLocalPosOffset<kArm64PointerSize>().Int32Value()));
+    Register cls_ref = cls;
+    if (kPoisonHeapReferences) {
+      cls_ref = end.W();
+      __ Mov(cls_ref, cls);
+      GetAssembler()->PoisonHeapReference(cls_ref);
+    }
+    // No barrier, the compiler emits a constructor fence after the new-instance.
+    __ Str(cls_ref, HeapOperand(out, mirror::Object::ClassOffset()));
+  }
+  __ Bind(slow_path->GetExitLabel());
   codegen_->MaybeGenerateMarkingRegisterCheck(/* code= */ __LINE__);
 }
 
@@ -1051,6 +1051,8 @@ class CodeGeneratorARM64 : public CodeGenerator {
   }
 
   void MaybeGenerateInlineCacheCheck(HInstruction* instruction, vixl::aarch64::Register klass);
+  void MaybeGenerateTypeCheckInlineCacheCheck(HTypeCheckInstruction* instruction,
+                                              vixl::aarch64::Register obj);
   void MaybeIncrementHotness(HSuspendCheck* suspend_check, bool is_frame_entry);
   void MaybeRecordTraceEvent(bool is_method_entry);
 
@@ -2322,6 +2322,19 @@ void CodeGeneratorARMVIXL::MaybeIncrementHotness(HSuspendCheck* suspend_check,
     __ Strh(tmp, MemOperand(lr, ProfilingInfo::BaselineHotnessCountOffset().Int32Value()));
     __ Bind(slow_path->GetExitLabel());
   }
+
+  if (is_frame_entry && GetGraph()->IsCountingInvocations()) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    DCHECK(!HasEmptyFrame());
+    uint32_t address = reinterpret_cast32<uint32_t>(info);
+    UseScratchRegisterScope temps(GetVIXLAssembler());
+    vixl32::Register tmp = temps.Acquire();
+    __ Mov(lr, address);
+    __ Ldr(tmp, MemOperand(lr, ProfilingInfo::InvocationCountOffset().Int32Value()));
+    __ Add(tmp, tmp, 1);
+    __ Str(tmp, MemOperand(lr, ProfilingInfo::InvocationCountOffset().Int32Value()));
+  }
 }
 
 void CodeGeneratorARMVIXL::GenerateFrameEntry() {
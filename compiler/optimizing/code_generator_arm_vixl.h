@@ -168,8 +168,6 @@ using VIXLUInt32Literal = vixl::aarch32::Literal<uint32_t>;
   V(SystemArrayCopyInt)                                                    \
   V(UnsafeArrayBaseOffset)                                                 \
   /* 1.8 */                                                                \
-  V(MathFmaDouble)                                                         \
-  V(MathFmaFloat)                                                          \
   V(MethodHandleInvokeExact)                                               \
   V(MethodHandleInvoke)                                                    \
   /* OpenJDK 11 */                                                         \
@@ -530,6 +528,10 @@ class InstructionCodeGeneratorARMVIXL : public InstructionCodeGenerator {
       // This function may acquire a scratch register.
       vixl::aarch32::UseScratchRegisterScope* temps_scope,
       /*out*/ vixl32::Register* scratch);
+  void GenerateVecReducePairwise(HVecReduce* instruction,
+                                 vixl::aarch32::DRegister dst,
+                                 vixl::aarch32::DRegister src,
+                                 size_t steps);
 
   ArmVIXLAssembler* const assembler_;
   CodeGeneratorARMVIXL* const codegen_;
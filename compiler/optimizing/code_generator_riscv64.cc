@@ -751,6 +751,40 @@ class ReadBarrierMarkSlowPathRISCV64 : public SlowPathCodeRISCV64 {
   DISALLOW_COPY_AND_ASSIGN(ReadBarrierMarkSlowPathRISCV64);
 };
 
+class NewInstanceSlowPathRISCV64 : public SlowPathCodeRISCV64 {
+ public:
+  explicit NewInstanceSlowPathRISCV64(HNewInstance* instruction)
+      : SlowPathCodeRISCV64(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    CodeGeneratorRISCV64* riscv64_codegen = down_cast<CodeGeneratorRISCV64*>(codegen);
+    InvokeRuntimeCallingConvention calling_convention;
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    DataType::Type type = DataType::Type::kReference;
+    riscv64_codegen->MoveLocation(
+        Location::RegisterLocation(calling_convention.GetRegisterAt(0)), locations->InAt(0), type);
+    riscv64_codegen->InvokeRuntime(instruction_->AsNewInstance()->GetEntrypoint(),
+                                   instruction_,
+                                   instruction_->GetDexPc(),
+                                   this);
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+    riscv64_codegen->MoveLocation(
+        locations->Out(), calling_convention.GetReturnLocation(type), type);
+    RestoreLiveRegisters(codegen, locations);
+
+    __ J(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "NewInstanceSlowPathRISCV64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NewInstanceSlowPathRISCV64);
+};
+
 class LoadStringSlowPathRISCV64 : public SlowPathCodeRISCV64 {
  public:
   explicit LoadStringSlowPathRISCV64(HLoadString* instruction)
@@ -1157,7 +1191,18 @@ void InstructionCodeGeneratorRISCV64::GenerateSuspendCheck(HSuspendCheck* instru
   }
 
   if (codegen_->CanUseImplicitSuspendCheck()) {
-    LOG(FATAL) << "Unimplemented ImplicitSuspendCheck";
+    // Load the suspend trigger and dereference it. The trigger points to itself unless
+    // a suspend check is requested, in which case it is null and the load faults. The
+    // `SuspensionHandler` recognizes this exact instruction sequence, see
+    // `runtime/arch/riscv64/fault_handler_riscv64.cc`.
+    ScratchRegisterScope srs(GetAssembler());
+    XRegister tmp = srs.AllocateXRegister();
+    __ Loadd(tmp, TR, Thread::ThreadSuspendTriggerOffset<kRiscv64PointerSize>().Int32Value());
+    __ Lw(Zero, tmp, 0);
+    codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+    if (successor != nullptr) {
+      __ J(codegen_->GetLabelOf(successor));
+    }
     return;
   }
 
@@ -2094,16 +2139,6 @@ void InstructionCodeGeneratorRISCV64::GenTableBasedPackedSwitch(XRegister adjust
   __ Jr(temp);
 }
 
-int32_t InstructionCodeGeneratorRISCV64::VecAddress(LocationSummary* locations,
-                                                    size_t size,
-                                                    /*out*/ XRegister* adjusted_base) {
-  UNUSED(locations);
-  UNUSED(size);
-  UNUSED(adjusted_base);
-  LOG(FATAL) << "Unimplemented";
-  UNREACHABLE();
-}
-
 void LocationsBuilderRISCV64::HandleBinaryOp(HBinaryOperation* instruction) {
   DCHECK_EQ(instruction->InputCount(), 2u);
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
@@ -4776,6 +4811,15 @@ void InstructionCodeGeneratorRISCV64::VisitNewArray(HNewArray* instruction) {
 }
 
 void LocationsBuilderRISCV64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    // The output is written before the class is stored into the new object.
+    locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+    locations->AddRegisterTemps(2);
+    return;
+  }
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
       instruction, LocationSummary::kCallOnMainOnly);
   InvokeRuntimeCallingConvention calling_convention;
@@ -4784,8 +4828,39 @@ void LocationsBuilderRISCV64::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorRISCV64::VisitNewInstance(HNewInstance* instruction) {
-  codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
-  CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+  if (!CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+    return;
+  }
+  // Same as the fast path of art_quick_alloc_object_resolved_tlab.
+  LocationSummary* locations = instruction->GetLocations();
+  XRegister cls = locations->InAt(0).AsRegister<XRegister>();
+  XRegister out = locations->Out().AsRegister<XRegister>();
+  XRegister end = locations->GetTemp(0).AsRegister<XRegister>();
+  XRegister new_pos = locations->GetTemp(1).AsRegister<XRegister>();
+  SlowPathCodeRISCV64* slow_path =
+      new (codegen_->GetScopedAllocator()) NewInstanceSlowPathRISCV64(instruction);
+  codegen_->AddSlowPath(slow_path);
+  int32_t pos_offset = Thread::ThreadLocalPosOffset<kRiscv64PointerSize>().Int32Value();
+  __ Loadwu(end, TR, Thread::ThreadFlagsOffset<kRiscv64PointerSize>().Int32Value());
+  __ Andi(end, end, enum_cast<int32_t>(ThreadFlag::kInstrumentedAllocation));
+  __ Bnez(end, slow_path->GetEntryLabel());
+  __ Loadd(out, TR, pos_offset);
+  __ Loadd(end, TR, Thread::ThreadLocalEndOffset<kRiscv64PointerSize>().Int32Value());
+  __ Loadwu(new_pos, cls, mirror::Class::ObjectSizeAllocFastPathOffset().Int32Value());
+  __ Add(new_pos, out, new_pos);
+  __ Bgtu(new_pos, end, slow_path->GetEntryLabel());
+  __ Stored(new_pos, TR, pos_offset);
+  XRegister cls_ref = cls;
+  if (kPoisonHeapReferences) {
+    cls_ref = end;
+    __ Mv(cls_ref, cls);
+    codegen_->PoisonHeapReference(cls_ref);
+  }
+  // No barrier, the compiler emits a constructor fence after the new-instance.
+  __ Storew(cls_ref, out, mirror::Object::ClassOffset().Int32Value());
+  __ Bind(slow_path->GetExitLabel());
 }
 
 void LocationsBuilderRISCV64::VisitNop(HNop* instruction) {
@@ -5504,347 +5579,6 @@ void InstructionCodeGeneratorRISCV64::VisitBitwiseNegatedRight(HBitwiseNegatedRi
   }
 }
 
-void LocationsBuilderRISCV64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecExtractScalar(HVecExtractScalar* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecExtractScalar(HVecExtractScalar* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecReduce(HVecReduce* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecReduce(HVecReduce* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecCnv(HVecCnv* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecCnv(HVecCnv* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecNeg(HVecNeg* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecNeg(HVecNeg* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecAbs(HVecAbs* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecAbs(HVecAbs* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecNot(HVecNot* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecNot(HVecNot* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecAdd(HVecAdd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecAdd(HVecAdd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecHalvingAdd(HVecHalvingAdd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecHalvingAdd(HVecHalvingAdd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecSub(HVecSub* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecSub(HVecSub* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecMul(HVecMul* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecMul(HVecMul* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecDiv(HVecDiv* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecDiv(HVecDiv* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecMin(HVecMin* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecMin(HVecMin* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecMax(HVecMax* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecMax(HVecMax* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecAnd(HVecAnd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecAnd(HVecAnd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecAndNot(HVecAndNot* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecAndNot(HVecAndNot* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecOr(HVecOr* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecOr(HVecOr* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecXor(HVecXor* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecXor(HVecXor* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecSaturationAdd(HVecSaturationAdd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecSaturationAdd(HVecSaturationAdd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecSaturationSub(HVecSaturationSub* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecSaturationSub(HVecSaturationSub* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecShl(HVecShl* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecShl(HVecShl* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecShr(HVecShr* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecShr(HVecShr* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecUShr(HVecUShr* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecUShr(HVecUShr* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecSetScalars(HVecSetScalars* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecSetScalars(HVecSetScalars* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecMultiplyAccumulate(
-    HVecMultiplyAccumulate* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecSADAccumulate(HVecSADAccumulate* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecSADAccumulate(HVecSADAccumulate* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecDotProd(HVecDotProd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecDotProd(HVecDotProd* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecLoad(HVecLoad* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecLoad(HVecLoad* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecStore(HVecStore* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecStore(HVecStore* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecPredSetAll(HVecPredSetAll* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecPredSetAll(HVecPredSetAll* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecPredWhile(HVecPredWhile* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecPredWhile(HVecPredWhile* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecPredToBoolean(HVecPredToBoolean* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecPredToBoolean(HVecPredToBoolean* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecCondition(HVecCondition* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecCondition(HVecCondition* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void LocationsBuilderRISCV64::VisitVecPredNot(HVecPredNot* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
-void InstructionCodeGeneratorRISCV64::VisitVecPredNot(HVecPredNot* instruction) {
-  UNUSED(instruction);
-  LOG(FATAL) << "Unimplemented";
-}
-
 namespace detail {
 
 // Mark which intrinsics we don't have handcrafted code for.
@@ -5955,11 +5689,29 @@ void CodeGeneratorRISCV64::MaybeIncrementHotness(HSuspendCheck* suspend_check,
     __ Sh(counter, tmp, imm12);
     __ Bind(slow_path->GetExitLabel());
   }
+
+  if (is_frame_entry && GetGraph()->IsCountingInvocations()) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    DCHECK(!HasEmptyFrame());
+    uint64_t address = reinterpret_cast64<uint64_t>(info) +
+                       ProfilingInfo::InvocationCountOffset().SizeValue();
+    auto [base_address, imm12] = SplitJitAddress(address);
+    ScratchRegisterScope srs(GetAssembler());
+    XRegister counter = srs.AllocateXRegister();
+    XRegister tmp = RA;
+    __ LoadConst64(tmp, base_address);
+    __ Lwu(counter, tmp, imm12);
+    __ Addiw(counter, counter, 1);
+    __ Sw(counter, tmp, imm12);
+  }
 }
 
 bool CodeGeneratorRISCV64::CanUseImplicitSuspendCheck() const {
-  // TODO(riscv64): Implement implicit suspend checks to reduce code size.
-  return false;
+  // Use implicit suspend checks if requested in compiler options unless there are SIMD
+  // instructions in the graph. The implicit suspend check does not save vector registers,
+  // so they would need to be saved in an explicit slow path.
+  return GetCompilerOptions().GetImplicitSuspendChecks() && !GetGraph()->HasSIMD();
 }
 
 void CodeGeneratorRISCV64::GenerateMemoryBarrier(MemBarrierKind kind) {
@@ -6169,7 +5921,15 @@ void CodeGeneratorRISCV64::MoveLocation(Location destination,
     DCHECK((destination.IsFpuRegister() && DataType::IsFloatingPointType(dst_type)) ||
            (destination.IsRegister() && !DataType::IsFloatingPointType(dst_type)));
 
-    if (source.IsStackSlot() || source.IsDoubleStackSlot()) {
+    if (source.IsSIMDStackSlot()) {
+      // Move to vector register from SIMD stack slot
+      DCHECK(destination.IsFpuRegister());
+      ScratchRegisterScope srs(GetAssembler());
+      XRegister address = srs.AllocateXRegister();
+      __ AddConst64(address, SP, source.GetStackIndex());
+      SetVectorConfig(DataType::Type::kInt8, kRiscv64VectorRegSizeInBytes);
+      __ VLe8(VRegister(destination.reg()), address);
+    } else if (source.IsStackSlot() || source.IsDoubleStackSlot()) {
       // Move to GPR/FPR from stack
       if (DataType::IsFloatingPointType(dst_type)) {
         if (DataType::Is64BitType(dst_type)) {
@@ -6222,8 +5982,11 @@ void CodeGeneratorRISCV64::MoveLocation(Location destination,
     } else if (source.IsFpuRegister()) {
       if (destination.IsFpuRegister()) {
         if (GetGraph()->HasSIMD()) {
-          LOG(FATAL) << "Vector extension is unsupported";
-          UNREACHABLE();
+          // The location may hold a scalar in the FP register or a vector in the vector
+          // register with the same number, so move both.
+          __ FMvD(destination.AsFpuRegister<FRegister>(), source.AsFpuRegister<FRegister>());
+          SetVectorConfig(DataType::Type::kInt8, kRiscv64VectorRegSizeInBytes);
+          __ VMv_vv(VRegister(destination.reg()), VRegister(source.reg()));
         } else {
           // Move to FPR from FPR
           if (dst_type == DataType::Type::kFloat32) {
@@ -6243,8 +6006,21 @@ void CodeGeneratorRISCV64::MoveLocation(Location destination,
       }
     }
   } else if (destination.IsSIMDStackSlot()) {
-    LOG(FATAL) << "SIMD is unsupported";
-    UNREACHABLE();
+    ScratchRegisterScope srs(GetAssembler());
+    XRegister tmp = srs.AllocateXRegister();
+    if (source.IsFpuRegister()) {
+      // Move to SIMD stack slot from vector register
+      __ AddConst64(tmp, SP, destination.GetStackIndex());
+      SetVectorConfig(DataType::Type::kInt8, kRiscv64VectorRegSizeInBytes);
+      __ VSe8(VRegister(source.reg()), tmp);
+    } else {
+      // Move to SIMD stack slot from SIMD stack slot
+      DCHECK(source.IsSIMDStackSlot());
+      for (size_t i = 0; i != kRiscv64VectorRegSizeInBytes; i += kRiscv64DoublewordSize) {
+        __ Loadd(tmp, SP, source.GetStackIndex() + i);
+        __ Stored(tmp, SP, destination.GetStackIndex() + i);
+      }
+    }
   } else {  // The destination is not a register. It must be a stack slot.
     DCHECK(destination.IsStackSlot() || destination.IsDoubleStackSlot());
     if (source.IsRegister() || source.IsFpuRegister()) {
@@ -6354,23 +6130,28 @@ size_t CodeGeneratorRISCV64::RestoreCoreRegister(size_t stack_index, uint32_t re
 }
 
 size_t CodeGeneratorRISCV64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
+  __ FStored(FRegister(reg_id), SP, stack_index);
   if (GetGraph()->HasSIMD()) {
-    // TODO(riscv64): RISC-V vector extension.
-    UNIMPLEMENTED(FATAL) << "Vector extension is unsupported";
-    UNREACHABLE();
+    // Save the vector register after the FP register, see `GetSlowPathFPWidth()`.
+    ScratchRegisterScope srs(GetAssembler());
+    XRegister address = srs.AllocateXRegister();
+    __ AddConst64(address, SP, stack_index + kRiscv64FloatRegSizeInBytes);
+    SetVectorConfig(DataType::Type::kInt8, kRiscv64VectorRegSizeInBytes);
+    __ VSe8(VRegister(reg_id), address);
   }
-  __ FStored(FRegister(reg_id), SP, stack_index);
-  return kRiscv64FloatRegSizeInBytes;
+  return GetSlowPathFPWidth();
 }
 
 size_t CodeGeneratorRISCV64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
+  __ FLoadd(FRegister(reg_id), SP, stack_index);
   if (GetGraph()->HasSIMD()) {
-    // TODO(riscv64): RISC-V vector extension.
-    UNIMPLEMENTED(FATAL) << "Vector extension is unsupported";
-    UNREACHABLE();
+    ScratchRegisterScope srs(GetAssembler());
+    XRegister address = srs.AllocateXRegister();
+    __ AddConst64(address, SP, stack_index + kRiscv64FloatRegSizeInBytes);
+    SetVectorConfig(DataType::Type::kInt8, kRiscv64VectorRegSizeInBytes);
+    __ VLe8(VRegister(reg_id), address);
   }
-  __ FLoadd(FRegister(reg_id), SP, stack_index);
-  return kRiscv64FloatRegSizeInBytes;
+  return GetSlowPathFPWidth();
 }
 
 void CodeGeneratorRISCV64::DumpCoreRegister(std::ostream& stream, int reg) const {
@@ -7094,10 +6875,9 @@ void CodeGeneratorRISCV64::SwapLocations(Location loc1, Location loc2, DataType:
   if ((is_slot1 != is_slot2) ||
       (loc2.IsRegister() && loc1.IsRegister()) ||
       (is_fp_reg2 && is_fp_reg1)) {
-    if ((is_fp_reg2 && is_fp_reg1) && GetGraph()->HasSIMD()) {
-      LOG(FATAL) << "Unsupported";
-      UNREACHABLE();
-    }
+    // Note: In SIMD graphs, moves between FPU registers transfer both the FP register and
+    // the vector register with the same number, and the vector register paired with FTMP
+    // is never allocated either.
     ScratchRegisterScope srs(GetAssembler());
     Location tmp = (is_fp_reg2 || is_fp_reg1)
         ? Location::FpuRegisterLocation(srs.AllocateFRegister())
@@ -7108,11 +6888,23 @@ void CodeGeneratorRISCV64::SwapLocations(Location loc1, Location loc2, DataType:
   } else if (is_slot1 && is_slot2) {
     move_resolver_.Exchange(loc1.GetStackIndex(), loc2.GetStackIndex(), loc1.IsDoubleStackSlot());
   } else if (is_simd1 && is_simd2) {
-    // TODO(riscv64): Add VECTOR/SIMD later.
-    UNIMPLEMENTED(FATAL) << "Vector extension is unsupported";
+    for (size_t i = 0; i != kRiscv64VectorRegSizeInBytes; i += kRiscv64DoublewordSize) {
+      move_resolver_.Exchange(loc1.GetStackIndex() + i,
+                              loc2.GetStackIndex() + i,
+                              /*double_slot=*/ true);
+    }
   } else if ((is_fp_reg1 && is_simd2) || (is_fp_reg2 && is_simd1)) {
-    // TODO(riscv64): Add VECTOR/SIMD later.
-    UNIMPLEMENTED(FATAL) << "Vector extension is unsupported";
+    Location fp_reg_loc = is_fp_reg1 ? loc1 : loc2;
+    Location simd_slot_loc = is_fp_reg1 ? loc2 : loc1;
+    VRegister reg = VRegister(fp_reg_loc.reg());
+    ScratchRegisterScope srs(GetAssembler());
+    XRegister address = srs.AllocateXRegister();
+    VRegister vtmp = VRegister(srs.AllocateFRegister());  // The vector register paired with FTMP.
+    __ AddConst64(address, SP, simd_slot_loc.GetStackIndex());
+    SetVectorConfig(DataType::Type::kInt8, kRiscv64VectorRegSizeInBytes);
+    __ VLe8(vtmp, address);
+    __ VSe8(reg, address);
+    __ VMv_vv(reg, vtmp);
   } else {
     LOG(FATAL) << "Unimplemented swap between locations " << loc1 << " and " << loc2;
   }
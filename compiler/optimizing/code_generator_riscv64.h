@@ -383,9 +383,8 @@ class InstructionCodeGeneratorRISCV64 : public InstructionCodeGenerator {
                                  XRegister temp,
                                  uint32_t num_entries,
                                  HBasicBlock* switch_block);
-  int32_t VecAddress(LocationSummary* locations,
-                     size_t size,
-                     /*out*/ XRegister* adjusted_base);
+  // Compute the address of the first element accessed by a vector load or store into `rd`.
+  void VecAddress(HVecMemoryOperation* instruction, XRegister rd);
 
   template <typename Reg,
             void (Riscv64Assembler::*opS)(Reg, FRegister, FRegister),
@@ -434,17 +433,19 @@ class CodeGeneratorRISCV64 : public CodeGenerator {
   }
 
   bool SupportsPredicatedSIMD() const override {
-    // TODO(riscv64): Check the vector extension.
+    // TODO(riscv64): Use masked vector instructions for predicated loops.
     return false;
   }
 
   // Get FP register width in bytes for spilling/restoring in the slow paths.
   //
-  // Note: In SIMD graphs this should return SIMD register width as all FP and SIMD registers
-  // alias and live SIMD registers are forced to be spilled in full size in the slow paths.
+  // Note: Unlike other architectures, FP and vector registers do not alias on riscv64.
+  // In SIMD graphs an FPU register location `fN` may hold either a scalar in `fN` or
+  // a vector in `vN`, so the slow paths save both the FP and the vector register.
   size_t GetSlowPathFPWidth() const override {
-    // Default implementation.
-    return GetCalleePreservedFPWidth();
+    return GetGraph()->HasSIMD()
+        ? kRiscv64FloatRegSizeInBytes + kRiscv64VectorRegSizeInBytes
+        : GetCalleePreservedFPWidth();
   }
 
   size_t GetCalleePreservedFPWidth() const override {
@@ -452,11 +453,16 @@ class CodeGeneratorRISCV64 : public CodeGenerator {
   };
 
   size_t GetSIMDRegisterWidth() const override {
-    // TODO(riscv64): Implement SIMD with the Vector extension.
     // Note: HLoopOptimization calls this function even for an ISA without SIMD support.
-    return kRiscv64FloatRegSizeInBytes;
+    return GetInstructionSetFeatures().HasVector() ? kRiscv64VectorRegSizeInBytes
+                                                   : kRiscv64FloatRegSizeInBytes;
   };
 
+  // Configure the vector unit for `count` elements of `packed_type`. Vector code uses
+  // a fixed 128-bit portion of each vector register, which is guaranteed to exist by
+  // the minimum VLEN of the application profiles, so the requested length always fits.
+  void SetVectorConfig(DataType::Type packed_type, size_t count);
+
   uintptr_t GetAddressOf(HBasicBlock* block) override {
     return assembler_.GetLabelLocation(GetLabelOf(block));
   };
@@ -276,6 +276,17 @@ void InstructionCodeGeneratorARM64Neon::VisitVecReduce(HVecReduce* instruction)
           UNREACHABLE();
       }
       break;
+    case DataType::Type::kFloat32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ Faddp(dst.V4S(), src.V4S(), src.V4S());
+      __ Faddp(dst.S(), dst.V2S());
+      break;
+    case DataType::Type::kFloat64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ Faddp(dst.D(), src.V2D());
+      break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
@@ -1057,6 +1068,14 @@ void InstructionCodeGeneratorARM64Neon::VisitVecSetScalars(HVecSetScalars* instr
       DCHECK_EQ(2u, instruction->GetVectorLength());
       __ Mov(dst.V2D(), 0, InputRegisterAt(instruction, 0));
       break;
+    case DataType::Type::kFloat32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      __ Ins(dst.V4S(), 0, VRegisterFrom(locations->InAt(0)).V4S(), 0);
+      break;
+    case DataType::Type::kFloat64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      __ Ins(dst.V2D(), 0, VRegisterFrom(locations->InAt(0)).V2D(), 0);
+      break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
@@ -268,6 +268,14 @@ void InstructionCodeGeneratorARM64Sve::VisitVecReduce(HVecReduce* instruction) {
           UNREACHABLE();
       }
       break;
+    case DataType::Type::kFloat32:
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ Faddv(dst.S(), p_reg, src.VnS());
+      break;
+    case DataType::Type::kFloat64:
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ Faddv(dst.D(), p_reg, src.VnD());
+      break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
@@ -924,6 +932,12 @@ void InstructionCodeGeneratorARM64Sve::VisitVecSetScalars(HVecSetScalars* instru
     case DataType::Type::kInt64:
       __ Mov(dst.V2D(), 0, InputRegisterAt(instruction, 0));
       break;
+    case DataType::Type::kFloat32:
+      __ Ins(dst.V4S(), 0, VRegisterFrom(locations->InAt(0)).V4S(), 0);
+      break;
+    case DataType::Type::kFloat64:
+      __ Ins(dst.V2D(), 0, VRegisterFrom(locations->InAt(0)).V2D(), 0);
+      break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
@@ -79,6 +79,10 @@ void InstructionCodeGeneratorARMVIXL::VisitVecReplicateScalar(HVecReplicateScala
 void LocationsBuilderARMVIXL::VisitVecExtractScalar(HVecExtractScalar* instruction) {
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
   switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
     case DataType::Type::kInt32:
       locations->SetInAt(0, Location::RequiresFpuRegister());
       locations->SetOut(Location::RequiresRegister());
@@ -93,6 +97,22 @@ void InstructionCodeGeneratorARMVIXL::VisitVecExtractScalar(HVecExtractScalar* i
   LocationSummary* locations = instruction->GetLocations();
   vixl32::DRegister src = DRegisterFrom(locations->InAt(0));
   switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      __ Vmov(DataTypeValue::U8, OutputRegister(instruction), DRegisterLane(src, 0));
+      break;
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      __ Vmov(DataTypeValue::S8, OutputRegister(instruction), DRegisterLane(src, 0));
+      break;
+    case DataType::Type::kUint16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      __ Vmov(DataTypeValue::U16, OutputRegister(instruction), DRegisterLane(src, 0));
+      break;
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      __ Vmov(DataTypeValue::S16, OutputRegister(instruction), DRegisterLane(src, 0));
+      break;
     case DataType::Type::kInt32:
       DCHECK_EQ(2u, instruction->GetVectorLength());
       __ Vmov(OutputRegister(instruction), DRegisterLane(src, 0));
@@ -127,6 +147,38 @@ static void CreateVecUnOpLocations(ArenaAllocator* allocator, HVecUnaryOperation
   }
 }
 
+// Reduce the narrow lanes of `src` into lane 0 of `dst` with `steps` pairwise operations.
+void InstructionCodeGeneratorARMVIXL::GenerateVecReducePairwise(HVecReduce* instruction,
+                                                                vixl32::DRegister dst,
+                                                                vixl32::DRegister src,
+                                                                size_t steps) {
+  DataType::Type type = instruction->GetPackedType();
+  bool is_unsigned = type == DataType::Type::kUint8 || type == DataType::Type::kUint16;
+  bool is_byte = DataType::Size(type) == 1u;
+  for (size_t i = 0; i != steps; ++i) {
+    vixl32::DRegister input = (i == 0u) ? src : dst;
+    switch (instruction->GetReductionKind()) {
+      case HVecReduce::kSum:
+        __ Vpadd(is_byte ? DataTypeValue::I8 : DataTypeValue::I16, dst, input, input);
+        break;
+      case HVecReduce::kMin:
+        __ Vpmin(is_byte ? (is_unsigned ? DataTypeValue::U8 : DataTypeValue::S8)
+                         : (is_unsigned ? DataTypeValue::U16 : DataTypeValue::S16),
+                 dst,
+                 input,
+                 input);
+        break;
+      case HVecReduce::kMax:
+        __ Vpmax(is_byte ? (is_unsigned ? DataTypeValue::U8 : DataTypeValue::S8)
+                         : (is_unsigned ? DataTypeValue::U16 : DataTypeValue::S16),
+                 dst,
+                 input,
+                 input);
+        break;
+    }
+  }
+}
+
 void LocationsBuilderARMVIXL::VisitVecReduce(HVecReduce* instruction) {
   CreateVecUnOpLocations(GetGraph()->GetAllocator(), instruction);
 }
@@ -136,6 +188,16 @@ void InstructionCodeGeneratorARMVIXL::VisitVecReduce(HVecReduce* instruction) {
   vixl32::DRegister src = DRegisterFrom(locations->InAt(0));
   vixl32::DRegister dst = DRegisterFrom(locations->Out());
   switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      GenerateVecReducePairwise(instruction, dst, src, /*steps=*/ 3u);
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      GenerateVecReducePairwise(instruction, dst, src, /*steps=*/ 2u);
+      break;
     case DataType::Type::kInt32:
       DCHECK_EQ(2u, instruction->GetVectorLength());
       switch (instruction->GetReductionKind()) {
@@ -748,6 +810,10 @@ void LocationsBuilderARMVIXL::VisitVecSetScalars(HVecSetScalars* instruction) {
   bool is_zero = IsZeroBitPattern(input);
 
   switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
     case DataType::Type::kInt32:
       locations->SetInAt(0, is_zero ? Location::ConstantLocation(input)
                                     : Location::RequiresRegister());
@@ -775,6 +841,16 @@ void InstructionCodeGeneratorARMVIXL::VisitVecSetScalars(HVecSetScalars* instruc
 
   // Set required elements.
   switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      __ Vmov(Untyped8, DRegisterLane(dst, 0), InputRegisterAt(instruction, 0));
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      __ Vmov(Untyped16, DRegisterLane(dst, 0), InputRegisterAt(instruction, 0));
+      break;
     case DataType::Type::kInt32:
       DCHECK_EQ(2u, instruction->GetVectorLength());
       __ Vmov(Untyped32, DRegisterLane(dst, 0), InputRegisterAt(instruction, 0));
@@ -811,7 +887,38 @@ void LocationsBuilderARMVIXL::VisitVecMultiplyAccumulate(HVecMultiplyAccumulate*
 }
 
 void InstructionCodeGeneratorARMVIXL::VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = instruction->GetLocations();
+  vixl32::DRegister acc = DRegisterFrom(locations->InAt(0));
+  vixl32::DRegister left = DRegisterFrom(locations->InAt(1));
+  vixl32::DRegister right = DRegisterFrom(locations->InAt(2));
+
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+
+  DataTypeValue dt;
+  switch (instruction->GetPackedType()) {
+    case DataType::Type::kUint8:
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, instruction->GetVectorLength());
+      dt = I8;
+      break;
+    case DataType::Type::kUint16:
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      dt = I16;
+      break;
+    case DataType::Type::kInt32:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      dt = I32;
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+      UNREACHABLE();
+  }
+  if (instruction->GetOpKind() == HInstruction::kAdd) {
+    __ Vmla(dt, acc, left, right);
+  } else {
+    __ Vmls(dt, acc, left, right);
+  }
 }
 
 void LocationsBuilderARMVIXL::VisitVecSADAccumulate(HVecSADAccumulate* instruction) {
@@ -830,13 +937,46 @@ void InstructionCodeGeneratorARMVIXL::VisitVecSADAccumulate(HVecSADAccumulate* i
   HVecOperation* a = instruction->InputAt(1)->AsVecOperation();
   HVecOperation* b = instruction->InputAt(2)->AsVecOperation();
   DCHECK_EQ(a->GetPackedType(), b->GetPackedType());
+  UseScratchRegisterScope temps(GetVIXLAssembler());
   switch (a->GetPackedType()) {
+    case DataType::Type::kInt8:
+      DCHECK_EQ(8u, a->GetVectorLength());
+      switch (instruction->GetPackedType()) {
+        case DataType::Type::kInt32: {
+          DCHECK_EQ(2u, instruction->GetVectorLength());
+          // The absolute differences of bytes fit in unsigned bytes.
+          vixl32::DRegister tmp = temps.AcquireD();
+          __ Vabd(DataTypeValue::S8, tmp, left, right);
+          __ Vpaddl(DataTypeValue::U8, tmp, tmp);
+          __ Vpadal(DataTypeValue::U16, acc, tmp);
+          break;
+        }
+        default:
+          LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+          UNREACHABLE();
+      }
+      break;
+    case DataType::Type::kInt16:
+      DCHECK_EQ(4u, a->GetVectorLength());
+      switch (instruction->GetPackedType()) {
+        case DataType::Type::kInt32: {
+          DCHECK_EQ(2u, instruction->GetVectorLength());
+          // The absolute differences of halfwords fit in unsigned halfwords.
+          vixl32::DRegister tmp = temps.AcquireD();
+          __ Vabd(DataTypeValue::S16, tmp, left, right);
+          __ Vpadal(DataTypeValue::U16, acc, tmp);
+          break;
+        }
+        default:
+          LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
+          UNREACHABLE();
+      }
+      break;
     case DataType::Type::kInt32:
       DCHECK_EQ(2u, a->GetVectorLength());
       switch (instruction->GetPackedType()) {
         case DataType::Type::kInt32: {
           DCHECK_EQ(2u, instruction->GetVectorLength());
-          UseScratchRegisterScope temps(GetVIXLAssembler());
           vixl32::DRegister tmp = temps.AcquireD();
           __ Vsub(DataTypeValue::I32, tmp, left, right);
           __ Vabs(DataTypeValue::S32, tmp, tmp);
@@ -855,11 +995,52 @@ void InstructionCodeGeneratorARMVIXL::VisitVecSADAccumulate(HVecSADAccumulate* i
 }
 
 void LocationsBuilderARMVIXL::VisitVecDotProd(HVecDotProd* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(instruction);
+  DCHECK(instruction->GetPackedType() == DataType::Type::kInt32);
+  locations->SetInAt(0, Location::RequiresFpuRegister());
+  locations->SetInAt(1, Location::RequiresFpuRegister());
+  locations->SetInAt(2, Location::RequiresFpuRegister());
+  locations->SetOut(Location::SameAsFirstInput());
 }
 
 void InstructionCodeGeneratorARMVIXL::VisitVecDotProd(HVecDotProd* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = instruction->GetLocations();
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  vixl32::DRegister acc = DRegisterFrom(locations->InAt(0));
+  vixl32::DRegister left = DRegisterFrom(locations->InAt(1));
+  vixl32::DRegister right = DRegisterFrom(locations->InAt(2));
+  HVecOperation* a = instruction->InputAt(1)->AsVecOperation();
+  HVecOperation* b = instruction->InputAt(2)->AsVecOperation();
+  DCHECK_EQ(HVecOperation::ToSignedType(a->GetPackedType()),
+            HVecOperation::ToSignedType(b->GetPackedType()));
+  DCHECK_EQ(instruction->GetPackedType(), DataType::Type::kInt32);
+  DCHECK_EQ(2u, instruction->GetVectorLength());
+
+  // Multiply into a full Q register and add the widened products pairwise to the accumulator.
+  UseScratchRegisterScope temps(GetVIXLAssembler());
+  vixl32::QRegister tmp = temps.AcquireQ();
+  bool is_zero_extending = instruction->IsZeroExtending();
+  size_t inputs_data_size = DataType::Size(a->GetPackedType());
+  switch (inputs_data_size) {
+    case 1u: {
+      DCHECK_EQ(8u, a->GetVectorLength());
+      // The products of bytes fit in halfwords.
+      __ Vmull(is_zero_extending ? DataTypeValue::U8 : DataTypeValue::S8, tmp, left, right);
+      DataTypeValue dt = is_zero_extending ? DataTypeValue::U16 : DataTypeValue::S16;
+      __ Vpadal(dt, acc, tmp.GetLowDRegister());
+      __ Vpadal(dt, acc, tmp.GetHighDRegister());
+      break;
+    }
+    case 2u:
+      DCHECK_EQ(4u, a->GetVectorLength());
+      __ Vmull(is_zero_extending ? DataTypeValue::U16 : DataTypeValue::S16, tmp, left, right);
+      __ Vadd(DataTypeValue::I32, acc, acc, tmp.GetLowDRegister());
+      __ Vadd(DataTypeValue::I32, acc, acc, tmp.GetHighDRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type size: " << inputs_data_size;
+      UNREACHABLE();
+  }
 }
 
 // Return whether the vector memory access operation is guaranteed to be word-aligned (ARM word
@@ -248,6 +248,19 @@ void InstructionCodeGeneratorX86::VisitVecReduce(HVecReduce* instruction) {
       }
       break;
     }
+    case DataType::Type::kFloat32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ movaps(dst, src);
+      __ haddps(dst, dst);
+      __ haddps(dst, dst);
+      break;
+    case DataType::Type::kFloat64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ movaps(dst, src);
+      __ haddpd(dst, dst);
+      break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
@@ -1149,11 +1162,11 @@ void InstructionCodeGeneratorX86::VisitVecSetScalars(HVecSetScalars* instruction
     }
     case DataType::Type::kFloat32:
       DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ movss(dst, locations->InAt(1).AsFpuRegister<XmmRegister>());
+      __ movss(dst, locations->InAt(0).AsFpuRegister<XmmRegister>());
       break;
     case DataType::Type::kFloat64:
       DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ movsd(dst, locations->InAt(1).AsFpuRegister<XmmRegister>());
+      __ movsd(dst, locations->InAt(0).AsFpuRegister<XmmRegister>());
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
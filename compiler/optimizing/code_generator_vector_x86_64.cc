@@ -231,6 +231,19 @@ void InstructionCodeGeneratorX86_64::VisitVecReduce(HVecReduce* instruction) {
       }
       break;
     }
+    case DataType::Type::kFloat32:
+      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ movaps(dst, src);
+      __ haddps(dst, dst);
+      __ haddps(dst, dst);
+      break;
+    case DataType::Type::kFloat64:
+      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(instruction->GetReductionKind(), HVecReduce::kSum);
+      __ movaps(dst, src);
+      __ haddpd(dst, dst);
+      break;
     default:
       LOG(FATAL) << "Unsupported SIMD type: " << instruction->GetPackedType();
       UNREACHABLE();
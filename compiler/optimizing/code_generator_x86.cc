@@ -1374,6 +1374,14 @@ void CodeGeneratorX86::MaybeIncrementHotness(HSuspendCheck* suspend_check, bool
     __ j(kEqual, slow_path->GetEntryLabel());
     __ Bind(slow_path->GetExitLabel());
   }
+
+  if (is_frame_entry && GetGraph()->IsCountingInvocations()) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    uint32_t address = reinterpret_cast32<uint32_t>(info) +
+        ProfilingInfo::InvocationCountOffset().Int32Value();
+    __ addl(Address::Absolute(address), Immediate(1));
+  }
 }
 
 void CodeGeneratorX86::GenerateFrameEntry() {
@@ -398,6 +398,36 @@ class LoadStringSlowPathX86_64 : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(LoadStringSlowPathX86_64);
 };
 
+class NewInstanceSlowPathX86_64 : public SlowPathCode {
+ public:
+  explicit NewInstanceSlowPathX86_64(HNewInstance* instruction) : SlowPathCode(instruction) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    DCHECK(!locations->GetLiveRegisters()->ContainsCoreRegister(locations->Out().reg()));
+    CodeGeneratorX86_64* x86_64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    InvokeRuntimeCallingConvention calling_convention;
+    x86_64_codegen->Move(Location::RegisterLocation(calling_convention.GetRegisterAt(0)),
+                         locations->InAt(0));
+    x86_64_codegen->InvokeRuntime(instruction_->AsNewInstance()->GetEntrypoint(),
+                                  instruction_,
+                                  instruction_->GetDexPc(),
+                                  this);
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+    x86_64_codegen->Move(locations->Out(), Location::RegisterLocation(RAX));
+    RestoreLiveRegisters(codegen, locations);
+    __ jmp(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "NewInstanceSlowPathX86_64"; }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(NewInstanceSlowPathX86_64);
+};
+
 class TypeCheckSlowPathX86_64 : public SlowPathCode {
  public:
   TypeCheckSlowPathX86_64(HInstruction* instruction, bool is_fatal)
@@ -461,6 +491,40 @@ class TypeCheckSlowPathX86_64 : public SlowPathCode {
   DISALLOW_COPY_AND_ASSIGN(TypeCheckSlowPathX86_64);
 };
 
+// Slow path updating the inline cache of a type check in baseline code.
+class TypeCheckInlineCacheSlowPathX86_64 : public SlowPathCode {
+ public:
+  TypeCheckInlineCacheSlowPathX86_64(HTypeCheckInstruction* instruction, InlineCache* cache)
+      : SlowPathCode(instruction), cache_(cache) {}
+
+  void EmitNativeCode(CodeGenerator* codegen) override {
+    LocationSummary* locations = instruction_->GetLocations();
+    CodeGeneratorX86_64* x86_64_codegen = down_cast<CodeGeneratorX86_64*>(codegen);
+    CpuRegister obj = locations->InAt(0).AsRegister<CpuRegister>();
+
+    __ Bind(GetEntryLabel());
+    SaveLiveRegisters(codegen, locations);
+
+    // The `art_quick_update_inline_cache` stub expects the class in edi and the cache in r11.
+    // /* HeapReference<Class> */ rdi = obj->klass_
+    __ movl(CpuRegister(RDI), Address(obj, mirror::Object::ClassOffset()));
+    __ MaybeUnpoisonHeapReference(CpuRegister(RDI));
+    __ movq(CpuRegister(TMP), Immediate(reinterpret_cast64<int64_t>(cache_)));
+    x86_64_codegen->GenerateInvokeRuntime(
+        GetThreadOffset<kX86_64PointerSize>(kQuickUpdateInlineCache).Int32Value());
+
+    RestoreLiveRegisters(codegen, locations);
+    __ jmp(GetExitLabel());
+  }
+
+  const char* GetDescription() const override { return "TypeCheckInlineCacheSlowPathX86_64"; }
+
+ private:
+  InlineCache* const cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeCheckInlineCacheSlowPathX86_64);
+};
+
 class DeoptimizationSlowPathX86_64 : public SlowPathCode {
  public:
   explicit DeoptimizationSlowPathX86_64(HDeoptimize* instruction)
@@ -1822,6 +1886,16 @@ void CodeGeneratorX86_64::MaybeIncrementHotness(HSuspendCheck* suspend_check, bo
     __ j(kEqual, slow_path->GetEntryLabel());
     __ Bind(slow_path->GetExitLabel());
   }
+
+  if (is_frame_entry && GetGraph()->IsCountingInvocations()) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    DCHECK(!HasEmptyFrame());
+    uint64_t address = reinterpret_cast64<uint64_t>(info) +
+        ProfilingInfo::InvocationCountOffset().Int32Value();
+    __ movq(CpuRegister(TMP), Immediate(address));
+    __ addl(Address(CpuRegister(TMP), 0), Immediate(1));
+  }
 }
 
 void CodeGeneratorX86_64::GenerateFrameEntry() {
@@ -3196,6 +3270,35 @@ void CodeGeneratorX86_64::MaybeGenerateInlineCacheCheck(HInstruction* instructio
   }
 }
 
+void CodeGeneratorX86_64::MaybeGenerateTypeCheckInlineCacheCheck(
+    HTypeCheckInstruction* instruction, CpuRegister obj) {
+  if (ProfilingInfoBuilder::IsInlineCacheUseful(instruction, this)) {
+    ProfilingInfo* info = GetGraph()->GetProfilingInfo();
+    DCHECK(info != nullptr);
+    InlineCache* cache = ProfilingInfoBuilder::GetInlineCache(info, instruction);
+    if (cache != nullptr) {
+      SlowPathCode* slow_path = new (GetScopedAllocator())
+          TypeCheckInlineCacheSlowPathX86_64(instruction, cache);
+      AddSlowPath(slow_path);
+      uint64_t address = reinterpret_cast64<uint64_t>(cache);
+      __ movq(CpuRegister(TMP), Immediate(address));
+      __ movl(CpuRegister(TMP),
+              Address(CpuRegister(TMP), InlineCache::ClassesOffset().Int32Value()));
+      // Poison the cached class for direct comparison with the class of `obj`.
+      __ MaybePoisonHeapReference(CpuRegister(TMP));
+      // Fast path for a monomorphic cache.
+      __ cmpl(CpuRegister(TMP), Address(obj, mirror::Object::ClassOffset()));
+      __ j(kNotEqual, slow_path->GetEntryLabel());
+      __ Bind(slow_path->GetExitLabel());
+    } else {
+      // This is unexpected, but we don't guarantee stable compilation across
+      // JIT runs so just warn about it.
+      ScopedObjectAccess soa(Thread::Current());
+      LOG(WARNING) << "Missing inline cache for " << GetGraph()->GetArtMethod()->PrettyMethod();
+    }
+  }
+}
+
 void InstructionCodeGeneratorX86_64::VisitInvokeInterface(HInvokeInterface* invoke) {
   // TODO: b/18116999, our IMTs can miss an IncompatibleClassChangeError.
   LocationSummary* locations = invoke->GetLocations();
@@ -5145,6 +5248,15 @@ void InstructionCodeGeneratorX86_64::VisitUShr(HUShr* ushr) {
 }
 
 void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
+  if (CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
+        instruction, LocationSummary::kCallOnSlowPath);
+    locations->SetInAt(0, Location::RequiresRegister());
+    // The output is written before the class is stored into the new object.
+    locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+    locations->AddTemp(Location::RequiresRegister());
+    return;
+  }
   LocationSummary* locations = new (GetGraph()->GetAllocator()) LocationSummary(
       instruction, LocationSummary::kCallOnMainOnly);
   InvokeRuntimeCallingConvention calling_convention;
@@ -5153,9 +5265,41 @@ void LocationsBuilderX86_64::VisitNewInstance(HNewInstance* instruction) {
 }
 
 void InstructionCodeGeneratorX86_64::VisitNewInstance(HNewInstance* instruction) {
-  codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
-  CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
-  DCHECK(!codegen_->IsLeafMethod());
+  if (!CodeGenerator::CanInlineTlabAllocation(instruction)) {
+    codegen_->InvokeRuntime(instruction->GetEntrypoint(), instruction, instruction->GetDexPc());
+    CheckEntrypointTypes<kQuickAllocObjectWithChecks, void*, mirror::Class*>();
+    DCHECK(!codegen_->IsLeafMethod());
+    return;
+  }
+  // Same as the fast path of art_quick_alloc_object_resolved_tlab.
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister cls = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister new_pos = locations->GetTemp(0).AsRegister<CpuRegister>();
+  SlowPathCode* slow_path =
+      new (codegen_->GetScopedAllocator()) NewInstanceSlowPathX86_64(instruction);
+  codegen_->AddSlowPath(slow_path);
+  int32_t pos_offset = Thread::ThreadLocalPosOffset<kX86_64PointerSize>().Int32Value();
+  int32_t end_offset = Thread::ThreadLocalEndOffset<kX86_64PointerSize>().Int32Value();
+  __ gs()->testl(Address::Absolute(Thread::ThreadFlagsOffset<kX86_64PointerSize>().Int32Value(),
+                                   /* no_rip= */ true),
+                 Immediate(enum_cast<int32_t>(ThreadFlag::kInstrumentedAllocation)));
+  __ j(kNotZero, slow_path->GetEntryLabel());
+  __ gs()->movq(out, Address::Absolute(pos_offset, /* no_rip= */ true));
+  __ movl(new_pos, Address(cls, mirror::Class::ObjectSizeAllocFastPathOffset().Int32Value()));
+  __ addq(new_pos, out);
+  __ gs()->cmpq(new_pos, Address::Absolute(end_offset, /* no_rip= */ true));
+  __ j(kAbove, slow_path->GetEntryLabel());
+  __ gs()->movq(Address::Absolute(pos_offset, /* no_rip= */ true), new_pos);
+  CpuRegister cls_ref = cls;
+  if (kPoisonHeapReferences) {
+    cls_ref = new_pos;
+    __ movl(cls_ref, cls);
+    __ PoisonHeapReference(cls_ref);
+  }
+  // No barrier, the compiler emits a constructor fence after the new-instance.
+  __ movl(Address(out, mirror::Object::ClassOffset().Int32Value()), cls_ref);
+  __ Bind(slow_path->GetExitLabel());
 }
 
 void LocationsBuilderX86_64::VisitNewArray(HNewArray* instruction) {
@@ -5282,6 +5426,14 @@ void InstructionCodeGeneratorX86_64::VisitPhi([[maybe_unused]] HPhi* instruction
   LOG(FATAL) << "Unimplemented";
 }
 
+bool CodeGeneratorX86_64::CanUseImplicitSuspendCheck() const {
+  // Use implicit suspend checks if requested in compiler options unless there are SIMD
+  // instructions in the graph. The implicit suspend check saves all XMM registers as
+  // 64-bit but SIMD instructions can use 128-bit registers, so they need to be saved
+  // in an explicit slow path.
+  return GetCompilerOptions().GetImplicitSuspendChecks() && !GetGraph()->HasSIMD();
+}
+
 void CodeGeneratorX86_64::GenerateMemoryBarrier(MemBarrierKind kind) {
   /*
    * According to the JSR-133 Cookbook, for x86-64 only StoreLoad/AnyAny barriers need memory fence.
@@ -6373,6 +6525,29 @@ void InstructionCodeGeneratorX86_64::VisitSuspendCheck(HSuspendCheck* instructio
 
 void InstructionCodeGeneratorX86_64::GenerateSuspendCheck(HSuspendCheck* instruction,
                                                           HBasicBlock* successor) {
+  if (instruction->IsNoOp()) {
+    if (successor != nullptr) {
+      __ jmp(codegen_->GetLabelOf(successor));
+    }
+    return;
+  }
+
+  if (codegen_->CanUseImplicitSuspendCheck()) {
+    // Load the suspend trigger and dereference it. The trigger points to itself unless
+    // a suspend check is requested, in which case it is null and the load faults. The
+    // `SuspensionHandler` recognizes this exact instruction sequence, see
+    // `runtime/arch/x86/fault_handler_x86.cc`.
+    __ gs()->movq(CpuRegister(TMP),
+                  Address::Absolute(Thread::ThreadSuspendTriggerOffset<kX86_64PointerSize>(),
+                                    /* no_rip= */ true));
+    __ testl(CpuRegister(TMP), Address(CpuRegister(TMP), 0));
+    codegen_->RecordPcInfo(instruction, instruction->GetDexPc());
+    if (successor != nullptr) {
+      __ jmp(codegen_->GetLabelOf(successor));
+    }
+    return;
+  }
+
   SuspendCheckSlowPathX86_64* slow_path =
       down_cast<SuspendCheckSlowPathX86_64*>(instruction->GetSlowPath());
   if (slow_path == nullptr) {
@@ -7140,6 +7315,12 @@ void LocationsBuilderX86_64::VisitInstanceOf(HInstanceOf* instruction) {
       break;
   }
 
+  if (ProfilingInfoBuilder::IsInlineCacheUseful(instruction, codegen_)) {
+    // The inline cache update needs to save the live caller-save registers.
+    call_kind = LocationSummary::kCallOnSlowPath;
+    baker_read_barrier_slow_path = false;
+  }
+
   LocationSummary* locations =
       new (GetGraph()->GetAllocator()) LocationSummary(instruction, call_kind);
   if (baker_read_barrier_slow_path) {
@@ -7190,6 +7371,8 @@ void InstructionCodeGeneratorX86_64::VisitInstanceOf(HInstanceOf* instruction) {
     __ j(kEqual, &zero);
   }
 
+  codegen_->MaybeGenerateTypeCheckInlineCacheCheck(instruction, obj);
+
   switch (type_check_kind) {
     case TypeCheckKind::kExactCheck: {
       ReadBarrierOption read_barrier_option =
@@ -7480,6 +7663,10 @@ void InstructionCodeGeneratorX86_64::VisitInstanceOf(HInstanceOf* instruction) {
 void LocationsBuilderX86_64::VisitCheckCast(HCheckCast* instruction) {
   TypeCheckKind type_check_kind = instruction->GetTypeCheckKind();
   LocationSummary::CallKind call_kind = codegen_->GetCheckCastCallKind(instruction);
+  if (ProfilingInfoBuilder::IsInlineCacheUseful(instruction, codegen_)) {
+    // The inline cache update needs to save the live caller-save registers.
+    call_kind = LocationSummary::kCallOnSlowPath;
+  }
   LocationSummary* locations =
       new (GetGraph()->GetAllocator()) LocationSummary(instruction, call_kind);
   locations->SetInAt(0, Location::RequiresRegister());
@@ -7532,6 +7719,8 @@ void InstructionCodeGeneratorX86_64::VisitCheckCast(HCheckCast* instruction) {
     __ j(kEqual, &done);
   }
 
+  codegen_->MaybeGenerateTypeCheckInlineCacheCheck(instruction, obj);
+
   switch (type_check_kind) {
     case TypeCheckKind::kExactCheck:
     case TypeCheckKind::kArrayCheck: {
@@ -60,7 +60,6 @@ static constexpr FloatRegister non_volatile_xmm_regs[] = { XMM12, XMM13, XMM14,
   V(MathSignumDouble)                          \
   V(MathCopySignFloat)                         \
   V(MathCopySignDouble)                        \
-  V(CRC32Update)                               \
   V(CRC32UpdateBytes)                          \
   V(CRC32UpdateByteBuffer)                     \
   V(FP16ToFloat)                               \
@@ -722,9 +721,12 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   void GenerateImplicitNullCheck(HNullCheck* instruction) override;
   void GenerateExplicitNullCheck(HNullCheck* instruction) override;
   void MaybeGenerateInlineCacheCheck(HInstruction* instruction, CpuRegister cls);
+  void MaybeGenerateTypeCheckInlineCacheCheck(HTypeCheckInstruction* instruction, CpuRegister obj);
 
   void MaybeIncrementHotness(HSuspendCheck* suspend_check, bool is_frame_entry);
 
+  bool CanUseImplicitSuspendCheck() const;
+
   static void BlockNonVolatileXmmRegisters(LocationSummary* locations);
 
   // When we don't know the proper offset for the value, we use kPlaceholder32BitOffset.
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dex_cache_load_elimination.h"
+
+#include "base/scoped_arena_allocator.h"
+#include "base/scoped_arena_containers.h"
+#include "mirror/class-inl.h"
+#include "mirror/string.h"
+#include "nodes.h"
+#include "optimizing_compiler_stats.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art HIDDEN {
+
+class DexCacheLoadEliminationImpl {
+ public:
+  DexCacheLoadEliminationImpl(HGraph* graph, OptimizingCompilerStats* stats)
+      : scoped_allocator_(graph->GetArenaStack()),
+        loads_(std::less<mirror::Object*>(), scoped_allocator_.Adapter(kArenaAllocGvn)),
+        initializations_(std::less<mirror::Object*>(), scoped_allocator_.Adapter(kArenaAllocGvn)),
+        stats_(stats),
+        changed_(false) {}
+
+  bool HasChanged() const { return changed_; }
+
+  void VisitLoadClass(HLoadClass* load_class) REQUIRES_SHARED(Locks::mutator_lock_) {
+    mirror::Class* klass = load_class->GetClass().Get();
+    if (klass == nullptr || load_class->NeedsAccessCheck()) {
+      // Keep unresolved classes to GVN. The access check depends on the referencing method.
+      return;
+    }
+    if (!load_class->MustGenerateClinitCheck() || IsInitialized(klass, load_class)) {
+      HInstruction* existing = FindDominating(loads_, klass, load_class);
+      if (existing != nullptr) {
+        Replace(load_class, existing);
+        return;
+      }
+    }
+    Record(&loads_, klass, load_class);
+    if (load_class->MustGenerateClinitCheck()) {
+      RecordInitialization(klass, load_class);
+    }
+  }
+
+  void VisitLoadString(HLoadString* load_string) REQUIRES_SHARED(Locks::mutator_lock_) {
+    Handle<mirror::String> handle = load_string->GetString();
+    if (handle.GetReference() == nullptr || handle.IsNull()) {
+      // The string was not looked up by `HSharpening`.
+      return;
+    }
+    mirror::String* string = handle.Get();
+    HInstruction* existing = FindDominating(loads_, string, load_string);
+    if (existing != nullptr) {
+      Replace(load_string, existing);
+      return;
+    }
+    Record(&loads_, string, load_string);
+  }
+
+  void VisitClinitCheck(HClinitCheck* check) REQUIRES_SHARED(Locks::mutator_lock_) {
+    mirror::Class* klass = check->GetLoadClass()->GetClass().Get();
+    if (klass == nullptr) {
+      return;
+    }
+    if (!IsInitialized(klass, check)) {
+      RecordInitialization(klass, check);
+      return;
+    }
+    // The class is initialized (or being initialized by this thread), so the check cannot throw.
+    // Static invokes keep their class initialization check as the last input; drop it there,
+    // the way `PrepareForRegisterAllocation` does for checks merged into other instructions.
+    const HUseList<HInstruction*>& uses = check->GetUses();
+    for (auto it = uses.begin(), end = uses.end(); it != end; /* ++it below */) {
+      HInstruction* user = it->GetUser();
+      ++it;  // Advance before we remove the node, reference to the next node is preserved.
+      if (user->IsInvokeStaticOrDirect() &&
+          user->AsInvokeStaticOrDirect()->IsStaticWithExplicitClinitCheck() &&
+          user->GetInputs().back() == check) {
+        user->AsInvokeStaticOrDirect()->RemoveExplicitClinitCheck(
+            HInvokeStaticOrDirect::ClinitCheckRequirement::kNone);
+      }
+    }
+    check->ReplaceWith(check->GetLoadClass());
+    check->GetBlock()->RemoveInstruction(check);
+    changed_ = true;
+    MaybeRecordStat(stats_, MethodCompilationStat::kRemovedClinitCheck);
+  }
+
+ private:
+  using InstructionMap = ScopedArenaSafeMap<mirror::Object*, ScopedArenaVector<HInstruction*>>;
+
+  static HInstruction* FindDominating(const InstructionMap& map,
+                                      mirror::Object* object,
+                                      HInstruction* instruction) {
+    auto it = map.find(object);
+    if (it != map.end()) {
+      for (HInstruction* candidate : it->second) {
+        if (candidate->StrictlyDominates(instruction)) {
+          return candidate;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  void Record(InstructionMap* map, mirror::Object* object, HInstruction* instruction) {
+    auto it = map->find(object);
+    if (it == map->end()) {
+      it = map->Put(object,
+                    ScopedArenaVector<HInstruction*>(scoped_allocator_.Adapter(kArenaAllocGvn)));
+    }
+    it->second.push_back(instruction);
+  }
+
+  // Initializing a class initializes its superclasses first, so after a successful
+  // initialization check of `klass`, all its superclasses are initialized as well.
+  void RecordInitialization(mirror::Class* klass, HInstruction* instruction)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    for (; klass != nullptr; klass = klass->GetSuperClass().Ptr()) {
+      Record(&initializations_, klass, instruction);
+    }
+  }
+
+  bool IsInitialized(mirror::Class* klass, HInstruction* instruction) const {
+    return FindDominating(initializations_, klass, instruction) != nullptr;
+  }
+
+  void Replace(HInstruction* instruction, HInstruction* existing) {
+    DCHECK_EQ(instruction->GetType(), existing->GetType());
+    instruction->ReplaceWith(existing);
+    instruction->GetBlock()->RemoveInstruction(instruction);
+    changed_ = true;
+    MaybeRecordStat(stats_, MethodCompilationStat::kRemovedDexCacheLoad);
+  }
+
+  ScopedArenaAllocator scoped_allocator_;
+
+  // Loads of classes and strings kept so far, by the loaded object.
+  InstructionMap loads_;
+
+  // Instructions which initialize a class, by the class and each of its superclasses.
+  InstructionMap initializations_;
+
+  OptimizingCompilerStats* const stats_;
+
+  bool changed_;
+
+  DISALLOW_COPY_AND_ASSIGN(DexCacheLoadEliminationImpl);
+};
+
+bool DexCacheLoadElimination::Run() {
+  // The loaded objects cannot move while we compare them.
+  ScopedObjectAccess soa(Thread::Current());
+  DexCacheLoadEliminationImpl impl(graph_, stats_);
+  // Reverse post order visits the dominating instructions first.
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    for (HInstructionIteratorHandleChanges it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (instruction->IsLoadClass()) {
+        impl.VisitLoadClass(instruction->AsLoadClass());
+      } else if (instruction->IsLoadString()) {
+        impl.VisitLoadString(instruction->AsLoadString());
+      } else if (instruction->IsClinitCheck()) {
+        impl.VisitClinitCheck(instruction->AsClinitCheck());
+      }
+    }
+  }
+  return impl.HasChanged();
+}
+
+}  // namespace art
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_DEX_CACHE_LOAD_ELIMINATION_H_
+#define ART_COMPILER_OPTIMIZING_DEX_CACHE_LOAD_ELIMINATION_H_
+
+#include "base/macros.h"
+#include "optimization.h"
+
+namespace art HIDDEN {
+
+/*
+ * Dex Cache Load Elimination.
+ *
+ * Removes `HLoadClass` and `HLoadString` instructions dominated by a load of the same
+ * class or string, and `HClinitCheck` instructions dominated by an initialization of the
+ * same class or one of its subclasses.
+ *
+ * Unlike GVN, loads are matched by the loaded object rather than by the dex file index, so
+ * loads from methods inlined from other dex files and loads with different load kinds are
+ * merged too. Initializing a class also initializes its superclasses, so the checks of
+ * the superclasses are known to pass after the check of a subclass.
+ */
+class DexCacheLoadElimination : public HOptimization {
+ public:
+  DexCacheLoadElimination(HGraph* graph,
+                          OptimizingCompilerStats* stats,
+                          const char* name = kDexCacheLoadEliminationPassName)
+      : HOptimization(graph, name, stats) {}
+
+  bool Run() override;
+
+  static constexpr const char* kDexCacheLoadEliminationPassName = "dex_cache_load_elimination";
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(DexCacheLoadElimination);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_DEX_CACHE_LOAD_ELIMINATION_H_
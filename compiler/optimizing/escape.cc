@@ -150,4 +150,32 @@ bool DoesNotEscape(HInstruction* reference, NoEscapeCheck& no_escape) {
   return is_singleton_and_not_returned;
 }
 
+bool EscapesOnlyInBlocks(HInstruction* reference, const BitVector& blocks) {
+  if (!reference->IsNewInstance() && !reference->IsNewArray()) {
+    return false;
+  }
+  bool escapes_elsewhere = false;
+  LambdaEscapeVisitor visitor([&](HInstruction* escape) -> bool {
+    if (escape == reference) {
+      // Finalizable references always escape.
+      escapes_elsewhere = true;
+      return false;
+    } else if (escape->IsReturn() ||
+               escape->IsDeoptimize() ||
+               escape->IsInstanceOf() ||
+               escape->IsCheckCast()) {
+      // Not escapes that can alias the reference, see CalculateEscape.
+      return true;
+    }
+    HBasicBlock* block = escape->GetBlock();
+    if (block->IsTryBlock() || !blocks.IsBitSet(block->GetBlockId())) {
+      escapes_elsewhere = true;
+      return false;
+    }
+    return true;
+  });
+  VisitEscapes(reference, visitor);
+  return !escapes_elsewhere;
+}
+
 }  // namespace art
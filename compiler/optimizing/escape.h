@@ -21,6 +21,7 @@
 
 namespace art HIDDEN {
 
+class BitVector;
 class HInstruction;
 
 /*
@@ -146,6 +147,14 @@ inline bool DoesNotEscape(HInstruction* reference,
   return DoesNotEscape(reference, esc);
 }
 
+/*
+ * Returns true if `reference` is an allocation whose escapes, as computed by CalculateEscape,
+ * all happen in the blocks set in `blocks`, outside of try blocks. Returns and deoptimizations
+ * do not count as escapes here. Clients pass the blocks from which the method cannot return
+ * normally: the reference is then a singleton on every path that returns from the method.
+ */
+bool EscapesOnlyInBlocks(HInstruction* reference, const BitVector& blocks);
+
 }  // namespace art
 
 #endif  // ART_COMPILER_OPTIMIZING_ESCAPE_H_
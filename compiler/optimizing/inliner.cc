@@ -33,7 +33,9 @@
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
 #include "mirror/class_loader.h"
-#include "mirror/dex_cache.h"
+#include "mirror/dex_cache-inl.h"
+#include "mirror/method_handle_impl-inl.h"
+#include "mirror/method_type.h"
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
 #include "nodes.h"
@@ -65,6 +67,11 @@ static constexpr size_t kMaximumNumberOfCumulatedDexRegisters = 32;
 // much inlining compared to code locality.
 static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 
+// Factor by which the code item size limit is relaxed for calls with constant arguments.
+// Constant folding and DCE usually shrink such callees a lot once the arguments are
+// substituted, and the optimized body still has to fit the normal limit.
+static constexpr size_t kConstantArgumentsCodeUnitsFactor = 2;
+
 // Limit recursive polymorphic call inlining to prevent code bloat, since it can quickly get out of
 // hand in the presence of multiple Wrapper classes. We set this to 0 to disallow polymorphic
 // recursive calls at all.
@@ -73,6 +80,13 @@ static constexpr size_t kMaximumNumberOfPolymorphicRecursiveCalls = 0;
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
+// A receiver type of a polymorphic profile inline cache that has at least this percentage
+// of the sampled receivers is inlined alone, leaving the other types to the virtual call.
+static constexpr uint64_t kDominantReceiverTypePercentage = 90;
+
+// Minimum number of receiver samples for trusting the receiver frequencies.
+static constexpr uint64_t kMinimumReceiverSamples = 10;
+
 // Controls the use of inlining try catches.
 static constexpr bool kInlineTryCatches = true;
 
@@ -179,8 +193,10 @@ bool HInliner::Run() {
     for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
       HInstruction* next = instruction->GetNext();
       HInvoke* call = instruction->AsInvokeOrNull();
-      // As long as the call is not intrinsified, it is worth trying to inline.
-      if (call != nullptr && !codegen_->IsImplementedIntrinsic(call)) {
+      // As long as the call is not intrinsified, it is worth trying to inline. A
+      // MethodHandle.invokeExact with a known target is better inlined than intrinsified.
+      if (call != nullptr &&
+          (!codegen_->IsImplementedIntrinsic(call) || call->IsInvokePolymorphic())) {
         if (honor_noinline_directives) {
           // Debugging case: directives in method names control or assert on inlining.
           std::string callee_name =
@@ -201,6 +217,8 @@ bool HInliner::Run() {
             did_inline = true;
           }
         }
+      } else if (instruction->IsInstanceOf() || instruction->IsCheckCast()) {
+        TrySpeculateTypeCheck(instruction->AsTypeCheckInstruction());
       }
       instruction = next;
     }
@@ -375,6 +393,12 @@ ArtMethod* HInliner::FindMethodFromCHA(ArtMethod* resolved_method) {
     // We do not support HDeoptimize in OSR methods.
     return nullptr;
   }
+  if (!Runtime::Current()->GetJit()->GetCodeCache()->CanUseChaFor(
+          outermost_graph_->GetArtMethod())) {
+    // Code of this method kept being invalidated by class loading, don't compile the same
+    // assumptions again.
+    return nullptr;
+  }
   PointerSize pointer_size = caller_compilation_unit_.GetClassLinker()->GetImagePointerSize();
   ArtMethod* single_impl = resolved_method->GetSingleImplementation(pointer_size);
   if (single_impl == nullptr) {
@@ -414,6 +438,16 @@ static bool IsMethodVerified(ArtMethod* method)
   return false;
 }
 
+// Returns whether any argument of `invoke_instruction` is a constant.
+static bool HasConstantArguments(const HInvoke* invoke_instruction) {
+  for (size_t i = 0, e = invoke_instruction->GetNumberOfArguments(); i != e; ++i) {
+    if (invoke_instruction->InputAt(i)->IsConstant()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static bool AlwaysThrows(ArtMethod* method)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(method != nullptr);
@@ -456,6 +490,12 @@ bool HInliner::TryInline(HInvoke* invoke_instruction) {
     MaybeRecordStat(stats_, MethodCompilationStat::kNotInlinedUnresolved);
     return false;
   } else if (invoke_instruction->IsInvokePolymorphic()) {
+    {
+      ScopedObjectAccess soa(Thread::Current());
+      if (TryInlineMethodHandleInvokeExact(invoke_instruction->AsInvokePolymorphic())) {
+        return true;
+      }
+    }
     MaybeRecordStat(stats_, MethodCompilationStat::kNotInlinedPolymorphic);
     return false;
   } else if (invoke_instruction->IsInvokeCustom()) {
@@ -668,11 +708,18 @@ bool HInliner::TryInlineFromInlineCache(HInvoke* invoke_instruction)
     }
 
     case kInlineCacheMegamorphic: {
+      MaybeRecordStat(stats_, MethodCompilationStat::kMegamorphicCall);
+      // Many receiver types often share a single implementation, e.g. one inherited from a
+      // common base class. If all the types we recorded do, inline it behind a guard and keep
+      // the call for the other types.
+      if (TryInlinePolymorphicCallToSameTarget(
+              invoke_instruction, classes, /* is_megamorphic= */ true)) {
+        return true;
+      }
       LOG_FAIL_NO_STAT()
           << "Interface or virtual call to "
           << invoke_instruction->GetMethodReference().PrettyMethod()
           << " is megamorphic and not inlined";
-      MaybeRecordStat(stats_, MethodCompilationStat::kMegamorphicCall);
       return false;
     }
 
@@ -769,11 +816,35 @@ HInliner::InlineCacheType HInliner::GetInlineCacheAOT(
   }
   DCHECK_LE(dex_pc_data.classes.size(), InlineCache::kIndividualCacheSize);
 
+  // If the profile has receiver frequencies and one type dominates, only inline that type.
+  // This needs a virtual call fallback for the other types instead of a deoptimization.
+  dex::TypeIndex dominant_type_index;
+  if (dex_pc_data.classes.size() > 1u && UseOnlyPolymorphicInliningWithNoDeopt()) {
+    uint64_t total_count = 0u;
+    for (const auto& [type_index, count] : dex_pc_data.counts) {
+      total_count += count;
+      if (!dominant_type_index.IsValid() || count > dex_pc_data.GetCount(dominant_type_index)) {
+        dominant_type_index = type_index;
+      }
+    }
+    if (total_count < kMinimumReceiverSamples ||
+        static_cast<uint64_t>(dex_pc_data.GetCount(dominant_type_index)) * 100u <
+            total_count * kDominantReceiverTypePercentage) {
+      dominant_type_index = dex::TypeIndex();
+    } else {
+      LOG_NOTE() << "Inlining only the dominant receiver type for call to "
+                 << invoke_instruction->GetMethodReference().PrettyMethod();
+    }
+  }
+
   // Walk over the class descriptors and look up the actual classes.
   // If we cannot find a type we return kInlineCacheMissingTypes.
   ClassLinker* class_linker = caller_compilation_unit_.GetClassLinker();
   Thread* self = Thread::Current();
   for (const dex::TypeIndex& type_index : dex_pc_data.classes) {
+    if (dominant_type_index.IsValid() && type_index != dominant_type_index) {
+      continue;
+    }
     const DexFile* dex_file = caller_compilation_unit_.GetDexFile();
     const char* descriptor = pci->GetTypeDescriptor(dex_file, type_index);
     ObjPtr<mirror::Class> clazz =
@@ -1025,7 +1096,8 @@ bool HInliner::TryInlinePolymorphicCall(
   DCHECK(invoke_instruction->IsInvokeVirtual() || invoke_instruction->IsInvokeInterface())
       << invoke_instruction->DebugName();
 
-  if (TryInlinePolymorphicCallToSameTarget(invoke_instruction, classes)) {
+  if (TryInlinePolymorphicCallToSameTarget(
+          invoke_instruction, classes, /* is_megamorphic= */ false)) {
     return true;
   }
 
@@ -1200,9 +1272,113 @@ void HInliner::CreateDiamondPatternForPolymorphicInline(HInstruction* compare,
       merge, original_invoke_block, /* replace_if_back_edge= */ true);
 }
 
+bool HInliner::TrySpeculateTypeCheck(HTypeCheckInstruction* check) {
+  // Type checks are only profiled by baseline JIT code.
+  if (!codegen_->GetCompilerOptions().IsJitCompiler() || graph_->IsCompilingBaseline()) {
+    return false;
+  }
+  switch (check->GetTypeCheckKind()) {
+    case TypeCheckKind::kAbstractClassCheck:
+    case TypeCheckKind::kClassHierarchyCheck:
+    case TypeCheckKind::kArrayObjectCheck:
+    case TypeCheckKind::kInterfaceCheck:
+      break;
+    default:
+      return false;
+  }
+  HInstruction* object = check->InputAt(0);
+  if (object->GetReferenceTypeInfo().IsExact()) {
+    return false;
+  }
+  // The dex pc of the type check is relative to the method of `graph_`, so look only
+  // at the profiling info of that method.
+  ProfilingInfo* profiling_info = graph_->GetProfilingInfo();
+  if (profiling_info == nullptr) {
+    return false;
+  }
+  InlineCache* cache = profiling_info->GetInlineCache(check->GetDexPc());
+  if (cache == nullptr) {
+    return false;
+  }
+
+  ScopedObjectAccess soa(Thread::Current());
+  if (!InlineCache::IsTypeCheckDexPc(graph_->GetArtMethod(), check->GetDexPc())) {
+    return false;
+  }
+  ReferenceTypeInfo object_rti = object->GetReferenceTypeInfo();
+  if (object_rti.IsValid() &&
+      check->GetClass()->IsAssignableFrom(object_rti.GetTypeHandle().Get())) {
+    // The instruction simplifier will remove the type check.
+    return false;
+  }
+  StackHandleScope<InlineCache::kIndividualCacheSize> classes(soa.Self());
+  Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(*cache, &classes);
+  if (GetInlineCacheType(classes) != kInlineCacheMonomorphic) {
+    return false;
+  }
+  // Only speculate on a class passing the check. Objects of other classes,
+  // including those failing the check, take the original type check.
+  ObjPtr<mirror::Class> profiled_class = GetMonomorphicType(classes);
+  if (!check->GetClass()->IsAssignableFrom(profiled_class)) {
+    return false;
+  }
+  dex::TypeIndex class_index = FindClassIndexIn(profiled_class, caller_compilation_unit_);
+  if (!class_index.IsValid()) {
+    return false;
+  }
+
+  // Add a fast exact check of the profiled class before the original type check:
+  //   if (object.getClass() != ic.GetMonomorphicType()) { original type check }
+  // For an `HInstanceOf`, the result is a phi of 1 and the original type check.
+  uint32_t dex_pc = check->GetDexPc();
+  ArenaAllocator* allocator = graph_->GetAllocator();
+  Handle<mirror::Class> klass = graph_->GetHandleCache()->NewHandle(profiled_class);
+  HLoadClass* load_class = new (allocator) HLoadClass(
+      graph_->GetCurrentMethod(),
+      class_index,
+      *caller_compilation_unit_.GetDexFile(),
+      klass,
+      klass.Get() == outermost_graph_->GetArtMethod()->GetDeclaringClass(),
+      dex_pc,
+      /* needs_access_check= */ false);
+  HLoadClass::LoadKind kind = HSharpening::ComputeLoadClassKind(
+      load_class, codegen_, caller_compilation_unit_);
+  DCHECK(kind != HLoadClass::LoadKind::kInvalid)
+      << "We should always be able to reference a class for inline caches";
+  // Load kind must be set before inserting the instruction into the graph.
+  load_class->SetLoadKind(kind);
+  DCHECK(!load_class->NeedsEnvironment());
+  HInstanceOf* exact_check = new (allocator) HInstanceOf(object,
+                                                         load_class,
+                                                         TypeCheckKind::kExactCheck,
+                                                         klass,
+                                                         dex_pc,
+                                                         allocator,
+                                                         /* bitstring_path_to_root= */ nullptr,
+                                                         /* bitstring_mask= */ nullptr);
+  if (!check->MustDoNullCheck()) {
+    exact_check->ClearMustDoNullCheck();
+  }
+  HEqual* compare = new (allocator) HEqual(exact_check, graph_->GetIntConstant(0), dex_pc);
+  HBasicBlock* block = check->GetBlock();
+  block->InsertInstructionBefore(load_class, check);
+  block->InsertInstructionBefore(exact_check, check);
+  block->InsertInstructionBefore(compare, check);
+
+  CreateDiamondPatternForPolymorphicInline(
+      compare, check->IsInstanceOf() ? graph_->GetIntConstant(1) : nullptr, check);
+
+  // Lazily run type propagation to get the new instructions typed.
+  run_extra_type_propagation_ = true;
+
+  MaybeRecordStat(stats_, MethodCompilationStat::kSpeculatedTypeCheck);
+  return true;
+}
+
 bool HInliner::TryInlinePolymorphicCallToSameTarget(
     HInvoke* invoke_instruction,
-    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes) {
+    const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+    bool is_megamorphic) {
   // This optimization only works under JIT for now.
   if (!codegen_->GetCompilerOptions().IsJitCompiler()) {
     return false;
@@ -1293,7 +1469,9 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
   bb_cursor->InsertInstructionAfter(class_table_get, receiver_class);
   bb_cursor->InsertInstructionAfter(compare, class_table_get);
 
-  if (outermost_graph_->IsCompilingOsr()) {
+  // A megamorphic call site has seen more types than we recorded, so the guard is expected to
+  // fail at times: fall back to the call instead of deoptimizing.
+  if (outermost_graph_->IsCompilingOsr() || is_megamorphic) {
     CreateDiamondPatternForPolymorphicInline(compare, return_replacement, invoke_instruction);
   } else {
     HDeoptimize* deoptimize = new (graph_->GetAllocator()) HDeoptimize(
@@ -1311,9 +1489,238 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
 
   // Lazily run type propagation to get the guard typed.
   run_extra_type_propagation_ = true;
-  MaybeRecordStat(stats_, MethodCompilationStat::kInlinedPolymorphicCall);
+  MaybeRecordStat(stats_,
+                  is_megamorphic ? MethodCompilationStat::kInlinedMegamorphicCall
+                                 : MethodCompilationStat::kInlinedPolymorphicCall);
+
+  LOG_SUCCESS() << "Inlined same " << (is_megamorphic ? "megamorphic" : "polymorphic")
+                << " target " << actual_method->PrettyMethod();
+  return true;
+}
+
+HInstanceFieldGet* HInliner::BuildGetMethodHandleField(HInstruction* method_handle,
+                                                       ArtField* field,
+                                                       DataType::Type type,
+                                                       uint32_t dex_pc) const {
+  DCHECK_EQ(DataType::FromShorty(field->GetTypeDescriptor()[0]), type);
+  HInstanceFieldGet* result = new (graph_->GetAllocator()) HInstanceFieldGet(
+      method_handle,
+      field,
+      type,
+      field->GetOffset(),
+      field->IsVolatile(),
+      field->GetDexFieldIndex(),
+      field->GetDeclaringClass()->GetDexClassDefIndex(),
+      *field->GetDexFile(),
+      dex_pc);
+  // The fields we check are only set when the method handle is created.
+  result->SetSideEffects(SideEffects::None());
+  return result;
+}
+
+bool HInliner::TryInlineMethodHandleInvokeExact(HInvokePolymorphic* invoke_instruction) {
+  // The guard needs the call site's MethodType, which is only passed for the invokeExact
+  // intrinsic, and the method handle itself, which only the JIT can read.
+  if (!invoke_instruction->CanHaveFastPath() ||
+      !codegen_->GetCompilerOptions().IsJitCompiler()) {
+    return false;
+  }
+
+  // Look for `static final MethodHandle` fields of initialized classes, the usual way of
+  // holding a method handle created with a MethodHandles.Lookup.
+  HInstruction* method_handle = invoke_instruction->InputAt(0);
+  HInstruction* method_handle_source = method_handle;
+  while (method_handle_source->IsNullCheck()) {
+    method_handle_source = method_handle_source->InputAt(0);
+  }
+  if (!method_handle_source->IsStaticFieldGet()) {
+    return false;
+  }
+  ArtField* field = method_handle_source->AsStaticFieldGet()->GetFieldInfo().GetField();
+  if (field == nullptr ||
+      !field->IsFinal() ||
+      !field->GetDeclaringClass()->IsVisiblyInitialized()) {
+    return false;
+  }
+  ClassLinker* class_linker = caller_compilation_unit_.GetClassLinker();
+  ObjPtr<mirror::Object> value = field->GetObject(field->GetDeclaringClass());
+  if (value == nullptr ||
+      value->GetClass() != GetClassRoot<mirror::MethodHandleImpl>(class_linker)) {
+    return false;
+  }
+  ObjPtr<mirror::MethodHandle> expected = ObjPtr<mirror::MethodHandle>::DownCast(value);
+
+  // The guard compares the call site's MethodType by reference, like the intrinsic does, so
+  // only speculate if the resolved call site type is the handle's type.
+  ObjPtr<mirror::MethodType> call_site_type =
+      caller_compilation_unit_.GetDexCache()->GetResolvedMethodType(
+          invoke_instruction->GetProtoIndex());
+  if (call_site_type == nullptr || call_site_type != expected->GetMethodType()) {
+    return false;
+  }
 
-  LOG_SUCCESS() << "Inlined same polymorphic target " << actual_method->PrettyMethod();
+  // Only handle kinds that map to a plain invoke of the target method.
+  mirror::MethodHandle::Kind kind = expected->GetHandleKind();
+  ArtMethod* method = expected->GetTargetMethod();
+  bool is_virtual = false;
+  switch (kind) {
+    case mirror::MethodHandle::Kind::kInvokeVirtual:
+      // `findVirtual` on an interface method also creates a kInvokeVirtual handle.
+      if (method->IsStatic() || method->GetDeclaringClass()->IsInterface()) {
+        return false;
+      }
+      is_virtual = !method->IsPrivate() && !IsMethodOrDeclaringClassFinal(method);
+      break;
+    case mirror::MethodHandle::Kind::kInvokeDirect:
+      // String constructors need to be replaced with StringFactory calls.
+      if (method->IsStatic() || method->IsConstructor()) {
+        return false;
+      }
+      break;
+    case mirror::MethodHandle::Kind::kInvokeStatic:
+      // We do not emit a class initialization check.
+      if (!method->IsStatic() || !method->GetDeclaringClass()->IsVisiblyInitialized()) {
+        return false;
+      }
+      break;
+    default:
+      return false;
+  }
+  if (method->IsIntrinsic() && !IsValidIntrinsicAfterBuilder(method->GetIntrinsic())) {
+    return false;
+  }
+
+  ObjPtr<mirror::Class> method_handle_class = GetClassRoot<mirror::MethodHandle>(class_linker);
+  ArtField* kind_field = method_handle_class->FindDeclaredInstanceField("handleKind", "I");
+  ArtField* type_field =
+      method_handle_class->FindDeclaredInstanceField("type", "Ljava/lang/invoke/MethodType;");
+  ArtField* target_field =
+      method_handle_class->FindDeclaredInstanceField("artFieldOrMethod", "J");
+  DCHECK(kind_field != nullptr && type_field != nullptr && target_field != nullptr);
+  DCHECK_EQ(kind_field->GetOffset().Uint32Value(),
+            mirror::MethodHandle::HandleKindOffset().Uint32Value());
+  DCHECK_EQ(type_field->GetOffset().Uint32Value(),
+            mirror::MethodHandle::MethodTypeOffset().Uint32Value());
+  DCHECK_EQ(target_field->GetOffset().Uint32Value(),
+            mirror::MethodHandle::ArtFieldOrMethodOffset().Uint32Value());
+
+  uint32_t dex_pc = invoke_instruction->GetDexPc();
+  DataType::Type type = invoke_instruction->GetType();
+  ArenaAllocator* allocator = graph_->GetAllocator();
+  // The target may not have a method id in the caller's dex file. Its own method reference is
+  // enough here since JIT code does not need relocations for invokes.
+  MethodReference target_reference(method->GetDexFile(), method->GetDexMethodIndex());
+  // The method handle itself is not passed to the target.
+  uint32_t number_of_arguments = invoke_instruction->GetNumberOfArguments() - 1u;
+  HInvoke* target_invoke = nullptr;
+  if (is_virtual) {
+    target_invoke = new (allocator) HInvokeVirtual(allocator,
+                                                   number_of_arguments,
+                                                   type,
+                                                   dex_pc,
+                                                   target_reference,
+                                                   method,
+                                                   target_reference,
+                                                   method->GetMethodIndex(),
+                                                   !graph_->IsDebuggable());
+  } else {
+    HInvokeStaticOrDirect::DispatchInfo dispatch_info =
+        HSharpening::SharpenLoadMethod(method,
+                                       /* has_method_id= */ true,
+                                       /* for_interface_call= */ false,
+                                       codegen_);
+    // The runtime call entrypoints would decode the invoke-polymorphic instruction.
+    if (dispatch_info.method_load_kind == MethodLoadKind::kRuntimeCall ||
+        dispatch_info.code_ptr_location == CodePtrLocation::kCallCriticalNative) {
+      return false;
+    }
+    HInvokeStaticOrDirect* direct_invoke = new (allocator) HInvokeStaticOrDirect(
+        allocator,
+        number_of_arguments,
+        type,
+        dex_pc,
+        target_reference,
+        method,
+        dispatch_info,
+        method->IsStatic() ? kStatic : kDirect,
+        target_reference,
+        HInvokeStaticOrDirect::ClinitCheckRequirement::kNone,
+        !graph_->IsDebuggable());
+    if (HInvokeStaticOrDirect::NeedsCurrentMethodInput(dispatch_info)) {
+      direct_invoke->SetRawInputAt(direct_invoke->GetCurrentMethodIndexUnchecked(),
+                                   graph_->GetCurrentMethod());
+    }
+    target_invoke = direct_invoke;
+  }
+
+  HInstruction* cursor = invoke_instruction->GetPrevious();
+  HBasicBlock* bb_cursor = invoke_instruction->GetBlock();
+
+  // Pass the arguments of invokeExact, null checking the receiver as the target expects.
+  for (uint32_t i = 0; i != number_of_arguments; ++i) {
+    HInstruction* argument = invoke_instruction->InputAt(i + 1u);
+    if (i == 0u && !method->IsStatic()) {
+      HNullCheck* null_check = new (allocator) HNullCheck(argument, dex_pc);
+      bb_cursor->InsertInstructionBefore(null_check, invoke_instruction);
+      null_check->CopyEnvironmentFrom(invoke_instruction->GetEnvironment());
+      null_check->SetReferenceTypeInfoIfValid(argument->GetReferenceTypeInfo());
+      argument = null_check;
+    }
+    target_invoke->SetArgumentAt(i, argument);
+  }
+  bb_cursor->InsertInstructionBefore(target_invoke, invoke_instruction);
+  target_invoke->CopyEnvironmentFrom(invoke_instruction->GetEnvironment());
+  if (type == DataType::Type::kReference) {
+    target_invoke->SetReferenceTypeInfoIfValid(invoke_instruction->GetReferenceTypeInfo());
+  }
+
+  // Check that the method handle still has the kind, type and target we compiled for. The
+  // checks are folded with selects so that a single branch takes the invokeExact call.
+  HInstanceFieldGet* kind_get =
+      BuildGetMethodHandleField(method_handle, kind_field, DataType::Type::kInt32, dex_pc);
+  HInstanceFieldGet* type_get =
+      BuildGetMethodHandleField(method_handle, type_field, DataType::Type::kReference, dex_pc);
+  HInstanceFieldGet* target_get =
+      BuildGetMethodHandleField(method_handle, target_field, DataType::Type::kInt64, dex_pc);
+  HInstruction* call_site_type_input =
+      invoke_instruction->InputAt(invoke_instruction->GetNumberOfArguments());
+  HNotEqual* kind_mismatch =
+      new (allocator) HNotEqual(kind_get, graph_->GetIntConstant(kind, dex_pc));
+  HNotEqual* type_mismatch = new (allocator) HNotEqual(type_get, call_site_type_input);
+  HLongConstant* zero = graph_->GetLongConstant(0, dex_pc);
+  HSelect* checked_type = new (allocator) HSelect(type_mismatch, zero, target_get, dex_pc);
+  HSelect* checked_kind = new (allocator) HSelect(kind_mismatch, zero, checked_type, dex_pc);
+  HNotEqual* compare = new (allocator) HNotEqual(
+      checked_kind,
+      graph_->GetLongConstant(static_cast<int64_t>(reinterpret_cast<uintptr_t>(method)), dex_pc));
+  if (cursor != nullptr) {
+    bb_cursor->InsertInstructionAfter(kind_get, cursor);
+  } else {
+    bb_cursor->InsertInstructionBefore(kind_get, bb_cursor->GetFirstInstruction());
+  }
+  bb_cursor->InsertInstructionAfter(type_get, kind_get);
+  bb_cursor->InsertInstructionAfter(target_get, type_get);
+  bb_cursor->InsertInstructionAfter(kind_mismatch, target_get);
+  bb_cursor->InsertInstructionAfter(type_mismatch, kind_mismatch);
+  bb_cursor->InsertInstructionAfter(checked_type, type_mismatch);
+  bb_cursor->InsertInstructionAfter(checked_kind, checked_type);
+  bb_cursor->InsertInstructionAfter(compare, checked_kind);
+
+  CreateDiamondPatternForPolymorphicInline(
+      compare, type != DataType::Type::kVoid ? target_invoke : nullptr, invoke_instruction);
+
+  // Lazily run type propagation to get the new instructions typed.
+  run_extra_type_propagation_ = true;
+  MaybeRecordStat(stats_, MethodCompilationStat::kSpeculatedMethodHandleTarget);
+  LOG_NOTE() << "Speculated MethodHandle target " << method->PrettyMethod();
+
+  // Now try to inline the target. If we cannot, we still call it without going through the
+  // method handle machinery.
+  bool honor_noinline_directives = codegen_->GetCompilerOptions().CompileArtTest();
+  if (!honor_noinline_directives ||
+      method->PrettyMethod(/* with_signature= */ false).find("$noinline$") == std::string::npos) {
+    TryInline(target_invoke);
+  }
   return true;
 }
 
@@ -1560,6 +1967,11 @@ bool HInliner::IsInliningEncouraged(const HInvoke* invoke_instruction,
   }
 
   size_t inline_max_code_units = codegen_->GetCompilerOptions().GetInlineMaxCodeUnits();
+  // Callees with constant arguments get a larger limit here; TryBuildAndInlineHelper()
+  // checks that the body fits the normal limit once the constants have been propagated.
+  if (!graph_->IsCompilingBaseline() && HasConstantArguments(invoke_instruction)) {
+    inline_max_code_units *= kConstantArgumentsCodeUnitsFactor;
+  }
   if (accessor.InsnsSizeInCodeUnits() > inline_max_code_units) {
     LOG_FAIL(stats_, MethodCompilationStat::kNotInlinedCodeItem)
         << "Method " << method->PrettyMethod()
@@ -1670,6 +2082,7 @@ bool HInliner::TryBuildAndInline(HInvoke* invoke_instruction,
 
   LOG_SUCCESS() << method->PrettyMethod();
   MaybeRecordStat(stats_, MethodCompilationStat::kInlinedInvoke);
+  outermost_graph_->IncrementNumberOfInlinedInvokes();
   if (outermost_graph_ == graph_) {
     MaybeRecordStat(stats_, MethodCompilationStat::kInlinedLastInvoke);
   }
@@ -2278,6 +2691,20 @@ bool HInliner::TryBuildAndInlineHelper(HInvoke* invoke_instruction,
     return false;
   }
 
+  // A code item over the normal limit was only accepted because of constant arguments.
+  // Inline it only if propagating them made the body small enough.
+  size_t inline_max_code_units = codegen_->GetCompilerOptions().GetInlineMaxCodeUnits();
+  if (code_item_accessor.InsnsSizeInCodeUnits() > inline_max_code_units) {
+    if (number_of_instructions > inline_max_code_units) {
+      LOG_FAIL(stats_, MethodCompilationStat::kNotInlinedCodeItem)
+          << "Method " << resolved_method->PrettyMethod()
+          << " is not inlined because its body is still too big after propagating constant"
+          << " arguments: " << number_of_instructions << " > " << inline_max_code_units;
+      return false;
+    }
+    MaybeRecordStat(stats_, MethodCompilationStat::kInlinedWithConstantArguments);
+  }
+
   DCHECK_EQ(caller_instruction_counter, graph_->GetCurrentInstructionId())
       << "No instructions can be added to the outer graph while inner graph is being built";
 
@@ -225,9 +225,35 @@ class HInliner : public HOptimization {
                                 const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Try to inline the target of a call whose recorded receiver types all dispatch to the same
+  // method. If `is_megamorphic`, other types have been seen too, and the original call is kept
+  // for them instead of deoptimizing when the guard fails.
   bool TryInlinePolymorphicCallToSameTarget(
       HInvoke* invoke_instruction,
-      const StackHandleScope<InlineCache::kIndividualCacheSize>& classes)
+      const StackHandleScope<InlineCache::kIndividualCacheSize>& classes,
+      bool is_megamorphic)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Try to speculate that the object checked by `check` is of the class recorded by the
+  // type check inline cache. If successful, the code in the graph will look like:
+  // if (object.getClass() != ic.GetMonomorphicType()) { check }
+  bool TrySpeculateTypeCheck(HTypeCheckInstruction* check);
+
+  // Try to turn a MethodHandle.invokeExact call on a method handle held in a static final field
+  // into a call to the handle's target method, and to inline it. If successful, the code in the
+  // graph will look like:
+  // if (mh.handleKind != kind || mh.type != call_site_type || mh.artFieldOrMethod != target) {
+  //   mh.invokeExact(...)
+  // } else {
+  //   ... // inlined code or call to target
+  // }
+  bool TryInlineMethodHandleInvokeExact(HInvokePolymorphic* invoke_instruction)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
+  HInstanceFieldGet* BuildGetMethodHandleField(HInstruction* method_handle,
+                                               ArtField* field,
+                                               DataType::Type type,
+                                               uint32_t dex_pc) const
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Returns whether or not we should use only polymorphic inlining with no deoptimizations.
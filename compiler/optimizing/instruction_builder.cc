@@ -918,6 +918,19 @@ static InvokeType GetInvokeTypeFromOpCode(Instruction::Code opcode) {
   }
 }
 
+// Record that the code of `graph` depends on `klass`, and on the component types of an array
+// class, so that the code can be invalidated if any of them is structurally redefined.
+static void AddClassDependency(HGraph* graph, ObjPtr<mirror::Class> klass)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (!graph->IsDebuggable() || !Runtime::Current()->UseJitCompilation()) {
+    // Classes can only be redefined in debuggable runtimes, and AOT code is never kept.
+    return;
+  }
+  for (; klass != nullptr && !klass->IsPrimitive(); klass = klass->GetComponentType()) {
+    graph->AddClassDependency(klass->DescriptorHash());
+  }
+}
+
 // Try to resolve a method using the class linker. Return null if a method could
 // not be resolved or the resolved method cannot be used for some reason.
 // Also retrieve method data needed for creating the invoke intermediate
@@ -925,6 +938,7 @@ static InvokeType GetInvokeTypeFromOpCode(Instruction::Code opcode) {
 static ArtMethod* ResolveMethod(uint16_t method_idx,
                                 ArtMethod* referrer,
                                 const DexCompilationUnit& dex_compilation_unit,
+                                HGraph* graph,
                                 /*inout*/InvokeType* invoke_type,
                                 /*out*/MethodReference* resolved_method_info,
                                 /*out*/uint16_t* imt_or_vtable_index,
@@ -1030,6 +1044,7 @@ static ArtMethod* ResolveMethod(uint16_t method_idx,
 
   *is_string_constructor = resolved_method->IsStringConstructor();
 
+  AddClassDependency(graph, resolved_method->GetDeclaringClass());
   return resolved_method;
 }
 
@@ -1054,6 +1069,7 @@ bool HInstructionBuilder::BuildInvoke(const Instruction& instruction,
   ArtMethod* resolved_method = ResolveMethod(method_idx,
                                              graph_->GetArtMethod(),
                                              *dex_compilation_unit_,
+                                             graph_,
                                              &invoke_type,
                                              &resolved_method_reference,
                                              &imt_or_vtable_index,
@@ -1384,6 +1400,7 @@ bool HInstructionBuilder::BuildInvokePolymorphic(uint32_t dex_pc,
   ArtMethod* resolved_method = ResolveMethod(method_idx,
                                             graph_->GetArtMethod(),
                                             *dex_compilation_unit_,
+                                            graph_,
                                             &invoke_type,
                                             &resolved_method_reference,
                                             &imt_or_vtable_index,
@@ -2333,6 +2350,7 @@ ArtField* HInstructionBuilder::ResolveField(uint16_t field_idx, bool is_static,
     resolved_field = resolved_field_handle.Get();
   }
 
+  AddClassDependency(graph_, resolved_field->GetDeclaringClass());
   return resolved_field;
 }
 
@@ -2677,6 +2695,7 @@ Handle<mirror::Class> HInstructionBuilder::ResolveClass(ScopedObjectAccess& soa,
       type_index, dex_compilation_unit_->GetDexCache(), dex_compilation_unit_->GetClassLoader());
   DCHECK_EQ(klass == nullptr, soa.Self()->IsExceptionPending());
   soa.Self()->ClearException();  // Clean up the exception left by type resolution if any.
+  AddClassDependency(graph_, klass);
 
   Handle<mirror::Class> h_klass = graph_->GetHandleCache()->NewHandle(klass);
   class_cache_.Put(type_index, h_klass);
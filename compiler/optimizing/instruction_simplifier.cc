@@ -79,6 +79,7 @@ class InstructionSimplifierVisitor final : public HGraphDelegateVisitor {
   void VisitEqual(HEqual* equal) override;
   void VisitNotEqual(HNotEqual* equal) override;
   void VisitBooleanNot(HBooleanNot* bool_not) override;
+  void VisitInstanceFieldGet(HInstanceFieldGet* instruction) override;
   void VisitInstanceFieldSet(HInstanceFieldSet* equal) override;
   void VisitStaticFieldSet(HStaticFieldSet* equal) override;
   void VisitArraySet(HArraySet* equal) override;
@@ -288,6 +289,8 @@ bool InstructionSimplifierVisitor::TryCombineVecMultiplyAccumulate(HVecMul* mul)
   DataType::Type type = mul->GetPackedType();
   InstructionSet isa = codegen_->GetInstructionSet();
   switch (isa) {
+    case InstructionSet::kArm:
+    case InstructionSet::kThumb2:
     case InstructionSet::kArm64:
       if (!(type == DataType::Type::kUint8 ||
             type == DataType::Type::kInt8 ||
@@ -2700,6 +2703,85 @@ void InstructionSimplifierVisitor::SimplifyBoxUnbox(
   }
 }
 
+// Returns the value boxed by `box` with the `intrinsic` `valueOf()`, looking through
+// instructions which do not change the reference, or null if it is not known.
+static HInstruction* FindBoxedValue(HInstruction* box, Intrinsics intrinsic) {
+  while (box->IsBoundType() || box->IsNullCheck()) {
+    box = box->InputAt(0);
+  }
+  if (box->IsInvoke() && box->AsInvoke()->GetIntrinsic() == intrinsic) {
+    return box->InputAt(0);
+  }
+  return nullptr;
+}
+
+// Unbox a phi of boxed values by creating a phi of the values, or reusing an existing one.
+static HInstruction* UnboxPhi(HPhi* phi, Intrinsics intrinsic, DataType::Type type) {
+  HBasicBlock* block = phi->GetBlock();
+  if (block->IsCatchBlock() || HPhi::ToPhiType(type) != type) {
+    // Catch phis merge values at throwing instructions, not at the end of predecessors.
+    // Small types would need a conversion of the new phi.
+    return nullptr;
+  }
+  for (HInstruction* input : phi->GetInputs()) {
+    if (FindBoxedValue(input, intrinsic) == nullptr) {
+      return nullptr;
+    }
+  }
+  auto unboxes_phi = [&](HInstruction* other) {
+    for (size_t i = 0, e = phi->InputCount(); i != e; ++i) {
+      if (other->InputAt(i) != FindBoxedValue(phi->InputAt(i), intrinsic)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  for (HInstructionIterator it(block->GetPhis()); !it.Done(); it.Advance()) {
+    if (it.Current()->GetType() == type && unboxes_phi(it.Current())) {
+      return it.Current();
+    }
+  }
+  ArenaAllocator* allocator = block->GetGraph()->GetAllocator();
+  HPhi* new_phi = new (allocator) HPhi(allocator, kNoRegNumber, 0, type, phi->GetDexPc());
+  for (HInstruction* input : phi->GetInputs()) {
+    new_phi->AddInput(FindBoxedValue(input, intrinsic));
+  }
+  block->AddPhi(new_phi);
+  return new_phi;
+}
+
+void InstructionSimplifierVisitor::VisitInstanceFieldGet(HInstanceFieldGet* instruction) {
+  // Replace the `value` field of a boxed value with the value, possibly through a phi.
+  // This complements `SimplifyBoxUnbox()` once inlining collection methods has put
+  // `HBoundType` or phis between the `valueOf()` and the unboxing.
+  ArtField* field = instruction->GetFieldInfo().GetField();
+  Intrinsics intrinsic = Intrinsics::kNone;
+  DataType::Type type = DataType::Type::kVoid;
+#define FIND_BOXED_FIELD(name, low, high, boxed_type, start_index) \
+  if (field == WellKnownClasses::java_lang_##name##_value) { \
+    intrinsic = Intrinsics::k ## name ## ValueOf; \
+    type = boxed_type; \
+  }
+  BOXED_TYPES(FIND_BOXED_FIELD)
+#undef FIND_BOXED_FIELD
+  if (intrinsic == Intrinsics::kNone || instruction->GetType() != type) {
+    return;
+  }
+
+  HInstruction* box = instruction->InputAt(0);
+  while (box->IsBoundType() || box->IsNullCheck()) {
+    box = box->InputAt(0);
+  }
+  HInstruction* value = box->IsPhi()
+      ? UnboxPhi(box->AsPhi(), intrinsic, type)
+      : FindBoxedValue(box, intrinsic);
+  if (value != nullptr) {
+    instruction->ReplaceWith(value);
+    instruction->GetBlock()->RemoveInstruction(instruction);
+    RecordSimplification();
+  }
+}
+
 void InstructionSimplifierVisitor::SimplifyStringEquals(HInvoke* instruction) {
   HInstruction* argument = instruction->InputAt(1);
   HInstruction* receiver = instruction->InputAt(0);
@@ -2996,6 +3078,17 @@ static bool NoEscapeForStringBufferReference(HInstruction* reference, HInstructi
   return false;
 }
 
+static bool IsStringArgument(HInstruction* arg) {
+  ReferenceTypeInfo rti = arg->GetReferenceTypeInfo();
+  if (!rti.IsValid()) {
+    return false;
+  }
+  ScopedObjectAccess soa(Thread::Current());
+  Handle<mirror::Class> input_type = rti.GetTypeHandle();
+  DCHECK(input_type != nullptr);
+  return input_type.Get() == GetClassRoot<mirror::String>();
+}
+
 static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
   DCHECK_EQ(invoke->GetIntrinsic(), Intrinsics::kStringBuilderToString);
   if (invoke->CanThrowIntoCatchBlock()) {
@@ -3024,15 +3117,17 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
   }
 
   // Collect args and check for unexpected uses.
-  // We expect one call to a constructor with no arguments, one constructor fence (unless
-  // eliminated), some number of append calls and one call to StringBuilder.toString().
+  // We expect one call to a constructor, one constructor fence (unless eliminated), some
+  // number of append calls and one call to StringBuilder.toString().
+  // Chains with more arguments than fit in one format are split into several runtime calls,
+  // each one appending the result of the previous one first.
+  static constexpr size_t kMaxFusedArgs = 4u * StringBuilderAppend::kMaxArgs;
   bool seen_constructor = false;
   bool seen_constructor_fence = false;
   bool seen_to_string = false;
-  uint32_t format = 0u;
   uint32_t num_args = 0u;
-  bool has_fp_args = false;
-  HInstruction* args[StringBuilderAppend::kMaxArgs];  // Added in reverse order.
+  StringBuilderAppend::Argument arg_types[kMaxFusedArgs];  // Added in reverse order.
+  HInstruction* args[kMaxFusedArgs];  // Added in reverse order.
   for (HBackwardInstructionIterator iter(block->GetInstructions()); !iter.Done(); iter.Advance()) {
     HInstruction* user = iter.Current();
     // Instructions of interest apply to `sb`, skip those that do not involve `sb`.
@@ -3079,21 +3174,12 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
           break;
         case Intrinsics::kStringBuilderAppendFloat:
           arg = StringBuilderAppend::Argument::kFloat;
-          has_fp_args = true;
           break;
         case Intrinsics::kStringBuilderAppendDouble:
           arg = StringBuilderAppend::Argument::kDouble;
-          has_fp_args = true;
           break;
         case Intrinsics::kStringBuilderAppendCharSequence: {
-          ReferenceTypeInfo rti = user->AsInvokeVirtual()->InputAt(1)->GetReferenceTypeInfo();
-          if (!rti.IsValid()) {
-            return false;
-          }
-          ScopedObjectAccess soa(Thread::Current());
-          Handle<mirror::Class> input_type = rti.GetTypeHandle();
-          DCHECK(input_type != nullptr);
-          if (input_type.Get() == GetClassRoot<mirror::String>()) {
+          if (IsStringArgument(user->AsInvokeVirtual()->InputAt(1))) {
             arg = StringBuilderAppend::Argument::kString;
           } else {
             // TODO: Check and implement for StringBuilder. We could find the StringBuilder's
@@ -3111,20 +3197,38 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
       // Uses of the append return value should have been replaced with the first input.
       DCHECK(!as_invoke_virtual->HasUses());
       DCHECK(!as_invoke_virtual->HasEnvironmentUses());
-      if (num_args == StringBuilderAppend::kMaxArgs) {
+      if (num_args == kMaxFusedArgs) {
         return false;
       }
-      format = (format << StringBuilderAppend::kBitsPerArg) | static_cast<uint32_t>(arg);
+      arg_types[num_args] = arg;
       args[num_args] = as_invoke_virtual->InputAt(1u);
       ++num_args;
     } else if (user->IsInvokeStaticOrDirect() &&
                user->AsInvokeStaticOrDirect()->GetResolvedMethod() != nullptr &&
                user->AsInvokeStaticOrDirect()->GetResolvedMethod()->IsConstructor() &&
-               user->AsInvokeStaticOrDirect()->GetNumberOfArguments() == 1u) {
+               user->AsInvokeStaticOrDirect()->GetNumberOfArguments() <= 2u) {
       // After arguments, we should see the constructor.
-      // We accept only the constructor with no extra arguments.
       DCHECK(!seen_constructor);
       DCHECK(!seen_constructor_fence);
+      if (user->AsInvokeStaticOrDirect()->GetNumberOfArguments() == 2u) {
+        // Besides StringBuilder(), we accept StringBuilder(int) with a non-negative capacity
+        // constant, which cannot throw, and StringBuilder(String) or StringBuilder(CharSequence)
+        // with a non-null String, which start with that String.
+        HInstruction* ctor_arg = user->InputAt(1u);
+        if (ctor_arg->GetType() == DataType::Type::kReference) {
+          if (ctor_arg->CanBeNull() || !IsStringArgument(ctor_arg)) {
+            return false;
+          }
+          if (num_args == kMaxFusedArgs) {
+            return false;
+          }
+          arg_types[num_args] = StringBuilderAppend::Argument::kString;
+          args[num_args] = ctor_arg;
+          ++num_args;
+        } else if (!ctor_arg->IsIntConstant() || ctor_arg->AsIntConstant()->GetValue() < 0) {
+          return false;
+        }
+      }
       seen_constructor = true;
     } else if (user->IsConstructorFence()) {
       // The last use we see is the constructor fence.
@@ -3153,16 +3257,49 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
     }
   }
 
-  // Create replacement instruction.
-  HIntConstant* fmt = block->GetGraph()->GetIntConstant(static_cast<int32_t>(format));
+  // Create replacement instructions. The first argument is in the lowest bits of the format.
   ArenaAllocator* allocator = block->GetGraph()->GetAllocator();
-  HStringBuilderAppend* append = new (allocator) HStringBuilderAppend(
-      fmt, num_args, has_fp_args, allocator, invoke->GetDexPc());
-  append->SetReferenceTypeInfoIfValid(invoke->GetReferenceTypeInfo());
-  for (size_t i = 0; i != num_args; ++i) {
-    append->SetArgumentAt(i, args[num_args - 1u - i]);
+  HStringBuilderAppend* appends[kMaxFusedArgs];
+  size_t num_appends = 0u;
+  HStringBuilderAppend* append = nullptr;
+  size_t remaining_args = num_args;
+  while (remaining_args != 0u) {
+    size_t num_new_args = std::min<size_t>(
+        remaining_args, StringBuilderAppend::kMaxArgs - ((append != nullptr) ? 1u : 0u));
+    // The arguments of this call are args[remaining_args - 1u] down to
+    // args[remaining_args - num_new_args].
+    uint32_t format = 0u;
+    bool has_fp_args = false;
+    for (size_t i = remaining_args - num_new_args; i != remaining_args; ++i) {
+      format = (format << StringBuilderAppend::kBitsPerArg) | static_cast<uint32_t>(arg_types[i]);
+      has_fp_args = has_fp_args ||
+                    arg_types[i] == StringBuilderAppend::Argument::kFloat ||
+                    arg_types[i] == StringBuilderAppend::Argument::kDouble;
+    }
+    HStringBuilderAppend* previous = append;
+    if (previous != nullptr) {
+      format = (format << StringBuilderAppend::kBitsPerArg) |
+               static_cast<uint32_t>(StringBuilderAppend::Argument::kString);
+    }
+    HIntConstant* fmt = block->GetGraph()->GetIntConstant(static_cast<int32_t>(format));
+    size_t num_call_args = num_new_args + ((previous != nullptr) ? 1u : 0u);
+    append = new (allocator) HStringBuilderAppend(
+        fmt, num_call_args, has_fp_args, allocator, invoke->GetDexPc());
+    append->SetReferenceTypeInfoIfValid(invoke->GetReferenceTypeInfo());
+    size_t arg_index = 0u;
+    if (previous != nullptr) {
+      append->SetArgumentAt(arg_index, previous);
+      ++arg_index;
+    }
+    for (size_t i = 0; i != num_new_args; ++i) {
+      append->SetArgumentAt(arg_index, args[remaining_args - 1u - i]);
+      ++arg_index;
+    }
+    block->InsertInstructionBefore(append, invoke);
+    appends[num_appends] = append;
+    ++num_appends;
+    remaining_args -= num_new_args;
   }
-  block->InsertInstructionBefore(append, invoke);
   DCHECK(!invoke->CanBeNull());
   DCHECK(!append->CanBeNull());
   invoke->ReplaceWith(append);
@@ -3175,7 +3312,9 @@ static bool TryReplaceStringBuilderAppend(HInvoke* invoke) {
       }
     }
   }
-  append->CopyEnvironmentFrom(invoke->GetEnvironment());
+  for (size_t i = 0; i != num_appends; ++i) {
+    appends[i]->CopyEnvironmentFrom(invoke->GetEnvironment());
+  }
   // Remove the old instruction.
   block->RemoveInstruction(invoke);
   // Remove the StringBuilder's uses and StringBuilder.
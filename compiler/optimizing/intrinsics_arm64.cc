@@ -4372,6 +4372,10 @@ class VarHandleSlowPathARM64 : public IntrinsicSlowPathARM64 {
     return &byte_array_view_check_label_;
   }
 
+  vixl::aarch64::Label* GetByteBufferViewCheckLabel() {
+    return &byte_buffer_view_check_label_;
+  }
+
   vixl::aarch64::Label* GetNativeByteOrderLabel() {
     return &native_byte_order_label_;
   }
@@ -4392,7 +4396,7 @@ class VarHandleSlowPathARM64 : public IntrinsicSlowPathARM64 {
   }
 
   void EmitNativeCode(CodeGenerator* codegen_in) override {
-    if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    if (GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked()) {
       EmitByteArrayViewCode(codegen_in);
     }
     IntrinsicSlowPathARM64::EmitNativeCode(codegen_in);
@@ -4410,6 +4414,7 @@ class VarHandleSlowPathARM64 : public IntrinsicSlowPathARM64 {
   void EmitByteArrayViewCode(CodeGenerator* codegen_in);
 
   vixl::aarch64::Label byte_array_view_check_label_;
+  vixl::aarch64::Label byte_buffer_view_check_label_;
   vixl::aarch64::Label native_byte_order_label_;
   // Shared parameter for all VarHandle intrinsics.
   std::memory_order order_;
@@ -4589,6 +4594,12 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
     __ Cbz(object, slow_path->GetEntryLabel());
   }
 
+  if (IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // The VarHandle can only be a ByteBufferViewVarHandle, do all other checks in the slow path.
+    __ B(slow_path->GetByteBufferViewCheckLabel());
+    return;
+  }
+
   UseScratchRegisterScope temps(masm);
   Register temp = temps.AcquireW();
   Register temp2 = temps.AcquireW();
@@ -4694,20 +4705,35 @@ struct VarHandleTarget {
   Register offset;  // The offset of the value to operate on.
 };
 
-static VarHandleTarget GetVarHandleTarget(HInvoke* invoke) {
+static VarHandleTarget GetVarHandleTarget(HInvoke* invoke, CodeGeneratorARM64* codegen) {
   size_t expected_coordinates_count = GetExpectedVarHandleCoordinatesCount(invoke);
   LocationSummary* locations = invoke->GetLocations();
 
   VarHandleTarget target;
   // The temporary allocated for loading the offset.
   target.offset = WRegisterFrom(locations->GetTemp(0u));
-  // The reference to the object that holds the value to operate on.
-  target.object = (expected_coordinates_count == 0u)
-      ? WRegisterFrom(locations->GetTemp(1u))
-      : InputRegisterAt(invoke, 1);
+  // The reference to the object that holds the value to operate on. For ByteBuffer views,
+  // this is the backing array held in the last temporary.
+  if (expected_coordinates_count == 0u) {
+    target.object = WRegisterFrom(locations->GetTemp(1u));
+  } else if (expected_coordinates_count == 2u && IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    target.object = WRegisterFrom(locations->GetTemp(locations->GetTempCount() - 1u));
+  } else {
+    target.object = InputRegisterAt(invoke, 1);
+  }
   return target;
 }
 
+static void MaybeAddByteBufferViewTemp(HInvoke* invoke,
+                                       CodeGeneratorARM64* codegen,
+                                       LocationSummary* locations) {
+  if (GetExpectedVarHandleCoordinatesCount(invoke) == 2u &&
+      IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // Add a temporary for the array backing the ByteBuffer, see `GetVarHandleTarget()`.
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
 static void GenerateVarHandleTarget(HInvoke* invoke,
                                     const VarHandleTarget& target,
                                     CodeGeneratorARM64* codegen) {
@@ -4753,6 +4779,9 @@ static void GenerateVarHandleTarget(HInvoke* invoke,
                                          codegen->GetCompilerReadBarrierOption());
       }
     }
+  } else if (IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // The target is constructed by the ByteBuffer view checks in the slow path.
+    DCHECK_EQ(expected_coordinates_count, 2u);
   } else {
     DCHECK_EQ(expected_coordinates_count, 2u);
     DataType::Type value_type =
@@ -4838,7 +4867,8 @@ static void CreateVarHandleGetLocations(HInvoke* invoke, CodeGeneratorARM64* cod
     return;
   }
 
-  CreateVarHandleCommonLocations(invoke, codegen);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static void GenerateVarHandleGet(HInvoke* invoke,
@@ -4852,7 +4882,7 @@ static void GenerateVarHandleGet(HInvoke* invoke,
   MacroAssembler* masm = codegen->GetVIXLAssembler();
   CPURegister out = helpers::OutputCPURegister(invoke);
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathARM64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, type);
@@ -4958,7 +4988,8 @@ static void CreateVarHandleSetLocations(HInvoke* invoke, CodeGeneratorARM64* cod
     return;
   }
 
-  CreateVarHandleCommonLocations(invoke, codegen);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static void GenerateVarHandleSet(HInvoke* invoke,
@@ -4971,7 +5002,7 @@ static void GenerateVarHandleSet(HInvoke* invoke,
   MacroAssembler* masm = codegen->GetVIXLAssembler();
   CPURegister value = InputCPURegisterOrZeroRegAt(invoke, value_index);
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathARM64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, value_type);
@@ -5129,6 +5160,7 @@ static void CreateVarHandleCompareAndSetOrExchangeLocations(HInvoke* invoke,
     // Add a temporary for the `old_value_temp` in slow path.
     locations->AddTemp(Location::RequiresRegister());
   }
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static Register MoveToTempIfFpRegister(const CPURegister& cpu_reg,
@@ -5169,7 +5201,7 @@ static void GenerateVarHandleCompareAndSetOrExchange(HInvoke* invoke,
   CPURegister new_value = InputCPURegisterOrZeroRegAt(invoke, new_value_index);
   CPURegister out = helpers::OutputCPURegister(invoke);
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathARM64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, value_type);
@@ -5457,6 +5489,7 @@ static void CreateVarHandleGetAndUpdateLocations(HInvoke* invoke,
       locations->AddTemp(Location::RequiresRegister());
     }
   }
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static void GenerateVarHandleGetAndUpdate(HInvoke* invoke,
@@ -5475,7 +5508,7 @@ static void GenerateVarHandleGetAndUpdate(HInvoke* invoke,
       : InputCPURegisterOrZeroRegAt(invoke, arg_index);
   CPURegister out = helpers::OutputCPURegister(invoke);
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathARM64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, value_type);
@@ -5714,7 +5747,8 @@ void IntrinsicCodeGeneratorARM64::VisitVarHandleGetAndBitwiseXorRelease(HInvoke*
 }
 
 void VarHandleSlowPathARM64::EmitByteArrayViewCode(CodeGenerator* codegen_in) {
-  DCHECK(GetByteArrayViewCheckLabel()->IsLinked());
+  bool is_byte_buffer_view = GetByteBufferViewCheckLabel()->IsLinked();
+  DCHECK_NE(GetByteArrayViewCheckLabel()->IsLinked(), is_byte_buffer_view);
   CodeGeneratorARM64* codegen = down_cast<CodeGeneratorARM64*>(codegen_in);
   MacroAssembler* masm = codegen->GetVIXLAssembler();
   HInvoke* invoke = GetInvoke();
@@ -5731,33 +5765,79 @@ void VarHandleSlowPathARM64::EmitByteArrayViewCode(CodeGenerator* codegen_in) {
   MemberOffset class_offset = mirror::Object::ClassOffset();
   MemberOffset array_length_offset = mirror::Array::LengthOffset();
   MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
-  MemberOffset native_byte_order_offset = mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
-
-  __ Bind(GetByteArrayViewCheckLabel());
+  MemberOffset native_byte_order_offset = is_byte_buffer_view
+      ? mirror::ByteBufferViewVarHandle::NativeByteOrderOffset()
+      : mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   {
     UseScratchRegisterScope temps(masm);
     Register temp = temps.AcquireW();
     Register temp2 = temps.AcquireW();
 
-    // The main path checked that the coordinateType0 is an array class that matches
-    // the class of the actual coordinate argument but it does not match the value type.
-    // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
-    __ Ldr(temp, HeapOperand(varhandle, class_offset.Int32Value()));
-    codegen->GetAssembler()->MaybeUnpoisonHeapReference(temp);
-    codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
-    __ Cmp(temp, temp2);
-    __ B(GetEntryLabel(), ne);
-
-    // Check for array index out of bounds.
-    __ Ldr(temp, HeapOperand(object, array_length_offset.Int32Value()));
-    __ Subs(temp, temp, index);
-    __ Ccmp(temp, size, NoFlag, hs);  // If SUBS yields LO (C=false), keep the C flag clear.
-    __ B(GetEntryLabel(), lo);
-
-    // Construct the target.
-    __ Add(target.offset, index, data_offset.Int32Value());
+    if (is_byte_buffer_view) {
+      __ Bind(GetByteBufferViewCheckLabel());
+
+      // The main path checked only the access mode and the var type. The coordinate
+      // is a non-null ByteBuffer, check if the `varhandle` references a
+      // ByteBufferViewVarHandle instance.
+      __ Ldr(temp, HeapOperand(varhandle, class_offset.Int32Value()));
+      codegen->GetAssembler()->MaybeUnpoisonHeapReference(temp);
+      codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteBufferViewVarHandle);
+      __ Cmp(temp, temp2);
+      __ B(GetEntryLabel(), ne);
+
+      // Direct buffers are accessed by the runtime.
+      MemberOffset address_offset = WellKnownClasses::java_nio_Buffer_address->GetOffset();
+      __ Ldr(temp.X(), HeapOperand(object, address_offset.Int32Value()));
+      __ Cbnz(temp.X(), GetEntryLabel());
+
+      // Let the runtime throw the ReadOnlyBufferException for write access modes.
+      if (access_mode_template != mirror::VarHandle::AccessModeTemplate::kGet) {
+        MemberOffset is_read_only_offset =
+            WellKnownClasses::java_nio_ByteBuffer_isReadOnly->GetOffset();
+        __ Ldrb(temp, HeapOperand(object, is_read_only_offset.Int32Value()));
+        __ Cbnz(temp, GetEntryLabel());
+      }
+
+      // Check for buffer index out of bounds. The index is relative to the buffer offset.
+      MemberOffset limit_offset = WellKnownClasses::java_nio_Buffer_limit->GetOffset();
+      __ Ldr(temp, HeapOperand(object, limit_offset.Int32Value()));
+      __ Subs(temp, temp, index);
+      __ Ccmp(temp, size, NoFlag, hs);  // If SUBS yields LO (C=false), keep the C flag clear.
+      __ B(GetEntryLabel(), lo);
+
+      // Construct the target from the backing array and the buffer offset. We do not need
+      // a read barrier for loading the array as this path is used only without read barriers.
+      MemberOffset hb_offset = WellKnownClasses::java_nio_ByteBuffer_hb->GetOffset();
+      MemberOffset buffer_offset_offset = WellKnownClasses::java_nio_ByteBuffer_offset->GetOffset();
+      __ Ldr(target.object, HeapOperand(object, hb_offset.Int32Value()));
+      codegen->GetAssembler()->MaybeUnpoisonHeapReference(target.object);
+      __ Cbz(target.object, GetEntryLabel());
+      __ Ldr(temp, HeapOperand(object, buffer_offset_offset.Int32Value()));
+      __ Add(target.offset, index, data_offset.Int32Value());
+      __ Add(target.offset, target.offset, temp);
+    } else {
+      __ Bind(GetByteArrayViewCheckLabel());
+
+      // The main path checked that the coordinateType0 is an array class that matches
+      // the class of the actual coordinate argument but it does not match the value type.
+      // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
+      __ Ldr(temp, HeapOperand(varhandle, class_offset.Int32Value()));
+      codegen->GetAssembler()->MaybeUnpoisonHeapReference(temp);
+      codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
+      __ Cmp(temp, temp2);
+      __ B(GetEntryLabel(), ne);
+
+      // Check for array index out of bounds.
+      __ Ldr(temp, HeapOperand(object, array_length_offset.Int32Value()));
+      __ Subs(temp, temp, index);
+      __ Ccmp(temp, size, NoFlag, hs);  // If SUBS yields LO (C=false), keep the C flag clear.
+      __ B(GetEntryLabel(), lo);
+
+      // Construct the target.
+      __ Add(target.offset, index, data_offset.Int32Value());
+    }
 
     // Alignment check. For unaligned access, go to the runtime.
     DCHECK(IsPowerOfTwo(size));
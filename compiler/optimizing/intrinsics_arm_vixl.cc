@@ -54,6 +54,7 @@ using helpers::HighSRegisterFrom;
 using helpers::OperandFrom;
 using helpers::OutputDRegister;
 using helpers::OutputRegister;
+using helpers::OutputSRegister;
 using helpers::RegisterFrom;
 using helpers::SRegisterFrom;
 
@@ -363,6 +364,45 @@ void IntrinsicCodeGeneratorARMVIXL::VisitMathRint(HInvoke* invoke) {
   __ Vrintn(F64, OutputDRegister(invoke), InputDRegisterAt(invoke, 0));
 }
 
+static void CreateFPFPFPToFPLocations(ArenaAllocator* allocator, HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresFpuRegister());
+  locations->SetInAt(1, Location::RequiresFpuRegister());
+  locations->SetInAt(2, Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresFpuRegister(), Location::kNoOutputOverlap);
+}
+
+// VFMA accumulates into its destination, so copy the addend to the output first.
+// The fused multiply-add is part of VFPv4, which every ARMv8-A core provides.
+void IntrinsicLocationsBuilderARMVIXL::VisitMathFmaDouble(HInvoke* invoke) {
+  if (features_.HasARMv8AInstructions()) {
+    CreateFPFPFPToFPLocations(allocator_, invoke);
+  }
+}
+
+void IntrinsicCodeGeneratorARMVIXL::VisitMathFmaDouble(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasARMv8AInstructions());
+  ArmVIXLAssembler* assembler = GetAssembler();
+  vixl32::DRegister out = OutputDRegister(invoke);
+  __ Vmov(out, InputDRegisterAt(invoke, 2));
+  __ Vfma(F64, out, InputDRegisterAt(invoke, 0), InputDRegisterAt(invoke, 1));
+}
+
+void IntrinsicLocationsBuilderARMVIXL::VisitMathFmaFloat(HInvoke* invoke) {
+  if (features_.HasARMv8AInstructions()) {
+    CreateFPFPFPToFPLocations(allocator_, invoke);
+  }
+}
+
+void IntrinsicCodeGeneratorARMVIXL::VisitMathFmaFloat(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasARMv8AInstructions());
+  ArmVIXLAssembler* assembler = GetAssembler();
+  vixl32::SRegister out = OutputSRegister(invoke);
+  __ Vmov(out, InputSRegisterAt(invoke, 2));
+  __ Vfma(F32, out, InputSRegisterAt(invoke, 0), InputSRegisterAt(invoke, 1));
+}
+
 void IntrinsicLocationsBuilderARMVIXL::VisitMathRoundFloat(HInvoke* invoke) {
   if (features_.HasARMv8AInstructions()) {
     LocationSummary* locations =
@@ -3315,6 +3315,10 @@ class VarHandleSlowPathRISCV64 : public IntrinsicSlowPathRISCV64 {
     return &byte_array_view_check_label_;
   }
 
+  Riscv64Label* GetByteBufferViewCheckLabel() {
+    return &byte_buffer_view_check_label_;
+  }
+
   Riscv64Label* GetNativeByteOrderLabel() {
     return &native_byte_order_label_;
   }
@@ -3335,7 +3339,7 @@ class VarHandleSlowPathRISCV64 : public IntrinsicSlowPathRISCV64 {
   }
 
   void EmitNativeCode(CodeGenerator* codegen_in) override {
-    if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    if (GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked()) {
       EmitByteArrayViewCode(codegen_in);
     }
     IntrinsicSlowPathRISCV64::EmitNativeCode(codegen_in);
@@ -3353,6 +3357,7 @@ class VarHandleSlowPathRISCV64 : public IntrinsicSlowPathRISCV64 {
   void EmitByteArrayViewCode(CodeGenerator* codegen_in);
 
   Riscv64Label byte_array_view_check_label_;
+  Riscv64Label byte_buffer_view_check_label_;
   Riscv64Label native_byte_order_label_;
   // Shared parameter for all VarHandle intrinsics.
   std::memory_order order_;
@@ -3543,6 +3548,12 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
     __ Beqz(object, slow_path->GetEntryLabel());
   }
 
+  if (IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // The VarHandle can only be a ByteBufferViewVarHandle, do all other checks in the slow path.
+    __ J(slow_path->GetByteBufferViewCheckLabel());
+    return;
+  }
+
   ScratchRegisterScope srs(assembler);
   XRegister temp = srs.AllocateXRegister();
   XRegister temp2 = srs.AllocateXRegister();
@@ -3645,20 +3656,39 @@ struct VarHandleTarget {
   XRegister offset;  // The offset of the value to operate on.
 };
 
-static VarHandleTarget GetVarHandleTarget(HInvoke* invoke) {
+static bool HasByteBufferViewTemp(HInvoke* invoke, CodeGeneratorRISCV64* codegen) {
+  return GetExpectedVarHandleCoordinatesCount(invoke) == 2u &&
+         IsVarHandleByteBufferViewAccess(invoke, codegen);
+}
+
+static VarHandleTarget GetVarHandleTarget(HInvoke* invoke, CodeGeneratorRISCV64* codegen) {
   size_t expected_coordinates_count = GetExpectedVarHandleCoordinatesCount(invoke);
   LocationSummary* locations = invoke->GetLocations();
 
   VarHandleTarget target;
   // The temporary allocated for loading the offset.
   target.offset = locations->GetTemp(0u).AsRegister<XRegister>();
-  // The reference to the object that holds the value to operate on.
-  target.object = (expected_coordinates_count == 0u)
-      ? locations->GetTemp(1u).AsRegister<XRegister>()
-      : locations->InAt(1).AsRegister<XRegister>();
+  // The reference to the object that holds the value to operate on. For ByteBuffer views,
+  // this is the backing array held in the last temporary.
+  if (expected_coordinates_count == 0u) {
+    target.object = locations->GetTemp(1u).AsRegister<XRegister>();
+  } else if (HasByteBufferViewTemp(invoke, codegen)) {
+    target.object = locations->GetTemp(locations->GetTempCount() - 1u).AsRegister<XRegister>();
+  } else {
+    target.object = locations->InAt(1).AsRegister<XRegister>();
+  }
   return target;
 }
 
+static void MaybeAddByteBufferViewTemp(HInvoke* invoke,
+                                       CodeGeneratorRISCV64* codegen,
+                                       LocationSummary* locations) {
+  if (HasByteBufferViewTemp(invoke, codegen)) {
+    // Add a temporary for the array backing the ByteBuffer, see `GetVarHandleTarget()`.
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
 static void GenerateVarHandleTarget(HInvoke* invoke,
                                     const VarHandleTarget& target,
                                     CodeGeneratorRISCV64* codegen) {
@@ -3705,6 +3735,9 @@ static void GenerateVarHandleTarget(HInvoke* invoke,
             codegen->GetCompilerReadBarrierOption());
       }
     }
+  } else if (IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // The target is constructed by the ByteBuffer view checks in the slow path.
+    DCHECK_EQ(expected_coordinates_count, 2u);
   } else {
     DCHECK_EQ(expected_coordinates_count, 2u);
     DataType::Type value_type =
@@ -3785,7 +3818,8 @@ static void CreateVarHandleGetLocations(HInvoke* invoke, CodeGeneratorRISCV64* c
     return;
   }
 
-  CreateVarHandleCommonLocations(invoke, codegen);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 DataType::Type IntTypeForFloatingPointType(DataType::Type fp_type) {
@@ -3804,7 +3838,7 @@ static void GenerateVarHandleGet(HInvoke* invoke,
   Riscv64Assembler* assembler = codegen->GetAssembler();
   Location out = locations->Out();
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathRISCV64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, type);
@@ -3905,15 +3939,15 @@ static void CreateVarHandleSetLocations(HInvoke* invoke, CodeGeneratorRISCV64* c
     return;
   }
 
-  CreateVarHandleCommonLocations(invoke, codegen);
-  if (kPoisonHeapReferences && invoke->GetLocations() != nullptr) {
-    LocationSummary* locations = invoke->GetLocations();
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
+  if (kPoisonHeapReferences) {
     uint32_t value_index = invoke->GetNumberOfArguments() - 1;
     DataType::Type value_type = GetDataTypeFromShorty(invoke, value_index);
     if (value_type == DataType::Type::kReference && !locations->InAt(value_index).IsConstant()) {
       locations->AddTemp(Location::RequiresRegister());
     }
   }
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static void GenerateVarHandleSet(HInvoke* invoke,
@@ -3926,7 +3960,7 @@ static void GenerateVarHandleSet(HInvoke* invoke,
   Riscv64Assembler* assembler = codegen->GetAssembler();
   Location value = invoke->GetLocations()->InAt(value_index);
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathRISCV64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, value_type);
@@ -4091,6 +4125,7 @@ static void CreateVarHandleCompareAndSetOrExchangeLocations(HInvoke* invoke,
   if (temps_needed > old_temp_count + scratch_registers_available) {
     locations->AddRegisterTemps(temps_needed - (old_temp_count + scratch_registers_available));
   }
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static XRegister PrepareXRegister(CodeGeneratorRISCV64* codegen,
@@ -4170,7 +4205,7 @@ static void GenerateVarHandleCompareAndSetOrExchange(HInvoke* invoke,
   Location new_value = locations->InAt(new_value_index);
   Location out = locations->Out();
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathRISCV64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, value_type);
@@ -4361,7 +4396,10 @@ static void GenerateVarHandleCompareAndSetOrExchange(HInvoke* invoke,
   // Check that we have allocated the right number of temps. We may need more registers
   // for byte swapped CAS in the slow path, so skip this check for the main path in that case.
   bool has_byte_swap = (expected_index == 3u) && (!is_reference && data_size != 1u);
-  if ((!has_byte_swap || byte_swap) && next_temp != locations->GetTempCount()) {
+  // The ByteBuffer view temporary for the `target.object` is not accounted in `next_temp`.
+  size_t temp_count =
+      locations->GetTempCount() - (HasByteBufferViewTemp(invoke, codegen) ? 1u : 0u);
+  if ((!has_byte_swap || byte_swap) && next_temp != temp_count) {
     // We allocate a temporary register for the class object for a static field `VarHandle` but
     // we do not update the `next_temp` if it's otherwise unused after the address calculation.
     CHECK_EQ(expected_index, 1u);
@@ -4517,6 +4555,7 @@ static void CreateVarHandleGetAndUpdateLocations(HInvoke* invoke,
   if (temps_needed > old_temp_count + scratch_registers_available) {
     locations->AddRegisterTemps(temps_needed - (old_temp_count + scratch_registers_available));
   }
+  MaybeAddByteBufferViewTemp(invoke, codegen, locations);
 }
 
 static void GenerateVarHandleGetAndUpdate(HInvoke* invoke,
@@ -4535,7 +4574,7 @@ static void GenerateVarHandleGetAndUpdate(HInvoke* invoke,
   DCHECK_IMPLIES(arg.IsConstant(), arg.GetConstant()->IsZeroBitPattern());
   Location out = locations->Out();
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathRISCV64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, order, value_type);
@@ -4776,7 +4815,10 @@ static void GenerateVarHandleGetAndUpdate(HInvoke* invoke,
   // Check that we have allocated the right number of temps. We may need more registers
   // for byte swapped CAS in the slow path, so skip this check for the main path in that case.
   bool has_byte_swap = (arg_index == 3u) && (!is_reference && data_size != 1u);
-  if ((!has_byte_swap || byte_swap) && next_temp != locations->GetTempCount()) {
+  // The ByteBuffer view temporary for the `target.object` is not accounted in `next_temp`.
+  size_t temp_count =
+      locations->GetTempCount() - (HasByteBufferViewTemp(invoke, codegen) ? 1u : 0u);
+  if ((!has_byte_swap || byte_swap) && next_temp != temp_count) {
     // We allocate a temporary register for the class object for a static field `VarHandle` but
     // we do not update the `next_temp` if it's otherwise unused after the address calculation.
     CHECK_EQ(arg_index, 1u);
@@ -4906,7 +4948,8 @@ void IntrinsicCodeGeneratorRISCV64::VisitVarHandleGetAndBitwiseXorRelease(HInvok
 }
 
 void VarHandleSlowPathRISCV64::EmitByteArrayViewCode(CodeGenerator* codegen_in) {
-  DCHECK(GetByteArrayViewCheckLabel()->IsLinked());
+  bool is_byte_buffer_view = GetByteBufferViewCheckLabel()->IsLinked();
+  DCHECK_NE(GetByteArrayViewCheckLabel()->IsLinked(), is_byte_buffer_view);
   CodeGeneratorRISCV64* codegen = down_cast<CodeGeneratorRISCV64*>(codegen_in);
   Riscv64Assembler* assembler = codegen->GetAssembler();
   HInvoke* invoke = GetInvoke();
@@ -4924,32 +4967,77 @@ void VarHandleSlowPathRISCV64::EmitByteArrayViewCode(CodeGenerator* codegen_in)
   MemberOffset class_offset = mirror::Object::ClassOffset();
   MemberOffset array_length_offset = mirror::Array::LengthOffset();
   MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
-  MemberOffset native_byte_order_offset = mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
+  MemberOffset native_byte_order_offset = is_byte_buffer_view
+      ? mirror::ByteBufferViewVarHandle::NativeByteOrderOffset()
+      : mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
 
-  __ Bind(GetByteArrayViewCheckLabel());
-
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   {
     ScratchRegisterScope srs(assembler);
     XRegister temp = srs.AllocateXRegister();
     XRegister temp2 = srs.AllocateXRegister();
 
-    // The main path checked that the coordinateType0 is an array class that matches
-    // the class of the actual coordinate argument but it does not match the value type.
-    // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
-    __ Loadwu(temp, varhandle, class_offset.Int32Value());
-    codegen->MaybeUnpoisonHeapReference(temp);
-    codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
-    __ Bne(temp, temp2, GetEntryLabel());
-
-    // Check for array index out of bounds.
-    __ Loadw(temp, object, array_length_offset.Int32Value());
-    __ Bgeu(index, temp, GetEntryLabel());
-    __ Addi(temp2, index, size - 1u);
-    __ Bgeu(temp2, temp, GetEntryLabel());
+    if (is_byte_buffer_view) {
+      __ Bind(GetByteBufferViewCheckLabel());
+
+      // The main path checked only the access mode and the var type. The coordinate
+      // is a non-null ByteBuffer, check if the `varhandle` references a
+      // ByteBufferViewVarHandle instance.
+      __ Loadwu(temp, varhandle, class_offset.Int32Value());
+      codegen->MaybeUnpoisonHeapReference(temp);
+      codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteBufferViewVarHandle);
+      __ Bne(temp, temp2, GetEntryLabel());
+
+      // Direct buffers are accessed by the runtime.
+      MemberOffset address_offset = WellKnownClasses::java_nio_Buffer_address->GetOffset();
+      __ Loadd(temp, object, address_offset.Int32Value());
+      __ Bnez(temp, GetEntryLabel());
+
+      // Let the runtime throw the ReadOnlyBufferException for write access modes.
+      if (access_mode_template != mirror::VarHandle::AccessModeTemplate::kGet) {
+        MemberOffset is_read_only_offset =
+            WellKnownClasses::java_nio_ByteBuffer_isReadOnly->GetOffset();
+        __ Loadbu(temp, object, is_read_only_offset.Int32Value());
+        __ Bnez(temp, GetEntryLabel());
+      }
 
-    // Construct the target.
-    __ Addi(target.offset, index, data_offset.Int32Value());
+      // Check for buffer index out of bounds. The index is relative to the buffer offset.
+      MemberOffset limit_offset = WellKnownClasses::java_nio_Buffer_limit->GetOffset();
+      __ Loadw(temp, object, limit_offset.Int32Value());
+      __ Bgeu(index, temp, GetEntryLabel());
+      __ Addi(temp2, index, size - 1u);
+      __ Bgeu(temp2, temp, GetEntryLabel());
+
+      // Construct the target from the backing array and the buffer offset. We do not need
+      // a read barrier for loading the array as this path is used only without read barriers.
+      MemberOffset hb_offset = WellKnownClasses::java_nio_ByteBuffer_hb->GetOffset();
+      MemberOffset buffer_offset_offset = WellKnownClasses::java_nio_ByteBuffer_offset->GetOffset();
+      __ Loadwu(target.object, object, hb_offset.Int32Value());
+      codegen->MaybeUnpoisonHeapReference(target.object);
+      __ Beqz(target.object, GetEntryLabel());
+      __ Loadw(temp, object, buffer_offset_offset.Int32Value());
+      __ Addi(target.offset, index, data_offset.Int32Value());
+      __ Add(target.offset, target.offset, temp);
+    } else {
+      __ Bind(GetByteArrayViewCheckLabel());
+
+      // The main path checked that the coordinateType0 is an array class that matches
+      // the class of the actual coordinate argument but it does not match the value type.
+      // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
+      __ Loadwu(temp, varhandle, class_offset.Int32Value());
+      codegen->MaybeUnpoisonHeapReference(temp);
+      codegen->LoadClassRootForIntrinsic(temp2, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
+      __ Bne(temp, temp2, GetEntryLabel());
+
+      // Check for array index out of bounds.
+      __ Loadw(temp, object, array_length_offset.Int32Value());
+      __ Bgeu(index, temp, GetEntryLabel());
+      __ Addi(temp2, index, size - 1u);
+      __ Bgeu(temp2, temp, GetEntryLabel());
+
+      // Construct the target.
+      __ Addi(target.offset, index, data_offset.Int32Value());
+    }
 
     // Alignment check. For unaligned access, go to the runtime.
     DCHECK(IsPowerOfTwo(size));
@@ -23,9 +23,12 @@
 #include "code_generator.h"
 #include "data_type-inl.h"
 #include "dex/dex_file-inl.h"
+#include "driver/compiler_options.h"
+#include "gc/heap.h"
 #include "locations.h"
 #include "mirror/var_handle.h"
 #include "nodes.h"
+#include "runtime.h"
 #include "utils/assembler.h"
 #include "utils/label.h"
 
@@ -207,6 +210,35 @@ static inline DataType::Type GetVarHandleExpectedValueType(HInvoke* invoke,
   }
 }
 
+// Returns whether an accessor with two coordinates shall check for a heap `java.nio.ByteBuffer`
+// view instead of an array or byte array view. Such a call site has a `ByteBuffer` as the static
+// type of the first coordinate, so the VarHandle cannot be anything but a ByteBufferViewVarHandle.
+// The intrinsic loads the `ByteBuffer.hb` reference without a read barrier and compares against
+// the ByteBufferViewVarHandle.class, so it is not used with read barriers or without boot image.
+static inline bool IsVarHandleByteBufferViewAccess(HInvoke* invoke, CodeGenerator* codegen) {
+  DCHECK_EQ(GetExpectedVarHandleCoordinatesCount(invoke), 2u);
+  DataType::Type value_type =
+      GetVarHandleExpectedValueType(invoke, /*expected_coordinates_count=*/ 2u);
+  if (value_type == DataType::Type::kReference || DataType::Size(value_type) == 1u) {
+    return false;  // Not a valid ByteBuffer view type, the main path checks shall fail.
+  }
+  if (codegen->EmitReadBarrier()) {
+    return false;
+  }
+  if (!codegen->GetCompilerOptions().IsBootImage() &&
+      Runtime::Current()->GetHeap()->GetBootImageSpaces().empty()) {
+    return false;
+  }
+  const DexFile* dex_file = invoke->GetMethodReference().dex_file;
+  const dex::ProtoId& proto_id =
+      dex_file->GetProtoId(invoke->AsInvokePolymorphic()->GetProtoIndex());
+  const dex::TypeList* parameters = dex_file->GetProtoParameters(proto_id);
+  DCHECK(parameters != nullptr);
+  DCHECK_GE(parameters->Size(), 2u);
+  dex::TypeIndex coordinate_type0_index = parameters->GetTypeItem(0u).type_idx_;
+  return dex_file->GetTypeDescriptorView(coordinate_type0_index) == "Ljava/nio/ByteBuffer;";
+}
+
 static inline ArtField* GetBootImageVarHandleField(HInvoke* invoke)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK_LE(GetExpectedVarHandleCoordinatesCount(invoke), 1u);
@@ -3458,6 +3458,46 @@ void IntrinsicLocationsBuilderX86_64::VisitReachabilityFence(HInvoke* invoke) {
 
 void IntrinsicCodeGeneratorX86_64::VisitReachabilityFence([[maybe_unused]] HInvoke* invoke) {}
 
+void IntrinsicLocationsBuilderX86_64::VisitCRC32Update(HInvoke* invoke) {
+  LocationSummary* locations =
+      new (allocator_) LocationSummary(invoke, LocationSummary::kNoCall, kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetOut(Location::SameAsFirstInput());
+  locations->AddTemp(Location::RequiresRegister());
+}
+
+// Lower the invoke of CRC32.update(int crc, int b).
+void IntrinsicCodeGeneratorX86_64::VisitCRC32Update(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister val = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
+  DCHECK_EQ(crc.AsRegister(), locations->Out().AsRegister<CpuRegister>().AsRegister());
+
+  // The SSE4.2 crc32 instruction uses the Castagnoli polynomial, not the one of
+  // java.util.zip.CRC32, so compute the CRC of the byte bit by bit without branches.
+  // This is still much cheaper than the JNI call of the native implementation:
+  //   crc = ~crc ^ (b & 0xff)
+  //   repeat 8 times: crc = (crc >>> 1) ^ (0xedb88320 & -(crc & 1))
+  //   crc = ~crc
+  static constexpr int32_t kCRC32Polynomial = static_cast<int32_t>(0xedb88320u);
+  __ notl(crc);
+  __ movzxb(temp, val);
+  __ xorl(crc, temp);
+  for (size_t i = 0; i != kBitsPerByte; ++i) {
+    __ movl(temp, crc);
+    __ andl(temp, Immediate(1));
+    __ negl(temp);
+    __ andl(temp, Immediate(kCRC32Polynomial));
+    __ shrl(crc, Immediate(1));
+    __ xorl(crc, temp);
+  }
+  __ notl(crc);
+}
+
 static void CreateDivideUnsignedLocations(HInvoke* invoke, ArenaAllocator* allocator) {
   LocationSummary* locations =
       new (allocator) LocationSummary(invoke, LocationSummary::kCallOnSlowPath, kIntrinsified);
@@ -3569,12 +3609,16 @@ class VarHandleSlowPathX86_64 : public IntrinsicSlowPathX86_64 {
     return &byte_array_view_check_label_;
   }
 
+  Label* GetByteBufferViewCheckLabel() {
+    return &byte_buffer_view_check_label_;
+  }
+
   Label* GetNativeByteOrderLabel() {
     return &native_byte_order_label_;
   }
 
   void EmitNativeCode(CodeGenerator* codegen) override {
-    if (GetByteArrayViewCheckLabel()->IsLinked()) {
+    if (GetByteArrayViewCheckLabel()->IsLinked() || GetByteBufferViewCheckLabel()->IsLinked()) {
       EmitByteArrayViewCode(down_cast<CodeGeneratorX86_64*>(codegen));
     }
     IntrinsicSlowPathX86_64::EmitNativeCode(codegen);
@@ -3592,6 +3636,7 @@ class VarHandleSlowPathX86_64 : public IntrinsicSlowPathX86_64 {
   void EmitByteArrayViewCode(CodeGeneratorX86_64* codegen);
 
   Label byte_array_view_check_label_;
+  Label byte_buffer_view_check_label_;
   Label native_byte_order_label_;
 
   // Arguments forwarded to specific methods.
@@ -3813,6 +3858,12 @@ static void GenerateVarHandleArrayChecks(HInvoke* invoke,
     __ j(kZero, slow_path->GetEntryLabel());
   }
 
+  if (IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // The VarHandle can only be a ByteBufferViewVarHandle, do all other checks in the slow path.
+    __ jmp(slow_path->GetByteBufferViewCheckLabel());
+    return;
+  }
+
   CpuRegister temp = locations->GetTemp(0).AsRegister<CpuRegister>();
 
   // Check that the VarHandle references an array, byte array view or ByteBuffer by checking
@@ -3912,15 +3963,19 @@ struct VarHandleTarget {
   Register offset;  // The offset of the value to operate on.
 };
 
-static VarHandleTarget GetVarHandleTarget(HInvoke* invoke) {
+static VarHandleTarget GetVarHandleTarget(HInvoke* invoke, CodeGeneratorX86_64* codegen) {
   size_t expected_coordinates_count = GetExpectedVarHandleCoordinatesCount(invoke);
   LocationSummary* locations = invoke->GetLocations();
 
   VarHandleTarget target;
   // The temporary allocated for loading the offset.
   target.offset = locations->GetTemp(0).AsRegister<CpuRegister>().AsRegister();
-  // The reference to the object that holds the value to operate on.
-  target.object = (expected_coordinates_count == 0u)
+  // The reference to the object that holds the value to operate on. For static fields this
+  // is the declaring class and for ByteBuffer views the backing array, both held in a temporary.
+  bool use_temp = (expected_coordinates_count == 0u) ||
+                  (expected_coordinates_count == 2u &&
+                   IsVarHandleByteBufferViewAccess(invoke, codegen));
+  target.object = use_temp
       ? locations->GetTemp(1).AsRegister<CpuRegister>().AsRegister()
       : locations->InAt(1).AsRegister<CpuRegister>().AsRegister();
   return target;
@@ -3973,6 +4028,9 @@ static void GenerateVarHandleTarget(HInvoke* invoke,
                                                codegen->GetCompilerReadBarrierOption());
       }
     }
+  } else if (IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // The target is constructed by the ByteBuffer view checks in the slow path.
+    DCHECK_EQ(expected_coordinates_count, 2u);
   } else {
     DCHECK_EQ(expected_coordinates_count, 2u);
 
@@ -4003,7 +4061,8 @@ static bool HasVarHandleIntrinsicImplementation(HInvoke* invoke, CodeGeneratorX8
   return true;
 }
 
-static LocationSummary* CreateVarHandleCommonLocations(HInvoke* invoke) {
+static LocationSummary* CreateVarHandleCommonLocations(HInvoke* invoke,
+                                                       CodeGeneratorX86_64* codegen) {
   size_t expected_coordinates_count = GetExpectedVarHandleCoordinatesCount(invoke);
   ArenaAllocator* allocator = invoke->GetBlock()->GetGraph()->GetAllocator();
   LocationSummary* locations = new (allocator) LocationSummary(
@@ -4033,6 +4092,10 @@ static LocationSummary* CreateVarHandleCommonLocations(HInvoke* invoke) {
   if (expected_coordinates_count == 0u) {
     // Add a temporary to hold the declaring class.
     locations->AddTemp(Location::RequiresRegister());
+  } else if (expected_coordinates_count == 2u &&
+             IsVarHandleByteBufferViewAccess(invoke, codegen)) {
+    // Add a temporary to hold the array backing the ByteBuffer.
+    locations->AddTemp(Location::RequiresRegister());
   }
 
   return locations;
@@ -4043,7 +4106,7 @@ static void CreateVarHandleGetLocations(HInvoke* invoke, CodeGeneratorX86_64* co
     return;
   }
 
-  LocationSummary* locations = CreateVarHandleCommonLocations(invoke);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
   if (DataType::IsFloatingPointType(invoke->GetType())) {
     locations->SetOut(Location::RequiresFpuRegister());
   } else {
@@ -4060,7 +4123,7 @@ static void GenerateVarHandleGet(HInvoke* invoke,
   LocationSummary* locations = invoke->GetLocations();
   X86_64Assembler* assembler = codegen->GetAssembler();
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathX86_64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, type);
@@ -4239,7 +4302,7 @@ static void CreateVarHandleSetLocations(HInvoke* invoke, CodeGeneratorX86_64* co
     return;
   }
 
-  LocationSummary* locations = CreateVarHandleCommonLocations(invoke);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
 
   // Extra temporary is used for card in MarkGCCard and to move 64-bit constants to memory.
   locations->AddTemp(Location::RequiresRegister());
@@ -4258,7 +4321,7 @@ static void GenerateVarHandleSet(HInvoke* invoke,
   uint32_t value_index = invoke->GetNumberOfArguments() - 1;
   DataType::Type value_type = GetDataTypeFromShorty(invoke, value_index);
 
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   VarHandleSlowPathX86_64* slow_path = nullptr;
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, value_type);
@@ -4353,7 +4416,7 @@ static void CreateVarHandleCompareAndSetOrExchangeLocations(HInvoke* invoke,
   DataType::Type expected_type = GetDataTypeFromShorty(invoke, expected_value_index);
   DCHECK_EQ(expected_type, GetDataTypeFromShorty(invoke, new_value_index));
 
-  LocationSummary* locations = CreateVarHandleCommonLocations(invoke);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
 
   if (DataType::IsFloatingPointType(return_type)) {
     locations->SetOut(Location::RequiresFpuRegister());
@@ -4400,7 +4463,7 @@ static void GenerateVarHandleCompareAndSetOrExchange(HInvoke* invoke,
   DataType::Type type = GetDataTypeFromShorty(invoke, expected_value_index);
 
   VarHandleSlowPathX86_64* slow_path = nullptr;
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, type);
     GenerateVarHandleTarget(invoke, target, codegen);
@@ -4507,7 +4570,7 @@ static void CreateVarHandleGetAndSetLocations(HInvoke* invoke, CodeGeneratorX86_
   DataType::Type type = invoke->GetType();
   DCHECK_EQ(type, GetDataTypeFromShorty(invoke, new_value_index));
 
-  LocationSummary* locations = CreateVarHandleCommonLocations(invoke);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
 
   if (DataType::IsFloatingPointType(type)) {
     locations->SetOut(Location::RequiresFpuRegister());
@@ -4649,7 +4712,7 @@ static void CreateVarHandleGetAndBitwiseOpLocations(HInvoke* invoke, CodeGenerat
   DataType::Type type = invoke->GetType();
   DCHECK_EQ(type, GetDataTypeFromShorty(invoke, new_value_index));
 
-  LocationSummary* locations = CreateVarHandleCommonLocations(invoke);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
 
   DCHECK_NE(DataType::Type::kReference, type);
   DCHECK(!DataType::IsFloatingPointType(type));
@@ -4788,7 +4851,7 @@ static void CreateVarHandleGetAndAddLocations(HInvoke* invoke, CodeGeneratorX86_
   DataType::Type type = invoke->GetType();
   DCHECK_EQ(type, GetDataTypeFromShorty(invoke, new_value_index));
 
-  LocationSummary* locations = CreateVarHandleCommonLocations(invoke);
+  LocationSummary* locations = CreateVarHandleCommonLocations(invoke, codegen);
 
   if (DataType::IsFloatingPointType(type)) {
     locations->SetOut(Location::RequiresFpuRegister());
@@ -4959,7 +5022,7 @@ static void GenerateVarHandleGetAndUpdate(HInvoke* invoke,
   DataType::Type type = invoke->GetType();
 
   VarHandleSlowPathX86_64* slow_path = nullptr;
-  VarHandleTarget target = GetVarHandleTarget(invoke);
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
   if (!byte_swap) {
     slow_path = GenerateVarHandleChecks(invoke, codegen, type);
     GenerateVarHandleTarget(invoke, target, codegen);
@@ -5199,7 +5262,8 @@ void IntrinsicCodeGeneratorX86_64::VisitVarHandleGetAndBitwiseXorRelease(HInvoke
 }
 
 void VarHandleSlowPathX86_64::EmitByteArrayViewCode(CodeGeneratorX86_64* codegen) {
-  DCHECK(GetByteArrayViewCheckLabel()->IsLinked());
+  bool is_byte_buffer_view = GetByteBufferViewCheckLabel()->IsLinked();
+  DCHECK_NE(GetByteArrayViewCheckLabel()->IsLinked(), is_byte_buffer_view);
   X86_64Assembler* assembler = codegen->GetAssembler();
 
   HInvoke* invoke = GetInvoke();
@@ -5214,36 +5278,88 @@ void VarHandleSlowPathX86_64::EmitByteArrayViewCode(CodeGeneratorX86_64* codegen
   CpuRegister varhandle = locations->InAt(0).AsRegister<CpuRegister>();
   CpuRegister object = locations->InAt(1).AsRegister<CpuRegister>();
   CpuRegister index = locations->InAt(2).AsRegister<CpuRegister>();
-  CpuRegister temp = locations->GetTemp(locations->GetTempCount() - 1).AsRegister<CpuRegister>();
+  VarHandleTarget target = GetVarHandleTarget(invoke, codegen);
+  // For ByteBuffer views, the last temporary may hold the `target.object`, use
+  // the `target.offset` as a temporary until we construct the target.
+  CpuRegister temp = is_byte_buffer_view
+      ? CpuRegister(target.offset)
+      : locations->GetTemp(locations->GetTempCount() - 1).AsRegister<CpuRegister>();
 
   MemberOffset class_offset = mirror::Object::ClassOffset();
   MemberOffset array_length_offset = mirror::Array::LengthOffset();
   MemberOffset data_offset = mirror::Array::DataOffset(Primitive::kPrimByte);
-  MemberOffset native_byte_order_offset = mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
-
-  VarHandleTarget target = GetVarHandleTarget(invoke);
-
-  __ Bind(GetByteArrayViewCheckLabel());
-
-  // The main path checked that the coordinateType0 is an array class that matches
-  // the class of the actual coordinate argument but it does not match the value type.
-  // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
-  codegen->LoadClassRootForIntrinsic(temp, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
-  assembler->MaybePoisonHeapReference(temp);
-  __ cmpl(temp, Address(varhandle, class_offset.Int32Value()));
-  __ j(kNotEqual, GetEntryLabel());
+  MemberOffset native_byte_order_offset = is_byte_buffer_view
+      ? mirror::ByteBufferViewVarHandle::NativeByteOrderOffset()
+      : mirror::ByteArrayViewVarHandle::NativeByteOrderOffset();
+
+  if (is_byte_buffer_view) {
+    __ Bind(GetByteBufferViewCheckLabel());
+
+    // The main path checked only the access mode and the var type. The coordinate
+    // is a non-null ByteBuffer, check if the `varhandle` references a
+    // ByteBufferViewVarHandle instance.
+    codegen->LoadClassRootForIntrinsic(temp, ClassRoot::kJavaLangInvokeByteBufferViewVarHandle);
+    assembler->MaybePoisonHeapReference(temp);
+    __ cmpl(temp, Address(varhandle, class_offset.Int32Value()));
+    __ j(kNotEqual, GetEntryLabel());
+
+    // Direct buffers are accessed by the runtime.
+    MemberOffset address_offset = WellKnownClasses::java_nio_Buffer_address->GetOffset();
+    __ cmpq(Address(object, address_offset.Int32Value()), Immediate(0));
+    __ j(kNotEqual, GetEntryLabel());
+
+    // Let the runtime throw the ReadOnlyBufferException for write access modes.
+    if (access_mode_template != mirror::VarHandle::AccessModeTemplate::kGet) {
+      MemberOffset is_read_only_offset =
+          WellKnownClasses::java_nio_ByteBuffer_isReadOnly->GetOffset();
+      __ cmpb(Address(object, is_read_only_offset.Int32Value()), Immediate(0));
+      __ j(kNotEqual, GetEntryLabel());
+    }
 
-  // Check for array index out of bounds.
-  __ movl(temp, Address(object, array_length_offset.Int32Value()));
-  // SUB sets flags in the same way as CMP.
-  __ subl(temp, index);
-  __ j(kBelowEqual, GetEntryLabel());
-  // The difference between index and array length must be enough for the `value_type` size.
-  __ cmpl(temp, Immediate(size));
-  __ j(kBelow, GetEntryLabel());
-
-  // Construct the target.
-  __ leal(CpuRegister(target.offset), Address(index, TIMES_1, data_offset.Int32Value()));
+    // Check for buffer index out of bounds. The index is relative to the buffer offset.
+    MemberOffset limit_offset = WellKnownClasses::java_nio_Buffer_limit->GetOffset();
+    __ movl(temp, Address(object, limit_offset.Int32Value()));
+    // SUB sets flags in the same way as CMP.
+    __ subl(temp, index);
+    __ j(kBelowEqual, GetEntryLabel());
+    // The difference between index and buffer limit must be enough for the `value_type` size.
+    __ cmpl(temp, Immediate(size));
+    __ j(kBelow, GetEntryLabel());
+
+    // Construct the target from the backing array and the buffer offset. We do not need
+    // a read barrier for loading the array as this path is used only without read barriers.
+    MemberOffset hb_offset = WellKnownClasses::java_nio_ByteBuffer_hb->GetOffset();
+    MemberOffset buffer_offset_offset = WellKnownClasses::java_nio_ByteBuffer_offset->GetOffset();
+    __ movl(CpuRegister(target.object), Address(object, hb_offset.Int32Value()));
+    assembler->MaybeUnpoisonHeapReference(CpuRegister(target.object));
+    __ testl(CpuRegister(target.object), CpuRegister(target.object));
+    __ j(kZero, GetEntryLabel());
+    __ movl(CpuRegister(target.offset), Address(object, buffer_offset_offset.Int32Value()));
+    __ leal(CpuRegister(target.offset),
+            Address(CpuRegister(target.offset), index, TIMES_1, data_offset.Int32Value()));
+  } else {
+    __ Bind(GetByteArrayViewCheckLabel());
+
+    // The main path checked that the coordinateType0 is an array class that matches
+    // the class of the actual coordinate argument but it does not match the value type.
+    // Check if the `varhandle` references a ByteArrayViewVarHandle instance.
+    codegen->LoadClassRootForIntrinsic(temp, ClassRoot::kJavaLangInvokeByteArrayViewVarHandle);
+    assembler->MaybePoisonHeapReference(temp);
+    __ cmpl(temp, Address(varhandle, class_offset.Int32Value()));
+    __ j(kNotEqual, GetEntryLabel());
+
+    // Check for array index out of bounds.
+    __ movl(temp, Address(object, array_length_offset.Int32Value()));
+    // SUB sets flags in the same way as CMP.
+    __ subl(temp, index);
+    __ j(kBelowEqual, GetEntryLabel());
+    // The difference between index and array length must be enough for the `value_type` size.
+    __ cmpl(temp, Immediate(size));
+    __ j(kBelow, GetEntryLabel());
+
+    // Construct the target.
+    __ leal(CpuRegister(target.offset), Address(index, TIMES_1, data_offset.Int32Value()));
+  }
 
   // Alignment check. For unaligned access, go to the runtime.
   DCHECK(IsPowerOfTwo(size));
@@ -36,6 +36,13 @@ static bool IsInnerLoop(HLoopInformation* outer, HLoopInformation* inner) {
       && inner->IsIn(*outer);
 }
 
+// Blocks outside of loops which end in a throw are cold. They are placed after all other
+// blocks whose predecessors have been placed, so that the hot code stays contiguous and the
+// fast path falls through instead of jumping over the throwing code.
+static bool IsColdBlock(HBasicBlock* block) {
+  return !IsLoop(block->GetLoopInformation()) && block->GetLastInstruction()->IsThrow();
+}
+
 // Helper method to update work list for linear order.
 static void AddToListForLinearization(ScopedArenaVector<HBasicBlock*>* worklist,
                                       HBasicBlock* block) {
@@ -87,7 +94,8 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   DCHECK_EQ(linear_order.size(), graph->GetReversePostOrder().size());
   // Create a reverse post ordering with the following properties:
   // - Blocks in a loop are consecutive,
-  // - Back-edge is the last block before loop exits.
+  // - Back-edge is the last block before loop exits,
+  // - Cold blocks come as late as possible.
   //
   // (1): Record the number of forward predecessors for each block. This is to
   //      ensure the resulting order is reverse post order. We could use the
@@ -108,10 +116,16 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  //      Cold blocks are kept aside and only taken when nothing else is ready.
   ScopedArenaVector<HBasicBlock*> worklist(allocator.Adapter(kArenaAllocLinearOrder));
+  ScopedArenaVector<HBasicBlock*> cold_worklist(allocator.Adapter(kArenaAllocLinearOrder));
   worklist.push_back(graph->GetEntryBlock());
   size_t num_added = 0u;
   do {
+    if (worklist.empty()) {
+      worklist.push_back(cold_worklist.back());
+      cold_worklist.pop_back();
+    }
     HBasicBlock* current = worklist.back();
     worklist.pop_back();
     linear_order[num_added] = current;
@@ -120,11 +134,15 @@ void LinearizeGraphInternal(const HGraph* graph, ArrayRef<HBasicBlock*> linear_o
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
-        AddToListForLinearization(&worklist, successor);
+        if (IsColdBlock(successor)) {
+          cold_worklist.push_back(successor);
+        } else {
+          AddToListForLinearization(&worklist, successor);
+        }
       }
       forward_predecessors[block_id] = number_of_remaining_predecessors - 1;
     }
-  } while (!worklist.empty());
+  } while (!worklist.empty() || !cold_worklist.empty());
   DCHECK_EQ(num_added, linear_order.size());
 
   DCHECK(graph->HasIrreducibleLoops() || IsLinearOrderWellFormed(graph, linear_order));
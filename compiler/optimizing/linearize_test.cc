@@ -245,4 +245,44 @@ TEST_F(LinearizeTest, CFG7) {
   TestCode(data, blocks);
 }
 
+TEST_F(LinearizeTest, ColdThrowBlockIsLast) {
+  // Structure of this graph:
+  //            Block0
+  //              |
+  //            Block1
+  //            /    \
+  //     (throw)      (return)
+  //            \    /
+  //             Exit
+  //
+  // The throwing block must come after the returning one even though it is the
+  // fall-through successor of the `if`.
+  const std::vector<uint16_t> data = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::THROW | 0,
+    Instruction::RETURN_VOID);
+
+  HGraph* graph = CreateCFG(data);
+  std::unique_ptr<CompilerOptions> compiler_options =
+      CommonCompilerTest::CreateCompilerOptions(kRuntimeISA, "default");
+  std::unique_ptr<CodeGenerator> codegen = CodeGenerator::Create(graph, *compiler_options);
+  SsaLivenessAnalysis liveness(graph, codegen.get(), GetScopedAllocator());
+  liveness.Analyze();
+
+  size_t throw_position = graph->GetLinearOrder().size();
+  size_t return_position = graph->GetLinearOrder().size();
+  for (size_t i = 0; i < graph->GetLinearOrder().size(); ++i) {
+    HInstruction* last = graph->GetLinearOrder()[i]->GetLastInstruction();
+    if (last->IsThrow()) {
+      throw_position = i;
+    } else if (last->IsReturnVoid()) {
+      return_position = i;
+    }
+  }
+  ASSERT_LT(return_position, graph->GetLinearOrder().size());
+  ASSERT_LT(throw_position, graph->GetLinearOrder().size());
+  ASSERT_LT(return_position, throw_position);
+}
+
 }  // namespace art
@@ -733,6 +733,18 @@ class LSEVisitor final : private HGraphDelegateVisitor {
   void FindStoresWritingOldValues();
   void FinishFullLSE();
 
+  // Find the references that escape only on paths that cannot return from the method.
+  void FindPartialSingletons();
+
+  // Returns true if no other name can refer to the value of `ref_info` while executing
+  // `block`. This holds everywhere for singletons, and outside the escaping paths for the
+  // references found by `FindPartialSingletons()`.
+  bool IsSingletonIn(const ReferenceInfo* ref_info, HBasicBlock* block) const {
+    return ref_info->IsSingleton() ||
+           (partial_singletons_.IsBitSet(ref_info->GetPosition()) &&
+            !non_returning_blocks_.IsBitSet(block->GetBlockId()));
+  }
+
   void HandleAcquireLoad(HInstruction* instruction) {
     DCHECK((instruction->IsInstanceFieldGet() && instruction->AsInstanceFieldGet()->IsVolatile()) ||
            (instruction->IsStaticFieldGet() && instruction->AsStaticFieldGet()->IsVolatile()) ||
@@ -1003,7 +1015,7 @@ class LSEVisitor final : private HGraphDelegateVisitor {
       ReferenceInfo* ref_info = heap_location_collector_.GetHeapLocation(i)->GetReferenceInfo();
       // We don't need to do anything if the reference has not escaped at this point.
       // This is true if we never escape.
-      if (!can_throw_inside_a_try && ref_info->IsSingleton()) {
+      if (!can_throw_inside_a_try && IsSingletonIn(ref_info, instruction->GetBlock())) {
         // Singleton references cannot be seen by the callee.
       } else {
         if (can_throw || side_effects.DoesAnyRead() || side_effects.DoesAnyWrite()) {
@@ -1183,6 +1195,14 @@ class LSEVisitor final : private HGraphDelegateVisitor {
   // The field infos for each heap location (if relevant).
   ScopedArenaVector<const FieldInfo*> field_infos_;
 
+  // Blocks from which every path leaves the method by throwing.
+  ArenaBitVector non_returning_blocks_;
+
+  // References, by `ReferenceInfo` position, that are not singletons but escape only in
+  // `non_returning_blocks_`. Their loads can be eliminated on the paths that return; their
+  // stores and allocations are kept and can then be sunk to the escaping paths.
+  ArenaBitVector partial_singletons_;
+
   Phase current_phase_;
 
   friend std::ostream& operator<<(std::ostream& os, const Value& v);
@@ -1295,6 +1315,14 @@ LSEVisitor::LSEVisitor(HGraph* graph,
       singleton_new_instances_(allocator_.Adapter(kArenaAllocLSE)),
       field_infos_(heap_location_collector_.GetNumberOfHeapLocations(),
                    allocator_.Adapter(kArenaAllocLSE)),
+      non_returning_blocks_(&allocator_,
+                            graph->GetBlocks().size(),
+                            /*expandable=*/false,
+                            kArenaAllocLSE),
+      partial_singletons_(&allocator_,
+                          /*start_bits=*/0,
+                          /*expandable=*/true,
+                          kArenaAllocLSE),
       current_phase_(Phase::kLoadElimination) {}
 
 LSEVisitor::Value LSEVisitor::PrepareLoopValue(HBasicBlock* block, size_t idx) {
@@ -2590,6 +2618,7 @@ void LSEVisitor::Run() {
   // 0. Set HasMonitorOperations to false. If we encounter some MonitorOperations that we can't
   // remove, we will set it to true in VisitMonitorOperation.
   GetGraph()->SetHasMonitorOperations(false);
+  FindPartialSingletons();
 
   // 1. Process blocks and instructions in reverse post order.
   for (HBasicBlock* block : GetGraph()->GetReversePostOrder()) {
@@ -2613,6 +2642,57 @@ void LSEVisitor::Run() {
 }
 
 
+void LSEVisitor::FindPartialSingletons() {
+  if (GetGraph()->GetExitBlock() == nullptr) {
+    // Infinite loop, nothing returns.
+    return;
+  }
+  // Find the blocks that can reach a return by walking predecessors backwards from them.
+  // Exit predecessors ending with anything but a throw, e.g. a try boundary, are
+  // conservatively treated as returning.
+  ArenaBitVector returning_blocks(
+      &allocator_, GetGraph()->GetBlocks().size(), /*expandable=*/false, kArenaAllocLSE);
+  ScopedArenaVector<HBasicBlock*> worklist(allocator_.Adapter(kArenaAllocLSE));
+  for (HBasicBlock* exit_predecessor : GetGraph()->GetExitBlock()->GetPredecessors()) {
+    if (!exit_predecessor->GetLastInstruction()->IsThrow()) {
+      returning_blocks.SetBit(exit_predecessor->GetBlockId());
+      worklist.push_back(exit_predecessor);
+    }
+  }
+  while (!worklist.empty()) {
+    HBasicBlock* block = worklist.back();
+    worklist.pop_back();
+    for (HBasicBlock* predecessor : block->GetPredecessors()) {
+      if (!returning_blocks.IsBitSet(predecessor->GetBlockId())) {
+        returning_blocks.SetBit(predecessor->GetBlockId());
+        worklist.push_back(predecessor);
+      }
+    }
+  }
+  bool has_non_returning_blocks = false;
+  for (HBasicBlock* block : GetGraph()->GetReversePostOrder()) {
+    if (!returning_blocks.IsBitSet(block->GetBlockId())) {
+      non_returning_blocks_.SetBit(block->GetBlockId());
+      has_non_returning_blocks = true;
+    }
+  }
+  if (!has_non_returning_blocks) {
+    return;
+  }
+
+  // Control never flows from a non-returning block back to a returning one, so a reference
+  // that only escapes in non-returning blocks has not escaped yet in any returning block.
+  for (size_t i = 0, size = heap_location_collector_.GetNumberOfHeapLocations(); i != size; ++i) {
+    ReferenceInfo* ref_info = heap_location_collector_.GetHeapLocation(i)->GetReferenceInfo();
+    if (!ref_info->IsSingleton() &&
+        !partial_singletons_.IsBitSet(ref_info->GetPosition()) &&
+        EscapesOnlyInBlocks(ref_info->GetReference(), non_returning_blocks_)) {
+      partial_singletons_.SetBit(ref_info->GetPosition());
+      MaybeRecordStat(stats_, MethodCompilationStat::kPartialEscapeSingleton);
+    }
+  }
+}
+
 void LSEVisitor::FinishFullLSE() {
   // Remove recorded load instructions that should be eliminated.
   for (const LoadStoreRecord& record : loads_and_stores_) {
@@ -153,6 +153,20 @@ class Arm64LoopHelper : public ArchDefaultLoopHelper {
                         kArm64ScalarHeuristicMaxBodySizeBlocks);
   }
 
+  uint32_t GetScalarUnrollingFactor(const LoopAnalysisInfo* analysis_info) const override {
+    int64_t trip_count = analysis_info->GetTripCount();
+    // Small loops with an odd trip count are still unrolled: the remaining iteration is peeled
+    // in front of the loop. This keeps the unrolled body a single straight-line block which the
+    // instruction scheduler can interleave, which pays off on in-order cores.
+    if (trip_count != LoopAnalysisInfo::kUnknownTripCount &&
+        trip_count > kScalarMaxUnrollFactor &&
+        trip_count % kScalarMaxUnrollFactor != 0 &&
+        analysis_info->GetNumberOfInstructions() < kArm64ScalarHeuristicMaxBodySizeInstr / 2) {
+      return kScalarMaxUnrollFactor;
+    }
+    return ArchDefaultLoopHelper::GetScalarUnrollingFactor(analysis_info);
+  }
+
   uint32_t GetSIMDUnrollingFactor(HBasicBlock* block,
                                   int64_t trip_count,
                                   uint32_t max_peel,
@@ -19,6 +19,7 @@
 #include "arch/arm/instruction_set_features_arm.h"
 #include "arch/arm64/instruction_set_features_arm64.h"
 #include "arch/instruction_set.h"
+#include "arch/riscv64/instruction_set_features_riscv64.h"
 #include "arch/x86/instruction_set_features_x86.h"
 #include "arch/x86_64/instruction_set_features_x86_64.h"
 #include "code_generator.h"
@@ -32,6 +33,9 @@ namespace art HIDDEN {
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
+// Maximum number of a != b runtime tests a vector loop may depend on.
+static constexpr size_t kMaxArrayRefsDisambiguationTests = 3;
+
 //
 // Static helpers.
 //
@@ -522,12 +526,14 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       reductions_(nullptr),
       simplified_(false),
       predicated_vectorization_mode_(codegen.SupportsPredicatedSIMD()),
+      relaxed_fp_reductions_(
+          compiler_options_->HasRelaxedFpReductionMethods() &&
+          compiler_options_->IsRelaxedFpReductionMethod(graph->PrettyMethod())),
       vector_length_(0),
       vector_refs_(nullptr),
       vector_static_peeling_factor_(0),
       vector_dynamic_peeling_candidate_(nullptr),
-      vector_runtime_test_a_(nullptr),
-      vector_runtime_test_b_(nullptr),
+      vector_runtime_tests_(nullptr),
       vector_map_(nullptr),
       vector_permanent_map_(nullptr),
       vector_external_set_(nullptr),
@@ -587,6 +593,8 @@ bool HLoopOptimization::LocalRun() {
   ScopedArenaSafeMap<HInstruction*, HInstruction*> reds(
       std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSet<ArrayReference> refs(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+  ScopedArenaVector<std::pair<HInstruction*, HInstruction*>> tests(
+      loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSafeMap<HInstruction*, HInstruction*> map(
       std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
   ScopedArenaSafeMap<HInstruction*, HInstruction*> perm(
@@ -598,6 +606,7 @@ bool HLoopOptimization::LocalRun() {
   iset_ = &iset;
   reductions_ = &reds;
   vector_refs_ = &refs;
+  vector_runtime_tests_ = &tests;
   vector_map_ = &map;
   vector_permanent_map_ = &perm;
   vector_external_set_ = &ext_set;
@@ -608,6 +617,7 @@ bool HLoopOptimization::LocalRun() {
   iset_ = nullptr;
   reductions_ = nullptr;
   vector_refs_ = nullptr;
+  vector_runtime_tests_ = nullptr;
   vector_map_ = nullptr;
   vector_permanent_map_ = nullptr;
   vector_external_set_ = nullptr;
@@ -987,7 +997,95 @@ bool HLoopOptimization::TryVectorizedTraditional(LoopNode* node,
 }
 
 bool HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
-  return TryOptimizeInnerLoopFinite(node) || TryLoopScalarOpts(node);
+  if (TryOptimizeInnerLoopFinite(node)) {
+    return true;
+  }
+  // Strength reduction keeps the loop shape, so scalar optimizations can still apply after it.
+  bool strength_reduced = TryStrengthReduceInductions(node);
+  return TryLoopScalarOpts(node) || strength_reduced;
+}
+
+// Returns the constant step `s` of `phi` if it is a basic induction `phi = phi + s` of the
+// loop, whose back edge is its only update.
+static bool IsBasicInductionWithConstantStep(HPhi* phi, /*out*/ int32_t* step) {
+  if (phi->GetType() != DataType::Type::kInt32 || phi->InputCount() != 2u) {
+    return false;
+  }
+  HInstruction* update = phi->InputAt(1);
+  if (!update->IsAdd() || update->InputAt(0) != phi || !update->InputAt(1)->IsIntConstant()) {
+    return false;
+  }
+  *step = update->InputAt(1)->AsIntConstant()->GetValue();
+  return true;
+}
+
+bool HLoopOptimization::TryStrengthReduceInductions(LoopNode* node) {
+  HLoopInformation* loop_info = node->loop_info;
+  HBasicBlock* header = loop_info->GetHeader();
+  HBasicBlock* preheader = loop_info->GetPreHeader();
+  if (header->GetPredecessors().size() != 2u) {
+    return false;  // need a single back edge
+  }
+  DCHECK_EQ(header->GetPredecessors()[0], preheader);
+  bool changed = false;
+  for (HInstructionIterator phi_it(header->GetPhis()); !phi_it.Done(); phi_it.Advance()) {
+    HPhi* phi = phi_it.Current()->AsPhi();
+    int32_t step = 0;
+    if (!IsBasicInductionWithConstantStep(phi, &step)) {
+      continue;
+    }
+    HInstruction* update = phi->InputAt(1);
+    // Collect the users first, as replacing them changes the use list.
+    ScopedArenaVector<HMul*> muls(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+    for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+      HInstruction* user = use.GetUser();
+      if (user->IsMul() &&
+          user->GetType() == DataType::Type::kInt32 &&
+          loop_info->Contains(*user->GetBlock()) &&
+          user->AsMul()->GetConstantRight() != nullptr &&
+          user->AsMul()->GetLeastConstantLeft() == phi) {
+        int32_t factor = user->AsMul()->GetConstantRight()->AsIntConstant()->GetValue();
+        // Multiplications by a power of two are a single cheap shift already.
+        if (!IsPowerOfTwo(std::abs(static_cast<int64_t>(factor)))) {
+          muls.push_back(user->AsMul());
+        }
+      }
+    }
+    for (HMul* mul : muls) {
+      // The multiplication may have been replaced already by a same-factor one.
+      if (mul->GetBlock() == nullptr) {
+        continue;
+      }
+      int32_t factor = mul->GetConstantRight()->AsIntConstant()->GetValue();
+      // new_phi = phi * factor at the start of each iteration. Use unsigned arithmetic for the
+      // scaled step to get the wrap-around semantics of the original multiplications.
+      HInstruction* init = Insert(
+          preheader, new (global_allocator_) HMul(DataType::Type::kInt32,
+                                                  phi->InputAt(0),
+                                                  graph_->GetIntConstant(factor)));
+      HPhi* new_phi = new (global_allocator_) HPhi(
+          global_allocator_, kNoRegNumber, 0, DataType::Type::kInt32);
+      header->AddPhi(new_phi);
+      int32_t scaled_step =
+          static_cast<int32_t>(static_cast<uint32_t>(step) * static_cast<uint32_t>(factor));
+      HInstruction* new_update = new (global_allocator_) HAdd(
+          DataType::Type::kInt32, new_phi, graph_->GetIntConstant(scaled_step));
+      update->GetBlock()->InsertInstructionAfter(new_update, update);
+      new_phi->AddInput(init);
+      new_phi->AddInput(new_update);
+      // Replace all the multiplications of `phi` by the same factor.
+      for (HMul* other : muls) {
+        if (other->GetBlock() != nullptr &&
+            other->GetConstantRight()->AsIntConstant()->GetValue() == factor) {
+          other->ReplaceWith(new_phi);
+          other->GetBlock()->RemoveInstruction(other);
+        }
+      }
+      MaybeRecordStat(stats_, MethodCompilationStat::kLoopInductionStrengthReduced);
+      changed = true;
+    }
+  }
+  return changed;
 }
 
 //
@@ -1008,9 +1106,15 @@ bool HLoopOptimization::TryUnrollingForBranchPenaltyReduction(LoopAnalysisInfo*
   if (generate_code) {
     // TODO: support other unrolling factors.
     DCHECK_EQ(unrolling_factor, 2u);
+    HLoopInformation* loop_info = analysis_info->GetLoopInfo();
+
+    // Peel the iterations which don't fit the unrolled loop, so that the loop check of the
+    // copied body can be removed below.
+    int64_t trip_count = analysis_info->GetTripCount();
+    DCHECK_NE(trip_count, LoopAnalysisInfo::kUnknownTripCount);
+    PeelByCount(loop_info, trip_count % unrolling_factor, &induction_range_);
 
     // Perform unrolling.
-    HLoopInformation* loop_info = analysis_info->GetLoopInfo();
     LoopClonerSimpleHelper helper(loop_info, &induction_range_);
     helper.DoUnrolling();
 
@@ -1104,26 +1208,30 @@ bool HLoopOptimization::TryLoopScalarOpts(LoopNode* node) {
 
   LoopAnalysisInfo analysis_info(loop_info);
   LoopAnalysis::CalculateLoopBasicProperties(loop_info, &analysis_info, trip_count);
-  if (analysis_info.HasInstructionsPreventingScalarOpts() ||
-      arch_loop_helper_->IsLoopNonBeneficialForScalarOpts(&analysis_info)) {
+  if (analysis_info.HasInstructionsPreventingScalarOpts()) {
     return false;
   }
 
-  if (!TryFullUnrolling(&analysis_info, /*generate_code*/ false) &&
-      !TryPeelingForLoopInvariantExitsElimination(&analysis_info, /*generate_code*/ false) &&
-      !TryUnrollingForBranchPenaltyReduction(&analysis_info, /*generate_code*/ false) &&
-      !TryToRemoveSuspendCheckFromLoopHeader(&analysis_info, /*generate_code*/ false)) {
-    return false;
-  }
-
-  // Try the suspend check removal even for non-clonable loops. Also this
+  // Try the suspend check removal even for non-clonable loops and for loops where
+  // the target heuristics reject the other scalar loop optimizations, as its own
+  // heuristic only depends on the total number of executed instructions. Also this
   // optimization doesn't interfere with other scalar loop optimizations so it can
   // be done prior to them.
   bool removed_suspend_check = TryToRemoveSuspendCheckFromLoopHeader(&analysis_info);
 
+  if (arch_loop_helper_->IsLoopNonBeneficialForScalarOpts(&analysis_info)) {
+    return removed_suspend_check;
+  }
+
+  if (!TryFullUnrolling(&analysis_info, /*generate_code*/ false) &&
+      !TryPeelingForLoopInvariantExitsElimination(&analysis_info, /*generate_code*/ false) &&
+      !TryUnrollingForBranchPenaltyReduction(&analysis_info, /*generate_code*/ false)) {
+    return removed_suspend_check;
+  }
+
   // Run 'IsLoopClonable' the last as it might be time-consuming.
   if (!LoopClonerHelper::IsLoopClonable(loop_info)) {
-    return false;
+    return removed_suspend_check;
   }
 
   return TryFullUnrolling(&analysis_info) ||
@@ -1146,8 +1254,7 @@ bool HLoopOptimization::CanVectorizeDataFlow(LoopNode* node,
   vector_refs_->clear();
   vector_static_peeling_factor_ = 0;
   vector_dynamic_peeling_candidate_ = nullptr;
-  vector_runtime_test_a_ =
-  vector_runtime_test_b_ = nullptr;
+  vector_runtime_tests_->clear();
 
   // Traverse the data flow of the loop, in the original program order.
   for (HBlocksInLoopReversePostOrderIterator block_it(*header->GetLoopInformation());
@@ -1221,14 +1328,18 @@ bool HLoopOptimization::CanVectorizeDataFlow(LoopNode* node,
           // Conservatively assume a potential loop-carried data dependence otherwise, avoided by
           // generating an explicit a != b disambiguation runtime test on the two references.
           if (x != y) {
-            // To avoid excessive overhead, we only accept one a != b test.
-            if (vector_runtime_test_a_ == nullptr) {
-              // First test found.
-              vector_runtime_test_a_ = a;
-              vector_runtime_test_b_ = b;
-            } else if ((vector_runtime_test_a_ != a || vector_runtime_test_b_ != b) &&
-                       (vector_runtime_test_a_ != b || vector_runtime_test_b_ != a)) {
-              return false;  // second test would be needed
+            auto same_pair = [a, b](const std::pair<HInstruction*, HInstruction*>& test) {
+              return (test.first == a && test.second == b) ||
+                     (test.first == b && test.second == a);
+            };
+            if (std::none_of(vector_runtime_tests_->begin(),
+                             vector_runtime_tests_->end(),
+                             same_pair)) {
+              // To avoid excessive overhead, we only accept a few a != b tests.
+              if (vector_runtime_tests_->size() == kMaxArrayRefsDisambiguationTests) {
+                return false;
+              }
+              vector_runtime_tests_->emplace_back(a, b);
             }
           }
         }
@@ -1317,12 +1428,7 @@ void HLoopOptimization::VectorizePredicated(LoopNode* node,
   // Generate runtime disambiguation test:
   // vtc = a != b ? vtc : 0;
   if (NeedsArrayRefsDisambiguationTest()) {
-    HInstruction* rt = Insert(
-        preheader,
-        new (global_allocator_) HNotEqual(vector_runtime_test_a_, vector_runtime_test_b_));
-    vtc = Insert(preheader,
-                 new (global_allocator_)
-                 HSelect(rt, vtc, graph_->GetConstant(induc_type, 0), kNoDexPc));
+    vtc = GenerateArrayRefsDisambiguationTest(preheader, vtc, induc_type);
     needs_disambiguation_test = true;
   }
 
@@ -1466,12 +1572,7 @@ void HLoopOptimization::VectorizeTraditional(LoopNode* node,
   // Generate runtime disambiguation test:
   // vtc = a != b ? vtc : 0;
   if (NeedsArrayRefsDisambiguationTest()) {
-    HInstruction* rt = Insert(
-        preheader,
-        new (global_allocator_) HNotEqual(vector_runtime_test_a_, vector_runtime_test_b_));
-    vtc = Insert(preheader,
-                 new (global_allocator_)
-                 HSelect(rt, vtc, graph_->GetConstant(induc_type, 0), kNoDexPc));
+    vtc = GenerateArrayRefsDisambiguationTest(preheader, vtc, induc_type);
     needs_cleanup = true;
   }
 
@@ -1582,6 +1683,19 @@ HPhi* HLoopOptimization::InitializeForNewLoop(HBasicBlock* new_preheader, HInstr
   return phi;
 }
 
+HInstruction* HLoopOptimization::GenerateArrayRefsDisambiguationTest(HBasicBlock* preheader,
+                                                                     HInstruction* vtc,
+                                                                     DataType::Type induc_type) {
+  DCHECK(NeedsArrayRefsDisambiguationTest());
+  for (const auto& [a, b] : *vector_runtime_tests_) {
+    HInstruction* rt = Insert(preheader, new (global_allocator_) HNotEqual(a, b));
+    vtc = Insert(preheader,
+                 new (global_allocator_)
+                 HSelect(rt, vtc, graph_->GetConstant(induc_type, 0), kNoDexPc));
+  }
+  return vtc;
+}
+
 void HLoopOptimization::GenerateNewLoopScalarOrTraditional(LoopNode* node,
                                                            HBasicBlock* new_preheader,
                                                            HInstruction* lo,
@@ -2033,11 +2147,11 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
         case DataType::Type::kBool:
         case DataType::Type::kUint8:
         case DataType::Type::kInt8:
-          *restrictions |= kNoDiv | kNoReduction | kNoDotProd;
+          *restrictions |= kNoDiv;
           return TrySetVectorLength(type, 8);
         case DataType::Type::kUint16:
         case DataType::Type::kInt16:
-          *restrictions |= kNoDiv | kNoStringCharAt | kNoReduction | kNoDotProd;
+          *restrictions |= kNoDiv | kNoStringCharAt;
           return TrySetVectorLength(type, 4);
         case DataType::Type::kInt32:
           *restrictions |= kNoDiv | kNoWideSAD;
@@ -2086,10 +2200,11 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
             *restrictions |= kNoDiv | kNoSAD | kNoIfCond;
             return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction | kNoIfCond;
-            return TrySetVectorLength(type, vector_length);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction | kNoIfCond;
+            *restrictions |= kNoIfCond;
+            if (!relaxed_fp_reductions_) {
+              *restrictions |= kNoReduction;
+            }
             return TrySetVectorLength(type, vector_length);
           default:
             break;
@@ -2116,16 +2231,56 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
             *restrictions |= kNoDiv | kNoMul;
             return TrySetVectorLength(type, 2);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction;
+            if (!relaxed_fp_reductions_) {
+              *restrictions |= kNoReduction;
+            }
             return TrySetVectorLength(type, 4);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction;
+            if (!relaxed_fp_reductions_) {
+              *restrictions |= kNoReduction;
+            }
             return TrySetVectorLength(type, 2);
           default:
             break;
         }
         return false;
       }
+    case InstructionSet::kRiscv64:
+      // Allow vectorization for devices with the "V" extension, using a fixed 128-bit part of
+      // each vector register. Only the basic element-wise operations are supported.
+      if (features->AsRiscv64InstructionSetFeatures()->HasVector()) {
+        *restrictions |= kNoIfCond |
+                         kNoReduction |
+                         kNoSignedHAdd |
+                         kNoUnsignedHAdd |
+                         kNoUnroundedHAdd |
+                         kNoSAD |
+                         kNoDotProd;
+        switch (type) {
+          case DataType::Type::kBool:
+          case DataType::Type::kUint8:
+          case DataType::Type::kInt8:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 16);
+          case DataType::Type::kUint16:
+          case DataType::Type::kInt16:
+            *restrictions |= kNoDiv | kNoStringCharAt;
+            return TrySetVectorLength(type, 8);
+          case DataType::Type::kInt32:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 4);
+          case DataType::Type::kInt64:
+            *restrictions |= kNoDiv;
+            return TrySetVectorLength(type, 2);
+          case DataType::Type::kFloat32:
+            return TrySetVectorLength(type, 4);
+          case DataType::Type::kFloat64:
+            return TrySetVectorLength(type, 2);
+          default:
+            break;
+        }
+      }
+      return false;
     case InstructionSet::kX86:
     case InstructionSet::kX86_64:
       // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD).
@@ -2166,10 +2321,14 @@ bool HLoopOptimization::TrySetVectorType(DataType::Type type, uint64_t* restrict
             *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoSAD;
             return TrySetVectorLength(type, 2);
           case DataType::Type::kFloat32:
-            *restrictions |= kNoReduction;
+            if (!relaxed_fp_reductions_) {
+              *restrictions |= kNoReduction;
+            }
             return TrySetVectorLength(type, 4);
           case DataType::Type::kFloat64:
-            *restrictions |= kNoReduction;
+            if (!relaxed_fp_reductions_) {
+              *restrictions |= kNoReduction;
+            }
             return TrySetVectorLength(type, 2);
           default:
             break;
@@ -2610,6 +2769,10 @@ bool HLoopOptimization::VectorizeSADIdiom(LoopNode* node,
       (reduction_type != sub_type && HasVectorRestrictions(restrictions, kNoWideSAD))) {
     return false;
   }
+  // The accumulator must still be a vector after widening (not the case for narrow SIMD).
+  if (GetOtherVL(reduction_type, sub_type, vector_length_) < 2u) {
+    return false;
+  }
   // Accept SAD idiom for vectorizable operands. Vectorized code uses the shorthand
   // idiomatic operation. Sequential code uses the original scalar expressions.
   DCHECK(r != nullptr && s != nullptr);
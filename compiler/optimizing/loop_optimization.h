@@ -290,6 +290,11 @@ class HLoopOptimization : public HOptimization {
   // Tries to apply scalar loop optimizations.
   bool TryLoopScalarOpts(LoopNode* node);
 
+  // Tries to replace multiplications of a basic induction variable by a constant with a new
+  // induction variable that is incremented by the scaled step, e.g. the `3 * i` in
+  // `a[3 * i + 1]` for array-of-struct style accesses. Returns whether anything changed.
+  bool TryStrengthReduceInductions(LoopNode* node);
+
   //
   // Vectorization analysis and synthesis.
   //
@@ -381,7 +386,13 @@ class HLoopOptimization : public HOptimization {
                                HInstruction* step);
 
   // Returns whether the vector loop needs runtime disambiguation test for array refs.
-  bool NeedsArrayRefsDisambiguationTest() const { return vector_runtime_test_a_ != nullptr; }
+  bool NeedsArrayRefsDisambiguationTest() const { return !vector_runtime_tests_->empty(); }
+
+  // Generates the runtime disambiguation tests for array refs in the preheader and returns
+  // the vector trip count `vtc` guarded by them, i.e. zero if any pair of arrays is the same.
+  HInstruction* GenerateArrayRefsDisambiguationTest(HBasicBlock* preheader,
+                                                    HInstruction* vtc,
+                                                    DataType::Type induc_type);
 
   bool VectorizeDef(LoopNode* node, HInstruction* instruction, bool generate_code);
   bool VectorizeUse(LoopNode* node,
@@ -520,6 +531,9 @@ class HLoopOptimization : public HOptimization {
   // Whether to use predicated loop vectorization (e.g. for arm64 SVE target).
   bool predicated_vectorization_mode_;
 
+  // Whether floating point reductions may be reassociated, which allows vectorizing them.
+  const bool relaxed_fp_reductions_;
+
   // Number of "lanes" for selected packed type.
   uint32_t vector_length_;
 
@@ -531,9 +545,9 @@ class HLoopOptimization : public HOptimization {
   uint32_t vector_static_peeling_factor_;
   const ArrayReference* vector_dynamic_peeling_candidate_;
 
-  // Dynamic data dependence test of the form a != b.
-  HInstruction* vector_runtime_test_a_;
-  HInstruction* vector_runtime_test_b_;
+  // Dynamic data dependence tests of the form a != b, one for each pair of array
+  // references that may alias. Contents reside in phase-local heap memory.
+  ScopedArenaVector<std::pair<HInstruction*, HInstruction*>>* vector_runtime_tests_;
 
   // Mapping used during vectorization synthesis for both the scalar peeling/cleanup
   // loop (mode is kSequential) and the actual vector loop (mode is kVector). The data
@@ -419,6 +419,7 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         invoke_type_(invoke_type),
         in_ssa_form_(false),
         number_of_cha_guards_(0),
+        number_of_inlined_invokes_(0),
         instruction_set_(instruction_set),
         cached_null_constant_(nullptr),
         cached_int_constants_(std::less<int32_t>(), allocator->Adapter(kArenaAllocConstantsMap)),
@@ -429,7 +430,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         art_method_(nullptr),
         compilation_kind_(compilation_kind),
         useful_optimizing_(false),
-        cha_single_implementation_list_(allocator->Adapter(kArenaAllocCHA)) {
+        count_invocations_(false),
+        cha_single_implementation_list_(allocator->Adapter(kArenaAllocCHA)),
+        class_dependencies_(allocator->Adapter(kArenaAllocCHA)) {
     blocks_.reserve(kDefaultNumberOfBlocks);
   }
 
@@ -697,6 +700,14 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
     cha_single_implementation_list_.insert(method);
   }
 
+  const ArenaSet<uint32_t>& GetClassDependencies() const {
+    return class_dependencies_;
+  }
+
+  void AddClassDependency(uint32_t descriptor_hash) {
+    class_dependencies_.insert(descriptor_hash);
+  }
+
   bool HasShouldDeoptimizeFlag() const {
     return number_of_cha_guards_ != 0 || debuggable_;
   }
@@ -746,9 +757,15 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   void SetNumberOfCHAGuards(uint32_t num) { number_of_cha_guards_ = num; }
   void IncrementNumberOfCHAGuards() { number_of_cha_guards_++; }
 
+  uint32_t GetNumberOfInlinedInvokes() const { return number_of_inlined_invokes_; }
+  void IncrementNumberOfInlinedInvokes() { number_of_inlined_invokes_++; }
+
   void SetUsefulOptimizing() { useful_optimizing_ = true; }
   bool IsUsefulOptimizing() const { return useful_optimizing_; }
 
+  void SetCountInvocations() { count_invocations_ = true; }
+  bool IsCountingInvocations() const { return count_invocations_; }
+
  private:
   void RemoveDeadBlocksInstructionsAsUsersAndDisconnect(const ArenaBitVector& visited) const;
   void RemoveDeadBlocks(const ArenaBitVector& visited);
@@ -879,6 +896,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // CHA guard optimization pass when there is no CHA guard left.
   uint32_t number_of_cha_guards_;
 
+  // Number of invokes inlined into the graph, including those inlined into inlined methods.
+  uint32_t number_of_inlined_invokes_;
+
   const InstructionSet instruction_set_;
 
   // Cached constants.
@@ -908,9 +928,17 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // method.
   bool useful_optimizing_;
 
+  // Whether the frame entry increments the invocation count of the method's `ProfilingInfo`.
+  bool count_invocations_;
+
   // List of methods that are assumed to have single implementation.
   ArenaSet<ArtMethod*> cha_single_implementation_list_;
 
+  // Descriptor hashes of the classes whose layout or methods the code depends on. Only recorded
+  // for debuggable JIT code, so that a structural class redefinition can invalidate just the code
+  // that depends on the redefined classes.
+  ArenaSet<uint32_t> class_dependencies_;
+
   friend class SsaBuilder;           // For caching constants.
   friend class SsaLivenessAnalysis;  // For the linear order.
   friend class HInliner;             // For the reverse post order.
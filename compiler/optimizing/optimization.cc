@@ -44,6 +44,7 @@
 #include "constant_folding.h"
 #include "constructor_fence_redundancy_elimination.h"
 #include "dead_code_elimination.h"
+#include "dex_cache_load_elimination.h"
 #include "dex/code_item_accessors-inl.h"
 #include "driver/compiler_options.h"
 #include "driver/dex_compilation_unit.h"
@@ -85,6 +86,8 @@ const char* OptimizationPassName(OptimizationPass pass) {
       return HConstantFolding::kConstantFoldingPassName;
     case OptimizationPass::kDeadCodeElimination:
       return HDeadCodeElimination::kDeadCodeEliminationPassName;
+    case OptimizationPass::kDexCacheLoadElimination:
+      return DexCacheLoadElimination::kDexCacheLoadEliminationPassName;
     case OptimizationPass::kInliner:
       return HInliner::kInlinerPassName;
     case OptimizationPass::kSelectGenerator:
@@ -147,6 +150,7 @@ OptimizationPass OptimizationPassByName(const std::string& pass_name) {
   X(OptimizationPass::kConstantFolding);
   X(OptimizationPass::kConstructorFenceRedundancyElimination);
   X(OptimizationPass::kDeadCodeElimination);
+  X(OptimizationPass::kDexCacheLoadElimination);
   X(OptimizationPass::kGlobalValueNumbering);
   X(OptimizationPass::kInductionVarAnalysis);
   X(OptimizationPass::kInliner);
@@ -244,6 +248,9 @@ ArenaVector<HOptimization*> ConstructOptimizations(
       case OptimizationPass::kDeadCodeElimination:
         opt = new (allocator) HDeadCodeElimination(graph, stats, pass_name);
         break;
+      case OptimizationPass::kDexCacheLoadElimination:
+        opt = new (allocator) DexCacheLoadElimination(graph, stats, pass_name);
+        break;
       case OptimizationPass::kInliner: {
         CodeItemDataAccessor accessor(*dex_compilation_unit.GetDexFile(),
                                       dex_compilation_unit.GetCodeItem());
@@ -19,6 +19,7 @@
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include <stdint.h>
 
@@ -31,7 +32,9 @@
 #include "base/mutex.h"
 #include "base/scoped_arena_allocator.h"
 #include "base/systrace.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
+#include "base/utils.h"
 #include "builder.h"
 #include "code_generator.h"
 #include "compiler.h"
@@ -44,15 +47,18 @@
 #include "graph_checker.h"
 #include "graph_visualizer.h"
 #include "inliner.h"
+#include "instrumentation.h"
 #include "jit/debugger_interface.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
 #include "jit/jit_logger.h"
+#include "jit/profiling_info.h"
 #include "jni/quick/jni_compiler.h"
 #include "linker/linker_patch.h"
 #include "nodes.h"
 #include "oat/oat_quick_method_header.h"
 #include "optimizing/write_barrier_elimination.h"
+#include "pass_summary.h"
 #include "prepare_for_register_allocation.h"
 #include "profiling_info_builder.h"
 #include "reference_type_propagation.h"
@@ -68,6 +74,13 @@ namespace art HIDDEN {
 
 static constexpr size_t kArenaAllocatorMemoryReportThreshold = 8 * MB;
 
+// Methods with more code units than this, or whose freshly built graph already uses more memory
+// than `kReducedPipelineMemoryThreshold`, are compiled with a reduced optimization pipeline.
+// The full pipeline's cost grows faster than linearly with the graph size for some passes
+// (e.g. GVN, LSE and the inliner), and such methods would dominate compile time and memory.
+static constexpr size_t kReducedPipelineCodeUnitsThreshold = 8 * KB;
+static constexpr size_t kReducedPipelineMemoryThreshold = 64 * MB;
+
 static constexpr const char* kPassNameSeparator = "$";
 
 /**
@@ -83,19 +96,27 @@ class PassObserver : public ValueObject {
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
-               const CompilerOptions& compiler_options)
+               const CompilerOptions& compiler_options,
+               PassSummary* pass_summary)
       : graph_(graph),
         last_seen_graph_size_(0),
         cached_method_name_(),
         timing_logger_enabled_(compiler_options.GetDumpPassTimings()),
         timing_logger_(timing_logger_enabled_ ? GetMethodName() : "", true, true),
+        pass_start_bytes_(),
+        pass_start_stack_peaks_(),
+        arena_usage_(),
         disasm_info_(graph->GetAllocator()),
         visualizer_oss_(),
         visualizer_output_(visualizer_output),
         visualizer_enabled_(!compiler_options.GetDumpCfgFileName().empty()),
         visualizer_(&visualizer_oss_, graph, codegen),
         codegen_(codegen),
-        graph_in_bad_state_(false) {
+        graph_in_bad_state_(false),
+        pass_summary_(pass_summary),
+        method_start_ns_(pass_summary != nullptr ? NanoTime() : 0u),
+        pass_start_ns_(),
+        pass_times_() {
     if (timing_logger_enabled_ || visualizer_enabled_) {
       if (!IsVerboseMethod(compiler_options, GetMethodName())) {
         timing_logger_enabled_ = visualizer_enabled_ = false;
@@ -108,9 +129,17 @@ class PassObserver : public ValueObject {
   }
 
   ~PassObserver() {
+    if (pass_summary_ != nullptr) {
+      size_t peak_arena_bytes =
+          graph_->GetAllocator()->BytesUsed() + graph_->GetArenaStack()->ApproximatePeakBytes();
+      pass_summary_->RecordMethod(method_start_ns_, NanoTime(), peak_arena_bytes, pass_times_);
+    }
     if (timing_logger_enabled_) {
       LOG(INFO) << "TIMINGS " << GetMethodName();
       LOG(INFO) << Dumpable<TimingLogger>(timing_logger_);
+      LOG(INFO) << "ARENA " << GetMethodName() << " (peak stack "
+                << PrettySize(graph_->GetArenaStack()->PeakBytesAllocated()) << ")";
+      LOG(INFO) << arena_usage_.str();
     }
     if (visualizer_enabled_) {
       FlushVisualizer();
@@ -144,8 +173,13 @@ class PassObserver : public ValueObject {
       FlushVisualizer();
     }
     if (timing_logger_enabled_) {
+      pass_start_bytes_.push_back(graph_->GetAllocator()->BytesAllocated());
+      pass_start_stack_peaks_.push_back(graph_->GetArenaStack()->ResetPeakBytesUsed());
       timing_logger_.StartTiming(pass_name);
     }
+    if (pass_summary_ != nullptr) {
+      pass_start_ns_.push_back(NanoTime());
+    }
   }
 
   void FlushVisualizer() {
@@ -157,8 +191,25 @@ class PassObserver : public ValueObject {
 
   void EndPass(const char* pass_name, bool pass_change) {
     // Pause timer first, then dump graph.
+    if (pass_summary_ != nullptr) {
+      DCHECK(!pass_start_ns_.empty());
+      pass_times_.emplace_back(pass_name, NanoTime() - pass_start_ns_.back());
+      pass_start_ns_.pop_back();
+    }
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
+      DCHECK(!pass_start_bytes_.empty());
+      size_t bytes_allocated = graph_->GetAllocator()->BytesAllocated();
+      // Restore the peak of an enclosing pass, it includes the peak of this pass.
+      DCHECK(!pass_start_stack_peaks_.empty());
+      ArenaStack* arena_stack = graph_->GetArenaStack();
+      size_t stack_peak = arena_stack->PeakBytesUsed();
+      arena_stack->ResetPeakBytesUsed(std::max(stack_peak, pass_start_stack_peaks_.back()));
+      arena_usage_ << pass_name << ": +" << PrettySize(bytes_allocated - pass_start_bytes_.back())
+                   << " (total " << PrettySize(bytes_allocated) << ", stack peak "
+                   << PrettySize(stack_peak) << ")\n";
+      pass_start_bytes_.pop_back();
+      pass_start_stack_peaks_.pop_back();
     }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass= */ true, graph_in_bad_state_);
@@ -206,6 +257,12 @@ class PassObserver : public ValueObject {
   bool timing_logger_enabled_;
   TimingLogger timing_logger_;
 
+  // Graph arena usage and the enclosing arena stack peak at the start of each running pass,
+  // and the per-pass report.
+  std::vector<size_t> pass_start_bytes_;
+  std::vector<size_t> pass_start_stack_peaks_;
+  std::ostringstream arena_usage_;
+
   DisassemblyInformation disasm_info_;
 
   std::ostringstream visualizer_oss_;
@@ -218,6 +275,13 @@ class PassObserver : public ValueObject {
   // expected to validate.
   bool graph_in_bad_state_;
 
+  // Aggregated timings for --dump-pass-summary, null if disabled. Nested passes are included in
+  // the time of the enclosing pass.
+  PassSummary* const pass_summary_;
+  const uint64_t method_start_ns_;
+  std::vector<uint64_t> pass_start_ns_;
+  PassSummary::PassTimes pass_times_;
+
   friend PassScope;
 
   DISALLOW_COPY_AND_ASSIGN(PassObserver);
@@ -374,6 +438,12 @@ class OptimizingCompiler final : public Compiler {
                          const DexCompilationUnit& dex_compilation_unit,
                          PassObserver* pass_observer) const;
 
+  // Runs only cheap, linear-time optimizations. Used for huge methods.
+  void RunReducedOptimizations(HGraph* graph,
+                               CodeGenerator* codegen,
+                               const DexCompilationUnit& dex_compilation_unit,
+                               PassObserver* pass_observer) const;
+
   std::vector<uint8_t> GenerateJitDebugInfo(const debug::MethodDebugInfo& method_debug_info);
 
   // This must be called before any other function that dumps data to the cfg
@@ -381,6 +451,8 @@ class OptimizingCompiler final : public Compiler {
 
   std::unique_ptr<OptimizingCompilerStats> compilation_stats_;
 
+  std::unique_ptr<PassSummary> pass_summary_;
+
   std::unique_ptr<std::ostream> visualizer_output_;
 
   DISALLOW_COPY_AND_ASSIGN(OptimizingCompiler);
@@ -402,12 +474,20 @@ OptimizingCompiler::OptimizingCompiler(const CompilerOptions& compiler_options,
   if (compiler_options.GetDumpStats()) {
     compilation_stats_.reset(new OptimizingCompilerStats());
   }
+  if (compiler_options.GetDumpPassSummary()) {
+    pass_summary_.reset(new PassSummary());
+  }
 }
 
 OptimizingCompiler::~OptimizingCompiler() {
   if (compilation_stats_.get() != nullptr) {
     compilation_stats_->Log();
   }
+  if (pass_summary_ != nullptr) {
+    std::ostringstream oss;
+    pass_summary_->Dump(oss);
+    LOG(INFO) << oss.str();
+  }
 }
 
 void OptimizingCompiler::DumpInstructionSetFeaturesToCfg() const {
@@ -661,6 +741,9 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
       OptDef(OptimizationPass::kDeadCodeElimination,
              "dead_code_elimination$after_inlining",
              OptimizationPass::kInliner),
+      OptDef(OptimizationPass::kDexCacheLoadElimination,
+             /* pass_name= */ nullptr,
+             OptimizationPass::kInliner),
       // GVN.
       OptDef(OptimizationPass::kSideEffectsAnalysis,
              "side_effects$before_gvn"),
@@ -716,6 +799,34 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
   RunArchOptimizations(graph, codegen, dex_compilation_unit, pass_observer);
 }
 
+// Returns whether the method should be compiled with the reduced pipeline. `allocator` holds
+// the freshly built graph.
+static bool IsHugeMethod(const DexFile& dex_file,
+                         const dex::CodeItem* code_item,
+                         ArenaAllocator* allocator) {
+  return CodeItemInstructionAccessor(dex_file, code_item).InsnsSizeInCodeUnits() >
+             kReducedPipelineCodeUnitsThreshold ||
+         allocator->BytesAllocated() > kReducedPipelineMemoryThreshold;
+}
+
+void OptimizingCompiler::RunReducedOptimizations(HGraph* graph,
+                                                 CodeGenerator* codegen,
+                                                 const DexCompilationUnit& dex_compilation_unit,
+                                                 PassObserver* pass_observer) const {
+  OptimizationDef optimizations[] = {
+      OptDef(OptimizationPass::kConstantFolding),
+      OptDef(OptimizationPass::kInstructionSimplifier),
+      OptDef(OptimizationPass::kDeadCodeElimination),
+  };
+  RunOptimizations(graph,
+                   codegen,
+                   dex_compilation_unit,
+                   pass_observer,
+                   optimizations);
+
+  RunRequiredPasses(graph, codegen, dex_compilation_unit, pass_observer);
+}
+
 static ArenaVector<linker::LinkerPatch> EmitAndSortLinkerPatches(CodeGenerator* codegen) {
   ArenaVector<linker::LinkerPatch> linker_patches(codegen->GetGraph()->GetAllocator()->Adapter());
   codegen->EmitLinkerPatches(&linker_patches);
@@ -840,6 +951,13 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   if (jit != nullptr) {
     ProfilingInfo* info = jit->GetCodeCache()->GetProfilingInfo(method, Thread::Current());
     graph->SetProfilingInfo(info);
+    // OSR code is entered from a loop, not through its frame entry, so it cannot count.
+    if (compilation_kind != CompilationKind::kOsr) {
+      ScopedObjectAccess soa(Thread::Current());
+      if (Runtime::Current()->GetInstrumentation()->CountsInvocationsInCompiledCode()) {
+        graph->SetCountInvocations();
+      }
+    }
   }
 
   std::unique_ptr<CodeGenerator> codegen(
@@ -855,7 +973,8 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
-                             compiler_options);
+                             compiler_options,
+                             pass_summary_.get());
 
   {
     VLOG(compiler) << "Building " << pass_observer.GetMethodName();
@@ -918,6 +1037,13 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
     graph->SetUsefulOptimizing();
     // Branch profiling currently doesn't support running optimizations.
     RunRequiredPasses(graph, codegen.get(), dex_compilation_unit, &pass_observer);
+  } else if (GetCompilerOptions().GetPassesToRun() == nullptr &&
+             IsHugeMethod(dex_file, code_item, allocator)) {
+    // Keep compile time and memory in check with cheap optimizations only.
+    VLOG(compiler) << "Compiling " << graph->PrettyMethod() << " with a reduced pipeline";
+    MaybeRecordStat(compilation_stats_.get(),
+                    MethodCompilationStat::kCompiledWithReducedPipeline);
+    RunReducedOptimizations(graph, codegen.get(), dex_compilation_unit, &pass_observer);
   } else {
     RunOptimizations(graph, codegen.get(), dex_compilation_unit, &pass_observer);
     PassScope scope(WriteBarrierElimination::kWBEPassName, &pass_observer);
@@ -942,6 +1068,22 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* allocator,
     }
   }
 
+  // The invocation counter lives in the profiling info, create one if the method does not have
+  // one already.
+  if (graph->IsCountingInvocations() && graph->GetProfilingInfo() == nullptr) {
+    ProfilingInfo* info;
+    {
+      ScopedObjectAccess soa(Thread::Current());
+      info = ProfilingInfo::Create(soa.Self(), method, /*inline_cache_entries=*/ {});
+    }
+    if (info == nullptr) {
+      SCOPED_TRACE << "Not compiling because of out of memory";
+      MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kJitOutOfMemoryForCommit);
+      return nullptr;
+    }
+    graph->SetProfilingInfo(info);
+  }
+
   AllocateRegisters(graph,
                     codegen.get(),
                     &pass_observer,
@@ -1012,7 +1154,8 @@ CodeGenerator* OptimizingCompiler::TryCompileIntrinsic(
   PassObserver pass_observer(graph,
                              codegen.get(),
                              visualizer_output_.get(),
-                             compiler_options);
+                             compiler_options,
+                             pass_summary_.get());
 
   {
     VLOG(compiler) << "Building intrinsic graph " << pass_observer.GetMethodName();
@@ -1266,6 +1409,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                                     ArtMethod* method,
                                     CompilationKind compilation_kind,
                                     jit::JitLogger* jit_logger) {
+  const uint64_t start_ns = NanoTime();
   const CompilerOptions& compiler_options = GetCompilerOptions();
   DCHECK(compiler_options.IsJitCompiler());
   DCHECK_EQ(compiler_options.IsJitCompilerForSharedCode(), code_cache->IsSharedRegion(*region));
@@ -1303,6 +1447,7 @@ bool OptimizingCompiler::JitCompile(Thread* self,
     std::vector<Handle<mirror::Object>> roots;
     ArenaSet<ArtMethod*, std::less<ArtMethod*>> cha_single_implementation_list(
         allocator.Adapter(kArenaAllocCHA));
+    ArenaSet<uint32_t> class_dependencies(allocator.Adapter(kArenaAllocCHA));
     ArenaStack arena_stack(runtime->GetJitArenaPool());
     // StackMapStream is large and it does not fit into this frame, so we need helper method.
     ScopedArenaAllocator stack_map_allocator(&arena_stack);  // Will hold the stack map.
@@ -1362,7 +1507,8 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                             debug_info,
                             /* is_full_debug_info= */ compiler_options.GetGenerateDebugInfo(),
                             compilation_kind,
-                            cha_single_implementation_list)) {
+                            cha_single_implementation_list,
+                            class_dependencies)) {
       code_cache->Free(self, region, reserved_code.data(), reserved_data.data());
       return false;
     }
@@ -1474,14 +1620,23 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                           debug_info,
                           /* is_full_debug_info= */ compiler_options.GetGenerateDebugInfo(),
                           compilation_kind,
-                          codegen->GetGraph()->GetCHASingleImplementationList())) {
+                          codegen->GetGraph()->GetCHASingleImplementationList(),
+                          codegen->GetGraph()->GetClassDependencies())) {
     CHECK_EQ(CodeInfo::HasShouldDeoptimizeFlag(stack_map.data()),
              codegen->GetGraph()->HasShouldDeoptimizeFlag());
     code_cache->Free(self, region, reserved_code.data(), reserved_data.data());
     return false;
   }
 
-  Runtime::Current()->GetJit()->AddMemoryUsage(method, allocator.BytesUsed());
+  jit::Jit* jit = Runtime::Current()->GetJit();
+  jit->AddMemoryUsage(method, allocator.BytesUsed());
+  jit->AddCompilationRecord(method,
+                            compilation_kind,
+                            dchecked_integral_cast<uint32_t>(
+                                codegen->GetGraph()->GetCurrentInstructionId()),
+                            codegen->GetGraph()->GetNumberOfInlinedInvokes(),
+                            NsToUs(NanoTime() - start_ns),
+                            codegen->GetAssembler()->CodeSize());
   if (jit_logger != nullptr) {
     jit_logger->WriteLog(code, codegen->GetAssembler()->CodeSize(), method);
   }
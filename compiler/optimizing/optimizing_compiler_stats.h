@@ -36,6 +36,7 @@ enum class MethodCompilationStat {
   kCompiledNativeStub,
   kCompiledIntrinsic,
   kCompiledBytecode,
+  kCompiledWithReducedPipeline,
   kCHAInline,
   kInlinedInvoke,
   kInlinedLastInvoke,
@@ -71,21 +72,29 @@ enum class MethodCompilationStat {
   kNotCompiledFrameTooBig,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
+  kInlinedMegamorphicCall,
   kMonomorphicCall,
   kPolymorphicCall,
   kMegamorphicCall,
+  kSpeculatedTypeCheck,
+  kSpeculatedMethodHandleTarget,
   kBooleanSimplified,
   kIntrinsicRecognized,
   kLoopInvariantMoved,
   kLoopVectorized,
   kLoopVectorizedIdiom,
+  kLoopInductionStrengthReduced,
   kSelectGenerated,
   kRemovedInstanceOf,
   kPropagatedIfValue,
   kInlinedInvokeVirtualOrInterface,
   kInlinedLastInvokeVirtualOrInterface,
+  kInlinedWithConstantArguments,
   kImplicitNullCheckGenerated,
   kExplicitNullCheckGenerated,
+  kRegisterSpilled,
+  kRegisterReloaded,
+  kRegisterSpilledOrReloadedInLoop,
   kSimplifyIf,
   kSimplifyIfAddedPhi,
   kSimplifyThrowingInvoke,
@@ -131,11 +140,14 @@ enum class MethodCompilationStat {
   kJitOutOfMemoryForCommit,
   kFullLSEAllocationRemoved,
   kFullLSEPossible,
+  kPartialEscapeSingleton,
   kNonPartialLoadRemoved,
   kPartialLSEPossible,
   kPartialStoreRemoved,
   kPartialAllocationMoved,
   kDevirtualized,
+  kRemovedDexCacheLoad,
+  kRemovedClinitCheck,
   kLastStat
 };
 std::ostream& operator<<(std::ostream& os, MethodCompilationStat rhs);
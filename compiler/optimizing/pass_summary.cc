@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pass_summary.h"
+
+#include <algorithm>
+#include <iomanip>
+
+#include "base/time_utils.h"
+#include "base/utils.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+template <typename T>
+static T Percentile(const std::vector<T>& sorted_values, size_t percent) {
+  DCHECK(!sorted_values.empty());
+  return sorted_values[(sorted_values.size() - 1u) * percent / 100u];
+}
+
+void PassSummary::RecordMethod(uint64_t start_ns,
+                               uint64_t end_ns,
+                               size_t peak_arena_bytes,
+                               const PassTimes& pass_times) {
+  MutexLock mu(Thread::Current(), lock_);
+  for (const std::pair<const char*, uint64_t>& pass_time : pass_times) {
+    PassTotals& totals = passes_[pass_time.first];
+    ++totals.runs;
+    totals.total_ns += pass_time.second;
+    totals.max_ns = std::max(totals.max_ns, pass_time.second);
+  }
+  method_times_ns_.push_back(end_ns - start_ns);
+  method_peak_arena_bytes_.push_back(peak_arena_bytes);
+  first_start_ns_ = std::min(first_start_ns_, start_ns);
+  last_end_ns_ = std::max(last_end_ns_, end_ns);
+}
+
+size_t PassSummary::GetMethodCount() {
+  MutexLock mu(Thread::Current(), lock_);
+  return method_times_ns_.size();
+}
+
+void PassSummary::Dump(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  if (method_times_ns_.empty()) {
+    os << "Pass summary: no method compiled.\n";
+    return;
+  }
+  std::vector<uint64_t> times = method_times_ns_;
+  std::sort(times.begin(), times.end());
+  std::vector<size_t> peaks = method_peak_arena_bytes_;
+  std::sort(peaks.begin(), peaks.end());
+  uint64_t total_method_ns = 0u;
+  for (uint64_t time : times) {
+    total_method_ns += time;
+  }
+  uint64_t wall_ns = std::max<uint64_t>(last_end_ns_ - first_start_ns_, 1u);
+
+  os << std::fixed << std::setprecision(1)
+     << "Pass summary: " << times.size() << " methods in " << PrettyDuration(wall_ns)
+     << " wall, " << times.size() * 1e9 / wall_ns << " methods/s\n"
+     << "Method time: total " << PrettyDuration(total_method_ns)
+     << ", p50 " << PrettyDuration(Percentile(times, 50))
+     << ", p90 " << PrettyDuration(Percentile(times, 90))
+     << ", p99 " << PrettyDuration(Percentile(times, 99))
+     << ", max " << PrettyDuration(times.back()) << "\n"
+     << "Method peak arena: p50 " << PrettySize(Percentile(peaks, 50))
+     << ", p90 " << PrettySize(Percentile(peaks, 90))
+     << ", p99 " << PrettySize(Percentile(peaks, 99))
+     << ", max " << PrettySize(peaks.back()) << "\n";
+
+  std::vector<std::pair<std::string, PassTotals>> passes(passes_.begin(), passes_.end());
+  std::sort(passes.begin(), passes.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.total_ns > rhs.second.total_ns;
+  });
+  for (const std::pair<std::string, PassTotals>& pass : passes) {
+    const PassTotals& totals = pass.second;
+    os << "Pass " << pass.first << ": " << totals.runs << " runs, total "
+       << PrettyDuration(totals.total_ns) << " ("
+       << totals.total_ns * 100.0 / std::max<uint64_t>(total_method_ns, 1u) << "%), mean "
+       << PrettyDuration(totals.total_ns / totals.runs) << ", max "
+       << PrettyDuration(totals.max_ns) << "\n";
+  }
+}
+
+}  // namespace art
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_PASS_SUMMARY_H_
+#define ART_COMPILER_OPTIMIZING_PASS_SUMMARY_H_
+
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+
+namespace art HIDDEN {
+
+// Aggregates the time spent in each pass of the optimizing compiler and the arena memory used
+// by each method over a whole compilation, for `--dump-pass-summary`. Methods can be recorded
+// from several compiler threads.
+class PassSummary {
+ public:
+  // The time spent in each pass run for a method, in the order the passes ended.
+  using PassTimes = std::vector<std::pair<const char*, uint64_t>>;
+
+  PassSummary() : lock_("pass summary lock", kGenericBottomLock) {}
+
+  // Records a method compiled between `start_ns` and `end_ns` that used at most
+  // `peak_arena_bytes` of arena memory.
+  void RecordMethod(uint64_t start_ns,
+                    uint64_t end_ns,
+                    size_t peak_arena_bytes,
+                    const PassTimes& pass_times) REQUIRES(!lock_);
+
+  size_t GetMethodCount() REQUIRES(!lock_);
+
+  // Dumps the methods per second of wall time, per-method time and memory percentiles, and the
+  // per-pass totals, most expensive pass first.
+  void Dump(std::ostream& os) REQUIRES(!lock_);
+
+ private:
+  struct PassTotals {
+    size_t runs = 0u;
+    uint64_t total_ns = 0u;
+    uint64_t max_ns = 0u;
+  };
+
+  Mutex lock_;
+  std::map<std::string, PassTotals> passes_ GUARDED_BY(lock_);
+  std::vector<uint64_t> method_times_ns_ GUARDED_BY(lock_);
+  std::vector<size_t> method_peak_arena_bytes_ GUARDED_BY(lock_);
+  uint64_t first_start_ns_ GUARDED_BY(lock_) = std::numeric_limits<uint64_t>::max();
+  uint64_t last_end_ns_ GUARDED_BY(lock_) = 0u;
+
+  DISALLOW_COPY_AND_ASSIGN(PassSummary);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_PASS_SUMMARY_H_
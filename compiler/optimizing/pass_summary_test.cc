@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pass_summary.h"
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+namespace art HIDDEN {
+
+TEST(PassSummaryTest, Empty) {
+  PassSummary summary;
+  std::ostringstream oss;
+  summary.Dump(oss);
+  EXPECT_EQ(0u, summary.GetMethodCount());
+  EXPECT_EQ("Pass summary: no method compiled.\n", oss.str());
+}
+
+TEST(PassSummaryTest, AggregatesPassesAcrossMethods) {
+  PassSummary summary;
+  summary.RecordMethod(/*start_ns=*/ 1000u,
+                       /*end_ns=*/ 2000u,
+                       /*peak_arena_bytes=*/ 4096u,
+                       {{"builder", 300u}, {"inliner", 600u}});
+  summary.RecordMethod(/*start_ns=*/ 1500u,
+                       /*end_ns=*/ 3000u,
+                       /*peak_arena_bytes=*/ 8192u,
+                       {{"builder", 500u}, {"register", 200u}});
+  EXPECT_EQ(2u, summary.GetMethodCount());
+
+  std::ostringstream oss;
+  summary.Dump(oss);
+  std::string dump = oss.str();
+  // Two methods over 2us of wall time.
+  EXPECT_NE(std::string::npos, dump.find("Pass summary: 2 methods")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("1000000.0 methods/s")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("Pass builder: 2 runs")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("Pass inliner: 1 runs")) << dump;
+  EXPECT_NE(std::string::npos, dump.find("Pass register: 1 runs")) << dump;
+  // Passes are sorted by their total time: builder (800ns), inliner (600ns), register (200ns).
+  size_t builder = dump.find("Pass builder");
+  size_t inliner = dump.find("Pass inliner");
+  size_t reg = dump.find("Pass register");
+  EXPECT_LT(builder, inliner);
+  EXPECT_LT(inliner, reg);
+  EXPECT_NE(std::string::npos, dump.find("max 8192B")) << dump;
+}
+
+}  // namespace art
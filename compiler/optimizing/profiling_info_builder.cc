@@ -20,6 +20,7 @@
 #include "code_generator.h"
 #include "driver/compiler_options.h"
 #include "dex/code_item_accessors-inl.h"
+#include "dex/dex_instruction-inl.h"
 #include "inliner.h"
 #include "jit/profiling_info.h"
 #include "optimizing_compiler_stats.h"
@@ -99,6 +100,20 @@ void ProfilingInfoBuilder::VisitInvokeVirtual(HInvokeVirtual* invoke) {
   HandleInvoke(invoke);
 }
 
+void ProfilingInfoBuilder::HandleTypeCheck(HTypeCheckInstruction* check) {
+  if (IsInlineCacheUseful(check, codegen_)) {
+    inline_caches_.push_back(check->GetDexPc());
+  }
+}
+
+void ProfilingInfoBuilder::VisitInstanceOf(HInstanceOf* instance_of) {
+  HandleTypeCheck(instance_of);
+}
+
+void ProfilingInfoBuilder::VisitCheckCast(HCheckCast* check_cast) {
+  HandleTypeCheck(check_cast);
+}
+
 bool ProfilingInfoBuilder::IsInlineCacheUseful(HInvoke* invoke, CodeGenerator* codegen) {
   DCHECK(invoke->IsInvokeVirtual() || invoke->IsInvokeInterface());
   if (codegen->IsImplementedIntrinsic(invoke)) {
@@ -129,6 +144,66 @@ bool ProfilingInfoBuilder::IsInlineCacheUseful(HInvoke* invoke, CodeGenerator* c
   return true;
 }
 
+// Unlike invokes, `HInstanceOf` has no environment telling whether it comes from an inlined
+// method, so only profile type checks matching the instruction of the compiled method at
+// their dex pc.
+static bool IsOuterMethodTypeCheck(HTypeCheckInstruction* check)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  ArtMethod* method = check->GetBlock()->GetGraph()->GetArtMethod();
+  uint32_t dex_pc = check->GetDexPc();
+  if (!InlineCache::IsTypeCheckDexPc(method, dex_pc)) {
+    return false;
+  }
+  HLoadClass* load_class = check->GetTargetClass();
+  if (!IsSameDexFile(load_class->GetDexFile(), *method->GetDexFile())) {
+    return false;
+  }
+  const Instruction& instruction = method->DexInstructions().InstructionAt(dex_pc);
+  bool is_instance_of = instruction.Opcode() == Instruction::INSTANCE_OF;
+  dex::TypeIndex type_index(is_instance_of ? instruction.VRegC_22c() : instruction.VRegB_21c());
+  return is_instance_of == check->IsInstanceOf() && type_index == load_class->GetTypeIndex();
+}
+
+bool ProfilingInfoBuilder::IsInlineCacheUseful(HTypeCheckInstruction* check,
+                                               CodeGenerator* codegen) {
+  DCHECK(check->IsInstanceOf() || check->IsCheckCast());
+  // Only these backends emit the inline cache update for type checks.
+  if (codegen->GetInstructionSet() != InstructionSet::kArm64 &&
+      codegen->GetInstructionSet() != InstructionSet::kX86_64) {
+    return false;
+  }
+  switch (check->GetTypeCheckKind()) {
+    case TypeCheckKind::kAbstractClassCheck:
+    case TypeCheckKind::kClassHierarchyCheck:
+    case TypeCheckKind::kArrayObjectCheck:
+    case TypeCheckKind::kInterfaceCheck:
+      break;
+    default:
+      // Exact, array and bitstring checks are already fast, and unresolved
+      // checks have no target class to speculate against.
+      return false;
+  }
+  if (!check->GetBlock()->GetGraph()->IsCompilingBaseline()) {
+    return false;
+  }
+  if (Runtime::Current()->IsAotCompiler()) {
+    return false;
+  }
+  if (check->InputAt(0)->GetReferenceTypeInfo().IsExact()) {
+    return false;
+  }
+  if (!codegen->GetGraph()->IsUsefulOptimizing()) {
+    return false;
+  }
+  ScopedObjectAccess soa(Thread::Current());
+  return IsOuterMethodTypeCheck(check);
+}
+
+InlineCache* ProfilingInfoBuilder::GetInlineCache(ProfilingInfo* info,
+                                                  HTypeCheckInstruction* check) {
+  return info->GetInlineCache(check->GetDexPc());
+}
+
 InlineCache* ProfilingInfoBuilder::GetInlineCache(ProfilingInfo* info,
                                                   const CompilerOptions& compiler_options,
                                                   HInvoke* instruction) {
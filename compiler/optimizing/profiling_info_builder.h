@@ -47,6 +47,11 @@ class ProfilingInfoBuilder final : public HGraphDelegateVisitor {
                                      const CompilerOptions& compiler_options,
                                      HInvoke* invoke);
   static bool IsInlineCacheUseful(HInvoke* invoke, CodeGenerator* codegen);
+
+  // Type checks are profiled like invokes, with the class of the object being checked
+  // recorded in an `InlineCache` at the dex pc of the type check.
+  static InlineCache* GetInlineCache(ProfilingInfo* info, HTypeCheckInstruction* check);
+  static bool IsInlineCacheUseful(HTypeCheckInstruction* check, CodeGenerator* codegen);
   static uint32_t EncodeInlinedDexPc(
       const HInliner* inliner, const CompilerOptions& compiler_options, HInvoke* invoke)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -54,8 +59,11 @@ class ProfilingInfoBuilder final : public HGraphDelegateVisitor {
  private:
   void VisitInvokeVirtual(HInvokeVirtual* invoke) override;
   void VisitInvokeInterface(HInvokeInterface* invoke) override;
+  void VisitInstanceOf(HInstanceOf* instance_of) override;
+  void VisitCheckCast(HCheckCast* check_cast) override;
 
   void HandleInvoke(HInvoke* invoke);
+  void HandleTypeCheck(HTypeCheckInstruction* check);
 
   CodeGenerator* codegen_;
   const CompilerOptions& compiler_options_;
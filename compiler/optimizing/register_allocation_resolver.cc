@@ -19,6 +19,7 @@
 #include "base/bit_vector-inl.h"
 #include "code_generator.h"
 #include "linear_order.h"
+#include "optimizing_compiler_stats.h"
 #include "ssa_liveness_analysis.h"
 
 namespace art HIDDEN {
@@ -505,11 +506,28 @@ static bool IsValidDestination(Location destination) {
       || destination.IsSIMDStackSlot();
 }
 
+static bool IsStackSlotKind(Location location) {
+  return location.IsStackSlot() || location.IsDoubleStackSlot() || location.IsSIMDStackSlot();
+}
+
 void RegisterAllocationResolver::AddMove(HParallelMove* move,
                                          Location source,
                                          Location destination,
                                          HInstruction* instruction,
                                          DataType::Type type) const {
+  // Record the memory traffic the allocation caused, moves inside loops being the costly ones.
+  bool is_spill = (source.IsRegisterKind() && IsStackSlotKind(destination));
+  bool is_reload = (IsStackSlotKind(source) && destination.IsRegisterKind());
+  if (is_spill || is_reload) {
+    OptimizingCompilerStats* stats = codegen_->GetCompilerStats();
+    MaybeRecordStat(stats,
+                    is_spill ? MethodCompilationStat::kRegisterSpilled
+                             : MethodCompilationStat::kRegisterReloaded);
+    if (move->GetBlock()->IsInLoop()) {
+      MaybeRecordStat(stats, MethodCompilationStat::kRegisterSpilledOrReloadedInLoop);
+    }
+  }
+
   if (type == DataType::Type::kInt64
       && codegen_->ShouldSplitLongMoves()
       // The parallel move resolver knows how to deal with long constants.
@@ -471,6 +471,8 @@ SchedulingNode* CriticalPathSchedulingNodeSelector::SelectMaterializedCondition(
     condition = instruction->AsIf()->InputAt(0)->AsConditionOrNull();
   } else if (instruction->IsSelect()) {
     condition = instruction->AsSelect()->GetCondition()->AsConditionOrNull();
+  } else if (instruction->IsDeoptimize()) {
+    condition = instruction->AsDeoptimize()->InputAt(0)->AsConditionOrNull();
   }
 
   SchedulingNode* condition_node = (condition != nullptr) ? graph.GetNode(condition) : nullptr;
@@ -692,7 +694,7 @@ bool HScheduler::IsSchedulable(const HInstruction* instruction) const {
   //    All unresolved field access instructions
   //    All volatile field access instructions, e.g. HInstanceFieldGet
   // TODO: Some of the instructions above may be safe to schedule (maybe as
-  // scheduling barriers).
+  // scheduling barriers, see HSchedulerARM64::IsSchedulableAsBarrier).
   return instruction->IsArrayGet() ||
          instruction->IsArraySet() ||
          instruction->IsArrayLength() ||
@@ -468,10 +468,27 @@ bool HSchedulerARM64::IsSchedulable(const HInstruction* instruction) const {
 #undef SCHEDULABLE_CASE
 
     default:
-      return HScheduler::IsSchedulable(instruction);
+      return HScheduler::IsSchedulable(instruction) || IsSchedulableAsBarrier(instruction);
   }
 }
 
+bool HSchedulerARM64::IsSchedulableAsBarrier(const HInstruction* instr) {
+  // Instructions related to exception delivery (e.g. HLoadException, HTryBoundary) are not
+  // listed, blocks with try-catch information are not scheduled anyway.
+  return instr->IsClinitCheck() ||
+         instr->IsDeoptimize() ||
+         instr->IsLoadClass() ||
+         instr->IsMemoryBarrier() ||
+         instr->IsMonitorOperation() ||
+         instr->IsNop() ||
+         (instr->IsInstanceFieldSet() && instr->AsInstanceFieldSet()->IsVolatile()) ||
+         (instr->IsStaticFieldSet() && instr->AsStaticFieldSet()->IsVolatile()) ||
+         instr->IsUnresolvedInstanceFieldGet() ||
+         instr->IsUnresolvedInstanceFieldSet() ||
+         instr->IsUnresolvedStaticFieldGet() ||
+         instr->IsUnresolvedStaticFieldSet();
+}
+
 std::pair<SchedulingGraph, ScopedArenaVector<SchedulingNode*>>
 HSchedulerARM64::BuildSchedulingGraph(
     HBasicBlock* block,
@@ -39,6 +39,7 @@ class HSchedulerARM64 : public HScheduler {
   // TODO: remove this when a proper support of SIMD registers is introduced to the compiler.
   bool IsSchedulingBarrier(const HInstruction* instr) const override {
     return HScheduler::IsSchedulingBarrier(instr) ||
+           IsSchedulableAsBarrier(instr) ||
            instr->IsVecReduce() ||
            instr->IsVecExtractScalar() ||
            instr->IsVecSetScalars() ||
@@ -52,6 +53,11 @@ class HSchedulerARM64 : public HScheduler {
       const HeapLocationCollector* heap_location_collector) override;
 
  private:
+  // Instructions that the generic scheduler does not know how to reorder but which are safe to
+  // leave in place as scheduling barriers. This lets the scheduler work on the other instructions
+  // of their block instead of skipping the whole block.
+  static bool IsSchedulableAsBarrier(const HInstruction* instr);
+
   DISALLOW_COPY_AND_ASSIGN(HSchedulerARM64);
 };
 
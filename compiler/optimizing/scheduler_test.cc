@@ -285,6 +285,35 @@ class SchedulerTest : public CommonCompilerTest, public OptimizingUnitTestHelper
     scheduler->Schedule(graph_);
   }
 
+  void TestDependencyGraphWithMemoryBarrier(HScheduler* scheduler) {
+    HBasicBlock* entry = new (GetAllocator()) HBasicBlock(graph_);
+    HBasicBlock* block1 = new (GetAllocator()) HBasicBlock(graph_);
+    graph_->AddBlock(entry);
+    graph_->AddBlock(block1);
+    graph_->SetEntryBlock(entry);
+
+    HInstruction* i = MakeParam(DataType::Type::kInt32);
+    HInstruction* c1 = graph_->GetIntConstant(1);
+
+    HInstruction* add1 = MakeBinOp<HAdd>(block1, DataType::Type::kInt32, i, c1);
+    HInstruction* barrier = new (GetAllocator()) HMemoryBarrier(MemBarrierKind::kAnyAny);
+    block1->AddInstruction(barrier);
+    HInstruction* add2 = MakeBinOp<HAdd>(block1, DataType::Type::kInt32, i, c1);
+
+    ASSERT_TRUE(scheduler->IsSchedulingBarrier(barrier));
+
+    TestSchedulingGraph scheduling_graph(GetScopedAllocator());
+    for (HBackwardInstructionIterator it(block1->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      scheduling_graph.AddNode(instruction, scheduler->IsSchedulingBarrier(instruction));
+    }
+
+    // Instructions cannot move across the barrier in either direction.
+    ASSERT_TRUE(scheduling_graph.HasImmediateOtherDependency(barrier, add1));
+    ASSERT_TRUE(scheduling_graph.HasImmediateOtherDependency(add2, barrier));
+    ASSERT_FALSE(scheduling_graph.HasImmediateOtherDependency(add2, add1));
+  }
+
   class TestSchedulingGraph : public SchedulingGraph {
    public:
     explicit TestSchedulingGraph(ScopedArenaAllocator* allocator,
@@ -335,6 +364,12 @@ TEST_F(SchedulerTest, ArrayAccessAliasingARM64) {
   arm64::HSchedulerARM64 scheduler(&critical_path_selector);
   TestDependencyGraphOnAliasingArrayAccesses(&scheduler);
 }
+
+TEST_F(SchedulerTest, MemoryBarrierARM64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  arm64::HSchedulerARM64 scheduler(&critical_path_selector);
+  TestDependencyGraphWithMemoryBarrier(&scheduler);
+}
 #endif
 
 #if defined(ART_ENABLE_CODEGEN_arm)
@@ -87,6 +87,15 @@ class DedupeSet<InKey, StoreKey, Alloc, HashType, HashFunc, kShard>::Shard {
     return keys_.size();
   }
 
+  void Clear(Thread* self) REQUIRES(!lock_) {
+    MutexLock lock(self, lock_);
+    for (const HashedKey<StoreKey>& key : keys_) {
+      DCHECK(key.Key() != nullptr);
+      alloc_.Destroy(key.Key());
+    }
+    keys_.clear();
+  }
+
   void UpdateStats(Thread* self, Stats* global_stats) REQUIRES(!lock_) {
     // HashSet<> doesn't keep entries ordered by hash, so we actually allocate memory
     // for bookkeeping while collecting the stats.
@@ -248,6 +257,18 @@ size_t DedupeSet<InKey, StoreKey, Alloc, HashType, HashFunc, kShard>::Size(Threa
   return result;
 }
 
+template <typename InKey,
+          typename StoreKey,
+          typename Alloc,
+          typename HashType,
+          typename HashFunc,
+          HashType kShard>
+void DedupeSet<InKey, StoreKey, Alloc, HashType, HashFunc, kShard>::Clear(Thread* self) {
+  for (const auto& shard : shards_) {
+    shard->Clear(self);
+  }
+}
+
 template <typename InKey,
           typename StoreKey,
           typename Alloc,
@@ -47,6 +47,9 @@ class DedupeSet {
 
   size_t Size(Thread* self) const;
 
+  // Destroy all stored keys. Previously returned stored keys become invalid.
+  void Clear(Thread* self);
+
   std::string DumpStats(Thread* self) const;
 
  private:
@@ -89,4 +89,28 @@ TEST(DedupeSetTest, Test) {
   }
 }
 
+TEST(DedupeSetTest, Clear) {
+  Thread* self = Thread::Current();
+  DedupeSetTestAlloc alloc;
+  DedupeSet<ArrayRef<const uint8_t>,
+            std::vector<uint8_t>,
+            DedupeSetTestAlloc,
+            size_t,
+            DedupeSetTestHashFunc> deduplicator("test", alloc);
+  uint8_t raw_test1[] = { 10u, 20u, 30u, 45u };
+  uint8_t raw_test2[] = { 10u, 22u, 30u, 47u };
+  ASSERT_NE(deduplicator.Add(self, ArrayRef<const uint8_t>(raw_test1)), nullptr);
+  ASSERT_NE(deduplicator.Add(self, ArrayRef<const uint8_t>(raw_test2)), nullptr);
+  ASSERT_EQ(deduplicator.Size(self), 2u);
+
+  deduplicator.Clear(self);
+  ASSERT_EQ(deduplicator.Size(self), 0u);
+
+  // The set can be used again after clearing.
+  const std::vector<uint8_t>* array = deduplicator.Add(self, ArrayRef<const uint8_t>(raw_test1));
+  ASSERT_NE(array, nullptr);
+  ASSERT_TRUE(std::equal(std::begin(raw_test1), std::end(raw_test1), array->begin()));
+  ASSERT_EQ(deduplicator.Size(self), 1u);
+}
+
 }  // namespace art
@@ -40,6 +40,9 @@ static constexpr size_t kRiscv64HalfwordSize = 2;
 static constexpr size_t kRiscv64WordSize = 4;
 static constexpr size_t kRiscv64DoublewordSize = 8;
 static constexpr size_t kRiscv64FloatRegSizeInBytes = 8;
+// Size of the part of a vector register used by compiled code (VLEN >= 128 is required by
+// the RVA profiles that include the "V" extension).
+static constexpr size_t kRiscv64VectorRegSizeInBytes = 16;
 
 // The `Riscv64Extension` enumeration is used for restricting the instructions that the assembler
 // can use. Some restrictions are checked only in debug mode (for example load and store
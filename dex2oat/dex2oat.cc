@@ -18,7 +18,10 @@
 #include <log/log.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/wait.h>
 
 #include <algorithm>
 #include <forward_list>
@@ -39,6 +42,7 @@
 #endif  // __arm__
 #endif
 
+#include <android-base/file.h>
 #include <android-base/parseint.h>
 #include <android-base/properties.h>
 #include <android-base/scopeguard.h>
@@ -132,6 +136,46 @@ static constexpr size_t kDefaultMinDexFileCumulativeSizeForSwap = 20 * MB;
 // Compiler filter override for very large apps.
 static constexpr CompilerFilter::Filter kLargeAppFilter = CompilerFilter::kVerify;
 
+// Maximum number of compiler threads used when `--adapt-to-memory-pressure` is passed and the
+// system is under memory pressure.
+static constexpr size_t kMaxThreadsUnderMemoryPressure = 2;
+
+// Thresholds on the percentage of time, over the last 10 seconds, in which some or all tasks were
+// stalled on memory, as reported by the kernel's Pressure Stall Information.
+static constexpr double kHighMemoryPressureSomeAvg10 = 10.0;
+static constexpr double kCriticalMemoryPressureFullAvg10 = 5.0;
+
+enum class MemoryPressure {
+  kNone,
+  kHigh,
+  kCritical,
+};
+
+// Returns the current memory pressure, or `kNone` if the kernel does not support PSI.
+static MemoryPressure GetMemoryPressure() {
+  std::string content;
+  if (!android::base::ReadFileToString("/proc/pressure/memory", &content)) {
+    return MemoryPressure::kNone;
+  }
+  double some_avg10 = 0.0;
+  double full_avg10 = 0.0;
+  for (const std::string& line : android::base::Split(content, "\n")) {
+    double avg10;
+    if (sscanf(line.c_str(), "some avg10=%lf", &avg10) == 1) {
+      some_avg10 = avg10;
+    } else if (sscanf(line.c_str(), "full avg10=%lf", &avg10) == 1) {
+      full_avg10 = avg10;
+    }
+  }
+  if (full_avg10 >= kCriticalMemoryPressureFullAvg10) {
+    return MemoryPressure::kCritical;
+  }
+  if (some_avg10 >= kHighMemoryPressureSomeAvg10) {
+    return MemoryPressure::kHigh;
+  }
+  return MemoryPressure::kNone;
+}
+
 static int original_argc;
 static char** original_argv;
 
@@ -523,12 +567,14 @@ class Dex2Oat final {
         input_vdex_fd_(-1),
         output_vdex_fd_(-1),
         input_vdex_file_(nullptr),
+        partial_input_vdex_(false),
         dm_fd_(-1),
         zip_fd_(-1),
         image_fd_(-1),
         have_multi_image_arg_(false),
         image_base_(0U),
         image_storage_mode_(ImageHeader::kStorageModeUncompressed),
+        vdex_storage_mode_(ImageHeader::kStorageModeUncompressed),
         passes_to_run_filename_(nullptr),
         is_host_(false),
         elf_writers_(),
@@ -687,10 +733,23 @@ class Dex2Oat final {
       Usage("Can't have both --input-vdex-fd and --input-vdex");
     }
 
+    if (partial_input_vdex_ && input_vdex_fd_ == -1 && input_vdex_.empty() && dm_fd_ == -1 &&
+        dm_file_location_.empty()) {
+      Usage("--partial-input-vdex requires --input-vdex-fd, --input-vdex or a dex metadata file");
+    }
+
     if (output_vdex_fd_ != -1 && !output_vdex_.empty()) {
       Usage("Can't have both --output-vdex-fd and --output-vdex");
     }
 
+    // The image writer keeps using the dex files mapped from the vdex file.
+    if (vdex_storage_mode_ != ImageHeader::kStorageModeUncompressed &&
+        (!image_filenames_.empty() || image_fd_ != -1 ||
+         !app_image_file_name_.empty() || app_image_fd_ != -1)) {
+      Usage("--vdex-format cannot be used with --image, --image-fd, --app-image-file"
+            " or --app-image-fd");
+    }
+
     if (!oat_filenames_.empty() && oat_fd_ != -1) {
       Usage("--oat-file should not be used with --oat-fd");
     }
@@ -862,13 +921,13 @@ class Dex2Oat final {
     // Set the compilation target's implicit checks options.
     switch (compiler_options_->GetInstructionSet()) {
       case InstructionSet::kArm64:
+      case InstructionSet::kRiscv64:
+      case InstructionSet::kX86_64:
         compiler_options_->implicit_suspend_checks_ = true;
         FALLTHROUGH_INTENDED;
       case InstructionSet::kArm:
       case InstructionSet::kThumb2:
-      case InstructionSet::kRiscv64:
       case InstructionSet::kX86:
-      case InstructionSet::kX86_64:
         compiler_options_->implicit_null_checks_ = true;
         compiler_options_->implicit_so_checks_ = true;
         break;
@@ -1082,6 +1141,7 @@ class Dex2Oat final {
     AssignIfExists(args, M::InputVdexFd, &input_vdex_fd_);
     AssignIfExists(args, M::OutputVdexFd, &output_vdex_fd_);
     AssignIfExists(args, M::InputVdex, &input_vdex_);
+    AssignTrueIfExists(args, M::PartialInputVdex, &partial_input_vdex_);
     AssignIfExists(args, M::OutputVdex, &output_vdex_);
     AssignIfExists(args, M::DmFd, &dm_fd_);
     AssignIfExists(args, M::DmFile, &dm_file_location_);
@@ -1111,6 +1171,7 @@ class Dex2Oat final {
     AssignIfExists(args, M::DirtyImageObjects, &dirty_image_objects_filenames_);
     AssignIfExists(args, M::DirtyImageObjectsFd, &dirty_image_objects_fds_);
     AssignIfExists(args, M::ImageFormat, &image_storage_mode_);
+    AssignIfExists(args, M::VdexFormat, &vdex_storage_mode_);
     AssignIfExists(args, M::CompilationReason, &compilation_reason_);
     AssignTrueIfExists(args, M::CheckLinkageConditions, &check_linkage_conditions_);
     AssignTrueIfExists(args, M::CrashOnLinkageViolation, &crash_on_linkage_violation_);
@@ -1130,6 +1191,7 @@ class Dex2Oat final {
 
     AssignTrueIfExists(args, M::Host, &is_host_);
     AssignTrueIfExists(args, M::AvoidStoringInvocation, &avoid_storing_invocation_);
+    AssignTrueIfExists(args, M::AdaptToMemoryPressure, &adapt_to_memory_pressure_);
     if (args.Exists(M::InvocationFile)) {
       invocation_file_.reset(open(args.Get(M::InvocationFile)->c_str(),
                                   O_CREAT|O_WRONLY|O_TRUNC|O_CLOEXEC,
@@ -1279,7 +1341,9 @@ class Dex2Oat final {
         std::string vdex_filename = output_vdex_.empty()
             ? ReplaceFileExtension(oat_filename, "vdex")
             : output_vdex_;
-        if (vdex_filename == input_vdex_ && output_vdex_.empty()) {
+        // A compressed vdex file cannot be mapped directly, so write it again.
+        if (vdex_filename == input_vdex_ && output_vdex_.empty() &&
+            (input_vdex_file_ == nullptr || !input_vdex_file_->IsCompressed())) {
           use_existing_vdex_ = true;
           std::unique_ptr<File> vdex_file(OS::OpenFileForReading(vdex_filename.c_str()));
           vdex_files_.push_back(std::move(vdex_file));
@@ -1334,7 +1398,9 @@ class Dex2Oat final {
 
       DCHECK_NE(output_vdex_fd_, -1);
       std::string vdex_location = ReplaceFileExtension(oat_location_, "vdex");
-      if (input_vdex_file_ != nullptr && output_vdex_fd_ == input_vdex_fd_) {
+      if (input_vdex_file_ != nullptr &&
+          !input_vdex_file_->IsCompressed() &&
+          output_vdex_fd_ == input_vdex_fd_) {
         use_existing_vdex_ = true;
       }
 
@@ -1521,6 +1587,9 @@ class Dex2Oat final {
     //       store which is used for determining whether the oat file is up to date,
     //       together with the boot class path locations and checksums stored below.
     CompilerFilter::Filter original_compiler_filter = compiler_options_->GetCompilerFilter();
+    if (!IsBootImage() && !IsBootImageExtension() && adapt_to_memory_pressure_) {
+      AdaptToMemoryPressure();
+    }
     if (!IsBootImage() && !IsBootImageExtension() && IsVeryLarge(dex_files)) {
       // Disable app image to make sure dex2oat unloading is enabled.
       compiler_options_->image_type_ = CompilerOptions::ImageType::kNone;
@@ -1682,6 +1751,8 @@ class Dex2Oat final {
           class_loader_context_->EncodeContextForOatFile(classpath_dir_,
                                                          stored_class_loader_context_.get());
       key_value_store_->Put(OatHeader::kClassPathKey, class_path_key);
+      key_value_store_->Put(OatHeader::kClassPathHashKey,
+                            std::to_string(ClassLoaderContext::HashEncodedContext(class_path_key)));
     }
 
     if (IsBootImage() ||
@@ -1740,9 +1811,14 @@ class Dex2Oat final {
       TimingLogger::ScopedTiming t_dex("Parse Verifier Deps", timings_);
       std::unique_ptr<verifier::VerifierDeps> verifier_deps(
           new verifier::VerifierDeps(dex_files, /*output_only=*/ false));
-      if (!verifier_deps->ParseStoredData(dex_files, input_vdex_file_->GetVerifierDepsData())) {
+      if (!verifier_deps->ParseStoredData(dex_files,
+                                          input_vdex_file_->GetVerifierDepsData(),
+                                          input_vdex_dex_files_valid_)) {
         return dex2oat::ReturnCode::kOther;
       }
+      if (partial_input_vdex_ && input_vdex_file_->HasDexSection() && !use_existing_vdex_) {
+        ReuseVerifierDepsOfIdenticalClasses(verifier_deps.get(), dex_files);
+      }
       // We can do fast verification.
       callbacks_->SetVerifierDeps(verifier_deps.release());
     } else {
@@ -1754,6 +1830,34 @@ class Dex2Oat final {
     return dex2oat::ReturnCode::kNoFailure;
   }
 
+  // With a partial input vdex which contains the previous version of the dex files, reuse the
+  // verification data of the unchanged classes of the dex files which changed.
+  void ReuseVerifierDepsOfIdenticalClasses(verifier::VerifierDeps* verifier_deps,
+                                           const std::vector<const DexFile*>& dex_files) {
+    TimingLogger::ScopedTiming t("Reuse Verifier Deps", timings_);
+    std::vector<std::unique_ptr<const DexFile>> old_dex_files;
+    std::string error_msg;
+    if (!input_vdex_file_->OpenAllDexFiles(&old_dex_files, &error_msg)) {
+      LOG(WARNING) << "Failed to open the dex files of the input vdex: " << error_msg;
+      return;
+    }
+    DCHECK_EQ(old_dex_files.size(), dex_files.size());
+    std::vector<const DexFile*> old_dex_file_ptrs = MakeNonOwningPointerVector(old_dex_files);
+    verifier::VerifierDeps old_verifier_deps(old_dex_file_ptrs, /*output_only=*/ false);
+    if (!old_verifier_deps.ParseStoredData(old_dex_file_ptrs,
+                                           input_vdex_file_->GetVerifierDepsData())) {
+      return;
+    }
+    size_t num_reused = 0u;
+    for (size_t i = 0; i != dex_files.size(); ++i) {
+      if (!input_vdex_dex_files_valid_[i]) {
+        num_reused += verifier_deps->ReuseIdenticalClasses(
+            *dex_files[i], *old_dex_files[i], old_verifier_deps);
+      }
+    }
+    VLOG(compiler) << "Reused verifier dependencies of " << num_reused << " unchanged classes";
+  }
+
   // Validates that the input vdex checksums match the source dex checksums.
   // Note that this is only effective and relevant if the input_vdex_file does not
   // contain a dex section (e.g. when they come from .dm files).
@@ -1776,6 +1880,11 @@ class Dex2Oat final {
       uint32_t dex_source_checksum =
           compiler_options_->dex_files_for_oat_file_[i]->GetLocationChecksum();
       uint32_t vdex_checksum = input_vdex_file_->GetLocationChecksum(i);
+      if (partial_input_vdex_) {
+        // Only reuse the verification data of dex files which did not change.
+        input_vdex_dex_files_valid_.push_back(dex_source_checksum == vdex_checksum);
+        continue;
+      }
       if (dex_source_checksum != vdex_checksum) {
         LOG(ERROR) << "Vdex file checksum different than source dex checksum for position " << i
           << std::hex
@@ -2085,7 +2194,8 @@ class Dex2Oat final {
                                                   oat_filenames_,
                                                   dex_file_oat_index_map_,
                                                   class_loader,
-                                                  dirty_image_objects_.get()));
+                                                  dirty_image_objects_.get(),
+                                                  thread_count_));
 
       // We need to prepare method offsets in the image address space for resolving linker patches.
       TimingLogger::ScopedTiming t2("dex2oat Prepare image address space", timings_);
@@ -2153,7 +2263,8 @@ class Dex2Oat final {
         // We need to mirror the layout of the ELF file in the compressed debug-info.
         // Therefore PrepareDebugInfo() relies on the SetLoadedSectionSizes() call further above.
         debug::DebugInfo debug_info = oat_writer->GetDebugInfo();  // Keep the variable alive.
-        elf_writer->PrepareDebugInfo(debug_info);  // Processes the data on background thread.
+        // Processes the data on background threads.
+        elf_writer->PrepareDebugInfo(debug_info, thread_count_);
 
         OutputStream* rodata = rodata_[i];
         DCHECK(rodata != nullptr);
@@ -2212,6 +2323,26 @@ class Dex2Oat final {
       }
     }
 
+    if (vdex_storage_mode_ != ImageHeader::kStorageModeUncompressed && !use_existing_vdex_) {
+      // Note: The dex files are mapped from the vdex files and must not be used after this.
+      TimingLogger::ScopedTiming t2("dex2oat Compress VDEX", timings_);
+      DCHECK(!IsImage());
+      for (std::unique_ptr<File>& vdex_file : vdex_files_) {
+        std::string error_msg;
+        if (!VdexFile::Compress(vdex_file.get(), vdex_storage_mode_, &error_msg)) {
+          LOG(ERROR) << "Failed to compress VDEX file: " << error_msg;
+          return false;
+        }
+      }
+    }
+
+    if (IsImage()) {
+      // The compiled code is in the oat files now. Free it before the image writer
+      // allocates the image buffers to reduce the peak memory usage.
+      TimingLogger::ScopedTiming t2("dex2oat Free compiled methods", timings_);
+      driver_->FreeCompiledMethods();
+    }
+
     return true;
   }
 
@@ -2315,6 +2446,14 @@ class Dex2Oat final {
     if (compiler_options_->GetDumpTimings() ||
         (kIsDebugBuild && timings_->GetTotalNs() > MsToNs(1000))) {
       LOG(INFO) << Dumpable<TimingLogger>(*timings_);
+      struct rusage usage;
+      if (compiler_options_->GetDumpTimings() && getrusage(RUSAGE_SELF, &usage) == 0) {
+        // `ru_maxrss` is in kilobytes.
+        LOG(INFO) << "dex2oat peak RSS: " << PrettySize(static_cast<size_t>(usage.ru_maxrss) * KB);
+      }
+      if (compiler_options_->GetDumpTimings() && driver_ != nullptr) {
+        LOG(INFO) << "dex2oat thread utilization: " << driver_->GetCompileThreadUtilization();
+      }
     }
   }
 
@@ -2507,6 +2646,10 @@ class Dex2Oat final {
       // Don't use swap, we know generation should succeed, and we don't want to slow it down.
       return false;
     }
+    if (force_swap_) {
+      // Memory is scarce, trade compilation speed for a lower peak memory use.
+      return true;
+    }
     if (dex_files.size() < min_dex_files_for_swap_) {
       // If there are less dex files than the threshold, assume it's gonna be fine.
       return false;
@@ -2518,6 +2661,32 @@ class Dex2Oat final {
     return dex_files_size >= min_dex_file_cumulative_size_for_swap_;
   }
 
+  // Reduces the memory used by the compilation if the system is under memory pressure. This only
+  // changes how the output is produced, except under critical pressure, where the threshold for
+  // very large apps is lowered so that more apps get downgraded to `kLargeAppFilter`.
+  void AdaptToMemoryPressure() {
+    MemoryPressure pressure = GetMemoryPressure();
+    if (pressure == MemoryPressure::kNone) {
+      return;
+    }
+    const char* pressure_name = pressure == MemoryPressure::kCritical ? "critical" : "high";
+    if (thread_count_ > kMaxThreadsUnderMemoryPressure) {
+      LOG(INFO) << "Memory pressure is " << pressure_name << ", reducing threads from "
+                << thread_count_ << " to " << kMaxThreadsUnderMemoryPressure << ".";
+      thread_count_ = kMaxThreadsUnderMemoryPressure;
+    }
+    if (swap_fd_ != -1) {
+      LOG(INFO) << "Memory pressure is " << pressure_name << ", forcing the use of swap.";
+      force_swap_ = true;
+    }
+    if (pressure == MemoryPressure::kCritical &&
+        very_large_threshold_ != std::numeric_limits<size_t>::max()) {
+      LOG(INFO) << "Memory pressure is " << pressure_name << ", halving the very large app "
+                << "threshold from " << very_large_threshold_ << ".";
+      very_large_threshold_ /= 2;
+    }
+  }
+
   bool IsVeryLarge(const std::vector<const DexFile*>& dex_files) {
     size_t dex_files_size = 0;
     for (const auto* dex_file : dex_files) {
@@ -2591,7 +2760,11 @@ class Dex2Oat final {
 
   bool AddDexFileSources() {
     TimingLogger::ScopedTiming t2("AddDexFileSources", timings_);
-    if (input_vdex_file_ != nullptr && input_vdex_file_->HasDexSection()) {
+    // With a partial input vdex, the dex files may have changed and are not taken from
+    // the vdex unless we keep the existing vdex.
+    if (input_vdex_file_ != nullptr &&
+        input_vdex_file_->HasDexSection() &&
+        (!partial_input_vdex_ || use_existing_vdex_)) {
       DCHECK_EQ(oat_writers_.size(), 1u);
       const std::string& name = zip_location_.empty() ? dex_locations_[0] : zip_location_;
       DCHECK(!name.empty());
@@ -2932,6 +3105,9 @@ class Dex2Oat final {
   std::string input_vdex_;
   std::string output_vdex_;
   std::unique_ptr<VdexFile> input_vdex_file_;
+  bool partial_input_vdex_;
+  // Whether the verification data of each dex file in the input vdex can be used.
+  std::vector<bool> input_vdex_dex_files_valid_;
   int dm_fd_;
   std::string dm_file_location_;
   std::unique_ptr<ZipArchive> dm_file_;
@@ -2947,6 +3123,7 @@ class Dex2Oat final {
   bool have_multi_image_arg_;
   uintptr_t image_base_;
   ImageHeader::StorageMode image_storage_mode_;
+  ImageHeader::StorageMode vdex_storage_mode_;
   const char* passes_to_run_filename_;
   std::vector<std::string> dirty_image_objects_filenames_;
   std::vector<int> dirty_image_objects_fds_;
@@ -2974,6 +3151,8 @@ class Dex2Oat final {
   size_t min_dex_files_for_swap_ = kDefaultMinDexFilesForSwap;
   size_t min_dex_file_cumulative_size_for_swap_ = kDefaultMinDexFileCumulativeSizeForSwap;
   size_t very_large_threshold_ = std::numeric_limits<size_t>::max();
+  bool adapt_to_memory_pressure_ = false;
+  bool force_swap_ = false;
   std::string app_image_file_name_;
   int app_image_fd_;
   std::vector<std::string> profile_files_;
@@ -3200,9 +3379,123 @@ static dex2oat::ReturnCode Dex2oat(int argc, char** argv) {
 
   return result;
 }
+
+// Server mode, used to run many compilations without paying the process startup each time:
+//
+//   dex2oat --server-fd=<fd> [--server-preload=<file>[:<file>...]]
+//
+// The preloaded files, typically the boot image and boot class path files, are mapped for
+// the lifetime of the server so that they stay in the page cache for all compilations.
+// Each request read from the connected socket `fd` is a `uint32_t` size followed by that
+// many bytes of NUL-terminated dex2oat arguments. Each compilation runs in a forked child,
+// so that no state leaks from one compilation to the next, and the server replies with the
+// `int32_t` exit code of the child. The server exits when the socket is closed.
+static constexpr std::string_view kServerFdOption = "--server-fd=";
+static constexpr std::string_view kServerPreloadOption = "--server-preload=";
+static constexpr uint32_t kMaxServerRequestSize = 1 * MB;
+
+static bool IsServerMode(int argc, char** argv) {
+  return argc > 1 && std::string_view(argv[1]).starts_with(kServerFdOption);
+}
+
+static void PreloadFile(const std::string& filename, /*inout*/ std::vector<MemMap>* maps) {
+  std::unique_ptr<File> file(OS::OpenFileForReading(filename.c_str()));
+  int64_t length = (file != nullptr) ? file->GetLength() : -1;
+  if (length <= 0) {
+    LOG(WARNING) << "Cannot preload " << filename;
+    return;
+  }
+  std::string error_msg;
+  MemMap map = MemMap::MapFile(static_cast<size_t>(length),
+                               PROT_READ,
+                               MAP_SHARED,
+                               file->Fd(),
+                               /*start=*/ 0,
+                               /*low_4gb=*/ false,
+                               filename.c_str(),
+                               &error_msg);
+  if (!map.IsValid()) {
+    LOG(WARNING) << "Cannot preload " << filename << ": " << error_msg;
+    return;
+  }
+  madvise(map.Begin(), map.Size(), MADV_WILLNEED);
+  maps->push_back(std::move(map));
+}
+
+static int Dex2oatServer(int argc, char** argv) {
+  // Logging is initialized by each compilation with its own command line.
+  MemMap::Init();
+  int server_fd = -1;
+  std::vector<MemMap> preloaded_files;
+  for (int i = 1; i != argc; ++i) {
+    std::string_view arg(argv[i]);
+    if (arg.starts_with(kServerFdOption)) {
+      std::string value(arg.substr(kServerFdOption.size()));
+      if (!android::base::ParseInt(value, &server_fd, 0)) {
+        LOG(ERROR) << "Invalid server fd: " << value;
+        return EXIT_FAILURE;
+      }
+    } else if (arg.starts_with(kServerPreloadOption)) {
+      for (const std::string& filename :
+           android::base::Split(std::string(arg.substr(kServerPreloadOption.size())), ":")) {
+        PreloadFile(filename, &preloaded_files);
+      }
+    } else {
+      LOG(ERROR) << "Unexpected server argument: " << arg;
+      return EXIT_FAILURE;
+    }
+  }
+
+  while (true) {
+    uint32_t size;
+    if (!android::base::ReadFully(server_fd, &size, sizeof(size))) {
+      return EXIT_SUCCESS;  // The client closed the socket.
+    }
+    std::vector<char> request(size);
+    if (size == 0u ||
+        size > kMaxServerRequestSize ||
+        !android::base::ReadFully(server_fd, request.data(), size) ||
+        request.back() != '\0') {
+      LOG(ERROR) << "Invalid dex2oat server request";
+      return EXIT_FAILURE;
+    }
+    std::vector<char*> job_argv(1u, argv[0]);
+    for (char* arg = request.data(); arg != request.data() + size; arg += strlen(arg) + 1u) {
+      job_argv.push_back(arg);
+    }
+    int job_argc = static_cast<int>(job_argv.size());
+    job_argv.push_back(nullptr);
+
+    int32_t exit_code = static_cast<int32_t>(dex2oat::ReturnCode::kOther);
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(server_fd);
+      FastExit(static_cast<int>(Dex2oat(job_argc, job_argv.data())));
+    } else if (pid == -1) {
+      PLOG(ERROR) << "Failed to fork dex2oat compilation";
+    } else {
+      int status;
+      if (TEMP_FAILURE_RETRY(waitpid(pid, &status, 0)) != pid) {
+        PLOG(ERROR) << "Failed to wait for dex2oat compilation";
+      } else if (WIFEXITED(status)) {
+        exit_code = WEXITSTATUS(status);
+      } else if (WIFSIGNALED(status)) {
+        LOG(ERROR) << "dex2oat compilation killed by signal " << WTERMSIG(status);
+        exit_code = 128 + WTERMSIG(status);
+      }
+    }
+    if (!android::base::WriteFully(server_fd, &exit_code, sizeof(exit_code))) {
+      PLOG(ERROR) << "Failed to reply to dex2oat server request";
+      return EXIT_FAILURE;
+    }
+  }
+}
 }  // namespace art
 
 int main(int argc, char** argv) {
+  if (art::IsServerMode(argc, argv)) {
+    return art::Dex2oatServer(argc, argv);
+  }
   int result = static_cast<int>(art::Dex2oat(argc, argv));
   // Everything was done, do an explicit exit here to avoid running Runtime destructors that take
   // time (bug 10645725) unless we're a debug or instrumented build or running on a memory tool.
@@ -117,6 +117,11 @@ static void AddGeneratedArtifactMappings(Builder& builder) {
           .WithType<std::string>()
           .WithHelp("specifies the vdex input source via a filename.")
           .IntoKey(M::InputVdex)
+      .Define("--partial-input-vdex")
+          .WithHelp("allow dex files to differ from the input vdex. The verification data is\n"
+                    "reused for the unchanged dex files and the other ones are verified again.\n"
+                    "Not supported with an input vdex which contains the dex files.")
+          .IntoKey(M::PartialInputVdex)
       .Define("--output-vdex-fd=_")
           .WithHelp("specifies the vdex output destination via a file descriptor.")
           .WithType<int>()
@@ -218,7 +223,16 @@ static void AddImageMappings(Builder& builder) {
                          {"uncompressed", ImageHeader::kStorageModeUncompressed}})
           .WithHelp("Which format to store the image Defaults to uncompressed. Eg:"
                     " --image-format=lz4")
-          .IntoKey(M::ImageFormat);
+          .IntoKey(M::ImageFormat)
+      .Define("--vdex-format=_")
+          .WithType<ImageHeader::StorageMode>()
+          .WithValueMap({{"lz4", ImageHeader::kStorageModeLZ4},
+                         {"lz4hc", ImageHeader::kStorageModeLZ4HC},
+                         {"uncompressed", ImageHeader::kStorageModeUncompressed}})
+          .WithHelp("Which format to store the vdex file in. Compressed vdex files take less"
+                    " storage but are decompressed to memory when loaded. Not supported when"
+                    " writing images. Defaults to uncompressed. Eg: --vdex-format=lz4")
+          .IntoKey(M::VdexFormat);
   // clang-format on
 }
 
@@ -351,6 +365,11 @@ Parser CreateDex2oatArgumentParser() {
           .WithHelp("Specifies the minimum total dex file size in bytes to consider the input\n"
                     "\"very large\" and reduce compilation done.")
           .IntoKey(M::VeryLargeAppThreshold)
+      .Define("--adapt-to-memory-pressure")
+          .WithHelp("Reduce the number of threads and use swap if the system is under\n"
+                    "memory pressure, as reported by /proc/pressure/memory. Under critical\n"
+                    "pressure, also halve the --very-large-app-threshold.")
+          .IntoKey(M::AdaptToMemoryPressure)
       .Define("--force-determinism")
           .WithHelp("Force the compiler to emit a deterministic output")
           .IntoKey(M::ForceDeterminism)
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <sys/socket.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -25,6 +26,7 @@
 #include <string>
 #include <vector>
 
+#include "android-base/file.h"
 #include "android-base/logging.h"
 #include "android-base/macros.h"
 #include "android-base/result-gmock.h"
@@ -2085,4 +2087,63 @@ TEST_F(Dex2oatTest, LoadOutOfDateOatFile) {
   }
 }
 
+TEST_F(Dex2oatTest, ServerMode) {
+  std::vector<std::string> argv;
+  std::string error_msg;
+  ASSERT_TRUE(StartDex2OatCommandLine(&argv, &error_msg)) << error_msg;
+  const char* android_root = getenv("ANDROID_ROOT");
+  ASSERT_NE(android_root, nullptr);
+  std::vector<std::string> common_args(argv.begin() + 1, argv.end());
+  if (!kIsTargetBuild) {
+    common_args.push_back("--host");
+  }
+  common_args.push_back("--android-root=" + std::string(android_root));
+  common_args.push_back("--compiler-filter=verify");
+
+  std::string dex_location = GetScratchDir() + "/Server.jar";
+  std::string odex_location = GetOdexDir() + "/Server.odex";
+  Copy(GetDexSrc1(), dex_location);
+  std::vector<std::vector<std::string>> jobs = {
+      {"--dex-file=" + dex_location, "--oat-file=" + odex_location},
+      {"--dex-file=" + GetScratchDir() + "/Missing.jar",
+       "--oat-file=" + GetOdexDir() + "/Missing.odex"},
+  };
+
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  android::base::unique_fd client_fd(fds[0]);
+  android::base::unique_fd server_fd(fds[1]);
+  // Queue all requests before starting the server, which exits once they are processed.
+  for (const std::vector<std::string>& job : jobs) {
+    std::string request;
+    for (const std::string& arg : common_args) {
+      request.append(arg).push_back('\0');
+    }
+    for (const std::string& arg : job) {
+      request.append(arg).push_back('\0');
+    }
+    uint32_t size = request.size();
+    ASSERT_TRUE(android::base::WriteFully(client_fd, &size, sizeof(size)));
+    ASSERT_TRUE(android::base::WriteFully(client_fd, request.data(), size));
+  }
+  ASSERT_EQ(shutdown(client_fd.get(), SHUT_WR), 0);
+
+  std::vector<std::string> server_argv = {
+      argv[0],
+      "--server-fd=" + std::to_string(server_fd.get()),
+      "--server-preload=" + dex_location,
+  };
+  ForkAndExecResult res = ForkAndExec(server_argv, []() { return true; }, &output_);
+  ASSERT_EQ(res.stage, ForkAndExecResult::kFinished) << output_;
+  ASSERT_TRUE(WIFEXITED(res.status_code)) << output_;
+  ASSERT_EQ(WEXITSTATUS(res.status_code), EXIT_SUCCESS) << output_;
+
+  int32_t exit_code;
+  ASSERT_TRUE(android::base::ReadFully(client_fd, &exit_code, sizeof(exit_code)));
+  EXPECT_EQ(exit_code, 0) << output_;
+  EXPECT_TRUE(OS::FileExists(odex_location.c_str()));
+  ASSERT_TRUE(android::base::ReadFully(client_fd, &exit_code, sizeof(exit_code)));
+  EXPECT_NE(exit_code, 0) << output_;
+}
+
 }  // namespace art
@@ -161,6 +161,16 @@ CompiledMethodStorage::~CompiledMethodStorage() {
   // All done by member destructors.
 }
 
+void CompiledMethodStorage::ReleaseDeduplicatedData() {
+  Thread* self = Thread::Current();
+  dedupe_code_.Clear(self);
+  dedupe_vmap_table_.Clear(self);
+  dedupe_cfi_info_.Clear(self);
+  dedupe_linker_patches_.Clear(self);
+  MutexLock lock(self, thunk_map_lock_);
+  thunk_map_.clear();
+}
+
 void CompiledMethodStorage::DumpMemoryUsage(std::ostream& os, bool extended) const {
   if (swap_space_.get() != nullptr) {
     const size_t swap_size = swap_space_->GetSize();
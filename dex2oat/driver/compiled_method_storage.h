@@ -42,6 +42,9 @@ class CompiledMethodStorage final : public CompiledCodeStorage {
 
   void DumpMemoryUsage(std::ostream& os, bool extended) const;
 
+  // Free all deduplicated arrays and thunks. All `CompiledMethod`s must have been released.
+  void ReleaseDeduplicatedData();
+
   void SetDedupeEnabled(bool dedupe_enabled) {
     dedupe_enabled_ = dedupe_enabled;
   }
@@ -22,6 +22,8 @@
 #include <malloc.h>  // For mallinfo
 #endif
 
+#include <algorithm>
+#include <numeric>
 #include <string_view>
 #include <vector>
 
@@ -73,6 +75,7 @@
 #include "mirror/object-refvisitor-inl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/throwable.h"
+#include "oat/jni_stub_hash_map-inl.h"
 #include "object_lock.h"
 #include "profile/profile_compilation_info.h"
 #include "runtime.h"
@@ -265,7 +268,11 @@ CompilerDriver::CompilerDriver(
       parallel_thread_count_(thread_count),
       stats_(new AOTCompilationStats),
       compiled_method_storage_(swap_fd),
-      max_arena_alloc_(0) {
+      jni_stubs_lock_("JNI stubs lock"),
+      jni_stubs_(JniStubKeyHash(compiler_options->GetInstructionSet()),
+                 JniStubKeyEquals(compiler_options->GetInstructionSet())),
+      max_arena_alloc_(0),
+      compile_wall_ns_(0u) {
   DCHECK(compiler_options_ != nullptr);
 
   compiled_method_storage_.SetDedupeEnabled(compiler_options_->DeduplicateCode());
@@ -279,6 +286,67 @@ CompilerDriver::~CompilerDriver() {
           CompiledMethod::ReleaseSwapAllocatedCompiledMethod(GetCompiledMethodStorage(), method);
         }
       });
+  for (const auto& entry : jni_stubs_) {
+    CompiledMethod::ReleaseSwapAllocatedCompiledMethod(GetCompiledMethodStorage(), entry.second);
+  }
+}
+
+void CompilerDriver::FreeCompiledMethods() {
+  compiled_methods_.Visit(
+      [this]([[maybe_unused]] const DexFileReference& ref, CompiledMethod* method) {
+        if (method != nullptr) {
+          CompiledMethod::ReleaseSwapAllocatedCompiledMethod(GetCompiledMethodStorage(), method);
+        }
+      });
+  compiled_methods_.ClearEntries();
+  {
+    MutexLock lock(Thread::Current(), jni_stubs_lock_);
+    for (const auto& entry : jni_stubs_) {
+      CompiledMethod::ReleaseSwapAllocatedCompiledMethod(GetCompiledMethodStorage(), entry.second);
+    }
+    jni_stubs_.clear();
+  }
+  compiled_method_storage_.ReleaseDeduplicatedData();
+}
+
+static CompiledMethod* CopyCompiledMethod(CompiledMethodStorage* storage,
+                                          const CompiledMethod* method) {
+  return storage->CreateCompiledMethod(method->GetInstructionSet(),
+                                       method->GetQuickCode(),
+                                       method->GetVmapTable(),
+                                       method->GetCFIInfo(),
+                                       method->GetPatches(),
+                                       method->IsIntrinsic());
+}
+
+CompiledMethod* CompilerDriver::CompileJniStub(uint32_t access_flags,
+                                               uint32_t method_idx,
+                                               const DexFile& dex_file,
+                                               Handle<mirror::DexCache> dex_cache) {
+  // Native methods in the boot image may be compiled as intrinsics.
+  if (GetCompilerOptions().IsBootImage()) {
+    return GetCompiler()->JniCompile(access_flags, method_idx, dex_file, dex_cache);
+  }
+  Thread* self = Thread::Current();
+  JniStubKey key(access_flags, dex_file.GetMethodShortyView(method_idx));
+  {
+    MutexLock lock(self, jni_stubs_lock_);
+    auto it = jni_stubs_.find(key);
+    if (it != jni_stubs_.end()) {
+      return CopyCompiledMethod(GetCompiledMethodStorage(), it->second);
+    }
+  }
+  CompiledMethod* compiled_method =
+      GetCompiler()->JniCompile(access_flags, method_idx, dex_file, dex_cache);
+  if (compiled_method != nullptr) {
+    MutexLock lock(self, jni_stubs_lock_);
+    // Another thread may have compiled the same stub meanwhile, keep the first one.
+    if (jni_stubs_.find(key) == jni_stubs_.end()) {
+      jni_stubs_.insert(
+          std::make_pair(key, CopyCompiledMethod(GetCompiledMethodStorage(), compiled_method)));
+    }
+  }
+  return compiled_method;
 }
 
 
@@ -492,6 +560,10 @@ static void CompileMethodQuick(
         // Query any JNI optimization annotations such as @FastNative or @CriticalNative.
         access_flags |= annotations::GetNativeMethodAnnotationAccessFlags(
             dex_file, dex_file.GetClassDef(class_def_idx), method_idx);
+        if ((access_flags & (kAccFastNative | kAccCriticalNative)) == 0u) {
+          // Methods allowlisted with `-XX:FastNativeAllowlist`, see `ClassLinker::LoadMethod()`.
+          access_flags |= Runtime::Current()->GetAllowlistedNativeAccessFlags(dex_file, method_idx);
+        }
         const void* boot_jni_stub = nullptr;
         if (!Runtime::Current()->GetHeap()->GetBootImageSpaces().empty()) {
           // Skip the compilation for native method if found an usable boot JNI stub.
@@ -501,7 +573,7 @@ static void CompileMethodQuick(
         }
         if (boot_jni_stub == nullptr) {
           compiled_method =
-              driver->GetCompiler()->JniCompile(access_flags, method_idx, dex_file, dex_cache);
+              driver->CompileJniStub(access_flags, method_idx, dex_file, dex_cache);
           CHECK(compiled_method != nullptr);
         }
       }
@@ -1580,16 +1652,27 @@ class ParallelCompilationManager {
     ForAllLambda(begin, end, [visitor](size_t index) { visitor->Visit(index); }, work_units);
   }
 
+  // Process the indexes in `[begin, end)` with `fn` in `work_units` tasks. The tasks pick the
+  // next index dynamically, so threads that finish early take over the remaining work. If
+  // `task_busy_ns` is not null, it receives the time each task spent processing indexes.
   template <typename Fn>
-  void ForAllLambda(size_t begin, size_t end, Fn fn, size_t work_units)
+  void ForAllLambda(size_t begin,
+                    size_t end,
+                    Fn fn,
+                    size_t work_units,
+                    /*out*/ std::vector<uint64_t>* task_busy_ns = nullptr)
       REQUIRES(!*Locks::mutator_lock_) {
     Thread* self = Thread::Current();
     self->AssertNoPendingException();
     CHECK_GT(work_units, 0U);
 
     index_.store(begin, std::memory_order_relaxed);
+    if (task_busy_ns != nullptr) {
+      task_busy_ns->assign(work_units, 0u);
+    }
     for (size_t i = 0; i < work_units; ++i) {
-      thread_pool_->AddTask(self, new ForAllClosureLambda<Fn>(this, end, fn));
+      uint64_t* busy_ns = (task_busy_ns != nullptr) ? &(*task_busy_ns)[i] : nullptr;
+      thread_pool_->AddTask(self, new ForAllClosureLambda<Fn>(this, end, fn, busy_ns));
     }
     thread_pool_->StartWorkers(self);
 
@@ -1612,12 +1695,14 @@ class ParallelCompilationManager {
   template <typename Fn>
   class ForAllClosureLambda : public Task {
    public:
-    ForAllClosureLambda(ParallelCompilationManager* manager, size_t end, Fn fn)
+    ForAllClosureLambda(ParallelCompilationManager* manager, size_t end, Fn fn, uint64_t* busy_ns)
         : manager_(manager),
           end_(end),
-          fn_(fn) {}
+          fn_(fn),
+          busy_ns_(busy_ns) {}
 
     void Run(Thread* self) override {
+      const uint64_t start_ns = (busy_ns_ != nullptr) ? NanoTime() : 0u;
       while (true) {
         const size_t index = manager_->NextIndex();
         if (UNLIKELY(index >= end_)) {
@@ -1626,6 +1711,9 @@ class ParallelCompilationManager {
         fn_(index);
         self->AssertNoPendingException();
       }
+      if (busy_ns_ != nullptr) {
+        *busy_ns_ = NanoTime() - start_ns;
+      }
     }
 
     void Finalize() override {
@@ -1636,6 +1724,7 @@ class ParallelCompilationManager {
     ParallelCompilationManager* const manager_;
     const size_t end_;
     Fn fn_;
+    uint64_t* const busy_ns_;
   };
 
   AtomicInteger index_;
@@ -1832,12 +1921,30 @@ static void LoadAndUpdateStatus(const ClassAccessor& accessor,
 }
 
 bool CompilerDriver::FastVerify(jobject jclass_loader,
-                                const std::vector<const DexFile*>& dex_files,
+                                const std::vector<const DexFile*>& all_dex_files,
+                                /*out*/ std::vector<const DexFile*>* unverified_dex_files,
                                 TimingLogger* timings) {
+  DCHECK(unverified_dex_files->empty());
   CompilerCallbacks* callbacks = Runtime::Current()->GetCompilerCallbacks();
   verifier::VerifierDeps* verifier_deps = callbacks->GetVerifierDeps();
   // If there exist VerifierDeps that aren't the ones we just created to output, use them to verify.
   if (verifier_deps == nullptr || verifier_deps->OutputOnly()) {
+    *unverified_dex_files = all_dex_files;
+    return false;
+  }
+  // With a partial input vdex, only some of the dex files have stored data. The others
+  // changed since the vdex was created and must be verified from scratch, except for the
+  // classes which were found identical in the previous version of the dex file.
+  std::vector<const DexFile*> dex_files;
+  for (const DexFile* dex_file : all_dex_files) {
+    if (verifier_deps->HasAnyStoredData(*dex_file)) {
+      dex_files.push_back(dex_file);
+    }
+    if (!verifier_deps->HasStoredData(*dex_file)) {
+      unverified_dex_files->push_back(dex_file);
+    }
+  }
+  if (dex_files.empty()) {
     return false;
   }
   TimingLogger::ScopedTiming t("Fast Verify", timings);
@@ -1869,6 +1976,9 @@ bool CompilerDriver::FastVerify(jobject jclass_loader,
     const std::vector<bool>& verified_classes = verifier_deps->GetVerifiedClasses(*dex_file);
     DCHECK_EQ(verified_classes.size(), dex_file->NumClassDefs());
     for (ClassAccessor accessor : dex_file->GetClasses()) {
+      if (!verifier_deps->HasStoredData(*dex_file, accessor.GetClassDefIndex())) {
+        continue;  // The class shall be verified by `VerifyClassVisitor`.
+      }
       ClassStatus status = verified_classes[accessor.GetClassDefIndex()]
           ? ClassStatus::kVerifiedNeedsAccessChecks
           : ClassStatus::kRetryVerificationAtRuntime;
@@ -1910,13 +2020,14 @@ bool CompilerDriver::FastVerify(jobject jclass_loader,
       }
     }
   }
-  return true;
+  return unverified_dex_files->empty();
 }
 
 void CompilerDriver::Verify(jobject jclass_loader,
-                            const std::vector<const DexFile*>& dex_files,
+                            const std::vector<const DexFile*>& all_dex_files,
                             TimingLogger* timings) {
-  if (FastVerify(jclass_loader, dex_files, timings)) {
+  std::vector<const DexFile*> dex_files;
+  if (FastVerify(jclass_loader, all_dex_files, &dex_files, timings)) {
     return;
   }
 
@@ -1976,6 +2087,13 @@ class VerifyClassVisitor : public CompilationVisitor {
     ScopedTrace trace(__FUNCTION__);
     ScopedObjectAccess soa(Thread::Current());
     const DexFile& dex_file = *manager_->GetDexFile();
+    verifier::VerifierDeps* main_verifier_deps =
+        Runtime::Current()->GetCompilerCallbacks()->GetVerifierDeps();
+    if (main_verifier_deps != nullptr &&
+        main_verifier_deps->HasStoredData(dex_file, class_def_index)) {
+      // Already handled by `CompilerDriver::FastVerify()`.
+      return;
+    }
     const dex::ClassDef& class_def = dex_file.GetClassDef(class_def_index);
     const char* descriptor = dex_file.GetClassDescriptor(class_def);
     ClassLinker* class_linker = manager_->GetClassLinker();
@@ -2140,6 +2258,13 @@ class SetVerifiedClassVisitor : public CompilationVisitor {
     ScopedTrace trace(__FUNCTION__);
     ScopedObjectAccess soa(Thread::Current());
     const DexFile& dex_file = *manager_->GetDexFile();
+    verifier::VerifierDeps* main_verifier_deps =
+        Runtime::Current()->GetCompilerCallbacks()->GetVerifierDeps();
+    if (main_verifier_deps != nullptr &&
+        main_verifier_deps->HasStoredData(dex_file, class_def_index)) {
+      // Already handled by `CompilerDriver::FastVerify()`.
+      return;
+    }
     const dex::ClassDef& class_def = dex_file.GetClassDef(class_def_index);
     const char* descriptor = dex_file.GetClassDescriptor(class_def);
     ClassLinker* class_linker = manager_->GetClassLinker();
@@ -2300,6 +2425,7 @@ class InitializeClassVisitor : public CompilationVisitor {
             // TODO(b/274077782): remove this test.
             (have_profile || !is_boot_image_extension)) {
           bool can_init_static_fields = false;
+          bool check_static_field_values = false;
           if (is_boot_image || is_boot_image_extension) {
             // We need to initialize static fields, we only do this for image classes that aren't
             // marked with the $NoPreloadHolder (which implies this should not be initialized
@@ -2312,12 +2438,22 @@ class InitializeClassVisitor : public CompilationVisitor {
             // Optimization will be disabled in debuggable build, because in debuggable mode we
             // want the <clinit> behavior to be observable for the debugger, so we don't do the
             // <clinit> at compile time.
-            can_init_static_fields =
-                ClassLinker::kAppImageMayContainStrings &&
+            if (ClassLinker::kAppImageMayContainStrings &&
                 !self->IsExceptionPending() &&
-                !compiler_options.GetDebuggable() &&
-                (compiler_options.InitializeAppImageClasses() ||
-                 NoClinitInDependency(klass, self, &class_loader));
+                !compiler_options.GetDebuggable()) {
+              if (compiler_options.InitializeAppImageClasses() ||
+                  NoClinitInDependency(klass, self, &class_loader)) {
+                can_init_static_fields = true;
+              } else if (compiler_options.InitializeAppImageStartupClasses() &&
+                         HasStartupStaticMethod(klass)) {
+                // Run the <clinit> of classes used during startup, so that compiled code can
+                // skip their initialization checks. We only keep the result if the static
+                // fields do not reference objects that would make the image writer prune
+                // the class, see `HasImageSafeStaticFields()`.
+                can_init_static_fields = true;
+                check_static_field_values = true;
+              }
+            }
             // TODO The checking for clinit can be removed since it's already
             // checked when init superclass. Currently keep it because it contains
             // processing of intern strings. Will be removed later when intern strings
@@ -2352,7 +2488,13 @@ class InitializeClassVisitor : public CompilationVisitor {
             {
               ScopedAssertNoThreadSuspension ants("Transaction end");
 
-              if (success) {
+              if (success && check_static_field_values && !HasImageSafeStaticFields(klass)) {
+                VLOG(compiler) << "Initialization of " << descriptor << " rolled back because"
+                               << " of static field values not allowed in the app image";
+                class_linker->RollbackAllTransactions();
+                CHECK_EQ(old_status, klass->GetStatus()) << "Previous class status not restored";
+                success = false;
+              } else if (success) {
                 class_linker->ExitTransactionMode();
                 DCHECK(!runtime->IsActiveTransaction());
 
@@ -2613,6 +2755,55 @@ class InitializeClassVisitor : public CompilationVisitor {
     return true;
   }
 
+  // Returns whether the profile marks a static method or a constructor of `klass` as a startup
+  // method. Such methods are likely to trigger the class initialization during startup.
+  bool HasStartupStaticMethod(Handle<mirror::Class> klass) REQUIRES_SHARED(Locks::mutator_lock_) {
+    const ProfileCompilationInfo* profile =
+        manager_->GetCompiler()->GetCompilerOptions().GetProfileCompilationInfo();
+    if (profile == nullptr) {
+      return false;
+    }
+    const DexFile& dex_file = klass->GetDexFile();
+    ProfileCompilationInfo::ProfileIndexType profile_index = profile->FindDexFile(dex_file);
+    if (profile_index == ProfileCompilationInfo::MaxProfileIndex()) {
+      return false;
+    }
+    PointerSize pointer_size = manager_->GetClassLinker()->GetImagePointerSize();
+    for (ArtMethod& method : klass->GetDirectMethods(pointer_size)) {
+      if ((method.IsStatic() || method.IsConstructor()) &&
+          !method.IsClassInitializer() &&
+          profile->IsStartupMethod(profile_index, method.GetDexMethodIndex())) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns whether the static reference fields of the initialized `klass` hold only values
+  // that cannot cause the image writer to prune the class: null, boot image objects, strings,
+  // primitive arrays or the class itself.
+  bool HasImageSafeStaticFields(Handle<mirror::Class> klass)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    for (ArtField& field : klass->GetSFields()) {
+      if (field.IsPrimitiveType()) {
+        continue;
+      }
+      ObjPtr<mirror::Object> value = field.GetObject(klass.Get());
+      if (value == nullptr ||
+          value == klass.Get() ||
+          heap->ObjectIsInBootImageSpace(value) ||
+          value->IsString() ||
+          value->GetClass()->IsPrimitiveArray()) {
+        continue;
+      }
+      VLOG(compiler) << klass->PrettyDescriptor() << ": static field " << field.PrettyField()
+                     << " references " << value->GetClass()->PrettyDescriptor();
+      return false;
+    }
+    return true;
+  }
+
   const ParallelCompilationManager* const manager_;
 };
 
@@ -2668,7 +2859,8 @@ static void CompileDexFile(CompilerDriver* driver,
                            size_t thread_count,
                            TimingLogger* timings,
                            const char* timing_name,
-                           CompileFn compile_fn) {
+                           CompileFn compile_fn,
+                           /*out*/ std::vector<uint64_t>* task_busy_ns) {
   TimingLogger::ScopedTiming t(timing_name, timings);
   ParallelCompilationManager context(Runtime::Current()->GetClassLinker(),
                                      class_loader,
@@ -2682,6 +2874,26 @@ static void CompileDexFile(CompilerDriver* driver,
       ? compiler_options.GetProfileCompilationInfo()->FindDexFile(dex_file)
       : ProfileCompilationInfo::MaxProfileIndex();
 
+  // Compile the classes with the most code first, so that the threads finish at about the same
+  // time instead of waiting for a thread that picked a large class at the end.
+  std::vector<uint32_t> class_order(dex_file.NumClassDefs());
+  {
+    std::vector<uint32_t> code_units(dex_file.NumClassDefs(), 0u);
+    for (ClassAccessor accessor : dex_file.GetClasses()) {
+      uint32_t class_code_units = 0u;
+      for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+        class_code_units += method.GetInstructions().InsnsSizeInCodeUnits();
+      }
+      code_units[accessor.GetClassDefIndex()] = class_code_units;
+    }
+    std::iota(class_order.begin(), class_order.end(), 0u);
+    std::stable_sort(class_order.begin(),
+                     class_order.end(),
+                     [&code_units](uint32_t lhs, uint32_t rhs) {
+                       return code_units[lhs] > code_units[rhs];
+                     });
+  }
+
   auto compile = [&context, &compile_fn, profile_index](size_t class_def_index) {
     const DexFile& dex_file = *context.GetDexFile();
     SCOPED_TRACE << "compile " << dex_file.GetLocation() << "@" << class_def_index;
@@ -2746,7 +2958,11 @@ static void CompileDexFile(CompilerDriver* driver,
                  profile_index);
     }
   };
-  context.ForAllLambda(0, dex_file.NumClassDefs(), compile, thread_count);
+  context.ForAllLambda(0,
+                       class_order.size(),
+                       [&compile, &class_order](size_t index) { compile(class_order[index]); },
+                       thread_count,
+                       task_busy_ns);
 }
 
 void CompilerDriver::Compile(jobject class_loader,
@@ -2763,6 +2979,8 @@ void CompilerDriver::Compile(jobject class_loader,
 
   for (const DexFile* dex_file : dex_files) {
     CHECK(dex_file != nullptr);
+    const uint64_t start_ns = NanoTime();
+    std::vector<uint64_t> task_busy_ns;
     CompileDexFile(this,
                    class_loader,
                    *dex_file,
@@ -2770,7 +2988,13 @@ void CompilerDriver::Compile(jobject class_loader,
                    parallel_thread_count_,
                    timings,
                    "Compile Dex File Quick",
-                   CompileMethodQuick);
+                   CompileMethodQuick,
+                   &task_busy_ns);
+    compile_wall_ns_ += NanoTime() - start_ns;
+    compile_task_busy_ns_.resize(task_busy_ns.size(), 0u);
+    for (size_t i = 0; i != task_busy_ns.size(); ++i) {
+      compile_task_busy_ns_[i] += task_busy_ns[i];
+    }
     const ArenaPool* const arena_pool = Runtime::Current()->GetArenaPool();
     const size_t arena_alloc = arena_pool->GetBytesAllocated();
     max_arena_alloc_ = std::max(arena_alloc, max_arena_alloc_);
@@ -2889,6 +3113,23 @@ std::string CompilerDriver::GetMemoryUsageString(bool extended) const {
   return oss.str();
 }
 
+std::string CompilerDriver::GetCompileThreadUtilization() const {
+  std::ostringstream oss;
+  oss << "compile wall time=" << PrettyDuration(compile_wall_ns_);
+  if (compile_wall_ns_ != 0u) {
+    uint64_t total_busy_ns = 0u;
+    for (size_t i = 0; i != compile_task_busy_ns_.size(); ++i) {
+      oss << " thread" << i << "=" << (compile_task_busy_ns_[i] * 100u / compile_wall_ns_) << "%";
+      total_busy_ns += compile_task_busy_ns_[i];
+    }
+    if (!compile_task_busy_ns_.empty()) {
+      oss << " average="
+          << (total_busy_ns * 100u / (compile_wall_ns_ * compile_task_busy_ns_.size())) << "%";
+    }
+  }
+  return oss.str();
+}
+
 void CompilerDriver::InitializeThreadPools() {
   size_t parallel_count = parallel_thread_count_ > 0 ? parallel_thread_count_ - 1 : 0;
   parallel_thread_pool_.reset(
@@ -37,6 +37,7 @@
 #include "dex/dex_file_types.h"
 #include "dex/method_reference.h"
 #include "driver/compiled_method_storage.h"
+#include "oat/jni_stub_hash_map.h"
 #include "thread_pool.h"
 #include "utils/atomic_dex_ref_map.h"
 
@@ -139,6 +140,16 @@ class CompilerDriver {
   // Add a compiled method.
   void AddCompiledMethod(const MethodReference& method_ref, CompiledMethod* const compiled_method);
   CompiledMethod* RemoveCompiledMethod(const MethodReference& method_ref);
+  // Free all compiled methods and their data once the oat files have been written.
+  void FreeCompiledMethods() REQUIRES(!jni_stubs_lock_);
+
+  // Compile the JNI stub for a native method, or copy the stub already compiled for
+  // another native method with the same `JniStubKey`.
+  CompiledMethod* CompileJniStub(uint32_t access_flags,
+                                 uint32_t method_idx,
+                                 const DexFile& dex_file,
+                                 Handle<mirror::DexCache> dex_cache)
+      REQUIRES(!jni_stubs_lock_);
 
   // Resolve compiling method's class. Returns null on failure.
   ObjPtr<mirror::Class> ResolveCompilingMethodsClass(const ScopedObjectAccess& soa,
@@ -206,6 +217,10 @@ class CompilerDriver {
   // Get memory usage during compilation.
   std::string GetMemoryUsageString(bool extended) const;
 
+  // Get the utilization of the compilation threads, i.e. the share of the compilation wall
+  // time each of them spent compiling rather than waiting for the others to finish.
+  std::string GetCompileThreadUtilization() const;
+
   void SetHadHardVerifierFailure() {
     had_hard_verifier_failure_ = true;
   }
@@ -242,9 +257,11 @@ class CompilerDriver {
       REQUIRES(!Locks::mutator_lock_);
 
   // Do fast verification through VerifierDeps if possible. Return whether
-  // verification was successful.
+  // verification was successful for all dex files. Dex files without stored
+  // VerifierDeps data are added to `unverified_dex_files`.
   bool FastVerify(jobject class_loader,
                   const std::vector<const DexFile*>& dex_files,
+                  /*out*/ std::vector<const DexFile*>* unverified_dex_files,
                   TimingLogger* timings);
 
   void Verify(jobject class_loader,
@@ -324,8 +341,18 @@ class CompilerDriver {
 
   CompiledMethodStorage compiled_method_storage_;
 
+  // JNI stubs compiled so far. Outside of the boot image, the generated code depends only
+  // on the access flags and shorty, so the stubs can be shared by all methods with the same
+  // `JniStubKey`. The stored methods are owned by this map.
+  Mutex jni_stubs_lock_;
+  JniStubHashMap<CompiledMethod*> jni_stubs_ GUARDED_BY(jni_stubs_lock_);
+
   size_t max_arena_alloc_;
 
+  // Time each compilation task spent compiling and the wall time of `Compile()`.
+  std::vector<uint64_t> compile_task_busy_ns_;
+  uint64_t compile_wall_ns_;
+
   friend class CommonCompilerDriverTest;
   friend class CompileClassVisitor;
   friend class InitializeClassVisitor;
@@ -29,12 +29,24 @@ void CodeInfoTableDeduper::ReserveDedupeBuffer(size_t num_code_infos) {
   dedupe_set_.reserve(max_size / 2u);
 }
 
+// Returns the number of bits used by `BitMemoryWriter<>::WriteVarint()` to encode `value`.
+static constexpr size_t VarintBitSize(uint32_t value) {
+  return (value > kVarintMax)
+      ? kVarintBits + BitsToBytesRoundUp(MinimumBitsToStore(value)) * kBitsPerByte
+      : kVarintBits;
+}
+
 size_t CodeInfoTableDeduper::Dedupe(const uint8_t* code_info_data) {
   static constexpr size_t kNumHeaders = CodeInfo::kNumHeaders;
   static constexpr size_t kNumBitTables = CodeInfo::kNumBitTables;
 
-  // The back-reference offset takes space so dedupe is not worth it for tiny tables.
-  constexpr size_t kMinDedupSize = 33;  // Assume 32-bit offset on average.
+  // The back-reference offset takes at least `kVarintBits`, so dedupe is never worth it for
+  // smaller tables. For larger tables, we check the actual back-reference size below.
+  constexpr size_t kMinDedupSize = kVarintBits + 1u;
+  // Marking tables as deduped can make the `bit_table_flags_` varint in the header longer,
+  // moving the tables by at most this many bits. (Other tables can only move them back.)
+  constexpr size_t kMaxHeaderGrowthBits =
+      VarintBitSize(MaxInt<uint32_t>(2u * kNumBitTables)) - kVarintBits;
 
   size_t start_bit_offset = writer_.NumberOfWrittenBits();
   DCHECK_ALIGNED(start_bit_offset, kBitsPerByte);
@@ -90,7 +102,14 @@ size_t CodeInfoTableDeduper::Dedupe(const uint8_t* code_info_data) {
         auto [it, inserted] = dedupe_set_.insert(entry);
         dedupe_entries[i] = &*it;
         if (!inserted) {
-          code_info.SetBitTableDeduped(i);  // Mark as deduped before we write header.
+          // The back-reference is written at or before `table_bit_start + kMaxHeaderGrowthBits`.
+          uint32_t max_back_reference = table_bit_start + kMaxHeaderGrowthBits - it->bit_start;
+          if (VarintBitSize(max_back_reference) < table_bit_size) {
+            code_info.SetBitTableDeduped(i);  // Mark as deduped before we write header.
+          } else {
+            // Keep this copy and let later back-references use it as it is closer.
+            it->bit_start = table_bit_start;
+          }
         }
       }
     }
@@ -121,7 +140,8 @@ size_t CodeInfoTableDeduper::Dedupe(const uint8_t* code_info_data) {
           uint32_t table_bit_size = bit_table_bit_starts[i + 1u] - bit_table_bit_starts[i];
           writer_.WriteRegion(read_region.Subregion(bit_table_bit_starts[i], table_bit_size));
           if (table_bit_size >= kMinDedupSize) {
-            // Update offset in the `dedupe_set_` entry.
+            // Update offset in the `dedupe_set_` entry. This also applies to entries
+            // found in the set if the back-reference would be bigger than the table.
             DCHECK(dedupe_entries[i] != nullptr);
             dedupe_entries[i]->bit_start = current_bit_offset;
           }
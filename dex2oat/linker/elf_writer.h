@@ -66,7 +66,8 @@ class ElfWriter {
                                      size_t bss_methods_offset,
                                      size_t bss_roots_offset,
                                      size_t dex_section_size) = 0;
-  virtual void PrepareDebugInfo(const debug::DebugInfo& debug_info) = 0;
+  // Generates the mini-debug-info, if requested, on `num_threads` background threads.
+  virtual void PrepareDebugInfo(const debug::DebugInfo& debug_info, size_t num_threads) = 0;
   virtual OutputStream* StartRoData() = 0;
   virtual void EndRoData(OutputStream* rodata) = 0;
   virtual OutputStream* StartText() = 0;
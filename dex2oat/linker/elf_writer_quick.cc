@@ -16,6 +16,7 @@
 
 #include "elf_writer_quick.h"
 
+#include <algorithm>
 #include <memory>
 #include <openssl/sha.h>
 
@@ -30,6 +31,7 @@
 #include "driver/compiler_options.h"
 #include "elf/elf_builder.h"
 #include "elf/elf_utils.h"
+#include "elf/xz_utils.h"
 #include "stream/buffered_output_stream.h"
 #include "stream/file_output_stream.h"
 #include "thread-current-inl.h"
@@ -46,27 +48,50 @@ class DebugInfoTask : public Task {
                 size_t text_section_size,
                 uint64_t dex_section_address,
                 size_t dex_section_size,
-                const debug::DebugInfo& debug_info)
+                const debug::DebugInfo& debug_info,
+                ThreadPool* thread_pool)
       : isa_(isa),
         instruction_set_features_(features),
         text_section_address_(text_section_address),
         text_section_size_(text_section_size),
         dex_section_address_(dex_section_address),
         dex_section_size_(dex_section_size),
-        debug_info_(debug_info) {
+        debug_info_(debug_info),
+        thread_pool_(thread_pool) {
   }
 
-  void Run(Thread*) override {
-    result_ = debug::MakeMiniDebugInfo(isa_,
-                                       instruction_set_features_,
-                                       text_section_address_,
-                                       text_section_size_,
-                                       dex_section_address_,
-                                       dex_section_size_,
-                                       debug_info_);
+  void Run(Thread* self) override {
+    uncompressed_ = debug::MakeMiniDebugInfo(isa_,
+                                             instruction_set_features_,
+                                             text_section_address_,
+                                             text_section_size_,
+                                             dex_section_address_,
+                                             dex_section_size_,
+                                             debug_info_,
+                                             /*compress=*/ false);
+    // Compress the chunks on all the workers of the pool. The chunk boundaries depend only on
+    // the data, so the output does not depend on the number of threads.
+    compressed_chunks_.resize(XzNumChunks(uncompressed_.size()));
+    for (size_t i = 1; i < compressed_chunks_.size(); ++i) {
+      thread_pool_->AddTask(self, new FunctionTask([this, i](Thread*) { CompressChunk(i); }));
+    }
+    CompressChunk(0u);
   }
 
+  // Must be called after the thread pool finished all the tasks.
   std::vector<uint8_t>* GetResult() {
+    if (!compressed_chunks_.empty()) {
+      size_t size = 0u;
+      for (const std::vector<uint8_t>& chunk : compressed_chunks_) {
+        size += chunk.size();
+      }
+      result_.reserve(size);
+      for (const std::vector<uint8_t>& chunk : compressed_chunks_) {
+        result_.insert(result_.end(), chunk.begin(), chunk.end());
+      }
+      compressed_chunks_.clear();
+      uncompressed_.clear();
+    }
     return &result_;
   }
 
@@ -78,7 +103,14 @@ class DebugInfoTask : public Task {
   uint64_t dex_section_address_;
   size_t dex_section_size_;
   const debug::DebugInfo& debug_info_;
+  ThreadPool* const thread_pool_;
+  std::vector<uint8_t> uncompressed_;
+  std::vector<std::vector<uint8_t>> compressed_chunks_;
   std::vector<uint8_t> result_;
+
+  void CompressChunk(size_t index) {
+    XzCompressChunk(ArrayRef<const uint8_t>(uncompressed_), index, &compressed_chunks_[index]);
+  }
 };
 
 template <typename ElfTypes>
@@ -97,7 +129,7 @@ class ElfWriterQuick final : public ElfWriter {
                              size_t bss_methods_offset,
                              size_t bss_roots_offset,
                              size_t dex_section_size) override;
-  void PrepareDebugInfo(const debug::DebugInfo& debug_info) override;
+  void PrepareDebugInfo(const debug::DebugInfo& debug_info, size_t num_threads) override;
   OutputStream* StartRoData() override;
   void EndRoData(OutputStream* rodata) override;
   OutputStream* StartText() override;
@@ -245,10 +277,13 @@ void ElfWriterQuick<ElfTypes>::WriteDynamicSection() {
 }
 
 template <typename ElfTypes>
-void ElfWriterQuick<ElfTypes>::PrepareDebugInfo(const debug::DebugInfo& debug_info) {
+void ElfWriterQuick<ElfTypes>::PrepareDebugInfo(const debug::DebugInfo& debug_info,
+                                                size_t num_threads) {
   if (compiler_options_.GetGenerateMiniDebugInfo()) {
     // Prepare the mini-debug-info in background while we do other I/O.
     Thread* self = Thread::Current();
+    debug_info_thread_pool_.reset(
+        ThreadPool::Create("Mini-debug-info writer", std::max<size_t>(num_threads, 1u)));
     debug_info_task_ = std::make_unique<DebugInfoTask>(
         builder_->GetIsa(),
         compiler_options_.GetInstructionSetFeatures(),
@@ -256,8 +291,8 @@ void ElfWriterQuick<ElfTypes>::PrepareDebugInfo(const debug::DebugInfo& debug_in
         text_size_,
         builder_->GetDex()->Exists() ? builder_->GetDex()->GetAddress() : 0,
         dex_section_size_,
-        debug_info);
-    debug_info_thread_pool_.reset(ThreadPool::Create("Mini-debug-info writer", 1));
+        debug_info,
+        debug_info_thread_pool_.get());
     debug_info_thread_pool_->AddTask(self, debug_info_task_.get());
     debug_info_thread_pool_->StartWorkers(self);
   }
@@ -268,12 +303,14 @@ void ElfWriterQuick<ElfTypes>::WriteDebugInfo(const debug::DebugInfo& debug_info
   if (compiler_options_.GetGenerateMiniDebugInfo()) {
     // If mini-debug-info wasn't explicitly created so far, create it now (happens in tests).
     if (debug_info_task_ == nullptr) {
-      PrepareDebugInfo(debug_info);
+      PrepareDebugInfo(debug_info, /*num_threads=*/ 1u);
     }
     // Wait for the mini-debug-info generation to finish and write it to disk.
     Thread* self = Thread::Current();
     DCHECK(debug_info_thread_pool_ != nullptr);
     debug_info_thread_pool_->Wait(self, true, false);
+    // Do not keep the workers around while other oat files are written.
+    debug_info_thread_pool_.reset();
     builder_->WriteSection(".gnu_debugdata", debug_info_task_->GetResult());
   }
   // The Strip method expects debug info to be last (mini-debug-info is not stripped).
@@ -22,6 +22,7 @@
 #include "base/utils.h"
 #include "common_compiler_driver_test.h"
 #include "elf/elf_builder.h"
+#include "elf/xz_utils.h"
 #include "elf_writer_quick.h"
 #include "oat/elf_file.h"
 #include "oat/elf_file_impl.h"
@@ -137,5 +138,34 @@ TEST_F(ElfWriterTest, CheckBuildIdPresent) {
   }
 }
 
+TEST_F(ElfWriterTest, ChunkedXzCompression) {
+  // The mini-debug-info is compressed in chunks that decompress as a whole.
+  constexpr size_t kChunkSize = 4 * KB;
+  std::vector<uint8_t> data(5 * kChunkSize + 123u);
+  for (size_t i = 0; i != data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i * 7u) ^ (i >> 5));
+  }
+  ArrayRef<const uint8_t> src(data);
+  size_t num_chunks = XzNumChunks(src.size(), kChunkSize);
+  ASSERT_EQ(6u, num_chunks);
+  std::vector<uint8_t> compressed;
+  for (size_t i = 0; i != num_chunks; ++i) {
+    std::vector<uint8_t> chunk;
+    XzCompressChunk(src, i, &chunk, kChunkSize);
+    compressed.insert(compressed.end(), chunk.begin(), chunk.end());
+  }
+  std::vector<uint8_t> decompressed;
+  XzDecompress(ArrayRef<const uint8_t>(compressed), &decompressed);
+  EXPECT_EQ(data, decompressed);
+
+  // Empty data is still a valid stream.
+  EXPECT_EQ(1u, XzNumChunks(0u, kChunkSize));
+  std::vector<uint8_t> empty_compressed;
+  XzCompressChunk(ArrayRef<const uint8_t>(), 0u, &empty_compressed, kChunkSize);
+  std::vector<uint8_t> empty_decompressed;
+  XzDecompress(ArrayRef<const uint8_t>(empty_compressed), &empty_decompressed);
+  EXPECT_TRUE(empty_decompressed.empty());
+}
+
 }  // namespace linker
 }  // namespace art
@@ -21,6 +21,7 @@
 #include <sys/stat.h>
 #include <zlib.h>
 
+#include <atomic>
 #include <charconv>
 #include <memory>
 #include <numeric>
@@ -88,6 +89,7 @@
 #include "subtype_check.h"
 #include "thread-current-inl.h"  // For AssertOnly1Thread.
 #include "thread_list.h"         // For AssertOnly1Thread.
+#include "thread_pool.h"
 #include "well_known_classes-inl.h"
 
 using ::art::mirror::Class;
@@ -405,7 +407,9 @@ static ObjPtr<mirror::ObjectArray<mirror::Object>> AllocateBootImageLiveObjects(
 template <typename MirrorType>
 ObjPtr<MirrorType> ImageWriter::DecodeGlobalWithoutRB(JavaVMExt* vm, jobject obj) {
   DCHECK_EQ(IndirectReferenceTable::GetIndirectRefKind(obj), kGlobal);
-  return ObjPtr<MirrorType>::DownCast(vm->globals_.Get<kWithoutReadBarrier>(obj));
+  IndirectRef ref = obj;
+  IndirectReferenceTable* table = &vm->GetGlobalsShard(&ref)->table;
+  return ObjPtr<MirrorType>::DownCast(table->Get<kWithoutReadBarrier>(ref));
 }
 
 template <typename MirrorType>
@@ -577,10 +581,16 @@ bool ImageWriter::Write(int image_fd,
   }
 
   {
+    // Create the workers before acquiring the mutator lock so that attaching them to the
+    // runtime cannot be blocked by the current thread.
+    std::unique_ptr<ThreadPool> thread_pool;
+    if (thread_count_ > 1u) {
+      thread_pool.reset(ThreadPool::Create("Image writer thread pool", thread_count_ - 1u));
+    }
     // TODO: heap validation can't handle these fix up passes.
     ScopedObjectAccess soa(self);
     Runtime::Current()->GetHeap()->DisableObjectValidation();
-    CopyAndFixupObjects();
+    CopyAndFixupObjects(thread_pool.get());
   }
 
   if (compiler_options_.IsAppImage()) {
@@ -1717,7 +1727,7 @@ class ImageWriter::LayoutHelper::CollectClassesVisitor {
       ClassTable* app_class_table = app_class_loader->GetClassTable();
       ReaderMutexLock lock(self, app_class_table->lock_);
       DCHECK_EQ(app_class_table->classes_.size(), 1u);
-      const ClassTable::ClassSet& app_class_set = app_class_table->classes_[0];
+      const ClassTable::ClassSet& app_class_set = app_class_table->classes_.front();
       DCHECK_GE(app_class_set.size(), image_info.class_table_size_);
       boot_image_classes.reserve(app_class_set.size() - image_info.class_table_size_);
       for (const ClassTable::TableSlot& slot : app_class_set) {
@@ -2940,6 +2950,8 @@ void ImageWriter::CopyAndFixupImTable(ImTable* orig, ImTable* copy) {
 }
 
 void ImageWriter::CopyAndFixupImtConflictTable(ImtConflictTable* orig, ImtConflictTable* copy) {
+  // Hashed tables depend on the method addresses and are not created by the AOT compiler.
+  DCHECK(!orig->IsHashed(target_ptr_size_));
   const size_t count = orig->NumEntries(target_ptr_size_);
   for (size_t i = 0; i < count; ++i) {
     ArtMethod* interface_method = orig->GetInterfaceMethod(i, target_ptr_size_);
@@ -3056,7 +3068,7 @@ void ImageWriter::CopyAndFixupNativeData(size_t oat_index) {
       MutexLock lock(Thread::Current(), *Locks::intern_table_lock_);
       CHECK(!temp_intern_table.strong_interns_.tables_.empty());
       // The UnorderedSet was inserted at the beginning.
-      CHECK_EQ(temp_intern_table.strong_interns_.tables_[0].Size(), intern_table.size());
+      CHECK_EQ(temp_intern_table.strong_interns_.tables_.front().Size(), intern_table.size());
     }
   }
 
@@ -3085,7 +3097,7 @@ void ImageWriter::CopyAndFixupNativeData(size_t oat_index) {
       ReaderMutexLock lock(Thread::Current(), temp_class_table.lock_);
       CHECK(!temp_class_table.classes_.empty());
       // The ClassSet was inserted at the beginning.
-      CHECK_EQ(temp_class_table.classes_[0].size(), table.size());
+      CHECK_EQ(temp_class_table.classes_.front().size(), table.size());
     }
   }
 }
@@ -3153,7 +3165,8 @@ inline Object* ImageWriter::CopyObject(Object* obj) {
   DCHECK_LT(offset, image_info.image_end_);
   const auto* src = reinterpret_cast<const uint8_t*>(obj);
 
-  bool done = image_info.image_bitmap_.Set(dst);  // Mark the obj as live.
+  // Mark the obj as live. Objects can be copied concurrently, see `CopyAndFixupObjects()`.
+  bool done = image_info.image_bitmap_.AtomicTestAndSet(dst);
   // Check if the object was already copied, unless the caller indicated that it was not.
   if (kCheckIfDone && done) {
     return nullptr;
@@ -3224,7 +3237,7 @@ class ImageWriter::FixupVisitor {
   mirror::Object* const copy_;
 };
 
-void ImageWriter::CopyAndFixupObjects() {
+void ImageWriter::CopyAndFixupObjects(ThreadPool* thread_pool) {
   // Copy and fix up pointer arrays first as they require special treatment.
   auto method_pointer_array_visitor =
       [&](ObjPtr<mirror::PointerArray> pointer_array) REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -3247,11 +3260,47 @@ void ImageWriter::CopyAndFixupObjects() {
     }
   }
 
-  auto visitor = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
-    DCHECK(obj != nullptr);
-    CopyAndFixupObject(obj);
-  };
-  Runtime::Current()->GetHeap()->VisitObjects(visitor);
+  if (thread_pool == nullptr) {
+    auto visitor = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+      DCHECK(obj != nullptr);
+      CopyAndFixupObject(obj);
+    };
+    Runtime::Current()->GetHeap()->VisitObjects(visitor);
+  } else {
+    // Each object is copied to its own location assigned by `CalculateNewObjectOffsets()`
+    // and the fixup reads only the original objects and the relocation data, so the objects
+    // can be processed in any order without affecting the output.
+    dchecked_vector<Object*> objects;
+    auto visitor = [&](Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+      DCHECK(obj != nullptr);
+      if (IsImageBinSlotAssigned(obj)) {
+        objects.push_back(obj);
+      }
+    };
+    Runtime::Current()->GetHeap()->VisitObjects(visitor);
+
+    static constexpr size_t kObjectsPerChunk = 1024u;
+    std::atomic<size_t> next_object(0u);
+    auto copy_and_fixup_chunks = [&](Thread* self) NO_THREAD_SAFETY_ANALYSIS {
+      // The current thread already holds the mutator lock, the workers need to acquire it.
+      ScopedObjectAccess soa(self);
+      size_t begin;
+      while ((begin = next_object.fetch_add(kObjectsPerChunk, std::memory_order_relaxed)) <
+                 objects.size()) {
+        size_t end = std::min(begin + kObjectsPerChunk, objects.size());
+        for (size_t i = begin; i != end; ++i) {
+          CopyAndFixupObject(objects[i]);
+        }
+      }
+    };
+    Thread* self = Thread::Current();
+    for (size_t i = 0, num_tasks = thread_pool->GetThreadCount() + 1u; i != num_tasks; ++i) {
+      thread_pool->AddTask(self, new FunctionTask(copy_and_fixup_chunks));
+    }
+    thread_pool->StartWorkers(self);
+    thread_pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ true);
+    thread_pool->StopWorkers(self);
+  }
 
   // Fill the padding objects since they are required for in order traversal of the image space.
   for (ImageInfo& image_info : image_infos_) {
@@ -3779,7 +3828,8 @@ ImageWriter::ImageWriter(const CompilerOptions& compiler_options,
                          const std::vector<std::string>& oat_filenames,
                          const HashMap<const DexFile*, size_t>& dex_file_oat_index_map,
                          jobject class_loader,
-                         const std::vector<std::string>* dirty_image_objects)
+                         const std::vector<std::string>* dirty_image_objects,
+                         size_t thread_count)
     : compiler_options_(compiler_options),
       target_ptr_size_(InstructionSetPointerSize(compiler_options.GetInstructionSet())),
       // If we're compiling a boot image and we have a profile, set methods as being shared
@@ -3803,7 +3853,8 @@ ImageWriter::ImageWriter(const CompilerOptions& compiler_options,
       image_storage_mode_(image_storage_mode),
       oat_filenames_(oat_filenames),
       dex_file_oat_index_map_(dex_file_oat_index_map),
-      dirty_image_objects_(dirty_image_objects) {
+      dirty_image_objects_(dirty_image_objects),
+      thread_count_(thread_count) {
   DCHECK(compiler_options.IsBootImage() ||
          compiler_options.IsBootImageExtension() ||
          compiler_options.IsAppImage());
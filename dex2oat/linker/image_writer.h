@@ -71,6 +71,7 @@ template<class T> class Handle;
 class ImTable;
 class ImtConflictTable;
 class JavaVMExt;
+class ThreadPool;
 class TimingLogger;
 
 namespace linker {
@@ -84,7 +85,8 @@ class ImageWriter final {
               const std::vector<std::string>& oat_filenames,
               const HashMap<const DexFile*, size_t>& dex_file_oat_index_map,
               jobject class_loader,
-              const std::vector<std::string>* dirty_image_objects);
+              const std::vector<std::string>* dirty_image_objects,
+              size_t thread_count);
   ~ImageWriter();
 
   /*
@@ -463,7 +465,8 @@ class ImageWriter final {
   // Creates the contiguous image in memory and adjusts pointers.
   void CopyAndFixupNativeData(size_t oat_index) REQUIRES_SHARED(Locks::mutator_lock_);
   void CopyAndFixupJniStubMethods(size_t oat_index) REQUIRES_SHARED(Locks::mutator_lock_);
-  void CopyAndFixupObjects() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Copy and fix up objects using `thread_pool`, if not null, in addition to the current thread.
+  void CopyAndFixupObjects(ThreadPool* thread_pool) REQUIRES_SHARED(Locks::mutator_lock_);
   void CopyAndFixupObject(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_);
   template <bool kCheckIfDone>
   mirror::Object* CopyObject(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_);
@@ -709,6 +712,9 @@ class ImageWriter final {
   // Objects are guaranteed to not cross the region size boundary.
   size_t region_size_ = 0u;
 
+  // Number of threads to use for copying and fixing up objects.
+  const size_t thread_count_;
+
   // Region alignment bytes wasted.
   size_t region_alignment_wasted_ = 0u;
 
@@ -43,10 +43,12 @@
 #include "debug/method_debug_info.h"
 #include "dex/art_dex_file_loader.h"
 #include "dex/class_accessor-inl.h"
+#include "dex/code_item_accessors-inl.h"
 #include "dex/dex_file-inl.h"
 #include "dex/dex_file_loader.h"
 #include "dex/dex_file_types.h"
 #include "dex/dex_file_verifier.h"
+#include "dex/dex_instruction-inl.h"
 #include "dex/proto_reference.h"
 #include "dex/standard_dex_file.h"
 #include "dex/type_lookup_table.h"
@@ -891,6 +893,12 @@ class OatWriter::InitOatClassesMethodVisitor : public DexMethodVisitor {
 //
 // See also OrderedMethodVisitor.
 struct OatWriter::OrderedMethodData {
+  // Bits of `hotness_bits`. The startup bit is the most significant one, so that
+  // the startup code is contiguous at the end of the code, see `operator<`.
+  static constexpr uint32_t kHotBit = 1u;
+  static constexpr uint32_t kPostStartupBit = 2u;
+  static constexpr uint32_t kStartupBit = 4u;
+
   uint32_t hotness_bits;
   OatClass* oat_class;
   CompiledMethod* compiled_method;
@@ -912,17 +920,17 @@ struct OatWriter::OrderedMethodData {
 
   // Bin each method according to the profile flags.
   //
-  // Groups by e.g.
+  // Groups by
   //  -- not hot at all
   //  -- hot
-  //  -- hot and startup
+  //  -- post-startup
   //  -- hot and post-startup
-  //  -- hot and startup and poststartup
   //  -- startup
+  //  -- hot and startup
   //  -- startup and post-startup
-  //  -- post-startup
+  //  -- hot and startup and post-startup
   //
-  // (See MethodHotness enum definition for up-to-date binning order.)
+  // The code of all startup methods is contiguous, see `OatHeader::GetStartupCodeOffset()`.
   bool operator<(const OrderedMethodData& other) const {
     if (kOatWriterForceOatCodeLayout) {
       // Development flag: Override default behavior by sorting by name.
@@ -1056,12 +1064,13 @@ class OatWriter::LayoutCodeMethodVisitor final : public OatDexMethodVisitor {
       if (profile_index_ != ProfileCompilationInfo::MaxProfileIndex()) {
         ProfileCompilationInfo* pci = writer_->profile_compilation_info_;
         DCHECK(pci != nullptr);
-        // Note: Bin-to-bin order does not matter. If the kernel does or does not read-ahead
+        // Note: Bin-to-bin order does not matter much. If the kernel does or does not read-ahead
         // any memory, it only goes into the buffer cache and does not grow the PSS until the
-        // first time that memory is referenced in the process.
-        constexpr uint32_t kHotBit = 1u;
-        constexpr uint32_t kStartupBit = 2u;
-        constexpr uint32_t kPostStartupBit = 4u;
+        // first time that memory is referenced in the process. The startup code is kept
+        // contiguous so that the runtime can request it to be read ahead when loading.
+        constexpr uint32_t kHotBit = OrderedMethodData::kHotBit;
+        constexpr uint32_t kStartupBit = OrderedMethodData::kStartupBit;
+        constexpr uint32_t kPostStartupBit = OrderedMethodData::kPostStartupBit;
         hotness_bits =
             (pci->IsHotMethod(profile_index_, method_index) ? kHotBit : 0u) |
             (pci->IsStartupMethod(profile_index_, method_index) ? kStartupBit : 0u) |
@@ -1138,6 +1147,10 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
 
   bool VisitComplete() override {
     offset_ = writer_->relative_patcher_->ReserveSpaceEnd(offset_);
+    if (startup_code_end_ != 0u) {
+      writer_->oat_header_->SetStartupCodeRange(startup_code_begin_,
+                                                startup_code_end_ - startup_code_begin_);
+    }
     if (generate_debug_info_) {
       std::vector<debug::MethodDebugInfo> thunk_infos =
           relative_patcher_->GenerateThunkDebugInfo(executable_offset_);
@@ -1215,6 +1228,13 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
     *method_header = OatQuickMethodHeader(code_info_offset);
 
     if (!deduped) {
+      if ((method_data.hotness_bits & OrderedMethodData::kStartupBit) != 0u) {
+        // Startup methods are sorted last, so the range includes only startup code and thunks.
+        if (startup_code_end_ == 0u) {
+          startup_code_begin_ = offset_;
+        }
+        startup_code_end_ = offset_ + sizeof(*method_header) + code_size;
+      }
       // Update offsets. (Checksum is updated when writing.)
       offset_ += sizeof(*method_header);  // Method header is prepended before code.
       offset_ += code_size;
@@ -1269,6 +1289,8 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
       : OrderedMethodVisitor(std::move(ordered_methods)),
         writer_(writer),
         offset_(offset),
+        startup_code_begin_(0u),
+        startup_code_end_(0u),
         relative_patcher_(writer->relative_patcher_),
         executable_offset_(writer->oat_header_->GetExecutableOffset()),
         debuggable_(compiler_options.GetDebuggable()),
@@ -1310,6 +1332,10 @@ class OatWriter::LayoutReserveOffsetCodeMethodVisitor : public OrderedMethodVisi
   // Offset of the code of the compiled methods.
   size_t offset_;
 
+  // Range of the code of the startup methods, including method headers.
+  size_t startup_code_begin_;
+  size_t startup_code_end_;
+
   // Deduplication is already done on a pointer basis by the compiler driver,
   // so we can simply compare the pointers to find out if things are duplicated.
   SafeMap<const CompiledMethod*, uint32_t, CodeOffsetsKeyComparator> dedupe_map_;
@@ -3473,6 +3499,75 @@ void OatWriter::InitializeTypeLookupTables(
   }
 }
 
+// Collect the ranges of the code items and of the strings they load for each layout type,
+// based on the profile flags of the methods. The dex file itself is not reordered, so the
+// runtime can only read ahead the ranges of the hot and startup code.
+static DexLayoutSections ComputeDexLayoutSections(const DexFile& dex_file,
+                                                  const ProfileCompilationInfo& profile) {
+  DexLayoutSections layout;
+  ProfileCompilationInfo::ProfileIndexType profile_index = profile.FindDexFile(dex_file);
+  if (profile_index == ProfileCompilationInfo::MaxProfileIndex()) {
+    return layout;
+  }
+  // Code items may be shared by several methods. Use the best layout for each of them.
+  SafeMap<uint32_t, LayoutType> code_item_layouts;
+  for (ClassAccessor accessor : dex_file.GetClasses()) {
+    for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+      if (method.GetCodeItemOffset() == 0u) {
+        continue;
+      }
+      uint32_t method_index = method.GetIndex();
+      bool is_startup = profile.IsStartupMethod(profile_index, method_index);
+      bool is_post_startup = profile.IsPostStartupMethod(profile_index, method_index);
+      LayoutType layout_type;
+      if (profile.IsHotMethod(profile_index, method_index)) {
+        layout_type = LayoutType::kLayoutTypeHot;
+      } else if (is_startup && !is_post_startup) {
+        layout_type = LayoutType::kLayoutTypeStartupOnly;
+      } else if (is_startup || is_post_startup) {
+        layout_type = LayoutType::kLayoutTypeSometimesUsed;
+      } else {
+        layout_type = LayoutType::kLayoutTypeUnused;
+      }
+      auto it = code_item_layouts.FindOrAdd(method.GetCodeItemOffset(), layout_type);
+      it->second = MergeLayoutType(it->second, layout_type);
+    }
+  }
+
+  DexLayoutSection& code_section = layout.sections_[
+      static_cast<size_t>(DexLayoutSections::SectionType::kSectionTypeCode)];
+  DexLayoutSection& strings_section = layout.sections_[
+      static_cast<size_t>(DexLayoutSections::SectionType::kSectionTypeStrings)];
+  for (const auto& [code_item_offset, layout_type] : code_item_layouts) {
+    const dex::CodeItem* code_item = dex_file.GetCodeItem(code_item_offset);
+    code_section.parts_[static_cast<size_t>(layout_type)].CombineSection(
+        code_item_offset, code_item_offset + dex_file.GetCodeItemSize(*code_item));
+    if (layout_type != LayoutType::kLayoutTypeHot &&
+        layout_type != LayoutType::kLayoutTypeStartupOnly) {
+      continue;
+    }
+    // The strings loaded by the code are needed at the same time.
+    for (const DexInstructionPcPair& inst : CodeItemInstructionAccessor(dex_file, code_item)) {
+      dex::StringIndex string_index;
+      if (inst->Opcode() == Instruction::CONST_STRING) {
+        string_index = dex::StringIndex(inst->VRegB_21c());
+      } else if (inst->Opcode() == Instruction::CONST_STRING_JUMBO) {
+        string_index = dex::StringIndex(inst->VRegB_31c());
+      } else {
+        continue;
+      }
+      const dex::StringId& string_id = dex_file.GetStringId(string_index);
+      uint32_t utf16_length;
+      const char* data = dex_file.GetStringDataAndUtf16Length(string_id, &utf16_length);
+      uint32_t end_offset = dchecked_integral_cast<uint32_t>(
+          reinterpret_cast<const uint8_t*>(data) + strlen(data) + 1u - dex_file.DataBegin());
+      strings_section.parts_[static_cast<size_t>(layout_type)].CombineSection(
+          string_id.string_data_off_, end_offset);
+    }
+  }
+  return layout;
+}
+
 bool OatWriter::WriteDexLayoutSections(OutputStream* oat_rodata,
                                        const std::vector<const DexFile*>& opened_dex_files) {
   TimingLogger::ScopedTiming split(__FUNCTION__, timings_);
@@ -3494,6 +3589,10 @@ bool OatWriter::WriteDexLayoutSections(OutputStream* oat_rodata,
   for (size_t i = 0, size = opened_dex_files.size(); i != size; ++i) {
     OatDexFile* oat_dex_file = &oat_dex_files_[i];
     DCHECK_EQ(oat_dex_file->dex_sections_layout_offset_, 0u);
+    if (profile_compilation_info_ != nullptr) {
+      oat_dex_file->dex_sections_layout_ =
+          ComputeDexLayoutSections(*opened_dex_files[i], *profile_compilation_info_);
+    }
 
     // Write dex layout section alignment bytes.
     const size_t padding_size =
@@ -3679,6 +3778,10 @@ bool OatWriter::FinishVdexFile(File* vdex_file, verifier::VerifierDeps* verifier
   new (ptr) VdexFile::VdexSectionHeader(VdexSection::kTypeLookupTableSection,
                                         vdex_lookup_tables_offset_,
                                         vdex_size_ - vdex_lookup_tables_offset_);
+  ptr += sizeof(VdexFile::VdexSectionHeader);
+
+  // Compressed data section. Filled by `VdexFile::Compress()` if requested.
+  new (ptr) VdexFile::VdexSectionHeader(VdexSection::kCompressedDataSection, 0u, 0u);
 
   // All the contents (except the header) of the vdex file has been emitted in memory. Flush it
   // to disk.
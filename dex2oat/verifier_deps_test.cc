@@ -523,6 +523,66 @@ TEST_F(VerifierDepsTest, EncodeDecodeMulti) {
   decoded_deps.Dump(&os);
 }
 
+TEST_F(VerifierDepsTest, EncodeDecodePartial) {
+  VerifyDexFile("MultiDex");
+
+  ASSERT_GT(NumberOfCompiledDexFiles(), 1u);
+  std::vector<uint8_t> buffer;
+  verifier_deps_->Encode(dex_files_, &buffer);
+  ASSERT_FALSE(buffer.empty());
+
+  // Only parse the data of the first dex file, as if the other ones had changed.
+  std::vector<bool> dex_files_to_parse(dex_files_.size(), false);
+  dex_files_to_parse[0] = true;
+  VerifierDeps decoded_deps(dex_files_, /*output_only=*/ false);
+  bool parsed = decoded_deps.ParseStoredData(
+      dex_files_, ArrayRef<const uint8_t>(buffer), dex_files_to_parse);
+  ASSERT_TRUE(parsed);
+  ASSERT_TRUE(decoded_deps.HasStoredData(*dex_files_[0]));
+  ASSERT_EQ(verifier_deps_->GetVerifiedClasses(*dex_files_[0]),
+            decoded_deps.GetVerifiedClasses(*dex_files_[0]));
+  for (size_t i = 1; i != dex_files_.size(); ++i) {
+    ASSERT_FALSE(decoded_deps.HasStoredData(*dex_files_[i]));
+    const std::vector<bool>& verified_classes = decoded_deps.GetVerifiedClasses(*dex_files_[i]);
+    ASSERT_TRUE(std::find(verified_classes.begin(), verified_classes.end(), true) ==
+                verified_classes.end());
+  }
+}
+
+TEST_F(VerifierDepsTest, ReuseIdenticalClasses) {
+  VerifyDexFile("MultiDex");
+
+  ASSERT_GT(NumberOfCompiledDexFiles(), 1u);
+  std::vector<uint8_t> buffer;
+  verifier_deps_->Encode(dex_files_, &buffer);
+  ASSERT_FALSE(buffer.empty());
+
+  VerifierDeps old_deps(dex_files_, /*output_only=*/ false);
+  ASSERT_TRUE(old_deps.ParseStoredData(dex_files_, ArrayRef<const uint8_t>(buffer)));
+
+  // Only parse the data of the first dex file, as if the other ones had changed, and
+  // reuse the data of their classes which are all identical.
+  std::vector<bool> dex_files_to_parse(dex_files_.size(), false);
+  dex_files_to_parse[0] = true;
+  VerifierDeps decoded_deps(dex_files_, /*output_only=*/ false);
+  ASSERT_TRUE(decoded_deps.ParseStoredData(
+      dex_files_, ArrayRef<const uint8_t>(buffer), dex_files_to_parse));
+  for (size_t i = 1; i != dex_files_.size(); ++i) {
+    const DexFile& dex_file = *dex_files_[i];
+    ASSERT_FALSE(decoded_deps.HasAnyStoredData(dex_file));
+    const std::vector<bool>& verified_classes = verifier_deps_->GetVerifiedClasses(dex_file);
+    size_t num_verified = std::count(verified_classes.begin(), verified_classes.end(), true);
+    ASSERT_EQ(num_verified, decoded_deps.ReuseIdenticalClasses(dex_file, dex_file, old_deps));
+    ASSERT_EQ(verified_classes, decoded_deps.GetVerifiedClasses(dex_file));
+    ASSERT_EQ(num_verified != 0u, decoded_deps.HasAnyStoredData(dex_file));
+    for (uint32_t class_def_index = 0; class_def_index != verified_classes.size();
+         ++class_def_index) {
+      ASSERT_EQ(verified_classes[class_def_index],
+                decoded_deps.HasStoredData(dex_file, class_def_index));
+    }
+  }
+}
+
 TEST_F(VerifierDepsTest, UnverifiedClasses) {
   VerifyDexFile();
   ASSERT_FALSE(HasUnverifiedClass("LMyThread;"));
@@ -20,6 +20,8 @@
 #include "gtest/gtest.h"
 #include "malloc_arena_pool.h"
 #include "memory_tool.h"
+#include "scoped_arena_allocator.h"
+#include "scoped_arena_containers.h"
 
 namespace art {
 
@@ -349,5 +351,60 @@ TEST_F(ArenaAllocatorTest, ReallocAlignment) {
   }
 }
 
+TEST_F(ArenaAllocatorTest, ScopedArenaVectorGrowthIsRecycled) {
+  if (!kArenaStackRecycleFreedMemory || kRunningOnMemoryTool) {
+    return;
+  }
+  MallocArenaPool pool;
+  ArenaStack arena_stack(&pool);
+  ScopedArenaAllocator allocator(&arena_stack);
+  static constexpr size_t kElements = ArenaStack::kMinRecycledBytes / sizeof(uint64_t);
+
+  ScopedArenaVector<uint64_t> outer(allocator.Adapter());
+  outer.reserve(kElements);
+  uint64_t* old_storage = outer.data();
+  outer.reserve(2u * kElements);  // Releases `old_storage`.
+  {
+    // A nested scope must not see the blocks released by the enclosing scope.
+    ScopedArenaAllocator inner_allocator(&arena_stack);
+    void* inner = inner_allocator.Alloc(ArenaStack::kMinRecycledBytes);
+    EXPECT_NE(static_cast<void*>(old_storage), inner);
+  }
+  size_t used_bytes = arena_stack.CurrentBytesUsed();
+  void* recycled = allocator.Alloc(ArenaStack::kMinRecycledBytes - ArenaStack::kAlignment);
+  EXPECT_EQ(static_cast<void*>(old_storage), recycled);
+  EXPECT_EQ(used_bytes, arena_stack.CurrentBytesUsed());
+  // The list is now empty, the next allocation is taken from the arena.
+  void* fresh = allocator.Alloc(ArenaStack::kMinRecycledBytes);
+  EXPECT_NE(recycled, fresh);
+  EXPECT_LT(used_bytes, arena_stack.CurrentBytesUsed());
+}
+
+TEST_F(ArenaAllocatorTest, ArenaStackPeakBytesUsed) {
+  MallocArenaPool pool;
+  ArenaStack arena_stack(&pool);
+  ScopedArenaAllocator allocator(&arena_stack);
+  allocator.Alloc(100u);
+  size_t base_bytes = arena_stack.CurrentBytesUsed();
+  EXPECT_LE(100u, base_bytes);
+  {
+    ScopedArenaAllocator inner_allocator(&arena_stack);
+    inner_allocator.Alloc(arena_allocator::kArenaDefaultSize);
+    EXPECT_LE(base_bytes + arena_allocator::kArenaDefaultSize, arena_stack.CurrentBytesUsed());
+  }
+  EXPECT_EQ(base_bytes, arena_stack.CurrentBytesUsed());
+  size_t peak_bytes = arena_stack.PeakBytesUsed();
+  EXPECT_LE(base_bytes + arena_allocator::kArenaDefaultSize, peak_bytes);
+
+  // After a reset only the new allocations count towards the peak.
+  EXPECT_EQ(peak_bytes, arena_stack.ResetPeakBytesUsed());
+  EXPECT_EQ(base_bytes, arena_stack.PeakBytesUsed());
+  {
+    ScopedArenaAllocator inner_allocator(&arena_stack);
+    inner_allocator.Alloc(100u);
+  }
+  EXPECT_GT(peak_bytes, arena_stack.PeakBytesUsed());
+  EXPECT_LT(base_bytes, arena_stack.PeakBytesUsed());
+}
 
 }  // namespace art
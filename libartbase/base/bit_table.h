@@ -24,6 +24,7 @@
 #include <type_traits>
 #include <unordered_map>
 
+#include "base/array_ref.h"
 #include "base/bit_memory_region.h"
 #include "base/casts.h"
 #include "base/iteration_range.h"
@@ -69,6 +70,46 @@ class BitTableBase {
     return table_data_.LoadBits(offset, NumColumnBits(column)) + kValueBias;
   }
 
+  // Decode all columns of a row. Rows that fit in a single load, which includes almost all stack
+  // map rows, are read once and split into columns with shifts instead of one load per column.
+  ALWAYS_INLINE std::array<uint32_t, kNumColumns> GetRowValues(uint32_t row) const {
+    using LoadType = BitMemoryRegion::MaxSingleLoadType;
+    DCHECK(table_data_.IsValid()) << "Table has not been loaded";
+    DCHECK_LT(row, num_rows_);
+    std::array<uint32_t, kNumColumns> values;
+    const size_t row_bits = NumRowBits();
+    if (LIKELY(row_bits <= BitSizeOf<LoadType>())) {
+      LoadType bits = table_data_.LoadBits<LoadType>(row * row_bits, row_bits);
+      for (uint32_t i = 0; i < kNumColumns; i++) {
+        uint32_t num_bits = NumColumnBits(i);  // At most 32, so the shifts are defined.
+        values[i] = static_cast<uint32_t>(bits & ((static_cast<LoadType>(1) << num_bits) - 1u));
+        values[i] += kValueBias;
+        bits >>= num_bits;
+      }
+    } else {
+      for (uint32_t i = 0; i < kNumColumns; i++) {
+        values[i] = Get(row, i);
+      }
+    }
+    return values;
+  }
+
+  // Decode `column` of `values.size()` consecutive rows starting at `first_row`.
+  ALWAYS_INLINE void GetColumnValues(uint32_t column,
+                                     uint32_t first_row,
+                                     /*out*/ ArrayRef<uint32_t> values) const {
+    DCHECK(table_data_.IsValid() || values.empty()) << "Table has not been loaded";
+    DCHECK_LE(first_row + values.size(), num_rows_);
+    DCHECK_LT(column, kNumColumns);
+    const size_t row_bits = NumRowBits();
+    const size_t num_bits = NumColumnBits(column);
+    size_t offset = first_row * row_bits + column_offset_[column];
+    for (uint32_t& value : values) {
+      value = table_data_.LoadBits(offset, num_bits) + kValueBias;
+      offset += row_bits;
+    }
+  }
+
   ALWAYS_INLINE BitMemoryRegion GetBitMemoryRegion(uint32_t row, uint32_t column = 0) const {
     DCHECK(table_data_.IsValid()) << "Table has not been loaded";
     DCHECK_LT(row, num_rows_);
@@ -119,6 +119,43 @@ TEST(BitTableTest, TestBigTable) {
   EXPECT_EQ(32u, table.NumColumnBits(3));
 }
 
+TEST(BitTableTest, TestBulkDecoding) {
+  MallocArenaPool pool;
+  ArenaStack arena_stack(&pool);
+  ScopedArenaAllocator allocator(&arena_stack);
+
+  constexpr uint32_t kNoValue = -1;
+  // Narrow rows are decoded with a single load, wide rows column by column.
+  for (uint32_t base_value : {50u, 0x70000000u}) {
+    std::vector<uint8_t> buffer;
+    BitMemoryWriter<std::vector<uint8_t>> writer(&buffer, /* bit_offset= */ 5);
+    BitTableBuilderBase<4> builder(&allocator);
+    for (uint32_t row = 0; row < 40u; row++) {
+      uint32_t last_value = (row % 3u == 0u) ? kNoValue : base_value + row * 7u;
+      builder.Add({base_value + row, kNoValue, base_value - row, last_value});
+    }
+    builder.Encode(writer);
+
+    BitMemoryReader reader(buffer.data(), /* bit_offset= */ 5);
+    BitTableBase<4> table(reader);
+    ASSERT_EQ(40u, table.NumRows());
+    EXPECT_EQ(base_value == 50u, table.NumRowBits() <= 64u);
+    for (uint32_t row = 0; row < table.NumRows(); row++) {
+      std::array<uint32_t, 4> values = table.GetRowValues(row);
+      for (uint32_t column = 0; column < 4u; column++) {
+        EXPECT_EQ(table.Get(row, column), values[column]) << row << " " << column;
+      }
+    }
+    std::vector<uint32_t> column_values(table.NumRows() - 3u);
+    for (uint32_t column = 0; column < 4u; column++) {
+      table.GetColumnValues(column, /* first_row= */ 3u, ArrayRef<uint32_t>(column_values));
+      for (uint32_t i = 0; i < column_values.size(); i++) {
+        EXPECT_EQ(table.Get(3u + i, column), column_values[i]) << i << " " << column;
+      }
+    }
+  }
+}
+
 TEST(BitTableTest, TestDedup) {
   MallocArenaPool pool;
   ArenaStack arena_stack(&pool);
@@ -26,7 +26,9 @@
 
 #include <gtest/gtest.h>
 
+#include "base/time_utils.h"
 #include "hash_map.h"
+#include "swiss_hash_set.h"
 
 namespace art {
 
@@ -488,4 +490,156 @@ TEST_F(HashSetTest, StatefulHashSet) {
   ASSERT_TRUE(search_it == hash_set.end());
 }
 
+TEST_F(HashSetTest, SwissInsertAndErase) {
+  SwissHashSet<std::string> hash_set;
+  ASSERT_TRUE(hash_set.empty());
+  ASSERT_TRUE(hash_set.begin() == hash_set.end());
+  ASSERT_TRUE(hash_set.find(std::string("missing")) == hash_set.end());
+  static constexpr size_t count = 1000;
+  std::vector<std::string> strings;
+  for (size_t i = 0; i < count; ++i) {
+    strings.push_back(RandomString(10));
+    ASSERT_TRUE(hash_set.insert(strings[i]).second);
+    ASSERT_FALSE(hash_set.insert(strings[i]).second);
+    auto it = hash_set.find(strings[i]);
+    ASSERT_TRUE(it != hash_set.end());
+    ASSERT_EQ(*it, strings[i]);
+  }
+  ASSERT_EQ(strings.size(), hash_set.size());
+  ASSERT_EQ(hash_set.Verify(), 0U);
+  for (size_t i = 1; i < count; i += 2) {
+    hash_set.erase(hash_set.find(strings[i]));
+  }
+  ASSERT_EQ(count / 2u, hash_set.size());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(i % 2u == 0u, hash_set.find(strings[i]) != hash_set.end()) << i;
+  }
+  // Lookup by an alternate key type.
+  ASSERT_TRUE(hash_set.find(std::string_view(strings[0])) != hash_set.end());
+
+  // Copies and moves keep all the elements.
+  SwissHashSet<std::string> copy(hash_set);
+  SwissHashSet<std::string> moved(std::move(hash_set));
+  ASSERT_TRUE(hash_set.empty());  // NOLINT(bugprone-use-after-move)
+  ASSERT_EQ(copy.size(), moved.size());
+  for (const std::string& s : moved) {
+    ASSERT_TRUE(copy.find(s) != copy.end());
+  }
+}
+
+TEST_F(HashSetTest, SwissIteratorErase) {
+  SwissHashSet<std::string> hash_set;
+  static constexpr size_t count = 1000;
+  for (size_t i = 0; i < count; ++i) {
+    hash_set.insert(RandomString(10));
+  }
+  // Erase leaves tombstones and does not move elements, so each element is visited once.
+  std::map<std::string, size_t> found_count;
+  for (auto it = hash_set.begin(); it != hash_set.end();) {
+    ++found_count[*it];
+    it = hash_set.erase(it);
+  }
+  ASSERT_TRUE(hash_set.empty());
+  ASSERT_EQ(count, found_count.size());
+  for (const std::pair<const std::string, size_t>& entry : found_count) {
+    ASSERT_EQ(1U, entry.second);
+  }
+}
+
+TEST_F(HashSetTest, SwissStress) {
+  // Aligned pointer-like values have an identity std::hash<> with zero low bits.
+  SwissHashSet<uintptr_t> hash_set;
+  std::unordered_set<uintptr_t> std_set;
+  static constexpr size_t operations = 100000;
+  static constexpr size_t target_size = 5000;
+  const size_t seed = time(nullptr);
+  SetSeed(seed);
+  LOG(INFO) << "Starting stress test with seed " << seed;
+  for (size_t i = 0; i < operations; ++i) {
+    ASSERT_EQ(hash_set.size(), std_set.size());
+    size_t delta = std::abs(static_cast<ssize_t>(target_size) -
+                            static_cast<ssize_t>(hash_set.size()));
+    size_t n = PRand();
+    uintptr_t value = static_cast<uintptr_t>(PRand() % (2u * target_size)) * 8u;
+    if (n % target_size == 0) {
+      hash_set.clear();
+      std_set.clear();
+    } else if (n % target_size < delta) {
+      ASSERT_EQ(std_set.insert(value).second, hash_set.insert(value).second);
+    } else {
+      auto it = hash_set.find(value);
+      ASSERT_EQ(it == hash_set.end(), std_set.find(value) == std_set.end());
+      if (it != hash_set.end()) {
+        hash_set.erase(it);
+        std_set.erase(value);
+      }
+    }
+  }
+  ASSERT_EQ(hash_set.Verify(), 0U);
+  for (uintptr_t value : std_set) {
+    ASSERT_TRUE(hash_set.find(value) != hash_set.end());
+  }
+}
+
+struct IsEmptyFnUintptr {
+  void MakeEmpty(uintptr_t& item) const {
+    item = 0u;
+  }
+  bool IsEmpty(uintptr_t item) const {
+    return item == 0u;
+  }
+};
+
+// Compares `HashSet<>` linear probing with `SwissHashSet<>` group probing. The timings are only
+// logged, they depend too much on the host to be checked.
+template <typename Set>
+static void BenchmarkSet(const char* name,
+                         const std::vector<uintptr_t>& present,
+                         const std::vector<uintptr_t>& missing) {
+  Set set;
+  uint64_t start_ns = NanoTime();
+  for (uintptr_t value : present) {
+    set.insert(value);
+  }
+  uint64_t insert_ns = NanoTime() - start_ns;
+  size_t found = 0u;
+  start_ns = NanoTime();
+  for (size_t round = 0; round != 10u; ++round) {
+    for (uintptr_t value : present) {
+      found += (set.find(value) != set.end()) ? 1u : 0u;
+    }
+  }
+  uint64_t hit_ns = NanoTime() - start_ns;
+  start_ns = NanoTime();
+  for (size_t round = 0; round != 10u; ++round) {
+    for (uintptr_t value : missing) {
+      found += (set.find(value) != set.end()) ? 1u : 0u;
+    }
+  }
+  uint64_t miss_ns = NanoTime() - start_ns;
+  EXPECT_EQ(10u * present.size(), found);
+  LOG(INFO) << name << ": " << present.size() << " inserts " << PrettyDuration(insert_ns)
+            << ", 10x hits " << PrettyDuration(hit_ns)
+            << ", 10x misses " << PrettyDuration(miss_ns);
+}
+
+TEST_F(HashSetTest, SwissBenchmark) {
+  static constexpr size_t count = 200000;
+  std::unordered_set<uintptr_t> unique;
+  std::vector<uintptr_t> present;
+  std::vector<uintptr_t> missing;
+  while (present.size() != count || missing.size() != count) {
+    // Object-like addresses, 8-byte aligned and never zero.
+    uintptr_t value = (static_cast<uintptr_t>(PRand() % (16u * count)) + 1u) * 8u;
+    if (unique.insert(value).second) {
+      std::vector<uintptr_t>& target = (present.size() != count) ? present : missing;
+      if (target.size() != count) {
+        target.push_back(value);
+      }
+    }
+  }
+  BenchmarkSet<HashSet<uintptr_t, IsEmptyFnUintptr>>("HashSet", present, missing);
+  BenchmarkSet<SwissHashSet<uintptr_t>>("SwissHashSet", present, missing);
+}
+
 }  // namespace art
@@ -59,6 +59,12 @@ using Maps = AllocationTrackingMultiMap<void*, MemMap*, kAllocatorTagMaps>;
 // All the non-empty MemMaps. Use a multimap as we do a reserve-and-divide (eg ElfMap::Load()).
 static Maps* gMaps GUARDED_BY(MemMap::GetMemMapsLock()) = nullptr;
 
+// The bytes mapped by the MemMaps, by name and in total. See `MemMap::UpdateUsage()`.
+static std::map<std::string, MemMap::NameUsage>* gUsageByName
+    GUARDED_BY(MemMap::GetMemMapsLock()) = nullptr;
+static size_t gMappedBytes GUARDED_BY(MemMap::GetMemMapsLock()) = 0u;
+static size_t gPeakMappedBytes GUARDED_BY(MemMap::GetMemMapsLock()) = 0u;
+
 // A map containing unique strings used for indentifying anonymous mappings
 static std::map<std::string, int> debugStrMap GUARDED_BY(MemMap::GetMemMapsLock());
 
@@ -506,6 +512,10 @@ bool MemMap::ReplaceWith(MemMap* source, /*out*/std::string* error) {
   size_t source_size = source->size_;
   source->Invalidate();
 
+  {
+    std::lock_guard<std::mutex> mu(*mem_maps_lock_);
+    UpdateUsage(base_size_, new_base_size);
+  }
   size_ = source_size;
   base_size_ = new_base_size;
   // Reduce base_size if needed (this will unmap the extra pages).
@@ -674,6 +684,7 @@ void MemMap::Invalidate() {
     std::lock_guard<std::mutex> mu(*mem_maps_lock_);
     auto it = GetGMapsEntry(*this);
     gMaps->erase(it);
+    UpdateUsage(base_size_, 0u);
   }
 
   // Mark it as invalid.
@@ -734,7 +745,46 @@ MemMap::MemMap(const std::string& name, uint8_t* begin, size_t size, void* base_
     std::lock_guard<std::mutex> mu(*mem_maps_lock_);
     DCHECK(gMaps != nullptr);
     gMaps->insert(std::make_pair(base_begin_, this));
+    UpdateUsage(0u, base_size_);
+  }
+}
+
+void MemMap::UpdateUsage(size_t old_base_size, size_t new_base_size) {
+  if (reuse_) {
+    return;  // The memory is accounted for by the map owning it.
+  }
+  DCHECK(gUsageByName != nullptr);
+  NameUsage& usage = (*gUsageByName)[name_];
+  DCHECK_GE(usage.live_bytes, old_base_size);
+  usage.live_bytes = usage.live_bytes - old_base_size + new_base_size;
+  usage.peak_bytes = std::max(usage.peak_bytes, usage.live_bytes);
+  if (old_base_size == 0u) {
+    ++usage.num_maps;
   }
+  if (new_base_size == 0u) {
+    DCHECK_NE(usage.num_maps, 0u);
+    --usage.num_maps;
+  }
+  DCHECK_GE(gMappedBytes, old_base_size);
+  gMappedBytes = gMappedBytes - old_base_size + new_base_size;
+  gPeakMappedBytes = std::max(gPeakMappedBytes, gMappedBytes);
+}
+
+std::map<std::string, MemMap::NameUsage> MemMap::GetUsageByName() {
+  std::lock_guard<std::mutex> mu(*mem_maps_lock_);
+  DCHECK(gUsageByName != nullptr);
+  std::map<std::string, NameUsage> result;
+  for (const auto& [name, usage] : *gUsageByName) {
+    if (usage.peak_bytes != 0u) {
+      result.emplace(name, usage);
+    }
+  }
+  return result;
+}
+
+size_t MemMap::GetPeakMappedBytes() {
+  std::lock_guard<std::mutex> mu(*mem_maps_lock_);
+  return gPeakMappedBytes;
 }
 
 MemMap MemMap::RemapAtEnd(uint8_t* new_end,
@@ -801,10 +851,13 @@ MemMap MemMap::RemapAtEnd(uint8_t* new_end,
     return Invalid();
   }
   // Update *this.
-  if (new_base_size == 0u) {
+  {
     std::lock_guard<std::mutex> mu(*mem_maps_lock_);
-    auto it = GetGMapsEntry(*this);
-    gMaps->erase(it);
+    if (new_base_size == 0u) {
+      auto it = GetGMapsEntry(*this);
+      gMaps->erase(it);
+    }
+    UpdateUsage(base_size_, new_base_size);
   }
 
   if (use_debug_name) {
@@ -847,6 +900,7 @@ void MemMap::ReleaseReservedMemory(size_t byte_count) {
     std::lock_guard<std::mutex> mu(*mem_maps_lock_);
     auto it = GetGMapsEntry(*this);
     auto node = gMaps->extract(it);
+    UpdateUsage(base_size_, base_size_ - byte_count);
     begin_ += byte_count;
     size_ -= byte_count;
     base_begin_ = begin_;
@@ -871,6 +925,15 @@ int MemMap::MadviseDontFork() {
   return -1;
 }
 
+int MemMap::MadviseHugePage() {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (base_begin_ != nullptr && base_size_ != 0) {
+    return madvise(base_begin_, base_size_, MADV_HUGEPAGE);
+  }
+#endif
+  return -1;
+}
+
 bool MemMap::Sync() {
 #ifdef _WIN32
   // TODO: add FlushViewOfFile support.
@@ -1034,6 +1097,8 @@ void MemMap::Init() {
 #endif
   DCHECK(gMaps == nullptr);
   gMaps = new Maps;
+  DCHECK(gUsageByName == nullptr);
+  gUsageByName = new std::map<std::string, NameUsage>();
 
   TargetMMapInit();
 }
@@ -1051,6 +1116,10 @@ void MemMap::Shutdown() {
     DCHECK(gMaps != nullptr);
     delete gMaps;
     gMaps = nullptr;
+    delete gUsageByName;
+    gUsageByName = nullptr;
+    gMappedBytes = 0u;
+    gPeakMappedBytes = 0u;
   }
 #if USE_ART_LOW_4G_ALLOCATOR
   next_mem_pos_ = 0u;
@@ -1076,6 +1145,10 @@ void MemMap::SetSize(size_t new_size) {
                         reinterpret_cast<uintptr_t>(BaseBegin()) + new_base_size),
                         base_size_ - new_base_size), 0)
                         << new_base_size << " " << base_size_;
+  if (mem_maps_lock_ != nullptr) {  // Runtime was shutdown.
+    std::lock_guard<std::mutex> mu(*mem_maps_lock_);
+    UpdateUsage(base_size_, new_base_size);
+  }
   base_size_ = new_base_size;
   size_ = new_size;
 }
@@ -1399,6 +1472,7 @@ void MemMap::AlignBy(size_t alignment, bool align_both_ends) {
     node.key() = aligned_base_begin;
     gMaps->insert(std::move(node));
   }
+  UpdateUsage(base_size_, aligned_base_size);
   base_begin_ = aligned_base_begin;
   base_size_ = aligned_base_size;
   begin_ = aligned_base_begin;
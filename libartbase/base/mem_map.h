@@ -257,6 +257,9 @@ class MemMap {
     FillWithZero(/* release_eagerly= */ true);
   }
   int MadviseDontFork();
+  // Ask the kernel to back the mapping with transparent huge pages where possible. Returns -1
+  // if that is not supported.
+  int MadviseHugePage();
 
   int GetProtect() const {
     return prot_;
@@ -324,6 +327,21 @@ class MemMap {
   static void DumpMaps(std::ostream& os, bool terse = false)
       REQUIRES(!MemMap::mem_maps_lock_);
 
+  // Bytes mapped by the MemMaps with a given name. Views of other mappings (`reuse`) are not
+  // counted.
+  struct NameUsage {
+    size_t live_bytes = 0u;
+    size_t peak_bytes = 0u;
+    size_t num_maps = 0u;
+  };
+
+  // Returns the bytes mapped by the MemMaps of each name. The names identify the subsystem
+  // owning the memory, e.g. "LinearAlloc" or "jit-code-cache".
+  static std::map<std::string, NameUsage> GetUsageByName() REQUIRES(!MemMap::mem_maps_lock_);
+
+  // Returns the highest number of bytes mapped by all MemMaps at any time.
+  static size_t GetPeakMappedBytes() REQUIRES(!MemMap::mem_maps_lock_);
+
   // Init and Shutdown are NOT thread safe.
   // Both may be called multiple times and MemMap objects may be created any
   // time after the first call to Init and before the first call to Shutodwn.
@@ -377,6 +395,10 @@ class MemMap {
   void Invalidate();
   void SwapMembers(MemMap& other);
 
+  // Accounts for the base size of this map changing from `old_base_size` to `new_base_size`.
+  void UpdateUsage(size_t old_base_size, size_t new_base_size)
+      REQUIRES(MemMap::mem_maps_lock_);
+
   static void DumpMapsLocked(std::ostream& os, bool terse)
       REQUIRES(MemMap::mem_maps_lock_);
   static bool HasMemMap(MemMap& map)
@@ -353,6 +353,28 @@ TEST_F(MemMapTest, MapAnonymousEmpty) {
   ASSERT_TRUE(error_msg.empty());
 }
 
+TEST_F(MemMapTest, MadviseHugePage) {
+  CommonInit();
+  const size_t page_size = MemMap::GetPageSize();
+  std::string error_msg;
+  MemMap map = MemMap::MapAnonymous("MadviseHugePage",
+                                    1024 * page_size,
+                                    PROT_READ | PROT_WRITE,
+                                    /*low_4gb=*/ false,
+                                    &error_msg);
+  ASSERT_TRUE(map.IsValid()) << error_msg;
+  if (map.MadviseHugePage() != 0) {
+    // Kernels built without transparent huge pages reject the advice.
+    ASSERT_EQ(errno, EINVAL);
+  }
+  // The mapping stays usable either way.
+  memset(map.Begin(), 0xab, map.Size());
+  ASSERT_EQ(map.Begin()[map.Size() - 1], 0xab);
+
+  MemMap empty;
+  ASSERT_EQ(empty.MadviseHugePage(), -1);
+}
+
 TEST_F(MemMapTest, MapAnonymousFailNullError) {
   CommonInit();
   const size_t page_size = MemMap::GetPageSize();
@@ -890,6 +912,56 @@ TEST_F(MemMapTest, Reservation) {
   ASSERT_FALSE(map2.IsValid());
 }
 
+TEST_F(MemMapTest, UsageByName) {
+  CommonInit();
+  const size_t page_size = MemMap::GetPageSize();
+  const std::string name = "UsageByName";
+  auto get_usage = [&]() {
+    std::map<std::string, MemMap::NameUsage> usage_by_name = MemMap::GetUsageByName();
+    auto it = usage_by_name.find(name);
+    return it != usage_by_name.end() ? it->second : MemMap::NameUsage();
+  };
+  std::string error_msg;
+  MemMap map = MemMap::MapAnonymous(name.c_str(),
+                                    4 * page_size,
+                                    PROT_READ | PROT_WRITE,
+                                    /*low_4gb=*/ false,
+                                    &error_msg);
+  ASSERT_TRUE(map.IsValid()) << error_msg;
+  MemMap::NameUsage usage = get_usage();
+  EXPECT_EQ(4 * page_size, usage.live_bytes);
+  EXPECT_EQ(4 * page_size, usage.peak_bytes);
+  EXPECT_EQ(1u, usage.num_maps);
+  EXPECT_GE(MemMap::GetPeakMappedBytes(), 4 * page_size);
+
+  // Shrinking the map lowers the live bytes but keeps the peak.
+  map.SetSize(page_size);
+  usage = get_usage();
+  EXPECT_EQ(page_size, usage.live_bytes);
+  EXPECT_EQ(4 * page_size, usage.peak_bytes);
+
+  // A view of the map is not counted again.
+  MemMap view = MemMap::MapAnonymous(name.c_str(),
+                                     map.Begin(),
+                                     page_size,
+                                     PROT_READ | PROT_WRITE,
+                                     /*low_4gb=*/ false,
+                                     /*reuse=*/ true,
+                                     /*reservation=*/ nullptr,
+                                     &error_msg);
+  ASSERT_TRUE(view.IsValid()) << error_msg;
+  usage = get_usage();
+  EXPECT_EQ(page_size, usage.live_bytes);
+  EXPECT_EQ(1u, usage.num_maps);
+  view.Reset();
+
+  map.Reset();
+  usage = get_usage();
+  EXPECT_EQ(0u, usage.live_bytes);
+  EXPECT_EQ(4 * page_size, usage.peak_bytes);
+  EXPECT_EQ(0u, usage.num_maps);
+}
+
 }  // namespace art
 
 namespace {
@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <optional>
@@ -55,12 +56,24 @@
   METRIC(FullGcTracingThroughputAvg, MetricsAverage)                \
   METRIC(JitMethodCompileTotalTime, MetricsCounter)                 \
   METRIC(JitMethodCompileCount, MetricsCounter)                     \
+  METRIC(JitThrottledTime, MetricsCounter)                          \
+  METRIC(JitMethodCompileTime, MetricsHistogram, 15, 0, 100'000)   \
+  METRIC(JitMethodCodeSize, MetricsHistogram, 15, 0, 30'000)        \
+  METRIC(SwitchInterpreterMethodEntryCount, MetricsCounter)         \
+  METRIC(MonitorSpinAcquiredCount, MetricsCounter)                  \
+  METRIC(MonitorSpinFailedCount, MetricsCounter)                    \
+  METRIC(MonitorContentionTime, MetricsHistogram, 15, 0, 10'000)    \
+  METRIC(MonitorInflationCount, MetricsCounter)                     \
   METRIC(YoungGcCollectionTime, MetricsHistogram, 15, 0, 60'000)    \
   METRIC(FullGcCollectionTime, MetricsHistogram, 15, 0, 60'000)     \
   METRIC(YoungGcThroughput, MetricsHistogram, 15, 0, 10'000)        \
   METRIC(FullGcThroughput, MetricsHistogram, 15, 0, 10'000)         \
   METRIC(YoungGcTracingThroughput, MetricsHistogram, 15, 0, 10'000) \
   METRIC(FullGcTracingThroughput, MetricsHistogram, 15, 0, 10'000)  \
+  METRIC(GcAllocationRate, MetricsHistogram, 15, 0, 3'000)          \
+  METRIC(GcPredictedDuration, MetricsHistogram, 15, 0, 10'000)      \
+  METRIC(SuspendAllSafepointTime, MetricsHistogram, 15, 0, 50'000)  \
+  METRIC(SuspendAllStragglerCount, MetricsCounter)                  \
   METRIC(GcWorldStopTime, MetricsCounter)                           \
   METRIC(GcWorldStopCount, MetricsCounter)                          \
   METRIC(YoungGcScannedBytes, MetricsCounter)                       \
@@ -68,27 +81,47 @@
   METRIC(YoungGcDuration, MetricsCounter)                           \
   METRIC(FullGcScannedBytes, MetricsCounter)                        \
   METRIC(FullGcFreedBytes, MetricsCounter)                          \
-  METRIC(FullGcDuration, MetricsCounter)
+  METRIC(FullGcDuration, MetricsCounter)                            \
+  METRIC(BootImagePrivateDirtyPages, MetricsCounter)                \
+  METRIC(GcPauseTime, MetricsHistogram, 15, 0, 50'000)              \
+  METRIC(GcMarkingPauseTime, MetricsHistogram, 15, 0, 50'000)       \
+  METRIC(GcCompactionPauseTime, MetricsHistogram, 15, 0, 50'000)    \
+  METRIC(GcFlipPauseTime, MetricsHistogram, 15, 0, 50'000)          \
+  METRIC(GcRefProcessingTime, MetricsHistogram, 15, 0, 50'000)      \
+  METRIC(GcUffdFaultTime, MetricsHistogram, 15, 0, 10'000)          \
+  METRIC(GcUffdMutatorPageCount, MetricsCounter)                    \
+  METRIC(GcUffdGcThreadPageCount, MetricsCounter)                   \
+  METRIC(GcUffdIoctlRetryCount, MetricsCounter)                     \
+  METRIC(GcUffdIoctlErrorCount, MetricsCounter)                     \
+  METRIC(GcForAllocCount, MetricsCounter)                           \
+  METRIC(GcBackgroundCount, MetricsCounter)                         \
+  METRIC(GcExplicitCount, MetricsCounter)                           \
+  METRIC(GcForNativeAllocCount, MetricsCounter)                     \
+  METRIC(GcOtherCauseCount, MetricsCounter)                         \
+  METRIC(MemMapPeakBytes, MetricsAccumulator, uint64_t, std::max<uint64_t>) \
+  METRIC(ArenaPoolPeakBytes, MetricsAccumulator, uint64_t, std::max<uint64_t>)
 
 // Increasing counter metrics, reported as Value Metrics in delta increments.
-#define ART_VALUE_METRICS(METRIC)                              \
-  METRIC(GcWorldStopTimeDelta, MetricsDeltaCounter)            \
-  METRIC(GcWorldStopCountDelta, MetricsDeltaCounter)           \
-  METRIC(YoungGcScannedBytesDelta, MetricsDeltaCounter)        \
-  METRIC(YoungGcFreedBytesDelta, MetricsDeltaCounter)          \
-  METRIC(YoungGcDurationDelta, MetricsDeltaCounter)            \
-  METRIC(FullGcScannedBytesDelta, MetricsDeltaCounter)         \
-  METRIC(FullGcFreedBytesDelta, MetricsDeltaCounter)           \
-  METRIC(FullGcDurationDelta, MetricsDeltaCounter)             \
-  METRIC(JitMethodCompileTotalTimeDelta, MetricsDeltaCounter)  \
-  METRIC(JitMethodCompileCountDelta, MetricsDeltaCounter)      \
-  METRIC(ClassVerificationTotalTimeDelta, MetricsDeltaCounter) \
-  METRIC(ClassVerificationCountDelta, MetricsDeltaCounter)     \
-  METRIC(ClassLoadingTotalTimeDelta, MetricsDeltaCounter)      \
-  METRIC(TotalBytesAllocatedDelta, MetricsDeltaCounter)        \
-  METRIC(TotalGcCollectionTimeDelta, MetricsDeltaCounter)      \
-  METRIC(YoungGcCountDelta, MetricsDeltaCounter)               \
-  METRIC(FullGcCountDelta, MetricsDeltaCounter)                \
+#define ART_VALUE_METRICS(METRIC)                                     \
+  METRIC(GcWorldStopTimeDelta, MetricsDeltaCounter)                   \
+  METRIC(GcWorldStopCountDelta, MetricsDeltaCounter)                  \
+  METRIC(YoungGcScannedBytesDelta, MetricsDeltaCounter)               \
+  METRIC(YoungGcFreedBytesDelta, MetricsDeltaCounter)                 \
+  METRIC(YoungGcDurationDelta, MetricsDeltaCounter)                   \
+  METRIC(FullGcScannedBytesDelta, MetricsDeltaCounter)                \
+  METRIC(FullGcFreedBytesDelta, MetricsDeltaCounter)                  \
+  METRIC(FullGcDurationDelta, MetricsDeltaCounter)                    \
+  METRIC(JitMethodCompileTotalTimeDelta, MetricsDeltaCounter)         \
+  METRIC(JitMethodCompileCountDelta, MetricsDeltaCounter)             \
+  METRIC(JitThrottledTimeDelta, MetricsDeltaCounter)                  \
+  METRIC(SwitchInterpreterMethodEntryCountDelta, MetricsDeltaCounter) \
+  METRIC(ClassVerificationTotalTimeDelta, MetricsDeltaCounter)        \
+  METRIC(ClassVerificationCountDelta, MetricsDeltaCounter)            \
+  METRIC(ClassLoadingTotalTimeDelta, MetricsDeltaCounter)             \
+  METRIC(TotalBytesAllocatedDelta, MetricsDeltaCounter)               \
+  METRIC(TotalGcCollectionTimeDelta, MetricsDeltaCounter)             \
+  METRIC(YoungGcCountDelta, MetricsDeltaCounter)                      \
+  METRIC(FullGcCountDelta, MetricsDeltaCounter)                       \
   METRIC(TimeElapsedDelta, MetricsDeltaCounter)
 
 #define ART_METRICS(METRIC) \
@@ -533,8 +566,10 @@ class MetricsAccumulator final : MetricsBase<T> {
   }
 
   // Report the metric as a counter, since this has only a single value.
-  void Report(MetricsBackend* backend) const {
-    backend->ReportCounter(datum_id, static_cast<uint64_t>(Value()));
+  void Report(const std::vector<MetricsBackend*>& backends) const {
+    for (MetricsBackend* backend : backends) {
+      backend->ReportCounter(datum_id, static_cast<uint64_t>(Value()));
+    }
   }
 
  protected:
@@ -29,7 +29,10 @@ ArenaStack::ArenaStack(ArenaPool* arena_pool)
     bottom_arena_(nullptr),
     top_arena_(nullptr),
     top_ptr_(nullptr),
-    top_end_(nullptr) {
+    top_end_(nullptr),
+    top_base_bytes_(0u),
+    peak_bytes_used_(0u),
+    free_lists_() {
 }
 
 ArenaStack::~ArenaStack() {
@@ -44,6 +47,9 @@ void ArenaStack::Reset() {
   top_arena_  = nullptr;
   top_ptr_ = nullptr;
   top_end_ = nullptr;
+  top_base_bytes_ = 0u;
+  peak_bytes_used_ = 0u;
+  free_lists_ = FreeLists();
 }
 
 MemStats ArenaStack::GetPeakStats() const {
@@ -57,9 +63,12 @@ uint8_t* ArenaStack::AllocateFromNextArena(size_t rounded_bytes) {
   if (UNLIKELY(top_arena_ == nullptr)) {
     top_arena_ = bottom_arena_ = stats_and_pool_.pool->AllocArena(allocation_size);
     top_arena_->next_ = nullptr;
+    top_base_bytes_ = 0u;
   } else if (top_arena_->next_ != nullptr && top_arena_->next_->Size() >= allocation_size) {
+    top_base_bytes_ += top_arena_->Size();
     top_arena_ = top_arena_->next_;
   } else {
+    top_base_bytes_ += top_arena_->Size();
     Arena* tail = top_arena_->next_;
     top_arena_->next_ = stats_and_pool_.pool->AllocArena(allocation_size);
     top_arena_ = top_arena_->next_;
@@ -70,6 +79,41 @@ uint8_t* ArenaStack::AllocateFromNextArena(size_t rounded_bytes) {
   return top_arena_->Begin();
 }
 
+void* ArenaStack::AllocFromFreeList(size_t bytes) {
+  size_t rounded_bytes = RoundUp(bytes, kAlignment);
+  if (rounded_bytes > kMaxRecycledAllocationBytes) {
+    return nullptr;
+  }
+  // Every block on list `index` has at least `kMinRecycledBytes << index` usable bytes.
+  size_t index = (rounded_bytes <= kMinRecycledBytes)
+      ? 0u
+      : WhichPowerOf2(RoundUpToPowerOfTwo(rounded_bytes)) - WhichPowerOf2(kMinRecycledBytes);
+  DCHECK_LT(index, kNumFreeLists);
+  if ((free_lists_.non_empty & (1u << index)) == 0u) {
+    return nullptr;
+  }
+  void* ptr = free_lists_.heads[index];
+  DCHECK(ptr != nullptr);
+  free_lists_.heads[index] = *reinterpret_cast<void**>(ptr);
+  if (free_lists_.heads[index] == nullptr) {
+    free_lists_.non_empty &= ~(1u << index);
+  }
+  if (kIsDebugBuild) {
+    ArenaTagForAllocation(ptr) = ArenaFreeTag::kUsed;
+  }
+  return ptr;
+}
+
+void ArenaStack::AddToFreeList(void* ptr, size_t bytes) {
+  DCHECK_GE(bytes, kMinRecycledBytes);
+  DCHECK_ALIGNED(ptr, kAlignment);
+  size_t index = std::min<size_t>(
+      MostSignificantBit(bytes) - WhichPowerOf2(kMinRecycledBytes), kNumFreeLists - 1u);
+  *reinterpret_cast<void**>(ptr) = free_lists_.heads[index];
+  free_lists_.heads[index] = ptr;
+  free_lists_.non_empty |= 1u << index;
+}
+
 void ArenaStack::UpdatePeakStatsAndRestore(const ArenaAllocatorStats& restore_stats) {
   if (PeakStats()->BytesAllocated() < CurrentStats()->BytesAllocated()) {
     PeakStats()->Copy(*CurrentStats());
@@ -123,7 +167,9 @@ ScopedArenaAllocator::ScopedArenaAllocator(ScopedArenaAllocator&& other) noexcep
       arena_stack_(other.arena_stack_),
       mark_arena_(other.mark_arena_),
       mark_ptr_(other.mark_ptr_),
-      mark_end_(other.mark_end_) {
+      mark_end_(other.mark_end_),
+      mark_base_bytes_(other.mark_base_bytes_),
+      saved_free_lists_(other.saved_free_lists_) {
   other.DebugStackRefCounter::CheckNoRefs();
   other.arena_stack_ = nullptr;
   // NOLINTEND(bugprone-use-after-move)
@@ -136,12 +182,18 @@ ScopedArenaAllocator::ScopedArenaAllocator(ArenaStack* arena_stack)
       arena_stack_(arena_stack),
       mark_arena_(arena_stack->top_arena_),
       mark_ptr_(arena_stack->top_ptr_),
-      mark_end_(arena_stack->top_end_) {
+      mark_end_(arena_stack->top_end_),
+      mark_base_bytes_(arena_stack->top_base_bytes_),
+      saved_free_lists_(arena_stack->free_lists_) {
+  // Blocks freed by the enclosing scope must not be handed out to this one, the enclosing
+  // scope's list links would be overwritten.
+  arena_stack->free_lists_ = ArenaStack::FreeLists();
 }
 
 ScopedArenaAllocator::~ScopedArenaAllocator() {
   if (arena_stack_ != nullptr) {
     DoReset();
+    arena_stack_->free_lists_ = saved_free_lists_;
   }
 }
 
@@ -158,14 +210,19 @@ void ScopedArenaAllocator::DoReset() {
   DebugStackRefCounter::CheckNoRefs();
   arena_stack_->UpdatePeakStatsAndRestore(*this);
   arena_stack_->UpdateBytesAllocated();
+  // The stack only grows within a scope, so its peak usage is reached just before a reset.
+  arena_stack_->peak_bytes_used_ = arena_stack_->PeakBytesUsed();
+  arena_stack_->free_lists_ = ArenaStack::FreeLists();
   if (LIKELY(mark_arena_ != nullptr)) {
     arena_stack_->top_arena_ = mark_arena_;
     arena_stack_->top_ptr_ = mark_ptr_;
     arena_stack_->top_end_ = mark_end_;
+    arena_stack_->top_base_bytes_ = mark_base_bytes_;
   } else if (arena_stack_->bottom_arena_ != nullptr) {
     mark_arena_ = arena_stack_->top_arena_ = arena_stack_->bottom_arena_;
     mark_ptr_ = arena_stack_->top_ptr_ = mark_arena_->Begin();
     mark_end_ = arena_stack_->top_end_ = mark_arena_->End();
+    mark_base_bytes_ = arena_stack_->top_base_bytes_ = 0u;
   }
 }
 
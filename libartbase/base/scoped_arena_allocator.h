@@ -17,6 +17,9 @@
 #ifndef ART_LIBARTBASE_BASE_SCOPED_ARENA_ALLOCATOR_H_
 #define ART_LIBARTBASE_BASE_SCOPED_ARENA_ALLOCATOR_H_
 
+#include <algorithm>
+#include <array>
+
 #include <android-base/logging.h>
 
 #include "arena_allocator.h"
@@ -40,6 +43,11 @@ enum class ArenaFreeTag : uint8_t {
   kFree,
 };
 
+// Whether memory released by containers of the top ScopedArenaAllocator, such as the old storage
+// of a growing ScopedArenaVector, is kept on size-class free lists and reused by later
+// allocations in the same scope. Released memory is otherwise lost until the scope ends.
+static constexpr bool kArenaStackRecycleFreedMemory = true;
+
 // Holds a list of Arenas for use by ScopedArenaAllocator stack.
 // The memory is returned to the ArenaPool when the ArenaStack is destroyed.
 class ArenaStack : private DebugStackRefCounter, private ArenaAllocatorMemoryTool {
@@ -63,6 +71,26 @@ class ArenaStack : private DebugStackRefCounter, private ArenaAllocatorMemoryToo
 
   MemStats GetPeakStats() const;
 
+  // Bytes of the arenas below the top of the stack, including unused tails of lower arenas.
+  size_t CurrentBytesUsed() const {
+    return (top_arena_ != nullptr)
+        ? top_base_bytes_ + static_cast<size_t>(top_ptr_ - top_arena_->Begin())
+        : 0u;
+  }
+
+  // High-water mark of CurrentBytesUsed() since the last ResetPeakBytesUsed(). This is tracked
+  // even when ArenaAllocatorStats do not count allocations and can be used for per-pass peaks.
+  size_t PeakBytesUsed() const {
+    return std::max(peak_bytes_used_, CurrentBytesUsed());
+  }
+
+  // Restarts the peak tracking at max(`peak`, current usage) and returns the previous peak.
+  size_t ResetPeakBytesUsed(size_t peak = 0u) {
+    size_t old_peak = PeakBytesUsed();
+    peak_bytes_used_ = std::max(peak, CurrentBytesUsed());
+    return old_peak;
+  }
+
   // Return the arena tag associated with a pointer.
   static ArenaFreeTag& ArenaTagForAllocation(void* ptr) {
     DCHECK(kIsDebugBuild) << "Only debug builds have tags";
@@ -72,7 +100,19 @@ class ArenaStack : private DebugStackRefCounter, private ArenaAllocatorMemoryToo
   // The alignment guaranteed for individual allocations.
   static constexpr size_t kAlignment = 8u;
 
+  // Free list size classes are powers of two from kMinRecycledBytes, the last class also holds
+  // all bigger blocks. Smaller blocks are not recycled.
+  static constexpr size_t kMinRecycledBytes = 64u;
+  static constexpr size_t kNumFreeLists = 8u;
+  static constexpr size_t kMaxRecycledAllocationBytes = kMinRecycledBytes << (kNumFreeLists - 1u);
+
  private:
+  // Freed blocks of the top scope, linked through their first word.
+  struct FreeLists {
+    std::array<void*, kNumFreeLists> heads;
+    uint32_t non_empty;  // Bit mask of lists with at least one block.
+  };
+
   struct Peak;
   struct Current;
   template <typename Tag> struct TaggedStats : ArenaAllocatorStats { };
@@ -98,6 +138,12 @@ class ArenaStack : private DebugStackRefCounter, private ArenaAllocatorMemoryToo
     if (UNLIKELY(IsRunningOnMemoryTool())) {
       return AllocWithMemoryTool(bytes, kind);
     }
+    if (kArenaStackRecycleFreedMemory && UNLIKELY(free_lists_.non_empty != 0u)) {
+      void* recycled = AllocFromFreeList(bytes);
+      if (recycled != nullptr) {
+        return recycled;
+      }
+    }
     // Add kAlignment for the free or used tag. Required to preserve alignment.
     size_t rounded_bytes = RoundUp(bytes + (kIsDebugBuild ? kAlignment : 0u), kAlignment);
     uint8_t* ptr = top_ptr_;
@@ -113,6 +159,16 @@ class ArenaStack : private DebugStackRefCounter, private ArenaAllocatorMemoryToo
     return ptr;
   }
 
+  // Private - access via ScopedArenaAllocatorAdapter. Releases memory of the top scope.
+  void Free(void* ptr, size_t bytes) ALWAYS_INLINE {
+    MakeInaccessible(ptr, bytes);
+    if (kArenaStackRecycleFreedMemory && !IsRunningOnMemoryTool() && bytes >= kMinRecycledBytes) {
+      AddToFreeList(ptr, bytes);
+    }
+  }
+
+  void* AllocFromFreeList(size_t bytes);
+  void AddToFreeList(void* ptr, size_t bytes);
   uint8_t* AllocateFromNextArena(size_t rounded_bytes);
   void UpdatePeakStatsAndRestore(const ArenaAllocatorStats& restore_stats);
   void UpdateBytesAllocated();
@@ -123,6 +179,9 @@ class ArenaStack : private DebugStackRefCounter, private ArenaAllocatorMemoryToo
   Arena* top_arena_;
   uint8_t* top_ptr_;
   uint8_t* top_end_;
+  size_t top_base_bytes_;  // Sum of sizes of the arenas below `top_arena_`.
+  size_t peak_bytes_used_;
+  FreeLists free_lists_;
 
   friend class ScopedArenaAllocator;
   template <typename T>
@@ -178,6 +237,9 @@ class ScopedArenaAllocator
   Arena* mark_arena_;
   uint8_t* mark_ptr_;
   uint8_t* mark_end_;
+  size_t mark_base_bytes_;
+  // Free lists of the enclosing scope, restored when this allocator is destroyed.
+  ArenaStack::FreeLists saved_free_lists_;
 
   void DoReset();
 
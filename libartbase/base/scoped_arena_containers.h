@@ -193,7 +193,7 @@ class ScopedArenaAllocatorAdapter
   }
   void deallocate(pointer p, size_type n) {
     DebugStackIndirectTopRef::CheckTop();
-    arena_stack_->MakeInaccessible(p, sizeof(T) * n);
+    arena_stack_->Free(p, sizeof(T) * n);
   }
 
   template <typename U, typename... Args>
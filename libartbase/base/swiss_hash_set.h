@@ -0,0 +1,603 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_LIBARTBASE_BASE_SWISS_HASH_SET_H_
+#define ART_LIBARTBASE_BASE_SWISS_HASH_SET_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <android-base/logging.h>
+
+#include "bit_utils.h"
+#include "hash_set.h"
+#include "macros.h"
+
+namespace art {
+
+namespace swiss_hash_set {
+
+// Number of control bytes examined by one probe step, 16 fits one SSE2 or NEON register.
+static constexpr size_t kGroupWidth = 16u;
+
+// Control byte values. Full slots store the low 7 bits of the mixed hash, so they are
+// non-negative, while both special values have the sign bit set.
+static constexpr int8_t kCtrlEmpty = -128;
+static constexpr int8_t kCtrlDeleted = -2;
+
+// Iterates over the lanes matched in a group. A lane is represented by `1 << kShift` bits of
+// the mask, of which only the highest one is set.
+template <size_t kShift>
+class BitMask {
+ public:
+  explicit BitMask(uint64_t mask) : mask_(mask) {}
+
+  explicit operator bool() const { return mask_ != 0u; }
+
+  size_t LowestLane() const {
+    DCHECK_NE(mask_, 0u);
+    return static_cast<size_t>(CTZ(mask_)) >> kShift;
+  }
+
+  void ClearLowestLane() { mask_ &= mask_ - 1u; }
+
+ private:
+  uint64_t mask_;
+};
+
+#if defined(__SSE2__)
+
+class Group {
+ public:
+  using Mask = BitMask<0u>;
+
+  explicit Group(const int8_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  Mask Match(int8_t h2) const {
+    return Mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+  }
+
+  Mask MatchEmpty() const {
+    return Match(kCtrlEmpty);
+  }
+
+  Mask MatchEmptyOrDeleted() const {
+    return Mask(static_cast<uint32_t>(_mm_movemask_epi8(ctrl_)));
+  }
+
+ private:
+  __m128i ctrl_;
+};
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+class Group {
+ public:
+  using Mask = BitMask<2u>;
+
+  explicit Group(const int8_t* ctrl) : ctrl_(vld1q_s8(ctrl)) {}
+
+  Mask Match(int8_t h2) const {
+    return ToMask(vceqq_s8(ctrl_, vdupq_n_s8(h2)));
+  }
+
+  Mask MatchEmpty() const {
+    return Match(kCtrlEmpty);
+  }
+
+  Mask MatchEmptyOrDeleted() const {
+    return ToMask(vcltzq_s8(ctrl_));
+  }
+
+ private:
+  // Narrows the 0x00/0xff lanes to one nibble per lane, there is no NEON movemask.
+  static Mask ToMask(uint8x16_t lanes) {
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4);
+    return Mask(vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & UINT64_C(0x8888888888888888));
+  }
+
+  int8x16_t ctrl_;
+};
+
+#else
+
+// Portable version that matches 64-bit words of 8 control bytes (little-endian lanes).
+class Group {
+ public:
+  using Mask = BitMask<0u>;
+
+  explicit Group(const int8_t* ctrl) {
+    memcpy(words_, ctrl, kGroupWidth);
+  }
+
+  // May report a false positive for a lane next to a real match, callers check the element.
+  Mask Match(int8_t h2) const {
+    const uint64_t pattern = kLsbs * static_cast<uint8_t>(h2);
+    auto match = [pattern](uint64_t word) {
+      uint64_t x = word ^ pattern;
+      return (x - kLsbs) & ~x & kMsbs;
+    };
+    return Mask(Pack(match(words_[0])) | (Pack(match(words_[1])) << 8));
+  }
+
+  // kCtrlEmpty is the only control value with the sign bit set and bit 1 clear.
+  Mask MatchEmpty() const {
+    auto match = [](uint64_t word) { return word & ~(word << 6) & kMsbs; };
+    return Mask(Pack(match(words_[0])) | (Pack(match(words_[1])) << 8));
+  }
+
+  Mask MatchEmptyOrDeleted() const {
+    return Mask(Pack(words_[0] & kMsbs) | (Pack(words_[1] & kMsbs) << 8));
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = UINT64_C(0x0101010101010101);
+  static constexpr uint64_t kMsbs = UINT64_C(0x8080808080808080);
+
+  // Gather the sign bits of the 8 lanes into the low 8 bits.
+  static uint32_t Pack(uint64_t msbs) {
+    return static_cast<uint32_t>(((msbs >> 7) * UINT64_C(0x0102040810204080)) >> 56);
+  }
+
+  uint64_t words_[kGroupWidth / sizeof(uint64_t)];
+};
+
+#endif
+
+}  // namespace swiss_hash_set
+
+// Hash set with a separate array of one control byte per slot, in the style of the Swiss tables.
+// A control byte records whether the slot is empty, deleted or full, and for full slots 7 bits
+// of the element hash. Lookups compare a whole group of control bytes at once with SSE2 or NEON
+// and only call `Pred` for slots with a matching hash tag, which makes misses and long probe
+// sequences much cheaper than in `HashSet<>`, at the cost of one byte per slot.
+//
+// Elements do not need an empty value and erase() leaves a tombstone instead of shuffling
+// elements back, so erasing during iteration never visits an element twice.
+//
+// Unlike `HashSet<>`, the table cannot be written to or used in place from an image; the boot
+// and app image tables keep the `HashSet<>` layout.
+template <class T,
+          class HashFn = DefaultHashFn<T>,
+          class Pred = DefaultPred<T>,
+          class Alloc = std::allocator<T>>
+class SwissHashSet {
+ public:
+  using value_type = T;
+  using allocator_type = Alloc;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = HashSetIterator<T, SwissHashSet>;
+  using const_iterator = HashSetIterator<const T, const SwissHashSet>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  // Smallest non-zero number of slots, one group.
+  static constexpr size_t kMinCapacity = swiss_hash_set::kGroupWidth;
+
+  SwissHashSet() : SwissHashSet(allocator_type()) {}
+  explicit SwissHashSet(const allocator_type& alloc) noexcept
+      : SwissHashSet(HashFn(), Pred(), alloc) {}
+  SwissHashSet(const HashFn& hashfn,
+               const Pred& pred,
+               const allocator_type& alloc = allocator_type()) noexcept
+      : allocfn_(alloc),
+        hashfn_(hashfn),
+        pred_(pred),
+        num_elements_(0u),
+        capacity_(0u),
+        growth_left_(0u),
+        ctrl_(nullptr),
+        slots_(nullptr) {}
+
+  SwissHashSet(const SwissHashSet& other)
+      : SwissHashSet(other.hashfn_, other.pred_, other.allocfn_) {
+    reserve(other.size());
+    for (const T& element : other) {
+      Put(element);
+    }
+  }
+
+  // noexcept required so that the move constructor is used instead of copy constructor.
+  SwissHashSet(SwissHashSet&& other) noexcept
+      : allocfn_(std::move(other.allocfn_)),
+        hashfn_(std::move(other.hashfn_)),
+        pred_(std::move(other.pred_)),
+        num_elements_(other.num_elements_),
+        capacity_(other.capacity_),
+        growth_left_(other.growth_left_),
+        ctrl_(other.ctrl_),
+        slots_(other.slots_) {
+    other.num_elements_ = 0u;
+    other.capacity_ = 0u;
+    other.growth_left_ = 0u;
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+  }
+
+  ~SwissHashSet() {
+    DeallocateStorage();
+  }
+
+  SwissHashSet& operator=(SwissHashSet&& other) noexcept {
+    SwissHashSet(std::move(other)).swap(*this);  // NOLINT [runtime/explicit] [5]
+    return *this;
+  }
+
+  SwissHashSet& operator=(const SwissHashSet& other) {
+    SwissHashSet(other).swap(*this);  // NOLINT(runtime/explicit)
+    return *this;
+  }
+
+  void clear() {
+    DeallocateStorage();
+  }
+
+  iterator begin() {
+    return iterator(this, (capacity_ != 0u && IsFreeSlot(0u)) ? NextNonEmptySlot(0u) : 0u);
+  }
+
+  const_iterator begin() const {
+    return const_iterator(this, (capacity_ != 0u && IsFreeSlot(0u)) ? NextNonEmptySlot(0u) : 0u);
+  }
+
+  iterator end() {
+    return iterator(this, NumBuckets());
+  }
+
+  const_iterator end() const {
+    return const_iterator(this, NumBuckets());
+  }
+
+  size_t size() const {
+    return num_elements_;
+  }
+
+  bool empty() const {
+    return size() == 0u;
+  }
+
+  // Erase the element and return an iterator to the next one. The slot becomes a tombstone that
+  // is reused by later insertions or dropped when the table is rehashed.
+  iterator erase(iterator it) {
+    size_t index = it.index_;
+    DCHECK(!IsFreeSlot(index));
+    std::allocator_traits<allocator_type>::destroy(allocfn_, std::addressof(slots_[index]));
+    SetCtrl(index, swiss_hash_set::kCtrlDeleted);
+    --num_elements_;
+    return iterator(this, NextNonEmptySlot(index));
+  }
+
+  // Find an element, returns end() if not found. Allows custom key (K) types like `HashSet<>`.
+  template <typename K>
+  iterator find(const K& key) {
+    return FindWithHash(key, hashfn_(key));
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return FindWithHash(key, hashfn_(key));
+  }
+
+  template <typename K>
+  iterator FindWithHash(const K& key, size_t hash) {
+    return iterator(this, FindIndex(key, hash));
+  }
+
+  template <typename K>
+  const_iterator FindWithHash(const K& key, size_t hash) const {
+    return const_iterator(this, FindIndex(key, hash));
+  }
+
+  std::pair<iterator, bool> insert(const T& element) {
+    return InsertWithHash(element, hashfn_(element));
+  }
+  std::pair<iterator, bool> insert(T&& element) {
+    return InsertWithHash(std::move(element), hashfn_(element));
+  }
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
+  std::pair<iterator, bool> InsertWithHash(U&& element, size_t hash) {
+    DCHECK_EQ(hash, hashfn_(element));
+    size_t index = FindIndex(element, hash);
+    if (index != NumBuckets()) {
+      return std::make_pair(iterator(this, index), false);
+    }
+    index = PrepareInsert(hash);
+    std::allocator_traits<allocator_type>::construct(
+        allocfn_, std::addressof(slots_[index]), std::forward<U>(element));
+    return std::make_pair(iterator(this, index), true);
+  }
+
+  // Insert an element known not to be in the `SwissHashSet<>`.
+  void Put(const T& element) {
+    return PutWithHash(element, hashfn_(element));
+  }
+  void Put(T&& element) {
+    return PutWithHash(std::move(element), hashfn_(element));
+  }
+
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
+  void PutWithHash(U&& element, size_t hash) {
+    DCHECK_EQ(hash, hashfn_(element));
+    DCHECK_EQ(FindIndex(element, hash), NumBuckets());
+    size_t index = PrepareInsert(hash);
+    std::allocator_traits<allocator_type>::construct(
+        allocfn_, std::addressof(slots_[index]), std::forward<U>(element));
+  }
+
+  void swap(SwissHashSet& other) {
+    // Use argument-dependent lookup with fall-back to std::swap() for function objects.
+    using std::swap;
+    swap(allocfn_, other.allocfn_);
+    swap(hashfn_, other.hashfn_);
+    swap(pred_, other.pred_);
+    std::swap(num_elements_, other.num_elements_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+  }
+
+  allocator_type get_allocator() const {
+    return allocfn_;
+  }
+
+  // Reserve enough room to insert until size() == num_elements without requiring to grow the
+  // hash set. No-op if the hash set is already large enough to do this.
+  void reserve(size_t num_elements) {
+    if (num_elements <= num_elements_ + growth_left_) {
+      return;
+    }
+    size_t capacity = kMinCapacity;
+    while (MaxElements(capacity) < num_elements) {
+      capacity *= 2u;
+    }
+    Resize(capacity);
+  }
+
+  // Make sure that every element can be found from its hash. Returns the number of errors.
+  size_t Verify() const {
+    size_t errors = 0u;
+    for (size_t i = 0; i != capacity_; ++i) {
+      if (!IsFreeSlot(i)) {
+        size_t hash = hashfn_(slots_[i]);
+        if (ctrl_[i] != H2(Mix(hash)) || FindIndex(slots_[i], hash) != i) {
+          LOG(ERROR) << "Element " << i << " cannot be found from its hash";
+          ++errors;
+        }
+      }
+    }
+    return errors;
+  }
+
+  double CalculateLoadFactor() const {
+    return (capacity_ != 0u) ? static_cast<double>(size()) / static_cast<double>(capacity_) : 0.0;
+  }
+
+  size_t NumBuckets() const {
+    return capacity_;
+  }
+
+ private:
+  using CtrlAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<int8_t>;
+
+  // Control bytes past the end of the table that mirror the first ones, so that a group can be
+  // loaded from any slot index without wrapping around.
+  static constexpr size_t kNumClonedBytes = swiss_hash_set::kGroupWidth - 1u;
+
+  // The maximum load factor is 7/8, counting tombstones.
+  static constexpr size_t MaxElements(size_t capacity) {
+    return capacity - capacity / 8u;
+  }
+
+  // Spreads the hash to the high bits as well, `HashFn` for pointers and integers is often the
+  // identity and we use a power of two number of slots.
+  static uint64_t Mix(size_t hash) {
+    uint64_t mixed = static_cast<uint64_t>(hash) * UINT64_C(0x9e3779b97f4a7c15);
+    return mixed ^ (mixed >> 32);
+  }
+
+  // Start of the probe sequence.
+  static size_t H1(uint64_t mixed) {
+    return static_cast<size_t>(mixed >> 7);
+  }
+
+  // Hash tag stored in the control byte.
+  static int8_t H2(uint64_t mixed) {
+    return static_cast<int8_t>(mixed & 0x7fu);
+  }
+
+  T& ElementForIndex(size_t index) {
+    DCHECK_LT(index, NumBuckets());
+    return slots_[index];
+  }
+
+  const T& ElementForIndex(size_t index) const {
+    DCHECK_LT(index, NumBuckets());
+    return slots_[index];
+  }
+
+  bool IsFreeSlot(size_t index) const {
+    DCHECK_LT(index, NumBuckets());
+    return ctrl_[index] < 0;
+  }
+
+  size_t NextNonEmptySlot(size_t index) const {
+    const size_t num_buckets = NumBuckets();
+    DCHECK_LT(index, num_buckets);
+    do {
+      ++index;
+    } while (index < num_buckets && IsFreeSlot(index));
+    return index;
+  }
+
+  void SetCtrl(size_t index, int8_t value) {
+    ctrl_[index] = value;
+    if (index < kNumClonedBytes) {
+      ctrl_[capacity_ + index] = value;
+    }
+  }
+
+  // Find the slot of an element, or return NumBuckets() if not found.
+  // The probe sequence visits groups at triangular offsets, which covers all the slots of a
+  // power of two table. There is always an empty slot, so that a miss terminates.
+  template <typename K>
+  ALWAYS_INLINE size_t FindIndex(const K& key, size_t hash) const {
+    DCHECK_EQ(hashfn_(key), hash);
+    if (UNLIKELY(capacity_ == 0u)) {
+      return 0u;
+    }
+    const uint64_t mixed = Mix(hash);
+    const int8_t h2 = H2(mixed);
+    const size_t mask = capacity_ - 1u;
+    size_t pos = H1(mixed) & mask;
+    for (size_t step = swiss_hash_set::kGroupWidth; ; step += swiss_hash_set::kGroupWidth) {
+      swiss_hash_set::Group group(ctrl_ + pos);
+      for (auto match = group.Match(h2); match; match.ClearLowestLane()) {
+        size_t index = (pos + match.LowestLane()) & mask;
+        if (LIKELY(pred_(slots_[index], key))) {
+          return index;
+        }
+      }
+      if (LIKELY(group.MatchEmpty())) {
+        return capacity_;
+      }
+      pos = (pos + step) & mask;
+      DCHECK_LE(step, capacity_ + swiss_hash_set::kGroupWidth);  // Don't loop forever.
+    }
+  }
+
+  // Return the first empty or deleted slot in the probe sequence for `mixed`.
+  size_t FindFirstNonFull(uint64_t mixed) const {
+    DCHECK_NE(capacity_, 0u);
+    const size_t mask = capacity_ - 1u;
+    size_t pos = H1(mixed) & mask;
+    for (size_t step = swiss_hash_set::kGroupWidth; ; step += swiss_hash_set::kGroupWidth) {
+      auto match = swiss_hash_set::Group(ctrl_ + pos).MatchEmptyOrDeleted();
+      if (LIKELY(match)) {
+        return (pos + match.LowestLane()) & mask;
+      }
+      pos = (pos + step) & mask;
+      DCHECK_LE(step, capacity_ + swiss_hash_set::kGroupWidth);  // Don't loop forever.
+    }
+  }
+
+  // Mark a slot as full for a new element with the given hash and return its index. Reusing a
+  // tombstone does not consume growth since the slot was already counted.
+  size_t PrepareInsert(size_t hash) {
+    const uint64_t mixed = Mix(hash);
+    size_t index = (capacity_ != 0u) ? FindFirstNonFull(mixed) : 0u;
+    if (UNLIKELY(capacity_ == 0u ||
+                 (growth_left_ == 0u && ctrl_[index] != swiss_hash_set::kCtrlDeleted))) {
+      // Drop the tombstones if they take at least half of the table, otherwise grow.
+      if (capacity_ != 0u && num_elements_ + 1u <= MaxElements(capacity_) / 2u) {
+        Resize(capacity_);
+      } else {
+        Resize(capacity_ != 0u ? capacity_ * 2u : kMinCapacity);
+      }
+      index = FindFirstNonFull(mixed);
+    }
+    if (ctrl_[index] == swiss_hash_set::kCtrlEmpty) {
+      DCHECK_NE(growth_left_, 0u);
+      --growth_left_;
+    }
+    SetCtrl(index, H2(mixed));
+    ++num_elements_;
+    return index;
+  }
+
+  // Rehash all elements into a new table with `new_capacity` slots, dropping tombstones.
+  void Resize(size_t new_capacity) {
+    DCHECK(IsPowerOfTwo(new_capacity));
+    DCHECK_GE(MaxElements(new_capacity), num_elements_);
+    int8_t* const old_ctrl = ctrl_;
+    T* const old_slots = slots_;
+    const size_t old_capacity = capacity_;
+
+    CtrlAlloc ctrl_alloc(allocfn_);
+    ctrl_ = ctrl_alloc.allocate(new_capacity + kNumClonedBytes);
+    memset(ctrl_, swiss_hash_set::kCtrlEmpty, new_capacity + kNumClonedBytes);
+    slots_ = allocfn_.allocate(new_capacity);
+    capacity_ = new_capacity;
+    growth_left_ = MaxElements(new_capacity) - num_elements_;
+    for (size_t i = 0; i != old_capacity; ++i) {
+      if (old_ctrl[i] >= 0) {
+        T& element = old_slots[i];
+        uint64_t mixed = Mix(hashfn_(element));
+        size_t index = FindFirstNonFull(mixed);
+        SetCtrl(index, H2(mixed));
+        std::allocator_traits<allocator_type>::construct(
+            allocfn_, std::addressof(slots_[index]), std::move(element));
+        std::allocator_traits<allocator_type>::destroy(allocfn_, std::addressof(element));
+      }
+    }
+    if (old_capacity != 0u) {
+      ctrl_alloc.deallocate(old_ctrl, old_capacity + kNumClonedBytes);
+      allocfn_.deallocate(old_slots, old_capacity);
+    }
+  }
+
+  void DeallocateStorage() {
+    if (capacity_ != 0u) {
+      for (size_t i = 0; i != capacity_; ++i) {
+        if (!IsFreeSlot(i)) {
+          std::allocator_traits<allocator_type>::destroy(allocfn_, std::addressof(slots_[i]));
+        }
+      }
+      CtrlAlloc(allocfn_).deallocate(ctrl_, capacity_ + kNumClonedBytes);
+      allocfn_.deallocate(slots_, capacity_);
+    }
+    num_elements_ = 0u;
+    capacity_ = 0u;
+    growth_left_ = 0u;
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+  }
+
+  Alloc allocfn_;  // Allocator function.
+  HashFn hashfn_;  // Hashing function.
+  Pred pred_;  // Equals function.
+  size_t num_elements_;  // Number of inserted elements.
+  size_t capacity_;  // Number of slots, zero or a power of two.
+  size_t growth_left_;  // Number of empty slots that can be filled before we rehash.
+  int8_t* ctrl_;  // Control bytes, `capacity_ + kNumClonedBytes` of them.
+  T* slots_;  // Element storage, only full slots hold constructed elements.
+
+  template <class Elem, class HashSetType>
+  friend class HashSetIterator;
+};
+
+template <class T, class HashFn, class Pred, class Alloc>
+void swap(SwissHashSet<T, HashFn, Pred, Alloc>& lhs, SwissHashSet<T, HashFn, Pred, Alloc>& rhs) {
+  lhs.swap(rhs);
+}
+
+}  // namespace art
+
+#endif  // ART_LIBARTBASE_BASE_SWISS_HASH_SET_H_
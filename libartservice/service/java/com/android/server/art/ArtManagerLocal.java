@@ -43,10 +43,12 @@ import android.content.BroadcastReceiver;
 import android.content.Context;
 import android.content.Intent;
 import android.content.IntentFilter;
+import android.os.BatteryManager;
 import android.os.Binder;
 import android.os.Build;
 import android.os.CancellationSignal;
 import android.os.ParcelFileDescriptor;
+import android.os.PowerManager;
 import android.os.Process;
 import android.os.RemoteException;
 import android.os.ServiceSpecificException;
@@ -487,7 +489,7 @@ public final class ArtManagerLocal {
         Utils.check(params.getDexoptParams().getReason().equals(reason));
 
         ExecutorService dexoptExecutor =
-                Executors.newFixedThreadPool(ReasonMapping.getConcurrencyForReason(reason));
+                Executors.newFixedThreadPool(getConcurrencyForBatchDexopt(reason));
         Map<Integer, DexoptResult> dexoptResults = new HashMap<>();
         mCleanupLock.readLock().lock();
         try (var pin = mInjector.createArtdPin()) {
@@ -1309,6 +1311,10 @@ public final class ArtManagerLocal {
                 // all packages when pm.dexopt.downgrade_after_inactive_days
                 // is set. See aosp/3237478 for more details.
                 break;
+            case ReasonMapping.REASON_BG_DEXOPT:
+                packages = sortByDexoptBenefit(filterAndSortByLastActiveTime(
+                        packages, true /* keepRecent */, true /* descending */));
+                break;
             default:
                 // Actually, the sorting is only needed for background dexopt, but we do it for all
                 // cases for simplicity.
@@ -1341,6 +1347,83 @@ public final class ArtManagerLocal {
                 .map(pair -> pair.first);
     }
 
+    /**
+     * Sorts packages so that the ones that benefit the most from background dexopt come first, in
+     * case the maintenance window is too short to dexopt all of them. Packages are ordered by the
+     * hour in which they were last active, most recent first, then by the size of their current
+     * profiles, largest first, as that is where the new hot code is, and then by the size of their
+     * dex files, smallest first, as an estimate of the compilation time.
+     */
+    @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
+    @NonNull
+    private Stream<PackageState> sortByDexoptBenefit(@NonNull Stream<PackageState> packages) {
+        List<UserHandle> userHandles =
+                mInjector.getUserManager().getUserHandles(true /* excludeDying */);
+        return packages
+                .map(pkgState
+                        -> new DexoptBenefit(pkgState,
+                                TimeUnit.MILLISECONDS.toHours(Utils.getPackageLastActiveTime(
+                                        pkgState, mInjector.getDexUseManager(),
+                                        mInjector.getUserManager())),
+                                getCurProfilesSize(pkgState, userHandles),
+                                getPrimaryDexFilesSize(pkgState)))
+                .sorted(Comparator
+                                .comparingLong((DexoptBenefit benefit) -> -benefit.lastActiveHour())
+                                .thenComparingLong(benefit -> -benefit.curProfilesSize())
+                                .thenComparingLong(DexoptBenefit::dexFilesSize))
+                .map(DexoptBenefit::pkgState);
+    }
+
+    @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
+    private long getCurProfilesSize(
+            @NonNull PackageState pkgState, @NonNull List<UserHandle> userHandles) {
+        long size = 0;
+        try {
+            for (PrimaryDexInfo dexInfo :
+                    PrimaryDexUtils.getDexInfo(Utils.getPackageOrThrow(pkgState))) {
+                for (ProfilePath profile :
+                        PrimaryDexUtils.getCurProfiles(userHandles, pkgState, dexInfo)) {
+                    size += mInjector.getArtd().getProfileSize(profile);
+                }
+            }
+        } catch (RemoteException e) {
+            Utils.logArtdException(e);
+        }
+        return size;
+    }
+
+    @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
+    private long getPrimaryDexFilesSize(@NonNull PackageState pkgState) {
+        long size = 0;
+        for (PrimaryDexInfo dexInfo :
+                PrimaryDexUtils.getDexInfo(Utils.getPackageOrThrow(pkgState))) {
+            // Returns 0 if the file doesn't exist.
+            size += new File(dexInfo.dexPath()).length();
+        }
+        return size;
+    }
+
+    /**
+     * Returns the number of packages to dexopt in parallel for {@link #dexoptPackages}. For
+     * background dexopt, the concurrency is reduced to 1 when the device is thermally throttled or
+     * not charging, so that dexopt doesn't heat up the device or drain the battery further.
+     */
+    @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
+    private int getConcurrencyForBatchDexopt(@NonNull @BatchDexoptReason String reason) {
+        int concurrency = ReasonMapping.getConcurrencyForReason(reason);
+        if (concurrency > 1 && reason.equals(ReasonMapping.REASON_BG_DEXOPT)) {
+            int thermalStatus = mInjector.getCurrentThermalStatus();
+            boolean isCharging = mInjector.isCharging();
+            if (thermalStatus >= PowerManager.THERMAL_STATUS_MODERATE || !isCharging) {
+                AsLog.i(String.format("Reducing concurrency from %d to 1 (thermalStatus=%d, "
+                                + "isCharging=%b)",
+                        concurrency, thermalStatus, isCharging));
+                return 1;
+            }
+        }
+        return concurrency;
+    }
+
     @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
     @NonNull
     private ParcelFileDescriptor mergeProfilesAndGetFd(@NonNull List<ProfilePath> profiles,
@@ -1524,6 +1607,10 @@ public final class ArtManagerLocal {
         }
     }
 
+    /** The signals used to order packages for background dexopt. */
+    private record DexoptBenefit(@NonNull PackageState pkgState, long lastActiveHour,
+            long curProfilesSize, long dexFilesSize) {}
+
     /**
      * Injector pattern for testing purpose.
      *
@@ -1686,6 +1773,18 @@ public final class ArtManagerLocal {
             return Objects.requireNonNull(mContext.getSystemService(StorageManager.class));
         }
 
+        @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
+        public int getCurrentThermalStatus() {
+            return Objects.requireNonNull(mContext.getSystemService(PowerManager.class))
+                    .getCurrentThermalStatus();
+        }
+
+        @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
+        public boolean isCharging() {
+            return Objects.requireNonNull(mContext.getSystemService(BatteryManager.class))
+                    .isCharging();
+        }
+
         @RequiresApi(Build.VERSION_CODES.UPSIDE_DOWN_CAKE)
         @NonNull
         public String getTempDir() {
@@ -56,6 +56,7 @@ import dalvik.system.DexFile;
 
 import com.google.auto.value.AutoValue;
 
+import java.io.File;
 import java.io.IOException;
 import java.util.ArrayList;
 import java.util.List;
@@ -70,6 +71,11 @@ import java.util.regex.Pattern;
 public abstract class Dexopter<DexInfoType extends DetailedDexInfo> {
     private static final List<String> ART_PACKAGE_NAMES =
             List.of("com.google.android.art", "com.android.art", "com.google.android.go.art");
+    /**
+     * The default minimum size of a dex file, in bytes, for background dexopt to checkpoint its
+     * verification. See {@link #shouldCheckpointVerification}.
+     */
+    private static final long DEFAULT_CHECKPOINT_DEX_SIZE_BYTES = 100 * 1024 * 1024;
 
     @NonNull protected final Injector mInjector;
     @NonNull protected final PackageState mPkgState;
@@ -230,6 +236,10 @@ public abstract class Dexopter<DexInfoType extends DetailedDexInfo> {
                             }
                         }
 
+                        // In Pre-reboot Dexopt, artd runs against the new system image, so this
+                        // checks the existing artifacts against the new boot classpath. The ones
+                        // that are still valid are kept for use after the reboot, and a VDEX file
+                        // that is still usable is passed to dex2oat.
                         GetDexoptNeededResult getDexoptNeededResult =
                                 getDexoptNeeded(target, options);
 
@@ -268,15 +278,34 @@ public abstract class Dexopter<DexInfoType extends DetailedDexInfo> {
                             }
                         });
 
-                        ArtdDexoptResult dexoptResult = dexoptFile(target, profile,
-                                getDexoptNeededResult, permissionSettings,
-                                mParams.getPriorityClass(), dexoptOptions, artdCancellationSignal);
+                        ArtdDexoptResult checkpointResult = null;
+                        if (shouldCheckpointVerification(target, getDexoptNeededResult)) {
+                            checkpointResult = checkpointVerification(target,
+                                    getDexoptNeededResult, permissionSettings,
+                                    artdCancellationSignal);
+                            if (!checkpointResult.cancelled) {
+                                // The VDEX file just created is now usable as input.
+                                getDexoptNeededResult = getDexoptNeeded(target, options);
+                            }
+                        }
+
+                        ArtdDexoptResult dexoptResult =
+                                (checkpointResult != null && checkpointResult.cancelled)
+                                ? checkpointResult
+                                : dexoptFile(target, profile, getDexoptNeededResult,
+                                        permissionSettings, mParams.getPriorityClass(),
+                                        dexoptOptions, artdCancellationSignal);
                         status = dexoptResult.cancelled ? DexoptResult.DEXOPT_CANCELLED
                                                         : DexoptResult.DEXOPT_PERFORMED;
                         wallTimeMs = dexoptResult.wallTimeMs;
                         cpuTimeMs = dexoptResult.cpuTimeMs;
                         sizeBytes = dexoptResult.sizeBytes;
                         sizeBeforeBytes = dexoptResult.sizeBeforeBytes;
+                        if (checkpointResult != null && dexoptResult != checkpointResult) {
+                            wallTimeMs += checkpointResult.wallTimeMs;
+                            cpuTimeMs += checkpointResult.cpuTimeMs;
+                            sizeBeforeBytes = checkpointResult.sizeBeforeBytes;
+                        }
                         dex2OatResult = dexoptResult.cancelled ? Dex2OatResult.cancelled()
                                                                : Dex2OatResult.exited(0);
 
@@ -608,6 +637,50 @@ public abstract class Dexopter<DexInfoType extends DetailedDexInfo> {
         return result;
     }
 
+    /**
+     * Returns true if the dex file should first be dexopted with the "verify" filter, before being
+     * compiled with the target filter.
+     *
+     * Background dexopt can be cancelled at any time, and a cancelled dex2oat invocation leaves
+     * nothing behind. For huge dex files, the next job run may then be cancelled again at the same
+     * point, so the dex file never gets compiled. Committing "verify" artifacts first acts as a
+     * checkpoint: the VDEX file is usable by the runtime right away, and later attempts pass it to
+     * dex2oat so that they only spend the idle window on compilation.
+     */
+    private boolean shouldCheckpointVerification(@NonNull DexoptTarget<DexInfoType> target,
+            @NonNull GetDexoptNeededResult getDexoptNeededResult) {
+        if (!mParams.getReason().equals(ReasonMapping.REASON_BG_DEXOPT)
+                || !DexFile.isOptimizedCompilerFilter(target.compilerFilter())
+                || getDexoptNeededResult.isVdexUsable || target.dmPath() != null) {
+            return false;
+        }
+        long thresholdBytes = SystemProperties.getLong(
+                "dalvik.vm.bgdexopt.checkpoint-dex-size", DEFAULT_CHECKPOINT_DEX_SIZE_BYTES);
+        return thresholdBytes >= 0
+                && new File(target.dexInfo().dexPath()).length() >= thresholdBytes;
+    }
+
+    @NonNull
+    private ArtdDexoptResult checkpointVerification(@NonNull DexoptTarget<DexInfoType> target,
+            @NonNull GetDexoptNeededResult getDexoptNeededResult,
+            @NonNull PermissionSettings permissionSettings,
+            @NonNull IArtdCancellationSignal artdCancellationSignal) throws RemoteException {
+        AsLog.i(String.format("Checkpointing verification [packageName = %s, dexPath = %s, "
+                        + "isa = %s]",
+                mPkgState.getPackageName(), target.dexInfo().dexPath(), target.isa()));
+        var verifyTarget = DexoptTarget.<DexInfoType>builder()
+                                   .setDexInfo(target.dexInfo())
+                                   .setIsa(target.isa())
+                                   .setIsInDalvikCache(target.isInDalvikCache())
+                                   .setCompilerFilter("verify")
+                                   .setDmPath(target.dmPath())
+                                   .build();
+        return dexoptFile(verifyTarget, null /* profile */, getDexoptNeededResult,
+                permissionSettings, mParams.getPriorityClass(),
+                getDexoptOptions(target.dexInfo(), false /* isProfileGuidedFilter */),
+                artdCancellationSignal);
+    }
+
     @Nullable
     private VdexPath getInputVdex(@NonNull GetDexoptNeededResult getDexoptNeededResult,
             @NonNull String dexPath, @NonNull String isa) {
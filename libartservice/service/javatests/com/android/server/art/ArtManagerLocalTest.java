@@ -605,6 +605,31 @@ public class ArtManagerLocalTest {
                         any(), any(), any(), any());
     }
 
+    @Test
+    public void testDexoptPackagesSortedByCurProfilesSize() throws Exception {
+        // Both packages were last active in the same hour, but PKG_NAME_1 has larger current
+        // profiles.
+        lenient()
+                .when(mArtd.getProfileSize(argThat(profile
+                        -> profile.getTag() == ProfilePath.primaryCurProfilePath
+                                && profile.getPrimaryCurProfilePath().packageName.equals(
+                                        PKG_NAME_1))))
+                .thenReturn(1024l);
+
+        var dexoptResult = DexoptResult.create();
+        var cancellationSignal = new CancellationSignal();
+
+        doReturn(dexoptResult)
+                .when(mDexoptHelper)
+                .dexopt(any(), deepEq(List.of(PKG_NAME_1, PKG_NAME_2)),
+                        argThat(params -> params.getReason().equals("bg-dexopt")),
+                        same(cancellationSignal), any(), any(), any());
+
+        assertThat(mArtManagerLocal.dexoptPackages(mSnapshot, "bg-dexopt", cancellationSignal,
+                           null /* processCallbackExecutor */, null /* processCallback */))
+                .isEqualTo(Map.of(ArtFlags.PASS_MAIN, dexoptResult));
+    }
+
     @Test
     public void testDexoptPackagesRecentlyInstalled() throws Exception {
         // The package is recently installed but hasn't been used.
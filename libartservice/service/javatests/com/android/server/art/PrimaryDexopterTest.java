@@ -23,6 +23,7 @@ import static com.google.common.truth.Truth.assertThat;
 
 import static org.mockito.Mockito.any;
 import static org.mockito.Mockito.anyInt;
+import static org.mockito.Mockito.anyLong;
 import static org.mockito.Mockito.argThat;
 import static org.mockito.Mockito.doAnswer;
 import static org.mockito.Mockito.doReturn;
@@ -39,6 +40,7 @@ import static org.mockito.Mockito.when;
 
 import android.os.Process;
 import android.os.ServiceSpecificException;
+import android.os.SystemProperties;
 import android.os.UserHandle;
 
 import androidx.test.filters.SmallTest;
@@ -890,6 +892,120 @@ public class PrimaryDexopterTest extends PrimaryDexopterTestBase {
         assertThat(results.get(1).getAbi()).isEqualTo("armeabi-v7a");
     }
 
+    @Test
+    public void testDexoptPreRebootReusesValidArtifacts() throws Exception {
+        when(mInjector.isPreReboot()).thenReturn(true);
+        // In Pre-reboot Dexopt, artd checks the existing artifacts against the new boot classpath.
+        // The ones that are still valid are kept as is.
+        doReturn(dexoptIsNotNeeded())
+                .when(mArtd)
+                .getDexoptNeeded(eq(mDexPath), any(), any(), any(), anyInt());
+
+        mPrimaryDexopter =
+                new PrimaryDexopter(mInjector, mPkgState, mPkg, mDexoptParams, mCancellationSignal);
+
+        List<DexContainerFileDexoptResult> results = mPrimaryDexopter.dexopt();
+        assertThat(results).hasSize(4);
+        assertThat(results.get(0).getStatus()).isEqualTo(DexoptResult.DEXOPT_SKIPPED);
+        assertThat(results.get(1).getStatus()).isEqualTo(DexoptResult.DEXOPT_SKIPPED);
+        assertThat(results.get(2).getStatus()).isEqualTo(DexoptResult.DEXOPT_PERFORMED);
+        assertThat(results.get(3).getStatus()).isEqualTo(DexoptResult.DEXOPT_PERFORMED);
+
+        verify(mArtd, never())
+                .dexopt(any(), eq(mDexPath), any(), any(), any(), any(), any(), any(), anyInt(),
+                        any(), any());
+    }
+
+    @Test
+    public void testDexoptPreRebootInputVdex() throws Exception {
+        when(mInjector.isPreReboot()).thenReturn(true);
+        // The VDEX file of the existing artifacts is passed to dex2oat when it's still usable, so
+        // that dex2oat doesn't verify the dex file again.
+        doReturn(dexoptIsNeeded(ArtifactsLocation.NEXT_TO_DEX))
+                .when(mArtd)
+                .getDexoptNeeded(eq(mDexPath), eq("arm64"), any(), any(), anyInt());
+
+        mPrimaryDexopter =
+                new PrimaryDexopter(mInjector, mPkgState, mPkg, mDexoptParams, mCancellationSignal);
+
+        mPrimaryDexopter.dexopt();
+
+        verify(mArtd).dexopt(any(), eq(mDexPath), eq("arm64"), any(), any(), any(),
+                deepEq(VdexPath.artifactsPath(AidlUtils.buildArtifactsPathAsInput(
+                        mDexPath, "arm64", false /* isInDalvikCache */))),
+                any(), anyInt(), any(), any());
+    }
+
+    @Test
+    public void testDexoptCheckpointsVerification() throws Exception {
+        lenient()
+                .when(SystemProperties.getLong(
+                        eq("dalvik.vm.bgdexopt.checkpoint-dex-size"), anyLong()))
+                .thenReturn(0l);
+        // After the checkpoint, the VDEX file is usable.
+        when(mArtd.getDexoptNeeded(eq(mDexPath), eq("arm64"), any(), any(), anyInt()))
+                .thenReturn(dexoptIsNeeded())
+                .thenReturn(dexoptIsNeeded(ArtifactsLocation.NEXT_TO_DEX));
+
+        mDexoptParams = new DexoptParams.Builder("bg-dexopt").setCompilerFilter("speed").build();
+        mPrimaryDexopter =
+                new PrimaryDexopter(mInjector, mPkgState, mPkg, mDexoptParams, mCancellationSignal);
+
+        List<DexContainerFileDexoptResult> results = mPrimaryDexopter.dexopt();
+        assertThat(results.get(0).getStatus()).isEqualTo(DexoptResult.DEXOPT_PERFORMED);
+        assertThat(results.get(0).getActualCompilerFilter()).isEqualTo("speed");
+
+        InOrder inOrder = inOrder(mArtd);
+        inOrder.verify(mArtd).dexopt(any(), eq(mDexPath), eq("arm64"), any(), eq("verify"),
+                isNull(), isNull(), any(), anyInt(), any(), any());
+        inOrder.verify(mArtd).dexopt(any(), eq(mDexPath), eq("arm64"), any(), eq("speed"),
+                isNull(),
+                deepEq(VdexPath.artifactsPath(AidlUtils.buildArtifactsPathAsInput(
+                        mDexPath, "arm64", false /* isInDalvikCache */))),
+                any(), anyInt(), any(), any());
+    }
+
+    @Test
+    public void testDexoptCheckpointsVerificationCancelled() throws Exception {
+        lenient()
+                .when(SystemProperties.getLong(
+                        eq("dalvik.vm.bgdexopt.checkpoint-dex-size"), anyLong()))
+                .thenReturn(0l);
+        when(mArtd.dexopt(any(), eq(mDexPath), eq("arm64"), any(), eq("verify"), any(), any(),
+                     any(), anyInt(), any(), any()))
+                .thenReturn(createArtdDexoptResult(true /* cancelled */));
+
+        mDexoptParams = new DexoptParams.Builder("bg-dexopt").setCompilerFilter("speed").build();
+        mPrimaryDexopter =
+                new PrimaryDexopter(mInjector, mPkgState, mPkg, mDexoptParams, mCancellationSignal);
+
+        List<DexContainerFileDexoptResult> results = mPrimaryDexopter.dexopt();
+        assertThat(results).hasSize(1);
+        assertThat(results.get(0).getStatus()).isEqualTo(DexoptResult.DEXOPT_CANCELLED);
+
+        verify(mArtd, never())
+                .dexopt(any(), any(), any(), any(), eq("speed"), any(), any(), any(), anyInt(),
+                        any(), any());
+    }
+
+    @Test
+    public void testDexoptNoCheckpointForNonBgDexopt() throws Exception {
+        lenient()
+                .when(SystemProperties.getLong(
+                        eq("dalvik.vm.bgdexopt.checkpoint-dex-size"), anyLong()))
+                .thenReturn(0l);
+
+        mDexoptParams = new DexoptParams.Builder("install").setCompilerFilter("speed").build();
+        mPrimaryDexopter =
+                new PrimaryDexopter(mInjector, mPkgState, mPkg, mDexoptParams, mCancellationSignal);
+
+        mPrimaryDexopter.dexopt();
+
+        verify(mArtd, never())
+                .dexopt(any(), any(), any(), any(), eq("verify"), any(), any(), any(), anyInt(),
+                        any(), any());
+    }
+
     @Test
     public void testDexoptPreRebootArtifactsExist() throws Exception {
         when(mInjector.isPreReboot()).thenReturn(true);
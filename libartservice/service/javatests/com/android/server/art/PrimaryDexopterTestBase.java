@@ -18,6 +18,7 @@ package com.android.server.art;
 
 import static org.mockito.Mockito.any;
 import static org.mockito.Mockito.anyBoolean;
+import static org.mockito.Mockito.anyLong;
 import static org.mockito.Mockito.argThat;
 import static org.mockito.Mockito.eq;
 import static org.mockito.Mockito.lenient;
@@ -105,6 +106,11 @@ public class PrimaryDexopterTestBase {
                 .thenReturn(false);
         lenient().when(SystemProperties.get("dalvik.vm.appimageformat")).thenReturn("lz4");
         lenient().when(SystemProperties.get("pm.dexopt.shared")).thenReturn("speed");
+        // Verification checkpointing is covered by dedicated tests.
+        lenient()
+                .when(SystemProperties.getLong(
+                        eq("dalvik.vm.bgdexopt.checkpoint-dex-size"), anyLong()))
+                .thenReturn(-1l);
 
         // No ISA translation.
         lenient()
@@ -26,6 +26,7 @@ import static com.google.common.truth.Truth.assertThat;
 import static org.mockito.Mockito.any;
 import static org.mockito.Mockito.anyBoolean;
 import static org.mockito.Mockito.anyInt;
+import static org.mockito.Mockito.anyLong;
 import static org.mockito.Mockito.argThat;
 import static org.mockito.Mockito.eq;
 import static org.mockito.Mockito.isNull;
@@ -131,6 +132,11 @@ public class SecondaryDexopterTest {
                 .thenReturn(false);
         lenient().when(SystemProperties.get("dalvik.vm.appimageformat")).thenReturn("lz4");
         lenient().when(SystemProperties.get("pm.dexopt.shared")).thenReturn("speed");
+        // Verification checkpointing is covered by dedicated tests.
+        lenient()
+                .when(SystemProperties.getLong(
+                        eq("dalvik.vm.bgdexopt.checkpoint-dex-size"), anyLong()))
+                .thenReturn(-1l);
 
         // No ISA translation.
         lenient()
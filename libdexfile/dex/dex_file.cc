@@ -38,6 +38,7 @@
 #include "descriptors_names.h"
 #include "dex_file-inl.h"
 #include "standard_dex_file.h"
+#include "type_lookup_table.h"
 #include "utf-inl.h"
 
 namespace art {
@@ -174,7 +175,9 @@ DexFile::DexFile(const uint8_t* base,
       oat_dex_file_(oat_dex_file),
       container_(std::move(container)),
       is_compact_dex_(is_compact_dex),
-      hiddenapi_domain_(hiddenapi::Domain::kApplication) {
+      hiddenapi_domain_(hiddenapi::Domain::kApplication),
+      dex_cache_miss_counters_{},
+      lazy_type_lookup_table_(nullptr) {
   CHECK(begin_ != nullptr) << GetLocation();
   // Check base (=header) alignment.
   // Must be 4-byte aligned to avoid undefined behavior when accessing
@@ -194,6 +197,22 @@ DexFile::~DexFile() {
   // that's only called after DetachCurrentThread, which means there's no JNIEnv. We could
   // re-attach, but cleaning up these global references is not obviously useful. It's not as if
   // the global reference table is otherwise empty!
+  delete lazy_type_lookup_table_.load(std::memory_order_relaxed);
+}
+
+const TypeLookupTable* DexFile::GetOrCreateTypeLookupTable() const {
+  const TypeLookupTable* table = lazy_type_lookup_table_.load(std::memory_order_acquire);
+  if (table != nullptr) {
+    return table->Valid() ? table : nullptr;
+  }
+  std::unique_ptr<const TypeLookupTable> new_table =
+      std::make_unique<const TypeLookupTable>(TypeLookupTable::Create(*this));
+  // Another thread may have created a table concurrently. Keep the first one.
+  if (lazy_type_lookup_table_.compare_exchange_strong(
+          table, new_table.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+    table = new_table.release();
+  }
+  return table->Valid() ? table : nullptr;
 }
 
 bool DexFile::Init(std::string* error_msg) {
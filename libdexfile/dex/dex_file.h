@@ -20,6 +20,7 @@
 #include <android-base/logging.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
@@ -48,6 +49,7 @@ class MemMap;
 class OatDexFile;
 class Signature;
 class StandardDexFile;
+class TypeLookupTable;
 class ZipArchive;
 
 namespace hiddenapi {
@@ -889,6 +891,20 @@ class DexFile {
   hiddenapi::Domain GetHiddenapiDomain() const { return hiddenapi_domain_; }
   void SetHiddenapiDomain(hiddenapi::Domain value) const { hiddenapi_domain_ = value; }
 
+  // Number of dex cache kinds with conflict miss counters, see `mirror::DexCache`.
+  static constexpr size_t kNumDexCacheMissCounters = 5u;
+
+  // Returns the counter of dex cache conflict misses for the given dex cache kind.
+  std::atomic<uint32_t>& GetDexCacheMissCounter(size_t kind) const {
+    DCHECK_LT(kind, kNumDexCacheMissCounters);
+    return dex_cache_miss_counters_[kind];
+  }
+
+  // Returns a type lookup table for this dex file, creating it on the first call. Used for class
+  // lookups in dex files whose oat file does not provide a lookup table, so that dex files which
+  // are never searched do not pay for one. Returns null if no table can be created.
+  const TypeLookupTable* GetOrCreateTypeLookupTable() const;
+
   bool IsInMainSection(const void* addr) const {
     return Begin() <= addr && addr < Begin() + Size();
   }
@@ -1021,6 +1037,13 @@ class DexFile {
   // has been created and can be changed later by the runtime.
   mutable hiddenapi::Domain hiddenapi_domain_;
 
+  // Conflict misses in the dex cache pair arrays, used by the runtime to decide when to
+  // switch to full arrays. It is declared `mutable` because it is updated by the runtime.
+  mutable std::array<std::atomic<uint32_t>, kNumDexCacheMissCounters> dex_cache_miss_counters_;
+
+  // The type lookup table created by `GetOrCreateTypeLookupTable()`, or null.
+  mutable std::atomic<const TypeLookupTable*> lazy_type_lookup_table_;
+
   friend class DexFileLoader;
   friend class DexFileVerifierTest;
   friend class OatWriter;
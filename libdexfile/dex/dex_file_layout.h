@@ -67,7 +67,7 @@ class DexLayoutSection {
       return start_offset_ <= offset && offset < end_offset_;
     }
 
-    bool Size() const {
+    uint32_t Size() const {
       DCHECK_LE(start_offset_, end_offset_);
       return end_offset_ - start_offset_;
     }
@@ -18,8 +18,12 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <vector>
 
 #include "android-base/stringprintf.h"
 #include "base/bit_utils.h"
@@ -51,8 +55,90 @@ namespace {
 // seems an excessive number.
 static constexpr size_t kWarnOnManyDexFilesThreshold = 100;
 
+// Dex files of an APK are verified on up to this many threads, including the calling thread.
+static constexpr size_t kMaxVerificationThreads = 4;
+
+// Below this total dex size, starting threads costs more than verifying concurrently saves.
+static constexpr size_t kMinTotalDexSizeForParallelVerification = 1 * 1024 * 1024;
+
 using android::base::StringPrintf;
 
+// Verifies the dex files from `dex_files[begin]` onwards. If there are several of them and they
+// are large enough, they are verified concurrently. Otherwise, they are verified in order on the
+// calling thread. On failure, reports the error of the first dex file that failed to verify and
+// removes it and the dex files after it from `dex_files`, as if they had been verified while
+// being opened one by one.
+bool VerifyDexFiles(std::vector<std::unique_ptr<const DexFile>>* dex_files,
+                    size_t begin,
+                    bool verify_checksum,
+                    DexFileLoaderErrorCode* error_code,
+                    std::string* error_msg) {
+  const size_t count = dex_files->size() - begin;
+  std::vector<std::string> error_msgs(count);
+  std::vector<uint8_t> failed(count, 0u);
+  auto verify = [&](size_t i) {
+    const DexFile* dex_file = (*dex_files)[begin + i].get();
+    // NB: Dex verifier does not understand the compact dex format.
+    if (dex_file->IsCompactDexFile()) {
+      return;
+    }
+    DEXFILE_SCOPED_TRACE(std::string("Verify dex file ") + dex_file->GetLocation());
+    if (!dex::Verify(dex_file, dex_file->GetLocation().c_str(), verify_checksum, &error_msgs[i])) {
+      failed[i] = 1u;
+    }
+  };
+
+  size_t total_size = 0;
+  for (size_t i = 0; i != count; ++i) {
+    total_size += (*dex_files)[begin + i]->Size();
+  }
+#ifdef _WIN32
+  // Keep host tools on Windows single-threaded.
+  const size_t num_threads = 1u;
+#else
+  const size_t num_threads =
+      total_size >= kMinTotalDexSizeForParallelVerification
+          ? std::min({count, kMaxVerificationThreads,
+                      static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 1u))})
+          : 1u;
+#endif
+  if (num_threads <= 1u) {
+    for (size_t i = 0; i != count; ++i) {
+      verify(i);
+      if (failed[i] != 0u) {
+        break;
+      }
+    }
+  } else {
+    DEXFILE_SCOPED_TRACE(StringPrintf("Verify %zu dex files on %zu threads", count, num_threads));
+    std::atomic<size_t> next_index = 0;
+    auto run = [&]() {
+      for (size_t i = next_index++; i < count; i = next_index++) {
+        verify(i);
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1u);
+    for (size_t t = 1; t != num_threads; ++t) {
+      threads.emplace_back(run);
+    }
+    run();
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  auto first_failure = std::find(failed.begin(), failed.end(), 1u);
+  if (first_failure == failed.end()) {
+    return true;
+  }
+  size_t index = first_failure - failed.begin();
+  *error_msg = std::move(error_msgs[index]);
+  *error_code = DexFileLoaderErrorCode::kVerifyError;
+  dex_files->resize(begin + index);
+  return false;
+}
+
 class VectorContainer : public DexFileContainer {
  public:
   explicit VectorContainer(std::vector<uint8_t>&& vector) : vector_(std::move(vector)) { }
@@ -387,12 +473,15 @@ bool DexFileLoader::Open(bool verify,
       return false;
     }
     size_t multidex_count = 0;
+    // Open all dex files first and verify them afterwards, so that they can be verified
+    // concurrently.
+    const size_t first_dex_file = dex_files->size();
     for (size_t i = 0;; ++i) {
       std::string name = GetMultiDexClassesDexName(i);
       bool ok = OpenFromZipEntry(*zip_archive,
                                  name.c_str(),
                                  location_,
-                                 verify,
+                                 /*verify=*/false,
                                  verify_checksum,
                                  &multidex_count,
                                  error_code,
@@ -402,7 +491,14 @@ bool DexFileLoader::Open(bool verify,
         // We keep opening consecutive dex entries as long as we can (until entry is not found).
         if (*error_code == DexFileLoaderErrorCode::kEntryNotFound) {
           // Success if we loaded at least one entry, or if empty zip is explicitly allowed.
-          return i > 0 || allow_no_dex_files;
+          if (i == 0 && !allow_no_dex_files) {
+            return false;
+          }
+          if (verify &&
+              !VerifyDexFiles(dex_files, first_dex_file, verify_checksum, error_code, error_msg)) {
+            return false;
+          }
+          return true;
         }
         return false;
       }
@@ -16,10 +16,14 @@
 
 #include "type_lookup_table.h"
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <numeric>
+#include <vector>
 
 #include "base/bit_utils.h"
+#include "base/casts.h"
 #include "base/leb128.h"
 #include "dex/dex_file-inl.h"
 #include "dex/utf-inl.h"
@@ -31,12 +35,121 @@ TypeLookupTable TypeLookupTable::Create(const DexFile& dex_file) {
   if (UNLIKELY(!SupportedSize(num_class_defs))) {
     return TypeLookupTable();
   }
-  size_t mask_bits = CalculateMaskBits(num_class_defs);
+  uint32_t mask_bits = CalculateMaskBits(num_class_defs);
   size_t size = 1u << mask_bits;
-  std::unique_ptr<Entry[]> owned_entries(new Entry[size]);
-  Entry* entries = owned_entries.get();
+  // Zero-initialized: all entries are empty, all displacements are zero and the layout is
+  // `Layout::kChained`.
+  std::unique_ptr<uint8_t[]> owned_data(new uint8_t[RawDataLengthForMaskBits(mask_bits)]());
 
   static_assert(alignof(Entry) == 4u, "Expecting Entry to be 4-byte aligned.");
+  Entry* entries = reinterpret_cast<Entry*>(owned_data.get());
+  uint16_t* displacements = reinterpret_cast<uint16_t*>(entries + size);
+  Layout* layout = reinterpret_cast<Layout*>(displacements + NumDisplacements(mask_bits));
+  DCHECK_ALIGNED(layout, alignof(Layout));
+  if (CreatePerfectHash(dex_file, mask_bits, entries, displacements)) {
+    *layout = Layout::kPerfectHash;
+  } else {
+    std::fill_n(entries, size, Entry());
+    std::fill_n(displacements, NumDisplacements(mask_bits), 0u);
+    CreateChained(dex_file, mask_bits, entries);
+    displacements = nullptr;
+  }
+
+  return TypeLookupTable(
+      dex_file.DataBegin(), mask_bits, entries, displacements, std::move(owned_data));
+}
+
+uint32_t TypeLookupTable::GetPerfectHashPos(uint32_t hash,
+                                            uint32_t displacement,
+                                            uint32_t mask_bits) {
+  // Mix the displacement into the hash with the MurmurHash3 finalizer, so that each displacement
+  // gives an unrelated position.
+  uint32_t x = hash ^ (displacement * 0x9e3779b9u);
+  x ^= x >> 16;
+  x *= 0x85ebca6bu;
+  x ^= x >> 13;
+  x *= 0xc2b2ae35u;
+  x ^= x >> 16;
+  return x & Entry::GetMask(mask_bits);
+}
+
+bool TypeLookupTable::CreatePerfectHash(const DexFile& dex_file,
+                                        uint32_t mask_bits,
+                                        Entry* entries,
+                                        uint16_t* displacements) {
+  const uint32_t num_class_defs = dex_file.NumClassDefs();
+  const uint32_t num_displacements = NumDisplacements(mask_bits);
+  std::vector<uint32_t> hashes(num_class_defs);
+  std::vector<uint32_t> str_offsets(num_class_defs);
+  for (uint32_t class_def_idx = 0; class_def_idx != num_class_defs; ++class_def_idx) {
+    const dex::ClassDef& class_def = dex_file.GetClassDef(class_def_idx);
+    const dex::TypeId& type_id = dex_file.GetTypeId(class_def.class_idx_);
+    const dex::StringId& str_id = dex_file.GetStringId(type_id.descriptor_idx_);
+    hashes[class_def_idx] = ComputeModifiedUtf8Hash(dex_file.GetStringView(str_id));
+    str_offsets[class_def_idx] = str_id.string_data_off_;
+  }
+
+  // Descriptors with the same hash always get the same position.
+  std::vector<uint32_t> sorted_hashes = hashes;
+  std::sort(sorted_hashes.begin(), sorted_hashes.end());
+  if (std::adjacent_find(sorted_hashes.begin(), sorted_hashes.end()) != sorted_hashes.end()) {
+    return false;
+  }
+
+  // Place the largest buckets first, while most entries are still free. The sort is stable to
+  // keep the output deterministic.
+  std::vector<std::vector<uint16_t>> buckets(num_displacements);
+  for (uint32_t class_def_idx = 0; class_def_idx != num_class_defs; ++class_def_idx) {
+    buckets[hashes[class_def_idx] & (num_displacements - 1u)].push_back(class_def_idx);
+  }
+  std::vector<uint32_t> order(num_displacements);
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  std::vector<bool> occupied(1u << mask_bits, false);
+  std::vector<uint32_t> positions;
+  for (uint32_t bucket : order) {
+    const std::vector<uint16_t>& class_defs = buckets[bucket];
+    if (class_defs.empty()) {
+      break;
+    }
+    bool placed = false;
+    for (uint32_t displacement = 0;
+         !placed && displacement <= std::numeric_limits<uint16_t>::max();
+         ++displacement) {
+      positions.clear();
+      for (uint16_t class_def_idx : class_defs) {
+        uint32_t pos = GetPerfectHashPos(hashes[class_def_idx], displacement, mask_bits);
+        if (occupied[pos]) {
+          break;
+        }
+        occupied[pos] = true;
+        positions.push_back(pos);
+      }
+      if (positions.size() == class_defs.size()) {
+        displacements[bucket] = dchecked_integral_cast<uint16_t>(displacement);
+        for (size_t i = 0; i != class_defs.size(); ++i) {
+          uint16_t class_def_idx = class_defs[i];
+          entries[positions[i]] = Entry::ForPerfectHash(
+              str_offsets[class_def_idx], hashes[class_def_idx], class_def_idx);
+        }
+        placed = true;
+      } else {
+        for (uint32_t pos : positions) {
+          occupied[pos] = false;
+        }
+      }
+    }
+    if (!placed) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TypeLookupTable::CreateChained(const DexFile& dex_file, uint32_t mask_bits, Entry* entries) {
   const uint32_t mask = Entry::GetMask(mask_bits);
   std::vector<uint16_t> conflict_class_defs;
   // The first stage. Put elements on their initial positions. If an initial position is already
@@ -80,8 +193,6 @@ TypeLookupTable TypeLookupTable::Create(const DexFile& dex_file) {
     DCHECK(entries[insert_pos].IsLast(mask_bits));
     DCHECK(!entries[tail_pos].IsLast(mask_bits));
   }
-
-  return TypeLookupTable(dex_file.DataBegin(), mask_bits, entries, std::move(owned_entries));
 }
 
 TypeLookupTable TypeLookupTable::Open(const uint8_t* dex_data_pointer,
@@ -89,11 +200,34 @@ TypeLookupTable TypeLookupTable::Open(const uint8_t* dex_data_pointer,
                                       uint32_t num_class_defs) {
   DCHECK_ALIGNED(raw_data, alignof(Entry));
   const Entry* entries = reinterpret_cast<const Entry*>(raw_data);
-  size_t mask_bits = CalculateMaskBits(num_class_defs);
-  return TypeLookupTable(dex_data_pointer, mask_bits, entries, /* owned_entries= */ nullptr);
+  uint32_t mask_bits = CalculateMaskBits(num_class_defs);
+  const uint16_t* displacements = reinterpret_cast<const uint16_t*>(entries + (1u << mask_bits));
+  Layout layout;
+  memcpy(&layout, displacements + NumDisplacements(mask_bits), sizeof(layout));
+  if (layout != Layout::kPerfectHash) {
+    DCHECK(layout == Layout::kChained) << static_cast<uint32_t>(layout);
+    displacements = nullptr;
+  }
+  return TypeLookupTable(
+      dex_data_pointer, mask_bits, entries, displacements, /* owned_data= */ nullptr);
 }
 
 uint32_t TypeLookupTable::Lookup(std::string_view str, uint32_t hash) const {
+  if (displacements_ == nullptr) {
+    return LookupChained(str, hash);
+  }
+  // One probe: if the descriptor is in the table, it is in this entry.
+  uint32_t displacement = displacements_[hash & (NumDisplacements(mask_bits_) - 1u)];
+  const Entry& entry = entries_[GetPerfectHashPos(hash, displacement, mask_bits_)];
+  if (entry.IsEmpty() ||
+      entry.GetPerfectHashBits() != (hash >> 16) ||
+      str != GetStringData(entry)) {
+    return dex::kDexNoIndex;
+  }
+  return entry.GetPerfectHashClassDefIdx();
+}
+
+uint32_t TypeLookupTable::LookupChained(std::string_view str, uint32_t hash) const {
   uint32_t mask = Entry::GetMask(mask_bits_);
   uint32_t pos = hash & mask;
   // Thanks to special insertion algorithm, the element at position pos can be empty
@@ -140,6 +274,7 @@ uint32_t TypeLookupTable::Lookup(std::string_view str, uint32_t hash) const {
 }
 
 void TypeLookupTable::Dump(std::ostream& os) const {
+  os << "layout: " << (displacements_ != nullptr ? "perfect-hash" : "chained") << '\n';
   size_t size = 1u << mask_bits_;
   for (uint32_t i = 0; i < size; i++) {
     const Entry& entry = entries_[i];
@@ -153,7 +288,9 @@ void TypeLookupTable::Dump(std::ostream& os) const {
 }
 
 uint32_t TypeLookupTable::RawDataLength(uint32_t num_class_defs) {
-  return SupportedSize(num_class_defs) ? RoundUpToPowerOfTwo(num_class_defs) * sizeof(Entry) : 0u;
+  return SupportedSize(num_class_defs)
+      ? RawDataLengthForMaskBits(CalculateMaskBits(num_class_defs))
+      : 0u;
 }
 
 uint32_t TypeLookupTable::CalculateMaskBits(uint32_t num_class_defs) {
@@ -167,11 +304,13 @@ bool TypeLookupTable::SupportedSize(uint32_t num_class_defs) {
 TypeLookupTable::TypeLookupTable(const uint8_t* dex_data_pointer,
                                  uint32_t mask_bits,
                                  const Entry* entries,
-                                 std::unique_ptr<Entry[]> owned_entries)
+                                 const uint16_t* displacements,
+                                 std::unique_ptr<uint8_t[]> owned_data)
     : dex_data_begin_(dex_data_pointer),
       mask_bits_(mask_bits),
       entries_(entries),
-      owned_entries_(std::move(owned_entries)) {}
+      displacements_(displacements),
+      owned_data_(std::move(owned_data)) {}
 
 std::string_view TypeLookupTable::GetStringData(const Entry& entry) const {
   DCHECK(dex_data_begin_ != nullptr);
@@ -17,6 +17,11 @@
 #ifndef ART_LIBDEXFILE_DEX_TYPE_LOOKUP_TABLE_H_
 #define ART_LIBDEXFILE_DEX_TYPE_LOOKUP_TABLE_H_
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string_view>
+
 #include <android-base/logging.h>
 
 #include "dex/dex_file_types.h"
@@ -31,6 +36,16 @@ class DexFile;
  * This class instantiated at compile time by calling Create() method and written into OAT file.
  * At runtime, the raw data is read from memory-mapped file by calling Open() method. The table
  * memory remains clean.
+ *
+ * The table comes in two layouts, which use the same amount of memory:
+ *  - A minimal-perfect-hash layout ("hash and displace"), where the hash of a descriptor selects
+ *    a bucket whose displacement, mixed with the hash, gives the only entry that can hold the
+ *    descriptor. A lookup then takes one probe and, for a partial hash match, one string compare.
+ *  - A chained layout, used when no perfect hash can be found, for example when two descriptors
+ *    have the same hash.
+ *
+ * The raw data is the array of entries, followed by the array of 16-bit displacements, followed
+ * by a 32-bit word holding the `Layout`. The displacements are all zero in the chained layout.
  */
 class TypeLookupTable {
  public:
@@ -48,7 +63,8 @@ class TypeLookupTable {
       : dex_data_begin_(nullptr),
         mask_bits_(0u),
         entries_(nullptr),
-        owned_entries_(nullptr) {}
+        displacements_(nullptr),
+        owned_data_(nullptr) {}
 
   TypeLookupTable(TypeLookupTable&& src) noexcept = default;
   TypeLookupTable& operator=(TypeLookupTable&& src) noexcept = default;
@@ -62,7 +78,13 @@ class TypeLookupTable {
     return entries_ != nullptr;
   }
 
-  // Return the number of buckets in the lookup table.
+  // Returns whether the table uses the minimal-perfect-hash layout.
+  bool IsPerfectHash() const {
+    DCHECK(Valid());
+    return displacements_ != nullptr;
+  }
+
+  // Return the number of entries in the lookup table.
   uint32_t Size() const {
     DCHECK(Valid());
     return 1u << mask_bits_;
@@ -81,7 +103,7 @@ class TypeLookupTable {
   // Method returns length of binary data. Used by the oat writer.
   uint32_t RawDataLength() const {
     DCHECK(Valid());
-    return Size() * sizeof(Entry);
+    return RawDataLengthForMaskBits(mask_bits_);
   }
 
   // Method returns length of binary data for the specified number of class definitions.
@@ -90,6 +112,11 @@ class TypeLookupTable {
   void Dump(std::ostream& os) const;
 
  private:
+  enum class Layout : uint32_t {
+    kChained = 0u,
+    kPerfectHash = 1u,
+  };
+
   /**
    * To find element we need to compare strings.
    * It is faster to compare first hashes and then strings itself.
@@ -112,6 +139,22 @@ class TypeLookupTable {
   class Entry {
    public:
     Entry() : str_offset_(0u), data_(0u) {}
+
+    // In the perfect hash layout, `data_` holds the class def index in the low 16 bits and the
+    // high 16 bits of the hash in the high 16 bits.
+    static Entry ForPerfectHash(uint32_t str_offset, uint32_t hash, uint32_t class_def_index) {
+      DCHECK_LE(class_def_index, std::numeric_limits<uint16_t>::max());
+      return Entry(str_offset, (hash & 0xffff0000u) | class_def_index);
+    }
+
+    uint32_t GetPerfectHashClassDefIdx() const {
+      return data_ & 0xffffu;
+    }
+
+    uint32_t GetPerfectHashBits() const {
+      return data_ >> 16;
+    }
+
     Entry(uint32_t str_offset, uint32_t hash, uint32_t class_def_index, uint32_t mask_bits)
         : str_offset_(str_offset),
           data_(((hash & ~GetMask(mask_bits)) | class_def_index) << mask_bits) {
@@ -156,6 +199,8 @@ class TypeLookupTable {
     }
 
    private:
+    Entry(uint32_t str_offset, uint32_t data) : str_offset_(str_offset), data_(data) {}
+
     uint32_t str_offset_;
     uint32_t data_;
   };
@@ -163,19 +208,47 @@ class TypeLookupTable {
   static uint32_t CalculateMaskBits(uint32_t num_class_defs);
   static bool SupportedSize(uint32_t num_class_defs);
 
+  // Returns the number of displacements for a table with `1 << mask_bits` entries.
+  static uint32_t NumDisplacements(uint32_t mask_bits) {
+    // Four entries per displacement on average, and an even number to keep the `Layout` aligned.
+    return std::max(1u << mask_bits >> 2, 2u);
+  }
+
+  static uint32_t RawDataLengthForMaskBits(uint32_t mask_bits) {
+    return (1u << mask_bits) * sizeof(Entry) + NumDisplacements(mask_bits) * sizeof(uint16_t) +
+           sizeof(Layout);
+  }
+
+  // Returns the position of the entry for `hash` in the perfect hash layout.
+  static uint32_t GetPerfectHashPos(uint32_t hash, uint32_t displacement, uint32_t mask_bits);
+
+  // Tries to fill `entries` and `displacements` with a minimal-perfect-hash layout.
+  static bool CreatePerfectHash(const DexFile& dex_file,
+                                uint32_t mask_bits,
+                                Entry* entries,
+                                uint16_t* displacements);
+
+  // Fills `entries` with the chained layout.
+  static void CreateChained(const DexFile& dex_file, uint32_t mask_bits, Entry* entries);
+
+  uint32_t LookupChained(std::string_view str, uint32_t hash) const;
+
   // Construct the TypeLookupTable.
   TypeLookupTable(const uint8_t* dex_data_pointer,
                   uint32_t mask_bits,
                   const Entry* entries,
-                  std::unique_ptr<Entry[]> owned_entries);
+                  const uint16_t* displacements,
+                  std::unique_ptr<uint8_t[]> owned_data);
 
   std::string_view GetStringData(const Entry& entry) const;
 
   const uint8_t* dex_data_begin_;
   uint32_t mask_bits_;
   const Entry* entries_;
-  // `owned_entries_` is either null (not owning `entries_`) or same pointer as `entries_`.
-  std::unique_ptr<Entry[]> owned_entries_;
+  // Null in the chained layout.
+  const uint16_t* displacements_;
+  // `owned_data_` is either null (not owning `entries_`) or same pointer as `entries_`.
+  std::unique_ptr<uint8_t[]> owned_data_;
 };
 
 }  // namespace art
@@ -33,7 +33,37 @@ TEST_F(TypeLookupTableTest, CreateLookupTable) {
   TypeLookupTable table = TypeLookupTable::Create(*dex_file);
   ASSERT_TRUE(table.Valid());
   ASSERT_NE(nullptr, table.RawData());
-  ASSERT_EQ(32U, table.RawDataLength());
+  // 4 entries, 2 displacements and the layout.
+  ASSERT_EQ(40U, table.RawDataLength());
+  ASSERT_EQ(TypeLookupTable::RawDataLength(dex_file->NumClassDefs()), table.RawDataLength());
+  ASSERT_TRUE(table.IsPerfectHash());
+}
+
+TEST_F(TypeLookupTableTest, OpenLookupTable) {
+  std::unique_ptr<const DexFile> dex_file(OpenTestDexFile("Lookup"));
+  TypeLookupTable created = TypeLookupTable::Create(*dex_file);
+  ASSERT_TRUE(created.Valid());
+  TypeLookupTable opened =
+      TypeLookupTable::Open(dex_file->DataBegin(), created.RawData(), dex_file->NumClassDefs());
+  ASSERT_TRUE(opened.Valid());
+  EXPECT_EQ(created.IsPerfectHash(), opened.IsPerfectHash());
+  for (uint32_t i = 0; i != dex_file->NumClassDefs(); ++i) {
+    const char* descriptor = dex_file->GetClassDescriptor(dex_file->GetClassDef(i));
+    EXPECT_EQ(i, opened.Lookup(descriptor, ComputeModifiedUtf8Hash(descriptor))) << descriptor;
+  }
+}
+
+TEST_F(TypeLookupTableTest, GetOrCreateTypeLookupTable) {
+  std::unique_ptr<const DexFile> dex_file(OpenTestDexFile("Lookup"));
+  const TypeLookupTable* table = dex_file->GetOrCreateTypeLookupTable();
+  ASSERT_NE(nullptr, table);
+  ASSERT_TRUE(table->Valid());
+  // The table is created only once.
+  EXPECT_EQ(table, dex_file->GetOrCreateTypeLookupTable());
+  for (uint32_t i = 0; i != dex_file->NumClassDefs(); ++i) {
+    const char* descriptor = dex_file->GetClassDescriptor(dex_file->GetClassDef(i));
+    EXPECT_EQ(i, table->Lookup(descriptor, ComputeModifiedUtf8Hash(descriptor))) << descriptor;
+  }
 }
 
 TEST_P(TypeLookupTableTest, Find) {
@@ -16,6 +16,8 @@
 
 #include "utf.h"
 
+#include <string.h>
+
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
 #include <android-base/strings.h>
@@ -27,6 +29,76 @@ namespace art {
 
 using android::base::StringAppendF;
 
+// The ASCII fast paths below test 8 bytes at a time. The loops using them are simple enough for
+// the compilers to vectorize, so there is no need for per-ISA implementations.
+
+// Returns the number of leading bytes of `utf8` that use the one-byte encoding.
+ALWAYS_INLINE static inline size_t CountLeadingAsciiBytes(const char* utf8, size_t byte_count) {
+  static constexpr uint64_t kNonAsciiBits = UINT64_C(0x8080808080808080);
+  size_t i = 0;
+  for (; byte_count - i >= sizeof(uint64_t); i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, utf8 + i, sizeof(word));
+    if ((word & kNonAsciiBits) != 0u) {
+      break;
+    }
+  }
+  while (i != byte_count && (utf8[i] & 0x80) == 0) {
+    ++i;
+  }
+  return i;
+}
+
+// Returns the number of leading chars of `utf16` that are encoded with one byte in Modified
+// UTF-8, i.e. U+0001 to U+007F. Note that U+0000 uses the two-byte encoding.
+ALWAYS_INLINE static inline size_t CountLeadingAsciiChars(const uint16_t* utf16,
+                                                          size_t char_count) {
+  static constexpr uint64_t kNonAsciiBits = UINT64_C(0xff80ff80ff80ff80);
+  static constexpr uint64_t kOnes = UINT64_C(0x0001000100010001);
+  static constexpr uint64_t kHighBits = UINT64_C(0x8000800080008000);
+  static constexpr size_t kCharsPerWord = sizeof(uint64_t) / sizeof(uint16_t);
+  size_t i = 0;
+  for (; char_count - i >= kCharsPerWord; i += kCharsPerWord) {
+    uint64_t word;
+    memcpy(&word, utf16 + i, sizeof(word));
+    // Once all chars are known to be below 0x80, subtracting one from each of them sets the
+    // high bit of a char only if that char is zero.
+    if ((word & kNonAsciiBits) != 0u || ((word - kOnes) & kHighBits) != 0u) {
+      break;
+    }
+  }
+  while (i != char_count && static_cast<uint16_t>(utf16[i] - 1u) < 0x7fu) {
+    ++i;
+  }
+  return i;
+}
+
+// Converts `utf16_in` to Modified UTF-8, copying runs of ASCII chars directly and passing the
+// chars in between to `ConvertUtf16ToUtf8`. Surrogate pairs are never split as ASCII chars
+// cannot be part of them.
+template <typename Append, typename AppendAscii>
+ALWAYS_INLINE static inline void ConvertUtf16ToModifiedUtf8Runs(const uint16_t* utf16_in,
+                                                                size_t char_count,
+                                                                Append&& append,
+                                                                AppendAscii&& append_ascii) {
+  const uint16_t* end = utf16_in + char_count;
+  while (utf16_in != end) {
+    size_t ascii_count = CountLeadingAsciiChars(utf16_in, end - utf16_in);
+    append_ascii(utf16_in, ascii_count);
+    utf16_in += ascii_count;
+    const uint16_t* non_ascii_end = utf16_in;
+    while (non_ascii_end != end && static_cast<uint16_t>(*non_ascii_end - 1u) >= 0x7fu) {
+      ++non_ascii_end;
+    }
+    // FIXME: We should not emit 4-byte sequences. Bug: 192935764
+    ConvertUtf16ToUtf8</*kUseShortZero=*/ false,
+                       /*kUse4ByteSequence=*/ true,
+                       /*kReplaceBadSurrogates=*/ false>(
+        utf16_in, non_ascii_end - utf16_in, append);
+    utf16_in = non_ascii_end;
+  }
+}
+
 // This is used only from debugger and test code.
 size_t CountModifiedUtf8Chars(const char* utf8) {
   return CountModifiedUtf8Chars(utf8, strlen(utf8));
@@ -52,12 +124,15 @@ size_t CountModifiedUtf8Chars(const char* utf8, size_t byte_count) {
   size_t len = 0;
   const char* end = utf8 + byte_count;
   for (; utf8 < end; ++utf8) {
+    // Skip a run of one-byte encodings.
+    size_t ascii_count = CountLeadingAsciiBytes(utf8, end - utf8);
+    len += ascii_count;
+    utf8 += ascii_count;
+    if (utf8 == end) {
+      break;
+    }
     int ic = *utf8;
     len++;
-    if (LIKELY((ic & 0x80) == 0)) {
-      // One-byte encoding.
-      continue;
-    }
     // Two- or three-byte encoding.
     utf8++;
     if ((ic & 0x20) == 0) {
@@ -110,6 +185,13 @@ void ConvertModifiedUtf8ToUtf16(uint16_t* utf16_data_out, size_t out_chars,
 
   // String contains non-ASCII characters.
   for (const char *p = in_start; p < in_end;) {
+    size_t ascii_count = CountLeadingAsciiBytes(p, in_end - p);
+    for (const char* ascii_end = p + ascii_count; p != ascii_end;) {
+      *out_p++ = dchecked_integral_cast<uint16_t>(*p++);
+    }
+    if (p == in_end) {
+      break;
+    }
     const uint32_t ch = GetUtf16FromUtf8(&p);
     const uint16_t leading = GetLeadingUtf16Char(ch);
     const uint16_t trailing = GetTrailingUtf16Char(ch);
@@ -133,11 +215,13 @@ void ConvertUtf16ToModifiedUtf8(char* utf8_out, size_t byte_count,
   }
 
   // String contains non-ASCII characters.
-  // FIXME: We should not emit 4-byte sequences. Bug: 192935764
   auto append = [&](char c) { *utf8_out++ = c; };
-  ConvertUtf16ToUtf8</*kUseShortZero=*/ false,
-                     /*kUse4ByteSequence=*/ true,
-                     /*kReplaceBadSurrogates=*/ false>(utf16_in, char_count, append);
+  auto append_ascii = [&](const uint16_t* ascii, size_t count) {
+    for (const uint16_t* ascii_end = ascii + count; ascii != ascii_end;) {
+      *utf8_out++ = dchecked_integral_cast<char>(*ascii++);
+    }
+  };
+  ConvertUtf16ToModifiedUtf8Runs(utf16_in, char_count, append, append_ascii);
 }
 
 int32_t ComputeUtf16HashFromModifiedUtf8(const char* utf8, size_t utf16_length) {
@@ -207,12 +291,12 @@ int CompareModifiedUtf8ToUtf16AsCodePointValues(const char* utf8, const uint16_t
 }
 
 size_t CountModifiedUtf8BytesInUtf16(const uint16_t* chars, size_t char_count) {
-  // FIXME: We should not emit 4-byte sequences. Bug: 192935764
   size_t result = 0;
   auto append = [&]([[maybe_unused]] char c) { ++result; };
-  ConvertUtf16ToUtf8</*kUseShortZero=*/ false,
-                     /*kUse4ByteSequence=*/ true,
-                     /*kReplaceBadSurrogates=*/ false>(chars, char_count, append);
+  auto append_ascii = [&]([[maybe_unused]] const uint16_t* ascii, size_t count) {
+    result += count;
+  };
+  ConvertUtf16ToModifiedUtf8Runs(chars, char_count, append, append_ascii);
   return result;
 }
 
@@ -20,6 +20,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <array>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -102,7 +103,27 @@ int32_t ComputeUtf16Hash(const MemoryType* chars, size_t char_count) {
                 std::is_same_v<MemoryType, uint8_t> ||
                 std::is_same_v<MemoryType, uint16_t>);
   using UnsignedMemoryType = std::make_unsigned_t<MemoryType>;
+  // Hash blocks of characters as `hash * 31^N + sum(chars[i] * 31^(N - 1 - i))`. The products
+  // within a block do not depend on each other, so the compiler can vectorize them instead of
+  // evaluating one long chain of dependent multiply-adds.
+  static constexpr size_t kBlockSize = 8u;
+  static constexpr std::array<uint32_t, kBlockSize + 1u> kPowers = []() {
+    std::array<uint32_t, kBlockSize + 1u> powers = {};
+    uint32_t power = 1u;
+    for (size_t i = 0; i != kBlockSize + 1u; ++i) {
+      powers[kBlockSize - i] = power;
+      power *= 31u;
+    }
+    return powers;
+  }();
   uint32_t hash = 0;
+  for (; char_count >= kBlockSize; char_count -= kBlockSize, chars += kBlockSize) {
+    uint32_t block_hash = 0u;
+    for (size_t i = 0; i != kBlockSize; ++i) {
+      block_hash += static_cast<UnsignedMemoryType>(chars[i]) * kPowers[i + 1u];
+    }
+    hash = hash * kPowers[0] + block_hash;
+  }
   while (char_count--) {
     hash = hash * 31 + static_cast<UnsignedMemoryType>(*chars++);
   }
@@ -380,6 +380,79 @@ TEST_F(UtfTest, ExhaustiveBidirectionalCodePointCheck) {
   }
 }
 
+// Checks the conversions of strings mixing ASCII runs of various lengths, which take the
+// word-at-a-time fast paths, with chars that need a multi-byte encoding.
+static void TestMixedConversions(const std::vector<uint16_t>& utf16) {
+  const size_t char_count = utf16.size();
+  size_t byte_count = CountModifiedUtf8BytesInUtf16(utf16.data(), char_count);
+  ASSERT_EQ(CountModifiedUtf8BytesInUtf16_reference(utf16.data(), char_count), byte_count);
+
+  std::vector<char> utf8_reference(byte_count + 1u, '\0');
+  std::vector<char> utf8(byte_count + 1u, '\0');
+  ConvertUtf16ToModifiedUtf8_reference(utf8_reference.data(), utf16.data(), char_count);
+  ConvertUtf16ToModifiedUtf8(utf8.data(), byte_count, utf16.data(), char_count);
+  ASSERT_EQ(utf8_reference, utf8);
+
+  ASSERT_EQ(char_count, CountModifiedUtf8Chars_reference(utf8.data()));
+  ASSERT_EQ(char_count, CountModifiedUtf8Chars(utf8.data(), byte_count));
+
+  std::vector<uint16_t> utf16_out(char_count);
+  ConvertModifiedUtf8ToUtf16(utf16_out.data(), char_count, utf8.data(), byte_count);
+  ASSERT_EQ(utf16, utf16_out);
+}
+
+TEST_F(UtfTest, MixedAsciiRuns) {
+  // U+0000 is not ASCII in Modified UTF-8. Also include a surrogate pair and unpaired surrogates.
+  const std::vector<std::vector<uint16_t>> kNonAscii = {
+      {0x0000}, {0x0080}, {0x07ff}, {0x20ac}, {0xd83d, 0xde00}, {0xd800}, {0xdc00}};
+  for (size_t prefix = 0; prefix != 20u; ++prefix) {
+    for (size_t suffix = 0; suffix != 20u; ++suffix) {
+      for (const std::vector<uint16_t>& non_ascii : kNonAscii) {
+        std::vector<uint16_t> utf16;
+        for (size_t i = 0; i != prefix; ++i) {
+          utf16.push_back('a' + i % 26u);
+        }
+        utf16.insert(utf16.end(), non_ascii.begin(), non_ascii.end());
+        for (size_t i = 0; i != suffix; ++i) {
+          utf16.push_back(0x7f - i);
+        }
+        TestMixedConversions(utf16);
+        // And with a second non-ASCII char after the ASCII run.
+        utf16.insert(utf16.end(), non_ascii.begin(), non_ascii.end());
+        TestMixedConversions(utf16);
+      }
+    }
+  }
+}
+
+template <typename MemoryType>
+static int32_t ComputeUtf16HashSlow(const std::vector<MemoryType>& chars) {
+  uint32_t hash = 0u;
+  for (MemoryType c : chars) {
+    hash = hash * 31u + static_cast<std::make_unsigned_t<MemoryType>>(c);
+  }
+  return static_cast<int32_t>(hash);
+}
+
+TEST_F(UtfTest, ComputeUtf16Hash) {
+  // Cover lengths below, at and above multiples of the hashing block size.
+  for (size_t length = 0; length != 40u; ++length) {
+    std::vector<uint8_t> compressed;
+    std::vector<uint16_t> uncompressed;
+    std::vector<char> utf8;
+    for (size_t i = 0; i != length; ++i) {
+      compressed.push_back(static_cast<uint8_t>(0x7f - i));
+      uncompressed.push_back(static_cast<uint16_t>(0xffff - i * 997u));
+      utf8.push_back(static_cast<char>(0x80 + i));
+    }
+    EXPECT_EQ(ComputeUtf16HashSlow(compressed),
+              ComputeUtf16Hash(compressed.data(), compressed.size())) << length;
+    EXPECT_EQ(ComputeUtf16HashSlow(uncompressed),
+              ComputeUtf16Hash(uncompressed.data(), uncompressed.size())) << length;
+    EXPECT_EQ(ComputeUtf16HashSlow(utf8), ComputeUtf16Hash(utf8.data(), utf8.size())) << length;
+  }
+}
+
 TEST_F(UtfTest, NonAscii) {
   const char kNonAsciiCharacter = '\x80';
   const char input[] = { kNonAsciiCharacter, '\0' };
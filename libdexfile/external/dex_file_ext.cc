@@ -18,6 +18,7 @@
 
 #include <inttypes.h>
 #include <stdint.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -28,6 +29,7 @@
 #include <deque>
 #include <map>
 #include <memory>
+#include <new>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,7 +38,9 @@
 #include <android-base/macros.h>
 #include <android-base/mapped_file.h>
 #include <android-base/stringprintf.h>
+#include <ziparchive/zip_archive.h>
 
+#include <base/bit_utils.h>
 #include <dex/class_accessor-inl.h>
 #include <dex/code_item_accessors-inl.h>
 #include <dex/dex_file-inl.h>
@@ -47,15 +51,48 @@ extern "C" {
 struct ADexFile_Method {
   ADexFile* adex;
   uint32_t index;
+  uint32_t access_flags;
+  const art::dex::CodeItem* code_item;
   size_t offset;
   size_t size;
 };
 
+struct ADexFile_Class {
+  ADexFile* adex;
+  const art::ClassAccessor* accessor;
+};
+
 // Opaque implementation of ADexFile for the C interface.
 struct ADexFile {
   explicit ADexFile(std::unique_ptr<const art::DexFile> dex_file)
       : dex_file_(std::move(dex_file)) {}
 
+  ADexFile(std::unique_ptr<const art::DexFile> dex_file,
+           std::unique_ptr<android::base::MappedFile> mapped_data,
+           std::unique_ptr<uint8_t[]> extracted_data)
+      : mapped_data_(std::move(mapped_data)),
+        extracted_data_(std::move(extracted_data)),
+        dex_file_(std::move(dex_file)) {}
+
+  // Returns the information about `method`. Methods without code have offset and size 0.
+  inline ADexFile_Method GetMethodInfo(const art::ClassAccessor::Method& method) {
+    art::CodeItemInstructionAccessor code = method.GetInstructions();
+    size_t offset = 0;
+    size_t size = 0;
+    if (code.HasCodeItem()) {
+      offset = reinterpret_cast<const uint8_t*>(code.Insns()) - dex_file_->Begin();
+      size = code.InsnsSizeInBytes();
+    }
+    return ADexFile_Method {
+      .adex = this,
+      .index = method.GetIndex(),
+      .access_flags = method.GetAccessFlags(),
+      .code_item = method.GetCodeItem(),
+      .offset = offset,
+      .size = size,
+    };
+  }
+
   inline bool FindMethod(uint32_t dex_offset, /*out*/ ADexFile_Method* result) {
     uint32_t class_def_index;
     if (GetClassDefIndex(dex_offset, &class_def_index)) {
@@ -68,12 +105,7 @@ struct ADexFile {
         size_t offset = reinterpret_cast<const uint8_t*>(code.Insns()) - dex_file_->Begin();
         size_t size = code.InsnsSizeInBytes();
         if (offset <= dex_offset && dex_offset < offset + size) {
-          *result = ADexFile_Method {
-            .adex = this,
-            .index = method.GetIndex(),
-            .offset = offset,
-            .size = size,
-          };
+          *result = GetMethodInfo(method);
           return true;
         }
       }
@@ -130,6 +162,11 @@ struct ADexFile {
     return false;
   }
 
+  // The memory backing `dex_file_` when it was opened from a zip entry. Either the entry
+  // mapped directly from the zip file, or the entry extracted into memory.
+  const std::unique_ptr<android::base::MappedFile> mapped_data_;
+  const std::unique_ptr<uint8_t[]> extracted_data_;
+
   // The underlying ART object.
   std::unique_ptr<const art::DexFile> dex_file_;
 
@@ -140,12 +177,11 @@ struct ADexFile {
   std::string temporary_qualified_name_;
 };
 
-ADexFile_Error ADexFile_create(const void* _Nonnull address,
-                               size_t size,
-                               size_t* _Nullable new_size,
-                               const char* _Nonnull location,
-                               /*out*/ ADexFile* _Nullable * _Nonnull out_dex_file) {
-  *out_dex_file = nullptr;
+static ADexFile_Error OpenDexFile(const void* address,
+                                  size_t size,
+                                  size_t* new_size,
+                                  const char* location,
+                                  /*out*/ std::unique_ptr<const art::DexFile>* out_dex_file) {
 
   if (size < sizeof(art::DexFile::Header)) {
     if (new_size != nullptr) {
@@ -203,10 +239,94 @@ ADexFile_Error ADexFile_create(const void* _Nonnull address,
     return ADEXFILE_ERROR_INVALID_DEX;
   }
 
+  *out_dex_file = std::move(dex_file);
+  return ADEXFILE_ERROR_OK;
+}
+
+ADexFile_Error ADexFile_create(const void* _Nonnull address,
+                               size_t size,
+                               size_t* _Nullable new_size,
+                               const char* _Nonnull location,
+                               /*out*/ ADexFile* _Nullable * _Nonnull out_dex_file) {
+  *out_dex_file = nullptr;
+
+  std::unique_ptr<const art::DexFile> dex_file;
+  ADexFile_Error error = OpenDexFile(address, size, new_size, location, &dex_file);
+  if (error != ADEXFILE_ERROR_OK) {
+    return error;
+  }
+
   *out_dex_file = new ADexFile(std::move(dex_file));
   return ADEXFILE_ERROR_OK;
 }
 
+ADexFile_Error ADexFile_createFromZipEntry(int fd,
+                                           const char* _Nonnull entry_name,
+                                           const char* _Nonnull location,
+                                           /*out*/ ADexFile* _Nullable * _Nonnull out_dex_file) {
+  *out_dex_file = nullptr;
+
+  ZipArchiveHandle handle;
+  int32_t zip_error = OpenArchiveFd(fd, location, &handle, /*assume_ownership=*/false);
+  if (zip_error != 0) {
+    LOG(ERROR) << "Can not open zip archive " << location << ": " << ErrorCodeString(zip_error);
+    CloseArchive(handle);
+    return ADEXFILE_ERROR_INVALID_ZIP;
+  }
+
+  ZipEntry64 entry;
+  zip_error = FindEntry(handle, entry_name, &entry);
+  if (zip_error != 0) {
+    LOG(ERROR) << "Can not find " << entry_name << " in " << location << ": "
+               << ErrorCodeString(zip_error);
+    CloseArchive(handle);
+    return ADEXFILE_ERROR_INVALID_ZIP;
+  }
+
+  // Map uncompressed, aligned entries directly and extract the others.
+  std::unique_ptr<android::base::MappedFile> mapped_data;
+  std::unique_ptr<uint8_t[]> extracted_data;
+  const void* address = nullptr;
+  size_t size = entry.uncompressed_length;
+  if (entry.method == kCompressStored &&
+      entry.compressed_length == entry.uncompressed_length &&
+      art::IsAligned<alignof(art::DexFile::Header)>(entry.offset)) {
+    mapped_data = android::base::MappedFile::FromFd(fd, entry.offset, size, PROT_READ);
+    if (mapped_data != nullptr) {
+      address = mapped_data->data();
+    }
+  }
+  if (address == nullptr) {
+    extracted_data.reset(new (std::nothrow) uint8_t[size]);
+    if (extracted_data == nullptr) {
+      LOG(ERROR) << "Can not allocate " << size << " bytes for " << entry_name;
+      CloseArchive(handle);
+      return ADEXFILE_ERROR_INVALID_ZIP;
+    }
+    zip_error = ExtractToMemory(handle, &entry, extracted_data.get(), size);
+    if (zip_error != 0) {
+      LOG(ERROR) << "Can not extract " << entry_name << " from " << location << ": "
+                 << ErrorCodeString(zip_error);
+      CloseArchive(handle);
+      return ADEXFILE_ERROR_INVALID_ZIP;
+    }
+    address = extracted_data.get();
+  }
+  CloseArchive(handle);
+
+  std::unique_ptr<const art::DexFile> dex_file;
+  ADexFile_Error error = OpenDexFile(address, size, /*new_size=*/nullptr, location, &dex_file);
+  if (error == ADEXFILE_ERROR_NOT_ENOUGH_DATA) {
+    return ADEXFILE_ERROR_INVALID_DEX;  // The entry is truncated.
+  } else if (error != ADEXFILE_ERROR_OK) {
+    return error;
+  }
+
+  *out_dex_file =
+      new ADexFile(std::move(dex_file), std::move(mapped_data), std::move(extracted_data));
+  return ADEXFILE_ERROR_OK;
+}
+
 void ADexFile_destroy(ADexFile* self) {
   delete self;
 }
@@ -249,13 +369,7 @@ size_t ADexFile_forEachMethod(ADexFile* self,
     for (const art::ClassAccessor::Method& method : accessor.GetMethods()) {
       art::CodeItemInstructionAccessor code = method.GetInstructions();
       if (code.HasCodeItem()) {
-        size_t offset = reinterpret_cast<const uint8_t*>(code.Insns()) - self->dex_file_->Begin();
-        ADexFile_Method info {
-          .adex = self,
-          .index = method.GetIndex(),
-          .offset = offset,
-          .size = code.InsnsSizeInBytes(),
-        };
+        ADexFile_Method info = self->GetMethodInfo(method);
         callback(callback_data, &info);
         count++;
       }
@@ -264,6 +378,21 @@ size_t ADexFile_forEachMethod(ADexFile* self,
   return count;
 }
 
+size_t ADexFile_forEachClass(ADexFile* self,
+                             ADexFile_ClassCallback* callback,
+                             void* callback_data) {
+  size_t count = 0;
+  for (art::ClassAccessor accessor : self->dex_file_->GetClasses()) {
+    ADexFile_Class info {
+      .adex = self,
+      .accessor = &accessor,
+    };
+    callback(callback_data, &info);
+    count++;
+  }
+  return count;
+}
+
 size_t ADexFile_Method_getCodeOffset(const ADexFile_Method* self,
                                      size_t* out_size) {
   if (out_size != nullptr) {
@@ -303,12 +432,66 @@ const char* ADexFile_Method_getClassDescriptor(const ADexFile_Method* self,
   return name;
 }
 
+uint32_t ADexFile_Method_getAccessFlags(const ADexFile_Method* self) {
+  return self->access_flags;
+}
+
+int ADexFile_Method_getCodeItemInfo(const ADexFile_Method* self,
+                                    uint16_t* out_registers_size,
+                                    uint16_t* out_ins_size,
+                                    uint16_t* out_outs_size,
+                                    uint16_t* out_tries_size) {
+  if (self->code_item == nullptr) {
+    return 0;
+  }
+  art::CodeItemDataAccessor code(*self->adex->dex_file_, self->code_item);
+  if (out_registers_size != nullptr) {
+    *out_registers_size = code.RegistersSize();
+  }
+  if (out_ins_size != nullptr) {
+    *out_ins_size = code.InsSize();
+  }
+  if (out_outs_size != nullptr) {
+    *out_outs_size = code.OutsSize();
+  }
+  if (out_tries_size != nullptr) {
+    *out_tries_size = code.TriesSize();
+  }
+  return 1;
+}
+
+const char* ADexFile_Class_getDescriptor(const ADexFile_Class* self,
+                                         size_t* out_size) {
+  const char* descriptor = self->accessor->GetDescriptor();
+  if (out_size != nullptr) {
+    *out_size = strlen(descriptor);
+  }
+  return descriptor;
+}
+
+uint32_t ADexFile_Class_getAccessFlags(const ADexFile_Class* self) {
+  return self->accessor->GetClassDef().access_flags_;
+}
+
+size_t ADexFile_Class_forEachMethod(const ADexFile_Class* self,
+                                    ADexFile_MethodCallback* callback,
+                                    void* callback_data) {
+  size_t count = 0;
+  for (const art::ClassAccessor::Method& method : self->accessor->GetMethods()) {
+    ADexFile_Method info = self->adex->GetMethodInfo(method);
+    callback(callback_data, &info);
+    count++;
+  }
+  return count;
+}
+
 const char* ADexFile_Error_toString(ADexFile_Error self) {
   switch (self) {
     case ADEXFILE_ERROR_OK: return "Ok";
     case ADEXFILE_ERROR_INVALID_DEX: return "Dex file is invalid.";
     case ADEXFILE_ERROR_NOT_ENOUGH_DATA: return "Not enough data. Incomplete dex file.";
     case ADEXFILE_ERROR_INVALID_HEADER: return "Invalid dex file header.";
+    case ADEXFILE_ERROR_INVALID_ZIP: return "Invalid zip archive or entry.";
   }
   return nullptr;
 }
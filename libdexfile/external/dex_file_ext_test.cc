@@ -14,15 +14,20 @@
  * limitations under the License.
  */
 
+#include <stdio.h>
 #include <sys/types.h>
 
 #include <memory>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <android-base/file.h>
 #include <dex/dex_file.h>
 #include <gtest/gtest.h>
+#include <ziparchive/zip_writer.h>
 
 #include "art_api/dex_file_external.h"
 #include "dex_file_test_data.h"
@@ -135,8 +140,106 @@ TEST_F(ADexFileTest, forEachMethod) {
   EXPECT_EQ(names, std::vector<std::string>({"Main.<init>", "Main.main"}));
 }
 
+TEST_F(ADexFileTest, forEachClass) {
+  dex_ = GetTestDexData();
+  ASSERT_NE(dex_, nullptr);
+
+  std::vector<std::pair<std::string, uint32_t>> classes;
+  auto add = [](void* ctx, const ADexFile_Class* clazz) {
+    reinterpret_cast<decltype(classes)*>(ctx)->emplace_back(
+        ADexFile_Class_getDescriptor(clazz, nullptr), ADexFile_Class_getAccessFlags(clazz));
+  };
+  EXPECT_EQ(ADexFile_forEachClass(dex_, add, &classes), 1u);
+  EXPECT_EQ(classes, (std::vector<std::pair<std::string, uint32_t>>({{"LMain;", 0x1u}})));
+}
+
+struct MethodInfo {
+  std::string name;
+  uint32_t access_flags;
+  uint16_t registers_size;
+  uint16_t ins_size;
+  uint16_t outs_size;
+  uint16_t tries_size;
+
+  bool operator==(const MethodInfo& other) const {
+    return std::tie(name, access_flags, registers_size, ins_size, outs_size, tries_size) ==
+           std::tie(other.name,
+                    other.access_flags,
+                    other.registers_size,
+                    other.ins_size,
+                    other.outs_size,
+                    other.tries_size);
+  }
+};
+
+TEST_F(ADexFileTest, Class_forEachMethod) {
+  dex_ = GetTestDexData();
+  ASSERT_NE(dex_, nullptr);
+
+  std::vector<MethodInfo> methods;
+  auto add_method = [](void* ctx, const ADexFile_Method* method) {
+    MethodInfo info = {
+        .name = ADexFile_Method_getName(method, nullptr),
+        .access_flags = ADexFile_Method_getAccessFlags(method),
+    };
+    EXPECT_NE(ADexFile_Method_getCodeItemInfo(
+                  method, &info.registers_size, &info.ins_size, &info.outs_size, &info.tries_size),
+              0);
+    reinterpret_cast<decltype(methods)*>(ctx)->push_back(info);
+  };
+  auto visit_class = [](void* ctx, const ADexFile_Class* clazz) {
+    EXPECT_EQ(ADexFile_Class_forEachMethod(clazz, add_method, ctx), 2u);
+  };
+  EXPECT_EQ(ADexFile_forEachClass(dex_, visit_class, &methods), 1u);
+  EXPECT_EQ(methods,
+            std::vector<MethodInfo>({
+                {"<init>", 0x10001u, /*registers_size=*/1, /*ins_size=*/1, /*outs_size=*/1, 0},
+                {"main", 0x9u, /*registers_size=*/1, /*ins_size=*/1, /*outs_size=*/0, 0},
+            }));
+}
+
+static void WriteTestZip(FILE* file) {
+  ZipWriter writer(file);
+  ASSERT_EQ(writer.StartAlignedEntry("classes.dex", /*flags=*/0, /*alignment=*/4), 0);
+  ASSERT_EQ(writer.WriteBytes(kDexData, sizeof(kDexData)), 0);
+  ASSERT_EQ(writer.FinishEntry(), 0);
+  ASSERT_EQ(writer.StartEntry("classes2.dex", ZipWriter::kCompress), 0);
+  ASSERT_EQ(writer.WriteBytes(kDexData, sizeof(kDexData)), 0);
+  ASSERT_EQ(writer.FinishEntry(), 0);
+  ASSERT_EQ(writer.StartEntry("not_a_dex.txt", /*flags=*/0), 0);
+  ASSERT_EQ(writer.WriteBytes("abc", 3), 0);
+  ASSERT_EQ(writer.FinishEntry(), 0);
+  ASSERT_EQ(writer.Finish(), 0);
+  ASSERT_EQ(fflush(file), 0);
+}
+
+TEST_F(ADexFileTest, createFromZipEntry) {
+  TemporaryFile zip_file;
+  std::unique_ptr<FILE, decltype(&fclose)> file(fdopen(zip_file.release(), "w+b"), fclose);
+  ASSERT_NE(file, nullptr);
+  WriteTestZip(file.get());
+  int fd = fileno(file.get());
+
+  // "classes.dex" is stored and mapped, "classes2.dex" is compressed and extracted.
+  for (const char* entry_name : {"classes.dex", "classes2.dex"}) {
+    ADexFile* dex = nullptr;
+    EXPECT_EQ(ADexFile_createFromZipEntry(fd, entry_name, zip_file.path, &dex), ADEXFILE_ERROR_OK);
+    ASSERT_NE(dex, nullptr);
+    auto no_cb = [](void*, const ADexFile_Method*) {};
+    EXPECT_EQ(ADexFile_forEachMethod(dex, no_cb, nullptr), 2u);
+    ADexFile_destroy(dex);
+  }
+
+  EXPECT_EQ(ADexFile_createFromZipEntry(fd, "missing.dex", zip_file.path, &dex_),
+            ADEXFILE_ERROR_INVALID_ZIP);
+  EXPECT_EQ(dex_, nullptr);
+  EXPECT_EQ(ADexFile_createFromZipEntry(fd, "not_a_dex.txt", zip_file.path, &dex_),
+            ADEXFILE_ERROR_INVALID_DEX);
+  EXPECT_EQ(dex_, nullptr);
+}
+
 TEST_F(ADexFileTest, Error_toString) {
-  constexpr size_t kNumErrors = 4;
+  constexpr size_t kNumErrors = 5;
   for (size_t i = 0; i < kNumErrors; i++) {
     const char* err = ADexFile_Error_toString(static_cast<ADexFile_Error>(i));
     ASSERT_NE(err, nullptr);
@@ -125,5 +125,24 @@ TEST(DexFileTest, get_all_method_infos_without_signature) {
   EXPECT_EQ(names, std::vector<std::string>({"Main.<init>", "Main.main"}));
 }
 
+TEST(DexFileTest, get_all_classes_and_their_methods) {
+  std::unique_ptr<DexFile> dex_file = GetTestDexData();
+  ASSERT_NE(dex_file, nullptr);
+
+  std::vector<std::string> names;
+  auto add_method = [&](const DexFile::Method& method) {
+    uint16_t registers_size = 0;
+    EXPECT_TRUE(method.GetCodeItemInfo(&registers_size));
+    EXPECT_EQ(registers_size, 1u);
+    names.push_back(method.GetName());
+  };
+  auto add_class = [&](const DexFile::Class& clazz) {
+    names.push_back(clazz.GetDescriptor());
+    EXPECT_EQ(clazz.ForEachMethod(add_method), 2u);
+  };
+  EXPECT_EQ(dex_file->ForEachClass(add_class), 1u);
+  EXPECT_EQ(names, std::vector<std::string>({"LMain;", "<init>", "main"}));
+}
+
 }  // namespace dex
 }  // namespace art_api
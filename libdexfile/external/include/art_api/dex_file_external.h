@@ -33,11 +33,15 @@ typedef struct ADexFile ADexFile; // NOLINT
 struct ADexFile_Method;
 typedef struct ADexFile_Method ADexFile_Method; // NOLINT
 
+struct ADexFile_Class;
+typedef struct ADexFile_Class ADexFile_Class; // NOLINT
+
 enum ADexFile_Error : uint32_t {
   ADEXFILE_ERROR_OK = 0,
   ADEXFILE_ERROR_INVALID_DEX = 1,
   ADEXFILE_ERROR_INVALID_HEADER = 2,
   ADEXFILE_ERROR_NOT_ENOUGH_DATA = 3,
+  ADEXFILE_ERROR_INVALID_ZIP = 4,
 };
 typedef enum ADexFile_Error ADexFile_Error; // NOLINT
 
@@ -47,6 +51,12 @@ typedef enum ADexFile_Error ADexFile_Error; // NOLINT
 typedef void ADexFile_MethodCallback(void* _Nullable callback_data,
                                      const ADexFile_Method* _Nonnull method);
 
+// Callback used to return information about a class definition.
+// The class information is valid only during the callback.
+// NOLINTNEXTLINE
+typedef void ADexFile_ClassCallback(void* _Nullable callback_data,
+                                    const ADexFile_Class* _Nonnull clazz);
+
 // Interprets a chunk of memory as a dex file.
 //
 // @param address Pointer to the start of dex file data.
@@ -72,6 +82,30 @@ ADexFile_Error ADexFile_create(const void* _Nonnull address,
                                const char* _Nonnull location,
                                /*out*/ ADexFile* _Nullable * _Nonnull out_dex_file);
 
+// Opens the first dex file stored in an entry of a zip archive (typically an APK).
+//
+// Uncompressed entries aligned to 4 bytes are mapped directly from the file without
+// copying. Other entries are extracted into memory owned by the returned object.
+//
+// @param fd File descriptor of the zip archive. It is not closed by this function
+//           and may be closed as soon as this function returns.
+// @param entry_name Name of the zip entry, for example "classes.dex".
+// @param location A string that describes the dex file. Preferably its path.
+//                 It is mostly used just for log messages and may be "".
+// @param dex_file The created dex file object, or nullptr on error.
+//                 It must be later freed with ADexFile_Destroy.
+//
+// @return ADEXFILE_ERROR_OK if successful.
+// @return ADEXFILE_ERROR_INVALID_ZIP if the archive or the entry cannot be read.
+// @return ADEXFILE_ERROR_INVALID_HEADER if the entry does not seem to represent DEX file.
+// @return ADEXFILE_ERROR_INVALID_DEX if any other non-specific error occurs.
+//
+// Thread-safe (creates new object).
+ADexFile_Error ADexFile_createFromZipEntry(int fd,
+                                           const char* _Nonnull entry_name,
+                                           const char* _Nonnull location,
+                                           /*out*/ ADexFile* _Nullable * _Nonnull out_dex_file);
+
 // Find method at given offset and call callback with information about the method.
 //
 // @param dex_offset Offset relative to the start of the dex file header.
@@ -101,6 +135,21 @@ size_t ADexFile_forEachMethod(ADexFile* _Nonnull self,
                               ADexFile_MethodCallback* _Nonnull callback,
                               void* _Nullable callback_data);
 
+// Call callback for all class definitions in the DEX file, in class def order.
+//
+// Nothing is allocated per class, which makes this suitable for scanning many dex files.
+//
+// @param callback The callback to call for all classes. Any data that needs to
+//                 outlive the execution of the callback must be copied by the user.
+// @param callback_data Extra user-specified argument for the callback.
+//
+// @return Number of classes found.
+//
+// Not thread-safe for calls on the same ADexFile instance.
+size_t ADexFile_forEachClass(ADexFile* _Nonnull self,
+                             ADexFile_ClassCallback* _Nonnull callback,
+                             void* _Nullable callback_data);
+
 // Free the given object.
 //
 // Thread-safe, can be called only once for given instance.
@@ -150,6 +199,54 @@ const char* _Nonnull ADexFile_Method_getQualifiedName(const ADexFile_Method* _No
 const char* _Nonnull ADexFile_Method_getClassDescriptor(const ADexFile_Method* _Nonnull self,
                                                         size_t* _Nullable out_size);
 
+// @return Access flags of the method (see Dex specification).
+uint32_t ADexFile_Method_getAccessFlags(const ADexFile_Method* _Nonnull self);
+
+// Read the header of the code item of the method.
+//
+// @param out_registers_size Optionally return the number of registers used by the code.
+// @param out_ins_size Optionally return the number of words of incoming arguments.
+// @param out_outs_size Optionally return the number of words of outgoing arguments.
+// @param out_tries_size Optionally return the number of try items.
+//
+// @return Non-zero if the method has a code item. Otherwise the outputs are not written.
+//
+// Not thread-safe for calls on the same ADexFile instance.
+int ADexFile_Method_getCodeItemInfo(const ADexFile_Method* _Nonnull self,
+                                    uint16_t* _Nullable out_registers_size,
+                                    uint16_t* _Nullable out_ins_size,
+                                    uint16_t* _Nullable out_outs_size,
+                                    uint16_t* _Nullable out_tries_size);
+
+// @return Class descriptor (mangled class name).
+//         The encoding is slightly modified UTF8 (see Dex specification).
+// @param out_size Optionally return string size (excluding null-terminator).
+//
+// Returned data may be short lived: it must be copied before calling
+// this method again within the same ADexFile.
+// (it is currently long lived, but this is not guaranteed in the future).
+//
+// Not thread-safe for calls on the same ADexFile instance.
+const char* _Nonnull ADexFile_Class_getDescriptor(const ADexFile_Class* _Nonnull self,
+                                                  size_t* _Nullable out_size);
+
+// @return Access flags of the class (see Dex specification).
+uint32_t ADexFile_Class_getAccessFlags(const ADexFile_Class* _Nonnull self);
+
+// Call callback for all methods declared in the class, including methods without code.
+// Methods without code (abstract and native methods) have a code offset and size of 0.
+//
+// @param callback The callback to call for all methods. Any data that needs to
+//                 outlive the execution of the callback must be copied by the user.
+// @param callback_data Extra user-specified argument for the callback.
+//
+// @return Number of methods found.
+//
+// Not thread-safe for calls on the same ADexFile instance.
+size_t ADexFile_Class_forEachMethod(const ADexFile_Class* _Nonnull self,
+                                    ADexFile_MethodCallback* _Nonnull callback,
+                                    void* _Nullable callback_data);
+
 // @return Compile-time literal or nullptr on error.
 const char* _Nullable ADexFile_Error_toString(ADexFile_Error self);
 
@@ -28,14 +28,21 @@ namespace art_api {
 namespace dex {
 
 #define FOR_EACH_ADEX_FILE_SYMBOL(MACRO) \
+  MACRO(ADexFile_Class_forEachMethod) \
+  MACRO(ADexFile_Class_getAccessFlags) \
+  MACRO(ADexFile_Class_getDescriptor) \
   MACRO(ADexFile_Error_toString) \
+  MACRO(ADexFile_Method_getAccessFlags) \
   MACRO(ADexFile_Method_getClassDescriptor) \
+  MACRO(ADexFile_Method_getCodeItemInfo) \
   MACRO(ADexFile_Method_getCodeOffset) \
   MACRO(ADexFile_Method_getName) \
   MACRO(ADexFile_Method_getQualifiedName) \
   MACRO(ADexFile_create) \
+  MACRO(ADexFile_createFromZipEntry) \
   MACRO(ADexFile_destroy) \
   MACRO(ADexFile_findMethodAtOffset) \
+  MACRO(ADexFile_forEachClass) \
   MACRO(ADexFile_forEachMethod) \
 
 #define DEFINE_ADEX_FILE_SYMBOL(DLFUNC) extern decltype(DLFUNC)* g_##DLFUNC;
@@ -72,9 +79,41 @@ class DexFile {
       return g_ADexFile_Method_getClassDescriptor(self, out_size);
     }
 
+    uint32_t GetAccessFlags() const {
+      return g_ADexFile_Method_getAccessFlags(self);
+    }
+
+    bool GetCodeItemInfo(uint16_t* out_registers_size,
+                         uint16_t* out_ins_size = nullptr,
+                         uint16_t* out_outs_size = nullptr,
+                         uint16_t* out_tries_size = nullptr) const {
+      return g_ADexFile_Method_getCodeItemInfo(
+          self, out_registers_size, out_ins_size, out_outs_size, out_tries_size) != 0;
+    }
+
     const ADexFile_Method* const self;
   };
 
+  struct Class {
+    const char* GetDescriptor(size_t* out_size = nullptr) const {
+      return g_ADexFile_Class_getDescriptor(self, out_size);
+    }
+
+    uint32_t GetAccessFlags() const {
+      return g_ADexFile_Class_getAccessFlags(self);
+    }
+
+    template<typename T /* lambda which takes (const DexFile::Method&) as argument */>
+    inline size_t ForEachMethod(T callback) const {
+      auto cb = [](void* ctx, const ADexFile_Method* m) {
+        (*reinterpret_cast<T*>(ctx))(Method{m});
+      };
+      return g_ADexFile_Class_forEachMethod(self, cb, &callback);
+    }
+
+    const ADexFile_Class* const self;
+  };
+
   struct Error {
     const char* ToString() const {
       return g_ADexFile_Error_toString(self);
@@ -105,6 +144,19 @@ class DexFile {
     return Error{error};
   }
 
+  static Error CreateFromZipEntry(int fd,
+                                  const char* entry_name,
+                                  const char* location,
+                                  /*out*/ std::unique_ptr<DexFile>* out_dex_file) {
+    LoadLibdexfile();
+    ADexFile* adex = nullptr;
+    ADexFile_Error error = g_ADexFile_createFromZipEntry(fd, entry_name, location, &adex);
+    if (adex != nullptr) {
+      *out_dex_file = std::unique_ptr<DexFile>(new DexFile{adex});
+    }
+    return Error{error};
+  }
+
   virtual ~DexFile() {
     g_ADexFile_destroy(self_);
   }
@@ -121,6 +173,12 @@ class DexFile {
     return g_ADexFile_forEachMethod(self_, cb, &callback);
   }
 
+  template<typename T /* lambda which takes (const DexFile::Class&) as argument */>
+  inline size_t ForEachClass(T callback) {
+    auto cb = [](void* ctx, const ADexFile_Class* c) { (*reinterpret_cast<T*>(ctx))(Class{c}); };
+    return g_ADexFile_forEachClass(self_, cb, &callback);
+  }
+
  protected:
   explicit DexFile(ADexFile* self) : self_(self) {}
 
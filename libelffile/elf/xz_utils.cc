@@ -16,6 +16,7 @@
 
 #include "xz_utils.h"
 
+#include <algorithm>
 #include <mutex>
 #include <vector>
 
@@ -98,6 +99,22 @@ void XzCompress(ArrayRef<const uint8_t> src,
   }
 }
 
+size_t XzNumChunks(size_t size, size_t chunk_size) {
+  DCHECK_NE(chunk_size, 0u);
+  return std::max<size_t>((size + chunk_size - 1u) / chunk_size, 1u);
+}
+
+void XzCompressChunk(ArrayRef<const uint8_t> src,
+                     size_t index,
+                     std::vector<uint8_t>* dst,
+                     size_t chunk_size) {
+  DCHECK_LT(index, XzNumChunks(src.size(), chunk_size));
+  size_t start = index * chunk_size;
+  ArrayRef<const uint8_t> chunk = src.SubArray(start, std::min(chunk_size, src.size() - start));
+  dst->reserve(chunk.size() / 4);
+  XzCompress(chunk, dst);
+}
+
 void XzDecompress(ArrayRef<const uint8_t> src, std::vector<uint8_t>* dst) {
   static const size_t page_size = GetPageSizeSlow();
   CHECK_NE(page_size, 0U);
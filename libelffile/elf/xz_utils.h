@@ -25,12 +25,26 @@
 namespace art {
 
 constexpr size_t kXzDefaultBlockSize = 16 * KB;
+constexpr size_t kXzDefaultChunkSize = 64 * kXzDefaultBlockSize;
 
 void XzCompress(ArrayRef<const uint8_t> src,
                 std::vector<uint8_t>* dst,
                 int level = 1 /* speed */,
                 size_t block_size = kXzDefaultBlockSize);
 
+// Returns the number of chunks of `chunk_size` bytes that `XzCompressChunk()` splits `size`
+// bytes of data into. There is always at least one chunk.
+size_t XzNumChunks(size_t size, size_t chunk_size = kXzDefaultChunkSize);
+
+// Compresses the chunk `index` of `src` as a standalone XZ stream. XZ decoders accept
+// concatenated streams, so the compressed chunks appended in order are valid XZ data for `src`.
+// The chunks can be compressed in parallel and the result does not depend on how.
+void XzCompressChunk(ArrayRef<const uint8_t> src,
+                     size_t index,
+                     std::vector<uint8_t>* dst,
+                     size_t chunk_size = kXzDefaultChunkSize);
+
+// Decompresses `src`, which can be several concatenated XZ streams.
 void XzDecompress(ArrayRef<const uint8_t> src, std::vector<uint8_t>* dst);
 
 }  // namespace art
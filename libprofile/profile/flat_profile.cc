@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flat_profile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+#include "base/bit_utils.h"
+#include "base/casts.h"
+#include "dex/dex_file.h"
+#include "dex/method_reference.h"
+
+namespace art {
+
+using android::base::StringPrintf;
+
+const uint8_t FlatProfile::kFlatProfileMagic[] = { 'p', 'f', 'l', '\0' };
+const uint8_t FlatProfile::kFlatProfileVersion[] = { '0', '0', '1', '\0' };
+
+struct FlatProfile::Header {
+  uint8_t magic[4];
+  uint8_t version[4];
+  uint32_t for_boot_image;
+  uint32_t num_dex_files;
+};
+
+struct FlatProfile::DexFileEntry {
+  uint32_t checksum;
+  uint32_t num_type_ids;
+  uint32_t num_method_ids;
+  uint32_t profile_key_offset;
+  uint32_t profile_key_size;
+  uint32_t methods_offset;
+  uint32_t num_methods;
+  uint32_t classes_offset;
+  uint32_t num_classes;
+};
+
+struct FlatProfile::MethodEntry {
+  uint16_t method_index;
+  uint16_t flags;
+};
+
+static_assert(sizeof(FlatProfile::kFlatProfileMagic) == 4u);
+static_assert(sizeof(FlatProfile::kFlatProfileVersion) == 4u);
+static_assert(FlatProfile::MethodHotness::kFlagLastBoot <= std::numeric_limits<uint16_t>::max(),
+              "Method flags must fit in MethodEntry::flags");
+
+bool FlatProfile::Write(const ProfileCompilationInfo& info, int fd, std::string* error_msg) {
+  std::vector<uint8_t> buffer;
+  auto append = [&](const void* data, size_t size) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+  };
+  auto align = [&](size_t alignment) {
+    buffer.resize(RoundUp(buffer.size(), alignment), 0u);
+  };
+
+  Header header;
+  memcpy(header.magic, kFlatProfileMagic, sizeof(header.magic));
+  memcpy(header.version, kFlatProfileVersion, sizeof(header.version));
+  header.for_boot_image = info.IsForBootImage() ? 1u : 0u;
+  header.num_dex_files = dchecked_integral_cast<uint32_t>(info.info_.size());
+  append(&header, sizeof(header));
+  // Reserve the dex file entries, they are filled once the data offsets are known.
+  size_t entries_offset = buffer.size();
+  buffer.resize(entries_offset + info.info_.size() * sizeof(DexFileEntry), 0u);
+
+  std::vector<DexFileEntry> entries;
+  entries.reserve(info.info_.size());
+  for (const std::unique_ptr<ProfileCompilationInfo::DexFileData>& data : info.info_) {
+    DexFileEntry entry;
+    entry.checksum = data->checksum;
+    entry.num_type_ids = data->num_type_ids;
+    entry.num_method_ids = data->num_method_ids;
+    entry.profile_key_offset = dchecked_integral_cast<uint32_t>(buffer.size());
+    entry.profile_key_size = dchecked_integral_cast<uint32_t>(data->profile_key.size());
+    append(data->profile_key.data(), data->profile_key.size());
+
+    align(alignof(MethodEntry));
+    entry.methods_offset = dchecked_integral_cast<uint32_t>(buffer.size());
+    entry.num_methods = 0u;
+    for (uint32_t method_index = 0; method_index != data->num_method_ids; ++method_index) {
+      MethodHotness hotness = data->GetHotnessInfo(method_index);
+      if (hotness.IsInProfile()) {
+        MethodEntry method_entry = {dchecked_integral_cast<uint16_t>(method_index),
+                                    dchecked_integral_cast<uint16_t>(hotness.GetFlags())};
+        append(&method_entry, sizeof(method_entry));
+        ++entry.num_methods;
+      }
+    }
+
+    // Classes with a descriptor which is not in the dex file are not represented.
+    align(alignof(uint16_t));
+    entry.classes_offset = dchecked_integral_cast<uint32_t>(buffer.size());
+    entry.num_classes = 0u;
+    for (dex::TypeIndex type_index : data->class_set) {
+      if (type_index.index_ < data->num_type_ids) {
+        append(&type_index.index_, sizeof(type_index.index_));
+        ++entry.num_classes;
+      }
+    }
+    align(alignof(DexFileEntry));
+    entries.push_back(entry);
+  }
+  if (!entries.empty()) {
+    memcpy(buffer.data() + entries_offset, entries.data(), entries.size() * sizeof(DexFileEntry));
+  }
+
+  if (!android::base::WriteFully(fd, buffer.data(), buffer.size())) {
+    *error_msg = StringPrintf("Failed to write flat profile: %s", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool FlatProfile::IsFlatProfile(int fd) {
+  uint8_t magic[sizeof(kFlatProfileMagic)];
+  return android::base::ReadFullyAtOffset(fd, magic, sizeof(magic), /*offset=*/ 0) &&
+         memcmp(magic, kFlatProfileMagic, sizeof(magic)) == 0;
+}
+
+std::unique_ptr<FlatProfile> FlatProfile::Open(int fd, std::string* error_msg) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    *error_msg = StringPrintf("Failed to stat flat profile: %s", strerror(errno));
+    return nullptr;
+  }
+  size_t size = static_cast<size_t>(st.st_size);
+  if (size < sizeof(Header)) {
+    *error_msg = StringPrintf("Flat profile too small: %zu", size);
+    return nullptr;
+  }
+  MemMap map = MemMap::MapFile(size,
+                               PROT_READ,
+                               MAP_PRIVATE,
+                               fd,
+                               /*start=*/ 0,
+                               /*low_4gb=*/ false,
+                               "flat profile",
+                               error_msg);
+  if (!map.IsValid()) {
+    return nullptr;
+  }
+  std::unique_ptr<FlatProfile> profile(new FlatProfile(std::move(map)));
+
+  const Header& header = profile->GetHeader();
+  if (memcmp(header.magic, kFlatProfileMagic, sizeof(header.magic)) != 0 ||
+      memcmp(header.version, kFlatProfileVersion, sizeof(header.version)) != 0) {
+    *error_msg = "Invalid flat profile magic or version";
+    return nullptr;
+  }
+  if (header.num_dex_files > (size - sizeof(Header)) / sizeof(DexFileEntry)) {
+    *error_msg = StringPrintf("Invalid number of dex files: %u", header.num_dex_files);
+    return nullptr;
+  }
+  auto is_valid_range = [size](uint32_t offset, uint32_t count, size_t element_size) {
+    return offset <= size && count <= (size - offset) / element_size;
+  };
+  for (size_t i = 0; i != header.num_dex_files; ++i) {
+    const DexFileEntry& entry = profile->GetDexFileEntry(i);
+    if (!is_valid_range(entry.profile_key_offset, entry.profile_key_size, sizeof(char)) ||
+        !IsAligned<alignof(MethodEntry)>(entry.methods_offset) ||
+        !is_valid_range(entry.methods_offset, entry.num_methods, sizeof(MethodEntry)) ||
+        !IsAligned<alignof(uint16_t)>(entry.classes_offset) ||
+        !is_valid_range(entry.classes_offset, entry.num_classes, sizeof(uint16_t))) {
+      *error_msg = StringPrintf("Invalid data for dex file %zu in flat profile", i);
+      return nullptr;
+    }
+  }
+  return profile;
+}
+
+const FlatProfile::Header& FlatProfile::GetHeader() const {
+  return *reinterpret_cast<const Header*>(map_.Begin());
+}
+
+const FlatProfile::DexFileEntry& FlatProfile::GetDexFileEntry(size_t index) const {
+  DCHECK_LT(index, GetNumberOfDexFiles());
+  return reinterpret_cast<const DexFileEntry*>(map_.Begin() + sizeof(Header))[index];
+}
+
+std::string_view FlatProfile::GetProfileKey(const DexFileEntry& entry) const {
+  return std::string_view(reinterpret_cast<const char*>(map_.Begin() + entry.profile_key_offset),
+                          entry.profile_key_size);
+}
+
+const FlatProfile::MethodEntry* FlatProfile::GetMethods(const DexFileEntry& entry) const {
+  return reinterpret_cast<const MethodEntry*>(map_.Begin() + entry.methods_offset);
+}
+
+const uint16_t* FlatProfile::GetClasses(const DexFileEntry& entry) const {
+  return reinterpret_cast<const uint16_t*>(map_.Begin() + entry.classes_offset);
+}
+
+bool FlatProfile::IsForBootImage() const {
+  return GetHeader().for_boot_image != 0u;
+}
+
+size_t FlatProfile::GetNumberOfDexFiles() const {
+  return GetHeader().num_dex_files;
+}
+
+const FlatProfile::DexFileEntry* FlatProfile::FindDexFileEntry(const DexFile& dex_file) const {
+  std::string_view base_key =
+      ProfileCompilationInfo::GetProfileDexFileBaseKeyView(dex_file.GetLocation());
+  for (size_t i = 0, num_dex_files = GetNumberOfDexFiles(); i != num_dex_files; ++i) {
+    const DexFileEntry& entry = GetDexFileEntry(i);
+    if (base_key ==
+        ProfileCompilationInfo::GetBaseKeyViewFromAugmentedKey(GetProfileKey(entry))) {
+      return (entry.checksum == dex_file.GetLocationChecksum()) ? &entry : nullptr;
+    }
+  }
+  return nullptr;
+}
+
+FlatProfile::MethodHotness FlatProfile::GetMethodHotness(const MethodReference& method_ref) const {
+  MethodHotness hotness;
+  const DexFileEntry* entry = FindDexFileEntry(*method_ref.dex_file);
+  if (entry == nullptr) {
+    return hotness;
+  }
+  const MethodEntry* begin = GetMethods(*entry);
+  const MethodEntry* end = begin + entry->num_methods;
+  const MethodEntry* it = std::lower_bound(
+      begin, end, method_ref.index, [](const MethodEntry& lhs, uint32_t method_index) {
+        return lhs.method_index < method_index;
+      });
+  if (it != end && it->method_index == method_ref.index) {
+    for (uint32_t flag = MethodHotness::kFlagFirst;
+         flag <= MethodHotness::kFlagLastBoot;
+         flag <<= 1) {
+      if ((it->flags & flag) != 0u) {
+        hotness.AddFlag(enum_cast<MethodHotness::Flag>(flag));
+      }
+    }
+  }
+  return hotness;
+}
+
+bool FlatProfile::ContainsClass(const DexFile& dex_file, dex::TypeIndex type_index) const {
+  const DexFileEntry* entry = FindDexFileEntry(dex_file);
+  if (entry == nullptr) {
+    return false;
+  }
+  const uint16_t* begin = GetClasses(*entry);
+  const uint16_t* end = begin + entry->num_classes;
+  return std::binary_search(begin, end, type_index.index_);
+}
+
+bool FlatProfile::ConvertTo(ProfileCompilationInfo* info) const {
+  if (info->IsForBootImage() != IsForBootImage()) {
+    LOG(ERROR) << "Cannot convert a flat profile to a different kind of profile";
+    return false;
+  }
+  for (size_t i = 0, num_dex_files = GetNumberOfDexFiles(); i != num_dex_files; ++i) {
+    const DexFileEntry& entry = GetDexFileEntry(i);
+    ProfileCompilationInfo::DexFileData* data = info->GetOrAddDexFileData(
+        std::string(GetProfileKey(entry)),
+        entry.checksum,
+        entry.num_type_ids,
+        entry.num_method_ids);
+    if (data == nullptr) {
+      return false;
+    }
+    const MethodEntry* methods = GetMethods(entry);
+    for (uint32_t j = 0; j != entry.num_methods; ++j) {
+      if (!data->AddMethod(static_cast<MethodHotness::Flag>(methods[j].flags),
+                           methods[j].method_index)) {
+        return false;
+      }
+    }
+    const uint16_t* classes = GetClasses(entry);
+    for (uint32_t j = 0; j != entry.num_classes; ++j) {
+      if (classes[j] >= entry.num_type_ids) {
+        LOG(ERROR) << "Invalid class index " << classes[j] << " in flat profile";
+        return false;
+      }
+      data->class_set.insert(dex::TypeIndex(classes[j]));
+    }
+  }
+  return true;
+}
+
+}  // namespace art
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_LIBPROFILE_PROFILE_FLAT_PROFILE_H_
+#define ART_LIBPROFILE_PROFILE_FLAT_PROFILE_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "base/mem_map.h"
+#include "dex/dex_file_types.h"
+#include "profile/profile_compilation_info.h"
+
+namespace art {
+
+class DexFile;
+class MethodReference;
+
+/**
+ * Read-only profile in a layout that can be queried directly from a memory mapped file.
+ *
+ * `ProfileCompilationInfo::Load()` decompresses and parses the whole profile into
+ * hash maps and bitmaps. For queries on large profiles (e.g. boot profiles) this class
+ * maps the file instead and answers them without parsing:
+ *
+ *   Header
+ *   DexFileEntry[number of dex files]
+ *   for each dex file:
+ *     profile key (not NUL-terminated)
+ *     MethodEntry[number of methods], sorted by method index
+ *     uint16_t class type index[number of classes], sorted
+ *
+ * Flat profiles are created from and converted back to a `ProfileCompilationInfo`.
+ * Inline caches and classes that are not defined by type indexes of the dex file are not
+ * represented; a converted profile only has the method hotness flags and the classes.
+ */
+class FlatProfile {
+ public:
+  static const uint8_t kFlatProfileMagic[];
+  static const uint8_t kFlatProfileVersion[];
+
+  using MethodHotness = ProfileCompilationInfo::MethodHotness;
+
+  // Write `info` in the flat format to `fd`. Returns true on success.
+  static bool Write(const ProfileCompilationInfo& info, int fd, std::string* error_msg);
+
+  // Return whether the file `fd` starts with the flat profile magic.
+  static bool IsFlatProfile(int fd);
+
+  // Map the flat profile `fd` and check its structure. Returns null on failure.
+  static std::unique_ptr<FlatProfile> Open(int fd, std::string* error_msg);
+
+  // Return whether the profile is for the boot image.
+  bool IsForBootImage() const;
+
+  // Return the number of dex files in the profile.
+  size_t GetNumberOfDexFiles() const;
+
+  // Return the hotness of the referenced method. Like
+  // `ProfileCompilationInfo::GetMethodHotness()` without an annotation, only the first
+  // dex file in the profile matching the dex file of the method is searched.
+  MethodHotness GetMethodHotness(const MethodReference& method_ref) const;
+
+  // Return whether the class is in the profile. Dex files are matched as for
+  // `GetMethodHotness()`.
+  bool ContainsClass(const DexFile& dex_file, dex::TypeIndex type_index) const;
+
+  // Add the methods and classes of this profile to `info`, which must be for the same
+  // kind of profile (boot image or not). Returns true on success.
+  bool ConvertTo(ProfileCompilationInfo* info) const;
+
+ private:
+  struct Header;
+  struct DexFileEntry;
+  struct MethodEntry;
+
+  explicit FlatProfile(MemMap&& map) : map_(std::move(map)) {}
+
+  const Header& GetHeader() const;
+  const DexFileEntry& GetDexFileEntry(size_t index) const;
+  std::string_view GetProfileKey(const DexFileEntry& entry) const;
+  const MethodEntry* GetMethods(const DexFileEntry& entry) const;
+  const uint16_t* GetClasses(const DexFileEntry& entry) const;
+
+  // Find the first entry matching `dex_file`, or null if there is none.
+  const DexFileEntry* FindDexFileEntry(const DexFile& dex_file) const;
+
+  MemMap map_;
+};
+
+}  // namespace art
+
+#endif  // ART_LIBPROFILE_PROFILE_FLAT_PROFILE_H_
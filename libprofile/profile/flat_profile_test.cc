@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/common_art_test.h"
+#include "base/unix_file/fd_file.h"
+#include "dex/dex_file.h"
+#include "dex/method_reference.h"
+#include "profile/flat_profile.h"
+#include "profile/profile_compilation_info.h"
+#include "profile/profile_test_helper.h"
+
+namespace art {
+
+class FlatProfileTest : public CommonArtTest, public ProfileTestHelper {
+ public:
+  void SetUp() override {
+    CommonArtTest::SetUp();
+    dex1 = BuildDex("location1", /*location_checksum=*/ 1, "LUnique1;", /*num_method_ids=*/ 101);
+    dex2 = BuildDex("location2", /*location_checksum=*/ 2, "LUnique2;", /*num_method_ids=*/ 102);
+    dex1_checksum_mismatch = BuildDex("location1",
+                                      /*location_checksum=*/ 12,
+                                      "LUnique1;",
+                                      /*num_method_ids=*/ 101);
+  }
+
+ protected:
+  std::unique_ptr<FlatProfile> WriteAndOpen(const ProfileCompilationInfo& info) {
+    ScratchFile file;
+    std::string error_msg;
+    CHECK(FlatProfile::Write(info, file.GetFd(), &error_msg)) << error_msg;
+    CHECK(FlatProfile::IsFlatProfile(file.GetFd()));
+    std::unique_ptr<FlatProfile> profile = FlatProfile::Open(file.GetFd(), &error_msg);
+    CHECK(profile != nullptr) << error_msg;
+    return profile;
+  }
+
+  void CheckSameData(const ProfileCompilationInfo& info, const FlatProfile& profile) {
+    for (const DexFile* dex : {dex1, dex2, dex1_checksum_mismatch}) {
+      for (uint32_t method_idx = 0; method_idx != dex->NumMethodIds(); ++method_idx) {
+        MethodReference ref(dex, method_idx);
+        EXPECT_EQ(info.GetMethodHotness(ref).GetFlags(), profile.GetMethodHotness(ref).GetFlags())
+            << dex->GetLocation() << " " << method_idx;
+      }
+      for (uint32_t type_idx = 0; type_idx != dex->NumTypeIds(); ++type_idx) {
+        EXPECT_EQ(info.ContainsClass(*dex, dex::TypeIndex(type_idx)),
+                  profile.ContainsClass(*dex, dex::TypeIndex(type_idx)))
+            << dex->GetLocation() << " " << type_idx;
+      }
+    }
+  }
+
+  const DexFile* dex1;
+  const DexFile* dex2;
+  const DexFile* dex1_checksum_mismatch;
+};
+
+TEST_F(FlatProfileTest, Empty) {
+  ProfileCompilationInfo info;
+  std::unique_ptr<FlatProfile> profile = WriteAndOpen(info);
+  EXPECT_EQ(profile->GetNumberOfDexFiles(), 0u);
+  EXPECT_FALSE(profile->IsForBootImage());
+  EXPECT_FALSE(profile->GetMethodHotness(MethodReference(dex1, 0)).IsInProfile());
+  EXPECT_FALSE(profile->ContainsClass(*dex1, dex::TypeIndex(0)));
+}
+
+TEST_F(FlatProfileTest, MethodsAndClasses) {
+  ProfileCompilationInfo info;
+  for (uint16_t method_idx = 0; method_idx != 100; method_idx += 3) {
+    ASSERT_TRUE(AddMethod(&info, dex1, method_idx));
+  }
+  for (uint16_t method_idx = 1; method_idx != 100; method_idx += 7) {
+    ASSERT_TRUE(AddMethod(&info, dex1, method_idx, Hotness::kFlagStartup));
+    ASSERT_TRUE(AddMethod(&info, dex2, method_idx, Hotness::kFlagPostStartup));
+  }
+  ASSERT_TRUE(AddClass(&info, dex1, dex::TypeIndex(0)));
+  ASSERT_TRUE(AddClass(&info, dex2, dex::TypeIndex(3)));
+  ASSERT_TRUE(AddClass(&info, dex2, dex::TypeIndex(5)));
+
+  std::unique_ptr<FlatProfile> profile = WriteAndOpen(info);
+  EXPECT_EQ(profile->GetNumberOfDexFiles(), 2u);
+  CheckSameData(info, *profile);
+}
+
+TEST_F(FlatProfileTest, BootImageFlags) {
+  ProfileCompilationInfo info(/*for_boot_image=*/ true);
+  ASSERT_TRUE(AddMethod(&info,
+                        dex1,
+                        /*method_idx=*/ 5,
+                        static_cast<Hotness::Flag>(Hotness::kFlagHot | Hotness::kFlagBoot)));
+  ASSERT_TRUE(AddMethod(&info, dex2, /*method_idx=*/ 7, Hotness::kFlagStartupMaxBin));
+
+  std::unique_ptr<FlatProfile> profile = WriteAndOpen(info);
+  EXPECT_TRUE(profile->IsForBootImage());
+  CheckSameData(info, *profile);
+}
+
+TEST_F(FlatProfileTest, ConvertTo) {
+  ProfileCompilationInfo info;
+  ASSERT_TRUE(AddMethod(&info, dex1, /*method_idx=*/ 1));
+  ASSERT_TRUE(AddMethod(&info, dex1, /*method_idx=*/ 2, Hotness::kFlagStartup));
+  ASSERT_TRUE(AddMethod(&info, dex2, /*method_idx=*/ 3, Hotness::kFlagPostStartup));
+  ASSERT_TRUE(AddClass(&info, dex2, dex::TypeIndex(1)));
+  std::unique_ptr<FlatProfile> profile = WriteAndOpen(info);
+
+  ProfileCompilationInfo converted;
+  ASSERT_TRUE(profile->ConvertTo(&converted));
+  EXPECT_TRUE(converted.Equals(info));
+
+  ProfileCompilationInfo boot_info(/*for_boot_image=*/ true);
+  EXPECT_FALSE(profile->ConvertTo(&boot_info));
+}
+
+TEST_F(FlatProfileTest, RejectInvalidFile) {
+  ScratchFile file;
+  ProfileCompilationInfo info;
+  ASSERT_TRUE(AddMethod(&info, dex1, /*method_idx=*/ 1));
+  ASSERT_TRUE(info.Save(file.GetFd()));
+  EXPECT_FALSE(FlatProfile::IsFlatProfile(file.GetFd()));
+  std::string error_msg;
+  EXPECT_TRUE(FlatProfile::Open(file.GetFd(), &error_msg) == nullptr);
+}
+
+}  // namespace art
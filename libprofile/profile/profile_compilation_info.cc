@@ -48,6 +48,7 @@
 #include "base/globals.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/malloc_arena_pool.h"
+#include "base/memfd.h"
 #include "base/os.h"
 #include "base/safe_map.h"
 #include "base/scoped_flock.h"
@@ -82,6 +83,17 @@ static_assert(sizeof(ProfileCompilationInfo::kProfileVersionForBootImage) == 4,
 // DO NOT CHANGE THIS! (it's similar to classes.dex in the apk files).
 const char ProfileCompilationInfo::kDexMetadataProfileEntry[] = "primary.prof";
 
+// The magic at the start of each record of a profile journal.
+const uint8_t ProfileCompilationInfo::kProfileJournalMagic[] = { 'p', 'r', 'j', '\0' };
+
+// Header of a profile journal record. It is followed by `size` bytes of a profile in the
+// regular format.
+struct ProfileJournalRecordHeader {
+  uint8_t magic[4];
+  uint32_t size;
+};
+static_assert(sizeof(ProfileJournalRecordHeader) == 8u);
+
 // A synthetic annotations that can be used to denote that no annotation should
 // be associated with the profile samples. We use the empty string for the package name
 // because that's an invalid package name and should never occur in practice.
@@ -236,8 +248,11 @@ enum class ProfileCompilationInfo::FileSectionType : uint32_t {
   // an optional reserved section not implemented on client yet.
   kAggregationCounts = 4,
 
+  // Receiver frequencies of the inline cache classes in the methods section.
+  kInlineCacheCounts = 5,
+
   // The number of known sections.
-  kNumberOfSections = 5
+  kNumberOfSections = 6
 };
 
 class ProfileCompilationInfo::FileSectionInfo {
@@ -589,7 +604,8 @@ ProfileCompilationInfo::~ProfileCompilationInfo() {
   VLOG(profiler) << Dumpable<MemStats>(allocator_.GetMemStats());
 }
 
-void ProfileCompilationInfo::DexPcData::AddClass(const dex::TypeIndex& type_idx) {
+void ProfileCompilationInfo::DexPcData::AddClass(const dex::TypeIndex& type_idx,
+                                                 uint32_t count) {
   if (is_megamorphic || is_missing_types) {
     return;
   }
@@ -601,6 +617,7 @@ void ProfileCompilationInfo::DexPcData::AddClass(const dex::TypeIndex& type_idx)
   auto lb = classes.lower_bound(type_idx);
   if (lb != classes.end() && *lb == type_idx) {
     // The type index exists.
+    AddCount(type_idx, count);
     return;
   }
 
@@ -608,11 +625,26 @@ void ProfileCompilationInfo::DexPcData::AddClass(const dex::TypeIndex& type_idx)
   if (classes.size() + 1 >= ProfileCompilationInfo::kIndividualInlineCacheSize) {
     is_megamorphic = true;
     classes.clear();
+    counts.clear();
     return;
   }
 
   // The type does not exist and the inline cache will not be megamorphic.
   classes.emplace_hint(lb, type_idx);
+  AddCount(type_idx, count);
+}
+
+void ProfileCompilationInfo::DexPcData::AddCount(const dex::TypeIndex& type_idx,
+                                                 uint32_t count) {
+  DCHECK(classes.find(type_idx) != classes.end());
+  if (count == 0u) {
+    return;
+  }
+  uint32_t& value = counts.FindOrAdd(type_idx, 0u)->second;
+  // Saturate rather than overflow, only the relative frequencies matter.
+  value = (count > std::numeric_limits<uint32_t>::max() - value)
+      ? std::numeric_limits<uint32_t>::max()
+      : value + count;
 }
 
 // Transform the actual dex location into a key used to index the dex file in the profile.
@@ -963,6 +995,7 @@ static bool WriteBuffer(int fd, const void* buffer, size_t byte_count) {
  *   Classes - optional, zipped
  *   Methods - optional, zipped
  *   AggregationCounts - optional, zipped, server-side
+ *   InlineCacheCounts - optional, zipped
  *
  * DexFiles:
  *    number_of_dex_files
@@ -1001,6 +1034,18 @@ static bool WriteBuffer(int fd, const void* buffer, size_t byte_count) {
  *    type_index_diff[dex_map_size]
  * where `M` stands for special encodings indicating missing types (kIsMissingTypesEncoding)
  * or memamorphic call (kIsMegamorphicEncoding) which both imply `dex_map_size == 0`.
+ *
+ * InlineCacheCounts contains records for any number of dex files, each consisting of:
+ *    profile_index  // Index of the dex file in DexFiles section.
+ *    following_data_size  // For easy skipping of remaining data when dex file is filtered out.
+ *    inline_cache_counts_encoding[]  // Until the size indicated by `following_data_size`.
+ * where the `inline_cache_counts_encoding` is
+ *    method_index
+ *    dex_pc
+ *    number_of_counts
+ *    (type_index,count)[number_of_counts]
+ * and refers to an inline cache in the Methods section. Classes without a count have not
+ * been sampled. Old versions of ART ignore this section and see the plain inline caches.
  **/
 bool ProfileCompilationInfo::Save(int fd) {
   uint64_t start = NanoTime();
@@ -1020,6 +1065,7 @@ bool ProfileCompilationInfo::Save(int fd) {
   uint64_t dex_files_section_size = sizeof(ProfileIndexType);  // Number of dex files.
   uint64_t classes_section_size = 0u;
   uint64_t methods_section_size = 0u;
+  uint64_t inline_cache_counts_section_size = 0u;
   DCHECK_LE(info_.size(), MaxProfileIndex());
   for (const std::unique_ptr<DexFileData>& dex_data : info_) {
     if (dex_data->profile_key.size() > kMaxDexFileKeyLength) {
@@ -1032,13 +1078,15 @@ bool ProfileCompilationInfo::Save(int fd) {
         sizeof(uint16_t) + dex_data->profile_key.size();
     classes_section_size += dex_data->ClassesDataSize();
     methods_section_size += dex_data->MethodsDataSize();
+    inline_cache_counts_section_size += dex_data->InlineCacheCountsDataSize();
   }
 
   const uint32_t file_section_count =
       /* dex files */ 1u +
       /* extra descriptors */ (extra_descriptors_section_size != 0u ? 1u : 0u) +
       /* classes */ (classes_section_size != 0u ? 1u : 0u) +
-      /* methods */ (methods_section_size != 0u ? 1u : 0u);
+      /* methods */ (methods_section_size != 0u ? 1u : 0u) +
+      /* inline cache counts */ (inline_cache_counts_section_size != 0u ? 1u : 0u);
   uint64_t header_and_infos_size =
       sizeof(FileHeader) + file_section_count * sizeof(FileSectionInfo);
 
@@ -1049,7 +1097,8 @@ bool ProfileCompilationInfo::Save(int fd) {
       dex_files_section_size +
       extra_descriptors_section_size +
       classes_section_size +
-      methods_section_size;
+      methods_section_size +
+      inline_cache_counts_section_size;
   VLOG(profiler) << "Required capacity: " << total_uncompressed_size << " bytes.";
   if (total_uncompressed_size > GetSizeErrorThresholdBytes()) {
     LOG(WARNING) << "Profile data size exceeds "
@@ -1148,6 +1197,22 @@ bool ProfileCompilationInfo::Save(int fd) {
     add_section_info(FileSectionType::kMethods, buffer.Size(), methods_section_size);
   }
 
+  // Write the inline cache counts section.
+  if (inline_cache_counts_section_size != 0u) {
+    SafeBuffer buffer(inline_cache_counts_section_size);
+    for (const std::unique_ptr<DexFileData>& dex_data : info_) {
+      dex_data->WriteInlineCacheCounts(buffer);
+    }
+    if (!buffer.Deflate()) {
+      return false;
+    }
+    if (!WriteBuffer(fd, buffer.Get(), buffer.Size())) {
+      return false;
+    }
+    add_section_info(
+        FileSectionType::kInlineCacheCounts, buffer.Size(), inline_cache_counts_section_size);
+  }
+
   if (file_offset > GetSizeWarningThresholdBytes()) {
     LOG(WARNING) << "Profile data size exceeds "
         << GetSizeWarningThresholdBytes()
@@ -1189,6 +1254,48 @@ bool ProfileCompilationInfo::Save(int fd) {
   return true;
 }
 
+bool ProfileCompilationInfo::AppendToJournal(int fd, /*out*/ uint64_t* bytes_written) {
+  ScopedTrace trace(__PRETTY_FUNCTION__);
+  DCHECK_GE(fd, 0);
+
+  // `Save()` writes the header last, so write the record to memory first. The record is
+  // then appended with a single write, so that a reader sees either all of it or a
+  // truncated tail that is ignored.
+  android::base::unique_fd record_fd(memfd_create("profile journal record", MFD_CLOEXEC));
+  if (record_fd.get() < 0) {
+    PLOG(WARNING) << "Failed to create memfd for profile journal record";
+    return false;
+  }
+  if (!Save(record_fd.get())) {
+    return false;
+  }
+  off_t size = lseek(record_fd.get(), 0, SEEK_END);
+  if (size < 0 || static_cast<uint64_t>(size) > std::numeric_limits<uint32_t>::max()) {
+    LOG(WARNING) << "Invalid profile journal record size " << size;
+    return false;
+  }
+  std::vector<uint8_t> buffer(sizeof(ProfileJournalRecordHeader) + size);
+  ProfileJournalRecordHeader header;
+  memcpy(header.magic, kProfileJournalMagic, sizeof(kProfileJournalMagic));
+  header.size = dchecked_integral_cast<uint32_t>(size);
+  memcpy(buffer.data(), &header, sizeof(header));
+  if (!android::base::ReadFullyAtOffset(record_fd.get(),
+                                        buffer.data() + sizeof(header),
+                                        size,
+                                        /*offset=*/ 0)) {
+    PLOG(WARNING) << "Failed to read profile journal record";
+    return false;
+  }
+  if (!WriteBuffer(fd, buffer.data(), buffer.size())) {
+    PLOG(WARNING) << "Failed to append profile journal record";
+    return false;
+  }
+  if (bytes_written != nullptr) {
+    *bytes_written = buffer.size();
+  }
+  return true;
+}
+
 ProfileCompilationInfo::DexFileData* ProfileCompilationInfo::GetOrAddDexFileData(
     const std::string& profile_key,
     uint32_t checksum,
@@ -1375,7 +1482,9 @@ bool ProfileCompilationInfo::AddMethod(const ProfileMethodInfo& pmi,
       FindOrAddDexPc(inline_cache, cache.dex_pc)->SetIsMegamorphic();
       continue;
     }
-    for (const TypeReference& class_ref : cache.classes) {
+    DCHECK(cache.counts.empty() || cache.counts.size() == cache.classes.size());
+    for (size_t i = 0; i != cache.classes.size(); ++i) {
+      const TypeReference& class_ref = cache.classes[i];
       DexPcData* dex_pc_data = FindOrAddDexPc(inline_cache, cache.dex_pc);
       if (dex_pc_data->is_missing_types || dex_pc_data->is_megamorphic) {
         // Don't bother adding classes if we are missing types or already megamorphic.
@@ -1383,7 +1492,7 @@ bool ProfileCompilationInfo::AddMethod(const ProfileMethodInfo& pmi,
       }
       dex::TypeIndex type_index = FindOrCreateTypeIndex(*pmi.ref.dex_file, class_ref);
       if (type_index.IsValid()) {
-        dex_pc_data->AddClass(type_index);
+        dex_pc_data->AddClass(type_index, cache.counts.empty() ? 0u : cache.counts[i]);
       } else {
         // Could not create artificial type index.
         dex_pc_data->SetIsMissingTypes();
@@ -1791,6 +1900,42 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::ReadMethodsSec
   return ProfileLoadStatus::kSuccess;
 }
 
+ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::ReadInlineCacheCountsSection(
+    ProfileSource& source,
+    const FileSectionInfo& section_info,
+    const dchecked_vector<ProfileIndexType>& dex_profile_index_remap,
+    const dchecked_vector<ExtraDescriptorIndex>& extra_descriptors_remap,
+    /*out*/ std::string* error) {
+  DCHECK(section_info.GetType() == FileSectionType::kInlineCacheCounts);
+  SafeBuffer buffer;
+  ProfileLoadStatus status = ReadSectionData(source, section_info, &buffer, error);
+  if (status != ProfileLoadStatus::kSuccess) {
+    return status;
+  }
+
+  while (buffer.GetAvailableBytes() != 0u) {
+    ProfileIndexType profile_index;
+    if (!buffer.ReadUintAndAdvance(&profile_index)) {
+      *error = "Error profile index in inline cache counts section.";
+      return ProfileLoadStatus::kBadData;
+    }
+    if (profile_index >= dex_profile_index_remap.size()) {
+      *error = "Invalid profile index in inline cache counts section.";
+      return ProfileLoadStatus::kBadData;
+    }
+    profile_index = dex_profile_index_remap[profile_index];
+    if (profile_index == MaxProfileIndex()) {
+      status = DexFileData::SkipInlineCacheCounts(buffer, error);
+    } else {
+      status = info_[profile_index]->ReadInlineCacheCounts(buffer, extra_descriptors_remap, error);
+    }
+    if (status != ProfileLoadStatus::kSuccess) {
+      return status;
+    }
+  }
+  return ProfileLoadStatus::kSuccess;
+}
+
 // TODO(calin): fail fast if the dex checksums don't match.
 ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
     int32_t fd,
@@ -1800,22 +1945,33 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
   ScopedTrace trace(__PRETTY_FUNCTION__);
   DCHECK_GE(fd, 0);
 
+  if (IsProfileJournal(fd)) {
+    return LoadJournal(fd, error, merge_classes, filter_fn);
+  }
+
   std::unique_ptr<ProfileSource> source;
   ProfileLoadStatus status = OpenSource(fd, &source, error);
   if (status != ProfileLoadStatus::kSuccess) {
     return status;
   }
+  return LoadFromSource(*source, error, merge_classes, filter_fn);
+}
 
+ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadFromSource(
+    ProfileSource& source,
+    std::string* error,
+    bool merge_classes,
+    const ProfileLoadFilterFn& filter_fn) {
   // We allow empty profile files.
   // Profiles may be created by ActivityManager or installd before we manage to
   // process them in the runtime or profman.
-  if (source->HasEmptyContent()) {
+  if (source.HasEmptyContent()) {
     return ProfileLoadStatus::kSuccess;
   }
 
   // Read file header.
   FileHeader header;
-  status = source->Read(&header, sizeof(FileHeader), "ReadProfileHeader", error);
+  ProfileLoadStatus status = source.Read(&header, sizeof(FileHeader), "ReadProfileHeader", error);
   if (status != ProfileLoadStatus::kSuccess) {
     return status;
   }
@@ -1839,7 +1995,7 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
 
   // Read section infos.
   dchecked_vector<FileSectionInfo> section_infos(section_count);
-  status = source->Read(
+  status = source.Read(
       section_infos.data(), section_count * sizeof(FileSectionInfo), "ReadSectionInfos", error);
   if (status != ProfileLoadStatus::kSuccess) {
     return status;
@@ -1878,7 +2034,7 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
   }
   dchecked_vector<ProfileIndexType> dex_profile_index_remap;
   status = ReadDexFilesSection(
-      *source, dex_files_section_info, filter_fn, &dex_profile_index_remap, error);
+      source, dex_files_section_info, filter_fn, &dex_profile_index_remap, error);
   if (status != ProfileLoadStatus::kSuccess) {
     DCHECK(!error->empty());
     return status;
@@ -1896,25 +2052,32 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
         break;
       case FileSectionType::kExtraDescriptors:
         status = ReadExtraDescriptorsSection(
-            *source, section_info, &extra_descriptors_remap, error);
+            source, section_info, &extra_descriptors_remap, error);
         break;
       case FileSectionType::kClasses:
         // Skip if all dex files were filtered out.
         if (!info_.empty() && merge_classes) {
           status = ReadClassesSection(
-              *source, section_info, dex_profile_index_remap, extra_descriptors_remap, error);
+              source, section_info, dex_profile_index_remap, extra_descriptors_remap, error);
         }
         break;
       case FileSectionType::kMethods:
         // Skip if all dex files were filtered out.
         if (!info_.empty()) {
           status = ReadMethodsSection(
-              *source, section_info, dex_profile_index_remap, extra_descriptors_remap, error);
+              source, section_info, dex_profile_index_remap, extra_descriptors_remap, error);
         }
         break;
       case FileSectionType::kAggregationCounts:
         // This section is only used on server side.
         break;
+      case FileSectionType::kInlineCacheCounts:
+        // Skip if all dex files were filtered out.
+        if (!info_.empty()) {
+          status = ReadInlineCacheCountsSection(
+              source, section_info, dex_profile_index_remap, extra_descriptors_remap, error);
+        }
+        break;
       default:
         // Unknown section. Skip it. New versions of ART are allowed
         // to add sections that shall be ignored by old versions.
@@ -1929,6 +2092,70 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadInternal(
   return ProfileLoadStatus::kSuccess;
 }
 
+ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::LoadJournal(
+    int32_t fd,
+    std::string* error,
+    bool merge_classes,
+    const ProfileLoadFilterFn& filter_fn) {
+  struct stat stat_buffer;
+  if (fstat(fd, &stat_buffer) != 0) {
+    *error = "Could not stat profile journal";
+    return ProfileLoadStatus::kIOError;
+  }
+  uint64_t file_size = static_cast<uint64_t>(stat_buffer.st_size);
+  uint64_t offset = 0u;
+  while (offset != file_size) {
+    // A record may be incomplete if the process appending it died. Ignore such a tail,
+    // the data will be collected again.
+    ProfileJournalRecordHeader header;
+    if (file_size - offset < sizeof(header) ||
+        !android::base::ReadFullyAtOffset(fd, &header, sizeof(header), offset) ||
+        file_size - offset - sizeof(header) < header.size) {
+      LOG(WARNING) << "Ignoring incomplete profile journal record at offset " << offset;
+      break;
+    }
+    if (memcmp(header.magic, kProfileJournalMagic, sizeof(kProfileJournalMagic)) != 0) {
+      *error = "Bad profile journal record magic at offset " + std::to_string(offset);
+      return ProfileLoadStatus::kBadMagic;
+    }
+    if (header.size > GetSizeErrorThresholdBytes()) {
+      *error = "Profile journal record size exceeds " +
+               std::to_string(GetSizeErrorThresholdBytes()) + " bytes";
+      return ProfileLoadStatus::kBadData;
+    }
+    offset += sizeof(header);
+
+    MemMap map = MemMap::Invalid();
+    if (header.size != 0u) {
+      map = MemMap::MapAnonymous("profile journal record",
+                                 header.size,
+                                 PROT_READ | PROT_WRITE,
+                                 /*low_4gb=*/ false,
+                                 error);
+      if (!map.IsValid()) {
+        return ProfileLoadStatus::kIOError;
+      }
+      if (!android::base::ReadFullyAtOffset(fd, map.Begin(), header.size, offset)) {
+        *error = "Could not read profile journal record at offset " + std::to_string(offset);
+        return ProfileLoadStatus::kIOError;
+      }
+    }
+    offset += header.size;
+
+    std::unique_ptr<ProfileSource> source(ProfileSource::Create(std::move(map)));
+    ProfileCompilationInfo record(IsForBootImage());
+    ProfileLoadStatus status = record.LoadFromSource(*source, error, merge_classes, filter_fn);
+    if (status != ProfileLoadStatus::kSuccess) {
+      return status;
+    }
+    if (!MergeWith(record, merge_classes)) {
+      *error = "Could not merge profile journal record";
+      return ProfileLoadStatus::kMergeError;
+    }
+  }
+  return ProfileLoadStatus::kSuccess;
+}
+
 bool ProfileCompilationInfo::MergeWith(const ProfileCompilationInfo& other,
                                        bool merge_classes) {
   if (!SameVersion(other)) {
@@ -2029,14 +2256,15 @@ bool ProfileCompilationInfo::MergeWith(const ProfileCompilationInfo& other,
       const auto& other_inline_cache = other_method_it.second;
       for (const auto& other_ic_it : other_inline_cache) {
         uint16_t other_dex_pc = other_ic_it.first;
-        const ArenaSet<dex::TypeIndex>& other_class_set = other_ic_it.second.classes;
+        const DexPcData& other_dex_pc_data = other_ic_it.second;
         DexPcData* dex_pc_data = FindOrAddDexPc(inline_cache, other_dex_pc);
-        if (other_ic_it.second.is_missing_types) {
+        if (other_dex_pc_data.is_missing_types) {
           dex_pc_data->SetIsMissingTypes();
-        } else if (other_ic_it.second.is_megamorphic) {
+        } else if (other_dex_pc_data.is_megamorphic) {
           dex_pc_data->SetIsMegamorphic();
         } else {
-          for (dex::TypeIndex type_index : other_class_set) {
+          for (dex::TypeIndex type_index : other_dex_pc_data.classes) {
+            uint32_t count = other_dex_pc_data.GetCount(type_index);
             if (type_index.index_ >= num_type_ids) {
               ExtraDescriptorIndex new_extra_descriptor_index =
                   extra_descriptors_remap[type_index.index_ - num_type_ids];
@@ -2046,7 +2274,7 @@ bool ProfileCompilationInfo::MergeWith(const ProfileCompilationInfo& other,
               }
               type_index = dex::TypeIndex(num_type_ids + new_extra_descriptor_index);
             }
-            dex_pc_data->AddClass(type_index);
+            dex_pc_data->AddClass(type_index, count);
           }
         }
       }
@@ -2482,6 +2710,12 @@ HashSet<std::string> ProfileCompilationInfo::GetClassDescriptors(
   return ret;
 }
 
+bool ProfileCompilationInfo::IsProfileJournal(int fd) {
+  uint8_t buffer[sizeof(kProfileJournalMagic)];
+  return android::base::ReadFullyAtOffset(fd, buffer, sizeof(buffer), /*offset=*/ 0) &&
+         memcmp(buffer, kProfileJournalMagic, sizeof(buffer)) == 0;
+}
+
 bool ProfileCompilationInfo::IsProfileFile(int fd) {
   // First check if it's an empty file as we allow empty profile files.
   // Profiles may be created by ActivityManager or installd before we manage to
@@ -2991,6 +3225,150 @@ ProfileCompilationInfo::ProfileLoadStatus ProfileCompilationInfo::DexFileData::S
   return ProfileLoadStatus::kSuccess;
 }
 
+uint32_t ProfileCompilationInfo::DexFileData::InlineCacheCountsDataSize() const {
+  constexpr size_t kPerDexPcEntrySize =
+      sizeof(uint16_t) +  // Method index.
+      sizeof(uint16_t) +  // Dex PC.
+      sizeof(uint8_t);    // Number of counts.
+  constexpr size_t kPerCountEntrySize =
+      sizeof(uint16_t) +  // Type index.
+      sizeof(uint32_t);   // Count.
+  size_t num_dex_pc_entries = 0u;
+  size_t num_count_entries = 0u;
+  for (const auto& method_entry : method_map) {
+    for (const auto& inline_cache_entry : method_entry.second) {
+      const DexPcData& dex_pc_data = inline_cache_entry.second;
+      if (!dex_pc_data.counts.empty()) {
+        ++num_dex_pc_entries;
+        num_count_entries += dex_pc_data.counts.size();
+      }
+    }
+  }
+  if (num_dex_pc_entries == 0u) {
+    return 0u;
+  }
+  return sizeof(ProfileIndexType) +  // Which dex file.
+         sizeof(uint32_t) +          // Total size of following data.
+         num_dex_pc_entries * kPerDexPcEntrySize +
+         num_count_entries * kPerCountEntrySize;
+}
+
+void ProfileCompilationInfo::DexFileData::WriteInlineCacheCounts(SafeBuffer& buffer) const {
+  uint32_t counts_data_size = InlineCacheCountsDataSize();
+  if (counts_data_size == 0u) {
+    return;  // No data to write.
+  }
+  DCHECK_GE(buffer.GetAvailableBytes(), counts_data_size);
+  uint32_t expected_available_bytes_at_end = buffer.GetAvailableBytes() - counts_data_size;
+
+  buffer.WriteUintAndAdvance(profile_index);
+  uint32_t following_data_size = counts_data_size - sizeof(ProfileIndexType) - sizeof(uint32_t);
+  buffer.WriteUintAndAdvance(following_data_size);
+  for (const auto& method_entry : method_map) {
+    for (const auto& inline_cache_entry : method_entry.second) {
+      const DexPcData& dex_pc_data = inline_cache_entry.second;
+      if (dex_pc_data.counts.empty()) {
+        continue;
+      }
+      DCHECK_LE(dex_pc_data.counts.size(), dex_pc_data.classes.size());
+      buffer.WriteUintAndAdvance(method_entry.first);
+      buffer.WriteUintAndAdvance(inline_cache_entry.first);
+      buffer.WriteUintAndAdvance(dchecked_integral_cast<uint8_t>(dex_pc_data.counts.size()));
+      for (const auto& count_entry : dex_pc_data.counts) {
+        buffer.WriteUintAndAdvance(dchecked_integral_cast<uint16_t>(count_entry.first.index_));
+        buffer.WriteUintAndAdvance(count_entry.second);
+      }
+    }
+  }
+
+  DCHECK_EQ(buffer.GetAvailableBytes(), expected_available_bytes_at_end);
+}
+
+ProfileCompilationInfo::ProfileLoadStatus
+ProfileCompilationInfo::DexFileData::ReadInlineCacheCounts(
+    SafeBuffer& buffer,
+    const dchecked_vector<ExtraDescriptorIndex>& extra_descriptors_remap,
+    std::string* error) {
+  uint32_t following_data_size;
+  if (!buffer.ReadUintAndAdvance(&following_data_size)) {
+    *error = "Error reading inline cache counts data size.";
+    return ProfileLoadStatus::kBadData;
+  }
+  if (following_data_size > buffer.GetAvailableBytes()) {
+    *error = "Inline cache counts data size exceeds available data size.";
+    return ProfileLoadStatus::kBadData;
+  }
+  uint32_t expected_available_bytes_at_end = buffer.GetAvailableBytes() - following_data_size;
+  while (buffer.GetAvailableBytes() > expected_available_bytes_at_end) {
+    uint16_t method_index;
+    uint16_t dex_pc;
+    uint8_t num_counts;
+    if (!buffer.ReadUintAndAdvance(&method_index) ||
+        !buffer.ReadUintAndAdvance(&dex_pc) ||
+        !buffer.ReadUintAndAdvance(&num_counts)) {
+      *error = "Error reading inline cache counts entry.";
+      return ProfileLoadStatus::kBadData;
+    }
+    // The counts refer to an inline cache loaded from the methods section. If there is no
+    // such inline cache, or it became megamorphic while merging, the counts are dropped.
+    DexPcData* dex_pc_data = nullptr;
+    auto method_it = method_map.find(method_index);
+    if (method_it != method_map.end()) {
+      auto dex_pc_it = method_it->second.find(dex_pc);
+      if (dex_pc_it != method_it->second.end()) {
+        dex_pc_data = &dex_pc_it->second;
+      }
+    }
+    for (uint8_t i = 0; i != num_counts; ++i) {
+      uint16_t type_index;
+      uint32_t count;
+      if (!buffer.ReadUintAndAdvance(&type_index) || !buffer.ReadUintAndAdvance(&count)) {
+        *error = "Error reading inline cache count.";
+        return ProfileLoadStatus::kBadData;
+      }
+      if (type_index >= num_type_ids) {
+        if (type_index - num_type_ids >= extra_descriptors_remap.size()) {
+          *error = "Invalid inline cache count type index.";
+          return ProfileLoadStatus::kBadData;
+        }
+        ExtraDescriptorIndex new_extra_descriptor_index =
+            extra_descriptors_remap[type_index - num_type_ids];
+        if (new_extra_descriptor_index >= DexFile::kDexNoIndex16 - num_type_ids) {
+          *error = "Remapped inline cache count type index out of range.";
+          return ProfileLoadStatus::kMergeError;
+        }
+        type_index = num_type_ids + new_extra_descriptor_index;
+      }
+      if (dex_pc_data != nullptr &&
+          dex_pc_data->classes.find(dex::TypeIndex(type_index)) != dex_pc_data->classes.end()) {
+        dex_pc_data->AddCount(dex::TypeIndex(type_index), count);
+      }
+    }
+  }
+
+  if (buffer.GetAvailableBytes() != expected_available_bytes_at_end) {
+    *error = "Inline cache counts data did not end at expected position.";
+    return ProfileLoadStatus::kBadData;
+  }
+  return ProfileLoadStatus::kSuccess;
+}
+
+ProfileCompilationInfo::ProfileLoadStatus
+ProfileCompilationInfo::DexFileData::SkipInlineCacheCounts(SafeBuffer& buffer,
+                                                           std::string* error) {
+  uint32_t following_data_size;
+  if (!buffer.ReadUintAndAdvance(&following_data_size)) {
+    *error = "Error reading inline cache counts data size to skip.";
+    return ProfileLoadStatus::kBadData;
+  }
+  if (following_data_size > buffer.GetAvailableBytes()) {
+    *error = "Inline cache counts data size to skip exceeds remaining data.";
+    return ProfileLoadStatus::kBadData;
+  }
+  buffer.Advance(following_data_size);
+  return ProfileLoadStatus::kSuccess;
+}
+
 void ProfileCompilationInfo::DexFileData::WriteClassSet(
     SafeBuffer& buffer,
     const ArenaSet<dex::TypeIndex>& class_set) {
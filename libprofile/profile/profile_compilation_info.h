@@ -50,11 +50,13 @@ struct ProfileMethodInfo {
                        bool missing_types,
                        const std::vector<TypeReference>& profile_classes,
                        // Only used by profman for creating profiles from text
-                       bool megamorphic = false)
+                       bool megamorphic = false,
+                       const std::vector<uint32_t>& class_counts = {})
         : dex_pc(pc),
           is_missing_types(missing_types),
           classes(profile_classes),
-          is_megamorphic(megamorphic) {}
+          is_megamorphic(megamorphic),
+          counts(class_counts) {}
 
     const uint32_t dex_pc;
     const bool is_missing_types;
@@ -63,6 +65,9 @@ struct ProfileMethodInfo {
     // by the profman. See `ProfileCompilationInfo::FindOrCreateTypeIndex()`.
     const std::vector<TypeReference> classes;
     const bool is_megamorphic;
+    // The number of times each of `classes` was seen as the receiver. Either empty
+    // if the frequencies are unknown, or the same size as `classes`.
+    const std::vector<uint32_t> counts;
   };
 
   explicit ProfileMethodInfo(MethodReference reference) : ref(reference) {}
@@ -90,6 +95,7 @@ class ProfileCompilationInfo {
   static const uint8_t kProfileVersion[];
   static const uint8_t kProfileVersionForBootImage[];
   static const char kDexMetadataProfileEntry[];
+  static const uint8_t kProfileJournalMagic[];
 
   static constexpr size_t kProfileVersionSize = 4;
   static constexpr uint8_t kIndividualInlineCacheSize = 5;
@@ -138,22 +144,34 @@ class ProfileCompilationInfo {
     explicit DexPcData(const ArenaAllocatorAdapter<void>& allocator)
         : is_missing_types(false),
           is_megamorphic(false),
-          classes(std::less<dex::TypeIndex>(), allocator) {}
-    void AddClass(const dex::TypeIndex& type_idx);
+          classes(std::less<dex::TypeIndex>(), allocator),
+          counts(std::less<dex::TypeIndex>(), allocator) {}
+    // Adds the class and `count` receiver observations of it.
+    void AddClass(const dex::TypeIndex& type_idx, uint32_t count = 0u);
+    // Adds `count` receiver observations of a class that is already in `classes`.
+    void AddCount(const dex::TypeIndex& type_idx, uint32_t count);
+    // Returns the number of receiver observations of the class, 0 if unknown.
+    uint32_t GetCount(const dex::TypeIndex& type_idx) const {
+      auto it = counts.find(type_idx);
+      return it != counts.end() ? it->second : 0u;
+    }
     void SetIsMegamorphic() {
       if (is_missing_types) return;
       is_megamorphic = true;
       classes.clear();
+      counts.clear();
     }
     void SetIsMissingTypes() {
       is_megamorphic = false;
       is_missing_types = true;
       classes.clear();
+      counts.clear();
     }
     bool operator==(const DexPcData& other) const {
       return is_megamorphic == other.is_megamorphic &&
           is_missing_types == other.is_missing_types &&
-          classes == other.classes;
+          classes == other.classes &&
+          counts == other.counts;
     }
 
     // Not all runtime types can be encoded in the profile. For example if the receiver
@@ -162,6 +180,9 @@ class ProfileCompilationInfo {
     bool is_missing_types;
     bool is_megamorphic;
     ArenaSet<dex::TypeIndex> classes;
+    // Receiver frequencies for the `classes` that have them. Counts from merged
+    // profiles are added together.
+    ArenaSafeMap<dex::TypeIndex, uint32_t> counts;
   };
 
   // The inline cache map: DexPc -> DexPcData.
@@ -482,6 +503,21 @@ class ProfileCompilationInfo {
   // A fallback implementation of `Save` that uses a flock.
   bool SaveFallback(const std::string& filename, uint64_t* bytes_written);
 
+  // Append the profile data as a new record to the profile journal `fd`, which should be
+  // opened with O_APPEND. A journal is a sequence of records, each holding a complete
+  // profile, and `Load()` reads it by merging all records. Appending lets the profile
+  // saver write only the data collected since its last save instead of rewriting the
+  // whole profile.
+  bool AppendToJournal(int fd, /*out*/ uint64_t* bytes_written);
+
+  // Return whether the fd points to a profile journal.
+  static bool IsProfileJournal(int fd);
+
+  // Return the location of the delta journal of the profile `profile_filename`.
+  static std::string GetJournalFilename(const std::string& profile_filename) {
+    return profile_filename + ".journal";
+  }
+
   // Return the number of dex files referenced in the profile.
   size_t GetNumberOfDexFiles() const {
     return info_.size();
@@ -879,6 +915,14 @@ class ProfileCompilationInfo {
         std::string* error);
     static ProfileLoadStatus SkipMethods(SafeBuffer& buffer, std::string* error);
 
+    uint32_t InlineCacheCountsDataSize() const;
+    void WriteInlineCacheCounts(SafeBuffer& buffer) const;
+    ProfileLoadStatus ReadInlineCacheCounts(
+        SafeBuffer& buffer,
+        const dchecked_vector<ExtraDescriptorIndex>& extra_descriptors_remap,
+        std::string* error);
+    static ProfileLoadStatus SkipInlineCacheCounts(SafeBuffer& buffer, std::string* error);
+
     // The allocator used to allocate new inline cache maps.
     ArenaAllocator* const allocator_;
     // The profile key this data belongs to.
@@ -1019,6 +1063,13 @@ class ProfileCompilationInfo {
       const dchecked_vector<ExtraDescriptorIndex>& extra_descriptors_remap,
       /*out*/ std::string* error);
 
+  ProfileLoadStatus ReadInlineCacheCountsSection(
+      ProfileSource& source,
+      const FileSectionInfo& section_info,
+      const dchecked_vector<ProfileIndexType>& dex_profile_index_remap,
+      const dchecked_vector<ExtraDescriptorIndex>& extra_descriptors_remap,
+      /*out*/ std::string* error);
+
   // Entry point for profile loading functionality.
   ProfileLoadStatus LoadInternal(
       int32_t fd,
@@ -1026,6 +1077,20 @@ class ProfileCompilationInfo {
       bool merge_classes = true,
       const ProfileLoadFilterFn& filter_fn = ProfileFilterFnAcceptAll);
 
+  // Load the profile data from an opened source.
+  ProfileLoadStatus LoadFromSource(
+      ProfileSource& source,
+      std::string* error,
+      bool merge_classes,
+      const ProfileLoadFilterFn& filter_fn);
+
+  // Load all records of the profile journal `fd` and merge them into the current data.
+  ProfileLoadStatus LoadJournal(
+      int32_t fd,
+      std::string* error,
+      bool merge_classes,
+      const ProfileLoadFilterFn& filter_fn);
+
   // Find the data for the dex_pc in the inline cache. Adds an empty entry
   // if no previous data exists.
   static DexPcData* FindOrAddDexPc(InlineCacheMap* inline_cache, uint32_t dex_pc);
@@ -1057,6 +1122,7 @@ class ProfileCompilationInfo {
   static std::string MigrateAnnotationInfo(const std::string& base_key,
                                            const std::string& augmented_key);
 
+  friend class FlatProfile;
   friend class ProfileCompilationInfoTest;
   friend class CompilerDriverProfileTest;
   friend class ProfileAssistantTest;
@@ -316,6 +316,46 @@ TEST_F(ProfileCompilationInfoTest, SaveFd) {
   ASSERT_TRUE(loaded_info2.Equals(saved_info));
 }
 
+TEST_F(ProfileCompilationInfoTest, Journal) {
+  ScratchFile journal;
+
+  ProfileCompilationInfo delta1;
+  ProfileCompilationInfo delta2;
+  ProfileCompilationInfo expected;
+  for (uint16_t i = 0; i < 10; i++) {
+    ASSERT_TRUE(AddMethod(&delta1, dex1, /*method_idx=*/ i));
+    ASSERT_TRUE(AddMethod(&delta2, dex2, /*method_idx=*/ i, Hotness::kFlagStartup));
+  }
+  ASSERT_TRUE(AddClass(&delta2, dex1, dex::TypeIndex(0)));
+  ASSERT_TRUE(expected.MergeWith(delta1));
+  ASSERT_TRUE(expected.MergeWith(delta2));
+
+  uint64_t bytes_written = 0u;
+  ASSERT_TRUE(delta1.AppendToJournal(GetFd(journal), &bytes_written));
+  ASSERT_NE(bytes_written, 0u);
+  ASSERT_TRUE(delta2.AppendToJournal(GetFd(journal), &bytes_written));
+  ASSERT_EQ(0, journal.GetFile()->Flush());
+  ASSERT_TRUE(ProfileCompilationInfo::IsProfileJournal(GetFd(journal)));
+
+  // Loading the journal merges all records.
+  ProfileCompilationInfo loaded_info;
+  ASSERT_TRUE(loaded_info.Load(GetFd(journal)));
+  ASSERT_TRUE(loaded_info.Equals(expected));
+
+  // An incomplete record at the end is ignored.
+  const uint8_t partial_record[] = { 'p', 'r', 'j', '\0', 0x10 };
+  ASSERT_TRUE(journal.GetFile()->WriteFully(partial_record, sizeof(partial_record)));
+  ASSERT_EQ(0, journal.GetFile()->Flush());
+  ProfileCompilationInfo loaded_info2;
+  ASSERT_TRUE(loaded_info2.Load(GetFd(journal)));
+  ASSERT_TRUE(loaded_info2.Equals(expected));
+
+  // A regular profile is not a journal.
+  ScratchFile profile;
+  ASSERT_TRUE(expected.Save(GetFd(profile)));
+  ASSERT_FALSE(ProfileCompilationInfo::IsProfileJournal(GetFd(profile)));
+}
+
 TEST_F(ProfileCompilationInfoTest, AddMethodsAndClassesFail) {
   ScratchFile profile;
 
@@ -549,6 +589,62 @@ TEST_F(ProfileCompilationInfoTest, SaveInlineCaches) {
   ASSERT_TRUE(EqualInlineCaches(inline_caches, dex4, loaded_hotness2, loaded_info));
 }
 
+TEST_F(ProfileCompilationInfoTest, InlineCacheCounts) {
+  ScratchFile profile;
+
+  // One call site with receiver frequencies and one without.
+  std::vector<TypeReference> types = {TypeReference(dex1, dex::TypeIndex(0)),
+                                      TypeReference(dex1, dex::TypeIndex(1)),
+                                      TypeReference(dex2, dex::TypeIndex(2))};
+  std::vector<ProfileInlineCache> inline_caches = {
+      ProfileInlineCache(/*pc=*/ 5, /*missing_types=*/ false, types, /*megamorphic=*/ false,
+                         /*class_counts=*/ {90u, 7u, 3u}),
+      ProfileInlineCache(/*pc=*/ 7, /*missing_types=*/ false, types),
+  };
+  ProfileCompilationInfo saved_info;
+  ASSERT_TRUE(AddMethod(&saved_info, dex1, /*method_idx=*/ 3, inline_caches));
+
+  auto get_counts = [](const ProfileCompilationInfo& info, const DexFile* dex, uint16_t dex_pc) {
+    ProfileCompilationInfo::MethodHotness hotness =
+        info.GetMethodHotness(MethodReference(dex, /*index=*/ 3));
+    CHECK(hotness.GetInlineCacheMap() != nullptr);
+    const ProfileCompilationInfo::DexPcData& dex_pc_data =
+        hotness.GetInlineCacheMap()->find(dex_pc)->second;
+    std::vector<uint32_t> counts;
+    for (dex::TypeIndex type_index : dex_pc_data.classes) {
+      counts.push_back(dex_pc_data.GetCount(type_index));
+    }
+    return counts;
+  };
+  EXPECT_EQ(get_counts(saved_info, dex1, 5), std::vector<uint32_t>({90u, 7u, 3u}));
+  EXPECT_EQ(get_counts(saved_info, dex1, 7), std::vector<uint32_t>({0u, 0u, 0u}));
+
+  // The counts survive a save and load.
+  ASSERT_TRUE(saved_info.Save(GetFd(profile)));
+  ASSERT_EQ(0, profile.GetFile()->Flush());
+  ProfileCompilationInfo loaded_info;
+  ASSERT_TRUE(loaded_info.Load(GetFd(profile)));
+  ASSERT_TRUE(loaded_info.Equals(saved_info));
+  EXPECT_EQ(get_counts(loaded_info, dex1, 5), std::vector<uint32_t>({90u, 7u, 3u}));
+
+  // Merging adds the counts together.
+  ProfileCompilationInfo other_info;
+  std::vector<ProfileInlineCache> other_inline_caches = {
+      ProfileInlineCache(/*pc=*/ 5, /*missing_types=*/ false, types, /*megamorphic=*/ false,
+                         /*class_counts=*/ {10u, 3u, 0u}),
+  };
+  ASSERT_TRUE(AddMethod(&other_info, dex1, /*method_idx=*/ 3, other_inline_caches));
+  ASSERT_TRUE(loaded_info.MergeWith(other_info));
+  EXPECT_EQ(get_counts(loaded_info, dex1, 5), std::vector<uint32_t>({100u, 10u, 3u}));
+
+  // Becoming megamorphic drops the counts.
+  std::vector<ProfileInlineCache> megamorphic_inline_caches = {
+      ProfileInlineCache(/*pc=*/ 5, /*missing_types=*/ false, {}, /*megamorphic=*/ true),
+  };
+  ASSERT_TRUE(AddMethod(&loaded_info, dex1, /*method_idx=*/ 3, megamorphic_inline_caches));
+  EXPECT_TRUE(get_counts(loaded_info, dex1, 5).empty());
+}
+
 TEST_F(ProfileCompilationInfoTest, MegamorphicInlineCaches) {
   ProfileCompilationInfo saved_info;
   std::vector<ProfileInlineCache> inline_caches = GetTestInlineCaches();
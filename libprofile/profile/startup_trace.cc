@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "startup_trace.h"
+
+#include <sys/stat.h>
+
+#include <cstring>
+
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+#include "base/casts.h"
+#include "base/leb128.h"
+#include "dex/dex_file.h"
+#include "dex/method_reference.h"
+#include "profile/profile_compilation_info.h"
+
+namespace art {
+
+using android::base::StringPrintf;
+
+const uint8_t StartupTrace::kStartupTraceMagic[] = { 's', 't', 't', '\0' };
+const uint8_t StartupTrace::kStartupTraceVersion[] = { '0', '0', '1', '\0' };
+
+uint32_t StartupTrace::AddDexFile(const std::string& location, uint32_t checksum) {
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    if (dex_files_[i].location == location && dex_files_[i].checksum == checksum) {
+      return dchecked_integral_cast<uint32_t>(i);
+    }
+  }
+  dex_files_.push_back({location, checksum});
+  return dchecked_integral_cast<uint32_t>(dex_files_.size() - 1u);
+}
+
+bool StartupTrace::Save(int fd, std::string* error_msg) const {
+  std::vector<uint8_t> buffer;
+  buffer.insert(
+      buffer.end(), kStartupTraceMagic, kStartupTraceMagic + sizeof(kStartupTraceMagic));
+  buffer.insert(
+      buffer.end(), kStartupTraceVersion, kStartupTraceVersion + sizeof(kStartupTraceVersion));
+  EncodeUnsignedLeb128(&buffer, dex_files_.size());
+  for (const DexFileInfo& dex_file : dex_files_) {
+    const uint8_t* checksum = reinterpret_cast<const uint8_t*>(&dex_file.checksum);
+    buffer.insert(buffer.end(), checksum, checksum + sizeof(dex_file.checksum));
+    EncodeUnsignedLeb128(&buffer, dex_file.location.size());
+    buffer.insert(buffer.end(), dex_file.location.begin(), dex_file.location.end());
+  }
+  EncodeUnsignedLeb128(&buffer, events_.size());
+  for (const Event& event : events_) {
+    buffer.push_back(static_cast<uint8_t>(event.kind));
+    EncodeUnsignedLeb128(&buffer, event.dex_file_index);
+    EncodeUnsignedLeb128(&buffer, event.index);
+  }
+
+  if (!android::base::WriteFully(fd, buffer.data(), buffer.size())) {
+    *error_msg = StringPrintf("Failed to write startup trace: %s", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool StartupTrace::IsStartupTrace(int fd) {
+  uint8_t magic[sizeof(kStartupTraceMagic)];
+  return android::base::ReadFullyAtOffset(fd, magic, sizeof(magic), /*offset=*/ 0) &&
+         memcmp(magic, kStartupTraceMagic, sizeof(magic)) == 0;
+}
+
+bool StartupTrace::Load(int fd, std::string* error_msg) {
+  struct stat stat_buffer;
+  if (fstat(fd, &stat_buffer) != 0) {
+    *error_msg = StringPrintf("Failed to stat startup trace: %s", strerror(errno));
+    return false;
+  }
+  std::vector<uint8_t> buffer(stat_buffer.st_size);
+  if (!android::base::ReadFullyAtOffset(fd, buffer.data(), buffer.size(), /*offset=*/ 0)) {
+    *error_msg = StringPrintf("Failed to read startup trace: %s", strerror(errno));
+    return false;
+  }
+  const uint8_t* data = buffer.data();
+  const uint8_t* end = buffer.data() + buffer.size();
+  if (buffer.size() < sizeof(kStartupTraceMagic) + sizeof(kStartupTraceVersion) ||
+      memcmp(data, kStartupTraceMagic, sizeof(kStartupTraceMagic)) != 0) {
+    *error_msg = "Not a startup trace";
+    return false;
+  }
+  data += sizeof(kStartupTraceMagic);
+  if (memcmp(data, kStartupTraceVersion, sizeof(kStartupTraceVersion)) != 0) {
+    *error_msg = "Unsupported startup trace version";
+    return false;
+  }
+  data += sizeof(kStartupTraceVersion);
+
+  std::vector<DexFileInfo> dex_files;
+  uint32_t num_dex_files;
+  if (!DecodeUnsignedLeb128Checked(&data, end, &num_dex_files)) {
+    *error_msg = "Truncated startup trace header";
+    return false;
+  }
+  for (uint32_t i = 0; i != num_dex_files; ++i) {
+    DexFileInfo dex_file;
+    uint32_t location_size;
+    if (static_cast<size_t>(end - data) < sizeof(dex_file.checksum)) {
+      *error_msg = "Truncated startup trace dex file";
+      return false;
+    }
+    memcpy(&dex_file.checksum, data, sizeof(dex_file.checksum));
+    data += sizeof(dex_file.checksum);
+    if (!DecodeUnsignedLeb128Checked(&data, end, &location_size) ||
+        static_cast<size_t>(end - data) < location_size) {
+      *error_msg = "Truncated startup trace dex file";
+      return false;
+    }
+    dex_file.location.assign(reinterpret_cast<const char*>(data), location_size);
+    data += location_size;
+    dex_files.push_back(std::move(dex_file));
+  }
+
+  std::vector<Event> events;
+  uint32_t num_events;
+  if (!DecodeUnsignedLeb128Checked(&data, end, &num_events)) {
+    *error_msg = "Truncated startup trace events";
+    return false;
+  }
+  for (uint32_t i = 0; i != num_events; ++i) {
+    Event event;
+    if (data == end || *data > static_cast<uint8_t>(EventKind::kLast)) {
+      *error_msg = "Invalid startup trace event";
+      return false;
+    }
+    event.kind = static_cast<EventKind>(*data++);
+    if (!DecodeUnsignedLeb128Checked(&data, end, &event.dex_file_index) ||
+        !DecodeUnsignedLeb128Checked(&data, end, &event.index) ||
+        event.dex_file_index >= dex_files.size()) {
+      *error_msg = "Invalid startup trace event";
+      return false;
+    }
+    events.push_back(event);
+  }
+  if (data != end) {
+    *error_msg = "Unexpected data at the end of the startup trace";
+    return false;
+  }
+
+  dex_files_ = std::move(dex_files);
+  events_ = std::move(events);
+  return true;
+}
+
+bool StartupTrace::ConvertTo(const std::vector<const DexFile*>& dex_files,
+                             ProfileCompilationInfo* info) const {
+  std::vector<const DexFile*> matching_dex_files(dex_files_.size(), nullptr);
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    for (const DexFile* dex_file : dex_files) {
+      if (dex_file->GetLocation() == dex_files_[i].location &&
+          dex_file->GetLocationChecksum() == dex_files_[i].checksum) {
+        matching_dex_files[i] = dex_file;
+        break;
+      }
+    }
+  }
+  for (const Event& event : events_) {
+    const DexFile* dex_file = matching_dex_files[event.dex_file_index];
+    if (dex_file == nullptr) {
+      continue;
+    }
+    if (event.kind == EventKind::kClass) {
+      if (event.index >= dex_file->NumTypeIds() ||
+          !info->AddClass(*dex_file, dex::TypeIndex(event.index))) {
+        return false;
+      }
+    } else if (event.kind == EventKind::kMethod) {
+      if (event.index >= dex_file->NumMethodIds() ||
+          !info->AddMethod(ProfileMethodInfo(MethodReference(dex_file, event.index)),
+                           ProfileCompilationInfo::MethodHotness::kFlagStartup)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace art
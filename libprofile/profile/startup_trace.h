@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_LIBPROFILE_PROFILE_STARTUP_TRACE_H_
+#define ART_LIBPROFILE_PROFILE_STARTUP_TRACE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace art {
+
+class DexFile;
+class ProfileCompilationInfo;
+
+/**
+ * Order in which the classes, methods and dex file pages of an app are first used during
+ * startup, recorded by the runtime with `-Xps-startup-trace-path:<file>`.
+ *
+ *   magic, version
+ *   uleb128 number of dex files
+ *   for each dex file: uint32_t checksum, uleb128 location size, location
+ *   uleb128 number of events
+ *   for each event: uint8_t kind, uleb128 dex file index, uleb128 index
+ *
+ * The index of an event is a type index for classes, a method index for methods and the
+ * offset in the dex file divided by `kDexPageSize` for dex pages. Events are in the order in
+ * which they were recorded, and each item has at most one event.
+ */
+class StartupTrace {
+ public:
+  static const uint8_t kStartupTraceMagic[];
+  static const uint8_t kStartupTraceVersion[];
+
+  // Granularity of the recorded dex page events.
+  static constexpr size_t kDexPageSize = 4096u;
+
+  enum class EventKind : uint8_t {
+    kClass = 0,
+    kMethod = 1,
+    kDexPage = 2,
+    kLast = kDexPage,
+  };
+
+  struct Event {
+    EventKind kind;
+    uint32_t dex_file_index;
+    uint32_t index;
+  };
+
+  struct DexFileInfo {
+    std::string location;
+    uint32_t checksum;
+  };
+
+  StartupTrace() {}
+
+  // Return the index of the dex file with the given location and checksum, adding it if
+  // it is not in the trace yet.
+  uint32_t AddDexFile(const std::string& location, uint32_t checksum);
+
+  void AddEvent(EventKind kind, uint32_t dex_file_index, uint32_t index) {
+    events_.push_back({kind, dex_file_index, index});
+  }
+
+  const std::vector<DexFileInfo>& GetDexFiles() const { return dex_files_; }
+  const std::vector<Event>& GetEvents() const { return events_; }
+
+  // Write the trace to `fd`. Returns true on success.
+  bool Save(int fd, std::string* error_msg) const;
+
+  // Read a trace written by `Save()` from `fd`, replacing the current content.
+  // Returns true on success.
+  bool Load(int fd, std::string* error_msg);
+
+  // Return whether the file `fd` starts with the startup trace magic.
+  static bool IsStartupTrace(int fd);
+
+  // Add the classes and methods of the trace that belong to `dex_files` to the app profile
+  // `info`, methods as startup methods. Dex files are matched by location and checksum.
+  // Returns true on success.
+  bool ConvertTo(const std::vector<const DexFile*>& dex_files,
+                 ProfileCompilationInfo* info) const;
+
+ private:
+  std::vector<DexFileInfo> dex_files_;
+  std::vector<Event> events_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTrace);
+};
+
+}  // namespace art
+
+#endif  // ART_LIBPROFILE_PROFILE_STARTUP_TRACE_H_
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/common_art_test.h"
+#include "base/unix_file/fd_file.h"
+#include "dex/dex_file.h"
+#include "dex/method_reference.h"
+#include "profile/profile_compilation_info.h"
+#include "profile/profile_test_helper.h"
+#include "profile/startup_trace.h"
+
+namespace art {
+
+class StartupTraceTest : public CommonArtTest, public ProfileTestHelper {
+ public:
+  void SetUp() override {
+    CommonArtTest::SetUp();
+    dex1 = BuildDex("location1", /*location_checksum=*/ 1, "LUnique1;", /*num_method_ids=*/ 101);
+    dex2 = BuildDex("location2", /*location_checksum=*/ 2, "LUnique2;", /*num_method_ids=*/ 102);
+  }
+
+ protected:
+  using EventKind = StartupTrace::EventKind;
+
+  const DexFile* dex1;
+  const DexFile* dex2;
+};
+
+TEST_F(StartupTraceTest, SaveAndLoad) {
+  StartupTrace trace;
+  uint32_t index1 = trace.AddDexFile(dex1->GetLocation(), dex1->GetLocationChecksum());
+  uint32_t index2 = trace.AddDexFile(dex2->GetLocation(), dex2->GetLocationChecksum());
+  EXPECT_EQ(trace.AddDexFile(dex1->GetLocation(), dex1->GetLocationChecksum()), index1);
+  trace.AddEvent(EventKind::kClass, index1, 0u);
+  trace.AddEvent(EventKind::kDexPage, index1, 3u);
+  trace.AddEvent(EventKind::kMethod, index1, 100u);
+  trace.AddEvent(EventKind::kMethod, index2, 1000u);
+
+  ScratchFile file;
+  std::string error_msg;
+  ASSERT_TRUE(trace.Save(file.GetFd(), &error_msg)) << error_msg;
+  EXPECT_TRUE(StartupTrace::IsStartupTrace(file.GetFd()));
+
+  StartupTrace loaded;
+  ASSERT_TRUE(loaded.Load(file.GetFd(), &error_msg)) << error_msg;
+  ASSERT_EQ(loaded.GetDexFiles().size(), 2u);
+  EXPECT_EQ(loaded.GetDexFiles()[index2].location, dex2->GetLocation());
+  EXPECT_EQ(loaded.GetDexFiles()[index2].checksum, dex2->GetLocationChecksum());
+  ASSERT_EQ(loaded.GetEvents().size(), 4u);
+  for (size_t i = 0; i != trace.GetEvents().size(); ++i) {
+    EXPECT_EQ(loaded.GetEvents()[i].kind, trace.GetEvents()[i].kind);
+    EXPECT_EQ(loaded.GetEvents()[i].dex_file_index, trace.GetEvents()[i].dex_file_index);
+    EXPECT_EQ(loaded.GetEvents()[i].index, trace.GetEvents()[i].index);
+  }
+}
+
+TEST_F(StartupTraceTest, ConvertTo) {
+  StartupTrace trace;
+  uint32_t index1 = trace.AddDexFile(dex1->GetLocation(), dex1->GetLocationChecksum());
+  uint32_t mismatch = trace.AddDexFile(dex2->GetLocation(), /*checksum=*/ 42u);
+  trace.AddEvent(EventKind::kClass, index1, 0u);
+  trace.AddEvent(EventKind::kMethod, index1, 7u);
+  trace.AddEvent(EventKind::kDexPage, index1, 1u);
+  trace.AddEvent(EventKind::kMethod, mismatch, 7u);
+
+  ProfileCompilationInfo info;
+  ASSERT_TRUE(trace.ConvertTo({dex1, dex2}, &info));
+  EXPECT_TRUE(info.ContainsClass(*dex1, dex::TypeIndex(0)));
+  Hotness hotness = info.GetMethodHotness(MethodReference(dex1, 7u));
+  EXPECT_TRUE(hotness.IsStartup());
+  EXPECT_FALSE(hotness.IsHot());
+  EXPECT_FALSE(info.GetMethodHotness(MethodReference(dex2, 7u)).IsInProfile());
+}
+
+TEST_F(StartupTraceTest, RejectInvalidFile) {
+  ScratchFile file;
+  ProfileCompilationInfo info;
+  ASSERT_TRUE(AddMethod(&info, dex1, /*method_idx=*/ 1));
+  ASSERT_TRUE(info.Save(file.GetFd()));
+  EXPECT_FALSE(StartupTrace::IsStartupTrace(file.GetFd()));
+  StartupTrace trace;
+  std::string error_msg;
+  EXPECT_FALSE(trace.Load(file.GetFd(), &error_msg));
+}
+
+}  // namespace art
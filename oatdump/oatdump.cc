@@ -486,6 +486,11 @@ class OatDumper {
                            GetNterpTrampolineOffset);
 #undef DUMP_OAT_HEADER_OFFSET
 
+    os << "STARTUP CODE:\n";
+    os << StringPrintf("0x%08zx size 0x%08x\n\n",
+                       AdjustOffset(oat_header.GetStartupCodeOffset()),
+                       oat_header.GetStartupCodeSize());
+
     // Print the key-value store.
     {
       os << "KEY VALUE STORE:\n";
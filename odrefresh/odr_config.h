@@ -47,6 +47,11 @@ constexpr const char* kCheckedSystemPropertyPrefixes[]{"dalvik.vm.", "ro.dalvik.
 static constexpr char kSystemPropertySystemServerCompilerFilterOverride[] =
     "persist.device_config.runtime_native_boot.systemservercompilerfilter_override";
 
+// System property for the memory that dex2oat invocations running in parallel may use together,
+// e.g. "2g". Defaults to a quarter of the physical memory.
+static constexpr char kSystemPropertyDex2oatMemoryBudget[] =
+    "dalvik.vm.odrefresh-dex2oat-memory-budget";
+
 // The list of system properties that odrefresh ignores. They don't affect compilation results.
 const std::unordered_set<std::string> kIgnoredSystemProperties{
     "dalvik.vm.dex2oat-cpu-set",
@@ -56,7 +61,8 @@ const std::unordered_set<std::string> kIgnoredSystemProperties{
     "dalvik.vm.restore-dex2oat-cpu-set",
     "dalvik.vm.restore-dex2oat-threads",
     "dalvik.vm.background-dex2oat-cpu-set",
-    "dalvik.vm.background-dex2oat-threads"};
+    "dalvik.vm.background-dex2oat-threads",
+    kSystemPropertyDex2oatMemoryBudget};
 
 struct SystemPropertyConfig {
   const char* name;
@@ -143,6 +149,7 @@ class OdrConfig final {
   bool compilation_os_mode_ = false;
   bool minimal_ = false;
   bool only_boot_images_ = false;
+  std::string build_fingerprint_;
 
   // The current values of system properties listed in `kSystemProperties`.
   std::unordered_map<std::string, std::string> system_properties_;
@@ -238,6 +245,7 @@ class OdrConfig final {
   bool GetCompilationOsMode() const { return compilation_os_mode_; }
   bool GetMinimal() const { return minimal_; }
   bool GetOnlyBootImages() const { return only_boot_images_; }
+  const std::string& GetBuildFingerprint() const { return build_fingerprint_; }
   const OdrSystemProperties& GetSystemProperties() const { return odr_system_properties_; }
 
   void SetApexInfoListFile(const std::string& file_path) { apex_info_list_file_ = file_path; }
@@ -291,6 +299,8 @@ class OdrConfig final {
 
   void SetOnlyBootImages(bool value) { only_boot_images_ = value; }
 
+  void SetBuildFingerprint(const std::string& value) { build_fingerprint_ = value; }
+
   std::unordered_map<std::string, std::string>* MutableSystemProperties() {
     return &system_properties_;
   }
@@ -17,6 +17,7 @@
 #include "odr_fs_utils.h"
 
 #include <dirent.h>
+#include <errno.h>
 #include <ftw.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -87,7 +88,8 @@ WARN_UNUSED bool EnsureDirectoryExists(const std::string& absolute_path) {
     path.append("/").append(directory);
     if (!OS::DirectoryExists(path.c_str())) {
       static constexpr mode_t kDirectoryMode = S_IRWXU | S_IRGRP | S_IXGRP| S_IROTH | S_IXOTH;
-      if (mkdir(path.c_str(), kDirectoryMode) != 0) {
+      // The directory may be created concurrently by another compilation job.
+      if (mkdir(path.c_str(), kDirectoryMode) != 0 && errno != EEXIST) {
         PLOG(ERROR) << "Could not create directory: " << path;
         return false;
       }
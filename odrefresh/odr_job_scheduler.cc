@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "odr_job_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "android-base/chrono_utils.h"
+#include "android-base/logging.h"
+
+namespace art {
+namespace odrefresh {
+
+using ::android::base::Timer;
+
+OdrJobScheduler::OdrJobScheduler(uint64_t memory_budget_bytes, size_t max_parallel_jobs)
+    : memory_budget_bytes_(memory_budget_bytes),
+      max_parallel_jobs_(std::max<size_t>(max_parallel_jobs, 1u)) {}
+
+OdrJobScheduler::JobId OdrJobScheduler::AddJob(const std::string& name,
+                                               uint64_t memory_bytes,
+                                               const std::vector<JobId>& dependencies,
+                                               std::function<bool()> fn) {
+  JobId id = jobs_.size();
+  for (JobId dependency : dependencies) {
+    CHECK_LT(dependency, id) << "Dependencies of " << name << " must be added before it";
+  }
+  jobs_.push_back({.name = name,
+                   .memory_bytes = memory_bytes,
+                   .dependencies = dependencies,
+                   .fn = std::move(fn)});
+  return id;
+}
+
+void OdrJobScheduler::Run() {
+  Timer timer;
+  std::mutex mutex;
+  std::condition_variable finished_cond;
+  std::vector<std::thread> threads;
+  size_t running_jobs = 0;
+  uint64_t running_memory_bytes = 0;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    bool has_pending_jobs = false;
+    bool made_progress = false;
+    for (JobId id = 0; id != jobs_.size(); ++id) {
+      Job& job = jobs_[id];
+      if (job.state != State::kPending) {
+        continue;
+      }
+      bool dependencies_finished = true;
+      bool dependencies_ok = true;
+      for (JobId dependency : job.dependencies) {
+        if (jobs_[dependency].state != State::kFinished) {
+          dependencies_finished = false;
+        } else if (!jobs_[dependency].result.ok) {
+          dependencies_ok = false;
+        }
+      }
+      if (!dependencies_ok) {
+        LOG(WARNING) << "Skipping " << job.name << " because one of its dependencies failed";
+        job.state = State::kFinished;
+        made_progress = true;
+        continue;
+      }
+      has_pending_jobs = true;
+      if (!dependencies_finished) {
+        continue;
+      }
+      if (running_jobs != 0 &&
+          (running_jobs >= max_parallel_jobs_ ||
+           running_memory_bytes + job.memory_bytes > memory_budget_bytes_)) {
+        // Do not let later jobs overtake this one.
+        break;
+      }
+      job.state = State::kRunning;
+      job.result.start_time_ms = timer.duration().count();
+      ++running_jobs;
+      running_memory_bytes += job.memory_bytes;
+      made_progress = true;
+      threads.emplace_back([&, id]() {
+        Timer job_timer;
+        bool ok = jobs_[id].fn();
+        std::lock_guard<std::mutex> guard(mutex);
+        Job& finished_job = jobs_[id];
+        finished_job.result.run = true;
+        finished_job.result.ok = ok;
+        finished_job.result.elapsed_time_ms = job_timer.duration().count();
+        finished_job.state = State::kFinished;
+        --running_jobs;
+        running_memory_bytes -= finished_job.memory_bytes;
+        finished_cond.notify_all();
+      });
+    }
+    if (!has_pending_jobs && running_jobs == 0) {
+      break;
+    }
+    if (!made_progress) {
+      // Dependencies are always added before their dependents, so the first pending job can
+      // always make progress when no job is running.
+      DCHECK_NE(running_jobs, 0u);
+      finished_cond.wait(lock);
+    }
+  }
+  lock.unlock();
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace odrefresh
+}  // namespace art
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_ODREFRESH_ODR_JOB_SCHEDULER_H_
+#define ART_ODREFRESH_ODR_JOB_SCHEDULER_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace art {
+namespace odrefresh {
+
+// Runs compilation jobs, each on its own thread, as soon as the jobs they depend on have
+// succeeded. Jobs whose dependencies have succeeded start in the order in which they were added,
+// and a job does not start while the estimated memory of the running jobs plus its own exceeds
+// the memory budget or `max_parallel_jobs` jobs are running. A job that exceeds the budget on its
+// own still runs, but alone. A job whose dependency failed or did not run is not run.
+class OdrJobScheduler final {
+ public:
+  using JobId = size_t;
+
+  struct JobResult {
+    // Whether the job was run. False if one of its dependencies failed or did not run.
+    bool run = false;
+    // The value returned by the job, or false if the job was not run.
+    bool ok = false;
+    // Time between the call to `Run()` and the start of the job.
+    int64_t start_time_ms = 0;
+    // Time spent in the job.
+    int64_t elapsed_time_ms = 0;
+  };
+
+  OdrJobScheduler(uint64_t memory_budget_bytes, size_t max_parallel_jobs);
+
+  // Adds a job that runs `fn` once all jobs in `dependencies` have succeeded. `fn` returns
+  // whether the job succeeded. `memory_bytes` is the estimated peak memory used by the job.
+  // Dependencies must have been added before.
+  JobId AddJob(const std::string& name,
+               uint64_t memory_bytes,
+               const std::vector<JobId>& dependencies,
+               std::function<bool()> fn);
+
+  // Runs all jobs and returns once they have all finished or have been skipped.
+  void Run();
+
+  const std::string& GetName(JobId id) const { return jobs_[id].name; }
+  const JobResult& GetResult(JobId id) const { return jobs_[id].result; }
+  size_t GetNumberOfJobs() const { return jobs_.size(); }
+
+ private:
+  enum class State : uint8_t {
+    kPending,
+    kRunning,
+    kFinished,
+  };
+
+  struct Job {
+    std::string name;
+    uint64_t memory_bytes;
+    std::vector<JobId> dependencies;
+    std::function<bool()> fn;
+    State state = State::kPending;
+    JobResult result;
+  };
+
+  const uint64_t memory_budget_bytes_;
+  const size_t max_parallel_jobs_;
+  std::vector<Job> jobs_;
+};
+
+}  // namespace odrefresh
+}  // namespace art
+
+#endif  // ART_ODREFRESH_ODR_JOB_SCHEDULER_H_
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "odr_job_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace art {
+namespace odrefresh {
+
+using std::chrono_literals::operator""ms;  // NOLINT
+
+class OdrJobSchedulerTest : public testing::Test {
+ protected:
+  // Returns a job that records how many jobs run at the same time.
+  std::function<bool()> CountingJob(bool result) {
+    return [this, result]() {
+      int running = ++running_jobs_;
+      int max = max_running_jobs_.load();
+      while (running > max && !max_running_jobs_.compare_exchange_weak(max, running)) {
+      }
+      std::this_thread::sleep_for(20ms);
+      --running_jobs_;
+      return result;
+    };
+  }
+
+  std::atomic<int> running_jobs_ = 0;
+  std::atomic<int> max_running_jobs_ = 0;
+};
+
+TEST_F(OdrJobSchedulerTest, RunsAllJobs) {
+  OdrJobScheduler scheduler(/*memory_budget_bytes=*/1000, /*max_parallel_jobs=*/4);
+  OdrJobScheduler::JobId a = scheduler.AddJob("a", 100, {}, CountingJob(true));
+  OdrJobScheduler::JobId b = scheduler.AddJob("b", 100, {}, CountingJob(false));
+  scheduler.Run();
+
+  EXPECT_EQ(scheduler.GetNumberOfJobs(), 2u);
+  EXPECT_EQ(scheduler.GetName(a), "a");
+  EXPECT_TRUE(scheduler.GetResult(a).run);
+  EXPECT_TRUE(scheduler.GetResult(a).ok);
+  EXPECT_TRUE(scheduler.GetResult(b).run);
+  EXPECT_FALSE(scheduler.GetResult(b).ok);
+  EXPECT_GE(scheduler.GetResult(a).elapsed_time_ms, 20);
+}
+
+TEST_F(OdrJobSchedulerTest, RunsDependentsAfterDependencies) {
+  OdrJobScheduler scheduler(/*memory_budget_bytes=*/1000, /*max_parallel_jobs=*/4);
+  std::atomic<bool> a_finished = false;
+  bool b_saw_a_finished = false;
+  OdrJobScheduler::JobId a = scheduler.AddJob("a", 100, {}, [&]() {
+    std::this_thread::sleep_for(20ms);
+    a_finished = true;
+    return true;
+  });
+  OdrJobScheduler::JobId b = scheduler.AddJob("b", 100, {a}, [&]() {
+    b_saw_a_finished = a_finished;
+    return true;
+  });
+  scheduler.Run();
+
+  EXPECT_TRUE(scheduler.GetResult(b).run);
+  EXPECT_TRUE(b_saw_a_finished);
+  EXPECT_GE(scheduler.GetResult(b).start_time_ms, scheduler.GetResult(a).elapsed_time_ms);
+}
+
+TEST_F(OdrJobSchedulerTest, SkipsDependentsOfFailedJobs) {
+  OdrJobScheduler scheduler(/*memory_budget_bytes=*/1000, /*max_parallel_jobs=*/4);
+  OdrJobScheduler::JobId a = scheduler.AddJob("a", 100, {}, CountingJob(false));
+  OdrJobScheduler::JobId b = scheduler.AddJob("b", 100, {a}, CountingJob(true));
+  OdrJobScheduler::JobId c = scheduler.AddJob("c", 100, {b}, CountingJob(true));
+  OdrJobScheduler::JobId d = scheduler.AddJob("d", 100, {}, CountingJob(true));
+  scheduler.Run();
+
+  EXPECT_TRUE(scheduler.GetResult(a).run);
+  EXPECT_FALSE(scheduler.GetResult(b).run);
+  EXPECT_FALSE(scheduler.GetResult(b).ok);
+  EXPECT_FALSE(scheduler.GetResult(c).run);
+  EXPECT_TRUE(scheduler.GetResult(d).ok);
+}
+
+TEST_F(OdrJobSchedulerTest, RespectsMemoryBudget) {
+  OdrJobScheduler scheduler(/*memory_budget_bytes=*/250, /*max_parallel_jobs=*/4);
+  for (int i = 0; i < 6; ++i) {
+    scheduler.AddJob("job", 100, {}, CountingJob(true));
+  }
+  scheduler.Run();
+
+  EXPECT_LE(max_running_jobs_, 2);
+}
+
+TEST_F(OdrJobSchedulerTest, RespectsMaxParallelJobs) {
+  OdrJobScheduler scheduler(/*memory_budget_bytes=*/1000, /*max_parallel_jobs=*/1);
+  for (int i = 0; i < 3; ++i) {
+    scheduler.AddJob("job", 100, {}, CountingJob(true));
+  }
+  scheduler.Run();
+
+  EXPECT_EQ(max_running_jobs_, 1);
+}
+
+TEST_F(OdrJobSchedulerTest, RunsJobExceedingBudgetAlone) {
+  OdrJobScheduler scheduler(/*memory_budget_bytes=*/100, /*max_parallel_jobs=*/4);
+  OdrJobScheduler::JobId a = scheduler.AddJob("a", 1000, {}, CountingJob(true));
+  scheduler.AddJob("b", 10, {}, CountingJob(true));
+  scheduler.Run();
+
+  EXPECT_TRUE(scheduler.GetResult(a).ok);
+  EXPECT_EQ(max_running_jobs_, 1);
+}
+
+}  // namespace odrefresh
+}  // namespace art
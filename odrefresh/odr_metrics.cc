@@ -109,6 +109,22 @@ void OdrMetrics::SetBcpCompilationType(Stage stage, BcpCompilationType type) {
   }
 }
 
+void OdrMetrics::LogDex2OatJobTimings() const {
+  int64_t wall_time_ms = 0;
+  int64_t total_time_ms = 0;
+  for (const Dex2OatJobTiming& timing : dex2oat_job_timings_) {
+    LOG(INFO) << "dex2oat job " << timing.name << " (" << timing.stage << "): started at "
+              << timing.start_time_ms << "ms, took " << timing.elapsed_time_ms << "ms"
+              << (timing.ok ? "" : ", failed");
+    wall_time_ms = std::max(wall_time_ms, timing.start_time_ms + timing.elapsed_time_ms);
+    total_time_ms += timing.elapsed_time_ms;
+  }
+  if (!dex2oat_job_timings_.empty()) {
+    LOG(INFO) << "dex2oat jobs took " << wall_time_ms << "ms (" << total_time_ms
+              << "ms if run sequentially)";
+  }
+}
+
 int32_t OdrMetrics::GetFreeSpaceMiB(const std::string& path) {
   static constexpr uint32_t kBytesPerMiB = 1024 * 1024;
   static constexpr uint64_t kNominalMaximumCacheBytes = 1024 * kBytesPerMiB;
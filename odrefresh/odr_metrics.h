@@ -22,6 +22,7 @@
 #include <iosfwd>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "base/macros.h"
 #include "exec_utils.h"
@@ -88,6 +89,16 @@ class OdrMetrics final {
     kMainline = 2,
   };
 
+  // Timing of a single dex2oat job. Jobs of the same stage may run in parallel.
+  struct Dex2OatJobTiming {
+    std::string name;
+    Stage stage;
+    // Time between the start of the compilation and the start of the job.
+    int64_t start_time_ms;
+    int64_t elapsed_time_ms;
+    bool ok;
+  };
+
   explicit OdrMetrics(const std::string& cache_directory,
                       const std::string& metrics_file = kOdrefreshMetricsFile);
   ~OdrMetrics();
@@ -132,6 +143,19 @@ class OdrMetrics final {
   // Sets the BCP compilation type.
   void SetBcpCompilationType(Stage stage, BcpCompilationType type);
 
+  // Records the timing of a dex2oat job.
+  void AddDex2OatJobTiming(const Dex2OatJobTiming& timing) {
+    dex2oat_job_timings_.push_back(timing);
+  }
+
+  // Gets the timings of the dex2oat jobs, in the order in which they were recorded.
+  const std::vector<Dex2OatJobTiming>& GetDex2OatJobTimings() const {
+    return dex2oat_job_timings_;
+  }
+
+  // Logs the timing of each dex2oat job and the wall time of the whole compilation.
+  void LogDex2OatJobTimings() const;
+
   // Captures the current free space as the end free space.
   void CaptureSpaceFreeEnd();
 
@@ -186,6 +210,9 @@ class OdrMetrics final {
   // The result of the last dex2oat invocation for compiling system server, or `std::nullopt` if
   // dex2oat is not invoked.
   std::optional<ExecResult> system_server_dex2oat_result_;
+
+  // The timing of each dex2oat job. Not part of the record reported to statsd.
+  std::vector<Dex2OatJobTiming> dex2oat_job_timings_;
 };
 
 // Generated ostream operators.
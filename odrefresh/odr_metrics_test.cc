@@ -197,5 +197,28 @@ TEST_F(OdrMetricsTest, SystemServerResultWithValue) {
   EXPECT_EQ(record.system_server_dex2oat_result.signal, 9);
 }
 
+TEST_F(OdrMetricsTest, Dex2OatJobTimings) {
+  OdrMetrics metrics(GetCacheDirectory(), GetMetricsFilePath());
+  metrics.AddDex2OatJobTiming({.name = "boot classpath (x86)",
+                               .stage = OdrMetrics::Stage::kSecondaryBootClasspath,
+                               .start_time_ms = 0,
+                               .elapsed_time_ms = 300,
+                               .ok = true});
+  metrics.AddDex2OatJobTiming({.name = "services.jar",
+                               .stage = OdrMetrics::Stage::kSystemServerClasspath,
+                               .start_time_ms = 10,
+                               .elapsed_time_ms = 200,
+                               .ok = false});
+
+  ASSERT_EQ(metrics.GetDex2OatJobTimings().size(), 2u);
+  EXPECT_EQ(metrics.GetDex2OatJobTimings()[1].name, "services.jar");
+  EXPECT_EQ(metrics.GetDex2OatJobTimings()[1].start_time_ms, 10);
+  EXPECT_FALSE(metrics.GetDex2OatJobTimings()[1].ok);
+
+  // The timings are not part of the record reported to statsd.
+  OdrMetricsRecord record = metrics.ToRecord();
+  EXPECT_EQ(record.secondary_bcp_compilation_millis, 0);
+}
+
 }  // namespace odrefresh
 }  // namespace art
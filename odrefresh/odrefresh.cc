@@ -28,6 +28,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdarg>
 #include <cstdint>
@@ -83,6 +84,7 @@
 #include "odr_common.h"
 #include "odr_config.h"
 #include "odr_fs_utils.h"
+#include "odr_job_scheduler.h"
 #include "odr_metrics.h"
 #include "odrefresh/odrefresh.h"
 #include "tools/cmdline_builder.h"
@@ -98,6 +100,7 @@ namespace art_apex = com::android::art;
 using ::android::base::Basename;
 using ::android::base::Dirname;
 using ::android::base::Join;
+using ::android::base::ParseByteCount;
 using ::android::base::ParseInt;
 using ::android::base::Result;
 using ::android::base::ScopeGuard;
@@ -130,6 +133,15 @@ constexpr const char* kPrimaryCompilerFilter = "speed-profile";
 // jars, so we always use "verify".
 constexpr const char* kMainlineCompilerFilter = "verify";
 
+// Maximum number of dex2oat invocations that run in parallel.
+constexpr size_t kMaxParallelDex2oatJobs = 4;
+
+// Java heap size assumed for a dex2oat invocation whose -Xmx is not set.
+constexpr uint64_t kDefaultDex2oatHeapBytes = 512 * MB;
+
+// Memory used by a dex2oat invocation on top of its Java heap, mostly compiler arenas.
+constexpr uint64_t kDex2oatNativeMemoryBytes = 256 * MB;
+
 void EraseFiles(const std::vector<std::unique_ptr<File>>& files) {
   for (auto& file : files) {
     file->Erase(/*unlink=*/true);
@@ -319,13 +331,36 @@ Result<void> CheckSystemServerComponents(
       });
 }
 
+// Returns a string that changes whenever the file described by `sb` is replaced or modified.
+std::string GetFileFingerprint(const struct stat& sb) {
+  return ART_FORMAT("{}:{}.{:09}:{}.{:09}",
+                    static_cast<uint64_t>(sb.st_ino),
+                    static_cast<int64_t>(sb.st_mtim.tv_sec),
+                    static_cast<int64_t>(sb.st_mtim.tv_nsec),
+                    static_cast<int64_t>(sb.st_ctim.tv_sec),
+                    static_cast<int64_t>(sb.st_ctim.tv_nsec));
+}
+
+// Generates the components for `jars`. If `cached_components` is not null, the checksums of a
+// jar whose size and fingerprint match its cached component are taken from the cache instead
+// of being computed from the jar, which saves reading the jar on every boot.
 template <typename T>
 std::vector<T> GenerateComponents(
     const std::vector<std::string>& jars,
-    const std::function<T(const std::string& path, uint64_t size, const std::string& checksum)>&
-        custom_generator) {
+    const std::function<T(const std::string& path,
+                          uint64_t size,
+                          const std::string& checksum,
+                          const std::string& fingerprint)>& custom_generator,
+    const std::vector<T>* cached_components = nullptr) {
   std::vector<T> components;
 
+  std::unordered_map<std::string_view, const T*> cached_components_by_file;
+  if (cached_components != nullptr) {
+    for (const T& cached_component : *cached_components) {
+      cached_components_by_file.emplace(cached_component.getFile(), &cached_component);
+    }
+  }
+
   for (const std::string& path : jars) {
     std::string actual_path = RewriteParentDirectoryIfNeeded(path);
     struct stat sb;
@@ -333,19 +368,27 @@ std::vector<T> GenerateComponents(
       PLOG(ERROR) << "Failed to stat component: " << QuotePath(actual_path);
       return {};
     }
+    std::string fingerprint = GetFileFingerprint(sb);
 
-    std::optional<uint32_t> checksum;
-    std::string error_msg;
-    ArtDexFileLoader dex_loader(actual_path);
-    if (!dex_loader.GetMultiDexChecksum(&checksum, &error_msg)) {
-      LOG(ERROR) << "Failed to get multi-dex checksum: " << error_msg;
-      return {};
+    std::string checksum_str;
+    auto it = cached_components_by_file.find(path);
+    if (it != cached_components_by_file.end() && it->second->hasFingerprint() &&
+        it->second->getFingerprint() == fingerprint &&
+        it->second->getSize() == static_cast<uint64_t>(sb.st_size)) {
+      checksum_str = it->second->getChecksums();
+    } else {
+      std::optional<uint32_t> checksum;
+      std::string error_msg;
+      ArtDexFileLoader dex_loader(actual_path);
+      if (!dex_loader.GetMultiDexChecksum(&checksum, &error_msg)) {
+        LOG(ERROR) << "Failed to get multi-dex checksum: " << error_msg;
+        return {};
+      }
+      checksum_str = checksum.has_value() ? StringPrintf("%08x", checksum.value()) : std::string();
     }
 
-    const std::string checksum_str =
-        checksum.has_value() ? StringPrintf("%08x", checksum.value()) : std::string();
-
-    Result<T> component = custom_generator(path, static_cast<uint64_t>(sb.st_size), checksum_str);
+    Result<T> component =
+        custom_generator(path, static_cast<uint64_t>(sb.st_size), checksum_str, fingerprint);
     if (!component.ok()) {
       LOG(ERROR) << "Failed to generate component: " << component.error();
       return {};
@@ -357,11 +400,18 @@ std::vector<T> GenerateComponents(
   return components;
 }
 
-std::vector<art_apex::Component> GenerateComponents(const std::vector<std::string>& jars) {
+std::vector<art_apex::Component> GenerateComponents(
+    const std::vector<std::string>& jars,
+    const std::vector<art_apex::Component>* cached_components = nullptr) {
   return GenerateComponents<art_apex::Component>(
-      jars, [](const std::string& path, uint64_t size, const std::string& checksum) {
-        return art_apex::Component{path, size, checksum};
-      });
+      jars,
+      [](const std::string& path,
+         uint64_t size,
+         const std::string& checksum,
+         const std::string& fingerprint) {
+        return art_apex::Component{path, size, checksum, fingerprint};
+      },
+      cached_components);
 }
 
 // Checks whether a group of artifacts exists. Returns true if all are present, false otherwise.
@@ -448,6 +498,38 @@ Result<void> AddDex2OatConcurrencyArguments(/*inout*/ CmdlineBuilder& args,
   return {};
 }
 
+// Returns the estimated peak memory of a dex2oat invocation whose -Xmx is given by the system
+// property `xmx_property`.
+uint64_t EstimateDex2oatMemoryBytes(const OdrSystemProperties& system_properties,
+                                    const std::string& xmx_property) {
+  uint64_t heap_bytes = kDefaultDex2oatHeapBytes;
+  std::string xmx = system_properties.GetOrEmpty(xmx_property);
+  if (!xmx.empty() && !ParseByteCount(xmx, &heap_bytes)) {
+    LOG(WARNING) << ART_FORMAT("Invalid value '{}' for {}", xmx, xmx_property);
+    heap_bytes = kDefaultDex2oatHeapBytes;
+  }
+  return heap_bytes + kDex2oatNativeMemoryBytes;
+}
+
+// Returns the memory that dex2oat invocations running in parallel may use together.
+uint64_t GetDex2oatMemoryBudgetBytes(const OdrSystemProperties& system_properties) {
+  std::string budget = system_properties.GetOrEmpty(kSystemPropertyDex2oatMemoryBudget);
+  uint64_t budget_bytes;
+  if (!budget.empty()) {
+    if (ParseByteCount(budget, &budget_bytes)) {
+      return budget_bytes;
+    }
+    LOG(WARNING) << ART_FORMAT(
+        "Invalid value '{}' for {}", budget, kSystemPropertyDex2oatMemoryBudget);
+  }
+  long physical_pages = sysconf(_SC_PHYS_PAGES);
+  if (physical_pages <= 0) {
+    // Only run one invocation at a time.
+    return 0;
+  }
+  return static_cast<uint64_t>(physical_pages) * sysconf(_SC_PAGE_SIZE) / 4;
+}
+
 void AddDex2OatDebugInfo(/*inout*/ CmdlineBuilder& args) {
   args.Add("--generate-mini-debug-info");
   args.Add("--strip");
@@ -855,7 +937,9 @@ NO_INLINE Result<void> OnDeviceRefresh::WriteCacheInfo() const {
       {art_apex::Classpath(bcp_components)},
       {art_apex::Classpath(dex2oat_bcp_components)},
       {art_apex::SystemServerComponents(system_server_components)},
-      config_.GetCompilationOsMode() ? std::make_optional(true) : std::nullopt));
+      config_.GetCompilationOsMode() ? std::make_optional(true) : std::nullopt,
+      config_.GetBuildFingerprint().empty() ? std::nullopt :
+                                              std::make_optional(config_.GetBuildFingerprint())));
 
   art_apex::write(out, *info);
   out.close();
@@ -874,22 +958,28 @@ static void ReportNextBootAnimationProgress(uint32_t current_compilation,
   SetProperty("service.bootanim.progress", std::to_string(value));
 }
 
-std::vector<art_apex::Component> OnDeviceRefresh::GenerateBootClasspathComponents() const {
-  return GenerateComponents(boot_classpath_jars_);
+std::vector<art_apex::Component> OnDeviceRefresh::GenerateBootClasspathComponents(
+    const std::vector<art_apex::Component>* cached_components) const {
+  return GenerateComponents(boot_classpath_jars_, cached_components);
 }
 
-std::vector<art_apex::Component> OnDeviceRefresh::GenerateDex2oatBootClasspathComponents() const {
-  return GenerateComponents(dex2oat_boot_classpath_jars_);
+std::vector<art_apex::Component> OnDeviceRefresh::GenerateDex2oatBootClasspathComponents(
+    const std::vector<art_apex::Component>* cached_components) const {
+  return GenerateComponents(dex2oat_boot_classpath_jars_, cached_components);
 }
 
-std::vector<art_apex::SystemServerComponent> OnDeviceRefresh::GenerateSystemServerComponents()
-    const {
+std::vector<art_apex::SystemServerComponent> OnDeviceRefresh::GenerateSystemServerComponents(
+    const std::vector<art_apex::SystemServerComponent>* cached_components) const {
   return GenerateComponents<art_apex::SystemServerComponent>(
       all_systemserver_jars_,
-      [&](const std::string& path, uint64_t size, const std::string& checksum) {
+      [&](const std::string& path,
+          uint64_t size,
+          const std::string& checksum,
+          const std::string& fingerprint) {
         bool isInClasspath = ContainsElement(systemserver_classpath_jars_, path);
-        return art_apex::SystemServerComponent{path, size, checksum, isInClasspath};
-      });
+        return art_apex::SystemServerComponent{path, size, checksum, fingerprint, isInClasspath};
+      },
+      cached_components);
 }
 
 std::vector<std::string> OnDeviceRefresh::GetArtBcpJars() const {
@@ -1295,8 +1385,12 @@ WARN_UNUSED PreconditionCheckResult OnDeviceRefresh::CheckPreconditionForData(
   //
   // The boot class components may change unexpectedly, for example an OTA could update
   // framework.jar.
-  const std::vector<art_apex::Component> current_dex2oat_bcp_components =
-      GenerateDex2oatBootClasspathComponents();
+  //
+  // The checksums are only recomputed for files whose fingerprint changed. A different build may
+  // reuse inodes and timestamps, so the fingerprints are only trusted on the same build.
+  bool use_cached_checksums = !config_.GetBuildFingerprint().empty() &&
+                              cache_info->hasBuildFingerprint() &&
+                              cache_info->getBuildFingerprint() == config_.GetBuildFingerprint();
 
   const art_apex::Classpath* cached_dex2oat_bcp_components =
       cache_info->getFirstDex2oatBootClasspath();
@@ -1305,6 +1399,10 @@ WARN_UNUSED PreconditionCheckResult OnDeviceRefresh::CheckPreconditionForData(
     return PreconditionCheckResult::NoneOk(OdrMetrics::Trigger::kApexVersionMismatch);
   }
 
+  const std::vector<art_apex::Component> current_dex2oat_bcp_components =
+      GenerateDex2oatBootClasspathComponents(
+          use_cached_checksums ? &cached_dex2oat_bcp_components->getComponent() : nullptr);
+
   Result<void> result = CheckComponents(current_dex2oat_bcp_components,
                                         cached_dex2oat_bcp_components->getComponent());
   if (!result.ok()) {
@@ -1345,8 +1443,6 @@ WARN_UNUSED PreconditionCheckResult OnDeviceRefresh::CheckPreconditionForData(
     }
   }
 
-  const std::vector<art_apex::Component> current_bcp_components = GenerateBootClasspathComponents();
-
   const art_apex::Classpath* cached_bcp_components = cache_info->getFirstBootClasspath();
   if (cached_bcp_components == nullptr) {
     LOG(INFO) << "Missing BootClasspath components.";
@@ -1354,6 +1450,9 @@ WARN_UNUSED PreconditionCheckResult OnDeviceRefresh::CheckPreconditionForData(
         OdrMetrics::Trigger::kApexVersionMismatch);
   }
 
+  const std::vector<art_apex::Component> current_bcp_components = GenerateBootClasspathComponents(
+      use_cached_checksums ? &cached_bcp_components->getComponent() : nullptr);
+
   result = CheckComponents(current_bcp_components, cached_bcp_components->getComponent());
   if (!result.ok()) {
     LOG(INFO) << "BootClasspath components mismatch: " << result.error();
@@ -1372,9 +1471,6 @@ WARN_UNUSED PreconditionCheckResult OnDeviceRefresh::CheckPreconditionForData(
   //
   // The system_server components may change unexpectedly, for example an OTA could update
   // services.jar.
-  const std::vector<art_apex::SystemServerComponent> current_system_server_components =
-      GenerateSystemServerComponents();
-
   const art_apex::SystemServerComponents* cached_system_server_components =
       cache_info->getFirstSystemServerComponents();
   if (cached_system_server_components == nullptr) {
@@ -1382,6 +1478,10 @@ WARN_UNUSED PreconditionCheckResult OnDeviceRefresh::CheckPreconditionForData(
     return PreconditionCheckResult::SystemServerNotOk(OdrMetrics::Trigger::kApexVersionMismatch);
   }
 
+  const std::vector<art_apex::SystemServerComponent> current_system_server_components =
+      GenerateSystemServerComponents(
+          use_cached_checksums ? &cached_system_server_components->getComponent() : nullptr);
+
   result = CheckSystemServerComponents(current_system_server_components,
                                        cached_system_server_components->getComponent());
   if (!result.ok()) {
@@ -2095,37 +2195,21 @@ WARN_UNUSED CompilationResult OnDeviceRefresh::RunDex2oatForSystemServer(
 }
 
 WARN_UNUSED CompilationResult
-OnDeviceRefresh::CompileSystemServer(const std::string& staging_dir,
-                                     const std::set<std::string>& system_server_jars_to_compile,
-                                     const std::function<void()>& on_dex2oat_success) const {
-  DCHECK(!system_server_jars_to_compile.empty());
-
-  CompilationResult result = CompilationResult::Ok();
-  std::vector<std::string> classloader_context;
-
+OnDeviceRefresh::CompileSystemServerJar(const std::string& staging_dir,
+                                        const std::string& jar,
+                                        const std::vector<std::string>& classloader_context,
+                                        const std::function<void()>& on_dex2oat_success) const {
   if (!check_compilation_space_()) {
-    LOG(ERROR) << "Compilation of system_server failed: Insufficient space";
+    LOG(ERROR) << ART_FORMAT("Compilation of {} failed: Insufficient space", Basename(jar));
     return CompilationResult::Error(OdrMetrics::Status::kNoSpace, "Insufficient space");
   }
 
-  for (const std::string& jar : all_systemserver_jars_) {
-    if (ContainsElement(system_server_jars_to_compile, jar)) {
-      CompilationResult current_result =
-          RunDex2oatForSystemServer(staging_dir, jar, classloader_context);
-      result.Merge(current_result);
-
-      if (current_result.IsOk()) {
-        on_dex2oat_success();
-      } else {
-        LOG(ERROR) << ART_FORMAT("Compilation of {} failed: {}", Basename(jar), result.error_msg);
-      }
-    }
-
-    if (ContainsElement(systemserver_classpath_jars_, jar)) {
-      classloader_context.emplace_back(jar);
-    }
+  CompilationResult result = RunDex2oatForSystemServer(staging_dir, jar, classloader_context);
+  if (result.IsOk()) {
+    on_dex2oat_success();
+  } else {
+    LOG(ERROR) << ART_FORMAT("Compilation of {} failed: {}", Basename(jar), result.error_msg);
   }
-
   return result;
 }
 
@@ -2183,9 +2267,9 @@ WARN_UNUSED ExitCode OnDeviceRefresh::Compile(OdrMetrics& metrics,
     staging_dir = res.value();
   }
 
-  uint32_t dex2oat_invocation_count = 0;
+  std::atomic<uint32_t> dex2oat_invocation_count = 0;
   uint32_t total_dex2oat_invocation_count = compilation_options.CompilationUnitCount();
-  ReportNextBootAnimationProgress(dex2oat_invocation_count, total_dex2oat_invocation_count);
+  ReportNextBootAnimationProgress(0, total_dex2oat_invocation_count);
   auto advance_animation_progress = [&]() {
     ReportNextBootAnimationProgress(++dex2oat_invocation_count, total_dex2oat_invocation_count);
   };
@@ -2193,38 +2277,143 @@ WARN_UNUSED ExitCode OnDeviceRefresh::Compile(OdrMetrics& metrics,
   const std::vector<InstructionSet>& bcp_instruction_sets = config_.GetBootClasspathIsas();
   DCHECK(!bcp_instruction_sets.empty() && bcp_instruction_sets.size() <= 2);
   InstructionSet system_server_isa = config_.GetSystemServerIsa();
+  const OdrSystemProperties& system_properties = config_.GetSystemProperties();
 
-  bool system_server_isa_failed = false;
-  std::optional<std::pair<OdrMetrics::Stage, OdrMetrics::Status>> first_failure;
+  // Independent dex2oat invocations run in parallel: the boot images of the other ISA are
+  // compiled while the system server jars, which only depend on the boot images of their own
+  // ISA, are compiled.
+  OdrJobScheduler scheduler(
+      GetDex2oatMemoryBudgetBytes(system_properties),
+      config_.GetCompilationOsMode() ? 1u : kMaxParallelDex2oatJobs);
+
+  struct Job {
+    OdrMetrics::Stage stage;
+    CompilationResult result;
+    OdrJobScheduler::JobId id;
+  };
+  // The jobs in the order in which they were added. Each job writes its own result, which is
+  // only read once all jobs have finished.
+  std::vector<Job> jobs;
+  jobs.reserve(compilation_options.boot_images_to_generate_for_isas.size() +
+               compilation_options.system_server_jars_to_compile.size());
+  auto add_job = [&](OdrMetrics::Stage stage,
+                     const std::string& name,
+                     uint64_t memory_bytes,
+                     const std::vector<OdrJobScheduler::JobId>& dependencies,
+                     std::function<CompilationResult()> fn) {
+    size_t index = jobs.size();
+    jobs.push_back({.stage = stage});
+    jobs[index].id = scheduler.AddJob(
+        name, memory_bytes, dependencies, [&jobs, index, fn = std::move(fn)]() {
+          jobs[index].result = fn();
+          return jobs[index].result.IsOk();
+        });
+    return jobs[index].id;
+  };
 
-  for (const auto& [isa, boot_images_to_generate] :
-       compilation_options.boot_images_to_generate_for_isas) {
+  // Add the boot images for the system server ISA first so that, when memory is scarce, the
+  // system server jars are not delayed by the boot images of the other ISA.
+  std::optional<OdrJobScheduler::JobId> system_server_bcp_job;
+  uint64_t bcp_memory_bytes =
+      EstimateDex2oatMemoryBytes(system_properties, "dalvik.vm.image-dex2oat-Xmx");
+  auto add_bcp_job = [&](InstructionSet isa, BootImages boot_images_to_generate) {
     OdrMetrics::Stage stage = (isa == bcp_instruction_sets.front()) ?
                                   OdrMetrics::Stage::kPrimaryBootClasspath :
                                   OdrMetrics::Stage::kSecondaryBootClasspath;
-    CompilationResult bcp_result =
-        CompileBootClasspath(staging_dir, isa, boot_images_to_generate, advance_animation_progress);
-    metrics.SetDex2OatResult(stage, bcp_result.elapsed_time_ms, bcp_result.dex2oat_result);
+    OdrJobScheduler::JobId id = add_job(
+        stage,
+        ART_FORMAT("boot classpath ({})", GetInstructionSetString(isa)),
+        bcp_memory_bytes,
+        /*dependencies=*/{},
+        [&, isa, boot_images_to_generate]() {
+          return CompileBootClasspath(
+              staging_dir, isa, boot_images_to_generate, advance_animation_progress);
+        });
     metrics.SetBcpCompilationType(stage, boot_images_to_generate.GetTypeForMetrics());
-    if (!bcp_result.IsOk()) {
-      if (isa == system_server_isa) {
-        system_server_isa_failed = true;
-      }
-      first_failure = first_failure.value_or(std::make_pair(stage, bcp_result.status));
+    if (isa == system_server_isa) {
+      system_server_bcp_job = id;
+    }
+  };
+  for (const auto& [isa, boot_images_to_generate] :
+       compilation_options.boot_images_to_generate_for_isas) {
+    if (isa == system_server_isa) {
+      add_bcp_job(isa, boot_images_to_generate);
     }
   }
 
-  // Don't compile system server if the compilation of BCP failed.
-  if (!system_server_isa_failed && !compilation_options.system_server_jars_to_compile.empty() &&
+  // System server jars depend on the boot images of their ISA and are not compiled if the
+  // compilation of those fails.
+  if (!compilation_options.system_server_jars_to_compile.empty() &&
       !config_.GetOnlyBootImages()) {
-    OdrMetrics::Stage stage = OdrMetrics::Stage::kSystemServerClasspath;
-    CompilationResult ss_result = CompileSystemServer(
-        staging_dir, compilation_options.system_server_jars_to_compile, advance_animation_progress);
-    metrics.SetDex2OatResult(stage, ss_result.elapsed_time_ms, ss_result.dex2oat_result);
-    if (!ss_result.IsOk()) {
-      first_failure = first_failure.value_or(std::make_pair(stage, ss_result.status));
+    std::vector<OdrJobScheduler::JobId> dependencies;
+    if (system_server_bcp_job.has_value()) {
+      dependencies.push_back(system_server_bcp_job.value());
+    }
+    uint64_t system_server_memory_bytes =
+        EstimateDex2oatMemoryBytes(system_properties, "dalvik.vm.dex2oat-Xmx");
+    // The class loader context only refers to the dex files of the preceding jars, not to their
+    // compiled artifacts, so the system server jars do not depend on each other.
+    std::vector<std::string> classloader_context;
+    for (const std::string& jar : all_systemserver_jars_) {
+      if (ContainsElement(compilation_options.system_server_jars_to_compile, jar)) {
+        add_job(OdrMetrics::Stage::kSystemServerClasspath,
+                Basename(jar),
+                system_server_memory_bytes,
+                dependencies,
+                [&, jar, classloader_context]() {
+                  return CompileSystemServerJar(
+                      staging_dir, jar, classloader_context, advance_animation_progress);
+                });
+      }
+      if (ContainsElement(systemserver_classpath_jars_, jar)) {
+        classloader_context.emplace_back(jar);
+      }
+    }
+  }
+
+  for (const auto& [isa, boot_images_to_generate] :
+       compilation_options.boot_images_to_generate_for_isas) {
+    if (isa != system_server_isa) {
+      add_bcp_job(isa, boot_images_to_generate);
+    }
+  }
+
+  scheduler.Run();
+
+  // Report the results in the order in which the stages used to run.
+  std::optional<std::pair<OdrMetrics::Stage, OdrMetrics::Status>> first_failure;
+  for (OdrMetrics::Stage stage : {OdrMetrics::Stage::kPrimaryBootClasspath,
+                                  OdrMetrics::Stage::kSecondaryBootClasspath,
+                                  OdrMetrics::Stage::kSystemServerClasspath}) {
+    std::optional<CompilationResult> stage_result;
+    for (const Job& job : jobs) {
+      if (job.stage != stage || !scheduler.GetResult(job.id).run) {
+        continue;
+      }
+      if (!stage_result.has_value()) {
+        stage_result = CompilationResult::Ok();
+      }
+      stage_result->Merge(job.result);
+    }
+    if (!stage_result.has_value()) {
+      continue;
+    }
+    metrics.SetDex2OatResult(stage, stage_result->elapsed_time_ms, stage_result->dex2oat_result);
+    if (!stage_result->IsOk()) {
+      first_failure = first_failure.value_or(std::make_pair(stage, stage_result->status));
+    }
+  }
+  for (const Job& job : jobs) {
+    const OdrJobScheduler::JobResult& job_result = scheduler.GetResult(job.id);
+    if (job_result.run) {
+      metrics.AddDex2OatJobTiming({.name = scheduler.GetName(job.id),
+                                   .stage = job.stage,
+                                   .start_time_ms = job_result.start_time_ms,
+                                   .elapsed_time_ms = job_result.elapsed_time_ms,
+                                   .ok = job_result.ok});
     }
   }
+  metrics.LogDex2OatJobTimings();
 
   if (first_failure.has_value()) {
     LOG(ERROR) << "Compilation failed, stage: " << first_failure->first
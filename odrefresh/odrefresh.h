@@ -206,11 +206,17 @@ class OnDeviceRefresh final {
   // Writes ART APEX cache information to `kOnDeviceRefreshOdrefreshArtifactDirectory`.
   android::base::Result<void> WriteCacheInfo() const;
 
-  std::vector<com::android::art::Component> GenerateBootClasspathComponents() const;
+  // The `Generate*Components()` functions take the checksums of unchanged files from
+  // `cached_components` if it is not null.
+  std::vector<com::android::art::Component> GenerateBootClasspathComponents(
+      const std::vector<com::android::art::Component>* cached_components = nullptr) const;
 
-  std::vector<com::android::art::Component> GenerateDex2oatBootClasspathComponents() const;
+  std::vector<com::android::art::Component> GenerateDex2oatBootClasspathComponents(
+      const std::vector<com::android::art::Component>* cached_components = nullptr) const;
 
-  std::vector<com::android::art::SystemServerComponent> GenerateSystemServerComponents() const;
+  std::vector<com::android::art::SystemServerComponent> GenerateSystemServerComponents(
+      const std::vector<com::android::art::SystemServerComponent>* cached_components =
+          nullptr) const;
 
   // Returns the list of BCP jars in the ART module.
   std::vector<std::string> GetArtBcpJars() const;
@@ -362,9 +368,10 @@ class OnDeviceRefresh final {
                             const std::vector<std::string>& classloader_context) const;
 
   WARN_UNUSED CompilationResult
-  CompileSystemServer(const std::string& staging_dir,
-                      const std::set<std::string>& system_server_jars_to_compile,
-                      const std::function<void()>& on_dex2oat_success) const;
+  CompileSystemServerJar(const std::string& staging_dir,
+                         const std::string& jar,
+                         const std::vector<std::string>& classloader_context,
+                         const std::function<void()>& on_dex2oat_success) const;
 
   // Configuration to use.
   const OdrConfig& config_;
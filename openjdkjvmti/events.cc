@@ -34,7 +34,10 @@
 #include <sys/time.h>
 
 #include <array>
+#include <atomic>
 #include <functional>
+#include <random>
+#include <vector>
 
 #include "alloc_manager.h"
 #include "android-base/thread_annotations.h"
@@ -55,6 +58,7 @@
 #include "indirect_reference_table.h"
 #include "instrumentation.h"
 #include "interpreter/shadow_frame.h"
+#include "jni/java_vm_ext.h"
 #include "jni/jni_env_ext-inl.h"
 #include "jni/jni_internal.h"
 #include "jvalue-inl.h"
@@ -313,13 +317,24 @@ class JvmtiDdmChunkListener : public art::DdmCallback {
 
 class JvmtiEventAllocationListener : public AllocationManager::AllocationCallback {
  public:
-  explicit JvmtiEventAllocationListener(EventHandler* handler) : handler_(handler) {}
+  explicit JvmtiEventAllocationListener(EventHandler* handler)
+      : handler_(handler),
+        sampling_interval_(0),
+        sampled_lock_("JVMTI sampled allocations lock", art::LockLevel::kGenericBottomLock),
+        sampled_cond_("JVMTI sampled allocations condition", sampled_lock_) {}
 
   void ObjectAllocated(art::Thread* self, art::ObjPtr<art::mirror::Object>* obj, size_t byte_count)
       override REQUIRES_SHARED(art::Locks::mutator_lock_) {
     DCHECK_EQ(self, art::Thread::Current());
 
     if (handler_->IsEventEnabledAnywhere(ArtJvmtiEvent::kVmObjectAlloc)) {
+      size_t sampling_interval = sampling_interval_.load(std::memory_order_relaxed);
+      if (sampling_interval != 0) {
+        if (TakeSample(byte_count, sampling_interval)) {
+          RecordSample(self, obj->Ptr(), byte_count);
+        }
+        return;
+      }
       art::StackHandleScope<1> hs(self);
       auto h = hs.NewHandleWrapper(obj);
       // jvmtiEventVMObjectAlloc parameters:
@@ -344,10 +359,99 @@ class JvmtiEventAllocationListener : public AllocationManager::AllocationCallbac
     }
   }
 
+  // A sampling interval of 0 delivers every allocation inline on the allocating thread.
+  void SetSamplingInterval(size_t sampling_interval) {
+    sampling_interval_.store(sampling_interval, std::memory_order_relaxed);
+  }
+
+  // Waits up to timeout_ms for a full batch of samples to be pending, then reports all pending
+  // samples to the VMObjectAlloc callback of the given env on the current thread.
+  jint DeliverSamples(ArtJvmTiEnv* env, art::Thread* self, jlong timeout_ms)
+      REQUIRES(!sampled_lock_) {
+    std::vector<SampledAllocation> samples;
+    {
+      art::MutexLock mu(self, sampled_lock_);
+      if (pending_samples_.size() < kSampleBatchSize && timeout_ms > 0) {
+        sampled_cond_.TimedWait(self, timeout_ms, /*ns=*/0);
+      }
+      samples.swap(pending_samples_);
+    }
+    jvmtiEventVMObjectAlloc callback =
+        env->event_callbacks != nullptr ? env->event_callbacks->VMObjectAlloc : nullptr;
+    JNIEnv* jni_env = self->GetJniEnv();
+    for (const SampledAllocation& sample : samples) {
+      if (callback != nullptr) {
+        callback(env, jni_env, sample.thread, sample.object, sample.klass, sample.byte_count);
+      }
+      jni_env->DeleteGlobalRef(sample.thread);
+      jni_env->DeleteGlobalRef(sample.object);
+      jni_env->DeleteGlobalRef(sample.klass);
+    }
+    return static_cast<jint>(samples.size());
+  }
+
  private:
+  struct SampledAllocation {
+    jthread thread;
+    jobject object;
+    jclass klass;
+    jlong byte_count;
+  };
+
+  // Number of pending samples that wakes up a waiting DeliverSamples.
+  static constexpr size_t kSampleBatchSize = 64;
+  // Samples taken while this many are pending are dropped, so that an agent that stops
+  // delivering does not keep an unbounded number of objects alive.
+  static constexpr size_t kMaxPendingSamples = 16 * 1024;
+
+  // Counts down the bytes allocated by the current thread until the next sample. As with the
+  // Java heap sampler, the distance between samples is drawn from a geometric distribution so that
+  // allocation patterns do not alias with the sampling interval.
+  static bool TakeSample(size_t byte_count, size_t sampling_interval) {
+    static thread_local size_t bytes_until_sample = 0;
+    static thread_local std::minstd_rand rng(static_cast<uint32_t>(art::GetTid()));
+    if (bytes_until_sample > byte_count) {
+      bytes_until_sample -= byte_count;
+      return false;
+    }
+    std::geometric_distribution<size_t> distribution(1.0 / sampling_interval);
+    bytes_until_sample = distribution(rng) + 1;
+    return true;
+  }
+
+  void RecordSample(art::Thread* self, art::mirror::Object* obj, size_t byte_count)
+      REQUIRES_SHARED(art::Locks::mutator_lock_) REQUIRES(!sampled_lock_) {
+    {
+      art::MutexLock mu(self, sampled_lock_);
+      if (pending_samples_.size() >= kMaxPendingSamples) {
+        return;
+      }
+    }
+    // The references are global since the samples are reported on another thread.
+    art::JavaVMExt* vm = art::Runtime::Current()->GetJavaVM();
+    SampledAllocation sample = {
+        static_cast<jthread>(vm->AddGlobalRef(self, self->GetPeer())),
+        vm->AddGlobalRef(self, obj),
+        static_cast<jclass>(vm->AddGlobalRef(self, obj->GetClass())),
+        static_cast<jlong>(byte_count),
+    };
+    art::MutexLock mu(self, sampled_lock_);
+    pending_samples_.push_back(sample);
+    if (pending_samples_.size() == kSampleBatchSize) {
+      sampled_cond_.Broadcast(self);
+    }
+  }
+
   EventHandler* handler_;
+  std::atomic<size_t> sampling_interval_;
+  art::Mutex sampled_lock_;
+  art::ConditionVariable sampled_cond_ GUARDED_BY(sampled_lock_);
+  std::vector<SampledAllocation> pending_samples_ GUARDED_BY(sampled_lock_);
 };
 
+// The allocation listener of the event handler, used by the allocation sampling extensions.
+static JvmtiEventAllocationListener* gSampledAllocationListener = nullptr;
+
 static void SetupObjectAllocationTracking(bool enable) {
   // We must not hold the mutator lock here, but if we're in FastJNI, for example, we might. For
   // now, do a workaround: (possibly) acquire and release.
@@ -1639,6 +1743,31 @@ int32_t EventHandler::GetInternalEventRefcount(ArtJvmtiEvent event) const {
   return internal_event_refcount_[GetInternalEventIndex(event)];
 }
 
+jvmtiError EventHandler::SetAllocationSamplingInterval(jvmtiEnv* env, jint sampling_interval) {
+  if (sampling_interval < 0) {
+    return ERR(ILLEGAL_ARGUMENT);
+  }
+  DCHECK(gSampledAllocationListener != nullptr);
+  gSampledAllocationListener->SetSamplingInterval(static_cast<size_t>(sampling_interval));
+  return OK;
+}
+
+jvmtiError EventHandler::DeliverSampledAllocations(jvmtiEnv* env,
+                                                   jlong timeout_ms,
+                                                   jint* delivered_count) {
+  if (delivered_count == nullptr) {
+    return ERR(NULL_POINTER);
+  }
+  art::Thread* self = art::Thread::Current();
+  if (self == nullptr) {
+    return ERR(UNATTACHED_THREAD);
+  }
+  DCHECK(gSampledAllocationListener != nullptr);
+  *delivered_count =
+      gSampledAllocationListener->DeliverSamples(ArtJvmTiEnv::AsArtJvmTiEnv(env), self, timeout_ms);
+  return OK;
+}
+
 void EventHandler::Shutdown() {
   // Need to remove the method_trace_listener_ if it's there.
   art::Thread* self = art::Thread::Current();
@@ -1656,6 +1785,7 @@ EventHandler::EventHandler()
     frame_pop_enabled(false),
     internal_event_refcount_({0}) {
   alloc_listener_.reset(new JvmtiEventAllocationListener(this));
+  gSampledAllocationListener = alloc_listener_.get();
   AllocationManager::Get()->SetAllocListener(alloc_listener_.get());
   ddm_listener_.reset(new JvmtiDdmChunkListener(this));
   gc_pause_listener_.reset(new JvmtiGcPauseListener(this));
@@ -304,6 +304,18 @@ class EventHandler {
       REQUIRES_SHARED(art::Locks::mutator_lock_)
       REQUIRES(art::Locks::user_code_suspension_lock_, art::Locks::thread_list_lock_);
 
+  // Extension function to report VMObjectAlloc events for a sample of the allocations only. A
+  // sample is taken on average once every sampling_interval bytes allocated by a thread. Samples
+  // are not reported on the allocating thread but queued until DeliverSampledAllocations is
+  // called. A sampling_interval of 0 reports every allocation inline, which is the default.
+  static jvmtiError SetAllocationSamplingInterval(jvmtiEnv* env, jint sampling_interval);
+
+  // Extension function to report the queued allocation samples to the VMObjectAlloc callback of
+  // env on the current thread. Waits for up to timeout_ms for a batch of samples to be queued.
+  static jvmtiError DeliverSampledAllocations(jvmtiEnv* env,
+                                              jlong timeout_ms,
+                                              jint* delivered_count);
+
   template<typename Visitor>
   void ForEachEnv(art::Thread* self, Visitor v) REQUIRES(!envs_lock_) {
     art::ReaderMutexLock mu(self, envs_lock_);
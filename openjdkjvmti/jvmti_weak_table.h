@@ -97,6 +97,20 @@ class JvmtiWeakTable : public art::gc::SystemWeakHolder {
     return GetTagLocked(self, obj, result);
   }
 
+  // Return the value associated with the given object without taking any lock, so that several
+  // threads can read the table at the same time. This is only safe while no thread can modify the
+  // table: a thread must hold the mutator lock exclusively and no GC may be running, so that the
+  // table only contains to-space references and is not swept.
+  bool GetTagUnsynchronized(art::ObjPtr<art::mirror::Object> obj, /* out */ T* result) const
+      NO_THREAD_SAFETY_ANALYSIS {
+    auto it = tagged_objects_.find(art::GcRoot<art::mirror::Object>(obj));
+    if (it != tagged_objects_.end()) {
+      *result = it->second;
+      return true;
+    }
+    return false;
+  }
+
   // Sweep the container. DO NOT CALL MANUALLY.
   ALWAYS_INLINE void Sweep(art::IsMarkedVisitor* visitor)
       REQUIRES_SHARED(art::Locks::mutator_lock_)
@@ -43,6 +43,7 @@
 #include "ti_dump.h"
 #include "ti_heap.h"
 #include "ti_logging.h"
+#include "ti_method.h"
 #include "ti_monitor.h"
 #include "ti_redefine.h"
 #include "ti_search.h"
@@ -200,6 +201,30 @@ jvmtiError ExtensionUtil::GetExtensionFunctions(jvmtiEnv* env,
     return error;
   }
 
+  error = add_extension(
+      reinterpret_cast<jvmtiExtensionFunction>(HeapExtensions::IterateThroughHeapParallel),
+      "com.android.art.heap.iterate_through_heap_parallel",
+      "Iterate through a heap on several threads. This is equivalent to"
+      " com.android.art.heap.iterate_through_heap_ext, except that the callbacks must be thread"
+      " safe, as they are called concurrently from several threads and objects are reported in"
+      " no particular order. Tags set by the callbacks are only visible to the other threads once"
+      " the iteration is complete. After a callback returns JVMTI_VISIT_ABORT, other threads may"
+      " report a few more objects before the iteration stops.",
+      {
+          { "heap_filter", JVMTI_KIND_IN, JVMTI_TYPE_JINT, false},
+          { "klass", JVMTI_KIND_IN, JVMTI_TYPE_JCLASS, true},
+          { "callbacks", JVMTI_KIND_IN_PTR, JVMTI_TYPE_CVOID, false},
+          { "user_data", JVMTI_KIND_IN_PTR, JVMTI_TYPE_CVOID, true}
+      },
+      {
+          ERR(MUST_POSSESS_CAPABILITY),
+          ERR(INVALID_CLASS),
+          ERR(NULL_POINTER),
+      });
+  if (error != ERR(NONE)) {
+    return error;
+  }
+
   error = add_extension(
       reinterpret_cast<jvmtiExtensionFunction>(AllocUtil::GetGlobalJvmtiAllocationState),
       "com.android.art.alloc.get_global_jvmti_allocation_state",
@@ -215,6 +240,71 @@ jvmtiError ExtensionUtil::GetExtensionFunctions(jvmtiEnv* env,
     return error;
   }
 
+  error = add_extension(
+      reinterpret_cast<jvmtiExtensionFunction>(EventHandler::SetAllocationSamplingInterval),
+      "com.android.art.alloc.set_allocation_sampling_interval",
+      "Sets the average number of bytes a thread allocates between two VMObjectAlloc events. When"
+      " the interval is not 0 the events are not sent on the allocating thread. Instead they are"
+      " queued and sent to the VMObjectAlloc callback of the calling jvmtiEnv by"
+      " com.android.art.alloc.deliver_sampled_allocations, typically in a loop on an agent"
+      " thread. Queued samples keep their objects alive until they are delivered. Samples are"
+      " dropped while too many are queued. The default interval of 0 sends an event for every"
+      " allocation on the allocating thread.",
+      {
+          { "sampling_interval", JVMTI_KIND_IN, JVMTI_TYPE_JINT, false },
+      },
+      { ERR(ILLEGAL_ARGUMENT) });
+  if (error != ERR(NONE)) {
+    return error;
+  }
+
+  error = add_extension(
+      reinterpret_cast<jvmtiExtensionFunction>(EventHandler::DeliverSampledAllocations),
+      "com.android.art.alloc.deliver_sampled_allocations",
+      "Sends the queued allocation samples to the VMObjectAlloc callback of this jvmtiEnv on the"
+      " current thread. The thread argument of each event is the allocating thread. If fewer than"
+      " a batch of samples is queued, waits for up to timeout_ms milliseconds for more samples"
+      " first. Returns the number of samples delivered.",
+      {
+          { "timeout_ms", JVMTI_KIND_IN, JVMTI_TYPE_JLONG, false },
+          { "delivered_count", JVMTI_KIND_OUT, JVMTI_TYPE_JINT, false },
+      },
+      { ERR(NULL_POINTER), ERR(UNATTACHED_THREAD) });
+  if (error != ERR(NONE)) {
+    return error;
+  }
+
+  error = add_extension(
+      reinterpret_cast<jvmtiExtensionFunction>(MethodUtil::SetCompiledInvocationCounting),
+      "com.android.art.method.set_compiled_invocation_counting",
+      "Sets whether the JIT compiles an invocation counter into the code it generates. This"
+      " allows counting calls or collecting coverage while methods keep running compiled code,"
+      " which is much cheaper than MethodEntry events. Enabling discards the code compiled"
+      " without counters. Invocations of methods that are interpreted, that have no JIT code or"
+      " that are inlined are not counted. The counts are read with"
+      " com.android.art.method.get_compiled_invocation_count.",
+      {
+          { "enable", JVMTI_KIND_IN, JVMTI_TYPE_JBOOLEAN, false },
+      },
+      {});
+  if (error != ERR(NONE)) {
+    return error;
+  }
+
+  error = add_extension(
+      reinterpret_cast<jvmtiExtensionFunction>(MethodUtil::GetCompiledInvocationCount),
+      "com.android.art.method.get_compiled_invocation_count",
+      "Returns how many times the JIT compiled code of a method was invoked while compiled"
+      " invocation counting was enabled. Concurrent invocations might not all be counted.",
+      {
+          { "method", JVMTI_KIND_IN, JVMTI_TYPE_JMETHODID, false },
+          { "count", JVMTI_KIND_OUT, JVMTI_TYPE_JLONG, false },
+      },
+      { ERR(INVALID_METHODID), ERR(NULL_POINTER) });
+  if (error != ERR(NONE)) {
+    return error;
+  }
+
   // DDMS extension
   error = add_extension(
       reinterpret_cast<jvmtiExtensionFunction>(DDMSUtil::HandleChunk),
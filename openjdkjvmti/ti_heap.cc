@@ -16,8 +16,12 @@
 
 #include "ti_heap.h"
 
+#include <algorithm>
+#include <atomic>
 #include <ios>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "android-base/logging.h"
 #include "android-base/thread_annotations.h"
@@ -63,6 +67,7 @@
 #include "stack.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 #include "ti_logging.h"
 #include "ti_stack.h"
 #include "ti_thread.h"
@@ -90,9 +95,10 @@ using IndexCachingTable = JvmtiWeakTable<IndexCache>;
 static IndexCachingTable gIndexCachingTable;
 
 // Report the contents of a string, if a callback is set.
+template <typename TagTable>
 jint ReportString(art::ObjPtr<art::mirror::Object> obj,
                   jvmtiEnv* env,
-                  ObjectTagTable* tag_table,
+                  TagTable* tag_table,
                   const jvmtiHeapCallbacks* cb,
                   const void* user_data) REQUIRES_SHARED(art::Locks::mutator_lock_) {
   if (UNLIKELY(cb->string_primitive_value_callback != nullptr) && obj->IsString()) {
@@ -142,9 +148,10 @@ jint ReportString(art::ObjPtr<art::mirror::Object> obj,
 }
 
 // Report the contents of a primitive array, if a callback is set.
+template <typename TagTable>
 jint ReportPrimitiveArray(art::ObjPtr<art::mirror::Object> obj,
                           jvmtiEnv* env,
-                          ObjectTagTable* tag_table,
+                          TagTable* tag_table,
                           const jvmtiHeapCallbacks* cb,
                           const void* user_data) REQUIRES_SHARED(art::Locks::mutator_lock_) {
   if (UNLIKELY(cb->array_primitive_value_callback != nullptr) &&
@@ -509,10 +516,11 @@ struct DumpVisitor {
   }
 }
 
+template <typename TagTable>
 class ReportPrimitiveField {
  public:
   static bool Report(art::ObjPtr<art::mirror::Object> obj,
-                     ObjectTagTable* tag_table,
+                     TagTable* tag_table,
                      const jvmtiHeapCallbacks* cb,
                      const void* user_data)
       REQUIRES_SHARED(art::Locks::mutator_lock_) {
@@ -542,7 +550,7 @@ class ReportPrimitiveField {
 
 
  private:
-  ReportPrimitiveField(ObjectTagTable* tag_table,
+  ReportPrimitiveField(TagTable* tag_table,
                        jlong class_tag,
                        const jvmtiHeapCallbacks* cb,
                        const void* user_data)
@@ -628,7 +636,7 @@ class ReportPrimitiveField {
     return false;
   }
 
-  ObjectTagTable* tag_table_;
+  TagTable* tag_table_;
   jlong class_tag_;
   const jvmtiHeapCallbacks* cb_;
   const void* user_data_;
@@ -739,6 +747,65 @@ jvmtiError HeapUtil::IterateOverInstancesOfClass(jvmtiEnv* env,
   return OK;
 }
 
+// Reports a single object of a heap iteration. Returns true if the iteration should stop.
+template <typename T, typename TagTable>
+static bool ReportHeapIterationObject(T fn,
+                                      art::mirror::Object* obj,
+                                      jvmtiEnv* env,
+                                      TagTable* tag_table,
+                                      const HeapFilter& heap_filter,
+                                      art::ObjPtr<art::mirror::Class> filter_klass,
+                                      const jvmtiHeapCallbacks* callbacks,
+                                      const void* user_data)
+    REQUIRES_SHARED(art::Locks::mutator_lock_) {
+  jlong tag = tag_table->GetTagOrZero(obj);
+
+  art::ObjPtr<art::mirror::Class> klass = obj->GetClass();
+  jlong class_tag = tag_table->GetTagOrZero(klass.Ptr());
+  // For simplicity, even if we find a tag = 0, assume 0 = not tagged.
+
+  if (!heap_filter.ShouldReportByHeapFilter(tag, class_tag)) {
+    return false;
+  }
+
+  if (filter_klass != nullptr) {
+    if (filter_klass != klass) {
+      return false;
+    }
+  }
+
+  jlong size = obj->SizeOf();
+
+  jint length = -1;
+  if (obj->IsArrayInstance()) {
+    length = obj->AsArray()->GetLength();
+  }
+
+  jlong saved_tag = tag;
+  jint ret = fn(obj, callbacks, class_tag, size, &tag, length, const_cast<void*>(user_data));
+
+  if (tag != saved_tag) {
+    tag_table->Set(obj, tag);
+  }
+
+  bool stop_reports = (ret & JVMTI_VISIT_ABORT) != 0;
+
+  if (!stop_reports) {
+    jint string_ret = ReportString(obj, env, tag_table, callbacks, user_data);
+    stop_reports = (string_ret & JVMTI_VISIT_ABORT) != 0;
+  }
+
+  if (!stop_reports) {
+    jint array_ret = ReportPrimitiveArray(obj, env, tag_table, callbacks, user_data);
+    stop_reports = (array_ret & JVMTI_VISIT_ABORT) != 0;
+  }
+
+  if (!stop_reports) {
+    stop_reports = ReportPrimitiveField<TagTable>::Report(obj, tag_table, callbacks, user_data);
+  }
+  return stop_reports;
+}
+
 template <typename T>
 static jvmtiError DoIterateThroughHeap(T fn,
                                        jvmtiEnv* env,
@@ -766,53 +833,8 @@ static jvmtiError DoIterateThroughHeap(T fn,
 
     art::ScopedAssertNoThreadSuspension no_suspension("IterateThroughHeapCallback");
 
-    jlong tag = 0;
-    tag_table->GetTag(obj, &tag);
-
-    jlong class_tag = 0;
-    art::ObjPtr<art::mirror::Class> klass = obj->GetClass();
-    tag_table->GetTag(klass.Ptr(), &class_tag);
-    // For simplicity, even if we find a tag = 0, assume 0 = not tagged.
-
-    if (!heap_filter.ShouldReportByHeapFilter(tag, class_tag)) {
-      return;
-    }
-
-    if (filter_klass != nullptr) {
-      if (filter_klass.Get() != klass) {
-        return;
-      }
-    }
-
-    jlong size = obj->SizeOf();
-
-    jint length = -1;
-    if (obj->IsArrayInstance()) {
-      length = obj->AsArray()->GetLength();
-    }
-
-    jlong saved_tag = tag;
-    jint ret = fn(obj, callbacks, class_tag, size, &tag, length, const_cast<void*>(user_data));
-
-    if (tag != saved_tag) {
-      tag_table->Set(obj, tag);
-    }
-
-    stop_reports = (ret & JVMTI_VISIT_ABORT) != 0;
-
-    if (!stop_reports) {
-      jint string_ret = ReportString(obj, env, tag_table, callbacks, user_data);
-      stop_reports = (string_ret & JVMTI_VISIT_ABORT) != 0;
-    }
-
-    if (!stop_reports) {
-      jint array_ret = ReportPrimitiveArray(obj, env, tag_table, callbacks, user_data);
-      stop_reports = (array_ret & JVMTI_VISIT_ABORT) != 0;
-    }
-
-    if (!stop_reports) {
-      stop_reports = ReportPrimitiveField::Report(obj, tag_table, callbacks, user_data);
-    }
+    stop_reports = ReportHeapIterationObject(
+        fn, obj, env, tag_table, heap_filter, filter_klass.Get(), callbacks, user_data);
   };
   art::Runtime::Current()->GetHeap()->VisitObjects(visitor);
 
@@ -1156,7 +1178,8 @@ class FollowReferencesHelper final {
       return;
     }
 
-    stop_reports_ = ReportPrimitiveField::Report(obj, tag_table_, callbacks_, user_data_);
+    stop_reports_ =
+        ReportPrimitiveField<ObjectTagTable>::Report(obj, tag_table_, callbacks_, user_data_);
   }
 
   void VisitArray(art::mirror::Object* array)
@@ -1279,7 +1302,8 @@ class FollowReferencesHelper final {
       return;
     }
 
-    stop_reports_ = ReportPrimitiveField::Report(klass, tag_table_, callbacks_, user_data_);
+    stop_reports_ =
+        ReportPrimitiveField<ObjectTagTable>::Report(klass, tag_table_, callbacks_, user_data_);
   }
 
   void MaybeEnqueue(art::mirror::Object* obj) REQUIRES_SHARED(art::Locks::mutator_lock_) {
@@ -1585,6 +1609,21 @@ jvmtiError HeapExtensions::GetHeapName(jvmtiEnv* env, jint heap_id, char** heap_
   }
 }
 
+// ART extension API: Also pass the heap id.
+static jint ArtIterateHeap(art::mirror::Object* obj,
+                           const jvmtiHeapCallbacks* cb_callbacks,
+                           jlong class_tag,
+                           jlong size,
+                           jlong* tag,
+                           jint length,
+                           void* cb_user_data)
+    REQUIRES_SHARED(art::Locks::mutator_lock_) {
+  jint heap_id = GetHeapId(obj);
+  using ArtExtensionAPI = jint (*)(jlong, jlong, jlong*, jint length, void*, jint);
+  return reinterpret_cast<ArtExtensionAPI>(cb_callbacks->heap_iteration_callback)(
+      class_tag, size, tag, length, cb_user_data, heap_id);
+}
+
 jvmtiError HeapExtensions::IterateThroughHeapExt(jvmtiEnv* env,
                                                  jint heap_filter,
                                                  jclass klass,
@@ -1594,20 +1633,6 @@ jvmtiError HeapExtensions::IterateThroughHeapExt(jvmtiEnv* env,
     return ERR(MUST_POSSESS_CAPABILITY); \
   }
 
-  // ART extension API: Also pass the heap id.
-  auto ArtIterateHeap = [](art::mirror::Object* obj,
-                           const jvmtiHeapCallbacks* cb_callbacks,
-                           jlong class_tag,
-                           jlong size,
-                           jlong* tag,
-                           jint length,
-                           void* cb_user_data)
-      REQUIRES_SHARED(art::Locks::mutator_lock_) {
-    jint heap_id = GetHeapId(obj);
-    using ArtExtensionAPI = jint (*)(jlong, jlong, jlong*, jint length, void*, jint);
-    return reinterpret_cast<ArtExtensionAPI>(cb_callbacks->heap_iteration_callback)(
-        class_tag, size, tag, length, cb_user_data, heap_id);
-  };
   return DoIterateThroughHeap(ArtIterateHeap,
                               env,
                               ArtJvmTiEnv::AsArtJvmTiEnv(env)->object_tag_table.get(),
@@ -1619,6 +1644,169 @@ jvmtiError HeapExtensions::IterateThroughHeapExt(jvmtiEnv* env,
 
 namespace {
 
+// The tags seen by one thread of a parallel heap iteration. Tags are read from the table without
+// locking, and the tags set by the callbacks are only written to the table once all threads are
+// done, so that the table does not change while it is being read.
+class ParallelHeapIterationTags {
+ public:
+  explicit ParallelHeapIterationTags(ObjectTagTable* tag_table) : tag_table_(tag_table) {}
+
+  jlong GetTagOrZero(art::ObjPtr<art::mirror::Object> obj) const
+      REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    auto it = updated_tags_.find(obj.Ptr());
+    if (it != updated_tags_.end()) {
+      return it->second;
+    }
+    jlong tag = 0;
+    tag_table_->GetTagUnsynchronized(obj, &tag);
+    return tag;
+  }
+
+  void Set(art::ObjPtr<art::mirror::Object> obj, jlong tag)
+      REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    updated_tags_[obj.Ptr()] = tag;
+  }
+
+  // Write the tags set by the callbacks to the table.
+  void Apply()
+      REQUIRES_SHARED(art::Locks::mutator_lock_)
+      REQUIRES(!*tag_table_->GetAllowDisallowLock()) {
+    for (const auto& [obj, tag] : updated_tags_) {
+      tag_table_->Set(obj, tag);
+    }
+  }
+
+ private:
+  ObjectTagTable* const tag_table_;
+  std::unordered_map<art::mirror::Object*, jlong> updated_tags_;
+};
+
+struct ParallelHeapIterationState {
+  ParallelHeapIterationState(jvmtiEnv* e,
+                             jint heap_filter_int,
+                             const jvmtiHeapCallbacks* cb,
+                             const void* data)
+      : env(e), heap_filter(heap_filter_int), callbacks(cb), user_data(data) {}
+
+  jvmtiEnv* const env;
+  const HeapFilter heap_filter;
+  // Raw pointer, as object pointers must not be shared between threads.
+  art::mirror::Class* filter_klass = nullptr;
+  const jvmtiHeapCallbacks* const callbacks;
+  const void* const user_data;
+
+  std::vector<art::mirror::Object*> objects;
+  std::atomic<size_t> next_object = 0;
+  std::atomic<bool> stop_reports = false;
+};
+
+class ParallelHeapIterationTask final : public art::SelfDeletingTask {
+ public:
+  ParallelHeapIterationTask(ParallelHeapIterationState* state, ParallelHeapIterationTags* tags)
+      : state_(state), tags_(tags) {}
+
+  // The thread that started the iteration holds the mutator lock exclusively for us.
+  void Run([[maybe_unused]] art::Thread* self) override NO_THREAD_SAFETY_ANALYSIS {
+    art::ScopedAssertNoThreadSuspension no_suspension("ParallelHeapIterationTask");
+    const size_t num_objects = state_->objects.size();
+    while (!state_->stop_reports.load(std::memory_order_relaxed)) {
+      size_t begin = state_->next_object.fetch_add(kChunkSize, std::memory_order_relaxed);
+      if (begin >= num_objects) {
+        break;
+      }
+      size_t end = std::min(begin + kChunkSize, num_objects);
+      for (size_t i = begin; i != end; ++i) {
+        if (ReportHeapIterationObject(ArtIterateHeap,
+                                      state_->objects[i],
+                                      state_->env,
+                                      tags_,
+                                      state_->heap_filter,
+                                      state_->filter_klass,
+                                      state_->callbacks,
+                                      state_->user_data)) {
+          state_->stop_reports.store(true, std::memory_order_relaxed);
+          break;
+        }
+      }
+    }
+  }
+
+ private:
+  // Number of objects a thread takes at a time.
+  static constexpr size_t kChunkSize = 1024;
+
+  ParallelHeapIterationState* const state_;
+  ParallelHeapIterationTags* const tags_;
+};
+
+}  // namespace
+
+jvmtiError HeapExtensions::IterateThroughHeapParallel(jvmtiEnv* env,
+                                                      jint heap_filter,
+                                                      jclass klass,
+                                                      const jvmtiHeapCallbacks* callbacks,
+                                                      const void* user_data) {
+  if (ArtJvmTiEnv::AsArtJvmTiEnv(env)->capabilities.can_tag_objects != 1) {
+    return ERR(MUST_POSSESS_CAPABILITY);
+  }
+  if (callbacks == nullptr) {
+    return ERR(NULL_POINTER);
+  }
+
+  art::Thread* self = art::Thread::Current();
+  ObjectTagTable* tag_table = ArtJvmTiEnv::AsArtJvmTiEnv(env)->object_tag_table.get();
+
+  // The calling thread also takes part in the iteration. Create the workers before suspending
+  // all threads, as they cannot attach to the runtime while threads are suspended.
+  const size_t num_workers = std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+  std::unique_ptr<art::ThreadPool> thread_pool(
+      art::ThreadPool::Create("JVMTI heap iteration thread pool", num_workers));
+
+  art::gc::Heap* heap = art::Runtime::Current()->GetHeap();
+  if (heap->IsGcConcurrentAndMoving()) {
+    // See the comment in Heap::VisitObjects().
+    heap->IncrementDisableMovingGC(self);
+  }
+  {
+    art::ScopedObjectAccess soa(self);
+    art::StackHandleScope<1> hs(self);
+    art::Handle<art::mirror::Class> filter_klass(
+        hs.NewHandle(soa.Decode<art::mirror::Class>(klass)));
+
+    // No GC may run during the iteration, as the workers read the tag table without locking.
+    art::ScopedThreadSuspension sts(self, art::ThreadState::kWaitingForVisitObjects);
+    art::gc::ScopedGCCriticalSection sgccs(
+        self, art::gc::GcCause::kGcCauseDebugger, art::gc::CollectorType::kCollectorTypeDebugger);
+    art::ScopedSuspendAll ssa("IterateThroughHeapParallel");
+
+    ParallelHeapIterationState state(env, heap_filter, callbacks, user_data);
+    state.filter_klass = filter_klass.Get();
+    heap->VisitObjectsPaused([&](art::mirror::Object* obj) {
+      state.objects.push_back(obj);
+    });
+
+    std::vector<ParallelHeapIterationTags> tags(num_workers + 1,
+                                                ParallelHeapIterationTags(tag_table));
+    for (ParallelHeapIterationTags& thread_tags : tags) {
+      thread_pool->AddTask(self, new ParallelHeapIterationTask(&state, &thread_tags));
+    }
+    thread_pool->StartWorkers(self);
+    thread_pool->Wait(self, /* do_work= */ true, /* may_hold_locks= */ true);
+    thread_pool->StopWorkers(self);
+
+    for (ParallelHeapIterationTags& thread_tags : tags) {
+      thread_tags.Apply();
+    }
+  }
+  if (heap->IsGcConcurrentAndMoving()) {
+    heap->DecrementDisableMovingGC(self);
+  }
+
+  return ERR(NONE);
+}
+
+namespace {
+
 using ObjectPtr = art::ObjPtr<art::mirror::Object>;
 using ObjectMap = std::unordered_map<ObjectPtr, ObjectPtr, art::HashObjPtr>;
 
@@ -89,6 +89,12 @@ class HeapExtensions {
                                                   const jvmtiHeapCallbacks* callbacks,
                                                   const void* user_data);
 
+  static jvmtiError JNICALL IterateThroughHeapParallel(jvmtiEnv* env,
+                                                       jint heap_filter,
+                                                       jclass klass,
+                                                       const jvmtiHeapCallbacks* callbacks,
+                                                       const void* user_data);
+
   static jvmtiError JNICALL ChangeArraySize(jvmtiEnv* env, jobject arr, jsize new_size);
 
   static void ReplaceReferences(
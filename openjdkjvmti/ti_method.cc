@@ -55,7 +55,10 @@
 #include "events-inl.h"
 #include "gc_root-inl.h"
 #include "handle.h"
+#include "instrumentation.h"
 #include "jit/jit.h"
+#include "jit/jit_code_cache.h"
+#include "jit/profiling_info.h"
 #include "jni/jni_internal.h"
 #include "jvmti.h"
 #include "mirror/class-inl.h"
@@ -197,6 +200,35 @@ jvmtiError MethodUtil::GetArgumentsSize([[maybe_unused]] jvmtiEnv* env,
   return ERR(NONE);
 }
 
+jvmtiError MethodUtil::SetCompiledInvocationCounting([[maybe_unused]] jvmtiEnv* env,
+                                                     jboolean enable) {
+  art::ScopedThreadStateChange stsc(art::Thread::Current(), art::ThreadState::kSuspended);
+  // Make sure that no compilation started before is committed without counters.
+  art::jit::ScopedJitSuspend suspend_jit;
+  art::ScopedSuspendAll ssa(__FUNCTION__);
+  art::Runtime::Current()->GetInstrumentation()->SetCountInvocationsInCompiledCode(enable);
+  return ERR(NONE);
+}
+
+jvmtiError MethodUtil::GetCompiledInvocationCount([[maybe_unused]] jvmtiEnv* env,
+                                                  jmethodID method,
+                                                  jlong* count_ptr) {
+  if (method == nullptr) {
+    return ERR(INVALID_METHODID);
+  }
+  if (count_ptr == nullptr) {
+    return ERR(NULL_POINTER);
+  }
+  art::ArtMethod* art_method = art::jni::DecodeArtMethod(method);
+  art::jit::Jit* jit = art::Runtime::Current()->GetJit();
+  art::ScopedObjectAccess soa(art::Thread::Current());
+  art::ProfilingInfo* info = (jit != nullptr && !art_method->IsNative())
+      ? jit->GetCodeCache()->GetProfilingInfo(art_method, soa.Self())
+      : nullptr;
+  *count_ptr = (info != nullptr) ? static_cast<jlong>(info->GetInvocationCount()) : 0;
+  return ERR(NONE);
+}
+
 jvmtiError MethodUtil::GetLocalVariableTable(jvmtiEnv* env,
                                              jmethodID method,
                                              jint* entry_count_ptr,
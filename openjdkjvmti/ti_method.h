@@ -94,6 +94,11 @@ class MethodUtil {
 
   static jvmtiError GetLocalInstance(jvmtiEnv* env, jthread thread, jint depth, jobject* data);
 
+  // Extension functions to count the invocations of JIT compiled code without method entry
+  // events, see art::instrumentation::Instrumentation::SetCountInvocationsInCompiledCode.
+  static jvmtiError SetCompiledInvocationCounting(jvmtiEnv* env, jboolean enable);
+  static jvmtiError GetCompiledInvocationCount(jvmtiEnv* env, jmethodID method, jlong* count_ptr);
+
  private:
   static jvmtiError SetLocalVariableGeneric(jvmtiEnv* env,
                                             jthread thread,
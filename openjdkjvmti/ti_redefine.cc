@@ -38,6 +38,7 @@
 #include <sstream>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
@@ -119,6 +120,7 @@
 #include "runtime_globals.h"
 #include "scoped_thread_state_change.h"
 #include "stack.h"
+#include "stack_map_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 #include "ti_breakpoint.h"
@@ -2532,6 +2534,8 @@ jvmtiError Redefiner::Run() {
       redef.UpdateClass(data);
     }
     RestoreObsoleteMethodMapsIfUnneeded(holder);
+    // The catch handlers cached for exception delivery refer to the old dex code of the methods.
+    art::StackMapCache::InvalidateAll();
     // TODO We should check for if any of the redefined methods are intrinsic methods here and, if
     // any are, force a full-world deoptimization before finishing redefinition. If we don't do this
     // then methods that have been jitted prior to the current redefinition being applied might
@@ -2970,10 +2974,17 @@ void Redefiner::ClassRedefinition::UpdateClassStructurally(const RedefinitionDat
 
   art::jit::Jit* jit = driver_->runtime_->GetJit();
   if (jit != nullptr) {
-    // Clear jit.
+    // Clear the jit code that depends on the layout or the methods of the redefined classes. The
+    // compiler records these dependencies for debuggable code, and does not inline when
+    // debuggable, so the rest of the code stays valid.
     // TODO We might want to have some way to tell the JIT not to wait the kJitSamplesBatchSize
     // invokes to start compiling things again.
-    jit->GetCodeCache()->InvalidateAllCompiledCode();
+    std::unordered_set<uint32_t> descriptor_hashes;
+    for (art::ObjPtr<art::mirror::Class> old_class : old_classes_vec) {
+      descriptor_hashes.insert(old_class->DescriptorHash());
+    }
+    size_t invalidated = jit->GetCodeCache()->InvalidateCompiledCodeDependingOn(descriptor_hashes);
+    VLOG(plugin) << "Invalidated jit code of " << invalidated << " methods";
   }
 
   // Clear thread caches
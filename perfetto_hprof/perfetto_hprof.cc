@@ -31,9 +31,12 @@
 #include <thread>
 #include <time.h>
 
+#include <deque>
 #include <limits>
 #include <optional>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "android-base/file.h"
 #include "android-base/logging.h"
@@ -52,6 +55,9 @@
 #include "perfetto/trace/profiling/smaps.pbzero.h"
 #include "perfetto/config/profiling/java_hprof_config.pbzero.h"
 #include "perfetto/protozero/packed_repeated_fields.h"
+#include "perfetto/protozero/root_message.h"
+#include "perfetto/protozero/scattered_heap_buffer.h"
+#include "perfetto/protozero/scattered_stream_writer.h"
 #include "perfetto/tracing.h"
 #include "runtime-inl.h"
 #include "runtime_callbacks.h"
@@ -77,6 +83,12 @@ constexpr time_t kWatchdogTimeoutSec = 120;
 // submessages can be up to 100k here for a 500k chunk size.
 // DropBox has a 500k chunk limit, and each chunk needs to parse as a proto.
 constexpr uint32_t kPacketSizeThreshold = 400000;
+// Upper bound of the number of threads encoding objects, see DumpOptions.
+constexpr uint32_t kMaxDumpThreads = 8;
+// Number of objects handed to a thread encoding objects at a time.
+constexpr size_t kDumpBatchSize = 4096;
+// Default number of instances above which the instances of a class are sampled.
+constexpr uint32_t kDefaultSampleMinInstances = 10000;
 constexpr char kByte[1] = {'x'};
 static art::Mutex& GetStateMutex() {
   static art::Mutex state_mutex("perfetto_hprof_state_mutex", art::LockLevel::kGenericBottomLock);
@@ -343,27 +355,49 @@ bool TimedWaitForDataSource(art::Thread* self, int64_t timeout_ms) {
   return true;
 }
 
-// Helper class to write Java heap dumps to `ctx`. The whole heap dump can be
-// split into more perfetto.protos.HeapGraph messages, to avoid making each
-// message too big.
-class Writer {
+// Destination of perfetto.protos.HeapGraph messages. The whole heap dump can
+// be split into more messages, to avoid making each message too big.
+class HeapGraphWriter {
+ public:
+  virtual ~HeapGraphWriter() {}
+
+  // Return whether the next call to GetHeapGraph will create a new message.
+  virtual bool will_create_new_packet() const = 0;
+
+  // Return the index of the message returned by the last call to GetHeapGraph.
+  virtual uint64_t packet_index() const = 0;
+
+  virtual perfetto::protos::pbzero::HeapGraph* GetHeapGraph() = 0;
+};
+
+// Helper class to write Java heap dumps to `ctx`, one perfetto.protos.HeapGraph
+// message per TracePacket.
+class Writer : public HeapGraphWriter {
  public:
   Writer(pid_t pid, JavaHprofDataSource::TraceContext* ctx, uint64_t timestamp)
       : pid_(pid), ctx_(ctx), timestamp_(timestamp),
         last_written_(ctx_->written()) {}
 
-  // Return whether the next call to GetHeapGraph will create a new TracePacket.
-  bool will_create_new_packet() const {
+  bool will_create_new_packet() const override {
     return !heap_graph_ || ctx_->written() - last_written_ > kPacketSizeThreshold;
   }
 
-  perfetto::protos::pbzero::HeapGraph* GetHeapGraph() {
+  uint64_t packet_index() const override { return index_; }
+
+  perfetto::protos::pbzero::HeapGraph* GetHeapGraph() override {
     if (will_create_new_packet()) {
       CreateNewHeapGraph();
     }
     return heap_graph_;
   }
 
+  // Writes `chunk`, a serialized perfetto.protos.HeapGraph without pid and
+  // index, to a new TracePacket.
+  void WriteChunk(const std::vector<uint8_t>& chunk) {
+    CreateNewHeapGraph();
+    heap_graph_->AppendRawProtoBytes(chunk.data(), chunk.size());
+  }
+
   void Finalize() {
     if (trace_packet_) {
       trace_packet_->Finalize();
@@ -371,7 +405,7 @@ class Writer {
     heap_graph_ = nullptr;
   }
 
-  ~Writer() { Finalize(); }
+  ~Writer() override { Finalize(); }
 
  private:
   Writer(const Writer&) = delete;
@@ -645,62 +679,54 @@ uint64_t EncodeBaseObjId(
   return base_obj_id;
 }
 
-// Helper to keep intermediate state while dumping objects and classes from ART into
-// perfetto.protos.HeapGraph.
-class HeapGraphDumper {
- public:
-  // Instances of classes whose name is in `ignored_types` will be ignored.
-  explicit HeapGraphDumper(const std::vector<std::string>& ignored_types)
-      : ignored_types_(ignored_types),
-        reference_field_ids_(std::make_unique<protozero::PackedVarInt>()),
-        reference_object_ids_(std::make_unique<protozero::PackedVarInt>()) {}
-
-  // Dumps a heap graph from `*runtime` and writes it to `writer`.
-  void Dump(art::Runtime* runtime, Writer& writer) REQUIRES(art::Locks::mutator_lock_) {
-    DumpRootObjects(runtime, writer);
+// Options of a heap dump that are not part of JavaHprofConfig. They are read from system
+// properties in the forked child.
+struct DumpOptions {
+  // Number of threads encoding objects. With a single thread, objects are encoded by the thread
+  // visiting the heap.
+  uint32_t num_threads = 1;
+  // If greater than one, only about one in `sample_interval` instances of classes with at least
+  // `sample_min_instances` instances are dumped.
+  uint32_t sample_interval = 0;
+  uint32_t sample_min_instances = 0;
+};
 
-    DumpObjects(runtime, writer);
+DumpOptions ReadDumpOptions() {
+  DumpOptions options;
+  options.num_threads = std::max(
+      1u,
+      android::base::GetUintProperty<uint32_t>(
+          "dalvik.vm.perfetto_hprof.dump_threads", 1u, kMaxDumpThreads));
+  options.sample_interval =
+      android::base::GetUintProperty<uint32_t>("dalvik.vm.perfetto_hprof.sample_interval", 0u);
+  options.sample_min_instances = android::base::GetUintProperty<uint32_t>(
+      "dalvik.vm.perfetto_hprof.sample_min_instances", kDefaultSampleMinInstances);
+  return options;
+}
 
-    WriteInternedData(writer);
+// Interned ids of a heap dump. When objects are dumped on several threads, they all share the
+// same `Interner` so that ids are consistent across the whole dump.
+class Interner {
+ public:
+  uint64_t ClassId(uintptr_t class_ptr) {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+    return FindOrAppend(&interned_classes_, class_ptr);
   }
 
- private:
-  // Dumps the root objects from `*runtime` to `writer`.
-  void DumpRootObjects(art::Runtime* runtime, Writer& writer)
-      REQUIRES_SHARED(art::Locks::mutator_lock_) {
-    std::map<art::RootType, std::vector<art::mirror::Object*>> root_objects;
-    RootFinder rcf(&root_objects);
-    runtime->VisitRoots(&rcf);
-    std::unique_ptr<protozero::PackedVarInt> object_ids(new protozero::PackedVarInt);
-    for (const auto& p : root_objects) {
-      const art::RootType root_type = p.first;
-      const std::vector<art::mirror::Object*>& children = p.second;
-      perfetto::protos::pbzero::HeapGraphRoot* root_proto = writer.GetHeapGraph()->add_roots();
-      root_proto->set_root_type(ToProtoType(root_type));
-      for (art::mirror::Object* obj : children) {
-        if (writer.will_create_new_packet()) {
-          root_proto->set_object_ids(*object_ids);
-          object_ids->Reset();
-          root_proto = writer.GetHeapGraph()->add_roots();
-          root_proto->set_root_type(ToProtoType(root_type));
-        }
-        object_ids->Append(GetObjectId(obj));
-      }
-      root_proto->set_object_ids(*object_ids);
-      object_ids->Reset();
-    }
+  uint64_t FieldId(const std::string& name) {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+    return FindOrAppend(&interned_fields_, name);
   }
 
-  // Dumps all the objects from `*runtime` to `writer`.
-  void DumpObjects(art::Runtime* runtime, Writer& writer) REQUIRES(art::Locks::mutator_lock_) {
-    runtime->GetHeap()->VisitObjectsPaused(
-        [this, &writer](art::mirror::Object* obj)
-            REQUIRES_SHARED(art::Locks::mutator_lock_) { WriteOneObject(obj, writer); });
+  uint64_t LocationId(const std::string& name) {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+    return FindOrAppend(&interned_locations_, name);
   }
 
   // Writes all the previously accumulated (while dumping objects and roots) interned data to
   // `writer`.
   void WriteInternedData(Writer& writer) {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
     for (const auto& p : interned_locations_) {
       const std::string& str = p.first;
       uint64_t id = p.second;
@@ -721,8 +747,116 @@ class HeapGraphDumper {
     }
   }
 
+ private:
+  art::Mutex lock_{"perfetto_hprof_interner_mutex", art::LockLevel::kGenericBottomLock};
+
+  // Make sure that intern ID 0 (default proto value for a uint64_t) always maps to ""
+  // (default proto value for a string) or to 0 (default proto value for a uint64).
+
+  // Map from string (the field name) to its index in perfetto.protos.HeapGraph.field_names
+  std::map<std::string, uint64_t> interned_fields_ GUARDED_BY(lock_) = {{"", 0}};
+  // Map from string (the location name) to its index in perfetto.protos.HeapGraph.location_names
+  std::map<std::string, uint64_t> interned_locations_ GUARDED_BY(lock_) = {{"", 0}};
+  // Map from addr (the class pointer) to its id in perfetto.protos.HeapGraph.types
+  std::map<uintptr_t, uint64_t> interned_classes_ GUARDED_BY(lock_) = {{0, 0}};
+};
+
+// Decides which objects are left out of a sampled heap dump. Only about one in `interval`
+// instances of classes with at least `min_instances` instances are kept, so that the few classes
+// with millions of instances do not dominate the size and duration of the dump. References to
+// the objects that are left out are dumped as null, like references to ignored types.
+class ObjectSampler {
+ public:
+  ObjectSampler(uint32_t interval, uint32_t min_instances)
+      : interval_(interval), min_instances_(min_instances) {}
+
+  // Finds the classes whose instances are sampled.
+  void CountInstances(art::Runtime* runtime) REQUIRES(art::Locks::mutator_lock_) {
+    std::unordered_map<art::mirror::Class*, uint32_t> instance_counts;
+    runtime->GetHeap()->VisitObjectsPaused(
+        [&instance_counts](art::mirror::Object* obj) REQUIRES_SHARED(art::Locks::mutator_lock_) {
+          if (!obj->IsClass()) {
+            ++instance_counts[obj->GetClass()];
+          }
+        });
+    for (const auto& [klass, count] : instance_counts) {
+      if (count >= min_instances_) {
+        sampled_classes_.insert(klass);
+      }
+    }
+  }
+
+  // Returns true if `*obj` is left out of the dump. The decision only depends on the address of
+  // the object, so that all the references to it agree.
+  bool IsSampledOut(art::mirror::Object* obj) const REQUIRES_SHARED(art::Locks::mutator_lock_) {
+    if (obj->IsClass() || sampled_classes_.find(obj->GetClass()) == sampled_classes_.end()) {
+      return false;
+    }
+    // Objects of the same class are often allocated at a fixed stride, so hash the id to avoid
+    // keeping all or none of them.
+    uint64_t hash = GetObjectId(obj) * UINT64_C(0x9e3779b97f4a7c15);
+    return (hash >> 32) % interval_ != 0;
+  }
+
+  size_t GetNumberOfSampledClasses() const { return sampled_classes_.size(); }
+
+ private:
+  const uint32_t interval_;
+  const uint32_t min_instances_;
+  std::unordered_set<art::mirror::Class*> sampled_classes_;
+};
+
+// Dumps the root objects from `*runtime` to `writer`.
+void DumpRootObjects(art::Runtime* runtime, Writer& writer)
+    REQUIRES_SHARED(art::Locks::mutator_lock_) {
+  std::map<art::RootType, std::vector<art::mirror::Object*>> root_objects;
+  RootFinder rcf(&root_objects);
+  runtime->VisitRoots(&rcf);
+  std::unique_ptr<protozero::PackedVarInt> object_ids(new protozero::PackedVarInt);
+  for (const auto& p : root_objects) {
+    const art::RootType root_type = p.first;
+    const std::vector<art::mirror::Object*>& children = p.second;
+    perfetto::protos::pbzero::HeapGraphRoot* root_proto = writer.GetHeapGraph()->add_roots();
+    root_proto->set_root_type(ToProtoType(root_type));
+    for (art::mirror::Object* obj : children) {
+      if (writer.will_create_new_packet()) {
+        root_proto->set_object_ids(*object_ids);
+        object_ids->Reset();
+        root_proto = writer.GetHeapGraph()->add_roots();
+        root_proto->set_root_type(ToProtoType(root_type));
+      }
+      object_ids->Append(GetObjectId(obj));
+    }
+    root_proto->set_object_ids(*object_ids);
+    object_ids->Reset();
+  }
+}
+
+// Helper to keep intermediate state while dumping objects and classes from ART into
+// perfetto.protos.HeapGraph.
+class HeapGraphDumper {
+ public:
+  // Instances of classes whose name is in `ignored_types`, and instances left out by `sampler`
+  // if not null, will be ignored.
+  HeapGraphDumper(const std::vector<std::string>& ignored_types,
+                  Interner* interner,
+                  const ObjectSampler* sampler)
+      : ignored_types_(ignored_types),
+        interner_(interner),
+        sampler_(sampler),
+        reference_field_ids_(std::make_unique<protozero::PackedVarInt>()),
+        reference_object_ids_(std::make_unique<protozero::PackedVarInt>()) {}
+
+  // Dumps all the objects from `*runtime` to `writer`.
+  void DumpObjects(art::Runtime* runtime, HeapGraphWriter& writer)
+      REQUIRES(art::Locks::mutator_lock_) {
+    runtime->GetHeap()->VisitObjectsPaused(
+        [this, &writer](art::mirror::Object* obj)
+            REQUIRES_SHARED(art::Locks::mutator_lock_) { WriteOneObject(obj, writer); });
+  }
+
   // Writes `*obj` into `writer`.
-  void WriteOneObject(art::mirror::Object* obj, Writer& writer)
+  void WriteOneObject(art::mirror::Object* obj, HeapGraphWriter& writer)
       REQUIRES_SHARED(art::Locks::mutator_lock_) {
     if (obj->IsClass()) {
       WriteClass(obj->AsClass().Ptr(), writer);
@@ -741,16 +875,20 @@ class HeapGraphDumper {
       return;
     }
 
-    auto class_id = FindOrAppend(&interned_classes_, class_ptr);
+    auto class_id = ClassId(class_ptr);
 
     uint64_t object_id = GetObjectId(obj);
     perfetto::protos::pbzero::HeapGraphObject* object_proto = writer.GetHeapGraph()->add_objects();
-    if (prev_object_id_ && prev_object_id_ < object_id) {
+    // Messages encoded on different threads may be written in any order, so only delta encode
+    // the ids of objects in the same message.
+    if (prev_object_id_ && prev_object_id_ < object_id &&
+        prev_object_packet_index_ == writer.packet_index()) {
       object_proto->set_id_delta(object_id - prev_object_id_);
     } else {
       object_proto->set_id(object_id);
     }
     prev_object_id_ = object_id;
+    prev_object_packet_index_ = writer.packet_index();
     object_proto->set_type_id(class_id);
 
     // Arrays / strings are magic and have an instance dependent size.
@@ -763,42 +901,65 @@ class HeapGraphDumper {
     FillFieldValues(obj, klass, object_proto);
   }
 
+ private:
+  // Returns the interned id of the class `class_ptr`, caching it to avoid contention on the
+  // shared interner.
+  uint64_t ClassId(uintptr_t class_ptr) {
+    auto it = class_ids_.find(class_ptr);
+    if (it != class_ids_.end()) {
+      return it->second;
+    }
+    uint64_t id = interner_->ClassId(class_ptr);
+    class_ids_.emplace(class_ptr, id);
+    return id;
+  }
+
+  // Returns the interned id of the field `name`, caching it like `ClassId()`.
+  uint64_t FieldId(const std::string& name) {
+    auto it = field_ids_.find(name);
+    if (it != field_ids_.end()) {
+      return it->second;
+    }
+    uint64_t id = interner_->FieldId(name);
+    field_ids_.emplace(name, id);
+    return id;
+  }
+
   // Writes `*klass` into `writer`.
-  void WriteClass(art::mirror::Class* klass, Writer& writer)
+  void WriteClass(art::mirror::Class* klass, HeapGraphWriter& writer)
       REQUIRES_SHARED(art::Locks::mutator_lock_) {
     perfetto::protos::pbzero::HeapGraphType* type_proto = writer.GetHeapGraph()->add_types();
-    type_proto->set_id(FindOrAppend(&interned_classes_, reinterpret_cast<uintptr_t>(klass)));
+    type_proto->set_id(ClassId(reinterpret_cast<uintptr_t>(klass)));
     type_proto->set_class_name(PrettyType(klass));
-    type_proto->set_location_id(FindOrAppend(&interned_locations_, klass->GetLocation()));
+    type_proto->set_location_id(interner_->LocationId(klass->GetLocation()));
     type_proto->set_object_size(klass->GetObjectSize());
     type_proto->set_kind(ProtoClassKind(klass->GetClassFlags()));
     type_proto->set_classloader_id(GetObjectId(klass->GetClassLoader().Ptr()));
     if (klass->GetSuperClass().Ptr()) {
-      type_proto->set_superclass_id(FindOrAppend(
-          &interned_classes_, reinterpret_cast<uintptr_t>(klass->GetSuperClass().Ptr())));
+      type_proto->set_superclass_id(
+          ClassId(reinterpret_cast<uintptr_t>(klass->GetSuperClass().Ptr())));
     }
     ForInstanceReferenceField(
         klass, [klass, this](art::MemberOffset offset) NO_THREAD_SAFETY_ANALYSIS {
           auto art_field = art::ArtField::FindInstanceFieldWithOffset(klass, offset.Uint32Value());
-          reference_field_ids_->Append(
-              FindOrAppend(&interned_fields_, art_field->PrettyField(true)));
+          reference_field_ids_->Append(FieldId(art_field->PrettyField(true)));
         });
     type_proto->set_reference_field_id(*reference_field_ids_);
     reference_field_ids_->Reset();
   }
 
   // Creates a fake class that represents a type only used by `*obj` into `writer`.
-  uintptr_t WriteSyntheticClassFromObj(art::mirror::Object* obj, Writer& writer)
+  uintptr_t WriteSyntheticClassFromObj(art::mirror::Object* obj, HeapGraphWriter& writer)
       REQUIRES_SHARED(art::Locks::mutator_lock_) {
     CHECK(obj->IsClass());
     perfetto::protos::pbzero::HeapGraphType* type_proto = writer.GetHeapGraph()->add_types();
     // All pointers are at least multiples of two, so this way we can make sure
     // we are not colliding with a real class.
     uintptr_t class_ptr = reinterpret_cast<uintptr_t>(obj) | 1;
-    auto class_id = FindOrAppend(&interned_classes_, class_ptr);
+    auto class_id = ClassId(class_ptr);
     type_proto->set_id(class_id);
     type_proto->set_class_name(obj->PrettyTypeOf());
-    type_proto->set_location_id(FindOrAppend(&interned_locations_, obj->AsClass()->GetLocation()));
+    type_proto->set_location_id(interner_->LocationId(obj->AsClass()->GetLocation()));
     return class_ptr;
   }
 
@@ -825,7 +986,7 @@ class HeapGraphDumper {
       const std::string& field_name = p.first;
       art::mirror::Object* referred_obj = p.second;
       if (emit_field_ids) {
-        reference_field_ids_->Append(FindOrAppend(&interned_fields_, field_name));
+        reference_field_ids_->Append(FieldId(field_name));
       }
       uint64_t referred_obj_id = GetObjectId(referred_obj);
       if (referred_obj_id) {
@@ -897,6 +1058,12 @@ class HeapGraphDumper {
     if (obj->IsClass()) {
       return false;
     }
+    if (sampler_ != nullptr && sampler_->IsSampledOut(obj)) {
+      return true;
+    }
+    if (ignored_types_.empty()) {
+      return false;
+    }
     art::mirror::Class* klass = obj->GetClass();
     std::string temp;
     std::string_view name(klass->GetDescriptor(&temp));
@@ -906,24 +1073,252 @@ class HeapGraphDumper {
   // Name of classes whose instances should be ignored.
   const std::vector<std::string> ignored_types_;
 
-  // Make sure that intern ID 0 (default proto value for a uint64_t) always maps to ""
-  // (default proto value for a string) or to 0 (default proto value for a uint64).
+  Interner* const interner_;
+  const ObjectSampler* const sampler_;
 
-  // Map from string (the field name) to its index in perfetto.protos.HeapGraph.field_names
-  std::map<std::string, uint64_t> interned_fields_{{"", 0}};
-  // Map from string (the location name) to its index in perfetto.protos.HeapGraph.location_names
-  std::map<std::string, uint64_t> interned_locations_{{"", 0}};
-  // Map from addr (the class pointer) to its id in perfetto.protos.HeapGraph.types
-  std::map<uintptr_t, uint64_t> interned_classes_{{0, 0}};
+  // Ids already looked up in `*interner_`.
+  std::map<uintptr_t, uint64_t> class_ids_;
+  std::map<std::string, uint64_t> field_ids_;
 
   // Temporary buffers: used locally in some methods and then cleared.
   std::unique_ptr<protozero::PackedVarInt> reference_field_ids_;
   std::unique_ptr<protozero::PackedVarInt> reference_object_ids_;
 
-  // Id of the previous object that was dumped. Used for delta encoding.
+  // Id of the previous object that was dumped, and index of the message it was written to. Used
+  // for delta encoding.
   uint64_t prev_object_id_ = 0;
+  uint64_t prev_object_packet_index_ = 0;
+};
+
+// Queues used to dump objects on several threads. The thread visiting the heap pushes batches of
+// objects in heap order, so that batches follow the spaces and regions of the heap. Worker
+// threads encode each batch into serialized perfetto.protos.HeapGraph chunks. The visiting thread
+// writes the chunks to the trace whenever it pushes a batch, so that only a bounded number of
+// batches and chunks are kept in memory.
+class ParallelDumpQueues {
+ public:
+  explicit ParallelDumpQueues(size_t num_workers)
+      : max_pending_batches_(2 * num_workers), running_workers_(num_workers) {}
+
+  // Called by the visiting thread. Waits while too many batches are pending, writing chunks to
+  // `writer` in the meantime.
+  void PushBatch(std::vector<art::mirror::Object*>&& batch, Writer& writer) {
+    std::deque<std::vector<uint8_t>> chunks;
+    bool pushed = false;
+    while (!pushed) {
+      {
+        art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+        while (chunks_.empty() && batches_.size() >= max_pending_batches_) {
+          visitor_cond_.Wait(JavaHprofDataSource::art_thread());
+        }
+        chunks.swap(chunks_);
+        if (batches_.size() < max_pending_batches_) {
+          batches_.push_back(std::move(batch));
+          worker_cond_.Signal(JavaHprofDataSource::art_thread());
+          pushed = true;
+        }
+      }
+      WriteChunks(&chunks, writer);
+    }
+  }
+
+  // Called by the visiting thread once all batches have been pushed. Writes all the remaining
+  // chunks to `writer` and returns once all workers are done.
+  void Finish(Writer& writer) {
+    {
+      art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+      no_more_batches_ = true;
+      worker_cond_.Broadcast(JavaHprofDataSource::art_thread());
+    }
+    std::deque<std::vector<uint8_t>> chunks;
+    bool done = false;
+    while (!done) {
+      {
+        art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+        while (chunks_.empty() && running_workers_ != 0) {
+          visitor_cond_.Wait(JavaHprofDataSource::art_thread());
+        }
+        chunks.swap(chunks_);
+        done = running_workers_ == 0;
+      }
+      WriteChunks(&chunks, writer);
+    }
+  }
+
+  // Called by workers. Returns false once there are no more batches.
+  bool PopBatch(std::vector<art::mirror::Object*>* batch) {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+    while (batches_.empty() && !no_more_batches_) {
+      worker_cond_.Wait(JavaHprofDataSource::art_thread());
+    }
+    if (batches_.empty()) {
+      return false;
+    }
+    *batch = std::move(batches_.front());
+    batches_.pop_front();
+    visitor_cond_.Signal(JavaHprofDataSource::art_thread());
+    return true;
+  }
+
+  // Called by workers.
+  void PushChunk(std::vector<uint8_t>&& chunk) {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+    chunks_.push_back(std::move(chunk));
+    visitor_cond_.Signal(JavaHprofDataSource::art_thread());
+  }
+
+  // Called by each worker once it has pushed all its chunks.
+  void WorkerDone() {
+    art::MutexLock lk(JavaHprofDataSource::art_thread(), lock_);
+    --running_workers_;
+    visitor_cond_.Signal(JavaHprofDataSource::art_thread());
+  }
+
+ private:
+  static void WriteChunks(std::deque<std::vector<uint8_t>>* chunks, Writer& writer) {
+    for (const std::vector<uint8_t>& chunk : *chunks) {
+      writer.WriteChunk(chunk);
+    }
+    chunks->clear();
+  }
+
+  const size_t max_pending_batches_;
+
+  art::Mutex lock_{"perfetto_hprof_parallel_dump_mutex", art::LockLevel::kGenericBottomLock};
+  // Signaled when a batch is pushed or when there are no more batches.
+  art::ConditionVariable worker_cond_{"perfetto_hprof_worker_cv", lock_};
+  // Signaled when a batch is popped, a chunk is pushed or a worker is done.
+  art::ConditionVariable visitor_cond_{"perfetto_hprof_visitor_cv", lock_};
+  std::deque<std::vector<art::mirror::Object*>> batches_ GUARDED_BY(lock_);
+  std::deque<std::vector<uint8_t>> chunks_ GUARDED_BY(lock_);
+  bool no_more_batches_ GUARDED_BY(lock_) = false;
+  size_t running_workers_ GUARDED_BY(lock_);
 };
 
+// Writes perfetto.protos.HeapGraph messages to memory and pushes them, once they reach about
+// kPacketSizeThreshold bytes, as chunks to `*queues`.
+class ChunkWriter : public HeapGraphWriter {
+ public:
+  explicit ChunkWriter(ParallelDumpQueues* queues) : queues_(queues), stream_(&buffer_) {
+    buffer_.set_writer(&stream_);
+  }
+
+  ~ChunkWriter() override { Flush(); }
+
+  bool will_create_new_packet() const override {
+    return !started_ || stream_.written() - chunk_start_ > kPacketSizeThreshold;
+  }
+
+  uint64_t packet_index() const override { return index_; }
+
+  perfetto::protos::pbzero::HeapGraph* GetHeapGraph() override {
+    if (will_create_new_packet()) {
+      Flush();
+      chunk_start_ = stream_.written();
+      message_.Reset(&stream_);
+      started_ = true;
+      ++index_;
+    }
+    return &message_;
+  }
+
+  // Pushes the current message, if any, to `*queues_`.
+  void Flush() {
+    if (!started_) {
+      return;
+    }
+    message_.Finalize();
+    queues_->PushChunk(buffer_.StitchSlices());
+    buffer_.Reset();
+    stream_.Reset(protozero::ContiguousMemoryRange{});
+    started_ = false;
+  }
+
+ private:
+  ChunkWriter(const ChunkWriter&) = delete;
+  ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+  ParallelDumpQueues* const queues_;
+  protozero::ScatteredHeapBuffer buffer_;
+  protozero::ScatteredStreamWriter stream_;
+  protozero::RootMessage<perfetto::protos::pbzero::HeapGraph> message_;
+  bool started_ = false;
+  uint64_t chunk_start_ = 0;
+  uint64_t index_ = 0;
+};
+
+// Dumps all the objects from `*runtime` to `writer`, encoding them on `num_threads` threads.
+void DumpObjectsInParallel(art::Runtime* runtime,
+                           Writer& writer,
+                           uint32_t num_threads,
+                           const std::vector<std::string>& ignored_types,
+                           Interner* interner,
+                           const ObjectSampler* sampler) REQUIRES(art::Locks::mutator_lock_) {
+  ParallelDumpQueues queues(num_threads);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    // The worker threads are not attached to the runtime. The heap of the forked child does not
+    // change while it is dumped, so they can read it without holding the mutator lock.
+    threads.emplace_back([&]() NO_THREAD_SAFETY_ANALYSIS {
+      HeapGraphDumper dumper(ignored_types, interner, sampler);
+      {
+        ChunkWriter chunk_writer(&queues);
+        std::vector<art::mirror::Object*> batch;
+        while (queues.PopBatch(&batch)) {
+          for (art::mirror::Object* obj : batch) {
+            dumper.WriteOneObject(obj, chunk_writer);
+          }
+        }
+      }
+      queues.WorkerDone();
+    });
+  }
+
+  std::vector<art::mirror::Object*> batch;
+  runtime->GetHeap()->VisitObjectsPaused([&](art::mirror::Object* obj) {
+    batch.push_back(obj);
+    if (batch.size() == kDumpBatchSize) {
+      queues.PushBatch(std::move(batch), writer);
+      batch.clear();
+    }
+  });
+  if (!batch.empty()) {
+    queues.PushBatch(std::move(batch), writer);
+  }
+  queues.Finish(writer);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+// Dumps a heap graph from `*runtime` and writes it to `writer`.
+void DumpHeapGraph(art::Runtime* runtime,
+                   Writer& writer,
+                   const std::vector<std::string>& ignored_types,
+                   const DumpOptions& options) REQUIRES(art::Locks::mutator_lock_) {
+  std::optional<ObjectSampler> sampler;
+  if (options.sample_interval > 1) {
+    sampler.emplace(options.sample_interval, options.sample_min_instances);
+    sampler->CountInstances(runtime);
+    LOG(INFO) << "sampling one in " << options.sample_interval << " instances of "
+              << sampler->GetNumberOfSampledClasses() << " classes";
+  }
+  const ObjectSampler* sampler_ptr = sampler.has_value() ? &sampler.value() : nullptr;
+
+  Interner interner;
+  DumpRootObjects(runtime, writer);
+
+  if (options.num_threads > 1) {
+    DumpObjectsInParallel(
+        runtime, writer, options.num_threads, ignored_types, &interner, sampler_ptr);
+  } else {
+    HeapGraphDumper dumper(ignored_types, &interner, sampler_ptr);
+    dumper.DumpObjects(runtime, writer);
+  }
+
+  interner.WriteInternedData(writer);
+}
+
 // waitpid with a timeout implemented by ~busy-waiting
 // See b/181031512 for rationale.
 void BusyWaitpid(pid_t pid, uint32_t timeout_ms) {
@@ -1037,9 +1432,7 @@ void WriteHeapPackets(pid_t parent_pid, uint64_t timestamp) {
               DumpSmaps(&ctx);
             }
             Writer writer(parent_pid, &ctx, timestamp);
-            HeapGraphDumper dumper(ignored_types);
-
-            dumper.Dump(art::Runtime::Current(), writer);
+            DumpHeapGraph(art::Runtime::Current(), writer, ignored_types, ReadDumpOptions());
 
             writer.Finalize();
             ctx.Flush([] {
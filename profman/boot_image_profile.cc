@@ -16,10 +16,14 @@
 
 #include "boot_image_profile.h"
 
+#include <algorithm>
+#include <cinttypes>
 #include <memory>
 #include <set>
 
 #include "android-base/file.h"
+#include "android-base/stringprintf.h"
+#include "base/globals.h"
 #include "dex/class_accessor-inl.h"
 #include "dex/descriptors_names.h"
 #include "dex/dex_file-inl.h"
@@ -27,6 +31,7 @@
 #include "dex/type_reference.h"
 #include "profile/profile_compilation_info.h"
 #include "inline_cache_format_util.h"
+#include "profile_aggregation.h"
 
 namespace art {
 
@@ -196,6 +201,119 @@ static bool IncludeInPreloadedClasses(const std::string& class_name,
       max_aggregation_count, options.preloaded_class_threshold, metadata, options);
 }
 
+// Rough estimates of the boot image space used by compiled methods and image classes,
+// used for choosing the profile within a size budget.
+static constexpr uint64_t kCompiledMethodHeaderSize = 16u;
+static constexpr uint64_t kCompiledBytesPerDexCodeUnit = 6u;
+static constexpr uint64_t kNativeMethodStubSize = 64u;
+static constexpr uint64_t kImageClassSize = 256u;
+static constexpr uint64_t kImageArtMethodSize = 32u;
+static constexpr uint64_t kImageArtFieldSize = 16u;
+
+// Startup methods run in every process that uses them, hot methods in many.
+static constexpr double kStartupBenefitFactor = 2.0;
+static constexpr double kHotBenefitFactor = 1.5;
+
+// Returns the estimated size of the compiled code of the given method in the boot image.
+static uint64_t EstimateCompiledMethodSize(const MethodReference& ref) {
+  const DexFile* dex_file = ref.dex_file;
+  const dex::ClassDef* class_def = dex_file->FindClassDef(ref.GetMethodId().class_idx_);
+  if (class_def != nullptr) {
+    ClassAccessor accessor(*dex_file, *class_def);
+    for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+      if (method.GetIndex() != ref.index) {
+        continue;
+      }
+      if (method.GetCodeItem() == nullptr) {
+        return ((method.GetAccessFlags() & kAccNative) != 0) ? kNativeMethodStubSize : 0u;
+      }
+      return kCompiledMethodHeaderSize +
+             kCompiledBytesPerDexCodeUnit * method.GetInstructions().InsnsSizeInCodeUnits();
+    }
+  }
+  return kCompiledMethodHeaderSize;
+}
+
+// Returns the estimated size of the given class and its methods and fields in the boot image.
+static uint64_t EstimateImageClassSize(const TypeReference& ref) {
+  const dex::ClassDef* class_def = ref.dex_file->FindClassDef(ref.TypeIndex());
+  if (class_def == nullptr) {
+    return kImageClassSize;
+  }
+  ClassAccessor accessor(*ref.dex_file, *class_def);
+  return kImageClassSize +
+         kImageArtMethodSize * accessor.NumMethods() +
+         kImageArtFieldSize * accessor.NumFields();
+}
+
+// Returns the expected startup savings of having the item in the boot image, as the weighted
+// fraction of the aggregated profiles that have the item.
+static double EstimateBenefit(uint32_t max_aggregation_count,
+                              const FlattenProfileData::ItemMetadata& metadata) {
+  CHECK_NE(max_aggregation_count, 0u);
+  double benefit =
+      metadata.GetAnnotations().size() / static_cast<double>(max_aggregation_count);
+  if (metadata.HasFlagSet(Hotness::kFlagStartup)) {
+    benefit *= kStartupBenefitFactor;
+  }
+  if (metadata.HasFlagSet(Hotness::kFlagHot)) {
+    benefit *= kHotBenefitFactor;
+  }
+  return benefit;
+}
+
+// A method or class that may be kept in a size budgeted boot image profile.
+struct BudgetCandidate {
+  std::string name;
+  uint64_t size;
+  double benefit;
+
+  double BenefitPerByte() const {
+    return benefit / static_cast<double>(std::max<uint64_t>(size, 1u));
+  }
+};
+
+// Removes from `profile_methods` and `profile_classes` the candidates that do not fit into
+// the image size budget. The candidates are taken greedily by decreasing savings per byte,
+// which is close to optimal as they are small compared to the budget. Returns, as text, the
+// marginal benefit curve: the cumulative size and savings of the candidates in that order.
+static std::string SelectWithinBudget(
+    std::vector<BudgetCandidate>&& candidates,
+    uint64_t budget,
+    SafeMap<std::string, FlattenProfileData::ItemMetadata>* profile_methods,
+    SafeMap<std::string, FlattenProfileData::ItemMetadata>* profile_classes) {
+  std::stable_sort(candidates.begin(),
+                   candidates.end(),
+                   [](const BudgetCandidate& lhs, const BudgetCandidate& rhs) {
+                     return lhs.BenefitPerByte() > rhs.BenefitPerByte();
+                   });
+
+  std::string curve = "# size benefit benefit_per_kib item\n";
+  uint64_t total_size = 0u;
+  double total_benefit = 0.0;
+  uint64_t selected_size = 0u;
+  double selected_benefit = 0.0;
+  for (const BudgetCandidate& candidate : candidates) {
+    total_size += candidate.size;
+    total_benefit += candidate.benefit;
+    curve += android::base::StringPrintf("%" PRIu64 " %.4f %.4f %s\n",
+                                         total_size,
+                                         total_benefit,
+                                         candidate.BenefitPerByte() * KB,
+                                         candidate.name.c_str());
+    if (selected_size + candidate.size <= budget) {
+      selected_size += candidate.size;
+      selected_benefit += candidate.benefit;
+    } else {
+      profile_methods->erase(candidate.name);
+      profile_classes->erase(candidate.name);
+    }
+  }
+  VLOG(profiler) << "Selected " << selected_size << " of " << total_size << " bytes with "
+                 << selected_benefit << " of " << total_benefit << " expected savings";
+  return curve;
+}
+
 bool GenerateBootImageProfile(
     const std::vector<std::unique_ptr<const DexFile>>& dex_files,
     const std::vector<std::string>& profile_files,
@@ -209,15 +327,10 @@ bool GenerateBootImageProfile(
 
   bool generate_preloaded_classes = !preloaded_classes_out_path.empty();
 
-  std::unique_ptr<FlattenProfileData> flattend_data(new FlattenProfileData());
-  for (const std::string& profile_file : profile_files) {
-    ProfileCompilationInfo profile(/*for_boot_image=*/ true);
-    if (!profile.Load(profile_file, /*clear_if_invalid=*/ false)) {
-      LOG(ERROR) << "Profile is not a valid: " << profile_file;
-      return false;
-    }
-    std::unique_ptr<FlattenProfileData> currentData = profile.ExtractProfileData(dex_files);
-    flattend_data->MergeData(*currentData);
+  std::unique_ptr<FlattenProfileData> flattend_data = AggregateProfiles(
+      dex_files, profile_files, /*for_boot_image=*/ true, options.num_threads);
+  if (flattend_data == nullptr) {
+    return false;
   }
 
   // We want the output sorted by the method/class name.
@@ -227,6 +340,9 @@ bool GenerateBootImageProfile(
   SafeMap<std::string, FlattenProfileData::ItemMetadata> profile_methods;
   SafeMap<std::string, FlattenProfileData::ItemMetadata> profile_classes;
   SafeMap<std::string, FlattenProfileData::ItemMetadata> preloaded_classes;
+  bool use_budget =
+      options.image_size_budget != 0u || !options.benefit_curve_out_path.empty();
+  std::vector<BudgetCandidate> budget_candidates;
 
   for (const auto& it : flattend_data->GetMethodData()) {
     if (IncludeMethodInProfile(flattend_data->GetMaxAggregationForMethods(), it.second, options)) {
@@ -235,7 +351,14 @@ bool GenerateBootImageProfile(
           && ((metadata.GetFlags() & Hotness::Flag::kFlagStartup) != 0)) {
         metadata.AddFlag(Hotness::Flag::kFlagHot);
       }
-      profile_methods.Put(BootImageRepresentation(it.first), metadata);
+      std::string representation = BootImageRepresentation(it.first);
+      if (use_budget) {
+        budget_candidates.push_back(
+            {representation,
+             EstimateCompiledMethodSize(it.first),
+             EstimateBenefit(flattend_data->GetMaxAggregationForMethods(), it.second)});
+      }
+      profile_methods.Put(representation, metadata);
     }
   }
 
@@ -246,7 +369,14 @@ bool GenerateBootImageProfile(
             flattend_data->GetMaxAggregationForClasses(),
             metadata,
             options)) {
-      profile_classes.Put(BootImageRepresentation(it.first), it.second);
+      std::string representation = BootImageRepresentation(it.first);
+      if (use_budget) {
+        budget_candidates.push_back(
+            {representation,
+             EstimateImageClassSize(type_ref),
+             EstimateBenefit(flattend_data->GetMaxAggregationForClasses(), metadata)});
+      }
+      profile_classes.Put(representation, it.second);
     }
     std::string preloaded_class_representation = PreloadedClassesRepresentation(it.first);
     if (generate_preloaded_classes && IncludeInPreloadedClasses(
@@ -258,6 +388,15 @@ bool GenerateBootImageProfile(
     }
   }
 
+  std::string benefit_curve;
+  if (use_budget) {
+    uint64_t budget = (options.image_size_budget != 0u)
+        ? options.image_size_budget
+        : std::numeric_limits<uint64_t>::max();
+    benefit_curve = SelectWithinBudget(
+        std::move(budget_candidates), budget, &profile_methods, &profile_classes);
+  }
+
   // Create the output content
   std::string profile_content;
   std::string preloaded_content;
@@ -279,7 +418,9 @@ bool GenerateBootImageProfile(
 
   return android::base::WriteStringToFile(profile_content, boot_profile_out_path)
       && (!generate_preloaded_classes
-          || android::base::WriteStringToFile(preloaded_content, preloaded_classes_out_path));
+          || android::base::WriteStringToFile(preloaded_content, preloaded_classes_out_path))
+      && (options.benefit_curve_out_path.empty()
+          || android::base::WriteStringToFile(benefit_curve, options.benefit_curve_out_path));
 }
 
 }  // namespace art
@@ -21,6 +21,7 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include <string>
 
 #include "base/safe_map.h"
 #include "dex/dex_file.h"
@@ -67,6 +68,18 @@ struct BootImageOptions {
 
   // The set of classes that should not be preloaded in Zygote
   std::set<std::string> preloaded_classes_denylist;
+
+  // Number of threads that load and merge the input profiles.
+  uint32_t num_threads = 1;
+
+  // Estimated boot image size, in bytes, that the compiled methods and the classes of the
+  // profile may use. Among the methods and classes that pass the thresholds, the ones with
+  // the best expected startup savings per byte are kept. Zero means no budget.
+  uint64_t image_size_budget = 0;
+
+  // If not empty, the cumulative size and savings of the candidate methods and classes, in
+  // the order in which they are selected for the budget, are written to this path.
+  std::string benefit_curve_out_path;
 };
 
 // Generate a boot image profile according to the specified options.
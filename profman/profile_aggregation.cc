@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profile_aggregation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "base/logging.h"
+#include "dex/method_reference.h"
+#include "dex/type_reference.h"
+#include "profile/profile_compilation_info.h"
+
+namespace art {
+
+using Hotness = ProfileCompilationInfo::MethodHotness;
+
+// Merges the profiles in [begin, end) into `result`. Returns false if a profile is invalid.
+static bool AggregateRange(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+                           const std::vector<std::string>& profile_files,
+                           bool for_boot_image,
+                           size_t begin,
+                           size_t end,
+                           FlattenProfileData* result) {
+  for (size_t i = begin; i != end; ++i) {
+    ProfileCompilationInfo profile(for_boot_image);
+    if (!profile.Load(profile_files[i], /*clear_if_invalid=*/ false)) {
+      LOG(ERROR) << "Profile is not a valid: " << profile_files[i];
+      return false;
+    }
+    std::unique_ptr<FlattenProfileData> data = profile.ExtractProfileData(dex_files);
+    result->MergeData(*data);
+  }
+  return true;
+}
+
+std::unique_ptr<FlattenProfileData> AggregateProfiles(
+    const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+    const std::vector<std::string>& profile_files,
+    bool for_boot_image,
+    uint32_t num_threads) {
+  size_t num_ranges =
+      std::clamp<size_t>(num_threads, 1u, std::max<size_t>(profile_files.size(), 1u));
+  std::vector<std::unique_ptr<FlattenProfileData>> partial_data(num_ranges);
+  for (std::unique_ptr<FlattenProfileData>& data : partial_data) {
+    data.reset(new FlattenProfileData());
+  }
+  if (num_ranges == 1u) {
+    if (!AggregateRange(dex_files,
+                        profile_files,
+                        for_boot_image,
+                        /*begin=*/ 0u,
+                        /*end=*/ profile_files.size(),
+                        partial_data[0].get())) {
+      return nullptr;
+    }
+    return std::move(partial_data[0]);
+  }
+
+  // Load and merge contiguous ranges of the inputs in parallel.
+  std::atomic<bool> success(true);
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i != num_ranges; ++i) {
+      size_t begin = profile_files.size() * i / num_ranges;
+      size_t end = profile_files.size() * (i + 1u) / num_ranges;
+      threads.emplace_back([&, begin, end, i]() {
+        if (!AggregateRange(
+                dex_files, profile_files, for_boot_image, begin, end, partial_data[i].get())) {
+          success.store(false, std::memory_order_relaxed);
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  if (!success.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  // Merge the partial results pairwise, halving their number in each round.
+  for (size_t stride = 1u; stride < num_ranges; stride *= 2u) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i + stride < num_ranges; i += 2u * stride) {
+      threads.emplace_back([&partial_data, i, stride]() {
+        partial_data[i]->MergeData(*partial_data[i + stride]);
+        partial_data[i + stride].reset();
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  return std::move(partial_data[0]);
+}
+
+// Returns true iff an item that is in `count` of `num_profiles` profiles meets `threshold`.
+static bool MeetsThreshold(size_t count, size_t num_profiles, uint32_t threshold) {
+  return count != 0u && count * 100u >= num_profiles * threshold;
+}
+
+bool GenerateAggregatedProfile(
+    const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+    const std::vector<std::string>& profile_files,
+    const ProfileAggregationOptions& options,
+    const std::string& out_path) {
+  if (out_path.empty()) {
+    LOG(ERROR) << "No output file specified";
+    return false;
+  }
+
+  std::unique_ptr<FlattenProfileData> data =
+      AggregateProfiles(dex_files, profile_files, /*for_boot_image=*/ false, options.num_threads);
+  if (data == nullptr) {
+    return false;
+  }
+
+  ProfileCompilationInfo result;
+  size_t num_methods = 0u;
+  for (const auto& it : data->GetMethodData()) {
+    const FlattenProfileData::ItemMetadata& metadata = it.second;
+    if (!MeetsThreshold(
+            metadata.GetAnnotations().size(), profile_files.size(), options.method_threshold)) {
+      continue;
+    }
+    Hotness::Flag flags = static_cast<Hotness::Flag>(metadata.GetFlags());
+    if (!result.AddMethod(ProfileMethodInfo(it.first), flags)) {
+      LOG(ERROR) << "Failed to add method " << it.first.PrettyMethod();
+      return false;
+    }
+    ++num_methods;
+  }
+  size_t num_classes = 0u;
+  for (const auto& it : data->GetClassData()) {
+    const TypeReference& type_ref = it.first;
+    if (!MeetsThreshold(
+            it.second.GetAnnotations().size(), profile_files.size(), options.class_threshold)) {
+      continue;
+    }
+    if (!result.AddClass(*type_ref.dex_file, type_ref.TypeIndex())) {
+      LOG(ERROR) << "Failed to add class " << type_ref.dex_file->PrettyType(type_ref.TypeIndex());
+      return false;
+    }
+    ++num_classes;
+  }
+  VLOG(profiler) << "Aggregated " << profile_files.size() << " profiles into " << num_methods
+                 << " methods and " << num_classes << " classes";
+
+  return result.Save(out_path, /*bytes_written=*/ nullptr);
+}
+
+}  // namespace art
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_PROFMAN_PROFILE_AGGREGATION_H_
+#define ART_PROFMAN_PROFILE_AGGREGATION_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dex/dex_file.h"
+
+namespace art {
+
+class FlattenProfileData;
+
+struct ProfileAggregationOptions {
+ public:
+  // Number of threads that load and merge the input profiles.
+  uint32_t num_threads = 1;
+
+  // Threshold for including a method in the aggregated profile. The threshold specifies, as
+  // percentage of the number of input profiles, how many profiles need to have the method.
+  uint32_t method_threshold = 0;
+
+  // Threshold for including a class in the aggregated profile, similar to `method_threshold`.
+  uint32_t class_threshold = 0;
+};
+
+// Load the profiles in `profile_files` and merge the data they have on `dex_files`, keeping
+// for each method and class the number of profiles that have it. The inputs are split in
+// `num_threads` contiguous ranges that are loaded and merged in parallel, and the partial
+// results are then merged pairwise in parallel. Returns null if a profile cannot be loaded.
+std::unique_ptr<FlattenProfileData> AggregateProfiles(
+    const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+    const std::vector<std::string>& profile_files,
+    bool for_boot_image,
+    uint32_t num_threads);
+
+// Aggregate app profiles and write the methods and classes that are in enough of them to
+// the app profile `out_path`. Method flags are the union of the flags in the input profiles.
+// Inline caches are not kept. Returns true if the generation was successful.
+bool GenerateAggregatedProfile(
+    const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+    const std::vector<std::string>& profile_files,
+    const ProfileAggregationOptions& options,
+    const std::string& out_path);
+
+}  // namespace art
+
+#endif  // ART_PROFMAN_PROFILE_AGGREGATION_H_
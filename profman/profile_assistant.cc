@@ -22,11 +22,6 @@
 
 namespace art {
 
-// Minimum number of new methods/classes that profiles
-// must contain to enable recompilation.
-static constexpr const uint32_t kMinNewMethodsForCompilation = 100;
-static constexpr const uint32_t kMinNewClassesForCompilation = 50;
-
 ProfmanResult::ProcessingResult ProfileAssistant::ProcessProfilesInternal(
     const std::vector<ScopedFlock>& profile_files,
     const ScopedFlock& reference_profile_file,
@@ -92,10 +87,10 @@ ProfmanResult::ProcessingResult ProfileAssistant::ProcessProfilesInternal(
     } else {
       uint32_t min_change_in_methods_for_compilation = std::max(
           (options.GetMinNewMethodsPercentChangeForCompilation() * number_of_methods) / 100,
-          kMinNewMethodsForCompilation);
+          options.GetMinNewMethodsForCompilation());
       uint32_t min_change_in_classes_for_compilation = std::max(
           (options.GetMinNewClassesPercentChangeForCompilation() * number_of_classes) / 100,
-          kMinNewClassesForCompilation);
+          options.GetMinNewClassesForCompilation());
       // Check if there is enough new information added by the current profiles.
       if (((info.GetNumberOfMethods() - number_of_methods) <
            min_change_in_methods_for_compilation) &&
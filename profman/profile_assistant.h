@@ -34,6 +34,8 @@ class ProfileAssistant {
     static constexpr bool kBootImageMergeDefault = false;
     static constexpr uint32_t kMinNewMethodsPercentChangeForCompilation = 2;
     static constexpr uint32_t kMinNewClassesPercentChangeForCompilation = 2;
+    static constexpr uint32_t kMinNewMethodsForCompilation = 100;
+    static constexpr uint32_t kMinNewClassesForCompilation = 50;
 
     Options()
         : force_merge_(kForceMergeDefault),
@@ -42,7 +44,9 @@ class ProfileAssistant {
           min_new_methods_percent_change_for_compilation_(
               kMinNewMethodsPercentChangeForCompilation),
           min_new_classes_percent_change_for_compilation_(
-              kMinNewClassesPercentChangeForCompilation) {
+              kMinNewClassesPercentChangeForCompilation),
+          min_new_methods_for_compilation_(kMinNewMethodsForCompilation),
+          min_new_classes_for_compilation_(kMinNewClassesForCompilation) {
     }
 
     // Only for S and T uses. U+ should use `IsForceMergeAndAnalyze`.
@@ -55,6 +59,8 @@ class ProfileAssistant {
     uint32_t GetMinNewClassesPercentChangeForCompilation() const {
         return min_new_classes_percent_change_for_compilation_;
     }
+    uint32_t GetMinNewMethodsForCompilation() const { return min_new_methods_for_compilation_; }
+    uint32_t GetMinNewClassesForCompilation() const { return min_new_classes_for_compilation_; }
 
     void SetForceMerge(bool value) { force_merge_ = value; }
     void SetForceMergeAndAnalyze(bool value) { force_merge_and_analyze_ = value; }
@@ -65,6 +71,12 @@ class ProfileAssistant {
     void SetMinNewClassesPercentChangeForCompilation(uint32_t value) {
       min_new_classes_percent_change_for_compilation_ = value;
     }
+    void SetMinNewMethodsForCompilation(uint32_t value) {
+      min_new_methods_for_compilation_ = value;
+    }
+    void SetMinNewClassesForCompilation(uint32_t value) {
+      min_new_classes_for_compilation_ = value;
+    }
 
    private:
     // If true, performs a forced merge, without analyzing if there is a significant difference
@@ -81,6 +93,10 @@ class ProfileAssistant {
     bool boot_image_merge_;
     uint32_t min_new_methods_percent_change_for_compilation_;
     uint32_t min_new_classes_percent_change_for_compilation_;
+    // Minimum number of new methods/classes that the current profiles must add to the reference
+    // profile to enable recompilation, regardless of the percentages above.
+    uint32_t min_new_methods_for_compilation_;
+    uint32_t min_new_classes_for_compilation_;
   };
 
   // Process the profile information present in the given files. Returns one of
@@ -707,6 +707,42 @@ TEST_F(ProfileAssistantTest, ShouldAdviseCompilationClassPercentage) {
                 kNumberOfClassesInCurProfile, kNumberOfClassesInRefProfile, extra_args));
 }
 
+TEST_F(ProfileAssistantTest, ShouldAdviseCompilationMethodCount) {
+  const uint16_t kNumberOfMethodsInRefProfile = 6000;
+  const uint16_t kNumberOfMethodsInCurProfile = 6050;  // Threshold is 40.
+  std::vector<std::string> extra_args(
+      {"--min-new-methods-percent-change=0", "--min-new-methods-change=40"});
+
+  // We should advise compilation.
+  ASSERT_EQ(ProfmanResult::kCompile,
+            CheckCompilationMethodPercentChange(
+                kNumberOfMethodsInCurProfile, kNumberOfMethodsInRefProfile, extra_args));
+}
+
+TEST_F(ProfileAssistantTest, DoNotAdviseCompilationMethodCount) {
+  const uint16_t kNumberOfMethodsInRefProfile = 6000;
+  const uint16_t kNumberOfMethodsInCurProfile = 6200;  // Threshold is 500.
+  std::vector<std::string> extra_args(
+      {"--min-new-methods-percent-change=2", "--min-new-methods-change=500"});
+
+  // We should not advise compilation.
+  ASSERT_EQ(ProfmanResult::kSkipCompilationSmallDelta,
+            CheckCompilationMethodPercentChange(
+                kNumberOfMethodsInCurProfile, kNumberOfMethodsInRefProfile, extra_args));
+}
+
+TEST_F(ProfileAssistantTest, ShouldAdviseCompilationClassCount) {
+  const uint16_t kNumberOfClassesInRefProfile = 6000;
+  const uint16_t kNumberOfClassesInCurProfile = 6030;  // Threshold is 20.
+  std::vector<std::string> extra_args(
+      {"--min-new-classes-percent-change=0", "--min-new-classes-change=20"});
+
+  // We should advise compilation.
+  ASSERT_EQ(ProfmanResult::kCompile,
+            CheckCompilationClassPercentChange(
+                kNumberOfClassesInCurProfile, kNumberOfClassesInRefProfile, extra_args));
+}
+
 TEST_F(ProfileAssistantTest, FailProcessingBecauseOfProfiles) {
   ScratchFile profile1;
   ScratchFile profile2;
@@ -988,6 +1024,59 @@ TEST_F(ProfileAssistantTest, TestBootImageProfile) {
   ASSERT_EQ(output_preloaded_contents, expected_preloaded_content);
 }
 
+TEST_F(ProfileAssistantTest, TestAggregateProfiles) {
+  const std::string core_dex = GetLibCoreDexFileNames()[0];
+
+  // In all profiles.
+  const std::string kCommonClass = "Ljava/lang/Object;";
+  const std::string kCommonMethod = "HLjava/lang/Comparable;->compareTo(Ljava/lang/Object;)I";
+  // In two of the three profiles.
+  const std::string kFrequentClass = "Ljava/lang/CharSequence;";
+  const std::string kFrequentMethod = "HLjava/util/ArrayList;->clear()V";
+  // In one profile.
+  const std::string kUncommonClass = "Ljava/lang/Process;";
+  const std::string kUncommonMethod = "HLjava/util/HashMap;-><init>()V";
+
+  std::vector<std::vector<std::string>> input_data = {
+      {kCommonClass, kCommonMethod, kFrequentClass, kFrequentMethod},
+      {kCommonClass, kCommonMethod, kFrequentClass, kFrequentMethod},
+      {kCommonClass, kCommonMethod, kUncommonClass, kUncommonMethod},
+  };
+  std::vector<ScratchFile> profiles(input_data.size());
+  std::vector<std::string> args;
+  args.push_back(GetProfmanCmd());
+  args.push_back("--aggregate-profiles");
+  args.push_back("--aggregation-threads=2");
+  args.push_back("--aggregation-method-threshold=50");
+  args.push_back("--aggregation-class-threshold=100");
+  for (size_t i = 0; i != input_data.size(); ++i) {
+    ASSERT_TRUE(
+        CreateProfile(JoinProfileLines(input_data[i]), profiles[i].GetFilename(), core_dex));
+    args.push_back("--profile-file=" + profiles[i].GetFilename());
+  }
+  ScratchFile reference_profile;
+  args.push_back("--reference-profile-file=" + reference_profile.GetFilename());
+  args.push_back("--apk=" + core_dex);
+  args.push_back("--dex-location=" + core_dex);
+
+  std::string error;
+  ASSERT_EQ(ExecAndReturnCode(args, &error), 0) << error;
+
+  std::string output;
+  ASSERT_TRUE(DumpClassesAndMethods(reference_profile.GetFilename(), &output));
+  std::vector<std::string> lines;
+  Split(output, '\n', &lines);
+  auto contains = [&](const std::string& line) {
+    return std::find(lines.begin(), lines.end(), line) != lines.end();
+  };
+  EXPECT_TRUE(contains(kCommonClass)) << output;
+  EXPECT_TRUE(contains(kCommonMethod)) << output;
+  EXPECT_TRUE(contains(kFrequentMethod)) << output;
+  EXPECT_FALSE(contains(kFrequentClass)) << output;
+  EXPECT_FALSE(contains(kUncommonClass)) << output;
+  EXPECT_FALSE(contains(kUncommonMethod)) << output;
+}
+
 TEST_F(ProfileAssistantTest, TestBootImageProfileWith2RawProfiles) {
   const std::string core_dex = GetLibCoreDexFileNames()[0];
 
@@ -1076,6 +1165,76 @@ TEST_F(ProfileAssistantTest, TestBootImageProfileWith2RawProfiles) {
   ASSERT_EQ(output_profile_contents, expected_profile_content);
 }
 
+TEST_F(ProfileAssistantTest, TestBootImageProfileWithSizeBudget) {
+  const std::string core_dex = GetLibCoreDexFileNames()[0];
+
+  const std::string kCommonHotMethod = "Ljava/lang/Object;->hashCode()I";
+  const std::string kUncommonHotMethod = "Ljava/util/HashMap;-><init>()V";
+  std::vector<std::vector<std::string>> input_data = {
+      {"H" + kCommonHotMethod, "H" + kUncommonHotMethod},
+      {"H" + kCommonHotMethod},
+  };
+  std::vector<ScratchFile> profiles(input_data.size());
+  for (size_t i = 0; i != input_data.size(); ++i) {
+    ASSERT_TRUE(CreateProfile(JoinProfileLines(input_data[i]),
+                              profiles[i].GetFilename(),
+                              core_dex,
+                              /*for_boot_image=*/ true));
+  }
+
+  auto generate = [&](const std::string& budget_arg,
+                      const std::string& out_profile,
+                      const std::string& out_curve) {
+    std::vector<std::string> args;
+    args.push_back(GetProfmanCmd());
+    args.push_back("--generate-boot-image-profile");
+    args.push_back("--method-threshold=0");
+    args.push_back(budget_arg);
+    for (const ScratchFile& profile : profiles) {
+      args.push_back("--profile-file=" + profile.GetFilename());
+    }
+    args.push_back("--out-profile-path=" + out_profile);
+    args.push_back("--out-benefit-curve-path=" + out_curve);
+    args.push_back("--apk=" + core_dex);
+    args.push_back("--dex-location=" + core_dex);
+    std::string error;
+    return ExecAndReturnCode(args, &error) == 0;
+  };
+
+  // Without a budget, all methods are kept and the curve lists them all.
+  ScratchFile out_profile;
+  ScratchFile out_curve;
+  ASSERT_TRUE(generate("--boot-image-size-budget=0",
+                       out_profile.GetFilename(),
+                       out_curve.GetFilename()));
+  std::string output_profile_contents;
+  ASSERT_TRUE(android::base::ReadFileToString(
+      out_profile.GetFilename(), &output_profile_contents));
+  ASSERT_EQ(output_profile_contents,
+            JoinProfileLines({"H" + kCommonHotMethod, "H" + kUncommonHotMethod}));
+  std::string curve_contents;
+  ASSERT_TRUE(android::base::ReadFileToString(out_curve.GetFilename(), &curve_contents));
+  std::vector<std::string> curve_lines;
+  Split(curve_contents, '\n', &curve_lines);
+  ASSERT_EQ(curve_lines.size(), 3u) << curve_contents;
+  std::vector<std::string> first_point;
+  Split(curve_lines[1], ' ', &first_point);
+  ASSERT_EQ(first_point.size(), 4u) << curve_contents;
+  const std::string& other_method =
+      (first_point[3] == kCommonHotMethod) ? kUncommonHotMethod : kCommonHotMethod;
+  EXPECT_TRUE(curve_lines[2].ends_with(" " + other_method)) << curve_contents;
+
+  // With a budget that fits only the first method of the curve, only that method is kept.
+  ScratchFile budget_profile;
+  ScratchFile budget_curve;
+  ASSERT_TRUE(generate("--boot-image-size-budget=" + first_point[0],
+                       budget_profile.GetFilename(),
+                       budget_curve.GetFilename()));
+  ASSERT_TRUE(android::base::ReadFileToString(
+      budget_profile.GetFilename(), &output_profile_contents));
+  ASSERT_EQ(output_profile_contents, JoinProfileLines({"H" + first_point[3]}));
+}
+
 TEST_F(ProfileAssistantTest, TestProfileCreationOneNotMatched) {
   // Class names put here need to be in sorted order.
   std::vector<std::string> class_names = {
@@ -61,6 +61,8 @@
 #include "dex/type_reference.h"
 #include "profile/profile_boot_info.h"
 #include "profile/profile_compilation_info.h"
+#include "profile/startup_trace.h"
+#include "profile_aggregation.h"
 #include "profile_assistant.h"
 #include "profman/profman_result.h"
 #include "inline_cache_format_util.h"
@@ -150,6 +152,9 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("      methods and inline caches.");
   UsageError("  --output-profile-type=(app|boot|bprof): Select output profile format for");
   UsageError("      the --create-profile-from option. Default: app.");
+  UsageError("  --create-profile-from-startup-trace=<filename>: creates an app profile from a");
+  UsageError("      startup trace recorded with -Xps-startup-trace-path. Traced classes are added");
+  UsageError("      to the profile and traced methods are added as startup methods.");
   UsageError("");
   UsageError("  --dex-location=<string>: location string to use with corresponding");
   UsageError("      apk-fd to find dex files");
@@ -183,6 +188,19 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("  --debug-append-uses=bool: whether or not to append package use as debug info.");
   UsageError("  --out-profile-path=path: boot image profile output path");
   UsageError("  --out-preloaded-classes-path=path: preloaded classes output path");
+  UsageError("  --boot-image-size-budget=bytes: keep only the methods and classes with the best");
+  UsageError("      expected startup savings per byte that fit into the given estimated size.");
+  UsageError("  --out-benefit-curve-path=path: write the cumulative size and expected savings");
+  UsageError("      of the methods and classes, in the order they are kept for the budget.");
+  UsageError("  --aggregate-profiles: merge the --profile-file(s) into the app profile passed");
+  UsageError("      with --reference-profile-file, keeping the methods and classes that are in");
+  UsageError("      enough of the inputs. Requires passing in dex files.");
+  UsageError("  --aggregation-method-threshold=percentage between 0 and 100");
+  UsageError("      the percentage of the input profiles that need to have a method.");
+  UsageError("  --aggregation-class-threshold=percentage between 0 and 100");
+  UsageError("      the percentage of the input profiles that need to have a class.");
+  UsageError("  --aggregation-threads=number: number of threads that load and merge the input");
+  UsageError("      profiles for --aggregate-profiles and --generate-boot-image-profile.");
   UsageError("  --copy-and-update-profile-key: if present, profman will copy the profile from");
   UsageError("      the file passed with --profile-fd(file) to the profile passed with");
   UsageError("      --reference-profile-fd(file) and update at the same time the profile-key");
@@ -198,6 +216,12 @@ NO_RETURN static void Usage(const char *fmt, ...) {
   UsageError("      the min percent of new methods to trigger a compilation.");
   UsageError("  --min-new-classes-percent-change=percentage between 0 and 100 (default 2)");
   UsageError("      the min percent of new classes to trigger a compilation.");
+  UsageError("  --min-new-methods-change=<number> (default 100)");
+  UsageError("      the min number of new methods to trigger a compilation, regardless of the");
+  UsageError("      percentage.");
+  UsageError("  --min-new-classes-change=<number> (default 50)");
+  UsageError("      the min number of new classes to trigger a compilation, regardless of the");
+  UsageError("      percentage.");
   UsageError("");
 
   exit(ProfmanResult::kErrorUsage);
@@ -208,6 +232,11 @@ static constexpr uint16_t kDefaultTestProfileNumDex = 20;
 static constexpr uint16_t kDefaultTestProfileMethodPercentage = 5;
 static constexpr uint16_t kDefaultTestProfileClassPercentage = 5;
 
+// Upper bound for --aggregation-threads.
+static constexpr uint32_t kMaxAggregationThreads = 64;
+// Upper bound for --boot-image-size-budget.
+static constexpr uint64_t kMaxBootImageSizeBudget = std::numeric_limits<int64_t>::max();
+
 // Separators used when parsing human friendly representation of profiles.
 static const std::string kMethodSep = "->";  // NOLINT [runtime/string] [4]
 static const std::string kClassAllMethods = "*";  // NOLINT [runtime/string] [4]
@@ -312,6 +341,7 @@ class ProfMan final {
       dump_only_(false),
       dump_classes_and_methods_(false),
       generate_boot_image_profile_(false),
+      aggregate_profiles_(false),
       output_profile_type_(OutputProfileType::kApp),
       dump_output_to_fd_(File::kInvalidFd),
       test_profile_num_dex_(kDefaultTestProfileNumDex),
@@ -354,6 +384,9 @@ class ProfMan final {
         dump_classes_and_methods_ = true;
       } else if (option.starts_with("--create-profile-from=")) {
         create_profile_from_file_ = std::string(option.substr(strlen("--create-profile-from=")));
+      } else if (option.starts_with("--create-profile-from-startup-trace=")) {
+        startup_trace_file_ =
+            std::string(option.substr(strlen("--create-profile-from-startup-trace=")));
       } else if (option.starts_with("--output-profile-type=")) {
         ParseOutputProfileType(option, "--output-profile-type=", &output_profile_type_);
       } else if (option.starts_with("--dump-output-to-fd=")) {
@@ -410,8 +443,38 @@ class ProfMan final {
         ParseBoolOption(option,
                         "--debug-append-uses=",
                         &boot_image_options_.append_package_use_list);
+      } else if (option == "--aggregate-profiles") {
+        aggregate_profiles_ = true;
+      } else if (option.starts_with("--aggregation-method-threshold=")) {
+        ParseUintOption(raw_option,
+                        "--aggregation-method-threshold=",
+                        &aggregation_options_.method_threshold,
+                        0u,
+                        100u);
+      } else if (option.starts_with("--aggregation-class-threshold=")) {
+        ParseUintOption(raw_option,
+                        "--aggregation-class-threshold=",
+                        &aggregation_options_.class_threshold,
+                        0u,
+                        100u);
+      } else if (option.starts_with("--aggregation-threads=")) {
+        ParseUintOption(raw_option,
+                        "--aggregation-threads=",
+                        &aggregation_options_.num_threads,
+                        1u,
+                        kMaxAggregationThreads);
+        boot_image_options_.num_threads = aggregation_options_.num_threads;
       } else if (option.starts_with("--out-profile-path=")) {
         boot_profile_out_path_ = std::string(option.substr(strlen("--out-profile-path=")));
+      } else if (option.starts_with("--boot-image-size-budget=")) {
+        ParseUintOption(raw_option,
+                        "--boot-image-size-budget=",
+                        &boot_image_options_.image_size_budget,
+                        UINT64_C(0),
+                        kMaxBootImageSizeBudget);
+      } else if (option.starts_with("--out-benefit-curve-path=")) {
+        boot_image_options_.benefit_curve_out_path =
+            std::string(option.substr(strlen("--out-benefit-curve-path=")));
       } else if (option.starts_with("--out-preloaded-classes-path=")) {
         preloaded_classes_out_path_ = std::string(
             option.substr(strlen("--out-preloaded-classes-path=")));
@@ -463,6 +526,14 @@ class ProfMan final {
                         100u);
         profile_assistant_options_.SetMinNewClassesPercentChangeForCompilation(
             min_new_classes_percent_change);
+      } else if (option.starts_with("--min-new-methods-change=")) {
+        uint32_t min_new_methods_change;
+        ParseUintOption(raw_option, "--min-new-methods-change=", &min_new_methods_change);
+        profile_assistant_options_.SetMinNewMethodsForCompilation(min_new_methods_change);
+      } else if (option.starts_with("--min-new-classes-change=")) {
+        uint32_t min_new_classes_change;
+        ParseUintOption(raw_option, "--min-new-classes-change=", &min_new_classes_change);
+        profile_assistant_options_.SetMinNewClassesForCompilation(min_new_classes_change);
       } else if (option == "--copy-and-update-profile-key") {
         copy_and_update_profile_key_ = true;
       } else if (option == "--boot-image-merge") {
@@ -1738,6 +1809,10 @@ class ProfMan final {
     return generate_boot_image_profile_;
   }
 
+  bool ShouldAggregateProfiles() const {
+    return aggregate_profiles_;
+  }
+
   OutputProfileType GetOutputProfileType() const {
     return output_profile_type_;
   }
@@ -1768,10 +1843,86 @@ class ProfMan final {
     return 0;
   }
 
+  // Aggregate the input profiles into the reference profile.
+  int AggregateProfiles() {
+    if (profile_files_.empty()) {
+      LOG(ERROR) << "At least one --profile-file must be specified.";
+      return -1;
+    }
+    if (reference_profile_file_.empty()) {
+      LOG(ERROR) << "--reference-profile-file must be specified.";
+      return -1;
+    }
+    std::vector<std::unique_ptr<const DexFile>> dex_files;
+    OpenApkFilesFromLocations(&dex_files);
+    if (dex_files.empty()) {
+      PLOG(ERROR) << "Expected dex files for aggregating profiles";
+      return -2;
+    }
+
+    if (!GenerateAggregatedProfile(
+            dex_files, profile_files_, aggregation_options_, reference_profile_file_)) {
+      LOG(ERROR) << "There was an error when aggregating the profiles";
+      return -4;
+    }
+    return 0;
+  }
+
   bool ShouldCreateProfile() {
     return !create_profile_from_file_.empty();
   }
 
+  bool ShouldCreateProfileFromStartupTrace() {
+    return !startup_trace_file_.empty();
+  }
+
+  // Creates an app profile from a startup trace written by the runtime.
+  int CreateProfileFromStartupTrace() {
+    if (apk_files_.empty() && apks_fd_.empty()) {
+      Usage("APK files must be specified");
+    }
+    if (dex_locations_.empty()) {
+      Usage("DEX locations must be specified");
+    }
+    if (reference_profile_file_.empty() && !FdIsValid(reference_profile_file_fd_)) {
+      Usage("Reference profile must be specified with --reference-profile-file or "
+            "--reference-profile-file-fd");
+    }
+    File trace_file(startup_trace_file_, O_RDONLY, /*check_usage=*/false);
+    if (trace_file.Fd() < 0) {
+      PLOG(ERROR) << "Cannot open startup trace " << startup_trace_file_;
+      return -1;
+    }
+    StartupTrace trace;
+    std::string error_msg;
+    if (!trace.Load(trace_file.Fd(), &error_msg)) {
+      LOG(ERROR) << "Cannot load startup trace " << startup_trace_file_ << ": " << error_msg;
+      return -1;
+    }
+
+    std::vector<std::unique_ptr<const DexFile>> dex_files;
+    OpenApkFilesFromLocations(&dex_files);
+    std::vector<const DexFile*> dex_file_ptrs;
+    for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+      dex_file_ptrs.push_back(dex_file.get());
+    }
+    ProfileCompilationInfo info;
+    if (!trace.ConvertTo(dex_file_ptrs, &info)) {
+      LOG(ERROR) << "Failed to convert startup trace " << startup_trace_file_;
+      return -1;
+    }
+
+    int fd = OpenReferenceProfile();
+    if (!FdIsValid(fd)) {
+      return -1;
+    }
+    CHECK(info.Save(fd));
+    if (close(fd) < 0) {
+      PLOG(WARNING) << "Failed to close descriptor";
+    }
+    return 0;
+  }
+
   int GenerateTestProfile() {
     // Validate parameters for this command.
     if (test_profile_method_percerntage_ > 100) {
@@ -1906,11 +2057,14 @@ class ProfMan final {
   bool dump_only_;
   bool dump_classes_and_methods_;
   bool generate_boot_image_profile_;
+  bool aggregate_profiles_;
   OutputProfileType output_profile_type_;
   int dump_output_to_fd_;
   BootImageOptions boot_image_options_;
+  ProfileAggregationOptions aggregation_options_;
   std::string test_profile_;
   std::string create_profile_from_file_;
+  std::string startup_trace_file_;
   uint16_t test_profile_num_dex_;
   uint16_t test_profile_method_percerntage_;
   uint16_t test_profile_class_percentage_;
@@ -1953,10 +2107,18 @@ static int profman(int argc, char** argv) {
     }
   }
 
+  if (profman.ShouldCreateProfileFromStartupTrace()) {
+    return profman.CreateProfileFromStartupTrace();
+  }
+
   if (profman.ShouldCreateBootImageProfile()) {
     return profman.CreateBootImageProfile();
   }
 
+  if (profman.ShouldAggregateProfiles()) {
+    return profman.AggregateProfiles();
+  }
+
   if (profman.ShouldCopyAndUpdateProfileKey()) {
     return profman.CopyAndUpdateProfileKey();
   }
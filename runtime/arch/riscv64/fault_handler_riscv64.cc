@@ -19,7 +19,10 @@
 #include <sys/ucontext.h>
 
 #include "arch/instruction_set.h"
+#include "base/bit_utils.h"
 #include "base/logging.h"  // For VLOG.
+#include "base/pointer_size.h"
+#include "thread-current-inl.h"
 
 extern "C" void art_quick_throw_stack_overflow();
 extern "C" void art_quick_throw_null_pointer_exception_from_signal();
@@ -84,9 +87,57 @@ bool NullPointerHandler::Action([[maybe_unused]] int sig, siginfo_t* info, void*
   return true;
 }
 
-bool SuspensionHandler::Action(int, siginfo_t*, void*) {
-  LOG(FATAL) << "SuspensionHandler::Action is not implemented for RISC-V";
-  return false;
+// A suspend check is done using the following instruction sequence:
+//      ld   t6, <suspend_trigger offset>(s1)
+//      lw   zero, 0(t6)
+// The compiler may use t5 instead of t6 if t6 is not available.
+// To check for a suspend check, we examine the instructions that caused the fault (at PC).
+bool SuspensionHandler::Action(int, siginfo_t*, void* context) {
+  ucontext_t* uc = reinterpret_cast<ucontext_t*>(context);
+  mcontext_t* mc = reinterpret_cast<mcontext_t*>(&uc->uc_mcontext);
+  uintptr_t pc = mc->__gregs[REG_PC];
+
+  // With the "C" Standard Extension, 32-bit instructions are only 2-byte aligned.
+  auto read_instruction = [](uintptr_t address) {
+    const uint16_t* halfwords = reinterpret_cast<const uint16_t*>(address);
+    return static_cast<uint32_t>(halfwords[0]) | (static_cast<uint32_t>(halfwords[1]) << 16);
+  };
+
+  // LW with imm=0, funct3=2, rd=Zero and opcode=0x03, with any base register `rs1`.
+  constexpr uint32_t kRs1Shift = 15u;
+  constexpr uint32_t kRs1Mask = 0x1fu << kRs1Shift;
+  uint32_t inst = read_instruction(pc);
+  VLOG(signals) << "checking suspend; inst: " << std::hex << inst;
+  if ((inst & 3u) != 3u || (inst & ~kRs1Mask) != 0x00002003u) {
+    // The instruction is not good, not ours.
+    return false;
+  }
+  uint32_t rs1 = (inst & kRs1Mask) >> kRs1Shift;
+
+  // LD with imm=<suspend trigger offset>, rs1=TR(S1), funct3=3, rd=`rs1` and opcode=0x03.
+  constexpr uint32_t kTr = 9u;  // S1
+  uint32_t trigger = Thread::ThreadSuspendTriggerOffset<kRiscv64PointerSize>().Uint32Value();
+  DCHECK(IsUint<11>(trigger));
+  uint32_t checkinst = (trigger << 20) | (kTr << kRs1Shift) | (3u << 12) | (rs1 << 7) | 0x03u;
+  if (read_instruction(pc - 4u) != checkinst) {
+    VLOG(signals) << "Not a suspend check match, first instruction mismatch";
+    return false;
+  }
+
+  // This is a suspend check.
+  VLOG(signals) << "suspend check match";
+
+  // Set RA so that after the suspend check it will resume after the
+  // `lw zero, 0(t6)` instruction that triggered the suspend check.
+  mc->__gregs[REG_RA] = pc + 4u;
+  // Arrange for the signal handler to return to `art_quick_implicit_suspend()`.
+  mc->__gregs[REG_PC] = reinterpret_cast<uintptr_t>(art_quick_implicit_suspend);
+
+  // Now remove the suspend trigger that caused this fault.
+  Thread::Current()->RemoveSuspendTrigger();
+  VLOG(signals) << "removed suspend trigger invoking test suspend";
+
+  return true;
 }
 
 bool StackOverflowHandler::Action([[maybe_unused]] int sig,
@@ -73,7 +73,11 @@ namespace art HIDDEN {
 
 extern "C" void art_quick_throw_null_pointer_exception_from_signal();
 extern "C" void art_quick_throw_stack_overflow();
+#if defined(__x86_64__)
+extern "C" void art_quick_implicit_suspend();
+#else
 extern "C" void art_quick_test_suspend();
+#endif
 
 // Get the size of an instruction in bytes.
 // Return 0 if the instruction is not handled.
@@ -330,15 +334,63 @@ bool NullPointerHandler::Action(int, siginfo_t* sig, void* context) {
   return true;
 }
 
+#if defined(__x86_64__)
+
+// A suspend check is done using the following instruction sequence:
+// 0x7f579de45d9e: 654C8B1C25A8000000      movq    r11, gs:[0xa8]  ; suspend_trigger
+// 0x7f579de45da7:             45851B      test    r11d, [r11]
+//
+// The offset from gs is Thread::ThreadSuspendTriggerOffset().
+// To check for a suspend check, we examine the instructions that caused the fault.
+bool SuspensionHandler::Action(int, siginfo_t*, void* context) {
+  uint32_t trigger = Thread::ThreadSuspendTriggerOffset<kRuntimePointerSize>().Int32Value();
+  const uint8_t checkinst1[] = {0x65, 0x4c, 0x8b, 0x1c, 0x25,
+                                static_cast<uint8_t>(trigger & 0xff),
+                                static_cast<uint8_t>((trigger >> 8) & 0xff),
+                                static_cast<uint8_t>((trigger >> 16) & 0xff),
+                                static_cast<uint8_t>((trigger >> 24) & 0xff)};
+  const uint8_t checkinst2[] = {0x45, 0x85, 0x1b};
+
+  ucontext_t* uc = reinterpret_cast<ucontext_t*>(context);
+  uint8_t* pc = reinterpret_cast<uint8_t*>(uc->CTX_EIP);
+  uint8_t* sp = reinterpret_cast<uint8_t*>(uc->CTX_ESP);
+
+  VLOG(signals) << "Checking for suspension point";
+  if (memcmp(pc, checkinst2, sizeof(checkinst2)) != 0) {
+    VLOG(signals) << "Not a suspension point";
+    return false;
+  }
+  // The compiler emits the two instructions back to back.
+  if (memcmp(pc - sizeof(checkinst1), checkinst1, sizeof(checkinst1)) != 0) {
+    VLOG(signals) << "Not a suspend check match, first instruction mismatch";
+    return false;
+  }
+
+  VLOG(signals) << "suspend check match";
+
+  // Push the return address so that after the suspend check it will resume after the
+  // `test r11d, [r11]` instruction that triggered the suspend check, as if the suspend
+  // entrypoint was called from there.
+  uintptr_t retaddr = reinterpret_cast<uintptr_t>(pc + sizeof(checkinst2));
+  uintptr_t* next_sp = reinterpret_cast<uintptr_t*>(sp - sizeof(uintptr_t));
+  *next_sp = retaddr;
+  uc->CTX_ESP = reinterpret_cast<uintptr_t>(next_sp);
+
+  // Arrange for the signal handler to return to `art_quick_implicit_suspend()`.
+  uc->CTX_EIP = reinterpret_cast<uintptr_t>(art_quick_implicit_suspend);
+
+  // Now remove the suspend trigger that caused this fault.
+  Thread::Current()->RemoveSuspendTrigger();
+  VLOG(signals) << "removed suspend trigger invoking implicit suspend";
+  return true;
+}
+
+#else
+
 // A suspend check is done using the following instruction sequence:
-// (x86)
 // 0xf720f1df:         648B058C000000      mov     eax, fs:[0x8c]  ; suspend_trigger
 // .. some intervening instructions.
 // 0xf720f1e6:                   8500      test    eax, [eax]
-// (x86_64)
-// 0x7f579de45d9e: 65488B0425A8000000      movq    rax, gs:[0xa8]  ; suspend_trigger
-// .. some intervening instructions.
-// 0x7f579de45da7:               8500      test    eax, [eax]
 
 // The offset from fs is Thread::ThreadSuspendTriggerOffset().
 // To check for a suspend check, we examine the instructions that caused
@@ -349,13 +401,8 @@ bool SuspensionHandler::Action(int, siginfo_t*, void* context) {
   uint32_t trigger = Thread::ThreadSuspendTriggerOffset<kRuntimePointerSize>().Int32Value();
 
   VLOG(signals) << "Checking for suspension point";
-#if defined(__x86_64__)
-  uint8_t checkinst1[] = {0x65, 0x48, 0x8b, 0x04, 0x25, static_cast<uint8_t>(trigger & 0xff),
-      static_cast<uint8_t>((trigger >> 8) & 0xff), 0, 0};
-#else
   uint8_t checkinst1[] = {0x64, 0x8b, 0x05, static_cast<uint8_t>(trigger & 0xff),
       static_cast<uint8_t>((trigger >> 8) & 0xff), 0, 0};
-#endif
   uint8_t checkinst2[] = {0x85, 0x00};
 
   ucontext_t* uc = reinterpret_cast<ucontext_t*>(context);
@@ -406,6 +453,8 @@ bool SuspensionHandler::Action(int, siginfo_t*, void* context) {
   return false;
 }
 
+#endif  // __x86_64__
+
 // The stack overflow check is done using the following instruction:
 // test eax, [esp+ -xxx]
 // where 'xxx' is the size of the overflow area.
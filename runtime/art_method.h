@@ -916,9 +916,11 @@ class EXPORT ArtMethod final {
 
   // Find the catch block for the given exception type and dex_pc. When a catch block is found,
   // indicates whether the found catch block is responsible for clearing the exception or whether
-  // a move-exception instruction is present.
+  // a move-exception instruction is present. If `all_types_resolved` is not null, it is set to
+  // false when a handler type that was checked could not be resolved, in which case the result
+  // may change once that type is loaded.
   uint32_t FindCatchBlock(Handle<mirror::Class> exception_type, uint32_t dex_pc,
-                          bool* has_no_move_exception)
+                          bool* has_no_move_exception, bool* all_types_resolved = nullptr)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   // NO_THREAD_SAFETY_ANALYSIS since we don't know what the callback requires.
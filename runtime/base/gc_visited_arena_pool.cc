@@ -117,6 +117,9 @@ GcVisitedArenaPool::GcVisitedArenaPool(bool low_4gb, bool is_zygote, const char*
     : lock_("gc-visited arena-pool", kGenericBottomLock),
       bytes_allocated_(0),
       unused_arenas_(nullptr),
+      cached_arena_bytes_(0),
+      arena_cache_hits_(0),
+      arena_cache_misses_(0),
       name_(name),
       defer_arena_freeing_(false),
       low_4gb_(low_4gb),
@@ -213,6 +216,21 @@ Arena* GcVisitedArenaPool::AllocArena(size_t size, bool single_obj_arena) {
     return *insert_result.first;
   }
 
+  // The most recently freed arena is the most likely to still be resident.
+  for (auto it = cached_arenas_.rbegin(); it != cached_arenas_.rend(); it++) {
+    if (it->second == size) {
+      uint8_t* addr = it->first;
+      cached_arenas_.erase(std::next(it).base());
+      cached_arena_bytes_ -= size;
+      arena_cache_hits_++;
+      auto insert_result = allocated_arenas_.insert(
+          new TrackedArena(addr, size, /*pre_zygote_fork=*/false, single_obj_arena));
+      DCHECK(insert_result.second);
+      return *insert_result.first;
+    }
+  }
+  arena_cache_misses_++;
+
   Chunk temp_chunk(nullptr, size);
   auto best_fit_iter = best_fit_allocs_.lower_bound(&temp_chunk);
   if (UNLIKELY(best_fit_iter == best_fit_allocs_.end())) {
@@ -333,6 +351,8 @@ void GcVisitedArenaPool::FreeArenaChain(Arena* first) {
   Thread* self = Thread::Current();
   // vector of arena ranges to be freed and whether they are pre-zygote-fork.
   std::vector<std::tuple<uint8_t*, size_t, bool>> free_ranges;
+  // vector of arena ranges to be cached and the number of bytes used in them.
+  std::vector<std::tuple<uint8_t*, size_t, size_t>> cache_ranges;
 
   {
     WriterMutexLock wmu(self, lock_);
@@ -340,7 +360,16 @@ void GcVisitedArenaPool::FreeArenaChain(Arena* first) {
       TrackedArena* temp = down_cast<TrackedArena*>(first);
       DCHECK(!temp->IsSingleObjectArena());
       first = first->Next();
-      free_ranges.emplace_back(temp->Begin(), temp->Size(), temp->IsPreZygoteForkArena());
+      // Don't cache arenas while the GC defers deletion, as it may still be
+      // processing their pages.
+      if (!temp->IsPreZygoteForkArena() &&
+          !defer_arena_freeing_ &&
+          cached_arena_bytes_ + temp->Size() <= kMaxCachedArenaBytes) {
+        cached_arena_bytes_ += temp->Size();
+        cache_ranges.emplace_back(temp->Begin(), temp->Size(), temp->GetBytesAllocated());
+      } else {
+        free_ranges.emplace_back(temp->Begin(), temp->Size(), temp->IsPreZygoteForkArena());
+      }
       // In other implementations of ArenaPool this is calculated when asked for,
       // thanks to the list of free arenas that is kept around. But in this case,
       // we release the freed arena back to the pool and therefore need to
@@ -370,8 +399,16 @@ void GcVisitedArenaPool::FreeArenaChain(Arena* first) {
       ZeroAndReleaseMemory(std::get<0>(iter), std::get<1>(iter));
     }
   }
+  // Cached arenas are zeroed but stay resident. Only the bytes handed out by
+  // the arena allocator can be dirty.
+  for (auto& iter : cache_ranges) {
+    std::fill_n(std::get<0>(iter), std::get<2>(iter), 0);
+  }
 
   WriterMutexLock wmu(self, lock_);
+  for (auto& iter : cache_ranges) {
+    cached_arenas_.emplace_back(std::get<0>(iter), std::get<1>(iter));
+  }
   for (auto& iter : free_ranges) {
     if (UNLIKELY(std::get<2>(iter))) {
       bool found = false;
@@ -391,6 +428,28 @@ void GcVisitedArenaPool::FreeArenaChain(Arena* first) {
   }
 }
 
+void GcVisitedArenaPool::TrimMaps() {
+  Thread* self = Thread::Current();
+  std::vector<std::pair<uint8_t*, size_t>> cached_arenas;
+  {
+    WriterMutexLock wmu(self, lock_);
+    VLOG(heap) << name_ << " arena cache: " << arena_cache_hits_ << " hits, "
+               << arena_cache_misses_ << " misses, releasing " << PrettySize(cached_arena_bytes_);
+    cached_arenas.swap(cached_arenas_);
+    cached_arena_bytes_ = 0;
+  }
+  if (cached_arenas.empty()) {
+    return;
+  }
+  for (auto& [begin, size] : cached_arenas) {
+    ZeroAndReleaseMemory(begin, size);
+  }
+  WriterMutexLock wmu(self, lock_);
+  for (auto& [begin, size] : cached_arenas) {
+    FreeRangeLocked(begin, size);
+  }
+}
+
 void GcVisitedArenaPool::DeleteUnusedArenas() {
   TrackedArena* arena;
   {
@@ -18,6 +18,8 @@
 #define ART_RUNTIME_BASE_GC_VISITED_ARENA_POOL_H_
 
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "base/allocator.h"
 #include "base/arena_allocator.h"
@@ -137,6 +139,9 @@ class GcVisitedArenaPool final : public ArenaPool {
 #else
   static constexpr size_t kLinearAllocPoolSize = 32 * MB;
 #endif
+  // Maximum number of bytes of freed arenas that are kept zeroed but resident
+  // for reuse, instead of being released to the kernel. See cached_arenas_.
+  static constexpr size_t kMaxCachedArenaBytes = 2 * MB;
 
   explicit GcVisitedArenaPool(bool low_4gb = false,
                               bool is_zygote = false,
@@ -153,7 +158,8 @@ class GcVisitedArenaPool final : public ArenaPool {
   size_t GetBytesAllocated() const override REQUIRES(!lock_);
   void ReclaimMemory() override {}
   void LockReclaimMemory() override {}
-  void TrimMaps() override {}
+  // Release the cached arenas. Called when the heap is trimmed.
+  void TrimMaps() override REQUIRES(!lock_);
 
   EXPORT uint8_t* AllocSingleObjArena(size_t size) REQUIRES(!lock_);
   EXPORT void FreeSingleObjArena(uint8_t* addr) REQUIRES(!lock_);
@@ -267,6 +273,14 @@ class GcVisitedArenaPool final : public ArenaPool {
   // To hold arenas that are freed while GC is happening. These are kept until
   // the end of GC to avoid ABA problem.
   TrackedArena* unused_arenas_ GUARDED_BY(lock_);
+  // Ranges (begin, size) of recently freed arenas which are zeroed but not
+  // released, so that class-loading bursts don't fault in fresh pages. Reused
+  // in LIFO order for arenas of the same size.
+  std::vector<std::pair<uint8_t*, size_t>> cached_arenas_ GUARDED_BY(lock_);
+  size_t cached_arena_bytes_ GUARDED_BY(lock_);
+  // Number of AllocArena() calls served from, or missing, cached_arenas_.
+  uint64_t arena_cache_hits_ GUARDED_BY(lock_);
+  uint64_t arena_cache_misses_ GUARDED_BY(lock_);
   const char* name_;
   // Flag to indicate that some arenas have been freed. This flag is used as an
   // optimization by GC to know if it needs to find if the arena being visited
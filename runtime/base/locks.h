@@ -78,6 +78,7 @@ enum LockLevel : uint8_t {
   kCustomTlsLock,
   kJniFunctionTableLock,
   kJniWeakGlobalsLock,
+  kJniGlobalsShardLock,
   kJniGlobalsLock,
   kReferenceQueueSoftReferencesLock,
   kReferenceQueuePhantomReferencesLock,
@@ -19,7 +19,9 @@
 #include <errno.h>
 #include <sys/time.h>
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 #include "android-base/stringprintf.h"
 
@@ -166,14 +168,33 @@ class ScopedAllMutexesLock final {
   const BaseMutex* const mutex_;
 };
 
+// Sampled lock contentions aggregated per lock name, see `BaseMutex::SetContentionSampleRate()`.
+// Entries are claimed by CAS on the name and updated with relaxed atomics. The profile is only
+// used for diagnostics, so races between updates of different fields are acceptable.
+struct ContentionProfileEntry {
+  Atomic<const char*> name;
+  Atomic<uint64_t> count;
+  Atomic<uint64_t> wait_time;
+  Atomic<uint64_t> max_wait_time;
+  Atomic<uint64_t> max_wait_owner_tid;
+};
+static constexpr size_t kContentionProfileSize = 256;
+static constexpr size_t kContentionProfileMaxProbes = 16;
+static constexpr size_t kContentionProfileMaxDumped = 32;
+static ContentionProfileEntry gContentionProfile[kContentionProfileSize];
+static Atomic<uint64_t> gContentionProfileDropped(0);
+static Atomic<uint32_t> gContentionSampleRate(0);
+static Atomic<uint32_t> gContentionSampleCounter(0);
+
 // Scoped class that generates events at the beginning and end of lock contention.
 class ScopedContentionRecorder final : public ValueObject {
  public:
   ScopedContentionRecorder(BaseMutex* mutex, uint64_t blocked_tid, uint64_t owner_tid)
-      : mutex_(kLogLockContentions ? mutex : nullptr),
+      : mutex_(mutex),
         blocked_tid_(kLogLockContentions ? blocked_tid : 0),
-        owner_tid_(kLogLockContentions ? owner_tid : 0),
-        start_nano_time_(kLogLockContentions ? NanoTime() : 0) {
+        owner_tid_(owner_tid),
+        sampled_(!kLogLockContentions && BaseMutex::ShouldSampleContention()),
+        start_nano_time_((kLogLockContentions || sampled_) ? NanoTime() : 0) {
     if (ATraceEnabled()) {
       std::string msg = StringPrintf("Lock contention on %s (owner tid: %" PRIu64 ")",
                                      mutex->GetName(), owner_tid);
@@ -186,6 +207,8 @@ class ScopedContentionRecorder final : public ValueObject {
     if (kLogLockContentions) {
       uint64_t end_nano_time = NanoTime();
       mutex_->RecordContention(blocked_tid_, owner_tid_, end_nano_time - start_nano_time_);
+    } else if (UNLIKELY(sampled_)) {
+      mutex_->RecordSampledContention(owner_tid_, NanoTime() - start_nano_time_);
     }
   }
 
@@ -193,6 +216,7 @@ class ScopedContentionRecorder final : public ValueObject {
   BaseMutex* const mutex_;
   const uint64_t blocked_tid_;
   const uint64_t owner_tid_;
+  const bool sampled_;
   const uint64_t start_nano_time_;
 };
 
@@ -219,7 +243,88 @@ BaseMutex::~BaseMutex() {
   }
 }
 
+void BaseMutex::SetContentionSampleRate(uint32_t rate) {
+  gContentionSampleRate.store(rate, std::memory_order_relaxed);
+}
+
+bool BaseMutex::ShouldSampleContention() {
+  uint32_t rate = gContentionSampleRate.load(std::memory_order_relaxed);
+  // Contention is the slow path, an atomic increment is cheap compared to the futex wait.
+  return rate != 0u &&
+         gContentionSampleCounter.fetch_add(1u, std::memory_order_relaxed) % rate == 0u;
+}
+
+void BaseMutex::RecordSampledContention(uint64_t owner_tid, uint64_t nano_time_blocked) const {
+  size_t index = (reinterpret_cast<uintptr_t>(name_) >> 3) % kContentionProfileSize;
+  for (size_t i = 0; i != kContentionProfileMaxProbes; ++i) {
+    ContentionProfileEntry& entry = gContentionProfile[(index + i) % kContentionProfileSize];
+    const char* name = entry.name.load(std::memory_order_relaxed);
+    if (name == nullptr) {
+      if (entry.name.CompareAndSetStrongRelaxed(nullptr, name_)) {
+        name = name_;
+      } else {
+        name = entry.name.load(std::memory_order_relaxed);
+      }
+    }
+    if (name != name_) {
+      continue;
+    }
+    entry.count.fetch_add(1u, std::memory_order_relaxed);
+    entry.wait_time.fetch_add(nano_time_blocked, std::memory_order_relaxed);
+    uint64_t max_wait_time = entry.max_wait_time.load(std::memory_order_relaxed);
+    while (nano_time_blocked > max_wait_time) {
+      if (entry.max_wait_time.CompareAndSetWeakRelaxed(max_wait_time, nano_time_blocked)) {
+        entry.max_wait_owner_tid.store(owner_tid, std::memory_order_relaxed);
+        break;
+      }
+      max_wait_time = entry.max_wait_time.load(std::memory_order_relaxed);
+    }
+    return;
+  }
+  gContentionProfileDropped.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void BaseMutex::DumpContentionProfile(std::ostream& os) {
+  uint32_t rate = gContentionSampleRate.load(std::memory_order_relaxed);
+  if (rate == 0u) {
+    return;
+  }
+  std::vector<const ContentionProfileEntry*> entries;
+  for (const ContentionProfileEntry& entry : gContentionProfile) {
+    if (entry.name.load(std::memory_order_relaxed) != nullptr &&
+        entry.count.load(std::memory_order_relaxed) != 0u) {
+      entries.push_back(&entry);
+    }
+  }
+  std::sort(entries.begin(),
+            entries.end(),
+            [](const ContentionProfileEntry* lhs, const ContentionProfileEntry* rhs) {
+              return lhs->wait_time.load(std::memory_order_relaxed) >
+                     rhs->wait_time.load(std::memory_order_relaxed);
+            });
+  os << "Lock contention profile (1 in " << rate << " contentions sampled):\n";
+  for (size_t i = 0; i != std::min(entries.size(), kContentionProfileMaxDumped); ++i) {
+    const ContentionProfileEntry* entry = entries[i];
+    uint64_t count = entry->count.load(std::memory_order_relaxed);
+    uint64_t wait_time = entry->wait_time.load(std::memory_order_relaxed);
+    os << "  " << entry->name.load(std::memory_order_relaxed)
+       << ": sampled=" << count
+       << " total wait=" << PrettyDuration(wait_time)
+       << " average=" << PrettyDuration(wait_time / count)
+       << " max=" << PrettyDuration(entry->max_wait_time.load(std::memory_order_relaxed))
+       << " (owner tid=" << entry->max_wait_owner_tid.load(std::memory_order_relaxed) << ")\n";
+  }
+  if (entries.size() > kContentionProfileMaxDumped) {
+    os << "  ... " << (entries.size() - kContentionProfileMaxDumped) << " more locks\n";
+  }
+  uint64_t dropped = gContentionProfileDropped.load(std::memory_order_relaxed);
+  if (dropped != 0u) {
+    os << "  " << dropped << " samples dropped, profile table full\n";
+  }
+}
+
 void BaseMutex::DumpAll(std::ostream& os) {
+  DumpContentionProfile(os);
   if (kLogLockContentions) {
     os << "Mutex logging:\n";
     ScopedAllMutexesLock mu(reinterpret_cast<const BaseMutex*>(-1));
@@ -633,12 +738,11 @@ bool Mutex::ExclusiveTryLock(Thread* self) {
 template bool Mutex::ExclusiveTryLock<false>(Thread* self);
 template bool Mutex::ExclusiveTryLock<true>(Thread* self);
 
-bool Mutex::ExclusiveTryLockWithSpinning(Thread* self) {
+bool Mutex::ExclusiveTryLockWithSpinning(Thread* self, uint32_t max_spins) {
   // Spin a small number of times, since this affects our ability to respond to suspension
   // requests. We spin repeatedly only if the mutex repeatedly becomes available and unavailable
   // in rapid succession, and then we will typically not spin for the maximal period.
-  const int kMaxSpins = 5;
-  for (int i = 0; i < kMaxSpins; ++i) {
+  for (uint32_t i = 0; i < max_spins; ++i) {
     if (ExclusiveTryLock(self)) {
       return true;
     }
@@ -85,7 +85,12 @@ class BaseMutex {
 
   virtual void Dump(std::ostream& os) const = 0;
 
-  static void DumpAll(std::ostream& os);
+  EXPORT static void DumpAll(std::ostream& os);
+
+  // Sample one in `rate` lock contentions, or none if `rate` is 0. Sampled contentions are
+  // aggregated per lock name and dumped by `DumpAll()`. Unlike `kLogLockContentions`, this
+  // can be enabled at runtime with `-XX:LockContentionSampleRate`.
+  EXPORT static void SetContentionSampleRate(uint32_t rate);
 
   bool ShouldRespondToEmptyCheckpointRequest() const {
     return should_respond_to_empty_checkpoint_request_;
@@ -119,6 +124,10 @@ class BaseMutex {
   void RecordContention(uint64_t blocked_tid, uint64_t owner_tid, uint64_t nano_time_blocked);
   void DumpContention(std::ostream& os) const;
 
+  static bool ShouldSampleContention();
+  void RecordSampledContention(uint64_t owner_tid, uint64_t nano_time_blocked) const;
+  static void DumpContentionProfile(std::ostream& os);
+
   const char* const name_;
 
   // A log entry that records contention but makes no guarantee that either tid will be held live.
@@ -191,7 +200,10 @@ class EXPORT LOCKABLE Mutex : public BaseMutex {
   bool ExclusiveTryLock(Thread* self) TRY_ACQUIRE(true);
   bool TryLock(Thread* self) TRY_ACQUIRE(true) { return ExclusiveTryLock(self); }
   // Equivalent to ExclusiveTryLock, but retry for a short period before giving up.
-  bool ExclusiveTryLockWithSpinning(Thread* self) TRY_ACQUIRE(true);
+  // The `max_spins` argument bounds the number of times we wait for the mutex to be released.
+  static constexpr uint32_t kDefaultMaxSpins = 5;
+  bool ExclusiveTryLockWithSpinning(Thread* self, uint32_t max_spins = kDefaultMaxSpins)
+      TRY_ACQUIRE(true);
 
   // Release exclusive access.
   void ExclusiveUnlock(Thread* self) RELEASE();
@@ -16,6 +16,9 @@
 
 #include "mutex-inl.h"
 
+#include <sstream>
+#include <thread>
+
 #include "common_runtime_test.h"
 #include "thread-current-inl.h"
 
@@ -179,4 +182,31 @@ TEST_F(MutexTest, SharedTryLockUnlock) {
   SharedTryLockUnlockTest();
 }
 
+static bool ContendOnce(Mutex& mu) NO_THREAD_SAFETY_ANALYSIS {
+  mu.Lock(Thread::Current());
+  std::thread contender([&mu]() NO_THREAD_SAFETY_ANALYSIS {
+    // Not attached to the runtime.
+    mu.Lock(nullptr);
+    mu.Unlock(nullptr);
+  });
+  usleep(10 * 1000);
+  mu.Unlock(Thread::Current());
+  contender.join();
+  std::ostringstream oss;
+  BaseMutex::DumpAll(oss);
+  return oss.str().find("sampled contention test mutex") != std::string::npos;
+}
+
+TEST_F(MutexTest, ContentionSampling) {
+  Mutex mu("sampled contention test mutex");
+  BaseMutex::SetContentionSampleRate(1u);
+  // The contender may not reach the lock before it is released, retry a few times.
+  bool found = false;
+  for (size_t i = 0; i != 100u && !found; ++i) {
+    found = ContendOnce(mu);
+  }
+  BaseMutex::SetContentionSampleRate(0u);
+  EXPECT_TRUE(found);
+}
+
 }  // namespace art
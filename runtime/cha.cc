@@ -675,6 +675,7 @@ void ClassHierarchyAnalysis::InvalidateSingleImplementationMethods(
         jit::JitCodeCache* code_cache = jit->GetCodeCache();
         for (const auto& pair : headers) {
           code_cache->InvalidateCompiledCodeFor(pair.first, pair.second);
+          code_cache->RecordChaInvalidation(pair.first);
         }
       }
     }
@@ -64,6 +64,7 @@
 #include "cha.h"
 #include "class_linker-inl.h"
 #include "class_loader_utils.h"
+#include "class_path_index.h"
 #include "class_root-inl.h"
 #include "class_table-inl.h"
 #include "compiler_callbacks.h"
@@ -88,6 +89,7 @@
 #include "gc/scoped_gc_critical_section.h"
 #include "gc/space/image_space.h"
 #include "gc/space/space-inl.h"
+#include "gc/task_processor.h"
 #include "gc_root-inl.h"
 #include "handle_scope-inl.h"
 #include "hidden_api.h"
@@ -99,6 +101,8 @@
 #include "jit/debugger_interface.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
+#include "jit/profile_sampler.h"
+#include "jit/startup_trace_recorder.h"
 #include "jni/java_vm_ext.h"
 #include "jni/jni_internal.h"
 #include "linear_alloc-inl.h"
@@ -150,6 +154,7 @@
 #include "runtime_callbacks.h"
 #include "scoped_assert_no_transaction_checks.h"
 #include "scoped_thread_state_change-inl.h"
+#include "stack_map_cache.h"
 #include "startup_completed_task.h"
 #include "thread-inl.h"
 #include "thread.h"
@@ -635,6 +640,8 @@ ClassLinker::ClassLinker(InternTable* intern_table, bool fast_class_not_found_ex
       visibly_initialize_classes_with_membarier_(RegisterMemBarrierForClassInitialization()),
       critical_native_code_with_clinit_check_lock_("critical native code with clinit check lock"),
       critical_native_code_with_clinit_check_(),
+      class_loader_deletion_lock_("class loader deletion lock"),
+      class_loaders_to_delete_(),
       boot_image_jni_stubs_(JniStubKeyHash(Runtime::Current()->GetInstructionSet()),
                             JniStubKeyEquals(Runtime::Current()->GetInstructionSet())),
       cha_(Runtime::Current()->IsAotCompiler() ? nullptr : new ClassHierarchyAnalysis()) {
@@ -2693,6 +2700,7 @@ ClassLinker::~ClassLinker() {
     delete data.class_table;
   }
   class_loaders_.clear();
+  DeletePendingClassLoaders(self);
   while (!running_visibly_initialized_callbacks_.empty()) {
     std::unique_ptr<VisiblyInitializedCallback> callback(
         std::addressof(running_visibly_initialized_callbacks_.front()));
@@ -2717,6 +2725,9 @@ void ClassLinker::PrepareToDeleteClassLoader(Thread* self,
     // If we don't have a JIT, we need to manually remove the CHA dependencies manually.
     cha_->RemoveDependenciesForLinearAlloc(self, data.allocator);
   }
+  // Remove samples of methods that will be deleted.
+  ProfileSampler::RemoveMethodsIn(self, *data.allocator);
+  StartupTraceRecorder::RemoveMethodsIn(self, *data.allocator);
   // Cleanup references to single implementation ArtMethods that will be deleted.
   if (cleanup_cha) {
     CHAOnDeleteUpdateClassVisitor visitor(data.allocator);
@@ -2735,6 +2746,27 @@ void ClassLinker::PrepareToDeleteClassLoader(Thread* self,
   }
 }
 
+class ClassLinker::DeleteClassLoadersTask final : public gc::HeapTask {
+ public:
+  DeleteClassLoadersTask() : gc::HeapTask(NanoTime()) {}
+
+  void Run(Thread* self) override {
+    Runtime::Current()->GetClassLinker()->DeletePendingClassLoaders(self);
+  }
+};
+
+void ClassLinker::DeletePendingClassLoaders(Thread* self) {
+  std::list<ClassLoaderData> to_delete;
+  {
+    MutexLock mu(self, class_loader_deletion_lock_);
+    to_delete.swap(class_loaders_to_delete_);
+  }
+  for (const ClassLoaderData& data : to_delete) {
+    delete data.allocator;
+    delete data.class_table;
+  }
+}
+
 ObjPtr<mirror::PointerArray> ClassLinker::AllocPointerArray(Thread* self, size_t length) {
   return ObjPtr<mirror::PointerArray>::DownCast(
       image_pointer_size_ == PointerSize::k64
@@ -3180,6 +3212,84 @@ bool ClassLinker::FindClassInBootClassLoaderClassPath(Thread* self,
   return true;
 }
 
+// Class paths with at least this many dex files get a `ClassPathIndex` once a lookup visited
+// them all, so that further lookups probe only the dex files that may define the class.
+static constexpr size_t kMinDexFilesForClassPathIndex = 8u;
+
+static ObjPtr<mirror::ObjectArray<mirror::Object>> GetDexElements(
+    ObjPtr<mirror::ClassLoader> class_loader) REQUIRES_SHARED(Locks::mutator_lock_) {
+  ObjPtr<mirror::Object> dex_path_list =
+      WellKnownClasses::dalvik_system_BaseDexClassLoader_pathList->GetObject(class_loader);
+  if (dex_path_list == nullptr) {
+    return nullptr;
+  }
+  ObjPtr<mirror::Object> dex_elements =
+      WellKnownClasses::dalvik_system_DexPathList_dexElements->GetObject(dex_path_list);
+  return dex_elements != nullptr ? dex_elements->AsObjectArray<mirror::Object>() : nullptr;
+}
+
+// Returns the mCookie of the dalvik.system.DexFile of the given DexPathList$Element, or null.
+static ObjPtr<mirror::LongArray> GetDexElementCookie(ObjPtr<mirror::Object> element)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (element == nullptr) {
+    return nullptr;
+  }
+  ObjPtr<mirror::Object> dex_file =
+      WellKnownClasses::dalvik_system_DexPathList__Element_dexFile->GetObject(element);
+  if (dex_file == nullptr) {
+    return nullptr;
+  }
+  ObjPtr<mirror::Object> cookie =
+      WellKnownClasses::dalvik_system_DexFile_cookie->GetObject(dex_file);
+  return cookie != nullptr ? cookie->AsLongArray() : nullptr;
+}
+
+// Returns the dex file at `location` in `dex_elements`, or null if it has been closed.
+static const DexFile* GetClassPathDexFile(ObjPtr<mirror::ObjectArray<mirror::Object>> dex_elements,
+                                          ClassPathIndex::Location location)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (location.element_index >= static_cast<uint32_t>(dex_elements->GetLength())) {
+    return nullptr;
+  }
+  ObjPtr<mirror::LongArray> cookie =
+      GetDexElementCookie(dex_elements->GetWithoutChecks(location.element_index));
+  if (cookie == nullptr || location.cookie_index >= static_cast<uint32_t>(cookie->GetLength())) {
+    return nullptr;
+  }
+  return reinterpret_cast<const DexFile*>(
+      static_cast<uintptr_t>(cookie->GetWithoutChecks(location.cookie_index)));
+}
+
+static std::unique_ptr<const ClassPathIndex> CreateClassPathIndex(
+    ObjPtr<mirror::ObjectArray<mirror::Object>> dex_elements)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  std::vector<const DexFile*> dex_files;
+  std::vector<ClassPathIndex::Location> locations;
+  for (int32_t i = 0, length = dex_elements->GetLength(); i != length; ++i) {
+    ObjPtr<mirror::Object> element = dex_elements->GetWithoutChecks(i);
+    if (element == nullptr) {
+      // Should never happen. `VisitClassLoaderDexElements()` stops at the first null element.
+      break;
+    }
+    ObjPtr<mirror::LongArray> cookie = GetDexElementCookie(element);
+    if (cookie == nullptr) {
+      continue;
+    }
+    // First element is the oat file.
+    for (int32_t j = kDexFileIndexStart, cookie_length = cookie->GetLength(); j < cookie_length;
+         ++j) {
+      const DexFile* dex_file =
+          reinterpret_cast<const DexFile*>(static_cast<uintptr_t>(cookie->GetWithoutChecks(j)));
+      if (dex_file != nullptr) {
+        dex_files.push_back(dex_file);
+        locations.push_back({.element_index = static_cast<uint32_t>(i),
+                             .cookie_index = static_cast<uint32_t>(j)});
+      }
+    }
+  }
+  return ClassPathIndex::Create(dex_files, std::move(locations));
+}
+
 bool ClassLinker::FindClassInBaseDexClassLoaderClassPath(
     Thread* self,
     const char* descriptor,
@@ -3193,8 +3303,9 @@ bool ClassLinker::FindClassInBaseDexClassLoaderClassPath(
 
   const DexFile* dex_file = nullptr;
   const dex::ClassDef* class_def = nullptr;
-  ObjPtr<mirror::Class> ret;
+  size_t num_visited_dex_files = 0u;
   auto find_class_def = [&](const DexFile* cp_dex_file) REQUIRES_SHARED(Locks::mutator_lock_) {
+    ++num_visited_dex_files;
     const dex::ClassDef* cp_class_def = OatDexFile::FindClassDef(*cp_dex_file, descriptor, hash);
     if (cp_class_def != nullptr) {
       dex_file = cp_dex_file;
@@ -3203,7 +3314,35 @@ bool ClassLinker::FindClassInBaseDexClassLoaderClassPath(
     }
     return true;  // Continue with the next DexFile.
   };
-  VisitClassLoaderDexFiles(self, class_loader, find_class_def);
+
+  ClassTable* class_table = class_loader->GetClassTable();
+  ObjPtr<mirror::ObjectArray<mirror::Object>> dex_elements = GetDexElements(class_loader.Get());
+  bool used_index = false;
+  if (class_table != nullptr && dex_elements != nullptr) {
+    used_index = class_table->VisitClassPathIndex(
+        dex_elements, [&](const ClassPathIndex& index) REQUIRES_SHARED(Locks::mutator_lock_) {
+          index.VisitCandidates(
+              static_cast<uint32_t>(hash),
+              [&](ClassPathIndex::Location location) REQUIRES_SHARED(Locks::mutator_lock_) {
+                const DexFile* cp_dex_file = GetClassPathDexFile(dex_elements, location);
+                return cp_dex_file == nullptr || find_class_def(cp_dex_file);
+              });
+        });
+  }
+  if (!used_index) {
+    VisitClassLoaderDexFiles(self, class_loader, find_class_def);
+    if (num_visited_dex_files >= kMinDexFilesForClassPathIndex &&
+        class_table != nullptr &&
+        dex_elements != nullptr &&
+        !Runtime::Current()->IsAotCompiler()) {
+      std::unique_ptr<const ClassPathIndex> index = CreateClassPathIndex(dex_elements);
+      if (index != nullptr) {
+        VLOG(class_linker) << "Created class path index for " << index->GetNumberOfDexFiles()
+                           << " dex files, " << index->GetMemoryUsage() << " bytes";
+        class_table->SetClassPathIndex(dex_elements, std::move(index));
+      }
+    }
+  }
 
   if (class_def != nullptr) {
     *result = DefineClass(self, descriptor, hash, class_loader, *dex_file, *class_def);
@@ -4145,6 +4284,9 @@ void ClassLinker::LoadMethod(const DexFile& dex_file,
       access_flags |=
           annotations::GetNativeMethodAnnotationAccessFlags(dex_file, *method_annotations);
     }
+    if ((access_flags & (kAccFastNative | kAccCriticalNative)) == 0u) {
+      access_flags |= Runtime::Current()->GetAllowlistedNativeAccessFlags(dex_file, dex_method_idx);
+    }
     dst->SetAccessFlags(access_flags);
     DCHECK(!dst->IsAbstract());
     DCHECK(!dst->HasCodeItem());
@@ -6664,6 +6806,15 @@ static ObjPtr<mirror::Class> GetImtOwner(ObjPtr<mirror::Class> klass)
   return nullptr;
 }
 
+// Hashed conflict tables depend on the addresses of the interface methods, so they are not
+// used for tables that may be written to an image and relocated.
+static_assert(ArtMethod::Size(PointerSize::k64) >= (1u << ImtConflictTable::kHashShift),
+              "Adjacent ArtMethods should hash to different conflict table slots");
+static bool UseHashedImtConflictTable(size_t num_entries, PointerSize pointer_size) {
+  return !Runtime::Current()->IsAotCompiler() &&
+         ImtConflictTable::CanUseHashedTable(num_entries, pointer_size);
+}
+
 ArtMethod* ClassLinker::AddMethodToConflictTable(ObjPtr<mirror::Class> klass,
                                                  ArtMethod* conflict_method,
                                                  ArtMethod* interface_method,
@@ -6690,10 +6841,13 @@ ArtMethod* ClassLinker::AddMethodToConflictTable(ObjPtr<mirror::Class> klass,
       : conflict_method;
 
   // Allocate a new table. Note that we will leak this table at the next conflict,
-  // but that's a tradeoff compared to making the table fixed size.
+  // but that's a tradeoff compared to making the table fixed size. Large tables are
+  // rebuilt with the hashed layout.
+  bool hashed = UseHashedImtConflictTable(current_table->NumEntries(image_pointer_size_) + 1u,
+                                          image_pointer_size_);
   void* data = linear_alloc->Alloc(
       Thread::Current(),
-      ImtConflictTable::ComputeSizeWithOneMoreEntry(current_table, image_pointer_size_),
+      ImtConflictTable::ComputeSizeWithOneMoreEntry(current_table, image_pointer_size_, hashed),
       LinearAllocKind::kNoGCRoots);
   if (data == nullptr) {
     LOG(ERROR) << "Failed to allocate conflict table";
@@ -6702,7 +6856,8 @@ ArtMethod* ClassLinker::AddMethodToConflictTable(ObjPtr<mirror::Class> klass,
   ImtConflictTable* new_table = new (data) ImtConflictTable(current_table,
                                                             interface_method,
                                                             method,
-                                                            image_pointer_size_);
+                                                            image_pointer_size_,
+                                                            hashed);
 
   // Do a fence to ensure threads see the data in the table before it is assigned
   // to the conflict method.
@@ -6806,15 +6961,21 @@ void ClassLinker::FillIMTAndConflictTables(ObjPtr<mirror::Class> klass) {
 
 ImtConflictTable* ClassLinker::CreateImtConflictTable(size_t count,
                                                       LinearAlloc* linear_alloc,
-                                                      PointerSize image_pointer_size) {
+                                                      PointerSize image_pointer_size,
+                                                      bool hashed) {
   void* data = linear_alloc->Alloc(Thread::Current(),
-                                   ImtConflictTable::ComputeSize(count, image_pointer_size),
+                                   ImtConflictTable::ComputeSize(count, image_pointer_size, hashed),
                                    LinearAllocKind::kNoGCRoots);
-  return (data != nullptr) ? new (data) ImtConflictTable(count, image_pointer_size) : nullptr;
+  return (data != nullptr)
+      ? new (data) ImtConflictTable(count, image_pointer_size, hashed)
+      : nullptr;
 }
 
 ImtConflictTable* ClassLinker::CreateImtConflictTable(size_t count, LinearAlloc* linear_alloc) {
-  return CreateImtConflictTable(count, linear_alloc, image_pointer_size_);
+  return CreateImtConflictTable(count,
+                                linear_alloc,
+                                image_pointer_size_,
+                                UseHashedImtConflictTable(count, image_pointer_size_));
 }
 
 void ClassLinker::FillIMTFromIfTable(ObjPtr<mirror::IfTable> if_table,
@@ -6916,9 +7077,7 @@ void ClassLinker::FillIMTFromIfTable(ObjPtr<mirror::IfTable> if_table,
           continue;
         }
         ImtConflictTable* table = imt[imt_index]->GetImtConflictTable(image_pointer_size_);
-        const size_t num_entries = table->NumEntries(image_pointer_size_);
-        table->SetInterfaceMethod(num_entries, image_pointer_size_, interface_method);
-        table->SetImplementationMethod(num_entries, image_pointer_size_, implementation_method);
+        table->AddEntry(interface_method, implementation_method, image_pointer_size_);
       }
     }
   }
@@ -10696,6 +10855,15 @@ void ClassLinker::DumpForSigQuit(std::ostream& os) {
     }
   }
   os << "Done dumping class loaders\n";
+  os << "Dumping dex cache sizes\n";
+  for (const auto& entry : dex_caches_) {
+    ObjPtr<mirror::DexCache> dex_cache =
+        ObjPtr<mirror::DexCache>::DownCast(soa.Self()->DecodeJObject(entry.second.weak_root));
+    if (dex_cache != nullptr) {
+      dex_cache->DumpCacheSizes(os);
+    }
+  }
+  os << "Done dumping dex cache sizes\n";
   Runtime* runtime = Runtime::Current();
   os << "Classes initialized: " << runtime->GetStat(KIND_GLOBAL_CLASS_INIT_COUNT) << " in "
      << PrettyDuration(runtime->GetStat(KIND_GLOBAL_CLASS_INIT_TIME)) << "\n";
@@ -10978,6 +11146,9 @@ void ClassLinker::CleanupClassLoaders() {
   if (to_delete.empty()) {
     return;
   }
+  // Exception delivery caches catch handlers keyed by `ArtMethod`s and exception classes that
+  // are about to be freed.
+  StackMapCache::InvalidateAll();
   std::set<const OatFile*> unregistered_oat_files;
   JavaVMExt* vm = self->GetJniEnv()->GetVm();
   {
@@ -11009,11 +11180,26 @@ void ClassLinker::CleanupClassLoaders() {
       PrepareToDeleteClassLoader(self, data, /*cleanup_cha=*/true);
     }
   }
-  for (const ClassLoaderData& data : to_delete) {
-    delete data.allocator;
-    delete data.class_table;
-  }
   Runtime* runtime = Runtime::Current();
+  // Releasing the arenas of the allocators can take a while, so leave it to a heap task when
+  // possible. The userfaultfd GC visits all the linear-alloc arenas, including the ones of
+  // unloaded class loaders, so it needs them to be gone before its compaction phase.
+  if (!gUseUserfaultfd && runtime->GetHeap()->GetTaskProcessor()->IsRunning()) {
+    bool add_task;
+    {
+      MutexLock mu(self, class_loader_deletion_lock_);
+      add_task = class_loaders_to_delete_.empty();
+      class_loaders_to_delete_.splice(class_loaders_to_delete_.end(), to_delete);
+    }
+    if (add_task) {
+      runtime->GetHeap()->GetTaskProcessor()->AddTask(self, new DeleteClassLoadersTask());
+    }
+  } else {
+    for (const ClassLoaderData& data : to_delete) {
+      delete data.allocator;
+      delete data.class_table;
+    }
+  }
   if (!unregistered_oat_files.empty()) {
     for (const OatFile* oat_file : unregistered_oat_files) {
       // Notify the fault handler about removal of the executable code range if needed.
@@ -748,13 +748,15 @@ class ClassLinker {
                                       ArtMethod* method)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Create a conflict table with a specified capacity.
+  // Create a conflict table with a specified capacity. Large tables use the hashed layout
+  // when they are not going to be written to an image.
   ImtConflictTable* CreateImtConflictTable(size_t count, LinearAlloc* linear_alloc);
 
   // Static version for when the class linker is not yet created.
   static ImtConflictTable* CreateImtConflictTable(size_t count,
                                                   LinearAlloc* linear_alloc,
-                                                  PointerSize pointer_size);
+                                                  PointerSize pointer_size,
+                                                  bool hashed = false);
 
 
   // Create the IMT and conflict tables for a class.
@@ -1004,6 +1006,7 @@ class ClassLinker {
   class MethodAnnotationsIterator;
   class OatClassCodeIterator;
   class VisiblyInitializedCallback;
+  class DeleteClassLoadersTask;
 
   struct ClassLoaderData {
     jweak weak_root;  // Weak root to enable class unloading.
@@ -1032,6 +1035,9 @@ class ClassLinker {
   void PrepareToDeleteClassLoader(Thread* self, const ClassLoaderData& data, bool cleanup_cha)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Delete the allocators and class tables that CleanupClassLoaders() left to a heap task.
+  void DeletePendingClassLoaders(Thread* self) REQUIRES(!class_loader_deletion_lock_);
+
   void VisitClassesInternal(ClassVisitor* visitor)
       REQUIRES_SHARED(Locks::classlinker_classes_lock_, Locks::mutator_lock_);
 
@@ -1504,6 +1510,11 @@ class ClassLinker {
   std::map<ArtMethod*, void*> critical_native_code_with_clinit_check_
       GUARDED_BY(critical_native_code_with_clinit_check_lock_);
 
+  // Unloaded class loaders, already prepared for deletion, whose allocator and class table are
+  // yet to be deleted by a heap task. See CleanupClassLoaders().
+  Mutex class_loader_deletion_lock_;
+  std::list<ClassLoaderData> class_loaders_to_delete_ GUARDED_BY(class_loader_deletion_lock_);
+
   // Load unique JNI stubs from boot images. If the subsequently loaded native methods could find a
   // matching stub, then reuse it without JIT/AOT compilation.
   JniStubHashMap<const void*> boot_image_jni_stubs_;
@@ -34,6 +34,7 @@
 #include "dex/art_dex_file_loader.h"
 #include "dex/dex_file.h"
 #include "dex/dex_file_loader.h"
+#include "dex/utf.h"
 #include "handle_scope-inl.h"
 #include "jni/jni_internal.h"
 #include "mirror/class_loader-inl.h"
@@ -1283,6 +1284,10 @@ bool ClassLoaderContext::IsValidEncoding(const std::string& possible_encoded_cla
          possible_encoded_class_loader_context == kUnsupportedClassLoaderContextEncoding;
 }
 
+uint32_t ClassLoaderContext::HashEncodedContext(std::string_view encoded_context) {
+  return ComputeModifiedUtf8Hash(encoded_context);
+}
+
 ClassLoaderContext::VerificationResult ClassLoaderContext::VerifyClassLoaderContextMatch(
     const std::string& context_spec, bool verify_names, bool verify_checksums) const {
   ScopedTrace trace(__FUNCTION__);
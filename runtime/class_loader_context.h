@@ -18,6 +18,7 @@
 #define ART_RUNTIME_CLASS_LOADER_CONTEXT_H_
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <set>
 
@@ -177,6 +178,10 @@ class EXPORT ClassLoaderContext {
                                                    bool verify_names = true,
                                                    bool verify_checksums = true) const;
 
+  // Returns a stable hash of a context encoded by EncodeContextForOatFile(), as stored in the
+  // oat header next to the encoded context.
+  static uint32_t HashEncodedContext(std::string_view encoded_context);
+
   // Checks if any of the given dex files is already loaded in the current class loader context.
   // It only checks the first class loader.
   // Returns the list of duplicate dex files (empty if there are no duplicates).
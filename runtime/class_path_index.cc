@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "class_path_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "android-base/logging.h"
+#include "base/bit_utils.h"
+#include "base/casts.h"
+#include "dex/dex_file-inl.h"
+#include "dex/utf.h"
+
+namespace art HIDDEN {
+
+std::unique_ptr<ClassPathIndex> ClassPathIndex::Create(
+    const std::vector<const DexFile*>& dex_files, std::vector<Location>&& locations) {
+  DCHECK_EQ(dex_files.size(), locations.size());
+  if (dex_files.size() > std::numeric_limits<uint16_t>::max()) {
+    return nullptr;
+  }
+  size_t num_class_defs = 0u;
+  for (const DexFile* dex_file : dex_files) {
+    num_class_defs += dex_file->NumClassDefs();
+  }
+  if (num_class_defs > std::numeric_limits<uint32_t>::max() / 2u) {
+    return nullptr;
+  }
+  // About one class per bucket.
+  uint32_t num_buckets = RoundUpToPowerOfTwo(std::max<uint32_t>(num_class_defs, 1u));
+  uint32_t mask = num_buckets - 1u;
+
+  // Sort (bucket, dex file index) pairs. Duplicates come from classes with the same bucket in the
+  // same dex file and are removed, as one probe of the dex file finds all of them.
+  std::vector<uint64_t> pairs;
+  pairs.reserve(num_class_defs);
+  for (size_t i = 0; i != dex_files.size(); ++i) {
+    const DexFile& dex_file = *dex_files[i];
+    for (uint32_t class_def_idx = 0; class_def_idx != dex_file.NumClassDefs(); ++class_def_idx) {
+      const dex::ClassDef& class_def = dex_file.GetClassDef(class_def_idx);
+      uint32_t hash = ComputeModifiedUtf8Hash(dex_file.GetTypeDescriptorView(class_def.class_idx_));
+      pairs.push_back((static_cast<uint64_t>(hash & mask) << 32) | i);
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+  std::vector<uint32_t> bucket_starts(num_buckets + 1u, 0u);
+  std::vector<uint16_t> dex_file_indexes;
+  dex_file_indexes.reserve(pairs.size());
+  for (uint64_t pair : pairs) {
+    ++bucket_starts[(pair >> 32) + 1u];
+    dex_file_indexes.push_back(dchecked_integral_cast<uint16_t>(pair & 0xffffffffu));
+  }
+  for (uint32_t bucket = 0; bucket != num_buckets; ++bucket) {
+    bucket_starts[bucket + 1u] += bucket_starts[bucket];
+  }
+  DCHECK_EQ(bucket_starts[num_buckets], dex_file_indexes.size());
+
+  return std::unique_ptr<ClassPathIndex>(new ClassPathIndex(
+      mask, std::move(bucket_starts), std::move(dex_file_indexes), std::move(locations)));
+}
+
+size_t ClassPathIndex::GetMemoryUsage() const {
+  return sizeof(*this) +
+         bucket_starts_.size() * sizeof(bucket_starts_[0]) +
+         dex_file_indexes_.size() * sizeof(dex_file_indexes_[0]) +
+         locations_.size() * sizeof(locations_[0]);
+}
+
+ClassPathIndex::ClassPathIndex(uint32_t mask,
+                               std::vector<uint32_t>&& bucket_starts,
+                               std::vector<uint16_t>&& dex_file_indexes,
+                               std::vector<Location>&& locations)
+    : mask_(mask),
+      bucket_starts_(std::move(bucket_starts)),
+      dex_file_indexes_(std::move(dex_file_indexes)),
+      locations_(std::move(locations)) {}
+
+}  // namespace art
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_CLASS_PATH_INDEX_H_
+#define ART_RUNTIME_CLASS_PATH_INDEX_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace art HIDDEN {
+
+class DexFile;
+
+// Maps class descriptor hashes to the dex files of a class path that define a class with that
+// hash, so that looking up a class in a class path with many dex files probes only the type
+// lookup tables of the few dex files that may define it, instead of those of all dex files.
+//
+// Each dex file is identified by a `Location` chosen by the creator, for example the position of
+// the dex file in the `DexPathList` of a class loader, so that the index does not keep pointers to
+// dex files that may be closed.
+class ClassPathIndex {
+ public:
+  struct Location {
+    uint32_t element_index;
+    uint32_t cookie_index;
+  };
+
+  // Creates an index for `dex_files`, given in class path order. `locations[i]` is the location
+  // of `dex_files[i]`. Returns null if there are too many dex files.
+  static std::unique_ptr<ClassPathIndex> Create(const std::vector<const DexFile*>& dex_files,
+                                                std::vector<Location>&& locations);
+
+  // Calls `visitor(location)`, in class path order, for each dex file that may define a class with
+  // a descriptor hash equal to `hash`, until the visitor returns false. Returns false if the
+  // visitor stopped the visit.
+  template <typename Visitor>
+  bool VisitCandidates(uint32_t hash, const Visitor& visitor) const {
+    uint32_t bucket = hash & mask_;
+    for (uint32_t i = bucket_starts_[bucket], end = bucket_starts_[bucket + 1u]; i != end; ++i) {
+      if (!visitor(locations_[dex_file_indexes_[i]])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t GetNumberOfDexFiles() const { return locations_.size(); }
+
+  // Returns the memory used by the index, for logging.
+  size_t GetMemoryUsage() const;
+
+ private:
+  ClassPathIndex(uint32_t mask,
+                 std::vector<uint32_t>&& bucket_starts,
+                 std::vector<uint16_t>&& dex_file_indexes,
+                 std::vector<Location>&& locations);
+
+  const uint32_t mask_;
+  // Bucket `b` holds `dex_file_indexes_[bucket_starts_[b]]` up to, but excluding,
+  // `dex_file_indexes_[bucket_starts_[b + 1]]`, in increasing order and without duplicates.
+  const std::vector<uint32_t> bucket_starts_;
+  const std::vector<uint16_t> dex_file_indexes_;
+  const std::vector<Location> locations_;
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_CLASS_PATH_INDEX_H_
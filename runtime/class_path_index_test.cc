@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "class_path_index.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "class_linker-inl.h"
+#include "class_table-inl.h"
+#include "common_runtime_test.h"
+#include "dex/dex_file-inl.h"
+#include "dex/utf.h"
+#include "handle_scope-inl.h"
+#include "mirror/class-inl.h"
+#include "mirror/class_loader.h"
+#include "mirror/object_array-inl.h"
+#include "scoped_thread_state_change-inl.h"
+#include "well_known_classes-inl.h"
+
+namespace art HIDDEN {
+
+static const std::vector<std::string> kDexNames = {
+    "Interfaces", "Main", "MyClass", "Nested", "Statics", "StaticLeafMethods", "XandY", "AllFields",
+};
+
+class ClassPathIndexTest : public CommonRuntimeTest {
+ protected:
+  // Opens the dex files of `kDexNames`, in class path order.
+  std::vector<std::unique_ptr<const DexFile>> OpenClassPath() {
+    std::vector<std::unique_ptr<const DexFile>> dex_files;
+    for (const std::string& name : kDexNames) {
+      for (std::unique_ptr<const DexFile>& dex_file : OpenTestDexFiles(name.c_str())) {
+        dex_files.push_back(std::move(dex_file));
+      }
+    }
+    return dex_files;
+  }
+
+  // Returns the indexes of the candidate dex files for `descriptor`.
+  static std::vector<uint32_t> GetCandidates(const ClassPathIndex& index,
+                                             const std::string& descriptor) {
+    std::vector<uint32_t> candidates;
+    index.VisitCandidates(ComputeModifiedUtf8Hash(descriptor),
+                          [&](ClassPathIndex::Location location) {
+                            candidates.push_back(location.element_index);
+                            return true;
+                          });
+    return candidates;
+  }
+};
+
+TEST_F(ClassPathIndexTest, FindsAllClasses) {
+  std::vector<std::unique_ptr<const DexFile>> dex_files = OpenClassPath();
+  std::vector<const DexFile*> dex_file_ptrs;
+  std::vector<ClassPathIndex::Location> locations;
+  for (size_t i = 0; i != dex_files.size(); ++i) {
+    dex_file_ptrs.push_back(dex_files[i].get());
+    locations.push_back({.element_index = static_cast<uint32_t>(i), .cookie_index = 0u});
+  }
+  std::unique_ptr<ClassPathIndex> index = ClassPathIndex::Create(dex_file_ptrs,
+                                                                 std::move(locations));
+  ASSERT_TRUE(index != nullptr);
+  EXPECT_EQ(dex_files.size(), index->GetNumberOfDexFiles());
+
+  for (size_t i = 0; i != dex_files.size(); ++i) {
+    const DexFile& dex_file = *dex_files[i];
+    for (uint32_t class_def_idx = 0; class_def_idx != dex_file.NumClassDefs(); ++class_def_idx) {
+      std::string descriptor(dex_file.GetClassDescriptor(dex_file.GetClassDef(class_def_idx)));
+      std::vector<uint32_t> candidates = GetCandidates(*index, descriptor);
+      EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+      EXPECT_TRUE(std::adjacent_find(candidates.begin(), candidates.end()) == candidates.end());
+      EXPECT_TRUE(std::find(candidates.begin(), candidates.end(), i) != candidates.end())
+          << descriptor;
+    }
+  }
+
+  // The visit stops when the visitor returns false.
+  const DexFile& first = *dex_files[0];
+  std::string descriptor(first.GetClassDescriptor(first.GetClassDef(0)));
+  size_t num_visited = 0u;
+  EXPECT_FALSE(index->VisitCandidates(ComputeModifiedUtf8Hash(descriptor),
+                                      [&](ClassPathIndex::Location) {
+                                        ++num_visited;
+                                        return false;
+                                      }));
+  EXPECT_EQ(1u, num_visited);
+}
+
+TEST_F(ClassPathIndexTest, FindClassWithIndex) {
+  std::vector<std::unique_ptr<const DexFile>> dex_files = OpenClassPath();
+  ASSERT_GE(dex_files.size(), 8u);
+  jobject jclass_loader = LoadDexInPathClassLoader(kDexNames, /*parent_loader=*/ nullptr);
+
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<1> hs(soa.Self());
+  Handle<mirror::ClassLoader> class_loader =
+      hs.NewHandle(soa.Decode<mirror::ClassLoader>(jclass_loader));
+
+  // Look up every class twice, so that most lookups go through the index built by the first
+  // lookup that visits all dex files.
+  for (size_t round = 0; round != 2u; ++round) {
+    for (size_t i = 0; i != dex_files.size(); ++i) {
+      const DexFile& dex_file = *dex_files[i];
+      for (uint32_t class_def_idx = 0; class_def_idx != dex_file.NumClassDefs(); ++class_def_idx) {
+        const char* descriptor = dex_file.GetClassDescriptor(dex_file.GetClassDef(class_def_idx));
+        // The first dex file in class path order that defines the class wins.
+        size_t expected = i;
+        for (size_t j = 0; j != i; ++j) {
+          if (OatDexFile::FindClassDef(
+                  *dex_files[j], descriptor, ComputeModifiedUtf8Hash(descriptor)) != nullptr) {
+            expected = j;
+            break;
+          }
+        }
+        ObjPtr<mirror::Class> klass =
+            class_linker_->FindClass(soa.Self(), descriptor, class_loader);
+        ASSERT_TRUE(klass != nullptr) << descriptor;
+        EXPECT_EQ(dex_files[expected]->GetLocation(), klass->GetDexFile().GetLocation())
+            << descriptor;
+      }
+    }
+    ObjPtr<mirror::Class> missing =
+        class_linker_->FindClass(soa.Self(), "LDoesNotExist;", class_loader);
+    EXPECT_TRUE(missing == nullptr);
+    ASSERT_TRUE(soa.Self()->IsExceptionPending());
+    soa.Self()->ClearException();
+  }
+
+  ObjPtr<mirror::Object> dex_path_list =
+      WellKnownClasses::dalvik_system_BaseDexClassLoader_pathList->GetObject(class_loader.Get());
+  ASSERT_TRUE(dex_path_list != nullptr);
+  ObjPtr<mirror::Object> dex_elements =
+      WellKnownClasses::dalvik_system_DexPathList_dexElements->GetObject(dex_path_list);
+  ClassTable* class_table = class_loader->GetClassTable();
+  ASSERT_TRUE(class_table != nullptr);
+  size_t num_indexed_dex_files = 0u;
+  EXPECT_TRUE(class_table->VisitClassPathIndex(dex_elements, [&](const ClassPathIndex& index) {
+    num_indexed_dex_files = index.GetNumberOfDexFiles();
+  }));
+  EXPECT_EQ(dex_files.size(), num_indexed_dex_files);
+}
+
+}  // namespace art
@@ -79,6 +79,7 @@ void ClassTable::VisitRoots(Visitor& visitor, bool skip_classes) {
   for (GcRoot<mirror::Object>& root : strong_roots_) {
     visitor.VisitRoot(root.AddressWithoutBarrier());
   }
+  visitor.VisitRootIfNonNull(class_path_index_dex_elements_.AddressWithoutBarrier());
   for (const OatFile* oat_file : oat_files_) {
     for (GcRoot<mirror::Object>& root : oat_file->GetBssGcRoots()) {
       visitor.VisitRootIfNonNull(root.AddressWithoutBarrier());
@@ -99,6 +100,7 @@ void ClassTable::VisitRoots(const Visitor& visitor, bool skip_classes) {
   for (GcRoot<mirror::Object>& root : strong_roots_) {
     visitor.VisitRoot(root.AddressWithoutBarrier());
   }
+  visitor.VisitRootIfNonNull(class_path_index_dex_elements_.AddressWithoutBarrier());
   for (const OatFile* oat_file : oat_files_) {
     for (GcRoot<mirror::Object>& root : oat_file->GetBssGcRoots()) {
       visitor.VisitRootIfNonNull(root.AddressWithoutBarrier());
@@ -106,6 +108,16 @@ void ClassTable::VisitRoots(const Visitor& visitor, bool skip_classes) {
   }
 }
 
+template <typename Visitor>
+bool ClassTable::VisitClassPathIndex(ObjPtr<mirror::Object> dex_elements, const Visitor& visitor) {
+  ReaderMutexLock mu(Thread::Current(), lock_);
+  if (class_path_index_ == nullptr || class_path_index_dex_elements_.Read() != dex_elements) {
+    return false;
+  }
+  visitor(*class_path_index_);
+  return true;
+}
+
 template <class Condition, class Visitor>
 void ClassTable::VisitClassesIfConditionMet(Condition& cond, Visitor& visitor) {
   ReaderMutexLock mu(Thread::Current(), lock_);
@@ -148,6 +160,7 @@ void ClassTable::VisitClassesAndRoots(Visitor& visitor) {
   for (GcRoot<mirror::Object>& root : strong_roots_) {
     visitor.VisitRoot(root.AddressWithoutBarrier());
   }
+  visitor.VisitRootIfNonNull(class_path_index_dex_elements_.AddressWithoutBarrier());
   for (const OatFile* oat_file : oat_files_) {
     for (GcRoot<mirror::Object>& root : oat_file->GetBssGcRoots()) {
       visitor.VisitRootIfNonNull(root.AddressWithoutBarrier());
@@ -23,7 +23,9 @@
 
 namespace art HIDDEN {
 
-ClassTable::ClassTable() : lock_("Class loader classes", kClassLoaderClassesLock) {
+ClassTable::ClassTable()
+    : lock_("Class loader classes", kClassLoaderClassesLock),
+      frozen_class_sets_(nullptr) {
   Runtime* const runtime = Runtime::Current();
   classes_.push_back(ClassSet(runtime->GetHashTableMinLoadFactor(),
                               runtime->GetHashTableMaxLoadFactor()));
@@ -36,6 +38,18 @@ void ClassTable::FreezeSnapshot() {
   const ClassSet& last_set = classes_.back();
   ClassSet new_set(last_set.GetMinLoadFactor(), last_set.GetMaxLoadFactor());
   classes_.push_back(std::move(new_set));
+  PublishFrozenClassSets();
+}
+
+void ClassTable::PublishFrozenClassSets() {
+  DCHECK(!classes_.empty());
+  std::unique_ptr<FrozenClassSets> frozen_sets(new FrozenClassSets());
+  frozen_sets->reserve(classes_.size() - 1u);
+  for (auto it = classes_.begin(), end = std::prev(classes_.end()); it != end; ++it) {
+    frozen_sets->push_back(&*it);
+  }
+  frozen_class_sets_.store(frozen_sets.get(), std::memory_order_release);
+  frozen_class_sets_snapshots_.push_back(std::move(frozen_sets));
 }
 
 ObjPtr<mirror::Class> ClassTable::UpdateClass(ObjPtr<mirror::Class> klass, size_t hash) {
@@ -79,8 +93,8 @@ size_t ClassTable::CountDefiningLoaderClasses(ObjPtr<mirror::ClassLoader> defini
 size_t ClassTable::NumZygoteClasses(ObjPtr<mirror::ClassLoader> defining_loader) const {
   ReaderMutexLock mu(Thread::Current(), lock_);
   size_t sum = 0;
-  for (size_t i = 0; i < classes_.size() - 1; ++i) {
-    sum += CountDefiningLoaderClasses(defining_loader, classes_[i]);
+  for (auto it = classes_.begin(), end = std::prev(classes_.end()); it != end; ++it) {
+    sum += CountDefiningLoaderClasses(defining_loader, *it);
   }
   return sum;
 }
@@ -93,8 +107,8 @@ size_t ClassTable::NumNonZygoteClasses(ObjPtr<mirror::ClassLoader> defining_load
 size_t ClassTable::NumReferencedZygoteClasses() const {
   ReaderMutexLock mu(Thread::Current(), lock_);
   size_t sum = 0;
-  for (size_t i = 0; i < classes_.size() - 1; ++i) {
-    sum += classes_[i].size();
+  for (auto it = classes_.begin(), end = std::prev(classes_.end()); it != end; ++it) {
+    sum += it->size();
   }
   return sum;
 }
@@ -106,19 +120,34 @@ size_t ClassTable::NumReferencedNonZygoteClasses() const {
 
 ObjPtr<mirror::Class> ClassTable::Lookup(const char* descriptor, size_t hash) {
   DescriptorHashPair pair(descriptor, hash);
+  // Search the frozen tables first without taking `lock_`, so that concurrent lookups do not
+  // contend on the lock's cache line. Search them from the last one. For prebuilt boot images,
+  // this helps by searching the large table from the framework boot image extension compiled
+  // as single-image before the individual small tables from the primary boot image compiled
+  // as multi-image.
+  const FrozenClassSets* frozen_sets = frozen_class_sets_.load(std::memory_order_acquire);
+  if (frozen_sets != nullptr) {
+    for (const ClassSet* class_set : ReverseRange(*frozen_sets)) {
+      auto it = class_set->FindWithHash(pair, hash);
+      if (it != class_set->end()) {
+        return it->Read();
+      }
+    }
+  }
   ReaderMutexLock mu(Thread::Current(), lock_);
-  // Search from the last table, assuming that apps shall search for their own classes
-  // more often than for boot image classes. For prebuilt boot images, this also helps
-  // by searching the large table from the framework boot image extension compiled as
-  // single-image before the individual small tables from the primary boot image
-  // compiled as multi-image.
-  for (ClassSet& class_set : ReverseRange(classes_)) {
-    auto it = class_set.FindWithHash(pair, hash);
-    if (it != class_set.end()) {
-      return it->Read();
+  if (UNLIKELY(frozen_class_sets_.load(std::memory_order_relaxed) != frozen_sets)) {
+    // Some sets were frozen or added since we searched, fall back to searching all of them.
+    for (ClassSet& class_set : ReverseRange(classes_)) {
+      auto it = class_set.FindWithHash(pair, hash);
+      if (it != class_set.end()) {
+        return it->Read();
+      }
     }
+    return nullptr;
   }
-  return nullptr;
+  ClassSet& class_set = classes_.back();
+  auto it = class_set.FindWithHash(pair, hash);
+  return (it != class_set.end()) ? it->Read() : nullptr;
 }
 
 void ClassTable::Insert(ObjPtr<mirror::Class> klass) {
@@ -178,13 +207,25 @@ void ClassTable::AddClassSet(ClassSet&& set) {
   // the number of searched frozen tables and not search them again.
   // TODO: Make use of this in `ClassLinker::FindClass()`.
   DCHECK(!classes_.empty());
-  classes_.insert(classes_.end() - 1, std::move(set));
+  classes_.insert(std::prev(classes_.end()), std::move(set));
+  PublishFrozenClassSets();
 }
 
 void ClassTable::ClearStrongRoots() {
   WriterMutexLock mu(Thread::Current(), lock_);
   oat_files_.clear();
   strong_roots_.clear();
+  class_path_index_.reset();
+  class_path_index_dex_elements_ = GcRoot<mirror::Object>(nullptr);
+}
+
+void ClassTable::SetClassPathIndex(ObjPtr<mirror::Object> dex_elements,
+                                   std::unique_ptr<const ClassPathIndex> index) {
+  DCHECK(dex_elements != nullptr);
+  DCHECK(index != nullptr);
+  WriterMutexLock mu(Thread::Current(), lock_);
+  class_path_index_ = std::move(index);
+  class_path_index_dex_elements_ = GcRoot<mirror::Object>(dex_elements);
 }
 
 }  // namespace art
@@ -17,6 +17,9 @@
 #ifndef ART_RUNTIME_CLASS_TABLE_H_
 #define ART_RUNTIME_CLASS_TABLE_H_
 
+#include <atomic>
+#include <list>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +28,7 @@
 #include "base/hash_set.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "class_path_index.h"
 #include "gc_root.h"
 #include "obj_ptr.h"
 
@@ -270,6 +274,20 @@ class ClassTable {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // If the class path index was built for the `dex_elements` array of the owning class loader,
+  // calls `visitor(index)` with `lock_` held and returns true. Returns false otherwise, including
+  // after the class loader replaced its `DexPathList.dexElements`.
+  template <typename Visitor>
+  bool VisitClassPathIndex(ObjPtr<mirror::Object> dex_elements, const Visitor& visitor)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Sets the class path index built for the `dex_elements` array of the owning class loader.
+  void SetClassPathIndex(ObjPtr<mirror::Object> dex_elements,
+                         std::unique_ptr<const ClassPathIndex> index)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   ReaderWriterMutex& GetLock() {
     return lock_;
   }
@@ -285,16 +303,35 @@ class ClassTable {
       REQUIRES(lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Publish a new snapshot of the frozen class sets for `Lookup()`.
+  void PublishFrozenClassSets() REQUIRES(lock_);
+
   // Lock to guard inserting and removing.
   mutable ReaderWriterMutex lock_;
-  // We have a vector to help prevent dirty pages after the zygote forks by calling FreezeSnapshot.
-  std::vector<ClassSet> classes_ GUARDED_BY(lock_);
+  // We have a list to help prevent dirty pages after the zygote forks by calling FreezeSnapshot.
+  // Only the last set is ever modified. A list keeps the addresses of the frozen sets stable.
+  std::list<ClassSet> classes_ GUARDED_BY(lock_);
+  // All sets from `classes_` but the last one, for lookups without holding `lock_`. Frozen sets
+  // are only modified by GC root updates, which are atomic, so a lookup can search them while
+  // another thread inserts into the last set.
+  using FrozenClassSets = std::vector<const ClassSet*>;
+  std::atomic<const FrozenClassSets*> frozen_class_sets_;
+  // All snapshots published to `frozen_class_sets_`. A concurrent lookup may still be reading an
+  // old one, so we keep them until the table is deleted. Sets are only frozen when the zygote
+  // forks or when adding image class sets, so there are few of them.
+  std::vector<std::unique_ptr<const FrozenClassSets>> frozen_class_sets_snapshots_
+      GUARDED_BY(lock_);
   // Extra strong roots that can be either dex files or dex caches. Dex files used by the class
   // loader which may not be owned by the class loader must be held strongly live. Also dex caches
   // are held live to prevent them being unloading once they have classes in them.
   std::vector<GcRoot<mirror::Object>> strong_roots_ GUARDED_BY(lock_);
   // Keep track of oat files with GC roots associated with dex caches in `strong_roots_`.
   std::vector<const OatFile*> oat_files_ GUARDED_BY(lock_);
+  // Index of the dex files of the owning `BaseDexClassLoader`, see `ClassPathIndex`, and the
+  // `DexPathList.dexElements` array it was built for. Holding the array strongly ensures that a
+  // different array cannot be allocated at the same address.
+  std::unique_ptr<const ClassPathIndex> class_path_index_ GUARDED_BY(lock_);
+  GcRoot<mirror::Object> class_path_index_dex_elements_ GUARDED_BY(lock_);
 
   friend class linker::ImageWriter;  // for InsertWithoutLocks.
 };
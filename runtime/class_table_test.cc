@@ -27,6 +27,7 @@
 #include "mirror/class-alloc-inl.h"
 #include "obj_ptr.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art HIDDEN {
 namespace mirror {
@@ -66,6 +67,34 @@ class CollectRootVisitor {
 };
 
 
+class LookupTask : public Task {
+ public:
+  LookupTask(ClassTable* table, const char* descriptor, Class* expected, AtomicInteger* failures)
+      : table_(table), descriptor_(descriptor), expected_(expected), failures_(failures) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    const size_t hash = ComputeModifiedUtf8Hash(descriptor_);
+    for (size_t i = 0; i != kIterations; ++i) {
+      if (table_->Lookup(descriptor_, hash) != expected_) {
+        ++*failures_;
+      }
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+  static constexpr size_t kIterations = 100000;
+
+ private:
+  ClassTable* const table_;
+  const char* const descriptor_;
+  Class* const expected_;
+  AtomicInteger* const failures_;
+};
+
 class ClassTableTest : public CommonRuntimeTest {
  protected:
   ClassTableTest() {
@@ -161,5 +190,49 @@ TEST_F(ClassTableTest, ClassTable) {
   // TODO: Add tests for UpdateClass, InsertOatFile.
 }
 
+// Look up classes from frozen and non-frozen sets from several threads at once.
+// Also reports the time taken, as a rough benchmark of concurrent lookups.
+TEST_F(ClassTableTest, ConcurrentLookup) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+  jobject jclass_loader = LoadDex("XandY");
+  VariableSizedHandleScope hs(soa.Self());
+  Handle<ClassLoader> class_loader(hs.NewHandle(soa.Decode<ClassLoader>(jclass_loader)));
+  const char* descriptor_x = "LX;";
+  const char* descriptor_y = "LY;";
+  Handle<mirror::Class> h_X(
+      hs.NewHandle(class_linker_->FindClass(soa.Self(), descriptor_x, class_loader)));
+  Handle<mirror::Class> h_Y(
+      hs.NewHandle(class_linker_->FindClass(soa.Self(), descriptor_y, class_loader)));
+  ClassTable table;
+  table.Insert(h_X.Get());
+  table.FreezeSnapshot();
+  table.Insert(h_Y.Get());
+
+  Class* x = h_X.Get();
+  Class* y = h_Y.Get();
+
+  // Let the pool threads run while we wait for them.
+  ScopedThreadSuspension sts(self, ThreadState::kNative);
+  static constexpr size_t kNumThreads = 4;
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Class table test thread pool", kNumThreads));
+  AtomicInteger failures(0);
+  for (size_t i = 0; i != kNumThreads; ++i) {
+    // Alternate between a class in the frozen set and one in the last set.
+    bool frozen = (i % 2u) == 0u;
+    thread_pool->AddTask(self, new LookupTask(&table,
+                                              frozen ? descriptor_x : descriptor_y,
+                                              frozen ? x : y,
+                                              &failures));
+  }
+  uint64_t start_ns = NanoTime();
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /* do_work= */ false, /* may_hold_locks= */ false);
+  LOG(INFO) << kNumThreads << "x" << LookupTask::kIterations << " concurrent lookups took "
+            << PrettyDuration(NanoTime() - start_ns);
+  EXPECT_EQ(failures.load(std::memory_order_relaxed), 0);
+}
+
 }  // namespace mirror
 }  // namespace art
@@ -36,6 +36,10 @@ void SetQuickAllocEntryPointsAllocator(gc::AllocatorType allocator)
 void SetQuickAllocEntryPointsInstrumented(bool instrumented)
     REQUIRES(Locks::mutator_lock_, Locks::runtime_shutdown_lock_);
 
+// Whether the allocation entrypoints are instrumented. Compiled code takes them instead of its
+// inline TLAB fast path while they are, see ThreadFlag::kInstrumentedAllocation.
+bool AreQuickAllocEntryPointsInstrumented();
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_ENTRYPOINTS_QUICK_QUICK_ALLOC_ENTRYPOINTS_H_
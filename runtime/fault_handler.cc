@@ -20,6 +20,7 @@
 #include <sys/mman.h>
 #include <sys/ucontext.h>
 
+#include <algorithm>
 #include <atomic>
 
 #include "art_method-inl.h"
@@ -66,6 +67,8 @@ static bool art_sigbus_handler(int sig, siginfo_t* info, void* context) {
 FaultManager::FaultManager()
     : generated_code_ranges_lock_("FaultHandler generated code ranges lock",
                                   LockLevel::kGenericBottomLock),
+      generated_code_ranges_(nullptr),
+      retired_generated_code_ranges_(nullptr),
       initialized_(false) {}
 
 FaultManager::~FaultManager() {
@@ -132,19 +135,6 @@ void FaultManager::Init(bool use_sig_chain) {
                    << errno << " " << strerror(errno);
     }
 
-    {
-      MutexLock lock(Thread::Current(), generated_code_ranges_lock_);
-      for (size_t i = 0; i != kNumLocalGeneratedCodeRanges; ++i) {
-        GeneratedCodeRange* next = (i + 1u != kNumLocalGeneratedCodeRanges)
-            ? &generated_code_ranges_storage_[i + 1u]
-            : nullptr;
-        generated_code_ranges_storage_[i].next.store(next, std::memory_order_relaxed);
-        generated_code_ranges_storage_[i].start = nullptr;
-        generated_code_ranges_storage_[i].size = 0u;
-      }
-      free_generated_code_ranges_ = generated_code_ranges_storage_;
-    }
-
     initialized_ = true;
   } else if (gUseUserfaultfd) {
     struct sigaction act;
@@ -186,20 +176,14 @@ void FaultManager::Shutdown() {
     // Delete remaining code ranges if any (such as nterp code or oat code from
     // oat files that have not been unloaded, including boot image oat files).
     MutexLock lock(Thread::Current(), generated_code_ranges_lock_);
-    GeneratedCodeRange* range = generated_code_ranges_.load(std::memory_order_acquire);
+    GeneratedCodeRangeTable* table = generated_code_ranges_.load(std::memory_order_relaxed);
     generated_code_ranges_.store(nullptr, std::memory_order_release);
-    while (range != nullptr) {
-      GeneratedCodeRange* next_range = range->next.load(std::memory_order_relaxed);
-      std::less<GeneratedCodeRange*> less;
-      if (!less(range, generated_code_ranges_storage_) &&
-          less(range, generated_code_ranges_storage_ + kNumLocalGeneratedCodeRanges)) {
-        // Nothing to do - not adding `range` to the `free_generated_code_ranges_` anymore.
-      } else {
-        // Range is not in the `generated_code_ranges_storage_`.
-        delete range;
-      }
-      range = next_range;
+    if (table != nullptr) {
+      table->next_retired = retired_generated_code_ranges_;
+      retired_generated_code_ranges_ = table;
     }
+    FreeGeneratedCodeRangeTables(retired_generated_code_ranges_);
+    retired_generated_code_ranges_ = nullptr;
   }
 }
 
@@ -268,12 +252,13 @@ inline void FaultManager::CheckForUnrecognizedImplicitSuspendCheckInBootImage(
         << "; mutator lock shared held = " << Locks::mutator_lock_->IsSharedHeld(thread);
   }
   oss << "; code ranges = {";
-  GeneratedCodeRange* range = generated_code_ranges_.load(std::memory_order_acquire);
+  GeneratedCodeRangeTable* table = generated_code_ranges_.load(std::memory_order_acquire);
   const char* s = "";
-  while (range != nullptr) {
-    oss << s << "{" << range->start << ", " << range->size << "}";
-    s = ", ";
-    range = range->next.load(std::memory_order_relaxed);
+  if (table != nullptr) {
+    for (const GeneratedCodeRange& range : table->ranges) {
+      oss << s << "{" << reinterpret_cast<const void*>(range.start) << ", " << range.size << "}";
+      s = ", ";
+    }
   }
   oss << "}";
   LOG(FATAL) << oss.str();
@@ -340,52 +325,52 @@ void FaultManager::RemoveHandler(FaultHandler* handler) {
   LOG(FATAL) << "Attempted to remove non existent handler " << handler;
 }
 
-inline FaultManager::GeneratedCodeRange* FaultManager::CreateGeneratedCodeRange(
-    const void* start, size_t size) {
-  GeneratedCodeRange* range = free_generated_code_ranges_;
-  if (range != nullptr) {
-    std::less<GeneratedCodeRange*> less;
-    DCHECK(!less(range, generated_code_ranges_storage_));
-    DCHECK(less(range, generated_code_ranges_storage_ + kNumLocalGeneratedCodeRanges));
-    range->start = start;
-    range->size = size;
-    free_generated_code_ranges_ = range->next.load(std::memory_order_relaxed);
-    range->next.store(nullptr, std::memory_order_relaxed);
-    return range;
-  } else {
-    return new GeneratedCodeRange{nullptr, start, size};
+void FaultManager::PublishGeneratedCodeRanges(std::vector<GeneratedCodeRange>&& ranges) {
+  uintptr_t max_end = 0u;
+  for (GeneratedCodeRange& range : ranges) {
+    max_end = std::max(max_end, range.start + range.size);
+    range.max_end = max_end;
+  }
+  GeneratedCodeRangeTable* new_table = new GeneratedCodeRangeTable{std::move(ranges)};
+  GeneratedCodeRangeTable* old_table = generated_code_ranges_.load(std::memory_order_relaxed);
+  generated_code_ranges_.store(new_table, std::memory_order_release);
+  if (old_table != nullptr) {
+    // A thread in `IsInGeneratedCode()` may still be searching the old table.
+    old_table->next_retired = retired_generated_code_ranges_;
+    retired_generated_code_ranges_ = old_table;
   }
 }
 
-inline void FaultManager::FreeGeneratedCodeRange(GeneratedCodeRange* range) {
-  std::less<GeneratedCodeRange*> less;
-  if (!less(range, generated_code_ranges_storage_) &&
-      less(range, generated_code_ranges_storage_ + kNumLocalGeneratedCodeRanges)) {
-    MutexLock lock(Thread::Current(), generated_code_ranges_lock_);
-    range->start = nullptr;
-    range->size = 0u;
-    range->next.store(free_generated_code_ranges_, std::memory_order_relaxed);
-    free_generated_code_ranges_ = range;
-  } else {
-    // Range is not in the `generated_code_ranges_storage_`.
-    delete range;
+void FaultManager::FreeGeneratedCodeRangeTables(GeneratedCodeRangeTable* table) {
+  while (table != nullptr) {
+    GeneratedCodeRangeTable* next = table->next_retired;
+    delete table;
+    table = next;
   }
 }
 
 void FaultManager::AddGeneratedCodeRange(const void* start, size_t size) {
-  GeneratedCodeRange* new_range = nullptr;
   {
     MutexLock lock(Thread::Current(), generated_code_ranges_lock_);
-    new_range = CreateGeneratedCodeRange(start, size);
-    GeneratedCodeRange* old_head = generated_code_ranges_.load(std::memory_order_relaxed);
-    new_range->next.store(old_head, std::memory_order_relaxed);
-    generated_code_ranges_.store(new_range, std::memory_order_release);
-  }
-
-  // The above release operation on `generated_code_ranges_` with an acquire operation
-  // on the same atomic object in `IsInGeneratedCode()` ensures the correct memory
-  // visibility for the contents of `*new_range` for any thread that loads the value
-  // written above (or a value written by a release sequence headed by that write).
+    GeneratedCodeRangeTable* old_table = generated_code_ranges_.load(std::memory_order_relaxed);
+    std::vector<GeneratedCodeRange> ranges;
+    if (old_table != nullptr) {
+      ranges = old_table->ranges;
+    }
+    GeneratedCodeRange new_range = {reinterpret_cast<uintptr_t>(start), size, /*max_end=*/ 0u};
+    auto it = std::upper_bound(
+        ranges.begin(),
+        ranges.end(),
+        new_range.start,
+        [](uintptr_t lhs, const GeneratedCodeRange& rhs) { return lhs < rhs.start; });
+    ranges.insert(it, new_range);
+    PublishGeneratedCodeRanges(std::move(ranges));
+  }
+
+  // The release operation on `generated_code_ranges_` in `PublishGeneratedCodeRanges()` with
+  // an acquire operation on the same atomic object in `IsInGeneratedCode()` ensures the correct
+  // memory visibility for the contents of the new table for any thread that loads the value
+  // written there.
   //
   // However, we also need to ensure that any thread that encounters a segmentation
   // fault in the provided range shall actually see the written value. For JIT code
@@ -403,45 +388,33 @@ void FaultManager::AddGeneratedCodeRange(const void* start, size_t size) {
 
 void FaultManager::RemoveGeneratedCodeRange(const void* start, size_t size) {
   Thread* self = Thread::Current();
-  GeneratedCodeRange* range = nullptr;
+  GeneratedCodeRangeTable* retired_tables = nullptr;
   {
     MutexLock lock(self, generated_code_ranges_lock_);
-    std::atomic<GeneratedCodeRange*>* before = &generated_code_ranges_;
-    range = before->load(std::memory_order_relaxed);
-    while (range != nullptr && range->start != start) {
-      before = &range->next;
-      range = before->load(std::memory_order_relaxed);
-    }
-    if (range != nullptr) {
-      GeneratedCodeRange* next = range->next.load(std::memory_order_relaxed);
-      if (before == &generated_code_ranges_) {
-        // Relaxed store directly to `generated_code_ranges_` would not satisfy
-        // conditions for a release sequence, so we need to use store-release.
-        before->store(next, std::memory_order_release);
-      } else {
-        // In the middle of the list, we can use a relaxed store as we're not
-        // publishing any newly written memory to potential reader threads.
-        // Whether they see the removed node or not is unimportant as we should
-        // not execute that code anymore. We're keeping the `next` link of the
-        // removed node, so that concurrent walk can use it to reach remaining
-        // retained nodes, if any.
-        before->store(next, std::memory_order_relaxed);
-      }
-    }
+    GeneratedCodeRangeTable* old_table = generated_code_ranges_.load(std::memory_order_relaxed);
+    CHECK(old_table != nullptr);
+    std::vector<GeneratedCodeRange> ranges = old_table->ranges;
+    auto it = std::find_if(ranges.begin(), ranges.end(), [start](const GeneratedCodeRange& range) {
+      return range.start == reinterpret_cast<uintptr_t>(start);
+    });
+    CHECK(it != ranges.end());
+    CHECK_EQ(it->size, size);
+    ranges.erase(it);
+    PublishGeneratedCodeRanges(std::move(ranges));
+    // The tables retired so far can be freed after the checkpoint below. Tables retired
+    // concurrently with the checkpoint are left for the next removal.
+    retired_tables = retired_generated_code_ranges_;
+    retired_generated_code_ranges_ = nullptr;
   }
-  CHECK(range != nullptr);
-  DCHECK_EQ(range->start, start);
-  CHECK_EQ(range->size, size);
 
   Runtime* runtime = Runtime::Current();
   CHECK(runtime != nullptr);
   if (runtime->IsStarted() && runtime->GetThreadList() != nullptr) {
-    // Run a checkpoint before deleting the range to ensure that no thread holds a
-    // pointer to the removed range while walking the list in `IsInGeneratedCode()`.
-    // That walk is guarded by checking that the thread is `Runnable`, so any walk
-    // started before the removal shall be done when running the checkpoint and the
-    // checkpoint also ensures the correct memory visibility of `next` links,
-    // so the thread shall not see the pointer during future walks.
+    // Run a checkpoint before deleting the retired tables to ensure that no thread holds
+    // a pointer to them while searching in `IsInGeneratedCode()`. That search is guarded
+    // by checking that the thread is `Runnable`, so any search started before the removal
+    // shall be done when running the checkpoint and the checkpoint also ensures the correct
+    // memory visibility of the new table, so the thread shall not see the old ones anymore.
 
     // This function is currently called in different mutex and thread states.
     // Semi-space GC performs the cleanup during its `MarkingPhase()` while holding
@@ -470,7 +443,7 @@ void FaultManager::RemoveGeneratedCodeRange(const void* start, size_t size) {
       }
     }
   }
-  FreeGeneratedCodeRange(range);
+  FreeGeneratedCodeRangeTables(retired_tables);
 }
 
 // This function is called within the signal handler. It checks that the thread
@@ -505,21 +478,29 @@ bool FaultManager::IsInGeneratedCode(siginfo_t* siginfo, void* context) {
     return false;
   }
 
-  // Walk over the list of registered code ranges.
-  GeneratedCodeRange* range = generated_code_ranges_.load(std::memory_order_acquire);
-  while (range != nullptr) {
-    if (fault_pc - reinterpret_cast<uintptr_t>(range->start) < range->size) {
+  // Search the registered code ranges. We may or may not see a concurrently added or
+  // removed range, depending on which table we load, but we should not execute removed code
+  // anymore and a thread cannot fault in a range before it is registered (see
+  // `AddGeneratedCodeRange()`). Correct memory visibility of the table contents is ensured
+  // by the release and acquire operations on `generated_code_ranges_`.
+  const GeneratedCodeRangeTable* table = generated_code_ranges_.load(std::memory_order_acquire);
+  if (table == nullptr) {
+    return false;
+  }
+  const std::vector<GeneratedCodeRange>& ranges = table->ranges;
+  // Find the last range starting at or below the fault PC and look back through any
+  // ranges overlapping it.
+  size_t index = std::upper_bound(
+      ranges.begin(),
+      ranges.end(),
+      fault_pc,
+      [](uintptr_t lhs, const GeneratedCodeRange& rhs) { return lhs < rhs.start; }) -
+      ranges.begin();
+  while (index != 0u && fault_pc < ranges[index - 1u].max_end) {
+    --index;
+    if (fault_pc - ranges[index].start < ranges[index].size) {
       return true;
     }
-    // We may or may not see ranges that were concurrently removed, depending
-    // on when the relaxed writes of the `next` links become visible. However,
-    // even if we're currently at a node that is being removed, we shall visit
-    // all remaining ranges that are not being removed as the removed nodes
-    // retain the `next` link at the time of removal (which may lead to other
-    // removed nodes before reaching remaining retained nodes, if any). Correct
-    // memory visibility of `start` and `size` fields of the visited ranges is
-    // ensured by the release and acquire operations on `generated_code_ranges_`.
-    range = range->next.load(std::memory_order_relaxed);
   }
   return false;
 }
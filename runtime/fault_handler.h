@@ -77,14 +77,25 @@ class FaultManager {
 
  private:
   struct GeneratedCodeRange {
-    std::atomic<GeneratedCodeRange*> next;
-    const void* start;
+    uintptr_t start;
     size_t size;
+    // The maximum end of this and all preceding ranges in the table, so that a lookup can
+    // stop early if the ranges overlap.
+    uintptr_t max_end;
   };
 
-  GeneratedCodeRange* CreateGeneratedCodeRange(const void* start, size_t size)
+  // An immutable table of the registered code ranges, sorted by start address. Modifications
+  // publish a new table and retire the old one, which is freed once no thread can be walking
+  // it anymore.
+  struct GeneratedCodeRangeTable {
+    std::vector<GeneratedCodeRange> ranges;
+    GeneratedCodeRangeTable* next_retired = nullptr;
+  };
+
+  // Publishes a table with `ranges` and retires the current one.
+  void PublishGeneratedCodeRanges(std::vector<GeneratedCodeRange>&& ranges)
       REQUIRES(generated_code_ranges_lock_);
-  void FreeGeneratedCodeRange(GeneratedCodeRange* range) REQUIRES(!generated_code_ranges_lock_);
+  static void FreeGeneratedCodeRangeTables(GeneratedCodeRangeTable* table);
 
   // The HandleFaultByOtherHandlers function is only called by HandleFault function for generated code.
   bool HandleFaultByOtherHandlers(int sig, siginfo_t* info, void* context)
@@ -98,24 +109,17 @@ class FaultManager {
       NO_THREAD_SAFETY_ANALYSIS;
 
   // Note: The lock guards modifications of the ranges but the function `IsInGeneratedCode()`
-  // walks the list in the context of a signal handler without holding the lock.
+  // searches the table in the context of a signal handler without holding the lock.
   Mutex generated_code_ranges_lock_;
-  std::atomic<GeneratedCodeRange*> generated_code_ranges_ GUARDED_BY(generated_code_ranges_lock_);
+  std::atomic<GeneratedCodeRangeTable*> generated_code_ranges_
+      GUARDED_BY(generated_code_ranges_lock_);
+  // Tables replaced since the last checkpoint in `RemoveGeneratedCodeRange()`.
+  GeneratedCodeRangeTable* retired_generated_code_ranges_ GUARDED_BY(generated_code_ranges_lock_);
 
   std::vector<FaultHandler*> generated_code_handlers_;
   std::vector<FaultHandler*> other_handlers_;
   bool initialized_;
 
-  // We keep a certain number of generated code ranges locally to avoid too many
-  // cache misses while traversing the singly-linked list `generated_code_ranges_`.
-  // 16 should be enough for the boot image (assuming `--multi-image`; there is
-  // only one entry for `--single-image`), nterp, JIT code cache and a few other
-  // entries for the app or system server.
-  static constexpr size_t kNumLocalGeneratedCodeRanges = 16;
-  GeneratedCodeRange generated_code_ranges_storage_[kNumLocalGeneratedCodeRanges];
-  GeneratedCodeRange* free_generated_code_ranges_
-       GUARDED_BY(generated_code_ranges_lock_);
-
   DISALLOW_COPY_AND_ASSIGN(FaultManager);
 };
 
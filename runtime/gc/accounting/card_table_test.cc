@@ -145,6 +145,45 @@ TEST_F(CardTableTest, TestModifyCardsAtomic) {
   }
 }
 
+class CountingAgeVisitor {
+ public:
+  explicit CountingAgeVisitor(size_t* count) : count_(count) {}
+  uint8_t operator()(uint8_t c) const {
+    return c == CardTable::kCardDirty ? c - 1 : 0;
+  }
+  void operator()(uint8_t* card, uint8_t expected_value, uint8_t new_value) const {
+    EXPECT_EQ(expected_value, CardTable::kCardDirty);
+    EXPECT_EQ(new_value, *card);
+    ++*count_;
+  }
+
+ private:
+  size_t* const count_;
+};
+
+// Sparse dirty cards, so that most of the range is skipped a block of words at a time.
+TEST_F(CardTableTest, TestModifyCardsAtomicSparse) {
+  CommonSetup();
+  constexpr size_t kStride = 37;
+  size_t num_dirty = 0;
+  size_t index = 0;
+  for (uint8_t* addr = HeapBegin(); addr < HeapLimit(); addr += CardTable::kCardSize, ++index) {
+    if (index % kStride == 0) {
+      card_table_->MarkCard(addr);
+      ++num_dirty;
+    }
+  }
+  size_t num_modified = 0;
+  CountingAgeVisitor visitor(&num_modified);
+  card_table_->ModifyCardsAtomic(HeapBegin(), HeapLimit(), visitor, visitor);
+  EXPECT_EQ(num_modified, num_dirty);
+  index = 0;
+  for (uint8_t* addr = HeapBegin(); addr < HeapLimit(); addr += CardTable::kCardSize, ++index) {
+    EXPECT_EQ(*card_table_->CardFromAddr(addr),
+              index % kStride == 0 ? CardTable::kCardDirty - 1 : CardTable::kCardClean);
+  }
+}
+
 // TODO: Add test for CardTable::Scan.
 }  // namespace accounting
 }  // namespace gc
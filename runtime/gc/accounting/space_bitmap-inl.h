@@ -100,6 +100,54 @@ inline mirror::Object* SpaceBitmap<kAlignment>::FindPrecedingObject(uintptr_t vi
   }
 }
 
+// Number of bitmap words checked together when skipping unmarked parts of a range. Marked
+// objects are often sparse, and OR-ing a block of words before looking at individual ones lets
+// the compiler use the widest vector loads available for the target.
+static constexpr size_t kEmptyBitmapBlockWords = 4;
+
+// Returns true if none of the `kEmptyBitmapBlockWords` words at `word` have a bit set.
+ALWAYS_INLINE static inline bool IsEmptyBitmapBlock(const Atomic<uintptr_t>* word) {
+  uintptr_t bits = 0;
+  for (size_t i = 0; i < kEmptyBitmapBlockWords; ++i) {
+    bits |= word[i].load(std::memory_order_relaxed);
+  }
+  return bits == 0;
+}
+
+template<size_t kAlignment>
+inline size_t SpaceBitmap<kAlignment>::CountMarkedRange(uintptr_t visit_begin,
+                                                        uintptr_t visit_end) const {
+  DCHECK_LE(visit_begin, visit_end);
+  DCHECK_LE(heap_begin_, visit_begin);
+  DCHECK_LE(visit_end, HeapLimit());
+  if (visit_begin == visit_end) {
+    return 0;
+  }
+  const uintptr_t offset_start = visit_begin - heap_begin_;
+  const uintptr_t offset_end = visit_end - heap_begin_;
+  const uintptr_t index_start = OffsetToIndex(offset_start);
+  const uintptr_t index_end = OffsetToIndex(offset_end);
+  const size_t bit_start = OffsetBitIndex(offset_start);
+  const size_t bit_end = OffsetBitIndex(offset_end);
+
+  uintptr_t left_edge = bitmap_begin_[index_start].load(std::memory_order_relaxed);
+  left_edge &= ~((static_cast<uintptr_t>(1) << bit_start) - 1);
+  if (index_start == index_end) {
+    return POPCOUNT(left_edge & ((static_cast<uintptr_t>(1) << bit_end) - 1));
+  }
+  size_t count = POPCOUNT(left_edge);
+  for (size_t i = index_start + 1; i < index_end; ++i) {
+    count += POPCOUNT(bitmap_begin_[i].load(std::memory_order_relaxed));
+  }
+  // Do not read the word containing visit_end if there is nothing to count in it, as it could
+  // be after the end of the bitmap.
+  if (bit_end != 0) {
+    uintptr_t right_edge = bitmap_begin_[index_end].load(std::memory_order_relaxed);
+    count += POPCOUNT(right_edge & ((static_cast<uintptr_t>(1) << bit_end) - 1));
+  }
+  return count;
+}
+
 template<size_t kAlignment>
 template<bool kVisitOnce, typename Visitor>
 inline void SpaceBitmap<kAlignment>::VisitMarkedRange(uintptr_t visit_begin,
@@ -160,6 +208,13 @@ inline void SpaceBitmap<kAlignment>::VisitMarkedRange(uintptr_t visit_begin,
 
     // Traverse the middle, full part.
     for (size_t i = index_start + 1; i < index_end; ++i) {
+      // Skip whole blocks of unmarked words at a time.
+      while (index_end - i >= kEmptyBitmapBlockWords && IsEmptyBitmapBlock(&bitmap_begin_[i])) {
+        i += kEmptyBitmapBlockWords;
+      }
+      if (i >= index_end) {
+        break;
+      }
       uintptr_t w = bitmap_begin_[i].load(std::memory_order_relaxed);
       if (w != 0) {
         const uintptr_t ptr_base = IndexToOffset(i) + heap_begin_;
@@ -160,14 +160,34 @@ template<size_t kAlignment>
 void SpaceBitmap<kAlignment>::ClearRange(const mirror::Object* begin, const mirror::Object* end) {
   uintptr_t begin_offset = reinterpret_cast<uintptr_t>(begin) - heap_begin_;
   uintptr_t end_offset = reinterpret_cast<uintptr_t>(end) - heap_begin_;
-  // Align begin and end to bitmap word boundaries.
-  while (begin_offset < end_offset && OffsetBitIndex(begin_offset) != 0) {
-    Clear(reinterpret_cast<mirror::Object*>(heap_begin_ + begin_offset));
-    begin_offset += kAlignment;
+  if (begin_offset >= end_offset) {
+    return;
+  }
+  // Clear the partial words at either end with a single masked store each, aligning begin and
+  // end to bitmap word boundaries.
+  const uintptr_t begin_bit = OffsetBitIndex(begin_offset);
+  const uintptr_t end_bit = OffsetBitIndex(end_offset);
+  const uintptr_t begin_index = OffsetToIndex(begin_offset);
+  const uintptr_t last_index = OffsetToIndex(end_offset);
+  // Bits below `end_bit` in the word containing end_offset.
+  const uintptr_t end_mask = (static_cast<uintptr_t>(1) << end_bit) - 1;
+  if (begin_bit != 0) {
+    uintptr_t clear_mask = ~((static_cast<uintptr_t>(1) << begin_bit) - 1);
+    if (begin_index == last_index) {
+      // Range is within a single word.
+      clear_mask &= end_mask;
+    }
+    Atomic<uintptr_t>* word = &bitmap_begin_[begin_index];
+    word->store(word->load(std::memory_order_relaxed) & ~clear_mask, std::memory_order_relaxed);
+    if (begin_index == last_index) {
+      return;
+    }
+    begin_offset = IndexToOffset(begin_index + 1);
   }
-  while (begin_offset < end_offset && OffsetBitIndex(end_offset) != 0) {
-    end_offset -= kAlignment;
-    Clear(reinterpret_cast<mirror::Object*>(heap_begin_ + end_offset));
+  if (end_bit != 0) {
+    Atomic<uintptr_t>* word = &bitmap_begin_[last_index];
+    word->store(word->load(std::memory_order_relaxed) & ~end_mask, std::memory_order_relaxed);
+    end_offset = IndexToOffset(last_index);
   }
   // Bitmap word boundaries.
   const uintptr_t start_index = OffsetToIndex(begin_offset);
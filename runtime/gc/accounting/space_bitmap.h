@@ -147,6 +147,10 @@ class SpaceBitmap {
   void VisitMarkedRange(uintptr_t visit_begin, uintptr_t visit_end, Visitor&& visitor) const
       NO_THREAD_SAFETY_ANALYSIS;
 
+  // Return the number of marked objects in the range [visit_begin, visit_end), counting whole
+  // bitmap words with popcount. Multiply by kAlignment for an upper bound of the live bytes.
+  size_t CountMarkedRange(uintptr_t visit_begin, uintptr_t visit_end) const;
+
   // Visit all of the set bits in HeapBegin(), HeapLimit().
   template <typename Visitor>
   void VisitAllMarked(Visitor&& visitor) const {
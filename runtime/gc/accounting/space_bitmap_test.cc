@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "base/mutex.h"
+#include "base/time_utils.h"
 #include "common_runtime_test.h"
 #include "gc/space/large_object_space.h"
 #include "runtime_globals.h"
@@ -245,6 +246,49 @@ TYPED_TEST(SpaceBitmapTest, VisitorAlignment) {
   RunTest<SpaceBitmap>(TypeParam::GetObjectAlignment(), count_test_fn);
 }
 
+TYPED_TEST(SpaceBitmapTest, CountMarkedRange) {
+  using SpaceBitmap = typename TypeParam::SpaceBitmap;
+  auto count_test_fn = [](SpaceBitmap* space_bitmap,
+                          uintptr_t range_begin,
+                          uintptr_t range_end,
+                          size_t manual_count) {
+    EXPECT_EQ(space_bitmap->CountMarkedRange(range_begin, range_end), manual_count);
+  };
+  RunTest<SpaceBitmap>(TypeParam::GetObjectAlignment(), count_test_fn);
+}
+
+// Microbenchmark for visiting a sparsely marked bitmap, where most of the time goes into
+// skipping unmarked words. Also checks that the visit agrees with CountMarkedRange().
+TYPED_TEST(SpaceBitmapTest, SparseVisitTiming) {
+  using SpaceBitmap = typename TypeParam::SpaceBitmap;
+  uint8_t* heap_begin = reinterpret_cast<uint8_t*>(0x10000000);
+  const size_t heap_capacity = 16 * MB;
+  const size_t alignment = TypeParam::GetObjectAlignment();
+  SpaceBitmap space_bitmap(SpaceBitmap::Create("test bitmap", heap_begin, heap_capacity));
+  EXPECT_TRUE(space_bitmap.IsValid());
+  // Mark one object in every 1000.
+  size_t marked = 0;
+  for (size_t offset = 0; offset < heap_capacity; offset += 1000 * alignment) {
+    space_bitmap.Set(reinterpret_cast<mirror::Object*>(heap_begin + offset));
+    ++marked;
+  }
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(heap_begin);
+  const uintptr_t end = begin + heap_capacity;
+  constexpr size_t kIterations = 20;
+  size_t visited = 0;
+  const uint64_t start_time = NanoTime();
+  for (size_t i = 0; i < kIterations; ++i) {
+    space_bitmap.VisitMarkedRange(begin, end, [&visited]([[maybe_unused]] mirror::Object* obj) {
+      visited++;
+    });
+  }
+  const uint64_t visit_time = NanoTime() - start_time;
+  EXPECT_EQ(visited, marked * kIterations);
+  EXPECT_EQ(space_bitmap.CountMarkedRange(begin, end), marked);
+  LOG(INFO) << "Visited " << marked << " sparse objects with alignment " << alignment << " in "
+            << PrettyDuration(visit_time / kIterations);
+}
+
 TYPED_TEST(SpaceBitmapTest, OrderAlignment) {
   using SpaceBitmap = typename TypeParam::SpaceBitmap;
   auto order_test_fn = [](SpaceBitmap* space_bitmap,
@@ -27,6 +27,14 @@ inline ALWAYS_INLINE bool RosAlloc::ShouldCheckZeroMemory() {
   return kCheckZeroMemory && !is_running_on_memory_tool_;
 }
 
+inline ALWAYS_INLINE void RosAlloc::RecordRequestedSize(size_t size) {
+  if (kTrackRequestedSizes) {
+    const size_t idx = SizeToIndex(size);
+    requested_bytes_[idx].fetch_add(size, std::memory_order_relaxed);
+    num_requests_[idx].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
 template<bool kThreadSafe>
 inline ALWAYS_INLINE void* RosAlloc::Alloc(Thread* self, size_t size, size_t* bytes_allocated,
                                            size_t* usable_size,
@@ -42,6 +50,9 @@ inline ALWAYS_INLINE void* RosAlloc::Alloc(Thread* self, size_t size, size_t* by
     m = AllocFromRunThreadUnsafe(self, size, bytes_allocated, usable_size,
                                  bytes_tl_bulk_allocated);
   }
+  if (m != nullptr) {
+    RecordRequestedSize(size);
+  }
   // Check if the returned memory is really all zero.
   if (ShouldCheckZeroMemory() && m != nullptr) {
     uint8_t* bytes = reinterpret_cast<uint8_t*>(m);
@@ -95,6 +106,7 @@ inline void* RosAlloc::AllocFromThreadLocalRun(Thread* self, size_t size,
   void* slot_addr = thread_local_run->AllocSlot();
   if (LIKELY(slot_addr != nullptr)) {
     *bytes_allocated = bracket_size;
+    RecordRequestedSize(size);
   }
   return slot_addr;
 }
@@ -2161,7 +2161,25 @@ void RosAlloc::DumpStats(std::ostream& os) {
        << " #metadata_bytes=" << PrettySize(num_metadata_bytes[i])
        << " #slots=" << num_slots[i] << " (" << PrettySize(num_slots[i] * bracketSizes[i]) << ")"
        << " #used_slots=" << num_used_slots[i]
-       << " (" << PrettySize(num_used_slots[i] * bracketSizes[i]) << ")\n";
+       << " (" << PrettySize(num_used_slots[i] * bracketSizes[i]) << ")";
+    if (num_slots[i] != 0) {
+      // Free slots in partially used runs, including the thread-local ones.
+      os << " run_fragmentation="
+         << (100 * (num_slots[i] - num_used_slots[i]) / num_slots[i]) << "%";
+    }
+    if (kTrackRequestedSizes) {
+      const uint64_t num_requests = num_requests_[i].load(std::memory_order_relaxed);
+      const uint64_t requested_bytes = requested_bytes_[i].load(std::memory_order_relaxed);
+      if (num_requests != 0) {
+        // Bytes lost to rounding requests up to the bracket size, since startup.
+        const uint64_t bracket_bytes = num_requests * bracketSizes[i];
+        os << " #requests=" << num_requests
+           << " avg_request=" << requested_bytes / num_requests
+           << " internal_fragmentation="
+           << (100 * (bracket_bytes - requested_bytes) / bracket_bytes) << "%";
+      }
+    }
+    os << "\n";
   }
   os << "Large #allocations=" << num_large_objects
      << " #pages=" << num_pages_large_objects
@@ -2176,9 +2194,15 @@ void RosAlloc::DumpStats(std::ostream& os) {
   }
   total_num_pages += num_pages_large_objects;
   total_allocated_bytes += num_pages_large_objects * gPageSize;
-  os << "Total #total_bytes=" << PrettySize(total_num_pages * gPageSize)
+  const size_t total_bytes = total_num_pages * gPageSize;
+  os << "Total #total_bytes=" << PrettySize(total_bytes)
      << " #metadata_bytes=" << PrettySize(total_metadata_bytes)
-     << " #used_bytes=" << PrettySize(total_allocated_bytes) << "\n";
+     << " #used_bytes=" << PrettySize(total_allocated_bytes);
+  if (total_bytes != 0) {
+    os << " fragmentation="
+       << (100 * (total_bytes - std::min(total_bytes, total_allocated_bytes)) / total_bytes) << "%";
+  }
+  os << "\n";
   os << "\n";
 }
 
@@ -631,6 +631,12 @@ class RosAlloc {
   // If true, log verbose details of operations.
   static constexpr bool kTraceRosAlloc = false;
 
+  // If true, count the requested bytes of allocations per size bracket so that DumpStats() can
+  // report the internal fragmentation from rounding up to bracket sizes. Allocations done by the
+  // compiled code fast paths are not counted.
+  static constexpr bool kTrackRequestedSizes = false;
+  ALWAYS_INLINE void RecordRequestedSize(size_t size);
+
   struct hash_run {
     size_t operator()(const RosAlloc::Run* r) const {
       return reinterpret_cast<size_t>(r);
@@ -769,6 +775,11 @@ class RosAlloc {
   // Whether this allocator is running on a memory tool.
   bool is_running_on_memory_tool_;
 
+  // Sums of the requested sizes, and number of allocations, per size bracket. Only updated if
+  // kTrackRequestedSizes.
+  Atomic<uint64_t> requested_bytes_[kNumOfSizeBrackets];
+  Atomic<uint64_t> num_requests_[kNumOfSizeBrackets];
+
   // The base address of the memory region that's managed by this allocator.
   uint8_t* Begin() { return base_; }
   // The end address of the memory region that's managed by this allocator.
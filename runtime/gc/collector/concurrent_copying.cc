@@ -423,6 +423,7 @@ void ConcurrentCopying::InitializePhase() {
   if (!use_generational_cc_ || !young_gen_) {
     if (gc_cause == kGcCauseExplicit ||
         gc_cause == kGcCauseCollectorTransition ||
+        gc_cause == kGcCauseIdleCompaction ||
         GetCurrentIteration()->GetClearSoftReferences()) {
       force_evacuate_all_ = true;
     }
@@ -755,6 +756,7 @@ void ConcurrentCopying::FlipThreadRoots() {
 
   Runtime::Current()->GetThreadList()->FlipThreadRoots(
       &thread_flip_visitor, &flip_callback, this, GetHeap()->GetGcPauseListener());
+  ReportLastPause(Runtime::Current()->GetMetrics()->GcFlipPauseTime());
 
   is_asserting_to_space_invariant_ = true;
   QuasiAtomic::ThreadFenceForConstructor();  // TODO: Remove?
@@ -138,6 +138,13 @@ void GarbageCollector::RegisterPause(uint64_t nano_length) {
   GetCurrentIteration()->pause_times_.push_back(nano_length);
 }
 
+void GarbageCollector::ReportLastPause(metrics::MetricsBase<int64_t>* histogram) {
+  const std::vector<uint64_t>& pause_times = GetCurrentIteration()->GetPauseTimes();
+  if (!pause_times.empty()) {
+    histogram->Add(NsToUs(pause_times.back()));
+  }
+}
+
 uint64_t GarbageCollector::ExtractRssFromMincore(
     std::list<std::pair<void*, void*>>* gc_ranges) {
   uint64_t rss = 0;
@@ -227,13 +234,31 @@ void GarbageCollector::Run(GcCause gc_cause, bool clear_soft_references) {
     RegisterPause(duration_ns);
   }
   total_time_ns_ += duration_ns;
+  metrics::ArtMetrics* metrics = runtime->GetMetrics();
   uint64_t total_pause_time_ns = 0;
   for (uint64_t pause_time : current_iteration->GetPauseTimes()) {
     MutexLock mu(self, pause_histogram_lock_);
     pause_histogram_.AdjustAndAddValue(pause_time);
     total_pause_time_ns += pause_time;
+    metrics->GcPauseTime()->Add(NsToUs(pause_time));
+  }
+  switch (gc_cause) {
+    case kGcCauseForAlloc:
+      metrics->GcForAllocCount()->AddOne();
+      break;
+    case kGcCauseBackground:
+      metrics->GcBackgroundCount()->AddOne();
+      break;
+    case kGcCauseExplicit:
+      metrics->GcExplicitCount()->AddOne();
+      break;
+    case kGcCauseForNativeAlloc:
+      metrics->GcForNativeAllocCount()->AddOne();
+      break;
+    default:
+      metrics->GcOtherCauseCount()->AddOne();
+      break;
   }
-  metrics::ArtMetrics* metrics = runtime->GetMetrics();
   // Report STW pause time in microseconds.
   const uint64_t total_pause_time_us = total_pause_time_ns / 1'000;
   metrics->WorldStopTimeDuringGCAvg()->Add(total_pause_time_us);
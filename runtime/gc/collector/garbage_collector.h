@@ -83,6 +83,8 @@ class GarbageCollector : public RootVisitor, public IsMarkedVisitor, public Mark
     return heap_;
   }
   void RegisterPause(uint64_t nano_length);
+  // Reports the length of the last registered pause, in microseconds, to `histogram`.
+  void ReportLastPause(metrics::MetricsBase<int64_t>* histogram);
   const CumulativeLogger& GetCumulativeTimings() const {
     return cumulative_timings_;
   }
@@ -25,18 +25,27 @@ namespace art HIDDEN {
 namespace gc {
 namespace collector {
 
+template <bool kParallel>
 inline void MarkCompact::UpdateClassAfterObjectMap(mirror::Object* obj) {
   mirror::Class* klass = obj->GetClass<kVerifyNone, kWithoutReadBarrier>();
   if (UNLIKELY(std::less<mirror::Object*>{}(obj, klass) && HasAddress(klass))) {
-    auto [iter, success] = class_after_obj_map_.try_emplace(ObjReference::FromMirrorPtr(klass),
-                                                            ObjReference::FromMirrorPtr(obj));
-    if (!success && std::less<mirror::Object*>{}(obj, iter->second.AsMirrorPtr())) {
-      iter->second = ObjReference::FromMirrorPtr(obj);
+    auto update = [&]() {
+      auto [iter, success] = class_after_obj_map_.try_emplace(ObjReference::FromMirrorPtr(klass),
+                                                              ObjReference::FromMirrorPtr(obj));
+      if (!success && std::less<mirror::Object*>{}(obj, iter->second.AsMirrorPtr())) {
+        iter->second = ObjReference::FromMirrorPtr(obj);
+      }
+    };
+    if (kParallel) {
+      MutexLock mu(Thread::Current(), lock_);
+      update();
+    } else {
+      update();
     }
   }
 }
 
-template <size_t kAlignment>
+template <size_t kAlignment> template <bool kAtomic>
 inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_t begin,
                                                                         size_t size) {
   const uintptr_t begin_bit_idx = MemRangeBitmap::BitIndexFromAddr(begin);
@@ -50,8 +59,15 @@ inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_
   uintptr_t mask = Bitmap::BitIndexToMask(begin_bit_idx);
   // Bits that needs to be set in the first word, if it's not also the last word
   mask = ~(mask - 1);
+  auto set_bits = [](uintptr_t* bm_address, uintptr_t bits) {
+    if (kAtomic) {
+      reinterpret_cast<Atomic<uintptr_t>*>(bm_address)->fetch_or(bits, std::memory_order_relaxed);
+    } else {
+      *bm_address |= bits;
+    }
+  };
   if (diff > 0) {
-    *begin_bm_address |= mask;
+    set_bits(begin_bm_address, mask);
     mask = ~0;
     // Even though memset can handle the (diff == 1) case but we should avoid the
     // overhead of a function call for this, highly likely (as most of the objects
@@ -62,7 +78,7 @@ inline uintptr_t MarkCompact::LiveWordsBitmap<kAlignment>::SetLiveWords(uintptr_
     }
   }
   uintptr_t end_mask = Bitmap::BitIndexToMask(end_bit_idx);
-  *end_bm_address |= mask & (end_mask | (end_mask - 1));
+  set_bits(end_bm_address, mask & (end_mask | (end_mask - 1)));
   return begin_bit_idx;
 }
 
@@ -276,6 +292,7 @@ inline bool MarkCompact::VerifyRootSingleUpdate(void* root,
       }
     }
     DCHECK(reinterpret_cast<uint8_t*>(old_ref) >= black_allocations_begin_ ||
+           reinterpret_cast<uint8_t*>(old_ref) < old_gen_end_ ||
            live_words_bitmap_->Test(old_ref))
         << "ref=" << old_ref << " <" << mirror::Object::PrettyTypeOf(old_ref) << "> RootInfo ["
         << info << "]";
@@ -356,6 +373,11 @@ inline mirror::Object* MarkCompact::PostCompactAddressUnchecked(mirror::Object*
   if (reinterpret_cast<uint8_t*>(old_ref) >= black_allocations_begin_) {
     return PostCompactBlackObjAddr(old_ref);
   }
+  if (reinterpret_cast<uint8_t*>(old_ref) < old_gen_end_) {
+    // Old-generation objects don't move in young-generation cycles.
+    DCHECK(moving_space_bitmap_->Test(old_ref)) << "ref=" << old_ref;
+    return old_ref;
+  }
   if (kIsDebugBuild) {
     mirror::Object* from_ref = GetFromSpaceAddr(old_ref);
     DCHECK(live_words_bitmap_->Test(old_ref))
@@ -28,6 +28,7 @@
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <fstream>
 #include <numeric>
 #include <string>
@@ -57,6 +58,7 @@
 #include "scoped_thread_state_change-inl.h"
 #include "sigchain.h"
 #include "thread_list.h"
+#include "thread_pool.h"
 
 #ifdef ART_TARGET_ANDROID
 #include "android-modules-utils/sdk_level.h"
@@ -334,6 +336,13 @@ static constexpr size_t kMutatorCompactionBufferCount = 2048;
 // Minimum from-space chunk to be madvised (during concurrent compaction) in one go.
 // Choose a reasonable size to avoid making too many batched ioctl and madvise calls.
 static constexpr ssize_t kMinFromSpaceMadviseSize = 8 * MB;
+// Don't bother with parallel marking for very small mark stacks.
+static constexpr size_t kMinimumParallelMarkStackSize = 128;
+// Don't bother with parallel thread-root marking in the pause for few threads.
+static constexpr size_t kMinimumParallelThreadRootsCount = 32;
+// Maximum number of concurrent card pre-cleaning rounds when a pause target is
+// set (see Heap::GetCardPreCleanPauseTarget()).
+static constexpr size_t kMaxPreCleanRounds = 4;
 // Concurrent compaction termination logic is different (and slightly more efficient) if the
 // kernel has the fault-retry feature (allowing repeated faults on the same page), which was
 // introduced in 5.7 (https://android-review.git.corp.google.com/c/kernel/common/+/1540088).
@@ -447,9 +456,16 @@ MarkCompact::MarkCompact(Heap* heap)
       moving_space_bitmap_(bump_pointer_space_->GetMarkBitmap()),
       moving_space_begin_(bump_pointer_space_->Begin()),
       moving_space_end_(bump_pointer_space_->Limit()),
+      old_gen_end_(moving_space_begin_),
+      old_gen_objects_(0),
+      full_gc_freed_bytes_(0),
+      full_gc_duration_ns_(0),
+      full_gc_count_(0),
       uffd_(kFdUnused),
       sigbus_in_progress_count_{kSigbusCounterCompactionDoneMask, kSigbusCounterCompactionDoneMask},
       compacting_(false),
+      use_generational_(heap->GetUseGenerationalCMC()),
+      young_gen_(false),
       marking_done_(false),
       uffd_initialized_(false),
       clamp_info_map_status_(ClampInfoStatus::kClampInfoNotDone) {
@@ -645,30 +661,70 @@ void MarkCompact::PrepareCardTableForMarking(bool clear_alloc_space_cards) {
     } else if (clear_alloc_space_cards) {
       CHECK(!space->IsZygoteSpace());
       CHECK(!space->IsImageSpace());
-      // The card-table corresponding to bump-pointer and non-moving space can
-      // be cleared, because we are going to traverse all the reachable objects
-      // in these spaces. This card-table will eventually be used to track
-      // mutations while concurrent marking is going on.
-      card_table->ClearCardRange(space->Begin(), space->Limit());
       if (space != bump_pointer_space_) {
         CHECK_EQ(space, heap_->GetNonMovingSpace());
         non_moving_space_ = space;
         non_moving_space_bitmap_ = space->GetMarkBitmap();
       }
+      // The card-table corresponding to bump-pointer and non-moving space can
+      // be cleared, because we are going to traverse all the reachable objects
+      // in these spaces. This card-table will eventually be used to track
+      // mutations while concurrent marking is going on.
+      // In young-generation cycles, the old-generation objects are not
+      // traversed. So age their cards instead, as they are the ones which can
+      // hold references into the young-generation.
+      uint8_t* clear_begin = space->Begin();
+      if (young_gen_) {
+        clear_begin = space == bump_pointer_space_ ? old_gen_end_ : space->Limit();
+        card_table->ModifyCardsAtomic(space->Begin(),
+                                      clear_begin,
+                                      [](uint8_t card) {
+                                        return (card == accounting::CardTable::kCardDirty) ?
+                                                   accounting::CardTable::kCardAged :
+                                                   card;
+                                      },
+                                      /* card modified visitor */ VoidFunctor());
+      }
+      card_table->ClearCardRange(clear_begin, space->Limit());
     } else {
+      // Aged cards have to be retained in young-generation cycles until the
+      // compaction pause, where references in the corresponding old objects
+      // are updated.
+      const bool retain_aged_cards = young_gen_;
       card_table->ModifyCardsAtomic(
           space->Begin(),
           space->End(),
-          [](uint8_t card) {
-            return (card == gc::accounting::CardTable::kCardDirty) ?
-                       gc::accounting::CardTable::kCardAged :
-                       gc::accounting::CardTable::kCardClean;
+          [retain_aged_cards](uint8_t card) {
+            if (card == gc::accounting::CardTable::kCardDirty) {
+              return gc::accounting::CardTable::kCardAged;
+            }
+            return retain_aged_cards ? card : gc::accounting::CardTable::kCardClean;
           },
           /* card modified visitor */ VoidFunctor());
     }
   }
 }
 
+void MarkCompact::BindBitmaps() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  DCHECK(young_gen_);
+  // Bind the live bitmap to the mark bitmap of non-moving space. As a result,
+  // all the objects which survived the previous GC cycle are implicitly
+  // marked and new allocations get marked into the live bitmap. Those not
+  // marked by the end of this cycle are reclaimed from the live stack in
+  // Sweep().
+  for (const auto& space : GetHeap()->GetContinuousSpaces()) {
+    if (space->IsContinuousMemMapAllocSpace() && space != bump_pointer_space_ &&
+        space->GetGcRetentionPolicy() == space::kGcRetentionPolicyAlwaysCollect) {
+      space->AsContinuousMemMapAllocSpace()->BindLiveToMarkBitmap();
+    }
+  }
+  for (const auto& space : GetHeap()->GetDiscontinuousSpaces()) {
+    CHECK(space->IsLargeObjectSpace());
+    space->AsLargeObjectSpace()->CopyLiveToMarked();
+  }
+}
+
 void MarkCompact::MarkZygoteLargeObjects() {
   Thread* self = thread_running_gc_;
   DCHECK_EQ(self, Thread::Current());
@@ -703,10 +759,34 @@ void MarkCompact::InitializePhase() {
   freed_objects_ = 0;
   // The first buffer is used by gc-thread.
   compaction_buffer_counter_.store(1, std::memory_order_relaxed);
+  gc_thread_uffd_pages_ = 0;
+  mutator_uffd_pages_.store(0, std::memory_order_relaxed);
+  uffd_ioctl_retries_.store(0, std::memory_order_relaxed);
+  uffd_ioctl_errors_.store(0, std::memory_order_relaxed);
   from_space_slide_diff_ = from_space_begin_ - bump_pointer_space_->Begin();
   black_allocations_begin_ = bump_pointer_space_->Limit();
   CHECK_EQ(moving_space_begin_, bump_pointer_space_->Begin());
   moving_space_end_ = bump_pointer_space_->Limit();
+  // A young-generation cycle requires an old-generation to be established by
+  // a preceding cycle. Zygote doesn't have one as the moving space is emptied
+  // into zygote space at fork. Also, there is nothing to collect if the
+  // old-generation occupies the entire space.
+  if (young_gen_ && (old_gen_end_ == moving_space_begin_ || old_gen_end_ >= moving_space_end_ ||
+                     Runtime::Current()->IsZygote())) {
+    young_gen_ = false;
+  }
+  if (!young_gen_) {
+    if (old_gen_end_ > moving_space_begin_) {
+      // Mark-bits of the old-generation are retained after every cycle with
+      // generational collection. A full cycle has to start afresh.
+      moving_space_bitmap_->ClearRange(reinterpret_cast<mirror::Object*>(moving_space_begin_),
+                                       reinterpret_cast<mirror::Object*>(old_gen_end_));
+    }
+    old_gen_end_ = moving_space_begin_;
+    old_gen_objects_ = 0;
+  }
+  DCHECK_ALIGNED_PARAM(old_gen_end_, gPageSize);
+  DCHECK_LE(old_gen_end_, bump_pointer_space_->End());
   // TODO: Would it suffice to read it once in the constructor, which is called
   // in zygote process?
   pointer_size_ = Runtime::Current()->GetClassLinker()->GetImagePointerSize();
@@ -749,6 +829,7 @@ void MarkCompact::RunPhases() {
   Thread* self = Thread::Current();
   thread_running_gc_ = self;
   Runtime* runtime = Runtime::Current();
+  const uint64_t start_time = NanoTime();
   InitializePhase();
   GetHeap()->PreGcVerification(this);
   {
@@ -763,6 +844,7 @@ void MarkCompact::RunPhases() {
       bump_pointer_space_->AssertAllThreadLocalBuffersAreRevoked();
     }
   }
+  ReportLastPause(runtime->GetMetrics()->GcMarkingPauseTime());
   {
     ReaderMutexLock mu(self, *Locks::mutator_lock_);
     ReclaimPhase();
@@ -776,6 +858,7 @@ void MarkCompact::RunPhases() {
     runtime->GetThreadList()->FlipThreadRoots(
         &visitor, &callback, this, GetHeap()->GetGcPauseListener());
   }
+  ReportLastPause(runtime->GetMetrics()->GcCompactionPauseTime());
 
   if (IsValidFd(uffd_)) {
     ReaderMutexLock mu(self, *Locks::mutator_lock_);
@@ -784,11 +867,24 @@ void MarkCompact::RunPhases() {
 
   FinishPhase();
   thread_running_gc_ = nullptr;
+  if (use_generational_ && !young_gen_) {
+    const Iteration* iteration = GetCurrentIteration();
+    int64_t freed_bytes = iteration->GetFreedBytes() + iteration->GetFreedLargeObjectBytes();
+    full_gc_freed_bytes_ += std::max<int64_t>(freed_bytes, 0);
+    full_gc_duration_ns_ += NanoTime() - start_time;
+    full_gc_count_++;
+  }
+}
+
+uint64_t MarkCompact::GetEstimatedFullGcMeanThroughput() const {
+  // Add 1ms to prevent possible division by 0.
+  return (full_gc_freed_bytes_ * 1000) / (NsToMs(full_gc_duration_ns_) + 1);
 }
 
 void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
-  // Find the first live word first.
-  size_t to_space_page_idx = 0;
+  // Find the first live word first. The old-generation, if any, is not
+  // compacted. So start from the first page after it.
+  size_t to_space_page_idx = DivideByPageSize(old_gen_end_ - moving_space_begin_);
   uint32_t offset_in_chunk_word;
   uint32_t offset;
   mirror::Object* obj;
@@ -796,9 +892,12 @@ void MarkCompact::InitMovingSpaceFirstObjects(const size_t vec_len) {
 
   size_t chunk_idx;
   // Find the first live word in the space
-  for (chunk_idx = 0; chunk_info_vec_[chunk_idx] == 0; chunk_idx++) {
+  for (chunk_idx = (old_gen_end_ - moving_space_begin_) / kOffsetChunkSize;
+       chunk_info_vec_[chunk_idx] == 0;
+       chunk_idx++) {
     if (chunk_idx >= vec_len) {
       // We don't have any live data on the moving-space.
+      moving_first_objs_count_ = to_space_page_idx;
       return;
     }
   }
@@ -944,8 +1043,11 @@ void MarkCompact::PrepareForCompaction() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   uint8_t* space_begin = bump_pointer_space_->Begin();
   size_t vector_len = (black_allocations_begin_ - space_begin) / kOffsetChunkSize;
+  // Old-generation's chunks are not used, as it is not compacted.
+  const size_t old_gen_vector_len = (old_gen_end_ - space_begin) / kOffsetChunkSize;
   DCHECK_LE(vector_len, vector_length_);
-  for (size_t i = 0; i < vector_len; i++) {
+  DCHECK_LE(old_gen_vector_len, vector_len);
+  for (size_t i = old_gen_vector_len; i < vector_len; i++) {
     DCHECK_LE(chunk_info_vec_[i], kOffsetChunkSize);
     DCHECK_EQ(chunk_info_vec_[i], live_words_bitmap_->LiveBytesInBitmapWord(i));
   }
@@ -986,7 +1088,11 @@ void MarkCompact::PrepareForCompaction() {
     // std::exclusive_scan().
     total = chunk_info_vec_[vector_len - 1];
   }
-  std::exclusive_scan(chunk_info_vec_, chunk_info_vec_ + vector_len, chunk_info_vec_, 0);
+  // Objects after the old-generation are compacted right after its end.
+  std::exclusive_scan(chunk_info_vec_ + old_gen_vector_len,
+                      chunk_info_vec_ + vector_len,
+                      chunk_info_vec_ + old_gen_vector_len,
+                      static_cast<uint32_t>(old_gen_end_ - space_begin));
   total += chunk_info_vec_[vector_len - 1];
 
   for (size_t i = vector_len; i < vector_length_; i++) {
@@ -1054,8 +1160,18 @@ void MarkCompact::MarkingPause() {
       MutexLock mu2(thread_running_gc_, *Locks::runtime_shutdown_lock_);
       MutexLock mu3(thread_running_gc_, *Locks::thread_list_lock_);
       std::list<Thread*> thread_list = runtime->GetThreadList()->GetList();
+      // With many threads the stack walks dominate this pause. As all the
+      // threads are suspended, their stacks can be walked in parallel.
+      const size_t thread_count = GetMarkingThreadCount(/*paused=*/ true);
+      const bool parallel =
+          thread_count > 1 && thread_list.size() >= kMinimumParallelThreadRootsCount;
+      if (parallel) {
+        MarkThreadRootsParallel(thread_list, thread_count);
+      }
       for (Thread* thread : thread_list) {
-        thread->VisitRoots(this, static_cast<VisitRootFlags>(0));
+        if (!parallel) {
+          thread->VisitRoots(this, static_cast<VisitRootFlags>(0));
+        }
         DCHECK_EQ(thread->GetThreadLocalGcBuffer(), nullptr);
         // Need to revoke all the thread-local allocation stacks since we will
         // swap the allocation stacks (below) and don't want anybody to allocate
@@ -1066,7 +1182,8 @@ void MarkCompact::MarkingPause() {
     }
     // Fetch only the accumulated objects-allocated count as it is guaranteed to
     // be up-to-date after the TLAB revocation above.
-    freed_objects_ += bump_pointer_space_->GetAccumulatedObjectsAllocated();
+    // Old-generation objects are not discovered in young-generation cycles.
+    freed_objects_ += bump_pointer_space_->GetAccumulatedObjectsAllocated() - old_gen_objects_;
     // Capture 'end' of moving-space at this point. Every allocation beyond this
     // point will be considered as black.
     // Align-up to page boundary so that black allocations happen from next page
@@ -1125,6 +1242,22 @@ void MarkCompact::Sweep(bool swap_bitmaps) {
   // Ensure that nobody inserted objects in the live stack after we swapped the
   // stacks.
   CHECK_GE(live_stack_freeze_size_, GetHeap()->GetLiveStack()->Size());
+  if (young_gen_) {
+    // Bitmaps are bound in young-generation cycles. So only the objects
+    // allocated since the last GC, which are on the live stack, can be reclaimed
+    // from non-moving and large-object spaces.
+    DCHECK(mark_stack_->IsEmpty());
+    std::vector<space::ContinuousSpace*> sweep_spaces;
+    for (const auto& space : GetHeap()->GetContinuousSpaces()) {
+      if (space->IsContinuousMemMapAllocSpace() && space != bump_pointer_space_ &&
+          !immune_spaces_.ContainsSpace(space)) {
+        sweep_spaces.push_back(space);
+      }
+    }
+    TimingLogger::ScopedTiming t2("SweepArray", GetTimings());
+    SweepArray(GetHeap()->GetLiveStack(), swap_bitmaps, &sweep_spaces);
+    return;
+  }
   {
     TimingLogger::ScopedTiming t2("MarkAllocStackAsLive", GetTimings());
     // Mark everything allocated since the last GC as live so that we can sweep
@@ -1272,7 +1405,8 @@ void MarkCompact::VerifyObject(mirror::Object* ref, Callback& callback) const {
           << " post_compact_end=" << static_cast<void*>(post_compact_end_)
           << " pre_compact_klass=" << pre_compact_klass
           << " black_allocations_begin=" << static_cast<void*>(black_allocations_begin_);
-      CHECK(live_words_bitmap_->Test(pre_compact_klass));
+      CHECK(reinterpret_cast<uint8_t*>(pre_compact_klass) < old_gen_end_ ||
+            live_words_bitmap_->Test(pre_compact_klass));
     }
     if (!IsValidObject(ref)) {
       std::ostringstream oss;
@@ -1690,6 +1824,7 @@ size_t MarkCompact::ZeropageIoctl(void* addr,
     int ret = ioctl(uffd_, UFFDIO_ZEROPAGE, &uffd_zeropage);
     if (ret == 0) {
       DCHECK_EQ(uffd_zeropage.zeropage, static_cast<ssize_t>(length));
+      RecordUffdMappedBytes(length);
       return length;
     } else if (errno == EAGAIN) {
       if (uffd_zeropage.zeropage > 0) {
@@ -1697,10 +1832,12 @@ size_t MarkCompact::ZeropageIoctl(void* addr,
         // is already done, which is what we care about.
         DCHECK(IsAlignedParam(uffd_zeropage.zeropage, gPageSize));
         DCHECK_GE(uffd_zeropage.zeropage, static_cast<ssize_t>(gPageSize));
+        RecordUffdMappedBytes(uffd_zeropage.zeropage);
         return uffd_zeropage.zeropage;
       } else if (uffd_zeropage.zeropage < 0) {
         // mmap_read_trylock() failed due to contention. Back-off and retry.
         DCHECK_EQ(uffd_zeropage.zeropage, -EAGAIN);
+        uffd_ioctl_retries_.fetch_add(1, std::memory_order_relaxed);
         if (backoff_count == -1) {
           int prio = Thread::Current()->GetNativePriority();
           DCHECK(prio > 0 && prio <= 10) << prio;
@@ -1715,12 +1852,17 @@ size_t MarkCompact::ZeropageIoctl(void* addr,
         }
       }
     } else if (tolerate_eexist && errno == EEXIST) {
+      uffd_ioctl_errors_.fetch_add(1, std::memory_order_relaxed);
+      if (uffd_zeropage.zeropage > 0) {
+        RecordUffdMappedBytes(uffd_zeropage.zeropage);
+      }
       // Ioctl returns the number of bytes it mapped. The page on which EEXIST occurred
       // wouldn't be included in it.
       return uffd_zeropage.zeropage > 0 ? uffd_zeropage.zeropage + gPageSize : gPageSize;
     } else {
       CHECK(tolerate_enoent && errno == ENOENT)
           << "ioctl_userfaultfd: zeropage failed: " << strerror(errno) << ". addr:" << addr;
+      uffd_ioctl_errors_.fetch_add(1, std::memory_order_relaxed);
       return 0;
     }
   }
@@ -1757,6 +1899,7 @@ size_t MarkCompact::CopyIoctl(
           break;
         }
       }
+      uffd_ioctl_retries_.fetch_add(1, std::memory_order_relaxed);
       if (backoff_count == -1) {
         int prio = Thread::Current()->GetNativePriority();
         DCHECK(prio > 0 && prio <= 10) << prio;
@@ -1771,23 +1914,64 @@ size_t MarkCompact::CopyIoctl(
       }
     } else if (errno == EEXIST) {
       DCHECK_NE(uffd_copy.copy, 0);
+      uffd_ioctl_errors_.fetch_add(1, std::memory_order_relaxed);
       if (uffd_copy.copy < 0) {
         uffd_copy.copy = 0;
       }
+      RecordUffdMappedBytes(uffd_copy.copy);
       // Ioctl returns the number of bytes it mapped. The page on which EEXIST occurred
       // wouldn't be included in it.
-      uffd_copy.copy += gPageSize;
-      break;
+      return uffd_copy.copy + gPageSize;
     } else {
       CHECK(tolerate_enoent && errno == ENOENT)
           << "ioctl_userfaultfd: copy failed: " << strerror(errno) << ". src:" << buffer
           << " dst:" << dst;
-      return uffd_copy.copy > 0 ? uffd_copy.copy : 0;
+      uffd_ioctl_errors_.fetch_add(1, std::memory_order_relaxed);
+      if (uffd_copy.copy > 0) {
+        RecordUffdMappedBytes(uffd_copy.copy);
+        return uffd_copy.copy;
+      }
+      return 0;
     }
   }
+  if (uffd_copy.copy > 0) {
+    RecordUffdMappedBytes(uffd_copy.copy);
+  }
   return uffd_copy.copy;
 }
 
+void MarkCompact::RecordUffdMappedBytes(size_t bytes) {
+  size_t pages = DivideByPageSize(bytes);
+  if (Thread::Current() == thread_running_gc_) {
+    gc_thread_uffd_pages_ += pages;
+  } else {
+    mutator_uffd_pages_.fetch_add(pages, std::memory_order_relaxed);
+  }
+}
+
+void MarkCompact::ReportUffdStats() {
+  size_t mutator_pages = mutator_uffd_pages_.load(std::memory_order_relaxed);
+  size_t retries = uffd_ioctl_retries_.load(std::memory_order_relaxed);
+  size_t errors = uffd_ioctl_errors_.load(std::memory_order_relaxed);
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics->GcUffdMutatorPageCount()->Add(mutator_pages);
+  metrics->GcUffdGcThreadPageCount()->Add(gc_thread_uffd_pages_);
+  metrics->GcUffdIoctlRetryCount()->Add(retries);
+  metrics->GcUffdIoctlErrorCount()->Add(errors);
+  if (ATraceEnabled()) {
+    auto clamp = [](size_t value) {
+      return static_cast<int32_t>(std::min<size_t>(value, std::numeric_limits<int32_t>::max()));
+    };
+    ATraceIntegerValue("uffd mutator pages", clamp(mutator_pages));
+    ATraceIntegerValue("uffd gc-thread pages", clamp(gc_thread_uffd_pages_));
+    ATraceIntegerValue("uffd ioctl retries", clamp(retries));
+    ATraceIntegerValue("uffd ioctl errors", clamp(errors));
+  }
+  VLOG(gc) << "Uffd pages mapped by mutators: " << mutator_pages
+           << ", by gc-thread: " << gc_thread_uffd_pages_ << ", ioctl retries: " << retries
+           << ", ioctl errors: " << errors;
+}
+
 template <int kMode, typename CompactionFn>
 bool MarkCompact::DoPageCompactionWithStateChange(size_t page_idx,
                                                   uint8_t* to_space_page,
@@ -2041,7 +2225,9 @@ void MarkCompact::CompactMovingSpace(uint8_t* page) {
   // Reserved page to be used if we can't find any reclaimable page for processing.
   uint8_t* reserve_page = page;
   size_t end_idx_for_mapping = idx;
-  while (idx > 0) {
+  // Old-generation pages, if any, are not compacted.
+  const size_t old_gen_page_count = DivideByPageSize(old_gen_end_ - moving_space_begin_);
+  while (idx > old_gen_page_count) {
     idx--;
     to_space_end -= gPageSize;
     if (kMode == kFallbackMode) {
@@ -2078,14 +2264,14 @@ void MarkCompact::CompactMovingSpace(uint8_t* page) {
     }
   }
   // map one last time to finish anything left.
-  if (kMode == kCopyMode && end_idx_for_mapping > 0) {
+  if (kMode == kCopyMode && end_idx_for_mapping > idx) {
     MapMovingSpacePages(idx,
                         end_idx_for_mapping,
                         /*from_fault=*/false,
                         /*return_on_contention=*/false,
                         /*tolerate_enoent=*/false);
   }
-  DCHECK_EQ(to_space_end, bump_pointer_space_->Begin());
+  DCHECK_EQ(to_space_end, old_gen_end_);
 }
 
 size_t MarkCompact::MapMovingSpacePages(size_t start_idx,
@@ -2652,6 +2838,61 @@ void MarkCompact::UpdateClassTableClasses(Runtime* runtime, bool immune_class_ta
   }
 }
 
+void MarkCompact::UpdateOldGenObjects() {
+  TimingLogger::ScopedTiming t("(Paused)UpdateOldGenObjects", GetTimings());
+  DCHECK(young_gen_);
+  // Old-gen objects are neither marked nor compacted in a young cycle. Only
+  // the ones on non-clean cards can have references into the young-gen, which
+  // all were aged/scanned during marking. Update their references now.
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  ImmuneSpaceUpdateObjVisitor visitor(this);
+  WriterMutexLock wmu(thread_running_gc_, *Locks::heap_bitmap_lock_);
+  card_table->Scan</*kClearCard*/ false>(moving_space_bitmap_,
+                                         moving_space_begin_,
+                                         old_gen_end_,
+                                         visitor,
+                                         accounting::CardTable::kCardAged);
+}
+
+void MarkCompact::UpdateCardsForNextYoungGen() {
+  TimingLogger::ScopedTiming t("(Paused)UpdateCardsForNextYoungGen", GetTimings());
+  DCHECK(use_generational_);
+  accounting::CardTable* const card_table = heap_->GetCardTable();
+  // All the objects compacted in this cycle get promoted to the old-gen.
+  // Cards which are still dirty (written to after the marking pause) may hold
+  // references to black allocations, which remain in the young-gen. Carry
+  // them over to the post-compact addresses of the corresponding objects.
+  std::vector<mirror::Object*> dirty_objs;
+  {
+    WriterMutexLock wmu(thread_running_gc_, *Locks::heap_bitmap_lock_);
+    card_table->Scan</*kClearCard*/ false>(
+        moving_space_bitmap_,
+        old_gen_end_,
+        black_allocations_begin_,
+        [this, &dirty_objs](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+          dirty_objs.push_back(PostCompactOldObjAddr(obj));
+        },
+        accounting::CardTable::kCardDirty);
+  }
+  card_table->ClearCardRange(old_gen_end_, black_allocations_begin_);
+  for (mirror::Object* obj : dirty_objs) {
+    card_table->MarkCard(obj);
+  }
+  // Aged cards have already been scanned during marking and their references
+  // updated in this pause. Only the dirty ones have to be retained.
+  auto clean_aged = [](uint8_t card) {
+    return card == accounting::CardTable::kCardAged ? accounting::CardTable::kCardClean : card;
+  };
+  card_table->ModifyCardsAtomic(moving_space_begin_,
+                                old_gen_end_,
+                                clean_aged,
+                                /* card modified visitor */ VoidFunctor());
+  card_table->ModifyCardsAtomic(non_moving_space_->Begin(),
+                                non_moving_space_->End(),
+                                clean_aged,
+                                /* card modified visitor */ VoidFunctor());
+}
+
 void MarkCompact::CompactionPause() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   Runtime* runtime = Runtime::Current();
@@ -2815,6 +3056,12 @@ void MarkCompact::CompactionPause() {
   }
 
   UpdateNonMovingSpace();
+  if (young_gen_) {
+    UpdateOldGenObjects();
+  }
+  if (use_generational_) {
+    UpdateCardsForNextYoungGen();
+  }
   // fallback mode
   if (uffd_ == kFallbackMode) {
     CompactMovingSpace<kFallbackMode>(nullptr);
@@ -2856,12 +3103,21 @@ void MarkCompact::KernelPrepareRangeForUffd(uint8_t* to_addr, uint8_t* from_addr
 
 void MarkCompact::KernelPreparation() {
   TimingLogger::ScopedTiming t("(Paused)KernelPreparation", GetTimings());
-  uint8_t* moving_space_begin = bump_pointer_space_->Begin();
-  size_t moving_space_size = bump_pointer_space_->Capacity();
-  size_t moving_space_register_sz = (moving_first_objs_count_ + black_page_count_) * gPageSize;
+  // The old-generation, if any, is neither compacted nor relocated to
+  // from-space. It is kept mapped in place as it is accessed by mutators during
+  // compaction. Its corresponding from-space portion remains unused.
+  // Note that this splits the moving-space vma at old_gen_end_. As with the
+  // uffd-registration split below, the fault-in ensures that the split vmas
+  // share 'anon_vma' so that they merge once the compaction is over.
+  const size_t old_gen_size = old_gen_end_ - moving_space_begin_;
+  uint8_t* moving_space_begin = old_gen_end_;
+  size_t moving_space_size = bump_pointer_space_->Capacity() - old_gen_size;
+  size_t moving_space_register_sz =
+      (moving_first_objs_count_ + black_page_count_) * gPageSize - old_gen_size;
   DCHECK_LE(moving_space_register_sz, moving_space_size);
 
-  KernelPrepareRangeForUffd(moving_space_begin, from_space_begin_, moving_space_size);
+  KernelPrepareRangeForUffd(
+      moving_space_begin, from_space_begin_ + old_gen_size, moving_space_size);
 
   if (IsValidFd(uffd_)) {
     if (moving_space_register_sz > 0) {
@@ -2889,7 +3145,7 @@ void MarkCompact::KernelPreparation() {
       } else {
         DCHECK_ALIGNED_PARAM(moving_space_begin, gPageSize);
         *const_cast<volatile uint8_t*>(moving_space_begin) = 0;
-        madvise(moving_space_begin, pmd_size, MADV_DONTNEED);
+        madvise(moving_space_begin, std::min(pmd_size, moving_space_size), MADV_DONTNEED);
       }
       // Register the moving space with userfaultfd.
       RegisterUffd(moving_space_begin, moving_space_register_sz);
@@ -2960,16 +3216,21 @@ bool MarkCompact::SigbusHandler(siginfo_t* info) {
       Thread* self = Thread::Current();
       Locks::mutator_lock_->AssertSharedHeld(self);
       size_t nr_moving_space_used_pages = moving_first_objs_count_ + black_page_count_;
+      const uint64_t start_time = NanoTime();
       ConcurrentlyProcessMovingPage(fault_page,
                                     self->GetThreadLocalGcBuffer(),
                                     nr_moving_space_used_pages,
                                     spc.TolerateEnoent());
+      Runtime::Current()->GetMetrics()->GcUffdFaultTime()->Add(NsToUs(NanoTime() - start_time));
       return true;
     } else {
       // Find the linear-alloc space containing fault-addr
       for (auto& data : linear_alloc_spaces_data_) {
         if (data.begin_ <= fault_page && data.end_ > fault_page) {
+          const uint64_t start_time = NanoTime();
           ConcurrentlyProcessLinearAllocPage(fault_page, spc.TolerateEnoent());
+          Runtime::Current()->GetMetrics()->GcUffdFaultTime()->Add(
+              NsToUs(NanoTime() - start_time));
           return true;
         }
       }
@@ -3513,9 +3774,11 @@ void MarkCompact::CompactionPhase() {
 
   // Unregister moving-space
   size_t moving_space_size = bump_pointer_space_->Capacity();
-  size_t used_size = (moving_first_objs_count_ + black_page_count_) * gPageSize;
+  // Old-generation isn't registered.
+  size_t used_size = (moving_first_objs_count_ + black_page_count_) * gPageSize -
+                     (old_gen_end_ - moving_space_begin_);
   if (used_size > 0) {
-    UnregisterUffd(bump_pointer_space_->Begin(), used_size);
+    UnregisterUffd(old_gen_end_, used_size);
   }
   // Unregister linear-alloc spaces
   for (auto& data : linear_alloc_spaces_data_) {
@@ -3529,6 +3792,7 @@ void MarkCompact::CompactionPhase() {
   // will access the address again, it will succeed. Once this counter is 0,
   // the gc-thread can safely initialize/madvise the data structures.
   wait_for_compaction_counter(1);
+  ReportUffdStats();
 
   // Release all of the memory taken by moving-space's from-map
   from_space_map_.MadviseDontNeedAndZero();
@@ -3666,6 +3930,54 @@ void MarkCompact::MarkRootsCheckpoint(Thread* self, Runtime* runtime) {
   Locks::heap_bitmap_lock_->ExclusiveLock(self);
 }
 
+// Thread-pool task for visiting thread roots in the marking pause. All the
+// tasks share a cursor into the list of threads, so that threads with deep
+// stacks don't hold up the others.
+class MarkCompact::ThreadRootsTask : public Task {
+ public:
+  ThreadRootsTask(MarkCompact* mark_compact,
+                  const std::vector<Thread*>* threads,
+                  std::atomic<size_t>* next_thread)
+      : mark_compact_(mark_compact), threads_(threads), next_thread_(next_thread) {}
+
+  // The GC thread, which waits for the thread-pool to finish, holds the locks on
+  // behalf of the workers.
+  void Run(Thread* self) override REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    ThreadRootsVisitor</*kBufferSize*/ 20> visitor(mark_compact_, self);
+    for (size_t i = next_thread_->fetch_add(1, std::memory_order_relaxed);
+         i < threads_->size();
+         i = next_thread_->fetch_add(1, std::memory_order_relaxed)) {
+      (*threads_)[i]->VisitRoots(&visitor, static_cast<VisitRootFlags>(0));
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  MarkCompact* const mark_compact_;
+  const std::vector<Thread*>* const threads_;
+  std::atomic<size_t>* const next_thread_;
+};
+
+void MarkCompact::MarkThreadRootsParallel(const std::list<Thread*>& threads,
+                                          size_t thread_count) {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Thread* self = Thread::Current();
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  const std::vector<Thread*> thread_vector(threads.begin(), threads.end());
+  std::atomic<size_t> next_thread(0);
+  for (size_t i = 0; i < thread_count; i++) {
+    thread_pool->AddTask(self, new ThreadRootsTask(this, &thread_vector, &next_thread));
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ true);
+  thread_pool->StopWorkers(self);
+}
+
 void MarkCompact::MarkNonThreadRoots(Runtime* runtime) {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   runtime->VisitNonThreadRoots(this);
@@ -3770,12 +4082,30 @@ void MarkCompact::MarkRoots(VisitRootFlags flags) {
 void MarkCompact::PreCleanCards() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
   CHECK(!Locks::mutator_lock_->IsExclusiveHeld(thread_running_gc_));
-  // Age the card-table before thread stack scanning checkpoint in MarkRoots()
-  // as it ensures that there are no in-progress write barriers which started
-  // prior to aging the card-table.
-  PrepareCardTableForMarking(/*clear_alloc_space_cards*/ false);
-  MarkRoots(static_cast<VisitRootFlags>(kVisitRootFlagClearRootLog | kVisitRootFlagNewRoots));
-  RecursiveMarkDirtyObjects(/*paused*/ false, accounting::CardTable::kCardDirty - 1);
+  // Every round scans the cards dirtied during the previous one, which is
+  // roughly the work left for the marking pause. So keep going while that
+  // takes longer than the target and is still shrinking. Aged cards are
+  // retained in young-generation cycles, so further rounds would rescan
+  // them all; a single round is done in that case.
+  const uint64_t pause_target = young_gen_ ? 0 : heap_->GetCardPreCleanPauseTarget();
+  uint64_t prev_duration = std::numeric_limits<uint64_t>::max();
+  for (size_t round = 1;; round++) {
+    const uint64_t start_time = NanoTime();
+    // Age the card-table before thread stack scanning checkpoint in MarkRoots()
+    // as it ensures that there are no in-progress write barriers which started
+    // prior to aging the card-table.
+    PrepareCardTableForMarking(/*clear_alloc_space_cards*/ false);
+    MarkRoots(static_cast<VisitRootFlags>(kVisitRootFlagClearRootLog | kVisitRootFlagNewRoots));
+    RecursiveMarkDirtyObjects(/*paused*/ false, accounting::CardTable::kCardDirty - 1);
+    const uint64_t duration = NanoTime() - start_time;
+    if (pause_target == 0 ||
+        round >= kMaxPreCleanRounds ||
+        duration <= pause_target ||
+        duration >= prev_duration) {
+      break;
+    }
+    prev_duration = duration;
+  }
 }
 
 // In a concurrent marking algorithm, if we are not using a write/read barrier, as
@@ -3795,6 +4125,9 @@ void MarkCompact::MarkingPhase() {
   DCHECK_EQ(thread_running_gc_, Thread::Current());
   WriterMutexLock mu(thread_running_gc_, *Locks::heap_bitmap_lock_);
   MaybeClampGcStructures();
+  if (young_gen_) {
+    BindBitmaps();
+  }
   PrepareCardTableForMarking(/*clear_alloc_space_cards*/ true);
   MarkZygoteLargeObjects();
   MarkRoots(
@@ -3866,26 +4199,39 @@ size_t MarkCompact::LiveWordsBitmap<kAlignment>::LiveBytesInBitmapWord(size_t ch
   return words * kAlignment;
 }
 
+template <bool kParallel>
 void MarkCompact::UpdateLivenessInfo(mirror::Object* obj, size_t obj_size) {
   DCHECK(obj != nullptr);
   DCHECK_EQ(obj_size, obj->SizeOf<kDefaultVerifyFlags>());
   uintptr_t obj_begin = reinterpret_cast<uintptr_t>(obj);
-  UpdateClassAfterObjectMap(obj);
+  UpdateClassAfterObjectMap<kParallel>(obj);
   size_t size = RoundUp(obj_size, kAlignment);
-  uintptr_t bit_index = live_words_bitmap_->SetLiveWords(obj_begin, size);
+  uintptr_t bit_index = live_words_bitmap_->SetLiveWords<kParallel>(obj_begin, size);
   size_t chunk_idx = (obj_begin - live_words_bitmap_->Begin()) / kOffsetChunkSize;
   // Compute the bit-index within the chunk-info vector word.
   bit_index %= kBitsPerVectorWord;
   size_t first_chunk_portion = std::min(size, (kBitsPerVectorWord - bit_index) * kAlignment);
+  // The first and the last chunks may be shared with other objects, which
+  // could concurrently be discovered by other marking threads.
+  auto add_to_chunk = [this](size_t idx, size_t bytes) {
+    if (kParallel) {
+      reinterpret_cast<Atomic<uint32_t>*>(&chunk_info_vec_[idx])
+          ->fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+      chunk_info_vec_[idx] += bytes;
+    }
+  };
 
-  chunk_info_vec_[chunk_idx++] += first_chunk_portion;
+  add_to_chunk(chunk_idx++, first_chunk_portion);
   DCHECK_LE(first_chunk_portion, size);
   for (size -= first_chunk_portion; size > kOffsetChunkSize; size -= kOffsetChunkSize) {
     DCHECK_EQ(chunk_info_vec_[chunk_idx], 0u);
     chunk_info_vec_[chunk_idx++] = kOffsetChunkSize;
   }
-  chunk_info_vec_[chunk_idx] += size;
-  freed_objects_--;
+  add_to_chunk(chunk_idx, size);
+  if (!kParallel) {
+    freed_objects_--;
+  }
 }
 
 template <bool kUpdateLiveWords>
@@ -3904,9 +4250,170 @@ void MarkCompact::ScanObject(mirror::Object* obj) {
   obj->VisitReferences(visitor, visitor);
 }
 
+// Thread-pool task for parallel marking. Every task has its own small
+// mark-stack. When it overflows, half of it is handed over to the thread-pool
+// as a new task, which is then picked up by an idle worker.
+class MarkCompact::MarkStackTask : public Task {
+ public:
+  MarkStackTask(ThreadPool* thread_pool,
+                MarkCompact* collector,
+                size_t mark_stack_size,
+                StackReference<mirror::Object>* mark_stack)
+      : collector_(collector),
+        thread_pool_(thread_pool),
+        mark_stack_pos_(mark_stack_size),
+        bytes_scanned_(0),
+        marked_objects_(0) {
+    if (mark_stack_size != 0) {
+      DCHECK(mark_stack != nullptr);
+      std::copy(mark_stack, mark_stack + mark_stack_size, mark_stack_);
+    }
+  }
+
+  static constexpr size_t kMaxSize = 1 * KB;
+
+  // The GC thread, which waits for the thread-pool to finish, holds the locks on
+  // behalf of the workers.
+  void Run([[maybe_unused]] Thread* self) override REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    while (mark_stack_pos_ != 0) {
+      mirror::Object* obj = mark_stack_[--mark_stack_pos_].AsMirrorPtr();
+      DCHECK(obj != nullptr);
+      ScanObject(obj);
+    }
+    collector_->parallel_bytes_scanned_.fetch_add(bytes_scanned_, std::memory_order_relaxed);
+    collector_->parallel_marked_objects_.fetch_add(marked_objects_, std::memory_order_relaxed);
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  class RefVisitor {
+   public:
+    ALWAYS_INLINE explicit RefVisitor(MarkStackTask* task) : task_(task) {}
+
+    ALWAYS_INLINE void operator()(mirror::Object* obj,
+                                  MemberOffset offset,
+                                  [[maybe_unused]] bool is_static) const
+        REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->Mark(obj->GetFieldObject<mirror::Object>(offset), obj, offset);
+    }
+
+    void operator()(ObjPtr<mirror::Class> klass, ObjPtr<mirror::Reference> ref) const ALWAYS_INLINE
+        REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->collector_->DelayReferenceReferent(klass, ref);
+    }
+
+    void VisitRootIfNonNull(mirror::CompressedReference<mirror::Object>* root) const ALWAYS_INLINE
+        REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+      if (!root->IsNull()) {
+        VisitRoot(root);
+      }
+    }
+
+    void VisitRoot(mirror::CompressedReference<mirror::Object>* root) const
+        REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+      task_->Mark(root->AsMirrorPtr(), nullptr, MemberOffset(0));
+    }
+
+   private:
+    MarkStackTask* const task_;
+  };
+
+  ALWAYS_INLINE void Mark(mirror::Object* ref, mirror::Object* holder, MemberOffset offset)
+      REQUIRES(Locks::heap_bitmap_lock_) REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (ref != nullptr &&
+        collector_->MarkObjectNonNullNoPush</*kParallel*/ true>(ref, holder, offset)) {
+      MarkStackPush(ref);
+    }
+  }
+
+  ALWAYS_INLINE void MarkStackPush(mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (UNLIKELY(mark_stack_pos_ == kMaxSize)) {
+      // Mark stack overflow, give 1/2 the stack to the thread pool as a new work task.
+      mark_stack_pos_ /= 2;
+      auto* task = new MarkStackTask(thread_pool_,
+                                     collector_,
+                                     kMaxSize - mark_stack_pos_,
+                                     mark_stack_ + mark_stack_pos_);
+      thread_pool_->AddTask(Thread::Current(), task);
+    }
+    DCHECK(obj != nullptr);
+    DCHECK_LT(mark_stack_pos_, kMaxSize);
+    mark_stack_[mark_stack_pos_++].Assign(obj);
+  }
+
+  // Parallel counterpart of MarkCompact::ScanObject</*kUpdateLiveWords*/ true>().
+  void ScanObject(mirror::Object* obj) REQUIRES(Locks::heap_bitmap_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_) {
+    size_t obj_size = obj->SizeOf<kDefaultVerifyFlags>();
+    bytes_scanned_ += obj_size;
+    DCHECK(collector_->IsMarked(obj)) << "Scanning unmarked object " << obj;
+    if (collector_->HasAddress(obj)) {
+      collector_->UpdateLivenessInfo</*kParallel*/ true>(obj, obj_size);
+      marked_objects_++;
+    }
+    RefVisitor visitor(this);
+    obj->VisitReferences(visitor, visitor);
+  }
+
+  MarkCompact* const collector_;
+  ThreadPool* const thread_pool_;
+  // Thread local mark stack for this task.
+  StackReference<mirror::Object> mark_stack_[kMaxSize];
+  // Mark stack position.
+  size_t mark_stack_pos_;
+  uint64_t bytes_scanned_;
+  int32_t marked_objects_;
+};
+
+size_t MarkCompact::GetMarkingThreadCount(bool paused) const {
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  // Use only the GC thread in background state, to leave more CPU time for the
+  // foreground apps.
+  if (thread_pool == nullptr || !Runtime::Current()->InJankPerceptibleProcessState()) {
+    return 1;
+  }
+  size_t workers = paused ? heap_->GetParallelGCThreadCount() : heap_->GetConcGCThreadCount();
+  if (workers == 0) {
+    workers = thread_pool->GetThreadCount();
+  }
+  return std::min(workers, thread_pool->GetThreadCount()) + 1;
+}
+
+void MarkCompact::ProcessMarkStackParallel(size_t thread_count) {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  Thread* self = Thread::Current();
+  ThreadPool* thread_pool = heap_->GetThreadPool();
+  const size_t chunk_size = std::min(mark_stack_->Size() / thread_count + 1,
+                                     static_cast<size_t>(MarkStackTask::kMaxSize));
+  CHECK_GT(chunk_size, 0U);
+  // Split the current mark stack up into work tasks.
+  for (auto* it = mark_stack_->Begin(), *end = mark_stack_->End(); it < end; ) {
+    const size_t delta = std::min(static_cast<size_t>(end - it), chunk_size);
+    thread_pool->AddTask(self, new MarkStackTask(thread_pool, this, delta, it));
+    it += delta;
+  }
+  thread_pool->SetMaxActiveWorkers(thread_count - 1);
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /*do_work=*/ true, /*may_hold_locks=*/ true);
+  thread_pool->StopWorkers(self);
+  mark_stack_->Reset();
+  bytes_scanned_ += parallel_bytes_scanned_.exchange(0, std::memory_order_relaxed);
+  freed_objects_ -= parallel_marked_objects_.exchange(0, std::memory_order_relaxed);
+}
+
 // Scan anything that's on the mark stack.
 void MarkCompact::ProcessMarkStack() {
   TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  const size_t thread_count =
+      GetMarkingThreadCount(/*paused=*/ Locks::mutator_lock_->IsExclusiveHeld(thread_running_gc_));
+  if (thread_count > 1 && mark_stack_->Size() >= kMinimumParallelMarkStackSize) {
+    ProcessMarkStackParallel(thread_count);
+    return;
+  }
   // TODO: try prefetch like in CMS
   while (!mark_stack_->IsEmpty()) {
     mirror::Object* obj = mark_stack_->PopBack();
@@ -4040,6 +4547,10 @@ mirror::Object* MarkCompact::IsMarked(mirror::Object* obj) {
     if (compacting_) {
       if (is_black) {
         return PostCompactBlackObjAddr(obj);
+      } else if (reinterpret_cast<uint8_t*>(obj) < old_gen_end_) {
+        // Old-generation objects are retained and are not moved in
+        // young-generation cycles.
+        return obj;
       } else if (live_words_bitmap_->Test(obj)) {
         return PostCompactOldObjAddr(obj);
       } else {
@@ -4092,6 +4603,28 @@ void MarkCompact::DelayReferenceReferent(ObjPtr<mirror::Class> klass,
   heap_->GetReferenceProcessor()->DelayReferenceReferent(klass, ref, this);
 }
 
+size_t MarkCompact::PromoteMovingSpaceObjects() {
+  TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
+  // Move mark-bits of the compacted objects to their post-compact addresses.
+  // As post-compact address is never higher than the pre-compact one, visiting
+  // in ascending order guarantees that a bit is never set ahead of the cursor.
+  size_t count = 0;
+  moving_space_bitmap_->VisitMarkedRange(
+      reinterpret_cast<uintptr_t>(old_gen_end_),
+      reinterpret_cast<uintptr_t>(black_allocations_begin_),
+      [this, &count](mirror::Object* obj) REQUIRES_SHARED(Locks::mutator_lock_) {
+        mirror::Object* new_obj = PostCompactOldObjAddr(obj);
+        DCHECK_LE(new_obj, obj);
+        moving_space_bitmap_->Clear(obj);
+        moving_space_bitmap_->Set(new_obj);
+        count++;
+      });
+  // Black allocations remain in the young-gen.
+  moving_space_bitmap_->ClearRange(reinterpret_cast<mirror::Object*>(post_compact_end_),
+                                   reinterpret_cast<mirror::Object*>(moving_space_end_));
+  return count;
+}
+
 void MarkCompact::FinishPhase() {
   GetCurrentIteration()->SetScannedBytes(bytes_scanned_);
   bool is_zygote = Runtime::Current()->IsZygote();
@@ -4099,13 +4632,24 @@ void MarkCompact::FinishPhase() {
   marking_done_ = false;
 
   ZeroAndReleaseMemory(compaction_buffers_map_.Begin(), compaction_buffers_map_.Size());
+  if (use_generational_ && !is_zygote) {
+    // Promote the objects compacted in this cycle to the old-gen. This requires
+    // the live-words bitmap and chunk-info vector, so must be done before they
+    // are cleared below.
+    ReaderMutexLock mu(thread_running_gc_, *Locks::mutator_lock_);
+    old_gen_objects_ += PromoteMovingSpaceObjects();
+    old_gen_end_ = post_compact_end_;
+  } else {
+    // TODO: We can clear this bitmap right before compaction pause. But in that
+    // case we need to ensure that we don't assert on this bitmap afterwards.
+    // Also, we would still need to clear it here again as we may have to use the
+    // bitmap for black-allocations (see UpdateMovingSpaceBlackAllocations()).
+    moving_space_bitmap_->Clear();
+    old_gen_end_ = moving_space_begin_;
+    old_gen_objects_ = 0;
+  }
   info_map_.MadviseDontNeedAndZero();
   live_words_bitmap_->ClearBitmap();
-  // TODO: We can clear this bitmap right before compaction pause. But in that
-  // case we need to ensure that we don't assert on this bitmap afterwards.
-  // Also, we would still need to clear it here again as we may have to use the
-  // bitmap for black-allocations (see UpdateMovingSpaceBlackAllocations()).
-  moving_space_bitmap_->Clear();
 
   if (UNLIKELY(is_zygote && IsValidFd(uffd_))) {
     // This unregisters all ranges as a side-effect.
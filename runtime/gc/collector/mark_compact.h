@@ -19,6 +19,7 @@
 
 #include <signal.h>
 
+#include <list>
 #include <map>
 #include <memory>
 #include <unordered_set>
@@ -84,7 +85,22 @@ class MarkCompact final : public GarbageCollector {
   bool SigbusHandler(siginfo_t* info) REQUIRES(!lock_) NO_THREAD_SAFETY_ANALYSIS;
 
   GcType GetGcType() const override {
-    return kGcTypeFull;
+    return young_gen_ ? kGcTypeSticky : kGcTypeFull;
+  }
+
+  // Request the next cycle to be a young-generation one, which only collects
+  // the part of the moving space allocated since the previous cycle. Ignored
+  // if generational collection is disabled. May be downgraded to a full cycle
+  // in InitializePhase().
+  void SetYoungGen(bool young_gen) {
+    young_gen_ = use_generational_ && young_gen;
+  }
+
+  // As the same instance runs both young and full cycles, the statistics of
+  // full cycles are maintained separately for full-vs-young heuristics.
+  uint64_t GetEstimatedFullGcMeanThroughput() const;
+  size_t NumberOfFullGcIterations() const {
+    return full_gc_count_;
   }
 
   CollectorType GetCollectorType() const override {
@@ -131,7 +147,8 @@ class MarkCompact final : public GarbageCollector {
 
   mirror::Object* GetFromSpaceAddrFromBarrier(mirror::Object* old_ref) {
     CHECK(compacting_);
-    if (HasAddress(old_ref)) {
+    // Old-generation objects are neither moved nor relocated to from-space.
+    if (HasAddress(old_ref, old_gen_end_, moving_space_end_)) {
       return GetFromSpaceAddr(old_ref);
     }
     return old_ref;
@@ -203,7 +220,10 @@ class MarkCompact final : public GarbageCollector {
     // Return offset (within the indexed chunk-info) of the nth live word.
     uint32_t FindNthLiveWordOffset(size_t chunk_idx, uint32_t n) const;
     // Sets all bits in the bitmap corresponding to the given range. Also
-    // returns the bit-index of the first word.
+    // returns the bit-index of the first word. If kAtomic is true, then the
+    // boundary words, which may be shared with other objects, are updated
+    // atomically.
+    template <bool kAtomic = false>
     ALWAYS_INLINE uintptr_t SetLiveWords(uintptr_t begin, size_t size);
     // Count number of live words upto the given bit-index. This is to be used
     // to compute the post-compact address of an old reference.
@@ -320,6 +340,10 @@ class MarkCompact final : public GarbageCollector {
   // card table. Also, identifies immune spaces and mark bitmap.
   void PrepareCardTableForMarking(bool clear_alloc_space_cards)
       REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::heap_bitmap_lock_);
+  // In young-generation cycles, bind the live bitmaps of the non-moving space
+  // to their mark bitmaps, and copy the live bitmap of large-object space to
+  // its mark bitmap, so that all old objects are implicitly marked.
+  void BindBitmaps() REQUIRES(Locks::heap_bitmap_lock_);
 
   // Perform one last round of marking, identifying roots from dirty cards
   // during a stop-the-world (STW) pause.
@@ -361,6 +385,18 @@ class MarkCompact final : public GarbageCollector {
       REQUIRES_SHARED(Locks::mutator_lock_);
   // Update all the references in the non-moving space.
   void UpdateNonMovingSpace() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Update references of the old-generation objects of moving space which are
+  // on non-clean cards. Only these can hold references into young-generation.
+  void UpdateOldGenObjects() REQUIRES(Locks::mutator_lock_);
+  // Carry the dirty cards of the compacted objects over to their post-compact
+  // addresses and clean the aged cards of the spaces that are not reclaimed
+  // in young-generation cycles. Required for generational collection as the
+  // next young-generation cycle finds old-to-young references using them.
+  void UpdateCardsForNextYoungGen() REQUIRES(Locks::mutator_lock_);
+  // Promote all the compacted objects to old-generation by relocating their
+  // mark-bits to post-compact addresses. Also returns the number of objects
+  // promoted.
+  size_t PromoteMovingSpaceObjects() REQUIRES_SHARED(Locks::mutator_lock_);
 
   // For all the pages in non-moving space, find the first object that overlaps
   // with the pages' start address, and store in first_objs_non_moving_space_ array.
@@ -432,6 +468,16 @@ class MarkCompact final : public GarbageCollector {
   // Go through all the objects in the mark-stack until it's empty.
   void ProcessMarkStack() override REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
+  // Drain the mark-stack using the heap thread-pool's workers along with the
+  // GC thread.
+  void ProcessMarkStackParallel(size_t thread_count) REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(Locks::heap_bitmap_lock_);
+  // Number of threads, including the GC thread, to be used for marking.
+  size_t GetMarkingThreadCount(bool paused) const;
+  // Visit the roots of all the (suspended) threads in the marking pause using
+  // the heap thread-pool's workers along with the GC thread.
+  void MarkThreadRootsParallel(const std::list<Thread*>& threads, size_t thread_count)
+      REQUIRES(Locks::mutator_lock_, Locks::heap_bitmap_lock_);
   void ExpandMarkStack() REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::heap_bitmap_lock_);
 
@@ -447,7 +493,9 @@ class MarkCompact final : public GarbageCollector {
 
   // Update the live-words bitmap as well as add the object size to the
   // chunk-info vector. Both are required for computation of post-compact addresses.
-  // Also updates freed_objects_ counter.
+  // Also updates freed_objects_ counter, unless kParallel is true, in which
+  // case the caller is responsible for counting the object.
+  template <bool kParallel = false>
   void UpdateLivenessInfo(mirror::Object* obj, size_t obj_size)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -535,7 +583,8 @@ class MarkCompact final : public GarbageCollector {
   }
 
   // Add/update <class, obj> pair if class > obj and obj is the lowest address
-  // object of class.
+  // object of class. The map is updated under lock_ if kParallel is true.
+  template <bool kParallel = false>
   ALWAYS_INLINE void UpdateClassAfterObjectMap(mirror::Object* obj)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -556,6 +605,11 @@ class MarkCompact final : public GarbageCollector {
   // returns. Returns number of bytes (multiple of page-size) mapped.
   size_t CopyIoctl(
       void* dst, void* buffer, size_t length, bool return_on_contention, bool tolerate_enoent);
+  // Attributes `bytes` mapped by a uffd ioctl to the gc-thread or to the mutators.
+  void RecordUffdMappedBytes(size_t bytes);
+  // Reports the uffd statistics of the compaction that just finished to the
+  // runtime metrics and as ATrace counters.
+  void ReportUffdStats();
 
   // Called after updating linear-alloc page(s) to map the page. It first
   // updates the state of the pages to kProcessedAndMapping and after ioctl to
@@ -591,7 +645,8 @@ class MarkCompact final : public GarbageCollector {
   ImmuneSpaces immune_spaces_;
   // Required only when mark-stack is accessed in shared mode, which happens
   // when collecting thread-stack roots using checkpoint. Otherwise, we use it
-  // to synchronize on updated_roots_ in debug-builds.
+  // to synchronize on updated_roots_ in debug-builds, and on
+  // class_after_obj_map_ during parallel marking.
   Mutex lock_;
   accounting::ObjectStack* mark_stack_;
   // Special bitmap wherein all the bits corresponding to an object are set.
@@ -693,6 +748,11 @@ class MarkCompact final : public GarbageCollector {
   size_t live_stack_freeze_size_;
 
   uint64_t bytes_scanned_;
+  // Bytes scanned and moving-space objects discovered by parallel marking
+  // tasks. Folded into bytes_scanned_ and freed_objects_ by the GC thread
+  // once all the tasks are finished.
+  Atomic<uint64_t> parallel_bytes_scanned_;
+  Atomic<int32_t> parallel_marked_objects_;
 
   // For every page in the to-space (post-compact heap) we need to know the
   // first object from which we must compact and/or update references. This is
@@ -731,6 +791,12 @@ class MarkCompact final : public GarbageCollector {
   // clamped.
   uint8_t* const moving_space_begin_;
   uint8_t* moving_space_end_;
+  // End of the old-generation in moving-space, which is made of objects that
+  // survived the previous GC cycle, all of them compacted at the beginning of
+  // the space. Objects under this address are neither marked, nor moved in
+  // young-generation cycles, and their mark-bits are retained across cycles.
+  // Set to moving_space_begin_ for full cycles. Aligned to page size.
+  uint8_t* old_gen_end_;
   // moving-space's end pointer at the marking pause. All allocations beyond
   // this will be considered black in the current GC cycle. Aligned up to page
   // size.
@@ -758,6 +824,14 @@ class MarkCompact final : public GarbageCollector {
   // in MarkingPause(). It reaches the correct count only once the marking phase
   // is completed.
   int32_t freed_objects_;
+  // Number of objects in the moving-space's old-generation. Excluded from
+  // freed_objects_ in young-generation cycles.
+  int32_t old_gen_objects_;
+  // Cumulative freed bytes, time and count of full cycles. Used only with
+  // generational collection.
+  uint64_t full_gc_freed_bytes_;
+  uint64_t full_gc_duration_ns_;
+  size_t full_gc_count_;
   // Userfault file descriptor, accessed only by the GC itself.
   // kFallbackMode value indicates that we are in the fallback mode.
   int uffd_;
@@ -774,8 +848,22 @@ class MarkCompact final : public GarbageCollector {
   // When using SIGBUS feature, this counter is used by mutators to claim a page
   // out of compaction buffers to be used for the entire compaction cycle.
   std::atomic<uint16_t> compaction_buffer_counter_;
+  // Uffd statistics of the current compaction, reset in InitializePhase() and
+  // reported in CompactionPhase() once no SIGBUS handler is in play anymore.
+  // Pages mapped by the gc-thread. Only updated by the gc-thread.
+  size_t gc_thread_uffd_pages_ = 0;
+  // Pages mapped by mutators in the SIGBUS handler.
+  std::atomic<size_t> mutator_uffd_pages_ = 0;
+  // Ioctls retried after failing to acquire mmap_lock.
+  std::atomic<size_t> uffd_ioctl_retries_ = 0;
+  // Ioctls which returned a tolerated error (EEXIST or ENOENT).
+  std::atomic<size_t> uffd_ioctl_errors_ = 0;
   // True while compacting.
   bool compacting_;
+  // Whether generational collection is enabled. Cached from heap.
+  const bool use_generational_;
+  // True if the current (or upcoming) GC cycle is young-generation one.
+  bool young_gen_;
   // Set to true in MarkingPause() to indicate when allocation_stack_ should be
   // checked in IsMarked() for black allocations.
   bool marking_done_;
@@ -803,6 +891,8 @@ class MarkCompact final : public GarbageCollector {
   class ClassLoaderRootsUpdater;
   class LinearAllocPageUpdater;
   class ImmuneSpaceUpdateObjVisitor;
+  class MarkStackTask;
+  class ThreadRootsTask;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MarkCompact);
 };
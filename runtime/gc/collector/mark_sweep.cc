@@ -19,6 +19,7 @@
 #include <atomic>
 #include <climits>
 #include <functional>
+#include <limits>
 #include <numeric>
 #include <vector>
 
@@ -54,6 +55,9 @@ namespace collector {
 static constexpr bool kUseRecursiveMark = false;
 static constexpr bool kUseMarkStackPrefetch = true;
 static constexpr bool kPreCleanCards = true;
+// Maximum number of card pre-cleaning rounds when a pause target is set (see
+// Heap::GetCardPreCleanPauseTarget()).
+static constexpr size_t kMaxPreCleanRounds = 4;
 
 // Parallelism options.
 static constexpr bool kParallelCardScan = true;
@@ -208,31 +212,51 @@ void MarkSweep::PreCleanCards() {
     TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
     Thread* self = Thread::Current();
     CHECK(!Locks::mutator_lock_->IsExclusiveHeld(self));
-    // Process dirty cards and add dirty cards to mod union tables, also ages cards.
-    heap_->ProcessCards(GetTimings(), false, true, false);
-    // The checkpoint root marking is required to avoid a race condition which occurs if the
-    // following happens during a reference write:
-    // 1. mutator dirties the card (write barrier)
-    // 2. GC ages the card (the above ProcessCards call)
-    // 3. GC scans the object (the RecursiveMarkDirtyObjects call below)
-    // 4. mutator writes the value (corresponding to the write barrier in 1.)
-    // This causes the GC to age the card but not necessarily mark the reference which the mutator
-    // wrote into the object stored in the card.
-    // Having the checkpoint fixes this issue since it ensures that the card mark and the
-    // reference write are visible to the GC before the card is scanned (this is due to locks being
-    // acquired / released in the checkpoint code).
-    // The other roots are also marked to help reduce the pause.
-    MarkRootsCheckpoint(self, false);
-    MarkNonThreadRoots();
-    MarkConcurrentRoots(
-        static_cast<VisitRootFlags>(kVisitRootFlagClearRootLog | kVisitRootFlagNewRoots));
-    // Process the newly aged cards.
-    RecursiveMarkDirtyObjects(false, accounting::CardTable::kCardDirty - 1);
-    // TODO: Empty allocation stack to reduce the number of objects we need to test / mark as live
-    // in the next GC.
+    // Every round processes the cards dirtied during the previous one, which is
+    // roughly the work left for the pause. So keep going while that takes longer
+    // than the target and is still shrinking.
+    const uint64_t pause_target = heap_->GetCardPreCleanPauseTarget();
+    uint64_t prev_duration = std::numeric_limits<uint64_t>::max();
+    for (size_t round = 1;; round++) {
+      const uint64_t start_time = NanoTime();
+      PreCleanCardsRound(self);
+      const uint64_t duration = NanoTime() - start_time;
+      if (pause_target == 0 ||
+          round >= kMaxPreCleanRounds ||
+          duration <= pause_target ||
+          duration >= prev_duration) {
+        break;
+      }
+      prev_duration = duration;
+    }
   }
 }
 
+void MarkSweep::PreCleanCardsRound(Thread* self) {
+  // Process dirty cards and add dirty cards to mod union tables, also ages cards.
+  heap_->ProcessCards(GetTimings(), false, true, false);
+  // The checkpoint root marking is required to avoid a race condition which occurs if the
+  // following happens during a reference write:
+  // 1. mutator dirties the card (write barrier)
+  // 2. GC ages the card (the above ProcessCards call)
+  // 3. GC scans the object (the RecursiveMarkDirtyObjects call below)
+  // 4. mutator writes the value (corresponding to the write barrier in 1.)
+  // This causes the GC to age the card but not necessarily mark the reference which the mutator
+  // wrote into the object stored in the card.
+  // Having the checkpoint fixes this issue since it ensures that the card mark and the
+  // reference write are visible to the GC before the card is scanned (this is due to locks being
+  // acquired / released in the checkpoint code).
+  // The other roots are also marked to help reduce the pause.
+  MarkRootsCheckpoint(self, false);
+  MarkNonThreadRoots();
+  MarkConcurrentRoots(
+      static_cast<VisitRootFlags>(kVisitRootFlagClearRootLog | kVisitRootFlagNewRoots));
+  // Process the newly aged cards.
+  RecursiveMarkDirtyObjects(false, accounting::CardTable::kCardDirty - 1);
+  // TODO: Empty allocation stack to reduce the number of objects we need to test / mark as live
+  // in the next GC.
+}
+
 void MarkSweep::RevokeAllThreadLocalAllocationStacks(Thread* self) {
   if (kUseThreadLocalAllocationStack) {
     TimingLogger::ScopedTiming t(__FUNCTION__, GetTimings());
@@ -66,6 +66,8 @@ enum GcCause {
   kGcCauseProfileSaver,
   // GC cause for deleting dex cache arrays at startup.
   kGcCauseDeletingDexCacheArrays,
+  // GC triggered to compact the heap after the process has been idle for a while.
+  kGcCauseIdleCompaction,
 };
 
 const char* PrettyCause(GcCause cause);
@@ -269,8 +269,11 @@ inline mirror::Object* Heap::AllocObjectWithAllocator(Thread* self,
   return obj.Ptr();
 }
 
-// The size of a thread-local allocation stack in the number of references.
+// The initial size of a thread-local allocation stack in the number of references. Threads
+// that keep refilling get chunks twice as big each time, up to
+// kMaxThreadLocalAllocationStackSize, so that they rarely touch the shared back index.
 static constexpr size_t kThreadLocalAllocationStackSize = 128;
+static constexpr size_t kMaxThreadLocalAllocationStackSize = 16 * kThreadLocalAllocationStackSize;
 
 inline void Heap::PushOnAllocationStack(Thread* self, ObjPtr<mirror::Object>* obj) {
   if (kUseThreadLocalAllocationStack) {
@@ -282,6 +285,52 @@ inline void Heap::PushOnAllocationStack(Thread* self, ObjPtr<mirror::Object>* ob
   }
 }
 
+template <typename PreFenceVisitor, typename Visitor>
+inline size_t Heap::AllocObjectsInTlab(Thread* self,
+                                       ObjPtr<mirror::Class> klass,
+                                       size_t byte_count,
+                                       size_t max_count,
+                                       AllocatorType allocator,
+                                       const PreFenceVisitor& pre_fence_visitor,
+                                       const Visitor& visitor) {
+  // Instrumented allocations report each object individually, leave them to AllocObject().
+  if (!IsTLABAllocator(allocator) ||
+      alloc_listener_.load(std::memory_order_seq_cst) != nullptr ||
+      IsAllocTrackingEnabled() ||
+      gc_stress_mode_ ||
+      Runtime::Current()->HasStatsEnabled() ||
+      ShouldAllocLargeObject(klass, byte_count)) {
+    return 0u;
+  }
+  if (kIsDebugBuild) {
+    CheckPreconditionsForAllocObject(klass, byte_count);
+    CHECK_EQ(self->GetState(), ThreadState::kRunnable);
+    self->AssertNoPendingException();
+  }
+  ScopedAssertNoThreadSuspension ants("Bulk TLAB allocation");
+  byte_count = RoundUp(byte_count, space::BumpPointerSpace::kAlignment);
+  size_t count = std::min(max_count, self->TlabSize() / byte_count);
+  if (count == 0u) {
+    return 0u;
+  }
+  uint8_t* start = self->AllocTlabObjects(count * byte_count, count);
+  for (size_t i = 0; i != count; ++i) {
+    ObjPtr<mirror::Object> obj = reinterpret_cast<mirror::Object*>(start + i * byte_count);
+    obj->SetClass(klass);
+    if (kUseBakerReadBarrier) {
+      obj->AssertReadBarrierState();
+    }
+    pre_fence_visitor(obj, byte_count);
+  }
+  QuasiAtomic::ThreadFenceForConstructor();
+  for (size_t i = 0; i != count; ++i) {
+    ObjPtr<mirror::Object> obj = reinterpret_cast<mirror::Object*>(start + i * byte_count);
+    VerifyObject(obj);
+    visitor(obj);
+  }
+  return count;
+}
+
 template <bool kInstrumented, typename PreFenceVisitor>
 inline mirror::Object* Heap::AllocLargeObject(Thread* self,
                                               ObjPtr<mirror::Class>* klass,
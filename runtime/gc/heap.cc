@@ -149,6 +149,10 @@ DEFINE_RUNTIME_DEBUG_FLAG(Heap, kStressCollectorTransition);
 // Minimum amount of remaining bytes before a concurrent GC is triggered.
 static constexpr size_t kMinConcurrentRemainingBytes = 128 * KB;
 static constexpr size_t kMaxConcurrentRemainingBytes = 512 * KB;
+// Weight of the latest sample in the adaptive GC trigger's moving averages.
+static constexpr double kAdaptiveGcTriggerEwmaWeight = 0.3;
+// Headroom over the predicted bytes allocated during the next GC, to absorb bursts.
+static constexpr double kAdaptiveGcTriggerSafetyFactor = 1.5;
 // Sticky GC throughput adjustment, divided by 4. Increasing this causes sticky GC to occur more
 // relative to partial/full GC. This may be desirable since sticky GCs interfere less with mutator
 // threads (lower pauses, use less memory bandwidth).
@@ -310,6 +314,7 @@ Heap::Heap(size_t initial_size,
            bool measure_gc_performance,
            bool use_homogeneous_space_compaction_for_oom,
            bool use_generational_cc,
+           bool use_generational_cmc,
            uint64_t min_interval_homogeneous_space_compaction_by_oom,
            bool dump_region_info_before_gc,
            bool dump_region_info_after_gc)
@@ -327,6 +332,7 @@ Heap::Heap(size_t initial_size,
       low_memory_mode_(low_memory_mode),
       long_pause_log_threshold_(long_pause_log_threshold),
       long_gc_log_threshold_(long_gc_log_threshold),
+      card_preclean_pause_target_ns_(0u),
       process_cpu_start_time_ns_(ProcessCpuNanoTime()),
       pre_gc_last_process_cpu_time_ns_(process_cpu_start_time_ns_),
       post_gc_last_process_cpu_time_ns_(process_cpu_start_time_ns_),
@@ -362,6 +368,11 @@ Heap::Heap(size_t initial_size,
       native_objects_notified_(0),
       num_bytes_freed_revoke_(0),
       num_bytes_alive_after_gc_(0),
+      adaptive_gc_trigger_(false),
+      last_gc_end_time_ns_(0u),
+      allocation_rate_ewma_(0.0),
+      gc_duration_ewma_ns_(),
+      idle_compaction_delay_ns_(0u),
       verify_missing_card_marks_(false),
       verify_system_weaks_(false),
       verify_pre_gc_heap_(verify_pre_gc_heap),
@@ -409,8 +420,10 @@ Heap::Heap(size_t initial_size,
       max_gc_requested_(0u),
       pending_collector_transition_(nullptr),
       pending_heap_trim_(nullptr),
+      pending_idle_compaction_(nullptr),
       use_homogeneous_space_compaction_for_oom_(use_homogeneous_space_compaction_for_oom),
       use_generational_cc_(use_generational_cc),
+      use_generational_cmc_(use_generational_cmc),
       running_collection_is_blocking_(false),
       blocking_gc_count_(0U),
       blocking_gc_time_(0U),
@@ -1002,6 +1015,27 @@ void Heap::DecrementDisableMovingGC(Thread* self) {
   --disable_moving_gc_count_;
 }
 
+bool Heap::TryPinRegionForCritical(ObjPtr<mirror::Object> obj) {
+  // Only the CC collector has the to-space invariant and region granular evacuation that
+  // make pinning possible. Objects are read with a read barrier, so `obj` is a to-space
+  // reference and keeping its region out of the from-space of subsequent flips keeps it
+  // in place.
+  if (!gUseReadBarrier || region_space_ == nullptr || !region_space_->HasAddress(obj.Ptr())) {
+    return false;
+  }
+  region_space_->PinRegion(obj.Ptr());
+  return true;
+}
+
+bool Heap::TryUnpinRegionForCritical(ObjPtr<mirror::Object> obj) {
+  // A pinned object does not move, so this matches the decision made when pinning.
+  if (!gUseReadBarrier || region_space_ == nullptr || !region_space_->HasAddress(obj.Ptr())) {
+    return false;
+  }
+  region_space_->UnpinRegion(obj.Ptr());
+  return true;
+}
+
 void Heap::IncrementDisableThreadFlip(Thread* self) {
   // Supposed to be called by mutators. If thread_flip_running_ is true, block. Otherwise, go ahead.
   bool is_nested = self->GetDisableThreadFlipCount() > 0;
@@ -1164,6 +1198,30 @@ void Heap::DeleteThreadPool() {
   thread_pool_.reset(nullptr);
 }
 
+void Heap::AdviseTransparentHugePages() {
+  std::vector<space::ContinuousMemMapAllocSpace*> spaces;
+  if (region_space_ != nullptr) {
+    spaces.push_back(region_space_);
+  }
+  // The userfaultfd GC moves pages of its moving space around and zaps them page by page
+  // during compaction, which would only split huge pages.
+  if (foreground_collector_type_ != kCollectorTypeCMC) {
+    if (bump_pointer_space_ != nullptr) {
+      spaces.push_back(bump_pointer_space_);
+    }
+    if (temp_space_ != nullptr) {
+      spaces.push_back(temp_space_);
+    }
+  }
+  for (space::ContinuousMemMapAllocSpace* space : spaces) {
+    if (space->GetMemMap()->MadviseHugePage() != 0) {
+      PLOG(WARNING) << "Failed to advise huge pages for " << space->GetName();
+    } else {
+      VLOG(heap) << "Advised huge pages for " << space->GetName();
+    }
+  }
+}
+
 void Heap::AddSpace(space::Space* space) {
   CHECK(space != nullptr);
   WriterMutexLock mu(Thread::Current(), *Locks::heap_bitmap_lock_);
@@ -1325,6 +1383,9 @@ void Heap::DumpGcPerformanceInfo(std::ostream& os) {
   if (kDumpRosAllocStatsOnSigQuit && rosalloc_space_ != nullptr) {
     rosalloc_space_->DumpStats(os);
   }
+  if (region_space_ != nullptr) {
+    region_space_->DumpStats(os);
+  }
 
   os << "Native bytes total: " << GetNativeBytes()
      << " registered: " << native_bytes_registered_.load(std::memory_order_relaxed) << "\n";
@@ -1611,6 +1672,11 @@ void Heap::Trim(Thread* self) {
   TrimSpaces(self);
   // Trim arenas that may have been used by JIT or verifier.
   runtime->GetArenaPool()->TrimMaps();
+  // Release linear-alloc arenas kept around for reuse.
+  ArenaPool* linear_alloc_arena_pool = runtime->GetLinearAllocArenaPool();
+  if (linear_alloc_arena_pool != nullptr) {
+    linear_alloc_arena_pool->TrimMaps();
+  }
 }
 
 class TrimIndirectReferenceTableClosure : public Closure {
@@ -2325,6 +2391,9 @@ void Heap::ChangeCollector(CollectorType collector_type) {
         break;
       }
       case kCollectorTypeCMC: {
+        if (use_generational_cmc_) {
+          gc_plan_.push_back(collector::kGcTypeSticky);
+        }
         gc_plan_.push_back(collector::kGcTypeFull);
         if (use_tlab_) {
           ChangeAllocator(kAllocatorTypeTLAB);
@@ -2853,6 +2922,10 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
           collector = semi_space_collector_;
           break;
         case kCollectorTypeCMC:
+          // The same collector runs both young and full cycles. The former is
+          // downgraded to the latter by the collector itself if needed.
+          mark_compact_->SetYoungGen(use_generational_cmc_ &&
+                                     gc_type == collector::kGcTypeSticky);
           collector = mark_compact_;
           break;
         case kCollectorTypeCC:
@@ -2913,6 +2986,10 @@ collector::GcType Heap::CollectGarbageInternal(collector::GcType gc_type,
   clear->Finalize();
   // Inform DDMS that a GC completed.
   Dbg::GcDidFinish();
+  // Look for an idle period after this GC, unless it was the idle compaction itself.
+  if (gc_cause != kGcCauseIdleCompaction) {
+    RequestIdleCompaction(self);
+  }
 
   // Unload native libraries for class unloading. We do this after calling FinishGC to prevent
   // deadlocks in case the JNI_OnUnload function does allocations.
@@ -3267,8 +3344,18 @@ void Heap::PushOnThreadLocalAllocationStackWithInternalGC(Thread* self,
   DCHECK(!self->PushOnThreadLocalAllocationStack(obj->Ptr()));
   StackReference<mirror::Object>* start_address;
   StackReference<mirror::Object>* end_address;
-  while (!allocation_stack_->AtomicBumpBack(kThreadLocalAllocationStackSize, &start_address,
-                                            &end_address)) {
+  // A thread which already filled a chunk since the last GC is likely to keep allocating, so
+  // grow its chunk to refill less often.
+  const size_t last_slots = self->GetThreadLocalAllocationStackSlots();
+  size_t num_slots = last_slots == 0
+      ? kThreadLocalAllocationStackSize
+      : std::min(2 * last_slots, kMaxThreadLocalAllocationStackSize);
+  while (!allocation_stack_->AtomicBumpBack(num_slots, &start_address, &end_address)) {
+    if (num_slots > kThreadLocalAllocationStackSize) {
+      // Near the growth limit. Take a smaller chunk before resorting to a GC.
+      num_slots = kThreadLocalAllocationStackSize;
+      continue;
+    }
     // TODO: Add handle VerifyObject.
     StackHandleScope<1> hs(self);
     HandleWrapperObjPtr<mirror::Object> wrapper(hs.NewHandleWrapper(obj));
@@ -3793,15 +3880,29 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     next_gc_type_ = collector::kGcTypeSticky;
   } else {
     collector::GcType non_sticky_gc_type = NonStickyGcType();
-    // Find what the next non sticky collector will be.
-    collector::GarbageCollector* non_sticky_collector = FindCollectorByGcType(non_sticky_gc_type);
-    if (use_generational_cc_) {
-      if (non_sticky_collector == nullptr) {
-        non_sticky_collector = FindCollectorByGcType(collector::kGcTypePartial);
+    uint64_t non_sticky_gc_throughput;
+    size_t non_sticky_gc_iterations;
+    if (collector_ran == mark_compact_) {
+      // The same collector instance runs both young and full CMC cycles, so
+      // it keeps the statistics of the full cycles separately.
+      DCHECK(use_generational_cmc_);
+      non_sticky_gc_throughput = mark_compact_->GetEstimatedFullGcMeanThroughput();
+      non_sticky_gc_iterations = mark_compact_->NumberOfFullGcIterations();
+    } else {
+      // Find what the next non sticky collector will be.
+      collector::GarbageCollector* non_sticky_collector =
+          FindCollectorByGcType(non_sticky_gc_type);
+      if (use_generational_cc_) {
+        if (non_sticky_collector == nullptr) {
+          non_sticky_collector = FindCollectorByGcType(collector::kGcTypePartial);
+        }
+        CHECK(non_sticky_collector != nullptr);
       }
-      CHECK(non_sticky_collector != nullptr);
+      non_sticky_gc_throughput = non_sticky_collector->GetEstimatedMeanThroughput();
+      non_sticky_gc_iterations = non_sticky_collector->NumberOfIterations();
     }
-    double sticky_gc_throughput_adjustment = GetStickyGcThroughputAdjustment(use_generational_cc_);
+    double sticky_gc_throughput_adjustment =
+        GetStickyGcThroughputAdjustment(use_generational_cc_ || use_generational_cmc_);
 
     // If the throughput of the current sticky GC >= throughput of the non sticky collector, then
     // do another sticky collection next.
@@ -3811,8 +3912,8 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
     // if the sticky GC throughput always remained >= the full/partial throughput.
     size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
     if (current_gc_iteration_.GetEstimatedThroughput() * sticky_gc_throughput_adjustment >=
-        non_sticky_collector->GetEstimatedMeanThroughput() &&
-        non_sticky_collector->NumberOfIterations() > 0 &&
+        non_sticky_gc_throughput &&
+        non_sticky_gc_iterations > 0 &&
         bytes_allocated <= (IsGcConcurrent() ? concurrent_start_bytes_ : target_footprint)) {
       next_gc_type_ = collector::kGcTypeSticky;
     } else {
@@ -3852,6 +3953,8 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
           current_gc_iteration_.GetFreedRevokeBytes();
       // Records the number of bytes allocated at the time of GC finish,excluding the number of
       // bytes allocated during GC.
+      const size_t bytes_allocated_before_gc_since_last_gc =
+          UnsignedDifference(bytes_allocated_before_gc, num_bytes_alive_after_gc_);
       num_bytes_alive_after_gc_ = UnsignedDifference(bytes_allocated_before_gc, freed_bytes);
       // Bytes allocated will shrink by freed_bytes after the GC runs, so if we want to figure out
       // how many bytes were allocated during the GC we need to add freed_bytes back on.
@@ -3860,8 +3963,16 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
           UnsignedDifference(bytes_allocated + freed_bytes, bytes_allocated_before_gc);
       // Calculate when to perform the next ConcurrentGC.
       // Estimate how many remaining bytes we will have when we need to start the next GC.
-      size_t remaining_bytes = bytes_allocated_during_gc;
-      remaining_bytes = std::min(remaining_bytes, kMaxConcurrentRemainingBytes);
+      size_t remaining_bytes;
+      if (adaptive_gc_trigger_) {
+        remaining_bytes = UpdateAdaptiveGcTrigger(
+            gc_type,
+            next_gc_type_,
+            bytes_allocated_before_gc_since_last_gc + bytes_allocated_during_gc);
+        remaining_bytes = std::min(remaining_bytes, max_free_);
+      } else {
+        remaining_bytes = std::min(bytes_allocated_during_gc, kMaxConcurrentRemainingBytes);
+      }
       remaining_bytes = std::max(remaining_bytes, kMinConcurrentRemainingBytes);
       size_t target_footprint = target_footprint_.load(std::memory_order_relaxed);
       if (UNLIKELY(remaining_bytes > target_footprint)) {
@@ -3885,6 +3996,38 @@ void Heap::GrowForUtilization(collector::GarbageCollector* collector_ran,
   }
 }
 
+size_t Heap::UpdateAdaptiveGcTrigger(collector::GcType gc_type,
+                                     collector::GcType next_gc_type,
+                                     size_t bytes_allocated_since_last_gc) {
+  DCHECK_GT(gc_type, collector::kGcTypeNone);
+  DCHECK_LT(gc_type, collector::kGcTypeMax);
+  auto ewma = [](double average, double sample) {
+    return average == 0.0
+        ? sample
+        : kAdaptiveGcTriggerEwmaWeight * sample + (1.0 - kAdaptiveGcTriggerEwmaWeight) * average;
+  };
+  const uint64_t now = NanoTime();
+  // The first GC has no previous end time; its interval would include startup.
+  if (last_gc_end_time_ns_ != 0u && now > last_gc_end_time_ns_) {
+    const double rate =
+        static_cast<double>(bytes_allocated_since_last_gc) / (now - last_gc_end_time_ns_);
+    allocation_rate_ewma_ = ewma(allocation_rate_ewma_, rate);
+  }
+  last_gc_end_time_ns_ = now;
+  const double duration = static_cast<double>(current_gc_iteration_.GetDurationNs());
+  gc_duration_ewma_ns_[gc_type] = ewma(gc_duration_ewma_ns_[gc_type], duration);
+  // Predict with the type of GC that runs next, if one has been seen already.
+  double predicted_duration = gc_duration_ewma_ns_[next_gc_type];
+  if (predicted_duration == 0.0) {
+    predicted_duration = gc_duration_ewma_ns_[gc_type];
+  }
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics->GcAllocationRate()->Add(static_cast<int64_t>(allocation_rate_ewma_ * 1e9 / MB));
+  metrics->GcPredictedDuration()->Add(static_cast<int64_t>(predicted_duration / 1e6));
+  return static_cast<size_t>(
+      allocation_rate_ewma_ * predicted_duration * kAdaptiveGcTriggerSafetyFactor);
+}
+
 void Heap::ClampGrowthLimit() {
   // Use heap bitmap lock to guard against races with BindLiveToMarkBitmap.
   ScopedObjectAccess soa(Thread::Current());
@@ -4131,6 +4274,94 @@ void Heap::RequestTrim(Thread* self) {
   task_processor_->AddTask(self, added_task);
 }
 
+// The process is considered idle if it allocated less than this many bytes during the idle
+// compaction delay...
+static constexpr uint64_t kIdleCompactionMaxAllocatedBytes = 256 * KB;
+// ... and used less than this fraction of a single CPU over the same period.
+static constexpr double kIdleCompactionMaxCpuFraction = 0.05;
+
+class Heap::IdleCompactionTask : public HeapTask {
+ public:
+  IdleCompactionTask(uint64_t delta_time,
+                     uint32_t gc_num,
+                     uint64_t bytes_allocated_ever,
+                     uint64_t process_cpu_time_ns)
+      : HeapTask(NanoTime() + delta_time),
+        start_time_ns_(NanoTime()),
+        gc_num_(gc_num),
+        bytes_allocated_ever_(bytes_allocated_ever),
+        process_cpu_time_ns_(process_cpu_time_ns) {}
+
+  void Run(Thread* self) override {
+    gc::Heap* heap = Runtime::Current()->GetHeap();
+    bool idle = heap->IsIdleSince(gc_num_, bytes_allocated_ever_, process_cpu_time_ns_,
+                                  start_time_ns_);
+    heap->ClearPendingIdleCompaction(self);
+    if (idle) {
+      // Passing gc_num_ + 1 makes this a no-op if a GC started in the meantime.
+      heap->CollectGarbageInternal(collector::kGcTypeFull,
+                                   kGcCauseIdleCompaction,
+                                   /*clear_soft_references=*/false,
+                                   gc_num_ + 1);
+    } else {
+      // The process was busy. Drop this attempt and wait for another idle period.
+      heap->RequestIdleCompaction(self);
+    }
+  }
+
+ private:
+  const uint64_t start_time_ns_;
+  const uint32_t gc_num_;
+  const uint64_t bytes_allocated_ever_;
+  const uint64_t process_cpu_time_ns_;
+};
+
+bool Heap::IsIdleSince(uint32_t gc_num,
+                       uint64_t bytes_allocated_ever,
+                       uint64_t process_cpu_time_ns,
+                       uint64_t start_time_ns) {
+  if (GetCurrentGcNum() != gc_num) {
+    return false;
+  }
+  uint64_t allocated = GetBytesAllocatedEver() - bytes_allocated_ever;
+  uint64_t wall_time = NanoTime() - start_time_ns;
+  uint64_t cpu_time = ProcessCpuNanoTime() - process_cpu_time_ns;
+  bool idle = allocated < kIdleCompactionMaxAllocatedBytes &&
+              cpu_time < wall_time * kIdleCompactionMaxCpuFraction;
+  VLOG(heap) << "Idle compaction check: allocated " << PrettySize(allocated) << ", CPU time "
+             << PrettyDuration(cpu_time) << " in " << PrettyDuration(wall_time)
+             << (idle ? ", compacting" : ", skipping");
+  return idle;
+}
+
+void Heap::ClearPendingIdleCompaction(Thread* self) {
+  MutexLock mu(self, *pending_task_lock_);
+  pending_idle_compaction_ = nullptr;
+}
+
+void Heap::RequestIdleCompaction(Thread* self) {
+  // Only the concurrent compacting collectors can compact without a long pause.
+  if (idle_compaction_delay_ns_ == 0u ||
+      (collector_type_ != kCollectorTypeCC && collector_type_ != kCollectorTypeCMC) ||
+      !CanAddHeapTask(self)) {
+    return;
+  }
+  IdleCompactionTask* added_task = nullptr;
+  {
+    MutexLock mu(self, *pending_task_lock_);
+    if (pending_idle_compaction_ != nullptr) {
+      // The pending task notices the GC that triggered this request and starts over.
+      return;
+    }
+    added_task = new IdleCompactionTask(idle_compaction_delay_ns_,
+                                        GetCurrentGcNum(),
+                                        GetBytesAllocatedEver(),
+                                        ProcessCpuNanoTime());
+    pending_idle_compaction_ = added_task;
+  }
+  task_processor_->AddTask(self, added_task);
+}
+
 void Heap::IncrementNumberOfBytesFreedRevoke(size_t freed_bytes_revoke) {
   size_t previous_num_bytes_freed_revoke =
       num_bytes_freed_revoke_.fetch_add(freed_bytes_revoke, std::memory_order_relaxed);
@@ -238,6 +238,7 @@ class Heap {
        bool measure_gc_performance,
        bool use_homogeneous_space_compaction,
        bool use_generational_cc,
+       bool use_generational_cmc,
        uint64_t min_interval_homogeneous_space_compaction_by_oom,
        bool dump_region_info_before_gc,
        bool dump_region_info_after_gc);
@@ -299,6 +300,23 @@ class Heap {
                !process_state_update_lock_,
                !Roles::uninterruptible_);
 
+  // Allocates up to `max_count` objects of `klass`, each of `byte_count` bytes, from the
+  // thread-local allocation buffer with a single bump of its position. `pre_fence_visitor` is
+  // called on each object before the constructor fence and `visitor` on each object after it.
+  // Returns the number of objects allocated, which is 0 if the allocator doesn't use TLABs, the
+  // allocation needs to be instrumented, the objects belong in the large object space or the
+  // TLAB doesn't have room for one of them. The caller then falls back to AllocObject(), which
+  // also refills the TLAB. Never suspends.
+  template <typename PreFenceVisitor, typename Visitor>
+  size_t AllocObjectsInTlab(Thread* self,
+                            ObjPtr<mirror::Class> klass,
+                            size_t byte_count,
+                            size_t max_count,
+                            AllocatorType allocator,
+                            const PreFenceVisitor& pre_fence_visitor,
+                            const Visitor& visitor)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   AllocatorType GetCurrentAllocator() const {
     return current_allocator_;
   }
@@ -393,6 +411,13 @@ class Heap {
   // Temporarily disable thread flip for JNI critical calls.
   void IncrementDisableThreadFlip(Thread* self) REQUIRES(!*thread_flip_lock_);
   void DecrementDisableThreadFlip(Thread* self) REQUIRES(!*thread_flip_lock_);
+  // Pin the region of a region space object for a JNI critical section so that the section
+  // does not need to block the thread flip. Returns false if the object cannot be pinned and
+  // the caller needs to use `IncrementDisableThreadFlip()` instead.
+  bool TryPinRegionForCritical(ObjPtr<mirror::Object> obj) REQUIRES_SHARED(Locks::mutator_lock_);
+  // Undo `TryPinRegionForCritical()`. Returns false if `obj` was not pinned by it.
+  bool TryUnpinRegionForCritical(ObjPtr<mirror::Object> obj)
+      REQUIRES_SHARED(Locks::mutator_lock_);
   void ThreadFlipBegin(Thread* self) REQUIRES(!*thread_flip_lock_);
   void ThreadFlipEnd(Thread* self) REQUIRES(!*thread_flip_lock_);
 
@@ -477,6 +502,27 @@ class Heap {
   // dalvik.system.VMRuntime.setTargetHeapUtilization.
   void SetTargetHeapUtilization(float target);
 
+  void SetCardPreCleanPauseTarget(uint64_t target_ns) {
+    card_preclean_pause_target_ns_ = target_ns;
+  }
+  uint64_t GetCardPreCleanPauseTarget() const {
+    return card_preclean_pause_target_ns_;
+  }
+
+  void SetAdaptiveGcTrigger(bool enabled) {
+    adaptive_gc_trigger_ = enabled;
+  }
+
+  // Sets how long the process has to stay idle after a GC before the heap is compacted in the
+  // background. 0 disables idle compaction.
+  void SetIdleCompactionDelay(uint64_t delay_ns) {
+    idle_compaction_delay_ns_ = delay_ns;
+  }
+
+  // Advise the kernel to back the region space, or the bump pointer spaces of the semi-space
+  // collector, with transparent huge pages. Should be called before the spaces are used.
+  void AdviseTransparentHugePages();
+
   // For the alloc space, sets the maximum number of bytes that the heap is allowed to allocate
   // from the system. Doesn't allow the space to exceed its growth limit.
   // Set while we hold gc_complete_lock or collector_type_running_ != kCollectorTypeNone.
@@ -574,6 +620,10 @@ class Heap {
     return use_generational_cc_;
   }
 
+  bool GetUseGenerationalCMC() const {
+    return use_generational_cmc_;
+  }
+
   // Returns the number of objects currently allocated.
   size_t GetObjectsAllocated() const
       REQUIRES(!Locks::heap_bitmap_lock_);
@@ -874,6 +924,10 @@ class Heap {
   // Request an asynchronous trim.
   void RequestTrim(Thread* self) REQUIRES(!*pending_task_lock_);
 
+  // Request a compaction of the heap once the process has been idle for the idle compaction
+  // delay. Does nothing if idle compaction is disabled or already pending.
+  void RequestIdleCompaction(Thread* self) REQUIRES(!*pending_task_lock_);
+
   // Retrieve the current GC number, i.e. the number n such that we completed n GCs so far.
   // Provides acquire ordering, so that if we read this first, and then check whether a GC is
   // required, we know that the GC number read actually preceded the test.
@@ -1031,6 +1085,7 @@ class Heap {
   class ConcurrentGCTask;
   class CollectorTransitionTask;
   class HeapTrimTask;
+  class IdleCompactionTask;
   class TriggerPostForkCCGcTask;
   class ReduceTargetFootprintTask;
 
@@ -1237,6 +1292,14 @@ class Heap {
                           size_t bytes_allocated_before_gc = 0)
       REQUIRES(!process_state_update_lock_);
 
+  // Update the allocation rate and GC duration averages of the adaptive GC trigger with the GC
+  // that just finished, and return the number of bytes expected to be allocated while a GC of
+  // `next_gc_type` runs. Only used for concurrent GCs.
+  size_t UpdateAdaptiveGcTrigger(collector::GcType gc_type,
+                                 collector::GcType next_gc_type,
+                                 size_t bytes_allocated_since_last_gc)
+      REQUIRES(process_state_update_lock_);
+
   size_t GetPercentFree();
 
   // Swap the allocation stack with the live stack.
@@ -1265,6 +1328,14 @@ class Heap {
 
   void ClearPendingTrim(Thread* self) REQUIRES(!*pending_task_lock_);
   void ClearPendingCollectorTransition(Thread* self) REQUIRES(!*pending_task_lock_);
+  void ClearPendingIdleCompaction(Thread* self) REQUIRES(!*pending_task_lock_);
+
+  // Returns true if no GC ran, little was allocated and the process used little CPU since the
+  // given snapshot was taken at `start_time_ns`.
+  bool IsIdleSince(uint32_t gc_num,
+                   uint64_t bytes_allocated_ever,
+                   uint64_t process_cpu_time_ns,
+                   uint64_t start_time_ns);
 
   // What kind of concurrency behavior is the runtime after?
   bool IsGcConcurrent() const ALWAYS_INLINE {
@@ -1402,6 +1473,11 @@ class Heap {
   // If we get a GC longer than long GC log threshold, then we print out the GC after it finishes.
   const size_t long_gc_log_threshold_;
 
+  // Target for the time spent in the marking pause scanning dirty cards. If
+  // non-zero, concurrent collectors run additional card pre-cleaning rounds
+  // until a round takes less than this, or stops converging.
+  uint64_t card_preclean_pause_target_ns_;
+
   // Starting time of the new process; meant to be used for measuring total process CPU time.
   uint64_t process_cpu_start_time_ns_;
 
@@ -1534,6 +1610,19 @@ class Heap {
   // how many bytes have been allocated since the last GC
   size_t num_bytes_alive_after_gc_;
 
+  // If true, the next concurrent GC is started early enough for it to finish before the
+  // target footprint is reached, given the averages below. See UpdateAdaptiveGcTrigger().
+  bool adaptive_gc_trigger_;
+  // Time at which the previous concurrent GC finished, 0 if there was none.
+  uint64_t last_gc_end_time_ns_ GUARDED_BY(process_state_update_lock_);
+  // Exponentially weighted moving average of the allocation rate, in bytes per nanosecond.
+  double allocation_rate_ewma_ GUARDED_BY(process_state_update_lock_);
+  // Exponentially weighted moving average of the GC duration for each GC type, in nanoseconds.
+  double gc_duration_ewma_ns_[collector::kGcTypeMax] GUARDED_BY(process_state_update_lock_);
+
+  // How long the process has to be idle before the heap is compacted, 0 if disabled.
+  uint64_t idle_compaction_delay_ns_;
+
   // Info related to the current or previous GC iteration.
   collector::Iteration current_gc_iteration_;
 
@@ -1684,6 +1773,7 @@ class Heap {
   // Active tasks which we can modify (change target time, desired collector type, etc..).
   CollectorTransitionTask* pending_collector_transition_ GUARDED_BY(pending_task_lock_);
   HeapTrimTask* pending_heap_trim_ GUARDED_BY(pending_task_lock_);
+  IdleCompactionTask* pending_idle_compaction_ GUARDED_BY(pending_task_lock_);
 
   // Whether or not we use homogeneous space compaction to avoid OOM errors.
   bool use_homogeneous_space_compaction_for_oom_;
@@ -1693,6 +1783,12 @@ class Heap {
   // for major collections. Set in Heap constructor.
   const bool use_generational_cc_;
 
+  // If true, enable generational collection when using the Concurrent
+  // Mark-Compact (CMC) collector, i.e. use young-generation CMC cycles for
+  // minor collections and full CMC cycles for major collections. Set in Heap
+  // constructor.
+  const bool use_generational_cmc_;
+
   // True if the currently running collection has made some thread wait.
   bool running_collection_is_blocking_ GUARDED_BY(gc_complete_lock_);
   // The number of blocking GC runs.
@@ -17,16 +17,21 @@
 #include <algorithm>
 
 #include "base/metrics/metrics.h"
+#include "base/time_utils.h"
 #include "class_linker-inl.h"
+#include "class_root-inl.h"
 #include "common_runtime_test.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/accounting/space_bitmap-inl.h"
+#include "gc/heap-inl.h"
 #include "handle_scope-inl.h"
+#include "mirror/class-alloc-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/object-inl.h"
 #include "mirror/object_array-alloc-inl.h"
 #include "mirror/object_array-inl.h"
 #include "scoped_thread_state_change-inl.h"
+#include "thread_pool.h"
 
 namespace art HIDDEN {
 namespace gc {
@@ -256,6 +261,62 @@ TEST_F(HeapTest, GCMetrics) {
     EXPECT_TRUE(young_gc_duration->IsNull());
     EXPECT_TRUE(young_gc_duration_delta->IsNull());
   }
+
+  // Per-pause and per-cause metrics are reported by all collectors. `CollectGarbage()` always
+  // pauses at least once and reports an explicit GC.
+  EXPECT_FALSE(metrics->GcPauseTime()->IsNull());
+  EXPECT_FALSE(metrics->GcExplicitCount()->IsNull());
+  EXPECT_FALSE(metrics->GcRefProcessingTime()->IsNull());
+}
+
+class NonMovableAllocationTask : public Task {
+ public:
+  explicit NonMovableAllocationTask(size_t num_allocations) : num_allocations_(num_allocations) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    ObjPtr<mirror::Class> klass = GetClassRoot<mirror::Object>();
+    for (size_t i = 0; i < num_allocations_; ++i) {
+      EXPECT_TRUE(klass->AllocNonMovableObject(self) != nullptr);
+    }
+    max_slots_ = self->GetThreadLocalAllocationStackSlots();
+  }
+
+  size_t GetMaxSlots() const {
+    return max_slots_;
+  }
+
+ private:
+  const size_t num_allocations_;
+  size_t max_slots_ = 0;
+};
+
+// Microbenchmark for many threads refilling their thread-local allocation stacks at the same
+// time. Non-movable allocations always go through the allocation stack.
+TEST_F(HeapTest, AllocationStackContention) {
+  if (!kUseThreadLocalAllocationStack) {
+    GTEST_SKIP() << "Thread-local allocation stacks are disabled";
+  }
+  constexpr size_t kNumThreads = 4;
+  constexpr size_t kAllocationsPerThread = 20000;
+  Thread* self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Allocation stack test thread pool", kNumThreads));
+  std::vector<std::unique_ptr<NonMovableAllocationTask>> tasks;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    tasks.emplace_back(new NonMovableAllocationTask(kAllocationsPerThread));
+    thread_pool->AddTask(self, tasks.back().get());
+  }
+  const uint64_t start_time = NanoTime();
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /*do_work=*/ false, /*may_hold_locks=*/ false);
+  const uint64_t duration = NanoTime() - start_time;
+  for (const std::unique_ptr<NonMovableAllocationTask>& task : tasks) {
+    // Chunks never grow beyond the maximum. They may have been revoked by a GC at the end.
+    EXPECT_LE(task->GetMaxSlots(), kMaxThreadLocalAllocationStackSize);
+  }
+  LOG(INFO) << kNumThreads * kAllocationsPerThread << " non-movable allocations on "
+            << kNumThreads << " threads took " << PrettyDuration(duration);
 }
 
 class ZygoteHeapTest : public CommonRuntimeTest {
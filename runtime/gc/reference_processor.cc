@@ -16,6 +16,8 @@
 
 #include "reference_processor.h"
 
+#include "android-base/stringprintf.h"
+
 #include "art_field-inl.h"
 #include "base/mutex.h"
 #include "base/time_utils.h"
@@ -39,6 +41,8 @@
 namespace art HIDDEN {
 namespace gc {
 
+using android::base::StringPrintf;
+
 static constexpr bool kAsyncReferenceQueueAdd = false;
 
 ReferenceProcessor::ReferenceProcessor()
@@ -119,6 +123,22 @@ ObjPtr<mirror::Object> ReferenceProcessor::GetReferent(Thread* self,
   while (slow_path_required()) {
     DCHECK(collector_ != nullptr);
     const bool other_read_barrier = !kUseBakerReadBarrier && gUseReadBarrier;
+    if (rp_state_ == RpState::kStarting &&
+        !reference->IsFinalizerReferenceInstance() &&
+        !reference->IsPhantomReferenceInstance()) {
+      // It is too early to tell that an unmarked referent is going to be cleared, but a marked
+      // one stays marked, so it is safe to return without waiting for reference processing.
+      // Re-load the referent as it may have been cleared before we acquired the lock.
+      referent = reference->GetReferent<kWithoutReadBarrier>();
+      ObjPtr<mirror::Object> forwarded_ref =
+          referent.IsNull() ? nullptr : collector_->IsMarked(referent.Ptr());
+      if (referent.IsNull() || forwarded_ref != nullptr) {
+        if (started_trace) {
+          finish_trace(start_millis);
+        }
+        return forwarded_ref;
+      }
+    }
     if (UNLIKELY(reference->IsFinalizerReferenceInstance()
                  || rp_state_ == RpState::kStarting /* too early to determine mark state */
                  || (other_read_barrier && reference->IsPhantomReferenceInstance()))) {
@@ -201,6 +221,7 @@ void ReferenceProcessor::Setup(Thread* self,
 // We advance rp_state_ to signal partial completion for the benefit of GetReferent.
 void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings) {
   TimingLogger::ScopedTiming t(concurrent_ ? __FUNCTION__ : "(Paused)ProcessReferences", timings);
+  const uint64_t start_time = NanoTime();
   if (!clear_soft_references_) {
     // Forward any additional SoftReferences we discovered late, now that reference access has been
     // inhibited.
@@ -230,8 +251,10 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
   }
   // Clear all remaining soft and weak references with white referents.
   // This misses references only reachable through finalizers.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  cleared_stats_.num_soft_ +=
+      soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  cleared_stats_.num_weak_ +=
+      weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
   // Defer PhantomReference processing until we've finished marking through finalizers.
   {
     // TODO: Capture mark state of some system weaks here. If the referent was marked here,
@@ -253,6 +276,7 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
     // Preserve all white objects with finalize methods and schedule them for finalization.
     FinalizerStats finalizer_stats =
         finalizer_reference_queue_.EnqueueFinalizerReferences(&cleared_references_, collector_);
+    cleared_stats_.num_finalizer_ += finalizer_stats.num_enqueued_;
     if (ATraceEnabled()) {
       static constexpr size_t kBufSize = 80;
       char buf[kBufSize];
@@ -285,13 +309,14 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
   // finalized object containing pointers to native objects that have already been deallocated.
   // But it can be argued that this is just an instance of the broader rule that it is not safe
   // for finalizers to access otherwise inaccessible finalizable objects.
-  soft_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_,
-                                             /*report_cleared=*/ true);
-  weak_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_,
-                                             /*report_cleared=*/ true);
+  cleared_stats_.num_soft_ += soft_reference_queue_.ClearWhiteReferences(
+      &cleared_references_, collector_, /*report_cleared=*/ true);
+  cleared_stats_.num_weak_ += weak_reference_queue_.ClearWhiteReferences(
+      &cleared_references_, collector_, /*report_cleared=*/ true);
 
   // Clear all phantom references with white referents. It's fine to do this just once here.
-  phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
+  cleared_stats_.num_phantom_ +=
+      phantom_reference_queue_.ClearWhiteReferences(&cleared_references_, collector_);
 
   // At this point all reference queues other than the cleared references should be empty.
   DCHECK(soft_reference_queue_.IsEmpty());
@@ -310,6 +335,7 @@ void ReferenceProcessor::ProcessReferences(Thread* self, TimingLogger* timings)
       DisableSlowPath(self);
     }
   }
+  Runtime::Current()->GetMetrics()->GcRefProcessingTime()->Add(NsToUs(NanoTime() - start_time));
 }
 
 // Process the "referent" field in a java.lang.ref.Reference.  If the referent has not yet been
@@ -356,12 +382,24 @@ void ReferenceProcessor::UpdateRoots(IsMarkedVisitor* visitor) {
   cleared_references_.UpdateRoots(visitor);
 }
 
+// Hands the whole circular list of cleared references to ReferenceQueue.add() with a single
+// call into managed code.
 class ClearedReferenceTask : public HeapTask {
  public:
-  explicit ClearedReferenceTask(jobject cleared_references)
-      : HeapTask(NanoTime()), cleared_references_(cleared_references) {
+  ClearedReferenceTask(jobject cleared_references, const ClearedReferenceStats& stats)
+      : HeapTask(NanoTime()), cleared_references_(cleared_references), stats_(stats) {
   }
   void Run(Thread* thread) override {
+    ScopedTrace trace([&]() {
+      return StringPrintf("ReferenceQueue.add %u soft, %u weak, %u finalizer, %u phantom",
+                          stats_.num_soft_,
+                          stats_.num_weak_,
+                          stats_.num_finalizer_,
+                          stats_.num_phantom_);
+    });
+    VLOG(heap) << "Enqueueing " << stats_.Total() << " cleared references: "
+               << stats_.num_soft_ << " soft, " << stats_.num_weak_ << " weak, "
+               << stats_.num_finalizer_ << " finalizer, " << stats_.num_phantom_ << " phantom";
     ScopedObjectAccess soa(thread);
     WellKnownClasses::java_lang_ref_ReferenceQueue_add->InvokeStatic<'V', 'L'>(
         thread, soa.Decode<mirror::Object>(cleared_references_));
@@ -370,6 +408,7 @@ class ClearedReferenceTask : public HeapTask {
 
  private:
   const jobject cleared_references_;
+  const ClearedReferenceStats stats_;
 };
 
 SelfDeletingTask* ReferenceProcessor::CollectClearedReferences(Thread* self) {
@@ -390,12 +429,13 @@ SelfDeletingTask* ReferenceProcessor::CollectClearedReferences(Thread* self) {
         // TODO: This can cause RunFinalization to terminate before newly freed objects are
         // finalized since they may not be enqueued by the time RunFinalization starts.
         Runtime::Current()->GetHeap()->GetTaskProcessor()->AddTask(
-            self, new ClearedReferenceTask(cleared_references));
+            self, new ClearedReferenceTask(cleared_references, cleared_stats_));
       } else {
-        result.reset(new ClearedReferenceTask(cleared_references));
+        result.reset(new ClearedReferenceTask(cleared_references, cleared_stats_));
       }
     }
     cleared_references_.Clear();
+    cleared_stats_ = ClearedReferenceStats();
   }
   return result.release();
 }
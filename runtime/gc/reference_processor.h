@@ -123,6 +123,8 @@ class ReferenceProcessor {
   ReferenceQueue finalizer_reference_queue_;
   ReferenceQueue phantom_reference_queue_;
   ReferenceQueue cleared_references_;
+  // What is in cleared_references_, reported when it is handed over. Only used by GC thread.
+  ClearedReferenceStats cleared_stats_;
 
   DISALLOW_COPY_AND_ASSIGN(ReferenceProcessor);
 };
@@ -131,9 +131,10 @@ size_t ReferenceQueue::GetLength() const {
   return count;
 }
 
-void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
-                                          collector::GarbageCollector* collector,
-                                          bool report_cleared) {
+uint32_t ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
+                                              collector::GarbageCollector* collector,
+                                              bool report_cleared) {
+  uint32_t num_cleared = 0;
   while (!IsEmpty()) {
     ObjPtr<mirror::Reference> ref = DequeuePendingReference();
     mirror::HeapReference<mirror::Object>* referent_addr = ref->GetReferentReferenceAddr();
@@ -147,6 +148,7 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
         ref->ClearReferent<false>();
       }
       cleared_references->EnqueueReference(ref);
+      ++num_cleared;
       if (report_cleared) {
         static bool already_reported = false;
         if (!already_reported) {
@@ -161,6 +163,7 @@ void ReferenceQueue::ClearWhiteReferences(ReferenceQueue* cleared_references,
     // transaction mode will trigger the read barrier.
     DisableReadBarrierForReference(ref, std::memory_order_relaxed);
   }
+  return num_cleared;
 }
 
 FinalizerStats ReferenceQueue::EnqueueFinalizerReferences(ReferenceQueue* cleared_references,
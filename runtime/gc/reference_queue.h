@@ -57,6 +57,18 @@ struct FinalizerStats {
   const uint32_t num_enqueued_;
 };
 
+// Number of references of each kind handed over to the java.lang.ref.ReferenceQueue(s) in one
+// batch of cleared references.
+struct ClearedReferenceStats {
+  uint32_t Total() const {
+    return num_soft_ + num_weak_ + num_finalizer_ + num_phantom_;
+  }
+  uint32_t num_soft_ = 0;
+  uint32_t num_weak_ = 0;
+  uint32_t num_finalizer_ = 0;
+  uint32_t num_phantom_ = 0;
+};
+
 // Used to temporarily store java.lang.ref.Reference(s) during GC and prior to queueing on the
 // appropriate java.lang.ref.ReferenceQueue. The linked list is maintained as an unordered,
 // circular, and singly-linked list using the pendingNext fields of the java.lang.ref.Reference
@@ -104,7 +116,8 @@ class ReferenceQueue {
 
   // Unlink the reference list clearing references objects with white referents. Cleared references
   // registered to a reference queue are scheduled for appending by the heap worker thread.
-  void ClearWhiteReferences(ReferenceQueue* cleared_references,
+  // Returns the number of cleared references.
+  uint32_t ClearWhiteReferences(ReferenceQueue* cleared_references,
                             collector::GarbageCollector* collector,
                             bool report_cleared = false)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -16,18 +16,25 @@
 
 #include "image_space.h"
 
+#include <fcntl.h>
 #include <sys/statvfs.h>
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "android-base/file.h"
 #include "android-base/logging.h"
+#include "android-base/parseint.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 #include "android-base/unique_fd.h"
@@ -287,10 +294,12 @@ class ImageSpace::PatchObjectVisitor final {
     // This should be the only reference field in j.l.Object and we assert that below.
     DCHECK_EQ(class_class,
               heap_visitor_(klass->GetClass<kVerifyNone, kWithoutReadBarrier>()));
-    klass->SetFieldObjectWithoutWriteBarrier<
-        /*kTransactionActive=*/ false,
-        /*kCheckTransaction=*/ true,
-        kVerifyNone>(mirror::Object::ClassOffset(), class_class);
+    if (klass->GetClass<kVerifyNone, kWithoutReadBarrier>() != class_class) {
+      klass->SetFieldObjectWithoutWriteBarrier<
+          /*kTransactionActive=*/ false,
+          /*kCheckTransaction=*/ true,
+          kVerifyNone>(mirror::Object::ClassOffset(), class_class);
+    }
     // Then patch the reference instance fields described by j.l.Class.class.
     // Use the sizeof(Object) to determine where these reference fields start;
     // this is the same as `class_class->GetFirstReferenceInstanceFieldOffset()`
@@ -442,7 +451,11 @@ class ImageSpace::PatchObjectVisitor final {
     T* old_value = root->template Read<kWithoutReadBarrier>();
     DCHECK(kMayBeNull || old_value != nullptr);
     if (!kMayBeNull || old_value != nullptr) {
-      *root = GcRoot<T>(heap_visitor_(old_value));
+      T* new_value = heap_visitor_(old_value);
+      // Avoid dirtying the page of a root which does not move.
+      if (new_value != old_value) {
+        *root = GcRoot<T>(new_value);
+      }
     }
   }
 
@@ -454,7 +467,9 @@ class ImageSpace::PatchObjectVisitor final {
       DCHECK(kMayBeNull || old_value != nullptr);
       if (!kMayBeNull || old_value != nullptr) {
         T* new_value = native_visitor_(old_value);
-        *raw_entry = reinterpret_cast64<uint64_t>(new_value);
+        if (new_value != old_value) {
+          *raw_entry = reinterpret_cast64<uint64_t>(new_value);
+        }
       }
     } else {
       uint32_t* raw_entry = reinterpret_cast<uint32_t*>(entry);
@@ -462,7 +477,9 @@ class ImageSpace::PatchObjectVisitor final {
       DCHECK(kMayBeNull || old_value != nullptr);
       if (!kMayBeNull || old_value != nullptr) {
         T* new_value = native_visitor_(old_value);
-        *raw_entry = reinterpret_cast32<uint32_t>(new_value);
+        if (new_value != old_value) {
+          *raw_entry = reinterpret_cast32<uint32_t>(new_value);
+        }
       }
     }
   }
@@ -475,9 +492,12 @@ class ImageSpace::PatchObjectVisitor final {
     DCHECK(kMayBeNull || old_value != nullptr);
     if (!kMayBeNull || old_value != nullptr) {
       ObjPtr<mirror::Object> new_value = heap_visitor_(old_value.Ptr());
-      object->SetFieldObjectWithoutWriteBarrier</*kTransactionActive=*/ false,
-                                                /*kCheckTransaction=*/ true,
-                                                kVerifyNone>(offset, new_value);
+      // Avoid dirtying the page of a reference which does not move.
+      if (new_value != old_value) {
+        object->SetFieldObjectWithoutWriteBarrier</*kTransactionActive=*/ false,
+                                                  /*kCheckTransaction=*/ true,
+                                                  kVerifyNone>(offset, new_value);
+      }
     }
   }
 
@@ -983,6 +1003,38 @@ class ImageSpace::Loader {
     return true;
   }
 
+  // Prefetches the ranges of `map` recorded in the `working_set_file` written by
+  // `ImageSpace::RecordBootImageWorkingSet()`, in the recorded order. Ranges recorded for
+  // another version of the image are ignored.
+  static void PrefetchWorkingSet(const std::string& working_set_file,
+                                 const ImageHeader& image_header,
+                                 const MemMap& map,
+                                 const char* image_filename) {
+    std::string contents;
+    if (!android::base::ReadFileToString(working_set_file, &contents)) {
+      return;  // Not recorded yet.
+    }
+    ScopedTrace trace("Prefetch boot image working set");
+    std::string name = android::base::Basename(image_filename);
+    std::string checksum = StringPrintf("%08x", image_header.GetImageChecksum());
+    for (const std::string& line : android::base::Split(contents, "\n")) {
+      std::vector<std::string> fields = android::base::Split(line, " ");
+      size_t offset = 0u;
+      size_t size = 0u;
+      if (fields.size() != 4u ||
+          fields[0] != name ||
+          fields[1] != checksum ||
+          !android::base::ParseUint(fields[2], &offset) ||
+          !android::base::ParseUint(fields[3], &size) ||
+          offset >= map.Size()) {
+        continue;
+      }
+      size = std::min(size, map.Size() - offset);
+      Runtime::MadviseFileForRange(
+          size, size, map.Begin() + offset, map.Begin() + offset + size, image_filename);
+    }
+  }
+
   static MemMap LoadImageFile(const char* image_filename,
                               const char* image_location,
                               const ImageHeader& image_header,
@@ -1019,6 +1071,9 @@ class ImageSpace::Loader {
       if (map.IsValid()) {
         Runtime::MadviseFileForRange(
             madvise_size_limit, map.Size(), map.Begin(), map.End(), image_filename);
+        if (runtime != nullptr && !runtime->GetBootImageWorkingSet().empty()) {
+          PrefetchWorkingSet(runtime->GetBootImageWorkingSet(), image_header, map, image_filename);
+        }
       }
       return map;
     }
@@ -1059,28 +1114,64 @@ class ImageSpace::Loader {
         const uint64_t start = NanoTime();
         Thread* const self = Thread::Current();
         static constexpr size_t kMinBlocks = 2u;
-        const bool use_parallel = pool != nullptr && image_header.GetBlockCount() >= kMinBlocks;
-        bool failed_decompression = false;
-        for (const ImageHeader::Block& block : image_header.GetBlocks(temp_map.Begin())) {
-          auto function = [&](Thread*) {
-            const uint64_t start2 = NanoTime();
-            ScopedTrace trace("LZ4 decompress block");
-            bool result = block.Decompress(/*out_ptr=*/map.Begin(),
-                                           /*in_ptr=*/temp_map.Begin(),
-                                           error_msg);
-            if (!result) {
-              failed_decompression = true;
-              if (error_msg != nullptr) {
-                *error_msg = "Failed to decompress image block " + *error_msg;
-              }
+        IterationRange<const ImageHeader::Block*> blocks =
+            image_header.GetBlocks(temp_map.Begin());
+        const size_t num_blocks = image_header.GetBlockCount();
+        // The runtime thread pool is only created after `Runtime::Init()`, so the boot image
+        // loaded during startup cannot use it. Block decompression does not touch any runtime
+        // state, so use short-lived native helper threads for it instead.
+        static constexpr size_t kMaxStartupHelpers = 3u;
+        const size_t num_startup_helpers =
+            (pool == nullptr && num_blocks >= kMinBlocks)
+                ? std::min({kMaxStartupHelpers,
+                            num_blocks - 1u,
+                            static_cast<size_t>(std::thread::hardware_concurrency()) - 1u})
+                : 0u;
+        const bool use_parallel = pool != nullptr && num_blocks >= kMinBlocks;
+        std::atomic<bool> failed_decompression(false);
+        std::mutex error_lock;
+        auto decompress = [&](const ImageHeader::Block& block) {
+          const uint64_t start2 = NanoTime();
+          ScopedTrace trace("LZ4 decompress block");
+          std::string block_error_msg;
+          bool result = block.Decompress(/*out_ptr=*/map.Begin(),
+                                         /*in_ptr=*/temp_map.Begin(),
+                                         &block_error_msg);
+          if (!result) {
+            std::lock_guard<std::mutex> lock(error_lock);
+            if (!failed_decompression.exchange(true) && error_msg != nullptr) {
+              *error_msg = "Failed to decompress image block " + block_error_msg;
+            }
+          }
+          VLOG(image) << "Decompress block " << block.GetDataSize() << " -> "
+                      << block.GetImageSize() << " in " << PrettyDuration(NanoTime() - start2);
+        };
+        if (num_startup_helpers != 0u) {
+          std::atomic<size_t> next_block(0u);
+          auto claim_blocks = [&]() {
+            for (size_t i = next_block.fetch_add(1u, std::memory_order_relaxed);
+                 i < num_blocks;
+                 i = next_block.fetch_add(1u, std::memory_order_relaxed)) {
+              decompress(blocks.begin()[i]);
             }
-            VLOG(image) << "Decompress block " << block.GetDataSize() << " -> "
-                        << block.GetImageSize() << " in " << PrettyDuration(NanoTime() - start2);
           };
-          if (use_parallel) {
-            pool->AddTask(self, new FunctionTask(std::move(function)));
-          } else {
-            function(self);
+          std::vector<std::thread> helpers;
+          helpers.reserve(num_startup_helpers);
+          for (size_t i = 0; i != num_startup_helpers; ++i) {
+            helpers.emplace_back(claim_blocks);
+          }
+          claim_blocks();
+          ScopedTrace trace("Waiting for startup helpers");
+          for (std::thread& helper : helpers) {
+            helper.join();
+          }
+        } else {
+          for (const ImageHeader::Block& block : blocks) {
+            if (use_parallel) {
+              pool->AddTask(self, new FunctionTask([&](Thread*) { decompress(block); }));
+            } else {
+              decompress(block);
+            }
           }
         }
         if (use_parallel) {
@@ -3566,6 +3657,106 @@ size_t ImageSpace::GetNumberOfComponents(ArrayRef<ImageSpace* const> image_space
   return n;
 }
 
+size_t ImageSpace::CountPrivateDirtyPages(ArrayRef<ImageSpace* const> image_spaces) {
+  // See https://www.kernel.org/doc/Documentation/vm/pagemap.txt.
+  static constexpr uint64_t kPagePresent = UINT64_C(1) << 63;
+  static constexpr uint64_t kPageFileOrSharedAnon = UINT64_C(1) << 61;
+  static constexpr uint64_t kPageExclusivelyMapped = UINT64_C(1) << 56;
+  android::base::unique_fd pagemap(open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC));
+  if (pagemap == -1) {
+    return 0u;
+  }
+  size_t count = 0u;
+  std::vector<uint64_t> entries;
+  auto count_pages = [&](const uint8_t* begin, const uint8_t* end) {
+    uintptr_t first_page = reinterpret_cast<uintptr_t>(begin) / gPageSize;
+    uintptr_t end_page = RoundUp(reinterpret_cast<uintptr_t>(end), gPageSize) / gPageSize;
+    entries.resize(end_page - first_page);
+    if (entries.empty() ||
+        !android::base::ReadFullyAtOffset(pagemap,
+                                          entries.data(),
+                                          entries.size() * sizeof(uint64_t),
+                                          first_page * sizeof(uint64_t))) {
+      return;
+    }
+    for (uint64_t entry : entries) {
+      if ((entry & (kPagePresent | kPageFileOrSharedAnon | kPageExclusivelyMapped)) ==
+          (kPagePresent | kPageExclusivelyMapped)) {
+        ++count;
+      }
+    }
+  };
+  for (ImageSpace* space : image_spaces) {
+    count_pages(space->GetMemMap()->Begin(), space->GetMemMap()->End());
+    const OatFile* oat_file = space->GetOatFile();
+    if (oat_file != nullptr) {
+      count_pages(oat_file->DataImgRelRoBegin(), oat_file->DataImgRelRoEnd());
+    }
+  }
+  return count;
+}
+
+bool ImageSpace::RecordBootImageWorkingSet(ArrayRef<ImageSpace* const> image_spaces,
+                                           const std::string& file,
+                                           /*out*/ std::string* error_msg) {
+  // See https://www.kernel.org/doc/Documentation/vm/pagemap.txt.
+  static constexpr uint64_t kPagePresent = UINT64_C(1) << 63;
+  android::base::unique_fd pagemap(open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC));
+  if (pagemap == -1) {
+    *error_msg = StringPrintf("Failed to open pagemap: %s", strerror(errno));
+    return false;
+  }
+  // One line per range of used pages: "<image file name> <image checksum> <offset> <size>",
+  // in the order the ranges should be prefetched.
+  std::string contents;
+  std::vector<uint64_t> entries;
+  for (ImageSpace* space : image_spaces) {
+    const ImageHeader& header = space->GetImageHeader();
+    if (header.HasCompressedBlock()) {
+      continue;  // Decompressed into anonymous memory, nothing to prefetch.
+    }
+    size_t num_pages = RoundUp(header.GetImageSize(), gPageSize) / gPageSize;
+    uintptr_t first_page = reinterpret_cast<uintptr_t>(space->Begin()) / gPageSize;
+    entries.resize(num_pages);
+    if (!android::base::ReadFullyAtOffset(pagemap,
+                                          entries.data(),
+                                          entries.size() * sizeof(uint64_t),
+                                          first_page * sizeof(uint64_t))) {
+      *error_msg = StringPrintf("Failed to read pagemap: %s", strerror(errno));
+      return false;
+    }
+    std::string name = android::base::Basename(space->GetImageFilename());
+    for (size_t i = 0; i != num_pages;) {
+      if ((entries[i] & kPagePresent) == 0u) {
+        ++i;
+        continue;
+      }
+      size_t start = i;
+      while (i != num_pages && (entries[i] & kPagePresent) != 0u) {
+        ++i;
+      }
+      contents += StringPrintf("%s %08x %zu %zu\n",
+                               name.c_str(),
+                               header.GetImageChecksum(),
+                               start * gPageSize,
+                               (i - start) * gPageSize);
+    }
+  }
+  // Write to a temporary file first so that a runtime starting concurrently never sees a
+  // partially written working set.
+  std::string temp_file = file + ".tmp";
+  if (!android::base::WriteStringToFile(contents, temp_file)) {
+    *error_msg = StringPrintf("Failed to write %s: %s", temp_file.c_str(), strerror(errno));
+    return false;
+  }
+  if (rename(temp_file.c_str(), file.c_str()) != 0) {
+    *error_msg = StringPrintf("Failed to rename %s: %s", temp_file.c_str(), strerror(errno));
+    unlink(temp_file.c_str());
+    return false;
+  }
+  return true;
+}
+
 size_t ImageSpace::CheckAndCountBCPComponents(std::string_view oat_boot_class_path,
                                          ArrayRef<const std::string> boot_class_path,
                                          /*out*/std::string* error_msg) {
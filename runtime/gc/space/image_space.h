@@ -244,6 +244,18 @@ class ImageSpace : public MemMapSpace {
   // Returns the total number of components (jar files) associated with the image spaces.
   static size_t GetNumberOfComponents(ArrayRef<gc::space::ImageSpace* const> image_spaces);
 
+  // Returns the number of pages of the image spaces and their oat files' .data.img.rel.ro
+  // sections which are privately dirty in this process, i.e. not shared via the page cache
+  // or with the zygote.
+  static size_t CountPrivateDirtyPages(ArrayRef<ImageSpace* const> image_spaces);
+
+  // Writes the ranges of the uncompressed image spaces that are mapped in this process, i.e.
+  // the pages used so far, to `file`. The ranges are prefetched when the images are mapped
+  // again by a runtime started with the same `-Xbootimageworkingset` file.
+  static bool RecordBootImageWorkingSet(ArrayRef<ImageSpace* const> image_spaces,
+                                        const std::string& file,
+                                        /*out*/ std::string* error_msg);
+
   // Returns whether the oat checksums and boot class path description are valid
   // for the given boot image spaces and boot class path. Used for boot image extensions.
   static bool VerifyBootClassPathChecksums(
@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 
+#include "android-base/file.h"
 #include "android-base/logging.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
@@ -388,6 +389,48 @@ TEST_F(ImageSpaceNoDex2oatTest, Test) {
   EXPECT_FALSE(Runtime::Current()->GetHeap()->GetBootImageSpaces().empty());
 }
 
+TEST_F(ImageSpaceNoDex2oatTest, CountPrivateDirtyPages) {
+  ArrayRef<ImageSpace* const> image_spaces(Runtime::Current()->GetHeap()->GetBootImageSpaces());
+  ASSERT_FALSE(image_spaces.empty());
+  size_t total_pages = 0u;
+  for (ImageSpace* space : image_spaces) {
+    total_pages += RoundUp(space->GetMemMap()->Size(), gPageSize) / gPageSize;
+    const OatFile* oat_file = space->GetOatFile();
+    total_pages += RoundUp(oat_file->DataImgRelRoSize(), gPageSize) / gPageSize + 1u;
+  }
+  // The relocation of the boot image writes to the image.
+  size_t dirty_pages = ImageSpace::CountPrivateDirtyPages(image_spaces);
+  EXPECT_NE(dirty_pages, 0u);
+  EXPECT_LE(dirty_pages, total_pages);
+}
+
+TEST_F(ImageSpaceNoDex2oatTest, RecordBootImageWorkingSet) {
+  ArrayRef<ImageSpace* const> image_spaces(Runtime::Current()->GetHeap()->GetBootImageSpaces());
+  ASSERT_FALSE(image_spaces.empty());
+  ScratchDir scratch;
+  std::string working_set = scratch.GetPath() + "boot.workingset";
+  std::string error_msg;
+  ASSERT_TRUE(ImageSpace::RecordBootImageWorkingSet(image_spaces, working_set, &error_msg))
+      << error_msg;
+  std::string contents;
+  ASSERT_TRUE(android::base::ReadFileToString(working_set, &contents));
+  // The image header at least has been used, so each uncompressed image has a range.
+  for (ImageSpace* space : image_spaces) {
+    const ImageHeader& header = space->GetImageHeader();
+    if (header.HasCompressedBlock()) {
+      continue;
+    }
+    std::string prefix = android::base::StringPrintf(
+        "%s %08x 0 ",
+        android::base::Basename(space->GetImageFilename()).c_str(),
+        header.GetImageChecksum());
+    EXPECT_NE(contents.find(prefix), std::string::npos) << prefix << "\n" << contents;
+  }
+  for (const std::string& line : android::base::Split(contents, "\n")) {
+    EXPECT_TRUE(line.empty() || android::base::Split(line, " ").size() == 4u) << line;
+  }
+}
+
 using ImageSpaceNoRelocateNoDex2oatTest =
     ImageSpaceLoadingTest</*kImage=*/true, /*kRelocate=*/false>;
 TEST_F(ImageSpaceNoRelocateNoDex2oatTest, Test) {
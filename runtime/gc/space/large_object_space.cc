@@ -83,6 +83,11 @@ class MemoryToolLargeObjectMapSpace final : public LargeObjectMapSpace {
     return LargeObjectMapSpace::Free(self, object_with_rdz);
   }
 
+  size_t FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) override {
+    // Free one object at a time so that the red zones are accounted for by Free() above.
+    return LargeObjectSpace::FreeList(self, num_ptrs, ptrs);
+  }
+
   bool Contains(const mirror::Object* obj) const override {
     return LargeObjectMapSpace::Contains(ObjectWithRedzone(obj));
   }
@@ -194,7 +199,30 @@ void LargeObjectMapSpace::SetAllLargeObjectsAsZygoteObjects(Thread* self, bool s
 }
 
 size_t LargeObjectMapSpace::Free(Thread* self, mirror::Object* ptr) {
+  // Destroyed, and so unmapped, after lock_ is released.
+  MemMap mem_map;
   MutexLock mu(self, lock_);
+  return RemoveLargeObjectLocked(self, ptr, &mem_map);
+}
+
+size_t LargeObjectMapSpace::FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) {
+  // The memory maps are destroyed, and so unmapped, after lock_ is released so that
+  // allocating threads do not wait for the munmap calls.
+  std::vector<MemMap> mem_maps(num_ptrs);
+  size_t total = 0;
+  MutexLock mu(self, lock_);
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    if (kDebugSpaces) {
+      CHECK(Contains(ptrs[i]));
+    }
+    total += RemoveLargeObjectLocked(self, ptrs[i], &mem_maps[i]);
+  }
+  return total;
+}
+
+size_t LargeObjectMapSpace::RemoveLargeObjectLocked(Thread* self,
+                                                    mirror::Object* ptr,
+                                                    MemMap* mem_map) {
   auto it = large_objects_.find(ptr);
   if (UNLIKELY(it == large_objects_.end())) {
     ScopedObjectAccess soa(self);
@@ -206,6 +234,7 @@ size_t LargeObjectMapSpace::Free(Thread* self, mirror::Object* ptr) {
   size_t allocation_size = map_size;
   num_bytes_allocated_ -= allocation_size;
   --num_objects_allocated_;
+  *mem_map = std::move(it->second.mem_map);
   large_objects_.erase(it);
   return allocation_size;
 }
@@ -466,13 +495,59 @@ size_t FreeListSpace::Free(Thread* self, mirror::Object* obj) {
   DCHECK_ALIGNED_PARAM(allocation_size, ObjectAlignment());
 
   // madvise the pages without lock
-  madvise(obj, allocation_size, MADV_DONTNEED);
+  uint8_t* begin = reinterpret_cast<uint8_t*>(obj);
+  ReleaseFreedRange(begin, begin + allocation_size);
+
+  MutexLock mu(self, lock_);
+  FreeLocked(info, allocation_size);
+  return allocation_size;
+}
+
+size_t FreeListSpace::FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) {
+  if (num_ptrs == 0) {
+    return 0;
+  }
+  // Objects swept together are often adjacent, so release their pages a run at a time.
+  // This is done without lock_, the objects are dead and only the GC looks at them.
+  size_t total = 0;
+  uint8_t* run_begin = reinterpret_cast<uint8_t*>(ptrs[0]);
+  uint8_t* run_end = run_begin;
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    DCHECK(Contains(ptrs[i]));
+    DCHECK_ALIGNED_PARAM(ptrs[i], ObjectAlignment());
+    uint8_t* obj = reinterpret_cast<uint8_t*>(ptrs[i]);
+    DCHECK_GE(obj, run_end) << "Large objects to free are not sorted";
+    const AllocationInfo* info = GetAllocationInfoForAddress(reinterpret_cast<uintptr_t>(obj));
+    DCHECK(!info->IsFree());
+    if (obj != run_end) {
+      ReleaseFreedRange(run_begin, run_end);
+      run_begin = obj;
+    }
+    run_end = obj + info->ByteSize();
+    total += info->ByteSize();
+  }
+  ReleaseFreedRange(run_begin, run_end);
+
+  MutexLock mu(self, lock_);
+  for (size_t i = 0; i < num_ptrs; ++i) {
+    AllocationInfo* info = GetAllocationInfoForAddress(reinterpret_cast<uintptr_t>(ptrs[i]));
+    FreeLocked(info, info->ByteSize());
+  }
+  return total;
+}
+
+void FreeListSpace::ReleaseFreedRange(uint8_t* begin, uint8_t* end) {
+  if (begin == end) {
+    return;
+  }
+  madvise(begin, end - begin, MADV_DONTNEED);
   if (kIsDebugBuild) {
     // Can't disallow reads since we use them to find next chunks during coalescing.
-    CheckedCall(mprotect, __FUNCTION__, obj, allocation_size, PROT_READ);
+    CheckedCall(mprotect, __FUNCTION__, begin, end - begin, PROT_READ);
   }
+}
 
-  MutexLock mu(self, lock_);
+void FreeListSpace::FreeLocked(AllocationInfo* info, size_t allocation_size) {
   info->SetByteSize(allocation_size, true);  // Mark as free.
   // Look at the next chunk.
   AllocationInfo* next_info = info->GetNextInfo();
@@ -518,7 +593,6 @@ size_t FreeListSpace::Free(Thread* self, mirror::Object* obj) {
   --num_objects_allocated_;
   DCHECK_LE(allocation_size, num_bytes_allocated_);
   num_bytes_allocated_ -= allocation_size;
-  return allocation_size;
 }
 
 size_t FreeListSpace::AllocationSize(mirror::Object* obj, size_t* usable_size) {
@@ -171,6 +171,9 @@ class LargeObjectMapSpace : public LargeObjectSpace {
                         size_t* usable_size, size_t* bytes_tl_bulk_allocated) override
       REQUIRES(!lock_);
   size_t Free(Thread* self, mirror::Object* ptr) override REQUIRES(!lock_);
+  // Removes all the objects holding lock_ once, and unmaps them after releasing it.
+  size_t FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) override
+      REQUIRES(!lock_);
   void Walk(DlMallocSpace::WalkCallback, void* arg) override REQUIRES(!lock_);
   // TODO: disabling thread safety analysis as this may be called when we already hold lock_.
   bool Contains(const mirror::Object* obj) const override NO_THREAD_SAFETY_ANALYSIS;
@@ -186,6 +189,11 @@ class LargeObjectMapSpace : public LargeObjectSpace {
   explicit LargeObjectMapSpace(const std::string& name);
   virtual ~LargeObjectMapSpace() {}
 
+  // Removes `ptr` from the space and moves its memory map to `mem_map`, so that the caller can
+  // unmap it after releasing lock_. Returns the number of bytes freed.
+  size_t RemoveLargeObjectLocked(Thread* self, mirror::Object* ptr, MemMap* mem_map)
+      REQUIRES(lock_);
+
   bool IsZygoteLargeObject(Thread* self, mirror::Object* obj) const override REQUIRES(!lock_);
   void SetAllLargeObjectsAsZygoteObjects(Thread* self, bool set_mark_bit) override
       REQUIRES(!lock_)
@@ -206,6 +214,10 @@ class FreeListSpace final : public LargeObjectSpace {
                         size_t* usable_size, size_t* bytes_tl_bulk_allocated)
       override REQUIRES(!lock_);
   size_t Free(Thread* self, mirror::Object* obj) override REQUIRES(!lock_);
+  // Releases the pages of runs of adjacent objects with a single madvise each, then returns all
+  // the objects to the free list holding lock_ once. `ptrs` must be sorted by address.
+  size_t FreeList(Thread* self, size_t num_ptrs, mirror::Object** ptrs) override
+      REQUIRES(!lock_);
   void Walk(DlMallocSpace::WalkCallback callback, void* arg) override REQUIRES(!lock_);
   void Dump(std::ostream& os) const override REQUIRES(!lock_);
   void ForEachMemMap(std::function<void(const MemMap&)> func) const override REQUIRES(!lock_);
@@ -229,6 +241,11 @@ class FreeListSpace final : public LargeObjectSpace {
   }
   // Removes header from the free blocks set by finding the corresponding iterator and erasing it.
   void RemoveFreePrev(AllocationInfo* info) REQUIRES(lock_);
+  // Releases the pages of [begin, end), which must only contain freed objects.
+  static void ReleaseFreedRange(uint8_t* begin, uint8_t* end);
+  // Marks the allocation of `allocation_size` bytes at `info` as free and coalesces it with the
+  // neighbouring free blocks. The memory must already have been released.
+  void FreeLocked(AllocationInfo* info, size_t allocation_size) REQUIRES(lock_);
   bool IsZygoteLargeObject(Thread* self, mirror::Object* obj) const override;
   void SetAllLargeObjectsAsZygoteObjects(Thread* self, bool set_mark_bit) override
       REQUIRES(!lock_)
@@ -16,6 +16,8 @@
 
 #include "large_object_space.h"
 
+#include <algorithm>
+
 #include "base/time_utils.h"
 #include "space_test.h"
 
@@ -30,6 +32,7 @@ class LargeObjectSpaceTest : public SpaceTest<CommonRuntimeTest> {
   static constexpr size_t kNumThreads = 10;
   static constexpr size_t kNumIterations = 1000;
   void RaceTest();
+  void FreeListTest();
 };
 
 
@@ -175,6 +178,50 @@ void LargeObjectSpaceTest::RaceTest() {
   }
 }
 
+void LargeObjectSpaceTest::FreeListTest() {
+  Thread* const self = Thread::Current();
+  for (size_t los_type = 0; los_type < 2; ++los_type) {
+    LargeObjectSpace* los = nullptr;
+    if (los_type == 0) {
+      los = space::LargeObjectMapSpace::Create("large object space");
+    } else {
+      los = space::FreeListSpace::Create("large object space", 128 * MB);
+    }
+    static constexpr size_t kNumAllocations = 32;
+    std::vector<mirror::Object*> objects;
+    for (size_t i = 0; i < kNumAllocations; ++i) {
+      size_t allocation_size, bytes_tl_bulk_allocated;
+      mirror::Object* obj = los->Alloc(self, (i % 4 + 1) * 16 * KB, &allocation_size, nullptr,
+                                       &bytes_tl_bulk_allocated);
+      ASSERT_TRUE(obj != nullptr);
+      objects.push_back(obj);
+    }
+    std::sort(objects.begin(), objects.end());
+    // Free runs of adjacent objects, keeping every fifth one live.
+    std::vector<mirror::Object*> to_free;
+    std::vector<mirror::Object*> live;
+    size_t expected_freed = 0;
+    for (size_t i = 0; i < objects.size(); ++i) {
+      if (i % 5 == 0) {
+        live.push_back(objects[i]);
+      } else {
+        to_free.push_back(objects[i]);
+        expected_freed += los->AllocationSize(objects[i], nullptr);
+      }
+    }
+    EXPECT_EQ(los->FreeList(self, to_free.size(), to_free.data()), expected_freed);
+    EXPECT_EQ(los->GetObjectsAllocated(), live.size());
+    for (mirror::Object* obj : live) {
+      // The live objects must still be accessible.
+      memset(obj, 0xAB, 16 * KB);
+    }
+    los->FreeList(self, live.size(), live.data());
+    EXPECT_EQ(0U, los->GetBytesAllocated());
+    EXPECT_EQ(0U, los->GetObjectsAllocated());
+    delete los;
+  }
+}
+
 TEST_F(LargeObjectSpaceTest, LargeObjectTest) {
   LargeObjectTest();
 }
@@ -183,6 +230,10 @@ TEST_F(LargeObjectSpaceTest, RaceTest) {
   RaceTest();
 }
 
+TEST_F(LargeObjectSpaceTest, FreeListTest) {
+  FreeListTest();
+}
+
 }  // namespace space
 }  // namespace gc
 }  // namespace art
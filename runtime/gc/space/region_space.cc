@@ -15,9 +15,17 @@
  */
 #include <deque>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "android-base/file.h"
+#include "android-base/stringprintf.h"
+#include "android-base/strings.h"
 #include "bump_pointer_space-inl.h"
 #include "bump_pointer_space.h"
 #include "base/dumpable.h"
+#include "base/histogram-inl.h"
 #include "base/logging.h"
 #include "gc/accounting/read_barrier_table.h"
 #include "mirror/class-inl.h"
@@ -32,6 +40,16 @@ namespace space {
 // value of the region size, evaculate the region.
 static constexpr uint kEvacuateLivePercentThreshold = 75U;
 
+// Maximum number of live bytes evacuated in a GC cycle from regions selected
+// based on their live bytes. Regions with the least live bytes, and hence the
+// most reclaimable space, are picked first. Newly allocated regions are not
+// accounted for as their live bytes are not known.
+static constexpr size_t kEvacuationCopyBytesBudget = 32 * MB;
+
+// Maximum number of free regions looked at while searching for one last used
+// as a TLAB on the allocating thread's CPU cluster.
+static constexpr size_t kMaxClusterAffinityProbes = 16;
+
 // Whether we protect the unused and cleared regions.
 static constexpr bool kProtectClearedRegions = kIsDebugBuild;
 
@@ -99,6 +117,36 @@ RegionSpace* RegionSpace::Create(
   return new RegionSpace(name, std::move(mem_map), use_generational_cc);
 }
 
+// Map every CPU to a cluster index, based on the value of the given per-CPU
+// sysfs attribute. Returns an empty vector if the attribute is not available
+// for all CPUs, or if all CPUs map to the same cluster.
+static std::vector<uint8_t> ReadCpuClusters(const char* attribute) {
+  std::vector<uint8_t> clusters;
+  const long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+  std::vector<std::string> unique_values;
+  for (long cpu = 0; cpu < num_cpus; ++cpu) {
+    std::string value;
+    std::string path =
+        android::base::StringPrintf("/sys/devices/system/cpu/cpu%ld/%s", cpu, attribute);
+    if (!android::base::ReadFileToString(path, &value)) {
+      return {};
+    }
+    value = android::base::Trim(value);
+    auto iter = std::find(unique_values.begin(), unique_values.end(), value);
+    if (iter == unique_values.end()) {
+      if (unique_values.size() == RegionSpace::kUnknownCluster) {
+        return {};
+      }
+      iter = unique_values.insert(unique_values.end(), value);
+    }
+    clusters.push_back(static_cast<uint8_t>(iter - unique_values.begin()));
+  }
+  if (unique_values.size() <= 1) {
+    return {};
+  }
+  return clusters;
+}
+
 RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_generational_cc)
     : ContinuousMemMapAllocSpace(name,
                                  std::move(mem_map),
@@ -114,10 +162,15 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
       num_non_free_regions_(0U),
       num_evac_regions_(0U),
       max_peak_num_non_free_regions_(0U),
+      live_percent_histogram_("region live percent histogram", 10U, 12U),
+      num_live_percent_evac_regions_(0U),
+      live_percent_evac_bytes_(0U),
+      num_over_budget_regions_(0U),
       non_free_region_index_limit_(0U),
       current_region_(&full_region_),
       evac_region_(nullptr),
-      cyclic_alloc_region_index_(0U) {
+      cyclic_alloc_region_index_(0U),
+      cross_cluster_tlab_handoffs_(0U) {
   CHECK_ALIGNED(mem_map_.Size(), kRegionSize);
   CHECK_ALIGNED(mem_map_.Begin(), kRegionSize);
   DCHECK_GT(num_regions_, 0U);
@@ -128,6 +181,14 @@ RegionSpace::RegionSpace(const std::string& name, MemMap&& mem_map, bool use_gen
   }
   mark_bitmap_ =
       accounting::ContinuousSpaceBitmap::Create("region space live bitmap", Begin(), Capacity());
+  if (kClusterAwareTlabAllocation) {
+    cpu_clusters_ = ReadCpuClusters("topology/cluster_id");
+    if (cpu_clusters_.empty()) {
+      // Not all kernels report cluster ids. On big.LITTLE systems CPUs in the
+      // same cluster have the same capacity, so use that instead.
+      cpu_clusters_ = ReadCpuClusters("cpu_capacity");
+    }
+  }
   if (kIsDebugBuild) {
     CHECK_EQ(regions_[0].Begin(), Begin());
     for (size_t i = 0; i < num_regions_; ++i) {
@@ -190,10 +251,10 @@ void RegionSpace::Region::SetAsUnevacFromSpace(bool clear_live_bytes) {
   type_ = RegionType::kRegionTypeUnevacFromSpace;
   if (IsNewlyAllocated()) {
     // A newly allocated region set as unevac from-space must be
-    // a large or large tail region.
-    DCHECK(IsLarge() || IsLargeTail()) << static_cast<uint>(state_);
-    // Always clear the live bytes of a newly allocated (large or
-    // large tail) region.
+    // a large or large tail region, or a pinned region.
+    DCHECK(IsLarge() || IsLargeTail() || IsPinned()) << static_cast<uint>(state_);
+    // Always clear the live bytes of a newly allocated (large,
+    // large tail or pinned) region.
     clear_live_bytes = true;
     // Clear the "newly allocated" status here, as we do not want the
     // GC to see it when encountering (and processing) references in the
@@ -232,6 +293,10 @@ inline bool RegionSpace::Region::ShouldBeEvacuated(EvacMode evac_mode) {
     // is live, we would just be moving around region-aligned memory.
     return false;
   }
+  if (UNLIKELY(IsPinned())) {
+    // A JNI critical section holds a raw pointer into the region.
+    return false;
+  }
   if (UNLIKELY(evac_mode == kEvacModeForceAll)) {
     return true;
   }
@@ -332,6 +397,8 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
   const size_t iter_limit = kUseTableLookupReadBarrier
       ? num_regions_
       : std::min(num_regions_, non_free_region_index_limit_);
+  // Candidates beyond the copy-bytes budget, sorted by region index.
+  auto over_budget_iter = PlanLivePercentEvacuation(evac_mode, iter_limit);
   for (size_t i = 0; i < iter_limit; ++i) {
     Region* r = &regions_[i];
     RegionState state = r->State();
@@ -343,6 +410,12 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
                 state == RegionState::kRegionStateLarge) &&
                type == RegionType::kRegionTypeToSpace);
         bool should_evacuate = r->ShouldBeEvacuated(evac_mode);
+        if (should_evacuate &&
+            over_budget_iter != evac_candidates_.end() &&
+            over_budget_iter->second == i) {
+          should_evacuate = false;
+          ++over_budget_iter;
+        }
         bool is_newly_allocated = r->IsNewlyAllocated();
         if (should_evacuate) {
           r->SetAsFromSpace();
@@ -351,6 +424,17 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
           r->SetAsUnevacFromSpace(clear_live_bytes);
           DCHECK(r->IsInUnevacFromSpace());
         }
+        if (UNLIKELY(state == RegionState::kRegionStateAllocated &&
+                     use_generational_cc_ &&
+                     !should_evacuate &&
+                     is_newly_allocated)) {
+          // A pinned newly allocated region. As for newly allocated large regions below,
+          // clear mark-bits set by the marking phase of a 2-phase full heap GC so that the
+          // live bytes get recomputed.
+          DCHECK(r->IsPinned());
+          GetMarkBitmap()->ClearRange(reinterpret_cast<mirror::Object*>(r->Begin()),
+                                      reinterpret_cast<mirror::Object*>(r->End()));
+        }
         if (UNLIKELY(state == RegionState::kRegionStateLarge &&
                      type == RegionType::kRegionTypeToSpace)) {
           prev_large_evacuated = should_evacuate;
@@ -389,10 +473,56 @@ void RegionSpace::SetFromSpace(accounting::ReadBarrierTable* rb_table,
     DCHECK(!r->is_newly_allocated_);
   }
   DCHECK_EQ(num_expected_large_tails, 0U);
+  DCHECK(over_budget_iter == evac_candidates_.end());
   current_region_ = &full_region_;
   evac_region_ = &full_region_;
 }
 
+std::vector<std::pair<size_t, size_t>>::iterator RegionSpace::PlanLivePercentEvacuation(
+    EvacMode evac_mode, size_t iter_limit) {
+  evac_candidates_.clear();
+  if (evac_mode != kEvacModeLivePercentNewlyAllocated) {
+    return evac_candidates_.end();
+  }
+  for (size_t i = 0; i < iter_limit; ++i) {
+    Region* r = &regions_[i];
+    if (!r->IsAllocated() || r->IsNewlyAllocated()) {
+      continue;
+    }
+    const size_t live_bytes = r->LiveBytes();
+    const size_t bytes_allocated = RoundUp(r->BytesAllocated(), kRegionSize);
+    if (live_bytes == static_cast<size_t>(-1) || bytes_allocated == 0) {
+      continue;
+    }
+    live_percent_histogram_.AddValue(live_bytes * 100U / bytes_allocated);
+    if (r->ShouldBeEvacuated(evac_mode)) {
+      evac_candidates_.emplace_back(live_bytes, i);
+    }
+  }
+  // Evacuating a region frees up its dead bytes at the cost of copying its live
+  // bytes. So prefer the regions with the least live bytes.
+  std::sort(evac_candidates_.begin(), evac_candidates_.end());
+  size_t copy_bytes = 0;
+  auto iter = evac_candidates_.begin();
+  for (; iter != evac_candidates_.end(); ++iter) {
+    if (copy_bytes + iter->first > kEvacuationCopyBytesBudget) {
+      break;
+    }
+    copy_bytes += iter->first;
+  }
+  num_live_percent_evac_regions_ += iter - evac_candidates_.begin();
+  live_percent_evac_bytes_ += copy_bytes;
+  num_over_budget_regions_ += evac_candidates_.end() - iter;
+  // The remaining candidates are not evacuated. Sort them by region index so
+  // that the caller can look them up while iterating over the regions.
+  std::sort(iter,
+            evac_candidates_.end(),
+            [](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) {
+              return a.second < b.second;
+            });
+  return iter;
+}
+
 static void ZeroAndProtectRegion(uint8_t* begin, uint8_t* end, bool release_eagerly) {
   ZeroMemory(begin, end - begin, release_eagerly);
   if (kProtectClearedRegions) {
@@ -849,6 +979,21 @@ void RegionSpace::DumpNonFreeRegions(std::ostream& os) {
   }
 }
 
+void RegionSpace::DumpStats(std::ostream& os) {
+  MutexLock mu(Thread::Current(), region_lock_);
+  if (live_percent_histogram_.SampleSize() > 0U) {
+    os << "Histogram of region live bytes percentage: ";
+    live_percent_histogram_.DumpBins(os);
+    os << "\n";
+  }
+  os << "Regions evacuated based on live bytes: " << num_live_percent_evac_regions_
+     << " live bytes copied: " << PrettySize(live_percent_evac_bytes_)
+     << " skipped due to copy budget: " << num_over_budget_regions_ << "\n";
+  if (!cpu_clusters_.empty()) {
+    os << "Cross-cluster TLAB handoffs: " << cross_cluster_tlab_handoffs_ << "\n";
+  }
+}
+
 void RegionSpace::RecordAlloc(mirror::Object* ref) {
   CHECK(ref != nullptr);
   Region* r = RefToRegion(ref);
@@ -858,6 +1003,7 @@ void RegionSpace::RecordAlloc(mirror::Object* ref) {
 bool RegionSpace::AllocNewTlab(Thread* self,
                                const size_t tlab_size,
                                size_t* bytes_tl_bulk_allocated) {
+  const uint8_t cluster = GetCurrentCpuCluster();
   MutexLock mu(self, region_lock_);
   RevokeThreadLocalBuffersLocked(self, /*reuse=*/ gc::Heap::kUsePartialTlabs);
   Region* r = nullptr;
@@ -880,9 +1026,15 @@ bool RegionSpace::AllocNewTlab(Thread* self,
   }
   if (r == nullptr) {
     // Fallback to allocating an entire region as TLAB.
-    r = AllocateRegion(/*for_evac=*/ false);
+    r = AllocateRegion(/*for_evac=*/ false, cluster);
   }
   if (r != nullptr) {
+    if (cluster != kUnknownCluster) {
+      if (r->last_tlab_cluster_ != kUnknownCluster && r->last_tlab_cluster_ != cluster) {
+        ++cross_cluster_tlab_handoffs_;
+      }
+      r->last_tlab_cluster_ = cluster;
+    }
     uint8_t* start = pos != nullptr ? pos : r->Begin();
     DCHECK_ALIGNED(start, kObjectAlignment);
     r->is_a_tlab_ = true;
@@ -1019,6 +1171,7 @@ size_t RegionSpace::AllocationSizeNonvirtual(mirror::Object* obj, size_t* usable
 }
 
 void RegionSpace::Region::Clear(bool zero_and_release_pages) {
+  DCHECK(!IsPinned());
   top_.store(begin_, std::memory_order_relaxed);
   state_ = RegionState::kRegionStateFree;
   type_ = RegionType::kRegionTypeNone;
@@ -1047,33 +1200,73 @@ RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac) {
     // allocate a region starting from the last cyclic allocated
     // region marker. Otherwise, try to allocate a region starting
     // from the beginning of the region space.
+    size_t region_index = kCyclicRegionAllocation
+        ? ((cyclic_alloc_region_index_ + i) % num_regions_)
+        : i;
+    if (regions_[region_index].IsFree()) {
+      return ClaimFreeRegion(region_index, for_evac);
+    }
+  }
+  return nullptr;
+}
+
+RegionSpace::Region* RegionSpace::AllocateRegion(bool for_evac, uint8_t preferred_cluster) {
+  if (preferred_cluster == kUnknownCluster ||
+      (!for_evac && (num_non_free_regions_ + 1) * 2 > num_regions_)) {
+    return AllocateRegion(for_evac);
+  }
+  // Look at the first few free regions, in the same order as
+  // AllocateRegion(bool), for one last used on `preferred_cluster`.
+  size_t probes = 0;
+  for (size_t i = 0; i < num_regions_ && probes < kMaxClusterAffinityProbes; ++i) {
     size_t region_index = kCyclicRegionAllocation
         ? ((cyclic_alloc_region_index_ + i) % num_regions_)
         : i;
     Region* r = &regions_[region_index];
     if (r->IsFree()) {
-      r->Unfree(this, time_);
-      if (use_generational_cc_) {
-        // TODO: Add an explanation for this assertion.
-        DCHECK_IMPLIES(for_evac, !r->is_newly_allocated_);
+      if (r->last_tlab_cluster_ == preferred_cluster) {
+        return ClaimFreeRegion(region_index, for_evac);
       }
-      if (for_evac) {
-        ++num_evac_regions_;
-        TraceHeapSize();
-        // Evac doesn't count as newly allocated.
-      } else {
-        r->SetNewlyAllocated();
-        ++num_non_free_regions_;
-      }
-      if (kCyclicRegionAllocation) {
-        // Move the cyclic allocation region marker to the region
-        // following the one that was just allocated.
-        cyclic_alloc_region_index_ = (region_index + 1) % num_regions_;
-      }
-      return r;
+      ++probes;
     }
   }
-  return nullptr;
+  return AllocateRegion(for_evac);
+}
+
+RegionSpace::Region* RegionSpace::ClaimFreeRegion(size_t region_index, bool for_evac) {
+  Region* r = &regions_[region_index];
+  DCHECK(r->IsFree());
+  r->Unfree(this, time_);
+  if (use_generational_cc_) {
+    // TODO: Add an explanation for this assertion.
+    DCHECK_IMPLIES(for_evac, !r->is_newly_allocated_);
+  }
+  if (for_evac) {
+    ++num_evac_regions_;
+    TraceHeapSize();
+    // Evac doesn't count as newly allocated.
+  } else {
+    r->SetNewlyAllocated();
+    ++num_non_free_regions_;
+  }
+  if (kCyclicRegionAllocation) {
+    // Move the cyclic allocation region marker to the region
+    // following the one that was just allocated.
+    cyclic_alloc_region_index_ = (region_index + 1) % num_regions_;
+  }
+  return r;
+}
+
+uint8_t RegionSpace::GetCurrentCpuCluster() const {
+#if defined(__linux__)
+  if (kClusterAwareTlabAllocation && !cpu_clusters_.empty()) {
+    int cpu = sched_getcpu();
+    if (cpu >= 0 && static_cast<size_t>(cpu) < cpu_clusters_.size()) {
+      return cpu_clusters_[cpu];
+    }
+  }
+#endif
+  return kUnknownCluster;
 }
 
 void RegionSpace::Region::MarkAsAllocated(RegionSpace* region_space, uint32_t alloc_time) {
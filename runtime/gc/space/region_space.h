@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_GC_SPACE_REGION_SPACE_H_
 #define ART_RUNTIME_GC_SPACE_REGION_SPACE_H_
 
+#include "base/histogram.h"
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "space.h"
@@ -24,6 +25,8 @@
 
 #include <functional>
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace art HIDDEN {
 namespace gc {
@@ -43,6 +46,12 @@ namespace space {
 // only enable it in debug mode.
 static constexpr bool kCyclicRegionAllocation = kIsDebugBuild;
 
+// Cluster-aware TLAB allocation. If `true`, a thread allocating a new TLAB
+// region prefers a free region which was last used as a TLAB by a thread
+// running on the same CPU cluster, as its contents are more likely to still be
+// in that cluster's caches. Has no effect on single-cluster systems.
+static constexpr bool kClusterAwareTlabAllocation = true;
+
 // A space that consists of equal-sized regions.
 class RegionSpace final : public ContinuousMemMapAllocSpace {
  public:
@@ -142,6 +151,9 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // Dump region containing object `obj`. Precondition: `obj` is in the region space.
   void DumpRegionForObject(std::ostream& os, mirror::Object* obj) REQUIRES(!region_lock_);
   EXPORT void DumpNonFreeRegions(std::ostream& os) REQUIRES(!region_lock_);
+  // Dump the cumulative live-bytes histogram and evacuation decisions made in
+  // SetFromSpace(), as well as TLAB allocation stats.
+  void DumpStats(std::ostream& os) REQUIRES(!region_lock_);
 
   EXPORT size_t RevokeThreadLocalBuffers(Thread* thread) override REQUIRES(!region_lock_);
   size_t RevokeThreadLocalBuffers(Thread* thread, const bool reuse) REQUIRES(!region_lock_);
@@ -234,6 +246,8 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   static constexpr size_t kAlignment = kObjectAlignment;
   // The region size.
   static constexpr size_t kRegionSize = 256 * KB;
+  // Cluster value used when the CPU cluster is not known.
+  static constexpr uint8_t kUnknownCluster = 0xFF;
 
   bool IsInFromSpace(mirror::Object* ref) {
     if (HasAddress(ref)) {
@@ -322,6 +336,22 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     reg->AddLiveBytes(alloc_size);
   }
 
+  // Pin the region containing `ref` so that it is not evacuated by any flip until the
+  // matching `UnpinRegion()`. This lets JNI critical sections hold raw pointers into the
+  // region without blocking the thread flip. The `ref` must be a to-space reference, i.e.
+  // the caller must be runnable and have read `ref` through a read barrier.
+  void PinRegion(mirror::Object* ref) REQUIRES_SHARED(Locks::mutator_lock_) {
+    Region* reg = RefToRegionUnlocked(ref);
+    DCHECK(!reg->IsFree() && !reg->IsInFromSpace());
+    reg->pin_count_.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  void UnpinRegion(mirror::Object* ref) REQUIRES_SHARED(Locks::mutator_lock_) {
+    Region* reg = RefToRegionUnlocked(ref);
+    uint32_t old_count = reg->pin_count_.fetch_sub(1u, std::memory_order_relaxed);
+    DCHECK_NE(old_count, 0u);
+  }
+
   void AssertAllRegionLiveBytesZeroOrCleared() REQUIRES(!region_lock_) {
     if (kIsDebugBuild) {
       MutexLock mu(Thread::Current(), region_lock_);
@@ -401,8 +431,10 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
           end_(nullptr),
           objects_allocated_(0),
           alloc_time_(0),
+          pin_count_(0),
           is_newly_allocated_(false),
           is_a_tlab_(false),
+          last_tlab_cluster_(kUnknownCluster),
           state_(RegionState::kRegionStateAllocated),
           type_(RegionType::kRegionTypeToSpace) {}
 
@@ -415,6 +447,7 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       type_ = RegionType::kRegionTypeNone;
       objects_allocated_.store(0, std::memory_order_relaxed);
       alloc_time_ = 0;
+      pin_count_.store(0, std::memory_order_relaxed);
       live_bytes_ = static_cast<size_t>(-1);
       is_newly_allocated_ = false;
       is_a_tlab_ = false;
@@ -506,6 +539,11 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
       return is_a_tlab_;
     }
 
+    // A pinned region is never evacuated, see `RegionSpace::PinRegion()`.
+    bool IsPinned() const {
+      return pin_count_.load(std::memory_order_relaxed) != 0u;
+    }
+
     bool IsInFromSpace() const {
       return type_ == RegionType::kRegionTypeFromSpace;
     }
@@ -635,10 +673,15 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
     // are concurrent updates.
     Atomic<size_t> objects_allocated_;  // The number of objects allocated.
     uint32_t alloc_time_;               // The allocation time of the region.
+    // The number of JNI critical sections holding a raw pointer into the region.
+    Atomic<uint32_t> pin_count_;
     // Note that newly allocated and evacuated regions use -1 as
     // special value for `live_bytes_`.
     bool is_newly_allocated_;           // True if it's allocated after the last collection.
     bool is_a_tlab_;                    // True if it's a tlab.
+    // The CPU cluster of the thread which last used the region as a TLAB.
+    // Retained when the region is freed.
+    uint8_t last_tlab_cluster_;
     RegionState state_;                 // The region state (see RegionState).
     RegionType type_;                   // The region type (see RegionType).
 
@@ -716,6 +759,14 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   }
 
   EXPORT Region* AllocateRegion(bool for_evac) REQUIRES(region_lock_);
+  // Same as above, but prefer a free region last used as a TLAB on the given
+  // CPU cluster, if one is found within a bounded number of probes.
+  Region* AllocateRegion(bool for_evac, uint8_t preferred_cluster) REQUIRES(region_lock_);
+  // Turn the free region at `region_index` into an allocated one.
+  Region* ClaimFreeRegion(size_t region_index, bool for_evac) REQUIRES(region_lock_);
+  // Return the cluster of the CPU the calling thread is running on, or
+  // kUnknownCluster if cluster-aware allocation is not in use.
+  uint8_t GetCurrentCpuCluster() const;
   void RevokeThreadLocalBuffersLocked(Thread* thread, bool reuse) REQUIRES(region_lock_);
 
   // Scan region range [`begin`, `end`) in increasing order to try to
@@ -735,6 +786,14 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
                                     /* out */ size_t* bytes_tl_bulk_allocated,
                                     /* out */ size_t* next_region = nullptr) REQUIRES(region_lock_);
 
+  // Select the regions to be evacuated based on their live bytes, within the
+  // copy-bytes budget, and record the live-bytes histogram. Returns the
+  // beginning of the qualifying regions in evac_candidates_ which couldn't fit
+  // in the budget, sorted by region index.
+  std::vector<std::pair<size_t, size_t>>::iterator PlanLivePercentEvacuation(EvacMode evac_mode,
+                                                                            size_t iter_limit)
+      REQUIRES(region_lock_);
+
   // Check that the value of `r->LiveBytes()` matches the number of
   // (allocated) bytes used by live objects according to the live bits
   // in the region space bitmap range corresponding to region `r`.
@@ -769,6 +828,19 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // To hold partially used TLABs which can be reassigned to threads later for
   // utilizing the un-used portion.
   std::multimap<size_t, Region*, std::greater<size_t>> partial_tlabs_ GUARDED_BY(region_lock_);
+  // <live-bytes, region-index> pairs of the regions qualifying for evacuation
+  // based on their live bytes. Only used within SetFromSpace(); kept as a
+  // member to avoid allocating it in every GC cycle.
+  std::vector<std::pair<size_t, size_t>> evac_candidates_ GUARDED_BY(region_lock_);
+  // Histogram of live-bytes percentage of regions with valid live bytes, as
+  // seen by SetFromSpace(), across all GC cycles.
+  Histogram<uint64_t> live_percent_histogram_ GUARDED_BY(region_lock_);
+  // Cumulative number of regions evacuated based on their live bytes, the
+  // live bytes in them, and the number of qualifying regions which were not
+  // evacuated because the copy-bytes budget was exhausted.
+  uint64_t num_live_percent_evac_regions_ GUARDED_BY(region_lock_);
+  uint64_t live_percent_evac_bytes_ GUARDED_BY(region_lock_);
+  uint64_t num_over_budget_regions_ GUARDED_BY(region_lock_);
   // The upper-bound index of the non-free regions. Used to avoid scanning all regions in
   // RegionSpace::SetFromSpace and RegionSpace::ClearFromSpace.
   //
@@ -788,6 +860,13 @@ class RegionSpace final : public ContinuousMemMapAllocSpace {
   // Mark bitmap used by the GC.
   accounting::ContinuousSpaceBitmap mark_bitmap_;
 
+  // CPU index to cluster mapping. Empty in case of a single cluster, or if the
+  // topology couldn't be determined.
+  std::vector<uint8_t> cpu_clusters_;
+  // Number of TLABs handed to a thread running on a different cluster than
+  // the one on which the region was last used as a TLAB.
+  uint64_t cross_cluster_tlab_handoffs_ GUARDED_BY(region_lock_);
+
   DISALLOW_COPY_AND_ASSIGN(RegionSpace);
 };
 
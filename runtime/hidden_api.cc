@@ -239,6 +239,47 @@ hiddenapi::AccessContext GetReflectionCallerAccessContext(Thread* self)
   return caller.IsNull() ? AccessContext(/* is_trusted= */ true) : AccessContext(caller);
 }
 
+AccessDecisionCache::AccessDecisionCache() : epoch_(0u) {
+  for (std::atomic<uint64_t>& entry : entries_) {
+    entry.store(0u, std::memory_order_relaxed);
+  }
+}
+
+bool AccessDecisionCache::Lookup(const void* member, /*out*/ Decision* decision) const {
+  uint64_t member_bits = reinterpret_cast<uintptr_t>(member);
+  uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+  uint64_t entry = entries_[GetIndex(member_bits)].load(std::memory_order_relaxed);
+  if ((entry & ~kDecisionMask) != ((epoch << kEpochShift) | member_bits)) {
+    return false;
+  }
+  *decision = static_cast<Decision>(entry & kDecisionMask);
+  return true;
+}
+
+void AccessDecisionCache::Store(const void* member, Decision decision) {
+  DCHECK_ALIGNED(member, alignof(uint32_t));
+  uint64_t member_bits = reinterpret_cast<uintptr_t>(member);
+  if ((member_bits >> kEpochShift) != 0u) {
+    // Tagged pointers do not leave room for the epoch. Do not cache.
+    return;
+  }
+  uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+  entries_[GetIndex(member_bits)].store(
+      (epoch << kEpochShift) | member_bits | static_cast<uint64_t>(decision),
+      std::memory_order_relaxed);
+}
+
+void AccessDecisionCache::Invalidate() {
+  uint32_t epoch = (epoch_.load(std::memory_order_relaxed) + 1u) & kEpochMask;
+  if (epoch == 0u) {
+    // The epoch wrapped around. Clear the entries so that old ones cannot become valid again.
+    for (std::atomic<uint64_t>& entry : entries_) {
+      entry.store(0u, std::memory_order_relaxed);
+    }
+  }
+  epoch_.store(epoch, std::memory_order_relaxed);
+}
+
 namespace detail {
 
 // Do not change the values of items in this enum, as they are written to the
@@ -573,11 +614,41 @@ bool HandleCorePlatformApiViolation(T* member,
   return policy == EnforcementPolicy::kEnabled;
 }
 
+// Returns whether `MemberSignature::NotifyHiddenApiListener()` would call back into managed code.
+static bool HasHiddenApiListener(Runtime* runtime, AccessMethod access_method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  if (access_method != AccessMethod::kReflection && access_method != AccessMethod::kJNI) {
+    return false;
+  }
+  if (runtime->IsAotCompiler()) {
+    return false;
+  }
+  ArtField* consumer_field = WellKnownClasses::dalvik_system_VMRuntime_nonSdkApiUsageConsumer;
+  return consumer_field->GetObject(consumer_field->GetDeclaringClass()) != nullptr;
+}
+
+// Returns whether this access should be reported to the event log and, if so, the sampled value
+// to report with it.
+static bool ShouldSampleAccessToEventLog(Runtime* runtime, /*out*/ uint32_t* sampled_value) {
+  // If event log sampling is enabled, report this violation.
+  if (kIsTargetBuild && !kIsTargetLinux) {
+    uint32_t eventLogSampleRate = runtime->GetHiddenApiEventLogSampleRate();
+    // Assert that RAND_MAX is big enough, to ensure sampling below works as expected.
+    static_assert(RAND_MAX >= 0xffff, "RAND_MAX too small");
+    if (eventLogSampleRate != 0) {
+      *sampled_value = static_cast<uint32_t>(std::rand()) & 0xffff;
+      return *sampled_value <= eventLogSampleRate;
+    }
+  }
+  return false;
+}
+
 template <typename T>
 bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod access_method) {
   DCHECK(member != nullptr);
   Runtime* runtime = Runtime::Current();
   CompatFramework& compatFramework = runtime->GetCompatFramework();
+  AccessDecisionCache* decision_cache = runtime->GetHiddenApiDecisionCache();
 
   EnforcementPolicy hiddenApiPolicy = runtime->GetHiddenApiEnforcementPolicy();
   DCHECK(hiddenApiPolicy != EnforcementPolicy::kDisabled)
@@ -591,6 +662,7 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
     // Note this results in no warning for the member, which seems like what one would expect.
     // Exemptions effectively adds new members to the public API list.
     MaybeUpdateAccessFlags(runtime, member, kAccPublicApi);
+    decision_cache->Store(member, AccessDecisionCache::Decision::kExempt);
     return false;
   }
 
@@ -616,9 +688,15 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
     }
   }
 
+  // Warn if blocked signature is being accessed or it is not exempted.
+  bool report_access = deny_access || !member_signature.DoesPrefixMatchAny(kWarningExemptions);
+  decision_cache->Store(member,
+                        deny_access ? AccessDecisionCache::Decision::kDeny :
+                        report_access ? AccessDecisionCache::Decision::kAllow :
+                                        AccessDecisionCache::Decision::kAllowWarningExempt);
+
   if (access_method != AccessMethod::kNone) {
-    // Warn if blocked signature is being accessed or it is not exempted.
-    if (deny_access || !member_signature.DoesPrefixMatchAny(kWarningExemptions)) {
+    if (report_access) {
       // Print a log message with information about this class member access.
       // We do this if we're about to deny access, or the app is debuggable.
       if (kLogAllAccesses || deny_access || runtime->IsJavaDebuggable()) {
@@ -629,17 +707,9 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
       member_signature.NotifyHiddenApiListener(access_method);
     }
 
-    // If event log sampling is enabled, report this violation.
-    if (kIsTargetBuild && !kIsTargetLinux) {
-      uint32_t eventLogSampleRate = runtime->GetHiddenApiEventLogSampleRate();
-      // Assert that RAND_MAX is big enough, to ensure sampling below works as expected.
-      static_assert(RAND_MAX >= 0xffff, "RAND_MAX too small");
-      if (eventLogSampleRate != 0) {
-        const uint32_t sampled_value = static_cast<uint32_t>(std::rand()) & 0xffff;
-        if (sampled_value <= eventLogSampleRate) {
-          member_signature.LogAccessToEventLog(sampled_value, access_method, deny_access);
-        }
-      }
+    uint32_t sampled_value;
+    if (ShouldSampleAccessToEventLog(runtime, &sampled_value)) {
+      member_signature.LogAccessToEventLog(sampled_value, access_method, deny_access);
     }
 
     // If this access was not denied, flag member as SDK and skip
@@ -653,6 +723,43 @@ bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod acce
   return deny_access;
 }
 
+template <typename T>
+bool ShouldDenyAccessToMemberCached(T* member,
+                                    AccessDecisionCache::Decision decision,
+                                    AccessMethod access_method) {
+  DCHECK(member != nullptr);
+  bool deny_access = (decision == AccessDecisionCache::Decision::kDeny);
+  if (access_method == AccessMethod::kNone || decision == AccessDecisionCache::Decision::kExempt) {
+    return deny_access;
+  }
+
+  // Perform the side effects of `ShouldDenyAccessToMemberImpl()` for this access. The member
+  // signature is only built if one of them needs it.
+  Runtime* runtime = Runtime::Current();
+  bool report_access = (decision != AccessDecisionCache::Decision::kAllowWarningExempt);
+  bool warn = report_access && (kLogAllAccesses || deny_access || runtime->IsJavaDebuggable());
+  bool notify = report_access && HasHiddenApiListener(runtime, access_method);
+  uint32_t sampled_value;
+  bool log_event = ShouldSampleAccessToEventLog(runtime, &sampled_value);
+  if (warn || notify || log_event) {
+    MemberSignature member_signature(member);
+    if (warn) {
+      member_signature.WarnAboutAccess(access_method, ApiList(GetDexFlags(member)), deny_access);
+    }
+    if (notify) {
+      member_signature.NotifyHiddenApiListener(access_method);
+    }
+    if (log_event) {
+      member_signature.LogAccessToEventLog(sampled_value, access_method, deny_access);
+    }
+  }
+
+  if (!deny_access && runtime->IsJavaDebuggable()) {
+    MaybeUpdateAccessFlags(runtime, member, kAccPublicApi);
+  }
+  return deny_access;
+}
+
 // Need to instantiate these.
 template uint32_t GetDexFlags<ArtField>(ArtField* member);
 template uint32_t GetDexFlags<ArtMethod>(ArtMethod* member);
@@ -670,6 +777,12 @@ template bool ShouldDenyAccessToMemberImpl<ArtField>(ArtField* member,
 template bool ShouldDenyAccessToMemberImpl<ArtMethod>(ArtMethod* member,
                                                       ApiList api_list,
                                                       AccessMethod access_method);
+template bool ShouldDenyAccessToMemberCached<ArtField>(ArtField* member,
+                                                       AccessDecisionCache::Decision decision,
+                                                       AccessMethod access_method);
+template bool ShouldDenyAccessToMemberCached<ArtMethod>(ArtMethod* member,
+                                                        AccessDecisionCache::Decision decision,
+                                                        AccessMethod access_method);
 }  // namespace detail
 
 template <typename T>
@@ -735,6 +848,12 @@ bool ShouldDenyAccessToMember(T* member,
       // If this is a proxy method, look at the interface method instead.
       member = detail::GetInterfaceMemberIfProxy(member);
 
+      // Reuse the decision taken by an earlier check of `member` under the same policy.
+      AccessDecisionCache::Decision decision;
+      if (runtime->GetHiddenApiDecisionCache()->Lookup(member, &decision)) {
+        return detail::ShouldDenyAccessToMemberCached(member, decision, access_method);
+      }
+
       // Decode hidden API access flags from the dex file.
       // This is an O(N) operation scaling with the number of fields/methods
       // in the class. Only do this on slow path and only do it once.
@@ -17,6 +17,8 @@
 #ifndef ART_RUNTIME_HIDDEN_API_H_
 #define ART_RUNTIME_HIDDEN_API_H_
 
+#include <atomic>
+
 #include "art_field.h"
 #include "art_method.h"
 #include "base/hiddenapi_domain.h"
@@ -160,6 +162,54 @@ class ScopedHiddenApiEnforcementPolicySetting {
   DISALLOW_COPY_AND_ASSIGN(ScopedHiddenApiEnforcementPolicySetting);
 };
 
+// Cache of the decisions taken by the hidden API slow path, indexed by member. A member checked
+// again under the same policy skips the exemption list, compat framework and dex flags lookups.
+// The cache is direct-mapped and lock-free: each entry packs the member pointer, the decision and
+// the epoch at which it was stored into a single word, so racing stores may evict each other but
+// a lookup never returns a decision taken for another member or under an older policy.
+class AccessDecisionCache {
+ public:
+  enum class Decision : uint32_t {
+    // Access is allowed.
+    kAllow = 0u,
+    // Access is denied.
+    kDeny = 1u,
+    // Access is allowed and the member is on the warning exemption list, so accesses are neither
+    // logged nor reported to the listener.
+    kAllowWarningExempt = 2u,
+    // The member is on the hidden API exemption list and is treated as SDK.
+    kExempt = 3u,
+  };
+
+  AccessDecisionCache();
+
+  // Returns true and sets `decision` if a decision for `member` was stored since the last call
+  // to `Invalidate()`.
+  bool Lookup(const void* member, /*out*/ Decision* decision) const;
+
+  // Records `decision` for `member`, possibly evicting the decision of another member.
+  void Store(const void* member, Decision decision);
+
+  // Drops all decisions stored so far.
+  void Invalidate();
+
+ private:
+  static constexpr size_t kNumEntries = 1024u;
+  static constexpr uint64_t kDecisionMask = 3u;
+  // The epoch is stored in the bits above the member pointer.
+  static constexpr size_t kEpochShift = (sizeof(void*) == 8u) ? 48u : 32u;
+  static constexpr uint64_t kEpochMask = (UINT64_C(1) << (64u - kEpochShift)) - 1u;
+
+  static size_t GetIndex(uint64_t member) {
+    return (member / alignof(uint32_t)) % kNumEntries;
+  }
+
+  std::atomic<uint32_t> epoch_;
+  std::atomic<uint64_t> entries_[kNumEntries];
+
+  DISALLOW_COPY_AND_ASSIGN(AccessDecisionCache);
+};
+
 void InitializeCorePlatformApiPrivateFields() REQUIRES(!Locks::mutator_lock_);
 
 // Walks the stack, finds the caller of this reflective call and returns
@@ -233,6 +283,14 @@ template<typename T>
 bool ShouldDenyAccessToMemberImpl(T* member, ApiList api_list, AccessMethod access_method)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
+// Repeats the side effects of an access to `member` for which `ShouldDenyAccessToMemberImpl()`
+// already took `decision`, and returns whether access should be denied.
+template<typename T>
+bool ShouldDenyAccessToMemberCached(T* member,
+                                    AccessDecisionCache::Decision decision,
+                                    AccessMethod access_method)
+    REQUIRES_SHARED(Locks::mutator_lock_);
+
 inline ArtField* GetInterfaceMemberIfProxy(ArtField* field) { return field; }
 
 inline ArtMethod* GetInterfaceMemberIfProxy(ArtMethod* method)
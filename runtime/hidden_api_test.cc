@@ -431,6 +431,40 @@ TEST_F(HiddenApiTest, CheckTestApiEnforcement) {
       ShouldDenyAccess(hiddenapi::ApiList::TestApi() | hiddenapi::ApiList::Blocked()), false);
 }
 
+TEST_F(HiddenApiTest, CheckAccessDecisionCache) {
+  using Decision = hiddenapi::AccessDecisionCache::Decision;
+  hiddenapi::AccessDecisionCache cache;
+  Decision decision;
+
+  ASSERT_FALSE(cache.Lookup(class1_field1_, &decision));
+  cache.Store(class1_field1_, Decision::kDeny);
+  ASSERT_TRUE(cache.Lookup(class1_field1_, &decision));
+  ASSERT_EQ(decision, Decision::kDeny);
+
+  ASSERT_FALSE(cache.Lookup(class1_method1_, &decision));
+  cache.Store(class1_method1_, Decision::kAllowWarningExempt);
+  ASSERT_TRUE(cache.Lookup(class1_method1_, &decision));
+  ASSERT_EQ(decision, Decision::kAllowWarningExempt);
+
+  cache.Invalidate();
+  ASSERT_FALSE(cache.Lookup(class1_field1_, &decision));
+  ASSERT_FALSE(cache.Lookup(class1_method1_, &decision));
+  cache.Store(class1_field1_, Decision::kExempt);
+  ASSERT_TRUE(cache.Lookup(class1_field1_, &decision));
+  ASSERT_EQ(decision, Decision::kExempt);
+
+  // Changing the policy drops the decisions cached by the runtime.
+  hiddenapi::AccessDecisionCache* runtime_cache = runtime_->GetHiddenApiDecisionCache();
+  runtime_cache->Store(class1_field1_, Decision::kAllow);
+  ASSERT_TRUE(runtime_cache->Lookup(class1_field1_, &decision));
+  ASSERT_EQ(decision, Decision::kAllow);
+  runtime_->SetTargetSdkVersion(runtime_->GetTargetSdkVersion());
+  ASSERT_FALSE(runtime_cache->Lookup(class1_field1_, &decision));
+  runtime_cache->Store(class1_field1_, Decision::kAllow);
+  runtime_->SetHiddenApiExemptions({});
+  ASSERT_FALSE(runtime_cache->Lookup(class1_field1_, &decision));
+}
+
 TEST_F(HiddenApiTest, CheckMembersRead) {
   ASSERT_NE(nullptr, class1_field1_);
   ASSERT_NE(nullptr, class1_field12_);
@@ -28,11 +28,14 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <optional>
 #include <set>
 
 #include <android-base/logging.h>
@@ -155,6 +158,25 @@ using HprofStackTraceSerialNumber = uint32_t;
 using HprofStackFrameId = uint32_t;
 static constexpr HprofStackTraceSerialNumber kHprofNullStackTrace = 0;
 
+// Writes `count` values to `out` in big-endian order. The loop has no dependency between
+// iterations, so that the compiler can vectorize the byte swaps of primitive arrays.
+template <typename T>
+static inline void CopyBigEndian(uint8_t* out, const T* values, size_t count) {
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
+  for (size_t i = 0; i < count; ++i) {
+    T value = values[i];
+    if constexpr (sizeof(T) == sizeof(uint16_t)) {
+      value = __builtin_bswap16(value);
+    } else if constexpr (sizeof(T) == sizeof(uint32_t)) {
+      value = __builtin_bswap32(value);
+    } else {
+      static_assert(sizeof(T) == sizeof(uint64_t));
+      value = __builtin_bswap64(value);
+    }
+    memcpy(out + i * sizeof(T), &value, sizeof(T));
+  }
+}
+
 class EndianOutput {
  public:
   EndianOutput() : length_(0), sum_length_(0), max_length_(0), started_(false) {}
@@ -300,10 +322,7 @@ class EndianOutputBuffered : public EndianOutput {
 
   void UpdateU4(size_t offset, uint32_t new_value) override {
     DCHECK_LE(offset, length_ - 4);
-    buffer_[offset + 0] = static_cast<uint8_t>((new_value >> 24) & 0xFF);
-    buffer_[offset + 1] = static_cast<uint8_t>((new_value >> 16) & 0xFF);
-    buffer_[offset + 2] = static_cast<uint8_t>((new_value >> 8)  & 0xFF);
-    buffer_[offset + 3] = static_cast<uint8_t>((new_value >> 0)  & 0xFF);
+    CopyBigEndian(buffer_.data() + offset, &new_value, 1);
   }
 
  protected:
@@ -327,40 +346,20 @@ class EndianOutputBuffered : public EndianOutput {
 
   void HandleU2List(const uint16_t* values, size_t count) override {
     DCHECK_EQ(length_, buffer_.size());
-    for (size_t i = 0; i < count; ++i) {
-      uint16_t value = *values;
-      buffer_.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 0) & 0xFF));
-      values++;
-    }
+    buffer_.resize(length_ + count * sizeof(uint16_t));
+    CopyBigEndian(buffer_.data() + length_, values, count);
   }
 
   void HandleU4List(const uint32_t* values, size_t count) override {
     DCHECK_EQ(length_, buffer_.size());
-    for (size_t i = 0; i < count; ++i) {
-      uint32_t value = *values;
-      buffer_.push_back(static_cast<uint8_t>((value >> 24) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 8)  & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 0)  & 0xFF));
-      values++;
-    }
+    buffer_.resize(length_ + count * sizeof(uint32_t));
+    CopyBigEndian(buffer_.data() + length_, values, count);
   }
 
   void HandleU8List(const uint64_t* values, size_t count) override {
     DCHECK_EQ(length_, buffer_.size());
-    for (size_t i = 0; i < count; ++i) {
-      uint64_t value = *values;
-      buffer_.push_back(static_cast<uint8_t>((value >> 56) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 48) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 40) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 32) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 24) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 8)  & 0xFF));
-      buffer_.push_back(static_cast<uint8_t>((value >> 0)  & 0xFF));
-      values++;
-    }
+    buffer_.resize(length_ + count * sizeof(uint64_t));
+    CopyBigEndian(buffer_.data() + length_, values, count);
   }
 
   void HandleEndRecord() override {
@@ -408,6 +407,82 @@ class FileEndianOutput final : public EndianOutputBuffered {
   bool errors_;
 };
 
+// Writes the dump directly to a shared mapping of the output file, which has been allocated to
+// the size measured by the first pass. This avoids copying each record into a buffer and writing
+// each record with its own system call.
+class MmapEndianOutput final : public EndianOutput {
+ public:
+  MmapEndianOutput(uint8_t* begin, size_t capacity) : begin_(begin), capacity_(capacity) {}
+
+  // Returns true if the dump did not fit in the mapping.
+  bool Errors() const {
+    return errors_;
+  }
+
+  void UpdateU4(size_t offset, uint32_t new_value) override {
+    DCHECK_LE(offset, length_ - 4);
+    if (!errors_) {
+      CopyBigEndian(begin_ + sum_length_ + offset, &new_value, 1);
+    }
+  }
+
+ protected:
+  void HandleU1List(const uint8_t* values, size_t count) override {
+    uint8_t* out = Reserve(count);
+    if (out != nullptr) {
+      memcpy(out, values, count);
+    }
+  }
+
+  void HandleU1AsU2List(const uint8_t* values, size_t count) override {
+    // All 8-bits are grouped in 2 to make 16-bit block like Java Char
+    size_t padding = count & 1;
+    uint8_t* out = Reserve(padding + count);
+    if (out != nullptr) {
+      if (padding != 0) {
+        *out++ = 0;
+      }
+      memcpy(out, values, count);
+    }
+  }
+
+  void HandleU2List(const uint16_t* values, size_t count) override {
+    uint8_t* out = Reserve(count * sizeof(uint16_t));
+    if (out != nullptr) {
+      CopyBigEndian(out, values, count);
+    }
+  }
+
+  void HandleU4List(const uint32_t* values, size_t count) override {
+    uint8_t* out = Reserve(count * sizeof(uint32_t));
+    if (out != nullptr) {
+      CopyBigEndian(out, values, count);
+    }
+  }
+
+  void HandleU8List(const uint64_t* values, size_t count) override {
+    uint8_t* out = Reserve(count * sizeof(uint64_t));
+    if (out != nullptr) {
+      CopyBigEndian(out, values, count);
+    }
+  }
+
+ private:
+  // Returns where to write the next `size` bytes, or null if they do not fit.
+  uint8_t* Reserve(size_t size) {
+    size_t offset = sum_length_ + length_;
+    if (errors_ || size > capacity_ - offset) {
+      errors_ = true;
+      return nullptr;
+    }
+    return begin_ + offset;
+  }
+
+  uint8_t* const begin_;
+  const size_t capacity_;
+  bool errors_ = false;
+};
+
 class VectorEndianOuputput final : public EndianOutputBuffered {
  public:
   VectorEndianOuputput(std::vector<uint8_t>& data, size_t reserved_size)
@@ -772,7 +847,10 @@ class Hprof : public SingleRootVisitor {
 
     std::unique_ptr<File> file(new File(out_fd, filename_, true));
     bool okay;
-    {
+    std::optional<bool> mmap_okay = DumpToMappedFile(file.get(), overall_size);
+    if (mmap_okay.has_value()) {
+      okay = mmap_okay.value();
+    } else {
       FileEndianOutput file_output(file.get(), max_length);
       output_ = &file_output;
       ProcessHeap(true);
@@ -802,6 +880,46 @@ class Hprof : public SingleRootVisitor {
     return okay;
   }
 
+  // Writes the dump through a shared mapping of `file` if it is a regular file positioned at its
+  // start and `overall_size` bytes can be allocated for it. Returns whether the dump was written,
+  // or no value if the file cannot be mapped and the dump must be written with write() instead.
+  std::optional<bool> DumpToMappedFile(File* file, size_t overall_size)
+      REQUIRES(Locks::mutator_lock_) {
+    int fd = file->Fd();
+    struct stat st;
+    if (overall_size == 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+        lseek(fd, 0, SEEK_CUR) != 0) {
+      return std::nullopt;
+    }
+    // Allocate the blocks up front: running out of space while writing to the mapping would
+    // raise SIGBUS instead of returning an error.
+    if (posix_fallocate(fd, 0, overall_size) != 0) {
+      return std::nullopt;
+    }
+    void* map = mmap(nullptr, overall_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+      PLOG(WARNING) << "hprof: mmap of \"" << filename_ << "\" failed, using write()";
+      return std::nullopt;
+    }
+
+    size_t written;
+    bool okay;
+    {
+      MmapEndianOutput mmap_output(reinterpret_cast<uint8_t*>(map), overall_size);
+      output_ = &mmap_output;
+      ProcessHeap(true);
+      okay = !mmap_output.Errors();
+      written = mmap_output.SumLength();
+      // Check for expected size. See DumpToFile for comment.
+      DCHECK(!okay || written <= overall_size);
+      output_ = nullptr;
+    }
+    munmap(map, overall_size);
+    // Drop the space allocated for the upper bound and leave the file offset at the end of the
+    // dump, as if it had been written with write().
+    return okay && ftruncate(fd, written) == 0 && lseek(fd, written, SEEK_SET) >= 0;
+  }
+
   bool DumpToDdmsDirect(size_t overall_size, size_t max_length, uint32_t chunk_type)
       REQUIRES(Locks::mutator_lock_) {
     CHECK(direct_to_ddms_);
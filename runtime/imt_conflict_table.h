@@ -18,7 +18,10 @@
 #define ART_RUNTIME_IMT_CONFLICT_TABLE_H_
 
 #include <cstddef>
+#include <cstdint>
+#include <utility>
 
+#include "base/bit_utils.h"
 #include "base/casts.h"
 #include "base/macros.h"
 #include "base/pointer_size.h"
@@ -32,6 +35,12 @@ class ArtMethod;
 // The table contains a list of pairs of { interface_method, implementation_method }
 // with the last entry being null to make an assembly implementation of a lookup
 // faster.
+//
+// Large tables created at runtime for 64-bit targets use a hashed layout instead: the first
+// entry is a header { kNonEntry, hash_mask } followed by the slots of a linearly probed hash
+// table without wrap-around, with unused slots holding kNonEntry as the interface method, and
+// the null entry at the end. As kNonEntry never matches an interface method, a plain linear
+// scan of a hashed table still finds every entry.
 class ImtConflictTable {
   enum MethodIndex {
     kMethodInterface,
@@ -40,12 +49,30 @@ class ImtConflictTable {
   };
 
  public:
+  // Marker stored as the interface method of the hashed table header and unused slots.
+  static constexpr uintptr_t kNonEntry = 1u;
+  // Number of low bits of the interface method address ignored by the hash. ArtMethods are
+  // 32 bytes on 64-bit targets, so methods of the same class map to consecutive slots.
+  static constexpr size_t kHashShift = 5u;
+  // Minimum number of entries for which a hashed table is used.
+  static constexpr size_t kMinHashedEntries = 8u;
+
   // Build a new table copying `other` and adding the new entry formed of
   // the pair { `interface_method`, `implementation_method` }
   ImtConflictTable(ImtConflictTable* other,
                    ArtMethod* interface_method,
                    ArtMethod* implementation_method,
-                   PointerSize pointer_size) {
+                   PointerSize pointer_size,
+                   bool hashed = false) {
+    if (hashed) {
+      InitHashed(other->NumEntries(pointer_size) + 1u, pointer_size);
+      other->ForEachEntry([&](ArtMethod* interface, ArtMethod* implementation) {
+        AddEntry(interface, implementation, pointer_size);
+      }, pointer_size);
+      AddEntry(interface_method, implementation_method, pointer_size);
+      return;
+    }
+    DCHECK(!other->IsHashed(pointer_size));
     const size_t count = other->NumEntries(pointer_size);
     for (size_t i = 0; i < count; ++i) {
       SetInterfaceMethod(i, pointer_size, other->GetInterfaceMethod(i, pointer_size));
@@ -58,13 +85,18 @@ class ImtConflictTable {
     SetImplementationMethod(count + 1, pointer_size, nullptr);
   }
 
-  // num_entries excludes the header.
-  ImtConflictTable(size_t num_entries, PointerSize pointer_size) {
+  // num_entries excludes the header. Entries are added with `AddEntry()`.
+  ImtConflictTable(size_t num_entries, PointerSize pointer_size, bool hashed = false) {
+    if (hashed) {
+      InitHashed(num_entries, pointer_size);
+      return;
+    }
     SetInterfaceMethod(num_entries, pointer_size, nullptr);
     SetImplementationMethod(num_entries, pointer_size, nullptr);
   }
 
-  // Set an entry at an index.
+  // Set an entry at an index. The index is a raw position in the table, only
+  // meaningful as an entry index for tables that are not hashed.
   void SetInterfaceMethod(size_t index, PointerSize pointer_size, ArtMethod* method) {
     SetMethod(index * kMethodCount + kMethodInterface, pointer_size, method);
   }
@@ -89,12 +121,46 @@ class ImtConflictTable {
     return AddressOfMethod(index * kMethodCount + kMethodImplementation, pointer_size);
   }
 
+  // Return whether the table uses the hashed layout.
+  bool IsHashed(PointerSize pointer_size) const {
+    return IsNonEntry(GetInterfaceMethod(0u, pointer_size));
+  }
+
+  // Add the pair { `interface_method`, `implementation_method` } to a table created
+  // with room for it. For tables that are not hashed, the entry is appended.
+  void AddEntry(ArtMethod* interface_method,
+                ArtMethod* implementation_method,
+                PointerSize pointer_size) {
+    DCHECK(interface_method != nullptr);
+    DCHECK(!IsNonEntry(interface_method));
+    size_t index;
+    if (IsHashed(pointer_size)) {
+      index = FirstProbedIndex(interface_method, pointer_size);
+      while (!IsNonEntry(GetInterfaceMethod(index, pointer_size))) {
+        ++index;
+        DCHECK(GetInterfaceMethod(index, pointer_size) != nullptr) << "Hashed table full";
+      }
+    } else {
+      index = NumRawEntries(pointer_size);
+    }
+    SetImplementationMethod(index, pointer_size, implementation_method);
+    SetInterfaceMethod(index, pointer_size, interface_method);
+  }
+
   // Return true if two conflict tables are the same.
   bool Equals(ImtConflictTable* other, PointerSize pointer_size) const {
     size_t num = NumEntries(pointer_size);
     if (num != other->NumEntries(pointer_size)) {
       return false;
     }
+    if (IsHashed(pointer_size) || other->IsHashed(pointer_size)) {
+      // The layouts may differ, compare the contents.
+      bool equal = true;
+      ForEachEntry([&](ArtMethod* interface, ArtMethod* implementation) {
+        equal = equal && other->Lookup(interface, pointer_size) == implementation;
+      }, pointer_size);
+      return equal;
+    }
     for (size_t i = 0; i < num; ++i) {
       if (GetInterfaceMethod(i, pointer_size) != other->GetInterfaceMethod(i, pointer_size) ||
           GetImplementationMethod(i, pointer_size) !=
@@ -116,10 +182,16 @@ class ImtConflictTable {
       if (interface_method == nullptr) {
         break;
       }
+      if (IsNonEntry(interface_method)) {
+        ++table_index;
+        continue;
+      }
       ArtMethod* implementation_method = GetImplementationMethod(table_index, pointer_size);
       auto input = std::make_pair(interface_method, implementation_method);
       std::pair<ArtMethod*, ArtMethod*> updated = visitor(input);
       if (input.first != updated.first) {
+        // Moving the interface method would invalidate its hashed slot.
+        DCHECK(!IsHashed(pointer_size));
         SetInterfaceMethod(table_index, pointer_size, updated.first);
       }
       if (input.second != updated.second) {
@@ -132,10 +204,12 @@ class ImtConflictTable {
   // Lookup the implementation ArtMethod associated to `interface_method`. Return null
   // if not found.
   ArtMethod* Lookup(ArtMethod* interface_method, PointerSize pointer_size) const {
-    uint32_t table_index = 0;
+    size_t table_index =
+        IsHashed(pointer_size) ? FirstProbedIndex(interface_method, pointer_size) : 0u;
     for (;;) {
       ArtMethod* current_interface_method = GetInterfaceMethod(table_index, pointer_size);
-      if (current_interface_method == nullptr) {
+      if (current_interface_method == nullptr || IsNonEntry(current_interface_method)) {
+        // For hashed tables, an unused slot ends the probe sequence.
         break;
       }
       if (current_interface_method == interface_method) {
@@ -148,27 +222,37 @@ class ImtConflictTable {
 
   // Compute the number of entries in this table.
   size_t NumEntries(PointerSize pointer_size) const {
-    uint32_t table_index = 0;
-    while (GetInterfaceMethod(table_index, pointer_size) != nullptr) {
-      ++table_index;
+    if (!IsHashed(pointer_size)) {
+      return NumRawEntries(pointer_size);
     }
-    return table_index;
+    size_t count = 0u;
+    ForEachEntry([&count](ArtMethod*, ArtMethod*) { ++count; }, pointer_size);
+    return count;
   }
 
   // Compute the size in bytes taken by this table.
   size_t ComputeSize(PointerSize pointer_size) const {
     // Add the end marker.
-    return ComputeSize(NumEntries(pointer_size), pointer_size);
+    return (NumRawEntries(pointer_size) + 1u) * EntrySize(pointer_size);
   }
 
   // Compute the size in bytes needed for copying the given `table` and add
   // one more entry.
-  static size_t ComputeSizeWithOneMoreEntry(ImtConflictTable* table, PointerSize pointer_size) {
+  static size_t ComputeSizeWithOneMoreEntry(ImtConflictTable* table,
+                                            PointerSize pointer_size,
+                                            bool hashed = false) {
+    if (hashed) {
+      return ComputeSize(table->NumEntries(pointer_size) + 1u, pointer_size, hashed);
+    }
     return table->ComputeSize(pointer_size) + EntrySize(pointer_size);
   }
 
   // Compute size with a fixed number of entries.
-  static size_t ComputeSize(size_t num_entries, PointerSize pointer_size) {
+  static size_t ComputeSize(size_t num_entries, PointerSize pointer_size, bool hashed = false) {
+    if (hashed) {
+      // Add one for the header and one for the null terminator.
+      return (NumHashedSlots(num_entries) + 2u) * EntrySize(pointer_size);
+    }
     return (num_entries + 1) * EntrySize(pointer_size);  // Add one for null terminator.
   }
 
@@ -176,7 +260,76 @@ class ImtConflictTable {
     return static_cast<size_t>(pointer_size) * static_cast<size_t>(kMethodCount);
   }
 
+  // Return whether a table with `num_entries` entries may use the hashed layout. The
+  // assembly lookups on 32-bit targets support only the linear layout.
+  static bool CanUseHashedTable(size_t num_entries, PointerSize pointer_size) {
+    return pointer_size == PointerSize::k64 && num_entries >= kMinHashedEntries;
+  }
+
  private:
+  static bool IsNonEntry(ArtMethod* method) {
+    return reinterpret_cast<uintptr_t>(method) == kNonEntry;
+  }
+
+  // The hash table size is at least twice the number of entries. Without wrap-around,
+  // the probe sequence of the last entry added may extend for `num_entries - 1` slots
+  // past the hash table.
+  static size_t HashCapacity(size_t num_entries) {
+    return RoundUpToPowerOfTwo(2u * num_entries);
+  }
+
+  static size_t NumHashedSlots(size_t num_entries) {
+    DCHECK_NE(num_entries, 0u);
+    return HashCapacity(num_entries) + num_entries - 1u;
+  }
+
+  void InitHashed(size_t num_entries, PointerSize pointer_size) {
+    DCHECK(pointer_size == PointerSize::k64);
+    ArtMethod* non_entry = reinterpret_cast<ArtMethod*>(kNonEntry);
+    size_t num_slots = NumHashedSlots(num_entries);
+    for (size_t i = 0; i <= num_slots; ++i) {
+      SetInterfaceMethod(i, pointer_size, non_entry);
+      SetImplementationMethod(i, pointer_size, nullptr);
+    }
+    // The header holds the hash mask in the implementation method slot.
+    SetImplementationMethod(
+        0u, pointer_size, reinterpret_cast<ArtMethod*>(HashCapacity(num_entries) - 1u));
+    SetInterfaceMethod(num_slots + 1u, pointer_size, nullptr);
+    SetImplementationMethod(num_slots + 1u, pointer_size, nullptr);
+  }
+
+  // Return the table index of the first slot probed for `interface_method`. This must
+  // match the assembly lookups in `art_quick_imt_conflict_trampoline`.
+  size_t FirstProbedIndex(ArtMethod* interface_method, PointerSize pointer_size) const {
+    DCHECK(IsHashed(pointer_size));
+    uintptr_t mask = reinterpret_cast<uintptr_t>(GetImplementationMethod(0u, pointer_size));
+    // Skip the header.
+    return 1u + ((reinterpret_cast<uintptr_t>(interface_method) >> kHashShift) & mask);
+  }
+
+  // Compute the number of entries before the null terminator, including the header
+  // and unused slots of hashed tables.
+  size_t NumRawEntries(PointerSize pointer_size) const {
+    size_t table_index = 0;
+    while (GetInterfaceMethod(table_index, pointer_size) != nullptr) {
+      ++table_index;
+    }
+    return table_index;
+  }
+
+  template<typename Function>
+  void ForEachEntry(const Function& function, PointerSize pointer_size) const {
+    for (size_t table_index = 0; ; ++table_index) {
+      ArtMethod* interface_method = GetInterfaceMethod(table_index, pointer_size);
+      if (interface_method == nullptr) {
+        break;
+      }
+      if (!IsNonEntry(interface_method)) {
+        function(interface_method, GetImplementationMethod(table_index, pointer_size));
+      }
+    }
+  }
+
   void** AddressOfMethod(size_t index, PointerSize pointer_size) {
     if (pointer_size == PointerSize::k64) {
       return reinterpret_cast<void**>(&data64_[index]);
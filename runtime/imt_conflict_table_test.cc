@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "imt_conflict_table.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace art HIDDEN {
+
+// The table only stores the method pointers, so we can use fake ones.
+static ArtMethod* FakeMethod(size_t index) {
+  // Use a stride of 4KiB so that all methods hash to the same slot for small hash masks.
+  return reinterpret_cast<ArtMethod*>(static_cast<uintptr_t>(0x100000u + 0x1000u * index));
+}
+
+static ImtConflictTable* NewTable(std::vector<uint64_t>* storage,
+                                  size_t num_entries,
+                                  bool hashed) {
+  size_t size = ImtConflictTable::ComputeSize(num_entries, PointerSize::k64, hashed);
+  storage->assign(size / sizeof(uint64_t), 0u);
+  return new (storage->data()) ImtConflictTable(num_entries, PointerSize::k64, hashed);
+}
+
+TEST(ImtConflictTableTest, HashedTable) {
+  constexpr PointerSize kPointerSize = PointerSize::k64;
+  constexpr size_t kNumEntries = 2u * ImtConflictTable::kMinHashedEntries;
+  ASSERT_TRUE(ImtConflictTable::CanUseHashedTable(kNumEntries, kPointerSize));
+  ASSERT_FALSE(ImtConflictTable::CanUseHashedTable(kNumEntries, PointerSize::k32));
+
+  std::vector<uint64_t> storage;
+  ImtConflictTable* table = NewTable(&storage, kNumEntries, /*hashed=*/ true);
+  EXPECT_TRUE(table->IsHashed(kPointerSize));
+  EXPECT_EQ(0u, table->NumEntries(kPointerSize));
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    table->AddEntry(FakeMethod(i), FakeMethod(kNumEntries + i), kPointerSize);
+  }
+  EXPECT_EQ(kNumEntries, table->NumEntries(kPointerSize));
+  EXPECT_EQ(storage.size() * sizeof(uint64_t), table->ComputeSize(kPointerSize));
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    EXPECT_EQ(FakeMethod(kNumEntries + i), table->Lookup(FakeMethod(i), kPointerSize));
+  }
+  EXPECT_EQ(nullptr, table->Lookup(FakeMethod(2u * kNumEntries), kPointerSize));
+
+  // A linear scan up to the null entry, as done by the assembly for tables that
+  // are not hashed, also finds all entries.
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    size_t index = 0u;
+    while (table->GetInterfaceMethod(index, kPointerSize) != FakeMethod(i)) {
+      ASSERT_NE(nullptr, table->GetInterfaceMethod(index, kPointerSize));
+      ++index;
+    }
+    EXPECT_EQ(FakeMethod(kNumEntries + i), table->GetImplementationMethod(index, kPointerSize));
+  }
+
+  size_t num_visited = 0u;
+  table->Visit([&](const std::pair<ArtMethod*, ArtMethod*>& methods) {
+    ++num_visited;
+    return methods;
+  }, kPointerSize);
+  EXPECT_EQ(kNumEntries, num_visited);
+}
+
+TEST(ImtConflictTableTest, GrowToHashedTable) {
+  constexpr PointerSize kPointerSize = PointerSize::k64;
+  constexpr size_t kNumEntries = ImtConflictTable::kMinHashedEntries - 1u;
+
+  std::vector<uint64_t> storage;
+  ImtConflictTable* table = NewTable(&storage, kNumEntries, /*hashed=*/ false);
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    table->AddEntry(FakeMethod(i), FakeMethod(kNumEntries + i), kPointerSize);
+  }
+  EXPECT_FALSE(table->IsHashed(kPointerSize));
+  EXPECT_EQ(kNumEntries, table->NumEntries(kPointerSize));
+
+  // Add one more entry, once with each layout.
+  ArtMethod* new_interface_method = FakeMethod(2u * kNumEntries);
+  ArtMethod* new_implementation_method = FakeMethod(2u * kNumEntries + 1u);
+  std::vector<uint64_t> linear_storage(
+      ImtConflictTable::ComputeSizeWithOneMoreEntry(table, kPointerSize) / sizeof(uint64_t));
+  ImtConflictTable* linear_table = new (linear_storage.data()) ImtConflictTable(
+      table, new_interface_method, new_implementation_method, kPointerSize);
+  std::vector<uint64_t> hashed_storage(
+      ImtConflictTable::ComputeSizeWithOneMoreEntry(table, kPointerSize, /*hashed=*/ true) /
+          sizeof(uint64_t));
+  ImtConflictTable* hashed_table = new (hashed_storage.data()) ImtConflictTable(
+      table, new_interface_method, new_implementation_method, kPointerSize, /*hashed=*/ true);
+
+  EXPECT_FALSE(linear_table->IsHashed(kPointerSize));
+  EXPECT_TRUE(hashed_table->IsHashed(kPointerSize));
+  EXPECT_EQ(hashed_storage.size() * sizeof(uint64_t), hashed_table->ComputeSize(kPointerSize));
+  EXPECT_EQ(kNumEntries + 1u, hashed_table->NumEntries(kPointerSize));
+  EXPECT_EQ(new_implementation_method,
+            hashed_table->Lookup(new_interface_method, kPointerSize));
+  EXPECT_TRUE(linear_table->Equals(hashed_table, kPointerSize));
+  EXPECT_TRUE(hashed_table->Equals(linear_table, kPointerSize));
+  EXPECT_FALSE(hashed_table->Equals(table, kPointerSize));
+}
+
+}  // namespace art
@@ -110,6 +110,7 @@ Instrumentation::Instrumentation()
     : run_exit_hooks_(false),
       instrumentation_level_(InstrumentationLevel::kInstrumentNothing),
       forced_interpret_only_(false),
+      count_invocations_in_compiled_code_(false),
       have_method_entry_listeners_(0),
       have_method_exit_listeners_(0),
       have_method_unwind_listeners_(false),
@@ -1442,6 +1443,19 @@ void Instrumentation::DisableMethodTracing(const char* key) {
                  /*try_switch_to_non_debuggable=*/true);
 }
 
+void Instrumentation::SetCountInvocationsInCompiledCode(bool enable) {
+  if (count_invocations_in_compiled_code_ == enable) {
+    return;
+  }
+  count_invocations_in_compiled_code_ = enable;
+  // Code compiled with counters can keep counting once disabled, but code compiled without them
+  // must be compiled again to be counted.
+  jit::Jit* jit = Runtime::Current()->GetJit();
+  if (enable && jit != nullptr) {
+    jit->GetCodeCache()->InvalidateAllCompiledCode();
+  }
+}
+
 const void* Instrumentation::GetCodeForInvoke(ArtMethod* method) {
   // This is called by instrumentation and resolution trampolines
   // and that should never be getting proxy methods.
@@ -367,6 +367,18 @@ class Instrumentation {
     return forced_interpret_only_;
   }
 
+  // Makes the JIT compile an increment of the method's invocation counter into the frame entry of
+  // the code it generates, see ProfilingInfo::GetInvocationCount. Tools that only need call counts
+  // or coverage can use this instead of method entry listeners, so that methods keep running
+  // compiled code. Enabling discards the JIT code compiled without counters. The caller should
+  // suspend the JIT so that no compilation started before is committed without counters.
+  EXPORT void SetCountInvocationsInCompiledCode(bool enable)
+      REQUIRES(Locks::mutator_lock_, !Locks::jit_lock_);
+
+  bool CountsInvocationsInCompiledCode() const REQUIRES_SHARED(Locks::mutator_lock_) {
+    return count_invocations_in_compiled_code_;
+  }
+
   bool RunExitHooks() const {
     return run_exit_hooks_;
   }
@@ -700,6 +712,9 @@ class Instrumentation {
   // Did the runtime request we only run in the interpreter? ie -Xint mode.
   bool forced_interpret_only_;
 
+  // Whether the JIT compiles invocation counters into the code it generates.
+  bool count_invocations_in_compiled_code_ GUARDED_BY(Locks::mutator_lock_);
+
   // For method entry / exit events, we maintain fast trace listeners in a separate list to make
   // implementation of fast trace listeners more efficient by JITing the code to handle fast trace
   // events. We use a uint8_t (and not bool) to encode if there are none / fast / slow listeners.
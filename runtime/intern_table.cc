@@ -16,6 +16,7 @@
 
 #include "intern_table-inl.h"
 
+#include <iterator>
 #include <memory>
 
 #include "class_linker.h"
@@ -115,16 +116,29 @@ ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self, ObjPtr<mirror::St
   DCHECK(s != nullptr);
   // `String::GetHashCode()` ensures that the stored hash is calculated.
   uint32_t hash = static_cast<uint32_t>(s->GetHashCode());
+  size_t num_searched_strong_frozen_tables;
+  ObjPtr<mirror::String> result =
+      strong_interns_.FindFrozen(s, hash, &num_searched_strong_frozen_tables);
+  if (result != nullptr) {
+    return result;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
-  return strong_interns_.Find(s, hash);
+  return strong_interns_.Find(s, hash, num_searched_strong_frozen_tables);
 }
 
 ObjPtr<mirror::String> InternTable::LookupStrong(Thread* self,
                                                  uint32_t utf16_length,
                                                  const char* utf8_data) {
   uint32_t hash = Utf8String::Hash(utf16_length, utf8_data);
+  Utf8String string(utf16_length, utf8_data);
+  size_t num_searched_strong_frozen_tables;
+  ObjPtr<mirror::String> result =
+      strong_interns_.FindFrozen(string, hash, &num_searched_strong_frozen_tables);
+  if (result != nullptr) {
+    return result;
+  }
   MutexLock mu(self, *Locks::intern_table_lock_);
-  return strong_interns_.Find(Utf8String(utf16_length, utf8_data), hash);
+  return strong_interns_.Find(string, hash, num_searched_strong_frozen_tables);
 }
 
 ObjPtr<mirror::String> InternTable::LookupWeakLocked(ObjPtr<mirror::String> s) {
@@ -255,13 +269,19 @@ ObjPtr<mirror::String> InternTable::InternStrong(uint32_t utf16_length, const ch
   uint32_t hash = Utf8String::Hash(utf16_length, utf8_data);
   Thread* self = Thread::Current();
   ObjPtr<mirror::String> s;
+  Utf8String string(utf16_length, utf8_data);
   size_t num_searched_strong_frozen_tables;
+  // Most lookups during class loading find boot image strings; try to avoid the lock.
+  s = strong_interns_.FindFrozen(string, hash, &num_searched_strong_frozen_tables);
+  if (s != nullptr) {
+    return s;
+  }
   {
     // Try to avoid allocation. If we need to allocate, release the mutex before the allocation.
     MutexLock mu(self, *Locks::intern_table_lock_);
     DCHECK(!strong_interns_.tables_.empty());
+    s = strong_interns_.Find(string, hash, num_searched_strong_frozen_tables);
     num_searched_strong_frozen_tables = strong_interns_.tables_.size() - 1u;
-    s = strong_interns_.Find(Utf8String(utf16_length, utf8_data), hash);
   }
   if (s != nullptr) {
     return s;
@@ -293,7 +313,13 @@ ObjPtr<mirror::String> InternTable::InternStrong(ObjPtr<mirror::String> s) {
   DCHECK(s != nullptr);
   // `String::GetHashCode()` ensures that the stored hash is calculated.
   uint32_t hash = static_cast<uint32_t>(s->GetHashCode());
-  return Insert(s, hash, /*is_strong=*/ true);
+  size_t num_searched_strong_frozen_tables;
+  ObjPtr<mirror::String> result =
+      strong_interns_.FindFrozen(s, hash, &num_searched_strong_frozen_tables);
+  if (result != nullptr) {
+    return result;
+  }
+  return Insert(s, hash, /*is_strong=*/ true, num_searched_strong_frozen_tables);
 }
 
 ObjPtr<mirror::String> InternTable::InternWeak(const char* utf8_data) {
@@ -311,7 +337,13 @@ ObjPtr<mirror::String> InternTable::InternWeak(ObjPtr<mirror::String> s) {
   DCHECK(s != nullptr);
   // `String::GetHashCode()` ensures that the stored hash is calculated.
   uint32_t hash = static_cast<uint32_t>(s->GetHashCode());
-  return Insert(s, hash, /*is_strong=*/ false);
+  size_t num_searched_strong_frozen_tables;
+  ObjPtr<mirror::String> result =
+      strong_interns_.FindFrozen(s, hash, &num_searched_strong_frozen_tables);
+  if (result != nullptr) {
+    return result;
+  }
+  return Insert(s, hash, /*is_strong=*/ false, num_searched_strong_frozen_tables);
 }
 
 void InternTable::SweepInternTableWeaks(IsMarkedVisitor* visitor) {
@@ -337,7 +369,8 @@ ObjPtr<mirror::String> InternTable::Table::Find(ObjPtr<mirror::String> s,
                                                 uint32_t hash,
                                                 size_t num_searched_frozen_tables) {
   Locks::intern_table_lock_->AssertHeld(Thread::Current());
-  auto mid = tables_.begin() + num_searched_frozen_tables;
+  DCHECK_LT(num_searched_frozen_tables, tables_.size());
+  auto mid = std::next(tables_.begin(), num_searched_frozen_tables);
   for (Table::InternalTable& table : MakeIterationRange(tables_.begin(), mid)) {
     DCHECK(table.set_.FindWithHash(GcRoot<mirror::String>(s), hash) == table.set_.end());
   }
@@ -353,11 +386,15 @@ ObjPtr<mirror::String> InternTable::Table::Find(ObjPtr<mirror::String> s,
 }
 
 FLATTEN
-ObjPtr<mirror::String> InternTable::Table::Find(const Utf8String& string, uint32_t hash) {
+ObjPtr<mirror::String> InternTable::Table::Find(const Utf8String& string,
+                                                uint32_t hash,
+                                                size_t num_searched_frozen_tables) {
   Locks::intern_table_lock_->AssertHeld(Thread::Current());
+  DCHECK_LT(num_searched_frozen_tables, tables_.size());
+  auto mid = std::next(tables_.begin(), num_searched_frozen_tables);
   // Search from the last table, assuming that apps shall search for their own
   // strings more often than for boot image strings.
-  for (InternalTable& table : ReverseRange(tables_)) {
+  for (InternalTable& table : ReverseRange(MakeIterationRange(mid, tables_.end()))) {
     auto it = table.set_.FindWithHash(string, hash);
     if (it != table.set_.end()) {
       return it->Read();
@@ -366,6 +403,49 @@ ObjPtr<mirror::String> InternTable::Table::Find(const Utf8String& string, uint32
   return nullptr;
 }
 
+template <typename Key>
+ALWAYS_INLINE
+ObjPtr<mirror::String> InternTable::Table::FindFrozenImpl(const Key& key,
+                                                          uint32_t hash,
+                                                          size_t* num_searched_frozen_tables) {
+  // Pairs with the release store in `PublishFrozenSets()`. The sets in the snapshot are
+  // not modified after publishing, so they can be searched without holding the lock.
+  const FrozenSets* frozen_sets = frozen_sets_.load(std::memory_order_acquire);
+  for (const UnorderedSet* set : *frozen_sets) {
+    auto it = set->FindWithHash(key, hash);
+    if (it != set->end()) {
+      return it->Read();
+    }
+  }
+  *num_searched_frozen_tables = frozen_sets->size();
+  return nullptr;
+}
+
+FLATTEN
+ObjPtr<mirror::String> InternTable::Table::FindFrozen(ObjPtr<mirror::String> s,
+                                                      uint32_t hash,
+                                                      size_t* num_searched_frozen_tables) {
+  return FindFrozenImpl(GcRoot<mirror::String>(s), hash, num_searched_frozen_tables);
+}
+
+FLATTEN
+ObjPtr<mirror::String> InternTable::Table::FindFrozen(const Utf8String& string,
+                                                      uint32_t hash,
+                                                      size_t* num_searched_frozen_tables) {
+  return FindFrozenImpl(string, hash, num_searched_frozen_tables);
+}
+
+void InternTable::Table::PublishFrozenSets() {
+  DCHECK(!tables_.empty());
+  auto frozen_sets = std::make_unique<FrozenSets>();
+  frozen_sets->reserve(tables_.size() - 1u);
+  for (const InternalTable& table : MakeIterationRange(tables_.begin(), std::prev(tables_.end()))) {
+    frozen_sets->push_back(&table.set_);
+  }
+  frozen_sets_.store(frozen_sets.get(), std::memory_order_release);
+  frozen_sets_snapshots_.push_back(std::move(frozen_sets));
+}
+
 void InternTable::Table::AddNewTable() {
   // Propagate the min/max load factor from the old active set.
   DCHECK(!tables_.empty());
@@ -373,6 +453,7 @@ void InternTable::Table::AddNewTable() {
   InternalTable new_table;
   new_table.set_.SetLoadFactor(last_set.GetMinLoadFactor(), last_set.GetMaxLoadFactor());
   tables_.push_back(std::move(new_table));
+  PublishFrozenSets();
 }
 
 void InternTable::Table::Insert(ObjPtr<mirror::String> s, uint32_t hash) {
@@ -437,12 +518,15 @@ void InternTable::ChangeWeakRootStateLocked(gc::WeakRootState new_state) {
   }
 }
 
-InternTable::Table::Table() {
+InternTable::Table::Table() : frozen_sets_(nullptr) {
   Runtime* const runtime = Runtime::Current();
   InternalTable initial_table;
   initial_table.set_.SetLoadFactor(runtime->GetHashTableMinLoadFactor(),
                                    runtime->GetHashTableMaxLoadFactor());
   tables_.push_back(std::move(initial_table));
+  // The table is not shared with other threads yet.
+  MutexLock mu(Thread::Current(), *Locks::intern_table_lock_);
+  PublishFrozenSets();
 }
 
 }  // namespace art
@@ -17,6 +17,11 @@
 #ifndef ART_RUNTIME_INTERN_TABLE_H_
 #define ART_RUNTIME_INTERN_TABLE_H_
 
+#include <atomic>
+#include <list>
+#include <memory>
+#include <vector>
+
 #include "base/dchecked_vector.h"
 #include "base/gc_visited_arena_pool.h"
 #include "base/hash_set.h"
@@ -241,8 +246,23 @@ class InternTable {
                                 uint32_t hash,
                                 size_t num_searched_frozen_tables = 0u)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
-    ObjPtr<mirror::String> Find(const Utf8String& string, uint32_t hash)
+    ObjPtr<mirror::String> Find(const Utf8String& string,
+                                uint32_t hash,
+                                size_t num_searched_frozen_tables = 0u)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
+    // Search the frozen tables without holding the `Locks::intern_table_lock_`. If the string
+    // is not found, `*num_searched_frozen_tables` is set to the number of searched tables so
+    // that the caller can skip them in a subsequent locked `Find()`. Frozen tables are never
+    // modified for strong interns (barring a transaction rollback), so this must be used only
+    // for the strong intern table.
+    ObjPtr<mirror::String> FindFrozen(ObjPtr<mirror::String> s,
+                                      uint32_t hash,
+                                      size_t* num_searched_frozen_tables)
+        REQUIRES_SHARED(Locks::mutator_lock_);
+    ObjPtr<mirror::String> FindFrozen(const Utf8String& string,
+                                      uint32_t hash,
+                                      size_t* num_searched_frozen_tables)
+        REQUIRES_SHARED(Locks::mutator_lock_);
     void Insert(ObjPtr<mirror::String> s, uint32_t hash)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
     void Remove(ObjPtr<mirror::String> s, uint32_t hash)
@@ -263,16 +283,37 @@ class InternTable {
         REQUIRES(!Locks::intern_table_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
 
    private:
+    using FrozenSets = std::vector<const UnorderedSet*>;
+
     void SweepWeaks(UnorderedSet* set, IsMarkedVisitor* visitor)
         REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(Locks::intern_table_lock_);
 
+    template <typename Key>
+    ObjPtr<mirror::String> FindFrozenImpl(const Key& key,
+                                          uint32_t hash,
+                                          size_t* num_searched_frozen_tables)
+        REQUIRES_SHARED(Locks::mutator_lock_);
+
+    // Publish a new snapshot of the frozen sets for lock-free lookups.
+    void PublishFrozenSets() REQUIRES(Locks::intern_table_lock_);
+
     // Add a table to the front of the tables vector.
     void AddInternStrings(UnorderedSet&& intern_strings, bool is_boot_image)
         REQUIRES(Locks::intern_table_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
 
     // We call AddNewTable when we create the zygote to reduce private dirty pages caused by
     // modifying the zygote intern table. The back of table is modified when strings are interned.
-    dchecked_vector<InternalTable> tables_;
+    // We use a list so that the sets do not move when tables are added, as lock-free lookups
+    // may be reading them through `frozen_sets_`.
+    std::list<InternalTable> tables_;
+
+    // Snapshot of all sets but the last one, in the same order as `tables_`. Frozen tables are
+    // only ever inserted before the last table, so the first N sets of an old snapshot remain
+    // the first N sets of `tables_`. All published snapshots are kept alive in
+    // `frozen_sets_snapshots_` as readers can use an old one; there are only a few of them.
+    std::atomic<const FrozenSets*> frozen_sets_;
+    std::vector<std::unique_ptr<const FrozenSets>> frozen_sets_snapshots_
+        GUARDED_BY(Locks::intern_table_lock_);
 
     friend class InternTable;
     friend class linker::ImageWriter;
@@ -247,6 +247,35 @@ TEST_F(InternTableTest, LookupStrong) {
   EXPECT_TRUE(lookup_foobbS == nullptr);
 }
 
+TEST_F(InternTableTest, LookupStrongFrozen) {
+  ScopedObjectAccess soa(Thread::Current());
+  InternTable intern_table;
+  StackHandleScope<3> hs(soa.Self());
+  Handle<mirror::String> foo(hs.NewHandle(intern_table.InternStrong(3, "foo")));
+  ASSERT_TRUE(foo != nullptr);
+  intern_table.AddNewTable();
+  Handle<mirror::String> bar(hs.NewHandle(intern_table.InternStrong(3, "bar")));
+  ASSERT_TRUE(bar != nullptr);
+  intern_table.AddNewTable();
+  Handle<mirror::String> baz(hs.NewHandle(intern_table.InternStrong(3, "baz")));
+  ASSERT_TRUE(baz != nullptr);
+
+  // Strings in frozen tables are found by the lock-free search, the others by the locked one.
+  EXPECT_OBJ_PTR_EQ(intern_table.LookupStrong(soa.Self(), 3, "foo"), foo.Get());
+  EXPECT_OBJ_PTR_EQ(intern_table.LookupStrong(soa.Self(), 3, "bar"), bar.Get());
+  EXPECT_OBJ_PTR_EQ(intern_table.LookupStrong(soa.Self(), 3, "baz"), baz.Get());
+  EXPECT_TRUE(intern_table.LookupStrong(soa.Self(), 3, "qux") == nullptr);
+  EXPECT_OBJ_PTR_EQ(intern_table.InternStrong(3, "foo"), foo.Get());
+  EXPECT_OBJ_PTR_EQ(intern_table.InternStrong(3, "baz"), baz.Get());
+
+  ObjPtr<mirror::String> bar_2 = mirror::String::AllocFromModifiedUtf8(soa.Self(), "bar");
+  ASSERT_TRUE(bar_2 != nullptr);
+  EXPECT_OBJ_PTR_EQ(intern_table.LookupStrong(soa.Self(), bar_2), bar.Get());
+  EXPECT_OBJ_PTR_EQ(intern_table.InternStrong(bar_2), bar.Get());
+  EXPECT_OBJ_PTR_EQ(intern_table.InternWeak(bar_2), bar.Get());
+  EXPECT_EQ(3u, intern_table.Size());
+}
+
 TEST_F(InternTableTest, InternStrongFrozenWeak) {
   ScopedObjectAccess soa(Thread::Current());
   InternTable intern_table;
@@ -296,6 +296,12 @@ static inline JValue Execute(
       }
     }
 
+    // Count the methods entered in the switch interpreter. This should stay close to zero
+    // unless we are debugging, as nterp or compiled code should run everything else.
+    metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+    metrics->SwitchInterpreterMethodEntryCount()->AddOne();
+    metrics->SwitchInterpreterMethodEntryCountDelta()->AddOne();
+
     instrumentation::Instrumentation* instrumentation = Runtime::Current()->GetInstrumentation();
     if (UNLIKELY(instrumentation->HasMethodEntryListeners() || shadow_frame.GetForcePopFrame())) {
       instrumentation->MethodEnterEvent(self, method);
@@ -19,17 +19,28 @@
 
 #include "interpreter_cache.h"
 
+#include <utility>
+
 #include "thread.h"
 
 namespace art HIDDEN {
 
 inline bool InterpreterCache::Get(Thread* self, const void* key, /* out */ size_t* value) {
   DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
-  Entry& entry = data_[IndexOf(key)];
+  size_t index = IndexOf(key);
+  Entry& entry = data_[index];
   if (LIKELY(entry.first == key)) {
     *value = entry.second;
     return true;
   }
+  Entry& second_entry = data_[kSize + index];
+  if (second_entry.first == key) {
+    *value = second_entry.second;
+    std::swap(entry, second_entry);
+    ++second_way_hits_;
+    return true;
+  }
+  ++misses_;
   return false;
 }
 
@@ -37,7 +48,13 @@ inline void InterpreterCache::Set(Thread* self, const void* key, size_t value) {
   DCHECK(self->GetInterpreterCache() == this) << "Must be called from owning thread";
   // Simple store works here as the cache is always read/written by the owning
   // thread only (or in a stop-the-world pause).
-  data_[IndexOf(key)] = Entry{key, value};
+  size_t index = IndexOf(key);
+  Entry& entry = data_[index];
+  if (entry.first != nullptr && entry.first != key) {
+    // Keep the evicted entry in the second way.
+    data_[kSize + index] = entry;
+  }
+  entry = Entry{key, value};
 }
 
 }  // namespace art
@@ -42,6 +42,13 @@ class Thread;
 // We ensure consistency of the cache by clearing it
 // whenever any dex file is unloaded.
 //
+// The cache is 2-way set associative. The first way is the direct-mapped
+// table that nterp probes from assembly. Entries evicted from it are kept
+// in the second way, which is only probed by the runtime slow paths. This
+// lets them skip the resolution on a conflict miss without any change to
+// the assembly fast path. A hit in the second way swaps the entries so
+// that the most recently used one is found by the fast path next time.
+//
 // Aligned to 16-bytes to make it easier to get the address of the cache
 // from assembly (it ensures that the offset is valid immediate value).
 class ALIGNED(16) InterpreterCache {
@@ -53,7 +60,11 @@ class ALIGNED(16) InterpreterCache {
   // Value of 256 has around 75% cache hit rate.
   static constexpr size_t kSize = 256;
 
-  InterpreterCache() {
+  // Number of ways of each set. The first `kSize` entries of the array are
+  // the first way probed by nterp, the next `kSize` entries the second way.
+  static constexpr size_t kWays = 2;
+
+  InterpreterCache() : misses_(0u), second_way_hits_(0u) {
     // We can not use the Clear() method since the constructor will not
     // be called from the owning thread.
     data_.fill(Entry{});
@@ -66,10 +77,20 @@ class ALIGNED(16) InterpreterCache {
 
   ALWAYS_INLINE void Set(Thread* self, const void* key, size_t value);
 
-  std::array<Entry, kSize>& GetArray() {
+  std::array<Entry, kWays * kSize>& GetArray() {
     return data_;
   }
 
+  // Number of lookups from the runtime that missed in both ways.
+  uint32_t GetMisses() const {
+    return misses_;
+  }
+
+  // Number of lookups from the runtime that hit in the second way.
+  uint32_t GetSecondWayHits() const {
+    return second_way_hits_;
+  }
+
  private:
   static ALWAYS_INLINE size_t IndexOf(const void* key) {
     static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
@@ -78,7 +99,12 @@ class ALIGNED(16) InterpreterCache {
     return index;
   }
 
-  std::array<Entry, kSize> data_;
+  std::array<Entry, kWays * kSize> data_;
+
+  // Statistics for the SIGQUIT dump. Lookups done by nterp from assembly are not
+  // counted, so these show how often the fast path fails to find an entry.
+  uint32_t misses_;
+  uint32_t second_way_hits_;
 };
 
 }  // namespace art
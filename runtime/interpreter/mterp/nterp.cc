@@ -125,6 +125,12 @@ inline void UpdateHotness(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock
   method->UpdateCounter(increase_hotness_for_ui ? 0x6ff : 0xf);
 }
 
+// Nterp only probes the first way of the cache from assembly. Look up the
+// entry in the other way before doing the full resolution.
+inline bool GetFromCache(Thread* self, const uint16_t* dex_pc_ptr, /* out */ size_t* value) {
+  return self->GetInterpreterCache()->Get(self, dex_pc_ptr, value);
+}
+
 template<typename T>
 inline void UpdateCache(Thread* self, const uint16_t* dex_pc_ptr, T value) {
   self->GetInterpreterCache()->Set(self, dex_pc_ptr, value);
@@ -320,6 +326,10 @@ LIBART_PROTECTED FLATTEN
 extern "C" size_t NterpGetMethod(Thread* self, ArtMethod* caller, const uint16_t* dex_pc_ptr)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (GetFromCache(self, dex_pc_ptr, &cached_value)) {
+    return cached_value;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   Instruction::Code opcode = inst->Opcode();
   DCHECK(IsUint<8>(static_cast<std::underlying_type_t<Instruction::Code>>(opcode)));
@@ -396,6 +406,10 @@ extern "C" size_t NterpGetStaticField(Thread* self,
                                       size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (GetFromCache(self, dex_pc_ptr, &cached_value)) {
+    return cached_value;
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegB_21c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -452,6 +466,10 @@ extern "C" uint32_t NterpGetInstanceFieldOffset(Thread* self,
                                                 size_t resolve_field_type)  // Resolve if not zero
     REQUIRES_SHARED(Locks::mutator_lock_) {
   UpdateHotness(caller);
+  size_t cached_value;
+  if (GetFromCache(self, dex_pc_ptr, &cached_value)) {
+    return static_cast<uint32_t>(cached_value);
+  }
   const Instruction* inst = Instruction::At(dex_pc_ptr);
   uint16_t field_index = inst->VRegC_22c();
   ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
@@ -497,6 +515,10 @@ extern "C" mirror::Object* NterpGetClass(Thread* self, ArtMethod* caller, uint16
          opcode == Instruction::INSTANCE_OF ||
          opcode == Instruction::CONST_CLASS ||
          opcode == Instruction::NEW_ARRAY);
+  size_t cached_value;
+  if (GetFromCache(self, dex_pc_ptr, &cached_value)) {
+    return reinterpret_cast<mirror::Object*>(cached_value);
+  }
 
   // In release mode, this is just a simple load.
   // In debug mode, this checks that we're using the correct instruction format.
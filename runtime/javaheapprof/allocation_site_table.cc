@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "javaheapprof/allocation_site_table.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "art_method-inl.h"
+#include "base/pointer_size.h"
+#include "stack.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+size_t AllocationSiteTable::SiteKeyHash::operator()(const SiteKey& key) const {
+  static constexpr size_t kHashMultiplier = 17;
+  size_t result = std::hash<uint32_t>()(key.parent);
+  result = result * kHashMultiplier + std::hash<void*>()(reinterpret_cast<void*>(key.method));
+  result = result * kHashMultiplier + std::hash<uint32_t>()(key.dex_pc);
+  return result;
+}
+
+AllocationSiteTable::AllocationSiteTable()
+    : lock_("allocation site table lock", kGenericBottomLock) {
+  sites_.push_back(Site{kRootSite, Frame{nullptr, 0u}, 0u, 0u});
+}
+
+void AllocationSiteTable::RecordSample(Thread* self, size_t bytes) {
+  // Collect the frames outside of the lock, innermost first.
+  Frame frames[kMaxStackDepth];
+  size_t num_frames = 0;
+  StackVisitor::WalkStack(
+      [&](const art::StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+        if (num_frames == kMaxStackDepth) {
+          return false;
+        }
+        ArtMethod* m = stack_visitor->GetMethod();
+        // m may be null if we have inlined methods of unresolved classes.
+        if (m != nullptr && !m->IsRuntimeMethod()) {
+          m = m->GetInterfaceMethodIfProxy(kRuntimePointerSize);
+          frames[num_frames++] = Frame{m, stack_visitor->GetDexPc()};
+        }
+        return true;
+      },
+      self,
+      /* context= */ nullptr,
+      art::StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+  std::reverse(frames, frames + num_frames);
+  RecordTrace(frames, num_frames, bytes);
+}
+
+uint32_t AllocationSiteTable::RecordTrace(const Frame* frames, size_t num_frames, size_t bytes) {
+  MutexLock mu(Thread::Current(), lock_);
+  uint32_t id = kRootSite;
+  for (size_t i = 0; i < num_frames; ++i) {
+    id = InternLocked(id, frames[i]);
+  }
+  sites_[id].bytes += bytes;
+  sites_[id].count++;
+  return id;
+}
+
+uint32_t AllocationSiteTable::InternLocked(uint32_t parent, const Frame& frame) {
+  SiteKey key{parent, frame.method, frame.dex_pc};
+  auto it = children_.find(key);
+  if (it != children_.end()) {
+    return it->second;
+  }
+  uint32_t id = static_cast<uint32_t>(sites_.size());
+  sites_.push_back(Site{parent, frame, 0u, 0u});
+  children_.emplace(key, id);
+  return id;
+}
+
+size_t AllocationSiteTable::NumSites() {
+  MutexLock mu(Thread::Current(), lock_);
+  return sites_.size();
+}
+
+void AllocationSiteTable::Clear() {
+  MutexLock mu(Thread::Current(), lock_);
+  sites_.resize(1);
+  sites_[kRootSite].bytes = 0u;
+  sites_[kRootSite].count = 0u;
+  children_.clear();
+}
+
+}  // namespace art
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_TABLE_H_
+#define ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_TABLE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+
+namespace art HIDDEN {
+
+class ArtMethod;
+class Thread;
+
+// Aggregates sampled allocations by call site. Stack traces are interned into a
+// trie, hash-consed on (parent, method, dex pc), so that a trace shares its
+// prefix (starting at the outermost frame) with all other traces through the
+// same callers and every distinct site is stored once.
+//
+// Methods are not kept alive by the table. Consumers must resolve them before
+// their classes may be unloaded, or Clear() the table across class unloading.
+class AllocationSiteTable {
+ public:
+  // Id of the root of the trie, which stands for the empty trace.
+  static constexpr uint32_t kRootSite = 0u;
+  // Only this many of the innermost frames of a trace are recorded.
+  static constexpr size_t kMaxStackDepth = 64u;
+
+  struct Frame {
+    ArtMethod* method;
+    uint32_t dex_pc;
+  };
+
+  struct Site {
+    uint32_t parent;
+    Frame frame;
+    // Samples whose innermost frame is this site.
+    uint64_t bytes;
+    uint64_t count;
+  };
+
+  AllocationSiteTable();
+
+  // Walk the stack of `self` and record a sample of `bytes` at its innermost frame.
+  void RecordSample(Thread* self, size_t bytes)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!lock_);
+
+  // Record a sample of `bytes` for the trace `frames`, ordered from the outermost
+  // to the innermost frame. Returns the id of the site of the innermost frame.
+  uint32_t RecordTrace(const Frame* frames, size_t num_frames, size_t bytes) REQUIRES(!lock_);
+
+  // Call `visitor(id, site)` for every site, parents before children.
+  template <typename Visitor>
+  void VisitSites(Thread* self, Visitor&& visitor) REQUIRES(!lock_) {
+    MutexLock mu(self, lock_);
+    for (uint32_t id = 0; id < sites_.size(); ++id) {
+      visitor(id, sites_[id]);
+    }
+  }
+
+  size_t NumSites() REQUIRES(!lock_);
+  void Clear() REQUIRES(!lock_);
+
+ private:
+  struct SiteKey {
+    uint32_t parent;
+    ArtMethod* method;
+    uint32_t dex_pc;
+
+    bool operator==(const SiteKey& other) const {
+      return parent == other.parent && method == other.method && dex_pc == other.dex_pc;
+    }
+  };
+
+  struct SiteKeyHash {
+    size_t operator()(const SiteKey& key) const;
+  };
+
+  uint32_t InternLocked(uint32_t parent, const Frame& frame) REQUIRES(lock_);
+
+  Mutex lock_;
+  std::vector<Site> sites_ GUARDED_BY(lock_);
+  std::unordered_map<SiteKey, uint32_t, SiteKeyHash> children_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSiteTable);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_JAVAHEAPPROF_ALLOCATION_SITE_TABLE_H_
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "javaheapprof/allocation_site_table.h"
+
+#include "common_runtime_test.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+class AllocationSiteTableTest : public CommonRuntimeTest {};
+
+// The methods are only used as keys, so any distinct addresses do.
+static ArtMethod* FakeMethod(uintptr_t n) {
+  return reinterpret_cast<ArtMethod*>(n * alignof(void*));
+}
+
+TEST_F(AllocationSiteTableTest, SharesPrefixes) {
+  AllocationSiteTable table;
+  using Frame = AllocationSiteTable::Frame;
+  const Frame a_b_c[] = {{FakeMethod(1), 0u}, {FakeMethod(2), 4u}, {FakeMethod(3), 8u}};
+  const Frame a_b_d[] = {{FakeMethod(1), 0u}, {FakeMethod(2), 4u}, {FakeMethod(4), 2u}};
+  const Frame a_b[] = {{FakeMethod(1), 0u}, {FakeMethod(2), 4u}};
+  // Same method as in a_b, but a different dex pc is a different site.
+  const Frame a_b2[] = {{FakeMethod(1), 0u}, {FakeMethod(2), 6u}};
+
+  uint32_t c = table.RecordTrace(a_b_c, 3, 16u);
+  EXPECT_EQ(table.RecordTrace(a_b_c, 3, 32u), c);
+  uint32_t d = table.RecordTrace(a_b_d, 3, 8u);
+  EXPECT_NE(c, d);
+  uint32_t b = table.RecordTrace(a_b, 2, 24u);
+  uint32_t b2 = table.RecordTrace(a_b2, 2, 24u);
+  EXPECT_NE(b, b2);
+  // Root, a, b, c, d and b2.
+  EXPECT_EQ(table.NumSites(), 6u);
+
+  Thread* self = Thread::Current();
+  table.VisitSites(self, [&](uint32_t id, const AllocationSiteTable::Site& site) {
+    if (id == c) {
+      EXPECT_EQ(site.parent, b);
+      EXPECT_EQ(site.bytes, 48u);
+      EXPECT_EQ(site.count, 2u);
+    } else if (id == d) {
+      EXPECT_EQ(site.parent, b);
+      EXPECT_EQ(site.bytes, 8u);
+      EXPECT_EQ(site.count, 1u);
+    } else if (id == b) {
+      EXPECT_EQ(site.frame.method, FakeMethod(2));
+      EXPECT_EQ(site.frame.dex_pc, 4u);
+      EXPECT_EQ(site.bytes, 24u);
+    }
+    // Parents are always visited first.
+    EXPECT_LE(site.parent, id);
+  });
+
+  table.Clear();
+  EXPECT_EQ(table.NumSites(), 1u);
+  EXPECT_EQ(table.RecordTrace(nullptr, 0, 8u), AllocationSiteTable::kRootSite);
+}
+
+}  // namespace art
@@ -61,13 +61,22 @@ size_t HeapSampler::PickAndAdjustNextSample(size_t sample_adjust_bytes) {
 // Also bytes_until_sample can only be updated after the allocation and reporting is done.
 // Thus next bytes_until_sample is previously calculated (before allocation) to be able to
 // get the next tlab_size, but only saved/updated here.
-void HeapSampler::ReportSample(art::mirror::Object* obj, size_t allocation_size) {
+// Samples of registered native allocations have a null object and may come from a thread that
+// does not hold the mutator lock. Java allocations always hold it, so only their call sites are
+// recorded.
+void HeapSampler::ReportSample(art::mirror::Object* obj, size_t allocation_size)
+    NO_THREAD_SAFETY_ANALYSIS {
   VLOG(heap) << "JHP:***Report Perfetto Allocation: alloc_size: " << allocation_size;
   uint64_t perf_alloc_id = reinterpret_cast<uint64_t>(obj);
   VLOG(heap) << "JHP:***Report Perfetto Allocation: obj: " << perf_alloc_id;
 #ifdef ART_TARGET_ANDROID
   AHeapProfile_reportSample(perfetto_heap_id_, perf_alloc_id, allocation_size);
 #endif
+  if (obj != nullptr && record_allocation_sites_.load(std::memory_order_acquire)) {
+    Thread* self = Thread::Current();
+    Locks::mutator_lock_->AssertSharedHeld(self);
+    allocation_sites_.RecordSample(self, allocation_size);
+  }
 }
 
 // Check whether we should take a sample or not at this allocation and calculate the sample
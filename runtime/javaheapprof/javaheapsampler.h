@@ -20,6 +20,7 @@
 #include <random>
 #include "base/locks.h"
 #include "base/mutex.h"
+#include "javaheapprof/allocation_site_table.h"
 #include "mirror/object.h"
 
 namespace art HIDDEN {
@@ -51,8 +52,15 @@ class HeapSampler {
   void DisableHeapSampler() {
     enabled_.store(false, std::memory_order_release);
   }
-  // Report a sample to Perfetto.
+  // Report a sample to Perfetto, and record its allocation site if enabled.
   void ReportSample(art::mirror::Object* obj, size_t allocation_size);
+  // Whether samples of Java allocations are also aggregated by call site.
+  void SetRecordAllocationSites(bool enabled) {
+    record_allocation_sites_.store(enabled, std::memory_order_release);
+  }
+  AllocationSiteTable& GetAllocationSites() {
+    return allocation_sites_;
+  }
   // Check whether we should take a sample or not at this allocation, and return the
   // number of bytes from current pos to the next sample to use in the expand Tlab
   // calculation.
@@ -85,6 +93,9 @@ class HeapSampler {
   // Writes guarded by geo_dist_rng_lock_.
   std::atomic<int> p_sampling_interval_{4 * 1024};
   uint32_t perfetto_heap_id_ = 0;
+  std::atomic<bool> record_allocation_sites_{false};
+  // Sampled bytes and counts per call site, see SetRecordAllocationSites().
+  AllocationSiteTable allocation_sites_;
   // std random number generator.
   std::minstd_rand rng_ GUARDED_BY(geo_dist_rng_lock_);  // Holds the state
   // std geometric distribution
@@ -105,9 +105,15 @@ constexpr std::memory_order kNonRacingRelaxed = std::memory_order_relaxed;
 // Size of JIT code range covered by each packed JITCodeEntry.
 constexpr uint32_t kJitRepackGroupSize = 64 * KB;
 
-// Automatically call the repack method every 'n' new entries.
+// Automatically call the repack method every 'n' new entries...
 constexpr uint32_t kJitRepackFrequency = 64;
 
+// ...but, except in zygote, at most once per interval, unless there are at least this many
+// unpacked entries. This batches the repacking during bursts of JIT compilations, such as at
+// startup. The unpacked entries are valid for readers, they just use more memory.
+constexpr uint64_t kJitRepackMinIntervalNs = MsToNs(100);
+constexpr uint32_t kJitRepackMaxUnpackedEntries = 1024;
+
 }  // namespace art
 
 // Public binary interface between ART and native tools (gdb, libunwind, etc).
@@ -217,6 +223,9 @@ static std::vector<const void*> g_removed_jit_functions GUARDED_BY(g_jit_debug_l
 // Number of small (single symbol) ELF files. Used to trigger repacking.
 static uint32_t g_jit_num_unpacked_entries = 0;
 
+// CLOCK_MONOTONIC time of the last repacking. Used to batch repacking.
+static uint64_t g_jit_last_repack_ns = 0;
+
 struct DexNativeInfo {
   static Mutex* Lock() RETURN_CAPABILITY(g_dex_debug_lock) { return &g_dex_debug_lock; }
   static constexpr bool kCopySymfileData = false;  // Just reference DEX files.
@@ -585,6 +594,7 @@ static void RepackEntries(bool compress_entries, ArrayRef<const void*> removed)
     group_it = end;  // Go to next group.
   }
   g_jit_num_unpacked_entries = 0;
+  g_jit_last_repack_ns = NanoTime();
 }
 
 static void RepackNativeDebugInfoForJitLocked() REQUIRES(g_jit_debug_lock);
@@ -624,7 +634,11 @@ void AddNativeDebugInfoForJit(const void* code_ptr,
   // Always compress zygote, since it does not GC and we want to keep the high-water mark low.
   if (++g_jit_num_unpacked_entries >= kJitRepackFrequency) {
     bool is_zygote = Runtime::Current()->IsZygote();
-    RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+    if (is_zygote ||
+        g_jit_num_unpacked_entries >= kJitRepackMaxUnpackedEntries ||
+        NanoTime() - g_jit_last_repack_ns >= kJitRepackMinIntervalNs) {
+      RepackEntries(/*compress_entries=*/ is_zygote, /*removed=*/ ArrayRef<const void*>());
+    }
   }
 }
 
@@ -18,12 +18,21 @@
 
 #include <dlfcn.h>
 #include <sys/resource.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+
+#include "android-base/file.h"
+#include "android-base/strings.h"
 #include "art_method-inl.h"
 #include "base/file_utils.h"
 #include "base/logging.h"  // For VLOG.
 #include "base/memfd.h"
 #include "base/memory_tool.h"
+#include "base/os.h"
 #include "base/pointer_size.h"
 #include "base/runtime_debug.h"
 #include "base/scoped_flock.h"
@@ -69,6 +78,9 @@ JitCompilerInterface* Jit::jit_compiler_ = nullptr;
 
 void Jit::DumpInfo(std::ostream& os) {
   code_cache_->Dump(os);
+  if (thread_pool_ != nullptr) {
+    thread_pool_->DumpQueueStats(os);
+  }
   cumulative_timings_.Dump(os);
   MutexLock mu(Thread::Current(), lock_);
   memory_use_.PrintMemoryUse(os);
@@ -76,6 +88,23 @@ void Jit::DumpInfo(std::ostream& os) {
 
 void Jit::DumpForSigQuit(std::ostream& os) {
   DumpInfo(os);
+  std::vector<CompilationRecord> records;
+  {
+    MutexLock mu(Thread::Current(), lock_);
+    records = slowest_compilations_;
+  }
+  if (!records.empty()) {
+    std::sort(records.begin(), records.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.compile_time_us > rhs.compile_time_us;
+    });
+    os << "Slowest JIT compilations:\n";
+    for (const CompilationRecord& record : records) {
+      os << "  " << record.method_name << " kind=" << record.kind
+         << " time=" << PrettyDuration(UsToNs(record.compile_time_us))
+         << " code_size=" << record.code_size << " graph_size=" << record.graph_size
+         << " inlined=" << record.inlined_invokes << "\n";
+    }
+  }
   ProfileSaver::DumpInstanceInfo(os);
 }
 
@@ -517,6 +546,40 @@ void Jit::AddMemoryUsage(ArtMethod* method, size_t bytes) {
   memory_use_.AddValue(bytes);
 }
 
+void Jit::AddCompilationRecord(ArtMethod* method,
+                               CompilationKind kind,
+                               uint32_t graph_size,
+                               uint32_t inlined_invokes,
+                               uint64_t compile_time_us,
+                               size_t code_size) {
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics->JitMethodCompileTime()->Add(compile_time_us);
+  metrics->JitMethodCodeSize()->Add(code_size);
+
+  MutexLock mu(Thread::Current(), lock_);
+  auto fastest = slowest_compilations_.end();
+  if (slowest_compilations_.size() == kMaxCompilationRecords) {
+    fastest = std::min_element(
+        slowest_compilations_.begin(),
+        slowest_compilations_.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.compile_time_us < rhs.compile_time_us; });
+    if (fastest->compile_time_us >= compile_time_us) {
+      return;
+    }
+  }
+  CompilationRecord record = {.method_name = method->PrettyMethod(),
+                              .kind = kind,
+                              .graph_size = graph_size,
+                              .inlined_invokes = inlined_invokes,
+                              .compile_time_us = compile_time_us,
+                              .code_size = code_size};
+  if (fastest != slowest_compilations_.end()) {
+    *fastest = std::move(record);
+  } else {
+    slowest_compilations_.push_back(std::move(record));
+  }
+}
+
 void Jit::NotifyZygoteCompilationDone() {
   if (fd_methods_ == -1) {
     return;
@@ -662,6 +725,11 @@ class JitCompileTask final : public Task {
   }
 
   void Run(Thread* self) override {
+    JitThreadPool* thread_pool = Runtime::Current()->GetJit()->GetThreadPool();
+    if (thread_pool != nullptr) {
+      thread_pool->WaitForCpuBudget(self);
+    }
+    uint64_t start_cpu_ns = ThreadCpuNanoTime();
     {
       ScopedObjectAccess soa(self);
       switch (kind_) {
@@ -676,6 +744,9 @@ class JitCompileTask final : public Task {
         }
       }
     }
+    if (thread_pool != nullptr) {
+      thread_pool->ChargeCpuTime(self, ThreadCpuNanoTime() - start_cpu_ns);
+    }
     ProfileSaver::NotifyJitActivity();
   }
 
@@ -785,6 +856,68 @@ class JitZygoteDoneCompilingTask final : public SelfDeletingTask {
   DISALLOW_COPY_AND_ASSIGN(JitZygoteDoneCompilingTask);
 };
 
+// Task run by the system server once boot has completed, to hand the boot classpath methods it
+// JIT-compiled over to the zygote. The zygote compiles the methods of the profile in the shared
+// region at its next start, so that all processes start with them compiled.
+class JitPublishZygoteSharedProfileTask final : public SelfDeletingTask {
+ public:
+  explicit JitPublishZygoteSharedProfileTask(const std::string& profile_file)
+      : profile_file_(profile_file) {}
+
+  void Run(Thread* self) override {
+    Runtime* runtime = Runtime::Current();
+    const std::vector<const DexFile*>& boot_class_path =
+        runtime->GetClassLinker()->GetBootClassPath();
+    ProfileCompilationInfo profile_info(/*for_boot_image=*/ true);
+    // Keep the methods published by previous runs, unless they were recorded for other
+    // boot classpath dex files, e.g. before an update.
+    if (OS::FileExists(profile_file_.c_str())) {
+      ProfileCompilationInfo previous_info(/*for_boot_image=*/ true);
+      if (previous_info.Load(profile_file_, /*clear_if_invalid=*/ false) &&
+          previous_info.VerifyProfileData(boot_class_path) &&
+          !profile_info.MergeWith(previous_info)) {
+        profile_info.ClearDataAndAdjustVersion(/*for_boot_image=*/ true);
+      }
+    }
+
+    std::map<const DexFile*, std::vector<uint16_t>> methods_per_dex;
+    {
+      ScopedObjectAccess soa(self);
+      std::vector<ArtMethod*> methods;
+      runtime->GetJit()->GetCodeCache()->GetBootMethodsForSharedRegion(&methods);
+      for (ArtMethod* method : methods) {
+        if (!method->IsProxyMethod()) {
+          methods_per_dex[method->GetDexFile()].push_back(method->GetDexMethodIndex());
+        }
+      }
+    }
+    size_t number_of_methods = 0u;
+    for (const auto& [dex_file, method_indexes] : methods_per_dex) {
+      if (!profile_info.AddMethodsForDex(ProfileCompilationInfo::MethodHotness::kFlagHot,
+                                         dex_file,
+                                         method_indexes.begin(),
+                                         method_indexes.end())) {
+        LOG(WARNING) << "Could not add methods of " << dex_file->GetLocation()
+                     << " to the zygote shared profile";
+        return;
+      }
+      number_of_methods += method_indexes.size();
+    }
+    uint64_t bytes_written = 0u;
+    if (!profile_info.Save(profile_file_, &bytes_written)) {
+      LOG(WARNING) << "Could not save the zygote shared profile " << profile_file_;
+      return;
+    }
+    VLOG(jit) << "Published " << number_of_methods << " boot classpath methods to "
+              << profile_file_;
+  }
+
+ private:
+  const std::string profile_file_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitPublishZygoteSharedProfileTask);
+};
+
 /**
  * A JIT task to run Java verification of boot classpath classes that were not
  * verified at compile-time.
@@ -871,6 +1004,20 @@ class ZygoteTask final : public Task {
             self, boot_class_path, profile_file, null_handle, /* add_to_queue= */ true);
       }
     }
+    // Also compile the boot classpath methods the system server JIT-compiled in its previous
+    // run. The profile only applies to dex files with matching checksums, so methods recorded
+    // against other boot classpath dex files are ignored.
+    const std::string& shared_profile = runtime->GetJITOptions()->GetZygoteSharedProfile();
+    if (runtime->IsPrimaryZygote() &&
+        !shared_profile.empty() &&
+        OS::FileExists(shared_profile.c_str())) {
+      const std::vector<const DexFile*>& boot_class_path =
+          runtime->GetClassLinker()->GetBootClassPath();
+      ScopedNullHandle<mirror::ClassLoader> null_handle;
+      LOG(INFO) << "JIT Zygote looking at shared profile " << shared_profile;
+      added_to_queue += runtime->GetJit()->CompileMethodsFromProfile(
+          self, boot_class_path, shared_profile, null_handle, /* add_to_queue= */ true);
+    }
     DCHECK(runtime->GetJit()->InZygoteUsingJit());
     runtime->GetJit()->AddPostBootTask(self, new JitZygoteDoneCompilingTask());
 
@@ -888,8 +1035,11 @@ class ZygoteTask final : public Task {
 
 class JitProfileTask final : public Task {
  public:
+  // If `profile` is empty, the profile next to the first dex file and its boot profile are used.
   JitProfileTask(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
-                 jobject class_loader) {
+                 jobject class_loader,
+                 const std::string& profile = "")
+      : profile_(profile) {
     ScopedObjectAccess soa(Thread::Current());
     StackHandleScope<1> hs(soa.Self());
     Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
@@ -911,11 +1061,18 @@ class JitProfileTask final : public Task {
     Handle<mirror::ClassLoader> loader = hs.NewHandle<mirror::ClassLoader>(
         soa.Decode<mirror::ClassLoader>(class_loader_));
 
+    Jit* jit = Runtime::Current()->GetJit();
+
+    if (!profile_.empty()) {
+      // Warm start: the profile is the one saved by a previous run. Queue the methods it lists
+      // and let the JIT compile them in the background.
+      jit->EnqueueMethodsFromWarmStartProfile(self, dex_files_, profile_, loader);
+      return;
+    }
+
     std::string profile = GetProfileFile(dex_files_[0]->GetLocation());
     std::string boot_profile = GetBootProfileFile(profile);
 
-    Jit* jit = Runtime::Current()->GetJit();
-
     jit->CompileMethodsFromBootProfile(
         self,
         dex_files_,
@@ -943,6 +1100,7 @@ class JitProfileTask final : public Task {
  private:
   std::vector<const DexFile*> dex_files_;
   jobject class_loader_;
+  const std::string profile_;
 
   DISALLOW_COPY_AND_ASSIGN(JitProfileTask);
 };
@@ -1082,13 +1240,82 @@ bool Jit::InZygoteUsingJit() {
   return runtime->IsZygote() && runtime->HasImageWithProfile() && runtime->UseJitCompilation();
 }
 
+// Return the number of CPUs the cgroup of this process may use, as given by its CPU quota, or
+// nothing if the quota is not limited.
+static std::optional<double> GetCgroupCpuQuota() {
+  std::string cgroups;
+  std::string cgroup_path;
+  if (android::base::ReadFileToString("/proc/self/cgroup", &cgroups)) {
+    for (std::string_view line : android::base::Split(cgroups, "\n")) {
+      // The cgroup v2 hierarchy is listed as "0::<path>".
+      if (line.starts_with("0::")) {
+        cgroup_path = line.substr(3);
+        break;
+      }
+    }
+  }
+  std::string content;
+  if (android::base::ReadFileToString("/sys/fs/cgroup" + cgroup_path + "/cpu.max", &content) ||
+      android::base::ReadFileToString("/sys/fs/cgroup/cpu.max", &content)) {
+    // cgroup v2: "<quota> <period>", where the quota is "max" when unlimited.
+    std::vector<std::string> fields = android::base::Split(android::base::Trim(content), " ");
+    if (fields.size() != 2 || fields[0] == "max") {
+      return std::nullopt;
+    }
+    double quota = strtod(fields[0].c_str(), nullptr);
+    double period = strtod(fields[1].c_str(), nullptr);
+    return (quota > 0 && period > 0) ? std::make_optional(quota / period) : std::nullopt;
+  }
+  std::string quota_content;
+  std::string period_content;
+  if (android::base::ReadFileToString("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", &quota_content) &&
+      android::base::ReadFileToString("/sys/fs/cgroup/cpu/cpu.cfs_period_us", &period_content)) {
+    // cgroup v1: the quota is -1 when unlimited.
+    double quota = strtod(quota_content.c_str(), nullptr);
+    double period = strtod(period_content.c_str(), nullptr);
+    return (quota > 0 && period > 0) ? std::make_optional(quota / period) : std::nullopt;
+  }
+  return std::nullopt;
+}
+
+size_t Jit::GetNumberOfCompilerThreads() const {
+  // Don't use more threads than there are CPUs online, or than the cgroup CPU quota allows,
+  // compilation is CPU bound.
+  long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  std::optional<double> cpu_quota = GetCgroupCpuQuota();
+  if (cpu_quota.has_value()) {
+    num_cpus = std::min(num_cpus, static_cast<long>(std::ceil(cpu_quota.value())));
+  }
+  return std::min(options_->GetThreadPoolThreads(),
+                  static_cast<size_t>(std::max(num_cpus, 1L)));
+}
+
+uint32_t Jit::GetCpuBudgetMs() const {
+  std::optional<uint32_t> budget_ms = options_->GetCpuBudgetMs();
+  if (budget_ms.has_value()) {
+    return budget_ms.value();
+  }
+  // Without an explicit budget, a process in a CPU-limited cgroup lets the JIT use a share of
+  // its quota, so that compilation does not starve the application threads.
+  static constexpr double kCgroupQuotaShare = 0.25;
+  std::optional<double> cpu_quota = GetCgroupCpuQuota();
+  if (!cpu_quota.has_value()) {
+    return 0u;
+  }
+  return std::max(static_cast<uint32_t>(cpu_quota.value() * kCgroupQuotaShare * 1000), 1u);
+}
+
 void Jit::CreateThreadPool() {
   // There is a DCHECK in the 'AddSamples' method to ensure the tread pool
   // is not null when we instrument.
 
-  thread_pool_.reset(JitThreadPool::Create("Jit thread pool", 1));
-
   Runtime* runtime = Runtime::Current();
+  // The zygote compiles boot profiles in the background with a single thread. Its children pick
+  // their own thread count in PostForkChildAction.
+  size_t num_threads = runtime->IsZygote() ? 1u : GetNumberOfCompilerThreads();
+  thread_pool_.reset(JitThreadPool::Create("Jit thread pool", num_threads));
+  thread_pool_->SetCpuBudget(runtime->IsZygote() ? 0u : GetCpuBudgetMs());
+
   thread_pool_->SetPthreadPriority(
       runtime->IsZygote()
           ? options_->GetZygoteThreadPoolPthreadPriority()
@@ -1210,6 +1437,20 @@ void Jit::RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& de
     // - System server dex files are registered *before* we set the runtime as
     //   system server (though we are in the system server process).
     thread_pool_->AddTask(Thread::Current(), new JitProfileTask(dex_files, class_loader));
+    return;
+  }
+  // Methods found hot by a previous run are compiled up front instead of waiting for them to
+  // become hot again. The profile records dex checksums, so it is only applied to the dex files
+  // it was recorded for.
+  const std::string& warm_start_profile = options_->GetWarmStartProfile();
+  if (!warm_start_profile.empty() &&
+      UseJitCompilation() &&
+      thread_pool_ != nullptr &&
+      !runtime->IsZygote() &&
+      !runtime->IsJavaDebuggable() &&
+      OS::FileExists(warm_start_profile.c_str())) {
+    thread_pool_->AddTask(Thread::Current(),
+                          new JitProfileTask(dex_files, class_loader, warm_start_profile));
   }
 }
 
@@ -1219,6 +1460,19 @@ void Jit::AddCompileTask(Thread* self,
   thread_pool_->AddTask(self, method, compilation_kind);
 }
 
+// Whether `method` runs in the interpreter or through a stub, i.e. has neither AOT nor JIT code.
+static bool HasNoCompiledCode(ClassLinker* class_linker, ArtMethod* method)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
+  return class_linker->IsQuickToInterpreterBridge(entry_point) ||
+      class_linker->IsQuickGenericJniStub(entry_point) ||
+      class_linker->IsNterpEntryPoint(entry_point) ||
+      // We explicitly check for the resolution stub, and not the resolution trampoline.
+      // The trampoline is for methods backed by a .oat file that has a compiled version of
+      // the method.
+      (entry_point == GetQuickResolutionStub());
+}
+
 bool Jit::CompileMethodFromProfile(Thread* self,
                                    ClassLinker* class_linker,
                                    uint32_t method_idx,
@@ -1240,14 +1494,7 @@ bool Jit::CompileMethodFromProfile(Thread* self,
     return false;
   }
   CompilationKind compilation_kind = CompilationKind::kOptimized;
-  const void* entry_point = method->GetEntryPointFromQuickCompiledCode();
-  if (class_linker->IsQuickToInterpreterBridge(entry_point) ||
-      class_linker->IsQuickGenericJniStub(entry_point) ||
-      class_linker->IsNterpEntryPoint(entry_point) ||
-      // We explicitly check for the resolution stub, and not the resolution trampoline.
-      // The trampoline is for methods backed by a .oat file that has a compiled version of
-      // the method.
-      (entry_point == GetQuickResolutionStub())) {
+  if (HasNoCompiledCode(class_linker, method)) {
     VLOG(jit) << "JIT Zygote processing method " << ArtMethod::PrettyMethod(method)
               << " from profile";
     method->SetPreCompiled();
@@ -1373,6 +1620,72 @@ uint32_t Jit::CompileMethodsFromProfile(
   return added_to_queue;
 }
 
+uint32_t Jit::EnqueueMethodsFromWarmStartProfile(Thread* self,
+                                                 const std::vector<const DexFile*>& dex_files,
+                                                 const std::string& profile_file,
+                                                 Handle<mirror::ClassLoader> class_loader) {
+  ProfileCompilationInfo profile_info;
+  {
+    unix_file::FdFile profile(profile_file, O_RDONLY, /* check_usage= */ true);
+    if (profile.Fd() == -1) {
+      PLOG(WARNING) << "No warm start profile: " << profile_file;
+      return 0u;
+    }
+    if (!profile_info.Load(profile.Fd())) {
+      LOG(WARNING) << "Could not load warm start profile: " << profile_file;
+      return 0u;
+    }
+  }
+  CompilationKind compilation_kind =
+      options_->UseBaselineCompiler() ? CompilationKind::kBaseline : CompilationKind::kOptimized;
+  ScopedObjectAccess soa(self);
+  StackHandleScope<1> hs(self);
+  MutableHandle<mirror::DexCache> dex_cache = hs.NewHandle<mirror::DexCache>(nullptr);
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  uint32_t added_to_queue = 0u;
+  for (const DexFile* dex_file : dex_files) {
+    std::set<dex::TypeIndex> class_types;
+    std::set<uint16_t> hot_methods;
+    std::set<uint16_t> startup_methods;
+    std::set<uint16_t> post_startup_methods;
+    if (!profile_info.GetClassesAndMethods(*dex_file,
+                                           &class_types,
+                                           &hot_methods,
+                                           &startup_methods,
+                                           &post_startup_methods)) {
+      // The profile does not know this dex file, or recorded a different checksum for it.
+      continue;
+    }
+    dex_cache.Assign(class_linker->FindDexCache(self, *dex_file));
+    CHECK(dex_cache != nullptr) << "Could not find dex cache for " << dex_file->GetLocation();
+    // The profile has no counts, so queue hot methods before methods only seen at startup.
+    // Post-startup methods are left to the samples.
+    for (const std::set<uint16_t>* methods : {&hot_methods, &startup_methods}) {
+      for (uint16_t method_idx : *methods) {
+        ArtMethod* method = class_linker->ResolveMethodWithoutInvokeType(
+            method_idx, dex_cache, class_loader);
+        if (method == nullptr) {
+          self->ClearException();
+          continue;
+        }
+        if (!method->IsCompilable() ||
+            !method->IsInvokable() ||
+            method->IsNative() ||
+            !HasNoCompiledCode(class_linker, method)) {
+          // Nothing to do, or dex2oat already compiled it.
+          continue;
+        }
+        // Go through the regular queues rather than the generic one, so that these requests
+        // are deduplicated with, and served after, requests from methods that are hot now.
+        thread_pool_->AddTask(self, method, compilation_kind);
+        ++added_to_queue;
+      }
+    }
+  }
+  VLOG(jit) << "Queued " << added_to_queue << " methods from warm start profile " << profile_file;
+  return added_to_queue;
+}
+
 bool Jit::IgnoreSamplesForMethod(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_) {
   if (method->IsClassInitializer() || !method->IsCompilable()) {
     // We do not want to compile such methods.
@@ -1550,6 +1863,14 @@ void Jit::PostForkChildAction(bool is_system_server, bool is_zygote) {
   // of the forked child. Parse them again.
   jit_compiler_->ParseCompilerOptions();
 
+  // The zygote used a single compiler thread. The pool's threads are usually created again in
+  // PostZygoteFork, but an unspecialized app process may already have them.
+  if (thread_pool_ != nullptr) {
+    thread_pool_->SetThreadCount(GetNumberOfCompilerThreads());
+    thread_pool_->SetPthreadPriority(options_->GetThreadPoolPthreadPriority());
+    thread_pool_->SetCpuBudget(GetCpuBudgetMs());
+  }
+
   // Adjust the status of code cache collection: the status from zygote was to not collect.
   // JitAtFirstUse compiles the methods synchronously on mutator threads. While this should work
   // in theory it is causing deadlocks in some jvmti tests related to Jit GC. Hence, disabling
@@ -1646,6 +1967,13 @@ void Jit::BootCompleted() {
   for (Task* task : tasks) {
     thread_pool_->AddTask(self, task);
   }
+  Runtime* runtime = Runtime::Current();
+  const std::string& shared_profile = options_->GetZygoteSharedProfile();
+  if (runtime->IsSystemServer() && !shared_profile.empty() && !runtime->IsJavaDebuggable()) {
+    // Queued after the boot tasks, so that the methods compiled from the system server
+    // profiles are included.
+    thread_pool_->AddTask(self, new JitPublishZygoteSharedProfileTask(shared_profile));
+  }
 }
 
 bool Jit::CanEncodeMethod(ArtMethod* method, bool is_for_shared_region) const {
@@ -1811,22 +2139,19 @@ void JitThreadPool::AddTask(Thread* self, ArtMethod* method, CompilationKind kin
       if (ContainsElement(osr_enqueued_methods_, method)) {
         return;
       }
-      osr_enqueued_methods_.insert(method);
-      osr_queue_.push_back(method);
+      Enqueue(osr_queue_, osr_enqueued_methods_, method, kind);
       break;
     case CompilationKind::kBaseline:
       if (ContainsElement(baseline_enqueued_methods_, method)) {
         return;
       }
-      baseline_enqueued_methods_.insert(method);
-      baseline_queue_.push_back(method);
+      Enqueue(baseline_queue_, baseline_enqueued_methods_, method, kind);
       break;
     case CompilationKind::kOptimized:
       if (ContainsElement(optimized_enqueued_methods_, method)) {
         return;
       }
-      optimized_enqueued_methods_.insert(method);
-      optimized_queue_.push_back(method);
+      Enqueue(optimized_queue_, optimized_enqueued_methods_, method, kind);
       break;
   }
   // If we have any waiters, signal one.
@@ -1835,33 +2160,70 @@ void JitThreadPool::AddTask(Thread* self, ArtMethod* method, CompilationKind kin
   }
 }
 
+void JitThreadPool::Enqueue(std::deque<QueuedMethod>& methods,
+                            std::set<ArtMethod*>& enqueued_methods,
+                            ArtMethod* method,
+                            CompilationKind kind) {
+  enqueued_methods.insert(method);
+  methods.push_back({method, NanoTime()});
+  QueueStats& stats = queue_stats_[static_cast<size_t>(kind)];
+  stats.requests++;
+  stats.max_depth = std::max(stats.max_depth, methods.size());
+}
+
 Task* JitThreadPool::TryGetTaskLocked() {
   if (!started_) {
     return nullptr;
   }
 
-  // Fetch generic tasks first.
+  // OSR requests first: they come from a loop that is running in the interpreter right now,
+  // while generic tasks are mostly speculative precompilation from profiles.
+  uint64_t now_ns = NanoTime();
+  Task* task = FetchFrom(osr_queue_, CompilationKind::kOsr, now_ns);
+  if (task != nullptr) {
+    return task;
+  }
+
+  // Generic tasks second.
   if (!generic_queue_.empty()) {
-    Task* task = generic_queue_.front();
+    task = generic_queue_.front();
     generic_queue_.pop_front();
     return task;
   }
 
-  // OSR requests second, then baseline and finally optimized.
-  Task* task = FetchFrom(osr_queue_, CompilationKind::kOsr);
+  // Then baseline and finally optimized. Optimized requests that have waited too long are
+  // served before baseline ones.
+  if (!baseline_queue_.empty() &&
+      !optimized_queue_.empty() &&
+      now_ns - optimized_queue_.front().enqueue_time_ns > kMaxOptimizedQueueWaitNs) {
+    aged_optimized_requests_++;
+    task = FetchFrom(optimized_queue_, CompilationKind::kOptimized, now_ns);
+  }
   if (task == nullptr) {
-    task = FetchFrom(baseline_queue_, CompilationKind::kBaseline);
+    task = FetchFrom(baseline_queue_, CompilationKind::kBaseline, now_ns);
     if (task == nullptr) {
-      task = FetchFrom(optimized_queue_, CompilationKind::kOptimized);
+      task = FetchFrom(optimized_queue_, CompilationKind::kOptimized, now_ns);
     }
   }
   return task;
 }
 
-Task* JitThreadPool::FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) {
-  if (!methods.empty()) {
-    ArtMethod* method = methods.front();
-    methods.pop_front();
+Task* JitThreadPool::FetchFrom(std::deque<QueuedMethod>& methods,
+                               CompilationKind kind,
+                               uint64_t now_ns) {
+  // With a single worker nothing else is being compiled when we fetch, so this takes the front.
+  for (auto it = methods.begin(); it != methods.end(); ++it) {
+    ArtMethod* method = it->method;
+    if (IsBeingCompiled(method)) {
+      // Compiling the same method concurrently could commit baseline code over optimized code.
+      continue;
+    }
+    uint64_t wait_ns = now_ns - it->enqueue_time_ns;
+    methods.erase(it);
+    QueueStats& stats = queue_stats_[static_cast<size_t>(kind)];
+    stats.served++;
+    stats.total_wait_ns += wait_ns;
+    stats.max_wait_ns = std::max(stats.max_wait_ns, wait_ns);
     JitCompileTask* task = new JitCompileTask(method, JitCompileTask::TaskKind::kCompile, kind);
     current_compilations_.insert(task);
     return task;
@@ -1869,6 +2231,34 @@ Task* JitThreadPool::FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind
   return nullptr;
 }
 
+bool JitThreadPool::IsBeingCompiled(ArtMethod* method) const {
+  for (JitCompileTask* task : current_compilations_) {
+    if (task->GetArtMethod() == method) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void JitThreadPool::SetThreadCount(size_t num_threads) {
+  // Like `CreateThreads` and `DeleteThreads`, this is not called concurrently with them, so
+  // `threads_` can be read without the lock.
+  if (GetThreadCount() == num_threads) {
+    return;
+  }
+  bool has_threads = GetThreadCount() != 0;
+  if (has_threads) {
+    DeleteThreads();
+  }
+  {
+    MutexLock mu(Thread::Current(), task_queue_lock_);
+    max_active_workers_ = num_threads;
+  }
+  if (has_threads) {
+    CreateThreads();
+  }
+}
+
 void JitThreadPool::Remove(JitCompileTask* task) {
   MutexLock mu(Thread::Current(), task_queue_lock_);
   current_compilations_.erase(task);
@@ -1888,6 +2278,89 @@ void JitThreadPool::Remove(JitCompileTask* task) {
   }
 }
 
+void JitThreadPool::DumpQueueStats(std::ostream& os) {
+  MutexLock mu(Thread::Current(), task_queue_lock_);
+  for (CompilationKind kind :
+       {CompilationKind::kOsr, CompilationKind::kBaseline, CompilationKind::kOptimized}) {
+    const QueueStats& stats = queue_stats_[static_cast<size_t>(kind)];
+    os << "JIT " << kind << " queue: requests=" << stats.requests
+       << " max depth=" << stats.max_depth;
+    if (stats.served != 0) {
+      os << " mean wait=" << PrettyDuration(stats.total_wait_ns / stats.served)
+         << " max wait=" << PrettyDuration(stats.max_wait_ns);
+    }
+    os << "\n";
+  }
+  os << "JIT optimized requests served ahead of baseline: " << aged_optimized_requests_ << "\n";
+  if (cpu_budget_ns_ != 0 || throttled_pauses_ != 0) {
+    os << "JIT CPU budget: " << PrettyDuration(cpu_budget_ns_) << " per second, throttled "
+       << throttled_pauses_ << " times for " << PrettyDuration(total_throttled_ns_) << "\n";
+  }
+}
+
+void JitThreadPool::SetCpuBudget(uint32_t budget_ms) {
+  Thread* self = Thread::Current();
+  MutexLock mu(self, task_queue_lock_);
+  cpu_budget_ns_ = MsToNs(budget_ms);
+  cpu_budget_window_start_ns_ = NanoTime();
+  cpu_budget_used_ns_ = 0;
+  paused_until_ns_ = 0;
+  // Resume workers paused under the previous budget.
+  task_queue_condition_.Broadcast(self);
+}
+
+void JitThreadPool::ChargeCpuTime(Thread* self, uint64_t cpu_ns) {
+  MutexLock mu(self, task_queue_lock_);
+  if (cpu_budget_ns_ == 0) {
+    return;
+  }
+  uint64_t now_ns = NanoTime();
+  uint64_t elapsed_windows = (now_ns - cpu_budget_window_start_ns_) / kCpuBudgetWindowNs;
+  if (elapsed_windows != 0) {
+    // Every window that passed pays back one budget of the time charged so far.
+    uint64_t refund_ns = elapsed_windows * cpu_budget_ns_;
+    cpu_budget_used_ns_ = (cpu_budget_used_ns_ > refund_ns) ? cpu_budget_used_ns_ - refund_ns : 0;
+    cpu_budget_window_start_ns_ += elapsed_windows * kCpuBudgetWindowNs;
+  }
+  cpu_budget_used_ns_ += cpu_ns;
+  if (cpu_budget_used_ns_ >= cpu_budget_ns_) {
+    // Pause until enough windows pass for the charged time to fit in the budget. A single
+    // compilation longer than the budget thus pauses the pool for several windows.
+    uint64_t windows_to_wait = cpu_budget_used_ns_ / cpu_budget_ns_;
+    paused_until_ns_ = cpu_budget_window_start_ns_ + windows_to_wait * kCpuBudgetWindowNs;
+  }
+}
+
+void JitThreadPool::WaitForCpuBudget(Thread* self) {
+  uint64_t pause_ns = 0;
+  {
+    MutexLock mu(self, task_queue_lock_);
+    uint64_t start_ns = NanoTime();
+    uint64_t now_ns = start_ns;
+    // The task queue condition is broadcast on shutdown and when the budget changes.
+    while (!IsShuttingDown() && now_ns < paused_until_ns_) {
+      uint64_t remaining_ns = paused_until_ns_ - now_ns;
+      task_queue_condition_.TimedWait(self,
+                                      static_cast<int64_t>(remaining_ns / MsToNs(1)),
+                                      static_cast<int32_t>(remaining_ns % MsToNs(1)));
+      now_ns = NanoTime();
+    }
+    if (now_ns == start_ns) {
+      return;
+    }
+    pause_ns = now_ns - start_ns;
+    total_throttled_ns_ += pause_ns;
+    throttled_pauses_++;
+    // We may have consumed a signal meant for an idle worker while paused.
+    if (waiting_count_ != 0 && HasOutstandingTasks()) {
+      task_queue_condition_.Signal(self);
+    }
+  }
+  metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+  metrics->JitThrottledTime()->Add(NsToUs(pause_ns));
+  metrics->JitThrottledTimeDelta()->Add(NsToUs(pause_ns));
+}
+
 void Jit::VisitRoots(RootVisitor* visitor) {
   if (thread_pool_ != nullptr) {
     thread_pool_->VisitRoots(visitor);
@@ -1909,9 +2382,12 @@ void JitThreadPool::VisitRoots(RootVisitor* visitor) {
     // - Generic tasks like `ZygoteVerificationTask` which don't hold any root.
     // - `JitCompileTask` for precompiled methods, which we know are live, being
     //   part of the boot classpath or system server classpath.
-    methods.insert(methods.end(), osr_queue_.begin(), osr_queue_.end());
-    methods.insert(methods.end(), baseline_queue_.begin(), baseline_queue_.end());
-    methods.insert(methods.end(), optimized_queue_.begin(), optimized_queue_.end());
+    for (const std::deque<QueuedMethod>* queue :
+         {&osr_queue_, &baseline_queue_, &optimized_queue_}) {
+      for (const QueuedMethod& queued : *queue) {
+        methods.push_back(queued.method);
+      }
+    }
     for (JitCompileTask* task : current_compilations_) {
       methods.push_back(task->GetArtMethod());
     }
@@ -17,13 +17,18 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include <deque>
+#include <set>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <android-base/unique_fd.h>
 
 #include "base/histogram-inl.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
 #include "compilation_kind.h"
 #include "handle.h"
@@ -137,6 +142,24 @@ class JitThreadPool : public AbstractThreadPool {
   // Visit the ArtMethods stored in the various queues.
   void VisitRoots(RootVisitor* visitor);
 
+  // Set the number of threads of the pool. If the pool currently has threads, they are
+  // recreated, otherwise the count takes effect at the next CreateThreads().
+  void SetThreadCount(size_t num_threads) REQUIRES(!task_queue_lock_);
+
+  // Dump how many compilation requests each queue received and how long they waited.
+  void DumpQueueStats(std::ostream& os) REQUIRES(!task_queue_lock_);
+
+  // Limit the CPU time the workers spend compiling, all together, to `budget_ms` milliseconds
+  // per wall-clock second. Zero means unlimited.
+  void SetCpuBudget(uint32_t budget_ms) REQUIRES(!task_queue_lock_);
+
+  // Charge `cpu_ns` of compilation to the CPU budget. When the budget is exhausted, the pool is
+  // paused until the compilation time used so far fits in the budget again.
+  void ChargeCpuTime(Thread* self, uint64_t cpu_ns) REQUIRES(!task_queue_lock_);
+
+  // Block until the pool is resumed, if the CPU budget paused it.
+  void WaitForCpuBudget(Thread* self) REQUIRES(!task_queue_lock_);
+
  protected:
   Task* TryGetTaskLocked() REQUIRES(task_queue_lock_) override;
 
@@ -155,14 +178,65 @@ class JitThreadPool : public AbstractThreadPool {
       // We need peers as we may report the JIT thread, e.g., in the debugger.
       : AbstractThreadPool(name, num_threads, /* create_peers= */ true, worker_stack_size) {}
 
-  // Try to fetch an entry from `methods`. Return null if `methods` is empty.
-  Task* FetchFrom(std::deque<ArtMethod*>& methods, CompilationKind kind) REQUIRES(task_queue_lock_);
+  // Optimized requests that waited longer than this are served before baseline requests, so
+  // that a steady stream of baseline requests cannot starve the hottest methods.
+  static constexpr uint64_t kMaxOptimizedQueueWaitNs = MsToNs(100);
+
+  // The wall-clock period the CPU budget applies to.
+  static constexpr uint64_t kCpuBudgetWindowNs = MsToNs(1000);
+
+  // A method waiting to be compiled, and when it was enqueued.
+  struct QueuedMethod {
+    ArtMethod* method;
+    uint64_t enqueue_time_ns;
+  };
+
+  struct QueueStats {
+    size_t requests = 0;
+    size_t served = 0;
+    size_t max_depth = 0;
+    uint64_t total_wait_ns = 0;
+    uint64_t max_wait_ns = 0;
+  };
+
+  static constexpr size_t kNumCompilationKinds = 3;
+
+  // Try to fetch an entry from `methods`, skipping methods that another worker is compiling.
+  // Return null if there is no such entry.
+  Task* FetchFrom(std::deque<QueuedMethod>& methods, CompilationKind kind, uint64_t now_ns)
+      REQUIRES(task_queue_lock_);
+
+  // Whether a worker is currently compiling `method`, with any compilation kind.
+  bool IsBeingCompiled(ArtMethod* method) const REQUIRES(task_queue_lock_);
+
+  // Enqueue `method` in `methods` and `enqueued_methods`.
+  void Enqueue(std::deque<QueuedMethod>& methods,
+               std::set<ArtMethod*>& enqueued_methods,
+               ArtMethod* method,
+               CompilationKind kind) REQUIRES(task_queue_lock_);
 
   std::deque<Task*> generic_queue_ GUARDED_BY(task_queue_lock_);
 
-  std::deque<ArtMethod*> osr_queue_ GUARDED_BY(task_queue_lock_);
-  std::deque<ArtMethod*> baseline_queue_ GUARDED_BY(task_queue_lock_);
-  std::deque<ArtMethod*> optimized_queue_ GUARDED_BY(task_queue_lock_);
+  std::deque<QueuedMethod> osr_queue_ GUARDED_BY(task_queue_lock_);
+  std::deque<QueuedMethod> baseline_queue_ GUARDED_BY(task_queue_lock_);
+  std::deque<QueuedMethod> optimized_queue_ GUARDED_BY(task_queue_lock_);
+
+  // Statistics for each queue, indexed by CompilationKind.
+  QueueStats queue_stats_[kNumCompilationKinds] GUARDED_BY(task_queue_lock_);
+  // Number of optimized requests served ahead of pending baseline requests because they aged.
+  size_t aged_optimized_requests_ GUARDED_BY(task_queue_lock_) = 0;
+
+  // CPU budget per `kCpuBudgetWindowNs`, zero when unlimited.
+  uint64_t cpu_budget_ns_ GUARDED_BY(task_queue_lock_) = 0;
+  // Start of the current budget window, and the compilation time charged to it. The charged
+  // time can exceed the budget, in which case the excess is paid by the following windows.
+  uint64_t cpu_budget_window_start_ns_ GUARDED_BY(task_queue_lock_) = 0;
+  uint64_t cpu_budget_used_ns_ GUARDED_BY(task_queue_lock_) = 0;
+  // Workers do not start new compilations before this time.
+  uint64_t paused_until_ns_ GUARDED_BY(task_queue_lock_) = 0;
+  // Time workers spent paused by the CPU budget, and how many times they were.
+  uint64_t total_throttled_ns_ GUARDED_BY(task_queue_lock_) = 0;
+  size_t throttled_pauses_ GUARDED_BY(task_queue_lock_) = 0;
 
   // We track the methods that are currently enqueued to avoid
   // adding them to the queue multiple times, which could bloat the
@@ -221,6 +295,17 @@ class Jit {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Records a successful compilation of `method`. Compile time and code size are reported to
+  // the metrics, and the slowest compilations are kept for `DumpForSigQuit()`.
+  void AddCompilationRecord(ArtMethod* method,
+                            CompilationKind kind,
+                            uint32_t graph_size,
+                            uint32_t inlined_invokes,
+                            uint64_t compile_time_us,
+                            size_t code_size)
+      REQUIRES(!lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   int GetThreadPoolPthreadPriority() const {
     return options_->GetThreadPoolPthreadPriority();
   }
@@ -362,6 +447,15 @@ class Jit {
                                          Handle<mirror::ClassLoader> class_loader,
                                          bool add_to_queue);
 
+  // Queue compilation of the hot and startup methods that `profile_path`, typically saved by a
+  // previous run of this process, lists for `dex_files`. Methods that already have compiled code
+  // are skipped.
+  // Return the number of methods added to the queue.
+  uint32_t EnqueueMethodsFromWarmStartProfile(Thread* self,
+                                              const std::vector<const DexFile*>& dex_files,
+                                              const std::string& profile_path,
+                                              Handle<mirror::ClassLoader> class_loader);
+
   // Register the dex files to the JIT. This is to perform any compilation/optimization
   // at the point of loading the dex files.
   void RegisterDexFiles(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
@@ -396,6 +490,12 @@ class Jit {
  private:
   Jit(JitCodeCache* code_cache, JitOptions* options);
 
+  // Number of compiler threads to use outside of the zygote.
+  size_t GetNumberOfCompilerThreads() const;
+
+  // CPU budget of the compiler threads outside of the zygote, in milliseconds per second.
+  uint32_t GetCpuBudgetMs() const;
+
   // Whether we should not add hotness counts for the given method.
   bool IgnoreSamplesForMethod(ArtMethod* method)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -442,6 +542,20 @@ class Jit {
   Histogram<uint64_t> memory_use_ GUARDED_BY(lock_);
   Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
 
+  // A compilation kept in `slowest_compilations_`. The method name is stored rather than the
+  // method, as the method may be unloaded before the record is dumped.
+  struct CompilationRecord {
+    std::string method_name;
+    CompilationKind kind;
+    uint32_t graph_size;
+    uint32_t inlined_invokes;
+    uint64_t compile_time_us;
+    size_t code_size;
+  };
+  static constexpr size_t kMaxCompilationRecords = 16;
+  // The `kMaxCompilationRecords` slowest compilations, in no particular order.
+  std::vector<CompilationRecord> slowest_compilations_ GUARDED_BY(lock_);
+
   // In the JIT zygote configuration, after all compilation is done, the zygote
   // will copy its contents of the boot image to the zygote_mapping_methods_,
   // which will be picked up by processes that will map the memory
@@ -16,6 +16,7 @@
 
 #include "jit_code_cache.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <android-base/logging.h>
@@ -51,12 +52,14 @@
 #include "jit/jit_scoped_code_cache_write.h"
 #include "linear_alloc.h"
 #include "mirror/method_type.h"
+#include "oat/jni_stub_hash_map-inl.h"
 #include "oat/oat_file-inl.h"
 #include "oat/oat_quick_method_header.h"
 #include "object_callbacks.h"
 #include "profile/profile_compilation_info.h"
 #include "scoped_thread_state_change-inl.h"
 #include "stack.h"
+#include "stack_map_cache.h"
 #include "thread-current-inl.h"
 #include "thread-inl.h"
 #include "thread_list.h"
@@ -68,53 +71,6 @@ namespace jit {
 static constexpr size_t kCodeSizeLogThreshold = 50 * KB;
 static constexpr size_t kStackMapSizeLogThreshold = 50 * KB;
 
-class JitCodeCache::JniStubKey {
- public:
-  explicit JniStubKey(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_)
-      : shorty_(method->GetShorty()),
-        is_static_(method->IsStatic()),
-        is_fast_native_(method->IsFastNative()),
-        is_critical_native_(method->IsCriticalNative()),
-        is_synchronized_(method->IsSynchronized()) {
-    DCHECK(!(is_fast_native_ && is_critical_native_));
-  }
-
-  bool operator<(const JniStubKey& rhs) const {
-    if (is_static_ != rhs.is_static_) {
-      return rhs.is_static_;
-    }
-    if (is_synchronized_ != rhs.is_synchronized_) {
-      return rhs.is_synchronized_;
-    }
-    if (is_fast_native_ != rhs.is_fast_native_) {
-      return rhs.is_fast_native_;
-    }
-    if (is_critical_native_ != rhs.is_critical_native_) {
-      return rhs.is_critical_native_;
-    }
-    return strcmp(shorty_, rhs.shorty_) < 0;
-  }
-
-  // Update the shorty to point to another method's shorty. Call this function when removing
-  // the method that references the old shorty from JniCodeData and not removing the entire
-  // JniCodeData; the old shorty may become a dangling pointer when that method is unloaded.
-  void UpdateShorty(ArtMethod* method) const REQUIRES_SHARED(Locks::mutator_lock_) {
-    const char* shorty = method->GetShorty();
-    DCHECK_STREQ(shorty_, shorty);
-    shorty_ = shorty;
-  }
-
- private:
-  // The shorty points to a DexFile data and may need to change
-  // to point to the same shorty in a different DexFile.
-  mutable const char* shorty_;
-
-  const bool is_static_;
-  const bool is_fast_native_;
-  const bool is_critical_native_;
-  const bool is_synchronized_;
-};
-
 class JitCodeCache::JniStubData {
  public:
   JniStubData() : code_(nullptr), methods_() {}
@@ -262,6 +218,7 @@ JitCodeCache::JitCodeCache()
       inline_cache_cond_("Jit inline cache condition variable", *Locks::jit_lock_),
       reserved_capacity_(GetInitialCapacity() * kReservedCapacityMultiplier),
       zygote_map_(&shared_region_),
+      jni_stubs_map_(JniStubKeyHash(kRuntimeISA), JniStubKeyEquals(kRuntimeISA)),
       lock_cond_("Jit code cache condition variable", *Locks::jit_lock_),
       collection_in_progress_(false),
       garbage_collect_code_(true),
@@ -269,6 +226,7 @@ JitCodeCache::JitCodeCache()
       number_of_optimized_compilations_(0),
       number_of_osr_compilations_(0),
       number_of_collections_(0),
+      number_of_cha_invalidations_(0),
       histogram_stack_map_memory_use_("Memory used for stack maps", 16),
       histogram_code_memory_use_("Memory used for compiled code", 16),
       histogram_profiling_info_memory_use_("Memory used for profiling info", 16) {
@@ -474,6 +432,10 @@ void JitCodeCache::SweepRootTables(IsMarkedVisitor* visitor) {
           mirror::Class* new_klass = down_cast<mirror::Class*>(visitor->IsMarked(klass));
           if (new_klass != klass) {
             cache->classes_[j] = GcRoot<mirror::Class>(new_klass);
+            if (new_klass == nullptr) {
+              // Do not attribute the samples to the class that takes the entry next.
+              cache->counts_[j] = 0u;
+            }
           }
         }
       }
@@ -507,9 +469,13 @@ void JitCodeCache::FreeAllMethodHeaders(
         ->RemoveDependentsWithMethodHeaders(method_headers);
   }
 
+  // Stack walks cache decoded stack maps keyed by the method header.
+  StackMapCache::InvalidateAll();
+
   {
     ScopedCodeCacheWrite scc(private_region_);
     for (const OatQuickMethodHeader* method_header : method_headers) {
+      class_dependencies_.erase(method_header->GetCode());
       FreeCodeAndData(method_header->GetCode());
     }
 
@@ -564,7 +530,7 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
         method_headers.insert(OatQuickMethodHeader::FromCodePointer(it->second.GetCode()));
         it = jni_stubs_map_.erase(it);
       } else {
-        it->first.UpdateShorty(it->second.GetMethods().front());
+        it->first.UpdateShorty(it->second.GetMethods().front()->GetShortyView());
         ++it;
       }
     }
@@ -607,6 +573,14 @@ void JitCodeCache::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
     }
   }
 
+  for (auto it = cha_invalidations_.begin(); it != cha_invalidations_.end();) {
+    if (alloc.ContainsUnsafe(it->first)) {
+      it = cha_invalidations_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   for (auto it = profiling_infos_.begin(); it != profiling_infos_.end();) {
     ProfilingInfo* info = it->second;
     if (alloc.ContainsUnsafe(info->GetMethod())) {
@@ -692,7 +666,8 @@ bool JitCodeCache::Commit(Thread* self,
                           const std::vector<uint8_t>& debug_info,
                           bool is_full_debug_info,
                           CompilationKind compilation_kind,
-                          const ArenaSet<ArtMethod*>& cha_single_implementation_list) {
+                          const ArenaSet<ArtMethod*>& cha_single_implementation_list,
+                          const ArenaSet<uint32_t>& class_dependencies) {
   DCHECK_IMPLIES(method->IsNative(), (compilation_kind != CompilationKind::kOsr));
 
   if (!method->IsNative()) {
@@ -701,6 +676,12 @@ bool JitCodeCache::Commit(Thread* self,
     DCheckRootsAreValid(roots, IsSharedRegion(*region));
   }
 
+  // The code also depends on the class of the compiled method.
+  std::vector<uint32_t> dependencies(class_dependencies.begin(), class_dependencies.end());
+  if (!dependencies.empty()) {
+    dependencies.push_back(method->GetDeclaringClass()->DescriptorHash());
+  }
+
   const uint8_t* roots_data = reserved_data.data();
   size_t root_table_size = ComputeRootTableSize(roots.size());
   const uint8_t* stack_map_data = roots_data + root_table_size;
@@ -789,6 +770,9 @@ bool JitCodeCache::Commit(Thread* self,
         ScopedDebugDisallowReadBarriers sddrb(self);
         WriterMutexLock mu2(self, *Locks::jit_mutator_lock_);
         method_code_map_.Put(code_ptr, method);
+        if (!dependencies.empty()) {
+          class_dependencies_.Overwrite(code_ptr, std::move(dependencies));
+        }
 
         // Searching for MethodType-s in roots. They need to be treated as strongly reachable while
         // the corresponding ArtMethod is not removed.
@@ -893,7 +877,7 @@ bool JitCodeCache::RemoveMethodLocked(ArtMethod* method, bool release_memory) {
         jni_stubs_map_.erase(it);
         zombie_jni_code_.erase(method);
       } else {
-        it->first.UpdateShorty(it->second.GetMethods().front());
+        it->first.UpdateShorty(it->second.GetMethods().front()->GetShortyView());
       }
     }
   } else {
@@ -1314,6 +1298,20 @@ void JitCodeCache::MaybeUpdateInlineCache(ArtMethod* method,
   info->AddInvokeInfo(dex_pc, cls.Ptr());
 }
 
+void JitCodeCache::MaybeAddReceiverSample(ArtMethod* method,
+                                          uint32_t dex_pc,
+                                          ObjPtr<mirror::Class> cls,
+                                          Thread* self) {
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  auto it = profiling_infos_.find(method);
+  if (it == profiling_infos_.end()) {
+    return;
+  }
+  ScopedAssertNoThreadSuspension sants("ProfilingInfo");
+  it->second->AddReceiverSample(dex_pc, cls.Ptr());
+}
+
 void JitCodeCache::DoCollection(Thread* self) {
   ScopedTrace trace(__FUNCTION__);
 
@@ -1515,6 +1513,19 @@ void* JitCodeCache::MoreCore(const void* mspace, intptr_t increment) {
       : private_region_.MoreCore(mspace, increment);
 }
 
+void JitCodeCache::GetBootMethodsForSharedRegion(std::vector<ArtMethod*>* methods) {
+  Thread* self = Thread::Current();
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  ReaderMutexLock mu(self, *Locks::jit_mutator_lock_);
+  for (const auto& it : method_code_map_) {  // Includes OSR methods.
+    ArtMethod* method = it.second;
+    if (heap->ObjectIsInBootImageSpace(method->GetDeclaringClass()) &&
+        !zygote_map_.ContainsMethod(method)) {
+      methods->push_back(method);
+    }
+  }
+}
+
 void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_locations,
                                       std::vector<ProfileMethodInfo>& methods,
                                       uint16_t inline_cache_threshold) {
@@ -1574,8 +1585,14 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
 
       for (size_t i = 0; i < info->number_of_inline_caches_; ++i) {
         std::vector<TypeReference> profile_classes;
+        std::vector<uint32_t> profile_counts;
+        bool has_counts = false;
         const InlineCache& cache = info->GetInlineCaches()[i];
         ArtMethod* caller = info->GetMethod();
+        if (InlineCache::IsTypeCheckDexPc(caller, cache.dex_pc_)) {
+          // Type check profiles are only used by the JIT, the profile only has invokes.
+          continue;
+        }
         bool is_missing_types = false;
         for (size_t k = 0; k < InlineCache::kIndividualCacheSize; k++) {
           mirror::Class* cls = cache.classes_[k].Read();
@@ -1616,13 +1633,22 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
             // Only consider classes from the same apk (including multidex).
             profile_classes.emplace_back(/*ProfileMethodInfo::ProfileClassReference*/
                 class_dex_file, type_index);
+            profile_counts.push_back(cache.counts_[k]);
+            has_counts = has_counts || cache.counts_[k] != 0u;
           } else {
             is_missing_types = true;
           }
         }
         if (!profile_classes.empty()) {
+          if (!has_counts) {
+            profile_counts.clear();
+          }
           inline_caches.emplace_back(/*ProfileMethodInfo::ProfileInlineCache*/
-              cache.dex_pc_, is_missing_types, profile_classes);
+              cache.dex_pc_,
+              is_missing_types,
+              profile_classes,
+              /*megamorphic=*/ false,
+              profile_counts);
         }
       }
     }
@@ -1631,6 +1657,23 @@ void JitCodeCache::GetProfiledMethods(const std::set<std::string>& dex_base_loca
   }
 }
 
+void JitCodeCache::ClearReceiverSamples(const std::set<std::string>& dex_base_locations) {
+  Thread* self = Thread::Current();
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  MutexLock mu(self, *Locks::jit_lock_);
+  for (const auto& [method, info] : profiling_infos_) {
+    const DexFile* dex_file = method->GetDexFile();
+    if (!ContainsElement(dex_base_locations,
+                         DexFileLoader::GetBaseLocation(dex_file->GetLocation()))) {
+      continue;
+    }
+    InlineCache* caches = info->GetInlineCaches();
+    for (size_t i = 0; i < info->number_of_inline_caches_; ++i) {
+      std::fill_n(caches[i].counts_, InlineCache::kIndividualCacheSize, 0u);
+    }
+  }
+}
+
 bool JitCodeCache::IsOsrCompiled(ArtMethod* method) {
   Thread* self = Thread::Current();
   ScopedDebugDisallowReadBarriers sddrb(self);
@@ -1688,7 +1731,7 @@ bool JitCodeCache::NotifyCompilationOf(ArtMethod* method,
     bool new_compilation = false;
     if (it == jni_stubs_map_.end()) {
       // Create a new entry to mark the stub as being compiled.
-      it = jni_stubs_map_.Put(key, JniStubData{});
+      it = jni_stubs_map_.insert(std::make_pair(key, JniStubData{})).first;
       new_compilation = true;
     }
     JniStubData* data = &it->second;
@@ -1798,6 +1841,57 @@ void JitCodeCache::InvalidateAllCompiledCode() {
   }
 }
 
+size_t JitCodeCache::InvalidateCompiledCodeDependingOn(
+    const std::unordered_set<uint32_t>& descriptor_hashes) {
+  Thread* self = Thread::Current();
+  ScopedDebugDisallowReadBarriers sddrb(self);
+  Runtime* runtime = Runtime::Current();
+  ClassLinker* linker = runtime->GetClassLinker();
+  instrumentation::Instrumentation* instr = runtime->GetInstrumentation();
+
+  std::vector<const void*> dependent_code;
+  {
+    MutexLock mu(self, *Locks::jit_lock_);
+    for (const auto& [code_ptr, hashes] : class_dependencies_) {
+      if (std::any_of(hashes.begin(), hashes.end(), [&](uint32_t hash) {
+            return descriptor_hashes.find(hash) != descriptor_hashes.end();
+          })) {
+        dependent_code.push_back(code_ptr);
+      }
+    }
+  }
+
+  size_t invalidated = 0;
+  WriterMutexLock mu(self, *Locks::jit_mutator_lock_);
+  for (const void* code_ptr : dependent_code) {
+    auto it = method_code_map_.find(code_ptr);
+    if (it == method_code_map_.end()) {
+      continue;
+    }
+    ArtMethod* meth = it->second;
+    VLOG(jit) << "Invalidating compiled code of " << meth->PrettyMethod()
+              << " as it depends on redefined classes";
+    const void* entry_point = OatQuickMethodHeader::FromCodePointer(code_ptr)->GetEntryPoint();
+    if (meth->GetEntryPointFromQuickCompiledCode() == entry_point) {
+      if (UNLIKELY(meth->IsObsolete())) {
+        linker->SetEntryPointsForObsoleteMethod(meth);
+      } else {
+        instr->InitializeMethodsCode(meth, /*aot_code=*/ nullptr);
+      }
+    }
+    auto osr_it = osr_code_map_.find(meth);
+    if (osr_it != osr_code_map_.end() && osr_it->second == code_ptr) {
+      osr_code_map_.erase(osr_it);
+    }
+    auto saved_it = saved_compiled_methods_map_.find(meth);
+    if (saved_it != saved_compiled_methods_map_.end() && saved_it->second == code_ptr) {
+      saved_compiled_methods_map_.erase(saved_it);
+    }
+    ++invalidated;
+  }
+  return invalidated;
+}
+
 void JitCodeCache::InvalidateCompiledCodeFor(ArtMethod* method,
                                              const OatQuickMethodHeader* header) {
   DCHECK(!method->IsNative());
@@ -1826,6 +1920,22 @@ void JitCodeCache::InvalidateCompiledCodeFor(ArtMethod* method,
   }
 }
 
+void JitCodeCache::RecordChaInvalidation(ArtMethod* method) {
+  MutexLock mu(Thread::Current(), *Locks::jit_lock_);
+  ++number_of_cha_invalidations_;
+  uint32_t count = ++cha_invalidations_.GetOrCreate(method, []() { return 0u; });
+  if (count == kMaxChaInvalidations) {
+    VLOG(jit) << "Not using CHA anymore when compiling " << method->PrettyMethod()
+              << ", its code was invalidated " << count << " times";
+  }
+}
+
+bool JitCodeCache::CanUseChaFor(ArtMethod* method) {
+  MutexLock mu(Thread::Current(), *Locks::jit_lock_);
+  auto it = cha_invalidations_.find(method);
+  return it == cha_invalidations_.end() || it->second < kMaxChaInvalidations;
+}
+
 void JitCodeCache::Dump(std::ostream& os) {
   MutexLock mu(Thread::Current(), *Locks::jit_lock_);
   os << "Current JIT code cache size (used / resident): "
@@ -1834,6 +1944,10 @@ void JitCodeCache::Dump(std::ostream& os) {
      << "Current JIT data cache size (used / resident): "
      << GetCurrentRegion()->GetUsedMemoryForData() / KB << "KB / "
      << GetCurrentRegion()->GetResidentMemoryForData() / KB << "KB\n";
+  JitMemoryRegion::CodeFragmentation fragmentation = GetCurrentRegion()->GetCodeFragmentation();
+  os << "Current JIT code cache pages with code: " << fragmentation.code_pages
+     << ", free chunks: " << fragmentation.free_chunks
+     << ", largest free chunk: " << PrettySize(fragmentation.largest_free_chunk) << "\n";
   if (!Runtime::Current()->IsZygote()) {
     os << "Zygote JIT code cache size (at point of fork): "
        << shared_region_.GetUsedMemoryForCode() / KB << "KB / "
@@ -1851,7 +1965,13 @@ void JitCodeCache::Dump(std::ostream& os) {
      << "Total number of JIT optimized compilations: " << number_of_optimized_compilations_ << "\n"
      << "Total number of JIT compilations for on stack replacement: "
         << number_of_osr_compilations_ << "\n"
-     << "Total number of JIT code cache collections: " << number_of_collections_ << std::endl;
+     << "Total number of JIT code cache collections: " << number_of_collections_ << "\n"
+     << "Total number of JIT code invalidations by CHA: " << number_of_cha_invalidations_
+        << " (methods no longer using CHA: "
+        << std::count_if(cha_invalidations_.begin(),
+                         cha_invalidations_.end(),
+                         [](const auto& entry) { return entry.second >= kMaxChaInvalidations; })
+        << ")" << std::endl;
   histogram_stack_map_memory_use_.PrintMemoryUse(os);
   histogram_code_memory_use_.PrintMemoryUse(os);
   histogram_profiling_info_memory_use_.PrintMemoryUse(os);
@@ -36,6 +36,7 @@
 #include "base/safe_map.h"
 #include "compilation_kind.h"
 #include "jit_memory_region.h"
+#include "oat/jni_stub_hash_map.h"
 #include "profiling_info.h"
 
 namespace art HIDDEN {
@@ -184,6 +185,10 @@ class JitCodeCache {
  public:
   static constexpr size_t kMaxCapacity = 64 * MB;
 
+  // After that many invalidations of its code by class hierarchy analysis, a method is compiled
+  // without CHA-based devirtualization.
+  static constexpr uint32_t kMaxChaInvalidations = 3;
+
   // Default initial capacity of the JIT code cache.
   static size_t GetInitialCapacity() {
     // This function is called during static initialization
@@ -266,6 +271,9 @@ class JitCodeCache {
   // single-implementation assumptions are violated later. This needs to be done
   // even if `has_should_deoptimize_flag` is false, which can happen due to CHA
   // guard elimination.
+  //
+  // `class_dependencies` holds the descriptor hashes of the classes the code
+  // depends on, see `InvalidateCompiledCodeDependingOn`.
   bool Commit(Thread* self,
               JitMemoryRegion* region,
               ArtMethod* method,
@@ -277,7 +285,8 @@ class JitCodeCache {
               const std::vector<uint8_t>& debug_info,
               bool is_full_debug_info,
               CompilationKind compilation_kind,
-              const ArenaSet<ArtMethod*>& cha_single_implementation_list)
+              const ArenaSet<ArtMethod*>& cha_single_implementation_list,
+              const ArenaSet<uint32_t>& class_dependencies)
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(!Locks::jit_lock_);
 
@@ -342,14 +351,44 @@ class JitCodeCache {
                                  uint16_t inline_cache_threshold) REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Collects the boot image methods compiled in the private region of this process, which the
+  // zygote could compile in the shared region instead.
+  void GetBootMethodsForSharedRegion(std::vector<ArtMethod*>* methods)
+      REQUIRES(!Locks::jit_mutator_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Resets the receiver samples of the methods in the given dex locations, after the profile
+  // saver has recorded the samples reported by `GetProfiledMethods`.
+  void ClearReceiverSamples(const std::set<std::string>& dex_base_locations)
+      REQUIRES(!Locks::jit_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   EXPORT void InvalidateAllCompiledCode()
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Invalidate the compiled code that the compiler recorded as depending on a class whose
+  // descriptor hash is in `descriptor_hashes`, e.g. because the classes are being structurally
+  // redefined. The other compiled code is kept. Returns the number of invalidated methods.
+  EXPORT size_t InvalidateCompiledCodeDependingOn(
+      const std::unordered_set<uint32_t>& descriptor_hashes)
+      REQUIRES(!Locks::jit_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void InvalidateCompiledCodeFor(ArtMethod* method, const OatQuickMethodHeader* code)
       REQUIRES(!Locks::jit_lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record that compiled code of `method` was invalidated because a class hierarchy analysis
+  // assumption it relied on no longer holds.
+  void RecordChaInvalidation(ArtMethod* method)
+      REQUIRES(!Locks::jit_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Whether code compiled for `method` may rely on class hierarchy analysis. Returns false once
+  // code of `method` has been invalidated by CHA `kMaxChaInvalidations` times.
+  bool CanUseChaFor(ArtMethod* method) REQUIRES(!Locks::jit_lock_);
+
   void Dump(std::ostream& os) REQUIRES(!Locks::jit_lock_);
   void DumpAllCompiledMethods(std::ostream& os)
       REQUIRES(!Locks::jit_lock_)
@@ -426,6 +465,14 @@ class JitCodeCache {
                               Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record a sampled receiver of class `cls` for the call at `dex_pc` in `method`.
+  void MaybeAddReceiverSample(ArtMethod* method,
+                              uint32_t dex_pc,
+                              ObjPtr<mirror::Class> cls,
+                              Thread* self)
+      REQUIRES(!Locks::jit_lock_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // NO_THREAD_SAFETY_ANALYSIS because we may be called with the JIT lock held
   // or not. The implementation of this method handles the two cases.
   void AddZombieCode(ArtMethod* method, const void* code_ptr) NO_THREAD_SAFETY_ANALYSIS;
@@ -513,7 +560,6 @@ class JitCodeCache {
 
   EXPORT const uint8_t* GetRootTable(const void* code_ptr, uint32_t* number_of_roots = nullptr);
 
-  class JniStubKey;
   class JniStubData;
 
   // Whether the GC allows accessing weaks in inline caches. Note that this
@@ -548,8 +594,9 @@ class JitCodeCache {
   // The GC must ensure that methods in these maps are cleaned up with `RemoveMethodsIn()`
   // before the declaring class memory is freed.
 
-  // Holds compiled code associated with the shorty for a JNI stub.
-  SafeMap<JniStubKey, JniStubData> jni_stubs_map_ GUARDED_BY(Locks::jit_mutator_lock_);
+  // Holds compiled code associated with the shorty for a JNI stub. Methods with different
+  // shorties share a stub if the stub code would be the same for the instruction set.
+  JniStubHashMap<JniStubData> jni_stubs_map_ GUARDED_BY(Locks::jit_mutator_lock_);
 
   // Holds compiled code associated to the ArtMethod.
   SafeMap<const void*, ArtMethod*> method_code_map_ GUARDED_BY(Locks::jit_mutator_lock_);
@@ -612,6 +659,17 @@ class JitCodeCache {
   // Number of code cache collections done throughout the lifetime of the JIT.
   size_t number_of_collections_ GUARDED_BY(Locks::jit_lock_);
 
+  // Number of times compiled code was invalidated by class hierarchy analysis.
+  size_t number_of_cha_invalidations_ GUARDED_BY(Locks::jit_lock_);
+
+  // For methods whose compiled code was invalidated by class hierarchy analysis, how many times
+  // that happened.
+  SafeMap<ArtMethod*, uint32_t> cha_invalidations_ GUARDED_BY(Locks::jit_lock_);
+
+  // For compiled code in `method_code_map_` that the compiler recorded class dependencies for, the
+  // descriptor hashes of those classes.
+  SafeMap<const void*, std::vector<uint32_t>> class_dependencies_ GUARDED_BY(Locks::jit_lock_);
+
   // Histograms for keeping track of stack map size statistics.
   Histogram<uint64_t> histogram_stack_map_memory_use_ GUARDED_BY(Locks::jit_lock_);
 
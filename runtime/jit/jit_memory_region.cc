@@ -19,6 +19,8 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include <android-base/unique_fd.h>
 #include <log/log.h>
 #include "base/bit_utils.h"  // For RoundDown, RoundUp
@@ -473,6 +475,46 @@ const uint8_t* JitMemoryRegion::AllocateCode(size_t size) {
   return reinterpret_cast<uint8_t*>(GetExecutableAddress(result));
 }
 
+namespace {
+
+struct CodeFragmentationVisitor {
+  JitMemoryRegion::CodeFragmentation fragmentation;
+  // Last page counted in `code_pages`, so that allocations sharing a page count it once.
+  uintptr_t last_code_page = 0;
+};
+
+// Callback for mspace_inspect_all. Chunks are visited in address order.
+void CodeFragmentationCallback(void* start, void* end, size_t used_bytes, void* arg) {
+  CodeFragmentationVisitor* visitor = reinterpret_cast<CodeFragmentationVisitor*>(arg);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(start);
+  uintptr_t limit = reinterpret_cast<uintptr_t>(end);
+  if (used_bytes == 0) {
+    visitor->fragmentation.free_chunks++;
+    visitor->fragmentation.largest_free_chunk =
+        std::max(visitor->fragmentation.largest_free_chunk, limit - begin);
+    return;
+  }
+  uintptr_t first_page = RoundDown(begin, gPageSize);
+  uintptr_t last_page = RoundDown(limit - 1, gPageSize);
+  if (first_page == visitor->last_code_page && visitor->fragmentation.code_pages != 0) {
+    first_page += gPageSize;
+  }
+  if (last_page >= first_page) {
+    visitor->fragmentation.code_pages += (last_page - first_page) / gPageSize + 1;
+  }
+  visitor->last_code_page = last_page;
+}
+
+}  // namespace
+
+JitMemoryRegion::CodeFragmentation JitMemoryRegion::GetCodeFragmentation() {
+  CodeFragmentationVisitor visitor;
+  if (exec_mspace_ != nullptr) {
+    mspace_inspect_all(exec_mspace_, CodeFragmentationCallback, &visitor);
+  }
+  return visitor.fragmentation;
+}
+
 void JitMemoryRegion::FreeCode(const uint8_t* code) {
   code = GetNonExecutableAddress(code);
   used_memory_for_code_ -= mspace_usable_size(code);
@@ -171,6 +171,15 @@ class JitMemoryRegion {
     return exec_end_;
   }
 
+  // How scattered the code is in the code mspace.
+  struct CodeFragmentation {
+    size_t free_chunks = 0;
+    size_t largest_free_chunk = 0;
+    // Number of pages holding at least part of a code allocation.
+    size_t code_pages = 0;
+  };
+  CodeFragmentation GetCodeFragmentation() REQUIRES(Locks::jit_lock_);
+
   size_t GetUsedMemoryForData() const REQUIRES(Locks::jit_lock_) {
     return used_memory_for_data_;
   }
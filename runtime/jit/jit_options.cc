@@ -57,6 +57,15 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.Exists(RuntimeArgumentMap::DumpJITInfoOnShutdown);
   jit_options->profile_saver_options_ =
       options.GetOrDefault(RuntimeArgumentMap::ProfileSaverOpts);
+  jit_options->warm_start_profile_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITWarmStartProfile);
+  jit_options->zygote_shared_profile_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITZygoteSharedProfile);
+  jit_options->thread_pool_threads_ =
+      std::max(options.GetOrDefault(RuntimeArgumentMap::JITPoolThreads), 1u);
+  if (options.Exists(RuntimeArgumentMap::JITCpuBudget)) {
+    jit_options->cpu_budget_ms_ = *options.Get(RuntimeArgumentMap::JITCpuBudget);
+  }
   jit_options->thread_pool_pthread_priority_ =
       options.GetOrDefault(RuntimeArgumentMap::JITPoolThreadPthreadPriority);
   jit_options->zygote_thread_pool_pthread_priority_ =
@@ -17,6 +17,9 @@
 #ifndef ART_RUNTIME_JIT_JIT_OPTIONS_H_
 #define ART_RUNTIME_JIT_JIT_OPTIONS_H_
 
+#include <optional>
+#include <string>
+
 #include "base/macros.h"
 #include "base/runtime_debug.h"
 #include "profile_saver_options.h"
@@ -73,10 +76,32 @@ class JitOptions {
     return profile_saver_options_;
   }
 
+  // Profile whose methods are precompiled when matching dex files are registered with the JIT.
+  // Empty if disabled.
+  const std::string& GetWarmStartProfile() const {
+    return warm_start_profile_;
+  }
+
+  // Profile written by the system server with the boot classpath methods it JIT-compiled, and
+  // read by the primary zygote to compile them in the shared region. Empty if disabled.
+  const std::string& GetZygoteSharedProfile() const {
+    return zygote_shared_profile_;
+  }
+
   bool GetSaveProfilingInfo() const {
     return profile_saver_options_.IsEnabled();
   }
 
+  size_t GetThreadPoolThreads() const {
+    return thread_pool_threads_;
+  }
+
+  // The CPU time, in milliseconds per wall-clock second, that the compiler threads may use
+  // together. Zero means unlimited. Unset means derived from the cgroup CPU quota.
+  std::optional<uint32_t> GetCpuBudgetMs() const {
+    return cpu_budget_ms_;
+  }
+
   int GetThreadPoolPthreadPriority() const {
     return thread_pool_pthread_priority_;
   }
@@ -133,9 +158,13 @@ class JitOptions {
   uint16_t priority_thread_weight_;
   uint16_t invoke_transition_weight_;
   bool dump_info_on_shutdown_;
+  size_t thread_pool_threads_;
+  std::optional<uint32_t> cpu_budget_ms_;
   int thread_pool_pthread_priority_;
   int zygote_thread_pool_pthread_priority_;
   ProfileSaverOptions profile_saver_options_;
+  std::string warm_start_profile_;
+  std::string zygote_shared_profile_;
 
   JitOptions()
       : use_jit_compilation_(false),
@@ -148,6 +177,7 @@ class JitOptions {
         priority_thread_weight_(0),
         invoke_transition_weight_(0),
         dump_info_on_shutdown_(false),
+        thread_pool_threads_(1),
         thread_pool_pthread_priority_(kJitPoolThreadPthreadDefaultPriority),
         zygote_thread_pool_pthread_priority_(kJitZygotePoolThreadPthreadDefaultPriority) {}
 
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profile_sampler.h"
+
+#include "arch/context.h"
+#include "art_method-inl.h"
+#include "barrier.h"
+#include "base/logging.h"  // For VLOG.
+#include "base/systrace.h"
+#include "gc/heap.h"
+#include "jit/jit.h"
+#include "jit/jit_code_cache.h"
+#include "linear_alloc.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "stack.h"
+#include "thread-current-inl.h"
+#include "thread_list.h"
+
+namespace art HIDDEN {
+
+ProfileSampler* ProfileSampler::instance_ = nullptr;
+
+ProfileSampler::ProfileSampler(uint32_t interval_ms, bool profile_boot_class_path)
+    : interval_ms_(interval_ms),
+      profile_boot_class_path_(profile_boot_class_path),
+      pthread_(0U),
+      lock_("ProfileSampler lock"),
+      shutdown_cond_("ProfileSampler shutdown condition", lock_),
+      shutting_down_(false),
+      intervals_since_aging_(0u),
+      number_of_samples_(0u) {}
+
+void ProfileSampler::Start(uint32_t interval_ms, bool profile_boot_class_path) {
+  DCHECK_NE(interval_ms, 0u);
+  if (instance_ != nullptr) {
+    return;
+  }
+  VLOG(profiler) << "Starting profile sampler with interval " << interval_ms << "ms";
+  instance_ = new ProfileSampler(interval_ms, profile_boot_class_path);
+  CHECK_PTHREAD_CALL(
+      pthread_create,
+      (&instance_->pthread_, nullptr, &RunSamplerThread, reinterpret_cast<void*>(instance_)),
+      "Profile sampler thread");
+}
+
+void ProfileSampler::Stop() {
+  Thread* self = Thread::Current();
+  ProfileSampler* sampler = nullptr;
+  {
+    MutexLock mu(self, *Locks::profiler_lock_);
+    sampler = instance_;
+  }
+  if (sampler == nullptr) {
+    return;
+  }
+  {
+    MutexLock mu(self, sampler->lock_);
+    sampler->shutting_down_ = true;
+    sampler->shutdown_cond_.Signal(self);
+  }
+  // The sampler thread does not wait for this thread to run a checkpoint as this thread is
+  // not runnable.
+  CHECK_PTHREAD_CALL(
+      pthread_join, (sampler->pthread_, nullptr), "profile sampler thread shutdown");
+  {
+    MutexLock mu(self, *Locks::profiler_lock_);
+    VLOG(profiler) << "Profile sampler took " << sampler->GetNumberOfSamples() << " samples";
+    instance_ = nullptr;
+  }
+  delete sampler;
+}
+
+void ProfileSampler::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
+  MutexLock mu(self, *Locks::profiler_lock_);
+  if (instance_ == nullptr) {
+    return;
+  }
+  MutexLock mu2(self, instance_->lock_);
+  std::unordered_map<ArtMethod*, uint32_t>& samples = instance_->samples_;
+  for (auto it = samples.begin(); it != samples.end();) {
+    if (alloc.ContainsUnsafe(it->first)) {
+      it = samples.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ProfileSampler::AddSample(Thread* self, ArtMethod* method) {
+  if (method->PreviouslyWarm() || method->IsNative()) {
+    return;
+  }
+  // Marking a boot class path method writes to the boot image.
+  if (!profile_boot_class_path_ &&
+      Runtime::Current()->GetHeap()->ObjectIsInBootImageSpace(method->GetDeclaringClass())) {
+    return;
+  }
+  MutexLock mu(self, lock_);
+  ++number_of_samples_;
+  uint32_t& count = samples_[method];
+  ++count;
+  if (count >= kSamplesToMarkWarm) {
+    method->SetPreviouslyWarm();
+    samples_.erase(method);
+  }
+}
+
+void ProfileSampler::AddReceiverSample(Thread* self,
+                                       ArtMethod* caller,
+                                       uint32_t dex_pc,
+                                       ObjPtr<mirror::Class> receiver_class) {
+  jit::Jit* jit = Runtime::Current()->GetJit();
+  if (jit == nullptr || caller->IsNative()) {
+    return;
+  }
+  jit->GetCodeCache()->MaybeAddReceiverSample(caller, dex_pc, receiver_class, self);
+}
+
+uint64_t ProfileSampler::GetNumberOfSamples() {
+  MutexLock mu(Thread::Current(), lock_);
+  return number_of_samples_;
+}
+
+class SampleMethodClosure final : public Closure {
+ public:
+  SampleMethodClosure(ProfileSampler* sampler, Barrier* barrier)
+      : sampler_(sampler), barrier_(barrier) {}
+
+  void Run(Thread* thread) override REQUIRES_SHARED(Locks::mutator_lock_) {
+    Thread* self = Thread::Current();
+    // Only sample threads that were executing managed code. When the closure runs on
+    // behalf of a suspended thread, that thread is blocked or in native code.
+    if (thread == self) {
+      ArtMethod* sampled_method = nullptr;
+      ObjPtr<mirror::Object> receiver = nullptr;
+      ArtMethod* caller = nullptr;
+      uint32_t caller_dex_pc = dex::kDexNoIndex;
+      std::unique_ptr<Context> context(Context::Create());
+      StackVisitor::WalkStack(
+          [&](const art::StackVisitor* stack_visitor) REQUIRES_SHARED(Locks::mutator_lock_) {
+            ArtMethod* method = stack_visitor->GetMethod();
+            if (method == nullptr || method->IsRuntimeMethod()) {
+              return true;
+            }
+            if (sampled_method == nullptr) {
+              sampled_method = method;
+              receiver = stack_visitor->GetThisObject();
+              // Without a receiver there is no inline cache to attribute the sample to.
+              return receiver != nullptr;
+            }
+            caller = method;
+            caller_dex_pc = stack_visitor->GetDexPc(/*abort_on_failure=*/ false);
+            return false;
+          },
+          thread,
+          context.get(),
+          art::StackVisitor::StackWalkKind::kIncludeInlinedFrames);
+      if (sampled_method != nullptr) {
+        sampler_->AddSample(self, sampled_method);
+      }
+      if (caller != nullptr && caller_dex_pc != dex::kDexNoIndex) {
+        // The receiver of the sampled method is the receiver of the call in its caller.
+        sampler_->AddReceiverSample(self, caller, caller_dex_pc, receiver->GetClass());
+      }
+    }
+    barrier_->Pass(self);
+  }
+
+ private:
+  ProfileSampler* const sampler_;
+  Barrier* const barrier_;
+};
+
+void ProfileSampler::SampleThreads(Thread* self) {
+  ScopedTrace trace(__PRETTY_FUNCTION__);
+  {
+    MutexLock mu(self, lock_);
+    if (++intervals_since_aging_ == kAgingPeriod) {
+      // Forget methods that were sampled too rarely to be marked warm.
+      intervals_since_aging_ = 0u;
+      samples_.clear();
+    }
+  }
+  ScopedObjectAccess soa(self);
+  Barrier barrier(0);
+  SampleMethodClosure closure(this, &barrier);
+  size_t threads_running_checkpoint =
+      Runtime::Current()->GetThreadList()->RunCheckpoint(&closure);
+  // Wait for the other threads to run the checkpoint in a suspended state.
+  ScopedThreadSuspension sts(self, ThreadState::kSuspended);
+  if (threads_running_checkpoint != 0) {
+    barrier.Increment(self, threads_running_checkpoint);
+  }
+}
+
+void ProfileSampler::Run() {
+  Thread* self = Thread::Current();
+  while (true) {
+    {
+      MutexLock mu(self, lock_);
+      if (!shutting_down_) {
+        shutdown_cond_.TimedWait(self, interval_ms_, 0);
+      }
+      if (shutting_down_) {
+        break;
+      }
+    }
+    SampleThreads(self);
+  }
+}
+
+void* ProfileSampler::RunSamplerThread(void* arg) {
+  Runtime* runtime = Runtime::Current();
+
+  bool attached = runtime->AttachCurrentThread("Profile Sampler",
+                                               /*as_daemon=*/true,
+                                               runtime->GetSystemThreadGroup(),
+                                               /*create_peer=*/true);
+  if (!attached) {
+    CHECK(runtime->IsShuttingDown(Thread::Current()));
+    return nullptr;
+  }
+
+  reinterpret_cast<ProfileSampler*>(arg)->Run();
+
+  runtime->DetachCurrentThread();
+  VLOG(profiler) << "Profile sampler shutdown";
+  return nullptr;
+}
+
+}  // namespace art
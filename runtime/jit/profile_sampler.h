@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_PROFILE_SAMPLER_H_
+#define ART_RUNTIME_JIT_PROFILE_SAMPLER_H_
+
+#include <pthread.h>
+
+#include <unordered_map>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "obj_ptr.h"
+
+namespace art HIDDEN {
+
+class ArtMethod;
+class LinearAlloc;
+class Thread;
+
+namespace mirror {
+class Class;
+}  // namespace mirror
+
+// Samples the Java method executing on each runnable thread at a fixed interval and marks
+// methods that are sampled often enough as warm, which the profile saver records as hot.
+// This finds the methods where the time is spent, including compiled code that no longer
+// updates hotness counters, for the cost of one checkpoint per sampling interval.
+// The receiver of a sampled method is also counted in the inline cache of the call in its
+// caller, which gives profiles the receiver type frequencies of polymorphic calls.
+class ProfileSampler {
+ public:
+  // Number of samples of a method within an aging period that make it warm.
+  static constexpr uint32_t kSamplesToMarkWarm = 2u;
+  // Number of sampling intervals after which the sample counts are reset.
+  static constexpr uint32_t kAgingPeriod = 1000u;
+
+  // Starts the sampler thread. `profile_boot_class_path` allows marking boot class path
+  // methods, which otherwise are not sampled to avoid dirtying boot image pages.
+  static void Start(uint32_t interval_ms, bool profile_boot_class_path)
+      REQUIRES(Locks::profiler_lock_);
+
+  // Stops the sampler thread if it was started.
+  static void Stop() REQUIRES(!Locks::profiler_lock_, !Locks::mutator_lock_);
+
+  // Removes the samples of methods allocated in `alloc`, which is about to be freed.
+  static void RemoveMethodsIn(Thread* self, const LinearAlloc& alloc)
+      REQUIRES(!Locks::profiler_lock_);
+
+  // Records a sample of `method` and marks it as warm once it has enough samples.
+  void AddSample(Thread* self, ArtMethod* method)
+      REQUIRES(!lock_) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Records that the call at `dex_pc` in `caller` was sampled with a receiver of class
+  // `receiver_class`, which gives the inline cache of the call receiver frequencies.
+  void AddReceiverSample(Thread* self,
+                         ArtMethod* caller,
+                         uint32_t dex_pc,
+                         ObjPtr<mirror::Class> receiver_class)
+      REQUIRES(!Locks::jit_lock_) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  uint64_t GetNumberOfSamples() REQUIRES(!lock_);
+
+ private:
+  ProfileSampler(uint32_t interval_ms, bool profile_boot_class_path);
+
+  static void* RunSamplerThread(void* arg) REQUIRES(!Locks::profiler_lock_);
+
+  void Run() REQUIRES(!lock_);
+  void SampleThreads(Thread* self) REQUIRES(!lock_);
+
+  // The only instance of the sampler.
+  static ProfileSampler* instance_ GUARDED_BY(Locks::profiler_lock_);
+
+  const uint32_t interval_ms_;
+  const bool profile_boot_class_path_;
+  pthread_t pthread_;
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  ConditionVariable shutdown_cond_ GUARDED_BY(lock_);
+  bool shutting_down_ GUARDED_BY(lock_);
+  uint32_t intervals_since_aging_ GUARDED_BY(lock_);
+  uint64_t number_of_samples_ GUARDED_BY(lock_);
+  // Sample counts of methods that are not marked as warm yet.
+  std::unordered_map<ArtMethod*, uint32_t> samples_ GUARDED_BY(lock_);
+
+  friend class ProfileSaverTest;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileSampler);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_PROFILE_SAMPLER_H_
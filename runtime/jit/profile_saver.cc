@@ -26,8 +26,10 @@
 #include "art_method-inl.h"
 #include "base/compiler_filter.h"
 #include "base/logging.h"  // For VLOG.
+#include "base/os.h"
 #include "base/pointer_size.h"
 #include "base/scoped_arena_containers.h"
+#include "base/scoped_flock.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
 #include "base/time_utils.h"
@@ -38,7 +40,9 @@
 #include "gc/collector_type.h"
 #include "gc/gc_cause.h"
 #include "jit/jit.h"
+#include "jit/profile_sampler.h"
 #include "jit/profiling_info.h"
+#include "jit/startup_trace_recorder.h"
 #include "oat/oat_file_manager.h"
 #include "profile/profile_compilation_info.h"
 #include "scoped_thread_state_change-inl.h"
@@ -253,7 +257,10 @@ bool ProfileSaver::IsFirstSave() {
     const std::string& ref_profile = it.second;
 
     // Check if any profile is non empty. If so, then this is not the first save.
-    if (!IsProfileEmpty(cur_profile) || !IsProfileEmpty(ref_profile)) {
+    if (!IsProfileEmpty(cur_profile) ||
+        !IsProfileEmpty(ref_profile) ||
+        (options_.GetUseDeltaJournal() &&
+         !IsProfileEmpty(ProfileCompilationInfo::GetJournalFilename(cur_profile)))) {
       return false;
     }
   }
@@ -483,6 +490,8 @@ void ProfileSaver::GetClassesAndMethodsHelper::CollectInternal(
       }
     }
 
+    // Proxy classes are generated at runtime and have no dex file to attribute them to.
+    // Their interfaces are recorded separately when visiting their defining class loaders.
     if (!k->IsResolved() || k->IsProxyClass()) {
       return true;
     }
@@ -804,6 +813,19 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
           locations, profile_methods, options_.GetInlineCacheThreshold());
       total_number_of_code_cache_queries_++;
     }
+    if (options_.GetUseDeltaJournal()) {
+      bool journaled;
+      {
+        MutexLock mu(Thread::Current(), *Locks::profiler_lock_);
+        journaled = SaveToJournal(filename, profile_methods, force_save, number_of_new_methods);
+      }
+      if (journaled) {
+        profile_file_saved = true;
+        ScopedObjectAccess soa(Thread::Current());
+        jit_code_cache_->ClearReceiverSamples(locations);
+      }
+      continue;
+    }
     {
       ProfileCompilationInfo info(Runtime::Current()->GetArenaPool(),
                                   /*for_boot_image=*/options_.GetProfileBootClassPath());
@@ -836,6 +858,7 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
         force_save = true;
       }
 
+      bool saved = false;
       {
         MutexLock mu(Thread::Current(), *Locks::profiler_lock_);
         auto profile_cache_it = profile_cache_.find(filename);
@@ -876,6 +899,7 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
         // Force the save. In case the profile data is corrupted or the profile
         // has the wrong version this will "fix" the file to the correct format.
         if (info.Save(filename, &bytes_written)) {
+          saved = true;
           // We managed to save the profile. Clear the cache stored during startup.
           if (profile_cache_it != profile_cache_.end()) {
             ProfileCompilationInfo *cached_info = profile_cache_it->second;
@@ -898,6 +922,11 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
           total_number_of_failed_writes_++;
         }
       }
+      if (saved) {
+        // The file has the receiver samples now, start counting anew.
+        ScopedObjectAccess soa(Thread::Current());
+        jit_code_cache_->ClearReceiverSamples(locations);
+      }
     }
   }
 
@@ -908,6 +937,133 @@ bool ProfileSaver::ProcessProfilingInfo(bool force_save, /*out*/uint16_t* number
   return profile_file_saved;
 }
 
+// Compact the delta journal into the profile once it grows beyond this size.
+static constexpr int64_t kMaxProfileJournalSizeBytes = 256 * KB;
+
+bool ProfileSaver::SaveToJournal(const std::string& filename,
+                                 const std::vector<ProfileMethodInfo>& profile_methods,
+                                 bool force_save,
+                                 /*out*/ uint16_t* number_of_new_methods) {
+  const std::string journal_filename = ProfileCompilationInfo::GetJournalFilename(filename);
+  const int64_t journal_size = OS::GetFileSizeBytes(journal_filename.c_str());
+  auto journaled_it = journaled_profiles_.find(filename);
+  if (journaled_it != journaled_profiles_.end() &&
+      journaled_it->second.journal_size != std::max<int64_t>(journal_size, 0)) {
+    // The journal was compacted or removed by someone else. Reload what is on disk.
+    journaled_profiles_.erase(journaled_it);
+    journaled_it = journaled_profiles_.end();
+  }
+  if (journaled_it == journaled_profiles_.end()) {
+    std::unique_ptr<ProfileCompilationInfo> info(new ProfileCompilationInfo(
+        Runtime::Current()->GetArenaPool(), /*for_boot_image=*/options_.GetProfileBootClassPath()));
+    if (!info->Load(filename, /*clear_if_invalid=*/true)) {
+      LOG(WARNING) << "Could not forcefully load profile " << filename;
+      return false;
+    }
+    if (journal_size > 0 && !info->MergeWith(journal_filename)) {
+      LOG(WARNING) << "Removing invalid profile journal " << journal_filename;
+      if (unlink(journal_filename.c_str()) != 0) {
+        PLOG(WARNING) << "Failed to remove profile journal " << journal_filename;
+        return false;
+      }
+    }
+    journaled_it = journaled_profiles_.Put(
+        filename, JournaledProfile{std::move(info), std::max<int64_t>(journal_size, 0)});
+  }
+  ProfileCompilationInfo* journaled_info = journaled_it->second.info.get();
+
+  // Collect the data that is not on disk yet. Inline caches of methods that are already
+  // saved with the same flags are not updated.
+  const ProfileCompilationInfo::ProfileSampleAnnotation annotation = GetProfileSampleAnnotation();
+  const Hotness::Flag flags = AnnotateSampleFlags(Hotness::kFlagHot | Hotness::kFlagPostStartup);
+  std::vector<ProfileMethodInfo> new_methods;
+  for (const ProfileMethodInfo& method : profile_methods) {
+    Hotness hotness = journaled_info->GetMethodHotness(method.ref, annotation);
+    if ((hotness.GetFlags() & flags) != flags) {
+      new_methods.push_back(method);
+    }
+  }
+  ProfileCompilationInfo delta(Runtime::Current()->GetArenaPool(),
+                               /*for_boot_image=*/options_.GetProfileBootClassPath());
+  if (!delta.AddMethods(new_methods, flags, annotation)) {
+    LOG(WARNING) << "Could not add methods to the profile delta of " << filename;
+    return false;
+  }
+  auto profile_cache_it = profile_cache_.find(filename);
+  if (profile_cache_it != profile_cache_.end() && !delta.MergeWith(*profile_cache_it->second)) {
+    LOG(WARNING) << "Could not merge the cached profile into the profile delta of " << filename;
+    return false;
+  }
+
+  uint64_t delta_number_of_methods = delta.GetNumberOfMethods();
+  uint64_t delta_number_of_classes = delta.GetNumberOfResolvedClasses();
+  if ((delta_number_of_methods == 0u && delta_number_of_classes == 0u) ||
+      (!force_save &&
+       delta_number_of_methods < options_.GetMinMethodsToSave() &&
+       delta_number_of_classes < options_.GetMinClassesToSave())) {
+    VLOG(profiler) << "Not enough information to append to the journal of: " << filename
+                   << " Number of methods: " << delta_number_of_methods
+                   << " Number of classes: " << delta_number_of_classes;
+    total_number_of_skipped_writes_++;
+    return false;
+  }
+  if (number_of_new_methods != nullptr) {
+    *number_of_new_methods =
+        std::max(static_cast<uint16_t>(delta_number_of_methods), *number_of_new_methods);
+  }
+
+  uint64_t bytes_written = 0u;
+  {
+    std::string error;
+    ScopedFlock journal = LockedFile::Open(
+        journal_filename.c_str(),
+        O_WRONLY | O_CREAT | O_APPEND | O_NOFOLLOW | O_CLOEXEC,
+        /*block=*/false,
+        &error);
+    if (journal == nullptr || !delta.AppendToJournal(journal->Fd(), &bytes_written)) {
+      LOG(WARNING) << "Could not append profiling info to " << journal_filename << " " << error;
+      total_number_of_failed_writes_++;
+      return false;
+    }
+    journaled_it->second.journal_size = journal->GetLength();
+  }
+  total_number_of_writes_++;
+  total_bytes_written_ += bytes_written;
+  if (profile_cache_it != profile_cache_.end()) {
+    delete profile_cache_it->second;
+    profile_cache_.erase(profile_cache_it);
+  }
+
+  bool compact = journaled_it->second.journal_size > kMaxProfileJournalSizeBytes;
+  if (!journaled_info->MergeWith(delta)) {
+    // The profiled dex files were updated. Replace the saved data with the new data.
+    LOG(WARNING) << "Could not merge the profile delta. Clearing the profile data.";
+    journaled_info->ClearData();
+    CHECK(journaled_info->MergeWith(delta));
+    compact = true;
+  }
+  if (compact) {
+    // Write the profile first so that no data is lost if the journal cannot be cleared.
+    uint64_t profile_bytes_written = 0u;
+    if (!journaled_info->Save(filename, &profile_bytes_written)) {
+      LOG(WARNING) << "Could not save profiling info to " << filename;
+      total_number_of_failed_writes_++;
+      return true;
+    }
+    total_number_of_writes_++;
+    total_bytes_written_ += profile_bytes_written;
+    std::string error;
+    ScopedFlock journal = LockedFile::Open(
+        journal_filename.c_str(), O_RDWR | O_NOFOLLOW | O_CLOEXEC, /*block=*/false, &error);
+    if (journal == nullptr || !journal->ClearContent()) {
+      LOG(WARNING) << "Could not clear the profile journal " << journal_filename << " " << error;
+    } else {
+      journaled_it->second.journal_size = 0;
+    }
+  }
+  return true;
+}
+
 void* ProfileSaver::RunProfileSaverThread(void* arg) {
   Runtime* runtime = Runtime::Current();
 
@@ -1032,6 +1188,13 @@ void  ProfileSaver::Start(const ProfileSaverOptions& options,
       "Profile saver thread");
 
   SetProfileSaverThreadPriority(profiler_pthread_, kProfileSaverPthreadPriority);
+
+  if (options.GetSamplingIntervalMs() != 0u) {
+    ProfileSampler::Start(options.GetSamplingIntervalMs(), options.GetProfileBootClassPath());
+  }
+  if (!options.GetStartupTracePath().empty()) {
+    StartupTraceRecorder::Start(options.GetStartupTracePath());
+  }
 }
 
 void ProfileSaver::Stop(bool dump_info) {
@@ -1054,6 +1217,10 @@ void ProfileSaver::Stop(bool dump_info) {
     instance_->shutting_down_ = true;
   }
 
+  // Stop sampling so that the final save below includes all samples.
+  ProfileSampler::Stop();
+  StartupTraceRecorder::Stop();
+
   {
     // Wake up the saver thread if it is sleeping to allow for a clean exit.
     MutexLock wait_mutex(Thread::Current(), profile_saver->wait_lock_);
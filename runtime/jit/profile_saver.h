@@ -84,6 +84,16 @@ class ProfileSaver {
       REQUIRES(!Locks::profiler_lock_)
       REQUIRES(!Locks::mutator_lock_);
 
+  // Appends the methods and classes collected since the last save of `filename` to the
+  // delta journal of the profile, and compacts the journal into the profile once it gets
+  // large. Returns true if data was written to disk.
+  bool SaveToJournal(const std::string& filename,
+                     const std::vector<ProfileMethodInfo>& profile_methods,
+                     bool force_save,
+                     /*out*/ uint16_t* number_of_new_methods)
+      REQUIRES(Locks::profiler_lock_)
+      REQUIRES(!Locks::mutator_lock_);
+
   void NotifyJitActivityInternal() REQUIRES(!wait_lock_);
   void WakeUpSaver() REQUIRES(wait_lock_);
 
@@ -151,6 +161,14 @@ class ProfileSaver {
   // to just a few hundreds entries in the ProfileCompilationInfo objects.
   SafeMap<std::string, ProfileCompilationInfo*> profile_cache_ GUARDED_BY(Locks::profiler_lock_);
 
+  // The data already saved to a profile and its delta journal, used to append only new data
+  // to the journal. The journal size detects compactions done by other processes.
+  struct JournaledProfile {
+    std::unique_ptr<ProfileCompilationInfo> info;
+    int64_t journal_size;
+  };
+  SafeMap<std::string, JournaledProfile> journaled_profiles_ GUARDED_BY(Locks::profiler_lock_);
+
   // Whether or not this is the first ever profile save.
   // Note this is an approximation and is not 100% precise. It relies on checking
   // whether or not the profiles are empty which is not a precise indication
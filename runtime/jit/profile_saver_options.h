@@ -43,7 +43,10 @@ struct ProfileSaverOptions {
         profile_path_(""),
         profile_boot_class_path_(false),
         profile_aot_code_(false),
-        wait_for_jit_notifications_to_save_(true) {}
+        wait_for_jit_notifications_to_save_(true),
+        use_delta_journal_(false),
+        sampling_interval_ms_(0u),
+        startup_trace_path_("") {}
 
   ProfileSaverOptions(bool enabled,
                       uint32_t min_save_period_ms,
@@ -56,7 +59,10 @@ struct ProfileSaverOptions {
                       const std::string& profile_path,
                       bool profile_boot_class_path,
                       bool profile_aot_code = false,
-                      bool wait_for_jit_notifications_to_save = true)
+                      bool wait_for_jit_notifications_to_save = true,
+                      bool use_delta_journal = false,
+                      uint32_t sampling_interval_ms = 0u,
+                      const std::string& startup_trace_path = "")
       : enabled_(enabled),
         min_save_period_ms_(min_save_period_ms),
         min_first_save_ms_(min_first_save_ms),
@@ -68,7 +74,10 @@ struct ProfileSaverOptions {
         profile_path_(profile_path),
         profile_boot_class_path_(profile_boot_class_path),
         profile_aot_code_(profile_aot_code),
-        wait_for_jit_notifications_to_save_(wait_for_jit_notifications_to_save) {}
+        wait_for_jit_notifications_to_save_(wait_for_jit_notifications_to_save),
+        use_delta_journal_(use_delta_journal),
+        sampling_interval_ms_(sampling_interval_ms),
+        startup_trace_path_(startup_trace_path) {}
 
   bool IsEnabled() const {
     return false;
@@ -113,6 +122,15 @@ struct ProfileSaverOptions {
   void SetWaitForJitNotificationsToSave(bool value) {
     wait_for_jit_notifications_to_save_ = value;
   }
+  bool GetUseDeltaJournal() const {
+    return use_delta_journal_;
+  }
+  uint32_t GetSamplingIntervalMs() const {
+    return sampling_interval_ms_;
+  }
+  std::string GetStartupTracePath() const {
+    return startup_trace_path_;
+  }
 
   friend std::ostream & operator<<(std::ostream &os, const ProfileSaverOptions& pso) {
     os << "enabled_" << pso.enabled_
@@ -125,7 +143,10 @@ struct ProfileSaverOptions {
         << ", inline_cache_threshold_" << pso.inline_cache_threshold_
         << ", profile_boot_class_path_" << pso.profile_boot_class_path_
         << ", profile_aot_code_" << pso.profile_aot_code_
-        << ", wait_for_jit_notifications_to_save_" << pso.wait_for_jit_notifications_to_save_;
+        << ", wait_for_jit_notifications_to_save_" << pso.wait_for_jit_notifications_to_save_
+        << ", use_delta_journal_" << pso.use_delta_journal_
+        << ", sampling_interval_ms_" << pso.sampling_interval_ms_
+        << ", startup_trace_path_" << pso.startup_trace_path_;
     return os;
   }
 
@@ -141,6 +162,12 @@ struct ProfileSaverOptions {
   bool profile_boot_class_path_;
   bool profile_aot_code_;
   bool wait_for_jit_notifications_to_save_;
+  // Append new data to a journal next to the profile instead of rewriting the profile.
+  bool use_delta_journal_;
+  // Interval of the sampling profiler, 0 if sampling is disabled.
+  uint32_t sampling_interval_ms_;
+  // File to write the startup trace to, empty if startup tracing is disabled.
+  std::string startup_trace_path_;
 };
 
 }  // namespace art
@@ -18,7 +18,9 @@
 
 #include "common_runtime_test.h"
 #include "compiler_callbacks.h"
+#include "art_method-inl.h"
 #include "jit/jit.h"
+#include "jit/profile_sampler.h"
 #include "profile_saver.h"
 #include "profile/profile_compilation_info.h"
 
@@ -59,6 +61,21 @@ class ProfileSaverTest : public CommonRuntimeTest {
     return profile_saver_->AnnotateSampleFlags(flags);
   }
 
+  std::unique_ptr<ProfileSampler> CreateSampler(bool profile_boot_class_path) {
+    return std::unique_ptr<ProfileSampler>(
+        new ProfileSampler(/*interval_ms=*/ 1u, profile_boot_class_path));
+  }
+
+  ArtMethod* FindMethodToSample(const char* descriptor) REQUIRES_SHARED(Locks::mutator_lock_) {
+    ObjPtr<mirror::Class> klass = class_linker_->FindSystemClass(Thread::Current(), descriptor);
+    for (ArtMethod& method : klass->GetDeclaredMethods(kRuntimePointerSize)) {
+      if (!method.PreviouslyWarm() && !method.IsNative() && !method.IsAbstract()) {
+        return &method;
+      }
+    }
+    return nullptr;
+  }
+
  protected:
   ProfileSaver* profile_saver_ = nullptr;
 };
@@ -103,4 +120,31 @@ TEST_F(ProfileSaverTest, AnnotateSampleFlags) {
   ASSERT_EQ(Hotness::kFlagHot, actual);
 }
 
+TEST_F(ProfileSaverTest, SamplerMarksSampledMethodsWarm) {
+  ScopedObjectAccess soa(Thread::Current());
+  ArtMethod* method = FindMethodToSample("Ljava/lang/StringBuilder;");
+  ASSERT_TRUE(method != nullptr);
+
+  // Boot class path methods are not sampled unless profiling the boot class path.
+  std::unique_ptr<ProfileSampler> app_sampler = CreateSampler(/*profile_boot_class_path=*/ false);
+  for (uint32_t i = 0; i != ProfileSampler::kSamplesToMarkWarm; ++i) {
+    app_sampler->AddSample(soa.Self(), method);
+  }
+  EXPECT_FALSE(method->PreviouslyWarm());
+  EXPECT_EQ(app_sampler->GetNumberOfSamples(), 0u);
+
+  std::unique_ptr<ProfileSampler> sampler = CreateSampler(/*profile_boot_class_path=*/ true);
+  for (uint32_t i = 1; i != ProfileSampler::kSamplesToMarkWarm; ++i) {
+    sampler->AddSample(soa.Self(), method);
+  }
+  EXPECT_FALSE(method->PreviouslyWarm());
+  sampler->AddSample(soa.Self(), method);
+  EXPECT_TRUE(method->PreviouslyWarm());
+  EXPECT_EQ(sampler->GetNumberOfSamples(), ProfileSampler::kSamplesToMarkWarm);
+
+  // Samples of warm methods are not counted.
+  sampler->AddSample(soa.Self(), method);
+  EXPECT_EQ(sampler->GetNumberOfSamples(), ProfileSampler::kSamplesToMarkWarm);
+}
+
 }  // namespace art
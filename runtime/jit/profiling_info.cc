@@ -29,6 +29,7 @@ ProfilingInfo::ProfilingInfo(ArtMethod* method,
                              const std::vector<uint32_t>& inline_cache_entries,
                              const std::vector<uint32_t>& branch_cache_entries)
       : baseline_hotness_count_(GetOptimizeThreshold()),
+        invocation_count_(0),
         method_(method),
         number_of_inline_caches_(inline_cache_entries.size()),
         number_of_branch_caches_(branch_cache_entries.size()),
@@ -145,6 +146,22 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   // as the garbage collector might clear the entries concurrently.
 }
 
+void ProfilingInfo::AddReceiverSample(uint32_t dex_pc, mirror::Class* cls) {
+  InlineCache* cache = GetInlineCache(dex_pc);
+  if (cache == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
+    mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
+    if (ReadBarrier::IsMarked(existing) == cls) {
+      // Several threads may add samples for the same cache concurrently.
+      reinterpret_cast<Atomic<uint32_t>*>(&cache->counts_[i])->fetch_add(
+          1u, std::memory_order_relaxed);
+      return;
+    }
+  }
+}
+
 ScopedProfilingInfoUse::ScopedProfilingInfoUse(jit::Jit* jit, ArtMethod* method, Thread* self)
     : jit_(jit),
       method_(method),
@@ -197,4 +214,14 @@ uint32_t InlineCache::MaxDexPcEncodingDepth(ArtMethod* method, uint32_t inline_m
   return depth - 1;
 }
 
+bool InlineCache::IsTypeCheckDexPc(ArtMethod* method, uint32_t dex_pc) {
+  CodeItemInstructionAccessor accessor = method->DexInstructions();
+  if (dex_pc >= accessor.InsnsSizeInCodeUnits()) {
+    // Encoded dex pc of an inlined invoke.
+    return false;
+  }
+  Instruction::Code opcode = accessor.InstructionAt(dex_pc).Opcode();
+  return opcode == Instruction::INSTANCE_OF || opcode == Instruction::CHECK_CAST;
+}
+
 }  // namespace art
@@ -63,9 +63,17 @@ class InlineCache {
                                         uint32_t inline_max_code_units)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Return whether the instruction at `dex_pc` in `method` is a type check. Baseline
+  // compiled code records the classes seen by type checks in inline caches too.
+  EXPORT static bool IsTypeCheckDexPc(ArtMethod* method, uint32_t dex_pc)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
  private:
   uint32_t dex_pc_;
   GcRoot<mirror::Class> classes_[kIndividualCacheSize];
+  // Number of times the receiver was sampled as `classes_[i]`. Only the profile sampler
+  // updates these, compiled code and the entrypoints only fill `classes_`.
+  uint32_t counts_[kIndividualCacheSize];
 
   friend class jit::JitCodeCache;
   friend class ProfilingInfo;
@@ -124,6 +132,12 @@ class ProfilingInfo {
       REQUIRES(Roles::uninterruptible_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record a sample of a call at `dex_pc` with a receiver of class `cls`. The sample is
+  // dropped if `cls` is not in the inline cache.
+  void AddReceiverSample(uint32_t dex_pc, mirror::Class* cls)
+      REQUIRES(Roles::uninterruptible_)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   ArtMethod* GetMethod() const {
     return method_;
   }
@@ -175,6 +189,16 @@ class ProfilingInfo {
     return baseline_hotness_count_;
   }
 
+  static constexpr MemberOffset InvocationCountOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(ProfilingInfo, invocation_count_));
+  }
+
+  // Number of times the method's JIT code was entered, if it was compiled with an invocation
+  // counter. See Instrumentation::CountsInvocationsInCompiledCode.
+  uint32_t GetInvocationCount() const {
+    return invocation_count_;
+  }
+
   static uint16_t GetOptimizeThreshold();
 
  private:
@@ -187,6 +211,10 @@ class ProfilingInfo {
   // JIT compile optimized the method.
   uint16_t baseline_hotness_count_;
 
+  // Incremented by the frame entry of compiled code when counting invocations. Concurrent
+  // increments may be lost, which is fine for call counts and coverage.
+  uint32_t invocation_count_;
+
   // Method this profiling info is for.
   // Not 'const' as JVMTI introduces obsolete methods that we implement by creating new ArtMethods.
   // See JitCodeCache::MoveObsoleteMethod.
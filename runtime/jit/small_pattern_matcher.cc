@@ -27,8 +27,9 @@ namespace jit {
 // code.
 
 static void EmptyMethod() {}
-static int32_t ReturnZero() { return 0; }
-static int32_t ReturnOne() { return 1; }
+
+template <int32_t kValue>
+static int32_t ReturnConstant() { return kValue; }
 static int32_t ReturnFirstArgMethod([[maybe_unused]] ArtMethod* method, int32_t first_arg) {
   return first_arg;
 }
@@ -80,6 +81,26 @@ static void SetFieldObjectAt([[maybe_unused]] ArtMethod* method,
       MemberOffset(offset + sizeof(mirror::Object)), value);
 }
 
+template <int offset, typename T>
+static mirror::Object* SetFieldAtReturnThis([[maybe_unused]] ArtMethod* method,
+                                            mirror::Object* obj,
+                                            T value)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  obj->SetFieldPrimitive<T, /* kIsVolatile= */ false>(
+      MemberOffset(offset + sizeof(mirror::Object)), value);
+  return obj;
+}
+
+template <int offset, typename unused>
+static mirror::Object* SetFieldObjectAtReturnThis([[maybe_unused]] ArtMethod* method,
+                                                  mirror::Object* obj,
+                                                  mirror::Object* value)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  obj->SetFieldObject</* kTransactionActive */ false>(
+      MemberOffset(offset + sizeof(mirror::Object)), value);
+  return obj;
+}
+
 template <int offset, typename T>
 static void ConstructorSetFieldAt([[maybe_unused]] ArtMethod* method, mirror::Object* obj, T value)
     REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -124,11 +145,72 @@ static void ConstructorSetFieldObjectAt([[maybe_unused]] ArtMethod* method,
     default: return nullptr; \
   }
 
+// Fields narrower than 32 bits can be at any offset aligned to their size.
+#define SWITCH_CASE_2(offset, func, type) \
+  SWITCH_CASE(offset, func, type)         \
+  SWITCH_CASE((offset) + 2, func, type)
+
+#define DO_SWITCH_OFFSET_16_BITS(offset, F, T) \
+  switch (offset) { \
+    SWITCH_CASE_2(0, F, T) \
+    SWITCH_CASE_2(4, F, T) \
+    SWITCH_CASE_2(8, F, T) \
+    SWITCH_CASE_2(12, F, T) \
+    SWITCH_CASE_2(16, F, T) \
+    SWITCH_CASE_2(20, F, T) \
+    SWITCH_CASE_2(24, F, T) \
+    SWITCH_CASE_2(28, F, T) \
+    SWITCH_CASE_2(32, F, T) \
+    SWITCH_CASE_2(36, F, T) \
+    SWITCH_CASE_2(40, F, T) \
+    SWITCH_CASE_2(44, F, T) \
+    SWITCH_CASE_2(48, F, T) \
+    SWITCH_CASE_2(52, F, T) \
+    SWITCH_CASE_2(56, F, T) \
+    SWITCH_CASE_2(60, F, T) \
+    SWITCH_CASE(64, F, T) \
+    default: return nullptr; \
+  }
+
+#define SWITCH_CASE_4(offset, func, type) \
+  SWITCH_CASE(offset, func, type)         \
+  SWITCH_CASE((offset) + 1, func, type)   \
+  SWITCH_CASE((offset) + 2, func, type)   \
+  SWITCH_CASE((offset) + 3, func, type)
+
+#define DO_SWITCH_OFFSET_8_BITS(offset, F, T) \
+  switch (offset) { \
+    SWITCH_CASE_4(0, F, T) \
+    SWITCH_CASE_4(4, F, T) \
+    SWITCH_CASE_4(8, F, T) \
+    SWITCH_CASE_4(12, F, T) \
+    SWITCH_CASE_4(16, F, T) \
+    SWITCH_CASE_4(20, F, T) \
+    SWITCH_CASE_4(24, F, T) \
+    SWITCH_CASE_4(28, F, T) \
+    SWITCH_CASE_4(32, F, T) \
+    SWITCH_CASE_4(36, F, T) \
+    SWITCH_CASE_4(40, F, T) \
+    SWITCH_CASE_4(44, F, T) \
+    SWITCH_CASE_4(48, F, T) \
+    SWITCH_CASE_4(52, F, T) \
+    SWITCH_CASE_4(56, F, T) \
+    SWITCH_CASE_4(60, F, T) \
+    SWITCH_CASE(64, F, T) \
+    default: return nullptr; \
+  }
+
 #define DO_SWITCH(offset, O, P, K)                  \
   DCHECK_EQ(is_object, (K) == Primitive::kPrimNot); \
   switch (K) {                                      \
     case Primitive::kPrimBoolean:                   \
-      DO_SWITCH_OFFSET(offset, P, uint8_t);         \
+      DO_SWITCH_OFFSET_8_BITS(offset, P, uint8_t);  \
+    case Primitive::kPrimByte:                      \
+      DO_SWITCH_OFFSET_8_BITS(offset, P, int8_t);   \
+    case Primitive::kPrimChar:                      \
+      DO_SWITCH_OFFSET_16_BITS(offset, P, uint16_t); \
+    case Primitive::kPrimShort:                     \
+      DO_SWITCH_OFFSET_16_BITS(offset, P, int16_t); \
     case Primitive::kPrimInt:                       \
       DO_SWITCH_OFFSET(offset, P, int32_t);         \
     case Primitive::kPrimLong:                      \
@@ -231,7 +313,7 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
   }
 
   // Recognize:
-  //   const vX, 0/1
+  //   const vX, -8..7
   //   return{-object} vX
   if (insns_size == 2u) {
     if (method->GetReturnTypePrimitive() == Primitive::kPrimFloat) {
@@ -246,29 +328,37 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
         case Instruction::CONST_4: {
           register_index = instruction.VRegA_11n();
           constant = instruction.VRegB_11n();
-          if (constant != 0 && constant != 1) {
-            return nullptr;
-          }
           break;
         }
         case Instruction::CONST_16: {
           register_index = instruction.VRegA_21s();
           constant = instruction.VRegB_21s();
-          if (constant != 0 && constant != 1) {
-            return nullptr;
-          }
           break;
         }
         case Instruction::RETURN:
         case Instruction::RETURN_OBJECT: {
-          if (register_index == instruction.VRegA_11x()) {
-            if (constant == 0) {
-              return reinterpret_cast<void*>(&ReturnZero);
-            } else if (constant == 1) {
-              return reinterpret_cast<void*>(&ReturnOne);
-            }
+          if (register_index != instruction.VRegA_11x()) {
+            return nullptr;
+          }
+          switch (constant) {
+            case -8: return reinterpret_cast<void*>(&ReturnConstant<-8>);
+            case -7: return reinterpret_cast<void*>(&ReturnConstant<-7>);
+            case -6: return reinterpret_cast<void*>(&ReturnConstant<-6>);
+            case -5: return reinterpret_cast<void*>(&ReturnConstant<-5>);
+            case -4: return reinterpret_cast<void*>(&ReturnConstant<-4>);
+            case -3: return reinterpret_cast<void*>(&ReturnConstant<-3>);
+            case -2: return reinterpret_cast<void*>(&ReturnConstant<-2>);
+            case -1: return reinterpret_cast<void*>(&ReturnConstant<-1>);
+            case 0: return reinterpret_cast<void*>(&ReturnConstant<0>);
+            case 1: return reinterpret_cast<void*>(&ReturnConstant<1>);
+            case 2: return reinterpret_cast<void*>(&ReturnConstant<2>);
+            case 3: return reinterpret_cast<void*>(&ReturnConstant<3>);
+            case 4: return reinterpret_cast<void*>(&ReturnConstant<4>);
+            case 5: return reinterpret_cast<void*>(&ReturnConstant<5>);
+            case 6: return reinterpret_cast<void*>(&ReturnConstant<6>);
+            case 7: return reinterpret_cast<void*>(&ReturnConstant<7>);
+            default: return nullptr;
           }
-          return nullptr;
         }
         default:
           return nullptr;
@@ -278,14 +368,17 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
   }
 
   // Recognize:
-  //   iget-{object,wide,boolean} vX, v0, field
-  //   return-{object} vX
+  //   iget{-object,-wide,-boolean,-byte,-char,-short} vX, v0, field
+  //   return{-object,-wide} vX
   // Or:
-  //   iput-{object,wide,boolean} v1, v0, field
+  //   iput{-object,-wide,-boolean,-byte,-char,-short} v1, v0, field
   //   return-void
   // Or:
-  //   sget-object vX, field
-  //   return-object vX
+  //   iput{-object,-wide,-boolean,-byte,-char,-short} v1, v0, field
+  //   return-object v0
+  // Or:
+  //   sget{-object,-wide,-boolean,-byte,-char,-short} vX, field
+  //   return{-object,-wide} vX
   // Or:
   //   iput-{object,wide,boolean} v1, v0, field
   //   invoke-direct v0, j.l.Object.<init>
@@ -315,22 +408,39 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
             return nullptr;
           }
           break;
-        case Instruction::SGET_OBJECT:
+        case Instruction::SGET:
+        case Instruction::SGET_WIDE:
+        case Instruction::SGET_BOOLEAN:
+        case Instruction::SGET_BYTE:
+        case Instruction::SGET_CHAR:
+        case Instruction::SGET_SHORT:
           is_static = true;
           FALLTHROUGH_INTENDED;
-        case Instruction::IPUT_OBJECT:
-        case Instruction::IGET_OBJECT:
-          is_object = true;
-          FALLTHROUGH_INTENDED;
         case Instruction::IPUT:
         case Instruction::IGET:
         case Instruction::IGET_BOOLEAN:
         case Instruction::IPUT_BOOLEAN:
+        case Instruction::IGET_BYTE:
+        case Instruction::IPUT_BYTE:
+        case Instruction::IGET_CHAR:
+        case Instruction::IPUT_CHAR:
+        case Instruction::IGET_SHORT:
+        case Instruction::IPUT_SHORT:
         case Instruction::IGET_WIDE:
-        case Instruction::IPUT_WIDE: {
+        case Instruction::IPUT_WIDE:
+        case Instruction::SGET_OBJECT:
+        case Instruction::IPUT_OBJECT:
+        case Instruction::IGET_OBJECT: {
+          is_static = is_static || pair->Opcode() == Instruction::SGET_OBJECT;
+          is_object = (pair->Opcode() == Instruction::SGET_OBJECT ||
+                       pair->Opcode() == Instruction::IPUT_OBJECT ||
+                       pair->Opcode() == Instruction::IGET_OBJECT);
           is_put = (pair->Opcode() == Instruction::IPUT ||
                     pair->Opcode() == Instruction::IPUT_OBJECT ||
                     pair->Opcode() == Instruction::IPUT_BOOLEAN ||
+                    pair->Opcode() == Instruction::IPUT_BYTE ||
+                    pair->Opcode() == Instruction::IPUT_CHAR ||
+                    pair->Opcode() == Instruction::IPUT_SHORT ||
                     pair->Opcode() == Instruction::IPUT_WIDE);
           if (!is_static && obj_reg != instruction.VRegB_22c()) {
             // The field access is not on the first parameter.
@@ -386,6 +496,14 @@ const void* SmallPatternMatcher::TryMatch(ArtMethod* method) REQUIRES_SHARED(Loc
           break;
         }
         case Instruction::RETURN_OBJECT:
+          if (is_put) {
+            // A setter returning `this`, as found in builders.
+            if (is_static || is_final || instruction.VRegA_11x() != obj_reg) {
+              return nullptr;
+            }
+            DO_SWITCH(offset, SetFieldObjectAtReturnThis, SetFieldAtReturnThis, field_type);
+          }
+          FALLTHROUGH_INTENDED;
         case Instruction::RETURN_WIDE:
         case Instruction::RETURN: {
           if (is_put || dest_reg != instruction.VRegA_11x()) {
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "startup_trace_recorder.h"
+
+#include "art_method-inl.h"
+#include "base/logging.h"  // For VLOG.
+#include "base/systrace.h"
+#include "base/unix_file/fd_file.h"
+#include "linear_alloc.h"
+#include "mirror/class-inl.h"
+#include "os.h"
+#include "runtime.h"
+#include "runtime_callbacks.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread-current-inl.h"
+#include "thread_list.h"
+
+namespace art HIDDEN {
+
+using EventKind = StartupTrace::EventKind;
+
+StartupTraceRecorder* StartupTraceRecorder::instance_ = nullptr;
+
+StartupTraceRecorder::StartupTraceRecorder(const std::string& output_path)
+    : output_path_(output_path),
+      pthread_(0U),
+      lock_("StartupTraceRecorder lock"),
+      shutdown_cond_("StartupTraceRecorder shutdown condition", lock_),
+      shutting_down_(false),
+      recording_(true) {}
+
+void StartupTraceRecorder::Start(const std::string& output_path) {
+  if (instance_ != nullptr) {
+    return;
+  }
+  if (Runtime::Current()->GetStartupCompleted()) {
+    LOG(WARNING) << "Not recording a startup trace as startup has already completed";
+    return;
+  }
+  VLOG(profiler) << "Starting startup trace recorder writing to " << output_path;
+  instance_ = new StartupTraceRecorder(output_path);
+  CHECK_PTHREAD_CALL(
+      pthread_create,
+      (&instance_->pthread_, nullptr, &RunRecorderThread, reinterpret_cast<void*>(instance_)),
+      "Startup trace recorder thread");
+}
+
+void StartupTraceRecorder::Stop() {
+  Thread* self = Thread::Current();
+  StartupTraceRecorder* recorder = nullptr;
+  pthread_t pthread = 0U;
+  {
+    MutexLock mu(self, *Locks::profiler_lock_);
+    recorder = instance_;
+    if (recorder == nullptr || recorder->pthread_ == 0U) {
+      return;
+    }
+    pthread = recorder->pthread_;
+    recorder->pthread_ = 0U;
+  }
+  {
+    MutexLock mu(self, recorder->lock_);
+    recorder->shutting_down_ = true;
+    recorder->shutdown_cond_.Signal(self);
+  }
+  CHECK_PTHREAD_CALL(pthread_join, (pthread, nullptr), "startup trace recorder thread shutdown");
+}
+
+void StartupTraceRecorder::RemoveMethodsIn(Thread* self, const LinearAlloc& alloc) {
+  MutexLock mu(self, *Locks::profiler_lock_);
+  if (instance_ == nullptr) {
+    return;
+  }
+  MutexLock mu2(self, instance_->lock_);
+  std::vector<PendingMethod>& pending_methods = instance_->pending_methods_;
+  for (size_t i = 0; i < pending_methods.size();) {
+    if (alloc.ContainsUnsafe(pending_methods[i].method)) {
+      pending_methods[i] = pending_methods.back();
+      pending_methods.pop_back();
+    } else {
+      ++i;
+    }
+  }
+}
+
+uint32_t StartupTraceRecorder::GetDexFileIndex(const DexFile& dex_file) {
+  auto it = dex_file_indexes_.find(&dex_file);
+  if (it != dex_file_indexes_.end()) {
+    return it->second;
+  }
+  uint32_t index = trace_.AddDexFile(dex_file.GetLocation(), dex_file.GetLocationChecksum());
+  dex_file_indexes_.emplace(&dex_file, index);
+  return index;
+}
+
+void StartupTraceRecorder::AddDexPage(uint32_t dex_file_index,
+                                      const DexFile& dex_file,
+                                      const void* address) {
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(address);
+  if (ptr < dex_file.Begin() || ptr >= dex_file.Begin() + dex_file.Size()) {
+    // The data section of compact dex files may be shared and outside of the dex file.
+    return;
+  }
+  uint32_t page = static_cast<uint32_t>(ptr - dex_file.Begin()) / StartupTrace::kDexPageSize;
+  if (recorded_pages_.insert((static_cast<uint64_t>(dex_file_index) << 32) | page).second) {
+    trace_.AddEvent(EventKind::kDexPage, dex_file_index, page);
+  }
+}
+
+void StartupTraceRecorder::ClassPrepare([[maybe_unused]] Handle<mirror::Class> temp_klass,
+                                        Handle<mirror::Class> klass) {
+  if (klass->IsBootStrapClassLoaded() || klass->IsProxyClass() || klass->IsArrayClass()) {
+    return;
+  }
+  const DexFile& dex_file = klass->GetDexFile();
+  MutexLock mu(Thread::Current(), lock_);
+  if (!recording_) {
+    return;
+  }
+  uint32_t dex_file_index = GetDexFileIndex(dex_file);
+  trace_.AddEvent(EventKind::kClass, dex_file_index, klass->GetDexTypeIndex().index_);
+  const dex::ClassDef* class_def = klass->GetClassDef();
+  if (class_def != nullptr && dex_file.GetClassData(*class_def) != nullptr) {
+    AddDexPage(dex_file_index, dex_file, dex_file.GetClassData(*class_def));
+  }
+  for (ArtMethod& method : klass->GetDeclaredMethods(kRuntimePointerSize)) {
+    if (method.IsInvokable() && !method.IsNative()) {
+      pending_methods_.push_back({&method, method.GetCounter()});
+    }
+  }
+}
+
+void StartupTraceRecorder::PollMethods() {
+  MutexLock mu(Thread::Current(), lock_);
+  for (size_t i = 0; i < pending_methods_.size();) {
+    ArtMethod* method = pending_methods_[i].method;
+    if (!method->PreviouslyWarm() && method->GetCounter() == pending_methods_[i].counter) {
+      ++i;
+      continue;
+    }
+    const DexFile& dex_file = *method->GetDexFile();
+    uint32_t dex_file_index = GetDexFileIndex(dex_file);
+    trace_.AddEvent(EventKind::kMethod, dex_file_index, method->GetDexMethodIndex());
+    if (method->GetCodeItem() != nullptr) {
+      AddDexPage(dex_file_index, dex_file, method->GetCodeItem());
+    }
+    pending_methods_[i] = pending_methods_.back();
+    pending_methods_.pop_back();
+  }
+}
+
+void StartupTraceRecorder::Write() {
+  ScopedTrace trace(__PRETTY_FUNCTION__);
+  Thread* self = Thread::Current();
+  std::unique_ptr<File> file(OS::CreateEmptyFileWriteOnly(output_path_.c_str()));
+  if (file == nullptr) {
+    PLOG(WARNING) << "Failed to open startup trace file " << output_path_;
+    return;
+  }
+  std::string error_msg;
+  {
+    MutexLock mu(self, lock_);
+    recording_ = false;
+    if (!trace_.Save(file->Fd(), &error_msg)) {
+      LOG(WARNING) << error_msg;
+      file->Erase();
+      return;
+    }
+    VLOG(profiler) << "Wrote startup trace with " << trace_.GetEvents().size() << " events to "
+                   << output_path_;
+  }
+  if (file->FlushCloseOrErase() != 0) {
+    PLOG(WARNING) << "Failed to write startup trace file " << output_path_;
+  }
+}
+
+void StartupTraceRecorder::Run() {
+  Thread* self = Thread::Current();
+  RuntimeCallbacks* callbacks = Runtime::Current()->GetRuntimeCallbacks();
+  {
+    ScopedSuspendAll ssa(__FUNCTION__);
+    callbacks->AddClassLoadCallback(this);
+  }
+  while (true) {
+    {
+      MutexLock mu(self, lock_);
+      if (!shutting_down_) {
+        shutdown_cond_.TimedWait(self, kPollIntervalMs, 0);
+      }
+      if (shutting_down_) {
+        break;
+      }
+    }
+    // Poll once more after startup completed to catch the last methods.
+    bool startup_completed = Runtime::Current()->GetStartupCompleted();
+    {
+      ScopedObjectAccess soa(self);
+      PollMethods();
+    }
+    if (startup_completed) {
+      break;
+    }
+  }
+  {
+    ScopedSuspendAll ssa(__FUNCTION__);
+    callbacks->RemoveClassLoadCallback(this);
+  }
+  Write();
+}
+
+void* StartupTraceRecorder::RunRecorderThread(void* arg) {
+  Runtime* runtime = Runtime::Current();
+
+  bool attached = runtime->AttachCurrentThread("Startup Trace Recorder",
+                                               /*as_daemon=*/true,
+                                               runtime->GetSystemThreadGroup(),
+                                               /*create_peer=*/true);
+  if (!attached) {
+    CHECK(runtime->IsShuttingDown(Thread::Current()));
+    return nullptr;
+  }
+
+  reinterpret_cast<StartupTraceRecorder*>(arg)->Run();
+
+  runtime->DetachCurrentThread();
+  VLOG(profiler) << "Startup trace recorder shutdown";
+  return nullptr;
+}
+
+}  // namespace art
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_STARTUP_TRACE_RECORDER_H_
+#define ART_RUNTIME_JIT_STARTUP_TRACE_RECORDER_H_
+
+#include <pthread.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/locks.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "class_linker.h"
+#include "profile/startup_trace.h"
+
+namespace art HIDDEN {
+
+class ArtMethod;
+class DexFile;
+class LinearAlloc;
+class Thread;
+
+// Records the order in which app classes, methods and dex file pages are first used until
+// startup completes, and writes it as a `StartupTrace`. Classes and the pages of their class
+// data are recorded when the classes are prepared, so classes loaded from an app image are not
+// recorded. Methods and the pages of their code items are recorded when polling finds that
+// their hotness counter changed, which orders methods by polling interval and leaves out
+// methods that only run AOT compiled code.
+class StartupTraceRecorder final : public ClassLoadCallback {
+ public:
+  // Interval between two polls of the methods of the prepared classes.
+  static constexpr uint32_t kPollIntervalMs = 10u;
+
+  // Starts recording into `output_path`. Only the first call in a process has an effect.
+  static void Start(const std::string& output_path) REQUIRES(Locks::profiler_lock_);
+
+  // Stops recording and writes the trace if startup has not completed yet.
+  static void Stop() REQUIRES(!Locks::profiler_lock_, !Locks::mutator_lock_);
+
+  // Forgets the methods allocated in `alloc`, which is about to be freed.
+  static void RemoveMethodsIn(Thread* self, const LinearAlloc& alloc)
+      REQUIRES(!Locks::profiler_lock_);
+
+  void ClassLoad([[maybe_unused]] Handle<mirror::Class> klass) override
+      REQUIRES_SHARED(Locks::mutator_lock_) {}
+  void ClassPrepare(Handle<mirror::Class> temp_klass, Handle<mirror::Class> klass) override
+      REQUIRES(!lock_) REQUIRES_SHARED(Locks::mutator_lock_);
+
+ private:
+  // A method of a prepared class that has not been recorded as executed yet.
+  struct PendingMethod {
+    ArtMethod* method;
+    uint16_t counter;
+  };
+
+  explicit StartupTraceRecorder(const std::string& output_path);
+
+  static void* RunRecorderThread(void* arg) REQUIRES(!Locks::profiler_lock_);
+
+  void Run() REQUIRES(!lock_);
+  void PollMethods() REQUIRES(!lock_) REQUIRES_SHARED(Locks::mutator_lock_);
+  void Write() REQUIRES(!lock_);
+
+  uint32_t GetDexFileIndex(const DexFile& dex_file) REQUIRES(lock_);
+  void AddDexPage(uint32_t dex_file_index, const DexFile& dex_file, const void* address)
+      REQUIRES(lock_);
+
+  // The only instance of the recorder. It is never deleted as it is a class load callback.
+  static StartupTraceRecorder* instance_ GUARDED_BY(Locks::profiler_lock_);
+
+  const std::string output_path_;
+  pthread_t pthread_ GUARDED_BY(Locks::profiler_lock_);
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  ConditionVariable shutdown_cond_ GUARDED_BY(lock_);
+  bool shutting_down_ GUARDED_BY(lock_);
+  bool recording_ GUARDED_BY(lock_);
+  StartupTrace trace_ GUARDED_BY(lock_);
+  std::unordered_map<const DexFile*, uint32_t> dex_file_indexes_ GUARDED_BY(lock_);
+  // Recorded dex pages, as the dex file index in the upper and the page in the lower bits.
+  std::unordered_set<uint64_t> recorded_pages_ GUARDED_BY(lock_);
+  std::vector<PendingMethod> pending_methods_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTraceRecorder);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_STARTUP_TRACE_RECORDER_H_
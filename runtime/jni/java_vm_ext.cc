@@ -511,7 +511,6 @@ JavaVMExt::JavaVMExt(Runtime* runtime, const RuntimeArgumentMap& runtime_options
       tracing_enabled_(runtime_options.Exists(RuntimeArgumentMap::JniTrace)
                        || VLOG_IS_ON(third_party_jni)),
       trace_(runtime_options.GetOrDefault(RuntimeArgumentMap::JniTrace)),
-      globals_(kGlobal),
       libraries_(new Libraries),
       unchecked_functions_(&gJniInvokeInterface),
       weak_globals_(kWeakGlobal),
@@ -521,6 +520,7 @@ JavaVMExt::JavaVMExt(Runtime* runtime, const RuntimeArgumentMap& runtime_options
                                    *Locks::jni_weak_globals_lock_)),
       env_hooks_lock_("environment hooks lock", art::kGenericBottomLock),
       env_hooks_(),
+      native_bridge_trampolines_lock_("native bridge trampolines lock", art::kGenericBottomLock),
       enable_allocation_tracking_delta_(
           runtime_options.GetOrDefault(RuntimeArgumentMap::GlobalRefAllocStackTraceLimit)),
       allocation_tracking_enabled_(false),
@@ -530,8 +530,15 @@ JavaVMExt::JavaVMExt(Runtime* runtime, const RuntimeArgumentMap& runtime_options
 }
 
 bool JavaVMExt::Initialize(std::string* error_msg) {
-  return globals_.Initialize(kGlobalsMax, error_msg) &&
-         weak_globals_.Initialize(kWeakGlobalsMax, error_msg);
+  static_assert(IsPowerOfTwo(kGlobalsShards));
+  // The shard index must not overlap with the index, serial and kind bits of the reference.
+  static_assert(MinimumBitsToStore(kGlobalsMax) + kIRTSerialBits + 2u <= kGlobalsShardShift);
+  for (GlobalsShard& shard : globals_) {
+    if (!shard.table.Initialize(kGlobalsMax / kGlobalsShards, error_msg)) {
+      return false;
+    }
+  }
+  return weak_globals_.Initialize(kWeakGlobalsMax, error_msg);
 }
 
 JavaVMExt::~JavaVMExt() {
@@ -650,7 +657,11 @@ void JavaVMExt::CheckGlobalRefAllocationTracking() {
   if (LIKELY(enable_allocation_tracking_delta_ == 0)) {
     return;
   }
-  size_t simple_free_capacity = globals_.FreeCapacity();
+  // Read without the locks, the result is just an estimate.
+  size_t simple_free_capacity = 0u;
+  for (GlobalsShard& shard : globals_) {
+    simple_free_capacity += shard.table.FreeCapacity();
+  }
   if (UNLIKELY(simple_free_capacity <= enable_allocation_tracking_delta_)) {
     if (!allocation_tracking_enabled_) {
       LOG(WARNING) << "Global reference storage appears close to exhaustion, program termination "
@@ -679,10 +690,15 @@ void JavaVMExt::CheckGlobalRefAllocationTracking() {
   }
 }
 
-void JavaVMExt::MaybeTraceGlobals() {
-  if (global_ref_report_counter_++ == kGlobalRefReportInterval) {
-    global_ref_report_counter_ = 1;
-    ATraceIntegerValue("JNI Global Refs", globals_.NEntriesForGlobal());
+void JavaVMExt::MaybeTraceGlobals(GlobalsShard* shard) {
+  if (shard->report_counter++ == kGlobalRefReportInterval) {
+    shard->report_counter = 1;
+    // Other shards are read without their locks, the total is just an estimate.
+    int32_t entries = 0;
+    for (GlobalsShard& s : globals_) {
+      entries += s.table.NEntriesForGlobal();
+    }
+    ATraceIntegerValue("JNI Global Refs", entries);
   }
 }
 
@@ -698,12 +714,26 @@ jobject JavaVMExt::AddGlobalRef(Thread* self, ObjPtr<mirror::Object> obj) {
   if (obj == nullptr) {
     return nullptr;
   }
-  IndirectRef ref;
+  IndirectRef ref = nullptr;
   std::string error_msg;
   {
-    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
-    ref = globals_.Add(obj, &error_msg);
-    MaybeTraceGlobals();
+    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
+    // Start with the shard of this thread and fall back to the others when it is full.
+    size_t home_shard = static_cast<size_t>(self->GetTid()) & (kGlobalsShards - 1u);
+    for (size_t i = 0; i != kGlobalsShards && ref == nullptr; ++i) {
+      size_t shard_index = (home_shard + i) & (kGlobalsShards - 1u);
+      GlobalsShard* shard = &globals_[shard_index];
+      MutexLock mu2(self, shard->lock);
+      // Only let a shard report overflow if all shards are full.
+      if (shard->table.FreeCapacity() != 0u || i == kGlobalsShards - 1u) {
+        ref = shard->table.Add(obj, &error_msg);
+        MaybeTraceGlobals(shard);
+        if (ref != nullptr) {
+          ref = reinterpret_cast<IndirectRef>(
+              reinterpret_cast<uintptr_t>(ref) | (shard_index << kGlobalsShardShift));
+        }
+      }
+    }
   }
   if (UNLIKELY(ref == nullptr)) {
     LOG(FATAL) << error_msg;
@@ -752,12 +782,15 @@ void JavaVMExt::DeleteGlobalRef(Thread* self, jobject obj) {
     return;
   }
   {
-    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
-    if (!globals_.Remove(obj)) {
+    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
+    IndirectRef ref = obj;
+    GlobalsShard* shard = GetGlobalsShard(&ref);
+    MutexLock mu2(self, shard->lock);
+    if (!shard->table.Remove(ref)) {
       LOG(WARNING) << "JNI WARNING: DeleteGlobalRef(" << obj << ") "
                    << "failed to find entry";
     }
-    MaybeTraceGlobals();
+    MaybeTraceGlobals(shard);
   }
   CheckGlobalRefAllocationTracking();
 }
@@ -795,8 +828,12 @@ void JavaVMExt::DumpForSigQuit(std::ostream& os) {
   }
   Thread* self = Thread::Current();
   {
-    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-    os << "; globals=" << globals_.Capacity();
+    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
+    size_t capacity = 0u;
+    for (GlobalsShard& shard : globals_) {
+      capacity += shard.table.Capacity();
+    }
+    os << "; globals=" << capacity;
   }
   {
     MutexLock mu(self, *Locks::jni_weak_globals_lock_);
@@ -838,12 +875,14 @@ void JavaVMExt::BroadcastForNewWeakGlobals() {
 }
 
 ObjPtr<mirror::Object> JavaVMExt::DecodeGlobal(IndirectRef ref) {
-  return globals_.Get(ref);
+  return GetGlobalsShard(&ref)->table.Get(ref);
 }
 
 void JavaVMExt::UpdateGlobal(Thread* self, IndirectRef ref, ObjPtr<mirror::Object> result) {
-  WriterMutexLock mu(self, *Locks::jni_globals_lock_);
-  globals_.Update(ref, result);
+  ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
+  GlobalsShard* shard = GetGlobalsShard(&ref);
+  MutexLock mu2(self, shard->lock);
+  shard->table.Update(ref, result);
 }
 
 ObjPtr<mirror::Object> JavaVMExt::DecodeWeakGlobal(Thread* self, IndirectRef ref) {
@@ -910,8 +949,10 @@ void JavaVMExt::UpdateWeakGlobal(Thread* self, IndirectRef ref, ObjPtr<mirror::O
 void JavaVMExt::DumpReferenceTables(std::ostream& os) {
   Thread* self = Thread::Current();
   {
-    ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-    globals_.Dump(os);
+    WriterMutexLock mu(self, *Locks::jni_globals_lock_);
+    for (GlobalsShard& shard : globals_) {
+      shard.table.Dump(os);
+    }
   }
   {
     MutexLock mu(self, *Locks::jni_weak_globals_lock_);
@@ -1181,15 +1222,51 @@ void* JavaVMExt::FindCodeForNativeMethod(ArtMethod* m, std::string* error_msg, b
   return native_method;
 }
 
+const void* JavaVMExt::FindOrCreateNativeBridgeTrampoline(const void* fn_ptr, ArtMethod* m) {
+#if defined(ART_TARGET_ANDROID)
+  uint32_t shorty_length;
+  const char* shorty = m->GetShorty(&shorty_length);
+  bool is_critical_native = m->IsCriticalNative();
+  NativeBridgeTrampolineKey key(fn_ptr, std::string(shorty, shorty_length), is_critical_native);
+  Thread* self = Thread::Current();
+  {
+    MutexLock mu(self, native_bridge_trampolines_lock_);
+    auto it = native_bridge_trampolines_.find(key);
+    if (it != native_bridge_trampolines_.end()) {
+      return it->second;
+    }
+  }
+  // Do not hold the lock while calling into the native bridge.
+  android::JNICallType jni_call_type = is_critical_native ?
+                                           android::JNICallType::kJNICallTypeCriticalNative :
+                                           android::JNICallType::kJNICallTypeRegular;
+  const void* trampoline = android::NativeBridgeGetTrampolineForFunctionPointer(
+      fn_ptr, shorty, shorty_length, jni_call_type);
+  if (trampoline == nullptr) {
+    return nullptr;
+  }
+  MutexLock mu(self, native_bridge_trampolines_lock_);
+  // If another thread created a trampoline for the same key meanwhile, keep using the first one.
+  return native_bridge_trampolines_.emplace(std::move(key), trampoline).first->second;
+#else
+  UNUSED(m);
+  return fn_ptr;
+#endif
+}
+
 void JavaVMExt::TrimGlobals() {
   WriterMutexLock mu(Thread::Current(), *Locks::jni_globals_lock_);
-  globals_.Trim();
+  for (GlobalsShard& shard : globals_) {
+    shard.table.Trim();
+  }
 }
 
 void JavaVMExt::VisitRoots(RootVisitor* visitor) {
   Thread* self = Thread::Current();
-  ReaderMutexLock mu(self, *Locks::jni_globals_lock_);
-  globals_.VisitRoots(visitor, RootInfo(kRootJNIGlobal));
+  WriterMutexLock mu(self, *Locks::jni_globals_lock_);
+  for (GlobalsShard& shard : globals_) {
+    shard.table.VisitRoots(visitor, RootInfo(kRootJNIGlobal));
+  }
   // The weak_globals table is visited by the GC itself (because it mutates the table).
 }
 
@@ -19,6 +19,10 @@
 
 #include "jni.h"
 
+#include <map>
+#include <string>
+#include <tuple>
+
 #include "base/macros.h"
 #include "base/mutex.h"
 #include "indirect_reference_table.h"
@@ -126,6 +130,12 @@ class JavaVMExt : public JavaVM {
   void* FindCodeForNativeMethod(ArtMethod* m, std::string* error_msg, bool can_suspend)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Returns the native bridge trampoline for `fn_ptr` registered as the code of `m` from a
+  // natively bridged class loader namespace. Trampolines are created once per function, shorty
+  // and JNI call type, and reused when the same function is registered again.
+  const void* FindOrCreateNativeBridgeTrampoline(const void* fn_ptr, ArtMethod* m)
+      REQUIRES_SHARED(Locks::mutator_lock_) REQUIRES(!native_bridge_trampolines_lock_);
+
   void DumpForSigQuit(std::ostream& os)
       REQUIRES(!Locks::jni_libraries_lock_,
                !Locks::jni_globals_lock_,
@@ -236,9 +246,37 @@ class JavaVMExt : public JavaVM {
       REQUIRES_SHARED(Locks::mutator_lock_)
       REQUIRES(Locks::jni_weak_globals_lock_);
 
+  // Global references are spread over shards with their own locks, so that threads adding and
+  // deleting global references concurrently do not serialize on a single lock. A thread adds
+  // to the shard selected by its tid and the shard index is encoded in the returned reference.
+  //
+  // Adding, removing and updating an entry holds `Locks::jni_globals_lock_` shared and the
+  // shard's lock. Operations on all shards hold `Locks::jni_globals_lock_` exclusively.
+  struct GlobalsShard {
+    GlobalsShard()
+        : lock("JNI globals shard lock", kJniGlobalsShardLock),
+          table(kGlobal),
+          report_counter(kGlobalRefReportInterval) {}
+
+    Mutex lock ACQUIRED_AFTER(Locks::jni_globals_lock_);
+    IndirectReferenceTable table;
+    uint32_t report_counter GUARDED_BY(lock);
+  };
+
+  static constexpr size_t kGlobalsShards = 8u;
+  static constexpr size_t kGlobalsShardShift = 24u;
+
+  // Return the shard of the global reference `*ref` and strip the shard index from it.
+  GlobalsShard* GetGlobalsShard(/*inout*/ IndirectRef* ref) {
+    uintptr_t uref = reinterpret_cast<uintptr_t>(*ref);
+    size_t shard_index = (uref >> kGlobalsShardShift) & (kGlobalsShards - 1u);
+    *ref = reinterpret_cast<IndirectRef>(uref & ~((kGlobalsShards - 1u) << kGlobalsShardShift));
+    return &globals_[shard_index];
+  }
+
   void CheckGlobalRefAllocationTracking();
 
-  inline void MaybeTraceGlobals() REQUIRES(Locks::jni_globals_lock_);
+  inline void MaybeTraceGlobals(GlobalsShard* shard) REQUIRES(shard->lock);
   inline void MaybeTraceWeakGlobals() REQUIRES(Locks::jni_weak_globals_lock_);
 
   Runtime* const runtime_;
@@ -255,7 +293,8 @@ class JavaVMExt : public JavaVM {
   // Extra diagnostics.
   const std::string trace_;
 
-  IndirectReferenceTable globals_;
+  // Global references, see `GlobalsShard`.
+  GlobalsShard globals_[kGlobalsShards];
 
   // No lock annotation since UnloadNativeLibraries is called on libraries_ but locks the
   // jni_libraries_lock_ internally.
@@ -275,6 +314,13 @@ class JavaVMExt : public JavaVM {
   ReaderWriterMutex env_hooks_lock_ BOTTOM_MUTEX_ACQUIRED_AFTER;
   std::vector<GetEnvHook> env_hooks_ GUARDED_BY(env_hooks_lock_);
 
+  // Native bridge trampolines created for `RegisterNatives()`, keyed by the function pointer,
+  // the shorty and whether the method is @CriticalNative.
+  using NativeBridgeTrampolineKey = std::tuple<const void*, std::string, bool>;
+  Mutex native_bridge_trampolines_lock_ BOTTOM_MUTEX_ACQUIRED_AFTER;
+  std::map<NativeBridgeTrampolineKey, const void*> native_bridge_trampolines_
+      GUARDED_BY(native_bridge_trampolines_lock_);
+
   size_t enable_allocation_tracking_delta_;
   std::atomic<bool> allocation_tracking_enabled_;
   std::atomic<bool> old_allocation_tracking_state_;
@@ -283,12 +329,11 @@ class JavaVMExt : public JavaVM {
   static constexpr uint32_t kGlobalRefReportInterval = 17;
   uint32_t weak_global_ref_report_counter_ GUARDED_BY(Locks::jni_weak_globals_lock_)
       = kGlobalRefReportInterval;
-  uint32_t global_ref_report_counter_ GUARDED_BY(Locks::jni_globals_lock_)
-      = kGlobalRefReportInterval;
 
   friend class linker::ImageWriter;  // Uses `globals_` and `weak_globals_` without read barrier.
   friend IndirectReferenceTable* GetIndirectReferenceTable(ScopedObjectAccess& soa,
-                                                           IndirectRefKind kind);
+                                                           IndirectRefKind kind,
+                                                           /*inout*/ IndirectRef* ref);
 
   DISALLOW_COPY_AND_ASSIGN(JavaVMExt);
 };
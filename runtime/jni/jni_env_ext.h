@@ -202,7 +202,8 @@ class JNIEnvExt : public JNIEnv {
   template<bool kEnableIndexIds> friend class JNI;
   friend class Thread;
   friend IndirectReferenceTable* GetIndirectReferenceTable(ScopedObjectAccess& soa,
-                                                           IndirectRefKind kind);
+                                                           IndirectRefKind kind,
+                                                           /*inout*/ IndirectRef* ref);
   friend jni::LocalReferenceTable* GetLocalReferenceTable(ScopedObjectAccess& soa);
   friend void ThreadResetFunctionTable(Thread* thread, void* arg);
   ART_FRIEND_TEST(JniInternalTest, JNIEnvExtOffsets);
@@ -59,7 +59,6 @@
 #include "mirror/string-alloc-inl.h"
 #include "mirror/string-inl.h"
 #include "mirror/throwable.h"
-#include "nativebridge/native_bridge.h"
 #include "nativehelper/scoped_local_ref.h"
 #include "nativeloader/native_loader.h"
 #include "parsed_options.h"
@@ -2372,8 +2371,11 @@ class JNI {
     if (heap->IsMovableObject(array)) {
       if (!gUseReadBarrier && !gUseUserfaultfd) {
         heap->IncrementDisableMovingGC(soa.Self());
+      } else if (heap->TryPinRegionForCritical(array)) {
+        // For the CC collector, keep the array's region from being evacuated rather than
+        // blocking the thread flip for the duration of the critical section.
       } else {
-        // For the CC and CMC collector, we only need to wait for the thread flip rather
+        // For the CMC collector, we only need to wait for the thread flip rather
         // than the whole GC to occur thanks to the to-space invariant.
         heap->IncrementDisableThreadFlip(soa.Self());
       }
@@ -2705,7 +2707,7 @@ class JNI {
       }
 
       if (is_class_loader_namespace_natively_bridged) {
-        fnPtr = GenerateNativeBridgeTrampoline(fnPtr, m);
+        fnPtr = soa.Vm()->FindOrCreateNativeBridgeTrampoline(fnPtr, m);
       }
       const void* final_function_ptr = class_linker->RegisterNative(soa.Self(), m, fnPtr);
       UNUSED(final_function_ptr);
@@ -2940,22 +2942,6 @@ class JNI {
 #endif
   }
 
-  static const void* GenerateNativeBridgeTrampoline(const void* fn_ptr, ArtMethod* method)
-      REQUIRES_SHARED(Locks::mutator_lock_) {
-#if defined(ART_TARGET_ANDROID)
-    uint32_t shorty_length;
-    const char* shorty = method->GetShorty(&shorty_length);
-    android::JNICallType jni_call_type = method->IsCriticalNative() ?
-                                             android::JNICallType::kJNICallTypeCriticalNative :
-                                             android::JNICallType::kJNICallTypeRegular;
-    return NativeBridgeGetTrampolineForFunctionPointer(
-        fn_ptr, shorty, shorty_length, jni_call_type);
-#else
-    UNUSED(method);
-    return fn_ptr;
-#endif
-  }
-
   template <typename ArrayT, typename ElementT, typename ArtArrayT>
   static ElementT* GetPrimitiveArray(JNIEnv* env, ArrayT java_array, jboolean* is_copy) {
     CHECK_NON_NULL_ARGUMENT(java_array);
@@ -3030,7 +3016,7 @@ class JNI {
         // Non copy to a movable object must means that we had disabled the moving GC.
         if (!gUseReadBarrier && !gUseUserfaultfd) {
           heap->DecrementDisableMovingGC(soa.Self());
-        } else {
+        } else if (!heap->TryUnpinRegionForCritical(array)) {
           heap->DecrementDisableThreadFlip(soa.Self());
         }
       }
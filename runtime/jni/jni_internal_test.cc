@@ -20,10 +20,15 @@
 
 #include "art_method-inl.h"
 #include "base/mem_map.h"
+#include "class_root-inl.h"
 #include "common_runtime_test.h"
+#include "gc/heap.h"
+#include "gc/space/large_object_space.h"
+#include "gc/space/region_space.h"
 #include "local_reference_table.h"
 #include "java_vm_ext.h"
 #include "jni_env_ext.h"
+#include "mirror/array-inl.h"
 #include "mirror/string-inl.h"
 #include "nativehelper/scoped_local_ref.h"
 #include "scoped_thread_state_change-inl.h"
@@ -1270,6 +1275,77 @@ TEST_F(JniInternalTest, GetReleasePrimitiveArrayCriticalOfWrongType) {
   GetReleasePrimitiveArrayCriticalOfWrongType(true);
 }
 
+TEST_F(JniInternalTest, GetPrimitiveArrayCriticalPinsRegion) {
+  jintArray array = env_->NewIntArray(16);
+  ASSERT_NE(array, nullptr);
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  bool in_region_space;
+  {
+    ScopedObjectAccess soa(env_);
+    gc::space::RegionSpace* region_space = heap->GetRegionSpace();
+    in_region_space = gUseReadBarrier &&
+                      region_space != nullptr &&
+                      region_space->HasAddress(soa.Decode<mirror::Array>(array).Ptr());
+  }
+  if (!in_region_space) {
+    // Only the CC collector pins regions instead of blocking the thread flip.
+    return;
+  }
+  jboolean is_copy = JNI_TRUE;
+  void* elements = env_->GetPrimitiveArrayCritical(array, &is_copy);
+  ASSERT_NE(elements, nullptr);
+  EXPECT_EQ(is_copy, JNI_FALSE);
+  EXPECT_EQ(Thread::Current()->GetDisableThreadFlipCount(), 0u);
+  // A collection must not block on the critical section, nor move the array.
+  heap->CollectGarbage(/* clear_soft_references= */ false);
+  {
+    ScopedObjectAccess soa(env_);
+    ObjPtr<mirror::IntArray> int_array = soa.Decode<mirror::IntArray>(array);
+    EXPECT_EQ(elements, int_array->GetData());
+  }
+  env_->ReleasePrimitiveArrayCritical(array, elements, 0);
+  // Once unpinned, the region can be evacuated again.
+  heap->CollectGarbage(/* clear_soft_references= */ false);
+  ScopedObjectAccess soa(env_);
+  EXPECT_EQ(soa.Decode<mirror::IntArray>(array)->GetLength(), 16);
+}
+
+// Large arrays from the non-moving allocator (as used by `VMRuntime.newNonMovableArray()`)
+// live in the large object space at a stable, page-aligned address, so their elements can
+// be shared with native code (e.g. through `NewDirectByteBuffer()`) without copies.
+TEST_F(JniInternalTest, NonMovableLargeArrayElementsAreNotCopied) {
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  const jsize length = 4 * gPageSize;
+  jbyteArray array;
+  {
+    ScopedObjectAccess soa(env_);
+    ObjPtr<mirror::Class> array_class = GetClassRoot<mirror::ByteArray>();
+    ObjPtr<mirror::Array> result = mirror::Array::Alloc(soa.Self(),
+                                                        array_class,
+                                                        length,
+                                                        array_class->GetComponentSizeShift(),
+                                                        heap->GetCurrentNonMovingAllocator());
+    ASSERT_TRUE(result != nullptr);
+    EXPECT_FALSE(heap->IsMovableObject(result));
+    gc::space::LargeObjectSpace* los = heap->GetLargeObjectsSpace();
+    if (los != nullptr) {
+      EXPECT_TRUE(los->Contains(result.Ptr()));
+      EXPECT_TRUE(IsAlignedParam(result.Ptr(), gPageSize));
+    }
+    array = soa.AddLocalReference<jbyteArray>(result);
+  }
+  jboolean is_copy = JNI_TRUE;
+  jbyte* elements = env_->GetByteArrayElements(array, &is_copy);
+  ASSERT_NE(elements, nullptr);
+  EXPECT_EQ(is_copy, JNI_FALSE);
+  heap->CollectGarbage(/* clear_soft_references= */ false);
+  jbyte* elements_after_gc = env_->GetByteArrayElements(array, &is_copy);
+  EXPECT_EQ(elements_after_gc, elements);
+  EXPECT_EQ(is_copy, JNI_FALSE);
+  env_->ReleaseByteArrayElements(array, elements_after_gc, JNI_ABORT);
+  env_->ReleaseByteArrayElements(array, elements, 0);
+}
+
 TEST_F(JniInternalTest, GetPrimitiveArrayRegionElementsOfWrongType) {
   GetPrimitiveArrayRegionElementsOfWrongType(false);
   GetPrimitiveArrayRegionElementsOfWrongType(true);
@@ -51,6 +51,8 @@ static inline MemMap NewLRTMap(size_t table_bytes, std::string* error_msg) {
 SmallLrtAllocator::SmallLrtAllocator()
     : free_lists_(num_lrt_slots_, nullptr),
       shared_lrt_maps_(),
+      cached_maps_(),
+      cached_maps_bytes_(0u),
       lock_("Small LRT allocator lock", LockLevel::kGenericBottomLock) {
 }
 
@@ -138,6 +140,41 @@ void SmallLrtAllocator::Deallocate(LrtEntry* unneeded, size_t size) {
   free_lists_[index] = unneeded;
 }
 
+MemMap SmallLrtAllocator::AllocateMap(size_t size, std::string* error_msg) {
+  DCHECK_GE(size, gPageSize / sizeof(LrtEntry));
+  DCHECK(IsPowerOfTwo(size));
+  const size_t table_bytes = size * sizeof(LrtEntry);
+  {
+    MutexLock lock(Thread::Current(), lock_);
+    auto match = [=](MemMap& map) { return map.Size() == table_bytes; };
+    auto it = std::find_if(cached_maps_.begin(), cached_maps_.end(), match);
+    if (it != cached_maps_.end()) {
+      MemMap result = std::move(*it);
+      *it = std::move(cached_maps_.back());
+      cached_maps_.pop_back();
+      DCHECK_GE(cached_maps_bytes_, table_bytes);
+      cached_maps_bytes_ -= table_bytes;
+      return result;
+    }
+  }
+  return NewLRTMap(table_bytes, error_msg);
+}
+
+void SmallLrtAllocator::DeallocateMap(MemMap map) {
+  DCHECK(map.IsValid());
+  if (map.Size() > kMaxCachedMapBytes) {
+    return;  // Unmap.
+  }
+  // Release the memory but keep the mapping. This also zero-initializes it for the next user.
+  map.MadviseDontNeedAndZero();
+  MutexLock lock(Thread::Current(), lock_);
+  if (cached_maps_bytes_ + map.Size() <= kMaxCachedMapBytes) {
+    cached_maps_bytes_ += map.Size();
+    cached_maps_.push_back(std::move(map));
+  }
+  // Otherwise the `map` is unmapped when the argument is destroyed after releasing the lock.
+}
+
 LocalReferenceTable::LocalReferenceTable(bool check_jni)
     : previous_state_(kLRTFirstSegment),
       segment_state_(kLRTFirstSegment),
@@ -187,6 +224,9 @@ LocalReferenceTable::~LocalReferenceTable() {
     for (size_t i = 0; i != num_small_tables; ++i) {
       small_lrt_allocator->Deallocate(tables_[i], GetTableSize(i));
     }
+    for (MemMap& map : table_mem_maps_) {
+      small_lrt_allocator->DeallocateMap(std::move(map));
+    }
   }
 }
 
@@ -213,7 +253,8 @@ bool LocalReferenceTable::Resize(size_t new_size, std::string* error_msg) {
       DCHECK_ALIGNED(new_table, kCheckJniEntriesPerReference * sizeof(LrtEntry));
       tables_.push_back(new_table);
     } else {
-      MemMap new_map = NewLRTMap(new_table_size * sizeof(LrtEntry), error_msg);
+      SmallLrtAllocator* small_lrt_allocator = Runtime::Current()->GetSmallLrtAllocator();
+      MemMap new_map = small_lrt_allocator->AllocateMap(new_table_size, error_msg);
       if (!new_map.IsValid()) {
         DCHECK(!error_msg->empty());
         return false;
@@ -212,6 +212,8 @@ static_assert(kMinPageSize % kInitialLrtBytes == 0);
 static_assert(kInitialLrtBytes % sizeof(LrtEntry) == 0);
 
 // A minimal stopgap allocator for initial small local LRT tables.
+// It also keeps a cache of `MemMap`s released by larger tables, so that threads that need
+// many local references do not mmap and munmap their tables again and again.
 class SmallLrtAllocator {
  public:
   SmallLrtAllocator();
@@ -222,7 +224,19 @@ class SmallLrtAllocator {
 
   void Deallocate(LrtEntry* unneeded, size_t size) REQUIRES(!lock_);
 
+  // Allocate a zero-initialized `MemMap` for a table of `size` `LrtEntries`, reusing a cached
+  // `MemMap` if available. The `size` must be a power of 2 requiring at least a page of memory.
+  MemMap AllocateMap(size_t size, std::string* error_msg) REQUIRES(!lock_);
+
+  // Release the memory of a `MemMap` allocated by `AllocateMap()` and keep the mapping
+  // for reuse unless the cache is full.
+  void DeallocateMap(MemMap map) REQUIRES(!lock_);
+
  private:
+  // The maximum total size of cached `MemMap`s. The cached memory is released to the kernel,
+  // so this limits only the reserved address space.
+  static constexpr size_t kMaxCachedMapBytes = 4 * MB;
+
   // Number of free lists in the allocator.
 #ifdef ART_PAGE_SIZE_AGNOSTIC
   const size_t num_lrt_slots_ = (WhichPowerOf2(gPageSize / kInitialLrtBytes));
@@ -238,6 +252,10 @@ class SmallLrtAllocator {
   // Repository of MemMaps used for small LRT tables.
   dchecked_vector<MemMap> shared_lrt_maps_;
 
+  // MemMaps released by large LRT tables, kept for reuse.
+  dchecked_vector<MemMap> cached_maps_;
+  size_t cached_maps_bytes_;
+
   Mutex lock_;  // Level kGenericBottomLock; acquired before mem_map_lock_, which is a C++ mutex.
 };
 
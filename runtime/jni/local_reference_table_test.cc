@@ -16,6 +16,8 @@
 
 #include "local_reference_table-inl.h"
 
+#include <algorithm>
+
 #include "android-base/stringprintf.h"
 
 #include "class_root-inl.h"
@@ -1024,5 +1026,28 @@ TEST_F(LocalReferenceTableTest, PruneBeforeTrim) {
   ASSERT_EQ(new_ref, refs[0]);
 }
 
+TEST_F(LocalReferenceTableTest, ReuseCachedMaps) {
+  SmallLrtAllocator allocator;
+  std::string error_msg;
+  const size_t size = 2u * gPageSize / sizeof(LrtEntry);
+  MemMap map = allocator.AllocateMap(size, &error_msg);
+  ASSERT_TRUE(map.IsValid()) << error_msg;
+  ASSERT_EQ(size * sizeof(LrtEntry), map.Size());
+  uint8_t* begin = map.Begin();
+  std::fill_n(begin, map.Size(), 0xffu);
+
+  // A map with a different size is not reused.
+  allocator.DeallocateMap(std::move(map));
+  MemMap other_map = allocator.AllocateMap(2u * size, &error_msg);
+  ASSERT_TRUE(other_map.IsValid()) << error_msg;
+  ASSERT_NE(begin, other_map.Begin());
+
+  // A map with the same size is reused and zero-initialized.
+  map = allocator.AllocateMap(size, &error_msg);
+  ASSERT_TRUE(map.IsValid()) << error_msg;
+  ASSERT_EQ(begin, map.Begin());
+  ASSERT_TRUE(std::all_of(map.Begin(), map.End(), [](uint8_t b) { return b == 0u; }));
+}
+
 }  // namespace jni
 }  // namespace art
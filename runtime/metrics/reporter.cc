@@ -201,6 +201,7 @@ ArtMetrics* MetricsReporter::GetMetrics() { return runtime_->GetMetrics(); }
 
 void MetricsReporter::ReportMetrics() {
   ArtMetrics* metrics = GetMetrics();
+  runtime_->UpdateInternalMemoryMetrics();
 
   if (!session_started_) {
     for (auto& backend : backends_) {
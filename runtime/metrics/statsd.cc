@@ -120,6 +120,42 @@ constexpr std::optional<int32_t> EncodeDatumId(DatumId datum_id) {
       return std::make_optional(
           statsd::
               ART_DATUM_REPORTED__KIND__ART_DATUM_GC_FULL_HEAP_TRACING_THROUGHPUT_HISTO_MB_PER_SEC);
+    case DatumId::kGcAllocationRate:
+    case DatumId::kGcPredictedDuration:
+      // Inputs of the adaptive GC trigger, not reported to statsd.
+      return std::nullopt;
+    case DatumId::kJitThrottledTime:
+    case DatumId::kJitThrottledTimeDelta:
+    case DatumId::kSwitchInterpreterMethodEntryCount:
+    case DatumId::kSwitchInterpreterMethodEntryCountDelta:
+    case DatumId::kMonitorSpinAcquiredCount:
+    case DatumId::kMonitorSpinFailedCount:
+    case DatumId::kMonitorContentionTime:
+    case DatumId::kMonitorInflationCount:
+    case DatumId::kSuspendAllSafepointTime:
+    case DatumId::kSuspendAllStragglerCount:
+    case DatumId::kBootImagePrivateDirtyPages:
+    case DatumId::kGcPauseTime:
+    case DatumId::kGcMarkingPauseTime:
+    case DatumId::kGcCompactionPauseTime:
+    case DatumId::kGcFlipPauseTime:
+    case DatumId::kGcRefProcessingTime:
+    case DatumId::kGcUffdFaultTime:
+    case DatumId::kGcUffdMutatorPageCount:
+    case DatumId::kGcUffdGcThreadPageCount:
+    case DatumId::kGcUffdIoctlRetryCount:
+    case DatumId::kGcUffdIoctlErrorCount:
+    case DatumId::kGcForAllocCount:
+    case DatumId::kGcBackgroundCount:
+    case DatumId::kGcExplicitCount:
+    case DatumId::kGcForNativeAllocCount:
+    case DatumId::kGcOtherCauseCount:
+    case DatumId::kMemMapPeakBytes:
+    case DatumId::kArenaPoolPeakBytes:
+    case DatumId::kJitMethodCompileTime:
+    case DatumId::kJitMethodCodeSize:
+      // No atom yet, only reported to the other backends.
+      return std::nullopt;
     case DatumId::kTotalGcCollectionTime:
       return std::make_optional(
           statsd::ART_DATUM_REPORTED__KIND__ART_DATUM_GC_TOTAL_COLLECTION_TIME_MS);
@@ -44,13 +44,55 @@ using android::base::StringPrintf;
 // piece and work our way in.
 // Recursively create an array with multiple dimensions.  Elements may be
 // Objects or primitive types.
+// Fills `array` with new arrays of `leaf_class` and `leaf_length`. The leaves are reserved in
+// as few TLAB bumps as possible since this is where most of a multidimensional array lives.
+static bool FillMultiArrayLeaves(Thread* self,
+                                 Handle<ObjectArray<Array>> array,
+                                 Handle<Class> leaf_class,
+                                 int32_t leaf_length)
+    REQUIRES_SHARED(Locks::mutator_lock_) {
+  size_t component_size_shift = leaf_class->GetComponentSizeShift();
+  size_t leaf_size = ComputeArraySize(leaf_length, component_size_shift);
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  SetLengthVisitor set_length(leaf_length);
+  int32_t length = array->GetLength();
+  int32_t i = 0;
+  auto store_leaf = [&](ObjPtr<Object> leaf) REQUIRES_SHARED(Locks::mutator_lock_) {
+    // Use non-transactional mode without check.
+    array->Set<false, false>(i++, ObjPtr<Array>::DownCast(leaf));
+  };
+  while (i < length) {
+    gc::AllocatorType allocator_type = heap->GetCurrentAllocator();
+    // A zero size means the leaf size overflows, let Array::Alloc() throw.
+    if (leaf_size != 0u &&
+        heap->AllocObjectsInTlab(self,
+                                 leaf_class.Get(),
+                                 leaf_size,
+                                 static_cast<size_t>(length - i),
+                                 allocator_type,
+                                 set_length,
+                                 store_leaf) != 0u) {
+      continue;
+    }
+    // Allocate a single leaf the regular way, this also refills the TLAB.
+    ObjPtr<Array> leaf =
+        Array::Alloc(self, leaf_class.Get(), leaf_length, component_size_shift, allocator_type);
+    if (UNLIKELY(leaf == nullptr)) {
+      CHECK(self->IsExceptionPending());
+      return false;
+    }
+    store_leaf(leaf);
+  }
+  return true;
+}
+
 static ObjPtr<Array> RecursiveCreateMultiArray(Thread* self,
                                                Handle<Class> array_class,
                                                int current_dimension,
                                                Handle<mirror::IntArray> dimensions)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   int32_t array_length = dimensions->Get(current_dimension);
-  StackHandleScope<2> hs(self);
+  StackHandleScope<3> hs(self);
   Handle<mirror::Class> h_component_type(hs.NewHandle(array_class->GetComponentType()));
   size_t component_size_shift = h_component_type->GetPrimitiveTypeSizeShift();
   gc::AllocatorType allocator_type = Runtime::Current()->GetHeap()->GetCurrentAllocator();
@@ -60,7 +102,13 @@ static ObjPtr<Array> RecursiveCreateMultiArray(Thread* self,
     CHECK(self->IsExceptionPending());
     return nullptr;
   }
-  if (current_dimension + 1 < dimensions->GetLength()) {
+  if (current_dimension + 2 == dimensions->GetLength()) {
+    Handle<ObjectArray<Array>> h_array(hs.NewHandle(new_array->AsObjectArray<Array>()));
+    if (UNLIKELY(!FillMultiArrayLeaves(
+            self, h_array, h_component_type, dimensions->Get(current_dimension + 1)))) {
+      return nullptr;
+    }
+  } else if (current_dimension + 1 < dimensions->GetLength()) {
     // Create a new sub-array in every element of the array.
     for (int32_t i = 0; i < array_length; i++) {
       ObjPtr<Array> sub_array =
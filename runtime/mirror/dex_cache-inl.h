@@ -83,6 +83,17 @@ T* DexCache::AllocArray(MemberOffset obj_offset, size_t num, LinearAllocKind kin
   return array;
 }
 
+template <typename T, size_t size>
+template <typename ArrayType>
+inline void DexCachePairArray<T, size>::CopyTo(ArrayType* array) {
+  for (uint32_t slot = 0; slot != size; ++slot) {
+    DexCachePair<T> pair = entries_[slot].load(std::memory_order_acquire);
+    if (pair.index != DexCachePair<T>::InvalidIndexForSlot(slot)) {
+      array->Set(pair.index, pair.object.Read());
+    }
+  }
+}
+
 template <typename T>
 inline DexCachePair<T>::DexCachePair(ObjPtr<T> object, uint32_t index)
     : object(object), index(index) {}
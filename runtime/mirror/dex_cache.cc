@@ -202,6 +202,54 @@ bool DexCache::ShouldAllocateFullArrayAtStartup() {
   return true;
 }
 
+bool DexCache::RecordConflictMiss(DualCacheKind kind) {
+  static_assert(static_cast<size_t>(DualCacheKind::kLast) + 1u ==
+                DexFile::kNumDexCacheMissCounters);
+  if (Runtime::Current()->IsAotCompiler()) {
+    // To save on memory in dex2oat, we don't allocate full arrays.
+    return false;
+  }
+  std::atomic<uint32_t>& counter = GetDexFile()->GetDexCacheMissCounter(static_cast<size_t>(kind));
+  // Only the thread that reaches the threshold switches to the full array, so that other
+  // threads do not contend on the `Locks::dex_cache_lock_` in `AllocArray()`.
+  return counter.fetch_add(1u, std::memory_order_relaxed) + 1u ==
+         kDexCacheConflictMissesForFullArray;
+}
+
+bool DexCache::HasGrownToFullArray(DualCacheKind kind) {
+  // Conflict misses are only recorded while there is no full array, so a full array
+  // present after reaching the threshold is the one allocated by `RecordConflictMiss()`.
+  std::atomic<uint32_t>& counter = GetDexFile()->GetDexCacheMissCounter(static_cast<size_t>(kind));
+  return counter.load(std::memory_order_relaxed) >= kDexCacheConflictMissesForFullArray;
+}
+
+void DexCache::DumpCacheSizes(std::ostream& os) {
+  const DexFile* dex_file = GetDexFile();
+  auto dump = [&](const char* name, size_t num_pairs, size_t num_entries, DualCacheKind kind) {
+    std::atomic<uint32_t>& counter = dex_file->GetDexCacheMissCounter(static_cast<size_t>(kind));
+    os << " " << name << "=";
+    if (num_entries != 0u) {
+      os << num_entries << " (full)";
+    } else {
+      os << num_pairs;
+    }
+    os << " misses=" << counter.load(std::memory_order_relaxed);
+  };
+  os << dex_file->GetLocation() << ":";
+  dump("strings", NumStrings(), NumStringsArray(), DualCacheKind::kStrings);
+  dump("types", NumResolvedTypes(), NumResolvedTypesArray(), DualCacheKind::kResolvedTypes);
+  dump("methods",
+       NumResolvedMethods(),
+       NumResolvedMethodsArray(),
+       DualCacheKind::kResolvedMethods);
+  dump("fields", NumResolvedFields(), NumResolvedFieldsArray(), DualCacheKind::kResolvedFields);
+  dump("method_types",
+       NumResolvedMethodTypes(),
+       NumResolvedMethodTypesArray(),
+       DualCacheKind::kResolvedMethodTypes);
+  os << "\n";
+}
+
 void DexCache::UnlinkStartupCaches() {
   if (GetDexFile() == nullptr) {
     // Unused dex cache.
@@ -141,6 +141,25 @@ template <typename T, size_t size> class NativeDexCachePairArray {
     SetNativePair(entries_, SlotIndex(index), value);
   }
 
+  // Returns whether setting the entry for `index` would evict an entry for another index.
+  bool IsConflict(uint32_t index) REQUIRES_SHARED(Locks::mutator_lock_) {
+    uint32_t slot = SlotIndex(index);
+    size_t stored_index = GetNativePair(entries_, slot).index;
+    return stored_index != index &&
+           stored_index != NativeDexCachePair<T>::InvalidIndexForSlot(slot);
+  }
+
+  // Copy all entries to the full `array` indexed by dex file ids.
+  template <typename ArrayType>
+  void CopyTo(ArrayType* array) REQUIRES_SHARED(Locks::mutator_lock_) {
+    for (uint32_t slot = 0; slot != size; ++slot) {
+      NativeDexCachePair<T> pair = GetNativePair(entries_, slot);
+      if (pair.index != NativeDexCachePair<T>::InvalidIndexForSlot(slot)) {
+        array->Set(static_cast<uint32_t>(pair.index), pair.object);
+      }
+    }
+  }
+
  private:
   NativeDexCachePair<T> GetNativePair(std::atomic<NativeDexCachePair<T>>* pair_array, size_t idx) {
     auto* array = reinterpret_cast<AtomicPair<uintptr_t>*>(pair_array);
@@ -186,6 +205,17 @@ template <typename T, size_t size> class DexCachePairArray {
     entries_[SlotIndex(index)].store(value, std::memory_order_release);
   }
 
+  // Returns whether setting the entry for `index` would evict an entry for another index.
+  bool IsConflict(uint32_t index) REQUIRES_SHARED(Locks::mutator_lock_) {
+    uint32_t slot = SlotIndex(index);
+    uint32_t stored_index = entries_[slot].load(std::memory_order_relaxed).index;
+    return stored_index != index && stored_index != DexCachePair<T>::InvalidIndexForSlot(slot);
+  }
+
+  // Copy all entries to the full `array` indexed by dex file ids.
+  template <typename ArrayType>
+  void CopyTo(ArrayType* array) REQUIRES_SHARED(Locks::mutator_lock_);
+
   void Clear(uint32_t index) {
     uint32_t slot = SlotIndex(index);
     // This is racy but should only be called from the transactional interpreter.
@@ -289,6 +319,20 @@ class MANAGED DexCache final : public Object {
   static_assert(IsPowerOfTwo(kDexCacheMethodTypeCacheSize),
                 "MethodType dex cache size is not a power of 2.");
 
+  // Number of conflict misses in a pair array after which we switch to a full array.
+  // The counters are kept in the `DexFile`, see `RecordConflictMiss()`.
+  static constexpr uint32_t kDexCacheConflictMissesForFullArray = 4096u;
+
+  // Kinds of caches that start with a pair array and can switch to a full array.
+  enum class DualCacheKind : size_t {
+    kResolvedFields,
+    kResolvedMethodTypes,
+    kResolvedMethods,
+    kResolvedTypes,
+    kStrings,
+    kLast = kStrings
+  };
+
   // Size of an instance of java.lang.DexCache not including referenced values.
   static constexpr uint32_t InstanceSize() {
     return sizeof(DexCache);
@@ -392,6 +436,16 @@ class MANAGED DexCache final : public Object {
     return number_of_elements <= dex_cache_size;
   }
 
+  // Record a conflict miss in the pair array of the given kind. Returns true when the pair
+  // array has seen enough conflicts that it should be replaced by a full array.
+  bool RecordConflictMiss(DualCacheKind kind) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns whether the full array of the given kind replaced the pair array at runtime.
+  bool HasGrownToFullArray(DualCacheKind kind) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Dump the sizes of the caches and the numbers of conflict misses for SIGQUIT.
+  void DumpCacheSizes(std::ostream& os) REQUIRES_SHARED(Locks::mutator_lock_);
+
 
 // NOLINTBEGIN(bugprone-macro-parentheses)
 #define DEFINE_ARRAY(name, array_kind, getter_setter, type, ids, alloc_kind) \
@@ -479,6 +533,12 @@ class MANAGED DexCache final : public Object {
           pairs = Allocate ##getter_setter(); \
           pairs->Set(index, resolved); \
         } \
+      } else if (UNLIKELY(pairs->IsConflict(index)) && \
+                 RecordConflictMiss(DualCacheKind::k ##getter_setter)) { \
+        /* This pair array is too small for the dex file, switch to a full array. */ \
+        array = Allocate ##getter_setter ##Array(); \
+        pairs->CopyTo(array); \
+        array->Set(index, resolved); \
       } else { \
         pairs->Set(index, resolved); \
       } \
@@ -486,7 +546,8 @@ class MANAGED DexCache final : public Object {
   } \
   void Unlink ##getter_setter ##ArrayIfStartup() \
       REQUIRES_SHARED(Locks::mutator_lock_) { \
-    if (!ShouldAllocateFullArray(GetDexFile()->ids(), pair_size)) { \
+    if (!ShouldAllocateFullArray(GetDexFile()->ids(), pair_size) && \
+        !HasGrownToFullArray(DualCacheKind::k ##getter_setter)) { \
       Set ##getter_setter ##Array(nullptr) ; \
     } \
   }
@@ -72,6 +72,43 @@ TEST_F(DexCacheMethodHandlesTest, Open) {
   EXPECT_EQ(0u, dex_cache->NumResolvedMethodTypes());
 }
 
+TEST_F(DexCacheTest, GrowToFullArray) {
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<1> hs(soa.Self());
+  ASSERT_TRUE(java_lang_dex_file_ != nullptr);
+  ASSERT_GT(java_lang_dex_file_->NumMethodIds(), DexCache::kDexCacheMethodCacheSize);
+  Handle<DexCache> dex_cache(
+      hs.NewHandle(class_linker_->AllocAndInitializeDexCache(
+          soa.Self(), *java_lang_dex_file_, /*class_loader=*/nullptr)));
+  ASSERT_TRUE(dex_cache != nullptr);
+
+  // The miss counter is shared with the runtime's dex cache for the same dex file.
+  std::atomic<uint32_t>& counter = java_lang_dex_file_->GetDexCacheMissCounter(
+      static_cast<size_t>(DexCache::DualCacheKind::kResolvedMethods));
+  uint32_t old_misses = counter.exchange(0u);
+
+  // Alternate between two method indexes that map to the same slot of the pair array.
+  ArtMethod* method = Runtime::Current()->GetResolutionMethod();
+  uint32_t index1 = 1u;
+  uint32_t index2 = index1 + DexCache::kDexCacheMethodCacheSize;
+  for (uint32_t i = 0; i != DexCache::kDexCacheConflictMissesForFullArray; ++i) {
+    dex_cache->SetResolvedMethod((i % 2u == 0u) ? index1 : index2, method);
+  }
+  // All but the first store were conflict misses.
+  EXPECT_EQ(DexCache::kDexCacheConflictMissesForFullArray - 1u, counter.load());
+  EXPECT_EQ(0u, dex_cache->NumResolvedMethodsArray());
+  EXPECT_EQ(DexCache::kDexCacheMethodCacheSize, dex_cache->NumResolvedMethods());
+
+  // The next conflict miss switches to the full array and keeps the cached entries.
+  dex_cache->SetResolvedMethod(index1, method);
+  EXPECT_EQ(java_lang_dex_file_->NumMethodIds(), dex_cache->NumResolvedMethodsArray());
+  EXPECT_EQ(method, dex_cache->GetResolvedMethod(index1));
+  EXPECT_EQ(method, dex_cache->GetResolvedMethod(index2));
+  EXPECT_TRUE(dex_cache->GetResolvedMethod(index1 + 1u) == nullptr);
+
+  counter.store(old_misses);
+}
+
 TEST_F(DexCacheTest, TestResolvedFieldAccess) {
   ScopedObjectAccess soa(Thread::Current());
   jobject jclass_loader(LoadDex("Packages"));
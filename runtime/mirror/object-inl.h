@@ -75,6 +75,12 @@ inline void Object::SetLockWord(LockWord new_val, bool as_volatile) {
   }
 }
 
+inline void Object::SetLockWordRelease(LockWord new_val) {
+  uint8_t* raw_addr = reinterpret_cast<uint8_t*>(this) + MonitorOffset().Int32Value();
+  reinterpret_cast<Atomic<uint32_t>*>(raw_addr)->store(new_val.GetValue(),
+                                                       std::memory_order_release);
+}
+
 inline uint32_t Object::GetLockOwnerThreadId() {
   return Monitor::GetLockOwnerThreadId(this);
 }
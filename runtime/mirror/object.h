@@ -159,6 +159,9 @@ class EXPORT MANAGED LOCKABLE Object {
   LockWord GetLockWord(bool as_volatile) REQUIRES_SHARED(Locks::mutator_lock_);
   template<VerifyObjectFlags kVerifyFlags = kDefaultVerifyFlags>
   void SetLockWord(LockWord new_val, bool as_volatile) REQUIRES_SHARED(Locks::mutator_lock_);
+  // Store the lock word with release ordering. This is all that releasing a thin lock needs
+  // and avoids the full barrier of a sequentially consistent store.
+  void SetLockWordRelease(LockWord new_val) REQUIRES_SHARED(Locks::mutator_lock_);
   bool CasLockWord(LockWord old_val, LockWord new_val, CASMode mode, std::memory_order memory_order)
       REQUIRES_SHARED(Locks::mutator_lock_);
   uint32_t GetLockOwnerThreadId() REQUIRES_SHARED(Locks::mutator_lock_);
@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <memory>
+#include <set>
 
 #include "array-alloc-inl.h"
 #include "array-inl.h"
@@ -399,6 +400,39 @@ TEST_F(ObjectTest, CreateMultiArray) {
   }
 }
 
+TEST_F(ObjectTest, CreateMultiArrayLeaves) {
+  ScopedObjectAccess soa(Thread::Current());
+
+  StackHandleScope<4> hs(soa.Self());
+  Handle<Class> double_class(hs.NewHandle(class_linker_->FindSystemClass(soa.Self(), "D")));
+  Handle<IntArray> dims(hs.NewHandle(IntArray::Alloc(soa.Self(), 3)));
+  // Enough leaves to need several TLABs.
+  dims->Set<false>(0, 3);
+  dims->Set<false>(1, 1000);
+  dims->Set<false>(2, 7);
+  Handle<ObjectArray<ObjectArray<DoubleArray>>> multi =
+      hs.NewHandle(Array::CreateMultiArray(soa.Self(), double_class, dims)
+                       ->AsObjectArray<ObjectArray<DoubleArray>>());
+  Handle<Class> double_array_class =
+      hs.NewHandle(class_linker_->FindSystemClass(soa.Self(), "[D"));
+  ASSERT_EQ(3, multi->GetLength());
+  std::set<DoubleArray*> leaves;
+  for (int32_t i = 0; i < 3; ++i) {
+    ObjPtr<ObjectArray<DoubleArray>> middle = multi->Get(i);
+    ASSERT_EQ(1000, middle->GetLength());
+    for (int32_t j = 0; j < 1000; ++j) {
+      ObjPtr<DoubleArray> leaf = middle->Get(j);
+      ASSERT_TRUE(leaf != nullptr);
+      EXPECT_OBJ_PTR_EQ(double_array_class.Get(), leaf->GetClass());
+      ASSERT_EQ(7, leaf->GetLength());
+      for (int32_t k = 0; k < 7; ++k) {
+        EXPECT_EQ(0.0, leaf->Get(k));
+      }
+      EXPECT_TRUE(leaves.insert(leaf.Ptr()).second);
+    }
+  }
+}
+
 TEST_F(ObjectTest, StaticFieldFromCode) {
   // pretend we are trying to access 'Static.s0' from StaticsFromCode.<clinit>
   ScopedObjectAccess soa(Thread::Current());
@@ -523,6 +557,34 @@ TEST_F(ObjectTest, StringCompareTo) {
   EXPECT_GT(0, string_5->CompareTo(string.Get()));
 }
 
+TEST_F(ObjectTest, StringCompareToMixedEncodings) {
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<4> hs(soa.Self());
+  // Long enough to go through the block comparison; the `\xc3\xa9` suffix is a non-ASCII
+  // character, so the last two strings are not compressed even with string compression.
+  Handle<String> compressed(hs.NewHandle(String::AllocFromModifiedUtf8(
+      soa.Self(), "0123456789abcdefghijklmnopqrstuvwxyz")));
+  Handle<String> compressed_2(hs.NewHandle(String::AllocFromModifiedUtf8(
+      soa.Self(), "0123456789abcdefghijKlmnopqrstuvwxyz")));
+  Handle<String> uncompressed(hs.NewHandle(String::AllocFromModifiedUtf8(
+      soa.Self(), "0123456789abcdefghijklmnopqrstuvwxyz\xc3\xa9")));
+  Handle<String> uncompressed_2(hs.NewHandle(String::AllocFromModifiedUtf8(
+      soa.Self(), "0123456789abcdefghijKlmnopqrstuvwxyz\xc3\xa9")));
+  EXPECT_LT(0, compressed->CompareTo(compressed_2.Get()));
+  EXPECT_GT(0, compressed_2->CompareTo(compressed.Get()));
+  EXPECT_GT(0, compressed->CompareTo(uncompressed.Get()));
+  EXPECT_LT(0, uncompressed->CompareTo(compressed.Get()));
+  EXPECT_LT(0, compressed->CompareTo(uncompressed_2.Get()));
+  EXPECT_GT(0, uncompressed_2->CompareTo(compressed.Get()));
+  EXPECT_EQ('k' - 'K', uncompressed->CompareTo(compressed_2.Get()));
+
+  EXPECT_EQ(20, compressed->FastIndexOf('k', 0));
+  EXPECT_EQ(20, uncompressed->FastIndexOf('k', 0));
+  EXPECT_EQ(-1, compressed->FastIndexOf('k', 21));
+  EXPECT_EQ(-1, compressed->FastIndexOf(0xe9, 0));
+  EXPECT_EQ(36, uncompressed->FastIndexOf(0xe9, 0));
+}
+
 TEST_F(ObjectTest, StringLength) {
   ScopedObjectAccess soa(Thread::Current());
   StackHandleScope<1> hs(soa.Self());
@@ -59,6 +59,18 @@ template <typename MemoryType>
 int32_t String::FastIndexOf(MemoryType* chars, int32_t ch, int32_t start) {
   const MemoryType* p = chars + start;
   const MemoryType* end = chars + GetLength();
+  // Skip blocks without a match with a branch-free test that the compiler can vectorize.
+  static constexpr size_t kBlockSize = 16u;
+  while (static_cast<size_t>(end - p) >= kBlockSize) {
+    bool found = false;
+    for (size_t i = 0; i != kBlockSize; ++i) {
+      found |= (p[i] == ch);
+    }
+    if (found) {
+      break;
+    }
+    p += kBlockSize;
+  }
   while (p < end) {
     if (*p++ == ch) {
       return (p - 1) - chars;
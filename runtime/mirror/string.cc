@@ -35,6 +35,47 @@
 namespace art HIDDEN {
 namespace mirror {
 
+// Characters are processed in blocks with a branch-free reduction that the compiler can
+// vectorize, the scalar loop then only runs over the block that contains the result.
+static constexpr size_t kStringBlockSize = 16u;
+
+// Returns the index of the first character that differs between `lhs` and `rhs`, or `count`
+// if the first `count` characters are equal. The two sides may use different encodings.
+template <typename LhsType, typename RhsType>
+ALWAYS_INLINE static size_t FindFirstMismatch(const LhsType* lhs,
+                                              const RhsType* rhs,
+                                              size_t count) {
+  size_t i = 0u;
+  for (; count - i >= kStringBlockSize; i += kStringBlockSize) {
+    uint32_t diff = 0u;
+    for (size_t j = 0; j != kStringBlockSize; ++j) {
+      diff |= static_cast<uint32_t>(lhs[i + j]) ^ static_cast<uint32_t>(rhs[i + j]);
+    }
+    if (diff != 0u) {
+      break;
+    }
+  }
+  for (; i != count; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return i;
+    }
+  }
+  return count;
+}
+
+// Inflates compressed characters to UTF-16.
+ALWAYS_INLINE static void InflateCompressedChars(const uint8_t* src, uint16_t* dest, size_t count) {
+  size_t i = 0u;
+  for (; count - i >= kStringBlockSize; i += kStringBlockSize) {
+    for (size_t j = 0; j != kStringBlockSize; ++j) {
+      dest[i + j] = src[i + j];
+    }
+  }
+  for (; i != count; ++i) {
+    dest[i] = src[i];
+  }
+}
+
 int32_t String::FastIndexOf(int32_t ch, int32_t start) {
   int32_t count = GetLength();
   if (start >= count) {
@@ -43,7 +84,13 @@ int32_t String::FastIndexOf(int32_t ch, int32_t start) {
     start = 0;
   }
   if (IsCompressed()) {
-    return FastIndexOf<uint8_t>(GetValueCompressed(), ch, start);
+    // Compressed strings contain only ASCII characters, so a non-ASCII `ch` cannot be found.
+    if (static_cast<uint32_t>(ch) > 0xffffu || !IsASCII(static_cast<uint16_t>(ch))) {
+      return -1;
+    }
+    const uint8_t* chars = GetValueCompressed();
+    const void* match = memchr(chars + start, ch, count - start);
+    return (match != nullptr) ? static_cast<const uint8_t*>(match) - chars : -1;
   } else {
     return FastIndexOf<uint16_t>(GetValue(), ch, start);
   }
@@ -345,22 +392,19 @@ int32_t String::CompareTo(ObjPtr<String> rhs) {
   if (lhs->IsCompressed() && rhs->IsCompressed()) {
     const uint8_t* lhs_chars = lhs->GetValueCompressed();
     const uint8_t* rhs_chars = rhs->GetValueCompressed();
-    for (int32_t i = 0; i < min_count; ++i) {
-      int32_t char_diff = static_cast<int32_t>(lhs_chars[i]) - static_cast<int32_t>(rhs_chars[i]);
-      if (char_diff != 0) {
-        return char_diff;
-      }
+    size_t i = FindFirstMismatch(lhs_chars, rhs_chars, min_count);
+    if (i != static_cast<size_t>(min_count)) {
+      return static_cast<int32_t>(lhs_chars[i]) - static_cast<int32_t>(rhs_chars[i]);
     }
   } else if (lhs->IsCompressed() || rhs->IsCompressed()) {
     const uint8_t* compressed_chars =
         lhs->IsCompressed() ? lhs->GetValueCompressed() : rhs->GetValueCompressed();
     const uint16_t* uncompressed_chars = lhs->IsCompressed() ? rhs->GetValue() : lhs->GetValue();
-    for (int32_t i = 0; i < min_count; ++i) {
+    size_t i = FindFirstMismatch(compressed_chars, uncompressed_chars, min_count);
+    if (i != static_cast<size_t>(min_count)) {
       int32_t char_diff =
           static_cast<int32_t>(compressed_chars[i]) - static_cast<int32_t>(uncompressed_chars[i]);
-      if (char_diff != 0) {
-        return lhs->IsCompressed() ? char_diff : -char_diff;
-      }
+      return lhs->IsCompressed() ? char_diff : -char_diff;
     }
   } else {
     const uint16_t* lhs_chars = lhs->GetValue();
@@ -379,12 +423,8 @@ ObjPtr<CharArray> String::ToCharArray(Handle<String> h_this, Thread* self) {
   ObjPtr<CharArray> result = CharArray::Alloc(self, h_this->GetLength());
   if (result != nullptr) {
     if (h_this->IsCompressed()) {
-      int32_t length = h_this->GetLength();
-      const uint8_t* src = h_this->GetValueCompressed();
-      uint16_t* dest = result->GetData();
-      for (int i = 0; i < length; ++i) {
-        dest[i] = src[i];
-      }
+      InflateCompressedChars(
+          h_this->GetValueCompressed(), result->GetData(), h_this->GetLength());
     } else {
       memcpy(result->GetData(), h_this->GetValue(), h_this->GetLength() * sizeof(uint16_t));
     }
@@ -399,10 +439,7 @@ void String::GetChars(int32_t start, int32_t end, Handle<CharArray> array, int32
   DCHECK_LE(start, end);
   int32_t length = end - start;
   if (IsCompressed()) {
-    const uint8_t* value = GetValueCompressed() + start;
-    for (int i = 0; i < length; ++i) {
-      data[i] = value[i];
-    }
+    InflateCompressedChars(GetValueCompressed() + start, data, length);
   } else {
     uint16_t* value = GetValue() + start;
     memcpy(data, value, length * sizeof(uint16_t));
@@ -339,6 +339,10 @@ class MANAGED ByteBufferViewVarHandle : public VarHandle {
 
   bool GetNativeByteOrder() REQUIRES_SHARED(Locks::mutator_lock_);
 
+  static MemberOffset NativeByteOrderOffset() {
+    return MemberOffset(OFFSETOF_MEMBER(ByteBufferViewVarHandle, native_byte_order_));
+  }
+
  private:
   bool AccessHeapBuffer(AccessMode access_mode,
                         ObjPtr<Object> byte_buffer,
@@ -355,10 +359,6 @@ class MANAGED ByteBufferViewVarHandle : public VarHandle {
                          JValue* result)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  static MemberOffset NativeByteOrderOffset() {
-    return MemberOffset(OFFSETOF_MEMBER(ByteBufferViewVarHandle, native_byte_order_));
-  }
-
   // Flag indicating that accessors should use native byte-ordering.
   uint8_t native_byte_order_;
 
@@ -53,6 +53,10 @@ using android::base::StringPrintf;
 static constexpr uint64_t kDebugThresholdFudgeFactor = kIsDebugBuild ? 10 : 1;
 static constexpr uint64_t kLongWaitMs = 100 * kDebugThresholdFudgeFactor;
 
+// Bounds of the per-monitor spin budget used by `Monitor::TryLock()`.
+static constexpr uint32_t kMinSpinBudget = 1u;
+static constexpr uint32_t kMaxSpinBudget = 2u * Mutex::kDefaultMaxSpins;
+
 /*
  * Every Object has a monitor associated with it, but not every Object is actually locked.  Even
  * the ones that are locked do not need a full-fledged monitor until a) there is actual contention
@@ -97,6 +101,7 @@ void Monitor::Init(uint32_t lock_profiling_threshold,
 Monitor::Monitor(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, int32_t hash_code)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_budget_(Mutex::kDefaultMaxSpins),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -131,6 +136,7 @@ Monitor::Monitor(Thread* self,
                  MonitorId id)
     : monitor_lock_("a monitor lock", kMonitorLock),
       num_waiters_(0),
+      spin_budget_(Mutex::kDefaultMaxSpins),
       owner_(owner),
       lock_count_(0),
       obj_(GcRoot<mirror::Object>(obj)),
@@ -426,8 +432,24 @@ bool Monitor::TryLock(Thread* self, bool spin) {
     lock_count_++;
     CHECK_NE(lock_count_, 0u);  // Abort on overflow.
   } else {
-    bool success = spin ? monitor_lock_.ExclusiveTryLockWithSpinning(self)
-        : monitor_lock_.ExclusiveTryLock(self);
+    bool success = monitor_lock_.ExclusiveTryLock(self);
+    if (!success && spin) {
+      uint32_t spin_budget = spin_budget_.load(std::memory_order_relaxed);
+      success = monitor_lock_.ExclusiveTryLockWithSpinning(self, spin_budget);
+      // Learn from the outcome. The budget is only a hint, so racy updates are fine.
+      uint32_t new_spin_budget = success
+          ? std::min(spin_budget + 1u, kMaxSpinBudget)
+          : std::max(spin_budget / 2u, kMinSpinBudget);
+      if (new_spin_budget != spin_budget) {
+        spin_budget_.store(new_spin_budget, std::memory_order_relaxed);
+      }
+      metrics::ArtMetrics* metrics = Runtime::Current()->GetMetrics();
+      if (success) {
+        metrics->MonitorSpinAcquiredCount()->AddOne();
+      } else {
+        metrics->MonitorSpinFailedCount()->AddOne();
+      }
+    }
     if (!success) {
       return false;
     }
@@ -521,7 +543,10 @@ void Monitor::Lock(Thread* self) {
     // Acquire monitor_lock_ without mutator_lock_, expecting to block this time.
     // We already tried spinning above. The shutdown procedure currently assumes we stop
     // touching monitors shortly after we suspend, so don't spin again here.
+    uint64_t block_start_ns = NanoTime();
     monitor_lock_.ExclusiveLock(self);
+    Runtime::Current()->GetMetrics()->MonitorContentionTime()->Add(
+        NsToUs(NanoTime() - block_start_ns));
 
     if (log_contention && orig_owner != nullptr) {
       // Woken from contention.
@@ -1049,7 +1074,9 @@ void Monitor::Inflate(Thread* self, Thread* owner, ObjPtr<mirror::Object> obj, i
       VLOG(monitor) << "monitor: Inflate with hashcode " << hash_code
           << " created monitor " << m << " for object " << obj;
     }
-    Runtime::Current()->GetMonitorList()->Add(m);
+    Runtime* runtime = Runtime::Current();
+    runtime->GetMonitorList()->Add(m);
+    runtime->GetMetrics()->MonitorInflationCount()->AddOne();
     CHECK_EQ(obj->GetLockWord(true).GetState(), LockWord::kFatLocked);
   } else {
     MonitorPool::ReleaseMonitor(self, m);
@@ -1245,10 +1272,8 @@ bool Monitor::MonitorExit(Thread* self, ObjPtr<mirror::Object> obj) {
           }
           if (!gUseReadBarrier) {
             DCHECK_EQ(new_lw.ReadBarrierState(), 0U);
-            // TODO: This really only needs memory_order_release, but we currently have
-            // no way to specify that. In fact there seem to be no legitimate uses of SetLockWord
-            // with a final argument of true. This slows down x86 and ARMv7, but probably not v8.
-            h_obj->SetLockWord(new_lw, true);
+            // Releasing the lock only needs release ordering, like the compiled code fast path.
+            h_obj->SetLockWordRelease(new_lw);
             AtraceMonitorUnlock();
             // Success!
             return true;
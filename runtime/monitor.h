@@ -332,6 +332,11 @@ class Monitor {
   // monitor acquisition. Prevents deflation.
   std::atomic<size_t> num_waiters_;
 
+  // Maximum number of spins `TryLock()` does on a contended acquisition. It grows when
+  // spinning succeeds and shrinks when we end up blocking anyway, so that we do not waste
+  // cycles on monitors held for long periods.
+  std::atomic<uint32_t> spin_budget_;
+
   // Which thread currently owns the lock? monitor_lock_ only keeps the tid.
   // Only set while holding monitor_lock_. Non-locking readers only use it to
   // compare to self or for debugging.
@@ -433,8 +438,9 @@ class Monitor {
   MonitorId monitor_id_;
 
 #ifdef __LP64__
-  // Free list for monitor pool.
-  Monitor* next_free_ GUARDED_BY(Locks::allocated_monitor_ids_lock_);
+  // Free list for monitor pool. Guarded by `Locks::allocated_monitor_ids_lock_` while the monitor
+  // is on the global free list, and owned by the thread while it is in a thread-local cache.
+  Monitor* next_free_;
 #endif
 
   friend class MonitorInfo;
@@ -110,17 +110,14 @@ Monitor* MonitorPool::CreateMonitorInPool(Thread* self,
                                           ObjPtr<mirror::Object> obj,
                                           int32_t hash_code)
     REQUIRES_SHARED(Locks::mutator_lock_) {
-  // We are gonna allocate, so acquire the writer lock.
-  MutexLock mu(self, *Locks::allocated_monitor_ids_lock_);
-
-  // Enough space, or need to resize?
-  if (first_free_ == nullptr) {
-    VLOG(monitor) << "Allocating a new chunk.";
-    AllocateChunk();
+  // Take the monitor from the thread-local cache, refilling it from the pool if needed.
+  if (self->monitor_cache_ == nullptr) {
+    RefillThreadLocalCache(self);
   }
 
-  Monitor* mon_uninitialized = first_free_;
-  first_free_ = first_free_->next_free_;
+  Monitor* mon_uninitialized = self->monitor_cache_;
+  self->monitor_cache_ = mon_uninitialized->next_free_;
+  --self->monitor_cache_size_;
 
   // Pull out the id which was preinitialized.
   MonitorId id = mon_uninitialized->monitor_id_;
@@ -132,28 +129,91 @@ Monitor* MonitorPool::CreateMonitorInPool(Thread* self,
 }
 
 void MonitorPool::ReleaseMonitorToPool(Thread* self, Monitor* monitor) {
-  // Might be racy with allocation, so acquire lock.
+  DestroyMonitor(monitor);
+
+  if (self == nullptr) {
+    // Not attached, e.g. during shutdown. Return the monitor to the global free list.
+    MutexLock mu(self, *Locks::allocated_monitor_ids_lock_);
+    monitor->next_free_ = first_free_;
+    first_free_ = monitor;
+    return;
+  }
+
+  // Add to the head of the thread-local cache.
+  monitor->next_free_ = self->monitor_cache_;
+  self->monitor_cache_ = monitor;
+  ++self->monitor_cache_size_;
+  if (self->monitor_cache_size_ > kMaxThreadCacheSize) {
+    FlushThreadLocalCache(self, self->monitor_cache_size_ / 2u);
+  }
+}
+
+void MonitorPool::ReleaseMonitorsToPool(Thread* self, MonitorList::Monitors* monitors) {
+  if (monitors->empty()) {
+    return;
+  }
+  // Link all monitors first and splice them into the free list with a single lock acquisition.
+  Monitor* first = nullptr;
+  Monitor* last = nullptr;
+  for (Monitor* mon : *monitors) {
+    DestroyMonitor(mon);
+    mon->next_free_ = first;
+    first = mon;
+    if (last == nullptr) {
+      last = mon;
+    }
+  }
+  MutexLock mu(self, *Locks::allocated_monitor_ids_lock_);
+  last->next_free_ = first_free_;
+  first_free_ = first;
+}
+
+void MonitorPool::RefillThreadLocalCache(Thread* self) {
+  DCHECK(self->monitor_cache_ == nullptr);
+  DCHECK_EQ(self->monitor_cache_size_, 0u);
+  // We are gonna allocate, so acquire the writer lock.
   MutexLock mu(self, *Locks::allocated_monitor_ids_lock_);
 
-  // Keep the monitor id. Don't trust it's not cleared.
-  MonitorId id = monitor->monitor_id_;
+  // Enough space, or need to resize?
+  if (first_free_ == nullptr) {
+    VLOG(monitor) << "Allocating a new chunk.";
+    AllocateChunk();
+  }
 
-  // Call the destructor.
-  // TODO: Exception safety?
-  monitor->~Monitor();
+  Monitor* first = first_free_;
+  Monitor* last = first;
+  size_t count = 1u;
+  while (count != kThreadCacheRefillSize && last->next_free_ != nullptr) {
+    last = last->next_free_;
+    ++count;
+  }
+  first_free_ = last->next_free_;
+  last->next_free_ = nullptr;
+  self->monitor_cache_ = first;
+  self->monitor_cache_size_ = count;
+}
 
-  // Add to the head of the free list.
-  monitor->next_free_ = first_free_;
-  first_free_ = monitor;
+void MonitorPool::FlushThreadLocalCache(Thread* self, size_t count) {
+  DCHECK_NE(count, 0u);
+  DCHECK_LE(count, self->monitor_cache_size_);
+  Monitor* first = self->monitor_cache_;
+  Monitor* last = first;
+  for (size_t i = 1u; i != count; ++i) {
+    last = last->next_free_;
+  }
+  self->monitor_cache_ = last->next_free_;
+  self->monitor_cache_size_ -= count;
 
-  // Rewrite monitor id.
-  monitor->monitor_id_ = id;
+  MutexLock mu(self, *Locks::allocated_monitor_ids_lock_);
+  last->next_free_ = first_free_;
+  first_free_ = first;
 }
 
-void MonitorPool::ReleaseMonitorsToPool(Thread* self, MonitorList::Monitors* monitors) {
-  for (Monitor* mon : *monitors) {
-    ReleaseMonitorToPool(self, mon);
+void MonitorPool::RevokeThreadLocalCacheInPool(Thread* self) {
+  if (self->monitor_cache_size_ != 0u) {
+    FlushThreadLocalCache(self, self->monitor_cache_size_);
   }
+  DCHECK(self->monitor_cache_ == nullptr);
 }
 
 }  // namespace art
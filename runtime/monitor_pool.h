@@ -83,6 +83,15 @@ class MonitorPool {
 #endif
   }
 
+  // Returns the monitors cached by `self` to the pool. Called when the thread is detached.
+  static void RevokeThreadLocalCache(Thread* self) {
+#ifndef __LP64__
+    UNUSED(self);
+#else
+    GetMonitorPool()->RevokeThreadLocalCacheInPool(self);
+#endif
+  }
+
   static MonitorId MonitorIdFromMonitor(Monitor* mon) {
 #ifndef __LP64__
     return reinterpret_cast<MonitorId>(mon) >> LockWord::kMonitorIdAlignmentShift;
@@ -135,6 +144,25 @@ class MonitorPool {
   void ReleaseMonitorToPool(Thread* self, Monitor* monitor);
   void ReleaseMonitorsToPool(Thread* self, MonitorList::Monitors* monitors);
 
+  // Moves up to `kThreadCacheRefillSize` free monitors to the cache of `self`, allocating a new
+  // chunk if there is none.
+  void RefillThreadLocalCache(Thread* self) REQUIRES(!Locks::allocated_monitor_ids_lock_);
+  // Returns `count` monitors from the cache of `self` to the global free list.
+  void FlushThreadLocalCache(Thread* self, size_t count)
+      REQUIRES(!Locks::allocated_monitor_ids_lock_);
+  void RevokeThreadLocalCacheInPool(Thread* self) REQUIRES(!Locks::allocated_monitor_ids_lock_);
+
+  // Destroys `monitor` while keeping its precomputed id, so that it can be reused.
+  static void DestroyMonitor(Monitor* monitor) {
+    // Keep the monitor id. Don't trust it's not cleared.
+    MonitorId id = monitor->monitor_id_;
+    // Call the destructor.
+    // TODO: Exception safety?
+    monitor->~Monitor();
+    // Rewrite monitor id.
+    monitor->monitor_id_ = id;
+  }
+
   // Note: This is safe as we do not ever move chunks.  All needed entries in the monitor_chunks_
   // data structure are read-only once we get here.  Updates happen-before this call because
   // the lock word was stored with release semantics and we read it with acquire semantics to
@@ -237,6 +265,14 @@ class MonitorPool {
   // ChunkListCapacity(current_chunk_list_index_).
   size_t current_chunk_list_capacity_ GUARDED_BY(Locks::allocated_monitor_ids_lock_);
 
+  // Each thread keeps a small cache of free monitors so that inflating threads do not all
+  // serialize on `allocated_monitor_ids_lock_`. A thread takes `kThreadCacheRefillSize` monitors
+  // at once when its cache is empty and gives half of them back once it holds more than
+  // `kMaxThreadCacheSize`.
+  static constexpr size_t kMaxThreadCacheSize = 32;
+  static constexpr size_t kThreadCacheRefillSize = 16;
+  static_assert(kThreadCacheRefillSize <= kMaxThreadCacheSize);
+
   using Allocator = TrackingAllocator<uint8_t, kAllocatorTagMonitorPool>;
   Allocator allocator_;
 
@@ -16,9 +16,11 @@
 
 #include "monitor_pool.h"
 
+#include "base/time_utils.h"
 #include "common_runtime_test.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread-current-inl.h"
+#include "thread_pool.h"
 
 namespace art HIDDEN {
 
@@ -124,4 +126,94 @@ TEST_F(MonitorPoolTest, MonitorPoolTest) {
   }
 }
 
+TEST_F(MonitorPoolTest, ThreadLocalCache) {
+  Thread* self = Thread::Current();
+  ScopedObjectAccess soa(self);
+
+  // A released monitor is reused by the next allocation of the same thread.
+  Monitor* mon = MonitorPool::CreateMonitor(self, self, nullptr, 1);
+  MonitorId id = mon->GetMonitorId();
+  MonitorPool::ReleaseMonitor(self, mon);
+  Monitor* mon2 = MonitorPool::CreateMonitor(self, self, nullptr, 2);
+  EXPECT_EQ(mon, mon2);
+  EXPECT_EQ(id, mon2->GetMonitorId());
+  VerifyMonitor(mon2, self);
+  MonitorPool::ReleaseMonitor(self, mon2);
+
+  // Overflow the cache several times. Monitors flushed back to the pool stay valid.
+  std::vector<Monitor*> monitors;
+  for (size_t i = 0; i != 200; ++i) {
+    monitors.push_back(MonitorPool::CreateMonitor(self, self, nullptr, static_cast<int32_t>(i)));
+  }
+  for (Monitor* m : monitors) {
+    VerifyMonitor(m, self);
+    MonitorPool::ReleaseMonitor(self, m);
+  }
+  monitors.clear();
+  for (size_t i = 0; i != 200; ++i) {
+    Monitor* m = MonitorPool::CreateMonitor(self, self, nullptr, static_cast<int32_t>(i));
+    VerifyMonitor(m, self);
+    monitors.push_back(m);
+  }
+  for (Monitor* m : monitors) {
+    MonitorPool::ReleaseMonitor(self, m);
+  }
+}
+
+class InflateDeflateTask : public Task {
+ public:
+  explicit InflateDeflateTask(AtomicInteger* failures) : failures_(failures) {}
+
+  void Run(Thread* self) override {
+    ScopedObjectAccess soa(self);
+    Monitor* monitors[kBatchSize];
+    for (size_t i = 0; i != kIterations; ++i) {
+      for (size_t j = 0; j != kBatchSize; ++j) {
+        monitors[j] = MonitorPool::CreateMonitor(self, self, nullptr, static_cast<int32_t>(j));
+      }
+      for (Monitor* mon : monitors) {
+        if (MonitorPool::MonitorFromMonitorId(mon->GetMonitorId()) != mon) {
+          ++*failures_;
+        }
+        MonitorPool::ReleaseMonitor(self, mon);
+      }
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+  static constexpr size_t kIterations = 20000;
+  static constexpr size_t kBatchSize = 8;
+
+ private:
+  AtomicInteger* const failures_;
+};
+
+// Inflation storm: several threads allocating and releasing monitors concurrently.
+TEST_F(MonitorPoolTest, ConcurrentCreateAndRelease) {
+  Thread* self = Thread::Current();
+  static constexpr size_t kNumThreads = 4;
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Monitor pool test thread pool", kNumThreads));
+  AtomicInteger failures(0);
+  for (size_t i = 0; i != kNumThreads; ++i) {
+    thread_pool->AddTask(self, new InflateDeflateTask(&failures));
+  }
+  uint64_t start_ns = NanoTime();
+  thread_pool->StartWorkers(self);
+  thread_pool->Wait(self, /* do_work= */ false, /* may_hold_locks= */ false);
+  uint64_t duration_ns = NanoTime() - start_ns;
+  size_t num_monitors =
+      kNumThreads * InflateDeflateTask::kIterations * InflateDeflateTask::kBatchSize;
+  LOG(INFO) << num_monitors << " concurrent monitor creations and releases took "
+            << PrettyDuration(duration_ns) << " ("
+            << num_monitors * 1000u / std::max<uint64_t>(duration_ns / MsToNs(1), 1u)
+            << " monitors/s)";
+  EXPECT_EQ(failures.load(std::memory_order_relaxed), 0);
+  // Detaching the workers returns their cached monitors to the pool.
+  thread_pool.reset();
+}
+
 }  // namespace art
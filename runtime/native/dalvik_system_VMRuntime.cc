@@ -275,7 +275,10 @@ static void VMRuntime_setDisabledCompatChangesNative(JNIEnv* env, jobject,
       disabled_compat_changes_set.insert(static_cast<uint64_t>(array->Get(i)));
     }
   }
-  Runtime::Current()->GetCompatFramework().SetDisabledCompatChanges(disabled_compat_changes_set);
+  Runtime* runtime = Runtime::Current();
+  runtime->GetCompatFramework().SetDisabledCompatChanges(disabled_compat_changes_set);
+  // Hidden API decisions depend on the state of compat changes.
+  runtime->InvalidateHiddenApiDecisions();
 }
 
 static inline size_t clamp_to_size_t(jlong n) {
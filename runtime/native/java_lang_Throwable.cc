@@ -20,6 +20,7 @@
 
 #include "jni/jni_internal.h"
 #include "native_util.h"
+#include "runtime.h"
 #include "scoped_fast_native_object_access-inl.h"
 #include "thread.h"
 
@@ -27,7 +28,8 @@ namespace art HIDDEN {
 
 static jobject Throwable_nativeFillInStackTrace(JNIEnv* env, jclass) {
   ScopedFastNativeObjectAccess soa(env);
-  return soa.AddLocalReference<jobject>(soa.Self()->CreateInternalStackTrace(soa));
+  size_t max_depth = Runtime::Current()->GetMaxThrowableStackTraceDepth();
+  return soa.AddLocalReference<jobject>(soa.Self()->CreateInternalStackTrace(soa, max_depth));
 }
 
 static jobjectArray Throwable_nativeGetStackTrace(JNIEnv* env, jclass, jobject javaStackState) {
@@ -29,6 +29,10 @@
 
 #if defined(__linux__)
 
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 #include <linux/unistd.h>
@@ -326,13 +330,14 @@ void DumpNativeStack(std::ostream& os,
   DumpNativeStack(os, unwinder, tid, prefix, current_method, ucontext_ptr, skip_frames);
 }
 
-void DumpNativeStack(std::ostream& os,
-                     unwindstack::AndroidLocalUnwinder& unwinder,
-                     pid_t tid,
-                     const char* prefix,
-                     ArtMethod* current_method,
-                     void* ucontext_ptr,
-                     bool skip_frames) {
+static void DumpNativeStackImpl(std::ostream& os,
+                                unwindstack::AndroidLocalUnwinder& unwinder,
+                                pid_t tid,
+                                const char* prefix,
+                                ArtMethod* current_method,
+                                void* ucontext_ptr,
+                                bool skip_frames,
+                                bool symbolize) NO_THREAD_SAFETY_ANALYSIS {
   // Historical note: This was disabled when running under Valgrind (b/18119146).
 
   unwindstack::AndroidUnwinderData data(!skip_frames /*show_all_frames*/);
@@ -350,7 +355,7 @@ void DumpNativeStack(std::ostream& os,
 
   // Check whether we have and should use addr2line.
   bool use_addr2line;
-  if (kUseAddr2line) {
+  if (kUseAddr2line && symbolize) {
     // Try to run it to see whether we have it. Push an argument so that it doesn't assume a.out
     // and print to stderr.
     use_addr2line = (gAborting > 0) && RunCommand(FindAddr2line() + " -h");
@@ -359,8 +364,11 @@ void DumpNativeStack(std::ostream& os,
   }
 
   std::unique_ptr<Addr2linePipe> addr2line_state;
-  data.DemangleFunctionNames();
-  bool holds_mutator_lock =  Locks::mutator_lock_->IsSharedHeld(Thread::Current());
+  bool holds_mutator_lock = false;
+  if (symbolize) {
+    data.DemangleFunctionNames();
+    holds_mutator_lock = Locks::mutator_lock_->IsSharedHeld(Thread::Current());
+  }
   for (const unwindstack::FrameData& frame : data.frames) {
     // We produce output like this:
     // ]    #00 pc 000075bb8  /system/lib/libc.so (unwind_backtrace_thread+536)
@@ -385,33 +393,37 @@ void DumpNativeStack(std::ostream& os,
       if (map_info->elf_start_offset() != 0) {
         os << StringPrintf(" (offset %" PRIx64 ")", map_info->elf_start_offset());
       }
-      os << " (";
-      if (!frame.function_name.empty()) {
-        // Remove parameters from the printed function name to improve signal/noise in the logs.
-        // Also, ANRs are often trimmed, so printing less means we get more useful data out.
-        // We can still symbolize the function based on the PC and build-id (including inlining).
-        os << StripParameters(frame.function_name.c_str());
-        if (frame.function_offset != 0) {
-          os << "+" << frame.function_offset;
-        }
-        // Functions found using the gdb jit interface will be in an empty
-        // map that cannot be found using addr2line.
-        if (!map_info->name().empty()) {
-          try_addr2line = true;
-        }
-      } else if (current_method != nullptr && holds_mutator_lock) {
-        const OatQuickMethodHeader* header = current_method->GetOatQuickMethodHeader(frame.pc);
-        if (header != nullptr) {
-          const void* start_of_code = header->GetCode();
-          os << current_method->JniLongName() << "+"
-             << (frame.pc - reinterpret_cast<uint64_t>(start_of_code));
+      // Without symbolization, the frame is symbolized offline from the build id and the
+      // relative pc.
+      if (symbolize) {
+        os << " (";
+        if (!frame.function_name.empty()) {
+          // Remove parameters from the printed function name to improve signal/noise in the logs.
+          // Also, ANRs are often trimmed, so printing less means we get more useful data out.
+          // We can still symbolize the function based on the PC and build-id (including inlining).
+          os << StripParameters(frame.function_name.c_str());
+          if (frame.function_offset != 0) {
+            os << "+" << frame.function_offset;
+          }
+          // Functions found using the gdb jit interface will be in an empty
+          // map that cannot be found using addr2line.
+          if (!map_info->name().empty()) {
+            try_addr2line = true;
+          }
+        } else if (current_method != nullptr && holds_mutator_lock) {
+          const OatQuickMethodHeader* header = current_method->GetOatQuickMethodHeader(frame.pc);
+          if (header != nullptr) {
+            const void* start_of_code = header->GetCode();
+            os << current_method->JniLongName() << "+"
+               << (frame.pc - reinterpret_cast<uint64_t>(start_of_code));
+          } else {
+            os << "???";
+          }
         } else {
           os << "???";
         }
-      } else {
-        os << "???";
+        os << ")";
       }
-      os << ")";
       std::string build_id = map_info->GetPrintableBuildID();
       if (!build_id.empty()) {
         os << " (BuildId: " << build_id << ")";
@@ -429,6 +441,60 @@ void DumpNativeStack(std::ostream& os,
   }
 }
 
+void DumpNativeStack(std::ostream& os,
+                     unwindstack::AndroidLocalUnwinder& unwinder,
+                     pid_t tid,
+                     const char* prefix,
+                     ArtMethod* current_method,
+                     void* ucontext_ptr,
+                     bool skip_frames) {
+  DumpNativeStackImpl(
+      os, unwinder, tid, prefix, current_method, ucontext_ptr, skip_frames, /*symbolize=*/ true);
+}
+
+std::vector<std::string> DumpNativeStacksForOfflineSymbolization(
+    unwindstack::AndroidLocalUnwinder& unwinder,
+    const std::vector<pid_t>& tids,
+    const char* prefix,
+    size_t num_threads) {
+  std::vector<std::string> dumps(tids.size());
+  if (tids.empty()) {
+    return dumps;
+  }
+  // Threads claim the next stack until there are none left, so that a thread with a deep stack
+  // does not hold up the others. The unwinds do not use any runtime state, so the helper
+  // threads do not need to be attached.
+  std::atomic<size_t> next_tid(0u);
+  auto dump_stacks = [&]() {
+    for (size_t i = next_tid.fetch_add(1u, std::memory_order_relaxed);
+         i < tids.size();
+         i = next_tid.fetch_add(1u, std::memory_order_relaxed)) {
+      std::ostringstream os;
+      DumpNativeStackImpl(os,
+                          unwinder,
+                          tids[i],
+                          prefix,
+                          /*current_method=*/ nullptr,
+                          /*ucontext_ptr=*/ nullptr,
+                          /*skip_frames=*/ true,
+                          /*symbolize=*/ false);
+      dumps[i] = os.str();
+    }
+  };
+  // The calling thread does its share of the unwinds.
+  size_t num_helpers = std::min(std::max<size_t>(num_threads, 1u), tids.size()) - 1u;
+  std::vector<std::thread> helpers;
+  helpers.reserve(num_helpers);
+  for (size_t i = 0; i != num_helpers; ++i) {
+    helpers.emplace_back(dump_stacks);
+  }
+  dump_stacks();
+  for (std::thread& helper : helpers) {
+    helper.join();
+  }
+  return dumps;
+}
+
 #elif defined(__APPLE__)
 
 void DumpNativeStack([[maybe_unused]] std::ostream& os,
@@ -446,6 +512,14 @@ void DumpNativeStack([[maybe_unused]] std::ostream& os,
                      [[maybe_unused]] void* ucontext_ptr,
                      [[maybe_unused]] bool skip_frames) {}
 
+std::vector<std::string> DumpNativeStacksForOfflineSymbolization(
+    [[maybe_unused]] unwindstack::AndroidLocalUnwinder& unwinder,
+    const std::vector<pid_t>& tids,
+    [[maybe_unused]] const char* prefix,
+    [[maybe_unused]] size_t num_threads) {
+  return std::vector<std::string>(tids.size());
+}
+
 #else
 #error "Unsupported architecture for native stack dumps."
 #endif
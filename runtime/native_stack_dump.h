@@ -20,6 +20,8 @@
 #include <unistd.h>
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 #include "base/macros.h"
 
@@ -53,6 +55,16 @@ void DumpNativeStack(std::ostream& os,
                      bool skip_frames = true)
     NO_THREAD_SAFETY_ANALYSIS;
 
+// Dumps the native stacks of the threads `tids`, unwinding them concurrently on up to
+// `num_threads` threads that share the `unwinder` and its cached maps and ELF files. The frames
+// are not symbolized, they only show their offsets and the build ids of their mapped files for
+// offline symbolization. Returns the dump of each thread, in the order of `tids`.
+std::vector<std::string> DumpNativeStacksForOfflineSymbolization(
+    unwindstack::AndroidLocalUnwinder& unwinder,
+    const std::vector<pid_t>& tids,
+    const char* prefix,
+    size_t num_threads);
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_NATIVE_STACK_DUMP_H_
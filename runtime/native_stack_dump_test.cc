@@ -16,7 +16,15 @@
 
 #include "native_stack_dump.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
+#include <unwindstack/AndroidUnwinder.h>
+
+#include "base/utils.h"
 
 namespace art HIDDEN {
 
@@ -36,4 +44,48 @@ TEST(StripParametersTest, InvalidInput) {
   EXPECT_EQ(StripParameters("foo(((int)))"), "foo");
 }
 
+#if defined(__linux__)
+
+TEST(DumpNativeStacksForOfflineSymbolizationTest, DumpsEachThread) {
+  constexpr size_t kNumThreads = 5u;
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool done = false;
+  std::vector<pid_t> tids;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      tids.push_back(static_cast<pid_t>(GetTid()));
+      cond.notify_all();
+      cond.wait(lock, [&]() { return done; });
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&]() { return tids.size() == kNumThreads; });
+  }
+  // The calling thread can also be dumped.
+  tids.push_back(static_cast<pid_t>(GetTid()));
+
+  unwindstack::AndroidLocalUnwinder unwinder;
+  std::vector<std::string> dumps = DumpNativeStacksForOfflineSymbolization(
+      unwinder, tids, "  native: ", /*num_threads=*/ 3u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  cond.notify_all();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(tids.size(), dumps.size());
+  for (const std::string& dump : dumps) {
+    EXPECT_EQ(0u, dump.rfind("  native: #00 pc ", 0u)) << dump;
+  }
+}
+
+#endif  // __linux__
+
 }  // namespace art
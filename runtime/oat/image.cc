@@ -279,10 +279,9 @@ const char* ImageHeader::GetImageSectionName(ImageSections index) {
   }
 }
 
-// Compress data from `source` into `storage`.
-static bool CompressData(ArrayRef<const uint8_t> source,
-                         ImageHeader::StorageMode image_storage_mode,
-                         /*out*/ dchecked_vector<uint8_t>* storage) {
+bool CompressData(ArrayRef<const uint8_t> source,
+                  ImageHeader::StorageMode image_storage_mode,
+                  /*out*/ dchecked_vector<uint8_t>* storage) {
   const uint64_t compress_start_time = NanoTime();
 
   // Bound is same for both LZ4 and LZ4HC.
@@ -19,6 +19,8 @@
 
 #include <string.h>
 
+#include "base/array_ref.h"
+#include "base/dchecked_vector.h"
 #include "base/iteration_range.h"
 #include "base/macros.h"
 #include "base/os.h"
@@ -107,10 +109,18 @@ class PACKED(8) ImageHeader {
       return storage_mode_;
     }
 
+    uint32_t GetDataOffset() const {
+      return data_offset_;
+    }
+
     uint32_t GetDataSize() const {
       return data_size_;
     }
 
+    uint32_t GetImageOffset() const {
+      return image_offset_;
+    }
+
     uint32_t GetImageSize() const {
       return image_size_;
     }
@@ -609,6 +619,11 @@ bool LZ4_decompress_safe_checked(const char* source,
                                  /*out*/ size_t* decompressed_size_checked,
                                  /*out*/ std::string* error_msg);
 
+// Compress data from `source` into `storage` with a compressed `storage_mode`.
+bool CompressData(ArrayRef<const uint8_t> source,
+                  ImageHeader::StorageMode storage_mode,
+                  /*out*/ dchecked_vector<uint8_t>* storage);
+
 }  // namespace art
 
 #endif  // ART_RUNTIME_OAT_IMAGE_H_
@@ -54,6 +54,13 @@ class JniStubKey {
     shorty_ = {};
   }
 
+  // Replaces the shorty with an equivalent one, for example when the method that owns the
+  // memory of the old shorty is unloaded. The hash stays the same.
+  void UpdateShorty(std::string_view shorty) {
+    DCHECK(!shorty.empty());
+    shorty_ = shorty;
+  }
+
  private:
   uint32_t flags_;
   std::string_view shorty_;
@@ -44,14 +44,16 @@ std::ostream& operator<<(std::ostream& stream, StubType stub_type);
 class EXPORT PACKED(4) OatHeader {
  public:
   static constexpr std::array<uint8_t, 4> kOatMagic { { 'o', 'a', 't', '\n' } };
-  // Last oat version changed reason: Adding new entrypoints for InvokeExact intrisic.
-  static constexpr std::array<uint8_t, 4> kOatVersion{{'2', '4', '7', '\0'}};
+  // Last oat version changed reason: Record the range of startup code.
+  static constexpr std::array<uint8_t, 4> kOatVersion{{'2', '4', '8', '\0'}};
 
   static constexpr const char* kDex2OatCmdLineKey = "dex2oat-cmdline";
   static constexpr const char* kDebuggableKey = "debuggable";
   static constexpr const char* kNativeDebuggableKey = "native-debuggable";
   static constexpr const char* kCompilerFilter = "compiler-filter";
   static constexpr const char* kClassPathKey = "classpath";
+  // ClassLoaderContext::HashEncodedContext() of the kClassPathKey value.
+  static constexpr const char* kClassPathHashKey = "classpath-hash";
   static constexpr const char* kBootClassPathKey = "bootclasspath";
   static constexpr const char* kBootClassPathChecksumsKey = "bootclasspath-checksums";
   static constexpr const char* kApexVersionsKey = "apex-versions";
@@ -108,6 +110,12 @@ class EXPORT PACKED(4) OatHeader {
   uint32_t GetNterpTrampolineOffset() const;
   void SetNterpTrampolineOffset(uint32_t offset);
 
+  // The range of compiled code of methods marked as startup methods in the profile.
+  // The offsets are relative to the oat data begin and the size is 0 if there is no such code.
+  uint32_t GetStartupCodeOffset() const;
+  uint32_t GetStartupCodeSize() const;
+  void SetStartupCodeRange(uint32_t offset, uint32_t size);
+
   InstructionSet GetInstructionSet() const;
   uint32_t GetInstructionSetFeaturesBitmap() const;
 
@@ -155,6 +163,8 @@ class EXPORT PACKED(4) OatHeader {
   uint32_t quick_resolution_trampoline_offset_;
   uint32_t quick_to_interpreter_bridge_offset_;
   uint32_t nterp_trampoline_offset_;
+  uint32_t startup_code_offset_;
+  uint32_t startup_code_size_;
 
   uint32_t key_value_store_size_;
   uint8_t key_value_store_[0];  // note variable width data at end
@@ -27,6 +27,7 @@
 #include <type_traits>
 
 #include "android-base/logging.h"
+#include "android-base/parseint.h"
 #include "android-base/stringprintf.h"
 #include "arch/instruction_set_features.h"
 #include "art_method.h"
@@ -1859,7 +1860,10 @@ class OatFileBackedByVdex final : public OatFileBase {
     store.Put(OatHeader::kConcurrentCopying,
               gUseReadBarrier ? OatHeader::kTrueValue : OatHeader::kFalseValue);
     if (context != nullptr) {
-      store.Put(OatHeader::kClassPathKey, context->EncodeContextForOatFile(""));
+      std::string class_path_key = context->EncodeContextForOatFile("");
+      store.Put(OatHeader::kClassPathHashKey,
+                std::to_string(ClassLoaderContext::HashEncodedContext(class_path_key)));
+      store.Put(OatHeader::kClassPathKey, class_path_key);
     }
 
     oat_header_.reset(OatHeader::Create(kRuntimeISA,
@@ -2364,11 +2368,18 @@ const dex::ClassDef* OatDexFile::FindClassDef(const DexFile& dex_file,
   DCHECK_EQ(ComputeModifiedUtf8Hash(descriptor), hash);
   bool used_lookup_table = false;
   const dex::ClassDef* lookup_table_classdef = nullptr;
+  const TypeLookupTable* lookup_table = nullptr;
   if (LIKELY((oat_dex_file != nullptr) && oat_dex_file->GetTypeLookupTable().Valid())) {
+    lookup_table = &oat_dex_file->GetTypeLookupTable();
+  } else if (dex_file.NumClassDefs() != 0u) {
+    // Dex files without a lookup table from an oat file get one on their first class lookup.
+    lookup_table = dex_file.GetOrCreateTypeLookupTable();
+  }
+  if (lookup_table != nullptr) {
     used_lookup_table = true;
-    const uint32_t class_def_idx = oat_dex_file->GetTypeLookupTable().Lookup(descriptor, hash);
+    const uint32_t class_def_idx = lookup_table->Lookup(descriptor, hash);
     if (class_def_idx != dex::kDexNoIndex) {
-      CHECK_LT(class_def_idx, dex_file.NumClassDefs()) << oat_dex_file->GetOatFile()->GetLocation();
+      CHECK_LT(class_def_idx, dex_file.NumClassDefs()) << dex_file.GetLocation();
       lookup_table_classdef = &dex_file.GetClassDef(class_def_idx);
     }
     if (!kIsDebugBuild) {
@@ -2476,6 +2487,15 @@ std::string OatFile::GetClassLoaderContext() const {
   return (value == nullptr) ? "" : value;
 }
 
+std::optional<uint32_t> OatFile::GetClassLoaderContextHash() const {
+  const char* value = GetOatHeader().GetStoreValueByKey(OatHeader::kClassPathHashKey);
+  uint32_t hash;
+  if (value == nullptr || !android::base::ParseUint(value, &hash)) {
+    return std::nullopt;
+  }
+  return hash;
+}
+
 const char* OatFile::GetCompilationReason() const {
   return GetOatHeader().GetStoreValueByKey(OatHeader::kCompilationReasonKey);
 }
@@ -19,6 +19,7 @@
 
 #include <list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -203,6 +204,9 @@ class OatFile {
 
   std::string GetClassLoaderContext() const;
 
+  // Returns the hash of GetClassLoaderContext() recorded by the compiler, if any.
+  std::optional<uint32_t> GetClassLoaderContextHash() const;
+
   const char* GetCompilationReason() const;
 
   const std::string& GetLocation() const {
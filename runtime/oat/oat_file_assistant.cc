@@ -1203,7 +1203,7 @@ bool OatFileAssistant::OatFileInfo::ShouldRecompileForFilter(CompilerFilter::Fil
   return false;
 }
 
-bool OatFileAssistant::ClassLoaderContextIsOkay(const OatFile& oat_file) const {
+bool OatFileAssistant::ClassLoaderContextIsOkay(const OatFile& oat_file) {
   if (context_ == nullptr) {
     // The caller requests to skip the check.
     return true;
@@ -1220,14 +1220,27 @@ bool OatFileAssistant::ClassLoaderContextIsOkay(const OatFile& oat_file) const {
     return true;
   }
 
+  if (!cached_encoded_context_.has_value()) {
+    cached_encoded_context_ =
+        context_->EncodeContextForOatFile(android::base::Dirname(dex_location_));
+    cached_encoded_context_hash_ = ClassLoaderContext::HashEncodedContext(*cached_encoded_context_);
+  }
+  std::string stored_context = oat_file.GetClassLoaderContext();
+  std::optional<uint32_t> stored_context_hash = oat_file.GetClassLoaderContextHash();
+  if (stored_context_hash == cached_encoded_context_hash_ &&
+      stored_context == *cached_encoded_context_) {
+    // The oat file was compiled with the same encoded context, which covers everything the full
+    // check below compares, without parsing the stored context or resolving the dex locations.
+    return true;
+  }
+
   ClassLoaderContext::VerificationResult matches =
-      context_->VerifyClassLoaderContextMatch(oat_file.GetClassLoaderContext(),
+      context_->VerifyClassLoaderContextMatch(stored_context,
                                               /*verify_names=*/true,
                                               /*verify_checksums=*/true);
   if (matches == ClassLoaderContext::VerificationResult::kMismatch) {
-    VLOG(oat) << "ClassLoaderContext check failed. Context was " << oat_file.GetClassLoaderContext()
-              << ". The expected context is "
-              << context_->EncodeContextForOatFile(android::base::Dirname(dex_location_));
+    VLOG(oat) << "ClassLoaderContext check failed. Context was " << stored_context
+              << ". The expected context is " << *cached_encoded_context_;
     return false;
   }
   return true;
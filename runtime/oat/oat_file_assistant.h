@@ -360,7 +360,7 @@ class OatFileAssistant {
   // anonymous dex file(s) created by AnonymousDexVdexLocation.
   EXPORT static bool IsAnonymousVdexBasename(const std::string& basename);
 
-  bool ClassLoaderContextIsOkay(const OatFile& oat_file) const;
+  bool ClassLoaderContextIsOkay(const OatFile& oat_file);
 
   // Validates the boot class path checksum of an OatFile.
   EXPORT bool ValidateBootClassPathChecksums(const OatFile& oat_file);
@@ -560,6 +560,12 @@ class OatFileAssistant {
   std::optional<std::string> cached_required_dex_checksums_error_;
   bool required_dex_checksums_attempted_ = false;
 
+  // Cached encoding of `context_` relative to the dex location, and its hash, compared with the
+  // context stored in each oat file before doing the full context check.
+  // This should be accessed only by the ClassLoaderContextIsOkay() method.
+  std::optional<std::string> cached_encoded_context_;
+  uint32_t cached_encoded_context_hash_ = 0u;
+
   // The AOT-compiled file of an app when the APK of the app is in /data.
   OatFileInfo odex_;
   // The AOT-compiled file of an app when the APK of the app is on a read-only partition
@@ -337,6 +337,8 @@ TEST_P(OatFileAssistantTest, MakeUpToDateWithContext) {
   ASSERT_NE(nullptr, oat_file->GetOatHeader().GetStoreValueByKey(OatHeader::kClassPathKey));
   EXPECT_EQ(context->EncodeContextForOatFile(""),
             oat_file->GetOatHeader().GetStoreValueByKey(OatHeader::kClassPathKey));
+  EXPECT_EQ(ClassLoaderContext::HashEncodedContext(context->EncodeContextForOatFile("")),
+            oat_file->GetClassLoaderContextHash());
 }
 
 TEST_P(OatFileAssistantTest, GetDexOptNeededWithUpToDateContextRelative) {
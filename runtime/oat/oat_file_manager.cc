@@ -19,11 +19,14 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <vector>
 
 #include "android-base/file.h"
+#include "android-base/scopeguard.h"
 #include "android-base/stringprintf.h"
 #include "android-base/strings.h"
 #include "art_field-inl.h"
@@ -34,6 +37,8 @@
 #include "base/sdk_version.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
+#include "base/time_utils.h"
+#include "base/unix_file/fd_file.h"
 #include "class_linker.h"
 #include "class_loader_context.h"
 #include "dex/art_dex_file_loader.h"
@@ -48,11 +53,14 @@
 #include "jni/jni_internal.h"
 #include "mirror/class_loader.h"
 #include "mirror/object-inl.h"
+#include "oat.h"
 #include "oat_file.h"
 #include "oat_file_assistant.h"
 #include "obj_ptr-inl.h"
+#include "profile/profile_compilation_info.h"
 #include "runtime_image.h"
 #include "scoped_thread_state_change-inl.h"
+#include "stack_map_cache.h"
 #include "thread-current-inl.h"
 #include "thread_list.h"
 #include "thread_pool.h"
@@ -110,6 +118,8 @@ void OatFileManager::UnRegisterAndDeleteOatFile(const OatFile* oat_file) {
   CHECK(it != oat_files_.end());
   oat_files_.erase(it);
   compare.release();  // NOLINT b/117926937
+  // The oat file is about to be unmapped, drop any decoded stack maps pointing into it.
+  StackMapCache::InvalidateAll();
 }
 
 const OatFile* OatFileManager::FindOpenedOatFileFromDexLocation(
@@ -192,6 +202,29 @@ bool OatFileManager::ShouldLoadAppImage() const {
   return true;
 }
 
+// Madvise the code items that dex2oat found to be hot or used only at startup in the
+// profile it compiled the oat file with.
+static void MadviseProfiledDexCode(const DexFile& dex_file) {
+  const OatDexFile* oat_dex_file = dex_file.GetOatDexFile();
+  if (oat_dex_file == nullptr || oat_dex_file->GetDexLayoutSections() == nullptr) {
+    return;
+  }
+  const DexLayoutSection& code_section = oat_dex_file->GetDexLayoutSections()->sections_[
+      static_cast<size_t>(DexLayoutSections::SectionType::kSectionTypeCode)];
+  for (LayoutType layout_type : {LayoutType::kLayoutTypeHot, LayoutType::kLayoutTypeStartupOnly}) {
+    const DexLayoutSection::Subsection& part =
+        code_section.parts_[static_cast<size_t>(layout_type)];
+    if (part.Size() == 0u || part.end_offset_ > dex_file.DataSize()) {
+      continue;
+    }
+    Runtime::MadviseFileForRange(part.Size() + gPageSize,
+                                 part.Size() + gPageSize,
+                                 dex_file.DataBegin() + part.start_offset_,
+                                 dex_file.DataBegin() + part.end_offset_,
+                                 dex_file.GetLocation() + " profiled code");
+  }
+}
+
 std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
     const char* dex_location,
     jobject class_loader,
@@ -208,6 +241,17 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
   Locks::mutator_lock_->AssertNotHeld(self);
   Runtime* const runtime = Runtime::Current();
 
+  const uint64_t start_ns = NanoTime();
+  auto record_open = android::base::make_scope_guard([&]() {
+    uint64_t elapsed_ns = NanoTime() - start_ns;
+    WriterMutexLock mu(self, *Locks::oat_file_manager_lock_);
+    DexLocationOpenStats& stats = dex_location_open_stats_[dex_location];
+    ++stats.count;
+    stats.total_time_ns += elapsed_ns;
+    VLOG(oat) << "Opened " << dex_location << " in " << PrettyDuration(elapsed_ns) << " ("
+              << stats.count << " time(s) so far)";
+  });
+
   std::vector<std::unique_ptr<const DexFile>> dex_files;
   std::unique_ptr<ClassLoaderContext> context(
       ClassLoaderContext::CreateContextForClassLoader(class_loader, dex_elements));
@@ -277,6 +321,22 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
                                      oat_file->Begin(),
                                      oat_file->End(),
                                      oat_file->GetLocation());
+        // The startup code is contiguous in the oat file. Make sure it is read ahead even
+        // if the limit prevents madvising the whole file.
+        const OatHeader& oat_header = oat_file->GetOatHeader();
+        size_t startup_code_size = oat_header.GetStartupCodeSize();
+        if (oat_file->IsExecutable() &&
+            madvise_size_limit != 0u &&
+            startup_code_size != 0u &&
+            oat_file->Size() > madvise_size_limit) {
+          const uint8_t* startup_code = oat_file->Begin() + oat_header.GetStartupCodeOffset();
+          Runtime::MadviseFileForRange(startup_code_size + gPageSize,
+                                       startup_code_size + gPageSize,
+                                       startup_code,
+                                       std::min(startup_code + startup_code_size + gPageSize,
+                                                oat_file->End()),
+                                       oat_file->GetLocation() + " startup code");
+        }
       }
 
       ScopedTrace app_image_timing("AppImage:Loading");
@@ -397,6 +457,14 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
       } else if (should_madvise) {
         size_t madvise_size_limit = Runtime::Current()->GetMadviseWillNeedTotalDexSize();
         for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+          // Without compiled code, the profiled code items are interpreted at startup.
+          // Read them ahead even when the limit prevents madvising the whole dex file.
+          if (dex_file->Size() > madvise_size_limit && !compilation_enabled) {
+            MadviseProfiledDexCode(*dex_file);
+          }
+          if (madvise_size_limit == 0u) {
+            continue;
+          }
           // Prefetch the dex file based on vdex size limit (name should
           // have been dex size limit).
           VLOG(oat) << "Madvising dex file: " << dex_file->GetLocation();
@@ -405,10 +473,7 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
                                        dex_file->Begin(),
                                        dex_file->Begin() + dex_file->Size(),
                                        dex_file->GetLocation());
-          if (dex_file->Size() >= madvise_size_limit) {
-            break;
-          }
-          madvise_size_limit -= dex_file->Size();
+          madvise_size_limit -= std::min(madvise_size_limit, dex_file->Size());
         }
       }
 
@@ -507,6 +572,8 @@ std::vector<std::unique_ptr<const DexFile>> OatFileManager::OpenDexFilesFromOat(
     Runtime::Current()->GetJit()->RegisterDexFiles(dex_files, class_loader);
   }
 
+  PreloadStartupClasses(dex_files, class_loader);
+
   // Now that we loaded the dex/odex files, notify the runtime.
   // Note that we do this everytime we load dex files.
   Runtime::Current()->NotifyDexFileLoaded();
@@ -712,13 +779,31 @@ static bool UnlinkLeastRecentlyUsedVdexIfNeeded(const std::string& vdex_path_to_
   return true;
 }
 
+// Results of the `BackgroundVerificationTask`s verifying the same dex files.
+struct BackgroundVerificationResults {
+  BackgroundVerificationResults(const std::vector<const DexFile*>& dex_files_in,
+                                const std::string& vdex_path_in,
+                                size_t num_shards)
+      : dex_files(dex_files_in),
+        vdex_path(vdex_path_in),
+        verifier_deps(num_shards),
+        remaining_shards(num_shards) {}
+
+  const std::vector<const DexFile*> dex_files;
+  // Where to write the merged `VerifierDeps`, empty if they should not be written.
+  const std::string vdex_path;
+  // One entry per shard, each only written by the task verifying that shard.
+  std::vector<std::unique_ptr<verifier::VerifierDeps>> verifier_deps;
+  std::atomic<size_t> remaining_shards;
+};
+
 class BackgroundVerificationTask final : public Task {
  public:
-  BackgroundVerificationTask(const std::vector<const DexFile*>& dex_files,
-                             jobject class_loader,
-                             const std::string& vdex_path)
-      : dex_files_(dex_files),
-        vdex_path_(vdex_path) {
+  BackgroundVerificationTask(jobject class_loader,
+                             std::shared_ptr<BackgroundVerificationResults> results,
+                             size_t shard_index)
+      : results_(std::move(results)),
+        shard_index_(shard_index) {
     Thread* const self = Thread::Current();
     ScopedObjectAccess soa(self);
     // Create a global ref for `class_loader` because it will be accessed from a different thread.
@@ -733,13 +818,18 @@ class BackgroundVerificationTask final : public Task {
   }
 
   void Run(Thread* self) override {
-    std::string error_msg;
     ClassLinker* const class_linker = Runtime::Current()->GetClassLinker();
-    verifier::VerifierDeps verifier_deps(dex_files_);
-
-    // Iterate over all classes and verify them.
-    for (const DexFile* dex_file : dex_files_) {
-      for (uint32_t cdef_idx = 0; cdef_idx < dex_file->NumClassDefs(); cdef_idx++) {
+    const std::vector<const DexFile*>& dex_files = results_->dex_files;
+    const size_t num_shards = results_->verifier_deps.size();
+    std::unique_ptr<verifier::VerifierDeps> verifier_deps(new verifier::VerifierDeps(dex_files));
+
+    // Iterate over the classes of our shard and verify them. Shards interleave the class
+    // definitions, so that all tasks together follow the class definition order, which
+    // the profile guided dex layout sorts by startup use.
+    for (const DexFile* dex_file : dex_files) {
+      for (uint32_t cdef_idx = shard_index_;
+           cdef_idx < dex_file->NumClassDefs();
+           cdef_idx += num_shards) {
         const dex::ClassDef& class_def = dex_file->GetClassDef(cdef_idx);
 
         // Take handles inside the loop. The background verification is low priority
@@ -766,7 +856,7 @@ class BackgroundVerificationTask final : public Task {
         }
 
         DCHECK(h_class->IsResolved()) << h_class->PrettyDescriptor();
-        class_linker->VerifyClass(self, &verifier_deps, h_class);
+        class_linker->VerifyClass(self, verifier_deps.get(), h_class);
         if (self->IsExceptionPending()) {
           // ClassLinker::VerifyClass can throw, but the exception isn't useful here.
           self->ClearException();
@@ -776,35 +866,56 @@ class BackgroundVerificationTask final : public Task {
             << h_class->PrettyDescriptor() << ": state=" << h_class->GetStatus();
 
         if (h_class->IsVerified()) {
-          verifier_deps.RecordClassVerified(*dex_file, class_def);
+          verifier_deps->RecordClassVerified(*dex_file, class_def);
         }
       }
     }
 
+    results_->verifier_deps[shard_index_] = std::move(verifier_deps);
+    if (results_->remaining_shards.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+      // This is the last shard to finish, merge the results and write them out.
+      WriteResults();
+    }
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  void WriteResults() {
+    if (results_->vdex_path.empty()) {
+      return;
+    }
+    const std::vector<const DexFile*>& dex_files = results_->dex_files;
+    std::unique_ptr<verifier::VerifierDeps>& verifier_deps = results_->verifier_deps[0];
+    for (size_t i = 1; i < results_->verifier_deps.size(); ++i) {
+      if (results_->verifier_deps[i]->HasExtraStrings()) {
+        // The ids of the extra strings are local to each shard and cannot be merged.
+        VLOG(oat) << "Not writing " << results_->vdex_path << " for shards with extra strings";
+        return;
+      }
+      verifier_deps->MergeWith(std::move(results_->verifier_deps[i]), dex_files);
+    }
+
     // Delete old vdex files if there are too many in the folder.
-    if (!UnlinkLeastRecentlyUsedVdexIfNeeded(vdex_path_, &error_msg)) {
-      LOG(ERROR) << "Could not unlink old vdex files " << vdex_path_ << ": " << error_msg;
+    std::string error_msg;
+    const std::string& vdex_path = results_->vdex_path;
+    if (!UnlinkLeastRecentlyUsedVdexIfNeeded(vdex_path, &error_msg)) {
+      LOG(ERROR) << "Could not unlink old vdex files " << vdex_path << ": " << error_msg;
       return;
     }
 
     // Construct a vdex file and write `verifier_deps` into it.
-    if (!VdexFile::WriteToDisk(vdex_path_,
-                               dex_files_,
-                               verifier_deps,
-                               &error_msg)) {
-      LOG(ERROR) << "Could not write anonymous vdex " << vdex_path_ << ": " << error_msg;
+    if (!VdexFile::WriteToDisk(vdex_path, dex_files, *verifier_deps, &error_msg)) {
+      LOG(ERROR) << "Could not write anonymous vdex " << vdex_path << ": " << error_msg;
       return;
     }
   }
 
-  void Finalize() override {
-    delete this;
-  }
-
- private:
-  const std::vector<const DexFile*> dex_files_;
   jobject class_loader_;
-  const std::string vdex_path_;
+  const std::shared_ptr<BackgroundVerificationResults> results_;
+  const size_t shard_index_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundVerificationTask);
 };
@@ -852,40 +963,193 @@ void OatFileManager::RunBackgroundVerification(const std::vector<const DexFile*>
 
   std::string dex_location = dex_files[0]->GetLocation();
   const std::string& data_dir = Runtime::Current()->GetProcessDataDirectory();
-  if (!dex_location.starts_with(data_dir)) {
-    // For now, we only run background verification for secondary dex files.
+  std::string vdex_filename;
+  if (dex_location.starts_with(data_dir)) {
+    std::string error_msg;
+    std::string odex_filename;
+    if (!OatFileAssistant::DexLocationToOdexFilename(dex_location,
+                                                     kRuntimeISA,
+                                                     &odex_filename,
+                                                     &error_msg)) {
+      LOG(WARNING) << "Could not get odex filename for " << dex_location << ": " << error_msg;
+      return;
+    }
+
+    if (LocationIsOnArtApexData(odex_filename) && Runtime::Current()->DenyArtApexDataFiles()) {
+      // Ignore vdex file associated with this odex file as the odex file is not trustworthy.
+      return;
+    }
+    vdex_filename = GetVdexFilename(odex_filename);
+  } else if (!runtime->BackgroundVerifyAllDexFiles()) {
+    // By default, we only run background verification for secondary dex files.
     // Running it for primary or split APKs could have some undesirable
     // side-effects, like overloading the device on app startup.
     return;
   }
+  // Otherwise we only verify the classes so that their first use does not need to. The
+  // app cannot write next to the primary or split APKs, so we do not write a vdex file.
 
-  std::string error_msg;
-  std::string odex_filename;
-  if (!OatFileAssistant::DexLocationToOdexFilename(dex_location,
-                                                   kRuntimeISA,
-                                                   &odex_filename,
-                                                   &error_msg)) {
-    LOG(WARNING) << "Could not get odex filename for " << dex_location << ": " << error_msg;
+  const size_t num_threads = runtime->GetBackgroundVerificationThreads();
+  {
+    WriterMutexLock mu(self, *Locks::oat_file_manager_lock_);
+    if (verification_thread_pool_ == nullptr) {
+      verification_thread_pool_.reset(
+          ThreadPool::Create("Verification thread pool", num_threads));
+      verification_thread_pool_->StartWorkers(self);
+    }
+  }
+  std::shared_ptr<BackgroundVerificationResults> results =
+      std::make_shared<BackgroundVerificationResults>(dex_files, vdex_filename, num_threads);
+  for (size_t shard_index = 0; shard_index != num_threads; ++shard_index) {
+    verification_thread_pool_->AddTask(
+        self, new BackgroundVerificationTask(class_loader, results, shard_index));
+  }
+}
+
+// Loads the classes that a profile lists for some dex files, so that the main thread finds
+// them already loaded during startup. The classes are not initialized, as running their
+// static initializers out of the app's order could have visible side effects.
+class PreloadStartupClassesTask final : public Task {
+ public:
+  PreloadStartupClassesTask(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+                            jobject class_loader,
+                            const std::string& profile)
+      : profile_(profile) {
+    Thread* const self = Thread::Current();
+    ScopedObjectAccess soa(self);
+    StackHandleScope<1> hs(self);
+    Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
+        soa.Decode<mirror::ClassLoader>(class_loader)));
+    ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+    for (const std::unique_ptr<const DexFile>& dex_file : dex_files) {
+      dex_files_.push_back(dex_file.get());
+      // Register the dex file so that we can guarantee it doesn't get deleted
+      // while reading it during the task.
+      class_linker->RegisterDexFile(*dex_file, h_loader.Get());
+    }
+    // Create a global ref for `class_loader` because it will be accessed from a different thread.
+    class_loader_ = soa.Vm()->AddGlobalRef(self, h_loader.Get());
+    CHECK(class_loader_ != nullptr);
+  }
+
+  ~PreloadStartupClassesTask() {
+    Thread* const self = Thread::Current();
+    ScopedObjectAccess soa(self);
+    soa.Vm()->DeleteGlobalRef(self, class_loader_);
+  }
+
+  void Run(Thread* self) override {
+    ScopedTrace trace("Preload startup classes");
+    ProfileCompilationInfo profile_info;
+    {
+      unix_file::FdFile profile(profile_, O_RDONLY, /* check_usage= */ true);
+      if (profile.Fd() == -1) {
+        PLOG(WARNING) << "No startup class preload profile: " << profile_;
+        return;
+      }
+      if (!profile_info.Load(profile.Fd())) {
+        LOG(WARNING) << "Could not load startup class preload profile: " << profile_;
+        return;
+      }
+    }
+
+    Runtime* const runtime = Runtime::Current();
+    ClassLinker* const class_linker = runtime->GetClassLinker();
+    size_t num_loaded = 0u;
+    for (const DexFile* dex_file : dex_files_) {
+      const ArenaSet<dex::TypeIndex>* classes = profile_info.GetClasses(*dex_file);
+      if (classes == nullptr) {
+        // The profile does not know this dex file, or recorded a different checksum for it.
+        continue;
+      }
+      for (dex::TypeIndex type_index : *classes) {
+        if (runtime->GetStartupCompleted()) {
+          // Too late to help, the remaining classes are loaded on first use.
+          VLOG(class_linker) << "Startup completed after preloading " << num_loaded << " classes";
+          return;
+        }
+        if (type_index.index_ >= dex_file->NumTypeIds()) {
+          // An extra descriptor recorded by the profile, not a type of this dex file.
+          continue;
+        }
+        // Take handles inside the loop, like the background verification, to minimize
+        // the risk of blocking anyone else.
+        ScopedObjectAccess soa(self);
+        StackHandleScope<1> hs(self);
+        Handle<mirror::ClassLoader> h_loader(hs.NewHandle(
+            soa.Decode<mirror::ClassLoader>(class_loader_)));
+        ObjPtr<mirror::Class> klass =
+            class_linker->FindClass(self, dex_file->GetTypeDescriptor(type_index), h_loader);
+        if (klass == nullptr) {
+          // The class may be missing or not yet visible through the class loader.
+          DCHECK(self->IsExceptionPending());
+          self->ClearException();
+          continue;
+        }
+        ++num_loaded;
+      }
+    }
+    VLOG(class_linker) << "Preloaded " << num_loaded << " startup classes from " << profile_;
+  }
+
+  void Finalize() override {
+    delete this;
+  }
+
+ private:
+  std::vector<const DexFile*> dex_files_;
+  jobject class_loader_;
+  const std::string profile_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreloadStartupClassesTask);
+};
+
+void OatFileManager::PreloadStartupClasses(
+    const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+    jobject class_loader) {
+  Runtime* const runtime = Runtime::Current();
+  Thread* const self = Thread::Current();
+  const std::string& profile = runtime->GetStartupClassPreloadProfile();
+  if (profile.empty() || dex_files.empty() || class_loader == nullptr) {
+    return;
+  }
+
+  if (runtime->IsJavaDebuggable()) {
+    // Threads created by ThreadPool ("runtime threads") are not allowed to load
+    // classes when debuggable to match class-initialization semantics
+    // expectations.
+    return;
+  }
+
+  if (runtime->IsZygote() || runtime->GetStartupCompleted()) {
+    // Zygote doesn't have a notion of startup.
     return;
   }
 
-  if (LocationIsOnArtApexData(odex_filename) && Runtime::Current()->DenyArtApexDataFiles()) {
-    // Ignore vdex file associated with this odex file as the odex file is not trustworthy.
+  {
+    // Only preload for class loaders we know the lookup chain of, as the runtime
+    // threads do not call Java to load classes.
+    std::unique_ptr<ClassLoaderContext> context(
+        ClassLoaderContext::CreateContextForClassLoader(class_loader, nullptr));
+    if (context == nullptr) {
+      return;
+    }
+  }
+
+  if (runtime->IsShuttingDown(self)) {
+    // Not allowed to create new threads during runtime shutdown.
     return;
   }
 
   {
     WriterMutexLock mu(self, *Locks::oat_file_manager_lock_);
-    if (verification_thread_pool_ == nullptr) {
-      verification_thread_pool_.reset(
-          ThreadPool::Create("Verification thread pool", /* num_threads= */ 1));
-      verification_thread_pool_->StartWorkers(self);
+    if (preload_thread_pool_ == nullptr) {
+      preload_thread_pool_.reset(ThreadPool::Create("Startup class preload thread pool", 1));
+      preload_thread_pool_->StartWorkers(self);
     }
   }
-  verification_thread_pool_->AddTask(self, new BackgroundVerificationTask(
-      dex_files,
-      class_loader,
-      GetVdexFilename(odex_filename)));
+  preload_thread_pool_->AddTask(
+      self, new PreloadStartupClassesTask(dex_files, class_loader, profile));
 }
 
 void OatFileManager::WaitForWorkersToBeCreated() {
@@ -894,10 +1158,14 @@ void OatFileManager::WaitForWorkersToBeCreated() {
   if (verification_thread_pool_ != nullptr) {
     verification_thread_pool_->WaitForWorkersToBeCreated();
   }
+  if (preload_thread_pool_ != nullptr) {
+    preload_thread_pool_->WaitForWorkersToBeCreated();
+  }
 }
 
 void OatFileManager::DeleteThreadPool() {
   verification_thread_pool_.reset(nullptr);
+  preload_thread_pool_.reset(nullptr);
 }
 
 void OatFileManager::WaitForBackgroundVerificationTasksToFinish() {
@@ -938,6 +1206,20 @@ void OatFileManager::DumpForSigQuit(std::ostream& os) {
     }
     os << oat_file->GetLocation() << ": " << oat_file->GetCompilerFilter() << "\n";
   }
+  // Dex files that are opened repeatedly, typically by plugin frameworks that create a class
+  // loader per use, pay the cost of opening and validating their oat files every time.
+  bool printed_header = false;
+  for (const auto& [dex_location, stats] : dex_location_open_stats_) {
+    if (stats.count < 2u) {
+      continue;
+    }
+    if (!printed_header) {
+      os << "Dex locations opened more than once:\n";
+      printed_header = true;
+    }
+    os << "  " << dex_location << ": " << stats.count << " times, "
+       << PrettyDuration(stats.total_time_ns) << " in total\n";
+  }
 }
 
 bool OatFileManager::ContainsPc(const void* code) {
@@ -128,11 +128,17 @@ class OatFileManager {
   void RunBackgroundVerification(const std::vector<const DexFile*>& dex_files,
                                  jobject class_loader);
 
+  // Load the classes that the startup class preload profile lists for the given dex files
+  // on a background thread. See `-XX:StartupClassPreloadProfile`.
+  void PreloadStartupClasses(const std::vector<std::unique_ptr<const DexFile>>& dex_files,
+                             jobject class_loader)
+      REQUIRES(!Locks::oat_file_manager_lock_, !Locks::mutator_lock_);
+
   // Wait for thread pool workers to be created. This is used during shutdown as
   // threads are not allowed to attach while runtime is in shutdown lock.
   void WaitForWorkersToBeCreated();
 
-  // If allocated, delete a thread pool of background verification threads.
+  // If allocated, delete the thread pools of background verification and preload threads.
   void DeleteThreadPool();
 
   // Wait for any ongoing background verification tasks to finish.
@@ -163,6 +169,16 @@ class OatFileManager {
 
   std::set<std::unique_ptr<const OatFile>> oat_files_ GUARDED_BY(Locks::oat_file_manager_lock_);
 
+  struct DexLocationOpenStats {
+    size_t count = 0u;
+    uint64_t total_time_ns = 0u;
+  };
+
+  // How many times, and for how long in total, `OpenDexFilesFromOat` opened each dex location.
+  // Reported in `DumpForSigQuit` so that repeated class loader creation shows up in ANR traces.
+  std::unordered_map<std::string, DexLocationOpenStats> dex_location_open_stats_
+      GUARDED_BY(Locks::oat_file_manager_lock_);
+
   // Only use the compiled code in an OAT file when the file is on /system. If the OAT file
   // is not on /system, don't load it "executable".
   bool only_use_system_oat_files_;
@@ -170,6 +186,9 @@ class OatFileManager {
   // Single-thread pool used to run the verifier in the background.
   std::unique_ptr<ThreadPool> verification_thread_pool_;
 
+  // Single-thread pool used to preload startup classes in the background.
+  std::unique_ptr<ThreadPool> preload_thread_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(OatFileManager);
 };
 
@@ -110,12 +110,13 @@ void CodeInfo::DecodeDexRegisterMap(uint32_t stack_map_index,
 
   // Keep scanning backwards and collect the most recent location of each register.
   for (int32_t s = stack_map_index; s >= 0 && remaining_registers != 0; s--) {
-    StackMap stack_map = GetStackMapAt(s);
+    // Decode the whole row at once, we need both the mask and the map index.
+    std::array<uint32_t, StackMap::kNumColumns> row = stack_maps_.GetRowValues(s);
     DCHECK_LE(stack_map_index - s, kMaxDexRegisterMapSearchDistance) << "Unbounded search";
 
     // The mask specifies which registers where modified in this stack map.
     // NB: the mask can be shorter than expected if trailing zero bits were removed.
-    uint32_t mask_index = stack_map.GetDexRegisterMaskIndex();
+    uint32_t mask_index = row[StackMap::kDexRegisterMaskIndex];
     if (mask_index == StackMap::kNoValue) {
       continue;  // Nothing changed at this stack map.
     }
@@ -125,7 +126,7 @@ void CodeInfo::DecodeDexRegisterMap(uint32_t stack_map_index,
     }
 
     // The map stores one catalogue index per each modified register location.
-    uint32_t map_index = stack_map.GetDexRegisterMapIndex();
+    uint32_t map_index = row[StackMap::kDexRegisterMapIndex];
     DCHECK_NE(map_index, StackMap::kNoValue);
 
     // Skip initial registers which we are not interested in (to get to inlined registers).
@@ -17,6 +17,8 @@
 #ifndef ART_RUNTIME_OAT_STACK_MAP_H_
 #define ART_RUNTIME_OAT_STACK_MAP_H_
 
+#include <algorithm>
+#include <array>
 #include <limits>
 
 #include "arch/instruction_set.h"
@@ -413,12 +415,9 @@ class CodeInfo {
   }
 
   StackMap GetStackMapForDexPc(uint32_t dex_pc) const {
-    for (StackMap stack_map : stack_maps_) {
-      if (stack_map.GetDexPc() == dex_pc && stack_map.GetKind() != StackMap::Kind::Debug) {
-        return stack_map;
-      }
-    }
-    return stack_maps_.GetInvalidRow();
+    return FindStackMapForDexPc(dex_pc, [](uint32_t kind) ALWAYS_INLINE {
+      return kind != StackMap::Kind::Debug;
+    });
   }
 
   StackMap GetCatchStackMapForDexPc(ArrayRef<const uint32_t> dex_pcs) const {
@@ -460,12 +459,9 @@ class CodeInfo {
   }
 
   StackMap GetOsrStackMapForDexPc(uint32_t dex_pc) const {
-    for (StackMap stack_map : stack_maps_) {
-      if (stack_map.GetDexPc() == dex_pc && stack_map.GetKind() == StackMap::Kind::OSR) {
-        return stack_map;
-      }
-    }
-    return stack_maps_.GetInvalidRow();
+    return FindStackMapForDexPc(dex_pc, [](uint32_t kind) ALWAYS_INLINE {
+      return kind == StackMap::Kind::OSR;
+    });
   }
 
   EXPORT StackMap GetStackMapForNativePcOffset(uintptr_t pc,
@@ -525,6 +521,26 @@ class CodeInfo {
                                    uint32_t first_dex_register,
                                    /*out*/ DexRegisterMap* map) const;
 
+  // Returns the first stack map for `dex_pc` whose kind is accepted by `kind_filter`. The dex pc
+  // column is decoded in chunks of rows and the kind is only decoded for the matching rows.
+  template <typename KindFilter>
+  ALWAYS_INLINE StackMap FindStackMapForDexPc(uint32_t dex_pc, KindFilter kind_filter) const {
+    static constexpr uint32_t kChunkRows = 16u;
+    std::array<uint32_t, kChunkRows> dex_pcs;
+    const uint32_t num_rows = stack_maps_.NumRows();
+    for (uint32_t first_row = 0; first_row < num_rows; first_row += kChunkRows) {
+      const uint32_t count = std::min(kChunkRows, num_rows - first_row);
+      stack_maps_.GetColumnValues(
+          StackMap::kDexPc, first_row, ArrayRef<uint32_t>(dex_pcs.data(), count));
+      for (uint32_t i = 0; i != count; ++i) {
+        if (dex_pcs[i] == dex_pc && kind_filter(stack_maps_.Get(first_row + i, StackMap::kKind))) {
+          return stack_maps_.GetRow(first_row + i);
+        }
+      }
+    }
+    return stack_maps_.GetInvalidRow();
+  }
+
   template<typename DecodeCallback>  // (size_t index, BitTable<...>*, BitMemoryRegion).
   ALWAYS_INLINE CodeInfo(const uint8_t* data, size_t* num_read_bits, DecodeCallback callback);
 
@@ -212,9 +212,80 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:ConcGCThreads=_")
           .WithType<unsigned int>()
           .IntoKey(M::ConcGCThreads)
+      .Define("-XX:ParallelMarkingCMC:_")
+          .WithHelp("Use the heap thread pool for marking with the userfaultfd GC. Defaults to"
+                    " 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::ParallelMarkingCMC)
+      .Define("-XX:AdaptiveGcTrigger:_")
+          .WithHelp("Start concurrent GCs based on the predicted allocation rate and GC duration"
+                    " instead of the bytes allocated during the last GC. Defaults to 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::AdaptiveGcTrigger)
+      .Define("-XX:HeapTransparentHugePages:_")
+          .WithHelp("Back the moving spaces of the CC and semi-space collectors with transparent"
+                    " huge pages where the kernel supports them. Defaults to 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::HeapTransparentHugePages)
+      .Define("-XX:RecordAllocationSites:_")
+          .WithHelp("Aggregate the Java heap profiler's samples by allocation site. Defaults to"
+                    " 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::RecordAllocationSites)
       .Define("-XX:FinalizerTimeoutMs=_")
           .WithType<unsigned int>()
           .IntoKey(M::FinalizerTimeoutMs)
+      .Define("-XX:BackgroundVerificationThreads=_")
+          .WithHelp("Number of threads verifying the classes of dex files that are not backed"
+                    " by an oat file. Defaults to 1")
+          .WithType<unsigned int>()
+          .IntoKey(M::BackgroundVerificationThreads)
+      .Define("-XX:BackgroundVerifyAllDexFiles:_")
+          .WithHelp("Verify in the background all dex files that are not backed by an oat file,"
+                    " not just secondary dex files. Defaults to 'false'")
+          .WithType<bool>()
+          .WithValueMap({{"false", false}, {"true", true}})
+          .IntoKey(M::BackgroundVerifyAllDexFiles)
+      .Define("-XX:StartupClassPreloadProfile=_")
+          .WithHelp("Load the classes listed in the given profile on a background thread when"
+                    " their dex files are opened, so that the main thread finds them loaded")
+          .WithType<std::string>()
+          .IntoKey(M::StartupClassPreloadProfile)
+      .Define("-XX:ParallelCheckpointThreads=_")
+          .WithHelp("Number of threads running checkpoints on behalf of suspended threads."
+                    " Defaults to 0, the requesting thread runs them")
+          .WithType<unsigned int>()
+          .IntoKey(M::ParallelCheckpointThreads)
+      .Define("-XX:FastNativeAllowlist=_")
+          .WithHelp("File listing native methods, one \"Lpkg/Class;->name(signature)\" per line,"
+                    " to treat as @FastNative. Must be passed to both dex2oat and the runtime")
+          .WithType<std::string>()
+          .IntoKey(M::FastNativeAllowlist)
+      .Define("-XX:ThreadStackPoolSize=_")
+          .WithHelp("Maximum number of native stacks kept for reuse by new threads."
+                    " Defaults to 0, stacks are allocated and freed by pthreads")
+          .WithType<unsigned int>()
+          .IntoKey(M::ThreadStackPoolSize)
+      .Define("-XX:LockContentionSampleRate=_")
+          .WithHelp("Record the wait time of one in N contended runtime lock acquisitions and"
+                    " dump the per-lock totals on SIGQUIT. Defaults to 0, disabled")
+          .WithType<unsigned int>()
+          .IntoKey(M::LockContentionSampleRate)
+      .Define("-XX:MaxJavaStackTraceDepth=_")
+          .WithHelp("Record at most N frames in the stack trace of a Throwable. Thread stack"
+                    " traces and stack walkers are not limited. Defaults to 0, unlimited")
+          .WithType<unsigned int>()
+          .IntoKey(M::MaxJavaStackTraceDepth)
+      .Define("-XX:ParallelNativeStackDumpThreads=_")
+          .WithHelp("Unwind the native stacks of a SIGQUIT dump on N threads after the managed"
+                    " stacks, printing build ids and offsets for offline symbolization instead of"
+                    " function names. Defaults to 0, disabled")
+          .WithType<unsigned int>()
+          .IntoKey(M::ParallelNativeStackDumpThreads)
       .Define("-XX:MaxSpinsBeforeThinLockInflation=_")
           .WithType<unsigned int>()
           .IntoKey(M::MaxSpinsBeforeThinLockInflation)
@@ -224,6 +295,16 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XX:LongGCLogThreshold=_")  // in ms
           .WithType<MillisecondsToNanoseconds>()  // store as ns
           .IntoKey(M::LongGCLogThreshold)
+      .Define("-XX:CardPreCleanPauseTarget=_")  // in ms
+          .WithHelp("Run additional concurrent card pre-cleaning rounds until one takes less than"
+                    " the given time. 0 (default) means a single round.")
+          .WithType<MillisecondsToNanoseconds>()  // store as ns
+          .IntoKey(M::CardPreCleanPauseTarget)
+      .Define("-XX:IdleCompactionDelay=_")  // in ms
+          .WithHelp("Compact the heap once the process has been idle for the given time after a"
+                    " GC. 0 (default) disables idle compaction.")
+          .WithType<MillisecondsToNanoseconds>()  // store as ns
+          .IntoKey(M::IdleCompactionDelay)
       .Define("-XX:DumpGCPerformanceOnShutdown")
           .IntoKey(M::DumpGCPerformanceOnShutdown)
       .Define("-XX:DumpRegionInfoBeforeGC")
@@ -263,6 +344,12 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-XMadviseWillNeedArtFileSize:_")
           .WithType<unsigned int>()
           .IntoKey(M::MadviseWillNeedArtFileSize)
+      .Define("-Xbootimageworkingset:_")
+          .WithHelp("File recording the boot image pages used during startup. The pages are\n"
+                    "prefetched when the boot image is mapped, and the file is written when the\n"
+                    "startup of a process completes if it does not exist.")
+          .WithType<std::string>()
+          .IntoKey(M::BootImageWorkingSet)
       .Define("-Xusejit:_")
           .WithType<bool>()
           .WithValueMap({{"false", false}, {"true", true}})
@@ -277,6 +364,17 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xjitmaxsize:_")
           .WithType<MemoryKiB>()
           .IntoKey(M::JITCodeCacheMaxCapacity)
+      .Define("-Xjitwarmstartprofile:_")
+          .WithHelp("Precompile the methods listed in the given profile, e.g. the profile saved\n"
+                    "by the previous run of the same process, when its dex files are loaded.")
+          .WithType<std::string>()
+          .IntoKey(M::JITWarmStartProfile)
+      .Define("-Xjitzygotesharedprofile:_")
+          .WithHelp("Profile through which the system server hands the boot classpath methods\n"
+                    "it JIT-compiled to the zygote, which compiles them in the shared code region\n"
+                    "at its next start.")
+          .WithType<std::string>()
+          .IntoKey(M::JITZygoteSharedProfile)
       .Define("-Xjitwarmupthreshold:_")
           .WithType<unsigned int>()
           .IntoKey(M::JITWarmupThreshold)
@@ -286,6 +384,12 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
       .Define("-Xjittransitionweight:_")
           .WithType<unsigned int>()
           .IntoKey(M::JITInvokeTransitionWeight)
+      .Define("-Xjitthreads:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::JITPoolThreads)
+      .Define("-Xjitcpubudget:_")
+          .WithType<unsigned int>()
+          .IntoKey(M::JITCpuBudget)
       .Define("-Xjitpthreadpriority:_")
           .WithType<int>()
           .IntoKey(M::JITPoolThreadPthreadPriority)
@@ -314,6 +418,8 @@ std::unique_ptr<RuntimeParser> ParsedOptions::MakeParser(bool ignore_unrecognize
                "-Xps-min-notification-before-wake:_",
                "-Xps-max-notification-before-wake:_",
                "-Xps-inline-cache-threshold:_",
+               "-Xps-sampling-interval-ms:_",
+               "-Xps-startup-trace-path:_",
                "-Xps-profile-path:_"})
           .WithHelp("profile-saver options -Xps-<key>:<value>")
           .WithType<ProfileSaverOptions>()
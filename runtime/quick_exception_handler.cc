@@ -44,6 +44,8 @@
 #include "oat/oat_quick_method_header.h"
 #include "oat/stack_map.h"
 #include "stack.h"
+#include "stack_map_cache.h"
+#include "thread.h"
 
 namespace art HIDDEN {
 
@@ -128,18 +130,44 @@ class CatchBlockStackVisitor final : public StackVisitor {
       dex_pc = GetDexPc();
     }
     if (dex_pc != dex::kDexNoIndex) {
-      bool clear_exception = false;
-      StackHandleScope<1> hs(GetThread());
-      Handle<mirror::Class> to_find(hs.NewHandle((*exception_)->GetClass()));
-      uint32_t found_dex_pc = method->FindCatchBlock(to_find, dex_pc, &clear_exception);
-      exception_handler_->SetClearException(clear_exception);
-      if (found_dex_pc != dex::kDexNoIndex) {
-        exception_handler_->SetHandlerDexPcList(ComputeDexPcList(found_dex_pc));
-        uint32_t stack_map_row = -1;
-        exception_handler_->SetHandlerQuickFramePc(
-            GetCurrentOatQuickMethodHeader()->ToNativeQuickPcForCatchHandlers(
-                method, exception_handler_->GetHandlerDexPcList(), &stack_map_row));
-        exception_handler_->SetCatchStackMapRow(stack_map_row);
+      // Frames of compiled code are identified by the native pc and the inlining depth,
+      // other frames only by the method and dex pc. Only the former cache the native handler.
+      bool is_compiled_frame = GetCurrentShadowFrame() == nullptr &&
+                               GetCurrentQuickFrame() != nullptr &&
+                               GetCurrentOatQuickMethodHeader()->IsOptimized();
+      uintptr_t pc = is_compiled_frame ? GetCurrentQuickFramePc() : 0u;
+      size_t inline_depth = is_compiled_frame ? InlineDepth() : 0u;
+      mirror::Class* exception_class = (*exception_)->GetClass().Ptr();
+      StackMapCache* cache = GetThread()->GetStackMapCache();
+      const StackMapCache::CatchHandler* cached_handler =
+          cache->FindCatchHandler(pc, inline_depth, method, dex_pc, exception_class);
+      StackMapCache::CatchHandler handler;
+      bool all_types_resolved = true;
+      if (cached_handler != nullptr) {
+        handler = *cached_handler;
+      } else {
+        StackHandleScope<1> hs(GetThread());
+        Handle<mirror::Class> to_find(hs.NewHandle(exception_class));
+        handler.dex_pc = method->FindCatchBlock(
+            to_find, dex_pc, &handler.clear_exception, &all_types_resolved);
+        // Resolving the handler types may have moved the exception class.
+        exception_class = to_find.Get();
+      }
+      exception_handler_->SetClearException(handler.clear_exception);
+      if (handler.dex_pc != dex::kDexNoIndex) {
+        exception_handler_->SetHandlerDexPcList(ComputeDexPcList(handler.dex_pc));
+        if (cached_handler == nullptr || !is_compiled_frame) {
+          handler.stack_map_row = -1;
+          handler.native_pc = GetCurrentOatQuickMethodHeader()->ToNativeQuickPcForCatchHandlers(
+              method, exception_handler_->GetHandlerDexPcList(), &handler.stack_map_row);
+        }
+      }
+      if (cached_handler == nullptr && all_types_resolved) {
+        cache->PutCatchHandler(pc, inline_depth, method, dex_pc, exception_class, handler);
+      }
+      if (handler.dex_pc != dex::kDexNoIndex) {
+        exception_handler_->SetHandlerQuickFramePc(handler.native_pc);
+        exception_handler_->SetCatchStackMapRow(handler.stack_map_row);
         exception_handler_->SetHandlerQuickFrame(GetCurrentQuickFrame());
         exception_handler_->SetHandlerMethodHeader(GetCurrentOatQuickMethodHeader());
         return false;  // End stack walk.
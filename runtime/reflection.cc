@@ -225,9 +225,10 @@ class ArgArray {
   bool BuildArgArrayFromObjectArray(ObjPtr<mirror::Object> receiver,
                                     ObjPtr<mirror::ObjectArray<mirror::Object>> raw_args,
                                     ArtMethod* m,
+                                    const dex::TypeList* classes,
                                     Thread* self)
       REQUIRES_SHARED(Locks::mutator_lock_) {
-    const dex::TypeList* classes = m->GetParameterTypeList();
+    DCHECK_EQ(classes, m->GetParameterTypeList());
     // Set receiver if non-null (method is not static)
     if (receiver != nullptr) {
       Append(receiver);
@@ -460,9 +461,11 @@ void InvokeWithArgArray(const ScopedObjectAccessAlreadyRunnable& soa,
 
 ALWAYS_INLINE
 bool CheckArgsForInvokeMethod(ArtMethod* np_method,
-                              ObjPtr<mirror::ObjectArray<mirror::Object>> objects)
+                              ObjPtr<mirror::ObjectArray<mirror::Object>> objects,
+                              /*out*/ const dex::TypeList** parameter_types)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   const dex::TypeList* classes = np_method->GetParameterTypeList();
+  *parameter_types = classes;
   uint32_t classes_size = (classes == nullptr) ? 0 : classes->Size();
   uint32_t arg_count = (objects == nullptr) ? 0 : objects->GetLength();
   if (UNLIKELY(arg_count != classes_size)) {
@@ -479,13 +482,15 @@ bool InvokeMethodImpl(const ScopedObjectAccessAlreadyRunnable& soa,
                       ArtMethod* np_method,
                       ObjPtr<mirror::Object> receiver,
                       ObjPtr<mirror::ObjectArray<mirror::Object>> objects,
+                      const dex::TypeList* parameter_types,
                       const char** shorty,
                       JValue* result) REQUIRES_SHARED(Locks::mutator_lock_) {
   // Invoke the method.
   uint32_t shorty_len = 0;
   *shorty = np_method->GetShorty(&shorty_len);
   ArgArray arg_array(*shorty, shorty_len);
-  if (!arg_array.BuildArgArrayFromObjectArray(receiver, objects, np_method, soa.Self())) {
+  if (!arg_array.BuildArgArrayFromObjectArray(
+          receiver, objects, np_method, parameter_types, soa.Self())) {
     CHECK(soa.Self()->IsExceptionPending());
     return false;
   }
@@ -736,8 +741,12 @@ jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa, jobject javaM
         return nullptr;
       }
 
-      // Find the actual implementation of the virtual method.
-      m = receiver->GetClass()->FindVirtualMethodForVirtualOrInterface(m, kPointerSize);
+      // Find the actual implementation of the virtual method. A receiver of exactly the
+      // declaring class, which is always the case for final classes, needs no lookup.
+      ObjPtr<mirror::Class> receiver_class = receiver->GetClass();
+      if (receiver_class != declaring_class) {
+        m = receiver_class->FindVirtualMethodForVirtualOrInterface(m, kPointerSize);
+      }
     }
   }
 
@@ -745,7 +754,8 @@ jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa, jobject javaM
   ObjPtr<mirror::ObjectArray<mirror::Object>> objects =
       soa.Decode<mirror::ObjectArray<mirror::Object>>(javaArgs);
   auto* np_method = m->GetInterfaceMethodIfProxy(kPointerSize);
-  if (!CheckArgsForInvokeMethod(np_method, objects)) {
+  const dex::TypeList* parameter_types;
+  if (!CheckArgsForInvokeMethod(np_method, objects, &parameter_types)) {
     return nullptr;
   }
 
@@ -770,7 +780,8 @@ jobject InvokeMethod(const ScopedObjectAccessAlreadyRunnable& soa, jobject javaM
   // Invoke the method.
   JValue result;
   const char* shorty;
-  if (!InvokeMethodImpl(soa, m, np_method, receiver, objects, &shorty, &result)) {
+  if (!InvokeMethodImpl(
+          soa, m, np_method, receiver, objects, parameter_types, &shorty, &result)) {
     return nullptr;
   }
   return soa.AddLocalReference<jobject>(BoxPrimitive(Primitive::GetType(shorty[0]), result));
@@ -822,14 +833,16 @@ void InvokeConstructor(const ScopedObjectAccessAlreadyRunnable& soa,
   ObjPtr<mirror::ObjectArray<mirror::Object>> objects =
       soa.Decode<mirror::ObjectArray<mirror::Object>>(javaArgs);
   ArtMethod* np_method = constructor->GetInterfaceMethodIfProxy(kRuntimePointerSize);
-  if (!CheckArgsForInvokeMethod(np_method, objects)) {
+  const dex::TypeList* parameter_types;
+  if (!CheckArgsForInvokeMethod(np_method, objects, &parameter_types)) {
     return;
   }
 
   // Invoke the constructor.
   JValue result;
   const char* shorty;
-  InvokeMethodImpl(soa, constructor, np_method, receiver, objects, &shorty, &result);
+  InvokeMethodImpl(
+      soa, constructor, np_method, receiver, objects, parameter_types, &shorty, &result);
 }
 
 ObjPtr<mirror::Object> BoxPrimitive(Primitive::Type src_class, const JValue& value) {
@@ -32,13 +32,16 @@
 #include <crt_externs.h>  // for _NSGetEnviron
 #endif
 
+#include <android-base/file.h>
 #include <android-base/properties.h>
 #include <android-base/strings.h>
 #include <string.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <limits>
+#include <map>
 #include <thread>
 #include <unordered_set>
 #include <vector>
@@ -175,8 +178,10 @@
 #include "signal_set.h"
 #include "thread.h"
 #include "thread_list.h"
+#include "thread_stack_pool.h"
 #include "ti/agent.h"
 #include "trace.h"
+#include "trace_profile.h"
 #include "vdex_file.h"
 #include "verifier/class_verifier.h"
 #include "well_known_classes-inl.h"
@@ -285,6 +290,7 @@ Runtime::Runtime()
       system_thread_group_(nullptr),
       system_class_loader_(nullptr),
       dump_gc_performance_on_shutdown_(false),
+      parallel_marking_cmc_(false),
       active_transaction_(false),
       verify_(verifier::VerifyMode::kNone),
       target_sdk_version_(static_cast<uint32_t>(SdkVersion::kUnset)),
@@ -330,6 +336,7 @@ Runtime::Runtime()
   std::fill(callee_save_methods_, callee_save_methods_ + arraysize(callee_save_methods_), 0u);
   interpreter::CheckInterpreterAsmConstants();
   callbacks_.reset(new RuntimeCallbacks());
+  hidden_api_decision_cache_.reset(new hiddenapi::AccessDecisionCache());
   for (size_t i = 0; i <= static_cast<size_t>(DeoptimizationKind::kLast); ++i) {
     deoptimization_counts_[i] = 0u;
   }
@@ -466,6 +473,7 @@ Runtime::~Runtime() {
   }
   DeleteThreadPool();
   CHECK(thread_pool_ == nullptr);
+  thread_list_->DeleteCheckpointThreadPool();
 
   if (attach_shutdown_thread) {
     DetachCurrentThread(/* should_run_callbacks= */ false);
@@ -505,6 +513,7 @@ Runtime::~Runtime() {
   // We assume that by this point, we've waited long enough for things to quiesce.
   delete thread_list_;
   thread_list_ = nullptr;
+  thread_stack_pool_.reset();
 
   // Delete the JIT after thread list to ensure that there is no remaining threads which could be
   // accessing the instrumentation when we delete it.
@@ -1229,6 +1238,13 @@ void Runtime::InitNonZygoteOrPostFork(
 
   DCHECK(!IsZygote());
 
+  // Create the heap thread pool used by the MarkCompact collector for parallel
+  // marking. Zygote doesn't get one as it must stay single-threaded for fork.
+  if (parallel_marking_cmc_ && heap_->GetThreadPool() == nullptr) {
+    ScopedTrace timing("CreateHeapThreadPool");
+    heap_->CreateThreadPool();
+  }
+
   if (is_system_server) {
     // Register the system server code paths.
     // TODO: Ideally this should be done by the VMRuntime#RegisterAppInfo. However, right now
@@ -1273,10 +1289,18 @@ void Runtime::InitNonZygoteOrPostFork(
     thread_pool_->StartWorkers(Thread::Current());
   }
 
+  // Create the thread pool running checkpoints on behalf of suspended threads.
+  if (parallel_checkpoint_threads_ != 0u) {
+    ScopedTrace timing("CreateCheckpointThreadPool");
+    thread_list_->CreateCheckpointThreadPool(parallel_checkpoint_threads_);
+  }
+
   // Reset the gc performance data and metrics at zygote fork so that the events from
   // before fork aren't attributed to an app.
   heap_->ResetGcPerformanceInfo();
   GetMetrics()->Reset();
+  GetMetrics()->BootImagePrivateDirtyPages()->Add(gc::space::ImageSpace::CountPrivateDirtyPages(
+      ArrayRef<gc::space::ImageSpace* const>(heap_->GetBootImageSpaces())));
 
   if (AreMetricsInitialized()) {
     // Now that we know if we are an app or system server, reload the metrics reporter config
@@ -1657,6 +1681,20 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   image_compiler_options_ = runtime_options.ReleaseOrDefault(Opt::ImageCompilerOptions);
 
   finalizer_timeout_ms_ = runtime_options.GetOrDefault(Opt::FinalizerTimeoutMs);
+  max_java_stack_trace_depth_ = runtime_options.GetOrDefault(Opt::MaxJavaStackTraceDepth);
+  parallel_native_stack_dump_threads_ =
+      runtime_options.GetOrDefault(Opt::ParallelNativeStackDumpThreads);
+  background_verification_threads_ =
+      std::max(runtime_options.GetOrDefault(Opt::BackgroundVerificationThreads), 1u);
+  background_verify_all_dex_files_ = runtime_options.GetOrDefault(Opt::BackgroundVerifyAllDexFiles);
+  startup_class_preload_profile_ = runtime_options.GetOrDefault(Opt::StartupClassPreloadProfile);
+  parallel_checkpoint_threads_ = runtime_options.GetOrDefault(Opt::ParallelCheckpointThreads);
+  LoadFastNativeAllowlist(runtime_options.GetOrDefault(Opt::FastNativeAllowlist));
+  BaseMutex::SetContentionSampleRate(runtime_options.GetOrDefault(Opt::LockContentionSampleRate));
+  unsigned int thread_stack_pool_size = runtime_options.GetOrDefault(Opt::ThreadStackPoolSize);
+  if (thread_stack_pool_size != 0u) {
+    thread_stack_pool_.reset(new ThreadStackPool(thread_stack_pool_size));
+  }
   max_spins_before_thin_lock_inflation_ =
       runtime_options.GetOrDefault(Opt::MaxSpinsBeforeThinLockInflation);
 
@@ -1716,6 +1754,7 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   madvise_willneed_total_dex_size_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedVdexFileSize);
   madvise_willneed_odex_filesize_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedOdexFileSize);
   madvise_willneed_art_filesize_ = runtime_options.GetOrDefault(Opt::MadviseWillNeedArtFileSize);
+  boot_image_working_set_ = runtime_options.ReleaseOrDefault(Opt::BootImageWorkingSet);
 
   jni_ids_indirection_ = runtime_options.GetOrDefault(Opt::OpaqueJniIds);
   automatically_set_jni_ids_indirection_ =
@@ -1743,6 +1782,8 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
 
   // Generational CC collection is currently only compatible with Baker read barriers.
   bool use_generational_cc = kUseBakerReadBarrier && xgc_option.generational_cc;
+  // Generational CMC collection is only meaningful with the userfaultfd GC.
+  bool use_generational_cmc = gUseUserfaultfd && xgc_option.generational_cmc;
 
   // Cache the apex versions.
   InitializeApexVersions();
@@ -1792,11 +1833,23 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
                        xgc_option.measure_,
                        runtime_options.GetOrDefault(Opt::EnableHSpaceCompactForOOM),
                        use_generational_cc,
+                       use_generational_cmc,
                        runtime_options.GetOrDefault(Opt::HSpaceCompactForOOMMinIntervalsMs),
                        runtime_options.Exists(Opt::DumpRegionInfoBeforeGC),
                        runtime_options.Exists(Opt::DumpRegionInfoAfterGC));
 
+  heap_->SetCardPreCleanPauseTarget(
+      runtime_options.GetOrDefault(Opt::CardPreCleanPauseTarget).GetNanoseconds());
+  heap_->SetAdaptiveGcTrigger(runtime_options.GetOrDefault(Opt::AdaptiveGcTrigger));
+  heap_->SetIdleCompactionDelay(
+      runtime_options.GetOrDefault(Opt::IdleCompactionDelay).GetNanoseconds());
+  if (runtime_options.GetOrDefault(Opt::HeapTransparentHugePages)) {
+    heap_->AdviseTransparentHugePages();
+  }
+  heap_->GetHeapSampler().SetRecordAllocationSites(
+      runtime_options.GetOrDefault(Opt::RecordAllocationSites));
   dump_gc_performance_on_shutdown_ = runtime_options.Exists(Opt::DumpGCPerformanceOnShutdown);
+  parallel_marking_cmc_ = gUseUserfaultfd && runtime_options.GetOrDefault(Opt::ParallelMarkingCMC);
 
   bool has_explicit_jdwp_options = runtime_options.Get(Opt::JdwpOptions) != nullptr;
   jdwp_options_ = runtime_options.GetOrDefault(Opt::JdwpOptions);
@@ -1872,13 +1925,13 @@ bool Runtime::Init(RuntimeArgumentMap&& runtime_options_in) {
   // Change the implicit checks flags based on runtime architecture.
   switch (kRuntimeISA) {
     case InstructionSet::kArm64:
+    case InstructionSet::kRiscv64:
+    case InstructionSet::kX86_64:
       implicit_suspend_checks_ = true;
       FALLTHROUGH_INTENDED;
     case InstructionSet::kArm:
     case InstructionSet::kThumb2:
-    case InstructionSet::kRiscv64:
     case InstructionSet::kX86:
-    case InstructionSet::kX86_64:
       implicit_null_checks_ = true;
       // Historical note: Installing stack protection was not playing well with Valgrind.
       implicit_so_checks_ = true;
@@ -2291,6 +2344,38 @@ void Runtime::AttachAgent(JNIEnv* env, const std::string& agent_arg, jobject cla
   }
 }
 
+void Runtime::LoadFastNativeAllowlist(const std::string& filename) {
+  if (filename.empty()) {
+    return;
+  }
+  std::string contents;
+  if (!android::base::ReadFileToString(filename, &contents)) {
+    PLOG(WARNING) << "Failed to read fast native allowlist " << filename;
+    return;
+  }
+  for (std::string_view line : SplitString(contents, '\n')) {
+    std::string entry = android::base::Trim(line);
+    if (!entry.empty() && entry[0] != '#') {
+      fast_native_allowlist_.insert(std::move(entry));
+    }
+  }
+  VLOG(jni) << "Loaded " << fast_native_allowlist_.size() << " fast native methods from "
+            << filename;
+}
+
+uint32_t Runtime::GetAllowlistedNativeAccessFlags(const DexFile& dex_file,
+                                                  uint32_t method_idx) const {
+  if (LIKELY(fast_native_allowlist_.empty())) {
+    return 0u;
+  }
+  const dex::MethodId& method_id = dex_file.GetMethodId(method_idx);
+  std::string key(dex_file.GetMethodDeclaringClassDescriptorView(method_id));
+  key += "->";
+  key += dex_file.GetMethodNameView(method_id);
+  key += dex_file.GetMethodSignature(method_id).ToString();
+  return ContainsElement(fast_native_allowlist_, key) ? kAccFastNative : 0u;
+}
+
 void Runtime::InitNativeMethods() {
   VLOG(startup) << "Runtime::InitNativeMethods entering";
   Thread* self = Thread::Current();
@@ -2449,6 +2534,45 @@ void Runtime::DumpDeoptimizations(std::ostream& os) {
   }
 }
 
+size_t Runtime::GetArenaPoolsBytesAllocated() {
+  size_t bytes = 0u;
+  for (ArenaPool* pool : {GetArenaPool(), GetJitArenaPool(), GetLinearAllocArenaPool()}) {
+    if (pool != nullptr) {
+      bytes += pool->GetBytesAllocated();
+    }
+  }
+  return bytes;
+}
+
+void Runtime::DumpInternalMemoryUsage(std::ostream& os) {
+  os << "Arena pools: " << PrettySize(GetArenaPoolsBytesAllocated()) << " allocated\n";
+  if (GetLinearAlloc() != nullptr) {
+    os << "Linear alloc: " << PrettySize(GetLinearAlloc()->GetUsedMemory()) << " used\n";
+  }
+  std::map<std::string, MemMap::NameUsage> usage_by_name = MemMap::GetUsageByName();
+  std::vector<std::pair<std::string, MemMap::NameUsage>> usages(usage_by_name.begin(),
+                                                                usage_by_name.end());
+  // Largest first, as these are the ones worth looking at for memory regressions.
+  std::sort(usages.begin(), usages.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.live_bytes > rhs.second.live_bytes;
+  });
+  size_t live_bytes = 0u;
+  for (const auto& [name, usage] : usages) {
+    live_bytes += usage.live_bytes;
+  }
+  os << "MemMaps: " << PrettySize(live_bytes) << " mapped, peak "
+     << PrettySize(MemMap::GetPeakMappedBytes()) << "\n";
+  for (const auto& [name, usage] : usages) {
+    os << "  " << name << ": " << PrettySize(usage.live_bytes) << " in " << usage.num_maps
+       << " maps, peak " << PrettySize(usage.peak_bytes) << "\n";
+  }
+}
+
+void Runtime::UpdateInternalMemoryMetrics() {
+  GetMetrics()->MemMapPeakBytes()->Add(MemMap::GetPeakMappedBytes());
+  GetMetrics()->ArenaPoolPeakBytes()->Add(GetArenaPoolsBytesAllocated());
+}
+
 std::optional<uint64_t> Runtime::SiqQuitNanoTime() const {
   return signal_catcher_ != nullptr ? signal_catcher_->SiqQuitNanoTime() : std::nullopt;
 }
@@ -2468,7 +2592,10 @@ void Runtime::DumpForSigQuit(std::ostream& os) {
     os << "Running non JIT\n";
   }
   DumpDeoptimizations(os);
+  TraceProfiler::DumpForSigQuit(os);
   TrackedAllocators::Dump(os);
+  DumpInternalMemoryUsage(os);
+  UpdateInternalMemoryMetrics();
   GetMetrics()->DumpForSigQuit(os);
   os << "\n";
 
@@ -3053,6 +3180,20 @@ bool Runtime::IsVerificationSoftFail() const {
   return verify_ == verifier::VerifyMode::kSoftFail;
 }
 
+size_t Runtime::GetMaxThrowableStackTraceDepth() const {
+  // Exception thrown events are only reported for exceptions thrown by the current method, which
+  // is checked by comparing the depth of the stack trace with the depth of the stack, see
+  // `Thread::IsExceptionThrownByCurrentMethod()`. Record complete stack traces for them.
+  if (GetInstrumentation()->HasExceptionThrownListeners()) {
+    return 0u;
+  }
+  return max_java_stack_trace_depth_;
+}
+
+void Runtime::InvalidateHiddenApiDecisions() {
+  hidden_api_decision_cache_->Invalidate();
+}
+
 bool Runtime::IsAsyncDeoptimizeable(ArtMethod* method, uintptr_t code) const {
   if (OatQuickMethodHeader::NterpMethodHeader != nullptr) {
     if (OatQuickMethodHeader::NterpMethodHeader->Contains(code)) {
@@ -3313,6 +3454,19 @@ bool Runtime::NotifyStartupCompleted() {
 
   ProfileSaver::NotifyStartupCompleted();
 
+  // Record the boot image pages used so far, for prefetching them on the next start.
+  if (!boot_image_working_set_.empty() &&
+      !GetHeap()->GetBootImageSpaces().empty() &&
+      !OS::FileExists(boot_image_working_set_.c_str())) {
+    std::string error_msg;
+    if (!gc::space::ImageSpace::RecordBootImageWorkingSet(
+            ArrayRef<gc::space::ImageSpace* const>(GetHeap()->GetBootImageSpaces()),
+            boot_image_working_set_,
+            &error_msg)) {
+      LOG(WARNING) << "Could not record the boot image working set: " << error_msg;
+    }
+  }
+
   if (AreMetricsInitialized()) {
     metrics_reporter_->NotifyStartupCompleted();
   }
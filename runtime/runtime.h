@@ -60,6 +60,7 @@ class Heap;
 }  // namespace gc
 
 namespace hiddenapi {
+class AccessDecisionCache;
 enum class EnforcementPolicy;
 }  // namespace hiddenapi
 
@@ -116,6 +117,7 @@ class StackOverflowHandler;
 class SuspensionHandler;
 class ThreadList;
 class ThreadPool;
+class ThreadStackPool;
 class Trace;
 struct TraceConfig;
 
@@ -318,6 +320,13 @@ class Runtime {
 
   void DumpDeoptimizations(std::ostream& os);
   void DumpForSigQuit(std::ostream& os);
+
+  // Dumps the memory used by runtime-internal allocators: the arena pools, the linear alloc
+  // and the MemMaps of each subsystem, with their peaks.
+  void DumpInternalMemoryUsage(std::ostream& os);
+
+  // Records the current runtime-internal memory usage in the peak memory metrics.
+  void UpdateInternalMemoryMetrics();
   void DumpLockHolders(std::ostream& os);
 
   EXPORT ~Runtime();
@@ -395,6 +404,30 @@ class Runtime {
     return finalizer_timeout_ms_;
   }
 
+  // Returns the maximum number of frames to record in the stack trace of a new `Throwable`,
+  // or 0 if the stack trace should be complete.
+  size_t GetMaxThrowableStackTraceDepth() const;
+
+  unsigned int GetParallelNativeStackDumpThreads() const {
+    return parallel_native_stack_dump_threads_;
+  }
+
+  unsigned int GetBackgroundVerificationThreads() const {
+    return background_verification_threads_;
+  }
+
+  bool BackgroundVerifyAllDexFiles() const {
+    return background_verify_all_dex_files_;
+  }
+
+  const std::string& GetStartupClassPreloadProfile() const {
+    return startup_class_preload_profile_;
+  }
+
+  // Returns `kAccFastNative` if the native method is listed in the `-XX:FastNativeAllowlist`
+  // file, 0 otherwise. Used for native methods without @FastNative or @CriticalNative.
+  uint32_t GetAllowlistedNativeAccessFlags(const DexFile& dex_file, uint32_t method_idx) const;
+
   gc::Heap* GetHeap() const {
     return heap_;
   }
@@ -444,6 +477,12 @@ class Runtime {
     return thread_list_;
   }
 
+  // Returns the pool of native stacks for new threads, or null if `-XX:ThreadStackPoolSize`
+  // is 0.
+  ThreadStackPool* GetThreadStackPool() const {
+    return thread_stack_pool_.get();
+  }
+
   static const char* GetVersion() {
     return "2.1.0";
   }
@@ -659,6 +698,7 @@ class Runtime {
 
   void SetHiddenApiEnforcementPolicy(hiddenapi::EnforcementPolicy policy) {
     hidden_api_policy_ = policy;
+    InvalidateHiddenApiDecisions();
   }
 
   hiddenapi::EnforcementPolicy GetHiddenApiEnforcementPolicy() const {
@@ -675,6 +715,7 @@ class Runtime {
 
   void SetTestApiEnforcementPolicy(hiddenapi::EnforcementPolicy policy) {
     test_api_policy_ = policy;
+    InvalidateHiddenApiDecisions();
   }
 
   hiddenapi::EnforcementPolicy GetTestApiEnforcementPolicy() const {
@@ -683,12 +724,22 @@ class Runtime {
 
   void SetHiddenApiExemptions(const std::vector<std::string>& exemptions) {
     hidden_api_exemptions_ = exemptions;
+    InvalidateHiddenApiDecisions();
   }
 
   const std::vector<std::string>& GetHiddenApiExemptions() {
     return hidden_api_exemptions_;
   }
 
+  hiddenapi::AccessDecisionCache* GetHiddenApiDecisionCache() const {
+    return hidden_api_decision_cache_.get();
+  }
+
+  // Drops the cached hidden API access decisions. Must be called whenever an input of these
+  // decisions, such as the enforcement policies, the exemptions, the target SDK version or the
+  // disabled compat changes, is modified.
+  EXPORT void InvalidateHiddenApiDecisions();
+
   void SetDedupeHiddenApiWarnings(bool value) {
     dedupe_hidden_api_warnings_ = value;
   }
@@ -739,6 +790,7 @@ class Runtime {
 
   void SetTargetSdkVersion(uint32_t version) {
     target_sdk_version_ = version;
+    InvalidateHiddenApiDecisions();
   }
 
   uint32_t GetTargetSdkVersion() const {
@@ -973,6 +1025,10 @@ class Runtime {
     return madvise_willneed_art_filesize_;
   }
 
+  const std::string& GetBootImageWorkingSet() const {
+    return boot_image_working_set_;
+  }
+
   const std::string& GetJdwpOptions() {
     return jdwp_options_;
   }
@@ -1137,6 +1193,9 @@ class Runtime {
  private:
   static void InitPlatformSignalHandlers();
 
+  // Returns the bytes allocated by all the arena pools of the runtime.
+  size_t GetArenaPoolsBytesAllocated();
+
   Runtime();
 
   bool HandlesSignalsInCompiledCode() const {
@@ -1149,6 +1208,7 @@ class Runtime {
   bool Init(RuntimeArgumentMap&& runtime_options)
       SHARED_TRYLOCK_FUNCTION(true, Locks::mutator_lock_);
   void InitNativeMethods() REQUIRES(!Locks::mutator_lock_);
+  void LoadFastNativeAllowlist(const std::string& filename);
   void RegisterRuntimeNativeMethods(JNIEnv* env);
   void InitMetrics();
 
@@ -1247,6 +1307,30 @@ class Runtime {
   // Finalizers running for longer than this many milliseconds abort the runtime.
   unsigned int finalizer_timeout_ms_;
 
+  // See `-XX:MaxJavaStackTraceDepth`, 0 if unlimited.
+  unsigned int max_java_stack_trace_depth_;
+
+  // See `-XX:ParallelNativeStackDumpThreads`, 0 if disabled.
+  unsigned int parallel_native_stack_dump_threads_;
+
+  // Number of threads used by `OatFileManager::RunBackgroundVerification()`.
+  unsigned int background_verification_threads_;
+
+  // Whether to verify in the background dex files other than secondary dex files.
+  bool background_verify_all_dex_files_;
+
+  // Profile listing the classes that `OatFileManager` loads in the background, if any.
+  std::string startup_class_preload_profile_;
+
+  // Number of threads running checkpoints on behalf of suspended threads, 0 if disabled.
+  unsigned int parallel_checkpoint_threads_;
+
+  // Native stacks kept for reuse by new threads, see `ThreadStackPool`.
+  std::unique_ptr<ThreadStackPool> thread_stack_pool_;
+
+  // Native methods to treat as @FastNative, see `GetAllowlistedNativeAccessFlags()`.
+  std::set<std::string, std::less<>> fast_native_allowlist_;
+
   gc::Heap* heap_;
 
   std::unique_ptr<ArenaPool> jit_arena_pool_;
@@ -1342,6 +1426,10 @@ class Runtime {
   // If true, then we dump the GC cumulative timings on shutdown.
   bool dump_gc_performance_on_shutdown_;
 
+  // If true, then the heap thread pool is created for non-zygote processes so
+  // that the MarkCompact collector can mark in parallel.
+  bool parallel_marking_cmc_;
+
   // Transactions are handled by the `AotClassLinker` but we keep a simple flag
   // in the `Runtime` for quick transaction checks.
   // Code that's not AOT-specific but needs some transaction-specific behavior
@@ -1443,6 +1531,10 @@ class Runtime {
   // A 0 for this will turn off madvising to MADV_WILLNEED
   size_t madvise_willneed_art_filesize_;
 
+  // File with the boot image pages used during startup, prefetched with MADV_WILLNEED when
+  // the boot image is mapped. Empty if disabled.
+  std::string boot_image_working_set_;
+
   // Whether the application should run in safe mode, that is, interpreter only.
   bool safe_mode_;
 
@@ -1459,6 +1551,9 @@ class Runtime {
   // as if SDK.
   std::vector<std::string> hidden_api_exemptions_;
 
+  // Decisions of hidden API access checks, reused by later checks of the same members.
+  std::unique_ptr<hiddenapi::AccessDecisionCache> hidden_api_decision_cache_;
+
   // Do not warn about the same hidden API access violation twice.
   // This is only used for testing.
   bool dedupe_hidden_api_warnings_;
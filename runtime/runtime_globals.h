@@ -142,6 +142,13 @@ static constexpr bool kEnableGenerationalCCByDefault = true;
 static constexpr bool kEnableGenerationalCCByDefault = false;
 #endif
 
+// When using the userfaultfd-based Concurrent Mark-Compact (CMC) collector,
+// enable generational collection by default, i.e. use young-generation CMC
+// cycles for minor collections and full CMC cycles for major collections.
+// This default value can be overridden with the runtime option
+// `-Xgc:[no]generational_cmc`.
+static constexpr bool kEnableGenerationalCMCByDefault = false;
+
 // If true, enable the tlab allocator by default.
 #ifdef ART_USE_TLAB
 static constexpr bool kUseTlab = true;
@@ -34,10 +34,12 @@
 #include "base/systrace.h"
 #include "base/unix_file/fd_file.h"
 #include "base/utils.h"
+#include "class_linker.h"
 #include "class_loader_context.h"
 #include "class_loader_utils.h"
 #include "class_root-inl.h"
 #include "dex/class_accessor-inl.h"
+#include "dex/dex_file_loader.h"
 #include "gc/space/image_space.h"
 #include "mirror/object-inl.h"
 #include "mirror/object-refvisitor-inl.h"
@@ -1871,6 +1873,54 @@ static bool EnsureDirectoryExists(const std::string& directory, std::string* err
   return true;
 }
 
+// Minimum number of classes loaded outside of a runtime app image, both in absolute terms and
+// as a percentage of the classes in the image, for regenerating the image.
+static constexpr size_t kMinNewClassesForRegeneration = 100u;
+static constexpr size_t kMinNewClassesPercentageForRegeneration = 10u;
+
+bool RuntimeImage::ShouldWriteImage(const std::string& dex_location) {
+  gc::Heap* heap = Runtime::Current()->GetHeap();
+  ScopedObjectAccess soa(Thread::Current());
+  gc::space::ImageSpace* app_image_space = nullptr;
+  for (gc::space::ContinuousSpace* space : heap->GetContinuousSpaces()) {
+    if (space->IsImageSpace() &&
+        !heap->IsBootImageAddress(space->Begin()) &&
+        space->AsImageSpace()->GetOatFile()->GetOatDexFiles()[0]->GetDexFileLocation() ==
+            dex_location) {
+      app_image_space = space->AsImageSpace();
+      break;
+    }
+  }
+  if (app_image_space == nullptr) {
+    return true;
+  }
+  // Images compiled by dex2oat are updated by the next compilation instead.
+  if (app_image_space->GetImageHeader().GetOatFileBegin() != nullptr) {
+    return false;
+  }
+
+  size_t image_classes = 0u;
+  size_t new_classes = 0u;
+  ClassFuncVisitor visitor([&](ObjPtr<mirror::Class> klass) REQUIRES_SHARED(Locks::mutator_lock_) {
+    if (!klass->IsResolved() || klass->IsArrayClass() || klass->IsProxyClass() ||
+        klass->IsPrimitive() || klass->IsBootStrapClassLoaded()) {
+      return true;
+    }
+    if (app_image_space->HasAddress(klass.Ptr())) {
+      ++image_classes;
+    } else if (DexFileLoader::GetBaseLocation(klass->GetDexFile().GetLocation()) ==
+                   dex_location) {
+      ++new_classes;
+    }
+    return true;
+  });
+  Runtime::Current()->GetClassLinker()->VisitClasses(&visitor);
+  VLOG(image) << "Found " << new_classes << " classes loaded outside of the runtime app image"
+              << " with " << image_classes << " classes for " << dex_location;
+  return new_classes >= kMinNewClassesForRegeneration &&
+         new_classes * 100u >= image_classes * kMinNewClassesPercentageForRegeneration;
+}
+
 bool RuntimeImage::WriteImageToDisk(std::string* error_msg) {
   gc::Heap* heap = Runtime::Current()->GetHeap();
   if (!heap->HasBootImageSpace()) {
@@ -28,6 +28,12 @@ class RuntimeImage {
     // Writes an app image for the currently running process.
   static bool WriteImageToDisk(std::string* error_msg);
 
+  // Returns whether an app image should be written for the primary APK at `dex_location`.
+  // This is the case if no app image was loaded for it, or if the loaded image is a runtime
+  // app image and the app loaded enough classes of the APK that are not in that image, which
+  // means the startup classes changed since the image was written.
+  static bool ShouldWriteImage(const std::string& dex_location);
+
   // Gets the path where a runtime-generated app image is stored.
   //
   // If any of the arguments is a valid glob (a pattern that contains '**' or those documented in
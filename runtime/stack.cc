@@ -46,6 +46,7 @@
 #include "obj_ptr-inl.h"
 #include "quick/quick_method_frame_info.h"
 #include "runtime.h"
+#include "stack_map_cache.h"
 #include "thread.h"
 #include "thread_list.h"
 
@@ -87,7 +88,10 @@ CodeInfo* StackVisitor::GetCurrentInlineInfo() const {
   DCHECK(!(*cur_quick_frame_)->IsNative());
   const OatQuickMethodHeader* header = GetCurrentOatQuickMethodHeader();
   if (cur_inline_info_.first != header) {
-    cur_inline_info_ = std::make_pair(header, CodeInfo::DecodeInlineInfoOnly(header));
+    StackMapCache* cache = GetStackMapCache();
+    cur_inline_info_ = std::make_pair(header,
+                                      cache != nullptr ? cache->GetInlineInfo(header)
+                                                       : CodeInfo::DecodeInlineInfoOnly(header));
   }
   return &cur_inline_info_.second;
 }
@@ -96,13 +100,25 @@ StackMap* StackVisitor::GetCurrentStackMap() const {
   DCHECK(!(*cur_quick_frame_)->IsNative());
   const OatQuickMethodHeader* header = GetCurrentOatQuickMethodHeader();
   if (cur_stack_map_.first != cur_quick_frame_pc_) {
-    uint32_t pc = header->NativeQuickPcOffset(cur_quick_frame_pc_);
-    cur_stack_map_ = std::make_pair(cur_quick_frame_pc_,
-                                    GetCurrentInlineInfo()->GetStackMapForNativePcOffset(pc));
+    StackMapCache* cache = GetStackMapCache();
+    StackMap stack_map;
+    if (cache != nullptr) {
+      stack_map = cache->GetStackMap(header, *GetCurrentInlineInfo(), cur_quick_frame_pc_);
+    } else {
+      uint32_t pc = header->NativeQuickPcOffset(cur_quick_frame_pc_);
+      stack_map = GetCurrentInlineInfo()->GetStackMapForNativePcOffset(pc);
+    }
+    cur_stack_map_ = std::make_pair(cur_quick_frame_pc_, stack_map);
   }
   return &cur_stack_map_.second;
 }
 
+StackMapCache* StackVisitor::GetStackMapCache() const {
+  // The cache belongs to the thread doing the walk, not to the thread being walked.
+  Thread* self = Thread::Current();
+  return (self != nullptr) ? self->GetStackMapCache() : nullptr;
+}
+
 ArtMethod* StackVisitor::GetMethod() const {
   if (cur_shadow_frame_ != nullptr) {
     return cur_shadow_frame_->GetMethod();
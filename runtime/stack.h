@@ -40,6 +40,7 @@ class Context;
 class HandleScope;
 class OatQuickMethodHeader;
 class ShadowFrame;
+class StackMapCache;
 class Thread;
 union JValue;
 
@@ -383,6 +384,7 @@ class StackVisitor {
 
   ALWAYS_INLINE CodeInfo* GetCurrentInlineInfo() const;
   ALWAYS_INLINE StackMap* GetCurrentStackMap() const;
+  StackMapCache* GetStackMapCache() const;
 
   Thread* const thread_;
   const StackWalkKind walk_kind_;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_map_cache.h"
+
+#include "base/casts.h"
+#include "mirror/class.h"
+#include "oat/oat_quick_method_header.h"
+#include "object_callbacks.h"
+
+namespace art HIDDEN {
+
+std::atomic<uint32_t> StackMapCache::global_generation_(0u);
+
+void StackMapCache::MaybeClear() {
+  uint32_t generation = global_generation_.load(std::memory_order_acquire);
+  if (UNLIKELY(generation != generation_)) {
+    code_infos_.fill(CodeInfoEntry{});
+    stack_maps_.fill(StackMapEntry{});
+    catch_handlers_.fill(CatchHandlerEntry{});
+    generation_ = generation;
+  }
+}
+
+const CodeInfo& StackMapCache::GetInlineInfo(const OatQuickMethodHeader* header) {
+  MaybeClear();
+  CodeInfoEntry& entry = code_infos_[IndexOf<kCodeInfoEntries, /*kShift=*/ 4u>(
+      reinterpret_cast<uintptr_t>(header))];
+  if (entry.header != header) {
+    entry.code_info = CodeInfo::DecodeInlineInfoOnly(header);
+    entry.header = header;
+  }
+  return entry.code_info;
+}
+
+StackMap StackMapCache::GetStackMap(const OatQuickMethodHeader* header,
+                                    const CodeInfo& code_info,
+                                    uintptr_t pc) {
+  MaybeClear();
+  DCHECK_NE(pc, 0u);
+  StackMapEntry& entry = stack_maps_[IndexOf<kStackMapEntries, /*kShift=*/ 2u>(pc)];
+  if (entry.pc == pc) {
+    return code_info.GetStackMapAt(entry.row);
+  }
+  StackMap stack_map = code_info.GetStackMapForNativePcOffset(header->NativeQuickPcOffset(pc));
+  if (stack_map.IsValid()) {
+    entry.pc = pc;
+    entry.row = stack_map.Row();
+  }
+  return stack_map;
+}
+
+const StackMapCache::CatchHandler* StackMapCache::FindCatchHandler(
+    uintptr_t pc,
+    size_t inline_depth,
+    ArtMethod* method,
+    uint32_t dex_pc,
+    mirror::Class* exception_class) {
+  MaybeClear();
+  DCHECK(exception_class != nullptr);
+  const CatchHandlerEntry& entry =
+      catch_handlers_[CatchHandlerIndexOf(pc, method, dex_pc, exception_class)];
+  if (entry.exception_class == exception_class &&
+      entry.pc == pc &&
+      entry.method == method &&
+      entry.dex_pc == dex_pc &&
+      entry.inline_depth == inline_depth) {
+    return &entry.handler;
+  }
+  return nullptr;
+}
+
+void StackMapCache::PutCatchHandler(uintptr_t pc,
+                                    size_t inline_depth,
+                                    ArtMethod* method,
+                                    uint32_t dex_pc,
+                                    mirror::Class* exception_class,
+                                    const CatchHandler& handler) {
+  MaybeClear();
+  DCHECK(exception_class != nullptr);
+  CatchHandlerEntry& entry =
+      catch_handlers_[CatchHandlerIndexOf(pc, method, dex_pc, exception_class)];
+  entry.pc = pc;
+  entry.method = method;
+  entry.exception_class = exception_class;
+  entry.dex_pc = dex_pc;
+  entry.inline_depth = dchecked_integral_cast<uint32_t>(inline_depth);
+  entry.handler = handler;
+}
+
+void StackMapCache::SweepCatchHandlers(IsMarkedVisitor* visitor) {
+  for (CatchHandlerEntry& entry : catch_handlers_) {
+    if (entry.exception_class == nullptr) {
+      continue;
+    }
+    mirror::Class* new_class = down_cast<mirror::Class*>(visitor->IsMarked(entry.exception_class));
+    if (new_class != entry.exception_class) {
+      // The entry is indexed by the class address, so a moved entry would need to be moved to
+      // another index which may hold an entry that has not been swept yet. Just drop it.
+      entry = CatchHandlerEntry{};
+    }
+  }
+}
+
+}  // namespace art
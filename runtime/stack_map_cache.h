@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_STACK_MAP_CACHE_H_
+#define ART_RUNTIME_STACK_MAP_CACHE_H_
+
+#include <array>
+#include <atomic>
+
+#include "base/bit_utils.h"
+#include "base/locks.h"
+#include "base/macros.h"
+#include "oat/stack_map.h"
+
+namespace art HIDDEN {
+
+class ArtMethod;
+class IsMarkedVisitor;
+class OatQuickMethodHeader;
+class Thread;
+
+namespace mirror {
+class Class;
+}  // namespace mirror
+
+// Small thread-local cache of decoded `CodeInfo` used by stack walks.
+//
+// Exception delivery and profiling walk the same frames over and over again and decoding
+// the `CodeInfo` and searching for the `StackMap` of each frame dominates the walk. The cache
+// keeps the inline info data decoded by `CodeInfo::DecodeInlineInfoOnly()` keyed by the
+// method header and the stack map row keyed by the native pc. It also keeps the catch handler
+// found for an exception class thrown from a frame, so that code throwing the same exceptions
+// over and over again does not search the try items and the catch stack maps every time.
+//
+// All operations must be done from the owning thread, or at a point when the owning thread
+// is suspended. Entries are keyed by code addresses and `ArtMethod`s, so the cache is
+// invalidated with `InvalidateAll()` whenever compiled code is freed or unmapped (before
+// different code can be placed at the same address), classes are unloaded or redefined.
+// Exception classes are weak, moving GCs drop their entries with `SweepCatchHandlers()`.
+class StackMapCache {
+ public:
+  StackMapCache() : generation_(global_generation_.load(std::memory_order_acquire)) {}
+
+  // Returns the decoded inline info data for `header`, decoding it on a cache miss.
+  const CodeInfo& GetInlineInfo(const OatQuickMethodHeader* header);
+
+  // Returns the stack map at the native `pc` within the code described by `code_info`.
+  // The `code_info` must be the inline info data for the code containing `pc`.
+  StackMap GetStackMap(const OatQuickMethodHeader* header, const CodeInfo& code_info, uintptr_t pc);
+
+  // The catch handler of an exception class thrown from a frame.
+  struct CatchHandler {
+    // The dex pc of the handler or `dex::kDexNoIndex` if the frame does not catch the exception.
+    uint32_t dex_pc = 0u;
+    // Whether the handler does not start with a move-exception instruction.
+    bool clear_exception = false;
+    // The native pc of the handler in compiled code and the row of its catch stack map. Only
+    // recorded for frames of compiled code, see `FindCatchHandler()`.
+    uint32_t stack_map_row = 0u;
+    uintptr_t native_pc = 0u;
+  };
+
+  // Returns the catch handler recorded for `exception_class` thrown at `dex_pc` of `method`, or
+  // null if there is none. Frames of compiled code are identified by their native `pc` and the
+  // `inline_depth` of the method in the frame; the `pc` is 0 for other frames.
+  const CatchHandler* FindCatchHandler(uintptr_t pc,
+                                       size_t inline_depth,
+                                       ArtMethod* method,
+                                       uint32_t dex_pc,
+                                       mirror::Class* exception_class);
+
+  // Records the catch handler of `exception_class` thrown at `dex_pc` of `method`.
+  void PutCatchHandler(uintptr_t pc,
+                       size_t inline_depth,
+                       ArtMethod* method,
+                       uint32_t dex_pc,
+                       mirror::Class* exception_class,
+                       const CatchHandler& handler);
+
+  // Drop the catch handlers of exception classes that the GC has moved or found unmarked.
+  void SweepCatchHandlers(IsMarkedVisitor* visitor) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Invalidate the caches of all threads. The caches of other threads shall be cleared
+  // lazily when they are next used.
+  static void InvalidateAll() {
+    global_generation_.fetch_add(1u, std::memory_order_release);
+  }
+
+ private:
+  static constexpr size_t kCodeInfoEntries = 8;
+  static constexpr size_t kStackMapEntries = 64;
+  static constexpr size_t kCatchHandlerEntries = 32;
+
+  struct CodeInfoEntry {
+    const OatQuickMethodHeader* header = nullptr;
+    CodeInfo code_info;
+  };
+
+  struct StackMapEntry {
+    uintptr_t pc = 0u;
+    uint32_t row = 0u;
+  };
+
+  struct CatchHandlerEntry {
+    uintptr_t pc = 0u;
+    ArtMethod* method = nullptr;
+    mirror::Class* exception_class = nullptr;
+    uint32_t dex_pc = 0u;
+    uint32_t inline_depth = 0u;
+    CatchHandler handler;
+  };
+
+  static ALWAYS_INLINE size_t CatchHandlerIndexOf(uintptr_t pc,
+                                                  ArtMethod* method,
+                                                  uint32_t dex_pc,
+                                                  mirror::Class* exception_class) {
+    uintptr_t key = pc ^ reinterpret_cast<uintptr_t>(method) ^ dex_pc ^
+                    (reinterpret_cast<uintptr_t>(exception_class) >> 3);
+    return IndexOf<kCatchHandlerEntries, /*kShift=*/ 2u>(key ^ (key >> 7));
+  }
+
+  // Drop `kShift` low bits of the key which are mostly the same due to code alignment.
+  template <size_t kSize, size_t kShift>
+  static ALWAYS_INLINE size_t IndexOf(uintptr_t key) {
+    static_assert(IsPowerOfTwo(kSize), "Size must be power of two");
+    return (key >> kShift) & (kSize - 1u);
+  }
+
+  // Clear all entries if any code has been freed since the cache was last used.
+  void MaybeClear();
+
+  std::array<CodeInfoEntry, kCodeInfoEntries> code_infos_;
+  std::array<StackMapEntry, kStackMapEntries> stack_maps_;
+  std::array<CatchHandlerEntry, kCatchHandlerEntries> catch_handlers_;
+  uint32_t generation_;
+
+  EXPORT static std::atomic<uint32_t> global_generation_;
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_STACK_MAP_CACHE_H_
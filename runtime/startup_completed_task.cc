@@ -47,9 +47,9 @@ class UnlinkStartupDexCacheVisitor : public DexCacheVisitor {
 void StartupCompletedTask::Run(Thread* self) {
   Runtime* const runtime = Runtime::Current();
   if (runtime->NotifyStartupCompleted()) {
-    // Maybe generate a runtime app image. If the runtime is debuggable, boot
-    // classpath classes can be dynamically changed, so don't bother generating an
-    // image.
+    // Maybe generate a runtime app image, or regenerate it if the startup classes
+    // changed. If the runtime is debuggable, boot classpath classes can be
+    // dynamically changed, so don't bother generating an image.
     if (!runtime->IsJavaDebuggable()) {
       std::string compiler_filter;
       std::string compilation_reason;
@@ -58,7 +58,7 @@ void StartupCompletedTask::Run(Thread* self) {
       CompilerFilter::Filter filter;
       if (CompilerFilter::ParseCompilerFilter(compiler_filter.c_str(), &filter) &&
           !CompilerFilter::IsAotCompilationEnabled(filter) &&
-          !runtime->GetHeap()->HasAppImageSpaceFor(primary_apk_path)) {
+          RuntimeImage::ShouldWriteImage(primary_apk_path)) {
         std::string error_msg;
         if (!RuntimeImage::WriteImageToDisk(&error_msg)) {
           LOG(DEBUG) << "Could not write temporary image to disk " << error_msg;
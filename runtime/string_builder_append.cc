@@ -16,6 +16,8 @@
 
 #include "string_builder_append.h"
 
+#include <cmath>
+
 #include "base/casts.h"
 #include "base/logging.h"
 #include "common_throws.h"
@@ -82,6 +84,8 @@ class StringBuilderAppend::Builder {
                                CharType* data,
                                int64_t value) REQUIRES_SHARED(Locks::mutator_lock_);
 
+  static size_t TryConvertFpArgFast(double value, uint8_t* out);
+
   int32_t ConvertFpArgs() REQUIRES_SHARED(Locks::mutator_lock_);
 
   template <typename CharType>
@@ -234,6 +238,49 @@ inline CharType* StringBuilderAppend::Builder::AppendInt64(ObjPtr<mirror::String
   return data + length;
 }
 
+// Converts the values whose representation does not need the shortest decimal search without
+// calling FloatingDecimal: NaN, infinities, zeros and integral values in the range where
+// Double.toString() and Float.toString() use the plain notation with a ".0" fraction.
+// Returns the length of the result or 0 if the value needs the full conversion.
+size_t StringBuilderAppend::Builder::TryConvertFpArgFast(double value, uint8_t* out) {
+  static constexpr char kNaN[] = "NaN";
+  static constexpr char kInfinity[] = "-Infinity";
+  auto copy = [out](const char* str, size_t length) {
+    std::copy_n(str, length, out);
+    return length;
+  };
+  if (std::isnan(value)) {
+    return copy(kNaN, sizeof(kNaN) - 1u);
+  }
+  if (std::isinf(value)) {
+    return (value < 0) ? copy(kInfinity, sizeof(kInfinity) - 1u)
+                       : copy(kInfinity + 1, sizeof(kInfinity) - 2u);
+  }
+  // Both float and double values of magnitude below 10^7 use the plain notation and all
+  // integers in this range are exactly representable in a float.
+  static constexpr double kMaxPlainIntegral = 1e7;
+  if (!(std::fabs(value) < kMaxPlainIntegral) || value != std::trunc(value)) {
+    return 0u;
+  }
+  uint8_t* data = out;
+  if (std::signbit(value)) {
+    *data = '-';
+    ++data;
+  }
+  uint64_t v = static_cast<uint64_t>(std::fabs(value));
+  size_t length = Uint64Length(v);
+  for (size_t i = length; i != 0u; --i) {
+    data[i - 1u] = '0' + static_cast<char>(v % UINT64_C(10));
+    v /= UINT64_C(10);
+  }
+  data += length;
+  data[0] = '.';
+  data[1] = '0';
+  data += 2u;
+  DCHECK_LE(static_cast<size_t>(data - out), kBinaryToASCIIBufferSize);
+  return data - out;
+}
+
 int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
   int32_t fp_args_length = 0u;
   const uint32_t* current_arg = args_;
@@ -241,6 +288,7 @@ int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
   for (uint32_t f = format_; f != 0u; f >>= kBitsPerArg) {
     DCHECK_LE(f & kArgMask, static_cast<uint32_t>(Argument::kLast));
     bool fp_arg = false;
+    size_t fast_length = 0u;
     ObjPtr<mirror::Object> converter;
     switch (static_cast<Argument>(f & kArgMask)) {
       case Argument::kString:
@@ -256,8 +304,12 @@ int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
       case Argument::kFloat: {
         fp_arg = true;
         float arg = bit_cast<float>(*current_arg);
-        converter = WellKnownClasses::jdk_internal_math_FloatingDecimal_getBinaryToASCIIConverter_F
-            ->InvokeStatic<'L', 'F'>(hs_.Self(), arg);
+        fast_length = TryConvertFpArgFast(arg, converted_fp_args_[fp_arg_index]);
+        if (fast_length == 0u) {
+          converter =
+              WellKnownClasses::jdk_internal_math_FloatingDecimal_getBinaryToASCIIConverter_F
+                  ->InvokeStatic<'L', 'F'>(hs_.Self(), arg);
+        }
         break;
       }
       case Argument::kDouble: {
@@ -265,8 +317,12 @@ int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
         current_arg = AlignUp(current_arg, sizeof(int64_t));
         double arg = bit_cast<double>(
             static_cast<uint64_t>(current_arg[0]) + (static_cast<uint64_t>(current_arg[1]) << 32));
-        converter = WellKnownClasses::jdk_internal_math_FloatingDecimal_getBinaryToASCIIConverter_D
-            ->InvokeStatic<'L', 'D'>(hs_.Self(), arg);
+        fast_length = TryConvertFpArgFast(arg, converted_fp_args_[fp_arg_index]);
+        if (fast_length == 0u) {
+          converter =
+              WellKnownClasses::jdk_internal_math_FloatingDecimal_getBinaryToASCIIConverter_D
+                  ->InvokeStatic<'L', 'D'>(hs_.Self(), arg);
+        }
         ++current_arg;  // Skip the low word, let the common code skip the high word.
         break;
       }
@@ -281,7 +337,11 @@ int32_t StringBuilderAppend::Builder::ConvertFpArgs() {
             << (f & kArgMask) << " full format: 0x" << std::hex << format_;
         UNREACHABLE();
     }
-    if (fp_arg) {
+    if (fp_arg && fast_length != 0u) {
+      converted_fp_arg_lengths_[fp_arg_index] = dchecked_integral_cast<int32_t>(fast_length);
+      fp_args_length += fast_length;
+      ++fp_arg_index;
+    } else if (fp_arg) {
       // If we see an exception (presumably OOME or SOE), keep it as is, even
       // though it may be confusing to see the stack trace for FP argument
       // conversion continue at the StringBuilder.toString() invoke location.
@@ -433,6 +433,14 @@ inline mirror::Object* Thread::AllocTlab(size_t bytes) {
   return ret;
 }
 
+inline uint8_t* Thread::AllocTlabObjects(size_t bytes, size_t num_objects) {
+  DCHECK_GE(TlabSize(), bytes);
+  tlsPtr_.thread_local_objects += num_objects;
+  uint8_t* ret = tlsPtr_.thread_local_pos;
+  tlsPtr_.thread_local_pos += bytes;
+  return ret;
+}
+
 inline bool Thread::PushOnThreadLocalAllocationStack(mirror::Object* obj) {
   DCHECK_LE(tlsPtr_.thread_local_alloc_stack_top, tlsPtr_.thread_local_alloc_stack_end);
   if (tlsPtr_.thread_local_alloc_stack_top < tlsPtr_.thread_local_alloc_stack_end) {
@@ -481,6 +489,7 @@ inline void Thread::SetThreadLocalAllocationStack(StackReference<mirror::Object>
   DCHECK_LT(start, end);
   tlsPtr_.thread_local_alloc_stack_end = end;
   tlsPtr_.thread_local_alloc_stack_top = start;
+  tls32_.thread_local_alloc_stack_slots = dchecked_integral_cast<uint32_t>(end - start);
 }
 
 inline void Thread::RevokeThreadLocalAllocationStack() {
@@ -492,6 +501,7 @@ inline void Thread::RevokeThreadLocalAllocationStack() {
   }
   tlsPtr_.thread_local_alloc_stack_end = nullptr;
   tlsPtr_.thread_local_alloc_stack_top = nullptr;
+  tls32_.thread_local_alloc_stack_slots = 0;
 }
 
 inline void Thread::PoisonObjectPointersIfDebug() {
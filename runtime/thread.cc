@@ -86,6 +86,7 @@
 #include "mirror/stack_trace_element.h"
 #include "monitor.h"
 #include "monitor_objects_stack_visitor.h"
+#include "monitor_pool.h"
 #include "native_stack_dump.h"
 #include "nativehelper/scoped_local_ref.h"
 #include "nativehelper/scoped_utf_chars.h"
@@ -107,9 +108,12 @@
 #include "scoped_thread_state_change-inl.h"
 #include "scoped_disable_public_sdk_checker.h"
 #include "stack.h"
+#include "stack_map_cache.h"
 #include "thread-inl.h"
 #include "thread_list.h"
+#include "thread_stack_pool.h"
 #include "trace.h"
+#include "trace_profile.h"
 #include "verify_object.h"
 #include "well_known_classes-inl.h"
 
@@ -182,10 +186,20 @@ void Thread::InitTlsEntryPoints() {
     AtomicSetFlag(ThreadFlag::kMonitorJniEntryExit);
   }
   InitEntryPoints(&tlsPtr_.jni_entrypoints, &tlsPtr_.quick_entrypoints, monitor_jni_entry_exit);
+  UpdateInstrumentedAllocationFlag();
 }
 
 void Thread::ResetQuickAllocEntryPointsForThread() {
   ResetQuickAllocEntryPoints(&tlsPtr_.quick_entrypoints);
+  UpdateInstrumentedAllocationFlag();
+}
+
+void Thread::UpdateInstrumentedAllocationFlag() {
+  if (AreQuickAllocEntryPointsInstrumented()) {
+    AtomicSetFlag(ThreadFlag::kInstrumentedAllocation);
+  } else if (ReadFlag(ThreadFlag::kInstrumentedAllocation)) {
+    AtomicClearFlag(ThreadFlag::kInstrumentedAllocation);
+  }
 }
 
 class DeoptimizationContextRecord {
@@ -664,6 +678,11 @@ void* Thread::CreateCallback(void* arg) {
     ObjPtr<mirror::Object> receiver = self->tlsPtr_.opeer;
     WellKnownClasses::java_lang_Thread_run->InvokeVirtual<'V'>(self, receiver);
   }
+  // Give back a pooled stack. It is reused only after this thread has exited.
+  ThreadStackPool* stack_pool = Runtime::Current()->GetThreadStackPool();
+  if (stack_pool != nullptr) {
+    stack_pool->Release(&stack_pool, self->GetTid());
+  }
   // Detach and delete self.
   Runtime::Current()->GetThreadList()->Unregister(self, /* should_run_callbacks= */ true);
 
@@ -908,7 +927,14 @@ void Thread::CreateNativeThread(JNIEnv* env, jobject java_peer, size_t stack_siz
     CHECK_PTHREAD_CALL(pthread_attr_init, (&attr), "new thread");
     CHECK_PTHREAD_CALL(pthread_attr_setdetachstate, (&attr, PTHREAD_CREATE_DETACHED),
                        "PTHREAD_CREATE_DETACHED");
-    CHECK_PTHREAD_CALL(pthread_attr_setstacksize, (&attr, stack_size), stack_size);
+    // Reuse the stack of an exited thread if the stack pool is enabled.
+    ThreadStackPool* stack_pool = runtime->GetThreadStackPool();
+    uint8_t* pooled_stack = nullptr;
+    if (stack_pool != nullptr && stack_pool->Acquire(stack_size, &pooled_stack)) {
+      CHECK_PTHREAD_CALL(pthread_attr_setstack, (&attr, pooled_stack, stack_size), stack_size);
+    } else {
+      CHECK_PTHREAD_CALL(pthread_attr_setstacksize, (&attr, stack_size), stack_size);
+    }
     pthread_create_result = pthread_create(&new_pthread,
                                            &attr,
                                            gUseUserfaultfd ? Thread::CreateCallbackWithUffdGc
@@ -924,6 +950,9 @@ void Thread::CreateNativeThread(JNIEnv* env, jobject java_peer, size_t stack_siz
       child_jni_env_ext.release();  // NOLINT pthreads API.
       return;
     }
+    if (pooled_stack != nullptr) {
+      stack_pool->Cancel(pooled_stack);
+    }
   }
 
   // Either JNIEnvExt::Create or pthread_create(3) failed, so clean up.
@@ -1033,6 +1062,7 @@ Thread* Thread::Attach(const char* thread_name,
   }
 
   self->InitStringEntryPoints();
+  TraceProfiler::AllocateThreadBuffer(self);
 
   CHECK_NE(self->GetState(), ThreadState::kRunnable);
   self->SetState(ThreadState::kNative);
@@ -1437,6 +1467,17 @@ Thread::DumpOrder Thread::Dump(std::ostream& os,
   return DumpStack(os, unwinder, dump_native_stack, force_dump_stack);
 }
 
+Thread::DumpOrder Thread::DumpDeferringNativeStack(std::ostream& os,
+                                                   std::ostream& stack_os,
+                                                   bool* dump_native_stack) const {
+  DumpState(os);
+  return DumpStackImpl(stack_os,
+                       /*unwinder=*/ nullptr,
+                       /*dump_native_stack=*/ true,
+                       /*force_dump_stack=*/ false,
+                       dump_native_stack);
+}
+
 ObjPtr<mirror::String> Thread::GetThreadName() const {
   if (tlsPtr_.opeer == nullptr) {
     return nullptr;
@@ -2118,6 +2159,8 @@ void Thread::DumpState(std::ostream& os, const Thread* thread, pid_t tid) {
     os << "  | stack=" << reinterpret_cast<void*>(thread->tlsPtr_.stack_begin) << "-"
         << reinterpret_cast<void*>(thread->tlsPtr_.stack_end) << " stackSize="
         << PrettySize(thread->tlsPtr_.stack_size) << "\n";
+    os << "  | interpreter cache misses=" << thread->interpreter_cache_.GetMisses()
+       << " second way hits=" << thread->interpreter_cache_.GetSecondWayHits() << "\n";
     // Dump the held mutexes.
     os << "  | held mutexes=";
     for (size_t i = 0; i < kLockLevelCount; ++i) {
@@ -2363,6 +2406,22 @@ Thread::DumpOrder Thread::DumpStack(std::ostream& os,
                                     unwindstack::AndroidLocalUnwinder& unwinder,
                                     bool dump_native_stack,
                                     bool force_dump_stack) const {
+  return DumpStackImpl(os,
+                       &unwinder,
+                       dump_native_stack,
+                       force_dump_stack,
+                       /*native_stack_deferred=*/ nullptr);
+}
+
+Thread::DumpOrder Thread::DumpStackImpl(std::ostream& os,
+                                        unwindstack::AndroidLocalUnwinder* unwinder,
+                                        bool dump_native_stack,
+                                        bool force_dump_stack,
+                                        bool* native_stack_deferred) const {
+  DCHECK_EQ(unwinder == nullptr, native_stack_deferred != nullptr);
+  if (native_stack_deferred != nullptr) {
+    *native_stack_deferred = false;
+  }
   // TODO: we call this code when dying but may not have suspended the thread ourself. The
   //       IsSuspended check is therefore racy with the use for dumping (normally we inhibit
   //       the race with the thread_suspend_count_lock_).
@@ -2378,11 +2437,15 @@ Thread::DumpOrder Thread::DumpStack(std::ostream& os,
     uint64_t nanotime = NanoTime();
     // If we're currently in native code, dump that stack before dumping the managed stack.
     if (dump_native_stack && (dump_for_abort || force_dump_stack || ShouldShowNativeStack(this))) {
-      ArtMethod* method =
-          GetCurrentMethod(nullptr,
-                           /*check_suspended=*/ !force_dump_stack,
-                           /*abort_on_error=*/ !(dump_for_abort || force_dump_stack));
-      DumpNativeStack(os, unwinder, GetTid(), "  native: ", method);
+      if (unwinder == nullptr) {
+        *native_stack_deferred = true;
+      } else {
+        ArtMethod* method =
+            GetCurrentMethod(nullptr,
+                             /*check_suspended=*/ !force_dump_stack,
+                             /*abort_on_error=*/ !(dump_for_abort || force_dump_stack));
+        DumpNativeStack(os, *unwinder, GetTid(), "  native: ", method);
+      }
     }
     dump_order = DumpJavaStack(os,
                                /*check_suspended=*/ !force_dump_stack,
@@ -2654,6 +2717,7 @@ void Thread::Destroy(bool should_run_callbacks) {
   {
     ScopedObjectAccess soa(self);
     Runtime::Current()->GetHeap()->RevokeThreadLocalBuffers(this);
+    MonitorPool::RevokeThreadLocalCache(this);
 
     if (UNLIKELY(self->GetMethodTraceBuffer() != nullptr)) {
       Trace::FlushThreadBuffer(self);
@@ -2912,15 +2976,18 @@ void Thread::SetClassLoaderOverride(jobject class_loader_override) {
 using ArtMethodDexPcPair = std::pair<ArtMethod*, uint32_t>;
 
 // Counts the stack trace depth and also fetches the first max_saved_frames frames.
+// If max_depth is not 0, the walk stops after counting max_depth frames.
 class FetchStackTraceVisitor : public StackVisitor {
  public:
   explicit FetchStackTraceVisitor(Thread* thread,
                                   ArtMethodDexPcPair* saved_frames = nullptr,
-                                  size_t max_saved_frames = 0)
+                                  size_t max_saved_frames = 0,
+                                  size_t max_depth = 0)
       REQUIRES_SHARED(Locks::mutator_lock_)
       : StackVisitor(thread, nullptr, StackVisitor::StackWalkKind::kIncludeInlinedFrames),
         saved_frames_(saved_frames),
-        max_saved_frames_(max_saved_frames) {}
+        max_saved_frames_(max_saved_frames),
+        max_depth_(max_depth) {}
 
   bool VisitFrame() override REQUIRES_SHARED(Locks::mutator_lock_) {
     // We want to skip frames up to and including the exception's constructor.
@@ -2938,6 +3005,9 @@ class FetchStackTraceVisitor : public StackVisitor {
           saved_frames_[depth_].second = m->IsProxyMethod() ? dex::kDexNoIndex : GetDexPc();
         }
         ++depth_;
+        if (depth_ == max_depth_) {
+          return false;  // End stack walk, the outer frames are not recorded.
+        }
       }
     } else {
       ++skip_depth_;
@@ -2959,6 +3029,7 @@ class FetchStackTraceVisitor : public StackVisitor {
   bool skipping_ = true;
   ArtMethodDexPcPair* saved_frames_;
   const size_t max_saved_frames_;
+  const size_t max_depth_;
 
   DISALLOW_COPY_AND_ASSIGN(FetchStackTraceVisitor);
 };
@@ -3000,6 +3071,7 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
     }
     trace->Set</*kTransactionActive=*/ false, /*kCheckTransaction=*/ false>(0, methods_and_pcs);
     trace_ = trace.Get();
+    depth_ = depth;
     // If We are called from native, use non-transactional mode.
     CHECK(last_no_suspend_cause == nullptr) << last_no_suspend_cause;
     return true;
@@ -3022,7 +3094,7 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
       return true;  // Ignore runtime frames (in particular callee save).
     }
     AddFrame(m, m->IsProxyMethod() ? dex::kDexNoIndex : GetDexPc());
-    return true;
+    return count_ != depth_;  // End stack walk once the trace is full.
   }
 
   void AddFrame(ArtMethod* method, uint32_t dex_pc) REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -3062,6 +3134,8 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
   uint32_t skip_depth_;
   // Current position down stack trace.
   uint32_t count_ = 0;
+  // Number of frames in the trace.
+  uint32_t depth_ = 0;
   // An object array where the first element is a pointer array that contains the `ArtMethod`
   // pointers on the stack and dex PCs. The rest of the elements are referencing objects
   // that shall keep the methods alive, namely the declaring class of the `ArtMethod` for
@@ -3078,13 +3152,17 @@ class BuildInternalStackTraceVisitor : public StackVisitor {
 };
 
 ObjPtr<mirror::ObjectArray<mirror::Object>> Thread::CreateInternalStackTrace(
-    const ScopedObjectAccessAlreadyRunnable& soa) const {
+    const ScopedObjectAccessAlreadyRunnable& soa, size_t max_depth) const {
   // Compute depth of stack, save frames if possible to avoid needing to recompute many.
+  // The walk stops at `max_depth`, so limited traces do not need to visit the outer frames.
   constexpr size_t kMaxSavedFrames = 256;
-  std::unique_ptr<ArtMethodDexPcPair[]> saved_frames(new ArtMethodDexPcPair[kMaxSavedFrames]);
+  const size_t num_saved_frames =
+      (max_depth != 0u) ? std::min(max_depth, kMaxSavedFrames) : kMaxSavedFrames;
+  std::unique_ptr<ArtMethodDexPcPair[]> saved_frames(new ArtMethodDexPcPair[num_saved_frames]);
   FetchStackTraceVisitor count_visitor(const_cast<Thread*>(this),
                                        &saved_frames[0],
-                                       kMaxSavedFrames);
+                                       num_saved_frames,
+                                       max_depth);
   count_visitor.WalkStack();
   const uint32_t depth = count_visitor.GetDepth();
   const uint32_t skip_depth = count_visitor.GetSkipDepth();
@@ -3097,7 +3175,7 @@ ObjPtr<mirror::ObjectArray<mirror::Object>> Thread::CreateInternalStackTrace(
   }
   // If we saved all of the frames we don't even need to do the actual stack walk. This is faster
   // than doing the stack walk twice.
-  if (depth < kMaxSavedFrames) {
+  if (depth <= num_saved_frames) {
     for (size_t i = 0; i < depth; ++i) {
       build_trace_visitor.AddFrame(saved_frames[i].first, saved_frames[i].second);
     }
@@ -4589,6 +4667,10 @@ void Thread::SweepInterpreterCache(IsMarkedVisitor* visitor) {
   for (InterpreterCache::Entry& entry : GetInterpreterCache()->GetArray()) {
     SweepCacheEntry(visitor, reinterpret_cast<const Instruction*>(entry.first), &entry.second);
   }
+  // The catch handlers cached for exception delivery are swept along with the interpreter cache.
+  if (stack_map_cache_ != nullptr) {
+    stack_map_cache_->SweepCatchHandlers(visitor);
+  }
 }
 
 // FIXME: clang-r433403 reports the below function exceeds frame size limit.
@@ -4839,6 +4921,14 @@ void Thread::SetReadBarrierEntrypoints() {
   UpdateReadBarrierEntrypoints(&tlsPtr_.quick_entrypoints, /* is_active=*/ true);
 }
 
+StackMapCache* Thread::GetStackMapCache() {
+  DCHECK_EQ(this, Thread::Current());
+  if (UNLIKELY(stack_map_cache_ == nullptr)) {
+    stack_map_cache_.reset(new StackMapCache());
+  }
+  return stack_map_cache_.get();
+}
+
 void Thread::ClearAllInterpreterCaches() {
   static struct ClearInterpreterCacheClosure : Closure {
     void Run(Thread* thread) override {
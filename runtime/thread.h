@@ -101,6 +101,7 @@ class Monitor;
 class RootVisitor;
 class ScopedObjectAccessAlreadyRunnable;
 class ShadowFrame;
+class StackMapCache;
 class StackedShadowFrameRecord;
 class Thread;
 class ThreadList;
@@ -168,8 +169,12 @@ enum class ThreadFlag : uint32_t {
   // inlined code, but take a slow path for monitoring method entry and exit events.
   kMonitorJniEntryExit = 1u << 7,
 
+  // Request that compiled code does not bump the TLAB inline for new-instance, but calls the
+  // allocation entrypoints which are instrumented. Set and cleared with the entrypoints.
+  kInstrumentedAllocation = 1u << 8,
+
   // Indicates the last flag. Used for checking that the flags do not overlap thread state.
-  kLastFlag = kMonitorJniEntryExit
+  kLastFlag = kInstrumentedAllocation
 };
 
 enum class StackedShadowFrameType {
@@ -336,6 +341,13 @@ class EXPORT Thread {
                  bool dump_native_stack = true,
                  bool force_dump_stack = false) const
       REQUIRES_SHARED(Locks::mutator_lock_);
+  // Like Dump() but dumps the thread state to `os` and the managed stack to `stack_os`, and
+  // instead of unwinding the native stack, sets `*dump_native_stack` to whether the caller
+  // should dump it between the two.
+  DumpOrder DumpDeferringNativeStack(std::ostream& os,
+                                     std::ostream& stack_os,
+                                     bool* dump_native_stack) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
 
   DumpOrder DumpJavaStack(std::ostream& os,
                           bool check_suspended = true,
@@ -862,9 +874,10 @@ class EXPORT Thread {
   void SetClassLoaderOverride(jobject class_loader_override);
 
   // Create the internal representation of a stack trace, that is more time
-  // and space efficient to compute than the StackTraceElement[].
+  // and space efficient to compute than the StackTraceElement[]. If `max_depth`
+  // is not 0, only the `max_depth` innermost frames are recorded.
   ObjPtr<mirror::ObjectArray<mirror::Object>> CreateInternalStackTrace(
-      const ScopedObjectAccessAlreadyRunnable& soa) const
+      const ScopedObjectAccessAlreadyRunnable& soa, size_t max_depth = 0u) const
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Convert an internal stack trace representation (returned by CreateInternalStackTrace) to a
@@ -1445,6 +1458,9 @@ class EXPORT Thread {
 
   // Doesn't check that there is room.
   mirror::Object* AllocTlab(size_t bytes);
+  // Reserves `bytes` for `num_objects` objects laid out back to back in a single bump.
+  // Doesn't check that there is room.
+  uint8_t* AllocTlabObjects(size_t bytes, size_t num_objects);
   void SetTlab(uint8_t* start, uint8_t* end, uint8_t* limit);
   bool HasTlab() const;
   void ResetTlab();
@@ -1483,6 +1499,11 @@ class EXPORT Thread {
   // Resets the thread local allocation pointers.
   void RevokeThreadLocalAllocationStack();
 
+  // Size in slots of the last thread-local allocation stack chunk set since the last revoke.
+  size_t GetThreadLocalAllocationStackSlots() const {
+    return tls32_.thread_local_alloc_stack_slots;
+  }
+
   size_t GetThreadLocalBytesAllocated() const {
     return tlsPtr_.thread_local_end - tlsPtr_.thread_local_start;
   }
@@ -1587,6 +1608,10 @@ class EXPORT Thread {
     return &interpreter_cache_;
   }
 
+  // Get the thread-local cache of decoded stack maps, creating it on first use.
+  // Must be called only by the owning thread.
+  StackMapCache* GetStackMapCache();
+
   // Clear all thread-local interpreter caches.
   //
   // Since the caches are keyed by memory pointer to dex instructions, this must be
@@ -1733,6 +1758,14 @@ class EXPORT Thread {
                       bool dump_native_stack = true,
                       bool force_dump_stack = false) const
       REQUIRES_SHARED(Locks::mutator_lock_);
+  // If `unwinder` is null, the native stack is not dumped and `*native_stack_deferred` is set to
+  // whether it should have been.
+  DumpOrder DumpStackImpl(std::ostream& os,
+                          unwindstack::AndroidLocalUnwinder* unwinder,
+                          bool dump_native_stack,
+                          bool force_dump_stack,
+                          bool* native_stack_deferred) const
+      REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Out-of-line conveniences for debugging in gdb.
   static Thread* CurrentFromGdb();  // Like Thread::Current.
@@ -1760,6 +1793,8 @@ class EXPORT Thread {
   void InitCpu();
   void CleanupCpu();
   void InitTlsEntryPoints();
+  // Sets or clears ThreadFlag::kInstrumentedAllocation to match the allocation entrypoints.
+  void UpdateInstrumentedAllocationFlag();
   void InitTid();
   void InitPthreadKeySelf();
   bool InitStackHwm();
@@ -2004,7 +2039,8 @@ class EXPORT Thread {
           make_visibly_initialized_counter(0),
           define_class_counter(0),
           num_name_readers(0),
-          shared_method_hotness(kSharedMethodHotnessThreshold) {}
+          shared_method_hotness(kSharedMethodHotnessThreshold),
+          thread_local_alloc_stack_slots(0) {}
 
     // The state and flags field must be changed atomically so that flag values aren't lost.
     // See `StateAndFlags` for bit assignments of `ThreadFlag` and `ThreadState` values.
@@ -2107,6 +2143,12 @@ class EXPORT Thread {
     // There is a second level counter in `Jit::shared_method_counters_` to make
     // sure we at least have a few samples before compiling a method.
     uint32_t shared_method_hotness;
+
+    // Number of slots in the current thread-local allocation stack chunk, or 0 if the thread
+    // has not taken a chunk since the allocation stacks were last revoked. Used to hand out
+    // bigger chunks to threads that keep refilling, see
+    // Heap::PushOnThreadLocalAllocationStackWithInternalGC.
+    uint32_t thread_local_alloc_stack_slots;
   } tls32_;
 
   struct alignas(8) tls_64bit_sized_values {
@@ -2375,6 +2417,13 @@ class EXPORT Thread {
   // Note that it is not in the packed struct, may not be accessed for cross compilation.
   uintptr_t poison_object_cookie_ = 0;
 
+  // Lazily allocated cache of decoded stack maps used by stack walks of this thread.
+  std::unique_ptr<StackMapCache> stack_map_cache_;
+
+  // Free monitors cached for this thread by the MonitorPool, linked through their free list.
+  Monitor* monitor_cache_ = nullptr;
+  size_t monitor_cache_size_ = 0u;
+
   // Pending extra checkpoints if checkpoint_function_ is already used.
   std::list<Closure*> checkpoint_overflow_ GUARDED_BY(Locks::thread_suspend_count_lock_);
 
@@ -2398,6 +2447,7 @@ class EXPORT Thread {
   uint32_t core_platform_api_cookie_ = 0;
 
   friend class gc::collector::SemiSpace;  // For getting stack traces.
+  friend class MonitorPool;  // For the monitor cache.
   friend class Runtime;  // For CreatePeer.
   friend class QuickExceptionHandler;  // For dumping the stack.
   friend class ScopedAssertNoTransactionChecks;
@@ -23,11 +23,14 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <tuple>
 #include <vector>
 
+#include "android-base/file.h"
 #include "android-base/stringprintf.h"
 #include "art_field-inl.h"
 #include "base/aborting.h"
@@ -50,6 +53,7 @@
 #include "obj_ptr-inl.h"
 #include "scoped_thread_state_change-inl.h"
 #include "thread.h"
+#include "thread_pool.h"
 #include "trace.h"
 #include "unwindstack/AndroidUnwinder.h"
 #include "well_known_classes.h"
@@ -65,6 +69,17 @@ using android::base::StringPrintf;
 
 static constexpr uint64_t kLongThreadSuspendThreshold = MsToNs(5);
 
+// If SuspendAll has not reached a safepoint within this time, the threads that have not yet
+// suspended are reported as stragglers.
+static constexpr uint64_t kSuspendAllStragglerThreshold = kLongThreadSuspendThreshold;
+
+// Maximum number of stragglers reported for a single SuspendAll.
+static constexpr size_t kMaxReportedStragglers = 4u;
+
+// Minimum number of suspended threads per checkpoint thread pool task. Running the checkpoint
+// for a few threads is cheaper than waking up a worker.
+static constexpr size_t kMinCheckpointsPerTask = 4u;
+
 // Whether we should try to dump the native stack of unattached threads. See commit ed8b723 for
 // some history.
 static constexpr bool kDumpUnattachedThreadNativeStackForSigQuit = true;
@@ -76,7 +91,8 @@ ThreadList::ThreadList(uint64_t thread_suspend_timeout_ns)
       long_suspend_(false),
       shut_down_(false),
       thread_suspend_timeout_ns_(thread_suspend_timeout_ns),
-      empty_checkpoint_barrier_(new Barrier(0)) {
+      empty_checkpoint_barrier_(new Barrier(0)),
+      checkpoint_thread_pool_users_(0u) {
   CHECK(Monitor::IsValidLockWord(LockWord::FromThinLockId(kMaxThreadId, 1, 0U)));
 }
 
@@ -187,14 +203,17 @@ static constexpr uint32_t kDumpWaitTimeout = kIsTargetBuild ? 100000 : 20000;
 // A closure used by Thread::Dump.
 class DumpCheckpoint final : public Closure {
  public:
-  DumpCheckpoint(bool dump_native_stack)
+  // If `native_stack_threads` is not 0, the native stacks are not unwound by the checkpoint but
+  // by `native_stack_threads` threads in DumpNativeStacks(), without symbolization.
+  DumpCheckpoint(bool dump_native_stack, size_t native_stack_threads = 0u)
       : lock_("Dump checkpoint lock", kGenericBottomLock),
         os_(),
         // Avoid verifying count in case a thread doesn't end up passing through the barrier.
         // This avoids a SIGABRT that would otherwise happen in the destructor.
         barrier_(0, /*verify_count_on_shutdown=*/false),
         unwinder_(std::vector<std::string>{}, std::vector<std::string> {"oat", "odex"}),
-        dump_native_stack_(dump_native_stack) {
+        dump_native_stack_(dump_native_stack),
+        native_stack_threads_(dump_native_stack ? native_stack_threads : 0u) {
   }
 
   void Run(Thread* thread) override {
@@ -202,23 +221,60 @@ class DumpCheckpoint final : public Closure {
     // request.
     Thread* self = Thread::Current();
     CHECK(self != nullptr);
-    std::ostringstream local_os;
+    ThreadDump dump;
     Locks::mutator_lock_->AssertSharedHeld(self);
-    Thread::DumpOrder dump_order = thread->Dump(local_os, unwinder_, dump_native_stack_);
+    Thread::DumpOrder dump_order;
+    if (native_stack_threads_ != 0u) {
+      bool dump_native_stack = false;
+      dump_order = thread->DumpDeferringNativeStack(dump.os, dump.stack_os, &dump_native_stack);
+      if (dump_native_stack) {
+        dump.native_stack_tid = thread->GetTid();
+      }
+    } else {
+      dump_order = thread->Dump(dump.os, unwinder_, dump_native_stack_);
+    }
     {
       MutexLock mu(self, lock_);
       // Sort, so that the most interesting threads for ANR are printed first (ANRs can be trimmed).
       std::pair<Thread::DumpOrder, uint32_t> sort_key(dump_order, thread->GetThreadId());
-      os_.emplace(sort_key, std::move(local_os));
+      os_.emplace(sort_key, std::move(dump));
     }
     barrier_.Pass(self);
   }
 
+  // Called after all threads ran through the checkpoint to unwind the deferred native stacks.
+  void DumpNativeStacks(Thread* self) REQUIRES(!lock_) {
+    if (native_stack_threads_ == 0u) {
+      return;
+    }
+    std::vector<pid_t> tids;
+    {
+      MutexLock mu(self, lock_);
+      for (const auto& it : os_) {
+        if (it.second.native_stack_tid != 0) {
+          tids.push_back(it.second.native_stack_tid);
+        }
+      }
+    }
+    // The dumps are not touched by the checkpoint anymore, so we can unwind without the lock.
+    std::vector<std::string> stacks = DumpNativeStacksForOfflineSymbolization(
+        unwinder_, tids, "  native: ", native_stack_threads_);
+    MutexLock mu(self, lock_);
+    size_t i = 0u;
+    for (auto& it : os_) {
+      if (it.second.native_stack_tid != 0) {
+        DCHECK_EQ(it.second.native_stack_tid, tids[i]);
+        it.second.native_stack = std::move(stacks[i]);
+        ++i;
+      }
+    }
+  }
+
   // Called at the end to print all the dumps in sequential prioritized order.
   void Dump(Thread* self, std::ostream& os) {
     MutexLock mu(self, lock_);
     for (const auto& it : os_) {
-      os << it.second.str() << std::endl;
+      os << it.second.os.str() << it.second.native_stack << it.second.stack_os.str() << std::endl;
     }
   }
 
@@ -237,13 +293,23 @@ class DumpCheckpoint final : public Closure {
   // Storage for the per-thread dumps (guarded by lock since they are generated in parallel).
   // Map is used to obtain sorted order. The key is unique, but use multimap just in case.
   Mutex lock_;
-  std::multimap<std::pair<Thread::DumpOrder, uint32_t>, std::ostringstream> os_ GUARDED_BY(lock_);
+  struct ThreadDump {
+    std::ostringstream os;
+    // The thread whose native stack should be dumped between `os` and `stack_os`, if any.
+    pid_t native_stack_tid = 0;
+    std::string native_stack;
+    // Only used when the native stack is deferred, otherwise the whole dump is in `os`.
+    std::ostringstream stack_os;
+  };
+  std::multimap<std::pair<Thread::DumpOrder, uint32_t>, ThreadDump> os_ GUARDED_BY(lock_);
   // The barrier to be passed through and for the requestor to wait upon.
   Barrier barrier_;
   // A backtrace map, so that all threads use a shared info and don't reacquire/parse separately.
   unwindstack::AndroidLocalUnwinder unwinder_;
   // Whether we should dump the native stack.
   const bool dump_native_stack_;
+  // The number of threads unwinding the deferred native stacks, 0 if they are not deferred.
+  const size_t native_stack_threads_;
 };
 
 void ThreadList::Dump(std::ostream& os, bool dump_native_stack) {
@@ -253,7 +319,10 @@ void ThreadList::Dump(std::ostream& os, bool dump_native_stack) {
     os << "DALVIK THREADS (" << list_.size() << "):\n";
   }
   if (self != nullptr) {
-    DumpCheckpoint checkpoint(dump_native_stack);
+    // When aborting, keep the symbolized native stacks since they may be all we get.
+    size_t native_stack_threads =
+        (gAborting == 0) ? Runtime::Current()->GetParallelNativeStackDumpThreads() : 0u;
+    DumpCheckpoint checkpoint(dump_native_stack, native_stack_threads);
     // Acquire mutator lock separately for each thread, to avoid long runnable code sequence
     // without suspend checks.
     size_t threads_running_checkpoint = RunCheckpoint(&checkpoint,
@@ -263,6 +332,7 @@ void ThreadList::Dump(std::ostream& os, bool dump_native_stack) {
     if (threads_running_checkpoint != 0) {
       checkpoint.WaitForThreadsToRunThroughCheckpoint(threads_running_checkpoint);
     }
+    checkpoint.DumpNativeStacks(self);
     checkpoint.Dump(self, os);
   } else {
     DumpUnattachedThreads(os, dump_native_stack);
@@ -365,8 +435,15 @@ size_t ThreadList::RunCheckpoint(Closure* checkpoint_function,
   size_t nthreads = remaining_threads.size();
   size_t starting_thread = 0;
   size_t next_starting_thread;  // First possible remaining non-null entry in remaining_threads.
+  if (checkpoint_thread_pool_ != nullptr && !mutator_lock_held && !acquire_mutator_lock) {
+    // The checkpoint does not access Java data structures, so other threads can run it on
+    // behalf of the suspended threads. Threads of the pool cannot share our mutator lock.
+    starting_thread = nthreads;
+    RunCheckpointOnSuspendedThreadsInParallel(
+        self, checkpoint_function, remaining_threads, tefs.get(), &count);
+  }
   // Run the checkpoint for the suspended threads.
-  do {
+  while (starting_thread != nthreads) {
     // We hold mutator_lock_ (if desired), thread_list_lock_, and suspend_count_lock_
     next_starting_thread = nthreads;
     for (size_t i = 0; i < nthreads; ++i) {
@@ -446,7 +523,7 @@ size_t ThreadList::RunCheckpoint(Closure* checkpoint_function,
       }
     }
     starting_thread = next_starting_thread;
-  } while (starting_thread != nthreads);
+  }
 
   // Finally run the checkpoint on ourself. We will already have run the flip function, if we're
   // runnable.
@@ -471,6 +548,128 @@ size_t ThreadList::RunCheckpoint(Closure* checkpoint_function,
   return count;
 }
 
+void ThreadList::RunCheckpointOnSuspendedThreadsInParallel(Thread* self,
+                                                           Closure* checkpoint_function,
+                                                           std::vector<Thread*>& remaining_threads,
+                                                           ThreadExitFlag* tefs,
+                                                           size_t* count) {
+  ThreadPool* const thread_pool = checkpoint_thread_pool_.get();
+  ++checkpoint_thread_pool_users_;
+  std::vector<size_t> batch;
+  std::vector<Thread*> batch_threads;
+  bool retry;
+  do {
+    retry = false;
+    batch.clear();
+    batch_threads.clear();
+    for (size_t i = 0; i < remaining_threads.size(); ++i) {
+      Thread* thread = remaining_threads[i];
+      if (thread == nullptr) {
+        continue;
+      }
+      if (tefs[i].HasExited()) {
+        remaining_threads[i] = nullptr;
+        --*count;
+        continue;
+      }
+      if (thread->RequestCheckpoint(checkpoint_function)) {
+        // Thread became runnable, and will run the checkpoint; we're done.
+        thread->UnregisterThreadExitFlag(&tefs[i]);
+        remaining_threads[i] = nullptr;
+        continue;
+      }
+      // Suspend the thread so it stays suspended until the whole batch is done.
+      thread->IncrementSuspendCount(self);
+      if (LIKELY(thread->IsSuspended())) {
+        batch.push_back(i);
+        batch_threads.push_back(thread);
+      } else {
+        // Thread may have become runnable since we last checked. Retry in the next batch.
+        thread->DecrementSuspendCount(self);
+        Thread::resume_cond_->Broadcast(self);
+        retry = true;
+      }
+    }
+    if (batch.empty()) {
+      continue;
+    }
+
+    // We need to run the checkpoint function without the thread_list and suspend_count locks.
+    Locks::thread_suspend_count_lock_->Unlock(self);
+    Locks::thread_list_lock_->Unlock(self);
+    {
+      ScopedTrace trace([&]() {
+        return android::base::StringPrintf("Checkpoint for %zu suspended threads",
+                                           batch_threads.size());
+      });
+      // Threads claim the next suspended thread until there are none left, so that a slow
+      // checkpoint does not hold up the others.
+      std::atomic<size_t> next_thread(0u);
+      auto run_checkpoints = [&]() {
+        for (size_t i = next_thread.fetch_add(1u, std::memory_order_relaxed);
+             i < batch_threads.size();
+             i = next_thread.fetch_add(1u, std::memory_order_relaxed)) {
+          checkpoint_function->Run(batch_threads[i]);
+        }
+      };
+      size_t num_tasks =
+          std::min(thread_pool->GetThreadCount(), batch_threads.size() / kMinCheckpointsPerTask);
+      // The tasks keep the barrier alive, as they may still be releasing its lock
+      // after we return from `Increment()`.
+      std::shared_ptr<Barrier> barrier = std::make_shared<Barrier>(0);
+      for (size_t task = 0; task != num_tasks; ++task) {
+        thread_pool->AddTask(self, new FunctionTask([&run_checkpoints, barrier](Thread* worker) {
+          run_checkpoints();
+          barrier->Pass(worker);
+        }));
+      }
+      run_checkpoints();
+      barrier->Increment(self, static_cast<int>(num_tasks));
+    }
+    Locks::thread_list_lock_->Lock(self);
+    Locks::thread_suspend_count_lock_->Lock(self);
+
+    for (size_t i : batch) {
+      Thread* thread = remaining_threads[i];
+      thread->DecrementSuspendCount(self);
+      thread->UnregisterThreadExitFlag(&tefs[i]);
+      remaining_threads[i] = nullptr;
+    }
+    // In the case of threads waiting for IO or the like, there will be no waiters
+    // on resume_cond_, so Broadcast() will not enter the kernel, and thus be cheap.
+    Thread::resume_cond_->Broadcast(self);
+  } while (retry);
+  --checkpoint_thread_pool_users_;
+}
+
+void ThreadList::CreateCheckpointThreadPool(size_t num_threads) {
+  Thread* self = Thread::Current();
+  DCHECK(!Runtime::Current()->IsZygote());
+  std::unique_ptr<ThreadPool> thread_pool(
+      ThreadPool::Create("Checkpoint thread pool", num_threads));
+  thread_pool->StartWorkers(self);
+  thread_pool->WaitForWorkersToBeCreated();
+  MutexLock mu(self, *Locks::thread_list_lock_);
+  CHECK(checkpoint_thread_pool_ == nullptr);
+  checkpoint_thread_pool_ = std::move(thread_pool);
+}
+
+void ThreadList::DeleteCheckpointThreadPool() {
+  Thread* self = Thread::Current();
+  std::unique_ptr<ThreadPool> thread_pool;
+  {
+    MutexLock mu(self, *Locks::thread_list_lock_);
+    // Let new checkpoints run serially and wait for the ones using the pool.
+    thread_pool = std::move(checkpoint_thread_pool_);
+    while (checkpoint_thread_pool_users_ != 0u) {
+      Locks::thread_list_lock_->Unlock(self);
+      usleep(kThreadSuspendSleepUs);
+      Locks::thread_list_lock_->Lock(self);
+    }
+  }
+  thread_pool.reset();
+}
+
 void ThreadList::RunEmptyCheckpoint() {
   Thread* self = Thread::Current();
   Locks::mutator_lock_->AssertNotExclusiveHeld(self);
@@ -759,6 +958,95 @@ static bool WaitOnceForSuspendBarrier(AtomicInteger* barrier,
 
 #endif  // ART_USE_FUTEXES
 
+// Wait for up to `timeout_ns` for the suspend barrier to reach zero. Unlike
+// WaitOnceForSuspendBarrier(), the timeout is not divided into kSuspendBarrierIters.
+// Returns true if it timed out.
+static bool WaitForSuspendBarrierShort(AtomicInteger* barrier, uint64_t timeout_ns) {
+  const uint64_t start_time = NanoTime();
+  while (true) {
+    int32_t cur_val = barrier->load(std::memory_order_acquire);
+    if (cur_val <= 0) {
+      DCHECK_EQ(cur_val, 0);
+      return false;
+    }
+    uint64_t wait_time = NanoTime() - start_time;
+    if (wait_time >= timeout_ns) {
+      return true;
+    }
+#if ART_USE_FUTEXES
+    timespec wait_timeout;
+    InitTimeSpec(false, CLOCK_MONOTONIC, 0, timeout_ns - wait_time, &wait_timeout);
+    if (futex(barrier->Address(), FUTEX_WAIT_PRIVATE, cur_val, &wait_timeout, nullptr, 0) != 0 &&
+        errno != ETIMEDOUT && errno != EAGAIN && errno != EINTR) {
+      PLOG(FATAL) << "futex wait for suspend barrier failed";
+    }
+#else
+    sched_yield();
+#endif
+  }
+}
+
+// Returns the syscall number, stack pointer and program counter of a thread blocked in the
+// kernel, or "running" if it is running in user space. See proc(5).
+static std::string GetOsThreadSyscallQuick(pid_t tid) {
+  std::string result;
+#if defined(__linux__)
+  if (android::base::ReadFileToString(StringPrintf("/proc/self/task/%d/syscall", tid), &result)) {
+    while (!result.empty() && result.back() == '\n') {
+      result.pop_back();
+    }
+    return result;
+  }
+#else
+  UNUSED(tid);
+#endif
+  return "unknown";
+}
+
+void ThreadList::ReportSuspendAllStragglers(Thread* self, const AtomicInteger& pending_threads) {
+  struct Straggler {
+    std::string name;
+    pid_t tid;
+    uint32_t state_and_flags;
+  };
+  std::vector<Straggler> stragglers;
+  size_t num_stragglers = 0u;
+  {
+    MutexLock mu(self, *Locks::thread_list_lock_);
+    MutexLock mu2(self, *Locks::thread_suspend_count_lock_);
+    for (const auto& thread : list_) {
+      if (thread != self && !thread->IsSuspended()) {
+        ++num_stragglers;
+        if (stragglers.size() < kMaxReportedStragglers) {
+          Straggler straggler;
+          thread->GetThreadName(straggler.name);
+          straggler.tid = thread->GetTid();
+          straggler.state_and_flags =
+              thread->GetStateAndFlags(std::memory_order_relaxed).GetValue();
+          stragglers.push_back(std::move(straggler));
+        }
+      }
+    }
+  }
+  if (num_stragglers == 0u) {
+    // All threads have reached a suspend point in the meantime.
+    return;
+  }
+  Runtime::Current()->GetMetrics()->SuspendAllStragglerCount()->Add(num_stragglers);
+  // Sample the OS state outside the locks, the threads are still running.
+  std::ostringstream oss;
+  oss << "SuspendAll did not reach a safepoint within "
+      << PrettyDuration(kSuspendAllStragglerThreshold) << ", barrier value: "
+      << pending_threads.load(std::memory_order_relaxed) << ", stragglers: " << num_stragglers;
+  for (const Straggler& straggler : stragglers) {
+    oss << "\n  \"" << straggler.name << "\" tid=" << straggler.tid
+        << StringPrintf(" state&flags=0x%x", straggler.state_and_flags)
+        << " syscall=[" << GetOsThreadSyscallQuick(straggler.tid) << "]"
+        << " stat=[" << GetOsThreadStatQuick(straggler.tid) << "]";
+  }
+  LOG(WARNING) << oss.str();
+}
+
 std::optional<std::string> ThreadList::WaitForSuspendBarrier(AtomicInteger* barrier,
                                                              pid_t t,
                                                              int attempt_of_4) {
@@ -971,6 +1259,12 @@ void ThreadList::SuspendAllInternal(Thread* self, SuspendReason reason) {
     // We're already not runnable, so an attempt to suspend us should succeed.
   }
 
+  // Give the threads a short time to reach a suspend point before attributing the delay.
+  const uint64_t wait_start_time = NanoTime();
+  if (WaitForSuspendBarrierShort(&pending_threads, kSuspendAllStragglerThreshold)) {
+    ReportSuspendAllStragglers(self, pending_threads);
+  }
+
   Thread* culprit = nullptr;
   pid_t tid = 0;
   std::ostringstream oss;
@@ -978,6 +1272,8 @@ void ThreadList::SuspendAllInternal(Thread* self, SuspendReason reason) {
     auto result = WaitForSuspendBarrier(&pending_threads, tid, attempt_of_4);
     if (!result.has_value()) {
       // Wait succeeded.
+      Runtime::Current()->GetMetrics()->SuspendAllSafepointTime()->Add(
+          NsToUs(NanoTime() - wait_start_time));
       break;
     }
     if (attempt_of_4 == 3) {
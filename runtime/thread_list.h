@@ -42,6 +42,8 @@ class Closure;
 class IsMarkedVisitor;
 class RootVisitor;
 class Thread;
+class ThreadExitFlag;
+class ThreadPool;
 class TimingLogger;
 enum VisitRootFlags : uint8_t;
 
@@ -145,6 +147,16 @@ class ThreadList {
                               bool acquire_mutator_lock = false)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
+  // Create a pool of `num_threads` threads which `RunCheckpoint()` uses to run the checkpoint
+  // function on behalf of suspended threads, when the caller holds no mutator lock. Must not be
+  // called in the zygote, which must stay single-threaded for fork.
+  void CreateCheckpointThreadPool(size_t num_threads)
+      REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
+
+  // Delete the checkpoint thread pool, if any, after waiting for the checkpoints using it.
+  void DeleteCheckpointThreadPool()
+      REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
+
   // Convenience version of the above to disable lock checking inside Run function. Hopefully this
   // and the third parameter above will eventually disappear.
   size_t RunCheckpointUnchecked(Closure* checkpoint_function, Closure* callback = nullptr)
@@ -278,9 +290,24 @@ class ThreadList {
                !Locks::thread_suspend_count_lock_,
                !Locks::mutator_lock_);
 
+  // Log the name, state and sampled OS state of threads that have not yet passed the suspend
+  // barrier of a SuspendAll and count them in the runtime metrics.
+  void ReportSuspendAllStragglers(Thread* self, const AtomicInteger& pending_threads)
+      REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
+
   void AssertOtherThreadsAreSuspended(Thread* self)
       REQUIRES(!Locks::thread_list_lock_, !Locks::thread_suspend_count_lock_);
 
+  // Run the checkpoint function for the remaining (not runnable) threads of `RunCheckpoint()`
+  // in batches. Each batch keeps its threads suspended while `checkpoint_thread_pool_` and
+  // `self` run the checkpoint for them. The locks are released while the batches run.
+  void RunCheckpointOnSuspendedThreadsInParallel(Thread* self,
+                                                 Closure* checkpoint_function,
+                                                 std::vector<Thread*>& remaining_threads,
+                                                 ThreadExitFlag* tefs,
+                                                 size_t* count)
+      REQUIRES(Locks::thread_list_lock_, Locks::thread_suspend_count_lock_);
+
   std::bitset<kMaxThreadId> allocated_ids_ GUARDED_BY(Locks::allocated_thread_ids_lock_);
 
   // The actual list of all threads.
@@ -311,6 +338,11 @@ class ThreadList {
 
   std::unique_ptr<Barrier> empty_checkpoint_barrier_;
 
+  // Threads running checkpoints on behalf of suspended threads, null if disabled.
+  std::unique_ptr<ThreadPool> checkpoint_thread_pool_ GUARDED_BY(Locks::thread_list_lock_);
+  // Number of `RunCheckpoint()` calls currently using `checkpoint_thread_pool_`.
+  size_t checkpoint_thread_pool_users_ GUARDED_BY(Locks::thread_list_lock_);
+
   friend class Thread;
 
   friend class Mutex;
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_stack_pool.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "base/logging.h"
+#include "base/mutex-inl.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+ThreadStackPool::ThreadStackPool(size_t max_stacks)
+    : lock_("thread stack pool lock", kGenericBottomLock),
+      max_stacks_(max_stacks) {}
+
+ThreadStackPool::~ThreadStackPool() {
+  // Daemon threads and threads that have not finished exiting may still run on their stacks.
+  // Leak those mappings rather than unmapping memory that is in use.
+  for (Entry& entry : entries_) {
+    if (!IsAvailable(entry)) {
+      new MemMap(std::move(entry.map));  // NOLINT - intentionally leaked.
+    }
+  }
+}
+
+bool ThreadStackPool::IsAvailable(const Entry& entry) {
+  if (entry.last_tid == kInUse || entry.last_tid == kUnused) {
+    return entry.last_tid == kUnused;
+  }
+  // Once the tid is gone, the exited thread can no longer touch the stack.
+  return syscall(__NR_tgkill, getpid(), entry.last_tid, 0) != 0 && errno == ESRCH;
+}
+
+bool ThreadStackPool::Acquire(size_t stack_size, /*out*/ uint8_t** begin) {
+  // The guard page below the stack is part of the mapping.
+  size_t map_size = stack_size + gPageSize;
+  MutexLock mu(Thread::Current(), lock_);
+  for (Entry& entry : entries_) {
+    if (entry.map.Size() == map_size && IsAvailable(entry)) {
+      entry.last_tid = kInUse;
+      *begin = entry.map.Begin() + gPageSize;
+      return true;
+    }
+  }
+  if (entries_.size() == max_stacks_) {
+    return false;
+  }
+  std::string error_msg;
+  MemMap map = MemMap::MapAnonymous("thread stack",
+                                    map_size,
+                                    PROT_READ | PROT_WRITE,
+                                    /*low_4gb=*/ false,
+                                    &error_msg);
+  if (!map.IsValid()) {
+    LOG(WARNING) << "Failed to map a pooled thread stack: " << error_msg;
+    return false;
+  }
+  CHECK_EQ(mprotect(map.Begin(), gPageSize, PROT_NONE), 0) << strerror(errno);
+  *begin = map.Begin() + gPageSize;
+  entries_.push_back(Entry{std::move(map), kInUse});
+  return true;
+}
+
+void ThreadStackPool::Cancel(uint8_t* begin) {
+  MutexLock mu(Thread::Current(), lock_);
+  for (Entry& entry : entries_) {
+    if (entry.map.Begin() + gPageSize == begin) {
+      DCHECK_EQ(entry.last_tid, kInUse);
+      entry.last_tid = kUnused;
+      return;
+    }
+  }
+  LOG(FATAL) << "Unknown pooled thread stack " << reinterpret_cast<void*>(begin);
+}
+
+void ThreadStackPool::Release(const void* address_on_stack, pid_t tid) {
+  DCHECK_GT(tid, 0);
+  MutexLock mu(Thread::Current(), lock_);
+  for (Entry& entry : entries_) {
+    if (entry.map.HasAddress(address_on_stack)) {
+      DCHECK_EQ(entry.last_tid, kInUse);
+      entry.last_tid = tid;
+      return;
+    }
+  }
+}
+
+}  // namespace art
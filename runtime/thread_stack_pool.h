@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_THREAD_STACK_POOL_H_
+#define ART_RUNTIME_THREAD_STACK_POOL_H_
+
+#include <sys/types.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mem_map.h"
+#include "base/mutex.h"
+
+namespace art HIDDEN {
+
+// Pool of native stacks for threads created by `Thread::CreateNativeThread()`.
+//
+// Creating a pthread with a default stack maps a fresh stack and the new thread then faults
+// in the pages it touches, and both are undone when the thread exits. Applications that keep
+// starting short-lived threads pay that cost every time. The pool keeps the stacks of exited
+// threads, with their pages still resident, and hands them out to new threads of the same
+// stack size.
+//
+// A thread returns its stack with `Release()` while it is still running on it, so the stack
+// is handed out again only once the kernel no longer knows the thread's tid.
+class ThreadStackPool {
+ public:
+  explicit ThreadStackPool(size_t max_stacks);
+  ~ThreadStackPool();
+
+  // Find or map a stack of `stack_size` bytes and store its lowest usable address in `*begin`.
+  // Returns false if the pool is at capacity or the mapping failed, in which case the caller
+  // should let pthreads allocate the stack.
+  bool Acquire(size_t stack_size, /*out*/ uint8_t** begin) REQUIRES(!lock_);
+
+  // Return a stack from `Acquire()` that no thread has started running on.
+  void Cancel(uint8_t* begin) REQUIRES(!lock_);
+
+  // Called by thread `tid` running on a stack from `Acquire()` right before it exits.
+  // Does nothing if `address_on_stack` is not on a stack from the pool.
+  void Release(const void* address_on_stack, pid_t tid) REQUIRES(!lock_);
+
+ private:
+  struct Entry {
+    MemMap map;
+    // The tid of the thread that last ran on the stack, `kInUse` or `kUnused`.
+    pid_t last_tid;
+  };
+
+  static constexpr pid_t kInUse = 0;
+  static constexpr pid_t kUnused = -1;
+
+  static bool IsAvailable(const Entry& entry);
+
+  Mutex lock_;
+  std::vector<Entry> entries_ GUARDED_BY(lock_);
+  const size_t max_stacks_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadStackPool);
+};
+
+}  // namespace art
+
+#endif  // ART_RUNTIME_THREAD_STACK_POOL_H_
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_stack_pool.h"
+
+#include "base/globals.h"
+#include "common_runtime_test.h"
+#include "thread-current-inl.h"
+
+namespace art HIDDEN {
+
+class ThreadStackPoolTest : public CommonRuntimeTest {};
+
+TEST_F(ThreadStackPoolTest, AcquireAndCancel) {
+  ThreadStackPool pool(/*max_stacks=*/ 2u);
+  const size_t stack_size = 16 * gPageSize;
+  uint8_t* first = nullptr;
+  uint8_t* second = nullptr;
+  uint8_t* third = nullptr;
+  ASSERT_TRUE(pool.Acquire(stack_size, &first));
+  ASSERT_TRUE(pool.Acquire(stack_size, &second));
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(IsAlignedParam(first, gPageSize));
+  // The pool is at capacity and all stacks are in use.
+  EXPECT_FALSE(pool.Acquire(stack_size, &third));
+  // A cancelled stack is handed out again.
+  pool.Cancel(second);
+  ASSERT_TRUE(pool.Acquire(stack_size, &third));
+  EXPECT_EQ(third, second);
+  // Stacks are usable.
+  first[0] = 1;
+  first[stack_size - 1u] = 1;
+}
+
+TEST_F(ThreadStackPoolTest, ReleasedStackNotReusedWhileThreadAlive) {
+  ThreadStackPool pool(/*max_stacks=*/ 1u);
+  const size_t stack_size = 16 * gPageSize;
+  uint8_t* stack = nullptr;
+  ASSERT_TRUE(pool.Acquire(stack_size, &stack));
+  // Pretend the current thread is running on the stack and exiting.
+  pool.Release(stack + stack_size / 2u, Thread::Current()->GetTid());
+  uint8_t* other = nullptr;
+  EXPECT_FALSE(pool.Acquire(stack_size, &other));
+  // Addresses outside of pooled stacks are ignored.
+  int local = 0;
+  pool.Release(&local, Thread::Current()->GetTid());
+}
+
+}  // namespace art
@@ -329,8 +329,12 @@ class TraceEntriesWriterTask final : public TraceWriterTask {
       : TraceWriterTask(trace_writer, index, buffer, cur_offset, tid) {}
 
   void ProcessBuffer(uintptr_t* buffer, size_t cur_offset, size_t thread_id) override {
-    std::unordered_map<ArtMethod*, std::string> method_infos;
     TraceWriter* trace_writer = GetTraceWriter();
+    if (trace_writer->CanFlushBufferOnWorker()) {
+      trace_writer->FlushBufferOnWorker(buffer, cur_offset, thread_id);
+      return;
+    }
+    std::unordered_map<ArtMethod*, std::string> method_infos;
     if (trace_writer->GetTraceFormatVersion() == Trace::kFormatV1) {
       ScopedObjectAccess soa(Thread::Current());
       trace_writer->PreProcessTraceForMethodInfos(buffer, cur_offset, method_infos);
@@ -964,6 +968,11 @@ void Trace::FlushThreadBuffer(Thread* self) {
   // Check if we still need to flush inside the trace_lock_. If we are stopping tracing it is
   // possible we already deleted the trace and flushed the buffer too.
   if (the_trace_ == nullptr) {
+    if (TraceProfiler::IsTraceProfileInProgress()) {
+      // The buffer belongs to the low-overhead profile. Events of exiting threads are dropped.
+      TraceProfiler::ReleaseThreadBuffer(self);
+      return;
+    }
     DCHECK_EQ(self->GetMethodTraceBuffer(), nullptr);
     return;
   }
@@ -975,6 +984,11 @@ void Trace::ReleaseThreadBuffer(Thread* self) {
   // Check if we still need to flush inside the trace_lock_. If we are stopping tracing it is
   // possible we already deleted the trace and flushed the buffer too.
   if (the_trace_ == nullptr) {
+    if (TraceProfiler::IsTraceProfileInProgress()) {
+      // The buffer belongs to the low-overhead profile. Events of exiting threads are dropped.
+      TraceProfiler::ReleaseThreadBuffer(self);
+      return;
+    }
     DCHECK_EQ(self->GetMethodTraceBuffer(), nullptr);
     return;
   }
@@ -1089,6 +1103,9 @@ TraceWriter::TraceWriter(File* trace_file,
   if (!Runtime::Current()->IsZygote()) {
     thread_pool_.reset(TraceWriterThreadPool::Create("Trace writer pool"));
     thread_pool_->StartWorkers(Thread::Current());
+    if (output_mode == TraceOutputMode::kStreaming && trace_format_version_ == Trace::kFormatV2) {
+      worker_buf_.reset(new uint8_t[buffer_size_]);
+    }
   }
 
   // Initialize the pool of per-thread buffers.
@@ -1831,6 +1848,29 @@ void TraceWriter::FlushBuffer(uintptr_t* method_trace_entries,
   return;
 }
 
+void TraceWriter::FlushBufferOnWorker(uintptr_t* method_trace_entries,
+                                      size_t current_offset,
+                                      size_t tid) {
+  DCHECK(CanFlushBufferOnWorker());
+  DCHECK(trace_output_mode_ == TraceOutputMode::kStreaming);
+  DCHECK_EQ(trace_format_version_, Trace::kFormatV2);
+  size_t num_entries = GetNumEntries(clock_source_);
+  size_t num_records = (kPerThreadBufSize - current_offset) / num_entries;
+  DCHECK_EQ((kPerThreadBufSize - current_offset) % num_entries, 0u);
+
+  // Blocks of the V2 format only depend on the entries of the thread, so they can be encoded
+  // without holding the trace_writer_lock_.
+  size_t current_index = 0;
+  FlushEntriesFormatV2(method_trace_entries, tid, num_records, &current_index, worker_buf_.get());
+  DCHECK_LE(current_index, buffer_size_);
+
+  MutexLock mu(Thread::Current(), trace_writer_lock_);
+  num_records_ += num_records;
+  if (!trace_file_->WriteFully(worker_buf_.get(), current_index)) {
+    PLOG(WARNING) << "Failed streaming a tracing event.";
+  }
+}
+
 void Trace::LogMethodTraceEvent(Thread* thread,
                                 ArtMethod* method,
                                 TraceAction action,
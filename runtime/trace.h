@@ -244,6 +244,16 @@ class TraceWriter {
                    const std::unordered_map<ArtMethod*, std::string>& method_infos)
       REQUIRES(!trace_writer_lock_);
 
+  // Flush buffer to the file from the trace writer thread in streaming mode with the V2 format.
+  // The entries are encoded into `worker_buf_` without holding the trace_writer_lock_, which is
+  // only taken to write the encoded block, so threads recording thread infos or flushing their
+  // buffers synchronously do not wait for the encoding.
+  void FlushBufferOnWorker(uintptr_t* buffer, size_t num_entries, size_t tid)
+      REQUIRES(!trace_writer_lock_);
+
+  // Whether `FlushBufferOnWorker()` should be used by the trace writer thread.
+  bool CanFlushBufferOnWorker() const { return worker_buf_ != nullptr; }
+
   // This is called when we see the first entry from the thread to record the information about the
   // thread.
   void RecordThreadInfo(Thread* thread) REQUIRES(!trace_writer_lock_);
@@ -310,7 +320,7 @@ class TraceWriter {
                             size_t tid,
                             size_t num_records,
                             size_t* current_index,
-                            uint8_t* init_buffer_ptr) REQUIRES(trace_writer_lock_);
+                            uint8_t* init_buffer_ptr);
 
   void FlushEntriesFormatV1(uintptr_t* method_trace_entries,
                             size_t tid,
@@ -348,8 +358,7 @@ class TraceWriter {
 
   // Encodes the header for the events block. This assumes that there is enough space reserved to
   // encode the entry.
-  void EncodeEventBlockHeader(uint8_t* ptr, uint32_t thread_id, uint32_t num_records)
-      REQUIRES(trace_writer_lock_);
+  void EncodeEventBlockHeader(uint8_t* ptr, uint32_t thread_id, uint32_t num_records);
 
   // Ensures there is sufficient space in the buffer to record the requested_size. If there is not
   // enough sufficient space the current contents of the buffer are written to the file and
@@ -398,6 +407,10 @@ class TraceWriter {
   // specified by the user in non-streaming mode.
   std::unique_ptr<uint8_t[]> buf_;
 
+  // Buffer used by the trace writer thread to encode entries in streaming mode with the V2
+  // format. Only accessed by that thread. Null if entries are encoded into `buf_`.
+  std::unique_ptr<uint8_t[]> worker_buf_;
+
   // The cur_offset_ into the buf_. Accessed only in SuspendAll scope when flushing data from the
   // thread local buffers to buf_.
   size_t cur_offset_ GUARDED_BY(trace_writer_lock_);
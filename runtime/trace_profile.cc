@@ -16,6 +16,7 @@
 
 #include "trace_profile.h"
 
+#include "art_method-inl.h"
 #include "base/leb128.h"
 #include "base/mutex.h"
 #include "base/unix_file/fd_file.h"
@@ -46,6 +47,9 @@ static constexpr size_t kBufSizeForEncodedData = kMinBufSizeForEncodedData * 10;
 
 static constexpr size_t kAlwaysOnTraceHeaderSize = 8;
 
+// The maximum number of events per thread printed in ANR reports.
+static constexpr size_t kMaxSigQuitEventsPerThread = 64;
+
 bool TraceProfiler::profile_in_progress_ = false;
 
 void TraceProfiler::Start() {
@@ -77,6 +81,28 @@ void TraceProfiler::Start() {
   }
 }
 
+void TraceProfiler::AllocateThreadBuffer(Thread* self) {
+  if (!art_flags::always_enable_profile_code()) {
+    return;
+  }
+
+  MutexLock mu(self, *Locks::trace_lock_);
+  // The buffer may already have been allocated if the profile was started after this thread was
+  // added to the thread list.
+  if (!profile_in_progress_ || self->GetMethodTraceBuffer() != nullptr) {
+    return;
+  }
+  auto buffer = new uintptr_t[kAlwaysOnTraceBufSize];
+  memset(buffer, 0, kAlwaysOnTraceBufSize * sizeof(uintptr_t));
+  self->SetMethodTraceBuffer(buffer, kAlwaysOnTraceBufSize);
+}
+
+void TraceProfiler::ReleaseThreadBuffer(Thread* self) {
+  DCHECK(profile_in_progress_);
+  delete[] self->GetMethodTraceBuffer();
+  self->SetMethodTraceBuffer(/* buffer= */ nullptr, /* offset= */ 0);
+}
+
 void TraceProfiler::Stop() {
   if (!art_flags::always_enable_profile_code()) {
     LOG(ERROR) << "Feature not supported. Please build with ART_ALWAYS_ENABLE_PROFILE_CODE.";
@@ -198,6 +224,64 @@ void TraceProfiler::Dump(std::unique_ptr<File>&& trace_file) {
     // Reset the current pointer.
     thread->SetMethodTraceBufferCurrentEntry(kAlwaysOnTraceBufSize);
   }
+
+  if (!trace_file->WriteFully(buffer_ptr, curr_buffer_ptr - buffer_ptr)) {
+    PLOG(WARNING) << "Failed streaming a tracing event.";
+  }
+  delete[] buffer_ptr;
+  if (trace_file->FlushClose() != 0) {
+    PLOG(WARNING) << "Failed to close the trace file.";
+  }
+}
+
+void TraceProfiler::DumpForSigQuit(std::ostream& os) {
+  if (!art_flags::always_enable_profile_code()) {
+    return;
+  }
+
+  Thread* self = Thread::Current();
+  MutexLock mu(self, *Locks::trace_lock_);
+  if (!profile_in_progress_) {
+    return;
+  }
+
+  ScopedSuspendAll ssa(__FUNCTION__);
+  MutexLock tl(self, *Locks::thread_list_lock_);
+  os << "TraceProfiler recent method events (most recent first):\n";
+  for (Thread* thread : Runtime::Current()->GetThreadList()->GetList()) {
+    uintptr_t* method_trace_entries = thread->GetMethodTraceBuffer();
+    if (method_trace_entries == nullptr) {
+      continue;
+    }
+    std::string thread_name;
+    thread->GetThreadName(thread_name);
+    os << "\"" << thread_name << "\" sysTid=" << thread->GetTid() << "\n";
+    DumpRecentEvents(os, method_trace_entries, *thread->GetTraceBufferCurrEntryPtr());
+  }
+  os << "\n";
+}
+
+void TraceProfiler::DumpRecentEvents(std::ostream& os,
+                                     uintptr_t* method_trace_entries,
+                                     uintptr_t* current_entry) {
+  // Events are recorded from the end of the buffer towards its start and wrap around once the
+  // start is reached, so the events following `current_entry` are older.
+  size_t start_index = current_entry - method_trace_entries;
+  for (size_t i = 0; i < kMaxSigQuitEventsPerThread; i++) {
+    uintptr_t method_action_encoding =
+        method_trace_entries[(start_index + i) % kAlwaysOnTraceBufSize];
+    // 0 value indicates the rest of the entries are empty.
+    if (method_action_encoding == 0) {
+      break;
+    }
+    ArtMethod* method = reinterpret_cast<ArtMethod*>(method_action_encoding & kMaskTraceAction);
+    bool is_exit = (method_action_encoding & ~kMaskTraceAction) != kTraceMethodEnter;
+    os << "  " << (is_exit ? "exit" : "enter");
+    if (method != nullptr) {
+      os << " " << method->PrettyMethod();
+    }
+    os << "\n";
+  }
 }
 
 bool TraceProfiler::IsTraceProfileInProgress() {
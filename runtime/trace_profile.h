@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_TRACE_PROFILE_H_
 #define ART_RUNTIME_TRACE_PROFILE_H_
 
+#include <ostream>
 #include <unordered_set>
 
 #include "base/locks.h"
@@ -26,6 +27,7 @@
 namespace art HIDDEN {
 
 class ArtMethod;
+class Thread;
 
 // TODO(mythria): A randomly chosen value. Tune it later based on the number of
 // entries required in the buffer.
@@ -51,6 +53,17 @@ class TraceProfiler {
 
   static bool IsTraceProfileInProgress() REQUIRES(Locks::trace_lock_);
 
+  // Allocates a buffer for a thread that attaches while a profile is in progress, so the profile
+  // also covers threads started after it.
+  static void AllocateThreadBuffer(Thread* self) REQUIRES(!Locks::trace_lock_);
+
+  // Releases the buffer of a thread that is exiting while a profile is in progress.
+  static void ReleaseThreadBuffer(Thread* self) REQUIRES(Locks::trace_lock_);
+
+  // Prints the most recent events of each thread in a human readable form. This is used to give
+  // method-level context in ANR reports.
+  static void DumpForSigQuit(std::ostream& os) REQUIRES(!Locks::trace_lock_);
+
  private:
   // Dumps the events from all threads into the trace_file.
   static void Dump(std::unique_ptr<File>&& trace_file);
@@ -65,6 +78,11 @@ class TraceProfiler {
                              uint8_t* buffer /* out */,
                              std::unordered_set<ArtMethod*>& methods /* out */);
 
+  // Prints the events in `thread_buffer` from the most recent one, which is at `current_entry`.
+  static void DumpRecentEvents(std::ostream& os,
+                               uintptr_t* thread_buffer,
+                               uintptr_t* current_entry) REQUIRES_SHARED(Locks::mutator_lock_);
+
   static bool profile_in_progress_ GUARDED_BY(Locks::trace_lock_);
   DISALLOW_COPY_AND_ASSIGN(TraceProfiler);
 };
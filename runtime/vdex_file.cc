@@ -19,14 +19,17 @@
 #include <sys/mman.h>  // For the PROT_* and MAP_* constants.
 #include <sys/stat.h>  // for mkdir()
 
+#include <algorithm>
 #include <memory>
 #include <unordered_set>
 
+#include <android-base/file.h>
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
 #include <log/log.h>
 
 #include "base/bit_utils.h"
+#include "base/casts.h"
 #include "base/leb128.h"
 #include "base/stl_util.h"
 #include "base/systrace.h"
@@ -122,6 +125,32 @@ std::unique_ptr<VdexFile> VdexFile::OpenAtAddress(uint8_t* mmap_addr,
     return nullptr;
   }
   CHECK_IMPLIES(mmap_reuse, mmap_addr != nullptr);
+
+  // Check the section headers to find out whether the file is compressed.
+  alignas(VdexFileHeader) uint8_t headers[
+      sizeof(VdexFileHeader) + VdexSection::kNumberOfSections * sizeof(VdexSectionHeader)];
+  const VdexFileHeader* header = reinterpret_cast<const VdexFileHeader*>(headers);
+  const VdexSectionHeader* sections =
+      reinterpret_cast<const VdexSectionHeader*>(headers + sizeof(VdexFileHeader));
+  if (vdex_length >= sizeof(headers) &&
+      android::base::ReadFullyAtOffset(file_fd, headers, sizeof(headers), /*offset=*/ 0) &&
+      header->IsValid() &&
+      header->GetNumberOfSections() == VdexSection::kNumberOfSections &&
+      sections[VdexSection::kCompressedDataSection].section_size != 0u) {
+    if (writable) {
+      *error_msg = "Cannot open compressed vdex file " + vdex_filename + " for writing";
+      return nullptr;
+    }
+    return OpenCompressed(mmap_addr,
+                          mmap_size,
+                          mmap_reuse,
+                          file_fd,
+                          vdex_length,
+                          vdex_filename,
+                          low_4gb,
+                          error_msg);
+  }
+
   // Start as PROT_WRITE so we can mprotect back to it if we want to.
   MemMap mmap = MemMap::MapFileAtAddress(
       mmap_addr,
@@ -149,6 +178,90 @@ std::unique_ptr<VdexFile> VdexFile::OpenAtAddress(uint8_t* mmap_addr,
   return vdex;
 }
 
+std::unique_ptr<VdexFile> VdexFile::OpenCompressed(uint8_t* mmap_addr,
+                                                   size_t mmap_size,
+                                                   bool mmap_reuse,
+                                                   int file_fd,
+                                                   size_t vdex_length,
+                                                   const std::string& vdex_filename,
+                                                   bool low_4gb,
+                                                   std::string* error_msg) {
+  ScopedTrace trace(("VdexFile::OpenCompressed " + vdex_filename).c_str());
+  MemMap file_map = MemMap::MapFile(vdex_length,
+                                    PROT_READ,
+                                    MAP_PRIVATE,
+                                    file_fd,
+                                    /*start=*/ 0u,
+                                    /*low_4gb=*/ false,
+                                    vdex_filename.c_str(),
+                                    error_msg);
+  if (!file_map.IsValid()) {
+    *error_msg = "Failed to mmap file " + vdex_filename + " : " + *error_msg;
+    return nullptr;
+  }
+  const uint8_t* file_begin = file_map.Begin();
+  VdexFile compressed_vdex(std::move(file_map));
+  const VdexSectionHeader& blocks_section =
+      compressed_vdex.GetSectionHeader(VdexSection::kCompressedDataSection);
+  if (!IsAligned<alignof(ImageHeader::Block)>(blocks_section.section_offset) ||
+      blocks_section.section_size % sizeof(ImageHeader::Block) != 0u ||
+      blocks_section.section_offset > vdex_length ||
+      blocks_section.section_size > vdex_length - blocks_section.section_offset) {
+    *error_msg = "Invalid compressed data section in vdex file " + vdex_filename;
+    return nullptr;
+  }
+  ArrayRef<const ImageHeader::Block> blocks(
+      reinterpret_cast<const ImageHeader::Block*>(file_begin + blocks_section.section_offset),
+      blocks_section.section_size / sizeof(ImageHeader::Block));
+
+  // The blocks must cover the decompressed data after the section headers without gaps.
+  size_t decompressed_size = GetChecksumsOffset();
+  for (const ImageHeader::Block& block : blocks) {
+    if (block.GetImageOffset() != decompressed_size ||
+        (block.GetStorageMode() == ImageHeader::kStorageModeUncompressed &&
+         block.GetDataSize() != block.GetImageSize()) ||
+        block.GetDataOffset() > vdex_length ||
+        block.GetDataSize() > vdex_length - block.GetDataOffset()) {
+      *error_msg = "Invalid compressed block in vdex file " + vdex_filename;
+      return nullptr;
+    }
+    decompressed_size += block.GetImageSize();
+  }
+  if (mmap_addr != nullptr && mmap_size < decompressed_size) {
+    *error_msg = StringPrintf("Insufficient pre-allocated space to decompress vdex: %zu and %zu",
+                              mmap_size,
+                              decompressed_size);
+    return nullptr;
+  }
+
+  MemMap mmap = MemMap::MapAnonymous(vdex_filename.c_str(),
+                                     mmap_addr,
+                                     decompressed_size,
+                                     PROT_READ | PROT_WRITE,
+                                     low_4gb,
+                                     mmap_reuse,
+                                     /*reservation=*/ nullptr,
+                                     error_msg);
+  if (!mmap.IsValid()) {
+    *error_msg = "Failed to allocate memory for vdex file " + vdex_filename + " : " + *error_msg;
+    return nullptr;
+  }
+  memcpy(mmap.Begin(), file_begin, GetChecksumsOffset());
+  for (const ImageHeader::Block& block : blocks) {
+    if (!block.Decompress(mmap.Begin(), file_begin, error_msg)) {
+      *error_msg = "Failed to decompress vdex file " + vdex_filename + " : " + *error_msg;
+      return nullptr;
+    }
+  }
+
+  std::unique_ptr<VdexFile> vdex(new VdexFile(std::move(mmap)));
+  if (!vdex->IsValid()) {
+    *error_msg = "Vdex file is not valid";
+    return nullptr;
+  }
+  return vdex;
+}
+
 std::unique_ptr<VdexFile> VdexFile::OpenFromDm(const std::string& filename,
                                                const ZipArchive& archive) {
   std::string error_msg;
@@ -172,6 +285,10 @@ std::unique_ptr<VdexFile> VdexFile::OpenFromDm(const std::string& filename,
     LOG(WARNING) << "The dex metadata .vdex is not valid. Ignoring it.";
     return nullptr;
   }
+  if (vdex_file->IsCompressed()) {
+    LOG(WARNING) << "The dex metadata .vdex is compressed. Ignoring it.";
+    return nullptr;
+  }
   if (vdex_file->HasDexSection()) {
     LOG(ERROR) << "The dex metadata is not allowed to contain dex files";
     android_errorWriteLog(0x534e4554, "178055795");  // Report to SafetyNet.
@@ -299,6 +416,11 @@ bool VdexFile::WriteToDisk(const std::string& path,
       sections[VdexSection::kVerifierDepsSection].section_offset + verifier_deps_with_padding_size;
   sections[VdexSection::kTypeLookupTableSection].section_size = type_lookup_table_size;
 
+  // Set compressed data section.
+  sections[VdexSection::kCompressedDataSection].section_kind = VdexSection::kCompressedDataSection;
+  sections[VdexSection::kCompressedDataSection].section_offset = 0u;
+  sections[VdexSection::kCompressedDataSection].section_size = 0u;
+
   if (!CreateDirectories(path, error_msg)) {
     return false;
   }
@@ -367,6 +489,85 @@ bool VdexFile::WriteToDisk(const std::string& path,
   return true;
 }
 
+bool VdexFile::Compress(File* file,
+                        ImageHeader::StorageMode storage_mode,
+                        std::string* error_msg) {
+  DCHECK_NE(storage_mode, ImageHeader::kStorageModeUncompressed);
+  int64_t length = file->GetLength();
+  if (length < 0 || static_cast<size_t>(length) < GetChecksumsOffset()) {
+    *error_msg = "Invalid vdex file length for " + file->GetPath();
+    return false;
+  }
+  dchecked_vector<uint8_t> data(static_cast<size_t>(length));
+  if (!file->PreadFully(data.data(), data.size(), /*offset=*/ 0)) {
+    *error_msg = "Could not read vdex file " + file->GetPath();
+    return false;
+  }
+  const VdexFileHeader& header = *reinterpret_cast<const VdexFileHeader*>(data.data());
+  VdexSectionHeader* sections =
+      reinterpret_cast<VdexSectionHeader*>(data.data() + sizeof(VdexFileHeader));
+  if (!header.IsValid() || header.GetNumberOfSections() != VdexSection::kNumberOfSections) {
+    *error_msg = "Invalid vdex file " + file->GetPath();
+    return false;
+  }
+  DCHECK_EQ(sections[VdexSection::kCompressedDataSection].section_size, 0u);
+
+  // Compress the data after the section headers in blocks.
+  const size_t data_begin = GetChecksumsOffset();
+  const size_t num_blocks = DivideRoundUp(data.size() - data_begin, kCompressedBlockSize);
+  const size_t blocks_offset = RoundUp(data_begin, alignof(ImageHeader::Block));
+  dchecked_vector<ImageHeader::Block> blocks;
+  blocks.reserve(num_blocks);
+  dchecked_vector<uint8_t> out(blocks_offset + num_blocks * sizeof(ImageHeader::Block), 0u);
+  for (size_t offset = data_begin; offset != data.size(); ) {
+    size_t size = std::min(data.size() - offset, kCompressedBlockSize);
+    dchecked_vector<uint8_t> compressed_data;
+    if (!CompressData(ArrayRef<const uint8_t>(data).SubArray(offset, size),
+                      storage_mode,
+                      &compressed_data)) {
+      *error_msg = "Error compressing data for " + file->GetPath();
+      return false;
+    }
+    blocks.emplace_back(storage_mode,
+                        /*data_offset=*/ dchecked_integral_cast<uint32_t>(out.size()),
+                        /*data_size=*/ dchecked_integral_cast<uint32_t>(compressed_data.size()),
+                        /*image_offset=*/ dchecked_integral_cast<uint32_t>(offset),
+                        /*image_size=*/ dchecked_integral_cast<uint32_t>(size));
+    out.insert(out.end(), compressed_data.begin(), compressed_data.end());
+    offset += size;
+  }
+  DCHECK_EQ(blocks.size(), num_blocks);
+  if (out.size() >= data.size()) {
+    // Compression does not help, keep the file uncompressed.
+    return true;
+  }
+
+  sections[VdexSection::kCompressedDataSection] =
+      VdexSectionHeader(VdexSection::kCompressedDataSection,
+                        dchecked_integral_cast<uint32_t>(blocks_offset),
+                        dchecked_integral_cast<uint32_t>(num_blocks * sizeof(ImageHeader::Block)));
+  memcpy(out.data(), data.data(), data_begin);
+  if (!blocks.empty()) {
+    memcpy(out.data() + blocks_offset, blocks.data(), num_blocks * sizeof(ImageHeader::Block));
+  }
+
+  // Write the data with an invalid magic first, so that we do not end up with a valid
+  // header and invalid data if the process is killed, then write the actual header.
+  memcpy(out.data(),
+         VdexFileHeader::kVdexInvalidMagic,
+         sizeof(VdexFileHeader::kVdexInvalidMagic));
+  if (!file->PwriteFully(out.data(), out.size(), /*offset=*/ 0) ||
+      file->SetLength(out.size()) != 0 ||
+      file->Flush() != 0 ||
+      !file->PwriteFully(&header, sizeof(header), /*offset=*/ 0) ||
+      file->Flush() != 0) {
+    *error_msg = "Failed to write compressed vdex file " + file->GetPath() + ": " +
+                 std::string(strerror(errno));
+    return false;
+  }
+  return true;
+}
+
 bool VdexFile::MatchesDexFileChecksums(const std::vector<const DexFile::Header*>& dex_headers)
     const {
   if (dex_headers.size() != GetNumberOfDexFiles()) {
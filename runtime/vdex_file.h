@@ -28,6 +28,7 @@
 #include "dex/compact_offset_table.h"
 #include "dex/dex_file.h"
 #include "handle.h"
+#include "oat/image.h"
 
 namespace art HIDDEN {
 
@@ -74,6 +75,21 @@ class VerifierDeps;
 //        uint32                     Number of strings
 //        uint32[]                   String data offsets for each string
 //        uint8[]                    String data
+//
+//   TypeLookupTable
+//      uint32 size and TypeLookupTable data for each dex file
+//
+// A vdex file can also be stored compressed, see `VdexFile::Compress()`. In that case the
+// file contains only the header and the section headers followed by the compressed data:
+//
+//   VdexFileHeader                fixed-length header
+//   VdexSectionHeader[kNumberOfSections]
+//   ImageHeader::Block[]          the compressed data section
+//   uint8[]                       compressed data of the blocks
+//
+// The blocks decompress to the sections listed above, which are described by the section
+// headers as if the file was uncompressed. The compressed vdex is decompressed to anonymous
+// memory when opened.
 
 
 enum VdexSection : uint32_t {
@@ -81,7 +97,8 @@ enum VdexSection : uint32_t {
   kDexFileSection = 1,
   kVerifierDepsSection = 2,
   kTypeLookupTableSection = 3,
-  kNumberOfSections = 4,
+  kCompressedDataSection = 4,
+  kNumberOfSections = 5,
 };
 
 class VdexFile {
@@ -122,8 +139,8 @@ class VdexFile {
     static constexpr uint8_t kVdexMagic[] = { 'v', 'd', 'e', 'x' };
 
     // The format version of the verifier deps header and the verifier deps.
-    // Last update: Introduce vdex sections.
-    static constexpr uint8_t kVdexVersion[] = { '0', '2', '7', '\0' };
+    // Last update: Add perfect hash type lookup tables.
+    static constexpr uint8_t kVdexVersion[] = { '0', '2', '9', '\0' };
 
     uint8_t magic_[4];
     uint8_t vdex_version_[4];
@@ -170,6 +187,13 @@ class VdexFile {
     return GetVdexFileHeader().GetNumberOfSections() >= (kTypeLookupTableSection + 1);
   }
 
+  // Returns true if the vdex file is stored compressed on disk. The data of an opened
+  // compressed vdex file is already decompressed.
+  bool IsCompressed() const {
+    return GetVdexFileHeader().GetNumberOfSections() >= (kCompressedDataSection + 1) &&
+           GetSectionHeader(VdexSection::kCompressedDataSection).section_size != 0u;
+  }
+
   const VdexChecksum* GetDexChecksumsArray() const {
     return reinterpret_cast<const VdexChecksum*>(
         Begin() + GetSectionHeader(VdexSection::kChecksumSection).section_offset);
@@ -290,6 +314,13 @@ class VdexFile {
                           const verifier::VerifierDeps& verifier_deps,
                           std::string* error_msg);
 
+  // Rewrites the complete vdex `file` compressed in blocks of `kCompressedBlockSize` bytes
+  // using `storage_mode`. The file is left uncompressed if that does not make it smaller.
+  // Any existing mapping of the file becomes invalid.
+  EXPORT static bool Compress(File* file,
+                              ImageHeader::StorageMode storage_mode,
+                              std::string* error_msg);
+
   // Returns true if the dex file checksums stored in the vdex header match
   // the checksums in `dex_headers`. Both the number of dex files and their
   // order must match too.
@@ -309,6 +340,19 @@ class VdexFile {
   }
 
  private:
+  // The size of the data decompressed from a single block. Blocks are independent,
+  // so keep them small enough to allow decompressing only a part of the data.
+  static constexpr size_t kCompressedBlockSize = 64 * KB;
+
+  static std::unique_ptr<VdexFile> OpenCompressed(uint8_t* mmap_addr,
+                                                  size_t mmap_size,
+                                                  bool mmap_reuse,
+                                                  int file_fd,
+                                                  size_t vdex_length,
+                                                  const std::string& vdex_filename,
+                                                  bool low_4gb,
+                                                  std::string* error_msg);
+
   bool ContainsDexFile(const DexFile& dex_file) const;
 
   const uint8_t* DexBegin() const {
@@ -17,6 +17,7 @@
 #include "vdex_file.h"
 
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -43,4 +44,59 @@ TEST_F(VdexFileTest, OpenEmptyVdex) {
   EXPECT_TRUE(vdex == nullptr);
 }
 
+TEST_F(VdexFileTest, CompressedVdex) {
+  // Create a vdex file with a dex section spanning multiple compressed blocks.
+  constexpr size_t kDexSectionSize = 200 * KB + 3u;
+  const size_t dex_section_offset = VdexFile::GetChecksumsOffset() + sizeof(VdexFile::VdexChecksum);
+  std::vector<uint8_t> data(dex_section_offset + kDexSectionSize);
+  new (data.data()) VdexFile::VdexFileHeader(/*has_dex_section=*/ true);
+  VdexFile::VdexSectionHeader* sections = reinterpret_cast<VdexFile::VdexSectionHeader*>(
+      data.data() + sizeof(VdexFile::VdexFileHeader));
+  sections[kChecksumSection] = VdexFile::VdexSectionHeader(
+      kChecksumSection, VdexFile::GetChecksumsOffset(), sizeof(VdexFile::VdexChecksum));
+  sections[kDexFileSection] =
+      VdexFile::VdexSectionHeader(kDexFileSection, dex_section_offset, kDexSectionSize);
+  sections[kVerifierDepsSection] =
+      VdexFile::VdexSectionHeader(kVerifierDepsSection, data.size(), 0u);
+  sections[kTypeLookupTableSection] =
+      VdexFile::VdexSectionHeader(kTypeLookupTableSection, data.size(), 0u);
+  sections[kCompressedDataSection] = VdexFile::VdexSectionHeader(kCompressedDataSection, 0u, 0u);
+  for (size_t i = VdexFile::GetChecksumsOffset(); i != data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i / 7u) % 13u);
+  }
+
+  ScratchFile tmp;
+  ASSERT_TRUE(tmp.GetFile()->WriteFully(data.data(), data.size()));
+  std::string error_msg;
+  ASSERT_TRUE(VdexFile::Compress(tmp.GetFile(), ImageHeader::kStorageModeLZ4, &error_msg))
+      << error_msg;
+  int64_t compressed_length = tmp.GetFile()->GetLength();
+  EXPECT_LT(static_cast<size_t>(compressed_length), data.size());
+
+  // A compressed vdex file cannot be opened for writing.
+  std::unique_ptr<VdexFile> vdex = VdexFile::Open(tmp.GetFd(),
+                                                  compressed_length,
+                                                  tmp.GetFilename(),
+                                                  /*writable=*/true,
+                                                  /*low_4gb=*/false,
+                                                  &error_msg);
+  EXPECT_TRUE(vdex == nullptr);
+
+  vdex = VdexFile::Open(tmp.GetFd(),
+                        compressed_length,
+                        tmp.GetFilename(),
+                        /*writable=*/false,
+                        /*low_4gb=*/false,
+                        &error_msg);
+  ASSERT_TRUE(vdex != nullptr) << error_msg;
+  EXPECT_TRUE(vdex->IsCompressed());
+  ASSERT_EQ(vdex->Size(), data.size());
+  EXPECT_EQ(memcmp(vdex->Begin() + VdexFile::GetChecksumsOffset(),
+                   data.data() + VdexFile::GetChecksumsOffset(),
+                   data.size() - VdexFile::GetChecksumsOffset()),
+            0);
+  EXPECT_TRUE(vdex->HasDexSection());
+  EXPECT_EQ(vdex->GetNumberOfDexFiles(), 1u);
+}
+
 }  // namespace art
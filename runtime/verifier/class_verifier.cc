@@ -16,6 +16,8 @@
 
 #include "class_verifier.h"
 
+#include <optional>
+
 #include <android-base/logging.h>
 #include <android-base/stringprintf.h>
 
@@ -23,6 +25,7 @@
 #include "base/locks.h"
 #include "base/logging.h"
 #include "base/pointer_size.h"
+#include "base/scoped_arena_allocator.h"
 #include "base/systrace.h"
 #include "base/utils.h"
 #include "class_linker.h"
@@ -51,6 +54,10 @@ using android::base::StringPrintf;
 // sure we only print this once.
 static bool gPrintedDxMonitorText = false;
 
+// The register type cache shared by the methods of a class is recreated before verifying a method
+// once it holds this many types, to bound the cost of its linear lookups and its memory use.
+static constexpr size_t kMaxSharedRegTypeCacheSize = 256u;
+
 static void UpdateMethodFlags(uint32_t method_index,
                               Handle<mirror::Class> klass,
                               Handle<mirror::DexCache> dex_cache,
@@ -111,6 +118,19 @@ FailureKind ClassVerifier::VerifyClass(Thread* self,
   MethodVerifier::FailureData failure_data;
   ClassLinker* const linker = Runtime::Current()->GetClassLinker();
 
+  // The methods of a class use many of the same types, such as the class itself, its fields'
+  // types and java.lang.Object, so share one register type cache between them rather than
+  // resolving the same classes again for each method.
+  ArenaStack reg_types_arena_stack(Runtime::Current()->GetArenaPool());
+  std::optional<ScopedArenaAllocator> reg_types_allocator;
+  std::optional<RegTypeCache> reg_types;
+  auto create_reg_types = [&]() REQUIRES_SHARED(Locks::mutator_lock_) {
+    reg_types.reset();
+    reg_types_allocator.reset();
+    reg_types_allocator.emplace(&reg_types_arena_stack);
+    reg_types.emplace(self, linker, /* can_load_classes= */ true, *reg_types_allocator);
+  };
+
   for (const ClassAccessor::Method& method : accessor.GetMethods()) {
     int64_t* previous_idx = &previous_method_idx[method.IsStaticOrDirect() ? 0u : 1u];
     self->AllowThreadSuspension();
@@ -121,11 +141,15 @@ FailureKind ClassVerifier::VerifyClass(Thread* self,
       continue;
     }
     *previous_idx = method_idx;
+    if (!reg_types.has_value() || reg_types->GetCacheSize() >= kMaxSharedRegTypeCacheSize) {
+      create_reg_types();
+    }
     std::string hard_failure_msg;
     MethodVerifier::FailureData result =
         MethodVerifier::VerifyMethod(self,
                                      linker,
                                      Runtime::Current()->GetArenaPool(),
+                                     &*reg_types,
                                      verifier_deps,
                                      method_idx,
                                      dex_file,
@@ -151,7 +151,8 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
                  const dex::ClassDef& class_def,
                  uint32_t access_flags,
                  bool verify_to_dump,
-                 uint32_t api_level) REQUIRES_SHARED(Locks::mutator_lock_)
+                 uint32_t api_level,
+                 RegTypeCache* reg_types = nullptr) REQUIRES_SHARED(Locks::mutator_lock_)
      : art::verifier::MethodVerifier(self,
                                      class_linker,
                                      arena_pool,
@@ -162,7 +163,8 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
                                      method_idx,
                                      can_load_classes,
                                      allow_thread_suspension,
-                                     aot_mode),
+                                     aot_mode,
+                                     reg_types),
        method_access_flags_(access_flags),
        return_type_(nullptr),
        dex_cache_(dex_cache),
@@ -172,6 +174,7 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
        monitor_enter_dex_pcs_(nullptr),
        verify_to_dump_(verify_to_dump),
        allow_thread_suspension_(allow_thread_suspension),
+       has_branches_or_monitors_(false),
        is_constructor_(false),
        api_level_(api_level == 0 ? std::numeric_limits<uint32_t>::max() : api_level) {
   }
@@ -453,9 +456,9 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
   /* Perform detailed code-flow analysis on a single method. */
   bool VerifyCodeFlow() REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Set the register types for the first instruction in the method based on the method signature.
-  // This has the side-effect of validating the signature.
-  bool SetTypesFromSignature() REQUIRES_SHARED(Locks::mutator_lock_);
+  // Set the register types in `reg_line`, the line of the first instruction in the method, based on
+  // the method signature. This has the side-effect of validating the signature.
+  bool SetTypesFromSignature(RegisterLine* reg_line) REQUIRES_SHARED(Locks::mutator_lock_);
 
   /*
    * Perform code flow on a method.
@@ -506,6 +509,14 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
   template <bool kMonitorDexPCs>
   bool CodeFlowVerifyMethod() REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Whether the code flow of the method can be verified by CodeFlowVerifyStraightLineMethod().
+  bool IsStraightLineMethod() const;
+
+  // Perform code-flow analysis on a method without branches, switches, monitors and try items.
+  // Each instruction is reached only from the previous one, so the instructions are verified in
+  // a single pass in order, and no register line is stored for any of them.
+  bool CodeFlowVerifyStraightLineMethod() REQUIRES_SHARED(Locks::mutator_lock_);
+
   /*
    * Perform verification for a single instruction.
    *
@@ -670,7 +681,7 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
       const dex::MethodId& method_id = dex_file_->GetMethodId(dex_method_idx_);
       const char* descriptor
           = dex_file_->GetTypeDescriptor(dex_file_->GetTypeId(method_id.class_idx_));
-      declaring_class_ = &reg_types_.FromDescriptor(class_loader_, descriptor);
+      declaring_class_ = &reg_types_->FromDescriptor(class_loader_, descriptor);
     }
     return *declaring_class_;
   }
@@ -695,7 +706,7 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
           << "non-instantiable klass " << descriptor;
       precise = false;
     }
-    return reg_types_.FromClass(descriptor, klass, precise);
+    return reg_types_->FromClass(descriptor, klass, precise);
   }
 
   ALWAYS_INLINE bool FailOrAbort(bool condition, const char* error_msg, uint32_t work_insn_idx);
@@ -771,6 +782,9 @@ class MethodVerifier final : public ::art::verifier::MethodVerifier {
   // FindLocksAtDexPC, resulting in deadlocks.
   const bool allow_thread_suspension_;
 
+  // Whether the code has a branch, switch or monitor instruction. Set by VerifyInstructions().
+  bool has_branches_or_monitors_;
+
   // Whether the method seems to be a constructor. Note that this field exists as we can't trust
   // the flags in the dex file. Some older code does not mark methods named "<init>" and "<clinit>"
   // correctly.
@@ -1150,6 +1164,12 @@ bool MethodVerifier<kVerifierDebug>::VerifyInstructions() {
       DCHECK_NE(failures_.size(), 0U);
       return false;
     }
+    if (inst->IsBranch() ||
+        inst->IsSwitch() ||
+        inst->Opcode() == Instruction::MONITOR_ENTER ||
+        inst->Opcode() == Instruction::MONITOR_EXIT) {
+      has_branches_or_monitors_ = true;
+    }
     // Flag some interesting instructions.
     if (inst->IsReturn()) {
       GetModifiableInstructionFlags(dex_pc).SetReturn();
@@ -1556,20 +1576,24 @@ bool MethodVerifier<kVerifierDebug>::CheckSwitchTargets(uint32_t cur_offset) {
 template <bool kVerifierDebug>
 bool MethodVerifier<kVerifierDebug>::VerifyCodeFlow() {
   const uint16_t registers_size = code_item_accessor_.RegistersSize();
+  const bool straight_line = IsStraightLineMethod();
 
   /* Create and initialize table holding register status */
-  reg_table_.Init(insn_flags_.get(),
-                  code_item_accessor_.InsnsSizeInCodeUnits(),
-                  registers_size,
-                  allocator_,
-                  GetRegTypeCache(),
-                  interesting_dex_pc_);
+  if (!straight_line) {
+    reg_table_.Init(insn_flags_.get(),
+                    code_item_accessor_.InsnsSizeInCodeUnits(),
+                    registers_size,
+                    allocator_,
+                    GetRegTypeCache(),
+                    interesting_dex_pc_);
+  }
 
   work_line_.reset(RegisterLine::Create(registers_size, allocator_, GetRegTypeCache()));
   saved_line_.reset(RegisterLine::Create(registers_size, allocator_, GetRegTypeCache()));
 
   /* Initialize register types of method arguments. */
-  if (!SetTypesFromSignature()) {
+  // Straight-line methods have no line for the first instruction and start from the work line.
+  if (!SetTypesFromSignature(straight_line ? work_line_.get() : reg_table_.GetLine(0))) {
     DCHECK_NE(failures_.size(), 0U);
     std::string prepend("Bad signature in ");
     prepend += dex_file_->PrettyMethod(dex_method_idx_);
@@ -1580,9 +1604,11 @@ bool MethodVerifier<kVerifierDebug>::VerifyCodeFlow() {
   flags_.have_pending_runtime_throw_failure_ = false;
 
   /* Perform code flow verification. */
-  bool res = LIKELY(monitor_enter_dex_pcs_ == nullptr)
-                 ? CodeFlowVerifyMethod</*kMonitorDexPCs=*/ false>()
-                 : CodeFlowVerifyMethod</*kMonitorDexPCs=*/ true>();
+  bool res = straight_line
+                 ? CodeFlowVerifyStraightLineMethod()
+                 : (LIKELY(monitor_enter_dex_pcs_ == nullptr)
+                        ? CodeFlowVerifyMethod</*kMonitorDexPCs=*/ false>()
+                        : CodeFlowVerifyMethod</*kMonitorDexPCs=*/ true>());
   if (UNLIKELY(!res)) {
     DCHECK_NE(failures_.size(), 0U);
     return false;
@@ -1599,7 +1625,7 @@ void MethodVerifier<kVerifierDebug>::Dump(VariableIndentationOutputStream* vios)
   {
     vios->Stream() << "Register Types:\n";
     ScopedIndentation indent1(vios);
-    reg_types_.Dump(vios->Stream());
+    reg_types_->Dump(vios->Stream());
   }
   vios->Stream() << "Dumping instructions and register lines:\n";
   ScopedIndentation indent1(vios);
@@ -1642,9 +1668,7 @@ static bool IsPrimitiveDescriptor(char descriptor) {
 }
 
 template <bool kVerifierDebug>
-bool MethodVerifier<kVerifierDebug>::SetTypesFromSignature() {
-  RegisterLine* reg_line = reg_table_.GetLine(0);
-
+bool MethodVerifier<kVerifierDebug>::SetTypesFromSignature(RegisterLine* reg_line) {
   // Should have been verified earlier.
   DCHECK_GE(code_item_accessor_.RegistersSize(), code_item_accessor_.InsSize());
 
@@ -1672,7 +1696,7 @@ bool MethodVerifier<kVerifierDebug>::SetTypesFromSignature() {
       } else {
         reg_line->SetRegisterType<LockOp::kClear>(
             arg_start + cur_arg,
-            reg_types_.UninitializedThisArgument(declaring_class));
+            reg_types_->UninitializedThisArgument(declaring_class));
       }
     } else {
       reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, declaring_class);
@@ -1713,22 +1737,22 @@ bool MethodVerifier<kVerifierDebug>::SetTypesFromSignature() {
         }
         break;
       case 'Z':
-        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_.Boolean());
+        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_->Boolean());
         break;
       case 'C':
-        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_.Char());
+        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_->Char());
         break;
       case 'B':
-        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_.Byte());
+        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_->Byte());
         break;
       case 'I':
-        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_.Integer());
+        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_->Integer());
         break;
       case 'S':
-        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_.Short());
+        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_->Short());
         break;
       case 'F':
-        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_.Float());
+        reg_line->SetRegisterType<LockOp::kClear>(arg_start + cur_arg, reg_types_->Float());
         break;
       case 'J':
       case 'D': {
@@ -1741,11 +1765,11 @@ bool MethodVerifier<kVerifierDebug>::SetTypesFromSignature() {
         const RegType* lo_half;
         const RegType* hi_half;
         if (descriptor[0] == 'J') {
-          lo_half = &reg_types_.LongLo();
-          hi_half = &reg_types_.LongHi();
+          lo_half = &reg_types_->LongLo();
+          hi_half = &reg_types_->LongHi();
         } else {
-          lo_half = &reg_types_.DoubleLo();
-          hi_half = &reg_types_.DoubleHi();
+          lo_half = &reg_types_->DoubleLo();
+          hi_half = &reg_types_->DoubleHi();
         }
         reg_line->SetRegisterTypeWide(arg_start + cur_arg, *lo_half, *hi_half);
         cur_arg++;
@@ -1949,6 +1973,44 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyMethod() {
   return true;
 }
 
+template <bool kVerifierDebug>
+bool MethodVerifier<kVerifierDebug>::IsStraightLineMethod() const {
+  // Requests for the register state at a dex pc need the register line table.
+  return !has_branches_or_monitors_ &&
+         code_item_accessor_.TriesSize() == 0u &&
+         interesting_dex_pc_ == dex::kDexNoIndex &&
+         monitor_enter_dex_pcs_ == nullptr;
+}
+
+template <bool kVerifierDebug>
+bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyStraightLineMethod() {
+  DCHECK(IsStraightLineMethod());
+  DCHECK(!reg_table_.IsInitialized());
+  uint32_t insn_idx = 0u;
+  while (true) {
+    if (allow_thread_suspension_) {
+      self_->AllowThreadSuspension();
+    }
+    work_insn_idx_ = insn_idx;
+    uint32_t next_insn_idx = insn_idx;
+    if (!CodeFlowVerifyInstruction(&next_insn_idx)) {
+      std::string prepend(dex_file_->PrettyMethod(dex_method_idx_));
+      prepend += " failed to verify: ";
+      PrependToLastFailMessage(prepend);
+      return false;
+    }
+    GetModifiableInstructionFlags(insn_idx).SetVisited();
+    GetModifiableInstructionFlags(insn_idx).ClearChanged();
+    // Only the next instruction can have been marked as changed. It is not marked when the
+    // current instruction returns, throws or always fails at runtime.
+    if (next_insn_idx == insn_idx || !GetInstructionFlags(next_insn_idx).IsChanged()) {
+      break;
+    }
+    insn_idx = next_insn_idx;
+  }
+  return true;
+}
+
 // Setup a register line for the given return instruction.
 template <bool kVerifierDebug>
 static void AdjustReturnLine(MethodVerifier<kVerifierDebug>* verifier,
@@ -2212,37 +2274,37 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       /* could be long or double; resolved upon use */
     case Instruction::CONST_WIDE_16: {
       int64_t val = static_cast<int16_t>(inst->VRegB_21s());
-      const RegType& lo = reg_types_.FromCat2ConstLo(static_cast<int32_t>(val), true);
-      const RegType& hi = reg_types_.FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
+      const RegType& lo = reg_types_->FromCat2ConstLo(static_cast<int32_t>(val), true);
+      const RegType& hi = reg_types_->FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
       work_line_->SetRegisterTypeWide(inst->VRegA_21s(), lo, hi);
       break;
     }
     case Instruction::CONST_WIDE_32: {
       int64_t val = static_cast<int32_t>(inst->VRegB_31i());
-      const RegType& lo = reg_types_.FromCat2ConstLo(static_cast<int32_t>(val), true);
-      const RegType& hi = reg_types_.FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
+      const RegType& lo = reg_types_->FromCat2ConstLo(static_cast<int32_t>(val), true);
+      const RegType& hi = reg_types_->FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
       work_line_->SetRegisterTypeWide(inst->VRegA_31i(), lo, hi);
       break;
     }
     case Instruction::CONST_WIDE: {
       int64_t val = inst->VRegB_51l();
-      const RegType& lo = reg_types_.FromCat2ConstLo(static_cast<int32_t>(val), true);
-      const RegType& hi = reg_types_.FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
+      const RegType& lo = reg_types_->FromCat2ConstLo(static_cast<int32_t>(val), true);
+      const RegType& hi = reg_types_->FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
       work_line_->SetRegisterTypeWide(inst->VRegA_51l(), lo, hi);
       break;
     }
     case Instruction::CONST_WIDE_HIGH16: {
       int64_t val = static_cast<uint64_t>(inst->VRegB_21h()) << 48;
-      const RegType& lo = reg_types_.FromCat2ConstLo(static_cast<int32_t>(val), true);
-      const RegType& hi = reg_types_.FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
+      const RegType& lo = reg_types_->FromCat2ConstLo(static_cast<int32_t>(val), true);
+      const RegType& hi = reg_types_->FromCat2ConstHi(static_cast<int32_t>(val >> 32), true);
       work_line_->SetRegisterTypeWide(inst->VRegA_21h(), lo, hi);
       break;
     }
     case Instruction::CONST_STRING:
-      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_21c(), reg_types_.JavaLangString());
+      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_21c(), reg_types_->JavaLangString());
       break;
     case Instruction::CONST_STRING_JUMBO:
-      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_31c(), reg_types_.JavaLangString());
+      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_31c(), reg_types_->JavaLangString());
       break;
     case Instruction::CONST_CLASS: {
       // Get type from instruction if unresolved then we need an access check
@@ -2251,16 +2313,16 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       // Register holds class, ie its type is class, on error it will hold Conflict.
       work_line_->SetRegisterType<LockOp::kClear>(
           inst->VRegA_21c(),
-          res_type.IsConflict() ? res_type : reg_types_.JavaLangClass());
+          res_type.IsConflict() ? res_type : reg_types_->JavaLangClass());
       break;
     }
     case Instruction::CONST_METHOD_HANDLE:
       work_line_->SetRegisterType<LockOp::kClear>(
-          inst->VRegA_21c(), reg_types_.JavaLangInvokeMethodHandle());
+          inst->VRegA_21c(), reg_types_->JavaLangInvokeMethodHandle());
       break;
     case Instruction::CONST_METHOD_TYPE:
       work_line_->SetRegisterType<LockOp::kClear>(
-          inst->VRegA_21c(), reg_types_.JavaLangInvokeMethodType());
+          inst->VRegA_21c(), reg_types_->JavaLangInvokeMethodType());
       break;
     case Instruction::MONITOR_ENTER:
       work_line_->PushMonitor(this, inst->VRegA_11x(), work_insn_idx_);
@@ -2379,7 +2441,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
 
         DCHECK_NE(failures_.size(), 0U);
         if (!is_checkcast) {
-          work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_22c(), reg_types_.Boolean());
+          work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_22c(), reg_types_->Boolean());
         }
         break;  // bad class
       }
@@ -2410,7 +2472,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
         if (is_checkcast) {
           work_line_->SetRegisterType<LockOp::kKeep>(inst->VRegA_21c(), res_type);
         } else {
-          work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_22c(), reg_types_.Boolean());
+          work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_22c(), reg_types_->Boolean());
         }
       }
       break;
@@ -2422,7 +2484,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
           // ie not an array or null
           Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "array-length on non-array " << res_type;
         } else {
-          work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_12x(), reg_types_.Integer());
+          work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_12x(), reg_types_->Integer());
         }
       } else {
         Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "array-length on non-array " << res_type;
@@ -2442,7 +2504,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
             << "new-instance on primitive, interface or abstract class" << res_type;
         // Soft failure so carry on to set register type.
       }
-      const RegType& uninit_type = reg_types_.Uninitialized(res_type, work_insn_idx_);
+      const RegType& uninit_type = reg_types_->Uninitialized(res_type, work_insn_idx_);
       // Any registers holding previous allocations from this address that have not yet been
       // initialized must be marked invalid.
       work_line_->MarkUninitRefsAsInvalid(this, uninit_type);
@@ -2463,40 +2525,40 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       break;
     case Instruction::CMPL_FLOAT:
     case Instruction::CMPG_FLOAT:
-      if (!work_line_->VerifyRegisterType(this, inst->VRegB_23x(), reg_types_.Float())) {
+      if (!work_line_->VerifyRegisterType(this, inst->VRegB_23x(), reg_types_->Float())) {
         break;
       }
-      if (!work_line_->VerifyRegisterType(this, inst->VRegC_23x(), reg_types_.Float())) {
+      if (!work_line_->VerifyRegisterType(this, inst->VRegC_23x(), reg_types_->Float())) {
         break;
       }
-      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_.Integer());
+      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_->Integer());
       break;
     case Instruction::CMPL_DOUBLE:
     case Instruction::CMPG_DOUBLE:
-      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegB_23x(), reg_types_.DoubleLo(),
-                                              reg_types_.DoubleHi())) {
+      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegB_23x(), reg_types_->DoubleLo(),
+                                              reg_types_->DoubleHi())) {
         break;
       }
-      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegC_23x(), reg_types_.DoubleLo(),
-                                              reg_types_.DoubleHi())) {
+      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegC_23x(), reg_types_->DoubleLo(),
+                                              reg_types_->DoubleHi())) {
         break;
       }
-      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_.Integer());
+      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_->Integer());
       break;
     case Instruction::CMP_LONG:
-      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegB_23x(), reg_types_.LongLo(),
-                                              reg_types_.LongHi())) {
+      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegB_23x(), reg_types_->LongLo(),
+                                              reg_types_->LongHi())) {
         break;
       }
-      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegC_23x(), reg_types_.LongLo(),
-                                              reg_types_.LongHi())) {
+      if (!work_line_->VerifyRegisterTypeWide(this, inst->VRegC_23x(), reg_types_->LongLo(),
+                                              reg_types_->LongHi())) {
         break;
       }
-      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_.Integer());
+      work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_->Integer());
       break;
     case Instruction::THROW: {
       const RegType& res_type = work_line_->GetRegisterType(this, inst->VRegA_11x());
-      if (!reg_types_.JavaLangThrowable().IsAssignableFrom(res_type, this)) {
+      if (!reg_types_->JavaLangThrowable().IsAssignableFrom(res_type, this)) {
         if (res_type.IsUninitializedTypes()) {
           Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "thrown exception not initialized";
         } else if (!res_type.IsReferenceTypes()) {
@@ -2518,7 +2580,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
     case Instruction::PACKED_SWITCH:
     case Instruction::SPARSE_SWITCH:
       /* verify that vAA is an integer, or can be converted to one */
-      work_line_->VerifyRegisterType(this, inst->VRegA_31t(), reg_types_.Integer());
+      work_line_->VerifyRegisterType(this, inst->VRegA_31t(), reg_types_->Integer());
       break;
 
     case Instruction::FILL_ARRAY_DATA: {
@@ -2534,7 +2596,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
           Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "invalid fill-array-data for array of type "
                                             << array_type;
         } else {
-          const RegType& component_type = reg_types_.GetComponentType(array_type, class_loader_);
+          const RegType& component_type = reg_types_->GetComponentType(array_type, class_loader_);
           DCHECK(!component_type.IsConflict());
           if (component_type.IsNonZeroReferenceTypes()) {
             Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "invalid fill-array-data with component type "
@@ -2650,7 +2712,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
             !cast_type.GetClass()->IsInterface() &&
             !orig_type.IsZeroOrNull() &&
             orig_type.IsStrictlyAssignableFrom(
-                cast_type.Merge(orig_type, &reg_types_, this), this)) {
+                cast_type.Merge(orig_type, reg_types_, this), this)) {
           RegisterLine* update_line = RegisterLine::Create(code_item_accessor_.RegistersSize(),
                                                            allocator_,
                                                            GetRegTypeCache());
@@ -2712,138 +2774,138 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       break;
     }
     case Instruction::AGET_BOOLEAN:
-      VerifyAGet(inst, reg_types_.Boolean(), true);
+      VerifyAGet(inst, reg_types_->Boolean(), true);
       break;
     case Instruction::AGET_BYTE:
-      VerifyAGet(inst, reg_types_.Byte(), true);
+      VerifyAGet(inst, reg_types_->Byte(), true);
       break;
     case Instruction::AGET_CHAR:
-      VerifyAGet(inst, reg_types_.Char(), true);
+      VerifyAGet(inst, reg_types_->Char(), true);
       break;
     case Instruction::AGET_SHORT:
-      VerifyAGet(inst, reg_types_.Short(), true);
+      VerifyAGet(inst, reg_types_->Short(), true);
       break;
     case Instruction::AGET:
-      VerifyAGet(inst, reg_types_.Integer(), true);
+      VerifyAGet(inst, reg_types_->Integer(), true);
       break;
     case Instruction::AGET_WIDE:
-      VerifyAGet(inst, reg_types_.LongLo(), true);
+      VerifyAGet(inst, reg_types_->LongLo(), true);
       break;
     case Instruction::AGET_OBJECT:
-      VerifyAGet(inst, reg_types_.JavaLangObject(false), false);
+      VerifyAGet(inst, reg_types_->JavaLangObject(false), false);
       break;
 
     case Instruction::APUT_BOOLEAN:
-      VerifyAPut(inst, reg_types_.Boolean(), true);
+      VerifyAPut(inst, reg_types_->Boolean(), true);
       break;
     case Instruction::APUT_BYTE:
-      VerifyAPut(inst, reg_types_.Byte(), true);
+      VerifyAPut(inst, reg_types_->Byte(), true);
       break;
     case Instruction::APUT_CHAR:
-      VerifyAPut(inst, reg_types_.Char(), true);
+      VerifyAPut(inst, reg_types_->Char(), true);
       break;
     case Instruction::APUT_SHORT:
-      VerifyAPut(inst, reg_types_.Short(), true);
+      VerifyAPut(inst, reg_types_->Short(), true);
       break;
     case Instruction::APUT:
-      VerifyAPut(inst, reg_types_.Integer(), true);
+      VerifyAPut(inst, reg_types_->Integer(), true);
       break;
     case Instruction::APUT_WIDE:
-      VerifyAPut(inst, reg_types_.LongLo(), true);
+      VerifyAPut(inst, reg_types_->LongLo(), true);
       break;
     case Instruction::APUT_OBJECT:
-      VerifyAPut(inst, reg_types_.JavaLangObject(false), false);
+      VerifyAPut(inst, reg_types_->JavaLangObject(false), false);
       break;
 
     case Instruction::IGET_BOOLEAN:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Boolean(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Boolean(), true, false);
       break;
     case Instruction::IGET_BYTE:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Byte(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Byte(), true, false);
       break;
     case Instruction::IGET_CHAR:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Char(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Char(), true, false);
       break;
     case Instruction::IGET_SHORT:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Short(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Short(), true, false);
       break;
     case Instruction::IGET:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Integer(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Integer(), true, false);
       break;
     case Instruction::IGET_WIDE:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.LongLo(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->LongLo(), true, false);
       break;
     case Instruction::IGET_OBJECT:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.JavaLangObject(false), false,
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->JavaLangObject(false), false,
                                                     false);
       break;
 
     case Instruction::IPUT_BOOLEAN:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Boolean(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Boolean(), true, false);
       break;
     case Instruction::IPUT_BYTE:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Byte(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Byte(), true, false);
       break;
     case Instruction::IPUT_CHAR:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Char(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Char(), true, false);
       break;
     case Instruction::IPUT_SHORT:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Short(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Short(), true, false);
       break;
     case Instruction::IPUT:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Integer(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Integer(), true, false);
       break;
     case Instruction::IPUT_WIDE:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.LongLo(), true, false);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->LongLo(), true, false);
       break;
     case Instruction::IPUT_OBJECT:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.JavaLangObject(false), false,
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->JavaLangObject(false), false,
                                                     false);
       break;
 
     case Instruction::SGET_BOOLEAN:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Boolean(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Boolean(), true, true);
       break;
     case Instruction::SGET_BYTE:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Byte(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Byte(), true, true);
       break;
     case Instruction::SGET_CHAR:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Char(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Char(), true, true);
       break;
     case Instruction::SGET_SHORT:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Short(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Short(), true, true);
       break;
     case Instruction::SGET:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.Integer(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->Integer(), true, true);
       break;
     case Instruction::SGET_WIDE:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.LongLo(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->LongLo(), true, true);
       break;
     case Instruction::SGET_OBJECT:
-      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_.JavaLangObject(false), false,
+      VerifyISFieldAccess<FieldAccessType::kAccGet>(inst, reg_types_->JavaLangObject(false), false,
                                                     true);
       break;
 
     case Instruction::SPUT_BOOLEAN:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Boolean(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Boolean(), true, true);
       break;
     case Instruction::SPUT_BYTE:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Byte(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Byte(), true, true);
       break;
     case Instruction::SPUT_CHAR:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Char(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Char(), true, true);
       break;
     case Instruction::SPUT_SHORT:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Short(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Short(), true, true);
       break;
     case Instruction::SPUT:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.Integer(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->Integer(), true, true);
       break;
     case Instruction::SPUT_WIDE:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.LongLo(), true, true);
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->LongLo(), true, true);
       break;
     case Instruction::SPUT_OBJECT:
-      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_.JavaLangObject(false), false,
+      VerifyISFieldAccess<FieldAccessType::kAccPut>(inst, reg_types_->JavaLangObject(false), false,
                                                     true);
       break;
 
@@ -2877,12 +2939,12 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
         dex::TypeIndex return_type_idx =
             dex_file_->GetProtoId(method_id.proto_idx_).return_type_idx_;
         const char* descriptor = dex_file_->GetTypeDescriptor(return_type_idx);
-        return_type = &reg_types_.FromDescriptor(class_loader_, descriptor);
+        return_type = &reg_types_->FromDescriptor(class_loader_, descriptor);
       }
       if (!return_type->IsLowHalf()) {
         work_line_->SetResultRegisterType(this, *return_type);
       } else {
-        work_line_->SetResultRegisterTypeWide(*return_type, return_type->HighHalf(&reg_types_));
+        work_line_->SetResultRegisterTypeWide(*return_type, return_type->HighHalf(reg_types_));
       }
       just_set_result = true;
       break;
@@ -2935,7 +2997,7 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
         }
 
         /* must be in same class or in superclass */
-        // const RegType& this_super_klass = this_type.GetSuperClass(&reg_types_);
+        // const RegType& this_super_klass = this_type.GetSuperClass(reg_types_);
         // TODO: re-enable constructor type verification
         // if (this_super_klass.IsConflict()) {
           // Unknown super class, fail so we re-check at runtime.
@@ -2957,12 +3019,12 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
         work_line_->MarkRefsAsInitialized(this, this_type);
       }
       if (return_type == nullptr) {
-        return_type = &reg_types_.FromDescriptor(class_loader_, return_type_descriptor);
+        return_type = &reg_types_->FromDescriptor(class_loader_, return_type_descriptor);
       }
       if (!return_type->IsLowHalf()) {
         work_line_->SetResultRegisterType(this, *return_type);
       } else {
-        work_line_->SetResultRegisterTypeWide(*return_type, return_type->HighHalf(&reg_types_));
+        work_line_->SetResultRegisterTypeWide(*return_type, return_type->HighHalf(reg_types_));
       }
       just_set_result = true;
       break;
@@ -2981,11 +3043,11 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
         } else {
           descriptor = called_method->GetReturnTypeDescriptor();
         }
-        const RegType& return_type = reg_types_.FromDescriptor(class_loader_, descriptor);
+        const RegType& return_type = reg_types_->FromDescriptor(class_loader_, descriptor);
         if (!return_type.IsLowHalf()) {
           work_line_->SetResultRegisterType(this, return_type);
         } else {
-          work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(&reg_types_));
+          work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(reg_types_));
         }
         just_set_result = true;
       }
@@ -3036,11 +3098,11 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       } else {
         descriptor = abs_method->GetReturnTypeDescriptor();
       }
-      const RegType& return_type = reg_types_.FromDescriptor(class_loader_, descriptor);
+      const RegType& return_type = reg_types_->FromDescriptor(class_loader_, descriptor);
       if (!return_type.IsLowHalf()) {
         work_line_->SetResultRegisterType(this, return_type);
       } else {
-        work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(&reg_types_));
+        work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(reg_types_));
       }
       just_set_result = true;
       break;
@@ -3069,11 +3131,11 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       const char* return_descriptor =
           dex_file_->GetReturnTypeDescriptor(dex_file_->GetProtoId(proto_idx));
       const RegType& return_type =
-          reg_types_.FromDescriptor(class_loader_, return_descriptor);
+          reg_types_->FromDescriptor(class_loader_, return_descriptor);
       if (!return_type.IsLowHalf()) {
         work_line_->SetResultRegisterType(this, return_type);
       } else {
-        work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(&reg_types_));
+        work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(reg_types_));
       }
       just_set_result = true;
       break;
@@ -3102,85 +3164,85 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
 
       // Step 3. Propagate return type information
       const RegType& return_type =
-          reg_types_.FromDescriptor(class_loader_, return_descriptor);
+          reg_types_->FromDescriptor(class_loader_, return_descriptor);
       if (!return_type.IsLowHalf()) {
         work_line_->SetResultRegisterType(this, return_type);
       } else {
-        work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(&reg_types_));
+        work_line_->SetResultRegisterTypeWide(return_type, return_type.HighHalf(reg_types_));
       }
       just_set_result = true;
       break;
     }
     case Instruction::NEG_INT:
     case Instruction::NOT_INT:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Integer(), reg_types_.Integer());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Integer(), reg_types_->Integer());
       break;
     case Instruction::NEG_LONG:
     case Instruction::NOT_LONG:
-      work_line_->CheckUnaryOpWide(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                   reg_types_.LongLo(), reg_types_.LongHi());
+      work_line_->CheckUnaryOpWide(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                   reg_types_->LongLo(), reg_types_->LongHi());
       break;
     case Instruction::NEG_FLOAT:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Float(), reg_types_.Float());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Float(), reg_types_->Float());
       break;
     case Instruction::NEG_DOUBLE:
-      work_line_->CheckUnaryOpWide(this, inst, reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                   reg_types_.DoubleLo(), reg_types_.DoubleHi());
+      work_line_->CheckUnaryOpWide(this, inst, reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                   reg_types_->DoubleLo(), reg_types_->DoubleHi());
       break;
     case Instruction::INT_TO_LONG:
-      work_line_->CheckUnaryOpToWide(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                     reg_types_.Integer());
+      work_line_->CheckUnaryOpToWide(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                     reg_types_->Integer());
       break;
     case Instruction::INT_TO_FLOAT:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Float(), reg_types_.Integer());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Float(), reg_types_->Integer());
       break;
     case Instruction::INT_TO_DOUBLE:
-      work_line_->CheckUnaryOpToWide(this, inst, reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                     reg_types_.Integer());
+      work_line_->CheckUnaryOpToWide(this, inst, reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                     reg_types_->Integer());
       break;
     case Instruction::LONG_TO_INT:
-      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_.Integer(),
-                                       reg_types_.LongLo(), reg_types_.LongHi());
+      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_->Integer(),
+                                       reg_types_->LongLo(), reg_types_->LongHi());
       break;
     case Instruction::LONG_TO_FLOAT:
-      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_.Float(),
-                                       reg_types_.LongLo(), reg_types_.LongHi());
+      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_->Float(),
+                                       reg_types_->LongLo(), reg_types_->LongHi());
       break;
     case Instruction::LONG_TO_DOUBLE:
-      work_line_->CheckUnaryOpWide(this, inst, reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                   reg_types_.LongLo(), reg_types_.LongHi());
+      work_line_->CheckUnaryOpWide(this, inst, reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                   reg_types_->LongLo(), reg_types_->LongHi());
       break;
     case Instruction::FLOAT_TO_INT:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Integer(), reg_types_.Float());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Integer(), reg_types_->Float());
       break;
     case Instruction::FLOAT_TO_LONG:
-      work_line_->CheckUnaryOpToWide(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                     reg_types_.Float());
+      work_line_->CheckUnaryOpToWide(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                     reg_types_->Float());
       break;
     case Instruction::FLOAT_TO_DOUBLE:
-      work_line_->CheckUnaryOpToWide(this, inst, reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                     reg_types_.Float());
+      work_line_->CheckUnaryOpToWide(this, inst, reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                     reg_types_->Float());
       break;
     case Instruction::DOUBLE_TO_INT:
-      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_.Integer(),
-                                       reg_types_.DoubleLo(), reg_types_.DoubleHi());
+      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_->Integer(),
+                                       reg_types_->DoubleLo(), reg_types_->DoubleHi());
       break;
     case Instruction::DOUBLE_TO_LONG:
-      work_line_->CheckUnaryOpWide(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                   reg_types_.DoubleLo(), reg_types_.DoubleHi());
+      work_line_->CheckUnaryOpWide(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                   reg_types_->DoubleLo(), reg_types_->DoubleHi());
       break;
     case Instruction::DOUBLE_TO_FLOAT:
-      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_.Float(),
-                                       reg_types_.DoubleLo(), reg_types_.DoubleHi());
+      work_line_->CheckUnaryOpFromWide(this, inst, reg_types_->Float(),
+                                       reg_types_->DoubleLo(), reg_types_->DoubleHi());
       break;
     case Instruction::INT_TO_BYTE:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Byte(), reg_types_.Integer());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Byte(), reg_types_->Integer());
       break;
     case Instruction::INT_TO_CHAR:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Char(), reg_types_.Integer());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Char(), reg_types_->Integer());
       break;
     case Instruction::INT_TO_SHORT:
-      work_line_->CheckUnaryOp(this, inst, reg_types_.Short(), reg_types_.Integer());
+      work_line_->CheckUnaryOp(this, inst, reg_types_->Short(), reg_types_->Integer());
       break;
 
     case Instruction::ADD_INT:
@@ -3191,14 +3253,14 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
     case Instruction::SHL_INT:
     case Instruction::SHR_INT:
     case Instruction::USHR_INT:
-      work_line_->CheckBinaryOp(this, inst, reg_types_.Integer(), reg_types_.Integer(),
-                                reg_types_.Integer(), false);
+      work_line_->CheckBinaryOp(this, inst, reg_types_->Integer(), reg_types_->Integer(),
+                                reg_types_->Integer(), false);
       break;
     case Instruction::AND_INT:
     case Instruction::OR_INT:
     case Instruction::XOR_INT:
-      work_line_->CheckBinaryOp(this, inst, reg_types_.Integer(), reg_types_.Integer(),
-                                reg_types_.Integer(), true);
+      work_line_->CheckBinaryOp(this, inst, reg_types_->Integer(), reg_types_->Integer(),
+                                reg_types_->Integer(), true);
       break;
     case Instruction::ADD_LONG:
     case Instruction::SUB_LONG:
@@ -3208,33 +3270,33 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
     case Instruction::AND_LONG:
     case Instruction::OR_LONG:
     case Instruction::XOR_LONG:
-      work_line_->CheckBinaryOpWide(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                    reg_types_.LongLo(), reg_types_.LongHi(),
-                                    reg_types_.LongLo(), reg_types_.LongHi());
+      work_line_->CheckBinaryOpWide(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                    reg_types_->LongLo(), reg_types_->LongHi(),
+                                    reg_types_->LongLo(), reg_types_->LongHi());
       break;
     case Instruction::SHL_LONG:
     case Instruction::SHR_LONG:
     case Instruction::USHR_LONG:
       /* shift distance is Int, making these different from other binary operations */
-      work_line_->CheckBinaryOpWideShift(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                         reg_types_.Integer());
+      work_line_->CheckBinaryOpWideShift(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                         reg_types_->Integer());
       break;
     case Instruction::ADD_FLOAT:
     case Instruction::SUB_FLOAT:
     case Instruction::MUL_FLOAT:
     case Instruction::DIV_FLOAT:
     case Instruction::REM_FLOAT:
-      work_line_->CheckBinaryOp(this, inst, reg_types_.Float(), reg_types_.Float(),
-                                reg_types_.Float(), false);
+      work_line_->CheckBinaryOp(this, inst, reg_types_->Float(), reg_types_->Float(),
+                                reg_types_->Float(), false);
       break;
     case Instruction::ADD_DOUBLE:
     case Instruction::SUB_DOUBLE:
     case Instruction::MUL_DOUBLE:
     case Instruction::DIV_DOUBLE:
     case Instruction::REM_DOUBLE:
-      work_line_->CheckBinaryOpWide(this, inst, reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                    reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                    reg_types_.DoubleLo(), reg_types_.DoubleHi());
+      work_line_->CheckBinaryOpWide(this, inst, reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                    reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                    reg_types_->DoubleLo(), reg_types_->DoubleHi());
       break;
     case Instruction::ADD_INT_2ADDR:
     case Instruction::SUB_INT_2ADDR:
@@ -3243,18 +3305,18 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
     case Instruction::SHL_INT_2ADDR:
     case Instruction::SHR_INT_2ADDR:
     case Instruction::USHR_INT_2ADDR:
-      work_line_->CheckBinaryOp2addr(this, inst, reg_types_.Integer(), reg_types_.Integer(),
-                                     reg_types_.Integer(), false);
+      work_line_->CheckBinaryOp2addr(this, inst, reg_types_->Integer(), reg_types_->Integer(),
+                                     reg_types_->Integer(), false);
       break;
     case Instruction::AND_INT_2ADDR:
     case Instruction::OR_INT_2ADDR:
     case Instruction::XOR_INT_2ADDR:
-      work_line_->CheckBinaryOp2addr(this, inst, reg_types_.Integer(), reg_types_.Integer(),
-                                     reg_types_.Integer(), true);
+      work_line_->CheckBinaryOp2addr(this, inst, reg_types_->Integer(), reg_types_->Integer(),
+                                     reg_types_->Integer(), true);
       break;
     case Instruction::DIV_INT_2ADDR:
-      work_line_->CheckBinaryOp2addr(this, inst, reg_types_.Integer(), reg_types_.Integer(),
-                                     reg_types_.Integer(), false);
+      work_line_->CheckBinaryOp2addr(this, inst, reg_types_->Integer(), reg_types_->Integer(),
+                                     reg_types_->Integer(), false);
       break;
     case Instruction::ADD_LONG_2ADDR:
     case Instruction::SUB_LONG_2ADDR:
@@ -3264,45 +3326,48 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
     case Instruction::AND_LONG_2ADDR:
     case Instruction::OR_LONG_2ADDR:
     case Instruction::XOR_LONG_2ADDR:
-      work_line_->CheckBinaryOp2addrWide(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                         reg_types_.LongLo(), reg_types_.LongHi(),
-                                         reg_types_.LongLo(), reg_types_.LongHi());
+      work_line_->CheckBinaryOp2addrWide(this, inst, reg_types_->LongLo(), reg_types_->LongHi(),
+                                         reg_types_->LongLo(), reg_types_->LongHi(),
+                                         reg_types_->LongLo(), reg_types_->LongHi());
       break;
     case Instruction::SHL_LONG_2ADDR:
     case Instruction::SHR_LONG_2ADDR:
     case Instruction::USHR_LONG_2ADDR:
-      work_line_->CheckBinaryOp2addrWideShift(this, inst, reg_types_.LongLo(), reg_types_.LongHi(),
-                                              reg_types_.Integer());
+      work_line_->CheckBinaryOp2addrWideShift(this,
+                                              inst,
+                                              reg_types_->LongLo(),
+                                              reg_types_->LongHi(),
+                                              reg_types_->Integer());
       break;
     case Instruction::ADD_FLOAT_2ADDR:
     case Instruction::SUB_FLOAT_2ADDR:
     case Instruction::MUL_FLOAT_2ADDR:
     case Instruction::DIV_FLOAT_2ADDR:
     case Instruction::REM_FLOAT_2ADDR:
-      work_line_->CheckBinaryOp2addr(this, inst, reg_types_.Float(), reg_types_.Float(),
-                                     reg_types_.Float(), false);
+      work_line_->CheckBinaryOp2addr(this, inst, reg_types_->Float(), reg_types_->Float(),
+                                     reg_types_->Float(), false);
       break;
     case Instruction::ADD_DOUBLE_2ADDR:
     case Instruction::SUB_DOUBLE_2ADDR:
     case Instruction::MUL_DOUBLE_2ADDR:
     case Instruction::DIV_DOUBLE_2ADDR:
     case Instruction::REM_DOUBLE_2ADDR:
-      work_line_->CheckBinaryOp2addrWide(this, inst, reg_types_.DoubleLo(), reg_types_.DoubleHi(),
-                                         reg_types_.DoubleLo(),  reg_types_.DoubleHi(),
-                                         reg_types_.DoubleLo(), reg_types_.DoubleHi());
+      work_line_->CheckBinaryOp2addrWide(this, inst, reg_types_->DoubleLo(), reg_types_->DoubleHi(),
+                                         reg_types_->DoubleLo(),  reg_types_->DoubleHi(),
+                                         reg_types_->DoubleLo(), reg_types_->DoubleHi());
       break;
     case Instruction::ADD_INT_LIT16:
     case Instruction::RSUB_INT_LIT16:
     case Instruction::MUL_INT_LIT16:
     case Instruction::DIV_INT_LIT16:
     case Instruction::REM_INT_LIT16:
-      work_line_->CheckLiteralOp(this, inst, reg_types_.Integer(), reg_types_.Integer(), false,
+      work_line_->CheckLiteralOp(this, inst, reg_types_->Integer(), reg_types_->Integer(), false,
                                  true);
       break;
     case Instruction::AND_INT_LIT16:
     case Instruction::OR_INT_LIT16:
     case Instruction::XOR_INT_LIT16:
-      work_line_->CheckLiteralOp(this, inst, reg_types_.Integer(), reg_types_.Integer(), true,
+      work_line_->CheckLiteralOp(this, inst, reg_types_->Integer(), reg_types_->Integer(), true,
                                  true);
       break;
     case Instruction::ADD_INT_LIT8:
@@ -3313,13 +3378,13 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
     case Instruction::SHL_INT_LIT8:
     case Instruction::SHR_INT_LIT8:
     case Instruction::USHR_INT_LIT8:
-      work_line_->CheckLiteralOp(this, inst, reg_types_.Integer(), reg_types_.Integer(), false,
+      work_line_->CheckLiteralOp(this, inst, reg_types_->Integer(), reg_types_->Integer(), false,
                                  false);
       break;
     case Instruction::AND_INT_LIT8:
     case Instruction::OR_INT_LIT8:
     case Instruction::XOR_INT_LIT8:
-      work_line_->CheckLiteralOp(this, inst, reg_types_.Integer(), reg_types_.Integer(), true,
+      work_line_->CheckLiteralOp(this, inst, reg_types_->Integer(), reg_types_->Integer(), true,
                                  false);
       break;
 
@@ -3537,7 +3602,9 @@ bool MethodVerifier<kVerifierDebug>::CodeFlowVerifyInstruction(uint32_t* start_g
       const Instruction* ret_inst = &code_item_accessor_.InstructionAt(next_insn_idx);
       AdjustReturnLine(this, ret_inst, work_line_.get());
     }
-    RegisterLine* next_line = reg_table_.GetLine(next_insn_idx);
+    // There is no register line table for straight-line methods.
+    RegisterLine* next_line =
+        reg_table_.IsInitialized() ? reg_table_.GetLine(next_insn_idx) : nullptr;
     if (next_line != nullptr) {
       // Merge registers into what we have for the next instruction, and set the "changed" flag if
       // needed. If the merge changes the state of the registers then the work line will be
@@ -3604,14 +3671,14 @@ const RegType& MethodVerifier<kVerifierDebug>::ResolveClass(dex::TypeIndex class
       UninstantiableError(descriptor);
       precise = false;
     }
-    result = reg_types_.FindClass(klass, precise);
+    result = reg_types_->FindClass(klass, precise);
     if (result == nullptr) {
       const char* descriptor = dex_file_->GetTypeDescriptor(class_idx);
-      result = reg_types_.InsertClass(descriptor, klass, precise);
+      result = reg_types_->InsertClass(descriptor, klass, precise);
     }
   } else {
     const char* descriptor = dex_file_->GetTypeDescriptor(class_idx);
-    result = &reg_types_.FromDescriptor(class_loader_, descriptor);
+    result = &reg_types_->FromDescriptor(class_loader_, descriptor);
   }
   DCHECK(result != nullptr);
   if (result->IsConflict()) {
@@ -3670,31 +3737,31 @@ bool MethodVerifier<kVerifierDebug>::HandleMoveException(const Instruction* inst
         for (; iterator.HasNext(); iterator.Next()) {
           if (iterator.GetHandlerAddress() == (uint32_t) work_insn_idx_) {
             if (!iterator.GetHandlerTypeIndex().IsValid()) {
-              common_super = &reg_types_.JavaLangThrowable();
+              common_super = &reg_types_->JavaLangThrowable();
             } else {
               // Do access checks only on resolved exception classes.
               const RegType& exception =
                   ResolveClass<CheckAccess::kOnResolvedClass>(iterator.GetHandlerTypeIndex());
-              if (!reg_types_.JavaLangThrowable().IsAssignableFrom(exception, this)) {
+              if (!reg_types_->JavaLangThrowable().IsAssignableFrom(exception, this)) {
                 DCHECK(!exception.IsUninitializedTypes());  // Comes from dex, shouldn't be uninit.
                 if (exception.IsUnresolvedTypes()) {
                   if (unresolved == nullptr) {
                     unresolved = &exception;
                   } else {
-                    unresolved = &unresolved->SafeMerge(exception, &reg_types_, this);
+                    unresolved = &unresolved->SafeMerge(exception, reg_types_, this);
                   }
                 } else {
                   Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "unexpected non-throwable class "
                                                     << exception;
-                  return std::make_pair(true, &reg_types_.Conflict());
+                  return std::make_pair(true, &reg_types_->Conflict());
                 }
               } else if (common_super == nullptr) {
                 common_super = &exception;
               } else if (common_super->Equals(exception)) {
                 // odd case, but nothing to do
               } else {
-                common_super = &common_super->Merge(exception, &reg_types_, this);
-                if (FailOrAbort(reg_types_.JavaLangThrowable().IsAssignableFrom(
+                common_super = &common_super->Merge(exception, reg_types_, this);
+                if (FailOrAbort(reg_types_->JavaLangThrowable().IsAssignableFrom(
                     *common_super, this),
                     "java.lang.Throwable is not assignable-from common_super at ",
                     work_insn_idx_)) {
@@ -3712,7 +3779,7 @@ bool MethodVerifier<kVerifierDebug>::HandleMoveException(const Instruction* inst
             << "Unresolved catch handler";
         bool should_continue = true;
         if (common_super != nullptr) {
-          unresolved = &unresolved->Merge(*common_super, &reg_types_, this);
+          unresolved = &unresolved->Merge(*common_super, reg_types_, this);
         } else {
           should_continue = !PotentiallyMarkRuntimeThrow();
         }
@@ -3722,7 +3789,7 @@ bool MethodVerifier<kVerifierDebug>::HandleMoveException(const Instruction* inst
     if (common_super == nullptr) {
       /* No catch block */
       Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "unable to find exception handler";
-      return std::make_pair(true, &reg_types_.Conflict());
+      return std::make_pair(true, &reg_types_->Conflict());
     }
     return std::make_pair(true, common_super);
   };
@@ -3935,7 +4002,7 @@ ArtMethod* MethodVerifier<kVerifierDebug>::VerifyInvocationArgsFromIterator(
         const uint32_t method_idx = GetMethodIdxOfInvoke(inst);
         const dex::TypeIndex class_idx = dex_file_->GetMethodId(method_idx).class_idx_;
         res_method_class =
-            &reg_types_.FromDescriptor(class_loader_, dex_file_->GetTypeDescriptor(class_idx));
+            &reg_types_->FromDescriptor(class_loader_, dex_file_->GetTypeDescriptor(class_idx));
       }
       if (!res_method_class->IsAssignableFrom(adjusted_type, this)) {
         Fail(adjusted_type.IsUnresolvedTypes()
@@ -3972,7 +4039,7 @@ ArtMethod* MethodVerifier<kVerifierDebug>::VerifyInvocationArgsFromIterator(
       return nullptr;
     }
 
-    const RegType& reg_type = reg_types_.FromDescriptor(class_loader_, param_descriptor);
+    const RegType& reg_type = reg_types_->FromDescriptor(class_loader_, param_descriptor);
     uint32_t get_reg = is_range ? inst->VRegC() + static_cast<uint32_t>(sig_registers) :
         arg[sig_registers];
     if (reg_type.IsIntegralTypes()) {
@@ -4129,7 +4196,7 @@ ArtMethod* MethodVerifier<kVerifierDebug>::VerifyInvocationArgs(
   if (method_type == METHOD_SUPER) {
     dex::TypeIndex class_idx = dex_file_->GetMethodId(method_idx).class_idx_;
     const RegType& reference_type =
-        reg_types_.FromDescriptor(class_loader_, dex_file_->GetTypeDescriptor(class_idx));
+        reg_types_->FromDescriptor(class_loader_, dex_file_->GetTypeDescriptor(class_idx));
     if (reference_type.IsUnresolvedTypes()) {
       // We cannot differentiate on whether this is a class change error or just
       // a missing method. This will be handled at runtime.
@@ -4154,7 +4221,7 @@ ArtMethod* MethodVerifier<kVerifierDebug>::VerifyInvocationArgs(
         return nullptr;
       }
     } else {
-      const RegType& super = GetDeclaringClass().GetSuperClass(&reg_types_);
+      const RegType& super = GetDeclaringClass().GetSuperClass(reg_types_);
       if (super.IsUnresolvedTypes()) {
         Fail(VERIFY_ERROR_NO_METHOD) << "unknown super class in invoke-super from "
                                     << dex_file_->PrettyMethod(dex_method_idx_)
@@ -4294,15 +4361,15 @@ void MethodVerifier<kVerifierDebug>::VerifyNewArray(const Instruction* inst,
       Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "new-array on non-array class " << res_type;
     } else if (!is_filled) {
       /* make sure "size" register is valid type */
-      work_line_->VerifyRegisterType(this, inst->VRegB_22c(), reg_types_.Integer());
+      work_line_->VerifyRegisterType(this, inst->VRegB_22c(), reg_types_->Integer());
       /* set register type to array class */
-      const RegType& precise_type = reg_types_.FromUninitialized(res_type);
+      const RegType& precise_type = reg_types_->FromUninitialized(res_type);
       work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_22c(), precise_type);
     } else {
       DCHECK(!res_type.IsUnresolvedMergedReference());
       // Verify each register. If "arg_count" is bad, VerifyRegisterType() will run off the end of
       // the list and fail. It's legal, if silly, for arg_count to be zero.
-      const RegType& expected_type = reg_types_.GetComponentType(res_type, class_loader_);
+      const RegType& expected_type = reg_types_->GetComponentType(res_type, class_loader_);
       uint32_t arg_count = (is_range) ? inst->VRegA_3rc() : inst->VRegA_35c();
       uint32_t arg[5];
       if (!is_range) {
@@ -4317,7 +4384,7 @@ void MethodVerifier<kVerifierDebug>::VerifyNewArray(const Instruction* inst,
         }
       }
       // filled-array result goes into "result" register
-      const RegType& precise_type = reg_types_.FromUninitialized(res_type);
+      const RegType& precise_type = reg_types_->FromUninitialized(res_type);
       work_line_->SetResultRegisterType(this, precise_type);
     }
   }
@@ -4336,7 +4403,7 @@ void MethodVerifier<kVerifierDebug>::VerifyAGet(const Instruction* inst,
       // Null array class; this code path will fail at runtime. Infer a merge-able type from the
       // instruction type.
       if (!is_primitive) {
-        work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_.Null());
+        work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), reg_types_->Null());
       } else if (insn_type.IsInteger()) {
         // Pick a non-zero constant (to distinguish with null) that can fit in any primitive.
         // We cannot use 'insn_type' as it could be a float array or an int array.
@@ -4348,8 +4415,8 @@ void MethodVerifier<kVerifierDebug>::VerifyAGet(const Instruction* inst,
       } else {
         // Category 2
         work_line_->SetRegisterTypeWide(inst->VRegA_23x(),
-                                        reg_types_.FromCat2ConstLo(0, false),
-                                        reg_types_.FromCat2ConstHi(0, false));
+                                        reg_types_->FromCat2ConstLo(0, false),
+                                        reg_types_->FromCat2ConstHi(0, false));
       }
     } else if (!array_type.IsArrayTypes()) {
       Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "not array type " << array_type << " with aget";
@@ -4363,11 +4430,11 @@ void MethodVerifier<kVerifierDebug>::VerifyAGet(const Instruction* inst,
             << " because of missing class";
         // Approximate with java.lang.Object[].
         work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(),
-                                                    reg_types_.JavaLangObject(false));
+                                                    reg_types_->JavaLangObject(false));
       }
     } else {
       /* verify the class */
-      const RegType& component_type = reg_types_.GetComponentType(array_type, class_loader_);
+      const RegType& component_type = reg_types_->GetComponentType(array_type, class_loader_);
       if (!component_type.IsReferenceTypes() && !is_primitive) {
         Fail(VERIFY_ERROR_BAD_CLASS_HARD) << "primitive array type " << array_type
             << " source for aget-object";
@@ -4387,7 +4454,7 @@ void MethodVerifier<kVerifierDebug>::VerifyAGet(const Instruction* inst,
           work_line_->SetRegisterType<LockOp::kClear>(inst->VRegA_23x(), component_type);
         } else {
           work_line_->SetRegisterTypeWide(inst->VRegA_23x(), component_type,
-                                          component_type.HighHalf(&reg_types_));
+                                          component_type.HighHalf(reg_types_));
         }
       }
     }
@@ -4462,16 +4529,16 @@ void MethodVerifier<kVerifierDebug>::VerifyAPut(const Instruction* inst,
       // Note: this is, as usual, complicated by the fact the the instruction isn't fully typed
       //       and fits multiple register types.
       const RegType* modified_reg_type = &insn_type;
-      if ((modified_reg_type == &reg_types_.Integer()) ||
-          (modified_reg_type == &reg_types_.LongLo())) {
+      if ((modified_reg_type == &reg_types_->Integer()) ||
+          (modified_reg_type == &reg_types_->LongLo())) {
         // May be integer or float | long or double. Overwrite insn_type accordingly.
         const RegType& value_type = work_line_->GetRegisterType(this, inst->VRegA_23x());
-        if (modified_reg_type == &reg_types_.Integer()) {
-          if (&value_type == &reg_types_.Float()) {
+        if (modified_reg_type == &reg_types_->Integer()) {
+          if (&value_type == &reg_types_->Float()) {
             modified_reg_type = &value_type;
           }
         } else {
-          if (&value_type == &reg_types_.DoubleLo()) {
+          if (&value_type == &reg_types_->DoubleLo()) {
             modified_reg_type = &value_type;
           }
         }
@@ -4489,7 +4556,7 @@ void MethodVerifier<kVerifierDebug>::VerifyAPut(const Instruction* inst,
                                     << " because of missing class";
       }
     } else {
-      const RegType& component_type = reg_types_.GetComponentType(array_type, class_loader_);
+      const RegType& component_type = reg_types_->GetComponentType(array_type, class_loader_);
       const uint32_t vregA = inst->VRegA_23x();
       if (is_primitive) {
         VerifyPrimitivePut(component_type, insn_type, vregA);
@@ -4730,7 +4797,7 @@ void MethodVerifier<kVerifierDebug>::VerifyISFieldAccess(const Instruction* inst
       const dex::FieldId& field_id = dex_file_->GetFieldId(field_idx);
       const char* field_class_descriptor = dex_file_->GetFieldDeclaringClassDescriptor(field_id);
       const RegType* field_class_type =
-          &reg_types_.FromDescriptor(class_loader_, field_class_descriptor);
+          &reg_types_->FromDescriptor(class_loader_, field_class_descriptor);
       if (!field_class_type->Equals(GetDeclaringClass())) {
         Fail(VERIFY_ERROR_ACCESS_FIELD) << "could not check field put for final field modify of "
                                         << field_class_descriptor
@@ -4744,7 +4811,7 @@ void MethodVerifier<kVerifierDebug>::VerifyISFieldAccess(const Instruction* inst
   if (field_type == nullptr) {
     const dex::FieldId& field_id = dex_file_->GetFieldId(field_idx);
     const char* descriptor = dex_file_->GetFieldTypeDescriptor(field_id);
-    field_type = &reg_types_.FromDescriptor(class_loader_, descriptor);
+    field_type = &reg_types_->FromDescriptor(class_loader_, descriptor);
   }
   DCHECK(field_type != nullptr);
   const uint32_t vregA = (is_static) ? inst->VRegA_21c() : inst->VRegA_22c();
@@ -4797,7 +4864,7 @@ void MethodVerifier<kVerifierDebug>::VerifyISFieldAccess(const Instruction* inst
     if (!field_type->IsLowHalf()) {
       work_line_->SetRegisterType<LockOp::kClear>(vregA, *field_type);
     } else {
-      work_line_->SetRegisterTypeWide(vregA, *field_type, field_type->HighHalf(&reg_types_));
+      work_line_->SetRegisterTypeWide(vregA, *field_type, field_type->HighHalf(reg_types_));
     }
   } else {
     LOG(FATAL) << "Unexpected case.";
@@ -4864,7 +4931,7 @@ const RegType& MethodVerifier<kVerifierDebug>::GetMethodReturnType() {
     const dex::ProtoId& proto_id = dex_file_->GetMethodPrototype(method_id);
     dex::TypeIndex return_type_idx = proto_id.return_type_idx_;
     const char* descriptor = dex_file_->GetTypeDescriptor(dex_file_->GetTypeId(return_type_idx));
-    return_type_ = &reg_types_.FromDescriptor(class_loader_, descriptor);
+    return_type_ = &reg_types_->FromDescriptor(class_loader_, descriptor);
   }
   return *return_type_;
 }
@@ -4873,23 +4940,23 @@ template <bool kVerifierDebug>
 const RegType& MethodVerifier<kVerifierDebug>::DetermineCat1Constant(int32_t value) {
   // Imprecise constant type.
   if (value < -32768) {
-    return reg_types_.IntConstant();
+    return reg_types_->IntConstant();
   } else if (value < -128) {
-    return reg_types_.ShortConstant();
+    return reg_types_->ShortConstant();
   } else if (value < 0) {
-    return reg_types_.ByteConstant();
+    return reg_types_->ByteConstant();
   } else if (value == 0) {
-    return reg_types_.Zero();
+    return reg_types_->Zero();
   } else if (value == 1) {
-    return reg_types_.One();
+    return reg_types_->One();
   } else if (value < 128) {
-    return reg_types_.PosByteConstant();
+    return reg_types_->PosByteConstant();
   } else if (value < 32768) {
-    return reg_types_.PosShortConstant();
+    return reg_types_->PosShortConstant();
   } else if (value < 65536) {
-    return reg_types_.CharConstant();
+    return reg_types_->CharConstant();
   } else {
-    return reg_types_.IntConstant();
+    return reg_types_->IntConstant();
   }
 }
 
@@ -4943,11 +5010,17 @@ MethodVerifier::MethodVerifier(Thread* self,
                                uint32_t dex_method_idx,
                                bool can_load_classes,
                                bool allow_thread_suspension,
-                               bool aot_mode)
+                               bool aot_mode,
+                               RegTypeCache* reg_types)
     : self_(self),
       arena_stack_(arena_pool),
       allocator_(&arena_stack_),
-      reg_types_(self, class_linker, can_load_classes, allocator_, allow_thread_suspension),
+      reg_types_(reg_types != nullptr ? reg_types
+                                      : &owned_reg_types_.emplace(self,
+                                                                  class_linker,
+                                                                  can_load_classes,
+                                                                  allocator_,
+                                                                  allow_thread_suspension)),
       reg_table_(allocator_),
       work_insn_idx_(dex::kDexNoIndex),
       dex_method_idx_(dex_method_idx),
@@ -4969,6 +5042,7 @@ MethodVerifier::~MethodVerifier() {
 MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
                                                          ClassLinker* class_linker,
                                                          ArenaPool* arena_pool,
+                                                         RegTypeCache* reg_types,
                                                          VerifierDeps* verifier_deps,
                                                          uint32_t method_idx,
                                                          const DexFile* dex_file,
@@ -4985,6 +5059,7 @@ MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
     return VerifyMethod<true>(self,
                               class_linker,
                               arena_pool,
+                              reg_types,
                               verifier_deps,
                               method_idx,
                               dex_file,
@@ -5001,6 +5076,7 @@ MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
     return VerifyMethod<false>(self,
                                class_linker,
                                arena_pool,
+                               reg_types,
                                verifier_deps,
                                method_idx,
                                dex_file,
@@ -5037,6 +5113,7 @@ template <bool kVerifierDebug>
 MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
                                                          ClassLinker* class_linker,
                                                          ArenaPool* arena_pool,
+                                                         RegTypeCache* reg_types,
                                                          VerifierDeps* verifier_deps,
                                                          uint32_t method_idx,
                                                          const DexFile* dex_file,
@@ -5067,7 +5144,8 @@ MethodVerifier::FailureData MethodVerifier::VerifyMethod(Thread* self,
                                                 class_def,
                                                 method_access_flags,
                                                 /* verify to dump */ false,
-                                                api_level);
+                                                api_level,
+                                                reg_types);
   if (verifier.Verify()) {
     // Verification completed, however failures may be pending that didn't cause the verification
     // to hard fail.
@@ -18,6 +18,7 @@
 #define ART_RUNTIME_VERIFIER_METHOD_VERIFIER_H_
 
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <vector>
 
@@ -128,7 +129,7 @@ class MethodVerifier {
   }
 
   RegTypeCache* GetRegTypeCache() {
-    return &reg_types_;
+    return reg_types_;
   }
 
   // Log a verification failure.
@@ -179,7 +180,7 @@ class MethodVerifier {
   }
 
   ClassLinker* GetClassLinker() const {
-    return reg_types_.GetClassLinker();
+    return reg_types_->GetClassLinker();
   }
 
   bool IsAotMode() const {
@@ -205,7 +206,8 @@ class MethodVerifier {
                  uint32_t dex_method_idx,
                  bool can_load_classes,
                  bool allow_thread_suspension,
-                 bool aot_mode)
+                 bool aot_mode,
+                 RegTypeCache* reg_types)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
   // Verification result for method(s). Includes a (maximum) failure kind, and (the union of)
@@ -232,6 +234,7 @@ class MethodVerifier {
   static FailureData VerifyMethod(Thread* self,
                                   ClassLinker* class_linker,
                                   ArenaPool* arena_pool,
+                                  RegTypeCache* reg_types,
                                   VerifierDeps* verifier_deps,
                                   uint32_t method_idx,
                                   const DexFile* dex_file,
@@ -250,6 +253,7 @@ class MethodVerifier {
   static FailureData VerifyMethod(Thread* self,
                                   ClassLinker* class_linker,
                                   ArenaPool* arena_pool,
+                                  RegTypeCache* reg_types,
                                   VerifierDeps* verifier_deps,
                                   uint32_t method_idx,
                                   const DexFile* dex_file,
@@ -293,7 +297,10 @@ class MethodVerifier {
   ArenaStack arena_stack_;
   ScopedArenaAllocator allocator_;
 
-  RegTypeCache reg_types_;
+  // The register types, either `owned_reg_types_` or a cache shared with the verifiers of the
+  // other methods of the class.
+  std::optional<RegTypeCache> owned_reg_types_;
+  RegTypeCache* const reg_types_;
 
   PcToRegisterLineTable reg_table_;
 
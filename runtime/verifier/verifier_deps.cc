@@ -26,7 +26,10 @@
 #include "base/mutex-inl.h"
 #include "compiler_callbacks.h"
 #include "dex/class_accessor-inl.h"
+#include "dex/code_item_accessors-inl.h"
 #include "dex/dex_file-inl.h"
+#include "dex/dex_file_exception_helpers.h"
+#include "dex/dex_instruction-inl.h"
 #include "mirror/class-inl.h"
 #include "mirror/class_loader.h"
 #include "oat/oat_file.h"
@@ -546,11 +549,19 @@ bool VerifierDeps::DecodeDexFileDeps(DexFileDeps& deps,
 }
 
 bool VerifierDeps::ParseStoredData(const std::vector<const DexFile*>& dex_files,
-                                   ArrayRef<const uint8_t> data) {
+                                   ArrayRef<const uint8_t> data,
+                                   const std::vector<bool>& dex_files_to_parse) {
+  DCHECK(dex_files_to_parse.empty() || dex_files_to_parse.size() == dex_files.size());
+  auto should_parse = [&](uint32_t dex_file_index) {
+    return dex_files_to_parse.empty() || dex_files_to_parse[dex_file_index];
+  };
   if (data.empty()) {
     // Return eagerly, as the first thing we expect from VerifierDeps data is
     // the number of created strings, even if there is no dependency.
     // Currently, only the boot image does not have any VerifierDeps data.
+    for (uint32_t i = 0; i != dex_files.size(); ++i) {
+      GetDexFileDeps(*dex_files[i])->from_stored_data_ = should_parse(i);
+    }
     return true;
   }
   const uint8_t* data_start = data.data();
@@ -558,6 +569,11 @@ bool VerifierDeps::ParseStoredData(const std::vector<const DexFile*>& dex_files,
   const uint8_t* cursor = data_start;
   uint32_t dex_file_index = 0;
   for (const DexFile* dex_file : dex_files) {
+    if (!should_parse(dex_file_index)) {
+      // Leave the dependencies empty, they shall be recorded by the verifier.
+      ++dex_file_index;
+      continue;
+    }
     DexFileDeps* deps = GetDexFileDeps(*dex_file);
     // Fetch the offset of this dex file's verifier data.
     cursor = data_start + reinterpret_cast<const uint32_t*>(data_start)[dex_file_index++];
@@ -567,11 +583,215 @@ bool VerifierDeps::ParseStoredData(const std::vector<const DexFile*>& dex_files,
       LOG(ERROR) << "Failed to parse dex file dependencies for " << dex_file->GetLocation();
       return false;
     }
+    deps->from_stored_data_ = true;
   }
   // TODO: We should check that `data_start == data_end`. Why are we passing excessive data?
   return true;
 }
 
+// Appends to `out` a description of `class_def` which does not depend on the string, type,
+// field and method indexes of `dex_file`. The definitions and code of a class in two versions
+// of a dex file are identical if their descriptions are. Returns false if the class uses
+// instructions which are not described.
+static bool AppendCanonicalClassDef(const DexFile& dex_file,
+                                    const dex::ClassDef& class_def,
+                                    std::string* out) {
+  auto append_u32 = [out](uint32_t value) {
+    out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  auto append_string = [&](std::string_view str) {
+    append_u32(str.size());
+    out->append(str);
+  };
+  auto append_type = [&](dex::TypeIndex type_idx) {
+    append_string(type_idx.IsValid() ? dex_file.GetTypeDescriptorView(type_idx) : "");
+  };
+  auto append_field = [&](uint32_t field_idx) {
+    const dex::FieldId& field_id = dex_file.GetFieldId(field_idx);
+    append_string(dex_file.GetFieldDeclaringClassDescriptorView(field_id));
+    append_string(dex_file.GetFieldNameView(field_id));
+    append_string(dex_file.GetFieldTypeDescriptorView(field_id));
+  };
+  auto append_method = [&](uint32_t method_idx) {
+    const dex::MethodId& method_id = dex_file.GetMethodId(method_idx);
+    append_string(dex_file.GetMethodDeclaringClassDescriptorView(method_id));
+    append_string(dex_file.GetMethodNameView(method_id));
+    append_string(dex_file.GetMethodSignature(method_id).ToString());
+  };
+
+  append_u32(class_def.access_flags_);
+  append_type(class_def.superclass_idx_);
+  const dex::TypeList* interfaces = dex_file.GetInterfacesList(class_def);
+  uint32_t num_interfaces = (interfaces != nullptr) ? interfaces->Size() : 0u;
+  append_u32(num_interfaces);
+  for (uint32_t i = 0; i != num_interfaces; ++i) {
+    append_type(interfaces->GetTypeItem(i).type_idx_);
+  }
+
+  ClassAccessor accessor(dex_file, class_def);
+  append_u32(accessor.NumFields());
+  for (const ClassAccessor::Field& field : accessor.GetFields()) {
+    append_field(field.GetIndex());
+    append_u32(field.GetAccessFlags());
+  }
+  append_u32(accessor.NumMethods());
+  for (const ClassAccessor::Method& method : accessor.GetMethods()) {
+    append_method(method.GetIndex());
+    append_u32(method.GetAccessFlags());
+    CodeItemDataAccessor code(dex_file, method.GetCodeItem());
+    if (!code.HasCodeItem()) {
+      append_u32(0u);
+      continue;
+    }
+    append_u32(code.InsnsSizeInCodeUnits());
+    append_u32(code.RegistersSize());
+    append_u32(code.InsSize());
+    append_u32(code.OutsSize());
+    for (const DexInstructionPcPair& pair : code) {
+      const Instruction& inst = pair.Inst();
+      Instruction::Code opcode = inst.Opcode();
+      Instruction::Format format = Instruction::FormatOf(opcode);
+      // Append the raw code units with the indexes cleared and then what the indexes refer to.
+      size_t size = inst.SizeInCodeUnits();
+      size_t start = out->size();
+      out->append(reinterpret_cast<const char*>(&inst), size * sizeof(uint16_t));
+      uint16_t* units = reinterpret_cast<uint16_t*>(out->data() + start);
+      Instruction::IndexType index_type = Instruction::IndexTypeOf(opcode);
+      if (index_type == Instruction::kIndexNone) {
+        continue;
+      }
+      uint32_t index = (format == Instruction::k22c) ? inst.VRegC_22c() : inst.VRegB();
+      switch (format) {
+        case Instruction::k21c:
+        case Instruction::k22c:
+        case Instruction::k35c:
+        case Instruction::k3rc:
+          units[1] = 0u;
+          break;
+        case Instruction::k31c:
+          units[1] = 0u;
+          units[2] = 0u;
+          break;
+        case Instruction::k45cc:
+        case Instruction::k4rcc:
+          units[1] = 0u;
+          units[3] = 0u;
+          break;
+        default:
+          return false;
+      }
+      switch (index_type) {
+        case Instruction::kIndexTypeRef:
+          append_type(dex::TypeIndex(index));
+          break;
+        case Instruction::kIndexStringRef:
+          append_string(dex_file.GetStringView(dex::StringIndex(index)));
+          break;
+        case Instruction::kIndexMethodRef:
+          append_method(index);
+          break;
+        case Instruction::kIndexFieldRef:
+          append_field(index);
+          break;
+        case Instruction::kIndexMethodAndProtoRef:
+          append_method(index);
+          append_string(
+              dex_file.GetProtoSignature(dex_file.GetProtoId(dex::ProtoIndex(inst.VRegH())))
+                  .ToString());
+          break;
+        case Instruction::kIndexProtoRef:
+          append_string(
+              dex_file.GetProtoSignature(dex_file.GetProtoId(dex::ProtoIndex(index))).ToString());
+          break;
+        default:
+          // Call sites and method handles are not described.
+          return false;
+      }
+    }
+    append_u32(code.TriesSize());
+    for (const dex::TryItem& try_item : code.TryItems()) {
+      append_u32(try_item.start_addr_);
+      append_u32(try_item.insn_count_);
+      for (CatchHandlerIterator it(code, try_item); it.HasNext(); it.Next()) {
+        append_u32(1u);
+        append_type(it.GetHandlerTypeIndex());
+        append_u32(it.GetHandlerAddress());
+      }
+      append_u32(0u);
+    }
+  }
+  return true;
+}
+
+size_t VerifierDeps::ReuseIdenticalClasses(const DexFile& dex_file,
+                                           const DexFile& old_dex_file,
+                                           const VerifierDeps& old_deps) {
+  WriterMutexLock mu(Thread::Current(), *Locks::verifier_deps_lock_);
+  DexFileDeps* deps = GetDexFileDeps(dex_file);
+  const DexFileDeps* old_dex_file_deps = old_deps.GetDexFileDeps(old_dex_file);
+  DCHECK(deps != nullptr);
+  DCHECK(!deps->from_stored_data_);
+  DCHECK(old_dex_file_deps != nullptr);
+
+  std::map<std::string_view, uint32_t> old_class_defs;
+  for (uint32_t i = 0; i != old_dex_file.NumClassDefs(); ++i) {
+    if (old_dex_file_deps->verified_classes_[i]) {
+      old_class_defs.emplace(
+          old_dex_file.GetTypeDescriptorView(old_dex_file.GetClassDef(i).class_idx_), i);
+    }
+  }
+  if (old_class_defs.empty()) {
+    return 0u;
+  }
+
+  // New strings are added directly to this `VerifierDeps`. This is done before
+  // verification, so there is no need to go through the main `VerifierDeps`.
+  auto get_id_from_old_id = [&](dex::StringIndex old_id) {
+    std::string str = old_deps.GetStringFromId(old_dex_file, old_id);
+    const dex::StringId* string_id = dex_file.FindStringId(str.c_str());
+    if (string_id != nullptr) {
+      return dex_file.GetIndexForStringId(*string_id);
+    }
+    uint32_t found_id;
+    if (!FindExistingStringId(deps->strings_, str, &found_id)) {
+      found_id = deps->strings_.size();
+      deps->strings_.push_back(std::move(str));
+    }
+    return dex::StringIndex(dex_file.NumStringIds() + found_id);
+  };
+
+  size_t num_reused = 0u;
+  std::string canonical;
+  std::string old_canonical;
+  for (uint32_t i = 0; i != dex_file.NumClassDefs(); ++i) {
+    const dex::ClassDef& class_def = dex_file.GetClassDef(i);
+    auto it = old_class_defs.find(dex_file.GetTypeDescriptorView(class_def.class_idx_));
+    if (it == old_class_defs.end()) {
+      continue;
+    }
+    uint32_t old_index = it->second;
+    canonical.clear();
+    old_canonical.clear();
+    if (!AppendCanonicalClassDef(dex_file, class_def, &canonical) ||
+        !AppendCanonicalClassDef(
+            old_dex_file, old_dex_file.GetClassDef(old_index), &old_canonical) ||
+        canonical != old_canonical) {
+      continue;
+    }
+    if (deps->stored_classes_.empty()) {
+      deps->stored_classes_.resize(dex_file.NumClassDefs());
+    }
+    deps->stored_classes_[i] = true;
+    deps->verified_classes_[i] = true;
+    for (const TypeAssignability& entry : old_dex_file_deps->assignable_types_[old_index]) {
+      deps->assignable_types_[i].emplace(get_id_from_old_id(entry.GetDestination()),
+                                         get_id_from_old_id(entry.GetSource()));
+    }
+    ++num_reused;
+  }
+  return num_reused;
+}
+
 bool VerifierDeps::ParseVerifiedClasses(
     const std::vector<const DexFile*>& dex_files,
     ArrayRef<const uint8_t> data,
@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_VERIFIER_VERIFIER_DEPS_H_
 #define ART_RUNTIME_VERIFIER_VERIFIER_DEPS_H_
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <vector>
@@ -69,8 +70,11 @@ class VerifierDeps {
   static uint32_t constexpr kNotVerifiedMarker = std::numeric_limits<uint32_t>::max();
 
   // Fill dependencies from stored data. Returns true on success, false on failure.
+  // If `dex_files_to_parse` is not empty, only the data of dex files for which it is true
+  // is filled and the other dex files must be verified from scratch, see `HasStoredData()`.
   EXPORT bool ParseStoredData(const std::vector<const DexFile*>& dex_files,
-                              ArrayRef<const uint8_t> data);
+                              ArrayRef<const uint8_t> data,
+                              const std::vector<bool>& dex_files_to_parse = {});
 
   // Merge `other` into this `VerifierDeps`'. `other` and `this` must be for the
   // same set of dex files.
@@ -143,6 +147,43 @@ class VerifierDeps {
     return GetDexFileDeps(dex_file) != nullptr;
   }
 
+  // Whether the dependencies of `dex_file` were filled by `ParseStoredData()`.
+  bool HasStoredData(const DexFile& dex_file) const {
+    return GetDexFileDeps(dex_file)->from_stored_data_;
+  }
+
+  // Whether the dependencies of the class at `class_def_index` were filled from stored data,
+  // either by `ParseStoredData()` or by `ReuseIdenticalClasses()`.
+  bool HasStoredData(const DexFile& dex_file, uint32_t class_def_index) const {
+    const DexFileDeps* deps = GetDexFileDeps(dex_file);
+    return deps->from_stored_data_ ||
+           (!deps->stored_classes_.empty() && deps->stored_classes_[class_def_index]);
+  }
+
+  // Whether the dependencies of any class of `dex_file` were filled from stored data.
+  bool HasAnyStoredData(const DexFile& dex_file) const {
+    const DexFileDeps* deps = GetDexFileDeps(dex_file);
+    return deps->from_stored_data_ || !deps->stored_classes_.empty();
+  }
+
+  // Copy the dependencies of the verified classes of `old_dex_file` recorded in `old_deps`
+  // to the classes of `dex_file` with the same descriptor and identical definitions and code.
+  // This lets an updated dex file be verified only for the classes which changed. The
+  // dependencies of `dex_file` must not have been filled by `ParseStoredData()`.
+  // Returns the number of reused classes.
+  EXPORT size_t ReuseIdenticalClasses(const DexFile& dex_file,
+                                      const DexFile& old_dex_file,
+                                      const VerifierDeps& old_deps)
+      REQUIRES(!Locks::verifier_deps_lock_);
+
+  // Whether any strings not present in the dex files were recorded. Only a `VerifierDeps`
+  // without such strings can be merged into another one with `MergeWith()`.
+  bool HasExtraStrings() const {
+    return std::any_of(dex_deps_.begin(), dex_deps_.end(), [](const auto& entry) {
+      return !entry.second->strings_.empty();
+    });
+  }
+
   // Parses raw VerifierDeps data to extract bitvectors of which class def indices
   // were verified or not. The given `dex_files` must match the order and count of
   // dex files used to create the VerifierDeps.
@@ -182,6 +223,13 @@ class VerifierDeps {
     // class was successfully verified.
     std::vector<bool> verified_classes_;
 
+    // Whether the dependencies were filled from stored data rather than recorded.
+    bool from_stored_data_ = false;
+
+    // Bit vector indexed by class def indices indicating whether the dependencies of the
+    // corresponding class were reused by `ReuseIdenticalClasses()`. Empty if none were.
+    std::vector<bool> stored_classes_;
+
     bool Equals(const DexFileDeps& rhs) const;
   };
 
@@ -36,6 +36,9 @@ class WriteBarrier {
 
   // Must be called if a reference field of an Object in the heap changes, and before any GC
   // safe-point. The call is not needed if null is stored in the field.
+  // Note that the card must be marked even if `dst` was just allocated: the concurrent collectors
+  // treat objects allocated during marking as live without scanning them, and rely on their
+  // dirty cards to find references stored into them afterwards.
   template <NullCheck kNullCheck = kWithNullCheck>
   ALWAYS_INLINE static void ForFieldWrite(ObjPtr<mirror::Object> dst,
                                           [[maybe_unused]] MemberOffset offset,
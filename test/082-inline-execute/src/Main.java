@@ -353,6 +353,29 @@ public class Main {
     Assert.assertEquals(str10.indexOf(searchData[20][0], searchData[20][1]), searchData[20][2]);
     Assert.assertEquals(str40.indexOf(searchData[21][0], searchData[21][1]), searchData[21][2]);
     Assert.assertEquals(str40.indexOf(searchData[22][0], searchData[22][1]), searchData[22][2]);
+
+    // Cover every match position and start index around the widths of the vectorized loops,
+    // for both compressed and uncompressed strings.
+    for (char filler : new char[] { 'a', '\u0100' }) {
+      for (int length = 0; length <= 50; ++length) {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < length; ++i) {
+          sb.append(filler);
+        }
+        String str = sb.toString();
+        Assert.assertEquals(str.indexOf('z'), -1);
+        Assert.assertEquals(str.indexOf('\u0161'), -1);
+        for (int pos = 0; pos < length; ++pos) {
+          sb.setCharAt(pos, 'z');
+          String strZ = sb.toString();
+          Assert.assertEquals(strZ.indexOf('z'), pos);
+          for (int start = 0; start <= length; ++start) {
+            Assert.assertEquals(strZ.indexOf('z', start), start <= pos ? pos : -1);
+          }
+          sb.setCharAt(pos, filler);
+        }
+      }
+    }
   }
 
   private static void testSurrogateIndexOf() {
@@ -27,6 +27,11 @@ public class Main {
   /// CHECK:        Goto                 loop:<<LoopId>>
   /// CHECK-NEXT:   b
 
+  /// CHECK-START-X86_64: void Main.$noinline$testRemoveSuspendCheck(int[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   jmp
+
   public static void $noinline$testRemoveSuspendCheck(int[] a) {
     for (int i = 0; i < ITERATIONS; i++) {
       a[i++] = i;
@@ -70,17 +75,44 @@ public class Main {
   /// CHECK:        Goto                 loop:<<LoopId>>
   /// CHECK-NEXT:   ldr
 
+  // The implicit suspend check loads the suspend trigger into the scratch register.
+  /// CHECK-START-X86_64: void Main.testRemoveSuspendCheckUnknownCount(int[], int) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   mov r11
+
   public static void testRemoveSuspendCheckUnknownCount(int[] a, int n) {
     for (int i = 0; i < n; i++) {
       a[i++] = i;
     }
   }
 
+  // Test 5: This test checks that the SuspendCheck is removed from the header
+  // also when the target heuristics reject other scalar loop optimizations,
+  // here because of the long typed instructions.
+
+  /// CHECK-START-ARM64: void Main.$noinline$testRemoveSuspendCheckLongArray(long[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   b
+
+  /// CHECK-START-X86_64: void Main.$noinline$testRemoveSuspendCheckLongArray(long[]) disassembly (after)
+  /// CHECK:        SuspendCheck         loop:<<LoopId:B\d+>>
+  /// CHECK:        Goto                 loop:<<LoopId>>
+  /// CHECK-NEXT:   jmp
+
+  public static void $noinline$testRemoveSuspendCheckLongArray(long[] a) {
+    for (int i = 0; i < ITERATIONS; i++) {
+      a[i++] = i;
+    }
+  }
+
   public static void main(String[] args) {
     int[] a = new int[100];
     $noinline$testRemoveSuspendCheck(a);
     testRemoveSuspendCheckWithCall(a);
     testRemoveSuspendCheckAboveHeuristic(a);
     testRemoveSuspendCheckUnknownCount(a, 4);
+    $noinline$testRemoveSuspendCheckLongArray(new long[100]);
   }
 }
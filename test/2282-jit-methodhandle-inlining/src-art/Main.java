@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
+
+// Checks that MethodHandle.invokeExact calls on static final method handles behave the same
+// once the JIT has turned them into calls to, or inlined copies of, the handle's target.
+public class Main {
+    static class Base {
+        int value;
+
+        Base(int value) {
+            this.value = value;
+        }
+
+        int getValue() {
+            return value;
+        }
+
+        void setValue(int value) {
+            this.value = value;
+        }
+
+        private int getDoubleValue() {
+            return 2 * value;
+        }
+    }
+
+    static class Derived extends Base {
+        Derived(int value) {
+            super(value);
+        }
+
+        @Override
+        int getValue() {
+            return -value;
+        }
+    }
+
+    static String describe(Base base, int suffix) {
+        return "value " + base.value + "/" + suffix;
+    }
+
+    private static final MethodHandle GET_VALUE;
+    private static final MethodHandle SET_VALUE;
+    private static final MethodHandle GET_DOUBLE_VALUE;
+    private static final MethodHandle DESCRIBE;
+
+    static {
+        try {
+            MethodHandles.Lookup lookup = MethodHandles.lookup();
+            GET_VALUE = lookup.findVirtual(
+                    Base.class, "getValue", MethodType.methodType(int.class));
+            SET_VALUE = lookup.findVirtual(
+                    Base.class, "setValue", MethodType.methodType(void.class, int.class));
+            GET_DOUBLE_VALUE = MethodHandles.privateLookupIn(Base.class, lookup).findVirtual(
+                    Base.class, "getDoubleValue", MethodType.methodType(int.class));
+            DESCRIBE = lookup.findStatic(
+                    Main.class,
+                    "describe",
+                    MethodType.methodType(String.class, Base.class, int.class));
+        } catch (ReflectiveOperationException e) {
+            throw new Error(e);
+        }
+    }
+
+    private static final int ITERATIONS = 10000;
+
+    public static void main(String[] args) throws Throwable {
+        System.loadLibrary(args[0]);
+
+        Base base = new Base(7);
+        Derived derived = new Derived(5);
+        for (int i = 0; i < ITERATIONS; ++i) {
+            $noinline$getValue(base);
+            $noinline$setValue(base, 7);
+            $noinline$getDoubleValue(base);
+            $noinline$describe(base, i);
+        }
+        ensureJitCompiled(Main.class, "$noinline$getValue");
+        ensureJitCompiled(Main.class, "$noinline$setValue");
+        ensureJitCompiled(Main.class, "$noinline$getDoubleValue");
+        ensureJitCompiled(Main.class, "$noinline$describe");
+
+        assertEquals(7, $noinline$getValue(base));
+        // A handle from `findVirtual` dispatches on the receiver's class.
+        assertEquals(-5, $noinline$getValue(derived));
+        $noinline$setValue(derived, 3);
+        assertEquals(3, derived.value);
+        assertEquals(6, $noinline$getDoubleValue(derived));
+        assertEquals("value 7/42", $noinline$describe(base, 42));
+        assertEquals("value 3/1", $noinline$describe(derived, 1));
+
+        try {
+            $noinline$getValue(null);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+        try {
+            $noinline$setValue(null, 1);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+        try {
+            $noinline$getDoubleValue(null);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+        // The static target does not use its argument as a receiver.
+        try {
+            $noinline$describe(null, 0);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+        System.out.println("passed");
+    }
+
+    static int $noinline$getValue(Base base) throws Throwable {
+        return (int) GET_VALUE.invokeExact(base);
+    }
+
+    static void $noinline$setValue(Base base, int value) throws Throwable {
+        SET_VALUE.invokeExact(base, value);
+    }
+
+    static int $noinline$getDoubleValue(Base base) throws Throwable {
+        return (int) GET_DOUBLE_VALUE.invokeExact(base);
+    }
+
+    static String $noinline$describe(Base base, int suffix) throws Throwable {
+        return (String) DESCRIBE.invokeExact(base, suffix);
+    }
+
+    private static void assertEquals(int expected, int actual) {
+        if (expected != actual) {
+            throw new AssertionError("Expected " + expected + ", got " + actual);
+        }
+    }
+
+    private static void assertEquals(String expected, String actual) {
+        if (!expected.equals(actual)) {
+            throw new AssertionError("Expected " + expected + ", got " + actual);
+        }
+    }
+
+    private static native void ensureJitCompiled(Class<?> klass, String methodName);
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.ReadOnlyBufferException;
+
+// Checks ByteBuffer view VarHandle accesses once the JIT has compiled them to intrinsic code
+// for heap buffers, with other buffers still handled by the runtime.
+public class Main {
+    private static final VarHandle INT_NATIVE =
+            MethodHandles.byteBufferViewVarHandle(int[].class, ByteOrder.nativeOrder());
+    private static final VarHandle LONG_SWAPPED =
+            MethodHandles.byteBufferViewVarHandle(long[].class, swappedOrder());
+
+    private static final int ITERATIONS = 10000;
+
+    // The data of a byte array starts 4 bytes past an 8-byte boundary, so these indices are
+    // aligned in heap buffers. Direct buffers are 8-byte aligned, so we use only `INT_INDEX`.
+    private static final int INT_INDEX = 0;
+    private static final int LONG_INDEX = 4;
+
+    public static void main(String[] args) throws Throwable {
+        System.loadLibrary(args[0]);
+
+        ByteBuffer warmup = ByteBuffer.allocate(64);
+        for (int i = 0; i < ITERATIONS; ++i) {
+            $noinline$getInt(warmup, INT_INDEX);
+            $noinline$setIntRelease(warmup, INT_INDEX, i);
+            $noinline$getIntAcquire(warmup, INT_INDEX);
+            $noinline$compareAndExchangeInt(warmup, INT_INDEX, i, i + 1);
+            $noinline$getAndAddInt(warmup, INT_INDEX, 1);
+            $noinline$getLong(warmup, LONG_INDEX);
+            $noinline$setLong(warmup, LONG_INDEX, i);
+            $noinline$compareAndSetLong(warmup, LONG_INDEX, i, i + 1);
+        }
+        ensureJitCompiled(Main.class, "$noinline$getInt");
+        ensureJitCompiled(Main.class, "$noinline$setIntRelease");
+        ensureJitCompiled(Main.class, "$noinline$getIntAcquire");
+        ensureJitCompiled(Main.class, "$noinline$compareAndExchangeInt");
+        ensureJitCompiled(Main.class, "$noinline$getAndAddInt");
+        ensureJitCompiled(Main.class, "$noinline$getLong");
+        ensureJitCompiled(Main.class, "$noinline$setLong");
+        ensureJitCompiled(Main.class, "$noinline$compareAndSetLong");
+
+        ByteBuffer heap = ByteBuffer.allocate(64);
+        testIntAccess(heap);
+        testLongAccess(heap);
+        // A slice shares the array of the original buffer at a non-zero offset.
+        ByteBuffer original = ByteBuffer.allocate(80);
+        original.position(16);
+        ByteBuffer slice = original.slice();
+        testIntAccess(slice);
+        testLongAccess(slice);
+        assertEquals(10, original.order(ByteOrder.nativeOrder()).getInt(16 + INT_INDEX));
+        testIntAccess(ByteBuffer.allocateDirect(64));
+
+        ByteBuffer readOnly = ByteBuffer.allocate(64).asReadOnlyBuffer();
+        assertEquals(0, $noinline$getInt(readOnly, INT_INDEX));
+        try {
+            $noinline$setIntRelease(readOnly, INT_INDEX, 1);
+            throw new Error("Expected ReadOnlyBufferException");
+        } catch (ReadOnlyBufferException expected) {
+        }
+        try {
+            $noinline$getAndAddInt(readOnly, INT_INDEX, 1);
+            throw new Error("Expected ReadOnlyBufferException");
+        } catch (ReadOnlyBufferException expected) {
+        }
+
+        ByteBuffer small = ByteBuffer.allocate(64);
+        small.limit(12);
+        assertEquals(0, $noinline$getInt(small, 8));
+        try {
+            $noinline$getInt(small, 12);
+            throw new Error("Expected IndexOutOfBoundsException");
+        } catch (IndexOutOfBoundsException expected) {
+        }
+        try {
+            $noinline$getLong(small, 8);
+            throw new Error("Expected IndexOutOfBoundsException");
+        } catch (IndexOutOfBoundsException expected) {
+        }
+        try {
+            $noinline$getInt(small, -4);
+            throw new Error("Expected IndexOutOfBoundsException");
+        } catch (IndexOutOfBoundsException expected) {
+        }
+        try {
+            $noinline$getInt(null, 0);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+        System.out.println("passed");
+    }
+
+    private static void testIntAccess(ByteBuffer buffer) throws Throwable {
+        int index = INT_INDEX;
+        $noinline$setIntRelease(buffer, index, 0x12345678);
+        assertEquals(0x12345678, $noinline$getInt(buffer, index));
+        assertEquals(0x12345678, $noinline$getIntAcquire(buffer, index));
+        assertEquals(0x12345678, buffer.order(ByteOrder.nativeOrder()).getInt(index));
+        assertEquals(0x12345678, $noinline$compareAndExchangeInt(buffer, index, 0x12345678, 7));
+        assertEquals(7, $noinline$compareAndExchangeInt(buffer, index, 0x12345678, 8));
+        assertEquals(7, $noinline$getAndAddInt(buffer, index, 3));
+        assertEquals(10, $noinline$getInt(buffer, index));
+    }
+
+    private static void testLongAccess(ByteBuffer buffer) throws Throwable {
+        int index = LONG_INDEX;
+        long value = 0x0102030405060708L;
+        $noinline$setLong(buffer, index, value);
+        assertEquals(value, $noinline$getLong(buffer, index));
+        // The handle uses the byte order opposite to the native one.
+        assertEquals(value, buffer.order(swappedOrder()).getLong(index));
+        assertEquals(Long.reverseBytes(value), buffer.order(ByteOrder.nativeOrder()).getLong(index));
+        assertEquals(false, $noinline$compareAndSetLong(buffer, index, 0L, 1L));
+        assertEquals(true, $noinline$compareAndSetLong(buffer, index, value, -1L));
+        assertEquals(-1L, $noinline$getLong(buffer, index));
+    }
+
+    private static ByteOrder swappedOrder() {
+        return ByteOrder.nativeOrder() == ByteOrder.LITTLE_ENDIAN
+                ? ByteOrder.BIG_ENDIAN
+                : ByteOrder.LITTLE_ENDIAN;
+    }
+
+    static int $noinline$getInt(ByteBuffer buffer, int index) {
+        return (int) INT_NATIVE.get(buffer, index);
+    }
+
+    static int $noinline$getIntAcquire(ByteBuffer buffer, int index) {
+        return (int) INT_NATIVE.getAcquire(buffer, index);
+    }
+
+    static void $noinline$setIntRelease(ByteBuffer buffer, int index, int value) {
+        INT_NATIVE.setRelease(buffer, index, value);
+    }
+
+    static int $noinline$compareAndExchangeInt(
+            ByteBuffer buffer, int index, int expected, int value) {
+        return (int) INT_NATIVE.compareAndExchange(buffer, index, expected, value);
+    }
+
+    static int $noinline$getAndAddInt(ByteBuffer buffer, int index, int delta) {
+        return (int) INT_NATIVE.getAndAdd(buffer, index, delta);
+    }
+
+    static long $noinline$getLong(ByteBuffer buffer, int index) {
+        return (long) LONG_SWAPPED.get(buffer, index);
+    }
+
+    static void $noinline$setLong(ByteBuffer buffer, int index, long value) {
+        LONG_SWAPPED.set(buffer, index, value);
+    }
+
+    static boolean $noinline$compareAndSetLong(
+            ByteBuffer buffer, int index, long expected, long value) {
+        return (boolean) LONG_SWAPPED.compareAndSet(buffer, index, expected, value);
+    }
+
+    private static void assertEquals(int expected, int actual) {
+        if (expected != actual) {
+            throw new AssertionError("Expected " + expected + ", got " + actual);
+        }
+    }
+
+    private static void assertEquals(long expected, long actual) {
+        if (expected != actual) {
+            throw new AssertionError("Expected " + expected + ", got " + actual);
+        }
+    }
+
+    private static void assertEquals(boolean expected, boolean actual) {
+        if (expected != actual) {
+            throw new AssertionError("Expected " + expected + ", got " + actual);
+        }
+    }
+
+    private static native void ensureJitCompiled(Class<?> klass, String methodName);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  public static void main(String[] args) throws Exception {
+    System.loadLibrary(args[0]);
+
+    if (!checkAppImageLoaded("2284-app-image-startup-classes")) {
+      System.out.println("AppImage not loaded.");
+    }
+    if (!checkAppImageContains(StartupTable.class)) {
+      System.out.println("StartupTable class is not in app image!");
+    }
+
+    // Has a startup static method and only image-safe static field values.
+    expectPreInit(StartupTable.class);
+    // Has a startup static method but references an app object from a static field.
+    expectNotPreInit(StartupObjectRef.class);
+    // Is an image class with a <clinit> but no startup method.
+    expectNotPreInit(NotStartup.class);
+
+    System.out.println("StartupTable.get(3): " + StartupTable.get(3));
+    System.out.println("StartupTable.NAME: " + StartupTable.NAME);
+    System.out.println("StartupObjectRef.get(): "
+        + (StartupObjectRef.get() != null ? "not null" : "null"));
+    System.out.println("NotStartup.value: " + NotStartup.value);
+  }
+
+  static void expectPreInit(Class<?> klass) {
+    if (checkInitialized(klass) == false) {
+      System.out.println(klass.getName() + " should be initialized!");
+    }
+  }
+
+  static void expectNotPreInit(Class<?> klass) {
+    if (checkInitialized(klass) == true) {
+      System.out.println(klass.getName() + " should not be initialized!");
+    }
+  }
+
+  public static native boolean checkAppImageLoaded(String name);
+  public static native boolean checkAppImageContains(Class<?> klass);
+  public static native boolean checkInitialized(Class<?> klass);
+}
+
+class StartupTable {
+  static final String NAME = "startup";
+  static int[] table = new int[16];
+
+  static {
+    for (int i = 0; i < table.length; ++i) {
+      table[i] = i * i;
+    }
+  }
+
+  static int get(int i) {
+    return table[i];
+  }
+}
+
+class StartupObjectRef {
+  static Object ref = new StartupObjectRef();
+
+  static Object get() {
+    return ref;
+  }
+}
+
+class NotStartup {
+  static int value;
+
+  static {
+    value = 42;
+  }
+}
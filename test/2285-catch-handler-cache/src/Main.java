@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  static class BaseException extends Exception {}
+  static class DerivedException extends BaseException {}
+  static class OtherException extends RuntimeException {}
+
+  // Enough iterations for the methods to be JIT compiled and their handlers to be cached.
+  static final int ITERATIONS = 20000;
+
+  static void $noinline$throwKind(int kind) throws BaseException {
+    switch (kind) {
+      case 0: throw new DerivedException();
+      case 1: throw new BaseException();
+      case 2: throw new OtherException();
+      case 3: throw new IllegalStateException();
+      default: break;
+    }
+  }
+
+  // Catches in the throwing frame. The handler depends on the exception class.
+  static int $noinline$catchInSameFrame(int kind) {
+    try {
+      switch (kind) {
+        case 0: throw new DerivedException();
+        case 1: throw new BaseException();
+        case 2: throw new OtherException();
+        default: return 0;
+      }
+    } catch (DerivedException e) {
+      return 1;
+    } catch (BaseException e) {
+      return 2;
+    } catch (RuntimeException e) {
+      return 3;
+    }
+  }
+
+  // Catches in the caller of the throwing frame, with the same throw site for all classes.
+  static int $noinline$catchInCaller(int kind) {
+    try {
+      $noinline$throwKind(kind);
+      return 0;
+    } catch (DerivedException e) {
+      return 1;
+    } catch (BaseException e) {
+      return 2;
+    } catch (RuntimeException e) {
+      return 3;
+    }
+  }
+
+  // Leaves the exceptions it does not catch to `$noinline$catchFurtherUp()`.
+  static int $noinline$catchSome(int kind) throws BaseException {
+    try {
+      $noinline$throwKind(kind);
+      return 0;
+    } catch (DerivedException e) {
+      return 1;
+    }
+  }
+
+  static int $noinline$catchFurtherUp(int kind) {
+    int result = 0;
+    try {
+      result = $noinline$catchSome(kind);
+    } catch (BaseException e) {
+      result = 2;
+    } catch (Throwable t) {
+      result = 4;
+    } finally {
+      result += 10;
+    }
+    return result;
+  }
+
+  // Same as `$noinline$catchSome()` but may be inlined.
+  static int catchSomeInlined(int kind) throws BaseException {
+    try {
+      $noinline$throwKind(kind);
+      return 0;
+    } catch (DerivedException e) {
+      return 1;
+    }
+  }
+
+  static int $noinline$catchFromInlined(int kind) {
+    try {
+      return catchSomeInlined(kind);
+    } catch (BaseException e) {
+      return 2;
+    } catch (RuntimeException e) {
+      return 3;
+    }
+  }
+
+  static void expectEquals(int expected, int actual, String what) {
+    if (expected != actual) {
+      throw new Error(what + ": expected " + expected + ", got " + actual);
+    }
+  }
+
+  public static void main(String[] args) {
+    int[] sameFrame = {1, 2, 3, 0};
+    int[] caller = {1, 2, 3, 3};
+    int[] furtherUp = {11, 12, 14, 14, 10};
+    int[] fromInlined = {1, 2, 3, 3, 0};
+    for (int i = 0; i < ITERATIONS; ++i) {
+      // Alternate the exception classes so that the same sites see all of them.
+      int kind = i % 5;
+      expectEquals(sameFrame[kind % 4], $noinline$catchInSameFrame(kind % 4), "same frame");
+      expectEquals(caller[kind % 4], $noinline$catchInCaller(kind % 4), "caller");
+      expectEquals(furtherUp[kind], $noinline$catchFurtherUp(kind), "further up");
+      expectEquals(fromInlined[kind], $noinline$catchFromInlined(kind), "from inlined");
+    }
+    System.out.println("passed");
+  }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  // The test runs with -XX:MaxJavaStackTraceDepth=8.
+  static final int MAX_DEPTH = 8;
+
+  static Throwable $noinline$recurseAndCreate(int depth) {
+    if (depth == 0) {
+      return new Throwable();
+    }
+    return $noinline$recurseAndCreate(depth - 1);
+  }
+
+  static StackTraceElement[] $noinline$recurseAndGetThreadStackTrace(int depth) {
+    if (depth == 0) {
+      return Thread.currentThread().getStackTrace();
+    }
+    return $noinline$recurseAndGetThreadStackTrace(depth - 1);
+  }
+
+  static int $noinline$recurseAndThrow(int depth) {
+    if (depth == 0) {
+      throw new IllegalStateException();
+    }
+    return $noinline$recurseAndThrow(depth - 1) + 1;
+  }
+
+  static void expectEquals(Object expected, Object actual, String what) {
+    if (!expected.equals(actual)) {
+      throw new Error(what + ": expected " + expected + ", got " + actual);
+    }
+  }
+
+  static void checkRecursion(StackTraceElement[] trace, String method, int frames, String what) {
+    for (int i = 0; i < frames; ++i) {
+      expectEquals(method, trace[i].getMethodName(), what + " frame " + i);
+    }
+  }
+
+  public static void main(String[] args) {
+    // Shallow stack traces are complete.
+    StackTraceElement[] trace = $noinline$recurseAndCreate(2).getStackTrace();
+    expectEquals(4, trace.length, "shallow trace length");
+    checkRecursion(trace, "$noinline$recurseAndCreate", 3, "shallow trace");
+    expectEquals("main", trace[3].getMethodName(), "shallow trace outermost frame");
+
+    // Deep stack traces keep the innermost frames.
+    trace = $noinline$recurseAndCreate(100).getStackTrace();
+    expectEquals(MAX_DEPTH, trace.length, "deep trace length");
+    checkRecursion(trace, "$noinline$recurseAndCreate", MAX_DEPTH, "deep trace");
+
+    try {
+      $noinline$recurseAndThrow(100);
+      throw new Error("Expected IllegalStateException");
+    } catch (IllegalStateException expected) {
+      trace = expected.getStackTrace();
+      expectEquals(MAX_DEPTH, trace.length, "thrown trace length");
+      checkRecursion(trace, "$noinline$recurseAndThrow", MAX_DEPTH, "thrown trace");
+    }
+
+    // Thread stack traces are not limited.
+    trace = $noinline$recurseAndGetThreadStackTrace(100);
+    if (trace.length <= 100) {
+      throw new Error("Thread stack trace is too short: " + trace.length);
+    }
+    System.out.println("passed");
+  }
+}
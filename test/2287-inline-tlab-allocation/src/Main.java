@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.lang.reflect.Method;
+
+public class Main {
+  static class Point {
+    int x;
+    long y;
+    Object z;
+  }
+
+  static class Lazy {
+    static int initialized = 1;
+    int value = 42;
+  }
+
+  static class Finalizable {
+    int value;
+
+    @Override
+    protected void finalize() {}
+  }
+
+  // Enough objects to go through several TLABs.
+  static final int COUNT = 200000;
+
+  static Point $noinline$newPoint() {
+    return new Point();
+  }
+
+  static Lazy $noinline$newLazy() {
+    return new Lazy();
+  }
+
+  static Finalizable $noinline$newFinalizable() {
+    return new Finalizable();
+  }
+
+  static void testFreshObjects() {
+    for (int i = 0; i < COUNT; ++i) {
+      Point p = $noinline$newPoint();
+      if (p.getClass() != Point.class || p.x != 0 || p.y != 0L || p.z != null) {
+        throw new Error("Unexpected point " + p.x + " " + p.y + " " + p.z);
+      }
+      p.x = i;
+      p.y = i;
+      p.z = p;
+    }
+    System.out.println("Fresh objects OK");
+  }
+
+  static void testLazyClass() {
+    // The class is not initialized when the method is compiled, the allocation entrypoint must
+    // initialize it.
+    Lazy lazy = $noinline$newLazy();
+    if (lazy.value != 42 || Lazy.initialized != 1) {
+      throw new Error("Unexpected lazy " + lazy.value);
+    }
+    System.out.println("Lazily initialized class OK");
+  }
+
+  static void testFinalizable() {
+    for (int i = 0; i < COUNT; ++i) {
+      Finalizable f = $noinline$newFinalizable();
+      if (f.getClass() != Finalizable.class || f.value != 0) {
+        throw new Error("Unexpected finalizable " + f.value);
+      }
+      f.value = i;
+    }
+    System.out.println("Finalizable class OK");
+  }
+
+  private static final int KIND_ALLOCATED_OBJECTS = 1 << 0;
+  private static final int RESET_ALL = 0xffffffff;
+
+  static void testAllocationCounting() throws Exception {
+    Class<?> vmDebug = Class.forName("dalvik.system.VMDebug");
+    Method startAllocCounting = vmDebug.getDeclaredMethod("startAllocCounting");
+    Method stopAllocCounting = vmDebug.getDeclaredMethod("stopAllocCounting");
+    Method getAllocCount = vmDebug.getDeclaredMethod("getAllocCount", Integer.TYPE);
+    Method resetAllocCount = vmDebug.getDeclaredMethod("resetAllocCount", Integer.TYPE);
+
+    resetAllocCount.invoke(null, RESET_ALL);
+    startAllocCounting.invoke(null);
+    for (int i = 0; i < COUNT; ++i) {
+      $noinline$newPoint();
+    }
+    stopAllocCounting.invoke(null);
+    int allocated = (Integer) getAllocCount.invoke(null, KIND_ALLOCATED_OBJECTS);
+    if (allocated < COUNT) {
+      throw new Error("Missed allocations: " + allocated + " < " + COUNT);
+    }
+    resetAllocCount.invoke(null, RESET_ALL);
+    System.out.println("Allocation counting OK");
+  }
+
+  public static void main(String[] args) throws Exception {
+    System.loadLibrary(args[0]);
+    for (int i = 0; i < 1000; ++i) {
+      $noinline$newPoint();
+      $noinline$newFinalizable();
+    }
+    ensureJitCompiled(Main.class, "$noinline$newPoint");
+    ensureJitCompiled(Main.class, "$noinline$newLazy");
+    ensureJitCompiled(Main.class, "$noinline$newFinalizable");
+
+    testFreshObjects();
+    testLazyClass();
+    testFinalizable();
+    testAllocationCounting();
+  }
+
+  public static native void ensureJitCompiled(Class<?> klass, String methodName);
+}
@@ -64,6 +64,38 @@ public class Main {
     return returnLongConstant(42L);
   }
 
+  /// CHECK-START: int Main.InlineWithConstantFlag(int) inliner (before)
+  /// CHECK:         InvokeStaticOrDirect method_name:Main.configDependent
+
+  /// CHECK-START: int Main.InlineWithConstantFlag(int) inliner (after)
+  /// CHECK-NOT:     InvokeStaticOrDirect
+
+  /// CHECK-START: int Main.InlineWithConstantFlag(int) inliner (after)
+  /// CHECK:         Mul
+  /// CHECK-NOT:     Mul
+
+  // The code item is too big to inline on its own, but constant folding the flag leaves
+  // only the short path.
+  public static int configDependent(boolean verbose, int x) {
+    if (verbose) {
+      x = x * 3 + 1;
+      x = x * 5 + 2;
+      x = x * 7 + 3;
+      x = x * 11 + 4;
+      x = x * 13 + 5;
+      x = x * 17 + 6;
+      x = x * 19 + 7;
+      x = x * 23 + 8;
+      x = x * 29 + 9;
+      x = x * 31 + 10;
+    }
+    return x * 37;
+  }
+
+  public static int InlineWithConstantFlag(int x) {
+    return configDependent(false, x);
+  }
+
   public static void main(String[] args) {
     if (InlineNullConstant() != null) {
       throw new Error("Expected null");
@@ -71,6 +103,8 @@ public class Main {
       throw new Error("Expected int 42");
     } else if (InlineLongConstant() != 42L) {
       throw new Error("Expected long 42");
+    } else if (InlineWithConstantFlag(2) != 74) {
+      throw new Error("Expected int 74");
     }
   }
 }
@@ -645,6 +645,50 @@ public class Main {
     return new ClassWithClinit13();
   }
 
+  /*
+   * Ensure that the initialization check of a superclass is removed
+   * after the initialization check of its subclass.
+   */
+
+  /// CHECK-START: int Main.superClassInitializedBySubClass() dex_cache_load_elimination (before)
+  /// CHECK:                               ClinitCheck
+  /// CHECK:                               ClinitCheck
+
+  /// CHECK-START: int Main.superClassInitializedBySubClass() dex_cache_load_elimination (after)
+  /// CHECK-DAG:   <<Sub:l\d+>>            LoadClass class_name:Main$SubClassOfClassWithClinit14
+  /// CHECK-DAG:                           ClinitCheck [<<Sub>>]
+  /// CHECK-DAG:                           LoadClass class_name:Main$ClassWithClinit14
+
+  /// CHECK-START: int Main.superClassInitializedBySubClass() dex_cache_load_elimination (after)
+  /// CHECK:                               ClinitCheck
+  /// CHECK-NOT:                           ClinitCheck
+
+  static int superClassInitializedBySubClass() {
+    return SubClassOfClassWithClinit14.$inline$getSubValue() + ClassWithClinit14.$inline$getValue();
+  }
+
+  static class ClassWithClinit14 {
+    static int value = 14;
+    static {
+      System.out.println("Main$ClassWithClinit14's static initializer");
+    }
+
+    static int $inline$getValue() {
+      return value;
+    }
+  }
+
+  static class SubClassOfClassWithClinit14 extends ClassWithClinit14 {
+    static int subValue = 41;
+    static {
+      System.out.println("Main$SubClassOfClassWithClinit14's static initializer");
+    }
+
+    static int $inline$getSubValue() {
+      return subValue;
+    }
+  }
+
   // TODO: Add a test for the case of a static method whose declaring
   // class type index is not available (i.e. when `storage_index`
   // equals `dex::kDexNoIndex` in
@@ -681,5 +725,8 @@ public class Main {
       // Expected
     }
     $noinline$testInliningAndNewInstance(it);
+    if (superClassInitializedBySubClass() != 55) {
+      throw new Error("Unexpected value");
+    }
   }
 }
@@ -288,6 +288,22 @@ public class Main {
     return a;
   }
 
+  // Linear induction multiplied by a constant becomes an induction of its own.
+
+  /// CHECK-START: int Main.strengthReduceMul(int[], int) loop_optimization (before)
+  /// CHECK-DAG: <<Phi:i\d+>> Phi                   loop:<<Loop:B\d+>>
+  /// CHECK-DAG:              Mul [<<Phi>>,{{i\d+}}] loop:<<Loop>>
+  //
+  /// CHECK-START: int Main.strengthReduceMul(int[], int) loop_optimization (after)
+  /// CHECK-NOT: Mul loop:B{{\d+}}
+  public static int strengthReduceMul(int[] x, int n) {
+    int r = 0;
+    for (int i = 0; i < n; i++) {
+      r += x[i * 6 + 1];
+    }
+    return r;
+  }
+
   //
   // Verifier.
   //
@@ -360,6 +376,14 @@ public class Main {
     expectEquals(0, geoDivBlackHole(0x80000000));
     expectEquals(0, geoRemBlackHole(0x80000000));
 
+    int[] x = new int[61];
+    for (int i = 0; i < x.length; i++) {
+      x[i] = i;
+    }
+    expectEquals(0, strengthReduceMul(x, 0));
+    expectEquals(1, strengthReduceMul(x, 1));
+    expectEquals(280, strengthReduceMul(x, 10));
+
     System.out.println("passed");
   }
 
@@ -871,27 +871,52 @@ public class Main {
   /// CHECK:                      ArraySet
   /// CHECK-NOT:                  ArraySet
 
-  /// CHECK-START: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK-START-{ARM,RISCV64,X86,X86_64}: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
   /// CHECK-DAG:                  Phi                                       loop:<<Loop:B\d+>> outer_loop:none
   /// CHECK-DAG:                  If                                        loop:<<Loop>>      outer_loop:none
   /// CHECK-DAG:                  ArrayGet                                  loop:<<Loop>>      outer_loop:none
   /// CHECK-DAG:                  ArrayGet                                  loop:<<Loop>>      outer_loop:none
   /// CHECK-DAG:                  ArraySet                                  loop:<<Loop>>      outer_loop:none
 
-  /// CHECK-START: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK-START-{ARM,RISCV64,X86,X86_64}: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
   /// CHECK:                      Phi
   /// CHECK-NOT:                  Phi
 
-  /// CHECK-START: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK-START-{ARM,RISCV64,X86,X86_64}: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
   /// CHECK:                      If
   /// CHECK-NOT:                  If
 
-  /// CHECK-START: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK-START-{ARM,RISCV64,X86,X86_64}: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
   /// CHECK:                      ArrayGet
   /// CHECK:                      ArrayGet
   /// CHECK-NOT:                  ArrayGet
 
-  /// CHECK-START: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK-START-{ARM,RISCV64,X86,X86_64}: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK:                      ArraySet
+  /// CHECK-NOT:                  ArraySet
+  // On arm64 the odd iteration is peeled and the rest of the loop is unrolled.
+  //
+  /// CHECK-START-ARM64: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Const0:i\d+>>  IntConstant 0                             loop:none
+  /// CHECK-DAG:                  Phi                                       loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:                  If [<<Const0>>]                           loop:<<Loop>>      outer_loop:none
+
+  /// CHECK-START-ARM64: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK:                      Phi
+  /// CHECK-NOT:                  Phi
+
+  /// CHECK-START-ARM64: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK:                      ArrayGet
+  /// CHECK:                      ArrayGet
+  /// CHECK:                      ArrayGet
+  /// CHECK:                      ArrayGet
+  /// CHECK:                      ArrayGet
+  /// CHECK:                      ArrayGet
+  /// CHECK-NOT:                  ArrayGet
+
+  /// CHECK-START-ARM64: void Main.noUnrollingOddTripCount(int[]) loop_optimization (after)
+  /// CHECK:                      ArraySet
+  /// CHECK:                      ArraySet
   /// CHECK:                      ArraySet
   /// CHECK-NOT:                  ArraySet
   private static final void noUnrollingOddTripCount(int[] a) {
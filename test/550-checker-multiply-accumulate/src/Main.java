@@ -426,6 +426,14 @@ public class Main {
   /// CHECK-NOT:     VecMul
   /// CHECK-NOT:     VecAdd
 
+  /// CHECK-START-ARM: void Main.SimdMulAdd(int[], int[]) instruction_simplifier$after_loop_opt (after)
+  /// CHECK-DAG:     Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:     VecMultiplyAccumulate kind:Add loop:<<Loop>>      outer_loop:none
+
+  /// CHECK-START-ARM: void Main.SimdMulAdd(int[], int[]) instruction_simplifier$after_loop_opt (after)
+  /// CHECK-NOT:     VecMul
+  /// CHECK-NOT:     VecAdd
+
   public static void SimdMulAdd(int[] array1, int[] array2) {
     for (int j = 0; j < 100; j++) {
       array2[j] += 12345 * array1[j];
@@ -451,6 +459,10 @@ public class Main {
   /// CHECK-NOT:     VecMul
   /// CHECK-NOT:     VecSub
 
+  /// CHECK-START-ARM: void Main.SimdMulSub(int[], int[]) instruction_simplifier$after_loop_opt (after)
+  /// CHECK-DAG:     Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:     VecMultiplyAccumulate kind:Sub loop:<<Loop>>      outer_loop:none
+
   public static void SimdMulSub(int[] array1, int[] array2) {
     for (int j = 0; j < 100; j++) {
       array2[j] -= 12345 * array1[j];
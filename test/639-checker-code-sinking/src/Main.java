@@ -31,6 +31,13 @@ public class Main {
     testSimpleUse();
     testTwoUses();
     testFieldStores(doThrow);
+    assertEquals(42, $noinline$testPartialEscape(false));
+    try {
+      $noinline$testPartialEscape(true);
+      throw new Exception("Unreachable");
+    } catch (Error e) {
+      // expected
+    }
     testFieldStoreCycle();
     testArrayStores();
     testOnlyStoreUses();
@@ -158,6 +165,37 @@ public class Main {
     }
   }
 
+  // The allocation escapes only on the throwing path. LSE forwards the stored value to the
+  // load on the returning path, across the call that cannot see the object, and code sinking
+  // then moves the allocation and its store to the throwing path.
+  //
+  /// CHECK-START: int Main.$noinline$testPartialEscape(boolean) load_store_elimination (before)
+  /// CHECK:                      NewInstance
+  /// CHECK:                      InstanceFieldSet
+  /// CHECK:                      InvokeStaticOrDirect method_name:Main.$noinline$returnSameValue
+  /// CHECK:                      InstanceFieldGet
+
+  /// CHECK-START: int Main.$noinline$testPartialEscape(boolean) load_store_elimination (after)
+  /// CHECK-NOT:                  InstanceFieldGet
+
+  /// CHECK-START: int Main.$noinline$testPartialEscape(boolean) code_sinking (before)
+  /// CHECK:                      InstanceFieldSet
+  /// CHECK:                      If
+
+  /// CHECK-START: int Main.$noinline$testPartialEscape(boolean) code_sinking (after)
+  /// CHECK:                      If
+  /// CHECK:                      InstanceFieldSet
+  /// CHECK:                      Throw
+  private static int $noinline$testPartialEscape(boolean doThrow) {
+    Main m = new Main();
+    m.intField = 42;
+    $noinline$returnSameValue(0);
+    if (doThrow) {
+      throw new Error(m.toString());
+    }
+    return m.intField;
+  }
+
   /// CHECK-START: void Main.testFieldStoreCycle() code_sinking (before)
   /// CHECK: <<LoadClass:l\d+>>    LoadClass class_name:Main
   /// CHECK: <<NewInstance1:l\d+>> NewInstance [<<LoadClass>>]
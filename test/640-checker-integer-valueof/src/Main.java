@@ -220,6 +220,46 @@ public class Main {
     return true;
   }
 
+  /// CHECK-START: int Main.$noinline$boxUnboxIntegerPhi(boolean, int, int) inliner (after)
+  /// CHECK-DAG: <<Phi:l\d+>>     Phi
+  /// CHECK-DAG: <<Unboxed:i\d+>> InstanceFieldGet field_name:java.lang.Integer.value
+  /// CHECK-DAG:                  Return [<<Unboxed>>]
+
+  /// CHECK-START: int Main.$noinline$boxUnboxIntegerPhi(boolean, int, int) instruction_simplifier$after_inlining (after)
+  /// CHECK-DAG: <<A:i\d+>>       ParameterValue
+  /// CHECK-DAG: <<B:i\d+>>       ParameterValue
+  /// CHECK-DAG: <<Phi:i\d+>>     Phi [<<A>>,<<B>>]
+  /// CHECK-DAG:                  Return [<<Phi>>]
+
+  /// CHECK-START: int Main.$noinline$boxUnboxIntegerPhi(boolean, int, int) instruction_simplifier$after_inlining (after)
+  /// CHECK-NOT:                  InstanceFieldGet
+
+  public static int $noinline$boxUnboxIntegerPhi(boolean cond, int a, int b) {
+    Integer boxed;
+    if (cond) {
+      boxed = Integer.valueOf(a);
+    } else {
+      boxed = Integer.valueOf(b);
+    }
+    return boxed.intValue();
+  }
+
+  /// CHECK-START: int Main.$noinline$boxUnboxIntegerThroughObject(int) instruction_simplifier$after_inlining (after)
+  /// CHECK-DAG: <<Input:i\d+>>   ParameterValue
+  /// CHECK-DAG:                  Return [<<Input>>]
+
+  /// CHECK-START: int Main.$noinline$boxUnboxIntegerThroughObject(int) instruction_simplifier$after_inlining (after)
+  /// CHECK-NOT:                  InstanceFieldGet
+
+  public static int $noinline$boxUnboxIntegerThroughObject(int value) {
+    Object boxed = $inline$identity(Integer.valueOf(value));
+    return ((Integer) boxed).intValue();
+  }
+
+  public static Object $inline$identity(Object o) {
+    return o;
+  }
+
   public static void main(String[] args) {
     assertEqual("42", foo(intField));
     assertEqual(foo(intField), foo(intField2));
@@ -249,6 +289,10 @@ public class Main {
 
     assertEqual(42, $noinline$boxUnboxByteAsUint8((byte) 42));
     assertEqual(-42 & 0xff, $noinline$boxUnboxByteAsUint8((byte) -42));
+
+    assertEqual(42, $noinline$boxUnboxIntegerPhi(true, 42, -42));
+    assertEqual(-42, $noinline$boxUnboxIntegerPhi(false, 42, -42));
+    assertEqual(55555, $noinline$boxUnboxIntegerThroughObject(55555));
   }
 
   static void assertEqual(String a, Integer b) {
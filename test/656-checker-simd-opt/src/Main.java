@@ -156,6 +156,26 @@ public class Main {
     }
   }
 
+  /// CHECK-START-{X86_64,ARM64}: void Main.$noinline$stencilThreeArrays(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-DAG: <<C0:i\d+>>    IntConstant 0
+  /// CHECK-DAG: <<CP1:i\d+>>   IntConstant 1
+  /// CHECK-DAG: <<CP2:i\d+>>   IntConstant 2
+  /// CHECK-DAG: <<Cond1:z\d+>> NotEqual [{{l\d+}},{{l\d+}}]             loop:none
+  /// CHECK-DAG: <<Cond2:z\d+>> NotEqual [{{l\d+}},{{l\d+}}]             loop:none
+  /// CHECK-DAG: <<Sel1:i\d+>>  Select [<<C0>>,{{i\d+}},<<Cond1>>]       loop:none
+  /// CHECK-DAG:                Select [<<C0>>,<<Sel1>>,<<Cond2>>]        loop:none
+  /// CHECK-DAG:                VecLoad                                   loop:<<LoopV:B\d+>> outer_loop:none
+  /// CHECK-DAG:                VecLoad                                   loop:<<LoopV>>      outer_loop:none
+  /// CHECK-DAG:                VecStore                                  loop:<<LoopV>>      outer_loop:none
+  //
+  // Checks that several disambiguation runtime tests can guard the same vector loop.
+  //
+  private static void $noinline$stencilThreeArrays(int[] a, int[] b, int[] c) {
+    for (int i = 1; i < STENCIL_ARRAY_SIZE - 1; i++) {
+      a[i] = b[i - 1] + c[i + 1];
+    }
+  }
+
   /// CHECK-START: void Main.stencilAddInt(int[], int[], int) loop_optimization (before)
   /// CHECK-DAG: <<CP1:i\d+>>   IntConstant 1                        loop:none
   /// CHECK-DAG: <<CM1:i\d+>>   IntConstant -1                       loop:none
@@ -444,6 +464,37 @@ public class Main {
     }
   }
 
+  static void testStencilThreeArrays() {
+    int[] a = new int[STENCIL_ARRAY_SIZE];
+    int[] b = new int[STENCIL_ARRAY_SIZE];
+    int[] c = new int[STENCIL_ARRAY_SIZE];
+    initArrayStencil(b);
+    initArrayStencil(c);
+
+    $noinline$stencilThreeArrays(a, b, c);
+    for (int i = 1; i < STENCIL_ARRAY_SIZE - 1; i++) {
+      // (i - 1) + (i + 1) = 2 * i.
+      expectEquals(i + i, a[i]);
+    }
+
+    // With c aliasing a, every a[i] reads the a[i + 1] that is still the initial value.
+    initArrayStencil(a);
+    $noinline$stencilThreeArrays(a, b, a);
+    for (int i = 1; i < STENCIL_ARRAY_SIZE - 1; i++) {
+      expectEquals(i + i, a[i]);
+    }
+
+    // With b aliasing a, every a[i] reads the a[i - 1] that was just computed.
+    initArrayStencil(a);
+    initArrayStencil(c);
+    $noinline$stencilThreeArrays(a, a, c);
+    int e = 0;
+    for (int i = 1; i < STENCIL_ARRAY_SIZE - 1; i++) {
+      e += i + 1;
+      expectEquals(e, a[i]);
+    }
+  }
+
   static void testStencil2() {
     int[] a = new int[100];
     int[] b = new int[100];
@@ -489,6 +540,7 @@ public class Main {
     testUnroll();
     testStencil1();
     testStencilConstSize();
+    testStencilThreeArrays();
     testStencil2();
     testStencil3();
     testTypes();
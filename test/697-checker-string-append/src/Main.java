@@ -26,6 +26,8 @@ public class Main {
         testNoArgs();
         testInline();
         testEquals();
+        testManyArgs();
+        testConstructorArgs();
         System.out.println("passed");
     }
 
@@ -253,6 +255,8 @@ public class Main {
                      $noinline$appendStringAndFloat(APPEND_FLOAT_PREFIX, Float.POSITIVE_INFINITY));
         assertEquals("Float/-Infinity",
                      $noinline$appendStringAndFloat(APPEND_FLOAT_PREFIX, Float.NEGATIVE_INFINITY));
+        assertEquals("Float/0.0", $noinline$appendStringAndFloat(APPEND_FLOAT_PREFIX, 0.0f));
+        assertEquals("Float/-0.0", $noinline$appendStringAndFloat(APPEND_FLOAT_PREFIX, -0.0f));
     }
 
     private static final String APPEND_DOUBLE_PREFIX = "Double/";
@@ -323,6 +327,8 @@ public class Main {
         assertEquals(
             "Double/-Infinity",
             $noinline$appendStringAndDouble(APPEND_DOUBLE_PREFIX, Double.NEGATIVE_INFINITY));
+        assertEquals("Double/0.0", $noinline$appendStringAndDouble(APPEND_DOUBLE_PREFIX, 0.0));
+        assertEquals("Double/-0.0", $noinline$appendStringAndDouble(APPEND_DOUBLE_PREFIX, -0.0));
     }
 
     /// CHECK-START: java.lang.String Main.$noinline$appendDoubleAndFloat(double, float) instruction_simplifier (before)
@@ -447,6 +453,64 @@ public class Main {
       }
     }
 
+    // More arguments than fit in one format are split into several appends.
+    /// CHECK-START: java.lang.String Main.$noinline$appendManyArgs(java.lang.String, int, char, double, long, float) instruction_simplifier (before)
+    /// CHECK-NOT:              StringBuilderAppend
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendManyArgs(java.lang.String, int, char, double, long, float) instruction_simplifier (after)
+    /// CHECK:      <<First:l\d+>> StringBuilderAppend
+    /// CHECK:                  StringBuilderAppend [<<First>>,{{.*}}]
+    /// CHECK-NOT:              StringBuilderAppend
+    public static String $noinline$appendManyArgs(String s,
+                                                  int i,
+                                                  char c,
+                                                  double d,
+                                                  long l,
+                                                  float f) {
+        return new StringBuilder().append(s).append('[')
+                                  .append(i).append(',')
+                                  .append(c).append(',')
+                                  .append(d).append(',')
+                                  .append(l).append(',')
+                                  .append(f).append(']').toString();
+    }
+
+    public static void testManyArgs() {
+        assertEquals("x[1,q,2.5,-3,4.0]", $noinline$appendManyArgs("x", 1, 'q', 2.5, -3L, 4.0f));
+        assertEquals("null[-42,\u0131,NaN,0,1.0E7]",
+                     $noinline$appendManyArgs(null, -42, '\u0131', Double.NaN, 0L, 1.0E7f));
+    }
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendToStringConstructor(int) instruction_simplifier (after)
+    /// CHECK:                  StringBuilderAppend
+    public static String $noinline$appendToStringConstructor(int i) {
+        return new StringBuilder("prefix/").append(i).toString();
+    }
+
+    /// CHECK-START: java.lang.String Main.$noinline$appendToCapacityConstructor(java.lang.String, int) instruction_simplifier (after)
+    /// CHECK:                  StringBuilderAppend
+    public static String $noinline$appendToCapacityConstructor(String s, int i) {
+        return new StringBuilder(64).append(s).append(i).toString();
+    }
+
+    // The constructor throws NullPointerException for a null String, so it is not replaced.
+    /// CHECK-START: java.lang.String Main.$noinline$appendToNullableStringConstructor(java.lang.String, int) instruction_simplifier (after)
+    /// CHECK-NOT:              StringBuilderAppend
+    public static String $noinline$appendToNullableStringConstructor(String s, int i) {
+        return new StringBuilder(s).append(i).toString();
+    }
+
+    public static void testConstructorArgs() {
+        assertEquals("prefix/42", $noinline$appendToStringConstructor(42));
+        assertEquals("x42", $noinline$appendToCapacityConstructor("x", 42));
+        assertEquals("x42", $noinline$appendToNullableStringConstructor("x", 42));
+        try {
+            $noinline$appendToNullableStringConstructor(null, 42);
+            throw new Error("Expected NullPointerException");
+        } catch (NullPointerException expected) {
+        }
+    }
+
     public static void assertEquals(String expected, String actual) {
         if (!expected.equals(actual)) {
             throw new AssertionError("Expected: " + expected + ", actual: " + actual);
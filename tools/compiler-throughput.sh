@@ -0,0 +1,63 @@
+#!/bin/bash
+#
+# Copyright (C) 2026 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#
+# This script measures the throughput of the optimizing compiler over a corpus of dex, jar or
+# apk files. Each file is compiled on the host with a fixed number of compiler threads, the
+# oat file is discarded, and the --dump-pass-summary report of dex2oat is printed: methods per
+# second, per-method time and peak arena memory, and the time spent in each pass.
+#
+# Usage:
+#     compiler-throughput.sh [-j<threads>] [--arch=<isa>] <file>+ [-- <dex2oat args>]
+#
+# Use the same thread count and a release dex2oat for comparisons between builds.
+#
+
+set -e
+
+THREADS=1
+ARCH=host64
+FILES=()
+while [[ "$#" -gt 0 ]]; do
+  case "$1" in
+    -j*) THREADS="${1#-j}" ;;
+    --arch=*) ARCH="${1#--arch=}" ;;
+    --) shift; break ;;
+    *) FILES+=("$1") ;;
+  esac
+  shift
+done
+
+if [[ "${#FILES[@]}" -eq 0 ]]; then
+  echo "Usage $0 [-j<threads>] [--arch=<isa>] <dex|jar|apk>+ [-- <dex2oat args>]"
+  echo "Example $0 -j4 Maps.apk Calendar.apk -- --compiler-filter=speed"
+  exit 1
+fi
+
+for FILE in "${FILES[@]}"; do
+  echo "== $FILE"
+  # The summary is logged at INFO level, keep only the message of its lines.
+  $ANDROID_BUILD_TOP/art/tools/compile-jar.py \
+      --dex2oat="$ANDROID_HOST_OUT/bin/dex2oat64" \
+      --arch="$ARCH" \
+      "$FILE" \
+      -j"$THREADS" \
+      --compiler-filter=speed \
+      --dump-pass-summary \
+      "$@" 2>&1 \
+    | grep -E '(Pass summary|Method time|Method peak arena|Pass [^ ]+:)' \
+    | sed -e 's/^.*\] //'
+done